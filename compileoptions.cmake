@@ -165,3 +165,62 @@ elseif (WIN32)
 endif()
 
 endif()
+
+# Link-time optimization, aimed to release builds (see also PGO below).
+if (LTO)
+
+if (CLR_CMAKE_PLATFORM_UNIX)
+  if (CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    set(LTO_FLAGS "-flto=thin")
+  else()
+    set(LTO_FLAGS "-flto")
+  endif()
+  set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} ${LTO_FLAGS} ")
+  set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} ${LTO_FLAGS} ")
+  set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} ${LTO_FLAGS} ")
+  set(CMAKE_SHARED_LINKER_FLAGS "${CMAKE_SHARED_LINKER_FLAGS} ${LTO_FLAGS} ")
+elseif (WIN32)
+  # Note, /GL is already used by Release and Relwithdebinfo builds.
+  set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} /LTCG")
+endif()
+
+endif()
+
+# Profile-guided optimization: build with PGO=generate, run training scenarios (see test-suite/pgo_train.sh),
+# then build in same build directory with PGO=use and PGO_PROFILE=<merged .profdata file for clang or profiles
+# directory for gcc>. Note, clang writes raw profiles into LLVM_PROFILE_FILE, gcc into PGO_PROFILE directory.
+if (PGO)
+
+if (NOT CLR_CMAKE_PLATFORM_UNIX)
+  message(FATAL_ERROR "PGO builds not supported on current platform")
+endif()
+
+if (PGO STREQUAL "generate")
+  if (CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    set(PGO_FLAGS "-fprofile-instr-generate")
+  else()
+    if (PGO_PROFILE STREQUAL "")
+      message(FATAL_ERROR "PGO=generate with gcc requires PGO_PROFILE directory")
+    endif()
+    set(PGO_FLAGS "-fprofile-generate=${PGO_PROFILE}")
+  endif()
+elseif (PGO STREQUAL "use")
+  if (NOT EXISTS "${PGO_PROFILE}")
+    message(FATAL_ERROR "PGO=use requires existing PGO_PROFILE")
+  endif()
+  # Note, profile could be collected on slightly different sources (local changes), don't fail on mismatch.
+  if (CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    set(PGO_FLAGS "-fprofile-instr-use=${PGO_PROFILE} -Wno-profile-instr-out-of-date -Wno-profile-instr-unprofiled")
+  else()
+    set(PGO_FLAGS "-fprofile-use=${PGO_PROFILE} -fprofile-correction -Wno-missing-profile")
+  endif()
+else()
+  message(FATAL_ERROR "Unknown PGO mode '${PGO}', 'generate' or 'use' expected")
+endif()
+
+set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} ${PGO_FLAGS} ")
+set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} ${PGO_FLAGS} ")
+set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} ${PGO_FLAGS} ")
+set(CMAKE_SHARED_LINKER_FLAGS "${CMAKE_SHARED_LINKER_FLAGS} ${PGO_FLAGS} ")
+
+endif()
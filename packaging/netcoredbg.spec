@@ -133,6 +133,9 @@ cmake .. \
 %ifnarch riscv64
     -DNCDB_DOTNET_STARTUP_HOOK=$STARTUP_HOOK \
     -DINTEROP_DEBUGGING=1 \
+%endif
+%ifarch %{arm}
+    -DEMBEDDED_PROFILE=ON \
 %endif
     -DBUILD_TESTING=%{build_testing} \
     -DCLR_CMAKE_ENABLE_CODE_COVERAGE=%{coverage}
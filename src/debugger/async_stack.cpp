@@ -0,0 +1,519 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/async_stack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+#include "metadata/async_info.h"
+#include "metadata/modules.h"
+#include "utils/utf.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+
+    // Continuation wrappers (delegates, task continuations, lists) nesting limit.
+    const int ContinuationDepthLimit = 8;
+    // Continuations lists items, that are checked for awaiter.
+    const uint32_t ContinuationsListLimit = 16;
+    // Tasks in awaiters chain limit (in case of broken chain or very deep async recursion).
+    const size_t AwaitersChainLimit = 256;
+    // Types hierarchy depth limit for fields search.
+    const int TypeHierarchyDepthLimit = 16;
+
+    // Same order as AsyncStack::Field.
+    const WCHAR *const FieldNames[] =
+    {
+        W("<>1__state"),
+        W("<>t__builder"),
+        W("_builder"),
+        W("m_task"),
+        W("m_continuationObject"),
+        W("StateMachine"),
+        W("m_action"),
+        W("_target"),
+        W("_continuation"),
+        W("_items"),
+        W("_size"),
+        W("m_stateFlags")
+    };
+
+    bool IsReferenceElementType(CorElementType elementType)
+    {
+        return elementType == ELEMENT_TYPE_CLASS || elementType == ELEMENT_TYPE_OBJECT || elementType == ELEMENT_TYPE_STRING ||
+               elementType == ELEMENT_TYPE_SZARRAY || elementType == ELEMENT_TYPE_ARRAY;
+    }
+
+    HRESULT GetTypeMetadata(ICorDebugProcess5 *pProcess5, COR_TYPEID typeId, ICorDebugModule **ppModule, mdTypeDef &typeDef,
+                            IMetaDataImport **ppMD)
+    {
+        HRESULT Status;
+        ToRelease<ICorDebugType> iCorType;
+        IfFailRet(pProcess5->GetTypeForTypeID(typeId, &iCorType));
+        ToRelease<ICorDebugClass> iCorClass;
+        IfFailRet(iCorType->GetClass(&iCorClass));
+        IfFailRet(iCorClass->GetToken(&typeDef));
+        ToRelease<ICorDebugModule> iCorModule;
+        IfFailRet(iCorClass->GetModule(&iCorModule));
+        ToRelease<IUnknown> pMDUnknown;
+        IfFailRet(iCorModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+        IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) ppMD));
+        *ppModule = iCorModule.Detach();
+        return S_OK;
+    }
+
+} // unnamed namespace
+
+AsyncStack::AsyncStack(std::shared_ptr<Modules> &sharedModules) :
+    m_uniqueAsyncInfo(new AsyncInfo(sharedModules)),
+    m_pProcess(nullptr),
+    m_pointerSize(0)
+{
+    static_assert(sizeof(FieldNames) / sizeof(FieldNames[0]) == size_t(Field::Count), "FieldNames must be in sync with AsyncStack::Field");
+}
+
+AsyncStack::~AsyncStack()
+{
+}
+
+void AsyncStack::InvalidateCache()
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_awaitersChains.clear();
+    // Note, types could be unloaded (collectible assemblies) and type id reused during process run.
+    m_fields.clear();
+    m_stateMachineMethods.clear();
+    m_moveNextMethods.clear();
+    m_iCorProcess5.Free();
+    m_pProcess = nullptr;
+    m_pointerSize = 0;
+}
+
+// Caller must care about m_cacheMutex.
+HRESULT AsyncStack::Init(ICorDebugProcess *pProcess)
+{
+    if (m_pProcess == pProcess && m_iCorProcess5 != nullptr)
+        return S_OK;
+
+    HRESULT Status;
+    m_iCorProcess5.Free();
+    IfFailRet(pProcess->QueryInterface(IID_ICorDebugProcess5, (LPVOID*) &m_iCorProcess5));
+    COR_HEAPINFO heapInfo;
+    IfFailRet(m_iCorProcess5->GetGCHeapInformation(&heapInfo));
+    m_pointerSize = heapInfo.pointerSize == 0 ? sizeof(void*) : heapInfo.pointerSize;
+    m_pProcess = pProcess;
+    return S_OK;
+}
+
+// Caller must care about m_cacheMutex.
+// Note, instance fields offsets are provided by runtime from object start for reference types and from value start
+// for value types, fields of parent types are provided for parent type only.
+HRESULT AsyncStack::FindField(COR_TYPEID typeId, Field field, field_t &result)
+{
+    const std::tuple<uint64_t, uint64_t, int> key(typeId.token1, typeId.token2, int(field));
+    auto find = m_fields.find(key);
+    if (find != m_fields.end())
+    {
+        result = find->second;
+        return result.found ? S_OK : E_FAIL;
+    }
+
+    field_t &entry = m_fields[key];
+    COR_TYPEID currentId = typeId;
+    for (int depth = 0; depth < TypeHierarchyDepthLimit; depth++)
+    {
+        COR_TYPE_LAYOUT layout;
+        if (FAILED(m_iCorProcess5->GetTypeLayout(currentId, &layout)))
+            break;
+
+        ToRelease<ICorDebugModule> iCorModule;
+        ToRelease<IMetaDataImport> pMD;
+        mdTypeDef typeDef = mdTypeDefNil;
+        mdFieldDef fieldDef = mdFieldDefNil;
+        if (layout.numFields > 0 &&
+            SUCCEEDED(GetTypeMetadata(m_iCorProcess5, currentId, &iCorModule, typeDef, &pMD)) &&
+            SUCCEEDED(pMD->FindField(typeDef, FieldNames[int(field)], nullptr, 0, &fieldDef)))
+        {
+            std::vector<COR_FIELD> fields(layout.numFields);
+            ULONG32 fetched = 0;
+            if (FAILED(m_iCorProcess5->GetTypeFields(currentId, layout.numFields, fields.data(), &fetched)))
+                break;
+
+            for (ULONG32 i = 0; i < fetched && i < layout.numFields; i++)
+            {
+                if (fields[i].token != fieldDef)
+                    continue;
+
+                entry.found = true;
+                entry.offset = fields[i].offset;
+                entry.fieldType = fields[i].fieldType;
+                entry.id = fields[i].id;
+                break;
+            }
+            // Note, field could be static (not provided by GetTypeFields()), no reason check parents in this case.
+            break;
+        }
+
+        if (layout.type == ELEMENT_TYPE_VALUETYPE || (layout.parentID.token1 == 0 && layout.parentID.token2 == 0))
+            break;
+        currentId = layout.parentID;
+    }
+
+    result = entry;
+    return entry.found ? S_OK : E_FAIL;
+}
+
+// Caller must care about m_cacheMutex.
+HRESULT AsyncStack::ReadPointer(CORDB_ADDRESS address, CORDB_ADDRESS &value)
+{
+    HRESULT Status;
+    BYTE buffer[sizeof(uint64_t)];
+    SIZE_T read = 0;
+    IfFailRet(m_pProcess->ReadMemory(address, m_pointerSize, buffer, &read));
+    if (read != m_pointerSize)
+        return E_FAIL;
+
+    if (m_pointerSize == sizeof(uint32_t))
+    {
+        uint32_t value32;
+        memcpy(&value32, buffer, sizeof(value32));
+        value = value32;
+        return S_OK;
+    }
+    uint64_t value64;
+    memcpy(&value64, buffer, sizeof(value64));
+    value = value64;
+    return S_OK;
+}
+
+// Caller must care about m_cacheMutex.
+HRESULT AsyncStack::ReadReferenceField(CORDB_ADDRESS object, Field field, CORDB_ADDRESS &value)
+{
+    HRESULT Status;
+    COR_TYPEID typeId;
+    IfFailRet(m_iCorProcess5->GetTypeID(object, &typeId));
+    field_t fieldInfo;
+    IfFailRet(FindField(typeId, field, fieldInfo));
+    if (!IsReferenceElementType(fieldInfo.fieldType))
+        return E_FAIL;
+
+    return ReadPointer(object + fieldInfo.offset, value);
+}
+
+// Caller must care about m_cacheMutex.
+// Return task (object with `m_continuationObject`), that will be continued by continuation object or 0.
+CORDB_ADDRESS AsyncStack::ResolveContinuation(CORDB_ADDRESS object, int depth)
+{
+    if (object == 0 || depth > ContinuationDepthLimit)
+        return 0;
+
+    COR_TYPEID typeId;
+    if (FAILED(m_iCorProcess5->GetTypeID(object, &typeId)))
+        return 0;
+
+    // Task, including state machine box (await of task without context) and continuation task (ContinueWith).
+    field_t fieldInfo;
+    if (SUCCEEDED(FindField(typeId, Field::ContinuationObject, fieldInfo)))
+        return object;
+
+    // Awaiting task continuations hold box's MoveNext delegate, task continuations hold continuation task, delegates and
+    // continuation wrappers (debugger or async method builder tracking) hold box as target.
+    static const Field wrapperFields[] = { Field::Action, Field::Task, Field::Target, Field::Continuation };
+    for (Field wrapperField : wrapperFields)
+    {
+        CORDB_ADDRESS inner = 0;
+        if (SUCCEEDED(ReadReferenceField(object, wrapperField, inner)))
+            return ResolveContinuation(inner, depth + 1);
+    }
+
+    // List<object> of continuations in case task have more than one continuation.
+    CORDB_ADDRESS items = 0;
+    if (FAILED(FindField(typeId, Field::Size, fieldInfo)) || fieldInfo.fieldType != ELEMENT_TYPE_I4 ||
+        FAILED(ReadReferenceField(object, Field::Items, items)) || items == 0)
+        return 0;
+
+    int32_t size = 0;
+    SIZE_T read = 0;
+    COR_TYPEID itemsTypeId;
+    COR_ARRAY_LAYOUT arrayLayout;
+    if (FAILED(m_pProcess->ReadMemory(object + fieldInfo.offset, sizeof(size), (BYTE*)&size, &read)) || read != sizeof(size) ||
+        FAILED(m_iCorProcess5->GetTypeID(items, &itemsTypeId)) ||
+        FAILED(m_iCorProcess5->GetArrayLayout(itemsTypeId, &arrayLayout)) ||
+        !IsReferenceElementType(arrayLayout.componentType))
+        return 0;
+
+    // Note, first continuation, that could be resolved to task, is used as awaiter.
+    const uint32_t count = std::min(uint32_t(std::max(size, 0)), ContinuationsListLimit);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        CORDB_ADDRESS item = 0;
+        if (FAILED(ReadPointer(items + arrayLayout.firstElementOffset + uint64_t(i) * arrayLayout.elementSize, item)))
+            return 0;
+
+        CORDB_ADDRESS task = ResolveContinuation(item, depth + 1);
+        if (task != 0)
+            return task;
+    }
+    return 0;
+}
+
+// Caller must care about m_cacheMutex.
+HRESULT AsyncStack::GetBuilderTask(CORDB_ADDRESS builderAddress, COR_TYPEID builderType, CORDB_ADDRESS &taskAddress)
+{
+    field_t fieldInfo;
+    if (SUCCEEDED(FindField(builderType, Field::Task, fieldInfo)) && IsReferenceElementType(fieldInfo.fieldType))
+        return ReadPointer(builderAddress + fieldInfo.offset, taskAddress);
+
+    // AsyncVoidMethodBuilder use AsyncTaskMethodBuilder inside.
+    if (SUCCEEDED(FindField(builderType, Field::InnerBuilder, fieldInfo)) && fieldInfo.fieldType == ELEMENT_TYPE_VALUETYPE)
+    {
+        field_t innerTask;
+        if (FAILED(FindField(fieldInfo.id, Field::Task, innerTask)) || !IsReferenceElementType(innerTask.fieldType))
+            return E_FAIL;
+        return ReadPointer(builderAddress + fieldInfo.offset + innerTask.offset, taskAddress);
+    }
+
+    return E_FAIL;
+}
+
+// Caller must care about m_cacheMutex.
+HRESULT AsyncStack::GetStateMachineMethod(COR_TYPEID stateMachineType, frame_t &frame)
+{
+    const std::pair<uint64_t, uint64_t> key(stateMachineType.token1, stateMachineType.token2);
+    auto find = m_stateMachineMethods.find(key);
+    if (find != m_stateMachineMethods.end())
+    {
+        frame = find->second;
+        return S_OK;
+    }
+
+    HRESULT Status;
+    ToRelease<ICorDebugModule> iCorModule;
+    ToRelease<IMetaDataImport> pMD;
+    mdTypeDef typeDef = mdTypeDefNil;
+    IfFailRet(GetTypeMetadata(m_iCorProcess5, stateMachineType, &iCorModule, typeDef, &pMD));
+    IfFailRet(iCorModule->GetBaseAddress(&frame.modAddress));
+    IfFailRet(pMD->FindMethod(typeDef, W("MoveNext"), nullptr, 0, &frame.methodToken));
+
+    ToRelease<ICorDebugFunction> iCorFunction;
+    IfFailRet(iCorModule->GetFunctionFromToken(frame.methodToken, &iCorFunction));
+    IfFailRet(iCorFunction->GetCurrentVersionNumber(&frame.methodVersion));
+
+    m_stateMachineMethods.emplace(key, frame);
+    return S_OK;
+}
+
+// Caller must care about m_cacheMutex.
+HRESULT AsyncStack::GetStateMachineFrame(CORDB_ADDRESS stateMachineAddress, COR_TYPEID stateMachineType, bool resolveAwait, frame_t &frame)
+{
+    HRESULT Status;
+    field_t stateField;
+    IfFailRet(FindField(stateMachineType, Field::State, stateField));
+    IfFailRet(GetStateMachineMethod(stateMachineType, frame));
+    SIZE_T read = 0;
+    IfFailRet(m_pProcess->ReadMemory(stateMachineAddress + stateField.offset, sizeof(frame.state), (BYTE*)&frame.state, &read));
+    if (read != sizeof(frame.state))
+        return E_FAIL;
+
+    if (!resolveAwait)
+        return S_OK;
+
+    AsyncInfo::AwaitInfo awaitInfo;
+    frame.haveILOffset = m_uniqueAsyncInfo->FindAwaitInfoByState(frame.modAddress, frame.methodToken, frame.methodVersion, frame.state, awaitInfo);
+    frame.ilOffset = frame.haveILOffset ? awaitInfo.yield_offset : 0;
+    return S_OK;
+}
+
+// Caller must care about m_cacheMutex.
+HRESULT AsyncStack::GetBoxFrame(CORDB_ADDRESS boxAddress, bool resolveAwait, frame_t &frame)
+{
+    HRESULT Status;
+    COR_TYPEID boxType;
+    IfFailRet(m_iCorProcess5->GetTypeID(boxAddress, &boxType));
+    field_t stateMachineField;
+    IfFailRet(FindField(boxType, Field::StateMachine, stateMachineField));
+
+    // Note, state machine is class for Debug build and structure for Release build.
+    CORDB_ADDRESS stateMachineAddress = boxAddress + stateMachineField.offset;
+    COR_TYPEID stateMachineType = stateMachineField.id;
+    if (stateMachineField.fieldType != ELEMENT_TYPE_VALUETYPE)
+    {
+        IfFailRet(ReadPointer(stateMachineAddress, stateMachineAddress));
+        if (stateMachineAddress == 0)
+            return E_FAIL;
+        IfFailRet(m_iCorProcess5->GetTypeID(stateMachineAddress, &stateMachineType));
+    }
+
+    IfFailRet(GetStateMachineFrame(stateMachineAddress, stateMachineType, resolveAwait, frame));
+    frame.taskAddress = boxAddress;
+    return S_OK;
+}
+
+// Caller must care about m_cacheMutex.
+HRESULT AsyncStack::GetAwaitersChain(CORDB_ADDRESS taskAddress, std::vector<frame_t> &frames)
+{
+    auto find = m_awaitersChains.find(taskAddress);
+    if (find != m_awaitersChains.end())
+    {
+        frames.insert(frames.end(), find->second.begin(), find->second.end());
+        return S_OK;
+    }
+
+    std::vector<frame_t> chain;
+    std::unordered_set<CORDB_ADDRESS> visited;
+    visited.insert(taskAddress);
+    CORDB_ADDRESS current = taskAddress;
+    for (size_t i = 0; i < AwaitersChainLimit; i++)
+    {
+        CORDB_ADDRESS continuation = 0;
+        if (FAILED(ReadReferenceField(current, Field::ContinuationObject, continuation)))
+            break;
+
+        const CORDB_ADDRESS next = ResolveContinuation(continuation, 0);
+        if (next == 0 || !visited.insert(next).second)
+            break;
+
+        // Note, tasks without state machine (continuation tasks, combinators promises) are skipped.
+        frame_t frame;
+        if (SUCCEEDED(GetBoxFrame(next, true, frame)))
+            chain.push_back(frame);
+
+        // Note, chains of different tasks usually have same tail (tasks awaited by same async method).
+        auto cached = m_awaitersChains.find(next);
+        if (cached != m_awaitersChains.end())
+        {
+            chain.insert(chain.end(), cached->second.begin(), cached->second.end());
+            break;
+        }
+
+        current = next;
+    }
+
+    frames.insert(frames.end(), chain.begin(), chain.end());
+    m_awaitersChains.emplace(taskAddress, std::move(chain));
+    return S_OK;
+}
+
+bool AsyncStack::IsAsyncMoveNextFrame(ICorDebugFrame *pFrame)
+{
+    ToRelease<ICorDebugFunction> iCorFunction;
+    ToRelease<ICorDebugModule> iCorModule;
+    CORDB_ADDRESS modAddress = 0;
+    mdMethodDef methodDef = mdMethodDefNil;
+    if (FAILED(pFrame->GetFunction(&iCorFunction)) ||
+        FAILED(iCorFunction->GetModule(&iCorModule)) ||
+        FAILED(iCorModule->GetBaseAddress(&modAddress)) ||
+        FAILED(iCorFunction->GetToken(&methodDef)))
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    const auto key = std::make_pair(modAddress, methodDef);
+    auto find = m_moveNextMethods.find(key);
+    if (find != m_moveNextMethods.end())
+        return find->second;
+
+    bool &isMoveNext = m_moveNextMethods[key];
+    ToRelease<IUnknown> pMDUnknown;
+    ToRelease<IMetaDataImport> pMD;
+    if (FAILED(iCorModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown)) ||
+        FAILED(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD)))
+        return isMoveNext;
+
+    mdTypeDef typeDef = mdTypeDefNil;
+    WCHAR methodName[mdNameLen];
+    ULONG methodNameLen = 0;
+    if (FAILED(pMD->GetMethodProps(methodDef, &typeDef, methodName, _countof(methodName), &methodNameLen,
+                                   nullptr, nullptr, nullptr, nullptr, nullptr)))
+        return isMoveNext;
+
+    // Note, iterators state machines have `<>1__state` too, but don't have builder.
+    mdFieldDef fieldDef = mdFieldDefNil;
+    isMoveNext = to_utf8(methodName) == "MoveNext" &&
+                 SUCCEEDED(pMD->FindField(typeDef, FieldNames[int(Field::State)], nullptr, 0, &fieldDef)) &&
+                 SUCCEEDED(pMD->FindField(typeDef, FieldNames[int(Field::Builder)], nullptr, 0, &fieldDef));
+    return isMoveNext;
+}
+
+HRESULT AsyncStack::GetFrameAsyncCallers(ICorDebugProcess *pProcess, ICorDebugFrame *pFrame, std::vector<frame_t> &frames)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugILFrame> iCorILFrame;
+    IfFailRet(pFrame->QueryInterface(IID_ICorDebugILFrame, (LPVOID*) &iCorILFrame));
+    // Note, `this` is object reference for class state machine and byref for structure state machine.
+    ToRelease<ICorDebugValue> iCorThisValue;
+    IfFailRet(iCorILFrame->GetArgument(0, &iCorThisValue));
+    ToRelease<ICorDebugReferenceValue> iCorRefValue;
+    IfFailRet(iCorThisValue->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &iCorRefValue));
+    BOOL isNull = TRUE;
+    IfFailRet(iCorRefValue->IsNull(&isNull));
+    if (isNull)
+        return E_FAIL;
+
+    CORDB_ADDRESS stateMachineAddress = 0;
+    IfFailRet(iCorRefValue->GetValue(&stateMachineAddress));
+    ToRelease<ICorDebugValue> iCorStateMachine;
+    IfFailRet(iCorRefValue->Dereference(&iCorStateMachine));
+    ToRelease<ICorDebugValue2> iCorStateMachine2;
+    IfFailRet(iCorStateMachine->QueryInterface(IID_ICorDebugValue2, (LPVOID*) &iCorStateMachine2));
+    ToRelease<ICorDebugType> iCorType;
+    IfFailRet(iCorStateMachine2->GetExactType(&iCorType));
+    ToRelease<ICorDebugType2> iCorType2;
+    IfFailRet(iCorType->QueryInterface(IID_ICorDebugType2, (LPVOID*) &iCorType2));
+    COR_TYPEID stateMachineType;
+    IfFailRet(iCorType2->GetTypeID(&stateMachineType));
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    IfFailRet(Init(pProcess));
+
+    field_t builderField;
+    IfFailRet(FindField(stateMachineType, Field::Builder, builderField));
+    if (builderField.fieldType != ELEMENT_TYPE_VALUETYPE)
+        return E_FAIL;
+
+    // Note, task is created by builder at first not completed await, before this all callers are on physical stack.
+    CORDB_ADDRESS taskAddress = 0;
+    IfFailRet(GetBuilderTask(stateMachineAddress + builderField.offset, builderField.id, taskAddress));
+    if (taskAddress == 0)
+        return S_FALSE;
+
+    return GetAwaitersChain(taskAddress, frames);
+}
+
+HRESULT AsyncStack::GetTaskAsyncStack(ICorDebugProcess *pProcess, CORDB_ADDRESS taskAddress, std::vector<frame_t> &frames)
+{
+    HRESULT Status;
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    IfFailRet(Init(pProcess));
+
+    frame_t frame;
+    if (SUCCEEDED(GetBoxFrame(taskAddress, true, frame)))
+        frames.push_back(frame);
+
+    return GetAwaitersChain(taskAddress, frames);
+}
+
+HRESULT AsyncStack::GetTaskState(ICorDebugProcess *pProcess, CORDB_ADDRESS taskAddress, int32_t &stateFlags, frame_t &frame)
+{
+    HRESULT Status;
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    IfFailRet(Init(pProcess));
+
+    COR_TYPEID typeId;
+    IfFailRet(m_iCorProcess5->GetTypeID(taskAddress, &typeId));
+    field_t stateFlagsField;
+    IfFailRet(FindField(typeId, Field::StateFlags, stateFlagsField));
+    SIZE_T read = 0;
+    IfFailRet(m_pProcess->ReadMemory(taskAddress + stateFlagsField.offset, sizeof(stateFlags), (BYTE*)&stateFlags, &read));
+    if (read != sizeof(stateFlags))
+        return E_FAIL;
+
+    // Note, await point is not resolved here, since this is called for each task in heap.
+    return SUCCEEDED(GetBoxFrame(taskAddress, false, frame)) ? S_OK : S_FALSE;
+}
+
+} // namespace netcoredbg
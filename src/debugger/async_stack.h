@@ -0,0 +1,121 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "utils/torelease.h"
+
+namespace netcoredbg
+{
+
+class Modules;
+class AsyncInfo;
+
+// Async methods logical call stack, reconstructed from tasks continuations chains by raw fields reads with runtime types
+// layout (ICorDebugProcess5), so, no func-eval involved and debuggee state is not changed. Chain is followed from task of
+// state machine through `m_continuationObject` (state machine boxes, tasks, delegates, awaiting task continuations and
+// continuations lists) till first unknown continuation.
+// Note, all results are cached till InvalidateCache() call, process must be stopped.
+class AsyncStack
+{
+public:
+
+    struct frame_t
+    {
+        CORDB_ADDRESS modAddress;
+        mdMethodDef methodToken;    // state machine MoveNext()
+        ULONG32 methodVersion;
+        ULONG32 ilOffset;           // await yield offset
+        bool haveILOffset;          // false in case await info not available (no PDB, state machine is not suspended)
+        int32_t state;              // state machine `<>1__state`
+        CORDB_ADDRESS taskAddress;  // state machine box
+
+        frame_t() :
+            modAddress(0), methodToken(mdMethodDefNil), methodVersion(0), ilOffset(0), haveILOffset(false), state(0), taskAddress(0)
+        {}
+    };
+
+    AsyncStack(std::shared_ptr<Modules> &sharedModules);
+    ~AsyncStack();
+
+    // Check, that frame is MoveNext() of async method state machine.
+    bool IsAsyncMoveNextFrame(ICorDebugFrame *pFrame);
+    // Logical callers (chain of awaiting async methods) of async method state machine MoveNext() frame.
+    HRESULT GetFrameAsyncCallers(ICorDebugProcess *pProcess, ICorDebugFrame *pFrame, std::vector<frame_t> &frames);
+    // Async methods chain for task, first entry is task's own state machine in case task is state machine box.
+    HRESULT GetTaskAsyncStack(ICorDebugProcess *pProcess, CORDB_ADDRESS taskAddress, std::vector<frame_t> &frames);
+    // Task `m_stateFlags` and own state machine (without await point) in case task is state machine box.
+    // Return S_FALSE in case task is not state machine box.
+    HRESULT GetTaskState(ICorDebugProcess *pProcess, CORDB_ADDRESS taskAddress, int32_t &stateFlags, frame_t &frame);
+    // Must be called on any process continue, since tasks could be completed and continuations changed.
+    void InvalidateCache();
+
+private:
+
+    // Fields, that are used for chain reconstruction.
+    enum class Field
+    {
+        State,              // state machine `<>1__state`
+        Builder,            // state machine `<>t__builder`
+        InnerBuilder,       // AsyncVoidMethodBuilder `_builder`
+        Task,               // Async(Value)TaskMethodBuilder and TaskContinuation `m_task`
+        ContinuationObject, // Task `m_continuationObject`
+        StateMachine,       // AsyncStateMachineBox `StateMachine`
+        Action,             // AwaitTaskContinuation `m_action`
+        Target,             // Delegate `_target`
+        Continuation,       // ContinuationWrapper `_continuation`
+        Items,              // List<object> `_items`
+        Size,               // List<object> `_size`
+        StateFlags,         // Task `m_stateFlags`
+        Count
+    };
+
+    struct field_t
+    {
+        bool found;
+        ULONG32 offset;
+        CorElementType fieldType;
+        COR_TYPEID id; // value type fields only
+
+        field_t() : found(false), offset(0), fieldType(ELEMENT_TYPE_END), id() {}
+    };
+
+    std::unique_ptr<AsyncInfo> m_uniqueAsyncInfo;
+
+    // Note, mutex is held during chain reconstruction, since all caches are filled at this time.
+    std::mutex m_cacheMutex;
+    ToRelease<ICorDebugProcess5> m_iCorProcess5;
+    ICorDebugProcess *m_pProcess;
+    uint32_t m_pointerSize;
+    // Key - module address and method token, value - method is async method state machine MoveNext().
+    std::map<std::pair<CORDB_ADDRESS, mdMethodDef>, bool> m_moveNextMethods;
+    // Key - type id tokens and field.
+    std::map<std::tuple<uint64_t, uint64_t, int>, field_t> m_fields;
+    // Key - state machine type id tokens, value - MoveNext() method (module address, token and version only).
+    std::map<std::pair<uint64_t, uint64_t>, frame_t> m_stateMachineMethods;
+    // Key - task address, value - awaiting async methods chain.
+    std::unordered_map<CORDB_ADDRESS, std::vector<frame_t>> m_awaitersChains;
+
+    HRESULT Init(ICorDebugProcess *pProcess);
+    HRESULT FindField(COR_TYPEID typeId, Field field, field_t &result);
+    HRESULT ReadPointer(CORDB_ADDRESS address, CORDB_ADDRESS &value);
+    HRESULT ReadReferenceField(CORDB_ADDRESS object, Field field, CORDB_ADDRESS &value);
+    CORDB_ADDRESS ResolveContinuation(CORDB_ADDRESS object, int depth);
+    HRESULT GetBuilderTask(CORDB_ADDRESS builderAddress, COR_TYPEID builderType, CORDB_ADDRESS &taskAddress);
+    HRESULT GetStateMachineMethod(COR_TYPEID stateMachineType, frame_t &frame);
+    HRESULT GetStateMachineFrame(CORDB_ADDRESS stateMachineAddress, COR_TYPEID stateMachineType, bool resolveAwait, frame_t &frame);
+    HRESULT GetBoxFrame(CORDB_ADDRESS boxAddress, bool resolveAwait, frame_t &frame);
+    HRESULT GetAwaitersChain(CORDB_ADDRESS taskAddress, std::vector<frame_t> &frames);
+};
+
+} // namespace netcoredbg
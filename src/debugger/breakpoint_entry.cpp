@@ -11,6 +11,81 @@
 namespace netcoredbg
 {
 
+static HRESULT ReadImageMemory(ICorDebugProcess *pProcess, CORDB_ADDRESS address, void *buffer, DWORD size)
+{
+    HRESULT Status;
+    SIZE_T read = 0;
+    IfFailRet(pProcess->ReadMemory(address, size, (BYTE*)buffer, &read));
+    return read == size ? S_OK : E_FAIL;
+}
+
+// Read entry point token from CLR header of already loaded by runtime module image, so, no file system access needed.
+// Note, return S_OK with mdMethodDefNil in case module don't have managed entry point (for example, library).
+static HRESULT GetEntryPointTokenFromMemory(ICorDebugModule *pModule, mdMethodDef &entryPointToken)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugProcess> pProcess;
+    IfFailRet(pModule->GetProcess(&pProcess));
+    CORDB_ADDRESS baseAddress;
+    IfFailRet(pModule->GetBaseAddress(&baseAddress));
+
+    IMAGE_DOS_HEADER dosHeader;
+    IfFailRet(ReadImageMemory(pProcess, baseAddress, &dosHeader, sizeof(dosHeader)));
+    if (dosHeader.e_magic != VAL16(IMAGE_DOS_SIGNATURE))
+        return E_FAIL;
+
+    const CORDB_ADDRESS ntHeadersAddress = baseAddress + VAL32(dosHeader.e_lfanew);
+    IMAGE_NT_HEADERS32 ntHeaders;
+    IfFailRet(ReadImageMemory(pProcess, ntHeadersAddress, &ntHeaders, sizeof(ntHeaders)));
+    if (ntHeaders.Signature != VAL32(IMAGE_NT_SIGNATURE))
+        return E_FAIL;
+
+    ULONG corRVA = 0;
+    if (ntHeaders.OptionalHeader.Magic == VAL16(IMAGE_NT_OPTIONAL_HDR32_MAGIC))
+    {
+        corRVA = VAL32(ntHeaders.OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_COMHEADER].VirtualAddress);
+    }
+    else
+    {
+        IMAGE_NT_HEADERS64 ntHeaders64;
+        IfFailRet(ReadImageMemory(pProcess, ntHeadersAddress, &ntHeaders64, sizeof(ntHeaders64)));
+        corRVA = VAL32(ntHeaders64.OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_COMHEADER].VirtualAddress);
+    }
+
+    CORDB_ADDRESS sectionAddress = ntHeadersAddress + sizeof(ntHeaders.Signature) + sizeof(ntHeaders.FileHeader) +
+                                   VAL16(ntHeaders.FileHeader.SizeOfOptionalHeader);
+    for (int i = 0; i < VAL16(ntHeaders.FileHeader.NumberOfSections); i++, sectionAddress += sizeof(IMAGE_SECTION_HEADER))
+    {
+        IMAGE_SECTION_HEADER sectionHeader;
+        IfFailRet(ReadImageMemory(pProcess, sectionAddress, &sectionHeader, sizeof(sectionHeader)));
+
+        if (corRVA < VAL32(sectionHeader.VirtualAddress) ||
+            corRVA >= VAL32(sectionHeader.VirtualAddress) + VAL32(sectionHeader.SizeOfRawData))
+            continue;
+
+        // Note, runtime could load image as mapped (sections at RVA) or as flat (file) layout, check both.
+        const CORDB_ADDRESS corAddresses[] = {
+            baseAddress + corRVA,
+            baseAddress + (corRVA - VAL32(sectionHeader.VirtualAddress)) + VAL32(sectionHeader.PointerToRawData)
+        };
+        for (CORDB_ADDRESS corAddress : corAddresses)
+        {
+            IMAGE_COR20_HEADER corHeader;
+            if (FAILED(ReadImageMemory(pProcess, corAddress, &corHeader, sizeof(corHeader))) ||
+                VAL32(corHeader.cb) != sizeof(IMAGE_COR20_HEADER))
+                continue;
+
+            entryPointToken = (VAL32(corHeader.Flags) & COMIMAGE_FLAGS_NATIVE_ENTRYPOINT) ? mdMethodDefNil : VAL32(corHeader.EntryPointToken);
+            return S_OK;
+        }
+
+        return E_FAIL;
+    }
+
+    entryPointToken = mdMethodDefNil;
+    return S_OK;
+}
+
 static mdMethodDef GetEntryPointTokenFromFile(const std::string &path)
 {
     class scope_guard
@@ -103,51 +178,24 @@ static HRESULT TrySetupAsyncEntryBreakpoint(ICorDebugModule *pModule, IMetaDataI
     // `Namespace.ClassName.Main()`, that create `Namespace.ClassName.<Main>d__0` and start state machine routine.
     // In this case, "real entry method" with user code from initial `Main()` method will be in:
     // Namespace.ClassName.<Main>d__0.MoveNext()
-    // Note, number in "<Main>d__0" class name could be different.
     // Note, `Namespace.ClassName` could be different (see `-main` compiler option).
-    // Note, `Namespace.ClassName.<Main>d__0` type have enclosing class as method `Namespace.ClassName.<Main>()` class.
-    HRESULT Status;
-     ULONG numTypedefs = 0;
+    // Note, PDB have kickoff method `Namespace.ClassName.Main()` to state machine `MoveNext()` method map,
+    // so, we don't need find `<Main>d__N` state machine type by name in all module's types.
+    mdMethodDef mainTokens[8];
+    ULONG mainTokensCount = 0;
     HCORENUM hEnum = NULL;
-    mdTypeDef typeDef;
+    HRESULT Status = pMD->EnumMethodsWithName(&hEnum, mdMainClass, W("Main"), mainTokens, _countof(mainTokens), &mainTokensCount);
+    pMD->CloseEnum(hEnum);
+    IfFailRet(Status);
+
     mdMethodDef resultToken = mdMethodDefNil;
-    while(SUCCEEDED(pMD->EnumTypeDefs(&hEnum, &typeDef, 1, &numTypedefs)) && numTypedefs != 0 && resultToken == mdMethodDefNil)
+    for (ULONG i = 0; i < mainTokensCount; i++)
     {
-        mdTypeDef mdEnclosingClass;
-        if (FAILED(pMD->GetNestedClassProps(typeDef, &mdEnclosingClass) ||
-            mdEnclosingClass != mdMainClass))
-            continue;
+        if (SUCCEEDED(pModules->GetStateMachineMethod(pModule, mainTokens[i], resultToken)))
+            break;
 
-        DWORD flags;
-        WCHAR className[mdNameLen];
-        ULONG classNameLen;
-        IfFailRet(pMD->GetTypeDefProps(typeDef, className, _countof(className), &classNameLen, &flags, NULL));
-        if (!starts_with(className, W("<Main>d__")))
-            continue;
-
-        ULONG numMethods = 0;
-        HCORENUM fEnum = NULL;
-        mdMethodDef methodDef;
-        while(SUCCEEDED(pMD->EnumMethods(&fEnum, typeDef, &methodDef, 1, &numMethods)) && numMethods != 0)
-        {
-            mdTypeDef memTypeDef;
-            WCHAR funcName[mdNameLen];
-            ULONG funcNameLen;
-            if (FAILED(pMD->GetMethodProps(methodDef, &memTypeDef, funcName, _countof(funcName), &funcNameLen,
-                                            nullptr, nullptr, nullptr, nullptr, nullptr)))
-            {
-                continue;
-            }
-
-            if (str_equal(funcName, W("MoveNext")))
-            {
-                resultToken = methodDef;
-                break;
-            }
-        }
-        pMD->CloseEnum(fEnum);
+        resultToken = mdMethodDefNil;
     }
-    pMD->CloseEnum(hEnum);
 
     if (resultToken == mdMethodDefNil)
         return E_FAIL;
@@ -170,7 +218,9 @@ HRESULT EntryBreakpoint::ManagedCallbackLoadModule(ICorDebugModule *pModule)
         return S_FALSE;
 
     HRESULT Status;
-    mdMethodDef entryPointToken = GetEntryPointTokenFromFile(GetModuleFileName(pModule));
+    mdMethodDef entryPointToken = mdMethodDefNil;
+    if (FAILED(GetEntryPointTokenFromMemory(pModule, entryPointToken)))
+        entryPointToken = GetEntryPointTokenFromFile(GetModuleFileName(pModule));
     // Note, by some reason, in CoreCLR 6.0 System.Private.CoreLib.dll have Token "0" as entry point RVA.
     if (entryPointToken == mdMethodDefNil ||
         TypeFromToken(entryPointToken) != mdtMethodDef)
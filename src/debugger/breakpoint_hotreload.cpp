@@ -110,6 +110,12 @@ void HotReloadBreakpoint::CheckApplicationReload(ICorDebugThread *pThread)
     Clear();
 }
 
+bool HotReloadBreakpoint::IsApplicationReloadPending()
+{
+    std::lock_guard<std::mutex> lock(m_reloadMutex);
+    return m_iCorFuncBreakpoint != nullptr;
+}
+
 void HotReloadBreakpoint::Delete()
 {
     std::lock_guard<std::mutex> lock(m_reloadMutex);
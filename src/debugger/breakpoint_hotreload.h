@@ -38,6 +38,8 @@ public:
     // S_FALSE - not internal HotReload breakpoint hit
     HRESULT CheckApplicationReload(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint);
     void CheckApplicationReload(ICorDebugThread *pThread);
+    // Return true in case application update was not applied yet (callbacks must reach CheckApplicationReload() call).
+    bool IsApplicationReloadPending();
 
     HRESULT ManagedCallbackLoadModuleAll(ICorDebugModule *pModule);
 
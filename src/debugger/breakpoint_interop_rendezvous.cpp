@@ -28,10 +28,11 @@ bool InteropRendezvousBreakpoint::SetupRendezvousBrk(pid_t pid, LoadLibCallback
         err_code = ENODATA;
         return false;
     }
+    m_processMaps.Refresh(pid, 0);
     GetProcessLibs(pid, m_rendezvousAddr, [this, &pid] (const std::string &libName, std::uintptr_t startAddr)
     {
         std::string realLibName;
-        std::uintptr_t endAddr = GetLibEndAddrAndRealName(pid, 0, realLibName, startAddr);
+        std::uintptr_t endAddr = m_processMaps.GetLibEndAddrAndRealName(startAddr, realLibName);
         if (endAddr == 0 || realLibName.empty()) // ignore in case error or linux-vdso.so
             return;
         m_loadLibCB(pid, libName, realLibName, startAddr, endAddr);
@@ -61,13 +62,15 @@ void InteropRendezvousBreakpoint::ChangeRendezvousState(pid_t TGID, pid_t pid)
     {
         if (m_rendezvousBrkState == r_debug::RT_ADD)
         {
-            GetProcessLibs(TGID, m_rendezvousAddr, [this, &TGID, &pid] (const std::string &libName, std::uintptr_t startAddr)
+            // Note, maps are read only once for all loaded libraries.
+            m_processMaps.Refresh(TGID, pid);
+            GetProcessLibs(TGID, m_rendezvousAddr, [this, &pid] (const std::string &libName, std::uintptr_t startAddr)
             {
                 if (m_libsNameToRealNameMap.find(libName) != m_libsNameToRealNameMap.end())
                     return;
 
                 std::string realLibName;
-                std::uintptr_t endAddr = GetLibEndAddrAndRealName(TGID, pid, realLibName, startAddr);
+                std::uintptr_t endAddr = m_processMaps.GetLibEndAddrAndRealName(startAddr, realLibName);
                 if (endAddr == 0 || realLibName.empty()) // ignore in case error or linux-vdso.so
                     return;
                 m_loadLibCB(pid, libName, realLibName, startAddr, endAddr);
@@ -111,6 +114,7 @@ void InteropRendezvousBreakpoint::RemoveAtDetach(pid_t pid)
     m_rendezvousBrkState = 0;
     m_brkAddr = 0;
     m_libsNameToRealNameMap.clear();
+    m_processMaps.Clear();
 }
 
 } // namespace InteropDebugging
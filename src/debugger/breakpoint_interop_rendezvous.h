@@ -10,6 +10,7 @@
 #include <functional>
 #include <unordered_map>
 #include "debugger/interop_ptrace_helpers.h"
+#include "debugger/interop_mem_helpers.h"
 
 
 namespace netcoredbg
@@ -48,6 +49,7 @@ private:
     UnloadLibCallback m_unloadLibCB;
     // Mapping for lib's name stored in rendezvous linked list and real lib's full path.
     std::unordered_map<std::string, std::string> m_libsNameToRealNameMap;
+    InteropDebugging::ProcessMaps m_processMaps;
 
 };
 
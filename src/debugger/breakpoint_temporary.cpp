@@ -0,0 +1,99 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/breakpoint_temporary.h"
+#include "debugger/breakpointutils.h"
+#include "metadata/modules.h"
+
+namespace netcoredbg
+{
+
+static HRESULT CreateFunctionBreakpoint(ICorDebugModule *pModule, mdMethodDef methodToken, ULONG32 ilOffset,
+                                        ToRelease<ICorDebugFunctionBreakpoint> &iCorFuncBreakpoint)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugFunction> pFunc;
+    IfFailRet(pModule->GetFunctionFromToken(methodToken, &pFunc));
+    ToRelease<ICorDebugCode> pCode;
+    IfFailRet(pFunc->GetILCode(&pCode));
+    IfFailRet(pCode->CreateBreakpoint(ilOffset, &iCorFuncBreakpoint));
+    return S_OK;
+}
+
+void TemporaryBreakpoint::DeleteUnlocked()
+{
+    for (auto &iCorFuncBreakpoint : m_iCorFuncBreakpoints)
+    {
+        iCorFuncBreakpoint->Activate(FALSE);
+    }
+    m_iCorFuncBreakpoints.clear();
+}
+
+void TemporaryBreakpoint::Delete()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    DeleteUnlocked();
+}
+
+HRESULT TemporaryBreakpoint::SetAtLine(const std::string &filename, int linenum)
+{
+    HRESULT Status;
+    unsigned fullnameIndex = 0;
+    std::vector<ModulesSources::resolved_bp_t> resolvedPoints;
+    IfFailRet(m_sharedModules->ResolveBreakpoint(0, filename, fullnameIndex, linenum, resolvedPoints));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    DeleteUnlocked();
+
+    // Note, same line could have code in several methods (for example, lambda), stop at first reached.
+    for (const auto &resolvedBP : resolvedPoints)
+    {
+        if (FAILED(Status = BreakpointUtils::SkipBreakpoint(resolvedBP.iCorModule, resolvedBP.methodToken, m_justMyCode)) ||
+            Status == S_OK) // S_FALSE - don't skip breakpoint
+            continue;
+
+        ToRelease<ICorDebugFunctionBreakpoint> iCorFuncBreakpoint;
+        if (SUCCEEDED(CreateFunctionBreakpoint(resolvedBP.iCorModule, resolvedBP.methodToken, resolvedBP.ilOffset, iCorFuncBreakpoint)))
+            m_iCorFuncBreakpoints.emplace_back(iCorFuncBreakpoint.Detach());
+    }
+
+    return m_iCorFuncBreakpoints.empty() ? E_FAIL : S_OK;
+}
+
+HRESULT TemporaryBreakpoint::SetAtMethod(ICorDebugModule *pModule, mdMethodDef methodToken, ULONG32 ilOffset)
+{
+    HRESULT Status;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    DeleteUnlocked();
+
+    ToRelease<ICorDebugFunctionBreakpoint> iCorFuncBreakpoint;
+    IfFailRet(CreateFunctionBreakpoint(pModule, methodToken, ilOffset, iCorFuncBreakpoint));
+    m_iCorFuncBreakpoints.emplace_back(iCorFuncBreakpoint.Detach());
+    return S_OK;
+}
+
+HRESULT TemporaryBreakpoint::CheckBreakpointHit(ICorDebugBreakpoint *pBreakpoint)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_iCorFuncBreakpoints.empty())
+        return S_FALSE; // S_FALSE - no error, but not affect on callback
+
+    HRESULT Status;
+    ToRelease<ICorDebugFunctionBreakpoint> pFunctionBreakpoint;
+    IfFailRet(pBreakpoint->QueryInterface(IID_ICorDebugFunctionBreakpoint, (LPVOID*) &pFunctionBreakpoint));
+
+    for (const auto &iCorFuncBreakpoint : m_iCorFuncBreakpoints)
+    {
+        if (FAILED(BreakpointUtils::IsSameFunctionBreakpoint(pFunctionBreakpoint, iCorFuncBreakpoint)))
+            continue;
+
+        DeleteUnlocked();
+        return S_OK;
+    }
+
+    return S_FALSE;
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,55 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "utils/torelease.h"
+
+namespace netcoredbg
+{
+
+class Modules;
+
+// Internal one-shot breakpoint for "run to cursor" and "step into target", not visible for protocol as breakpoint.
+// Note, all runtime breakpoints are removed at first hit in any thread, or at any other debuggee stop (see DeleteAll()).
+class TemporaryBreakpoint
+{
+public:
+
+    TemporaryBreakpoint(std::shared_ptr<Modules> &sharedModules) :
+        m_sharedModules(sharedModules),
+        m_justMyCode(true)
+    {}
+
+    void SetJustMyCode(bool enable) { m_justMyCode = enable; }
+
+    // Replace previous temporary breakpoint by breakpoints at all methods with code at source line (or next line with code).
+    HRESULT SetAtLine(const std::string &filename, int linenum);
+    // Replace previous temporary breakpoint by breakpoint at method's IL offset.
+    HRESULT SetAtMethod(ICorDebugModule *pModule, mdMethodDef methodToken, ULONG32 ilOffset);
+    void Delete();
+
+    // Important! Must provide succeeded return code:
+    // S_OK - breakpoint hit
+    // S_FALSE - no breakpoint hit
+    HRESULT CheckBreakpointHit(ICorDebugBreakpoint *pBreakpoint);
+
+private:
+
+    std::mutex m_mutex;
+    std::shared_ptr<Modules> m_sharedModules;
+    std::vector<ToRelease<ICorDebugFunctionBreakpoint> > m_iCorFuncBreakpoints;
+    bool m_justMyCode;
+
+    void DeleteUnlocked();
+};
+
+} // namespace netcoredbg
@@ -8,9 +8,11 @@
 #include "debugger/breakpoints_func.h"
 #include "debugger/breakpoints_line.h"
 #include "debugger/breakpoint_hotreload.h"
+#include "debugger/breakpoint_temporary.h"
 #include "debugger/breakpoint_interop_rendezvous.h"
 #include "debugger/breakpoints_interop.h"
 #include "debugger/breakpoints_interop_line.h"
+#include "debugger/breakpoints_interop_data.h"
 #include "debugger/breakpoints.h"
 #include "debugger/breakpointutils.h"
 #include "debugger/interop_brk_helpers.h"
@@ -21,6 +23,11 @@
 #include <algorithm>
 #include <iterator>
 #include <sstream>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+#include "metadata/metadata_index.h"
 #include "metadata/modules.h"
 #include "metadata/typeprinter.h"
 #include "utils/logger.h"
@@ -40,19 +47,71 @@ Breakpoints::Breakpoints(std::shared_ptr<Modules> &sharedModules, std::shared_pt
         m_uniqueFuncBreakpoints(new FuncBreakpoints(sharedModules, sharedVariables)),
         m_uniqueLineBreakpoints(new LineBreakpoints(sharedModules, sharedVariables)),
         m_uniqueHotReloadBreakpoint(new HotReloadBreakpoint(sharedModules, sharedEvaluator, sharedEvalHelpers)),
+        m_uniqueTemporaryBreakpoint(new TemporaryBreakpoint(sharedModules)),
 #ifdef INTEROP_DEBUGGING
         m_sharedInteropBreakpoints(new InteropDebugging::InteropBreakpoints()),
         m_uniqueInteropRendezvousBreakpoint(new InteropDebugging::InteropRendezvousBreakpoint(m_sharedInteropBreakpoints)),
         m_sharedInteropLineBreakpoints(new InteropDebugging::InteropLineBreakpoints(m_sharedInteropBreakpoints)),
+        m_uniqueInteropDataBreakpoints(new InteropDebugging::InteropDataBreakpoints()),
 #endif // INTEROP_DEBUGGING
-        m_nextBreakpointId(1)
+        m_nextBreakpointId(1),
+        m_allManagedDisabled(false),
+        m_activationEpoch(0),
+        m_activationPending(false),
+        m_activationRunning(false),
+        m_activationExit(false)
     {}
 
+Breakpoints::~Breakpoints()
+{
+    std::unique_lock<std::mutex> lock(m_activationMutex);
+    m_activationExit = true;
+    m_activationEpoch++;
+    m_activationCV.notify_all();
+    lock.unlock();
+
+    if (m_activationWorker.joinable())
+        m_activationWorker.join();
+}
+
+void Breakpoints::ActivationWorker()
+{
+    std::unique_lock<std::mutex> lock(m_activationMutex);
+    while (true)
+    {
+        m_activationCV.wait(lock, [this]{ return m_activationExit || m_activationPending; });
+        if (m_activationExit)
+            return;
+
+        m_activationPending = false;
+        m_activationRunning = true;
+        const uint64_t epoch = m_activationEpoch;
+        lock.unlock();
+
+        auto isCanceled = [this, epoch]() { return m_activationEpoch != epoch; };
+        m_uniqueLineBreakpoints->ApplyAllBreakpointsActivation(isCanceled);
+        m_uniqueFuncBreakpoints->ApplyAllBreakpointsActivation(isCanceled);
+
+        lock.lock();
+        m_activationRunning = false;
+        m_activationCV.notify_all();
+    }
+}
+
+void Breakpoints::CancelActivation()
+{
+    std::unique_lock<std::mutex> lock(m_activationMutex);
+    m_activationPending = false;
+    m_activationEpoch++;
+    m_activationCV.wait(lock, [this]{ return !m_activationRunning; });
+}
+
 void Breakpoints::SetJustMyCode(bool enable)
 {
     m_uniqueFuncBreakpoints->SetJustMyCode(enable);
     m_uniqueLineBreakpoints->SetJustMyCode(enable);
     m_uniqueExceptionBreakpoints->SetJustMyCode(enable);
+    m_uniqueTemporaryBreakpoint->SetJustMyCode(enable);
 }
 
 void Breakpoints::SetLastStoppedIlOffset(ICorDebugProcess *pProcess, const ThreadId &lastStoppedThreadId)
@@ -72,7 +131,10 @@ HRESULT Breakpoints::ManagedCallbackBreak(ICorDebugThread *pThread, const Thread
 
 void Breakpoints::DeleteAllManaged()
 {
+    CancelActivation();
+    m_allManagedDisabled = false;
     m_uniqueEntryBreakpoint->Delete();
+    m_uniqueTemporaryBreakpoint->Delete();
     m_uniqueFuncBreakpoints->DeleteAll();
     m_uniqueLineBreakpoints->DeleteAll();
     m_uniqueExceptionBreakpoints->DeleteAll();
@@ -108,6 +170,8 @@ HRESULT Breakpoints::DisableAllManaged(ICorDebugProcess *pProcess)
 
 HRESULT Breakpoints::SetFuncBreakpoints(bool haveProcess, const std::vector<FuncBreakpoint> &funcBreakpoints, std::vector<Breakpoint> &breakpoints)
 {
+    // Note, new breakpoints are enabled.
+    m_allManagedDisabled = false;
     return m_uniqueFuncBreakpoints->SetFuncBreakpoints(haveProcess, funcBreakpoints, breakpoints, [&]() -> uint32_t
     {
         std::lock_guard<std::mutex> lock(m_nextBreakpointIdMutex);
@@ -117,11 +181,13 @@ HRESULT Breakpoints::SetFuncBreakpoints(bool haveProcess, const std::vector<Func
 
 HRESULT Breakpoints::UpdateLineBreakpoint(bool haveProcess, int id, int linenum, Breakpoint &breakpoint)
 {
+    m_allManagedDisabled = false;
     return m_uniqueLineBreakpoints->UpdateLineBreakpoint(haveProcess, id, linenum, breakpoint);
 }
 
 HRESULT Breakpoints::SetLineBreakpoints(bool haveProcess, const std::string& filename, const std::vector<LineBreakpoint> &lineBreakpoints, std::vector<Breakpoint> &breakpoints)
 {
+    m_allManagedDisabled = false;
     return m_uniqueLineBreakpoints->SetLineBreakpoints(haveProcess, filename, lineBreakpoints, breakpoints, [&]() -> uint32_t
     {
         std::lock_guard<std::mutex> lock(m_nextBreakpointIdMutex);
@@ -129,6 +195,21 @@ HRESULT Breakpoints::SetLineBreakpoints(bool haveProcess, const std::string& fil
     });
 }
 
+HRESULT Breakpoints::SetTemporaryBreakpoint(const std::string &filename, int linenum)
+{
+    return m_uniqueTemporaryBreakpoint->SetAtLine(filename, linenum);
+}
+
+HRESULT Breakpoints::SetTemporaryBreakpoint(ICorDebugModule *pModule, mdMethodDef methodToken, ULONG32 ilOffset)
+{
+    return m_uniqueTemporaryBreakpoint->SetAtMethod(pModule, methodToken, ilOffset);
+}
+
+void Breakpoints::DeleteTemporaryBreakpoint()
+{
+    m_uniqueTemporaryBreakpoint->Delete();
+}
+
 HRESULT Breakpoints::SetExceptionBreakpoints(const std::vector<ExceptionBreakpoint> &exceptionBreakpoints, std::vector<Breakpoint> &breakpoints)
 {
     return m_uniqueExceptionBreakpoints->SetExceptionBreakpoints(exceptionBreakpoints, breakpoints, [&]() -> uint32_t
@@ -138,10 +219,11 @@ HRESULT Breakpoints::SetExceptionBreakpoints(const std::vector<ExceptionBreakpoi
     });
 }
 
-HRESULT Breakpoints::UpdateBreakpointsOnHotReload(ICorDebugModule *pModule, std::unordered_set<mdMethodDef> &methodTokens, std::vector<BreakpointEvent> &events)
+HRESULT Breakpoints::UpdateBreakpointsOnHotReload(ICorDebugModule *pModule, std::unordered_set<mdMethodDef> &methodTokens, std::unordered_set<unsigned> &updatedSources,
+                                                  std::vector<BreakpointEvent> &events)
 {
     m_uniqueFuncBreakpoints->UpdateBreakpointsOnHotReload(pModule, methodTokens, events);
-    m_uniqueLineBreakpoints->UpdateBreakpointsOnHotReload(pModule, methodTokens, events);
+    m_uniqueLineBreakpoints->UpdateBreakpointsOnHotReload(pModule, updatedSources, events);
     return S_OK;
 }
 
@@ -150,13 +232,257 @@ HRESULT Breakpoints::GetExceptionInfo(ICorDebugThread *pThread, ExceptionInfo &e
     return m_uniqueExceptionBreakpoints->GetExceptionInfo(pThread, exceptionInfo);
 }
 
-HRESULT Breakpoints::ManagedCallbackBreakpoint(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint, bool &atEntry)
+void Breakpoints::SetExceptionStatistics(bool enable)
+{
+    m_uniqueExceptionBreakpoints->SetExceptionStatistics(enable);
+}
+
+bool Breakpoints::IsExceptionStatistics()
+{
+    return m_uniqueExceptionBreakpoints->IsExceptionStatistics();
+}
+
+HRESULT Breakpoints::GetExceptionStatistics(Modules *pModules, std::vector<ExceptionStatistic> &statistics, uint64_t &droppedCount, bool reset)
+{
+    return m_uniqueExceptionBreakpoints->GetExceptionStatistics(pModules, statistics, droppedCount, reset);
+}
+
+namespace
+{
+
+    // Read argument value directly from frame (no evaluation), objects are stored by address.
+    HRESULT ReadTraceArg(ICorDebugILFrame *pILFrame, DWORD index, TraceBuffer::arg_t &arg)
+    {
+        HRESULT Status;
+        ToRelease<ICorDebugValue> iCorValue;
+        IfFailRet(pILFrame->GetArgument(index, &iCorValue));
+        CorElementType corType;
+        IfFailRet(iCorValue->GetType(&corType));
+        arg.type = corType;
+        arg.value = 0;
+
+        ToRelease<ICorDebugReferenceValue> iCorRefValue;
+        if (SUCCEEDED(iCorValue->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &iCorRefValue)))
+        {
+            CORDB_ADDRESS address = 0;
+            IfFailRet(iCorRefValue->GetValue(&address));
+            arg.value = address;
+            return S_OK;
+        }
+
+        // Note, value types bigger than 8 bytes are recorded with type only.
+        ULONG32 size = 0;
+        ToRelease<ICorDebugGenericValue> iCorGenericValue;
+        if (SUCCEEDED(iCorValue->GetSize(&size)) && size <= sizeof(arg.value) &&
+            SUCCEEDED(iCorValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &iCorGenericValue)))
+        {
+            IfFailRet(iCorGenericValue->GetValue(&arg.value));
+        }
+
+        return S_OK;
+    }
+
+    HRESULT AddTraceRecord(TraceBuffer &traceBuffer, ICorDebugThread *pThread, uint32_t id, unsigned traceArgs)
+    {
+        TraceBuffer::record_t record = TraceBuffer::record_t();
+        record.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        record.breakpointId = id;
+
+        HRESULT Status;
+        DWORD threadId = 0;
+        IfFailRet(pThread->GetID(&threadId));
+        record.threadId = threadId;
+
+        ToRelease<ICorDebugFrame> iCorFrame;
+        ToRelease<ICorDebugFunction> iCorFunction;
+        ToRelease<ICorDebugModule> iCorModule;
+        ToRelease<ICorDebugILFrame> iCorILFrame;
+        CORDB_ADDRESS modAddress = 0;
+        mdMethodDef methodDef = mdMethodDefNil;
+        ULONG32 ilOffset = 0;
+        CorDebugMappingResult mappingResult;
+        IfFailRet(pThread->GetActiveFrame(&iCorFrame));
+        if (iCorFrame == nullptr)
+            return E_FAIL;
+        IfFailRet(iCorFrame->GetFunction(&iCorFunction));
+        IfFailRet(iCorFunction->GetToken(&methodDef));
+        IfFailRet(iCorFunction->GetModule(&iCorModule));
+        IfFailRet(iCorModule->GetBaseAddress(&modAddress));
+        IfFailRet(iCorFrame->QueryInterface(IID_ICorDebugILFrame, (LPVOID*) &iCorILFrame));
+        IfFailRet(iCorILFrame->GetIP(&ilOffset, &mappingResult));
+        record.module = modAddress;
+        record.methodToken = methodDef;
+        record.ilOffset = ilOffset;
+
+        // Note, hit is recorded even if some argument can't be read, record have all arguments that were read before.
+        for (unsigned i = 0; i < traceArgs && i < TraceBuffer::MaxArgs; i++)
+        {
+            if (FAILED(ReadTraceArg(iCorILFrame, i, record.args[i])))
+                break;
+            record.argsCount++;
+        }
+
+        traceBuffer.Push(record);
+        return S_OK;
+    }
+
+    std::string FormatTraceArg(const TraceBuffer::arg_t &arg)
+    {
+        std::ostringstream ss;
+        switch (CorElementType(arg.type))
+        {
+            case ELEMENT_TYPE_BOOLEAN: ss << ((arg.value & 0xff) ? "true" : "false"); break;
+            case ELEMENT_TYPE_CHAR: ss << uint16_t(arg.value); break;
+            case ELEMENT_TYPE_I1: ss << int(int8_t(arg.value)); break;
+            case ELEMENT_TYPE_U1: ss << unsigned(uint8_t(arg.value)); break;
+            case ELEMENT_TYPE_I2: ss << int16_t(arg.value); break;
+            case ELEMENT_TYPE_U2: ss << uint16_t(arg.value); break;
+            case ELEMENT_TYPE_I4: ss << int32_t(arg.value); break;
+            case ELEMENT_TYPE_U4: ss << uint32_t(arg.value); break;
+            case ELEMENT_TYPE_I8:
+            case ELEMENT_TYPE_I: ss << int64_t(arg.value); break;
+            case ELEMENT_TYPE_U8:
+            case ELEMENT_TYPE_U: ss << arg.value; break;
+            case ELEMENT_TYPE_R4:
+            {
+                float value;
+                uint32_t bits = uint32_t(arg.value);
+                memcpy(&value, &bits, sizeof(value));
+                ss << value;
+                break;
+            }
+            case ELEMENT_TYPE_R8:
+            {
+                double value;
+                memcpy(&value, &arg.value, sizeof(value));
+                ss << value;
+                break;
+            }
+            case ELEMENT_TYPE_STRING:
+            case ELEMENT_TYPE_CLASS:
+            case ELEMENT_TYPE_OBJECT:
+            case ELEMENT_TYPE_SZARRAY:
+            case ELEMENT_TYPE_ARRAY:
+            case ELEMENT_TYPE_BYREF:
+            case ELEMENT_TYPE_PTR:
+                if (arg.value == 0)
+                    ss << "null";
+                else
+                    ss << "0x" << std::hex << arg.value;
+                break;
+            default:
+                ss << "{...}";
+                break;
+        }
+        return ss.str();
+    }
+
+} // unnamed namespace
+
+bool Breakpoints::ManagedCallbackTraceBreakpoint(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint)
+{
+    // All breakpoints were deactivated, regular hit check will continue callback.
+    if (m_allManagedDisabled)
+        return false;
+
+    bool record = false;
+    uint32_t id = 0;
+    unsigned traceArgs = 0;
+    if (m_uniqueLineBreakpoints->CheckTraceBreakpointHit(pBreakpoint, record, id, traceArgs) != S_OK &&
+        m_uniqueFuncBreakpoints->CheckTraceBreakpointHit(pBreakpoint, record, id, traceArgs) != S_OK)
+        return false;
+
+    if (record && FAILED(AddTraceRecord(m_traceBuffer, pThread, id, traceArgs)))
+        LOGW("Failed to record trace point %u hit", id);
+
+    return true;
+}
+
+HRESULT Breakpoints::GetTraceRecords(Modules *pModules, std::vector<TraceRecord> &records, uint64_t &overwrittenCount, bool drain)
+{
+    overwrittenCount = m_traceBuffer.GetOverwrittenCount();
+    std::vector<TraceBuffer::record_t> traceRecords;
+    m_traceBuffer.GetRecords(traceRecords, drain);
+
+    struct module_names_t
+    {
+        std::string name;
+        MetadataIndex::index_ptr_t index;
+        std::unordered_map<mdMethodDef, size_t> methods; // method token -> method index in metadata index
+    };
+    std::map<CORDB_ADDRESS, module_names_t> modules;
+    for (const auto &traceRecord : traceRecords)
+    {
+        modules.emplace(traceRecord.module, module_names_t());
+    }
+
+    // Note, names are resolved for loaded modules only, unloaded modules records are reported with tokens.
+    HRESULT Status;
+    IfFailRet(pModules->ForEachModule([&](ICorDebugModule *pModule)
+    {
+        CORDB_ADDRESS modAddress = 0;
+        if (FAILED(pModule->GetBaseAddress(&modAddress)))
+            return S_OK;
+
+        auto find = modules.find(modAddress);
+        if (find == modules.end())
+            return S_OK;
+
+        module_names_t &names = find->second;
+        names.name = GetBasename(GetModuleFileName(pModule));
+        if (FAILED(MetadataIndex::GetModuleIndex(pModule, names.index)))
+            return S_OK;
+
+        for (size_t i = 0; i < names.index->methods.size(); i++)
+        {
+            names.methods.emplace(names.index->methods[i].methodDef, i);
+        }
+        return S_OK;
+    }));
+
+    records.reserve(records.size() + traceRecords.size());
+    for (const auto &traceRecord : traceRecords)
+    {
+        records.emplace_back();
+        TraceRecord &record = records.back();
+        record.timestamp = traceRecord.timestamp;
+        record.threadId = ThreadId(int(traceRecord.threadId));
+        record.breakpointId = traceRecord.breakpointId;
+        record.ilOffset = traceRecord.ilOffset;
+        for (uint32_t i = 0; i < traceRecord.argsCount; i++)
+        {
+            record.args.emplace_back(FormatTraceArg(traceRecord.args[i]));
+        }
+
+        const module_names_t &names = modules[traceRecord.module];
+        record.module = names.name;
+        auto method = names.methods.find(traceRecord.methodToken);
+        if (method != names.methods.end())
+        {
+            record.method = names.index->GetMethodFullName(names.index->methods[method->second]);
+            continue;
+        }
+
+        std::ostringstream ss;
+        ss << "<token 0x" << std::hex << traceRecord.methodToken << ">";
+        record.method = ss.str();
+    }
+
+    return S_OK;
+}
+
+void Breakpoints::ClearTraceRecords()
+{
+    m_traceBuffer.Clear();
+}
+
+HRESULT Breakpoints::ManagedCallbackBreakpoint(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint, bool &atEntry, bool &atTemporary, std::string &logOutput)
 {
     // CheckBreakpointHit return:
     //     S_OK - breakpoint hit
     //     S_FALSE - no breakpoint hit.
     // ManagedCallbackBreakpoint return:
-    //     S_OK - callback should be interrupted without event emit
+    //     S_OK - callback should be interrupted without event emit (in case of log point hit, `logOutput` provide message)
     //     S_FALSE - callback should not be interrupted and emit stop event
 
     HRESULT Status;
@@ -168,6 +494,25 @@ HRESULT Breakpoints::ManagedCallbackBreakpoint(ICorDebugThread *pThread, ICorDeb
         return S_FALSE; // S_FALSE - not affect on callback (callback will emit stop event)
     }
 
+    // Note, temporary breakpoint is set by user request (run to cursor or step into target), so, checked before "all
+    // breakpoints" deactivation and JMC status checks.
+    atTemporary = false;
+    if (SUCCEEDED(Status = m_uniqueTemporaryBreakpoint->CheckBreakpointHit(pBreakpoint)) &&
+        Status == S_OK) // S_FALSE - no breakpoint hit
+    {
+        atTemporary = true;
+        return S_FALSE; // S_FALSE - not affect on callback (callback will emit stop event)
+    }
+
+    // All breakpoints were deactivated, but background worker could not deactivate this runtime breakpoint yet.
+    if (m_allManagedDisabled)
+        return S_OK; // forced to interrupt this callback (continue process execution)
+
+    // Note, trace points are checked in managed callback thread, but callback could reach worker in case of pending
+    // application update.
+    if (ManagedCallbackTraceBreakpoint(pThread, pBreakpoint))
+        return S_OK; // forced to interrupt this callback (trace point hit recorded, continue process execution)
+
     // Don't stop at breakpoint in not JMC code, if possible (error here is not fatal for debug process).
     // We need this check here, since we can't guarantee this check in SkipBreakpoint().
     ToRelease<ICorDebugFrame> iCorFrame;
@@ -183,13 +528,13 @@ HRESULT Breakpoints::ManagedCallbackBreakpoint(ICorDebugThread *pThread, ICorDeb
         return S_OK; // forced to interrupt this callback (breakpoint in not user code, continue process execution)
     }
 
-    if (SUCCEEDED(Status = m_uniqueLineBreakpoints->CheckBreakpointHit(pThread, pBreakpoint, breakpoint)) &&
+    if (SUCCEEDED(Status = m_uniqueLineBreakpoints->CheckBreakpointHit(pThread, pBreakpoint, breakpoint, logOutput)) &&
         Status == S_OK) // S_FALSE - no breakpoint hit
     {
         return S_FALSE; // S_FALSE - not affect on callback (callback will emit stop event)
     }
 
-    if (SUCCEEDED(Status = m_uniqueFuncBreakpoints->CheckBreakpointHit(pThread, pBreakpoint, breakpoint)) &&
+    if (SUCCEEDED(Status = m_uniqueFuncBreakpoints->CheckBreakpointHit(pThread, pBreakpoint, breakpoint, logOutput)) &&
         Status == S_OK) // S_FALSE - no breakpoint hit
     {
         return S_FALSE; // S_FALSE - not affect on callback (callback will emit stop event)
@@ -206,33 +551,65 @@ HRESULT Breakpoints::ManagedCallbackLoadModule(ICorDebugModule *pModule, std::ve
     return S_OK;
 }
 
+HRESULT Breakpoints::VerifyPreResolvedBreakpoints(std::vector<BreakpointEvent> &events)
+{
+    return m_uniqueLineBreakpoints->VerifyPreResolvedBreakpoints(events);
+}
+
 HRESULT Breakpoints::ManagedCallbackLoadModuleAll(ICorDebugModule *pModule)
 {
     m_uniqueHotReloadBreakpoint->ManagedCallbackLoadModuleAll(pModule);
     return S_OK;
 }
 
-HRESULT Breakpoints::ManagedCallbackException(ICorDebugThread *pThread, ExceptionCallbackType eventType, const std::string &excModule, StoppedEvent &event)
+HRESULT Breakpoints::ManagedCallbackExceptionFilter(ICorDebugThread *pThread, ExceptionCallbackType eventType, std::string &excModule)
 {
-    return m_uniqueExceptionBreakpoints->ManagedCallbackException(pThread, eventType, excModule, event);
+    return m_uniqueExceptionBreakpoints->ManagedCallbackExceptionFilter(pThread, eventType, excModule);
+}
+
+bool Breakpoints::ManagedCallbackExceptionStatistics(ICorDebugThread *pThread, ICorDebugFrame *pFrame, bool firstChance)
+{
+    return m_uniqueExceptionBreakpoints->ManagedCallbackExceptionStatistics(pThread, pFrame, firstChance);
+}
+
+HRESULT Breakpoints::ManagedCallbackException(ICorDebugThread *pThread, const std::string &excModule, StoppedEvent &event)
+{
+    return m_uniqueExceptionBreakpoints->ManagedCallbackException(pThread, excModule, event);
 }
 
 HRESULT Breakpoints::AllBreakpointsActivate(bool act)
 {
-    HRESULT Status1 = m_uniqueLineBreakpoints->AllBreakpointsActivate(act);
-    HRESULT Status2 = m_uniqueFuncBreakpoints->AllBreakpointsActivate(act);
+    m_uniqueLineBreakpoints->AllBreakpointsActivate(act);
+    m_uniqueFuncBreakpoints->AllBreakpointsActivate(act);
+    m_allManagedDisabled = !act;
+
+    std::lock_guard<std::mutex> lock(m_activationMutex);
+    m_activationEpoch++;
+    m_activationPending = true;
+    if (!m_activationWorker.joinable())
+        m_activationWorker = std::thread(&Breakpoints::ActivationWorker, this);
+    m_activationCV.notify_all();
 
-    return FAILED(Status1) ? Status1 : Status2;
+    return S_OK;
 }
 
 HRESULT Breakpoints::BreakpointActivate(uint32_t id, bool act)
 {
+    if (act)
+        m_allManagedDisabled = false;
+
     if (SUCCEEDED(m_uniqueLineBreakpoints->BreakpointActivate(id, act)))
         return S_OK;
 
     return m_uniqueFuncBreakpoints->BreakpointActivate(id, act);
 }
 
+void Breakpoints::GetModulesWithBreakpoints(std::unordered_set<CORDB_ADDRESS> &modules)
+{
+    m_uniqueLineBreakpoints->AddModulesWithBreakpoints(modules);
+    m_uniqueFuncBreakpoints->AddModulesWithBreakpoints(modules);
+}
+
 // This function allows to enumerate breakpoints (sorted by number).
 // Callback which is called for each breakpoint might return `false` to stop iteration over breakpoints list.
 void Breakpoints::EnumerateBreakpoints(std::function<bool (const IDebugger::BreakpointInfo&)>&& callback)
@@ -243,6 +620,7 @@ void Breakpoints::EnumerateBreakpoints(std::function<bool (const IDebugger::Brea
     m_uniqueExceptionBreakpoints->AddAllBreakpointsInfo(list);
 #ifdef INTEROP_DEBUGGING
     m_sharedInteropLineBreakpoints->AddAllBreakpointsInfo(list);
+    m_uniqueInteropDataBreakpoints->AddAllBreakpointsInfo(list);
 #endif // INTEROP_DEBUGGING
 
     // sort breakpoint list by ascending order, preserve order of elements with same number
@@ -264,6 +642,11 @@ HRESULT Breakpoints::ManagedCallbackExitThread(ICorDebugThread *pThread)
     return m_uniqueExceptionBreakpoints->ManagedCallbackExitThread(pThread);
 }
 
+void Breakpoints::ManagedCallbackUnloadModule(ICorDebugModule *pModule)
+{
+    m_uniqueExceptionBreakpoints->ManagedCallbackUnloadModule(pModule);
+}
+
 HRESULT Breakpoints::CheckApplicationReload(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint)
 {
     return m_uniqueHotReloadBreakpoint->CheckApplicationReload(pThread, pBreakpoint);
@@ -274,6 +657,11 @@ void Breakpoints::CheckApplicationReload(ICorDebugThread *pThread)
     m_uniqueHotReloadBreakpoint->CheckApplicationReload(pThread);
 }
 
+bool Breakpoints::IsApplicationReloadPending()
+{
+    return m_uniqueHotReloadBreakpoint->IsApplicationReloadPending();
+}
+
 HRESULT Breakpoints::SetHotReloadBreakpoint(const std::string &updatedDLL, const std::unordered_set<mdTypeDef> &updatedTypeTokens)
 {
     return m_uniqueHotReloadBreakpoint->SetHotReloadBreakpoint(updatedDLL, updatedTypeTokens);
@@ -294,6 +682,17 @@ HRESULT Breakpoints::InteropSetLineBreakpoints(pid_t pid, InteropDebugging::Inte
     }) ? S_OK : E_FAIL;
 }
 
+HRESULT Breakpoints::InteropSetDataBreakpoints(pid_t pid, const std::vector<DataBreakpoint> &dataBreakpoints, std::vector<Breakpoint> &breakpoints,
+                                               std::function<void()> StopAllThreads, SetAllThreadsWatchpointsCallback SetAllThreads)
+{
+    // NOTE interop code provide 'true' on success, we must convert it into HRESULT
+    return m_uniqueInteropDataBreakpoints->SetDataBreakpoints(pid, dataBreakpoints, breakpoints, StopAllThreads, SetAllThreads, [&]() -> uint32_t
+    {
+        std::lock_guard<std::mutex> lock(m_nextBreakpointIdMutex);
+        return m_nextBreakpointId++;
+    }) ? S_OK : E_FAIL;
+}
+
 bool Breakpoints::InteropSetupRendezvousBrk(pid_t pid, LoadLibCallback loadLibCB, UnloadLibCallback unloadLibCB, IsThumbCodeCallback isThumbCode, int &err_code)
 {
     return m_uniqueInteropRendezvousBreakpoint->SetupRendezvousBrk(pid, loadLibCB, unloadLibCB, isThumbCode, err_code);
@@ -323,14 +722,39 @@ bool Breakpoints::IsInteropLineBreakpoint(std::uintptr_t brkAddr, Breakpoint &br
     return m_sharedInteropLineBreakpoints->IsLineBreakpoint(brkAddr, breakpoint);
 }
 
+bool Breakpoints::IsInteropDataBreakpointHit(pid_t pid, const siginfo_t &siginfo, std::uintptr_t &dataAddr)
+{
+    return m_uniqueInteropDataBreakpoints->IsDataBreakpointHit(pid, siginfo, dataAddr);
+}
+
+bool Breakpoints::IsInteropDataBreakpoint(std::uintptr_t dataAddr, Breakpoint &breakpoint)
+{
+    return m_uniqueInteropDataBreakpoints->IsDataBreakpoint(dataAddr, breakpoint);
+}
+
+void Breakpoints::InteropSetupDataBreakpoints(pid_t pid)
+{
+    m_uniqueInteropDataBreakpoints->SetupThread(pid);
+}
+
+void Breakpoints::InteropStepOverDataBreakpoint(pid_t pid, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk)
+{
+    m_uniqueInteropDataBreakpoints->StepOverDataBreakpoint(pid, SingleStepOnBrk);
+}
+
 bool Breakpoints::InteropStepPrevToBrk(pid_t pid, std::uintptr_t brkAddr)
 {
     return m_sharedInteropBreakpoints->StepPrevToBrk(pid, brkAddr);
 }
 
-void Breakpoints::InteropStepOverBrk(pid_t pid, std::uintptr_t brkAddr, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk)
+void Breakpoints::InteropStepOverBrk(pid_t pid, std::uintptr_t brkAddr, std::function<void()> StopAllThreads, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk)
 {
-    m_sharedInteropBreakpoints->StepOverBrk(pid, brkAddr, SingleStepOnBrk);
+    m_sharedInteropBreakpoints->StepOverBrk(pid, brkAddr, StopAllThreads, SingleStepOnBrk);
+}
+
+void Breakpoints::InteropRestoreOriginalData(std::uintptr_t addr, char *buffer, size_t size)
+{
+    m_sharedInteropBreakpoints->RestoreOriginalData(addr, buffer, size);
 }
 
 // Must be called only in case all threads stopped and fixed (see InteropDebugger::StopAndDetach()).
@@ -341,9 +765,16 @@ void Breakpoints::InteropRemoveAllAtDetach(pid_t pid)
     m_sharedInteropLineBreakpoints->RemoveAllAtDetach(pid);
 }
 
-void Breakpoints::InteropLoadModule(pid_t pid, std::uintptr_t startAddr, InteropDebugging::InteropLibraries *pInteropLibraries, std::vector<BreakpointEvent> &events)
+// Must be called only in case all threads stopped (see InteropDebugger::StopAndDetach()).
+void Breakpoints::InteropRemoveAllDataBreakpointsAtDetach(SetAllThreadsWatchpointsCallback SetAllThreads)
 {
-    m_sharedInteropLineBreakpoints->LoadModule(pid, startAddr, pInteropLibraries, events);
+    m_uniqueInteropDataBreakpoints->RemoveAllAtDetach(SetAllThreads);
+}
+
+void Breakpoints::InteropLoadModule(pid_t pid, std::uintptr_t startAddr, InteropDebugging::InteropLibraries *pInteropLibraries, std::vector<BreakpointEvent> &events,
+                                    std::function<void()> StopAllThreads)
+{
+    m_sharedInteropLineBreakpoints->LoadModule(pid, startAddr, pInteropLibraries, events, StopAllThreads);
 }
 
 void Breakpoints::InteropUnloadModule(std::uintptr_t startAddr, std::uintptr_t endAddr, std::vector<BreakpointEvent> &events)
@@ -352,16 +783,23 @@ void Breakpoints::InteropUnloadModule(std::uintptr_t startAddr, std::uintptr_t e
     m_sharedInteropLineBreakpoints->UnloadModule(startAddr, endAddr, events);
 }
 
-HRESULT Breakpoints::InteropAllBreakpointsActivate(pid_t pid, bool act, std::function<void()> StopAllThreads, std::function<void(std::uintptr_t)> FixAllThreads)
+HRESULT Breakpoints::InteropAllBreakpointsActivate(pid_t pid, bool act, std::function<void()> StopAllThreads, std::function<void(std::uintptr_t)> FixAllThreads,
+                                                   SetAllThreadsWatchpointsCallback SetAllThreads)
 {
     // NOTE interop code provide error as `errno` code, we must convert it into HRESULT
-    return m_sharedInteropLineBreakpoints->AllBreakpointsActivate(pid, act, StopAllThreads, FixAllThreads) == 0 ? S_OK : E_FAIL;
+    int err_code1 = m_sharedInteropLineBreakpoints->AllBreakpointsActivate(pid, act, StopAllThreads, FixAllThreads);
+    int err_code2 = m_uniqueInteropDataBreakpoints->AllBreakpointsActivate(act, StopAllThreads, SetAllThreads);
+    return err_code1 == 0 && err_code2 == 0 ? S_OK : E_FAIL;
 }
 
-HRESULT Breakpoints::InteropBreakpointActivate(pid_t pid, uint32_t id, bool act, std::function<void()> StopAllThreads, std::function<void(std::uintptr_t)> FixAllThreads)
+HRESULT Breakpoints::InteropBreakpointActivate(pid_t pid, uint32_t id, bool act, std::function<void()> StopAllThreads, std::function<void(std::uintptr_t)> FixAllThreads,
+                                               SetAllThreadsWatchpointsCallback SetAllThreads)
 {
     // NOTE interop code provide error as `errno` code, we must convert it into HRESULT
-    return m_sharedInteropLineBreakpoints->BreakpointActivate(pid, id, act, StopAllThreads, FixAllThreads) == 0 ? S_OK : E_FAIL;
+    if (m_sharedInteropLineBreakpoints->BreakpointActivate(pid, id, act, StopAllThreads, FixAllThreads) == 0)
+        return S_OK;
+
+    return m_uniqueInteropDataBreakpoints->BreakpointActivate(id, act, StopAllThreads, SetAllThreads) == 0 ? S_OK : E_FAIL;
 }
 
 #endif // INTEROP_DEBUGGING
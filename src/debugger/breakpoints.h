@@ -10,9 +10,14 @@
 #include <string>
 #include <mutex>
 #include <memory>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
 #include <unordered_set>
 #include "interfaces/idebugger.h"
 #include "debugger/interop_ptrace_helpers.h"
+#include "debugger/interop_watchpoint_helpers.h"
+#include "debugger/trace_buffer.h"
 
 namespace netcoredbg
 {
@@ -27,12 +32,14 @@ class ExceptionBreakpoints;
 class FuncBreakpoints;
 class LineBreakpoints;
 class HotReloadBreakpoint;
+class TemporaryBreakpoint;
 #ifdef INTEROP_DEBUGGING
 namespace InteropDebugging
 {
 class InteropRendezvousBreakpoint;
 class InteropBreakpoints;
 class InteropLineBreakpoints;
+class InteropDataBreakpoints;
 class InteropLibraries;
 } // namespace InteropDebugging
 #endif // INTEROP_DEBUGGING
@@ -42,6 +49,7 @@ class Breakpoints
 public:
 
     Breakpoints(std::shared_ptr<Modules> &sharedModules, std::shared_ptr<Evaluator> &sharedEvaluator, std::shared_ptr<EvalHelpers> &sharedEvalHelpers, std::shared_ptr<Variables> &sharedVariables);
+    ~Breakpoints();
 
     void SetJustMyCode(bool enable);
     void SetLastStoppedIlOffset(ICorDebugProcess *pProcess, const ThreadId &lastStoppedThreadId);
@@ -53,12 +61,24 @@ public:
     HRESULT SetFuncBreakpoints(bool haveProcess, const std::vector<FuncBreakpoint> &funcBreakpoints, std::vector<Breakpoint> &breakpoints);
     HRESULT SetLineBreakpoints(bool haveProcess, const std::string &filename, const std::vector<LineBreakpoint> &lineBreakpoints, std::vector<Breakpoint> &breakpoints);
     HRESULT SetExceptionBreakpoints(const std::vector<ExceptionBreakpoint> &exceptionBreakpoints, std::vector<Breakpoint> &breakpoints);
+    // Internal one-shot breakpoint for "run to cursor" and "step into target", see TemporaryBreakpoint.
+    HRESULT SetTemporaryBreakpoint(const std::string &filename, int linenum);
+    HRESULT SetTemporaryBreakpoint(ICorDebugModule *pModule, mdMethodDef methodToken, ULONG32 ilOffset);
+    void DeleteTemporaryBreakpoint();
     HRESULT SetHotReloadBreakpoint(const std::string &updatedDLL, const std::unordered_set<mdTypeDef> &updatedTypeTokens);
-    HRESULT UpdateBreakpointsOnHotReload(ICorDebugModule *pModule, std::unordered_set<mdMethodDef> &methodTokens, std::vector<BreakpointEvent> &events);
+    HRESULT UpdateBreakpointsOnHotReload(ICorDebugModule *pModule, std::unordered_set<mdMethodDef> &methodTokens, std::unordered_set<unsigned> &updatedSources,
+                                         std::vector<BreakpointEvent> &events);
 
     HRESULT GetExceptionInfo(ICorDebugThread *pThread, ExceptionInfo &exceptionInfo);
+    void SetExceptionStatistics(bool enable);
+    bool IsExceptionStatistics();
+    HRESULT GetExceptionStatistics(Modules *pModules, std::vector<ExceptionStatistic> &statistics, uint64_t &droppedCount, bool reset);
+    HRESULT GetTraceRecords(Modules *pModules, std::vector<TraceRecord> &records, uint64_t &overwrittenCount, bool drain);
+    void ClearTraceRecords();
 
     void EnumerateBreakpoints(std::function<bool (const IDebugger::BreakpointInfo&)>&& callback);
+    // Modules with resolved managed line and function breakpoints.
+    void GetModulesWithBreakpoints(std::unordered_set<CORDB_ADDRESS> &modules);
     HRESULT BreakpointActivate(uint32_t id, bool act);
     HRESULT AllBreakpointsActivate(bool act);
 
@@ -70,23 +90,37 @@ public:
     //     IfFailRet(pThread->GetID(&threadId));
     //     return S_OK;
     HRESULT ManagedCallbackBreak(ICorDebugThread *pThread, const ThreadId &lastStoppedThreadId);
-    HRESULT ManagedCallbackBreakpoint(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint, bool &atEntry);
-    HRESULT ManagedCallbackException(ICorDebugThread *pThread, ExceptionCallbackType eventType, const std::string &excModule, StoppedEvent &event);
+    HRESULT ManagedCallbackBreakpoint(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint, bool &atEntry, bool &atTemporary, std::string &logOutput);
+    // Could be called from managed callback thread, return `true` in case trace point hit was recorded and callback
+    // should be continued without stop.
+    bool ManagedCallbackTraceBreakpoint(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint);
+    HRESULT ManagedCallbackExceptionFilter(ICorDebugThread *pThread, ExceptionCallbackType eventType, std::string &excModule);
+    bool ManagedCallbackExceptionStatistics(ICorDebugThread *pThread, ICorDebugFrame *pFrame, bool firstChance);
+    HRESULT ManagedCallbackException(ICorDebugThread *pThread, const std::string &excModule, StoppedEvent &event);
     HRESULT ManagedCallbackLoadModule(ICorDebugModule *pModule, std::vector<BreakpointEvent> &events);
     HRESULT ManagedCallbackLoadModuleAll(ICorDebugModule *pModule);
+    // Verify line breakpoints activated at module load by cached resolve results, see LineBreakpoints.
+    HRESULT VerifyPreResolvedBreakpoints(std::vector<BreakpointEvent> &events);
     HRESULT ManagedCallbackExitThread(ICorDebugThread *pThread);
+    void ManagedCallbackUnloadModule(ICorDebugModule *pModule);
 
     // S_OK - internal HotReload breakpoint hit
     // S_FALSE - not internal HotReload breakpoint hit
     HRESULT CheckApplicationReload(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint);
     void CheckApplicationReload(ICorDebugThread *pThread);
+    bool IsApplicationReloadPending();
 
 #ifdef INTEROP_DEBUGGING
     HRESULT InteropSetLineBreakpoints(pid_t pid, InteropDebugging::InteropLibraries *pInteropLibraries, const std::string& filename,
                                       const std::vector<LineBreakpoint> &lineBreakpoints, std::vector<Breakpoint> &breakpoints,
                                       std::function<void()> StopAllThreads, std::function<void(std::uintptr_t)> FixAllThreads);
-    HRESULT InteropAllBreakpointsActivate(pid_t pid, bool act, std::function<void()> StopAllThreads, std::function<void(std::uintptr_t)> FixAllThreads);
-    HRESULT InteropBreakpointActivate(pid_t pid, uint32_t id, bool act, std::function<void()> StopAllThreads, std::function<void(std::uintptr_t)> FixAllThreads);
+    typedef std::function<void(const std::vector<InteropDebugging::hw_watchpoint_t>&)> SetAllThreadsWatchpointsCallback;
+    HRESULT InteropSetDataBreakpoints(pid_t pid, const std::vector<DataBreakpoint> &dataBreakpoints, std::vector<Breakpoint> &breakpoints,
+                                      std::function<void()> StopAllThreads, SetAllThreadsWatchpointsCallback SetAllThreads);
+    HRESULT InteropAllBreakpointsActivate(pid_t pid, bool act, std::function<void()> StopAllThreads, std::function<void(std::uintptr_t)> FixAllThreads,
+                                          SetAllThreadsWatchpointsCallback SetAllThreads);
+    HRESULT InteropBreakpointActivate(pid_t pid, uint32_t id, bool act, std::function<void()> StopAllThreads, std::function<void(std::uintptr_t)> FixAllThreads,
+                                      SetAllThreadsWatchpointsCallback SetAllThreads);
     // In case of error - return `false`.
     typedef std::function<void(pid_t, const std::string&, const std::string&, std::uintptr_t, std::uintptr_t)> LoadLibCallback;
     typedef std::function<void(const std::string&)> UnloadLibCallback;
@@ -97,15 +131,26 @@ public:
     bool IsInteropRendezvousBreakpoint(std::uintptr_t brkAddr);
     void InteropChangeRendezvousState(pid_t TGID, pid_t pid);
     bool IsInteropLineBreakpoint(std::uintptr_t brkAddr, Breakpoint &breakpoint);
+    // Return true, if SIGTRAP was caused by data breakpoint (hardware watchpoint), `dataAddr` provide watched address.
+    bool IsInteropDataBreakpointHit(pid_t pid, const siginfo_t &siginfo, std::uintptr_t &dataAddr);
+    bool IsInteropDataBreakpoint(std::uintptr_t dataAddr, Breakpoint &breakpoint);
+    // Setup data breakpoints for new thread.
+    void InteropSetupDataBreakpoints(pid_t pid);
+    // Execute instruction that trigger data breakpoint (in case arch need this).
+    void InteropStepOverDataBreakpoint(pid_t pid, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk);
     // In case we stop at breakpoint and need just move PC before breakpoint.
     // Note, this method will reset PC in case thread stop at breakpoint and alter `regs`.
     bool InteropStepPrevToBrk(pid_t pid, std::uintptr_t brkAddr);
     // Execute real breakpoint's code with single step.
-    void InteropStepOverBrk(pid_t pid, std::uintptr_t brkAddr, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk);
+    void InteropStepOverBrk(pid_t pid, std::uintptr_t brkAddr, std::function<void()> StopAllThreads, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk);
     // Remove all native breakpoints at interop detach.
     void InteropRemoveAllAtDetach(pid_t pid);
+    // Replace native breakpoints opcodes in memory read from debuggee by original code.
+    void InteropRestoreOriginalData(std::uintptr_t addr, char *buffer, size_t size);
+    void InteropRemoveAllDataBreakpointsAtDetach(SetAllThreadsWatchpointsCallback SetAllThreads);
     // Resolve breakpoints for module.
-    void InteropLoadModule(pid_t pid, std::uintptr_t startAddr, InteropDebugging::InteropLibraries *pInteropLibraries, std::vector<BreakpointEvent> &events);
+    void InteropLoadModule(pid_t pid, std::uintptr_t startAddr, InteropDebugging::InteropLibraries *pInteropLibraries, std::vector<BreakpointEvent> &events,
+                           std::function<void()> StopAllThreads);
     // Remove all related to unloaded library breakpoints entries in data structures.
     void InteropUnloadModule(std::uintptr_t startAddr, std::uintptr_t endAddr, std::vector<BreakpointEvent> &events);
 #endif // INTEROP_DEBUGGING
@@ -118,6 +163,8 @@ private:
     std::unique_ptr<FuncBreakpoints> m_uniqueFuncBreakpoints;
     std::unique_ptr<LineBreakpoints> m_uniqueLineBreakpoints;
     std::unique_ptr<HotReloadBreakpoint> m_uniqueHotReloadBreakpoint;
+    std::unique_ptr<TemporaryBreakpoint> m_uniqueTemporaryBreakpoint;
+    TraceBuffer m_traceBuffer;
 #ifdef INTEROP_DEBUGGING
     // "Low level" native breakpoints layer (related to memory patch).
     std::shared_ptr<InteropDebugging::InteropBreakpoints> m_sharedInteropBreakpoints;
@@ -128,11 +175,30 @@ private:
     // implementation for line breakpoint logic (close to managed line breakpoints we already have). In case of managed line breakpoints,
     // "low level" layer is CoreCLR debug API itself.
     std::unique_ptr<InteropDebugging::InteropLineBreakpoints> m_sharedInteropLineBreakpoints;
+    // Data breakpoints implementation, use hardware watchpoints instead of memory patch.
+    std::unique_ptr<InteropDebugging::InteropDataBreakpoints> m_uniqueInteropDataBreakpoints;
 #endif // INTEROP_DEBUGGING
 
     std::mutex m_nextBreakpointIdMutex;
     uint32_t m_nextBreakpointId;
 
+    // "All breakpoints" activate/deactivate change breakpoints state only, runtime breakpoints are activated/deactivated
+    // by background worker, so, protocol command don't wait for thousands of ICorDebug calls.
+    // In case all breakpoints were deactivated, hit check is skipped, since runtime breakpoints could be not deactivated yet.
+    std::atomic<bool> m_allManagedDisabled;
+    // Changed by each request, worker stop outdated request processing.
+    std::atomic<uint64_t> m_activationEpoch;
+    std::mutex m_activationMutex;
+    std::condition_variable m_activationCV;
+    bool m_activationPending;
+    bool m_activationRunning;
+    bool m_activationExit;
+    std::thread m_activationWorker;
+
+    void ActivationWorker();
+    // Cancel background activation and wait for worker, in case it is in progress.
+    void CancelActivation();
+
 };
 
 } // namespace netcoredbg
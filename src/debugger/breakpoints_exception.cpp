@@ -5,7 +5,12 @@
 #include "debugger/breakpoints_exception.h"
 #include "debugger/evaluator.h"
 #include "debugger/valueprint.h"
+#include "metadata/metadata_index.h"
+#include "metadata/modules.h"
 #include "metadata/typeprinter.h"
+#include "utils/filesystem.h"
+#include <algorithm>
+#include <map>
 #include <sstream>
 
 namespace netcoredbg
@@ -24,7 +29,256 @@ void ExceptionBreakpoints::DeleteAll()
     {
         filterMap.clear();
     }
+    UpdateFiltersMatch();
     m_breakpointsMutex.unlock();
+
+    m_excTypeNamesMutex.lock();
+    m_excTypeNames.clear();
+    m_excTypeNamesMutex.unlock();
+}
+
+// Return S_FALSE in case type is generic (name can't be cached by typedef token only).
+static HRESULT GetExceptionTypeKey(ICorDebugType *pType, CORDB_ADDRESS &modAddress, mdTypeDef &typeDef)
+{
+    HRESULT Status;
+    CorElementType corElemType;
+    IfFailRet(pType->GetType(&corElemType));
+    if (corElemType != ELEMENT_TYPE_CLASS)
+        return S_FALSE;
+
+    ToRelease<ICorDebugTypeEnum> iCorTypeEnum;
+    ULONG typeArgsCount = 0;
+    IfFailRet(pType->EnumerateTypeParameters(&iCorTypeEnum));
+    IfFailRet(iCorTypeEnum->GetCount(&typeArgsCount));
+    if (typeArgsCount != 0)
+        return S_FALSE;
+
+    ToRelease<ICorDebugClass> iCorClass;
+    IfFailRet(pType->GetClass(&iCorClass));
+    IfFailRet(iCorClass->GetToken(&typeDef));
+    ToRelease<ICorDebugModule> iCorModule;
+    IfFailRet(iCorClass->GetModule(&iCorModule));
+    IfFailRet(iCorModule->GetBaseAddress(&modAddress));
+    return S_OK;
+}
+
+void ExceptionBreakpoints::GetExceptionTypeName(ICorDebugValue *pExceptionValue, std::string &excType)
+{
+    ToRelease<ICorDebugValue2> iCorValue2;
+    ToRelease<ICorDebugType> iCorType;
+    CORDB_ADDRESS modAddress = 0;
+    mdTypeDef typeDef = mdTypeDefNil;
+    if (FAILED(pExceptionValue->QueryInterface(IID_ICorDebugValue2, (LPVOID*) &iCorValue2)) ||
+        FAILED(iCorValue2->GetExactType(&iCorType)) ||
+        GetExceptionTypeKey(iCorType, modAddress, typeDef) != S_OK)
+    {
+        if (FAILED(TypePrinter::GetTypeOfValue(pExceptionValue, excType)))
+            excType = "<unknown exception>";
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_excTypeNamesMutex);
+
+    auto &moduleTypeNames = m_excTypeNames[modAddress];
+    auto find = moduleTypeNames.find(typeDef);
+    if (find != moduleTypeNames.end())
+    {
+        excType = find->second;
+        return;
+    }
+
+    if (FAILED(TypePrinter::GetTypeOfValue(iCorType, excType)))
+    {
+        excType = "<unknown exception>";
+        return; // Don't cache failed result.
+    }
+
+    moduleTypeNames.emplace(typeDef, excType);
+}
+
+void ExceptionBreakpoints::ManagedCallbackUnloadModule(ICorDebugModule *pModule)
+{
+    CORDB_ADDRESS modAddress = 0;
+    if (FAILED(pModule->GetBaseAddress(&modAddress)))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_excTypeNamesMutex);
+    m_excTypeNames.erase(modAddress);
+}
+
+bool ExceptionBreakpoints::ManagedCallbackExceptionStatistics(ICorDebugThread *pThread, ICorDebugFrame *pFrame, bool firstChance)
+{
+    if (!m_exceptionStatistics)
+        return false;
+
+    // Note, only first chance is counted, all other callbacks for same exception are continued.
+    if (!firstChance)
+        return true;
+
+    // Note, generic exceptions are counted by generic type definition.
+    CORDB_ADDRESS typeModule = 0;
+    mdTypeDef typeDef = mdTypeDefNil;
+    ToRelease<ICorDebugValue> iCorExceptionValue;
+    ToRelease<ICorDebugValue2> iCorValue2;
+    ToRelease<ICorDebugType> iCorType;
+    ToRelease<ICorDebugClass> iCorClass;
+    ToRelease<ICorDebugModule> iCorTypeModule;
+    if (FAILED(pThread->GetCurrentException(&iCorExceptionValue)) || iCorExceptionValue == nullptr ||
+        FAILED(iCorExceptionValue->QueryInterface(IID_ICorDebugValue2, (LPVOID*) &iCorValue2)) ||
+        FAILED(iCorValue2->GetExactType(&iCorType)) ||
+        FAILED(iCorType->GetClass(&iCorClass)) ||
+        FAILED(iCorClass->GetToken(&typeDef)) ||
+        FAILED(iCorClass->GetModule(&iCorTypeModule)) ||
+        FAILED(iCorTypeModule->GetBaseAddress(&typeModule)))
+    {
+        typeModule = 0;
+        typeDef = mdTypeDefNil;
+    }
+
+    // Exception could be thrown outside of managed code (for example, by runtime), in this case pFrame is nullptr.
+    CORDB_ADDRESS methodModule = 0;
+    mdMethodDef methodDef = mdMethodDefNil;
+    ULONG32 ilOffset = 0;
+    ToRelease<ICorDebugFunction> iCorFunction;
+    ToRelease<ICorDebugModule> iCorMethodModule;
+    ToRelease<ICorDebugILFrame> iCorILFrame;
+    CorDebugMappingResult mappingResult;
+    if (pFrame == nullptr ||
+        FAILED(pFrame->GetFunction(&iCorFunction)) ||
+        FAILED(iCorFunction->GetToken(&methodDef)) ||
+        FAILED(iCorFunction->GetModule(&iCorMethodModule)) ||
+        FAILED(iCorMethodModule->GetBaseAddress(&methodModule)))
+    {
+        methodModule = 0;
+        methodDef = mdMethodDefNil;
+    }
+    else if (FAILED(pFrame->QueryInterface(IID_ICorDebugILFrame, (LPVOID*) &iCorILFrame)) ||
+             FAILED(iCorILFrame->GetIP(&ilOffset, &mappingResult)))
+    {
+        ilOffset = 0;
+    }
+
+    m_exceptionStats.Add(ExceptionStats::exc_key_t(typeModule, typeDef, methodModule, methodDef, ilOffset));
+    return true;
+}
+
+HRESULT ExceptionBreakpoints::GetExceptionStatistics(Modules *pModules, std::vector<ExceptionStatistic> &statistics, uint64_t &droppedCount, bool reset)
+{
+    // Note, dropped count is reset by entries read with reset.
+    droppedCount = m_exceptionStats.GetDroppedCount();
+    std::vector<ExceptionStats::entry_t> entries;
+    m_exceptionStats.GetEntries(entries, reset);
+
+    struct module_names_t
+    {
+        std::string name;
+        MetadataIndex::index_ptr_t index;
+        std::unordered_map<mdMethodDef, size_t> methods; // method token -> method index in metadata index
+    };
+    std::map<CORDB_ADDRESS, module_names_t> modules;
+    for (const auto &entry : entries)
+    {
+        modules.emplace(entry.key.typeModule, module_names_t());
+        modules.emplace(entry.key.methodModule, module_names_t());
+    }
+    modules.erase(0);
+
+    // Note, names are resolved for loaded modules only, unloaded modules entries are reported with tokens.
+    HRESULT Status;
+    IfFailRet(pModules->ForEachModule([&](ICorDebugModule *pModule)
+    {
+        CORDB_ADDRESS modAddress = 0;
+        if (FAILED(pModule->GetBaseAddress(&modAddress)))
+            return S_OK;
+
+        auto find = modules.find(modAddress);
+        if (find == modules.end())
+            return S_OK;
+
+        module_names_t &names = find->second;
+        names.name = GetBasename(GetModuleFileName(pModule));
+        if (FAILED(MetadataIndex::GetModuleIndex(pModule, names.index)))
+            return S_OK;
+
+        for (size_t i = 0; i < names.index->methods.size(); i++)
+        {
+            names.methods.emplace(names.index->methods[i].methodDef, i);
+        }
+        return S_OK;
+    }));
+
+    auto tokenName = [](uint32_t token)
+    {
+        std::ostringstream ss;
+        ss << "<token 0x" << std::hex << token << ">";
+        return ss.str();
+    };
+
+    std::sort(entries.begin(), entries.end(), [](const ExceptionStats::entry_t &a, const ExceptionStats::entry_t &b) { return a.count > b.count; });
+    statistics.reserve(statistics.size() + entries.size());
+    for (const auto &entry : entries)
+    {
+        statistics.emplace_back();
+        ExceptionStatistic &statistic = statistics.back();
+        statistic.ilOffset = entry.key.ilOffset;
+        statistic.count = entry.count;
+
+        auto typeModule = modules.find(entry.key.typeModule);
+        const module_metadata_index_t::type_t *type = nullptr;
+        if (typeModule != modules.end() && typeModule->second.index)
+            type = typeModule->second.index->FindType(entry.key.typeToken);
+        if (type != nullptr)
+            statistic.exceptionType = type->fullName;
+        else if (entry.key.typeModule == 0)
+            statistic.exceptionType = "<unknown exception>";
+        else
+            statistic.exceptionType = tokenName(entry.key.typeToken);
+
+        if (entry.key.methodModule == 0)
+            continue;
+
+        auto methodModule = modules.find(entry.key.methodModule);
+        if (methodModule == modules.end() || methodModule->second.name.empty())
+        {
+            statistic.module = "<unknown module>";
+            statistic.method = tokenName(entry.key.methodToken);
+            continue;
+        }
+
+        const module_names_t &names = methodModule->second;
+        statistic.module = names.name;
+        auto method = names.methods.find(entry.key.methodToken);
+        if (method == names.methods.end())
+            statistic.method = tokenName(entry.key.methodToken);
+        else
+            statistic.method = names.index->GetMethodFullName(names.index->methods[method->second]);
+    }
+
+    return S_OK;
+}
+
+// Note, caller must care about m_breakpointsMutex.
+void ExceptionBreakpoints::UpdateFiltersMatch()
+{
+    for (size_t filter = 0; filter < (size_t)ExceptionBreakpointFilter::Size; ++filter)
+    {
+        FilterMatch match = FilterMatch::None;
+        for (auto &expb : m_exceptionBreakpoints[filter])
+        {
+            if (expb.second.categoryHint != ExceptionCategory::CLR &&
+                expb.second.categoryHint != ExceptionCategory::ANY)
+                continue;
+
+            if (expb.second.condition.empty())
+            {
+                match = FilterMatch::All;
+                break;
+            }
+
+            match = FilterMatch::ByType;
+        }
+        m_filtersMatchCLR[filter] = match;
+    }
 }
 
 static std::string CalculateExceptionBreakpointHash(const ExceptionBreakpoint &expb)
@@ -67,7 +321,10 @@ HRESULT ExceptionBreakpoints::SetExceptionBreakpoints(const std::vector<Exceptio
     }
 
     if (exceptionBreakpoints.empty())
+    {
+        UpdateFiltersMatch();
         return S_OK;
+    }
 
     // Export exception breakpoints
     for (const auto &expb : exceptionBreakpoints)
@@ -98,6 +355,7 @@ HRESULT ExceptionBreakpoints::SetExceptionBreakpoints(const std::vector<Exceptio
         breakpoints.push_back(breakpoint);
     }
 
+    UpdateFiltersMatch();
     return S_OK;
 }
 
@@ -109,6 +367,32 @@ bool ExceptionBreakpoints::CoveredByFilter(ExceptionBreakpointFilter filterId, c
     assert(excCategory != ExceptionCategory::ANY); // caller must know category: CLR = Exception() callback, MDA = MDANotification() callback
     std::lock_guard<std::mutex> lock(m_breakpointsMutex);
 
+    return InternalCoveredByFilter(filterId, excType, excCategory);
+}
+
+bool ExceptionBreakpoints::CoveredByFilterCLR(ExceptionBreakpointFilter filterId, ICorDebugValue *pExceptionValue, std::string &excType)
+{
+    std::lock_guard<std::mutex> lock(m_breakpointsMutex);
+
+    switch (m_filtersMatchCLR[(size_t)filterId])
+    {
+        case FilterMatch::None:
+            return false;
+        case FilterMatch::All:
+            return true;
+        default:
+            break;
+    }
+
+    if (excType.empty())
+        GetExceptionTypeName(pExceptionValue, excType);
+
+    return InternalCoveredByFilter(filterId, excType, ExceptionCategory::CLR);
+}
+
+// Note, caller must care about m_breakpointsMutex.
+bool ExceptionBreakpoints::InternalCoveredByFilter(ExceptionBreakpointFilter filterId, const std::string &excType, ExceptionCategory excCategory)
+{
     for (auto &expb : m_exceptionBreakpoints[(size_t)filterId])
     {
         if (expb.second.categoryHint != excCategory &&
@@ -193,13 +477,38 @@ static void GetExceptionBreakModeName(ExceptionBreakMode breakMode, std::string
     }
 }
 
-HRESULT ExceptionBreakpoints::GetExceptionDetails(ICorDebugThread *pThread, ICorDebugValue *pExceptionValue, ExceptionDetails &details)
+static void CopyExceptionDetails(const ExceptionDetails &source, ExceptionDetails &details)
 {
-    std::string excType;
-    if (FAILED(TypePrinter::GetTypeOfValue(pExceptionValue, details.fullTypeName)))
+    details.message = source.message;
+    details.typeName = source.typeName;
+    details.fullTypeName = source.fullTypeName;
+    details.evaluateName = source.evaluateName;
+    details.stackTrace = source.stackTrace;
+    details.formattedDescription = source.formattedDescription;
+    details.source = source.source;
+    details.innerException.reset();
+    if (source.innerException)
     {
-        excType = "<unknown exception>";
+        details.innerException.reset(new ExceptionDetails);
+        CopyExceptionDetails(*source.innerException, *details.innerException);
     }
+}
+
+static void CopyExceptionInfo(const ExceptionInfo &source, ExceptionInfo &exceptionInfo)
+{
+    exceptionInfo.exceptionId = source.exceptionId;
+    exceptionInfo.description = source.description;
+    exceptionInfo.breakMode = source.breakMode;
+    CopyExceptionDetails(source.details, exceptionInfo.details);
+}
+
+// Note, only top level exception `StackTrace` and `Source` properties are evaluated, inner exceptions are collected from
+// `_innerException` and `_message` fields without evaluation. Inner exceptions stack traces could be evaluated on demand
+// by provided evaluateName (for example, `$exception.InnerException.StackTrace`).
+HRESULT ExceptionBreakpoints::GetExceptionDetails(ICorDebugThread *pThread, ICorDebugValue *pExceptionValue, const std::string &evaluateName,
+                                                  unsigned depth, ExceptionDetails &details)
+{
+    GetExceptionTypeName(pExceptionValue, details.fullTypeName);
 
     auto lastDotPosition = details.fullTypeName.find_last_of(".");
     if (lastDotPosition < details.fullTypeName.size())
@@ -207,7 +516,7 @@ HRESULT ExceptionBreakpoints::GetExceptionDetails(ICorDebugThread *pThread, ICor
     else
         details.typeName = details.fullTypeName;
 
-    details.evaluateName = "$exception";
+    details.evaluateName = evaluateName;
 
     HRESULT Status;
     ToRelease<ICorDebugValue> iCorInnerExceptionValue;
@@ -242,15 +551,18 @@ HRESULT ExceptionBreakpoints::GetExceptionDetails(ICorDebugThread *pThread, ICor
         if (Status == S_OK)
             return S_OK;
 
-        IfFailRet(Status = getMemberWithName("StackTrace", details.stackTrace));
-        if (Status == S_OK)
-            return S_OK;
+        if (depth == 0)
+        {
+            IfFailRet(Status = getMemberWithName("StackTrace", details.stackTrace));
+            if (Status == S_OK)
+                return S_OK;
 
-        IfFailRet(Status = getMemberWithName("Source", details.source));
-        if (Status == S_OK)
-            return S_OK;
+            IfFailRet(Status = getMemberWithName("Source", details.source));
+            if (Status == S_OK)
+                return S_OK;
+        }
 
-        if (memberName == "InnerException")
+        if (memberName == "_innerException")
         {
             IfFailRet(getValue(&iCorInnerExceptionValue, defaultEvalFlags));
             BOOL isNull = FALSE;
@@ -270,10 +582,10 @@ HRESULT ExceptionBreakpoints::GetExceptionDetails(ICorDebugThread *pThread, ICor
     if (!details.message.empty())
         details.formattedDescription += " '" + details.message + "'";
 
-    if (iCorInnerExceptionValue != nullptr)
+    if (iCorInnerExceptionValue != nullptr && depth < MaxInnerExceptionsDepth)
     {
         details.innerException.reset(new ExceptionDetails);
-        GetExceptionDetails(pThread, iCorInnerExceptionValue, *details.innerException.get());
+        GetExceptionDetails(pThread, iCorInnerExceptionValue, evaluateName + ".InnerException", depth + 1, *details.innerException.get());
     }
 
     return S_OK;
@@ -296,7 +608,21 @@ HRESULT ExceptionBreakpoints::GetExceptionInfo(ICorDebugThread *pThread, Excepti
     if (findBreakMode == m_threadsExceptionBreakMode.end() || findBreakMode->second == ExceptionBreakMode::NEVER)
         return E_FAIL;
 
-    IfFailRet(GetExceptionDetails(pThread, iCorExceptionValue, exceptionInfo.details));
+    // Note, IDE could request exception info few times for same stop (each time thread selected), all data collected
+    // for exception object is reused until next exception for this thread.
+    CORDB_ADDRESS exceptionAddress = 0;
+    ToRelease<ICorDebugReferenceValue> iCorExceptionRef;
+    if (SUCCEEDED(iCorExceptionValue->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &iCorExceptionRef)))
+        iCorExceptionRef->GetValue(&exceptionAddress);
+
+    auto findCached = m_threadsExceptionInfo.find(tid);
+    if (findCached != m_threadsExceptionInfo.end() && exceptionAddress != 0 && findCached->second.address == exceptionAddress)
+    {
+        CopyExceptionInfo(findCached->second.info, exceptionInfo);
+        return S_OK;
+    }
+
+    IfFailRet(GetExceptionDetails(pThread, iCorExceptionValue, "$exception", 0, exceptionInfo.details));
 
     std::string excModule;
     if (exceptionInfo.details.source.empty())
@@ -320,6 +646,13 @@ HRESULT ExceptionBreakpoints::GetExceptionInfo(ICorDebugThread *pThread, Excepti
     // TODO need store info about category too (not only BreakMode) during Exception() (CLR) and MDANotification() (MDA) callbacks.
     exceptionInfo.exceptionId = "CLR/" + exceptionInfo.details.fullTypeName;
 
+    if (exceptionAddress != 0)
+    {
+        CachedExceptionInfo &cached = m_threadsExceptionInfo[tid];
+        cached.address = exceptionAddress;
+        CopyExceptionInfo(exceptionInfo, cached.info);
+    }
+
     return S_OK;
 }
 
@@ -366,7 +699,7 @@ HRESULT ExceptionBreakpoints::GetExceptionInfo(ICorDebugThread *pThread, Excepti
     https://github.com/OmniSharp/omnisharp-vscode/blob/master/debugger.md#exception-settings
     https://docs.microsoft.com/en-us/visualstudio/debugger/managing-exceptions-with-the-debugger
 */
-HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread, ExceptionCallbackType eventType, std::string excModule, StoppedEvent &event)
+HRESULT ExceptionBreakpoints::ManagedCallbackExceptionFilter(ICorDebugThread *pThread, ExceptionCallbackType eventType, std::string &excModule)
 {
     HRESULT Status;
     DWORD tid = 0;
@@ -377,14 +710,15 @@ HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread,
     if (iCorExceptionValue == nullptr)
         return E_FAIL;
 
+    // Note, exception type name resolved only in case filter result depend on it.
     std::string excType;
-    if (FAILED(TypePrinter::GetTypeOfValue(iCorExceptionValue, excType)))
-    {
-        excType = "<unknown exception>";
-    }
 
     std::lock_guard<std::mutex> lock(m_threadsExceptionMutex);
 
+    // Note, previous stop event for this thread (if any) was already processed or dropped.
+    m_threadsPendingExceptionStop.erase(tid);
+    m_threadsExceptionInfo.erase(tid);
+
     switch(eventType)
     {
         case ExceptionCallbackType::FIRST_CHANCE:
@@ -395,8 +729,8 @@ HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread,
             m_threadsExceptionStatus[tid].m_lastEvent = ExceptionCallbackType::FIRST_CHANCE;
             m_threadsExceptionStatus[tid].m_excModule = excModule;
 
-            if (!CoveredByFilter(ExceptionBreakpointFilter::THROW, excType, ExceptionCategory::CLR) &&
-                !CoveredByFilter(ExceptionBreakpointFilter::THROW_USER_UNHANDLED, excType, ExceptionCategory::CLR))
+            if (!CoveredByFilterCLR(ExceptionBreakpointFilter::THROW, iCorExceptionValue, excType) &&
+                !CoveredByFilterCLR(ExceptionBreakpointFilter::THROW_USER_UNHANDLED, iCorExceptionValue, excType))
                 return S_OK;
 
             m_threadsExceptionBreakMode[tid] = ExceptionBreakMode::THROW;
@@ -419,8 +753,8 @@ HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread,
             m_threadsExceptionStatus[tid].m_lastEvent = ExceptionCallbackType::USER_FIRST_CHANCE;
             m_threadsExceptionStatus[tid].m_excModule = excModule;
 
-            if (!CoveredByFilter(ExceptionBreakpointFilter::THROW, excType, ExceptionCategory::CLR) &&
-                !CoveredByFilter(ExceptionBreakpointFilter::THROW_USER_UNHANDLED, excType, ExceptionCategory::CLR))
+            if (!CoveredByFilterCLR(ExceptionBreakpointFilter::THROW, iCorExceptionValue, excType) &&
+                !CoveredByFilterCLR(ExceptionBreakpointFilter::THROW_USER_UNHANDLED, iCorExceptionValue, excType))
                 return S_OK;
 
             m_threadsExceptionBreakMode[tid] = ExceptionBreakMode::THROW;
@@ -429,7 +763,9 @@ HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread,
 
         case ExceptionCallbackType::CATCH_HANDLER_FOUND:
         {
-            assert(m_threadsExceptionStatus.find(tid) != m_threadsExceptionStatus.end());
+            // Note, first chance could be not filtered, in case exception statistics mode was disabled during exception processing.
+            if (m_threadsExceptionStatus.find(tid) == m_threadsExceptionStatus.end())
+                return S_OK;
 
             if (!m_justMyCode || m_threadsExceptionStatus[tid].m_lastEvent == ExceptionCallbackType::FIRST_CHANCE)
             {
@@ -437,8 +773,8 @@ HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread,
                 return S_OK;
             }
 
-            if (!CoveredByFilter(ExceptionBreakpointFilter::USER_UNHANDLED, excType, ExceptionCategory::CLR) &&
-                !CoveredByFilter(ExceptionBreakpointFilter::THROW_USER_UNHANDLED, excType, ExceptionCategory::CLR))
+            if (!CoveredByFilterCLR(ExceptionBreakpointFilter::USER_UNHANDLED, iCorExceptionValue, excType) &&
+                !CoveredByFilterCLR(ExceptionBreakpointFilter::THROW_USER_UNHANDLED, iCorExceptionValue, excType))
             {
                 m_threadsExceptionStatus.erase(tid);
                 return S_OK;
@@ -453,8 +789,8 @@ HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread,
 
         case ExceptionCallbackType::USER_CATCH_HANDLER_FOUND:
         {
-            assert(m_threadsExceptionStatus.find(tid) != m_threadsExceptionStatus.end());
-            assert(m_threadsExceptionStatus[tid].m_lastEvent == ExceptionCallbackType::USER_FIRST_CHANCE);
+            assert(m_threadsExceptionStatus.find(tid) == m_threadsExceptionStatus.end() ||
+                   m_threadsExceptionStatus[tid].m_lastEvent == ExceptionCallbackType::USER_FIRST_CHANCE);
 
             m_threadsExceptionStatus.erase(tid);
             return S_OK;
@@ -485,6 +821,32 @@ HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread,
     if (excModule.empty())
         excModule = "<unknown module>";
 
+    m_threadsPendingExceptionStop[tid] = std::move(excType);
+    return S_FALSE;
+}
+
+HRESULT ExceptionBreakpoints::ManagedCallbackException(ICorDebugThread *pThread, const std::string &excModule, StoppedEvent &event)
+{
+    HRESULT Status;
+    DWORD tid = 0;
+    IfFailRet(pThread->GetID(&tid));
+
+    ToRelease<ICorDebugValue> iCorExceptionValue;
+    IfFailRet(pThread->GetCurrentException(&iCorExceptionValue));
+    if (iCorExceptionValue == nullptr)
+        return E_FAIL;
+
+    std::lock_guard<std::mutex> lock(m_threadsExceptionMutex);
+
+    auto findPending = m_threadsPendingExceptionStop.find(tid);
+    if (findPending == m_threadsPendingExceptionStop.end())
+        return S_OK; // Filtered out by ManagedCallbackExceptionFilter(), no stop event need.
+
+    std::string excType(std::move(findPending->second));
+    m_threadsPendingExceptionStop.erase(findPending);
+    if (excType.empty())
+        GetExceptionTypeName(iCorExceptionValue, excType);
+
     // Custom message, provided by runtime (in case internal runtime exception) or directly by user as exception constructor argument on throw.
     // Note, this is optional field in exception object that could have nulled reference.
     std::string excMessage;
@@ -534,6 +896,8 @@ HRESULT ExceptionBreakpoints::ManagedCallbackExitThread(ICorDebugThread *pThread
     m_threadsExceptionMutex.lock();
     m_threadsExceptionBreakMode.erase(tid);
     m_threadsExceptionStatus.erase(tid);
+    m_threadsPendingExceptionStop.erase(tid);
+    m_threadsExceptionInfo.erase(tid);
     m_threadsExceptionMutex.unlock();
 
     return S_OK;
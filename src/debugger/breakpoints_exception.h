@@ -9,6 +9,8 @@
 
 #include "interfaces/types.h"
 #include "interfaces/idebugger.h"
+#include "debugger/exception_stats.h"
+#include <atomic>
 #include <unordered_map>
 #include <string>
 #include <memory>
@@ -20,6 +22,7 @@ namespace netcoredbg
 
 class Evaluator;
 class IDebugger;
+class Modules;
 
 class ExceptionBreakpoints
 {
@@ -28,7 +31,9 @@ public:
     ExceptionBreakpoints(std::shared_ptr<Evaluator> &sharedEvaluator) :
         m_sharedEvaluator(sharedEvaluator),
         m_justMyCode(true),
-        m_exceptionBreakpoints((size_t)ExceptionBreakpointFilter::Size)
+        m_exceptionStatistics(false),
+        m_exceptionBreakpoints((size_t)ExceptionBreakpointFilter::Size),
+        m_filtersMatchCLR((size_t)ExceptionBreakpointFilter::Size, FilterMatch::None)
     {}
 
     void SetJustMyCode(bool enable) { m_justMyCode = enable; };
@@ -37,6 +42,11 @@ public:
                                     std::function<uint32_t()> getId);
     HRESULT GetExceptionInfo(ICorDebugThread *pThread, ExceptionInfo &exceptionInfo);
     bool CoveredByFilter(ExceptionBreakpointFilter filterId, const std::string &excType, ExceptionCategory excCategory);
+    // In exception statistics mode exception breakpoints are ignored (except unhandled exceptions).
+    void SetExceptionStatistics(bool enable) { m_exceptionStatistics = enable; }
+    bool IsExceptionStatistics() const { return m_exceptionStatistics; }
+    // Resolve exceptions types and throw-sites names, `pModules` is used for names resolve only.
+    HRESULT GetExceptionStatistics(Modules *pModules, std::vector<ExceptionStatistic> &statistics, uint64_t &droppedCount, bool reset);
 
     // Important! Callbacks related methods must control return for succeeded return code.
     // Do not allow debugger API return succeeded (uncontrolled) return code.
@@ -45,14 +55,27 @@ public:
     // Good:
     //     IfFailRet(pThread->GetID(&threadId));
     //     return S_OK;
-    HRESULT ManagedCallbackException(ICorDebugThread *pThread, ExceptionCallbackType eventType, std::string excModule, StoppedEvent &event);
+    //
+    // Exception filter, called directly from managed callback thread (before callbacks queue), must not use evaluation.
+    // Return S_FALSE in case exception need stop event (in this case `excModule` is changed to module, that must be reported
+    // by ManagedCallbackException() call), S_OK in case exception filtered out and process could be continued.
+    HRESULT ManagedCallbackExceptionFilter(ICorDebugThread *pThread, ExceptionCallbackType eventType, std::string &excModule);
+    // Exception statistics mode, called directly from managed callback thread before any filtering.
+    // Return `true` in case exception was counted (for first chance) and process must be continued without filtering.
+    bool ManagedCallbackExceptionStatistics(ICorDebugThread *pThread, ICorDebugFrame *pFrame, bool firstChance);
+    // Create stop event for exception, that was marked for stop by ManagedCallbackExceptionFilter().
+    // Return S_FALSE in case stop event created, S_OK in case no stop event need.
+    HRESULT ManagedCallbackException(ICorDebugThread *pThread, const std::string &excModule, StoppedEvent &event);
     HRESULT ManagedCallbackExitThread(ICorDebugThread *pThread);
+    void ManagedCallbackUnloadModule(ICorDebugModule *pModule);
     void AddAllBreakpointsInfo(std::vector<IDebugger::BreakpointInfo> &list);
 
 private:
 
     std::shared_ptr<Evaluator> m_sharedEvaluator;
     bool m_justMyCode;
+    std::atomic<bool> m_exceptionStatistics;
+    ExceptionStats m_exceptionStats;
 
     struct ExceptionStatus
     {
@@ -68,8 +91,29 @@ private:
     std::unordered_map<DWORD, ExceptionStatus> m_threadsExceptionStatus;
     // Note, we have Exception callback called with different exception callback type, and we need know exception type that related to current stop event.
     std::unordered_map<DWORD, ExceptionBreakMode> m_threadsExceptionBreakMode;
+    // Exception type name for threads with stop event pending (marked by ManagedCallbackExceptionFilter() and not processed
+    // by ManagedCallbackException() yet). Note, type name could be empty, if filter don't need it.
+    std::unordered_map<DWORD, std::string> m_threadsPendingExceptionStop;
 
-    HRESULT GetExceptionDetails(ICorDebugThread *pThread, ICorDebugValue *pExceptionValue, ExceptionDetails &details);
+    struct CachedExceptionInfo
+    {
+        CORDB_ADDRESS address; // exception object address
+        ExceptionInfo info;
+    };
+    // Exception info for threads stopped by exception, collected at first request.
+    std::unordered_map<DWORD, CachedExceptionInfo> m_threadsExceptionInfo;
+
+    static const unsigned MaxInnerExceptionsDepth = 16;
+    HRESULT GetExceptionDetails(ICorDebugThread *pThread, ICorDebugValue *pExceptionValue, const std::string &evaluateName,
+                                unsigned depth, ExceptionDetails &details);
+
+    // Exception type names cache for non generic types, by module base address and typedef token.
+    // Note, exception type name is resolved at each throw (for type related conditions and stop event),
+    // but almost all the time same exception types are used.
+    std::mutex m_excTypeNamesMutex;
+    std::unordered_map<CORDB_ADDRESS, std::unordered_map<mdTypeDef, std::string>> m_excTypeNames;
+
+    void GetExceptionTypeName(ICorDebugValue *pExceptionValue, std::string &excType);
 
     struct ManagedExceptionBreakpoint
     {
@@ -93,6 +137,22 @@ private:
     std::mutex m_breakpointsMutex;
     std::vector<std::unordered_multimap<std::string, ManagedExceptionBreakpoint>> m_exceptionBreakpoints;
 
+    // Precompiled (at breakpoints change) filters status for CLR exceptions, in order to avoid exception type name
+    // resolving and breakpoints iterating in case filter result don't depend on exception type.
+    enum class FilterMatch
+    {
+        None,   // filter don't cover any CLR exceptions
+        All,    // filter cover all CLR exceptions
+        ByType  // filter result depend on exception type
+    };
+    std::vector<FilterMatch> m_filtersMatchCLR;
+
+    // Note, caller must care about m_breakpointsMutex.
+    void UpdateFiltersMatch();
+    bool InternalCoveredByFilter(ExceptionBreakpointFilter filterId, const std::string &excType, ExceptionCategory excCategory);
+    // Note, `excType` resolved (if empty) only in case filter result depend on exception type.
+    bool CoveredByFilterCLR(ExceptionBreakpointFilter filterId, ICorDebugValue *pExceptionValue, std::string &excType);
+
 };
 
 } // namespace netcoredbg
@@ -4,9 +4,7 @@
 
 #include "debugger/breakpoints_func.h"
 #include "debugger/breakpointutils.h"
-#include "metadata/typeprinter.h"
 #include "metadata/modules.h"
-#include <sstream>
 #include <unordered_set>
 #include <algorithm>
 
@@ -30,7 +28,7 @@ void FuncBreakpoints::DeleteAll()
     m_breakpointsMutex.unlock();
 }
 
-HRESULT FuncBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint)
+HRESULT FuncBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint, std::string &logOutput)
 {
     if (m_funcBreakpoints.empty())
         return S_FALSE; // Stopped at break, but no breakpoints.
@@ -39,63 +37,70 @@ HRESULT FuncBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugB
     ToRelease<ICorDebugFunctionBreakpoint> pFunctionBreakpoint;
     IfFailRet(pBreakpoint->QueryInterface(IID_ICorDebugFunctionBreakpoint, (LPVOID *) &pFunctionBreakpoint));
 
-    ToRelease<ICorDebugFrame> pFrame;
-    IfFailRet(pThread->GetActiveFrame(&pFrame));
-    if (pFrame == nullptr)
-        return E_FAIL;
-
-    ToRelease<ICorDebugILFrame> pILFrame;
-    IfFailRet(pFrame->QueryInterface(IID_ICorDebugILFrame, (LPVOID *) &pILFrame));
+    // Note, breakpoints are resolved for methods with provided params only, no reason check params at hit time.
+    // Note, since IsEnableByCondition() during eval execution could neutered frame, all frame-related calculation
+    // must be done before enter into this cycles.
+    for (auto &fb : m_funcBreakpoints)
+    {
+        ManagedFuncBreakpoint &fbp = fb.second;
 
-    ToRelease<ICorDebugValueEnum> pParamEnum;
-    IfFailRet(pILFrame->EnumerateArguments(&pParamEnum));
-    ULONG cParams = 0;
-    IfFailRet(pParamEnum->GetCount(&cParams));
+        // Note, trace point hit is handled by CheckTraceBreakpointHit().
+        if (!fbp.enabled || fbp.trace)
+            continue;
 
-    std::ostringstream ss;
-    ss << "(";
-    if (cParams > 0)
-    {
-        for (ULONG i = 0; i < cParams; ++i)
+        for (auto &funcBreakpoint : fbp.funcBreakpoints)
         {
-            ToRelease<ICorDebugValue> pValue;
-            ULONG cArgsFetched;
-            if (FAILED(pParamEnum->Next(1, &pValue, &cArgsFetched)))
+            if (FAILED(BreakpointUtils::IsSameFunctionBreakpoint(pFunctionBreakpoint, funcBreakpoint.iCorFuncBreakpoint)) ||
+                FAILED(BreakpointUtils::IsEnableByCondition(fbp.condition, m_sharedVariables.get(), pThread)))
+                continue;
+            
+            ++fbp.times;
+            if (BreakpointUtils::IsEnableByHitCondition(fbp.hitCondition, fbp.times) != S_OK)
                 continue;
 
-            std::string param;
-            IfFailRet(TypePrinter::GetTypeOfValue(pValue, param));
-            if (i > 0)
-                ss << ",";
+            if (!fbp.logMessage.empty())
+            {
+                BreakpointUtils::FormatLogMessage(fbp.logMessage, m_sharedVariables.get(), pThread, logOutput);
+                return S_FALSE; // log point, no stop
+            }
 
-            ss << param;
+            fbp.ToBreakpoint(breakpoint);
+            return S_OK;
         }
     }
-    ss << ")";
-    std::string params = ss.str();
 
-    // Note, since IsEnableByCondition() during eval execution could neutered frame, all frame-related calculation
-    // must be done before enter into this cycles.
+    return S_FALSE; // Stopped at break, but breakpoint not found.
+}
+
+HRESULT FuncBreakpoints::CheckTraceBreakpointHit(ICorDebugBreakpoint *pBreakpoint, bool &record, uint32_t &id, unsigned &traceArgs)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugFunctionBreakpoint> pFunctionBreakpoint;
+    IfFailRet(pBreakpoint->QueryInterface(IID_ICorDebugFunctionBreakpoint, (LPVOID *) &pFunctionBreakpoint));
+
+    std::lock_guard<std::mutex> lock(m_breakpointsMutex);
+
     for (auto &fb : m_funcBreakpoints)
     {
         ManagedFuncBreakpoint &fbp = fb.second;
 
-        if (!fbp.enabled || (!fbp.params.empty() && params != fbp.params))
+        if (!fbp.enabled || !fbp.trace)
             continue;
 
         for (auto &funcBreakpoint : fbp.funcBreakpoints)
         {
-            if (FAILED(BreakpointUtils::IsSameFunctionBreakpoint(pFunctionBreakpoint, funcBreakpoint.iCorFuncBreakpoint)) ||
-                FAILED(BreakpointUtils::IsEnableByCondition(fbp.condition, m_sharedVariables.get(), pThread)))
+            if (FAILED(BreakpointUtils::IsSameFunctionBreakpoint(pFunctionBreakpoint, funcBreakpoint.iCorFuncBreakpoint)))
                 continue;
-            
+
             ++fbp.times;
-            fbp.ToBreakpoint(breakpoint);
+            record = BreakpointUtils::IsEnableByHitCondition(fbp.hitCondition, fbp.times) == S_OK;
+            id = fbp.id;
+            traceArgs = fbp.traceArgs;
             return S_OK;
         }
     }
 
-    return S_FALSE; // Stopped at break, but breakpoint not found.
+    return S_FALSE;
 }
 
 HRESULT FuncBreakpoints::ManagedCallbackLoadModule(ICorDebugModule *pModule, std::vector<BreakpointEvent> &events)
@@ -171,6 +176,10 @@ HRESULT FuncBreakpoints::SetFuncBreakpoints(bool haveProcess, const std::vector<
             fbp.name = fb.func;
             fbp.params = fb.params;
             fbp.condition = fb.condition;
+            fbp.hitCondition = fb.hitCondition;
+            fbp.logMessage = fb.logMessage;
+            fbp.trace = fb.trace;
+            fbp.traceArgs = fb.traceArgs;
 
             if (haveProcess)
                 ResolveFuncBreakpoint(fbp);
@@ -183,6 +192,10 @@ HRESULT FuncBreakpoints::SetFuncBreakpoints(bool haveProcess, const std::vector<
             ManagedFuncBreakpoint &fbp = b->second;
 
             fbp.condition = fb.condition;
+            fbp.hitCondition = fb.hitCondition;
+            fbp.logMessage = fb.logMessage;
+            fbp.trace = fb.trace;
+            fbp.traceArgs = fb.traceArgs;
             fbp.ToBreakpoint(breakpoint);
         }
 
@@ -205,7 +218,7 @@ HRESULT FuncBreakpoints::UpdateBreakpointsOnHotReload(ICorDebugModule *pModule,
 
         ResolvedFBP fbpResolved;
         IfFailRet(m_sharedModules->ResolveFuncBreakpointInModule(
-            pModule, fbp.module, fbp.module_checked, fbp.name,
+            pModule, fbp.module, fbp.module_checked, fbp.name, fbp.params,
             [&](ICorDebugModule *pModule, mdMethodDef &methodToken) -> HRESULT
         {
             // Note, in case Hot Reload we ignore "resolved" status + setup breakpoints for new/changed methods only.
@@ -285,7 +298,7 @@ HRESULT FuncBreakpoints::ResolveFuncBreakpoint(ManagedFuncBreakpoint &fbp)
     ResolvedFBP fbpResolved;
 
     IfFailRet(m_sharedModules->ResolveFuncBreakpointInAny(
-        fbp.module, fbp.module_checked, fbp.name, 
+        fbp.module, fbp.module_checked, fbp.name, fbp.params, 
         [&](ICorDebugModule *pModule, mdMethodDef &methodToken) -> HRESULT
     {
         fbpResolved.emplace_back(std::make_pair(pModule, methodToken));
@@ -301,7 +314,7 @@ HRESULT FuncBreakpoints::ResolveFuncBreakpointInModule(ICorDebugModule *pModule,
     ResolvedFBP fbpResolved;
 
     IfFailRet(m_sharedModules->ResolveFuncBreakpointInModule(
-        pModule, fbp.module, fbp.module_checked, fbp.name,
+        pModule, fbp.module, fbp.module_checked, fbp.name, fbp.params,
         [&](ICorDebugModule *pModule, mdMethodDef &methodToken) -> HRESULT
     {
         fbpResolved.emplace_back(std::make_pair(pModule, methodToken));
@@ -311,25 +324,45 @@ HRESULT FuncBreakpoints::ResolveFuncBreakpointInModule(ICorDebugModule *pModule,
     return AddFuncBreakpoint(fbp, fbpResolved);
 }
 
-HRESULT FuncBreakpoints::AllBreakpointsActivate(bool act)
+void FuncBreakpoints::AllBreakpointsActivate(bool act)
 {
     std::lock_guard<std::mutex> lock(m_breakpointsMutex);
 
-    HRESULT Status = S_OK;
     for (auto &fbp : m_funcBreakpoints)
     {
-        for (auto &funcBreakpoint : fbp.second.funcBreakpoints)
-        {
-            if (!funcBreakpoint.iCorFuncBreakpoint)
-                continue;
-
-            HRESULT ret = funcBreakpoint.iCorFuncBreakpoint->Activate(act ? TRUE : FALSE);
-            Status = FAILED(ret) ? ret : Status;
-        }
         fbp.second.enabled = act;
     }
+}
+
+void FuncBreakpoints::ApplyAllBreakpointsActivation(std::function<bool()> isCanceled)
+{
+    // Note, mutex is not held during all ICorDebug calls, but for one function breakpoint only.
+    std::vector<std::string> names;
+    std::unique_lock<std::mutex> lock(m_breakpointsMutex);
+    names.reserve(m_funcBreakpoints.size());
+    for (const auto &fbp : m_funcBreakpoints)
+    {
+        names.emplace_back(fbp.first);
+    }
+    lock.unlock();
 
-    return Status;
+    for (const auto &name : names)
+    {
+        if (isCanceled())
+            return;
+
+        lock.lock();
+        auto find = m_funcBreakpoints.find(name);
+        if (find != m_funcBreakpoints.end())
+        {
+            for (auto &funcBreakpoint : find->second.funcBreakpoints)
+            {
+                if (funcBreakpoint.iCorFuncBreakpoint)
+                    funcBreakpoint.iCorFuncBreakpoint->Activate(find->second.enabled ? TRUE : FALSE);
+            }
+        }
+        lock.unlock();
+    }
 }
 
 HRESULT FuncBreakpoints::BreakpointActivate(uint32_t id, bool act)
@@ -372,4 +405,24 @@ void FuncBreakpoints::AddAllBreakpointsInfo(std::vector<IDebugger::BreakpointInf
     }
 }
 
+void FuncBreakpoints::AddModulesWithBreakpoints(std::unordered_set<CORDB_ADDRESS> &modules)
+{
+    std::lock_guard<std::mutex> lock(m_breakpointsMutex);
+
+    for (auto &pair_bp : m_funcBreakpoints)
+    {
+        for (auto &funcBreakpoint : pair_bp.second.funcBreakpoints)
+        {
+            ToRelease<ICorDebugFunction> pFunction;
+            ToRelease<ICorDebugModule> pModule;
+            CORDB_ADDRESS modAddress;
+            if (funcBreakpoint.iCorFuncBreakpoint &&
+                SUCCEEDED(funcBreakpoint.iCorFuncBreakpoint->GetFunction(&pFunction)) &&
+                SUCCEEDED(pFunction->GetModule(&pModule)) &&
+                SUCCEEDED(pModule->GetBaseAddress(&modAddress)))
+                modules.insert(modAddress);
+        }
+    }
+}
+
 } // namespace netcoredbg
@@ -14,6 +14,7 @@
 #include <list>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include "interfaces/idebugger.h"
 #include "utils/torelease.h"
 
@@ -38,14 +39,23 @@ public:
     HRESULT SetFuncBreakpoints(bool haveProcess, const std::vector<FuncBreakpoint> &funcBreakpoints,
                                std::vector<Breakpoint> &breakpoints, std::function<uint32_t()> getId);
     HRESULT UpdateBreakpointsOnHotReload(ICorDebugModule *pModule, std::unordered_set<mdMethodDef> &methodTokens, std::vector<BreakpointEvent> &events);
-    HRESULT AllBreakpointsActivate(bool act);
+    // Note, change breakpoints state only, runtime breakpoints state must be changed by ApplyAllBreakpointsActivation() call.
+    void AllBreakpointsActivate(bool act);
+    // Activate/deactivate runtime breakpoints in accordance with breakpoints state, `isCanceled` checked between breakpoints.
+    void ApplyAllBreakpointsActivation(std::function<bool()> isCanceled);
     HRESULT BreakpointActivate(uint32_t id, bool act);
     void AddAllBreakpointsInfo(std::vector<IDebugger::BreakpointInfo> &list);
+    void AddModulesWithBreakpoints(std::unordered_set<CORDB_ADDRESS> &modules);
 
     // Important! Must provide succeeded return code:
     // S_OK - breakpoint hit
     // S_FALSE - no breakpoint hit
-    HRESULT CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint);
+    // Note, in case of log point hit, S_FALSE returned and interpolated log message appended to `logOutput`.
+    HRESULT CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint, std::string &logOutput);
+    // Could be called from managed callback thread, since don't need any evaluation.
+    // S_OK - trace point hit, in case hit condition was not passed `record` is false
+    // S_FALSE - no trace point hit
+    HRESULT CheckTraceBreakpointHit(ICorDebugBreakpoint *pBreakpoint, bool &record, uint32_t &id, unsigned &traceArgs);
 
     // Important! Callbacks related methods must control return for succeeded return code.
     // Do not allow debugger API return succeeded (uncontrolled) return code.
@@ -88,13 +98,17 @@ private:
         ULONG32 times;
         bool enabled;
         std::string condition;
+        std::string hitCondition;
+        std::string logMessage;
+        bool trace;
+        unsigned traceArgs;
         std::list<internalFuncBreakpoint> funcBreakpoints;
 
         bool IsResolved() const { return module_checked; }
         bool IsVerified() const { return !funcBreakpoints.empty(); }
 
         ManagedFuncBreakpoint() :
-            id(0), module_checked(false), times(0), enabled(true)
+            id(0), module_checked(false), times(0), enabled(true), trace(false), traceArgs(0)
         {}
 
         ~ManagedFuncBreakpoint()
@@ -4,10 +4,12 @@
 
 #include "debugger/breakpoints_interop.h"
 #include "debugger/interop_brk_helpers.h"
+#include "debugger/interop_mem_helpers.h"
 #include <sys/uio.h> // iovec
 #include <elf.h> // NT_PRSTATUS
 #include <assert.h>
 #include <string.h>
+#include <algorithm>
 #include "utils/logger.h"
 
 
@@ -113,9 +115,21 @@ void InteropBreakpoints::RemoveAllAtDetach(pid_t pid)
                 LOGE("Ptrace pokedata error: %s\n", strerror(errno));
             }
         }
+
+        // Note, must be restored after breakpoints, since breakpoint could be set inside scratch buffer after it was used.
+        for (size_t i = 0; i < m_displacedStepBufSavedData.size(); i++)
+        {
+            if (async_ptrace(PTRACE_POKEDATA, pid, (void*)(m_displacedStepBufAddr + i * sizeof(word_t)), (void*)m_displacedStepBufSavedData[i]) == -1)
+            {
+                LOGE("Ptrace pokedata error: %s\n", strerror(errno));
+            }
+        }
     }
 
     m_currentBreakpointsInMemory.clear();
+    m_displacedStepBufResolved = false;
+    m_displacedStepBufAddr = 0;
+    m_displacedStepBufSavedData.clear();
 
     m_breakpointsMutex.unlock();
 }
@@ -127,7 +141,96 @@ bool InteropBreakpoints::IsBreakpoint(std::uintptr_t brkAddr)
     return m_currentBreakpointsInMemory.find(brkAddr) != m_currentBreakpointsInMemory.end();
 }
 
-void InteropBreakpoints::StepOverBrk(pid_t pid, std::uintptr_t brkAddr, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk)
+void InteropBreakpoints::RestoreOriginalData(std::uintptr_t addr, char *buffer, size_t size)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_breakpointsMutex);
+
+    const std::uintptr_t endAddr = addr + size;
+    for (const auto &entry : m_currentBreakpointsInMemory)
+    {
+        const std::uintptr_t brkAddr = entry.first;
+        if (brkAddr >= endAddr || brkAddr + sizeof(word_t) <= addr)
+            continue;
+
+        // Note, breakpoint word could be read partially, missed bytes are not used.
+        const std::uintptr_t start = std::max(brkAddr, addr);
+        const std::uintptr_t end = std::min(brkAddr + sizeof(word_t), endAddr);
+        word_t data = entry.second.m_savedData;
+        memcpy((char*)&data + (start - brkAddr), buffer + (start - addr), end - start);
+        data = RestoredOpcode(data, entry.second.m_savedData);
+        memcpy(buffer + (start - addr), (char*)&data + (start - brkAddr), end - start);
+    }
+}
+
+bool InteropBreakpoints::IsBreakpointInRange(std::uintptr_t startAddr, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        if (m_currentBreakpointsInMemory.find(startAddr + i) != m_currentBreakpointsInMemory.end())
+            return true;
+    }
+    return false;
+}
+
+// Return `false` in case displaced stepping not possible (thread was not changed).
+bool InteropBreakpoints::DisplacedStepOverBrk(pid_t pid, std::uintptr_t brkAddr, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk, bool &stepResult)
+{
+    if (!m_displacedStepBufResolved)
+    {
+        m_displacedStepBufResolved = true;
+
+        std::uintptr_t bufAddr = GetProcessEntryAddr(pid);
+        if (bufAddr == 0)
+            return false;
+
+        std::vector<word_t> savedData;
+        for (size_t i = 0; i < DisplacedStepBufSize; i += sizeof(word_t))
+        {
+            errno = 0;
+            savedData.push_back(async_ptrace(PTRACE_PEEKDATA, pid, (void*)(bufAddr + i), nullptr));
+            if (errno != 0)
+            {
+                LOGE("Ptrace peekdata error: %s", strerror(errno));
+                return false;
+            }
+        }
+
+        m_displacedStepBufAddr = bufAddr;
+        m_displacedStepBufSavedData = std::move(savedData);
+    }
+
+    if (m_displacedStepBufAddr == 0 || IsBreakpointInRange(m_displacedStepBufAddr, DisplacedStepBufSize))
+        return false;
+
+    // Note, instruction could be longer than one word and have other breakpoints inside, read one more word,
+    // so, RestoredOpcode() could be applied for any breakpoint address in code.
+    static const size_t codeWords = DisplacedStepBufSize / sizeof(word_t) + 1;
+    word_t code[codeWords];
+    for (size_t i = 0; i < codeWords; i++)
+    {
+        errno = 0;
+        code[i] = async_ptrace(PTRACE_PEEKDATA, pid, (void*)(brkAddr + i * sizeof(word_t)), nullptr);
+        if (errno != 0)
+            return false; // Note, could be end of mapped memory, in place step must be used.
+    }
+
+    uint8_t *codeBytes = (uint8_t*)code;
+    for (size_t i = 0; i < DisplacedStepBufSize; i++)
+    {
+        auto find = m_currentBreakpointsInMemory.find(brkAddr + i);
+        if (find == m_currentBreakpointsInMemory.end())
+            continue;
+
+        word_t data;
+        memcpy(&data, codeBytes + i, sizeof(word_t));
+        data = RestoredOpcode(data, find->second.m_savedData);
+        memcpy(codeBytes + i, &data, sizeof(word_t));
+    }
+
+    return InteropDebugging::DisplacedStepOverBrk(pid, brkAddr, codeBytes, m_displacedStepBufAddr, SingleStepOnBrk, stepResult);
+}
+
+void InteropBreakpoints::StepOverBrk(pid_t pid, std::uintptr_t brkAddr, std::function<void()> StopAllThreads, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk)
 {
     std::lock_guard<std::recursive_mutex> lock(m_breakpointsMutex);
 
@@ -135,6 +238,17 @@ void InteropBreakpoints::StepOverBrk(pid_t pid, std::uintptr_t brkAddr, std::fun
     if (find == m_currentBreakpointsInMemory.end())
         return;
 
+    bool stepResult = false;
+    if (DisplacedStepOverBrk(pid, brkAddr, SingleStepOnBrk, stepResult))
+    {
+        if (!stepResult)
+            std::abort(); // Fatal error, we already logged all data about this error.
+        return;
+    }
+
+    // Note, breakpoint will be removed from memory during step, all threads must be stopped.
+    StopAllThreads();
+
     if (!InteropDebugging::StepOverBrk(pid, brkAddr, find->second.m_savedData, SingleStepOnBrk))
         std::abort(); // Fatal error, we already logged all data about this error.
 }
@@ -9,6 +9,7 @@
 #include "debugger/interop_ptrace_helpers.h"
 #include <unordered_map>
 #include <list>
+#include <vector>
 #include <mutex>
 #include <functional>
 
@@ -28,7 +29,11 @@ public:
     // Remove all native breakpoints at interop detach.
     void RemoveAllAtDetach(pid_t pid);
     bool IsBreakpoint(std::uintptr_t brkAddr);
-    void StepOverBrk(pid_t pid, std::uintptr_t brkAddr, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk);
+    // Replace breakpoints opcodes in memory read from debuggee by original code.
+    void RestoreOriginalData(std::uintptr_t addr, char *buffer, size_t size);
+    // Note, breakpoint's instruction executed out-of-line (displaced stepping) if possible, so, other threads could continue execution.
+    // Otherwise, StopAllThreads() is called and instruction executed in place with temporary removed breakpoint.
+    void StepOverBrk(pid_t pid, std::uintptr_t brkAddr, std::function<void()> StopAllThreads, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk);
     // Return `false` in case no breakpoint with this PC was found (step is not possible).
     bool StepPrevToBrk(pid_t pid, std::uintptr_t brkAddr);
     // Remove all related to unloaded library breakpoints entries in data structures.
@@ -45,6 +50,14 @@ private:
     // NOTE we could recursively call `InteropBreakpoints` methods in StopAllThreads/FixAllThreads callbacks.
     std::recursive_mutex m_breakpointsMutex;
     std::unordered_map<std::uintptr_t, MemBrk> m_currentBreakpointsInMemory;
+
+    // Scratch buffer for displaced stepping, executable entry point code (executed only once at process start).
+    bool m_displacedStepBufResolved = false;
+    std::uintptr_t m_displacedStepBufAddr = 0; // `0` in case displaced stepping not available
+    std::vector<word_t> m_displacedStepBufSavedData;
+
+    bool IsBreakpointInRange(std::uintptr_t startAddr, size_t size);
+    bool DisplacedStepOverBrk(pid_t pid, std::uintptr_t brkAddr, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk, bool &stepResult);
 };
 
 } // namespace InteropDebugging
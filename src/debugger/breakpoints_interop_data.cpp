@@ -0,0 +1,284 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/breakpoints_interop_data.h"
+#include <algorithm>
+#include <sstream>
+#include <assert.h>
+#include <errno.h>
+#include "utils/logger.h"
+
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+
+namespace
+{
+    std::string DataBreakpointName(const DataBreakpoint &breakpoint)
+    {
+        std::ostringstream ss;
+        ss << "*0x" << std::hex << breakpoint.address;
+        return ss.str();
+    }
+
+} // unnamed namespace
+
+void InteropDataBreakpoints::InteropDataBreakpoint::ToBreakpoint(Breakpoint &breakpoint) const
+{
+    breakpoint.id = m_id;
+    breakpoint.verified = m_slot != -1;
+    breakpoint.message = m_message;
+    breakpoint.funcname = DataBreakpointName(m_breakpoint);
+    breakpoint.hitCount = m_times;
+}
+
+bool InteropDataBreakpoints::UpdateSlots()
+{
+    std::vector<hw_watchpoint_t> slots(m_slots.size());
+    size_t usedSlots = 0;
+
+    for (auto &bp : m_dataBreakpoints)
+    {
+        bp.m_slot = -1;
+        bp.m_message.clear();
+
+        if (!bp.m_enabled)
+            continue;
+
+        // Note, managed field address is not available during GC or in case object was collected.
+        if (bp.m_breakpoint.address == 0)
+        {
+            bp.m_message = "Watched object is not available.";
+            continue;
+        }
+
+        if (!IsHWWatchpointSupported(bp.m_breakpoint.address, bp.m_breakpoint.size, bp.m_breakpoint.access))
+        {
+            bp.m_message = "Data breakpoint size, alignment or access type is not supported by hardware.";
+            continue;
+        }
+
+        // Same data breakpoint could be requested several times, reuse slot in this case.
+        for (size_t i = 0; i < usedSlots; i++)
+        {
+            if (slots[i].addr == bp.m_breakpoint.address && slots[i].size == bp.m_breakpoint.size && slots[i].access == bp.m_breakpoint.access)
+            {
+                bp.m_slot = (int)i;
+                break;
+            }
+        }
+        if (bp.m_slot != -1)
+            continue;
+
+        if (usedSlots == slots.size())
+        {
+            bp.m_message = "No free hardware watchpoints available.";
+            continue;
+        }
+
+        slots[usedSlots].addr = bp.m_breakpoint.address;
+        slots[usedSlots].size = bp.m_breakpoint.size;
+        slots[usedSlots].access = bp.m_breakpoint.access;
+        bp.m_slot = (int)usedSlots;
+        usedSlots++;
+    }
+
+    bool changed = false;
+    for (size_t i = 0; i < slots.size(); i++)
+    {
+        if (slots[i].addr != m_slots[i].addr || slots[i].size != m_slots[i].size || slots[i].access != m_slots[i].access)
+        {
+            changed = true;
+            break;
+        }
+    }
+
+    m_slots.swap(slots);
+    return changed;
+}
+
+void InteropDataBreakpoints::ApplySlots(std::function<void()> &StopAllThreads, SetAllThreadsCallback &SetAllThreads)
+{
+    if (!UpdateSlots())
+        return;
+
+    // Note, debug registers could be changed for stopped threads only.
+    StopAllThreads();
+    SetAllThreads(m_slots);
+}
+
+bool InteropDataBreakpoints::SetDataBreakpoints(pid_t pid, const std::vector<DataBreakpoint> &dataBreakpoints, std::vector<Breakpoint> &breakpoints,
+                                                std::function<void()> StopAllThreads, SetAllThreadsCallback SetAllThreads, std::function<uint32_t()> getId)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_breakpointsMutex);
+
+    breakpoints.reserve(dataBreakpoints.size());
+
+    if (pid == 0)
+    {
+        // Watchpoints are debuggee threads registers, nothing to setup without process.
+        assert(m_dataBreakpoints.empty());
+        for (const auto &entry : dataBreakpoints)
+        {
+            InteropDataBreakpoint bp(getId(), entry);
+            bp.m_message = "Data breakpoints require native debuggee process.";
+            breakpoints.emplace_back();
+            bp.ToBreakpoint(breakpoints.back());
+        }
+        return true;
+    }
+
+    if (!m_slotsCountDetected)
+    {
+        m_slots.resize(GetHWWatchpointsCount(pid));
+        m_slotsCountDetected = true;
+    }
+
+    // Connect new data with previous data by breakpoint itself, in order to keep id, hit count and enabled status.
+    std::list<InteropDataBreakpoint> newDataBreakpoints;
+    for (const auto &entry : dataBreakpoints)
+    {
+        auto find = std::find_if(m_dataBreakpoints.begin(), m_dataBreakpoints.end(),
+                                 [&](const InteropDataBreakpoint &bp) { return bp.m_breakpoint == entry; });
+        if (find != m_dataBreakpoints.end())
+        {
+            newDataBreakpoints.splice(newDataBreakpoints.end(), m_dataBreakpoints, find);
+            // Managed field address could be changed by GC.
+            newDataBreakpoints.back().m_breakpoint.address = entry.address;
+        }
+        else
+            newDataBreakpoints.emplace_back(getId(), entry);
+    }
+    m_dataBreakpoints.swap(newDataBreakpoints);
+
+    ApplySlots(StopAllThreads, SetAllThreads);
+
+    for (const auto &bp : m_dataBreakpoints)
+    {
+        breakpoints.emplace_back();
+        bp.ToBreakpoint(breakpoints.back());
+    }
+
+    return true;
+}
+
+int InteropDataBreakpoints::AllBreakpointsActivate(bool act, std::function<void()> StopAllThreads, SetAllThreadsCallback SetAllThreads)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_breakpointsMutex);
+
+    for (auto &bp : m_dataBreakpoints)
+    {
+        bp.m_enabled = act;
+    }
+
+    ApplySlots(StopAllThreads, SetAllThreads);
+    return 0;
+}
+
+int InteropDataBreakpoints::BreakpointActivate(uint32_t id, bool act, std::function<void()> StopAllThreads, SetAllThreadsCallback SetAllThreads)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_breakpointsMutex);
+
+    auto find = std::find_if(m_dataBreakpoints.begin(), m_dataBreakpoints.end(), [&](const InteropDataBreakpoint &bp) { return bp.m_id == id; });
+    if (find == m_dataBreakpoints.end())
+        return ENOENT;
+
+    find->m_enabled = act;
+    ApplySlots(StopAllThreads, SetAllThreads);
+    return 0;
+}
+
+void InteropDataBreakpoints::AddAllBreakpointsInfo(std::vector<IDebugger::BreakpointInfo> &list)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_breakpointsMutex);
+
+    list.reserve(list.size() + m_dataBreakpoints.size());
+    for (const auto &bp : m_dataBreakpoints)
+    {
+        list.emplace_back(IDebugger::BreakpointInfo{ bp.m_id, bp.m_slot != -1, bp.m_enabled, bp.m_times, "",
+                                                     DataBreakpointName(bp.m_breakpoint), 0, 0, "", {} });
+    }
+}
+
+// Must be called only in case all threads stopped (see InteropDebugger::StopAndDetach()).
+void InteropDataBreakpoints::RemoveAllAtDetach(SetAllThreadsCallback SetAllThreads)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_breakpointsMutex);
+
+    m_dataBreakpoints.clear();
+    if (UpdateSlots())
+        SetAllThreads(m_slots);
+
+    m_slots.clear();
+    m_slotsCountDetected = false;
+}
+
+// Note, hardware watchpoints are not inherited by new threads, they must be setup by debugger.
+void InteropDataBreakpoints::SetupThread(pid_t pid)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_breakpointsMutex);
+
+    for (const auto &slot : m_slots)
+    {
+        if (slot.addr == 0)
+            continue;
+
+        SetHWWatchpoints(pid, m_slots);
+        return;
+    }
+}
+
+bool InteropDataBreakpoints::IsDataBreakpointHit(pid_t pid, const siginfo_t &siginfo, std::uintptr_t &dataAddr)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_breakpointsMutex);
+
+    int slot = GetHWWatchpointHit(pid, siginfo, m_slots);
+    if (slot == -1)
+        return false;
+
+    dataAddr = m_slots[slot].addr;
+    return true;
+}
+
+bool InteropDataBreakpoints::IsDataBreakpoint(std::uintptr_t dataAddr, Breakpoint &breakpoint)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_breakpointsMutex);
+
+    for (auto &bp : m_dataBreakpoints)
+    {
+        if (bp.m_slot == -1 || m_slots[bp.m_slot].addr != dataAddr)
+            continue;
+
+        ++bp.m_times;
+        bp.ToBreakpoint(breakpoint);
+        return true;
+    }
+
+    return false;
+}
+
+void InteropDataBreakpoints::StepOverDataBreakpoint(pid_t pid, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk)
+{
+    if (!NeedStepOverHWWatchpoint())
+        return;
+
+    std::vector<hw_watchpoint_t> slots;
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_breakpointsMutex);
+        slots = m_slots;
+    }
+
+    // Note, only this thread registers changed, all other threads could continue execution.
+    if (SetHWWatchpoints(pid, std::vector<hw_watchpoint_t>(slots.size())) != 0)
+        return;
+
+    // Note, `0` as address, since this is not memory breakpoint and we don't need "step over" at next stop in case single step failed.
+    if (SingleStepOnBrk(pid, 0))
+        SetHWWatchpoints(pid, slots);
+}
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
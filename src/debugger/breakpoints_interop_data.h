@@ -0,0 +1,82 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#ifdef INTEROP_DEBUGGING
+
+#include "debugger/interop_watchpoint_helpers.h"
+#include <mutex>
+#include <list>
+#include <functional>
+#include "interfaces/idebugger.h"
+
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+
+// Data breakpoints implementation with hardware watchpoints. Watchpoints are per thread debug registers, so, each change of slots
+// must be applied to all threads (see SetAllThreads callback) and new threads must be setup at creation (see SetupThread()).
+// Note, no cost for debuggee execution until watchpoint triggered.
+class InteropDataBreakpoints
+{
+public:
+
+    typedef std::function<void(const std::vector<hw_watchpoint_t>&)> SetAllThreadsCallback;
+
+    // Return `false` in case of error, `pid` have `0` in case no debuggee process available.
+    bool SetDataBreakpoints(pid_t pid, const std::vector<DataBreakpoint> &dataBreakpoints, std::vector<Breakpoint> &breakpoints,
+                            std::function<void()> StopAllThreads, SetAllThreadsCallback SetAllThreads, std::function<uint32_t()> getId);
+    // In case of error, return `errno` code.
+    int AllBreakpointsActivate(bool act, std::function<void()> StopAllThreads, SetAllThreadsCallback SetAllThreads);
+    // In case of error, return `errno` code.
+    int BreakpointActivate(uint32_t id, bool act, std::function<void()> StopAllThreads, SetAllThreadsCallback SetAllThreads);
+    void AddAllBreakpointsInfo(std::vector<IDebugger::BreakpointInfo> &list);
+    // Remove all watchpoints at interop detach, all threads must be stopped.
+    void RemoveAllAtDetach(SetAllThreadsCallback SetAllThreads);
+
+    // Setup watchpoints for new thread, thread must be stopped.
+    void SetupThread(pid_t pid);
+    // Check SIGTRAP for data breakpoint, provide watched address in case of hit.
+    bool IsDataBreakpointHit(pid_t pid, const siginfo_t &siginfo, std::uintptr_t &dataAddr);
+    bool IsDataBreakpoint(std::uintptr_t dataAddr, Breakpoint &breakpoint);
+    // Execute instruction that trigger watchpoint (in case arch need this) with disabled watchpoints for this thread.
+    void StepOverDataBreakpoint(pid_t pid, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk);
+
+private:
+
+    struct InteropDataBreakpoint
+    {
+        uint32_t m_id;
+        DataBreakpoint m_breakpoint;
+        bool m_enabled;
+        int m_slot; // `-1` in case watchpoint was not set
+        std::string m_message; // reason why not set
+        ULONG32 m_times;
+
+        InteropDataBreakpoint(uint32_t id, const DataBreakpoint &breakpoint) :
+            m_id(id), m_breakpoint(breakpoint), m_enabled(true), m_slot(-1), m_times(0)
+        {}
+
+        void ToBreakpoint(Breakpoint &breakpoint) const;
+    };
+
+    // NOTE we could recursively call `InteropDataBreakpoints` methods in StopAllThreads callback (new thread setup).
+    std::recursive_mutex m_breakpointsMutex;
+    std::list<InteropDataBreakpoint> m_dataBreakpoints;
+    // Current hardware watchpoints slots state, same for all threads.
+    std::vector<hw_watchpoint_t> m_slots;
+    bool m_slotsCountDetected = false;
+
+    // Return `true` in case slots state was changed.
+    bool UpdateSlots();
+    void ApplySlots(std::function<void()> &StopAllThreads, SetAllThreadsCallback &SetAllThreads);
+};
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
+
+#endif // INTEROP_DEBUGGING
@@ -388,7 +388,7 @@ bool InteropLineBreakpoints::SetLineBreakpoints(pid_t pid, InteropLibraries *pIn
     return true;
 }
 
-void InteropLineBreakpoints::LoadModule(pid_t pid, std::uintptr_t startAddr, InteropLibraries *pInteropLibraries, std::vector<BreakpointEvent> &events)
+void InteropLineBreakpoints::LoadModule(pid_t pid, std::uintptr_t startAddr, InteropLibraries *pInteropLibraries, std::vector<BreakpointEvent> &events, std::function<void()> StopAllThreads)
 {
     std::lock_guard<std::mutex> lock(m_breakpointsMutex);
 
@@ -419,8 +419,8 @@ void InteropLineBreakpoints::LoadModule(pid_t pid, std::uintptr_t startAddr, Int
 
             if (bp.m_enabled)
             {
-                // At this point we add breakpoint in unused memory (we are in the middle of lib load process now), no need to stop other threads.
-                m_sharedInteropBreakpoints->Add(pid, resolved_brkAddr, resolvedIsThumbCode, [](){});
+                // Note, libs are processed after debuggee continue, other threads could already execute lib code.
+                m_sharedInteropBreakpoints->Add(pid, resolved_brkAddr, resolvedIsThumbCode, StopAllThreads);
             }
 
             bp.m_linenum = resolvedLineNum;
@@ -42,7 +42,7 @@ public:
     void AddAllBreakpointsInfo(std::vector<IDebugger::BreakpointInfo> &list);
 
     bool IsLineBreakpoint(std::uintptr_t addr, Breakpoint &breakpoint);
-    void LoadModule(pid_t pid, std::uintptr_t startAddr, InteropLibraries *pInteropLibraries, std::vector<BreakpointEvent> &events);
+    void LoadModule(pid_t pid, std::uintptr_t startAddr, InteropLibraries *pInteropLibraries, std::vector<BreakpointEvent> &events, std::function<void()> StopAllThreads);
     // Remove all related to unloaded library breakpoints entries in data structures.
     void UnloadModule(std::uintptr_t startAddr, std::uintptr_t endAddr, std::vector<BreakpointEvent> &events);
 
@@ -6,6 +6,7 @@
 #include "debugger/breakpointutils.h"
 #include "metadata/modules.h"
 #include "utils/filesystem.h"
+#include "utils/logger.h"
 #include <unordered_set>
 #include <algorithm>
 
@@ -28,15 +29,144 @@ void LineBreakpoints::DeleteAll()
     m_breakpointsMutex.lock();
     m_lineResolvedBreakpoints.clear();
     m_lineBreakpointMapping.clear();
+    m_hitIndex.clear();
+    m_unverifiedBreakpoints.clear();
+    FlushResolvedCache();
     m_breakpointsMutex.unlock();
 }
 
-HRESULT LineBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint)
+static HRESULT GetHitKey(ICorDebugFunctionBreakpoint *pFunctionBreakpoint, CORDB_ADDRESS &modAddress, mdMethodDef &methodToken, ULONG32 &ilOffset)
+{
+    HRESULT Status;
+    IfFailRet(pFunctionBreakpoint->GetOffset(&ilOffset));
+    ToRelease<ICorDebugFunction> pFunction;
+    IfFailRet(pFunctionBreakpoint->GetFunction(&pFunction));
+    IfFailRet(pFunction->GetToken(&methodToken));
+    ToRelease<ICorDebugModule> pModule;
+    IfFailRet(pFunction->GetModule(&pModule));
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+    return S_OK;
+}
+
+// [out] sameFound - true in case bList have breakpoint, that related to pFunctionBreakpoint.
+HRESULT LineBreakpoints::CheckBreakpointsListHit(ICorDebugThread *pThread, ICorDebugFunctionBreakpoint *pFunctionBreakpoint, std::list<ManagedLineBreakpoint> &bList,
+                                                 unsigned filenameIndex, bool &sameFound, Breakpoint &breakpoint, std::string &logOutput)
+{
+    sameFound = false;
+
+    // Same logic as provide vsdbg - only one breakpoint is active for one line, find first active in the list.
+    for (auto &b : bList)
+    {
+        if (!b.enabled)
+            continue;
+
+        for (const auto &iCorFuncBreakpoint : b.iCorFuncBreakpoints)
+        {
+            if (FAILED(BreakpointUtils::IsSameFunctionBreakpoint(pFunctionBreakpoint, iCorFuncBreakpoint)))
+                continue;
+
+            sameFound = true;
+            if (b.trace)
+                continue; // trace point hit is handled by CheckTraceBreakpointHit()
+
+            if (FAILED(BreakpointUtils::IsEnableByCondition(b.condition, m_sharedVariables.get(), pThread)))
+                continue;
+
+            ++b.times;
+            if (BreakpointUtils::IsEnableByHitCondition(b.hitCondition, b.times) != S_OK)
+                continue;
+
+            if (!b.logMessage.empty())
+            {
+                BreakpointUtils::FormatLogMessage(b.logMessage, m_sharedVariables.get(), pThread, logOutput);
+                return S_FALSE; // log point, no stop
+            }
+
+            std::string fullname;
+            m_sharedModules->GetSourceFullPathByIndex(filenameIndex, fullname);
+            b.ToBreakpoint(breakpoint, fullname);
+            return S_OK;
+        }
+    }
+
+    return S_FALSE; // Stopped at break, but breakpoint not found.
+}
+
+HRESULT LineBreakpoints::CheckTraceBreakpointHit(ICorDebugBreakpoint *pBreakpoint, bool &record, uint32_t &id, unsigned &traceArgs)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugFunctionBreakpoint> pFunctionBreakpoint;
+    IfFailRet(pBreakpoint->QueryInterface(IID_ICorDebugFunctionBreakpoint, (LPVOID *) &pFunctionBreakpoint));
+
+    hit_key_t key;
+    IfFailRet(GetHitKey(pFunctionBreakpoint, key.modAddress, key.methodToken, key.ilOffset));
+
+    std::lock_guard<std::mutex> lock(m_breakpointsMutex);
+
+    auto findKey = m_hitIndex.find(key);
+    if (findKey == m_hitIndex.end())
+        return S_FALSE;
+
+    auto breakpoints = m_lineResolvedBreakpoints.find(findKey->second.first);
+    if (breakpoints == m_lineResolvedBreakpoints.end())
+        return S_FALSE;
+
+    auto it = breakpoints->second.find(findKey->second.second);
+    if (it == breakpoints->second.end())
+        return S_FALSE;
+
+    // Same logic as CheckBreakpointsListHit() have - only first active breakpoint for line is checked.
+    for (auto &b : it->second)
+    {
+        if (!b.enabled)
+            continue;
+
+        for (const auto &iCorFuncBreakpoint : b.iCorFuncBreakpoints)
+        {
+            if (FAILED(BreakpointUtils::IsSameFunctionBreakpoint(pFunctionBreakpoint, iCorFuncBreakpoint)))
+                continue;
+
+            if (!b.trace)
+                return S_FALSE;
+
+            ++b.times;
+            record = BreakpointUtils::IsEnableByHitCondition(b.hitCondition, b.times) == S_OK;
+            id = b.id;
+            traceArgs = b.traceArgs;
+            return S_OK;
+        }
+    }
+
+    return S_FALSE;
+}
+
+HRESULT LineBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint, std::string &logOutput)
 {
     HRESULT Status;
     ToRelease<ICorDebugFunctionBreakpoint> pFunctionBreakpoint;
     IfFailRet(pBreakpoint->QueryInterface(IID_ICorDebugFunctionBreakpoint, (LPVOID *) &pFunctionBreakpoint));
 
+    bool sameFound = false;
+    hit_key_t key;
+    if (SUCCEEDED(GetHitKey(pFunctionBreakpoint, key.modAddress, key.methodToken, key.ilOffset)))
+    {
+        auto findKey = m_hitIndex.find(key);
+        if (findKey != m_hitIndex.end())
+        {
+            auto breakpoints = m_lineResolvedBreakpoints.find(findKey->second.first);
+            if (breakpoints != m_lineResolvedBreakpoints.end())
+            {
+                auto it = breakpoints->second.find(findKey->second.second);
+                if (it != breakpoints->second.end())
+                {
+                    Status = CheckBreakpointsListHit(pThread, pFunctionBreakpoint, it->second, findKey->second.first, sameFound, breakpoint, logOutput);
+                    if (sameFound)
+                        return Status;
+                }
+            }
+        }
+    }
+
     ToRelease<ICorDebugFrame> pFrame;
     IfFailRet(pThread->GetActiveFrame(&pFrame));
     if (pFrame == nullptr)
@@ -62,28 +192,7 @@ HRESULT LineBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugB
     if (bList.empty())
         return S_FALSE; // Stopped at break, but no breakpoints.
 
-    mdMethodDef methodToken;
-    IfFailRet(pFrame->GetFunctionToken(&methodToken));
-
-    // Same logic as provide vsdbg - only one breakpoint is active for one line, find first active in the list.
-    for (auto &b : bList)
-    {
-        if (!b.enabled)
-            continue;
-
-        for (const auto &iCorFuncBreakpoint : b.iCorFuncBreakpoints)
-        {
-            if (FAILED(BreakpointUtils::IsSameFunctionBreakpoint(pFunctionBreakpoint, iCorFuncBreakpoint)) ||
-                FAILED(BreakpointUtils::IsEnableByCondition(b.condition, m_sharedVariables.get(), pThread)))
-                continue;
-
-            ++b.times;
-            b.ToBreakpoint(breakpoint, sp.document);
-            return S_OK;
-        }
-    }
-
-    return S_FALSE; // Stopped at break, but breakpoint not found.
+    return CheckBreakpointsListHit(pThread, pFunctionBreakpoint, bList, filenameIndex, sameFound, breakpoint, logOutput);
 }
 
 static HRESULT EnableOneICorBreakpointForLine(std::list<LineBreakpoints::ManagedLineBreakpoint> &bList)
@@ -116,43 +225,103 @@ static HRESULT EnableOneICorBreakpointForLine(std::list<LineBreakpoints::Managed
     return Status;
 }
 
+LineBreakpoints::ManagedLineBreakpoint LineBreakpoints::CreateManagedLineBreakpoint(const ManagedLineBreakpointMapping &initialBreakpoint)
+{
+    ManagedLineBreakpoint bp;
+    bp.id = initialBreakpoint.id;
+    bp.module = initialBreakpoint.breakpoint.module;
+    bp.enabled = initialBreakpoint.enabled;
+    bp.linenum = initialBreakpoint.breakpoint.line;
+    bp.endLine = initialBreakpoint.breakpoint.line;
+    bp.condition = initialBreakpoint.breakpoint.condition;
+    bp.hitCondition = initialBreakpoint.breakpoint.hitCondition;
+    bp.logMessage = initialBreakpoint.breakpoint.logMessage;
+    bp.trace = initialBreakpoint.breakpoint.trace;
+    bp.traceArgs = initialBreakpoint.breakpoint.traceArgs;
+    return bp;
+}
+
+void LineBreakpoints::AddResolvedBreakpoint(unsigned resolved_fullname_index, ManagedLineBreakpoint &&bp)
+{
+    hit_key_t key;
+    for (const auto &iCorFuncBreakpoint : bp.iCorFuncBreakpoints)
+    {
+        if (SUCCEEDED(GetHitKey(iCorFuncBreakpoint, key.modAddress, key.methodToken, key.ilOffset)))
+            m_hitIndex[key] = std::make_pair(resolved_fullname_index, bp.linenum);
+    }
+
+    std::list<ManagedLineBreakpoint> &bList = m_lineResolvedBreakpoints[resolved_fullname_index][bp.linenum];
+    bList.push_back(std::move(bp));
+    EnableOneICorBreakpointForLine(bList);
+}
+
+// Remove related to module resolved breakpoint and reset initial breakpoint to "unresolved" state.
+HRESULT LineBreakpoints::RemoveResolvedBreakpoint(ManagedLineBreakpointMapping &initialBreakpoint, CORDB_ADDRESS modAddress)
+{
+    auto bMap_it = m_lineResolvedBreakpoints.find(initialBreakpoint.resolved_fullname_index);
+    if (bMap_it == m_lineResolvedBreakpoints.end())
+        return E_FAIL;
+
+    auto bList_it = bMap_it->second.find(initialBreakpoint.resolved_linenum);
+    if (bList_it == bMap_it->second.end())
+        return E_FAIL;
+
+    for (auto itList = bList_it->second.begin(); itList != bList_it->second.end(); ++itList)
+    {
+        if ((*itList).id == initialBreakpoint.id && (*itList).modAddress == modAddress)
+        {
+            bList_it->second.erase(itList);
+            initialBreakpoint.resolved_linenum = 0;
+            initialBreakpoint.resolved_fullname_index = 0;
+            EnableOneICorBreakpointForLine(bList_it->second);
+            break;
+        }
+    }
+
+    return S_OK;
+}
+
 // [in] pModule - optional, provide filter by module during resolve
-// [in,out] bp - breakpoint data for resolve
-static HRESULT ResolveLineBreakpoint(Modules *pModules, ICorDebugModule *pModule, LineBreakpoints::ManagedLineBreakpoint &bp, const std::string &bp_fullname,
-                                     std::vector<ModulesSources::resolved_bp_t> &resolvedPoints, unsigned &bp_fullname_index)
+// [in] bp - breakpoint data for resolve
+// [out] modAddress - module filter for resolve request (0 - all modules)
+static HRESULT GetLineBreakpointResolveModule(Modules *pModules, ICorDebugModule *pModule, const LineBreakpoints::ManagedLineBreakpoint &bp,
+                                              const std::string &bp_fullname, CORDB_ADDRESS &modAddress)
 {
     if (bp_fullname.empty() || bp.linenum <= 0 || bp.endLine <= 0)
         return E_INVALIDARG;
 
     HRESULT Status;
-    CORDB_ADDRESS modAddress = 0;
+    modAddress = 0;
 
     if (!bp.module.empty() && pModule)
     {
-        IfFailRet(IsModuleHaveSameName(pModule, bp.module, IsFullPath(bp.module)));
+        IfFailRet(pModules->IsModuleHaveSameNameCached(pModule, bp.module, IsFullPath(bp.module)));
         if (Status == S_FALSE)
             return E_FAIL;
     }
     else if (!bp.module.empty())
     {
-        bool isFullPath = IsFullPath(bp.module);
-        pModules->ForEachModule([&bp, &modAddress, &isFullPath, &Status](ICorDebugModule *pModule) -> HRESULT
-        {
-            IfFailRet(IsModuleHaveSameName(pModule, bp.module, isFullPath));
-            if (Status == S_FALSE)
-                return S_FALSE;
-
-            IfFailRet(pModule->GetBaseAddress(&modAddress));
-
-            return E_ABORT; // Fast exit from cycle.
-        });
-
-        if (!modAddress)
+        ToRelease<ICorDebugModule> iCorModule;
+        if (FAILED(pModules->GetModuleWithName(bp.module, &iCorModule, false, IsFullPath(bp.module))))
             return E_FAIL;
+
+        IfFailRet(iCorModule->GetBaseAddress(&modAddress));
     }
     else if (pModule) // Filter data from only one module during resolve, if need.
         IfFailRet(pModule->GetBaseAddress(&modAddress));
 
+    return S_OK;
+}
+
+// [in] pModule - optional, provide filter by module during resolve
+// [in,out] bp - breakpoint data for resolve
+static HRESULT ResolveLineBreakpoint(Modules *pModules, ICorDebugModule *pModule, LineBreakpoints::ManagedLineBreakpoint &bp, const std::string &bp_fullname,
+                                     std::vector<ModulesSources::resolved_bp_t> &resolvedPoints, unsigned &bp_fullname_index)
+{
+    HRESULT Status;
+    CORDB_ADDRESS modAddress = 0;
+    IfFailRet(GetLineBreakpointResolveModule(pModules, pModule, bp, bp_fullname, modAddress));
+
     IfFailRet(pModules->ResolveBreakpoint(modAddress, bp_fullname, bp_fullname_index, bp.linenum, resolvedPoints));
     if (resolvedPoints.empty())
         return E_FAIL;
@@ -213,46 +382,298 @@ static HRESULT ActivateLineBreakpoint(LineBreakpoints::ManagedLineBreakpoint &bp
     return S_OK;
 }
 
+// Resolve result points in breakpoint's module, in same form as stored in resolved breakpoints cache.
+// Return breakpoint's module or nullptr in case module's points not found.
+static ICorDebugModule *GetModuleResolvedPoints(CORDB_ADDRESS modAddress, const std::vector<ModulesSources::resolved_bp_t> &resolvedPoints,
+                                                std::vector<ResolvedBreakpointsCache::point_t> &points)
+{
+    ICorDebugModule *pModule = nullptr;
+    points.clear();
+    for (const auto &resolvedBP : resolvedPoints)
+    {
+        CORDB_ADDRESS modAddressTrack = 0;
+        if (FAILED(resolvedBP.iCorModule->GetBaseAddress(&modAddressTrack)) || modAddressTrack != modAddress)
+            continue;
+
+        pModule = resolvedBP.iCorModule.GetPtr();
+        points.push_back({resolvedBP.methodToken, resolvedBP.ilOffset});
+    }
+    return pModule;
+}
+
+// Caller must care about m_breakpointsMutex.
+ResolvedBreakpointsCache::module_entries_t &LineBreakpoints::GetResolvedCacheEntries(const std::string &moduleId)
+{
+    auto find = m_resolvedCache.find(moduleId);
+    if (find != m_resolvedCache.end())
+        return find->second;
+
+    ResolvedBreakpointsCache::module_entries_t &entries = m_resolvedCache[moduleId];
+    ResolvedBreakpointsCache::Load(moduleId, entries);
+    return entries;
+}
+
+// Caller must care about m_breakpointsMutex.
+void LineBreakpoints::StoreResolveResult(ICorDebugModule *pModule, const std::string &filename, int linenum, unsigned resolved_fullname_index,
+                                         const ManagedLineBreakpoint &bp, std::vector<ResolvedBreakpointsCache::point_t> &&points)
+{
+    std::string moduleId;
+    ResolvedBreakpointsCache::entry_t entry;
+    if (!pModule || !ResolvedBreakpointsCache::IsEnabled() ||
+        FAILED(m_sharedModules->GetModuleIdCached(pModule, moduleId)) ||
+        FAILED(m_sharedModules->GetSourceFullPathByIndex(resolved_fullname_index, entry.fullname)))
+        return;
+
+    entry.startLine = bp.linenum;
+    entry.endLine = bp.endLine;
+    entry.points = std::move(points);
+
+    ResolvedBreakpointsCache::module_entries_t &entries = GetResolvedCacheEntries(moduleId);
+    auto find = entries.find(std::make_pair(filename, (int32_t)linenum));
+    if (find != entries.end() &&
+        find->second.fullname == entry.fullname &&
+        find->second.startLine == entry.startLine &&
+        find->second.endLine == entry.endLine &&
+        find->second.points == entry.points)
+        return;
+
+    entries[std::make_pair(filename, (int32_t)linenum)] = std::move(entry);
+    m_resolvedCacheChanged.insert(moduleId);
+}
+
+// Caller must care about m_breakpointsMutex.
+void LineBreakpoints::FlushResolvedCache()
+{
+    for (const auto &moduleId : m_resolvedCacheChanged)
+    {
+        ResolvedBreakpointsCache::StoreAsync(moduleId, m_resolvedCache[moduleId]);
+    }
+    m_resolvedCacheChanged.clear();
+}
+
+// Activate breakpoint with resolve result from previous debug session, without methods ranges load for module.
+// Caller must care about m_breakpointsMutex.
+HRESULT LineBreakpoints::ActivateCachedLineBreakpoint(ICorDebugModule *pModule, const std::string &moduleId, const std::string &filename,
+                                                      ManagedLineBreakpointMapping &initialBreakpoint, ManagedLineBreakpoint &bp,
+                                                      std::vector<BreakpointEvent> &events)
+{
+    const ResolvedBreakpointsCache::module_entries_t &entries = GetResolvedCacheEntries(moduleId);
+    auto find = entries.find(std::make_pair(filename, (int32_t)initialBreakpoint.breakpoint.line));
+    if (find == entries.end() || find->second.points.empty())
+        return E_FAIL;
+
+    HRESULT Status;
+    unsigned resolved_fullname_index = 0;
+    // Note, module's documents are known at this point, even if methods ranges was not indexed yet (lazy indexing).
+    IfFailRet(m_sharedModules->GetIndexBySourceFullPath(find->second.fullname, resolved_fullname_index));
+
+    std::vector<ModulesSources::resolved_bp_t> resolvedPoints;
+    resolvedPoints.reserve(find->second.points.size());
+    for (const auto &point : find->second.points)
+    {
+        pModule->AddRef();
+        resolvedPoints.emplace_back(find->second.startLine, find->second.endLine, point.ilOffset, point.methodToken, pModule);
+    }
+
+    if (FAILED(Status = ActivateLineBreakpoint(bp, filename, m_justMyCode, resolvedPoints)))
+    {
+        // Note, some of runtime breakpoints could be created before fail, breakpoint will be resolved in usual way.
+        for (auto &iCorFuncBreakpoint : bp.iCorFuncBreakpoints)
+        {
+            iCorFuncBreakpoint->Activate(FALSE);
+        }
+        bp.iCorFuncBreakpoints.clear();
+        return Status;
+    }
+
+    std::string resolved_fullname;
+    m_sharedModules->GetSourceFullPathByIndex(resolved_fullname_index, resolved_fullname);
+
+    Breakpoint breakpoint;
+    bp.ToBreakpoint(breakpoint, resolved_fullname);
+    events.emplace_back(BreakpointChanged, breakpoint);
+
+    initialBreakpoint.resolved_fullname_index = resolved_fullname_index;
+    initialBreakpoint.resolved_linenum = bp.linenum;
+
+    m_unverifiedBreakpoints.emplace_back(unverified_bp_t{bp.id, bp.modAddress, moduleId, filename, initialBreakpoint.breakpoint.line, find->second.points});
+    AddResolvedBreakpoint(resolved_fullname_index, std::move(bp));
+    return S_OK;
+}
+
+HRESULT LineBreakpoints::VerifyPreResolvedBreakpoints(std::vector<BreakpointEvent> &events)
+{
+    std::lock_guard<std::mutex> lock(m_breakpointsMutex);
+
+    std::list<unverified_bp_t> unverifiedBreakpoints;
+    unverifiedBreakpoints.swap(m_unverifiedBreakpoints);
+    for (auto &unverified : unverifiedBreakpoints)
+    {
+        auto initialBreakpoints = m_lineBreakpointMapping.find(unverified.filename);
+        if (initialBreakpoints == m_lineBreakpointMapping.end())
+            continue;
+
+        auto initialBreakpoint = std::find_if(initialBreakpoints->second.begin(), initialBreakpoints->second.end(),
+                                              [&](const ManagedLineBreakpointMapping &b) { return b.id == unverified.id; });
+        // Note, breakpoint could be removed or changed since activation, in this case it was resolved in usual way.
+        if (initialBreakpoint == initialBreakpoints->second.end() ||
+            !initialBreakpoint->resolved_linenum ||
+            initialBreakpoint->breakpoint.line != unverified.linenum)
+            continue;
+
+        unsigned resolved_fullname_index = 0;
+        std::vector<ModulesSources::resolved_bp_t> resolvedPoints;
+        std::vector<ResolvedBreakpointsCache::point_t> points;
+        ICorDebugModule *pModule = nullptr;
+        if (SUCCEEDED(m_sharedModules->ResolveBreakpoint(unverified.modAddress, unverified.filename, resolved_fullname_index,
+                                                         unverified.linenum, resolvedPoints)))
+            pModule = GetModuleResolvedPoints(unverified.modAddress, resolvedPoints, points);
+
+        if (pModule &&
+            resolved_fullname_index == initialBreakpoint->resolved_fullname_index &&
+            resolvedPoints[0].startLine == initialBreakpoint->resolved_linenum &&
+            points == unverified.points)
+            continue;
+
+        LOGW("Cached resolve result for breakpoint %s:%d don't match symbols, breakpoint resolved again.",
+             unverified.filename.c_str(), unverified.linenum);
+
+        HRESULT Status;
+        IfFailRet(RemoveResolvedBreakpoint(*initialBreakpoint, unverified.modAddress));
+
+        ManagedLineBreakpoint bp = CreateManagedLineBreakpoint(*initialBreakpoint);
+        Breakpoint breakpoint;
+        if (!pModule || FAILED(ActivateLineBreakpoint(bp, unverified.filename, m_justMyCode, resolvedPoints)))
+        {
+            GetResolvedCacheEntries(unverified.moduleId).erase(std::make_pair(unverified.filename, (int32_t)unverified.linenum));
+            m_resolvedCacheChanged.insert(unverified.moduleId);
+
+            bp.ToBreakpoint(breakpoint, unverified.filename);
+            events.emplace_back(BreakpointChanged, breakpoint);
+            continue;
+        }
+
+        std::string resolved_fullname;
+        m_sharedModules->GetSourceFullPathByIndex(resolved_fullname_index, resolved_fullname);
+
+        bp.ToBreakpoint(breakpoint, resolved_fullname);
+        events.emplace_back(BreakpointChanged, breakpoint);
+
+        initialBreakpoint->resolved_fullname_index = resolved_fullname_index;
+        initialBreakpoint->resolved_linenum = bp.linenum;
+
+        StoreResolveResult(pModule, unverified.filename, unverified.linenum, resolved_fullname_index, bp, std::move(points));
+        AddResolvedBreakpoint(resolved_fullname_index, std::move(bp));
+    }
+
+    FlushResolvedCache();
+    return S_OK;
+}
+
 HRESULT LineBreakpoints::ManagedCallbackLoadModule(ICorDebugModule *pModule, std::vector<BreakpointEvent> &events)
 {
     std::lock_guard<std::mutex> lock(m_breakpointsMutex);
 
+    // Resolve all not yet resolved breakpoints (for all sources) with one request.
+    struct unresolved_bp_t
+    {
+        ManagedLineBreakpointMapping *pInitialBreakpoint;
+        const std::string *pFullname;
+        ManagedLineBreakpoint bp;
+    };
+    std::vector<unresolved_bp_t> unresolvedBreakpoints;
+    std::vector<ModulesSources::resolve_bp_request_t> requests;
+
+    // Note, most of loaded modules don't have any source with pending breakpoints, so, find sources
+    // related to this module by file names first and resolve only related breakpoints.
+    std::vector<std::string> pendingFiles;
+    std::vector<decltype(m_lineBreakpointMapping)::value_type*> pendingBreakpoints;
     for (auto &initialBreakpoints : m_lineBreakpointMapping)
     {
+        if (std::any_of(initialBreakpoints.second.begin(), initialBreakpoints.second.end(),
+                        [](const ManagedLineBreakpointMapping &initialBreakpoint) { return !initialBreakpoint.resolved_linenum; }))
+        {
+            pendingFiles.emplace_back(initialBreakpoints.first);
+            pendingBreakpoints.emplace_back(&initialBreakpoints);
+        }
+    }
+
+    if (pendingFiles.empty())
+        return S_OK;
+
+    HRESULT Status;
+    CORDB_ADDRESS loadedModAddress = 0;
+    IfFailRet(pModule->GetBaseAddress(&loadedModAddress));
+    std::vector<bool> haveSources;
+    IfFailRet(m_sharedModules->FindModuleSources(loadedModAddress, pendingFiles, haveSources));
+
+    // Note, breakpoints with resolve result from previous debug sessions for this module are activated without resolve
+    // (that need methods ranges load for module) and verified later, see VerifyPreResolvedBreakpoints().
+    std::string moduleId;
+    const bool useResolvedCache = ResolvedBreakpointsCache::IsEnabled() && SUCCEEDED(m_sharedModules->GetModuleIdCached(pModule, moduleId));
+
+    for (size_t i = 0; i < pendingBreakpoints.size(); i++)
+    {
+        if (!haveSources[i])
+            continue;
+
+        auto &initialBreakpoints = *pendingBreakpoints[i];
         for (auto &initialBreakpoint : initialBreakpoints.second)
         {
             if (initialBreakpoint.resolved_linenum)
                 continue;
 
-            ManagedLineBreakpoint bp;
-            bp.id = initialBreakpoint.id;
-            bp.module = initialBreakpoint.breakpoint.module;
-            bp.enabled = initialBreakpoint.enabled;
-            bp.linenum = initialBreakpoint.breakpoint.line;
-            bp.endLine = initialBreakpoint.breakpoint.line;
-            bp.condition = initialBreakpoint.breakpoint.condition;
-            unsigned resolved_fullname_index = 0;
-            std::vector<ModulesSources::resolved_bp_t> resolvedPoints;
+            ManagedLineBreakpoint bp = CreateManagedLineBreakpoint(initialBreakpoint);
 
-            if (FAILED(ResolveLineBreakpoint(m_sharedModules.get(), pModule, bp, initialBreakpoints.first, resolvedPoints, resolved_fullname_index)) ||
-                FAILED(ActivateLineBreakpoint(bp, initialBreakpoints.first, m_justMyCode, resolvedPoints)))
+            CORDB_ADDRESS modAddress = 0;
+            if (FAILED(GetLineBreakpointResolveModule(m_sharedModules.get(), pModule, bp, initialBreakpoints.first, modAddress)))
                 continue;
 
-            std::string resolved_fullname;
-            m_sharedModules->GetSourceFullPathByIndex(resolved_fullname_index, resolved_fullname);
+            if (useResolvedCache &&
+                (modAddress == 0 || modAddress == loadedModAddress) &&
+                SUCCEEDED(ActivateCachedLineBreakpoint(pModule, moduleId, initialBreakpoints.first, initialBreakpoint, bp, events)))
+                continue;
 
-            Breakpoint breakpoint;
-            bp.ToBreakpoint(breakpoint, resolved_fullname);
-            events.emplace_back(BreakpointChanged, breakpoint);
+            requests.emplace_back(modAddress, initialBreakpoints.first, bp.linenum);
+            unresolvedBreakpoints.emplace_back(unresolved_bp_t{&initialBreakpoint, &initialBreakpoints.first, std::move(bp)});
+        }
+    }
 
-            initialBreakpoint.resolved_fullname_index = resolved_fullname_index;
-            initialBreakpoint.resolved_linenum = bp.linenum;
+    if (requests.empty())
+        return S_OK;
 
-            m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum].push_back(std::move(bp));
-            EnableOneICorBreakpointForLine(m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum]);
-        }
+    std::vector<ModulesSources::resolve_bp_result_t> results;
+    IfFailRet(m_sharedModules->ResolveBreakpoints(requests, results));
+    std::vector<ResolvedBreakpointsCache::point_t> points;
+
+    for (size_t i = 0; i < unresolvedBreakpoints.size(); i++)
+    {
+        ManagedLineBreakpointMapping &initialBreakpoint = *unresolvedBreakpoints[i].pInitialBreakpoint;
+        ManagedLineBreakpoint &bp = unresolvedBreakpoints[i].bp;
+        const unsigned resolved_fullname_index = results[i].fullname_index;
+
+        if (FAILED(results[i].Status) ||
+            FAILED(ActivateLineBreakpoint(bp, *unresolvedBreakpoints[i].pFullname, m_justMyCode, results[i].resolvedPoints)))
+            continue;
+
+        std::string resolved_fullname;
+        m_sharedModules->GetSourceFullPathByIndex(resolved_fullname_index, resolved_fullname);
+
+        Breakpoint breakpoint;
+        bp.ToBreakpoint(breakpoint, resolved_fullname);
+        events.emplace_back(BreakpointChanged, breakpoint);
+
+        initialBreakpoint.resolved_fullname_index = resolved_fullname_index;
+        initialBreakpoint.resolved_linenum = bp.linenum;
+
+        ICorDebugModule *pResolvedModule = GetModuleResolvedPoints(bp.modAddress, results[i].resolvedPoints, points);
+        StoreResolveResult(pResolvedModule, *unresolvedBreakpoints[i].pFullname, initialBreakpoint.breakpoint.line,
+                           resolved_fullname_index, bp, std::move(points));
+
+        AddResolvedBreakpoint(resolved_fullname_index, std::move(bp));
     }
 
+    FlushResolvedCache();
     return S_OK;
 }
 
@@ -310,6 +731,10 @@ HRESULT LineBreakpoints::UpdateLineBreakpoint(bool haveProcess, int id, int line
             bp.linenum = initialBreakpoint.breakpoint.line;
             bp.endLine = initialBreakpoint.breakpoint.line;
             bp.condition = initialBreakpoint.breakpoint.condition;
+            bp.hitCondition = initialBreakpoint.breakpoint.hitCondition;
+            bp.logMessage = initialBreakpoint.breakpoint.logMessage;
+            bp.trace = initialBreakpoint.breakpoint.trace;
+            bp.traceArgs = initialBreakpoint.breakpoint.traceArgs;
 
             unsigned resolved_fullname_index = 0;
             std::vector<ModulesSources::resolved_bp_t> resolvedPoints;
@@ -327,8 +752,7 @@ HRESULT LineBreakpoints::UpdateLineBreakpoint(bool haveProcess, int id, int line
 
             bp.ToBreakpoint(breakpoint, resolved_fullname);
 
-            m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum].push_back(std::move(bp));
-            EnableOneICorBreakpointForLine(m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum]);
+            AddResolvedBreakpoint(resolved_fullname_index, std::move(bp));
             return S_OK;
         }
     }
@@ -412,11 +836,42 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
         }
     }
 
+    // Resolve all new breakpoints with one request.
+    std::vector<ModulesSources::resolve_bp_request_t> requests;
+    // index in lineBreakpoints -> index in requests/results
+    std::unordered_map<size_t, size_t> requestsIndexes;
+    std::vector<ModulesSources::resolve_bp_result_t> results;
+    if (haveProcess)
+    {
+        for (size_t i = 0; i < lineBreakpoints.size(); i++)
+        {
+            if (breakpointsInSourceMap.find(lineBreakpoints[i].line) != breakpointsInSourceMap.end())
+                continue;
+
+            ManagedLineBreakpoint bp;
+            bp.module = lineBreakpoints[i].module;
+            bp.linenum = lineBreakpoints[i].line;
+            bp.endLine = lineBreakpoints[i].line;
+
+            CORDB_ADDRESS modAddress = 0;
+            if (FAILED(GetLineBreakpointResolveModule(m_sharedModules.get(), nullptr, bp, filename, modAddress)))
+                continue;
+
+            requestsIndexes[i] = requests.size();
+            requests.emplace_back(modAddress, filename, bp.linenum);
+        }
+
+        // In case of fail, all new breakpoints will be added as not resolved.
+        if (!requests.empty() && FAILED(m_sharedModules->ResolveBreakpoints(requests, results)))
+            requestsIndexes.clear();
+    }
+
     // Export breakpoints
     // Note, VSCode and MI/GDB protocols requires, that "breakpoints" and "lineBreakpoints" must have same indexes for same breakpoints.
 
-    for (const auto &sb : lineBreakpoints)
+    for (size_t i = 0; i < lineBreakpoints.size(); i++)
     {
+        const auto &sb = lineBreakpoints[i];
         int line = sb.line;
         Breakpoint breakpoint;
 
@@ -434,20 +889,26 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
             bp.linenum = line;
             bp.endLine = line;
             bp.condition = initialBreakpoint.breakpoint.condition;
-            unsigned resolved_fullname_index = 0;
-            std::vector<ModulesSources::resolved_bp_t> resolvedPoints;
-
-            if (haveProcess &&
-                SUCCEEDED(ResolveLineBreakpoint(m_sharedModules.get(), nullptr, bp, filename, resolvedPoints, resolved_fullname_index)) &&
-                SUCCEEDED(ActivateLineBreakpoint(bp, filename, m_justMyCode, resolvedPoints)))
+            bp.hitCondition = initialBreakpoint.breakpoint.hitCondition;
+            bp.logMessage = initialBreakpoint.breakpoint.logMessage;
+            bp.trace = initialBreakpoint.breakpoint.trace;
+            bp.traceArgs = initialBreakpoint.breakpoint.traceArgs;
+            auto findRequestIndex = requestsIndexes.find(i);
+
+            if (findRequestIndex != requestsIndexes.end() &&
+                SUCCEEDED(results[findRequestIndex->second].Status) &&
+                SUCCEEDED(ActivateLineBreakpoint(bp, filename, m_justMyCode, results[findRequestIndex->second].resolvedPoints)))
             {
+                const unsigned resolved_fullname_index = results[findRequestIndex->second].fullname_index;
                 initialBreakpoint.resolved_fullname_index = resolved_fullname_index;
                 initialBreakpoint.resolved_linenum = bp.linenum;
                 std::string resolved_fullname;
                 m_sharedModules->GetSourceFullPathByIndex(resolved_fullname_index, resolved_fullname);
                 bp.ToBreakpoint(breakpoint, resolved_fullname);
-                m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum].push_back(std::move(bp));
-                EnableOneICorBreakpointForLine(m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum]);
+                std::vector<ResolvedBreakpointsCache::point_t> points;
+                ICorDebugModule *pResolvedModule = GetModuleResolvedPoints(bp.modAddress, results[findRequestIndex->second].resolvedPoints, points);
+                StoreResolveResult(pResolvedModule, filename, line, resolved_fullname_index, bp, std::move(points));
+                AddResolvedBreakpoint(resolved_fullname_index, std::move(bp));
             }
             else
             {
@@ -464,6 +925,10 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
         {
             ManagedLineBreakpointMapping &initialBreakpoint = *b->second;
             initialBreakpoint.breakpoint.condition = sb.condition;
+            initialBreakpoint.breakpoint.hitCondition = sb.hitCondition;
+            initialBreakpoint.breakpoint.logMessage = sb.logMessage;
+            initialBreakpoint.breakpoint.trace = sb.trace;
+            initialBreakpoint.breakpoint.traceArgs = sb.traceArgs;
 
             if (initialBreakpoint.resolved_linenum)
             {
@@ -482,6 +947,10 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
 
                     // Existing breakpoint
                     bp.condition = initialBreakpoint.breakpoint.condition;
+                    bp.hitCondition = initialBreakpoint.breakpoint.hitCondition;
+                    bp.logMessage = initialBreakpoint.breakpoint.logMessage;
+                    bp.trace = initialBreakpoint.breakpoint.trace;
+                    bp.traceArgs = initialBreakpoint.breakpoint.traceArgs;
                     std::string resolved_fullname;
                     m_sharedModules->GetSourceFullPathByIndex(initialBreakpoint.resolved_fullname_index, resolved_fullname);
                     bp.ToBreakpoint(breakpoint, resolved_fullname);
@@ -497,6 +966,10 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
                 bp.linenum = line;
                 bp.endLine = line;
                 bp.condition = initialBreakpoint.breakpoint.condition;
+                bp.hitCondition = initialBreakpoint.breakpoint.hitCondition;
+                bp.logMessage = initialBreakpoint.breakpoint.logMessage;
+                bp.trace = initialBreakpoint.breakpoint.trace;
+                bp.traceArgs = initialBreakpoint.breakpoint.traceArgs;
                 bp.ToBreakpoint(breakpoint, filename);
                 if (!haveProcess)
                     breakpoint.message = "The breakpoint is pending and will be resolved when debugging starts.";
@@ -508,11 +981,16 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
         breakpoints.push_back(breakpoint);
     }
 
+    FlushResolvedCache();
     return S_OK;
 }
 
-HRESULT LineBreakpoints::UpdateBreakpointsOnHotReload(ICorDebugModule *pModule, std::unordered_set<mdMethodDef> &methodTokens, std::vector<BreakpointEvent> &events)
+HRESULT LineBreakpoints::UpdateBreakpointsOnHotReload(ICorDebugModule *pModule, std::unordered_set<unsigned> &updatedSources, std::vector<BreakpointEvent> &events)
 {
+    // Note, only sources with new/changed methods or line updates could change breakpoints resolve.
+    if (updatedSources.empty())
+        return S_OK;
+
     std::lock_guard<std::mutex> lock(m_breakpointsMutex);
 
     HRESULT Status;
@@ -523,42 +1001,19 @@ HRESULT LineBreakpoints::UpdateBreakpointsOnHotReload(ICorDebugModule *pModule,
     {
         for (auto &initialBreakpoint : initialBreakpoints.second)
         {
+            // Resolved in not updated source breakpoint have same methods and lines, keep its ICorDebugFunctionBreakpoints untouched.
+            // Note, unresolved breakpoint could be resolved now in new methods, try to resolve it again.
+            if (initialBreakpoint.resolved_linenum &&
+                updatedSources.find(initialBreakpoint.resolved_fullname_index) == updatedSources.end())
+                continue;
+
             int initiallyResolved_linenum = initialBreakpoint.resolved_linenum;
             if (initialBreakpoint.resolved_linenum)
-            {
-                auto bMap_it = m_lineResolvedBreakpoints.find(initialBreakpoint.resolved_fullname_index);
-                if (bMap_it == m_lineResolvedBreakpoints.end())
-                    return E_FAIL;
-
-                auto bList_it = bMap_it->second.find(initialBreakpoint.resolved_linenum);
-                if (bList_it == bMap_it->second.end())
-                    return E_FAIL;
-
-                for (auto itList = bList_it->second.begin(); itList != bList_it->second.end();)
-                {
-                    if ((*itList).id == initialBreakpoint.id && (*itList).modAddress == modAddress)
-                    {
-                        // Remove related resolved breakpoint and reset initial breakpoint to "unresolved" state.
-                        bList_it->second.erase(itList);
-                        initialBreakpoint.resolved_linenum = 0;
-                        initialBreakpoint.resolved_fullname_index = 0;
-                        EnableOneICorBreakpointForLine(bList_it->second);
-                        break;
-                    }
-                    else
-                        ++itList;
-                }
-            }
+                IfFailRet(RemoveResolvedBreakpoint(initialBreakpoint, modAddress));
             if (initiallyResolved_linenum && initialBreakpoint.resolved_linenum)
                 continue;
 
-            ManagedLineBreakpoint bp;
-            bp.id = initialBreakpoint.id;
-            bp.module = initialBreakpoint.breakpoint.module;
-            bp.enabled = initialBreakpoint.enabled;
-            bp.linenum = initialBreakpoint.breakpoint.line;
-            bp.endLine = initialBreakpoint.breakpoint.line;
-            bp.condition = initialBreakpoint.breakpoint.condition;
+            ManagedLineBreakpoint bp = CreateManagedLineBreakpoint(initialBreakpoint);
             unsigned resolved_fullname_index = 0;
             Breakpoint breakpoint;
             std::vector<ModulesSources::resolved_bp_t> resolvedPoints;
@@ -587,19 +1042,17 @@ HRESULT LineBreakpoints::UpdateBreakpointsOnHotReload(ICorDebugModule *pModule,
                 events.emplace_back(BreakpointChanged, breakpoint);
             }
 
-            m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum].push_back(std::move(bp));
-            EnableOneICorBreakpointForLine(m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum]);
+            AddResolvedBreakpoint(resolved_fullname_index, std::move(bp));
         }
     }
 
     return S_OK;
 }
 
-HRESULT LineBreakpoints::AllBreakpointsActivate(bool act)
+void LineBreakpoints::AllBreakpointsActivate(bool act)
 {
     std::lock_guard<std::mutex> lock(m_breakpointsMutex);
 
-    HRESULT Status = S_OK;
     // resolved breakpoints
     for (auto &file_bps : m_lineResolvedBreakpoints)
     {
@@ -609,8 +1062,6 @@ HRESULT LineBreakpoints::AllBreakpointsActivate(bool act)
             {
                 rbp.enabled = act;
             }
-            HRESULT ret = EnableOneICorBreakpointForLine(line_bps.second);
-            Status = FAILED(ret) ? ret : Status;
         }
     }
 
@@ -622,8 +1073,37 @@ HRESULT LineBreakpoints::AllBreakpointsActivate(bool act)
             bp.enabled = act;
         }
     }
+}
 
-    return Status;
+void LineBreakpoints::ApplyAllBreakpointsActivation(std::function<bool()> isCanceled)
+{
+    // Note, mutex is not held during all ICorDebug calls, but for one line's breakpoints only.
+    std::vector<std::pair<unsigned, int>> lines;
+    std::unique_lock<std::mutex> lock(m_breakpointsMutex);
+    for (const auto &file_bps : m_lineResolvedBreakpoints)
+    {
+        for (const auto &line_bps : file_bps.second)
+        {
+            lines.emplace_back(file_bps.first, line_bps.first);
+        }
+    }
+    lock.unlock();
+
+    for (const auto &line : lines)
+    {
+        if (isCanceled())
+            return;
+
+        lock.lock();
+        auto bMap_it = m_lineResolvedBreakpoints.find(line.first);
+        if (bMap_it != m_lineResolvedBreakpoints.end())
+        {
+            auto bList_it = bMap_it->second.find(line.second);
+            if (bList_it != bMap_it->second.end())
+                EnableOneICorBreakpointForLine(bList_it->second);
+        }
+        lock.unlock();
+    }
 }
 
 HRESULT LineBreakpoints::BreakpointActivate(uint32_t id, bool act)
@@ -708,4 +1188,20 @@ void LineBreakpoints::AddAllBreakpointsInfo(std::vector<IDebugger::BreakpointInf
     }
 }
 
+void LineBreakpoints::AddModulesWithBreakpoints(std::unordered_set<CORDB_ADDRESS> &modules)
+{
+    std::lock_guard<std::mutex> lock(m_breakpointsMutex);
+
+    for (auto &file_bps : m_lineResolvedBreakpoints)
+    {
+        for (auto &line_bps : file_bps.second)
+        {
+            for (auto &bp : line_bps.second)
+            {
+                modules.insert(bp.modAddress);
+            }
+        }
+    }
+}
+
 } // namespace netcoredbg
@@ -13,7 +13,9 @@
 #include <list>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include "interfaces/idebugger.h"
+#include "metadata/resolved_bp_cache.h"
 #include "utils/torelease.h"
 
 namespace netcoredbg
@@ -37,15 +39,24 @@ public:
     HRESULT UpdateLineBreakpoint(bool haveProcess, int id, int linenum, Breakpoint &breakpoint);
     HRESULT SetLineBreakpoints(bool haveProcess, const std::string &filename, const std::vector<LineBreakpoint> &lineBreakpoints,
                                std::vector<Breakpoint> &breakpoints, std::function<uint32_t()> getId);
-    HRESULT UpdateBreakpointsOnHotReload(ICorDebugModule *pModule, std::unordered_set<mdMethodDef> &methodTokens, std::vector<BreakpointEvent> &events);
-    HRESULT AllBreakpointsActivate(bool act);
+    HRESULT UpdateBreakpointsOnHotReload(ICorDebugModule *pModule, std::unordered_set<unsigned> &updatedSources, std::vector<BreakpointEvent> &events);
+    // Note, change breakpoints state only, runtime breakpoints state must be changed by ApplyAllBreakpointsActivation() call.
+    void AllBreakpointsActivate(bool act);
+    // Activate/deactivate runtime breakpoints in accordance with breakpoints state, `isCanceled` checked between breakpoints.
+    void ApplyAllBreakpointsActivation(std::function<bool()> isCanceled);
     HRESULT BreakpointActivate(uint32_t id, bool act);
     void AddAllBreakpointsInfo(std::vector<IDebugger::BreakpointInfo> &list);
+    void AddModulesWithBreakpoints(std::unordered_set<CORDB_ADDRESS> &modules);
 
     // Important! Must provide succeeded return code:
     // S_OK - breakpoint hit
     // S_FALSE - no breakpoint hit
-    HRESULT CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint);
+    // Note, in case of log point hit, S_FALSE returned and interpolated log message appended to `logOutput`.
+    HRESULT CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint, std::string &logOutput);
+    // Could be called from managed callback thread, since don't need any evaluation.
+    // S_OK - trace point hit, in case hit condition was not passed `record` is false
+    // S_FALSE - no trace point hit
+    HRESULT CheckTraceBreakpointHit(ICorDebugBreakpoint *pBreakpoint, bool &record, uint32_t &id, unsigned &traceArgs);
 
     // Important! Callbacks related methods must control return for succeeded return code.
     // Do not allow debugger API return succeeded (uncontrolled) return code.
@@ -55,6 +66,10 @@ public:
     //     IfFailRet(pThread->GetID(&threadId));
     //     return S_OK;
     HRESULT ManagedCallbackLoadModule(ICorDebugModule *pModule, std::vector<BreakpointEvent> &events);
+    // Breakpoints activated at module load from resolved breakpoints cache are verified by real resolve, in case resolve
+    // result changed, breakpoint is resolved again and BreakpointChanged event added into `events`.
+    // Note, should be called at stop event, since verification (methods ranges load for module) could take a while.
+    HRESULT VerifyPreResolvedBreakpoints(std::vector<BreakpointEvent> &events);
 
     struct ManagedLineBreakpoint
     {
@@ -66,6 +81,10 @@ public:
         bool enabled;
         ULONG32 times;
         std::string condition;
+        std::string hitCondition;
+        std::string logMessage;
+        bool trace;
+        unsigned traceArgs;
         // In case of code line in constructor, we could resolve multiple methods for breakpoints.
         // For example, `MyType obj = new MyType(1);` code will be added to all class constructors).
         std::vector<ToRelease<ICorDebugFunctionBreakpoint> > iCorFuncBreakpoints;
@@ -73,7 +92,7 @@ public:
         bool IsVerified() const { return !iCorFuncBreakpoints.empty(); }
 
         ManagedLineBreakpoint() :
-            id(0), modAddress(0), linenum(0), endLine(0), enabled(true), times(0)
+            id(0), modAddress(0), linenum(0), endLine(0), enabled(true), times(0), trace(false), traceArgs(0)
         {}
 
         ~ManagedLineBreakpoint()
@@ -111,6 +130,55 @@ private:
         ~ManagedLineBreakpointMapping() = default;
     };
 
+    // Hit dispatch key, same for ICorDebugFunctionBreakpoint from callback and one, that was created by us.
+    struct hit_key_t
+    {
+        CORDB_ADDRESS modAddress;
+        mdMethodDef methodToken;
+        ULONG32 ilOffset;
+
+        bool operator == (const hit_key_t &other) const
+        {
+            return modAddress == other.modAddress && methodToken == other.methodToken && ilOffset == other.ilOffset;
+        }
+    };
+
+    struct hit_key_t_hash
+    {
+        size_t operator()(const hit_key_t &key) const
+        {
+            uint64_t hash = key.modAddress ^ ((uint64_t)key.ilOffset << 32) ^ key.methodToken;
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdULL;
+            hash ^= hash >> 33;
+            return (size_t)hash;
+        }
+    };
+
+    // Breakpoint activated from resolved breakpoints cache, but not verified by real resolve yet.
+    struct unverified_bp_t
+    {
+        uint32_t id;
+        CORDB_ADDRESS modAddress;
+        std::string moduleId;
+        std::string filename; // breakpoint's source path as provided by protocol
+        int linenum; // breakpoint's line as provided by protocol
+        std::vector<ResolvedBreakpointsCache::point_t> points;
+    };
+
+    static ManagedLineBreakpoint CreateManagedLineBreakpoint(const ManagedLineBreakpointMapping &initialBreakpoint);
+    void AddResolvedBreakpoint(unsigned resolved_fullname_index, ManagedLineBreakpoint &&bp);
+    HRESULT RemoveResolvedBreakpoint(ManagedLineBreakpointMapping &initialBreakpoint, CORDB_ADDRESS modAddress);
+    HRESULT ActivateCachedLineBreakpoint(ICorDebugModule *pModule, const std::string &moduleId, const std::string &filename,
+                                         ManagedLineBreakpointMapping &initialBreakpoint, ManagedLineBreakpoint &bp,
+                                         std::vector<BreakpointEvent> &events);
+    ResolvedBreakpointsCache::module_entries_t &GetResolvedCacheEntries(const std::string &moduleId);
+    void StoreResolveResult(ICorDebugModule *pModule, const std::string &filename, int linenum, unsigned resolved_fullname_index,
+                            const ManagedLineBreakpoint &bp, std::vector<ResolvedBreakpointsCache::point_t> &&points);
+    void FlushResolvedCache();
+    HRESULT CheckBreakpointsListHit(ICorDebugThread *pThread, ICorDebugFunctionBreakpoint *pFunctionBreakpoint, std::list<ManagedLineBreakpoint> &bList,
+                                    unsigned filenameIndex, bool &sameFound, Breakpoint &breakpoint, std::string &logOutput);
+
     std::mutex m_breakpointsMutex;
     // Resolved line breakpoints:
     // Mapped in order to fast search with mapping data (see container below):
@@ -122,6 +190,16 @@ private:
     // Container have structure for fast compare current breakpoints data with new breakpoints data from protocol:
     // path to source -> list of ManagedLineBreakpointMapping that include LineBreakpoint (from protocol) and resolve related data.
     std::unordered_map<std::string, std::list<ManagedLineBreakpointMapping> > m_lineBreakpointMapping;
+    // Breakpoint hit dispatch without frame's sequence point calculation (managed part call) and source path search:
+    // module, method token, IL offset -> resolved source full path index and resolved line number in m_lineResolvedBreakpoints.
+    // Note, entries are not removed with breakpoints (map only point to list, that should be checked), but overwritten
+    // by latest resolved breakpoint with same key, in case of miss, slow path with sequence point is used.
+    std::unordered_map<hit_key_t, std::pair<unsigned, int>, hit_key_t_hash> m_hitIndex;
+    // Resolve results from previous and current debug sessions by module ID (loaded from disk at first module's access),
+    // and modules with changed results, that must be stored on disk.
+    std::unordered_map<std::string, ResolvedBreakpointsCache::module_entries_t> m_resolvedCache;
+    std::unordered_set<std::string> m_resolvedCacheChanged;
+    std::list<unverified_bp_t> m_unverifiedBreakpoints;
 
 };
 
@@ -6,6 +6,9 @@
 #include "debugger/variables.h"
 #include "metadata/attributes.h"
 #include "utils/torelease.h"
+#include <cstring>
+#include <cctype>
+#include <limits>
 
 namespace netcoredbg
 {
@@ -75,6 +78,11 @@ HRESULT IsEnableByCondition(const std::string &condition, Variables *pVariables,
 
     if (!condition.empty())
     {
+        // Fast path for trivial conditions (like `i == 1000` or `obj != null`), that don't need stack machine.
+        bool result = false;
+        if (pVariables->EvaluateTrivialCondition(pThread, FrameLevel{0}, condition, result) == S_OK)
+            return result ? S_OK : E_FAIL;
+
         DWORD threadId = 0;
         IfFailRet(pThread->GetID(&threadId));
         FrameId frameId(ThreadId{threadId}, FrameLevel{0});
@@ -93,6 +101,88 @@ HRESULT IsEnableByCondition(const std::string &condition, Variables *pVariables,
     return S_OK;
 }
 
+HRESULT IsEnableByHitCondition(const std::string &hitCondition, ULONG32 times)
+{
+    size_t pos = hitCondition.find_first_not_of(" \t");
+    if (pos == std::string::npos)
+        return S_OK;
+
+    enum class HitOperation { Equal, Greater, GreaterOrEqual, Less, LessOrEqual, Multiple };
+    HitOperation operation = HitOperation::Equal;
+    static const std::pair<const char*, HitOperation> operations[] = {
+        {"==", HitOperation::Equal}, {">=", HitOperation::GreaterOrEqual}, {"<=", HitOperation::LessOrEqual},
+        {"=", HitOperation::Equal}, {">", HitOperation::Greater}, {"<", HitOperation::Less}, {"%", HitOperation::Multiple}
+    };
+    for (const auto &entry : operations)
+    {
+        if (hitCondition.compare(pos, strlen(entry.first), entry.first) == 0)
+        {
+            operation = entry.second;
+            pos = hitCondition.find_first_not_of(" \t", pos + strlen(entry.first));
+            break;
+        }
+    }
+
+    if (pos == std::string::npos || !isdigit((unsigned char)hitCondition[pos]))
+        return E_INVALIDARG;
+
+    uint64_t count = 0;
+    for (; pos < hitCondition.size() && isdigit((unsigned char)hitCondition[pos]); pos++)
+    {
+        count = count * 10 + (hitCondition[pos] - '0');
+        if (count > std::numeric_limits<ULONG32>::max())
+            return E_INVALIDARG;
+    }
+
+    if (hitCondition.find_first_not_of(" \t", pos) != std::string::npos)
+        return E_INVALIDARG;
+
+    bool enable = false;
+    switch (operation)
+    {
+        case HitOperation::Equal:          enable = times == count; break;
+        case HitOperation::Greater:        enable = times > count; break;
+        case HitOperation::GreaterOrEqual: enable = times >= count; break;
+        case HitOperation::Less:           enable = times < count; break;
+        case HitOperation::LessOrEqual:    enable = times <= count; break;
+        case HitOperation::Multiple:
+            if (count == 0)
+                return E_INVALIDARG;
+            enable = times % count == 0;
+            break;
+    }
+
+    return enable ? S_OK : S_FALSE;
+}
+
+void FormatLogMessage(const std::string &logMessage, Variables *pVariables, ICorDebugThread *pThread, std::string &output)
+{
+    size_t pos = 0;
+    while (pos < logMessage.size())
+    {
+        size_t start = logMessage.find('{', pos);
+        size_t end = start == std::string::npos ? std::string::npos : logMessage.find('}', start + 1);
+        if (end == std::string::npos)
+        {
+            output.append(logMessage, pos, std::string::npos);
+            break;
+        }
+
+        output.append(logMessage, pos, start - pos);
+        pos = end + 1;
+
+        const std::string expression(logMessage, start + 1, end - start - 1);
+        std::string value;
+        std::string evalOutput;
+        if (SUCCEEDED(pVariables->EvaluateAndPrint(pThread, FrameLevel{0}, expression, value, evalOutput)))
+            output.append(value);
+        else
+            output.append(evalOutput.empty() ? "<error>" : evalOutput);
+    }
+
+    output.append("\n");
+}
+
 HRESULT SkipBreakpoint(ICorDebugModule *pModule, mdMethodDef methodToken, bool justMyCode)
 {
     HRESULT Status;
@@ -18,6 +18,10 @@ namespace BreakpointUtils
 {
     HRESULT IsSameFunctionBreakpoint(ICorDebugFunctionBreakpoint *pBreakpoint1, ICorDebugFunctionBreakpoint *pBreakpoint2);
     HRESULT IsEnableByCondition(const std::string &condition, Variables *pVariables, ICorDebugThread *pThread);
+    // S_OK - enabled by hit condition, S_FALSE - not enabled, E_INVALIDARG - wrong hit condition format.
+    HRESULT IsEnableByHitCondition(const std::string &hitCondition, ULONG32 times);
+    // Interpolate log point message and append it to `output`, expressions in curly braces are evaluated in thread's top frame context.
+    void FormatLogMessage(const std::string &logMessage, Variables *pVariables, ICorDebugThread *pThread, std::string &output);
     HRESULT SkipBreakpoint(ICorDebugModule *pModule, mdMethodDef methodToken, bool justMyCode);
 }
 
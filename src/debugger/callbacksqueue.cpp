@@ -13,9 +13,17 @@
 #include "debugger/stepper_simple.h"
 #include "debugger/stepper_async.h"
 #include "debugger/steppers.h"
+#include "debugger/stepstats.h"
 #include "interfaces/iprotocol.h"
+#include "utils/logger.h"
+#include "utils/perfcounters.h"
+#include "utils/tracerecorder.h"
+#include "utils/utf.h"
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 namespace netcoredbg
 {
@@ -27,15 +35,29 @@ bool CallbacksQueue::CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain, I
     if (S_OK == m_debugger.m_sharedBreakpoints->CheckApplicationReload(pThread, pBreakpoint))
         return false;
 
+    // Note, breakpoints in not user code are filtered by JMC status.
+    m_debugger.m_sharedModules->ApplyDeferredJMC();
+
     // S_FALSE - not error and steppers not affect on callback
-    if (S_FALSE != m_debugger.m_uniqueSteppers->ManagedCallbackBreakpoint(pAppDomain, pThread))
+    bool stepComplete = false;
+    if (S_FALSE != m_debugger.m_uniqueSteppers->ManagedCallbackBreakpoint(pAppDomain, pThread, pBreakpoint, stepComplete))
+    {
+        // Step-out breakpoint reached, steppers already done all step complete related work.
+        if (stepComplete)
+            return CallbacksWorkerStepComplete(pAppDomain, pThread, CorDebugStepReason::STEP_RETURN, true);
         return false;
+    }
 
     bool atEntry = false;
+    bool atTemporary = false;
     ThreadId threadId(getThreadId(pThread));
     StoppedEvent event(StopBreakpoint, threadId);
+    std::string logOutput;
+    HRESULT Status = m_debugger.m_sharedBreakpoints->ManagedCallbackBreakpoint(pThread, pBreakpoint, event.breakpoint, atEntry, atTemporary, logOutput);
+    // Log point hit, output will be emitted before stop event or process continue.
+    m_logPointsOutput.append(logOutput);
     // S_FALSE - not error and not affect on callback (callback will emit stop event)
-    if (S_FALSE != m_debugger.m_sharedBreakpoints->ManagedCallbackBreakpoint(pThread, pBreakpoint, event.breakpoint, atEntry))
+    if (S_FALSE != Status)
         return false;
 
     // Disable all steppers if we stop at breakpoint during step.
@@ -43,6 +65,9 @@ bool CallbacksQueue::CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain, I
 
     if (atEntry)
         event.reason = StopEntry;
+    // Note, "run to cursor" and "step into target" are reported as step, protocol don't know about internal breakpoint.
+    else if (atTemporary)
+        event.reason = StopStep;
 
     ToRelease<ICorDebugFrame> pFrame;
     if (SUCCEEDED(pThread->GetActiveFrame(&pFrame)) && pFrame != nullptr)
@@ -52,20 +77,25 @@ bool CallbacksQueue::CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain, I
     StopAllNativeThreads();
 #endif // INTEROP_DEBUGGING
 
+    FlushLogPointsOutput();
     m_debugger.SetLastStoppedThread(pThread);
+    const bool stopProcess = StopEventThread(pThread, event);
     m_debugger.pProtocol->EmitStoppedEvent(event);
     m_debugger.m_ioredirect.async_cancel();
-    return true;
+    return stopProcess;
 }
 
-bool CallbacksQueue::CallbacksWorkerStepComplete(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, CorDebugStepReason reason)
+bool CallbacksQueue::CallbacksWorkerStepComplete(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, CorDebugStepReason reason, bool filtered)
 {
     m_debugger.m_sharedBreakpoints->CheckApplicationReload(pThread);
 
     // S_FALSE - not error and steppers not affect on callback (callback will emit stop event)
-    if (S_FALSE != m_debugger.m_uniqueSteppers->ManagedCallbackStepComplete(pThread, reason))
+    if (!filtered && S_FALSE != m_debugger.m_uniqueSteppers->ManagedCallbackStepComplete(pThread, reason))
         return false;
 
+    // Note, stopped event emit time include top frame location and stop all native threads (for interop).
+    StepStats::ScopedTimer timer(StepStats::Phase::StoppedEvent);
+
     StackFrame stackFrame;
     ToRelease<ICorDebugFrame> iCorFrame;
     ThreadId threadId(getThreadId(pThread));
@@ -80,9 +110,10 @@ bool CallbacksQueue::CallbacksWorkerStepComplete(ICorDebugAppDomain *pAppDomain,
 #endif // INTEROP_DEBUGGING
 
     m_debugger.SetLastStoppedThread(pThread);
+    const bool stopProcess = StopEventThread(pThread, event);
     m_debugger.pProtocol->EmitStoppedEvent(event);
     m_debugger.m_ioredirect.async_cancel();
-    return true;
+    return stopProcess;
 }
 
 bool CallbacksQueue::CallbacksWorkerBreak(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread)
@@ -110,12 +141,13 @@ bool CallbacksQueue::CallbacksWorkerBreak(ICorDebugAppDomain *pAppDomain, ICorDe
 
     StoppedEvent event(StopPause, threadId);
     event.frame = stackFrame;
+    const bool stopProcess = StopEventThread(pThread, event);
     m_debugger.pProtocol->EmitStoppedEvent(event);
     m_debugger.m_ioredirect.async_cancel();
-    return true;
+    return stopProcess;
 }
 
-bool CallbacksQueue::CallbacksWorkerException(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ExceptionCallbackType eventType, const std::string &excModule)
+bool CallbacksQueue::CallbacksWorkerException(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, const std::string &excModule)
 {
     m_debugger.m_sharedBreakpoints->CheckApplicationReload(pThread);
 
@@ -123,7 +155,7 @@ bool CallbacksQueue::CallbacksWorkerException(ICorDebugAppDomain *pAppDomain, IC
     StoppedEvent event(StopException, threadId);
 
     // S_FALSE - not error and not affect on callback (callback will emit stop event)
-    if (S_FALSE != m_debugger.m_sharedBreakpoints->ManagedCallbackException(pThread, eventType, excModule, event))
+    if (S_FALSE != m_debugger.m_sharedBreakpoints->ManagedCallbackException(pThread, excModule, event))
         return false;
 
     ToRelease<ICorDebugFrame> pActiveFrame;
@@ -138,9 +170,29 @@ bool CallbacksQueue::CallbacksWorkerException(ICorDebugAppDomain *pAppDomain, IC
 #endif // INTEROP_DEBUGGING
 
     m_debugger.SetLastStoppedThread(pThread);
+    const bool stopProcess = StopEventThread(pThread, event);
     m_debugger.pProtocol->EmitStoppedEvent(event);
     m_debugger.m_ioredirect.async_cancel();
-    return true;
+    return stopProcess;
+}
+
+// NOTE caller must care about m_callbacksMutex.
+bool CallbacksQueue::StopEventThread(ICorDebugThread *pThread, StoppedEvent &event)
+{
+    // Note, native threads are stopped by interop debugger for all stop events, non-stop mode is not supported for interop.
+    if (!m_debugger.m_nonStop || m_debugger.m_interopDebugging)
+        return true;
+
+    HRESULT Status;
+    if (FAILED(Status = pThread->SetDebugState(THREAD_SUSPEND)))
+    {
+        LOGW("SetDebugState(THREAD_SUSPEND) failed: %s, stop all threads.", errormessage(Status));
+        return true;
+    }
+
+    m_nonStopThreads.insert(event.threadId);
+    event.allThreadsStopped = false;
+    return false;
 }
 
 bool CallbacksQueue::CallbacksWorkerCreateProcess()
@@ -149,8 +201,47 @@ bool CallbacksQueue::CallbacksWorkerCreateProcess()
     return false;
 }
 
+void CallbacksQueue::FlushLogPointsOutput()
+{
+    if (m_logPointsOutput.empty())
+        return;
+
+    m_debugger.pProtocol->EmitOutputEvent(OutputConsole, m_logPointsOutput);
+    m_logPointsOutput.clear();
+}
+
+void CallbacksQueue::VerifyPreResolvedBreakpoints()
+{
+    std::vector<BreakpointEvent> events;
+    m_debugger.m_sharedBreakpoints->VerifyPreResolvedBreakpoints(events);
+    for (const BreakpointEvent &event : events)
+    {
+        m_debugger.pProtocol->EmitBreakpointEvent(event);
+    }
+}
+
+static const char *GetCallbackQueueCallName(CallbackQueueCall call)
+{
+    switch (call)
+    {
+    case CallbackQueueCall::Breakpoint:             return "Breakpoint";
+    case CallbackQueueCall::StepComplete:           return "StepComplete";
+    case CallbackQueueCall::StepCompleteFiltered:   return "StepCompleteFiltered";
+    case CallbackQueueCall::Break:                  return "Break";
+    case CallbackQueueCall::Exception:              return "Exception";
+    case CallbackQueueCall::CreateProcess:          return "CreateProcess";
+#ifdef INTEROP_DEBUGGING
+    case CallbackQueueCall::InteropBreakpoint:      return "InteropBreakpoint";
+    case CallbackQueueCall::InteropSignal:          return "InteropSignal";
+    case CallbackQueueCall::InteropDataBreakpoint:  return "InteropDataBreakpoint";
+#endif // INTEROP_DEBUGGING
+    default:                                        return "FinishWorker";
+    }
+}
+
 void CallbacksQueue::CallbacksWorker()
 {
+    TraceRecorder::SetThreadName("CallbacksWorker");
     std::unique_lock<std::mutex> lock(m_callbacksMutex);
 
     while (true)
@@ -163,6 +254,22 @@ void CallbacksQueue::CallbacksWorker()
         }
 
         auto &c = m_callbacksQueue.front();
+        TraceRecorder::ScopedEvent traceEvent("callbacks", GetCallbackQueueCallName(c.Call));
+
+        // Log points output must be emitted before any other event.
+        if (c.Call != CallbackQueueCall::Breakpoint)
+            FlushLogPointsOutput();
+        // Modules events must be emitted before stop events.
+        m_debugger.WaitLoadModuleTasks();
+
+        // Note, breakpoints activated at module load by cached resolve results are verified at first managed callback,
+        // that could stop process, so, wrong breakpoint will be resolved again before hit check.
+        if (c.Call == CallbackQueueCall::Breakpoint ||
+            c.Call == CallbackQueueCall::StepComplete ||
+            c.Call == CallbackQueueCall::StepCompleteFiltered ||
+            c.Call == CallbackQueueCall::Break ||
+            c.Call == CallbackQueueCall::Exception)
+            VerifyPreResolvedBreakpoints();
 
         switch (c.Call)
         {
@@ -170,13 +277,15 @@ void CallbacksQueue::CallbacksWorker()
             m_stopEventInProcess = CallbacksWorkerBreakpoint(c.iCorAppDomain, c.iCorThread, c.iCorBreakpoint);
             break;
         case CallbackQueueCall::StepComplete:
-            m_stopEventInProcess = CallbacksWorkerStepComplete(c.iCorAppDomain, c.iCorThread, c.Reason);
+        case CallbackQueueCall::StepCompleteFiltered:
+            StepStats::Add(StepStats::Phase::CallbacksQueue, std::chrono::steady_clock::now() - c.QueuedTime);
+            m_stopEventInProcess = CallbacksWorkerStepComplete(c.iCorAppDomain, c.iCorThread, c.Reason, c.Call == CallbackQueueCall::StepCompleteFiltered);
             break;
         case CallbackQueueCall::Break:
             m_stopEventInProcess = CallbacksWorkerBreak(c.iCorAppDomain, c.iCorThread);
             break;
         case CallbackQueueCall::Exception:
-            m_stopEventInProcess = CallbacksWorkerException(c.iCorAppDomain, c.iCorThread, c.EventType, c.ExcModule);
+            m_stopEventInProcess = CallbacksWorkerException(c.iCorAppDomain, c.iCorThread, c.ExcModule);
             break;
         case CallbackQueueCall::CreateProcess:
             m_stopEventInProcess = CallbacksWorkerCreateProcess();
@@ -188,6 +297,9 @@ void CallbacksQueue::CallbacksWorker()
         case CallbackQueueCall::InteropSignal:
             m_stopEventInProcess = CallbacksWorkerInteropSignal(c.pid, c.addr, c.signal);
             break;
+        case CallbackQueueCall::InteropDataBreakpoint:
+            m_stopEventInProcess = CallbacksWorkerInteropDataBreakpoint(c.pid, c.addr, c.dataAddr);
+            break;
 #endif // INTEROP_DEBUGGING
         default:
             // finish loop
@@ -198,6 +310,9 @@ void CallbacksQueue::CallbacksWorker()
         ToRelease<ICorDebugAppDomain> iCorAppDomain(c.iCorAppDomain.Detach());
         m_callbacksQueue.pop_front();
 
+        if (m_callbacksQueue.empty() || m_logPointsOutput.size() >= MaxLogPointsOutputSize)
+            FlushLogPointsOutput();
+
         // Continue process execution only in case we don't have stop event emitted and queue is empty.
         // We safe here against fast Continue()/AddCallbackToQueue() call from new callback call, since we don't unlock m_callbacksMutex.
         // m_callbacksMutex will be unlocked only in m_callbacksCV.wait(), when CallbacksWorker will be ready for notify_one.
@@ -257,6 +372,30 @@ HRESULT CallbacksQueue::AddCallbackToQueue(ICorDebugAppDomain *pAppDomain, std::
     return S_OK;
 }
 
+HRESULT CallbacksQueue::AddFilteredCallbackToQueue(ICorDebugAppDomain *pAppDomain, std::function<bool()> callback)
+{
+    if (m_debugger.m_sharedEvalWaiter->IsEvalRunning())
+    {
+        pAppDomain->Continue(0);
+        return S_OK;
+    }
+
+    std::unique_lock<std::mutex> lock(m_callbacksMutex);
+
+    const bool queued = callback();
+    assert(!queued || !m_callbacksQueue.empty());
+
+    // Filtered out event should be continued in the same way as ContinueAppDomain() do.
+    ToRelease<ICorDebugProcess> iCorProcess;
+    if ((!queued && m_callbacksQueue.empty()) ||
+        (SUCCEEDED(pAppDomain->GetProcess(&iCorProcess)) && HasQueuedCallbacks(iCorProcess)))
+        pAppDomain->Continue(0);
+    else
+        m_callbacksCV.notify_one(); // notify_one with lock
+
+    return S_OK;
+}
+
 HRESULT CallbacksQueue::ContinueAppDomain(ICorDebugAppDomain *pAppDomain)
 {
     if (m_debugger.m_sharedEvalWaiter->IsEvalRunning())
@@ -312,7 +451,8 @@ HRESULT CallbacksQueue::ContinueProcess(ICorDebugProcess *pProcess)
 
 bool CallbacksQueue::IsRunning()
 {
-    std::unique_lock<std::mutex> lock(m_callbacksMutex);
+    // Note, no m_callbacksMutex lock here, since this one could be called during callbacks processing
+    // (that hold m_callbacksMutex for a long time) and we need status only.
     return !m_stopEventInProcess;
 }
 
@@ -340,7 +480,7 @@ HRESULT CallbacksQueue::Continue(ICorDebugProcess *pProcess)
 // NOTE caller must care about m_callbacksMutex.
 // Check stop status and stop, if need.
 // Return S_FALSE in case already was stopped, S_OK in case stopped by this call.
-static HRESULT InternalStop(ICorDebugProcess *pProcess, bool &stopEventInProcess)
+static HRESULT InternalStop(ICorDebugProcess *pProcess, std::atomic<bool> &stopEventInProcess)
 {
     if (stopEventInProcess)
         return S_FALSE; // Already stopped.
@@ -359,6 +499,174 @@ HRESULT CallbacksQueue::Stop(ICorDebugProcess *pProcess)
     return InternalStop(pProcess, m_stopEventInProcess);
 }
 
+HRESULT CallbacksQueue::StopForSample(ICorDebugProcess *pProcess, std::function<HRESULT()> cb)
+{
+    HRESULT Status;
+    {
+        std::unique_lock<std::mutex> lock(m_callbacksMutex);
+        if (m_stopEventInProcess)
+            return S_FALSE;
+
+        IfFailRet(pProcess->Stop(0));
+    }
+
+    // Note, m_stopEventInProcess is not changed, since this is not stop event. Stop()/Continue() calls are counted by debug API,
+    // so, in case Pause() called during `cb` call, process will be still stopped after Continue() below.
+    Status = cb();
+    pProcess->Continue(0);
+    return Status;
+}
+
+bool CallbacksQueue::IsNonStopThread(ThreadId threadId)
+{
+    std::lock_guard<std::mutex> lock(m_callbacksMutex);
+    return m_nonStopThreads.find(threadId) != m_nonStopThreads.end();
+}
+
+HRESULT CallbacksQueue::NonStopContinue(ICorDebugProcess *pProcess, ThreadId threadId, std::function<HRESULT(ICorDebugThread *pThread)> beforeResume)
+{
+    std::unique_lock<std::mutex> lock(m_callbacksMutex);
+    if (m_stopEventInProcess)
+        return S_FALSE;
+
+    std::vector<ThreadId> threads;
+    if (threadId == ThreadId::AllThreads)
+        threads.assign(m_nonStopThreads.begin(), m_nonStopThreads.end());
+    else if (m_nonStopThreads.find(threadId) != m_nonStopThreads.end())
+        threads.push_back(threadId);
+
+    if (threads.empty())
+        return S_FALSE;
+
+    // Note, Stop()/Continue() calls are counted by debug API, so, this is safe even with inspection stop.
+    HRESULT Status;
+    IfFailRet(pProcess->Stop(0));
+
+    for (const ThreadId &id : threads)
+    {
+        ToRelease<ICorDebugThread> iCorThread;
+        if (FAILED(pProcess->GetThread(int(id), &iCorThread)))
+        {
+            m_nonStopThreads.erase(id); // thread exited
+            continue;
+        }
+
+        if ((beforeResume && FAILED(Status = beforeResume(iCorThread))) ||
+            FAILED(Status = iCorThread->SetDebugState(THREAD_RUN)))
+        {
+            LOGE("Thread %i resume failed: %s", int(id), errormessage(Status));
+            pProcess->Continue(0);
+            return Status;
+        }
+        m_nonStopThreads.erase(id);
+    }
+
+    // Values and frames, that was got during inspection stop, are related to previous thread state, don't hold process at all.
+    m_inspectionEnd = std::chrono::steady_clock::now();
+    m_inspectionCV.notify_one();
+
+    // Note, events emitted with process stopped and m_callbacksMutex locked, so, new stop event of this thread will be emitted after.
+    for (const ThreadId &id : threads)
+    {
+        m_debugger.pProtocol->EmitContinuedEvent(id, false);
+    }
+    return pProcess->Continue(0);
+}
+
+HRESULT CallbacksQueue::NonStopPause(ICorDebugProcess *pProcess, ThreadId threadId)
+{
+    std::unique_lock<std::mutex> lock(m_callbacksMutex);
+    if (m_stopEventInProcess)
+        return S_FALSE;
+
+    if (m_nonStopThreads.find(threadId) != m_nonStopThreads.end())
+        return S_OK; // Already stopped.
+
+    HRESULT Status;
+    IfFailRet(pProcess->Stop(0));
+
+    ToRelease<ICorDebugThread> iCorThread;
+    if (FAILED(Status = pProcess->GetThread(int(threadId), &iCorThread)) ||
+        FAILED(Status = iCorThread->SetDebugState(THREAD_SUSPEND)))
+    {
+        pProcess->Continue(0);
+        return Status;
+    }
+    m_nonStopThreads.insert(threadId);
+
+    // Same logic as provide vsdbg in case of pause during stepping.
+    m_debugger.m_uniqueSteppers->DisableAllSteppers(pProcess);
+
+    StoppedEvent event(StopPause, threadId);
+    event.allThreadsStopped = false;
+    ToRelease<ICorDebugFrame> iCorFrame;
+    if (SUCCEEDED(iCorThread->GetActiveFrame(&iCorFrame)) && iCorFrame != nullptr)
+        m_debugger.GetFrameLocation(iCorFrame, threadId, FrameLevel(0), event.frame);
+
+    m_debugger.SetLastStoppedThreadId(threadId);
+    m_debugger.pProtocol->EmitStoppedEvent(event);
+    return pProcess->Continue(0);
+}
+
+HRESULT CallbacksQueue::BeginInspection(ICorDebugProcess *pProcess)
+{
+    std::unique_lock<std::mutex> lock(m_callbacksMutex);
+    if (m_stopEventInProcess || m_nonStopThreads.empty())
+        return S_FALSE;
+
+    if (!m_inspectionStop)
+    {
+        HRESULT Status;
+        IfFailRet(pProcess->Stop(0));
+        m_inspectionStop = true;
+        m_inspectionProcess = pProcess;
+        pProcess->AddRef();
+
+        if (!m_inspectionWorker.joinable())
+            m_inspectionWorker = std::thread(&CallbacksQueue::InspectionWorker, this);
+    }
+
+    m_inspections++;
+    return S_OK;
+}
+
+void CallbacksQueue::EndInspection()
+{
+    std::unique_lock<std::mutex> lock(m_callbacksMutex);
+    assert(m_inspections > 0);
+    m_inspections--;
+    m_inspectionEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds(InspectionIdleTime);
+    m_inspectionCV.notify_one();
+}
+
+void CallbacksQueue::InspectionWorker()
+{
+    std::unique_lock<std::mutex> lock(m_callbacksMutex);
+
+    while (!m_inspectionExit)
+    {
+        if (!m_inspectionStop || m_inspections > 0)
+        {
+            m_inspectionCV.wait(lock);
+            continue;
+        }
+
+        if (std::chrono::steady_clock::now() < m_inspectionEnd)
+        {
+            m_inspectionCV.wait_until(lock, m_inspectionEnd);
+            continue;
+        }
+
+        // Note, ICorDebugValue and ICorDebugFrame objects, that was got during inspection stop, are neutered by process continue.
+        m_inspectionStop = false;
+        m_inspectionProcess->Continue(0);
+        m_inspectionProcess.Free();
+    }
+}
+
+// Maximum threads count, that used for stacks walk during pause.
+static const unsigned PauseMaxWorkers = 4;
+
 // Stop process and set last stopped thread. If `lastStoppedThread` not passed value from protocol, find best thread.
 HRESULT CallbacksQueue::Pause(ICorDebugProcess *pProcess, ThreadId lastStoppedThread, EventFormat eventFormat)
 {
@@ -374,6 +682,9 @@ HRESULT CallbacksQueue::Pause(ICorDebugProcess *pProcess, ThreadId lastStoppedTh
     if (Status == S_FALSE) // Already stopped.
         return S_OK;
 
+    // Modules events must be emitted before stop event.
+    m_debugger.WaitLoadModuleTasks();
+
 #ifdef INTEROP_DEBUGGING
     if (m_debugger.m_interopDebugging)
         IfFailRet(m_debugger.m_sharedInteropDebugger->StopAllNativeThreads(pProcess));
@@ -433,27 +744,82 @@ HRESULT CallbacksQueue::Pause(ICorDebugProcess *pProcess, ThreadId lastStoppedTh
             }
         }
 
-        // Now get stack trace for each thread and find a frame with valid source location.
-        for (const Thread& thread : threads)
+        // Find first thread (in order above) with a frame with valid source location.
+        // Note, stack traces are stored in debugger's frames cache, so, stack trace requests after stop event don't walk them again.
+        auto findSourceFrame = [&](size_t index, StackFrame &frame) -> bool
         {
             int totalFrames = 0;
             std::vector<StackFrame> stackFrames;
+            if (FAILED(m_debugger.GetCachedStackTrace(threads[index].id, FrameLevel(0), 0, stackFrames, totalFrames, false)))
+                return false;
 
-            if (FAILED(m_debugger.GetStackTrace(thread.id, FrameLevel(0), 0, stackFrames, totalFrames)))
-                continue;
-
-            for (const StackFrame& stackFrame : stackFrames)
+            for (StackFrame &stackFrame : stackFrames)
             {
                 if (stackFrame.source.IsNull())
                     continue;
 
-                StoppedEvent event(StopPause, thread.id);
-                event.frame = stackFrame;
-                m_debugger.SetLastStoppedThreadId(thread.id);
-                m_debugger.pProtocol->EmitStoppedEvent(event);
-                m_debugger.m_ioredirect.async_cancel();
-                return S_OK;
+                frame = std::move(stackFrame);
+                return true;
             }
+            return false;
+        };
+
+        StackFrame sourceFrame;
+        size_t sourceThread = threads.size();
+        // Last stopped thread (or main thread) usually have user code, in this case stop event is emitted without other threads
+        // stack walk, that could take seconds for process with many threads.
+        if (!threads.empty() && findSourceFrame(0, sourceFrame))
+            sourceThread = 0;
+        else if (threads.size() > 1)
+        {
+            // Note, threads are independent and all data are read by DBI from stopped process, walk them in parallel.
+            std::atomic<size_t> nextThread(1);
+            std::mutex resultMutex;
+            auto worker = [&]()
+            {
+                for (size_t i = nextThread++; i < threads.size(); i = nextThread++)
+                {
+                    {
+                        std::lock_guard<std::mutex> resultLock(resultMutex);
+                        if (sourceThread < i) // Thread with higher priority already found.
+                            return;
+                    }
+
+                    StackFrame frame;
+                    if (!findSourceFrame(i, frame))
+                        continue;
+
+                    std::lock_guard<std::mutex> resultLock(resultMutex);
+                    if (i < sourceThread)
+                    {
+                        sourceThread = i;
+                        sourceFrame = std::move(frame);
+                    }
+                    return; // All next threads for this worker have lower priority.
+                }
+            };
+
+            std::vector<std::thread> workers;
+            const unsigned workersCount = std::min<unsigned>(std::min(PauseMaxWorkers, std::thread::hardware_concurrency()), threads.size() - 1);
+            for (unsigned i = 1; i < workersCount; i++)
+            {
+                workers.emplace_back(worker);
+            }
+            worker();
+            for (auto &thread : workers)
+            {
+                thread.join();
+            }
+        }
+
+        if (sourceThread < threads.size())
+        {
+            StoppedEvent event(StopPause, threads[sourceThread].id);
+            event.frame = std::move(sourceFrame);
+            m_debugger.SetLastStoppedThreadId(threads[sourceThread].id);
+            m_debugger.pProtocol->EmitStoppedEvent(event);
+            m_debugger.m_ioredirect.async_cancel();
+            return S_OK;
         }
     }
 
@@ -469,18 +835,69 @@ CallbacksQueue::~CallbacksQueue()
 
     // Clear queue and do notify_one call with FinishWorker request.
     m_callbacksQueue.clear();
-    m_callbacksQueue.emplace_front(CallbackQueueCall::FinishWorker, nullptr, nullptr, nullptr, STEP_NORMAL, ExceptionCallbackType::FIRST_CHANCE);
+    m_callbacksQueue.push_back().Set(CallbackQueueCall::FinishWorker, nullptr, nullptr, nullptr, STEP_NORMAL, std::string());
     m_stopEventInProcess = false; // forced to proceed during brake too
     m_callbacksCV.notify_one(); // notify_one with lock
+    m_inspectionExit = true;
+    m_inspectionCV.notify_one();
     lock.unlock();
     m_callbacksWorker.join();
+    if (m_inspectionWorker.joinable())
+        m_inspectionWorker.join();
 }
 
 // NOTE caller must care about m_callbacksMutex.
 void CallbacksQueue::EmplaceBack(CallbackQueueCall Call, ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint,
-                                 CorDebugStepReason Reason, ExceptionCallbackType EventType, const std::string &ExcModule)
+                                 CorDebugStepReason Reason, const std::string &ExcModule)
+{
+    m_callbacksQueue.push_back().Set(Call, pAppDomain, pThread, pBreakpoint, Reason, ExcModule);
+}
+
+const size_t CallbacksQueue::CallbacksRing::InitialCapacity;
+
+static PerfCounters::Gauge callbacksQueueDepthGauge("callbacksQueueDepth");
+
+CallbacksQueue::CallbackQueueEntry &CallbacksQueue::CallbacksRing::push_back()
+{
+    if (m_count == m_entries.size())
+        Grow();
+
+    CallbackQueueEntry &entry = m_entries[(m_head + m_count) % m_entries.size()];
+    m_count++;
+    callbacksQueueDepthGauge.Set(m_count);
+    return entry;
+}
+
+void CallbacksQueue::CallbacksRing::pop_front()
 {
-    m_callbacksQueue.emplace_back(Call, pAppDomain, pThread, pBreakpoint, Reason, EventType, ExcModule);
+    assert(m_count > 0);
+    m_entries[m_head].Reset();
+    m_head = (m_head + 1) % m_entries.size();
+    m_count--;
+    callbacksQueueDepthGauge.Set(m_count);
+}
+
+void CallbacksQueue::CallbacksRing::clear()
+{
+    while (m_count > 0)
+    {
+        pop_front();
+    }
+    m_head = 0;
+}
+
+void CallbacksQueue::CallbacksRing::Grow()
+{
+    std::vector<CallbackQueueEntry> entries;
+    entries.reserve(m_entries.size() * 2);
+    // Note, CallbackQueueEntry is move constructible only, keep queue order from head.
+    for (size_t i = 0; i < m_count; i++)
+    {
+        entries.emplace_back(std::move(m_entries[(m_head + i) % m_entries.size()]));
+    }
+    entries.resize(m_entries.size() * 2);
+    m_entries.swap(entries);
+    m_head = 0;
 }
 
 #ifdef INTEROP_DEBUGGING
@@ -539,6 +956,30 @@ bool CallbacksQueue::CallbacksWorkerInteropSignal(pid_t pid, std::uintptr_t brea
     return true;
 }
 
+bool CallbacksQueue::CallbacksWorkerInteropDataBreakpoint(pid_t pid, std::uintptr_t breakAddr, std::uintptr_t dataAddr)
+{
+    ThreadId threadId(pid);
+    StoppedEvent event(StopDataBreakpoint, threadId);
+    if (!m_debugger.m_sharedBreakpoints->IsInteropDataBreakpoint(dataAddr, event.breakpoint))
+        return false;
+
+    // Disable all steppers if we stop at data breakpoint during step.
+    m_debugger.m_debugProcessRWLock.reader.lock();
+    if (m_debugger.m_iCorProcess)
+    {
+        m_debugger.m_uniqueSteppers->DisableAllSteppers(m_debugger.m_iCorProcess);
+    }
+    m_debugger.m_debugProcessRWLock.reader.unlock();
+
+    m_debugger.SetLastStoppedThreadId(ThreadId(pid));
+
+    m_debugger.m_sharedInteropDebugger->GetFrameForAddr(breakAddr, event.frame);
+
+    m_debugger.pProtocol->EmitStoppedEvent(event);
+    m_debugger.m_ioredirect.async_cancel();
+    return true;
+}
+
 HRESULT CallbacksQueue::AddInteropCallbackToQueue(std::function<void()> callback)
 {
     std::unique_lock<std::mutex> lock(m_callbacksMutex);
@@ -569,9 +1010,9 @@ HRESULT CallbacksQueue::AddInteropCallbackToQueue(std::function<void()> callback
 }
 
 // NOTE caller must care about m_callbacksMutex.
-void CallbacksQueue::EmplaceBackInterop(CallbackQueueCall Call, pid_t pid, std::uintptr_t addr, const std::string &signal)
+void CallbacksQueue::EmplaceBackInterop(CallbackQueueCall Call, pid_t pid, std::uintptr_t addr, const std::string &signal, std::uintptr_t dataAddr)
 {
-    m_callbacksQueue.emplace_back(Call, pid, addr, signal);
+    m_callbacksQueue.push_back().Set(Call, pid, addr, signal, dataAddr);
 }
 
 // NOTE caller must care about m_callbacksMutex.
@@ -6,7 +6,10 @@
 
 #include "debugger/manageddebugger.h"
 #include <thread>
-#include <list>
+#include <vector>
+#include <set>
+#include <atomic>
+#include <chrono>
 
 namespace netcoredbg
 {
@@ -27,12 +30,14 @@ enum class CallbackQueueCall
     FinishWorker = 0,
     Breakpoint,
     StepComplete,
+    StepCompleteFiltered, // step complete, that was already checked by steppers in managed callback thread
     Break,
     Exception,
     CreateProcess
 #ifdef INTEROP_DEBUGGING
     , InteropBreakpoint
     , InteropSignal
+    , InteropDataBreakpoint
 #endif // INTEROP_DEBUGGING
 };
 
@@ -41,25 +46,47 @@ class CallbacksQueue
 public:
 
     CallbacksQueue(ManagedDebuggerHelpers &debugger) :
-        m_debugger(debugger), m_stopEventInProcess(false), m_callbacksWorker{&CallbacksQueue::CallbacksWorker, this} {}
+        m_debugger(debugger), m_stopEventInProcess(false), m_inspections(0), m_inspectionStop(false), m_inspectionExit(false),
+        m_callbacksWorker{&CallbacksQueue::CallbacksWorker, this} {}
     ~CallbacksQueue();
 
     // Called from ManagedDebugger by protocol request (Continue/Pause).
     bool IsRunning();
+    // Dump analysis, no callbacks from process and process is stopped all the time.
+    void MarkStopped() { m_stopEventInProcess = true; }
     HRESULT Continue(ICorDebugProcess *pProcess);
     // Stop process and set last stopped thread. If `lastStoppedThread` not passed value from protocol, find best thread.
     HRESULT Pause(ICorDebugProcess *pProcess, ThreadId lastStoppedThread, EventFormat eventFormat);
     // Analog of "pProcess->Stop(0)" call that also care about callbacks.
     HRESULT Stop(ICorDebugProcess *pProcess);
+    // Stop running process for `cb` call and continue it after, return S_FALSE without `cb` call in case process already stopped by event.
+    HRESULT StopForSample(ICorDebugProcess *pProcess, std::function<HRESULT()> cb);
+
+    // Non-stop mode related. Stop event suspend event thread only (by ICorDebugThread::SetDebugState()) and process continue execution.
+    // Return S_FALSE in case process stopped by stop event (all-stop state), caller should use all-stop logic in this case.
+    // Resume thread (or all stopped threads for ThreadId::AllThreads), `beforeResume` (if provided) called for each thread
+    // with stopped process, for example, for stepper setup.
+    HRESULT NonStopContinue(ICorDebugProcess *pProcess, ThreadId threadId, std::function<HRESULT(ICorDebugThread *pThread)> beforeResume);
+    // Suspend one running thread and emit stop event for it.
+    HRESULT NonStopPause(ICorDebugProcess *pProcess, ThreadId threadId);
+    bool IsNonStopThread(ThreadId threadId);
+    // Stop process for stopped threads inspection (stack trace, variables, evaluation), since debug API need stopped process for this.
+    // Process is continued after inspection idle period (no inspection requests during InspectionIdleTime).
+    // Return S_FALSE in case inspection don't need process stop (all-stop state or no stopped threads).
+    HRESULT BeginInspection(ICorDebugProcess *pProcess);
+    void EndInspection();
 
     HRESULT ContinueProcess(ICorDebugProcess *pProcess);
     HRESULT ContinueAppDomain(ICorDebugAppDomain *pAppDomain);
     HRESULT AddCallbackToQueue(ICorDebugAppDomain *pAppDomain, std::function<void()> callback);
+    // Same as AddCallbackToQueue(), but callback could filter out event (return `false` and don't add entry into queue),
+    // in this case process continued directly, without callbacks worker involving.
+    HRESULT AddFilteredCallbackToQueue(ICorDebugAppDomain *pAppDomain, std::function<bool()> callback);
     void EmplaceBack(CallbackQueueCall Call, ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint,
-                     CorDebugStepReason Reason, ExceptionCallbackType EventType, const std::string &ExcModule = std::string{});
+                     CorDebugStepReason Reason, const std::string &ExcModule = std::string{});
 #ifdef INTEROP_DEBUGGING
     HRESULT AddInteropCallbackToQueue(std::function<void()> callback);
-    void EmplaceBackInterop(CallbackQueueCall Call, pid_t pid, std::uintptr_t addr, const std::string &signal);
+    void EmplaceBackInterop(CallbackQueueCall Call, pid_t pid, std::uintptr_t addr, const std::string &signal, std::uintptr_t dataAddr = 0);
 #endif // INTEROP_DEBUGGING
 
 private:
@@ -68,68 +95,134 @@ private:
 
     // NOTE we have one entry type for both (managed and interop) callbacks (stop events),
     //      since almost all the time we have CallbackQueue with 1 entry only, no reason complicate code.
-    //      Probably in future we could reuse Reason, EventType and ExcModule fields for interop events too.
-    //      Each event use its own constructor.
+    //      Probably in future we could reuse Reason and ExcModule fields for interop events too.
+    //      Each event use its own Set() method.
+    //      Entries are pooled (see CallbacksRing), so strings capacity is reused and no allocation happens at event add.
     struct CallbackQueueEntry
     {
-        CallbackQueueCall Call;
+        CallbackQueueCall Call = CallbackQueueCall::FinishWorker;
         ToRelease<ICorDebugAppDomain> iCorAppDomain;
         ToRelease<ICorDebugThread> iCorThread;
         ToRelease<ICorDebugBreakpoint> iCorBreakpoint;
         CorDebugStepReason Reason = CorDebugStepReason::STEP_NORMAL; // Initial value in order to suppress static analyzer warnings.
-        ExceptionCallbackType EventType = ExceptionCallbackType::FIRST_CHANCE; // Initial value in order to suppress static analyzer warnings.
         std::string ExcModule;
-
-        CallbackQueueEntry(CallbackQueueCall call,
-                           ICorDebugAppDomain *pAppDomain,
-                           ICorDebugThread *pThread,
-                           ICorDebugBreakpoint *pBreakpoint,
-                           CorDebugStepReason reason,
-                           ExceptionCallbackType eventType,
-                           const std::string &excModule = "") :
-            Call(call),
-            iCorAppDomain(pAppDomain),
-            iCorThread(pThread),
-            iCorBreakpoint(pBreakpoint),
-            Reason(reason),
-            EventType(eventType),
-            ExcModule(excModule)
-        {}
+        std::chrono::steady_clock::time_point QueuedTime; // for stepping latency statistic
+
+        void Set(CallbackQueueCall call,
+                 ICorDebugAppDomain *pAppDomain,
+                 ICorDebugThread *pThread,
+                 ICorDebugBreakpoint *pBreakpoint,
+                 CorDebugStepReason reason,
+                 const std::string &excModule)
+        {
+            Call = call;
+            iCorAppDomain = pAppDomain;
+            iCorThread = pThread;
+            iCorBreakpoint = pBreakpoint;
+            Reason = reason;
+            ExcModule = excModule;
+            QueuedTime = std::chrono::steady_clock::now();
+        }
 
 #ifdef INTEROP_DEBUGGING
         pid_t pid = 0; // Initial value in order to suppress static analyzer warnings.
         std::uintptr_t addr = 0; // Initial value in order to suppress static analyzer warnings.
         std::string signal;
+        std::uintptr_t dataAddr = 0; // watched address for data breakpoint
+
+        void Set(CallbackQueueCall call,
+                 pid_t pid_,
+                 std::uintptr_t addr_,
+                 const std::string &signal_,
+                 std::uintptr_t dataAddr_)
+        {
+            Call = call;
+            pid = pid_;
+            addr = addr_;
+            signal = signal_;
+            dataAddr = dataAddr_;
+        }
+#endif // INTEROP_DEBUGGING
 
-        CallbackQueueEntry(CallbackQueueCall call,
-                           pid_t pid_,
-                           std::uintptr_t addr_,
-                           const std::string &signal_) :
-            Call(call),
-            pid(pid_),
-            addr(addr_),
-            signal(signal_)
-        {}
+        // Release interfaces, but keep strings capacity for entry reuse.
+        void Reset()
+        {
+            Call = CallbackQueueCall::FinishWorker;
+            iCorAppDomain.Free();
+            iCorThread.Free();
+            iCorBreakpoint.Free();
+            ExcModule.clear();
+#ifdef INTEROP_DEBUGGING
+            signal.clear();
 #endif // INTEROP_DEBUGGING
+        }
+    };
+
+    // FIFO ring of preallocated entries. Grows (with entries move) only in case all entries are in use,
+    // since almost all the time we have 1 entry only, this never happens in real debug session.
+    // Note, caller must care about m_callbacksMutex.
+    class CallbacksRing
+    {
+    public:
+
+        CallbacksRing() : m_entries(InitialCapacity), m_head(0), m_count(0) {}
+
+        bool empty() const { return m_count == 0; }
+        CallbackQueueEntry &front() { return m_entries[m_head]; }
+        // Return reference to new (reset) entry at the end of queue.
+        CallbackQueueEntry &push_back();
+        void pop_front();
+        void clear();
+
+    private:
+
+        static const size_t InitialCapacity = 16;
+        std::vector<CallbackQueueEntry> m_entries;
+        size_t m_head;
+        size_t m_count;
+
+        void Grow();
     };
 
     std::mutex m_callbacksMutex;
     std::condition_variable m_callbacksCV;
-    std::list<CallbackQueueEntry> m_callbacksQueue; // Make sure this one initialized before m_callbacksWorker.
-    bool m_stopEventInProcess; // Make sure this one initialized before m_callbacksWorker.
+    CallbacksRing m_callbacksQueue; // Make sure this one initialized before m_callbacksWorker.
+    // Note, changed with m_callbacksMutex locked only, but could be read without lock (see IsRunning()).
+    std::atomic<bool> m_stopEventInProcess; // Make sure this one initialized before m_callbacksWorker.
+    // Non-stop mode stopped threads, protected by m_callbacksMutex. Make sure all non-stop related fields initialized before m_callbacksWorker.
+    std::set<ThreadId> m_nonStopThreads;
+    // Inspection stop related, protected by m_callbacksMutex.
+    static const unsigned InspectionIdleTime = 500; // milliseconds
+    unsigned m_inspections; // inspections in progress
+    bool m_inspectionStop;
+    std::chrono::steady_clock::time_point m_inspectionEnd;
+    ToRelease<ICorDebugProcess> m_inspectionProcess;
+    std::condition_variable m_inspectionCV;
+    bool m_inspectionExit;
+    std::thread m_inspectionWorker; // started at first inspection stop
     std::thread m_callbacksWorker;
+    // Log points output, collected during callbacks queue processing in order to emit it by one output event.
+    // Note, accessed by callbacks worker thread only.
+    std::string m_logPointsOutput;
+    static const size_t MaxLogPointsOutputSize = 16 * 1024;
 
     void CallbacksWorker();
+    void InspectionWorker();
+    // In non-stop mode suspend event thread, return `true` in case process must be stopped (all-stop mode).
+    bool StopEventThread(ICorDebugThread *pThread, StoppedEvent &event);
     bool CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint);
-    bool CallbacksWorkerStepComplete(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, CorDebugStepReason reason);
+    bool CallbacksWorkerStepComplete(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, CorDebugStepReason reason, bool filtered);
     bool CallbacksWorkerBreak(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread);
-    bool CallbacksWorkerException(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ExceptionCallbackType eventType, const std::string &excModule);
+    bool CallbacksWorkerException(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, const std::string &excModule);
     bool CallbacksWorkerCreateProcess();
     bool HasQueuedCallbacks(ICorDebugProcess *pProcess);
+    void FlushLogPointsOutput();
+    void VerifyPreResolvedBreakpoints();
 
 #ifdef INTEROP_DEBUGGING
     bool CallbacksWorkerInteropBreakpoint(pid_t pid, std::uintptr_t brkAddr);
     bool CallbacksWorkerInteropSignal(pid_t pid, std::uintptr_t breakAddr, const std::string &signal);
+    bool CallbacksWorkerInteropDataBreakpoint(pid_t pid, std::uintptr_t breakAddr, std::uintptr_t dataAddr);
     void StopAllNativeThreads();
 #endif // INTEROP_DEBUGGING
 
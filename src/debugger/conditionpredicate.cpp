@@ -0,0 +1,452 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/conditionpredicate.h"
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+
+namespace netcoredbg
+{
+
+const size_t ConditionPredicatesCache::MaxConditions;
+const size_t ConditionPredicate::MaxComparisons;
+
+namespace
+{
+
+    inline bool IsIdentifierStart(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+
+    inline bool IsIdentifierPart(char c)
+    {
+        return IsIdentifierStart(c) || (c >= '0' && c <= '9');
+    }
+
+    inline bool IsDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    inline bool IsHexDigit(char c)
+    {
+        return IsDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
+
+    // C# keywords, that change identifier meaning and must be processed by stack machine.
+    bool IsKeyword(const std::string &name)
+    {
+        static const char *const keywords[] = {
+            "base", "new", "typeof", "sizeof", "default", "checked", "unchecked", "nameof", "is", "as", "stackalloc"
+        };
+        for (const char *keyword : keywords)
+        {
+            if (name == keyword)
+                return true;
+        }
+        return false;
+    }
+
+    class Parser
+    {
+    public:
+
+        Parser(const std::string &str) :
+            m_str(str),
+            m_pos(0)
+        {}
+
+        void SkipSpaces()
+        {
+            while (m_pos < m_str.size() && (m_str[m_pos] == ' ' || m_str[m_pos] == '\t'))
+                m_pos++;
+        }
+
+        bool End() const
+        {
+            return m_pos >= m_str.size();
+        }
+
+        bool ParseOperand(ConditionPredicate::operand_t &operand)
+        {
+            operand = ConditionPredicate::operand_t();
+            if (End())
+                return false;
+
+            const char c = m_str[m_pos];
+            if (IsIdentifierStart(c))
+                return ParseIdentifiers(operand);
+            else if (c == '\'')
+                return ParseChar(operand.literal);
+            else if (IsDigit(c) || c == '-')
+                return ParseNumber(operand.literal);
+
+            return false;
+        }
+
+        // Return false in case there is no logical operation at current position.
+        bool ParseLogic(ConditionPredicate::Logic &logic)
+        {
+            if (m_pos + 1 >= m_str.size() || m_str[m_pos] != m_str[m_pos + 1] || (m_str[m_pos] != '&' && m_str[m_pos] != '|'))
+                return false;
+
+            logic = m_str[m_pos] == '&' ? ConditionPredicate::Logic::And : ConditionPredicate::Logic::Or;
+            m_pos += 2;
+            return true;
+        }
+
+        bool IsLogic() const
+        {
+            return m_pos + 1 < m_str.size() && m_str[m_pos] == m_str[m_pos + 1] && (m_str[m_pos] == '&' || m_str[m_pos] == '|');
+        }
+
+        bool ParseOperation(ConditionPredicate::Operation &operation)
+        {
+            if (m_pos + 1 < m_str.size() && m_str[m_pos + 1] == '=')
+            {
+                switch (m_str[m_pos])
+                {
+                    case '=': operation = ConditionPredicate::Operation::Equal; break;
+                    case '!': operation = ConditionPredicate::Operation::NotEqual; break;
+                    case '<': operation = ConditionPredicate::Operation::LessOrEqual; break;
+                    case '>': operation = ConditionPredicate::Operation::GreaterOrEqual; break;
+                    default: return false;
+                }
+                m_pos += 2;
+                return true;
+            }
+
+            if (m_pos < m_str.size() && (m_str[m_pos] == '<' || m_str[m_pos] == '>'))
+            {
+                // Note, `<<` and `>>` are shift operations.
+                if (m_pos + 1 < m_str.size() && m_str[m_pos + 1] == m_str[m_pos])
+                    return false;
+
+                operation = m_str[m_pos] == '<' ? ConditionPredicate::Operation::Less : ConditionPredicate::Operation::Greater;
+                m_pos++;
+                return true;
+            }
+
+            return false;
+        }
+
+    private:
+
+        const std::string &m_str;
+        size_t m_pos;
+
+        bool ParseIdentifiers(ConditionPredicate::operand_t &operand)
+        {
+            while (true)
+            {
+                if (m_pos >= m_str.size() || !IsIdentifierStart(m_str[m_pos]))
+                    return false;
+
+                const size_t start = m_pos;
+                while (m_pos < m_str.size() && IsIdentifierPart(m_str[m_pos]))
+                    m_pos++;
+                operand.identifiers.emplace_back(m_str, start, m_pos - start);
+
+                const std::string &name = operand.identifiers.back();
+                if (IsKeyword(name) || (name == "this" && operand.identifiers.size() > 1))
+                    return false;
+
+                if (m_pos >= m_str.size() || m_str[m_pos] != '.')
+                    break;
+                m_pos++;
+            }
+
+            // Generics, methods calls, indexers, etc.
+            if (m_pos < m_str.size() && !(m_str[m_pos] == ' ' || m_str[m_pos] == '\t' || m_str[m_pos] == '=' ||
+                                          m_str[m_pos] == '!' || m_str[m_pos] == '<' || m_str[m_pos] == '>' ||
+                                          IsLogic()))
+                return false;
+
+            if (operand.identifiers.size() != 1)
+                return true;
+
+            const std::string &name = operand.identifiers.front();
+            if (name == "true" || name == "false")
+                operand.literal = ConditionPredicate::value_t::Bool(name == "true");
+            else if (name == "null")
+                operand.literal = ConditionPredicate::value_t::Null();
+            else
+                return true;
+
+            operand.identifiers.clear();
+            return true;
+        }
+
+        bool ParseChar(ConditionPredicate::value_t &literal)
+        {
+            // Only simple 'c' form with printable ASCII char (no escape sequences).
+            if (m_pos + 2 >= m_str.size() || m_str[m_pos + 2] != '\'')
+                return false;
+
+            const char c = m_str[m_pos + 1];
+            if (c < 0x20 || c > 0x7e || c == '\\' || c == '\'')
+                return false;
+
+            literal = ConditionPredicate::value_t::Unsigned((uint64_t)c);
+            m_pos += 3;
+            return true;
+        }
+
+        bool ParseNumber(ConditionPredicate::value_t &literal)
+        {
+            const size_t start = m_pos;
+            const bool negative = m_str[m_pos] == '-';
+            if (negative)
+                m_pos++;
+
+            if (m_pos >= m_str.size() || !IsDigit(m_str[m_pos]))
+                return false;
+
+            bool hex = false;
+            bool real = false;
+            if (m_str[m_pos] == '0' && m_pos + 1 < m_str.size() && (m_str[m_pos + 1] == 'x' || m_str[m_pos + 1] == 'X'))
+            {
+                hex = true;
+                m_pos += 2;
+                const size_t digitsStart = m_pos;
+                while (m_pos < m_str.size() && IsHexDigit(m_str[m_pos]))
+                    m_pos++;
+                if (m_pos == digitsStart)
+                    return false;
+            }
+            else
+            {
+                while (m_pos < m_str.size() && IsDigit(m_str[m_pos]))
+                    m_pos++;
+
+                if (m_pos < m_str.size() && m_str[m_pos] == '.')
+                {
+                    real = true;
+                    m_pos++;
+                    if (m_pos >= m_str.size() || !IsDigit(m_str[m_pos]))
+                        return false;
+                    while (m_pos < m_str.size() && IsDigit(m_str[m_pos]))
+                        m_pos++;
+                }
+
+                if (m_pos < m_str.size() && (m_str[m_pos] == 'e' || m_str[m_pos] == 'E'))
+                {
+                    real = true;
+                    m_pos++;
+                    if (m_pos < m_str.size() && (m_str[m_pos] == '+' || m_str[m_pos] == '-'))
+                        m_pos++;
+                    if (m_pos >= m_str.size() || !IsDigit(m_str[m_pos]))
+                        return false;
+                    while (m_pos < m_str.size() && IsDigit(m_str[m_pos]))
+                        m_pos++;
+                }
+            }
+
+            // Literals with suffixes (`u`, `l`, `f`, `m`, etc.) and digit separators are not supported.
+            if (m_pos < m_str.size() && (IsIdentifierPart(m_str[m_pos]) || m_str[m_pos] == '.'))
+                return false;
+
+            const std::string number(m_str, start, m_pos - start);
+            char *endPtr = nullptr;
+            errno = 0;
+
+            if (real)
+            {
+                literal = ConditionPredicate::value_t::Real(strtod(number.c_str(), &endPtr));
+            }
+            else if (negative)
+            {
+                long long value = strtoll(number.c_str(), &endPtr, hex ? 16 : 10);
+                // Note, C# don't allow negative hex literals in the same way (`-0x1` is unary minus for literal), but result is same.
+                literal = ConditionPredicate::value_t::Signed((int64_t)value);
+            }
+            else
+            {
+                unsigned long long value = strtoull(number.c_str(), &endPtr, hex ? 16 : 10);
+                if (value <= (unsigned long long)std::numeric_limits<int64_t>::max())
+                    literal = ConditionPredicate::value_t::Signed((int64_t)value);
+                else
+                    literal = ConditionPredicate::value_t::Unsigned((uint64_t)value);
+            }
+
+            return errno == 0 && endPtr == number.c_str() + number.size();
+        }
+    };
+
+    template <class T>
+    bool CompareValues(ConditionPredicate::Operation operation, const T &left, const T &right)
+    {
+        switch (operation)
+        {
+            case ConditionPredicate::Operation::Equal:          return left == right;
+            case ConditionPredicate::Operation::NotEqual:       return left != right;
+            case ConditionPredicate::Operation::Less:           return left < right;
+            case ConditionPredicate::Operation::LessOrEqual:    return left <= right;
+            case ConditionPredicate::Operation::Greater:        return left > right;
+            case ConditionPredicate::Operation::GreaterOrEqual: return left >= right;
+            default:                                             return false;
+        }
+    }
+
+    inline double ToReal(const ConditionPredicate::value_t &value)
+    {
+        switch (value.kind)
+        {
+            case ConditionPredicate::value_t::Kind::Signed:   return (double)value.data.i;
+            case ConditionPredicate::value_t::Kind::Unsigned: return (double)value.data.u;
+            default:                                          return value.data.d;
+        }
+    }
+
+    // Compare signed and unsigned integers by value, -1 (less), 0 (equal) or 1 (greater).
+    int CompareIntegers(const ConditionPredicate::value_t &left, const ConditionPredicate::value_t &right)
+    {
+        typedef ConditionPredicate::value_t::Kind Kind;
+
+        if (left.kind == Kind::Signed && right.kind == Kind::Signed)
+            return left.data.i < right.data.i ? -1 : (left.data.i > right.data.i ? 1 : 0);
+
+        if (left.kind == Kind::Signed && left.data.i < 0)
+            return -1;
+        if (right.kind == Kind::Signed && right.data.i < 0)
+            return 1;
+
+        const uint64_t leftValue = left.kind == Kind::Signed ? (uint64_t)left.data.i : left.data.u;
+        const uint64_t rightValue = right.kind == Kind::Signed ? (uint64_t)right.data.i : right.data.u;
+        return leftValue < rightValue ? -1 : (leftValue > rightValue ? 1 : 0);
+    }
+
+} // unnamed namespace
+
+bool ConditionPredicate::Parse(const std::string &condition)
+{
+    m_comparisons.clear();
+    m_logic = Logic::None;
+
+    Parser parser(condition);
+    while (true)
+    {
+        if (m_comparisons.size() >= MaxComparisons)
+            return false;
+        m_comparisons.emplace_back();
+        comparison_t &comparison = m_comparisons.back();
+
+        parser.SkipSpaces();
+        if (!parser.ParseOperand(comparison.left))
+            return false;
+
+        parser.SkipSpaces();
+        if (!parser.End() && !parser.IsLogic())
+        {
+            if (!parser.ParseOperation(comparison.operation))
+                return false;
+
+            parser.SkipSpaces();
+            if (!parser.ParseOperand(comparison.right))
+                return false;
+
+            parser.SkipSpaces();
+        }
+
+        if (parser.End())
+            return true;
+
+        // Note, `&&` have higher precedence than `||`, mixed operations are processed by stack machine.
+        Logic logic = Logic::None;
+        if (!parser.ParseLogic(logic) || (m_logic != Logic::None && m_logic != logic))
+            return false;
+        m_logic = logic;
+    }
+}
+
+bool ConditionPredicate::Calculate(const comparison_t &comparison, const value_t &left, const value_t &right, bool &result)
+{
+    typedef value_t::Kind Kind;
+
+    const Operation operation = comparison.operation;
+    if (operation == Operation::None)
+    {
+        if (left.kind != Kind::Bool)
+            return false;
+
+        result = left.data.b;
+        return true;
+    }
+
+    if (left.kind == Kind::None || right.kind == Kind::None)
+        return false;
+
+    const bool equality = operation == Operation::Equal || operation == Operation::NotEqual;
+
+    if (left.kind == Kind::Null || left.kind == Kind::Reference ||
+        right.kind == Kind::Null || right.kind == Kind::Reference)
+    {
+        // Note, references equality (and operators overloading) must be checked by stack machine.
+        if (!equality || (left.kind == Kind::Reference && right.kind == Kind::Reference))
+            return false;
+
+        auto isNull = [](const value_t &value) -> int
+        {
+            if (value.kind == Kind::Null)
+                return 1;
+            if (value.kind == Kind::Reference)
+                return value.isNull ? 1 : 0;
+            return -1; // not reference
+        };
+        const int leftIsNull = isNull(left);
+        const int rightIsNull = isNull(right);
+        if (leftIsNull == -1 || rightIsNull == -1)
+            return false;
+
+        result = CompareValues(operation, leftIsNull, rightIsNull);
+        return true;
+    }
+
+    if (left.kind == Kind::Bool || right.kind == Kind::Bool)
+    {
+        if (!equality || left.kind != right.kind)
+            return false;
+
+        result = CompareValues(operation, left.data.b, right.data.b);
+        return true;
+    }
+
+    if (left.kind == Kind::Real || right.kind == Kind::Real)
+    {
+        result = CompareValues(operation, ToReal(left), ToReal(right));
+        return true;
+    }
+
+    result = CompareValues(operation, CompareIntegers(left, right), 0);
+    return true;
+}
+
+ConditionPredicatesCache::predicate_t ConditionPredicatesCache::GetPredicate(const std::string &condition)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    auto find = m_cache.find(condition);
+    if (find != m_cache.end())
+        return find->second;
+
+    if (m_cache.size() >= MaxConditions)
+        m_cache.clear();
+
+    std::shared_ptr<ConditionPredicate> predicate = std::make_shared<ConditionPredicate>();
+    if (!predicate->Parse(condition))
+        predicate.reset();
+
+    m_cache.emplace(condition, predicate);
+    return predicate;
+}
+
+void ConditionPredicatesCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_cache.clear();
+}
+
+} // namespace netcoredbg
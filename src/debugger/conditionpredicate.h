@@ -0,0 +1,141 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <list>
+#include <mutex>
+#include <memory>
+#include <unordered_map>
+
+namespace netcoredbg
+{
+
+// Pre-compiled trivial condition of breakpoint, that could be calculated natively (without stack machine), one or more
+// comparisons joined by same logical operation (`&&` or `||`, without parentheses):
+//     <comparison> [&& <comparison> ...]
+//     <comparison> [|| <comparison> ...]
+// where comparison is:
+//     <operand>
+//     <operand> <operation> <operand>
+// where operand is identifier (local variable, argument, `this`, field, `this.field`, `local.field`, etc.) or
+// literal (integer, real, char, `true`, `false`, `null`), operation is one of `==`, `!=`, `<`, `<=`, `>`, `>=`.
+// Note, predicate don't care about value types, operators overloading, properties, etc. Caller should read
+// identifiers values and in case value can't be represented by value_t or can't be compared (Calculate() return
+// false), use stack machine instead. Comparisons should be calculated in order with short-circuit (same as C# do),
+// so, `obj != null && obj.field > 0` don't read `obj.field` for null `obj`.
+class ConditionPredicate
+{
+public:
+
+    struct value_t
+    {
+        enum class Kind
+        {
+            None,       // value can't be used by predicate
+            Null,       // `null` literal only
+            Reference,  // reference type value (could be compared with `null` only)
+            Bool,
+            Signed,
+            Unsigned,
+            Real
+        };
+
+        Kind kind = Kind::None;
+        union
+        {
+            bool b;
+            int64_t i;
+            uint64_t u;
+            double d;
+        } data = {};
+        bool isNull = false; // for Kind::Reference only
+
+        static value_t Bool(bool b) { value_t value; value.kind = Kind::Bool; value.data.b = b; return value; }
+        static value_t Signed(int64_t i) { value_t value; value.kind = Kind::Signed; value.data.i = i; return value; }
+        static value_t Unsigned(uint64_t u) { value_t value; value.kind = Kind::Unsigned; value.data.u = u; return value; }
+        static value_t Real(double d) { value_t value; value.kind = Kind::Real; value.data.d = d; return value; }
+        static value_t Reference(bool isNull) { value_t value; value.kind = Kind::Reference; value.isNull = isNull; return value; }
+        static value_t Null() { value_t value; value.kind = Kind::Null; return value; }
+    };
+
+    struct operand_t
+    {
+        std::vector<std::string> identifiers; // empty in case of literal
+        value_t literal;
+
+        bool IsLiteral() const { return identifiers.empty(); }
+    };
+
+    enum class Operation
+    {
+        None, // condition is single operand
+        Equal,
+        NotEqual,
+        Less,
+        LessOrEqual,
+        Greater,
+        GreaterOrEqual
+    };
+
+    struct comparison_t
+    {
+        operand_t left;
+        operand_t right;
+        Operation operation = Operation::None;
+    };
+
+    enum class Logic
+    {
+        None, // condition is single comparison
+        And,
+        Or
+    };
+
+    // Limit for comparisons in one condition, longer conditions are processed by stack machine.
+    static const size_t MaxComparisons = 8;
+
+    // Return false in case condition is not trivial.
+    bool Parse(const std::string &condition);
+
+    // Return false in case values can't be compared natively.
+    // Note, in case of Operation::None `right` is not used.
+    static bool Calculate(const comparison_t &comparison, const value_t &left, const value_t &right, bool &result);
+
+    const std::vector<comparison_t> &GetComparisons() const { return m_comparisons; }
+    Logic GetLogic() const { return m_logic; }
+    // Return true in case result of all condition is known after comparison with `result` (short-circuit).
+    bool IsFinalResult(bool result) const { return m_logic == Logic::Or ? result : !result; }
+
+private:
+
+    std::vector<comparison_t> m_comparisons;
+    Logic m_logic = Logic::None;
+};
+
+// Bounded cache of parsed conditions, aimed to avoid condition parsing at each breakpoint hit.
+// Note, non trivial conditions also stored (as nullptr), in order to avoid parsing attempts for them too.
+class ConditionPredicatesCache
+{
+public:
+
+    typedef std::shared_ptr<const ConditionPredicate> predicate_t;
+
+    static const size_t MaxConditions = 256;
+
+    // Return nullptr in case condition is not trivial.
+    predicate_t GetPredicate(const std::string &condition);
+    void Clear();
+
+private:
+
+    std::mutex m_cacheMutex;
+    std::unordered_map<std::string, predicate_t> m_cache;
+};
+
+} // namespace netcoredbg
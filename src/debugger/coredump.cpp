@@ -0,0 +1,257 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/coredump.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace netcoredbg
+{
+
+namespace
+{
+
+    // ELF64 structures layout, see elf.h (not available on all supported hosts).
+    const size_t EhdrSize = 64;
+    const size_t PhdrSize = 56;
+    const uint16_t ET_CORE_ = 4;
+    const uint32_t PT_LOAD_ = 1;
+    const uint32_t PT_NOTE_ = 4;
+    const uint32_t NT_PRSTATUS_ = 1;
+    const uint32_t NT_FILE_ = 0x46494c45;
+
+    // Offsets in `struct elf_prstatus` of 64-bit Linux, same for all architectures.
+    const size_t PrstatusPidOffset = 32;
+    const size_t PrstatusRegOffset = 112;
+
+    template <class T>
+    T Read(const char *data)
+    {
+        // Note, dump is little endian, same as all supported hosts.
+        T value;
+        memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    size_t Align4(size_t value)
+    {
+        return (value + 3) & ~size_t(3);
+    }
+
+} // unnamed namespace
+
+bool CoreDump::Open(const std::string &path, std::string &error)
+{
+    if (!m_dump.Open(path))
+    {
+        error = "can't open file";
+        return false;
+    }
+
+    const char *data = m_dump.Data();
+    const size_t size = m_dump.Size();
+    if (size < EhdrSize || memcmp(data, "\x7f" "ELF", 4) != 0)
+    {
+        error = "not ELF file";
+        return false;
+    }
+    if (data[4] != 2 /*ELFCLASS64*/ || data[5] != 1 /*ELFDATA2LSB*/)
+    {
+        error = "only 64-bit little endian dumps are supported";
+        return false;
+    }
+    if (Read<uint16_t>(data + 16) != ET_CORE_)
+    {
+        error = "not core dump";
+        return false;
+    }
+    m_machine = Read<uint16_t>(data + 18);
+
+    const uint64_t phoff = Read<uint64_t>(data + 32);
+    const uint16_t phentsize = Read<uint16_t>(data + 54);
+    const uint16_t phnum = Read<uint16_t>(data + 56);
+    if (phentsize < PhdrSize || phoff > size || (size - phoff) / phentsize < phnum)
+    {
+        error = "broken program headers";
+        return false;
+    }
+
+    for (uint16_t i = 0; i < phnum; i++)
+    {
+        const char *phdr = data + phoff + size_t(i) * phentsize;
+        const uint32_t type = Read<uint32_t>(phdr);
+        const uint64_t offset = Read<uint64_t>(phdr + 8);
+        const uint64_t vaddr = Read<uint64_t>(phdr + 16);
+        uint64_t fileSize = Read<uint64_t>(phdr + 32);
+        const uint64_t memSize = Read<uint64_t>(phdr + 40);
+
+        // Note, dump could be truncated (disk full or dump write interrupted), provide only available part.
+        if (offset > size)
+            fileSize = 0;
+        else if (size - offset < fileSize)
+            fileSize = size - offset;
+
+        if (type == PT_LOAD_)
+        {
+            if (memSize != 0)
+                m_segments.push_back({vaddr, std::min(fileSize, memSize), memSize, offset});
+        }
+        else if (type == PT_NOTE_)
+        {
+            if (!ParseNotes(data + offset, size_t(fileSize)))
+            {
+                error = "broken notes";
+                return false;
+            }
+        }
+    }
+
+    std::sort(m_segments.begin(), m_segments.end(), [](const Segment &a, const Segment &b) { return a.vaddr < b.vaddr; });
+    std::sort(m_mappings.begin(), m_mappings.end(), [](const Mapping &a, const Mapping &b) { return a.start < b.start; });
+
+    if (m_threads.empty())
+    {
+        error = "no threads in dump";
+        return false;
+    }
+
+    return true;
+}
+
+bool CoreDump::ParseNotes(const char *data, size_t size)
+{
+    size_t pos = 0;
+    while (size - pos >= 12)
+    {
+        const size_t nameSize = Read<uint32_t>(data + pos);
+        const size_t descSize = Read<uint32_t>(data + pos + 4);
+        const uint32_t type = Read<uint32_t>(data + pos + 8);
+        pos += 12;
+        if (size - pos < Align4(nameSize))
+            return false;
+        const bool isCore = nameSize == 5 && memcmp(data + pos, "CORE", 5) == 0;
+        pos += Align4(nameSize);
+        if (size - pos < descSize)
+            return false;
+        const char *desc = data + pos;
+        pos += std::min(Align4(descSize), size - pos);
+
+        if (!isCore)
+            continue;
+
+        if (type == NT_PRSTATUS_ && descSize > PrstatusRegOffset)
+        {
+            Thread thread;
+            thread.tid = Read<uint32_t>(desc + PrstatusPidOffset);
+            thread.registers.assign(desc + PrstatusRegOffset, desc + descSize);
+            m_threads.emplace_back(std::move(thread));
+        }
+        else if (type == NT_FILE_ && descSize >= 16)
+        {
+            // count, page size, `count` entries of start, end and offset (in pages), `count` null terminated paths.
+            const uint64_t count = Read<uint64_t>(desc);
+            const uint64_t pageSize = Read<uint64_t>(desc + 8);
+            if ((descSize - 16) / 24 < count)
+                return false;
+            const char *name = desc + 16 + count * 24;
+            const char *descEnd = desc + descSize;
+            for (uint64_t i = 0; i < count && name < descEnd; i++)
+            {
+                const char *entry = desc + 16 + i * 24;
+                const char *nameEnd = static_cast<const char*>(memchr(name, 0, size_t(descEnd - name)));
+                if (nameEnd == nullptr)
+                    return false;
+                m_mappings.push_back({Read<uint64_t>(entry), Read<uint64_t>(entry + 8),
+                                      Read<uint64_t>(entry + 16) * pageSize, std::string(name, nameEnd)});
+                name = nameEnd + 1;
+            }
+        }
+    }
+    return true;
+}
+
+size_t CoreDump::ReadSegments(uint64_t address, char *buffer, size_t size) const
+{
+    auto it = std::upper_bound(m_segments.begin(), m_segments.end(), address,
+                               [](uint64_t addr, const Segment &segment) { return addr < segment.vaddr; });
+    if (it == m_segments.begin())
+        return 0;
+    --it;
+
+    const uint64_t segmentOffset = address - it->vaddr;
+    if (segmentOffset >= it->fileSize)
+        return 0;
+
+    const size_t count = size_t(std::min<uint64_t>(size, it->fileSize - segmentOffset));
+    memcpy(buffer, m_dump.Data() + it->offset + segmentOffset, count);
+    return count;
+}
+
+size_t CoreDump::ReadMappedFile(uint64_t address, char *buffer, size_t size)
+{
+    auto it = std::upper_bound(m_mappings.begin(), m_mappings.end(), address,
+                               [](uint64_t addr, const Mapping &mapping) { return addr < mapping.start; });
+    if (it == m_mappings.begin())
+        return 0;
+    --it;
+    if (address >= it->end)
+        return 0;
+
+    std::lock_guard<std::mutex> lock(m_filesMutex);
+    std::unique_ptr<MappedFile> &file = m_files[it->path];
+    if (!file)
+    {
+        // Note, file that can't be opened is kept closed in cache, so, open will not be repeated.
+        file.reset(new MappedFile());
+        file->Open(it->path);
+    }
+
+    const uint64_t fileOffset = it->fileOffset + (address - it->start);
+    if (file->Data() == nullptr || fileOffset >= file->Size())
+        return 0;
+
+    const size_t count = size_t(std::min<uint64_t>(std::min<uint64_t>(size, it->end - address), file->Size() - fileOffset));
+    memcpy(buffer, file->Data() + fileOffset, count);
+    return count;
+}
+
+size_t CoreDump::ReadMemory(uint64_t address, void *buffer, size_t size)
+{
+    char *out = static_cast<char*>(buffer);
+    size_t done = 0;
+    while (done < size)
+    {
+        const uint64_t current = address + done;
+        size_t count = ReadSegments(current, out + done, size - done);
+        if (count == 0)
+            count = ReadMappedFile(current, out + done, size - done);
+        if (count == 0)
+            break;
+        done += count;
+    }
+    return done;
+}
+
+bool CoreDump::FindModuleBase(const std::string &fileName, uint64_t &base, std::string &path) const
+{
+    for (const auto &mapping : m_mappings)
+    {
+        if (mapping.fileOffset != 0 || mapping.path.size() < fileName.size())
+            continue;
+
+        const size_t nameStart = mapping.path.size() - fileName.size();
+        if (mapping.path.compare(nameStart, std::string::npos, fileName) != 0 ||
+            (nameStart != 0 && mapping.path[nameStart - 1] != '/'))
+            continue;
+
+        // Note, mappings sorted by start address, first one is module base.
+        base = mapping.start;
+        path = mapping.path;
+        return true;
+    }
+    return false;
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,83 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+/// \file coredump.h  This file contains declaration of ELF core dump reader, that provide target memory, threads
+/// and mapped files of dumped process for offline dump analysis.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "utils/mappedfile.h"
+
+namespace netcoredbg
+{
+
+// Read-only view of ELF64 little endian core dump (createdump, gcore or kernel core file). Dump file is memory
+// mapped, so, dump with huge heap don't need any memory allocation for access.
+class CoreDump
+{
+public:
+
+    struct Thread
+    {
+        uint32_t tid;
+        // Raw `pr_reg` data of NT_PRSTATUS note (`user_regs_struct` of dumped process architecture) till note end.
+        std::vector<uint8_t> registers;
+    };
+
+    struct Mapping
+    {
+        uint64_t start;
+        uint64_t end;
+        uint64_t fileOffset; // in bytes
+        std::string path;
+    };
+
+    // Return false in case file can't be mapped or is not ELF64 little endian core dump, `error` describe reason.
+    bool Open(const std::string &path, std::string &error);
+
+    // ELF `e_machine` of dumped process (EM_X86_64, EM_AARCH64, etc.).
+    uint16_t Machine() const { return m_machine; }
+    const std::vector<Thread> &Threads() const { return m_threads; }
+    const std::vector<Mapping> &Mappings() const { return m_mappings; }
+
+    // Read target memory, return count of bytes read (less than `size` in case memory is not available).
+    // Note, file backed memory not included into dump (for example, module code) is read from mapped file on disk.
+    size_t ReadMemory(uint64_t address, void *buffer, size_t size);
+
+    // Find base address (start of mapping with zero file offset) of loaded file with `fileName` name.
+    bool FindModuleBase(const std::string &fileName, uint64_t &base, std::string &path) const;
+
+private:
+
+    struct Segment
+    {
+        uint64_t vaddr;
+        uint64_t fileSize;
+        uint64_t memSize;
+        uint64_t offset;
+    };
+
+    MappedFile m_dump;
+    uint16_t m_machine = 0;
+    std::vector<Segment> m_segments; // sorted by vaddr
+    std::vector<Thread> m_threads;
+    std::vector<Mapping> m_mappings; // sorted by start
+
+    // Note, files are opened on first access, nullptr stored for files that can't be opened.
+    std::mutex m_filesMutex;
+    std::map<std::string, std::unique_ptr<MappedFile> > m_files;
+
+    bool ParseNotes(const char *data, size_t size);
+    size_t ReadSegments(uint64_t address, char *buffer, size_t size) const;
+    size_t ReadMappedFile(uint64_t address, char *buffer, size_t size);
+};
+
+} // namespace netcoredbg
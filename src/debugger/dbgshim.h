@@ -34,6 +34,8 @@ struct dbgshim_t
     HRESULT (*CloseCLREnumeration)(HANDLE* pHandleArray, LPWSTR* pStringArray, DWORD dwArrayLength);
     HRESULT (*CreateVersionStringFromModule)(DWORD pidDebuggee, LPCWSTR szModuleName, LPWSTR pBuffer, DWORD cchBuffer, DWORD* pdwLength);
     HRESULT (*CreateDebuggingInterfaceFromVersionEx)(int iDebuggerVersion, LPCWSTR szDebuggeeVersion, IUnknown ** ppCordb);
+    // Note, optional (could be nullptr), used for dump analysis only (ICLRDebugging::OpenVirtualProcess).
+    HRESULT (*CLRCreateInstance)(REFCLSID clsid, REFIID riid, LPVOID *ppInterface);
 
     dbgshim_t() :
         CreateProcessForLaunch(nullptr),
@@ -45,6 +47,7 @@ struct dbgshim_t
         CloseCLREnumeration(nullptr),
         CreateVersionStringFromModule(nullptr),
         CreateDebuggingInterfaceFromVersionEx(nullptr),
+        CLRCreateInstance(nullptr),
         m_module(nullptr)
     {
 #ifdef DBGSHIM_DIR
@@ -82,6 +85,7 @@ struct dbgshim_t
         *((void**)&CloseCLREnumeration) = DLSym(m_module, "CloseCLREnumeration");
         *((void**)&CreateVersionStringFromModule) = DLSym(m_module, "CreateVersionStringFromModule");
         *((void**)&CreateDebuggingInterfaceFromVersionEx) = DLSym(m_module, "CreateDebuggingInterfaceFromVersionEx");
+        *((void**)&CLRCreateInstance) = DLSym(m_module, "CLRCreateInstance");
 
         bool dlsym_ok = CreateProcessForLaunch &&
                         ResumeProcess &&
@@ -0,0 +1,258 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/dumptarget.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include "utils/filesystem.h"
+#include "utils/logger.h"
+#include "utils/utf.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+
+    // ELF `e_machine` values.
+    const uint16_t EM_386_ = 3;
+    const uint16_t EM_ARM_ = 40;
+    const uint16_t EM_X86_64_ = 62;
+    const uint16_t EM_AARCH64_ = 183;
+
+    uint64_t Reg(const std::vector<uint8_t> &registers, size_t index)
+    {
+        uint64_t value = 0;
+        if ((index + 1) * sizeof(uint64_t) <= registers.size())
+            memcpy(&value, registers.data() + index * sizeof(uint64_t), sizeof(uint64_t));
+        return value;
+    }
+
+    // Convert `user_regs_struct` of NT_PRSTATUS note into CONTEXT. Note, dump could be analyzed only by DBI and DAC
+    // for same architecture, so, only host architecture CONTEXT is supported.
+    HRESULT RegistersToContext(const std::vector<uint8_t> &registers, CONTEXT &context)
+    {
+#if defined(_TARGET_AMD64_)
+        // r15, r14, r13, r12, rbp, rbx, r11, r10, r9, r8, rax, rcx, rdx, rsi, rdi, orig_rax, rip, cs, eflags, rsp, ss, ...
+        if (registers.size() < 21 * sizeof(uint64_t))
+            return E_FAIL;
+        context.R15 = Reg(registers, 0);
+        context.R14 = Reg(registers, 1);
+        context.R13 = Reg(registers, 2);
+        context.R12 = Reg(registers, 3);
+        context.Rbp = Reg(registers, 4);
+        context.Rbx = Reg(registers, 5);
+        context.R11 = Reg(registers, 6);
+        context.R10 = Reg(registers, 7);
+        context.R9 = Reg(registers, 8);
+        context.R8 = Reg(registers, 9);
+        context.Rax = Reg(registers, 10);
+        context.Rcx = Reg(registers, 11);
+        context.Rdx = Reg(registers, 12);
+        context.Rsi = Reg(registers, 13);
+        context.Rdi = Reg(registers, 14);
+        context.Rip = Reg(registers, 16);
+        context.SegCs = (WORD)Reg(registers, 17);
+        context.EFlags = (DWORD)Reg(registers, 18);
+        context.Rsp = Reg(registers, 19);
+        context.SegSs = (WORD)Reg(registers, 20);
+        context.ContextFlags = CONTEXT_CONTROL | CONTEXT_INTEGER;
+        return S_OK;
+#elif defined(_TARGET_ARM64_)
+        // x0 ... x30, sp, pc, pstate
+        if (registers.size() < 34 * sizeof(uint64_t))
+            return E_FAIL;
+        for (size_t i = 0; i < 29; i++)
+        {
+            context.X[i] = Reg(registers, i);
+        }
+        context.Fp = Reg(registers, 29);
+        context.Lr = Reg(registers, 30);
+        context.Sp = Reg(registers, 31);
+        context.Pc = Reg(registers, 32);
+        context.Cpsr = (DWORD)Reg(registers, 33);
+        context.ContextFlags = CONTEXT_CONTROL | CONTEXT_INTEGER;
+        return S_OK;
+#else
+        (void)registers;
+        (void)context;
+        return E_NOTIMPL;
+#endif
+    }
+
+} // unnamed namespace
+
+HRESULT DumpDataTarget::Open(const std::string &path)
+{
+    std::string error;
+    if (!m_dump.Open(path, error))
+    {
+        LOGE("Can't open dump %s: %s", path.c_str(), error.c_str());
+        return E_FAIL;
+    }
+    return S_OK;
+}
+
+ULONG DumpDataTarget::GetRefCount()
+{
+    std::lock_guard<std::mutex> lock(m_refCountMutex);
+    return m_refCount;
+}
+
+HRESULT STDMETHODCALLTYPE DumpDataTarget::QueryInterface(REFIID riid, VOID** ppInterface)
+{
+    if (riid == IID_ICorDebugDataTarget)
+    {
+        *ppInterface = static_cast<ICorDebugDataTarget*>(this);
+    }
+    else if (riid == IID_IUnknown)
+    {
+        *ppInterface = static_cast<IUnknown*>(this);
+    }
+    else
+    {
+        *ppInterface = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    this->AddRef();
+    return S_OK;
+}
+
+ULONG STDMETHODCALLTYPE DumpDataTarget::AddRef()
+{
+    std::lock_guard<std::mutex> lock(m_refCountMutex);
+    return ++m_refCount;
+}
+
+ULONG STDMETHODCALLTYPE DumpDataTarget::Release()
+{
+    std::lock_guard<std::mutex> lock(m_refCountMutex);
+
+    assert(m_refCount > 0);
+
+    // Note, we don't provide "delete" call for object itself for our fake "COM".
+    // External holder will care about this object during debugger lifetime.
+
+    return --m_refCount;
+}
+
+HRESULT STDMETHODCALLTYPE DumpDataTarget::GetPlatform(CorDebugPlatform *pTargetPlatform)
+{
+    switch (m_dump.Machine())
+    {
+        case EM_X86_64_:  *pTargetPlatform = CORDB_PLATFORM_POSIX_AMD64; return S_OK;
+        case EM_AARCH64_: *pTargetPlatform = CORDB_PLATFORM_POSIX_ARM64; return S_OK;
+        case EM_ARM_:     *pTargetPlatform = CORDB_PLATFORM_POSIX_ARM;   return S_OK;
+        case EM_386_:     *pTargetPlatform = CORDB_PLATFORM_POSIX_X86;   return S_OK;
+        default:          return E_NOTIMPL;
+    }
+}
+
+HRESULT STDMETHODCALLTYPE DumpDataTarget::ReadVirtual(CORDB_ADDRESS address, BYTE *pBuffer, ULONG32 bytesRequested, ULONG32 *pBytesRead)
+{
+    const size_t bytesRead = m_dump.ReadMemory(address, pBuffer, bytesRequested);
+    if (pBytesRead)
+        *pBytesRead = (ULONG32)bytesRead;
+
+    return bytesRead == 0 && bytesRequested != 0 ? CORDBG_E_READVIRTUAL_FAILURE : S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE DumpDataTarget::GetThreadContext(DWORD dwThreadID, ULONG32 /*contextFlags*/, ULONG32 contextSize, BYTE *pContext)
+{
+    if (contextSize < sizeof(CONTEXT))
+        return E_INVALIDARG;
+
+    for (const auto &thread : m_dump.Threads())
+    {
+        if (thread.tid != dwThreadID)
+            continue;
+
+        CONTEXT context;
+        memset(&context, 0, sizeof(CONTEXT));
+        HRESULT Status;
+        // Note, dump provide only integer and control registers, no matter what was requested.
+        IfFailRet(RegistersToContext(thread.registers, context));
+        memcpy(pContext, &context, sizeof(CONTEXT));
+        return S_OK;
+    }
+
+    return E_INVALIDARG;
+}
+
+ULONG DumpLibraryProvider::GetRefCount()
+{
+    std::lock_guard<std::mutex> lock(m_refCountMutex);
+    return m_refCount;
+}
+
+HRESULT STDMETHODCALLTYPE DumpLibraryProvider::QueryInterface(REFIID riid, VOID** ppInterface)
+{
+    if (riid == IID_ICLRDebuggingLibraryProvider)
+    {
+        *ppInterface = static_cast<ICLRDebuggingLibraryProvider*>(this);
+    }
+    else if (riid == IID_ICLRDebuggingLibraryProvider2)
+    {
+        *ppInterface = static_cast<ICLRDebuggingLibraryProvider2*>(this);
+    }
+    else if (riid == IID_IUnknown)
+    {
+        *ppInterface = static_cast<IUnknown*>(static_cast<ICLRDebuggingLibraryProvider*>(this));
+    }
+    else
+    {
+        *ppInterface = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    this->AddRef();
+    return S_OK;
+}
+
+ULONG STDMETHODCALLTYPE DumpLibraryProvider::AddRef()
+{
+    std::lock_guard<std::mutex> lock(m_refCountMutex);
+    return ++m_refCount;
+}
+
+ULONG STDMETHODCALLTYPE DumpLibraryProvider::Release()
+{
+    std::lock_guard<std::mutex> lock(m_refCountMutex);
+
+    assert(m_refCount > 0);
+
+    // Note, we don't provide "delete" call for object itself for our fake "COM".
+    // External holder will care about this object during debugger lifetime.
+
+    return --m_refCount;
+}
+
+HRESULT STDMETHODCALLTYPE DumpLibraryProvider::ProvideLibrary(const WCHAR * /*pwszFileName*/, DWORD /*dwTimestamp*/, DWORD /*dwSizeOfImage*/, HMODULE * /*phModule*/)
+{
+    // Note, module handle could be provided only by PAL's LoadLibrary, ProvideLibrary2() is used instead.
+    return E_NOTIMPL;
+}
+
+HRESULT STDMETHODCALLTYPE DumpLibraryProvider::ProvideLibrary2(const WCHAR *pwszFileName, DWORD /*dwTimestamp*/, DWORD /*dwSizeOfImage*/, LPWSTR *ppResolvedModulePath)
+{
+    if (pwszFileName == nullptr || ppResolvedModulePath == nullptr)
+        return E_INVALIDARG;
+
+    const std::string path = m_runtimeDir + DIRECTORY_SEPARATOR_STR_A + to_utf8(pwszFileName);
+    LOGI("Provide %s for dump analysis", path.c_str());
+
+    const WSTRING wpath = to_utf16(path);
+    // Note, caller release resolved path with free().
+    WCHAR *result = static_cast<WCHAR*>(malloc((wpath.size() + 1) * sizeof(WCHAR)));
+    if (result == nullptr)
+        return E_OUTOFMEMORY;
+    memcpy(result, wpath.c_str(), (wpath.size() + 1) * sizeof(WCHAR));
+    *ppResolvedModulePath = result;
+    return S_OK;
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,80 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+/// \file dumptarget.h  This file contains declaration of ICorDebug data target and libraries provider for dump analysis.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <mutex>
+#include <string>
+#include "debugger/coredump.h"
+
+namespace netcoredbg
+{
+
+// Data target for ICLRDebugging::OpenVirtualProcess(), all target memory and threads context are read from core dump.
+class DumpDataTarget : public ICorDebugDataTarget
+{
+public:
+
+    DumpDataTarget() : m_refCount(0) {}
+
+    HRESULT Open(const std::string &path);
+    CoreDump &GetDump() { return m_dump; }
+    ULONG GetRefCount();
+
+    // IUnknown
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, VOID** ppInterface) override;
+    ULONG STDMETHODCALLTYPE AddRef() override;
+    ULONG STDMETHODCALLTYPE Release() override;
+
+    // ICorDebugDataTarget
+
+    HRESULT STDMETHODCALLTYPE GetPlatform(CorDebugPlatform *pTargetPlatform) override;
+    HRESULT STDMETHODCALLTYPE ReadVirtual(CORDB_ADDRESS address, BYTE *pBuffer, ULONG32 bytesRequested, ULONG32 *pBytesRead) override;
+    HRESULT STDMETHODCALLTYPE GetThreadContext(DWORD dwThreadID, ULONG32 contextFlags, ULONG32 contextSize, BYTE *pContext) override;
+
+private:
+
+    std::mutex m_refCountMutex;
+    ULONG m_refCount;
+    CoreDump m_dump;
+};
+
+// Provide DBI and DAC from runtime directory of dumped process. Note, same runtime version must be installed at same
+// path on host, that analyze dump (usually, dump is analyzed on same host or in same container image).
+class DumpLibraryProvider : public ICLRDebuggingLibraryProvider, public ICLRDebuggingLibraryProvider2
+{
+public:
+
+    DumpLibraryProvider(const std::string &runtimeDir) : m_refCount(0), m_runtimeDir(runtimeDir) {}
+
+    ULONG GetRefCount();
+
+    // IUnknown
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, VOID** ppInterface) override;
+    ULONG STDMETHODCALLTYPE AddRef() override;
+    ULONG STDMETHODCALLTYPE Release() override;
+
+    // ICLRDebuggingLibraryProvider
+
+    HRESULT STDMETHODCALLTYPE ProvideLibrary(const WCHAR *pwszFileName, DWORD dwTimestamp, DWORD dwSizeOfImage, HMODULE *phModule) override;
+
+    // ICLRDebuggingLibraryProvider2
+
+    HRESULT STDMETHODCALLTYPE ProvideLibrary2(const WCHAR *pwszFileName, DWORD dwTimestamp, DWORD dwSizeOfImage, LPWSTR *ppResolvedModulePath) override;
+
+private:
+
+    std::mutex m_refCountMutex;
+    ULONG m_refCount;
+    std::string m_runtimeDir;
+};
+
+} // namespace netcoredbg
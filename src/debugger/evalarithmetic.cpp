@@ -0,0 +1,617 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/evalarithmetic.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace netcoredbg
+{
+
+namespace EvalArithmetic
+{
+
+namespace
+{
+    // Same messages as managed part provide for OverflowException and DivideByZeroException.
+    const char OverflowError[] = "error: Arithmetic operation resulted in an overflow.";
+    const char DivideByZeroError[] = "error: Attempted to divide by zero.";
+
+    bool IsIntegral(BasicTypes type)
+    {
+        switch (type)
+        {
+        case BasicTypes::TypeByte:
+        case BasicTypes::TypeSByte:
+        case BasicTypes::TypeChar:
+        case BasicTypes::TypeInt16:
+        case BasicTypes::TypeUInt16:
+        case BasicTypes::TypeInt32:
+        case BasicTypes::TypeUInt32:
+        case BasicTypes::TypeInt64:
+        case BasicTypes::TypeUInt64:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool IsFloatingPoint(BasicTypes type)
+    {
+        return type == BasicTypes::TypeSingle || type == BasicTypes::TypeDouble;
+    }
+
+    bool IsNumeric(BasicTypes type)
+    {
+        return IsIntegral(type) || IsFloatingPoint(type);
+    }
+
+    bool IsSigned(BasicTypes type)
+    {
+        return type == BasicTypes::TypeSByte || type == BasicTypes::TypeInt16 ||
+               type == BasicTypes::TypeInt32 || type == BasicTypes::TypeInt64;
+    }
+
+    bool IsUnsigned(BasicTypes type)
+    {
+        return IsIntegral(type) && !IsSigned(type);
+    }
+
+    // C# unary numeric promotion (see ECMA-334 "Unary numeric promotions").
+    BasicTypes UnaryPromotion(BasicTypes type)
+    {
+        switch (type)
+        {
+        case BasicTypes::TypeByte:
+        case BasicTypes::TypeSByte:
+        case BasicTypes::TypeChar:
+        case BasicTypes::TypeInt16:
+        case BasicTypes::TypeUInt16:
+            return BasicTypes::TypeInt32;
+        default:
+            return type;
+        }
+    }
+
+    // C# binary numeric promotion (see ECMA-334 "Binary numeric promotions"), operands must be numeric.
+    // Return false in case promotion is not allowed (ulong with signed type).
+    bool BinaryPromotion(BasicTypes type1, BasicTypes type2, BasicTypes &result)
+    {
+        auto either = [&](BasicTypes type) { return type1 == type || type2 == type; };
+
+        if (either(BasicTypes::TypeDouble))
+            result = BasicTypes::TypeDouble;
+        else if (either(BasicTypes::TypeSingle))
+            result = BasicTypes::TypeSingle;
+        else if (either(BasicTypes::TypeUInt64))
+        {
+            if (IsSigned(type1) || IsSigned(type2))
+                return false;
+            result = BasicTypes::TypeUInt64;
+        }
+        else if (either(BasicTypes::TypeInt64))
+            result = BasicTypes::TypeInt64;
+        else if (either(BasicTypes::TypeUInt32))
+            result = (IsSigned(type1) || IsSigned(type2)) ? BasicTypes::TypeInt64 : BasicTypes::TypeUInt32;
+        else
+            result = BasicTypes::TypeInt32;
+
+        return true;
+    }
+
+    // Truncate integral value to type's size, keep 64 bit value sign extended (signed types) or zero extended.
+    int64_t Normalize(BasicTypes type, int64_t value)
+    {
+        switch (type)
+        {
+        case BasicTypes::TypeInt32:
+            return int32_t(value);
+        case BasicTypes::TypeUInt32:
+            return uint32_t(value);
+        default:
+            return value;
+        }
+    }
+
+    // Implicit numeric conversion into promoted type (Int32, UInt32, Int64, UInt64, Single or Double).
+    Value Convert(const Value &value, BasicTypes type)
+    {
+        Value result;
+        result.type = type;
+
+        if (type == BasicTypes::TypeDouble)
+        {
+            if (IsFloatingPoint(value.type))
+                result.d = value.d;
+            else
+                result.d = value.type == BasicTypes::TypeUInt64 ? double(uint64_t(value.i)) : double(value.i);
+        }
+        else if (type == BasicTypes::TypeSingle)
+        {
+            if (IsFloatingPoint(value.type))
+                result.d = value.d; // Single only, since Double can't be converted implicitly
+            else
+                result.d = value.type == BasicTypes::TypeUInt64 ? float(uint64_t(value.i)) : float(value.i);
+        }
+        else
+            result.i = value.i;
+
+        return result;
+    }
+
+    // Return false in case of overflow, `result` contain truncated value.
+    bool SignedOperation(OperationType opType, int64_t x, int64_t y, int64_t &result)
+    {
+        const int64_t min = std::numeric_limits<int64_t>::min();
+        const int64_t max = std::numeric_limits<int64_t>::max();
+
+        switch (opType)
+        {
+        case OperationType::AddExpression:
+            result = int64_t(uint64_t(x) + uint64_t(y));
+            return !((y > 0 && x > max - y) || (y < 0 && x < min - y));
+        case OperationType::SubtractExpression:
+            result = int64_t(uint64_t(x) - uint64_t(y));
+            return !((y < 0 && x > max + y) || (y > 0 && x < min + y));
+        case OperationType::MultiplyExpression:
+            result = int64_t(uint64_t(x) * uint64_t(y));
+            if (x == 0 || y == 0)
+                return true;
+            if ((x == -1 && y == min) || (y == -1 && x == min))
+                return false;
+            return result / y == x;
+        case OperationType::DivideExpression:
+            result = x / y;
+            return true;
+        default: // OperationType::ModuloExpression
+            result = x % y;
+            return true;
+        }
+    }
+
+    bool UnsignedOperation(OperationType opType, uint64_t x, uint64_t y, uint64_t &result)
+    {
+        switch (opType)
+        {
+        case OperationType::AddExpression:
+            result = x + y;
+            return result >= x;
+        case OperationType::SubtractExpression:
+            result = x - y;
+            return x >= y;
+        case OperationType::MultiplyExpression:
+            result = x * y;
+            return x == 0 || result / x == y;
+        case OperationType::DivideExpression:
+            result = x / y;
+            return true;
+        default: // OperationType::ModuloExpression
+            result = x % y;
+            return true;
+        }
+    }
+
+    Result Arithmetic(OperationType opType, const Value &x, const Value &y, bool checkedContext, Value &result, std::string &errorText)
+    {
+        result.type = x.type;
+
+        if (IsFloatingPoint(x.type))
+        {
+            double value;
+            switch (opType)
+            {
+            case OperationType::AddExpression:      value = x.d + y.d; break;
+            case OperationType::SubtractExpression: value = x.d - y.d; break;
+            case OperationType::MultiplyExpression: value = x.d * y.d; break;
+            case OperationType::DivideExpression:   value = x.d / y.d; break;
+            default:                                value = std::fmod(x.d, y.d); break;
+            }
+            // Note, result of Single operation calculated in double precision and rounded is same as float operation result.
+            result.d = x.type == BasicTypes::TypeSingle ? double(float(value)) : value;
+            return Result::Calculated;
+        }
+
+        if (opType == OperationType::DivideExpression || opType == OperationType::ModuloExpression)
+        {
+            if (y.i == 0)
+            {
+                errorText = DivideByZeroError;
+                return Result::Failed;
+            }
+            // Note, CLR throw OverflowException for `MinValue / -1` and `MinValue % -1` in unchecked context too.
+            if (y.i == -1 && ((x.type == BasicTypes::TypeInt32 && x.i == std::numeric_limits<int32_t>::min()) ||
+                              (x.type == BasicTypes::TypeInt64 && x.i == std::numeric_limits<int64_t>::min())))
+            {
+                errorText = OverflowError;
+                return Result::Failed;
+            }
+        }
+
+        bool noOverflow;
+        if (IsSigned(x.type))
+            noOverflow = SignedOperation(opType, x.i, y.i, result.i);
+        else
+        {
+            uint64_t value;
+            noOverflow = UnsignedOperation(opType, uint64_t(x.i), uint64_t(y.i), value);
+            result.i = int64_t(value);
+        }
+
+        // Note, 32 bit operations can't overflow 64 bit calculation, but result could be out of type's range.
+        const int64_t value = Normalize(x.type, result.i);
+        noOverflow = noOverflow && value == result.i;
+        result.i = value;
+
+        if (checkedContext && !noOverflow)
+        {
+            errorText = OverflowError;
+            return Result::Failed;
+        }
+
+        return Result::Calculated;
+    }
+
+    template <typename T> bool CompareValues(OperationType opType, T x, T y)
+    {
+        switch (opType)
+        {
+        case OperationType::EqualsExpression:             return x == y;
+        case OperationType::NotEqualsExpression:          return x != y;
+        case OperationType::LessThanExpression:           return x < y;
+        case OperationType::GreaterThanExpression:        return x > y;
+        case OperationType::LessThanOrEqualExpression:    return x <= y;
+        default: /*OperationType::GreaterThanOrEqualExpression*/ return x >= y;
+        }
+    }
+
+    bool Compare(OperationType opType, const Value &x, const Value &y)
+    {
+        if (IsFloatingPoint(x.type))
+            return CompareValues(opType, x.d, y.d);
+        else if (IsUnsigned(x.type))
+            return CompareValues(opType, uint64_t(x.i), uint64_t(y.i));
+        else
+            return CompareValues(opType, x.i, y.i);
+    }
+
+    Result Shift(OperationType opType, const Value &operand1, const Value &operand2, Value &result)
+    {
+        // Right operand must be implicitly convertible to int.
+        if (!IsIntegral(operand1.type) || UnaryPromotion(operand2.type) != BasicTypes::TypeInt32)
+            return Result::NotHandled;
+
+        result.type = UnaryPromotion(operand1.type);
+        const bool is64 = result.type == BasicTypes::TypeInt64 || result.type == BasicTypes::TypeUInt64;
+        const unsigned count = unsigned(operand2.i) & (is64 ? 0x3F : 0x1F);
+
+        if (opType == OperationType::LeftShiftExpression)
+            result.i = Normalize(result.type, int64_t(uint64_t(operand1.i) << count));
+        else if (IsUnsigned(result.type))
+            result.i = int64_t(uint64_t(operand1.i) >> count);
+        // Arithmetic shift for signed types, note, 32 bit value is sign extended, so, same code could be used.
+        else if (operand1.i < 0)
+            result.i = ~(~operand1.i >> count);
+        else
+            result.i = operand1.i >> count;
+
+        return Result::Calculated;
+    }
+
+    // Same as ToString() for types allowed in string concatenation, return false for types with complex formatting.
+    bool AppendToString(const Value &value, std::string &output)
+    {
+        switch (value.type)
+        {
+        case BasicTypes::TypeString:
+            output += value.s;
+            return true;
+        case BasicTypes::TypeBoolean:
+            output += value.i ? "True" : "False";
+            return true;
+        case BasicTypes::TypeChar:
+        {
+            const uint32_t c = uint32_t(value.i);
+            // Note, lone surrogate can't be represented in UTF-8, leave it for managed implementation.
+            if (c >= 0xD800 && c <= 0xDFFF)
+                return false;
+
+            if (c < 0x80)
+                output += char(c);
+            else if (c < 0x800)
+            {
+                output += char(0xC0 | (c >> 6));
+                output += char(0x80 | (c & 0x3F));
+            }
+            else
+            {
+                output += char(0xE0 | (c >> 12));
+                output += char(0x80 | ((c >> 6) & 0x3F));
+                output += char(0x80 | (c & 0x3F));
+            }
+            return true;
+        }
+        case BasicTypes::TypeUInt64:
+            output += std::to_string(uint64_t(value.i));
+            return true;
+        default:
+            if (!IsIntegral(value.type))
+                return false;
+            output += std::to_string(value.i);
+            return true;
+        }
+    }
+
+    bool IsComparison(OperationType opType)
+    {
+        switch (opType)
+        {
+        case OperationType::EqualsExpression:
+        case OperationType::NotEqualsExpression:
+        case OperationType::LessThanExpression:
+        case OperationType::GreaterThanExpression:
+        case OperationType::LessThanOrEqualExpression:
+        case OperationType::GreaterThanOrEqualExpression:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    Result StringOperation(OperationType opType, const Value &operand1, const Value &operand2, Value &result)
+    {
+        if (opType == OperationType::AddExpression)
+        {
+            std::string value;
+            if (!AppendToString(operand1, value) || !AppendToString(operand2, value))
+                return Result::NotHandled;
+            result = Value::FromString(value);
+            return Result::Calculated;
+        }
+
+        if (operand1.type != BasicTypes::TypeString || operand2.type != BasicTypes::TypeString)
+            return Result::NotHandled;
+
+        // Note, string comparison is ordinal, same as String.op_Equality().
+        if (opType == OperationType::EqualsExpression)
+            result = Value::FromBoolean(operand1.s == operand2.s);
+        else if (opType == OperationType::NotEqualsExpression)
+            result = Value::FromBoolean(operand1.s != operand2.s);
+        else
+            return Result::NotHandled;
+
+        return Result::Calculated;
+    }
+
+    Result BooleanOperation(OperationType opType, const Value &operand1, const Value &operand2, Value &result)
+    {
+        if (operand1.type != BasicTypes::TypeBoolean || operand2.type != BasicTypes::TypeBoolean)
+            return Result::NotHandled;
+
+        const bool x = operand1.i != 0;
+        const bool y = operand2.i != 0;
+        switch (opType)
+        {
+        case OperationType::LogicalAndExpression:
+        case OperationType::BitwiseAndExpression:
+            result = Value::FromBoolean(x && y);
+            break;
+        case OperationType::LogicalOrExpression:
+        case OperationType::BitwiseOrExpression:
+            result = Value::FromBoolean(x || y);
+            break;
+        case OperationType::ExclusiveOrExpression:
+        case OperationType::NotEqualsExpression:
+            result = Value::FromBoolean(x != y);
+            break;
+        case OperationType::EqualsExpression:
+            result = Value::FromBoolean(x == y);
+            break;
+        default:
+            return Result::NotHandled;
+        }
+
+        return Result::Calculated;
+    }
+} // unnamed namespace
+
+bool Value::FromRaw(BasicTypes type, const void *data, Value &value)
+{
+    value = Value();
+    value.type = type;
+
+    switch (type)
+    {
+    case BasicTypes::TypeBoolean:
+    case BasicTypes::TypeByte:
+        { uint8_t v; memcpy(&v, data, sizeof(v)); value.i = type == BasicTypes::TypeBoolean ? (v != 0) : v; }
+        break;
+    case BasicTypes::TypeSByte:
+        { int8_t v; memcpy(&v, data, sizeof(v)); value.i = v; }
+        break;
+    case BasicTypes::TypeChar:
+    case BasicTypes::TypeUInt16:
+        { uint16_t v; memcpy(&v, data, sizeof(v)); value.i = v; }
+        break;
+    case BasicTypes::TypeInt16:
+        { int16_t v; memcpy(&v, data, sizeof(v)); value.i = v; }
+        break;
+    case BasicTypes::TypeInt32:
+        { int32_t v; memcpy(&v, data, sizeof(v)); value.i = v; }
+        break;
+    case BasicTypes::TypeUInt32:
+        { uint32_t v; memcpy(&v, data, sizeof(v)); value.i = v; }
+        break;
+    case BasicTypes::TypeInt64:
+    case BasicTypes::TypeUInt64:
+        memcpy(&value.i, data, sizeof(value.i));
+        break;
+    case BasicTypes::TypeSingle:
+        { float v; memcpy(&v, data, sizeof(v)); value.d = v; }
+        break;
+    case BasicTypes::TypeDouble:
+        memcpy(&value.d, data, sizeof(value.d));
+        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+bool Value::ToRaw(void *data) const
+{
+    memset(data, 0, sizeof(int64_t));
+
+    switch (type)
+    {
+    case BasicTypes::TypeBoolean:
+    case BasicTypes::TypeByte:
+    case BasicTypes::TypeSByte:
+        { uint8_t v = uint8_t(i); memcpy(data, &v, sizeof(v)); }
+        break;
+    case BasicTypes::TypeChar:
+    case BasicTypes::TypeInt16:
+    case BasicTypes::TypeUInt16:
+        { uint16_t v = uint16_t(i); memcpy(data, &v, sizeof(v)); }
+        break;
+    case BasicTypes::TypeInt32:
+    case BasicTypes::TypeUInt32:
+        { uint32_t v = uint32_t(i); memcpy(data, &v, sizeof(v)); }
+        break;
+    case BasicTypes::TypeInt64:
+    case BasicTypes::TypeUInt64:
+        memcpy(data, &i, sizeof(i));
+        break;
+    case BasicTypes::TypeSingle:
+        { float v = float(d); memcpy(data, &v, sizeof(v)); }
+        break;
+    case BasicTypes::TypeDouble:
+        memcpy(data, &d, sizeof(d));
+        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+Result Calculate(OperationType opType, const Value &operand1, const Value &operand2, bool checkedContext,
+                 Value &result, std::string &errorText)
+{
+    if (operand1.type == BasicTypes::TypeString || operand2.type == BasicTypes::TypeString)
+        return StringOperation(opType, operand1, operand2, result);
+
+    if (operand1.type == BasicTypes::TypeBoolean || operand2.type == BasicTypes::TypeBoolean ||
+        opType == OperationType::LogicalAndExpression || opType == OperationType::LogicalOrExpression)
+        return BooleanOperation(opType, operand1, operand2, result);
+
+    if (!IsNumeric(operand1.type) || !IsNumeric(operand2.type))
+        return Result::NotHandled;
+
+    if (opType == OperationType::LeftShiftExpression || opType == OperationType::RightShiftExpression)
+        return Shift(opType, operand1, operand2, result);
+
+    BasicTypes type;
+    if (!BinaryPromotion(operand1.type, operand2.type, type))
+        return Result::NotHandled;
+
+    const Value x = Convert(operand1, type);
+    const Value y = Convert(operand2, type);
+
+    switch (opType)
+    {
+    case OperationType::AddExpression:
+    case OperationType::SubtractExpression:
+    case OperationType::MultiplyExpression:
+    case OperationType::DivideExpression:
+    case OperationType::ModuloExpression:
+        return Arithmetic(opType, x, y, checkedContext, result, errorText);
+
+    case OperationType::BitwiseAndExpression:
+    case OperationType::BitwiseOrExpression:
+    case OperationType::ExclusiveOrExpression:
+        if (IsFloatingPoint(type))
+            return Result::NotHandled;
+        result.type = type;
+        if (opType == OperationType::BitwiseAndExpression)
+            result.i = x.i & y.i;
+        else if (opType == OperationType::BitwiseOrExpression)
+            result.i = x.i | y.i;
+        else
+            result.i = x.i ^ y.i;
+        return Result::Calculated;
+
+    default:
+        if (!IsComparison(opType))
+            return Result::NotHandled;
+        result = Value::FromBoolean(Compare(opType, x, y));
+        return Result::Calculated;
+    }
+}
+
+Result Calculate(OperationType opType, const Value &operand, bool checkedContext,
+                 Value &result, std::string &errorText)
+{
+    if (opType == OperationType::LogicalNotExpression)
+    {
+        if (operand.type != BasicTypes::TypeBoolean)
+            return Result::NotHandled;
+        result = Value::FromBoolean(operand.i == 0);
+        return Result::Calculated;
+    }
+
+    if (!IsNumeric(operand.type))
+        return Result::NotHandled;
+
+    const Value x = Convert(operand, UnaryPromotion(operand.type));
+
+    switch (opType)
+    {
+    case OperationType::UnaryPlusExpression:
+        result = x;
+        return Result::Calculated;
+
+    case OperationType::UnaryMinusExpression:
+        switch (x.type)
+        {
+        case BasicTypes::TypeSingle:
+        case BasicTypes::TypeDouble:
+            result = x;
+            result.d = -x.d;
+            return Result::Calculated;
+        case BasicTypes::TypeUInt32:
+            // Note, C# provide `long operator -(long x)` for uint operand.
+            result = Value::FromInt64(-x.i);
+            return Result::Calculated;
+        case BasicTypes::TypeInt32:
+        case BasicTypes::TypeInt64:
+            result.type = x.type;
+            result.i = Normalize(x.type, int64_t(0 - uint64_t(x.i)));
+            if (checkedContext && x.i != 0 && result.i == x.i)
+            {
+                errorText = OverflowError;
+                return Result::Failed;
+            }
+            return Result::Calculated;
+        default: // ulong negation is not allowed
+            return Result::NotHandled;
+        }
+
+    case OperationType::BitwiseNotExpression:
+        if (IsFloatingPoint(x.type))
+            return Result::NotHandled;
+        result.type = x.type;
+        result.i = Normalize(x.type, ~x.i);
+        return Result::Calculated;
+
+    default:
+        return Result::NotHandled;
+    }
+}
+
+} // namespace EvalArithmetic
+
+} // namespace netcoredbg
@@ -0,0 +1,107 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+/// \file evalarithmetic.h  This file contains declaration of native implementation of C# operators for built-in types.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace netcoredbg
+{
+
+// Keep in sync with BasicTypes enum in Evaluation.cs
+enum class BasicTypes : int32_t
+{
+    TypeBoolean = 1,
+    TypeByte,
+    TypeSByte,
+    TypeChar,
+    TypeDouble,
+    TypeSingle,
+    TypeInt32,
+    TypeUInt32,
+    TypeInt64,
+    TypeUInt64,
+    TypeInt16,
+    TypeUInt16,
+    TypeString
+};
+
+// Keep in sync with OperationType enum in Evaluation.cs
+enum class OperationType : int32_t
+{
+    AddExpression = 1,
+    SubtractExpression,
+    MultiplyExpression,
+    DivideExpression,
+    ModuloExpression,
+    RightShiftExpression,
+    LeftShiftExpression,
+    BitwiseNotExpression,
+    LogicalAndExpression,
+    LogicalOrExpression,
+    ExclusiveOrExpression,
+    BitwiseAndExpression,
+    BitwiseOrExpression,
+    LogicalNotExpression,
+    EqualsExpression,
+    NotEqualsExpression,
+    LessThanExpression,
+    GreaterThanExpression,
+    LessThanOrEqualExpression,
+    GreaterThanOrEqualExpression,
+    UnaryPlusExpression,
+    UnaryMinusExpression
+};
+
+// Native implementation of C# unary and binary operators for built-in types (numeric promotions, checked/unchecked
+// integral arithmetic, comparisons, shifts, bool logic and string concatenation), so, evaluation of expressions like
+// `i + 1 > 10` don't need managed CalculationDelegate() call for each operator. Operations, which are not allowed in
+// C# for provided operand types, or rare cases with complex semantic (like floating point value formatting during string
+// concatenation) are not handled, caller should use managed implementation for them (this also provides proper error).
+namespace EvalArithmetic
+{
+    struct Value
+    {
+        BasicTypes type;
+        int64_t i;      // Boolean, Char and integral types value (UInt64 value stored as bits)
+        double d;       // Single and Double value
+        std::string s;  // String value in UTF-8, note, null string is same as empty string
+
+        Value() : type(BasicTypes::TypeInt32), i(0), d(0) {}
+
+        static Value FromBoolean(bool value) { Value v; v.type = BasicTypes::TypeBoolean; v.i = value ? 1 : 0; return v; }
+        static Value FromInt32(int32_t value) { Value v; v.type = BasicTypes::TypeInt32; v.i = value; return v; }
+        static Value FromUInt32(uint32_t value) { Value v; v.type = BasicTypes::TypeUInt32; v.i = value; return v; }
+        static Value FromInt64(int64_t value) { Value v; v.type = BasicTypes::TypeInt64; v.i = value; return v; }
+        static Value FromUInt64(uint64_t value) { Value v; v.type = BasicTypes::TypeUInt64; v.i = int64_t(value); return v; }
+        static Value FromSingle(float value) { Value v; v.type = BasicTypes::TypeSingle; v.d = value; return v; }
+        static Value FromDouble(double value) { Value v; v.type = BasicTypes::TypeDouble; v.d = value; return v; }
+        static Value FromString(const std::string &value) { Value v; v.type = BasicTypes::TypeString; v.s = value; return v; }
+
+        /// Create value from raw (little endian) data with size of `type`, as ICorDebugGenericValue::GetValue() provide.
+        /// Return false for TypeString or unknown type.
+        static bool FromRaw(BasicTypes type, const void *data, Value &value);
+
+        /// Store value as raw data, `data` should have at least 8 bytes. Return false for TypeString.
+        bool ToRaw(void *data) const;
+    };
+
+    enum class Result
+    {
+        Calculated,
+        NotHandled, // caller should use managed implementation
+        Failed      // runtime error (like division by zero), error text provided
+    };
+
+    Result Calculate(OperationType opType, const Value &operand1, const Value &operand2, bool checkedContext,
+                     Value &result, std::string &errorText);
+
+    Result Calculate(OperationType opType, const Value &operand, bool checkedContext,
+                     Value &result, std::string &errorText);
+}
+
+} // namespace netcoredbg
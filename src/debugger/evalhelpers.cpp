@@ -10,6 +10,7 @@
 #include "utils/utf.h"
 #include "metadata/modules.h"
 #include "metadata/typeprinter.h"
+#include "utils/logger.h"
 #include "valueprint.h"
 
 namespace netcoredbg
@@ -22,11 +23,52 @@ void EvalHelpers::Cleanup()
         m_pSuppressFinalize.Free();
     m_pSuppressFinalizeMutex.unlock();
 
+    m_moduleMethodsMutex.lock();
+    m_moduleMethods.clear();
+    m_moduleMethodsMutex.unlock();
+
     m_typeObjectCacheMutex.lock();
+    LOGI("Type objects cache: %llu hits, %llu misses", (unsigned long long)m_typeObjectCacheHits, (unsigned long long)m_typeObjectCacheMisses);
+    m_typeObjectCacheIndex.clear();
     m_typeObjectCache.clear();
+    m_typeObjectCacheHits = 0;
+    m_typeObjectCacheMisses = 0;
     m_typeObjectCacheMutex.unlock();
 }
 
+const size_t EvalHelpers::DefaultTypeObjectCacheCapacity;
+const size_t EvalHelpers::MaxTypeObjectCacheCapacity;
+
+void EvalHelpers::SetTypeObjectCacheCapacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(m_typeObjectCacheMutex);
+
+    m_typeObjectCacheCapacity = std::min(capacity, MaxTypeObjectCacheCapacity);
+    while (m_typeObjectCache.size() > m_typeObjectCacheCapacity)
+    {
+        m_typeObjectCacheIndex.erase(m_typeObjectCache.back().id);
+        m_typeObjectCache.pop_back();
+    }
+}
+
+size_t EvalHelpers::GetTypeObjectCacheCapacity()
+{
+    std::lock_guard<std::mutex> lock(m_typeObjectCacheMutex);
+    return m_typeObjectCacheCapacity;
+}
+
+void EvalHelpers::GetTypeObjectCacheStats(uint64_t &hits, uint64_t &misses)
+{
+    std::lock_guard<std::mutex> lock(m_typeObjectCacheMutex);
+    hits = m_typeObjectCacheHits;
+    misses = m_typeObjectCacheMisses;
+}
+
+uint64_t EvalHelpers::GetEvalsCount()
+{
+    return m_sharedEvalWaiter->GetEvalsCount();
+}
+
 HRESULT EvalHelpers::CreateString(ICorDebugThread *pThread, const std::string &value, ICorDebugValue **ppNewString)
 {
     auto value16t = to_utf16(value);
@@ -97,7 +139,8 @@ HRESULT EvalHelpers::EvalFunction(
                 ArgsValueCount,
                 ppArgsValue));
             return S_OK;
-        });
+        },
+        evalFlags);
 }
 
 HRESULT EvalHelpers::EvalGenericFunction(
@@ -130,7 +173,8 @@ HRESULT EvalHelpers::EvalGenericFunction(
                 valueCount,
                 ppValues));
             return S_OK;
-        });
+        },
+        flags);
 }
 
 static HRESULT GetMethodToken(IMetaDataImport *pMD, mdTypeDef cl, const WCHAR *methodName)
@@ -169,10 +213,40 @@ HRESULT EvalHelpers::FindMethodInModule(const std::string &moduleName, const WCH
     HRESULT Status;
     ToRelease<ICorDebugModule> pModule;
     IfFailRet(m_sharedModules->GetModuleWithName(moduleName, &pModule));
-    IfFailRet(FindFunction(pModule, className, methodName, ppFunction));
+    CORDB_ADDRESS modAddress = 0;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+
+    const module_method_key_t key(modAddress, to_utf8(className), to_utf8(methodName));
+    std::lock_guard<std::mutex> lock(m_moduleMethodsMutex);
+    auto find = m_moduleMethods.find(key);
+    if (find == m_moduleMethods.end())
+    {
+        ToRelease<ICorDebugFunction> pFunction;
+        IfFailRet(FindFunction(pModule, className, methodName, &pFunction));
+        find = m_moduleMethods.emplace(key, std::move(pFunction)).first;
+    }
+
+    find->second->AddRef();
+    *ppFunction = find->second.GetPtr();
     return S_OK;
 }
 
+void EvalHelpers::InvalidateModuleMethods(ICorDebugModule *pModule)
+{
+    CORDB_ADDRESS modAddress = 0;
+    if (FAILED(pModule->GetBaseAddress(&modAddress)))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_moduleMethodsMutex);
+    for (auto it = m_moduleMethods.begin(); it != m_moduleMethods.end();)
+    {
+        if (std::get<0>(it->first) == modAddress)
+            it = m_moduleMethods.erase(it);
+        else
+            ++it;
+    }
+}
+
 static bool TypeHaveStaticMembers(ICorDebugType *pType)
 {
     HRESULT Status;
@@ -248,14 +322,18 @@ HRESULT EvalHelpers::TryReuseTypeObjectFromCache(ICorDebugType *pType, ICorDebug
     COR_TYPEID typeID;
     IfFailRet(iCorType2->GetTypeID(&typeID));
 
-    auto is_same = [&typeID](type_object_t &typeObject){ return typeObject.id.token1 == typeID.token1 && typeObject.id.token2 == typeID.token2; };
-    auto it = std::find_if(m_typeObjectCache.begin(), m_typeObjectCache.end(), is_same);
-    if (it == m_typeObjectCache.end())
+    auto find = m_typeObjectCacheIndex.find(typeID);
+    if (find == m_typeObjectCacheIndex.end())
+    {
+        m_typeObjectCacheMisses++;
         return E_FAIL;
+    }
+    m_typeObjectCacheHits++;
 
     // Move data to begin, so, last used will be on front.
-    if (it != m_typeObjectCache.begin())
-        m_typeObjectCache.splice(m_typeObjectCache.begin(), m_typeObjectCache, it);
+    // Note, splice() don't invalidate iterators, index still valid.
+    if (find->second != m_typeObjectCache.begin())
+        m_typeObjectCache.splice(m_typeObjectCache.begin(), m_typeObjectCache, find->second);
 
     if (ppTypeObjectResult)
     {
@@ -279,9 +357,10 @@ HRESULT EvalHelpers::AddTypeObjectToCache(ICorDebugType *pType, ICorDebugValue *
     COR_TYPEID typeID;
     IfFailRet(iCorType2->GetTypeID(&typeID));
 
-    auto is_same = [&typeID](type_object_t &typeObject){ return typeObject.id.token1 == typeID.token1 && typeObject.id.token2 == typeID.token2; };
-    auto it = std::find_if(m_typeObjectCache.begin(), m_typeObjectCache.end(), is_same);
-    if (it != m_typeObjectCache.end())
+    if (m_typeObjectCacheCapacity == 0)
+        return S_OK;
+
+    if (m_typeObjectCacheIndex.find(typeID) != m_typeObjectCacheIndex.end())
         return S_OK;
 
     ToRelease<ICorDebugHandleValue> iCorHandleValue;
@@ -292,18 +371,20 @@ HRESULT EvalHelpers::AddTypeObjectToCache(ICorDebugType *pType, ICorDebugValue *
         handleType != HANDLE_STRONG)
         return E_FAIL;
 
-    if (m_typeObjectCache.size() == m_typeObjectCacheSize)
+    if (m_typeObjectCache.size() >= m_typeObjectCacheCapacity)
     {
         // Re-use last list entry.
+        m_typeObjectCacheIndex.erase(m_typeObjectCache.back().id);
         m_typeObjectCache.back().id = typeID;
         m_typeObjectCache.back().typeObject.Free();
         m_typeObjectCache.back().typeObject = iCorHandleValue.Detach();
-        assert(m_typeObjectCacheSize >= 2);
         m_typeObjectCache.splice(m_typeObjectCache.begin(), m_typeObjectCache, std::prev(m_typeObjectCache.end()));
     }
     else
         m_typeObjectCache.emplace_front(type_object_t{typeID, iCorHandleValue.Detach()});
 
+    m_typeObjectCacheIndex[typeID] = m_typeObjectCache.begin();
+
     return S_OK;
 }
 
@@ -9,8 +9,11 @@
 
 #include <string>
 #include <list>
+#include <map>
 #include <mutex>
+#include <tuple>
 #include <memory>
+#include <unordered_map>
 #include "utils/torelease.h"
 
 namespace netcoredbg
@@ -69,10 +72,28 @@ public:
 
     HRESULT CreateString(ICorDebugThread *pThread, const std::string &value, ICorDebugValue **ppNewString);
 
+    // Note, found functions are cached, so, metadata is not searched at each call with same names.
     HRESULT FindMethodInModule(const std::string &moduleName, const WCHAR className[], const WCHAR methodName[], ICorDebugFunction **ppFunction);
+    // Must be called in case module unloaded or its metadata changed (Hot Reload).
+    void InvalidateModuleMethods(ICorDebugModule *pModule);
 
     void Cleanup();
 
+    // Because handles affect the performance of the garbage collector, the debugger should limit itself to a relatively
+    // small number of handles (about 256) that are active at a time.
+    // https://docs.microsoft.com/en-us/dotnet/framework/unmanaged-api/debugging/icordebugheapvalue2-createhandle-method
+    // Note, we also use handles (results of eval) in var refs during brake (cleared at 'Continue').
+    static const size_t DefaultTypeObjectCacheCapacity = 100;
+    static const size_t MaxTypeObjectCacheCapacity = 200;
+
+    // Note, capacity `0` disable type objects cache, capacity bigger than MaxTypeObjectCacheCapacity is truncated.
+    void SetTypeObjectCacheCapacity(size_t capacity);
+    size_t GetTypeObjectCacheCapacity();
+    void GetTypeObjectCacheStats(uint64_t &hits, uint64_t &misses);
+
+    // Count of evaluations run (see EvalWaiter::GetEvalsCount()).
+    uint64_t GetEvalsCount();
+
 private:
 
     std::shared_ptr<Modules> m_sharedModules;
@@ -81,22 +102,43 @@ private:
     std::mutex m_pSuppressFinalizeMutex;
     ToRelease<ICorDebugFunction> m_pSuppressFinalize;
 
+    // Module address, class name, method name.
+    typedef std::tuple<CORDB_ADDRESS, std::string, std::string> module_method_key_t;
+    std::mutex m_moduleMethodsMutex;
+    std::map<module_method_key_t, ToRelease<ICorDebugFunction>> m_moduleMethods;
+
     struct type_object_t
     {
         COR_TYPEID id;
         ToRelease<ICorDebugHandleValue> typeObject;
     };
 
+    // COR_TYPEID is unique for exact type (module, type token and type arguments for generic type instantiation).
+    struct type_id_hash
+    {
+        size_t operator()(const COR_TYPEID &id) const
+        {
+            return std::hash<uint64_t>()(id.token1) ^ (std::hash<uint64_t>()(id.token2) << 1);
+        }
+    };
+
+    struct type_id_equal
+    {
+        bool operator()(const COR_TYPEID &id1, const COR_TYPEID &id2) const
+        {
+            return id1.token1 == id2.token1 && id1.token2 == id2.token2;
+        }
+    };
+
     std::mutex m_typeObjectCacheMutex;
-    // Because handles affect the performance of the garbage collector, the debugger should limit itself to a relatively
-    // small number of handles (about 256) that are active at a time.
-    // https://docs.microsoft.com/en-us/dotnet/framework/unmanaged-api/debugging/icordebugheapvalue2-createhandle-method
-    // Note, we also use handles (results of eval) in var refs during brake (cleared at 'Continue').
-    // Warning! Since we use `std::prev(m_typeObjectCache.end())` without any check in code, make sure cache size is `2` or bigger.
-    static const size_t m_typeObjectCacheSize = 100;
+    size_t m_typeObjectCacheCapacity = DefaultTypeObjectCacheCapacity;
+    uint64_t m_typeObjectCacheHits = 0;
+    uint64_t m_typeObjectCacheMisses = 0;
     // The idea of cache is not hold all type objects, but prevent numerous times same type objects creation during eval.
     // At access, element moved to front of list, new element also add to front. In this way, not used elements displaced from cache.
     std::list<type_object_t> m_typeObjectCache;
+    // Index for list entries search by type id.
+    std::unordered_map<COR_TYPEID, std::list<type_object_t>::iterator, type_id_hash, type_id_equal> m_typeObjectCacheIndex;
 
     HRESULT TryReuseTypeObjectFromCache(ICorDebugType *pType, ICorDebugValue **ppTypeObjectResult);
     HRESULT AddTypeObjectToCache(ICorDebugType *pType, ICorDebugValue *pTypeObject);
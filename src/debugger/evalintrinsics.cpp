@@ -0,0 +1,1295 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/evalintrinsics.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include "debugger/valueprint.h"
+#include "metadata/wellknown_types.h"
+#include "utils/utf.h"
+
+namespace netcoredbg
+{
+
+namespace EvalIntrinsics
+{
+
+namespace // unnamed namespace
+{
+
+// Dictionary entries are scanned linearly (hash codes can't be calculated without debuggee code), so, lookup in big
+// dictionaries is delegated to evaluation.
+const int32_t DictionaryScanLimit = 10000;
+// Memory<T> and ReadOnlySequence<T> indexes have flags in high bit.
+const int32_t IndexFlagsMask = 0x7FFFFFFF;
+// ReadOnlySequence<T> segments are linked list provided by user code, don't walk it forever in case of broken list.
+const size_t SequenceSegmentsLimit = 1024;
+// Hash collections internal arrays are read from debuggee memory by chunks with this number of elements.
+const ULONG32 HashScanChunkSize = 4096;
+
+HRESULT GetExactClass(ICorDebugValue *pValue, ICorDebugType **ppType, ICorDebugClass **ppClass)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue2> iCorValue2;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugValue2, (LPVOID*) &iCorValue2));
+    IfFailRet(iCorValue2->GetExactType(ppType));
+    if (!*ppType)
+        return E_FAIL;
+    return (*ppType)->GetClass(ppClass);
+}
+
+HRESULT GetMetaData(ICorDebugClass *pClass, IMetaDataImport **ppMD, mdTypeDef &typeDef)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugModule> iCorModule;
+    IfFailRet(pClass->GetModule(&iCorModule));
+    IfFailRet(pClass->GetToken(&typeDef));
+    ToRelease<IUnknown> pMDUnknown;
+    IfFailRet(iCorModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+    return pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) ppMD);
+}
+
+HRESULT FindField(ICorDebugClass *pClass, const WCHAR *fieldName, mdFieldDef &fieldDef)
+{
+    HRESULT Status;
+    ToRelease<IMetaDataImport> pMD;
+    mdTypeDef typeDef = mdTypeDefNil;
+    IfFailRet(GetMetaData(pClass, &pMD, typeDef));
+    return pMD->FindField(typeDef, fieldName, nullptr, 0, &fieldDef);
+}
+
+// Note, pValue must be dereferenced and unboxed value.
+HRESULT GetFieldValue(ICorDebugValue *pValue, const WCHAR *fieldName, ICorDebugValue **ppFieldValue)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugType> iCorType;
+    ToRelease<ICorDebugClass> iCorClass;
+    IfFailRet(GetExactClass(pValue, &iCorType, &iCorClass));
+    mdFieldDef fieldDef = mdFieldDefNil;
+    IfFailRet(FindField(iCorClass, fieldName, fieldDef));
+    ToRelease<ICorDebugObjectValue> iCorObjectValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &iCorObjectValue));
+    return iCorObjectValue->GetFieldValue(iCorClass, fieldDef, ppFieldValue);
+}
+
+// Field could be declared by base class (for example, ReadOnlySequenceSegment<T> fields of user's segment class).
+HRESULT GetInheritedFieldValue(ICorDebugValue *pValue, const WCHAR *fieldName, ICorDebugValue **ppFieldValue)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugObjectValue> iCorObjectValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &iCorObjectValue));
+    ToRelease<ICorDebugValue2> iCorValue2;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugValue2, (LPVOID*) &iCorValue2));
+    ToRelease<ICorDebugType> iCorType;
+    IfFailRet(iCorValue2->GetExactType(&iCorType));
+
+    while (iCorType)
+    {
+        ToRelease<ICorDebugClass> iCorClass;
+        mdFieldDef fieldDef = mdFieldDefNil;
+        IfFailRet(iCorType->GetClass(&iCorClass));
+        if (SUCCEEDED(FindField(iCorClass, fieldName, fieldDef)))
+            return iCorObjectValue->GetFieldValue(iCorClass, fieldDef, ppFieldValue);
+
+        ToRelease<ICorDebugType> iCorBaseType;
+        if (FAILED(iCorType->GetBase(&iCorBaseType)))
+            return E_FAIL;
+        iCorType = iCorBaseType.Detach();
+    }
+
+    return E_FAIL;
+}
+
+HRESULT ReadInt32(ICorDebugValue *pValue, int32_t &result)
+{
+    HRESULT Status;
+    ULONG32 size = 0;
+    IfFailRet(pValue->GetSize(&size));
+    if (size != sizeof(int32_t))
+        return E_FAIL;
+    ToRelease<ICorDebugGenericValue> iCorGenericValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &iCorGenericValue));
+    return iCorGenericValue->GetValue(&result);
+}
+
+HRESULT ReadInt32Field(ICorDebugValue *pValue, const WCHAR *fieldName, int32_t &result)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> iCorFieldValue;
+    IfFailRet(GetFieldValue(pValue, fieldName, &iCorFieldValue));
+    return ReadInt32(iCorFieldValue, result);
+}
+
+HRESULT CreateInt32Value(ICorDebugThread *pThread, int32_t value, ICorDebugValue **ppValue)
+{
+    HRESULT Status;
+    if (!pThread)
+        return E_FAIL;
+    ToRelease<ICorDebugEval> iCorEval;
+    IfFailRet(pThread->CreateEval(&iCorEval));
+    IfFailRet(iCorEval->CreateValue(ELEMENT_TYPE_I4, nullptr, ppValue));
+    ToRelease<ICorDebugGenericValue> iCorGenericValue;
+    IfFailRet((*ppValue)->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &iCorGenericValue));
+    return iCorGenericValue->SetValue(&value);
+}
+
+HRESULT ReadString(ICorDebugValue *pValue, std::vector<WCHAR> &result)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugStringValue> iCorStringValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugStringValue, (LPVOID*) &iCorStringValue));
+    ULONG32 length = 0;
+    IfFailRet(iCorStringValue->GetLength(&length));
+    result.resize(length + 1); // one more for null terminator
+    ULONG32 fetched = 0;
+    IfFailRet(iCorStringValue->GetString(length + 1, &fetched, result.data()));
+    result.resize(fetched > length ? length : fetched);
+    return S_OK;
+}
+
+typedef HRESULT (*member_intrinsic_t)(ICorDebugThread *pThread, ICorDebugValue *pValue, ICorDebugValue **ppResultValue);
+
+HRESULT StringLength(ICorDebugThread *pThread, ICorDebugValue *pValue, ICorDebugValue **ppResultValue)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugStringValue> iCorStringValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugStringValue, (LPVOID*) &iCorStringValue));
+    ULONG32 length = 0;
+    IfFailRet(iCorStringValue->GetLength(&length));
+    return CreateInt32Value(pThread, (int32_t)length, ppResultValue);
+}
+
+HRESULT NullableHasValue(ICorDebugThread *, ICorDebugValue *pValue, ICorDebugValue **ppResultValue)
+{
+    return GetFieldValue(pValue, W("hasValue"), ppResultValue);
+}
+
+HRESULT NullableValue(ICorDebugThread *, ICorDebugValue *pValue, ICorDebugValue **ppResultValue)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> iCorHasValue;
+    IfFailRet(GetFieldValue(pValue, W("hasValue"), &iCorHasValue));
+    ToRelease<ICorDebugGenericValue> iCorGenericValue;
+    IfFailRet(iCorHasValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &iCorGenericValue));
+    uint8_t hasValue = 0;
+    IfFailRet(iCorGenericValue->GetValue(&hasValue));
+    // Note, InvalidOperationException must be thrown by debuggee code.
+    if (!hasValue)
+        return S_FALSE;
+    return GetFieldValue(pValue, W("value"), ppResultValue);
+}
+
+HRESULT ListCount(ICorDebugThread *, ICorDebugValue *pValue, ICorDebugValue **ppResultValue)
+{
+    return GetFieldValue(pValue, W("_size"), ppResultValue);
+}
+
+HRESULT DictionaryCount(ICorDebugThread *pThread, ICorDebugValue *pValue, ICorDebugValue **ppResultValue)
+{
+    HRESULT Status;
+    int32_t count = 0;
+    int32_t freeCount = 0;
+    IfFailRet(ReadInt32Field(pValue, W("_count"), count));
+    IfFailRet(ReadInt32Field(pValue, W("_freeCount"), freeCount));
+    return CreateInt32Value(pThread, count - freeCount, ppResultValue);
+}
+
+HRESULT SpanLength(ICorDebugThread *, ICorDebugValue *pValue, ICorDebugValue **ppResultValue)
+{
+    return GetFieldValue(pValue, W("_length"), ppResultValue);
+}
+
+struct member_entry_t
+{
+    WellKnownTypes::Type type;
+    const char *name;
+    member_intrinsic_t intrinsic;
+};
+
+const member_entry_t memberIntrinsics[] = {
+    {WellKnownTypes::Type::String,       "Length",   StringLength},
+    {WellKnownTypes::Type::Nullable,     "HasValue", NullableHasValue},
+    {WellKnownTypes::Type::Nullable,     "Value",    NullableValue},
+    {WellKnownTypes::Type::List,         "Count",    ListCount},
+    {WellKnownTypes::Type::Dictionary,   "Count",    DictionaryCount},
+    {WellKnownTypes::Type::Span,         "Length",   SpanLength},
+    {WellKnownTypes::Type::ReadOnlySpan, "Length",   SpanLength}
+};
+
+HRESULT ListElement(ICorDebugValue *pValue, ICorDebugValue *pIndexValue, ICorDebugValue **ppResultValue)
+{
+    HRESULT Status;
+    CorElementType indexType;
+    int32_t index = 0;
+    int32_t size = 0;
+    IfFailRet(pIndexValue->GetType(&indexType));
+    if (indexType != ELEMENT_TYPE_I4)
+        return S_FALSE;
+    IfFailRet(ReadInt32(pIndexValue, index));
+    IfFailRet(ReadInt32Field(pValue, W("_size"), size));
+    // Note, ArgumentOutOfRangeException must be thrown by debuggee code.
+    if (index < 0 || index >= size)
+        return S_FALSE;
+
+    ToRelease<ICorDebugValue> iCorItems;
+    ToRelease<ICorDebugValue> iCorItemsValue;
+    BOOL isNull = FALSE;
+    IfFailRet(GetFieldValue(pValue, W("_items"), &iCorItems));
+    IfFailRet(DereferenceAndUnboxValue(iCorItems, &iCorItemsValue, &isNull));
+    if (isNull)
+        return S_FALSE;
+    ToRelease<ICorDebugArrayValue> iCorArrayValue;
+    IfFailRet(iCorItemsValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID*) &iCorArrayValue));
+    return iCorArrayValue->GetElementAtPosition((ULONG32)index, ppResultValue);
+}
+
+// Note, in .NET Core 3.0+ dictionary with value type keys and default comparer have null `_comparer` field.
+// For string keys default comparers are ordinal comparers nested into NonRandomizedStringEqualityComparer.
+bool IsDefaultComparer(ICorDebugValue *pComparer, bool stringKey)
+{
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> iCorComparerValue;
+    if (FAILED(DereferenceAndUnboxValue(pComparer, &iCorComparerValue, &isNull)))
+        return false;
+    if (isNull)
+        return true;
+    if (!stringKey)
+        return false;
+
+    ToRelease<ICorDebugType> iCorType;
+    ToRelease<ICorDebugClass> iCorClass;
+    ToRelease<IMetaDataImport> pMD;
+    mdTypeDef typeDef = mdTypeDefNil;
+    mdTypeDef enclosingClass = mdTypeDefNil;
+    WCHAR name[mdNameLen] = {0};
+    WCHAR enclosingName[mdNameLen] = {0};
+    ULONG nameLen = 0;
+    if (FAILED(GetExactClass(iCorComparerValue, &iCorType, &iCorClass)) ||
+        FAILED(GetMetaData(iCorClass, &pMD, typeDef)) ||
+        FAILED(pMD->GetTypeDefProps(typeDef, name, _countof(name), &nameLen, nullptr, nullptr)) ||
+        FAILED(pMD->GetNestedClassProps(typeDef, &enclosingClass)) ||
+        FAILED(pMD->GetTypeDefProps(enclosingClass, enclosingName, _countof(enclosingName), &nameLen, nullptr, nullptr)))
+        return false;
+
+    const std::string comparerName = to_utf8(name);
+    return to_utf8(enclosingName) == "System.Collections.Generic.NonRandomizedStringEqualityComparer" &&
+           (comparerName == "OrdinalComparer" || comparerName == "WrappedAroundDefaultComparer");
+}
+
+// Return S_OK in case keys are equal, S_FALSE in case not equal.
+HRESULT CompareKeys(ICorDebugValue *pKey, CorElementType keyType, ICorDebugValue *pEntryKey)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> iCorEntryKey;
+    IfFailRet(DereferenceAndUnboxValue(pEntryKey, &iCorEntryKey, &isNull));
+    if (isNull)
+        return S_FALSE;
+
+    CorElementType entryKeyType;
+    IfFailRet(iCorEntryKey->GetType(&entryKeyType));
+    if (entryKeyType != keyType)
+        return E_FAIL;
+
+    if (keyType == ELEMENT_TYPE_STRING)
+    {
+        std::vector<WCHAR> key;
+        std::vector<WCHAR> entryKey;
+        IfFailRet(ReadString(pKey, key));
+        IfFailRet(ReadString(iCorEntryKey, entryKey));
+        return key == entryKey ? S_OK : S_FALSE;
+    }
+
+    ULONG32 size = 0;
+    ULONG32 entrySize = 0;
+    uint64_t data = 0;
+    uint64_t entryData = 0;
+    IfFailRet(pKey->GetSize(&size));
+    IfFailRet(iCorEntryKey->GetSize(&entrySize));
+    if (size != entrySize || size > sizeof(data))
+        return E_FAIL;
+
+    ToRelease<ICorDebugGenericValue> iCorGenericValue;
+    ToRelease<ICorDebugGenericValue> iCorEntryGenericValue;
+    IfFailRet(pKey->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &iCorGenericValue));
+    IfFailRet(iCorEntryKey->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &iCorEntryGenericValue));
+    IfFailRet(iCorGenericValue->GetValue(&data));
+    IfFailRet(iCorEntryGenericValue->GetValue(&entryData));
+    return memcmp(&data, &entryData, size) == 0 ? S_OK : S_FALSE;
+}
+
+HRESULT DictionaryElement(ICorDebugValue *pValue, ICorDebugValue *pKeyValue, ICorDebugValue **ppResultValue)
+{
+    HRESULT Status;
+    CorElementType keyType;
+    IfFailRet(pKeyValue->GetType(&keyType));
+    // Note, floating point keys can't be compared bitwise (NaN and negative zero), value types use Equals() override.
+    switch (keyType)
+    {
+        case ELEMENT_TYPE_BOOLEAN: case ELEMENT_TYPE_CHAR:
+        case ELEMENT_TYPE_I1: case ELEMENT_TYPE_U1: case ELEMENT_TYPE_I2: case ELEMENT_TYPE_U2:
+        case ELEMENT_TYPE_I4: case ELEMENT_TYPE_U4: case ELEMENT_TYPE_I8: case ELEMENT_TYPE_U8:
+        case ELEMENT_TYPE_I: case ELEMENT_TYPE_U: case ELEMENT_TYPE_STRING:
+            break;
+        default:
+            return S_FALSE;
+    }
+
+    ToRelease<ICorDebugValue> iCorComparer;
+    if (FAILED(GetFieldValue(pValue, W("_comparer"), &iCorComparer)) ||
+        !IsDefaultComparer(iCorComparer, keyType == ELEMENT_TYPE_STRING))
+        return S_FALSE;
+
+    int32_t count = 0;
+    IfFailRet(ReadInt32Field(pValue, W("_count"), count));
+    if (count > DictionaryScanLimit)
+        return S_FALSE;
+
+    ToRelease<ICorDebugValue> iCorEntries;
+    ToRelease<ICorDebugValue> iCorEntriesValue;
+    BOOL isNull = FALSE;
+    IfFailRet(GetFieldValue(pValue, W("_entries"), &iCorEntries));
+    IfFailRet(DereferenceAndUnboxValue(iCorEntries, &iCorEntriesValue, &isNull));
+    if (isNull)
+        return S_FALSE; // empty dictionary, KeyNotFoundException must be thrown by debuggee code
+
+    ToRelease<ICorDebugArrayValue> iCorArrayValue;
+    ULONG32 entriesCount = 0;
+    IfFailRet(iCorEntriesValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID*) &iCorArrayValue));
+    IfFailRet(iCorArrayValue->GetCount(&entriesCount));
+    if ((ULONG32)count > entriesCount)
+        return E_FAIL;
+
+    ToRelease<ICorDebugType> iCorArrayType;
+    ToRelease<ICorDebugType> iCorEntryType;
+    ToRelease<ICorDebugClass> iCorEntryClass;
+    mdFieldDef hashCodeField = mdFieldDefNil;
+    mdFieldDef nextField = mdFieldDefNil;
+    mdFieldDef keyField = mdFieldDefNil;
+    mdFieldDef valueField = mdFieldDefNil;
+    ToRelease<ICorDebugValue2> iCorValue2;
+    IfFailRet(iCorEntriesValue->QueryInterface(IID_ICorDebugValue2, (LPVOID*) &iCorValue2));
+    IfFailRet(iCorValue2->GetExactType(&iCorArrayType));
+    IfFailRet(iCorArrayType->GetFirstTypeParameter(&iCorEntryType));
+    IfFailRet(iCorEntryType->GetClass(&iCorEntryClass));
+    IfFailRet(FindField(iCorEntryClass, W("hashCode"), hashCodeField));
+    IfFailRet(FindField(iCorEntryClass, W("next"), nextField));
+    IfFailRet(FindField(iCorEntryClass, W("key"), keyField));
+    IfFailRet(FindField(iCorEntryClass, W("value"), valueField));
+
+    for (int32_t i = 0; i < count; i++)
+    {
+        ToRelease<ICorDebugValue> iCorEntry;
+        ToRelease<ICorDebugObjectValue> iCorEntryObject;
+        IfFailRet(iCorArrayValue->GetElementAtPosition((ULONG32)i, &iCorEntry));
+        IfFailRet(iCorEntry->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &iCorEntryObject));
+
+        // Note, free list entries have `next` field less than -1 (.NET Core 3.0+), .NET Core 2.x use negative hash code.
+        ToRelease<ICorDebugValue> iCorNext;
+        ToRelease<ICorDebugValue> iCorHashCode;
+        int32_t next = 0;
+        int32_t hashCode = 0;
+        CorElementType hashCodeType;
+        IfFailRet(iCorEntryObject->GetFieldValue(iCorEntryClass, nextField, &iCorNext));
+        IfFailRet(ReadInt32(iCorNext, next));
+        IfFailRet(iCorEntryObject->GetFieldValue(iCorEntryClass, hashCodeField, &iCorHashCode));
+        IfFailRet(iCorHashCode->GetType(&hashCodeType));
+        IfFailRet(ReadInt32(iCorHashCode, hashCode));
+        if (next < -1 || (hashCodeType == ELEMENT_TYPE_I4 && hashCode < 0))
+            continue;
+
+        ToRelease<ICorDebugValue> iCorKey;
+        IfFailRet(iCorEntryObject->GetFieldValue(iCorEntryClass, keyField, &iCorKey));
+        IfFailRet(Status = CompareKeys(pKeyValue, keyType, iCorKey));
+        if (Status == S_OK)
+            return iCorEntryObject->GetFieldValue(iCorEntryClass, valueField, ppResultValue);
+    }
+
+    return S_FALSE; // KeyNotFoundException must be thrown by debuggee code
+}
+
+bool IsReferenceType(CorElementType elementType)
+{
+    return elementType == ELEMENT_TYPE_CLASS || elementType == ELEMENT_TYPE_STRING || elementType == ELEMENT_TYPE_OBJECT ||
+           elementType == ELEMENT_TYPE_SZARRAY || elementType == ELEMENT_TYPE_ARRAY;
+}
+
+// Note, types declared outside of System.Private.CoreLib (or moved between assemblies in different .NET versions)
+// are checked by name, return empty string in case of error.
+std::string GetClassName(ICorDebugClass *pClass)
+{
+    ToRelease<IMetaDataImport> pMD;
+    mdTypeDef typeDef = mdTypeDefNil;
+    WCHAR name[mdNameLen] = {0};
+    ULONG nameLen = 0;
+    if (FAILED(GetMetaData(pClass, &pMD, typeDef)) ||
+        FAILED(pMD->GetTypeDefProps(typeDef, name, _countof(name), &nameLen, nullptr, nullptr)))
+        return std::string();
+
+    return to_utf8(name);
+}
+
+enum class ViewKind
+{
+    None,
+    Span,
+    Memory,
+    ArraySegment,
+    Sequence,
+    Queue,
+    Stack
+};
+
+ViewKind GetViewKind(CorElementType corType, ICorDebugType *pType, ICorDebugClass *pClass)
+{
+    if (corType == ELEMENT_TYPE_VALUETYPE)
+    {
+        if (WellKnownTypes::IsType(pType, WellKnownTypes::Type::Span) ||
+            WellKnownTypes::IsType(pType, WellKnownTypes::Type::ReadOnlySpan))
+            return ViewKind::Span;
+        if (WellKnownTypes::IsType(pType, WellKnownTypes::Type::Memory) ||
+            WellKnownTypes::IsType(pType, WellKnownTypes::Type::ReadOnlyMemory))
+            return ViewKind::Memory;
+        if (WellKnownTypes::IsType(pType, WellKnownTypes::Type::ArraySegment))
+            return ViewKind::ArraySegment;
+        if (GetClassName(pClass) == "System.Buffers.ReadOnlySequence`1")
+            return ViewKind::Sequence;
+    }
+    else
+    {
+        const std::string name = GetClassName(pClass);
+        if (name == "System.Collections.Generic.Queue`1")
+            return ViewKind::Queue;
+        if (name == "System.Collections.Generic.Stack`1")
+            return ViewKind::Stack;
+    }
+
+    return ViewKind::None;
+}
+
+// Add chunk for part of array or string (owner could be null reference in case of empty view).
+// Return S_FALSE in case owner is not array or string (for example, MemoryManager<T>).
+HRESULT AddOwnerChunk(ICorDebugValue *pOwner, int64_t offset, int64_t length, ElementsView &view, bool reversed = false)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> iCorOwner;
+    IfFailRet(DereferenceAndUnboxValue(pOwner, &iCorOwner, &isNull));
+    if (isNull)
+        return length == 0 ? S_OK : E_FAIL;
+
+    CorElementType ownerType;
+    ULONG32 count = 0;
+    IfFailRet(iCorOwner->GetType(&ownerType));
+    if (ownerType == ELEMENT_TYPE_SZARRAY)
+    {
+        ToRelease<ICorDebugArrayValue> iCorArrayValue;
+        IfFailRet(iCorOwner->QueryInterface(IID_ICorDebugArrayValue, (LPVOID*) &iCorArrayValue));
+        IfFailRet(iCorArrayValue->GetCount(&count));
+    }
+    else if (ownerType == ELEMENT_TYPE_STRING)
+    {
+        ToRelease<ICorDebugStringValue> iCorStringValue;
+        IfFailRet(iCorOwner->QueryInterface(IID_ICorDebugStringValue, (LPVOID*) &iCorStringValue));
+        IfFailRet(iCorStringValue->GetLength(&count));
+    }
+    else
+        return S_FALSE;
+
+    if (offset < 0 || length < 0 || offset + length > count || view.length + length > INT32_MAX)
+        return E_FAIL;
+    if (length == 0)
+        return S_OK;
+
+    view.chunks.emplace_back();
+    ElementsView::Chunk &chunk = view.chunks.back();
+    chunk.owner = iCorOwner.Detach();
+    chunk.offset = (ULONG32)offset;
+    chunk.length = (ULONG32)length;
+    chunk.reversed = reversed;
+    view.length += (ULONG32)length;
+    return S_OK;
+}
+
+// Queue<T> fields: `_array` (circular buffer), `_head` and `_size`.
+HRESULT AddQueueChunks(ICorDebugValue *pQueue, ElementsView &view)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> iCorArray;
+    int32_t head = 0;
+    int32_t size = 0;
+    IfFailRet(GetFieldValue(pQueue, W("_array"), &iCorArray));
+    IfFailRet(ReadInt32Field(pQueue, W("_head"), head));
+    IfFailRet(ReadInt32Field(pQueue, W("_size"), size));
+    if (size == 0)
+        return S_OK;
+
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> iCorArrayValue;
+    ToRelease<ICorDebugArrayValue> iCorArray2;
+    ULONG32 arrayLength = 0;
+    IfFailRet(DereferenceAndUnboxValue(iCorArray, &iCorArrayValue, &isNull));
+    if (isNull)
+        return E_FAIL;
+    IfFailRet(iCorArrayValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID*) &iCorArray2));
+    IfFailRet(iCorArray2->GetCount(&arrayLength));
+    if (head < 0 || size < 0 || (ULONG32)head >= arrayLength || (ULONG32)size > arrayLength)
+        return E_FAIL;
+
+    const int64_t first = std::min<int64_t>(size, int64_t(arrayLength) - head);
+    IfFailRet(AddOwnerChunk(iCorArrayValue, head, first, view));
+    return AddOwnerChunk(iCorArrayValue, 0, size - first, view);
+}
+
+// Stack<T> fields: `_array` and `_size`, items are provided from top of stack (same as enumerator do).
+HRESULT AddStackChunk(ICorDebugValue *pStack, ElementsView &view)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> iCorArray;
+    int32_t size = 0;
+    IfFailRet(GetFieldValue(pStack, W("_array"), &iCorArray));
+    IfFailRet(ReadInt32Field(pStack, W("_size"), size));
+    return AddOwnerChunk(iCorArray, 0, size, view, true);
+}
+
+// Memory<T> and ReadOnlyMemory<T> fields: `_object` (array, string or MemoryManager<T>), `_index` and `_length`.
+// Note, `skip` and `limit` (or -1) are range of memory elements, that should be added to view.
+HRESULT AddMemoryChunk(ICorDebugValue *pMemory, int32_t skip, int32_t limit, ElementsView &view)
+{
+    HRESULT Status;
+    int32_t index = 0;
+    int32_t length = 0;
+    IfFailRet(ReadInt32Field(pMemory, W("_index"), index));
+    IfFailRet(ReadInt32Field(pMemory, W("_length"), length));
+    index &= IndexFlagsMask;
+    if (limit >= 0 && limit < length)
+        length = limit;
+    if (skip < 0 || skip > length)
+        return E_FAIL;
+
+    ToRelease<ICorDebugValue> iCorObject;
+    IfFailRet(GetFieldValue(pMemory, W("_object"), &iCorObject));
+    return AddOwnerChunk(iCorObject, int64_t(index) + skip, int64_t(length) - skip, view);
+}
+
+// Span<T> and ReadOnlySpan<T> first element address: `ref T _reference` field (.NET 7+) or `ByReference<T> _pointer`
+// field with IntPtr `_value` field (.NET Core 2.1 - .NET 6).
+HRESULT ReadSpanAddress(ICorDebugValue *pSpan, CORDB_ADDRESS &address, ULONG32 &pointerSize)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> iCorField;
+    if (SUCCEEDED(GetFieldValue(pSpan, W("_reference"), &iCorField)))
+    {
+        ToRelease<ICorDebugReferenceValue> iCorReferenceValue;
+        IfFailRet(iCorField->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &iCorReferenceValue));
+        IfFailRet(iCorField->GetSize(&pointerSize));
+        return iCorReferenceValue->GetValue(&address);
+    }
+
+    ToRelease<ICorDebugValue> iCorPointer;
+    IfFailRet(GetFieldValue(pSpan, W("_pointer"), &iCorPointer));
+    IfFailRet(GetFieldValue(iCorPointer, W("_value"), &iCorField));
+    IfFailRet(iCorField->GetSize(&pointerSize));
+    if (pointerSize != sizeof(uint32_t) && pointerSize != sizeof(uint64_t))
+        return E_FAIL;
+
+    ToRelease<ICorDebugGenericValue> iCorGenericValue;
+    IfFailRet(iCorField->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &iCorGenericValue));
+    uint64_t value = 0;
+    IfFailRet(iCorGenericValue->GetValue(&value));
+    address = pointerSize == sizeof(uint32_t) ? CORDB_ADDRESS(uint32_t(value)) : CORDB_ADDRESS(value);
+    return S_OK;
+}
+
+HRESULT AddSpanChunk(ICorDebugValue *pSpan, ElementsView &view)
+{
+    HRESULT Status;
+    CORDB_ADDRESS address = 0;
+    ULONG32 pointerSize = 0;
+    int32_t length = 0;
+    IfFailRet(ReadSpanAddress(pSpan, address, pointerSize));
+    IfFailRet(ReadInt32Field(pSpan, W("_length"), length));
+    if (IsReferenceType(view.elementType))
+        view.elementSize = pointerSize;
+    // Note, elements of value types can't be provided, since ICorDebugValue can't be created for memory address.
+    if (view.elementSize == 0)
+        return S_FALSE;
+    if (length < 0 || (length > 0 && address == 0))
+        return E_FAIL;
+    if (length == 0)
+        return S_OK;
+
+    view.chunks.emplace_back();
+    ElementsView::Chunk &chunk = view.chunks.back();
+    chunk.address = address;
+    chunk.length = (ULONG32)length;
+    view.length = (ULONG32)length;
+    return S_OK;
+}
+
+// ReadOnlySequence<T> fields: `_startObject` and `_endObject` (array, string, MemoryManager<T> or first and last
+// ReadOnlySequenceSegment<T>), `_startInteger` and `_endInteger` (indexes in start and end objects with flags in high bits).
+HRESULT AddSequenceChunks(ICorDebugValue *pSequence, ElementsView &view)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> iCorStartObject;
+    ToRelease<ICorDebugValue> iCorEndObject;
+    int32_t startIndex = 0;
+    int32_t endIndex = 0;
+    IfFailRet(GetFieldValue(pSequence, W("_startObject"), &iCorStartObject));
+    IfFailRet(GetFieldValue(pSequence, W("_endObject"), &iCorEndObject));
+    IfFailRet(ReadInt32Field(pSequence, W("_startInteger"), startIndex));
+    IfFailRet(ReadInt32Field(pSequence, W("_endInteger"), endIndex));
+    startIndex &= IndexFlagsMask;
+    endIndex &= IndexFlagsMask;
+
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> iCorSegment;
+    IfFailRet(DereferenceAndUnboxValue(iCorStartObject, &iCorSegment, &isNull));
+    if (isNull)
+        return S_OK; // default (empty) sequence
+
+    CorElementType startType;
+    IfFailRet(iCorSegment->GetType(&startType));
+    if (startType == ELEMENT_TYPE_SZARRAY || startType == ELEMENT_TYPE_STRING)
+        return AddOwnerChunk(iCorSegment, startIndex, int64_t(endIndex) - startIndex, view);
+
+    ToRelease<ICorDebugValue> iCorEndSegment;
+    CORDB_ADDRESS endAddress = 0;
+    IfFailRet(DereferenceAndUnboxValue(iCorEndObject, &iCorEndSegment, &isNull));
+    if (isNull)
+        return E_FAIL;
+    IfFailRet(iCorEndSegment->GetAddress(&endAddress));
+
+    for (size_t i = 0; i < SequenceSegmentsLimit; i++)
+    {
+        CORDB_ADDRESS address = 0;
+        IfFailRet(iCorSegment->GetAddress(&address));
+        const bool last = address == endAddress;
+
+        // Note, MemoryManager<T> have no segment fields, so, sequence created from MemoryManager<T> is not supported.
+        ToRelease<ICorDebugValue> iCorMemory;
+        if (FAILED(GetInheritedFieldValue(iCorSegment, W("<Memory>k__BackingField"), &iCorMemory)))
+            return S_FALSE;
+        IfFailRet(Status = AddMemoryChunk(iCorMemory, i == 0 ? startIndex : 0, last ? endIndex : -1, view));
+        if (Status == S_FALSE || last)
+            return Status;
+
+        ToRelease<ICorDebugValue> iCorNext;
+        IfFailRet(GetInheritedFieldValue(iCorSegment, W("<Next>k__BackingField"), &iCorNext));
+        iCorSegment.Free();
+        IfFailRet(DereferenceAndUnboxValue(iCorNext, &iCorSegment, &isNull));
+        if (isNull)
+            return E_FAIL;
+    }
+
+    return S_FALSE;
+}
+
+enum class HashKind
+{
+    None,
+    Dictionary,
+    HashSet,
+    ConcurrentDictionary
+};
+
+// Return S_FALSE in case value is not hash collection.
+HRESULT GetHashCollection(ICorDebugValue *pInputValue, ICorDebugValue **ppValue, ICorDebugClass **ppClass, HashKind &kind)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> iCorValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &iCorValue, &isNull));
+    if (isNull)
+        return S_FALSE;
+
+    CorElementType corType;
+    IfFailRet(iCorValue->GetType(&corType));
+    if (corType != ELEMENT_TYPE_CLASS)
+        return S_FALSE;
+
+    ToRelease<ICorDebugType> iCorType;
+    ToRelease<ICorDebugClass> iCorClass;
+    ToRelease<ICorDebugType> iCorKeyType;
+    IfFailRet(GetExactClass(iCorValue, &iCorType, &iCorClass));
+    if (FAILED(iCorType->GetFirstTypeParameter(&iCorKeyType)) || !iCorKeyType)
+        return S_FALSE;
+
+    if (WellKnownTypes::IsType(iCorType, WellKnownTypes::Type::Dictionary))
+        kind = HashKind::Dictionary;
+    else
+    {
+        // Note, HashSet<T> is System.Collections.dll type in .NET Core 3.1 and older.
+        const std::string name = GetClassName(iCorClass);
+        if (name == "System.Collections.Generic.HashSet`1")
+            kind = HashKind::HashSet;
+        else if (name == "System.Collections.Concurrent.ConcurrentDictionary`2")
+            kind = HashKind::ConcurrentDictionary;
+        else
+            return S_FALSE;
+    }
+
+    *ppValue = iCorValue.Detach();
+    *ppClass = iCorClass.Detach();
+    return S_OK;
+}
+
+HRESULT GetProcess(ICorDebugClass *pClass, ICorDebugProcess **ppProcess)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugModule> iCorModule;
+    IfFailRet(pClass->GetModule(&iCorModule));
+    return iCorModule->GetProcess(ppProcess);
+}
+
+// Dictionary<TKey,TValue> and HashSet<T> items are stored in entries array, removed items entries are linked into free list.
+struct hash_entries_t
+{
+    ToRelease<ICorDebugProcess> process;
+    ToRelease<ICorDebugArrayValue> entries;
+    ToRelease<ICorDebugClass> entryClass;
+    mdFieldDef keyField = mdFieldDefNil;   // HashSet<T> item
+    mdFieldDef valueField = mdFieldDefNil; // Dictionary<TKey,TValue> only
+    mdFieldDef nextField = mdFieldDefNil;
+    mdFieldDef hashCodeField = mdFieldDefNil;
+    // Free entries have negative `hashCode` in .NET Core 3.1 and older (`next` less than -1 in newer versions).
+    bool checkHashCode = false;
+    ULONG32 used = 0;  // entries in [0, used) range are items or free entries
+    ULONG32 count = 0; // items count
+};
+
+HRESULT FindEntryField(ICorDebugClass *pClass, const WCHAR *name, const WCHAR *altName, mdFieldDef &fieldDef)
+{
+    if (SUCCEEDED(FindField(pClass, name, fieldDef)))
+        return S_OK;
+    return FindField(pClass, altName, fieldDef);
+}
+
+// Dictionary<TKey,TValue> fields: `_entries` (entries with `key`, `value`, `next` and `hashCode` fields), `_count` and `_freeCount`.
+// HashSet<T> fields: same as Dictionary<TKey,TValue>, but entries have `Value`, `Next` and `HashCode` fields (.NET 5+), or
+// `_slots` (slots with `value`, `next` and `hashCode` fields), `_lastIndex` and `_count` (.NET Core 3.1 and older).
+HRESULT GetHashEntries(ICorDebugValue *pValue, ICorDebugClass *pClass, HashKind kind, hash_entries_t &hash)
+{
+    HRESULT Status;
+    int32_t used = 0;
+    int32_t count = 0;
+    ToRelease<ICorDebugValue> iCorEntries;
+    if (SUCCEEDED(GetFieldValue(pValue, W("_entries"), &iCorEntries)))
+    {
+        int32_t freeCount = 0;
+        IfFailRet(ReadInt32Field(pValue, W("_count"), used));
+        IfFailRet(ReadInt32Field(pValue, W("_freeCount"), freeCount));
+        count = used - freeCount;
+    }
+    else
+    {
+        if (kind != HashKind::HashSet || FAILED(GetFieldValue(pValue, W("_slots"), &iCorEntries)))
+            return S_FALSE;
+        IfFailRet(ReadInt32Field(pValue, W("_lastIndex"), used));
+        IfFailRet(ReadInt32Field(pValue, W("_count"), count));
+    }
+    if (used < 0 || count < 0 || count > used)
+        return E_FAIL;
+
+    hash.used = (ULONG32)used;
+    hash.count = (ULONG32)count;
+    if (used == 0)
+        return S_OK;
+
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> iCorEntriesValue;
+    IfFailRet(DereferenceAndUnboxValue(iCorEntries, &iCorEntriesValue, &isNull));
+    if (isNull)
+        return E_FAIL;
+    IfFailRet(iCorEntriesValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID*) &hash.entries));
+    ULONG32 entriesCount = 0;
+    IfFailRet(hash.entries->GetCount(&entriesCount));
+    if (hash.used > entriesCount)
+        return E_FAIL;
+
+    ToRelease<ICorDebugValue2> iCorValue2;
+    ToRelease<ICorDebugType> iCorArrayType;
+    ToRelease<ICorDebugType> iCorEntryType;
+    IfFailRet(iCorEntriesValue->QueryInterface(IID_ICorDebugValue2, (LPVOID*) &iCorValue2));
+    IfFailRet(iCorValue2->GetExactType(&iCorArrayType));
+    IfFailRet(iCorArrayType->GetFirstTypeParameter(&iCorEntryType));
+    IfFailRet(iCorEntryType->GetClass(&hash.entryClass));
+    if (kind == HashKind::Dictionary)
+    {
+        IfFailRet(FindField(hash.entryClass, W("key"), hash.keyField));
+        IfFailRet(FindField(hash.entryClass, W("value"), hash.valueField));
+    }
+    else
+        IfFailRet(FindEntryField(hash.entryClass, W("Value"), W("value"), hash.keyField));
+    IfFailRet(FindEntryField(hash.entryClass, W("next"), W("Next"), hash.nextField));
+    hash.checkHashCode = SUCCEEDED(FindField(hash.entryClass, W("hashCode"), hash.hashCodeField));
+
+    return GetProcess(pClass, &hash.process);
+}
+
+// Call `cb` for entries positions of items with index in [start, end) range. In case collection have free entries,
+// `next` and `hashCode` fields of entries are read from debuggee memory by chunks (fields offsets are calculated
+// from first entry fields addresses), so, items before `start` are skipped without ICorDebugValue creation.
+HRESULT ForEachUsedEntry(const hash_entries_t &hash, ULONG32 start, ULONG32 end, const std::function<HRESULT(ULONG32)> &cb)
+{
+    HRESULT Status;
+    end = std::min(end, hash.count);
+    if (start >= end)
+        return S_OK;
+
+    if (hash.count == hash.used)
+    {
+        for (ULONG32 i = start; i < end; i++)
+        {
+            IfFailRet(cb(i));
+        }
+        return S_OK;
+    }
+
+    ToRelease<ICorDebugValue> iCorEntry;
+    ToRelease<ICorDebugObjectValue> iCorEntryObject;
+    CORDB_ADDRESS entryAddress = 0;
+    ULONG32 entrySize = 0;
+    IfFailRet(hash.entries->GetElementAtPosition(0, &iCorEntry));
+    IfFailRet(iCorEntry->GetAddress(&entryAddress));
+    IfFailRet(iCorEntry->GetSize(&entrySize));
+    IfFailRet(iCorEntry->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &iCorEntryObject));
+
+    // Note, `hashCode` is `uint` in .NET 5+ Dictionary<TKey,TValue>, only signed `hashCode` is used for free entries check.
+    auto getFieldOffset = [&](mdFieldDef fieldDef, ULONG32 &offset) -> HRESULT
+    {
+        ToRelease<ICorDebugValue> iCorField;
+        CorElementType fieldType;
+        CORDB_ADDRESS fieldAddress = 0;
+        ULONG32 fieldSize = 0;
+        IfFailRet(iCorEntryObject->GetFieldValue(hash.entryClass, fieldDef, &iCorField));
+        IfFailRet(iCorField->GetType(&fieldType));
+        IfFailRet(iCorField->GetAddress(&fieldAddress));
+        IfFailRet(iCorField->GetSize(&fieldSize));
+        if (fieldType != ELEMENT_TYPE_I4 || fieldSize != sizeof(int32_t) ||
+            fieldAddress < entryAddress || fieldAddress + fieldSize > entryAddress + entrySize)
+            return E_FAIL;
+        offset = ULONG32(fieldAddress - entryAddress);
+        return S_OK;
+    };
+    ULONG32 nextOffset = 0;
+    ULONG32 hashCodeOffset = 0;
+    IfFailRet(getFieldOffset(hash.nextField, nextOffset));
+    const bool checkHashCode = hash.checkHashCode && SUCCEEDED(getFieldOffset(hash.hashCodeField, hashCodeOffset));
+
+    std::vector<BYTE> buffer;
+    ULONG32 index = 0;
+    for (ULONG32 chunkStart = 0; chunkStart < hash.used; chunkStart += HashScanChunkSize)
+    {
+        const ULONG32 chunkCount = std::min(HashScanChunkSize, hash.used - chunkStart);
+        buffer.resize(size_t(chunkCount) * entrySize);
+        SIZE_T read = 0;
+        IfFailRet(hash.process->ReadMemory(entryAddress + CORDB_ADDRESS(chunkStart) * entrySize, (DWORD)buffer.size(),
+                                           buffer.data(), &read));
+        if (read != buffer.size())
+            return E_FAIL;
+
+        for (ULONG32 i = 0; i < chunkCount; i++)
+        {
+            const BYTE *entry = &buffer[size_t(i) * entrySize];
+            int32_t next = 0;
+            int32_t hashCode = 0;
+            memcpy(&next, entry + nextOffset, sizeof(next));
+            if (checkHashCode)
+                memcpy(&hashCode, entry + hashCodeOffset, sizeof(hashCode));
+            if (next < -1 || hashCode < 0)
+                continue;
+
+            if (index >= start)
+                IfFailRet(cb(chunkStart + i));
+            if (++index >= end)
+                return S_OK;
+        }
+    }
+
+    return S_OK;
+}
+
+// ConcurrentDictionary<TKey,TValue> items are stored in `_tables._buckets` nodes chains (buckets are `VolatileNode` with
+// `_node` field in .NET 7+), nodes have `_key`, `_value` and `_next` fields, count is sum of `_tables._countPerLock`.
+HRESULT GetConcurrentTables(ICorDebugValue *pValue, ICorDebugValue **ppTables)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> iCorTables;
+    BOOL isNull = FALSE;
+    IfFailRet(GetFieldValue(pValue, W("_tables"), &iCorTables));
+    IfFailRet(DereferenceAndUnboxValue(iCorTables, ppTables, &isNull));
+    return isNull ? E_FAIL : S_OK;
+}
+
+HRESULT GetConcurrentCount(ICorDebugProcess *pProcess, ICorDebugValue *pTables, ULONG32 &count)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> iCorCountPerLock;
+    IfFailRet(GetFieldValue(pTables, W("_countPerLock"), &iCorCountPerLock));
+    CorElementType elementType = ELEMENT_TYPE_END;
+    std::vector<BYTE> data;
+    IfFailRet(ReadPrimitiveArrayElements(pProcess, iCorCountPerLock, 0, UINT32_MAX, elementType, data));
+    if (Status != S_OK || elementType != ELEMENT_TYPE_I4)
+        return E_FAIL;
+
+    int64_t sum = 0;
+    for (size_t i = 0; i + sizeof(int32_t) <= data.size(); i += sizeof(int32_t))
+    {
+        int32_t value = 0;
+        memcpy(&value, &data[i], sizeof(value));
+        sum += value;
+    }
+    if (sum < 0 || sum > INT32_MAX)
+        return E_FAIL;
+
+    count = ULONG32(sum);
+    return S_OK;
+}
+
+// Note, buckets (node references) are read from debuggee memory by chunks, so, empty buckets are skipped without
+// ICorDebugValue creation, but nodes chains are walked by fields.
+HRESULT WalkConcurrentNodes(ICorDebugProcess *pProcess, ICorDebugValue *pTables, ULONG32 start, ULONG32 end,
+                            const std::function<HRESULT(ICorDebugValue*, ICorDebugValue*)> &cb)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> iCorBuckets;
+    ToRelease<ICorDebugValue> iCorBucketsValue;
+    ToRelease<ICorDebugArrayValue> iCorBucketsArray;
+    BOOL isNull = FALSE;
+    ULONG32 bucketsCount = 0;
+    IfFailRet(GetFieldValue(pTables, W("_buckets"), &iCorBuckets));
+    IfFailRet(DereferenceAndUnboxValue(iCorBuckets, &iCorBucketsValue, &isNull));
+    if (isNull)
+        return E_FAIL;
+    IfFailRet(iCorBucketsValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID*) &iCorBucketsArray));
+    IfFailRet(iCorBucketsArray->GetCount(&bucketsCount));
+    if (bucketsCount == 0)
+        return S_OK;
+
+    ToRelease<ICorDebugValue> iCorBucket;
+    ULONG32 pointerSize = 0;
+    IfFailRet(iCorBucketsArray->GetElementAtPosition(0, &iCorBucket));
+    IfFailRet(iCorBucket->GetSize(&pointerSize));
+    if (pointerSize != sizeof(uint32_t) && pointerSize != sizeof(uint64_t))
+        return E_FAIL;
+
+    ToRelease<ICorDebugProcess5> iCorProcess5;
+    IfFailRet(pProcess->QueryInterface(IID_ICorDebugProcess5, (LPVOID*) &iCorProcess5));
+
+    std::vector<BYTE> buffer;
+    ULONG32 index = 0;
+    for (ULONG32 chunkStart = 0; chunkStart < bucketsCount; chunkStart += HashScanChunkSize)
+    {
+        const ULONG32 chunkCount = std::min(HashScanChunkSize, bucketsCount - chunkStart);
+        buffer.resize(size_t(chunkCount) * pointerSize);
+        IfFailRet(ReadArrayMemory(pProcess, iCorBucketsValue, pointerSize, chunkStart, chunkCount, buffer.data()));
+
+        for (ULONG32 i = 0; i < chunkCount; i++)
+        {
+            uint64_t nodeAddress = 0;
+            memcpy(&nodeAddress, &buffer[size_t(i) * pointerSize], pointerSize);
+            if (nodeAddress == 0)
+                continue;
+
+            ToRelease<ICorDebugObjectValue> iCorNodeObject;
+            ToRelease<ICorDebugValue> iCorNode;
+            IfFailRet(iCorProcess5->GetObject(nodeAddress, &iCorNodeObject));
+            IfFailRet(iCorNodeObject->QueryInterface(IID_ICorDebugValue, (LPVOID*) &iCorNode));
+            while (iCorNode)
+            {
+                if (index >= start)
+                {
+                    ToRelease<ICorDebugValue> iCorKey;
+                    ToRelease<ICorDebugValue> iCorValue;
+                    IfFailRet(GetFieldValue(iCorNode, W("_key"), &iCorKey));
+                    IfFailRet(GetFieldValue(iCorNode, W("_value"), &iCorValue));
+                    IfFailRet(cb(iCorKey, iCorValue));
+                }
+                if (++index >= end)
+                    return S_OK;
+
+                ToRelease<ICorDebugValue> iCorNext;
+                IfFailRet(GetFieldValue(iCorNode, W("_next"), &iCorNext));
+                iCorNode.Free();
+                IfFailRet(DereferenceAndUnboxValue(iCorNext, &iCorNode, &isNull));
+                if (isNull)
+                    iCorNode.Free();
+            }
+        }
+    }
+
+    return S_OK;
+}
+
+} // unnamed namespace
+
+HRESULT GetMember(ICorDebugThread *pThread, ICorDebugValue *pInputValue, const std::string &name, ICorDebugValue **ppResultValue)
+{
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> iCorValue;
+    if (FAILED(DereferenceAndUnboxValue(pInputValue, &iCorValue, &isNull)) || isNull)
+        return S_FALSE;
+
+    ToRelease<ICorDebugArrayValue> iCorArrayValue;
+    if (SUCCEEDED(iCorValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID*) &iCorArrayValue)))
+    {
+        ULONG32 value = 0;
+        if (name == "Length")
+        {
+            if (FAILED(iCorArrayValue->GetCount(&value)))
+                return S_FALSE;
+        }
+        else if (name == "Rank")
+        {
+            if (FAILED(iCorArrayValue->GetRank(&value)))
+                return S_FALSE;
+        }
+        else
+            return S_FALSE;
+
+        return SUCCEEDED(CreateInt32Value(pThread, (int32_t)value, ppResultValue)) ? S_OK : S_FALSE;
+    }
+
+    ToRelease<ICorDebugType> iCorType;
+    bool typeResolved = false;
+    for (const auto &entry : memberIntrinsics)
+    {
+        if (name != entry.name)
+            continue;
+
+        if (!typeResolved)
+        {
+            typeResolved = true;
+            ToRelease<ICorDebugValue2> iCorValue2;
+            if (FAILED(iCorValue->QueryInterface(IID_ICorDebugValue2, (LPVOID*) &iCorValue2)) ||
+                FAILED(iCorValue2->GetExactType(&iCorType)) || !iCorType)
+                return S_FALSE;
+        }
+
+        if (!WellKnownTypes::IsType(iCorType, entry.type))
+            continue;
+
+        // Note, in case of any error, member will be resolved in usual way.
+        HRESULT Status = entry.intrinsic(pThread, iCorValue, ppResultValue);
+        return Status == S_OK ? S_OK : S_FALSE;
+    }
+
+    return S_FALSE;
+}
+
+HRESULT GetElementsView(ICorDebugValue *pInputValue, ElementsView &view)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> iCorValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &iCorValue, &isNull));
+    if (isNull)
+        return S_FALSE;
+
+    CorElementType corType;
+    IfFailRet(iCorValue->GetType(&corType));
+    if (corType != ELEMENT_TYPE_VALUETYPE && corType != ELEMENT_TYPE_CLASS)
+        return S_FALSE;
+
+    // All views types have one generic parameter, check it first, since this is cheap.
+    ToRelease<ICorDebugType> iCorType;
+    ToRelease<ICorDebugClass> iCorClass;
+    ToRelease<ICorDebugType> iCorElementType;
+    IfFailRet(GetExactClass(iCorValue, &iCorType, &iCorClass));
+    if (FAILED(iCorType->GetFirstTypeParameter(&iCorElementType)) || !iCorElementType)
+        return S_FALSE;
+
+    const ViewKind kind = GetViewKind(corType, iCorType, iCorClass);
+    if (kind == ViewKind::None)
+        return S_FALSE;
+
+    ToRelease<ICorDebugModule> iCorModule;
+    IfFailRet(iCorClass->GetModule(&iCorModule));
+    IfFailRet(iCorModule->GetProcess(&view.process));
+    IfFailRet(iCorElementType->GetType(&view.elementType));
+    view.elementSize = GetPrimitiveTypeSize(view.elementType);
+
+    switch (kind)
+    {
+        case ViewKind::Span:
+            return AddSpanChunk(iCorValue, view);
+        case ViewKind::Memory:
+            return AddMemoryChunk(iCorValue, 0, -1, view);
+        case ViewKind::ArraySegment:
+        {
+            // ArraySegment<T> fields: `_array`, `_offset` and `_count`.
+            ToRelease<ICorDebugValue> iCorArray;
+            int32_t offset = 0;
+            int32_t count = 0;
+            IfFailRet(GetFieldValue(iCorValue, W("_array"), &iCorArray));
+            IfFailRet(ReadInt32Field(iCorValue, W("_offset"), offset));
+            IfFailRet(ReadInt32Field(iCorValue, W("_count"), count));
+            return AddOwnerChunk(iCorArray, offset, count, view);
+        }
+        case ViewKind::Sequence:
+            return AddSequenceChunks(iCorValue, view);
+        case ViewKind::Queue:
+            return AddQueueChunks(iCorValue, view);
+        case ViewKind::Stack:
+            return AddStackChunk(iCorValue, view);
+        default:
+            return S_FALSE;
+    }
+}
+
+HRESULT GetViewElement(const ElementsView &view, ULONG32 position, ICorDebugValue **ppResultValue)
+{
+    if (position >= view.length)
+        return E_INVALIDARG;
+
+    HRESULT Status;
+    for (const auto &chunk : view.chunks)
+    {
+        if (position >= chunk.length)
+        {
+            position -= chunk.length;
+            continue;
+        }
+
+        if (chunk.owner)
+        {
+            // Note, string characters can't be provided as values.
+            ToRelease<ICorDebugArrayValue> iCorArrayValue;
+            IfFailRet(chunk.owner->QueryInterface(IID_ICorDebugArrayValue, (LPVOID*) &iCorArrayValue));
+            return iCorArrayValue->GetElementAtPosition(chunk.offset + (chunk.reversed ? chunk.length - 1 - position : position),
+                                                        ppResultValue);
+        }
+
+        if (!IsReferenceType(view.elementType))
+            return E_FAIL;
+
+        CORDB_ADDRESS objectAddress = 0;
+        SIZE_T read = 0;
+        IfFailRet(view.process->ReadMemory(chunk.address + (CORDB_ADDRESS)position * view.elementSize, view.elementSize,
+                                           (BYTE*)&objectAddress, &read));
+        if (read != view.elementSize)
+            return E_FAIL;
+        if (objectAddress == 0)
+            return S_FALSE;
+
+        ToRelease<ICorDebugProcess5> iCorProcess5;
+        ToRelease<ICorDebugObjectValue> iCorObjectValue;
+        IfFailRet(view.process->QueryInterface(IID_ICorDebugProcess5, (LPVOID*) &iCorProcess5));
+        IfFailRet(iCorProcess5->GetObject(objectAddress, &iCorObjectValue));
+        return iCorObjectValue->QueryInterface(IID_ICorDebugValue, (LPVOID*) ppResultValue);
+    }
+
+    return E_FAIL;
+}
+
+HRESULT GetElement(ICorDebugValue *pInputValue, std::vector<ToRelease<ICorDebugValue>> &indexes, ICorDebugValue **ppResultValue)
+{
+    if (indexes.size() != 1)
+        return S_FALSE;
+
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> iCorValue;
+    ToRelease<ICorDebugValue> iCorIndexValue;
+    if (FAILED(DereferenceAndUnboxValue(pInputValue, &iCorValue, &isNull)) || isNull ||
+        FAILED(DereferenceAndUnboxValue(indexes[0], &iCorIndexValue, &isNull)) || isNull)
+        return S_FALSE;
+
+    ToRelease<ICorDebugValue2> iCorValue2;
+    ToRelease<ICorDebugType> iCorType;
+    if (FAILED(iCorValue->QueryInterface(IID_ICorDebugValue2, (LPVOID*) &iCorValue2)) ||
+        FAILED(iCorValue2->GetExactType(&iCorType)) || !iCorType)
+        return S_FALSE;
+
+    HRESULT Status = S_FALSE;
+    if (WellKnownTypes::IsType(iCorType, WellKnownTypes::Type::List))
+        Status = ListElement(iCorValue, iCorIndexValue, ppResultValue);
+    else if (WellKnownTypes::IsType(iCorType, WellKnownTypes::Type::Dictionary))
+        Status = DictionaryElement(iCorValue, iCorIndexValue, ppResultValue);
+    else
+    {
+        ElementsView view;
+        CorElementType indexType;
+        int32_t index = 0;
+        if (GetElementsView(iCorValue, view) == S_OK &&
+            SUCCEEDED(iCorIndexValue->GetType(&indexType)) && indexType == ELEMENT_TYPE_I4 &&
+            SUCCEEDED(ReadInt32(iCorIndexValue, index)) && index >= 0 && (ULONG32)index < view.length)
+            Status = GetViewElement(view, (ULONG32)index, ppResultValue);
+    }
+
+    return Status == S_OK ? S_OK : S_FALSE;
+}
+
+HRESULT GetHashItemsCount(ICorDebugValue *pInputValue, ULONG32 &count)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> iCorValue;
+    ToRelease<ICorDebugClass> iCorClass;
+    HashKind kind = HashKind::None;
+    if (GetHashCollection(pInputValue, &iCorValue, &iCorClass, kind) != S_OK)
+        return S_FALSE;
+
+    if (kind == HashKind::ConcurrentDictionary)
+    {
+        ToRelease<ICorDebugProcess> iCorProcess;
+        ToRelease<ICorDebugValue> iCorTables;
+        if (FAILED(GetProcess(iCorClass, &iCorProcess)) ||
+            FAILED(GetConcurrentTables(iCorValue, &iCorTables)) ||
+            FAILED(GetConcurrentCount(iCorProcess, iCorTables, count)))
+            return S_FALSE;
+        return S_OK;
+    }
+
+    hash_entries_t hash;
+    IfFailRet(GetHashEntries(iCorValue, iCorClass, kind, hash));
+    if (Status != S_OK)
+        return S_FALSE;
+    count = hash.count;
+    return S_OK;
+}
+
+HRESULT WalkHashItems(ICorDebugValue *pInputValue, ULONG32 start, ULONG32 end, WalkHashItemsCallback cb)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> iCorValue;
+    ToRelease<ICorDebugClass> iCorClass;
+    HashKind kind = HashKind::None;
+    if (GetHashCollection(pInputValue, &iCorValue, &iCorClass, kind) != S_OK)
+        return S_FALSE;
+
+    if (kind == HashKind::ConcurrentDictionary)
+    {
+        ToRelease<ICorDebugProcess> iCorProcess;
+        ToRelease<ICorDebugValue> iCorTables;
+        IfFailRet(GetProcess(iCorClass, &iCorProcess));
+        IfFailRet(GetConcurrentTables(iCorValue, &iCorTables));
+        return WalkConcurrentNodes(iCorProcess, iCorTables, start, end, cb);
+    }
+
+    hash_entries_t hash;
+    IfFailRet(GetHashEntries(iCorValue, iCorClass, kind, hash));
+    if (Status != S_OK)
+        return S_FALSE;
+
+    return ForEachUsedEntry(hash, start, end, [&](ULONG32 position) -> HRESULT
+    {
+        ToRelease<ICorDebugValue> iCorEntry;
+        ToRelease<ICorDebugObjectValue> iCorEntryObject;
+        ToRelease<ICorDebugValue> iCorKey;
+        ToRelease<ICorDebugValue> iCorItemValue;
+        IfFailRet(hash.entries->GetElementAtPosition(position, &iCorEntry));
+        IfFailRet(iCorEntry->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &iCorEntryObject));
+        IfFailRet(iCorEntryObject->GetFieldValue(hash.entryClass, hash.keyField, &iCorKey));
+        if (hash.valueField != mdFieldDefNil)
+            IfFailRet(iCorEntryObject->GetFieldValue(hash.entryClass, hash.valueField, &iCorItemValue));
+        return cb(iCorKey, iCorItemValue);
+    });
+}
+
+} // namespace EvalIntrinsics
+
+} // namespace netcoredbg
@@ -0,0 +1,70 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "utils/torelease.h"
+
+namespace netcoredbg
+{
+
+// Native implementation for most common well known BCL types members (like `list.Count` or `str.Length`), calculated
+// from object fields without members resolution and evaluation in debuggee.
+// Note, all functions return S_FALSE in case member have no intrinsic or value can't be calculated natively (for example,
+// debuggee code must throw exception), so, caller should continue with usual way.
+namespace EvalIntrinsics
+{
+    // Member access (`obj.name`), array, string, Nullable<T>, List<T>, Dictionary<TKey,TValue>, Span<T> and ReadOnlySpan<T>.
+    HRESULT GetMember(ICorDebugThread *pThread, ICorDebugValue *pInputValue, const std::string &name, ICorDebugValue **ppResultValue);
+    // Element access (`obj[index]`), List<T>, Dictionary<TKey,TValue> with primitive or string key and elements views types
+    // (see GetElementsView()).
+    HRESULT GetElement(ICorDebugValue *pInputValue, std::vector<ToRelease<ICorDebugValue>> &indexes, ICorDebugValue **ppResultValue);
+
+    // Elements of Span<T>, ReadOnlySpan<T>, Memory<T>, ReadOnlyMemory<T>, ArraySegment<T>, ReadOnlySequence<T>, Queue<T>
+    // and Stack<T>, that displayed as array. Elements are stored in contiguous chunks (multi-segment ReadOnlySequence<T>
+    // have chunk for each segment, Queue<T> circular buffer could have two chunks): part of array or string, or raw memory
+    // in case of Span<T> (could point to stack or native memory).
+    struct ElementsView
+    {
+        struct Chunk
+        {
+            ToRelease<ICorDebugValue> owner; // array or string, nullptr in case of raw memory
+            CORDB_ADDRESS address = 0;       // first element address in case of raw memory
+            ULONG32 offset = 0;              // first element position in owner
+            ULONG32 length = 0;
+            bool reversed = false;           // elements are provided from chunk end (Stack<T>)
+        };
+
+        ToRelease<ICorDebugProcess> process;
+        CorElementType elementType = ELEMENT_TYPE_END;
+        // Element size in debuggee memory, 0 in case elements can't be read directly from memory.
+        ULONG32 elementSize = 0;
+        ULONG32 length = 0;
+        std::vector<Chunk> chunks;
+    };
+
+    // Return S_FALSE in case value is not elements view type or view can't be created (for example, Memory<T> created by
+    // MemoryManager<T> or Span<T> of value type elements), in this case value should be displayed in usual way.
+    HRESULT GetElementsView(ICorDebugValue *pInputValue, ElementsView &view);
+    // Return S_FALSE without value for null reference in raw memory. Note, elements of primitive types in raw memory and
+    // string characters can't be provided as ICorDebugValue, caller should read them from memory (see ReadPrimitiveArrayElements()).
+    HRESULT GetViewElement(const ElementsView &view, ULONG32 position, ICorDebugValue **ppResultValue);
+
+    // Items of Dictionary<TKey,TValue>, HashSet<T> and ConcurrentDictionary<TKey,TValue>, read from collection internal
+    // arrays (entries array with free list or buckets with nodes chains) without evaluation in debuggee.
+    // Note, `pValue` is nullptr for HashSet<T> items.
+    typedef std::function<HRESULT(ICorDebugValue *pKey, ICorDebugValue *pValue)> WalkHashItemsCallback;
+    // Return S_FALSE in case value is not supported hash collection or internal data have unknown layout.
+    HRESULT GetHashItemsCount(ICorDebugValue *pInputValue, ULONG32 &count);
+    // Call `cb` for items with index in [start, end) range, in same order as collection enumerator provide them.
+    HRESULT WalkHashItems(ICorDebugValue *pInputValue, ULONG32 start, ULONG32 end, WalkHashItemsCallback cb);
+}
+
+} // namespace netcoredbg
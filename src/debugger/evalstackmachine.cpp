@@ -8,12 +8,17 @@
 #include <iterator>
 #include <arrayholder.h>
 #include "debugger/evalstackmachine.h"
+#include "debugger/evalarithmetic.h"
 #include "debugger/evalhelpers.h"
+#include "debugger/evalintrinsics.h"
+#include "debugger/evalintrinsics.h"
 #include "debugger/evalwaiter.h"
 #include "debugger/valueprint.h"
 #include "debugger/evalutils.h"
 #include "managed/interop.h"
 #include "metadata/typeprinter.h"
+#include "metadata/wellknown_types.h"
+#include "utils/cancellation.h"
 #include "utils/utf.h"
 
 
@@ -53,50 +58,13 @@ namespace
         PVOID Ptr;
     };
 
-    // Keep in sync with BasicTypes enum in Evaluation.cs
-    enum class BasicTypes : int32_t
-    {
-        TypeBoolean = 1,
-        TypeByte,
-        TypeSByte,
-        TypeChar,
-        TypeDouble,
-        TypeSingle,
-        TypeInt32,
-        TypeUInt32,
-        TypeInt64,
-        TypeUInt64,
-        TypeInt16,
-        TypeUInt16,
-        TypeString
-    };
+    // Keep in sync with flagChecked in StackMachine.cs
+    const uint32_t FlagChecked = 0x00000001;
 
-    // Keep in sync with OperationType enum in Evaluation.cs
-    enum class OperationType : int32_t
+    bool IsCheckedContext(PVOID pArguments)
     {
-        AddExpression = 1,
-        SubtractExpression,
-        MultiplyExpression,
-        DivideExpression,
-        ModuloExpression,
-        RightShiftExpression,
-        LeftShiftExpression,
-        BitwiseNotExpression,
-        LogicalAndExpression,
-        LogicalOrExpression,
-        ExclusiveOrExpression,
-        BitwiseAndExpression,
-        BitwiseOrExpression,
-        LogicalNotExpression,
-        EqualsExpression,
-        NotEqualsExpression,
-        LessThanExpression,
-        GreaterThanExpression,
-        LessThanOrEqualExpression,
-        GreaterThanOrEqualExpression,
-        UnaryPlusExpression,
-        UnaryMinusExpression
-    };
+        return (((FormatF*)pArguments)->Flags & FlagChecked) != 0;
+    }
 
     void ReplaceAllSubstring(std::string &str, const std::string &from, const std::string &to)
     {
@@ -291,6 +259,105 @@ namespace
         return S_OK;
     }
 
+    // Drop cached values in case process was continued by func-eval since they were resolved.
+    void CheckBatchResolvedIdentifiers(EvalData &ed)
+    {
+        uint64_t evalsCount = ed.pEvalWaiter->GetEvalsCount();
+        if (ed.batchEvalsCount == evalsCount)
+            return;
+
+        ed.batchResolvedIdentifiers.clear();
+        ed.batchLiterals.clear();
+        ed.batchEvalsCount = evalsCount;
+    }
+
+    // Push literal value on stack, in batch mode value is reused for same literal in other expressions.
+    // Note, literal value must not be changed by stack machine, since it could be shared.
+    HRESULT PushLiteralValue(std::list<EvalStackEntry> &evalStack, const std::string &key, EvalData &ed,
+                             const std::function<HRESULT(ICorDebugValue **ppValue)> &createValue)
+    {
+        evalStack.emplace_front();
+        evalStack.front().literal = true;
+        if (!ed.batchMode)
+            return createValue(&evalStack.front().iCorValue);
+
+        CheckBatchResolvedIdentifiers(ed);
+        auto find = ed.batchLiterals.find(key);
+        if (find != ed.batchLiterals.end())
+        {
+            find->second->AddRef();
+            evalStack.front().iCorValue = find->second.GetPtr();
+            return S_OK;
+        }
+
+        HRESULT Status;
+        IfFailRet(createValue(&evalStack.front().iCorValue));
+        // Note, value creation could be func-eval (string or decimal), created value is valid till next func-eval.
+        CheckBatchResolvedIdentifiers(ed);
+        evalStack.front().iCorValue->AddRef();
+        ed.batchLiterals[key] = evalStack.front().iCorValue.GetPtr();
+        return S_OK;
+    }
+
+    // Resolve identifiers one by one with resolved prefixes reuse, return S_FALSE in case identifiers can't be resolved in this way
+    // (for example, first identifier is namespace or type name) and must be resolved by Evaluator::ResolveIdentifiers() as usual.
+    // Note, last identifier result is never cached, since we may need setter data for it.
+    HRESULT BatchResolveIdentifiers(std::vector<std::string> &identifiers, ICorDebugValue **ppResultValue,
+                                    std::unique_ptr<Evaluator::SetterData> *resultSetterData, EvalData &ed)
+    {
+        assert(identifiers.size() > 1);
+        CheckBatchResolvedIdentifiers(ed);
+        const uint64_t evalsCount = ed.batchEvalsCount;
+
+        std::vector<std::string> prefixes(identifiers.size() - 1);
+        prefixes[0] = identifiers[0];
+        for (size_t i = 1; i < prefixes.size(); i++)
+        {
+            prefixes[i] = prefixes[i - 1] + "." + identifiers[i];
+        }
+
+        HRESULT Status;
+        ToRelease<ICorDebugValue> iCorValue;
+        size_t nextIdentifier = 0;
+        for (size_t i = prefixes.size(); i > 0; i--)
+        {
+            auto find = ed.batchResolvedIdentifiers.find(prefixes[i - 1]);
+            if (find == ed.batchResolvedIdentifiers.end())
+                continue;
+
+            find->second->AddRef();
+            iCorValue = find->second.GetPtr();
+            nextIdentifier = i;
+            break;
+        }
+
+        for (; nextIdentifier < identifiers.size(); nextIdentifier++)
+        {
+            bool last = nextIdentifier + 1 == identifiers.size();
+            std::vector<std::string> identifier{identifiers[nextIdentifier]};
+            ToRelease<ICorDebugValue> iCorResultValue;
+            if (FAILED(Status = ed.pEvaluator->ResolveIdentifiers(ed.pThread, ed.frameLevel, iCorValue, nullptr, identifier, &iCorResultValue,
+                                                                  last ? resultSetterData : nullptr, nullptr, ed.evalFlags)))
+            {
+                // Don't repeat resolve in case func-eval was involved, since it could have side effects or could be timed out.
+                return evalsCount == ed.pEvalWaiter->GetEvalsCount() ? S_FALSE : Status;
+            }
+
+            if (last)
+            {
+                *ppResultValue = iCorResultValue.Detach();
+                return S_OK;
+            }
+
+            iCorValue = iCorResultValue.Detach();
+            CheckBatchResolvedIdentifiers(ed);
+            iCorValue->AddRef();
+            ed.batchResolvedIdentifiers[prefixes[nextIdentifier]] = iCorValue.GetPtr();
+        }
+
+        return E_FAIL; // Unreachable.
+    }
+
     HRESULT GetFrontStackEntryValue(ICorDebugValue **ppResultValue, std::unique_ptr<Evaluator::SetterData> *resultSetterData, std::list<EvalStackEntry> &evalStack, EvalData &ed, std::string &output)
     {
         HRESULT Status;
@@ -300,9 +367,15 @@ namespace
         else
             resultSetterData = nullptr;
 
-        if (FAILED(Status = ed.pEvaluator->ResolveIdentifiers(ed.pThread, ed.frameLevel, evalStack.front().iCorValue, inputPropertyData,  evalStack.front().identifiers,
-                                                              ppResultValue, resultSetterData, nullptr, ed.evalFlags))
-            && !evalStack.front().identifiers.empty())
+        Status = S_FALSE;
+        if (ed.batchMode && !evalStack.front().iCorValue && evalStack.front().identifiers.size() > 1)
+            Status = BatchResolveIdentifiers(evalStack.front().identifiers, ppResultValue, resultSetterData, ed);
+
+        if (Status == S_FALSE)
+            Status = ed.pEvaluator->ResolveIdentifiers(ed.pThread, ed.frameLevel, evalStack.front().iCorValue, inputPropertyData,  evalStack.front().identifiers,
+                                                       ppResultValue, resultSetterData, nullptr, ed.evalFlags);
+
+        if (FAILED(Status) && !evalStack.front().identifiers.empty())
         {
             std::ostringstream ss;
             for (size_t i = 0; i < evalStack.front().identifiers.size(); i++)
@@ -369,8 +442,8 @@ namespace
         ed.pEvaluator->WalkMethods(pValue, [&](
             bool is_static,
             const std::string &methodName,
-            Evaluator::ReturnElementType&,
-            std::vector<Evaluator::ArgElementType> &methodArgs,
+            const Evaluator::ReturnElementType&,
+            const std::vector<Evaluator::ArgElementType> &methodArgs,
             Evaluator::GetFunctionCallback getFunction)
         {
             if (!is_static || methodArgs.size() != 1 || opName != methodName ||
@@ -399,8 +472,8 @@ namespace
         ed.pEvaluator->WalkMethods(pValue, [&](
             bool is_static,
             const std::string &methodName,
-            Evaluator::ReturnElementType& methodRet,
-            std::vector<Evaluator::ArgElementType> &methodArgs,
+            const Evaluator::ReturnElementType &methodRet,
+            const std::vector<Evaluator::ArgElementType> &methodArgs,
             Evaluator::GetFunctionCallback getFunction)
         {
             if (!is_static || methodArgs.size() != 1 || opName != methodName ||
@@ -737,6 +810,37 @@ namespace
         return CreatePrimitiveValue(ed.pThread, ppValue, findType->second, valueData);
     }
 
+    // Note, string value is read directly, without BSTR allocation (that only needed for managed part call).
+    HRESULT GetArithmeticValue(ICorDebugValue *pValue, CorElementType elemType, EvalArithmetic::Value &value)
+    {
+        HRESULT Status;
+
+        if (elemType == ELEMENT_TYPE_STRING)
+        {
+            value = EvalArithmetic::Value::FromString(std::string());
+            ToRelease<ICorDebugValue> iCorValue;
+            BOOL isNull = FALSE;
+            IfFailRet(DereferenceAndUnboxValue(pValue, &iCorValue, &isNull));
+            return isNull ? S_OK : PrintStringValue(iCorValue, value.s);
+        }
+
+        int64_t valueDataHolder = 0;
+        PVOID valueData = &valueDataHolder;
+        int32_t valueType = 0;
+        IfFailRet(GetOperandDataTypeByValue(pValue, elemType, valueData, valueType));
+        return EvalArithmetic::Value::FromRaw((BasicTypes)valueType, valueData, value) ? S_OK : E_FAIL;
+    }
+
+    HRESULT CreateArithmeticValue(const EvalArithmetic::Value &value, ICorDebugValue **ppValue, EvalData &ed)
+    {
+        if (value.type == BasicTypes::TypeString)
+            return ed.pEvalHelpers->CreateString(ed.pThread, value.s, ppValue);
+
+        int64_t valueData = 0;
+        value.ToRaw(&valueData);
+        return GetValueByOperandDataType(&valueData, value.type, ppValue, ed);
+    }
+
     HRESULT CallBinaryOperator(const std::string &opName, ICorDebugValue *pValue, ICorDebugValue *pType1Value, ICorDebugValue *pType2Value,
                                ICorDebugValue **pResultValue, EvalData &ed)
     {
@@ -757,14 +861,14 @@ namespace
             return E_INVALIDARG;
 
         ToRelease<ICorDebugValue> iCorTypeValue;
-        auto CallOperator = [&](std::function<HRESULT(std::vector<Evaluator::ArgElementType>&)> cb)
+        auto CallOperator = [&](std::function<HRESULT(const std::vector<Evaluator::ArgElementType>&)> cb)
         {
             ToRelease<ICorDebugFunction> iCorFunc;
             ed.pEvaluator->WalkMethods(pValue, [&](
                 bool is_static,
                 const std::string &methodName,
-                Evaluator::ReturnElementType&,
-                std::vector<Evaluator::ArgElementType> &methodArgs,
+                const Evaluator::ReturnElementType&,
+                const std::vector<Evaluator::ArgElementType> &methodArgs,
                 Evaluator::GetFunctionCallback getFunction)
             {
                 if (!is_static || methodArgs.size() != 2 || opName != methodName ||
@@ -783,7 +887,7 @@ namespace
         };
 
         // Try execute operator for exact same type as provided values.
-        if (SUCCEEDED(CallOperator([&](std::vector<Evaluator::ArgElementType> &methodArgs)
+        if (SUCCEEDED(CallOperator([&](const std::vector<Evaluator::ArgElementType> &methodArgs)
             {
                 return elemType1 != methodArgs[0].corType || typeName1 != methodArgs[0].typeName ||
                        elemType2 != methodArgs[1].corType || typeName2 != methodArgs[1].typeName
@@ -794,7 +898,7 @@ namespace
         // Try execute operator with implicit cast for second value.
         // Make sure we don't cast "base" struct/class value for this case, since "... at least one parameter must have type T...".
         if (elemType == elemType1 && typeName == typeName1 &&
-            SUCCEEDED(CallOperator([&](std::vector<Evaluator::ArgElementType> &methodArgs)
+            SUCCEEDED(CallOperator([&](const std::vector<Evaluator::ArgElementType> &methodArgs)
             {
                 if (elemType1 != methodArgs[0].corType || typeName1 != methodArgs[0].typeName)
                     return E_FAIL;
@@ -812,7 +916,7 @@ namespace
             return S_OK;
 
         // Try execute operator with implicit cast for first value.
-        return CallOperator([&](std::vector<Evaluator::ArgElementType> &methodArgs)
+        return CallOperator([&](const std::vector<Evaluator::ArgElementType> &methodArgs)
             {
                 if (elemType2 != methodArgs[1].corType || typeName2 != methodArgs[1].typeName)
                     return E_FAIL;
@@ -851,7 +955,7 @@ namespace
         return supportedElementTypes.find(elemType) != supportedElementTypes.end();
     }
 
-    HRESULT CalculateTwoOparands(OperationType opType, std::list<EvalStackEntry> &evalStack, std::string &output, EvalData &ed)
+    HRESULT CalculateTwoOparands(OperationType opType, bool checkedContext, std::list<EvalStackEntry> &evalStack, std::string &output, EvalData &ed)
     {
         HRESULT Status;
         ToRelease<ICorDebugValue> iCorValue2;
@@ -935,6 +1039,23 @@ namespace
         else if (!SupportedByCalculationDelegateType(elemType1) || !SupportedByCalculationDelegateType(elemType2))
             return E_INVALIDARG;
 
+        // Note, most of operations with built-in types are calculated natively, managed part is called only for cases,
+        // which are not handled (in order to get proper result or compiler error message).
+        EvalArithmetic::Value operand1;
+        EvalArithmetic::Value operand2;
+        EvalArithmetic::Value result;
+        IfFailRet(GetArithmeticValue(iCorRealValue1, elemType1, operand1));
+        IfFailRet(GetArithmeticValue(iCorRealValue2, elemType2, operand2));
+        switch (EvalArithmetic::Calculate(opType, operand1, operand2, checkedContext, result, output))
+        {
+        case EvalArithmetic::Result::Calculated:
+            return CreateArithmeticValue(result, &evalStack.front().iCorValue, ed);
+        case EvalArithmetic::Result::Failed:
+            return E_FAIL;
+        default:
+            break;
+        }
+
         int64_t valueDataHolder1 = 0;
         PVOID valueData1 = &valueDataHolder1;
         int32_t valueType1 = 0;
@@ -963,7 +1084,7 @@ namespace
         return Status;
     }
 
-    HRESULT CalculateOneOparand(OperationType opType, std::list<EvalStackEntry> &evalStack, std::string &output, EvalData &ed)
+    HRESULT CalculateOneOparand(OperationType opType, bool checkedContext, std::list<EvalStackEntry> &evalStack, std::string &output, EvalData &ed)
     {
         HRESULT Status;
         ToRelease<ICorDebugValue> iCorValue;
@@ -999,6 +1120,19 @@ namespace
         else if (!SupportedByCalculationDelegateType(elemType))
             return E_INVALIDARG;
 
+        EvalArithmetic::Value operand;
+        EvalArithmetic::Value result;
+        IfFailRet(GetArithmeticValue(iCorRealValue, elemType, operand));
+        switch (EvalArithmetic::Calculate(opType, operand, checkedContext, result, output))
+        {
+        case EvalArithmetic::Result::Calculated:
+            return CreateArithmeticValue(result, &evalStack.front().iCorValue, ed);
+        case EvalArithmetic::Result::Failed:
+            return E_FAIL;
+        default:
+            break;
+        }
+
         int64_t valueDataHolder1 = 0;
         PVOID valueData1 = &valueDataHolder1;
         int32_t valueType1 = 0;
@@ -1070,6 +1204,37 @@ namespace
         return S_OK;
     }
 
+    // Unique key of method call for overloads cache (see Evaluator::FindMethodOverload()).
+    HRESULT GetMethodOverloadKey(ICorDebugType *pType, bool searchStatic, bool idsEmpty, const std::string &funcName,
+                                 const std::vector<Evaluator::ArgElementType> &funcArgs,
+                                 const std::vector<Evaluator::ArgElementType> &methodGenerics, std::string &key)
+    {
+        HRESULT Status;
+        ToRelease<ICorDebugClass> pClass;
+        IfFailRet(pType->GetClass(&pClass));
+        ToRelease<ICorDebugModule> pModule;
+        IfFailRet(pClass->GetModule(&pModule));
+        CORDB_ADDRESS modAddress = 0;
+        IfFailRet(pModule->GetBaseAddress(&modAddress));
+        std::string typeName;
+        IfFailRet(TypePrinter::NameForTypeByType(pType, typeName));
+
+        std::ostringstream ss;
+        ss << modAddress << ':' << typeName << ':' << searchStatic << idsEmpty << ':' << funcName << '(';
+        for (const auto &arg : funcArgs)
+        {
+            ss << arg.corType << ':' << arg.typeName << ',';
+        }
+        ss << ")<";
+        for (const auto &generic : methodGenerics)
+        {
+            ss << generic.corType << ':' << generic.typeName << ',';
+        }
+        ss << '>';
+        key = ss.str();
+        return S_OK;
+    }
+
     HRESULT InvocationExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
         int32_t Int = ((FormatFI*)pArguments)->Int;
@@ -1180,37 +1345,48 @@ namespace
             methodGenerics.emplace_back(ed.pEvaluator->GetElementTypeByTypeName(methodGenericStrings[i]));
         }
 
+        std::string overloadKey;
+        if (FAILED(GetMethodOverloadKey(iCorType, searchStatic, idsEmpty, funcName, funcArgs, methodGenerics, overloadKey)))
+            overloadKey.clear();
+
         ToRelease<ICorDebugFunction> iCorFunc;
         ToRelease<ICorDebugType> iCorResultType;
-        ed.pEvaluator->WalkMethods(iCorType, &iCorResultType, methodGenerics, [&](
-            bool is_static,
-            const std::string &methodName,
-            Evaluator::ReturnElementType&,
-            std::vector<Evaluator::ArgElementType> &methodArgs,
-            Evaluator::GetFunctionCallback getFunction)
+        if (overloadKey.empty() || !ed.pEvaluator->FindMethodOverload(overloadKey, &iCorFunc, &iCorResultType, isInstance))
         {
-            if ( (searchStatic && !is_static) || (!searchStatic && is_static && !idsEmpty) ||
-                funcArgs.size() != methodArgs.size() || funcName != methodName)
-                return S_OK;
-
-            for (size_t i = 0; i < funcArgs.size(); ++i)
+            ed.pEvaluator->WalkMethods(iCorType, &iCorResultType, methodGenerics, [&](
+                bool is_static,
+                const std::string &methodName,
+                const Evaluator::ReturnElementType&,
+                const std::vector<Evaluator::ArgElementType> &methodArgs,
+                Evaluator::GetFunctionCallback getFunction)
             {
-                if (funcArgs[i] != methodArgs[i])
+                if ( (searchStatic && !is_static) || (!searchStatic && is_static && !idsEmpty) ||
+                    funcArgs.size() != methodArgs.size() || funcName != methodName)
                     return S_OK;
-            }
 
-            IfFailRet(getFunction(&iCorFunc));
-            isInstance = !is_static;
+                for (size_t i = 0; i < funcArgs.size(); ++i)
+                {
+                    if (funcArgs[i] != methodArgs[i])
+                        return S_OK;
+                }
 
-            return E_ABORT; // Fast exit from cycle.
-        });
+                IfFailRet(getFunction(&iCorFunc));
+                isInstance = !is_static;
 
-        if (!iCorFunc)
-        {
-            if(SUCCEEDED(ed.pEvaluator->LookupExtensionMethods(iCorType, funcName, funcArgs, methodGenerics, &iCorFunc)))
-                isInstance = true; // Extension methods always require "this" as their first parameter
-            else
-                return E_FAIL;
+                return E_ABORT; // Fast exit from cycle.
+            });
+
+            if (!iCorFunc)
+            {
+                if(SUCCEEDED(ed.pEvaluator->LookupExtensionMethods(iCorType, funcName, funcArgs, methodGenerics, &iCorFunc)))
+                    isInstance = true; // Extension methods always require "this" as their first parameter
+                else
+                    return E_FAIL;
+            }
+
+            // Note, failed resolution is not cached, since extension method could be provided by module loaded later.
+            if (!overloadKey.empty())
+                ed.pEvaluator->AddMethodOverload(overloadKey, iCorFunc, iCorResultType, isInstance);
         }
 
         if(iCorResultType)
@@ -1310,6 +1486,15 @@ namespace
             evalStack.front().setterData = std::move(setterData);
             Status = ed.pEvaluator->GetElement(iCorObjectValue, indexes, &evalStack.front().iCorValue);
         } else {
+            // Note, List<T> and Dictionary<TKey,TValue> elements could be read directly from fields without get_Item() evaluation.
+            ToRelease<ICorDebugValue> iCorIntrinsicValue;
+            if (EvalIntrinsics::GetElement(iCorObjectValue, indexvalues, &iCorIntrinsicValue) == S_OK)
+            {
+                evalStack.front().ResetEntry();
+                evalStack.front().iCorValue = iCorIntrinsicValue.Detach();
+                return S_OK;
+            }
+
             std::vector<Evaluator::ArgElementType> funcArgs(Int);
             for (int32_t i = 0; i < Int; ++i)
             {
@@ -1325,8 +1510,8 @@ namespace
             ed.pEvaluator->WalkMethods(iCorObjectValue, [&](
                 bool,
                 const std::string &methodName,
-                Evaluator::ReturnElementType& retType,
-                std::vector<Evaluator::ArgElementType> &methodArgs,
+                const Evaluator::ReturnElementType &retType,
+                const std::vector<Evaluator::ArgElementType> &methodArgs,
                 Evaluator::GetFunctionCallback getFunction)
             {
                 std::string name = "get_Item";
@@ -1416,6 +1601,15 @@ namespace
             evalStack.front().setterData = std::move(setterData);
             Status = ed.pEvaluator->GetElement(iCorObjectValue, indexes, &evalStack.front().iCorValue);
         } else {
+            // Note, List<T> and Dictionary<TKey,TValue> elements could be read directly from fields without get_Item() evaluation.
+            ToRelease<ICorDebugValue> iCorIntrinsicValue;
+            if (EvalIntrinsics::GetElement(iCorObjectValue, indexvalues, &iCorIntrinsicValue) == S_OK)
+            {
+                evalStack.front().ResetEntry();
+                evalStack.front().iCorValue = iCorIntrinsicValue.Detach();
+                return S_OK;
+            }
+
             std::vector<Evaluator::ArgElementType> funcArgs(Int);
             for (int32_t i = 0; i < Int; ++i)
             {
@@ -1431,8 +1625,8 @@ namespace
             ed.pEvaluator->WalkMethods(iCorObjectValue, [&](
                 bool,
                 const std::string &methodName,
-                Evaluator::ReturnElementType& retType,
-                std::vector<Evaluator::ArgElementType> &methodArgs,
+                const Evaluator::ReturnElementType &retType,
+                const std::vector<Evaluator::ArgElementType> &methodArgs,
                 Evaluator::GetFunctionCallback getFunction)
             {
                 std::string name = "get_Item";
@@ -1496,29 +1690,44 @@ namespace
             ELEMENT_TYPE_U8
         };
 
-        evalStack.emplace_front();
-        evalStack.front().literal = true;
-        if (BasicTypesAlias[Int] == ELEMENT_TYPE_VALUETYPE)
-            return CreateValueType(ed.pEvalWaiter, ed.pThread, ed.iCorDecimalClass, &evalStack.front().iCorValue, Ptr);
-        else
-            return CreatePrimitiveValue(ed.pThread, &evalStack.front().iCorValue, BasicTypesAlias[Int], Ptr);
+        // Literal data size, see MarshalValue() in StackMachine.cs.
+        static const size_t BasicTypesSize[] {
+            0, 0, 0,
+            16, // Decimal
+            8, 4, 4, 8,
+            0, 0, 0, 0, 0,
+            4, 8
+        };
+
+        std::string key("N");
+        key += char(Int);
+        key.append((const char*)Ptr, BasicTypesSize[Int]);
+        return PushLiteralValue(evalStack, key, ed, [&](ICorDebugValue **ppValue)
+        {
+            if (BasicTypesAlias[Int] == ELEMENT_TYPE_VALUETYPE)
+                return CreateValueType(ed.pEvalWaiter, ed.pThread, ed.iCorDecimalClass, ppValue, Ptr);
+            else
+                return CreatePrimitiveValue(ed.pThread, ppValue, BasicTypesAlias[Int], Ptr);
+        });
     }
 
     HRESULT StringLiteralExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
         std::string String = to_utf8(((FormatFS*)pArguments)->wString);
         ReplaceInternalNames(String, true);
-        evalStack.emplace_front();
-        evalStack.front().literal = true;
-        return ed.pEvalHelpers->CreateString(ed.pThread, String, &evalStack.front().iCorValue);
+        return PushLiteralValue(evalStack, "S" + String, ed, [&](ICorDebugValue **ppValue)
+        {
+            return ed.pEvalHelpers->CreateString(ed.pThread, String, ppValue);
+        });
     }
 
     HRESULT CharacterLiteralExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
         PVOID Ptr = ((FormatFIP*)pArguments)->Ptr;
-        evalStack.emplace_front();
-        evalStack.front().literal = true;
-        return CreatePrimitiveValue(ed.pThread, &evalStack.front().iCorValue, ELEMENT_TYPE_CHAR, Ptr);
+        return PushLiteralValue(evalStack, std::string("C") + std::string((const char*)Ptr, sizeof(WCHAR)), ed, [&](ICorDebugValue **ppValue)
+        {
+            return CreatePrimitiveValue(ed.pThread, ppValue, ELEMENT_TYPE_CHAR, Ptr);
+        });
     }
 
     HRESULT PredefinedType(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
@@ -1651,92 +1860,92 @@ namespace
 
     HRESULT AddExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::AddExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::AddExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT MultiplyExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::MultiplyExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::MultiplyExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT SubtractExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::SubtractExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::SubtractExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT DivideExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::DivideExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::DivideExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT ModuloExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::ModuloExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::ModuloExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT LeftShiftExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::LeftShiftExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::LeftShiftExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT RightShiftExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::RightShiftExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::RightShiftExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT BitwiseAndExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::BitwiseAndExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::BitwiseAndExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT BitwiseOrExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::BitwiseOrExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::BitwiseOrExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT ExclusiveOrExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::ExclusiveOrExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::ExclusiveOrExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT LogicalAndExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::LogicalAndExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::LogicalAndExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT LogicalOrExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::LogicalOrExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::LogicalOrExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT EqualsExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::EqualsExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::EqualsExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT NotEqualsExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::NotEqualsExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::NotEqualsExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT GreaterThanExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::GreaterThanExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::GreaterThanExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT LessThanExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::LessThanExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::LessThanExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT GreaterThanOrEqualExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::GreaterThanOrEqualExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::GreaterThanOrEqualExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT LessThanOrEqualExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateTwoOparands(OperationType::LessThanOrEqualExpression, evalStack, output, ed);
+        return CalculateTwoOparands(OperationType::LessThanOrEqualExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT IsExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
@@ -1747,22 +1956,22 @@ namespace
 
     HRESULT UnaryPlusExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateOneOparand(OperationType::UnaryPlusExpression, evalStack, output, ed);
+        return CalculateOneOparand(OperationType::UnaryPlusExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT UnaryMinusExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateOneOparand(OperationType::UnaryMinusExpression, evalStack, output, ed);
+        return CalculateOneOparand(OperationType::UnaryMinusExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT LogicalNotExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateOneOparand(OperationType::LogicalNotExpression, evalStack, output, ed);
+        return CalculateOneOparand(OperationType::LogicalNotExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT BitwiseNotExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
     {
-        return CalculateOneOparand(OperationType::BitwiseNotExpression, evalStack, output, ed);
+        return CalculateOneOparand(OperationType::BitwiseNotExpression, IsCheckedContext(pArguments), evalStack, output, ed);
     }
 
     HRESULT TrueLiteralExpression(std::list<EvalStackEntry> &evalStack, PVOID pArguments, std::string &output, EvalData &ed)
@@ -1932,6 +2141,76 @@ namespace
 
 } // unnamed namespace
 
+const size_t StackProgramsCache::MaxPrograms;
+
+struct StackProgramsCache::Program
+{
+    // Note, commands arguments memory owned by managed part stack program object.
+    PVOID pStackProgram;
+    std::vector<Interop::StackCommand> commands;
+
+    Program() : pStackProgram(nullptr) {}
+    ~Program()
+    {
+        if (pStackProgram)
+            Interop::ReleaseStackMachineProgram(pStackProgram);
+    }
+};
+
+HRESULT StackProgramsCache::GetProgram(const std::string &expression, program_ptr_t &program, std::string &output)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto find = m_programs.find(expression);
+        if (find != m_programs.end())
+        {
+            m_lruList.splice(m_lruList.begin(), m_lruList, find->second);
+            program = find->second->second;
+            output.clear();
+            return S_OK;
+        }
+    }
+
+    // Note, program generated without cache lock, since Roslyn parsing could take a while.
+    HRESULT Status;
+    auto newProgram = std::make_shared<Program>();
+    IfFailRet(Interop::GenerateStackMachineProgram(expression, &newProgram->pStackProgram, output));
+    std::string commandsOutput;
+    if (FAILED(Status = Interop::GetStackMachineProgramCommands(newProgram->pStackProgram, newProgram->commands, commandsOutput)))
+    {
+        output = commandsOutput;
+        return Status;
+    }
+    program = newProgram;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto find = m_programs.find(expression);
+    if (find != m_programs.end())
+    {
+        // Same expression was added by another thread, use most recent program.
+        find->second->second = program;
+        m_lruList.splice(m_lruList.begin(), m_lruList, find->second);
+        return S_OK;
+    }
+
+    if (m_programs.size() >= MaxPrograms)
+    {
+        m_programs.erase(m_lruList.back().first);
+        m_lruList.pop_back();
+    }
+
+    m_lruList.emplace_front(expression, program);
+    m_programs.emplace(expression, m_lruList.begin());
+    return S_OK;
+}
+
+void StackProgramsCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_programs.clear();
+    m_lruList.clear();
+}
+
 HRESULT EvalStackMachine::Run(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, const std::string &expression,
                               std::list<EvalStackEntry> &evalStack, std::string &output)
 {
@@ -1996,25 +2275,25 @@ HRESULT EvalStackMachine::Run(ICorDebugThread *pThread, FrameLevel frameLevel, i
     ReplaceInternalNames(fixed_expression);
 
     HRESULT Status;
-    PVOID pStackProgram = nullptr;
-    IfFailRet(Interop::GenerateStackMachineProgram(fixed_expression, &pStackProgram, output));
-
-    static constexpr int32_t ProgramFinished = -1;
-    int32_t Command;
-    PVOID pArguments;
+    StackProgramsCache::program_ptr_t program;
+    IfFailRet(m_stackProgramsCache.GetProgram(fixed_expression, program, output));
 
     m_evalData.pThread = pThread;
     m_evalData.frameLevel = frameLevel;
     m_evalData.evalFlags = evalFlags;
 
-    do
+    for (const auto &command : program->commands)
     {
-        if (FAILED(Status = Interop::NextStackCommand(pStackProgram, Command, pArguments, output)) ||
-            Command == ProgramFinished ||
-            FAILED(Status = CommandImplementation[Command](evalStack, pArguments, output, m_evalData)))
+        output.clear();
+        // Note, check cancellation between commands, long evaluation could have many func-evals (each one could be aborted separately).
+        if (Cancellation::IsRequested())
+        {
+            Status = COR_E_OPERATIONCANCELED;
+            break;
+        }
+        if (FAILED(Status = CommandImplementation[command.command](evalStack, command.arguments, output, m_evalData)))
             break;
     }
-    while (1);
 
     switch (Status)
     {
@@ -2045,7 +2324,6 @@ HRESULT EvalStackMachine::Run(ICorDebugThread *pThread, FrameLevel frameLevel, i
             break;
     }
 
-    Interop::ReleaseStackMachineProgram(pStackProgram);
     return Status;
 }
 
@@ -2071,6 +2349,19 @@ HRESULT EvalStackMachine::EvaluateExpression(ICorDebugThread *pThread, FrameLeve
     return S_OK;
 }
 
+void EvalStackMachine::BeginBatch()
+{
+    m_evalData.batchMode = true;
+    m_evalData.batchEvalsCount = m_evalData.pEvalWaiter->GetEvalsCount();
+}
+
+void EvalStackMachine::EndBatch()
+{
+    m_evalData.batchMode = false;
+    m_evalData.batchResolvedIdentifiers.clear();
+    m_evalData.batchLiterals.clear();
+}
+
 HRESULT EvalStackMachine::SetValueByExpression(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, ICorDebugValue *pValue,
                                                const std::string &expression, std::string &output)
 {
@@ -2094,15 +2385,11 @@ HRESULT EvalStackMachine::FindPredefinedTypes(ICorDebugModule *pModule)
     ToRelease<IMetaDataImport> pMD;
     IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
 
+    // Note, WellKnownTypes registry must be initialized before this call.
+    IfFailRet(WellKnownTypes::GetClass(WellKnownTypes::Type::Decimal, &m_evalData.iCorDecimalClass));
+    IfFailRet(WellKnownTypes::GetClass(WellKnownTypes::Type::Void, &m_evalData.iCorVoidClass));
+
     mdTypeDef typeDef = mdTypeDefNil;
-    static const WCHAR strTypeDefDecimal[] = W("System.Decimal");
-    IfFailRet(pMD->FindTypeDefByName(strTypeDefDecimal, NULL, &typeDef));
-    IfFailRet(pModule->GetClassFromToken(typeDef, &m_evalData.iCorDecimalClass));
-
-    typeDef = mdTypeDefNil;
-    static const WCHAR strTypeDefVoid[] = W("System.Void");
-    IfFailRet(pMD->FindTypeDefByName(strTypeDefVoid, NULL, &typeDef));
-    IfFailRet(pModule->GetClassFromToken(typeDef, &m_evalData.iCorVoidClass));
 
     static const std::vector<std::pair<CorElementType, const WCHAR*>> corElementToValueNameMap{
         {ELEMENT_TYPE_BOOLEAN,  W("System.Boolean")},
@@ -11,6 +11,7 @@
 #include <memory>
 #include <vector>
 #include <list>
+#include <mutex>
 #include <unordered_map>
 #include "interfaces/types.h"
 #include "utils/torelease.h"
@@ -79,18 +80,54 @@ struct EvalData
     std::unordered_map<CorElementType, ToRelease<ICorDebugClass>> corElementToValueClassMap;
     FrameLevel frameLevel;
     int evalFlags;
+    // Resolved identifiers prefixes (`this`, `this.a`, ...) cache, used during batch evaluation only.
+    // Note, cached values are valid till process continue, so, cache must be cleared after any func-eval.
+    bool batchMode;
+    uint64_t batchEvalsCount;
+    std::unordered_map<std::string, ToRelease<ICorDebugValue>> batchResolvedIdentifiers;
+    // Literals values cache (by literal type and data), same lifetime as batchResolvedIdentifiers. Aimed to avoid
+    // values creation (func-eval in case of string or decimal) for literals repeated in watch expressions.
+    std::unordered_map<std::string, ToRelease<ICorDebugValue>> batchLiterals;
 
     EvalData() :
-        pThread(nullptr), pEvaluator(nullptr), pEvalHelpers(nullptr), pEvalWaiter(nullptr), evalFlags(defaultEvalFlags)
+        pThread(nullptr), pEvaluator(nullptr), pEvalHelpers(nullptr), pEvalWaiter(nullptr), evalFlags(defaultEvalFlags),
+        batchMode(false), batchEvalsCount(0)
     {}
 };
 
+// Bounded LRU cache of stack machine programs by expression, aimed to avoid expression parsing (by Roslyn in managed part)
+// on each watch refresh and conditional breakpoint check.
+class StackProgramsCache
+{
+public:
+
+    struct Program;
+    typedef std::shared_ptr<const Program> program_ptr_t;
+
+    static const size_t MaxPrograms = 256;
+
+    // Return cached program or generate new one. Note, in case of error, output contain error message.
+    HRESULT GetProgram(const std::string &expression, program_ptr_t &program, std::string &output);
+    void Clear();
+
+private:
+
+    typedef std::list<std::pair<std::string, program_ptr_t>> lru_list_t;
+
+    std::mutex m_mutex;
+    // m_lruList - most recently used first
+    lru_list_t m_lruList;
+    std::unordered_map<std::string, lru_list_t::iterator> m_programs;
+};
+
 class EvalStackMachine
 {
     std::shared_ptr<Evaluator> m_sharedEvaluator;
     std::shared_ptr<EvalHelpers> m_sharedEvalHelpers;
     std::shared_ptr<EvalWaiter> m_sharedEvalWaiter;
     EvalData m_evalData;
+    // Note, m_stackProgramsCache have its own mutex for private data state sync.
+    StackProgramsCache m_stackProgramsCache;
 
     // Run stack machine for particular expression.
     HRESULT Run(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, const std::string &expression,
@@ -116,12 +153,19 @@ public:
         m_evalData.pEvaluator = nullptr;
         m_evalData.pEvalHelpers = nullptr;
         m_evalData.pEvalWaiter = nullptr;
+        m_stackProgramsCache.Clear();
     }
 
     // Evaluate expression. Optional, return `editable` state and in case result is property - setter related information.
     HRESULT EvaluateExpression(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, const std::string &expression, ICorDebugValue **ppResultValue,
                                std::string &output, bool *editable = nullptr, std::unique_ptr<Evaluator::SetterData> *resultSetterData = nullptr);
 
+    // Batch evaluation for expressions in same thread and frame with same evalFlags, resolved identifiers prefixes
+    // are shared between expressions (for example, `this.a` for `this.a.b` and `this.a.c`).
+    // Note, all EvaluateExpression() calls between BeginBatch() and EndBatch() must have the same thread, frame and evalFlags.
+    void BeginBatch();
+    void EndBatch();
+
     // Set value in pValue by expression with implicitly cast expression result to pValue type, if need.
     HRESULT SetValueByExpression(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, ICorDebugValue *pValue,
                                  const std::string &expression, std::string &output);
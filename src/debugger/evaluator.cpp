@@ -7,20 +7,231 @@
 #include <unordered_set>
 #include <vector>
 #include "debugger/evalhelpers.h"
+#include "debugger/evalintrinsics.h"
 #include "debugger/evalutils.h"
 #include "debugger/evaluator.h"
 #include "debugger/evalstackmachine.h"
 #include "debugger/frames.h"
+#include "debugger/il_interpreter.h"
+#include "utils/memory_size.h"
 #include "utils/utf.h"
 #include "metadata/modules.h"
+#include "metadata/metadata_index.h"
 #include "metadata/typeprinter.h"
 #include "metadata/attributes.h"
+#include "metadata/wellknown_types.h"
 #include "valueprint.h"
 #include "managed/interop.h"
 
 namespace netcoredbg
 {
 
+Evaluator::Evaluator(std::shared_ptr<Modules> &sharedModules,
+                     std::shared_ptr<EvalHelpers> &sharedEvalHelpers,
+                     std::shared_ptr<EvalStackMachine> &sharedEvalStackMachine) :
+    m_sharedModules(sharedModules),
+    m_sharedEvalHelpers(sharedEvalHelpers),
+    m_sharedEvalStackMachine(sharedEvalStackMachine),
+    m_uniqueTypeMembersCache(new TypeMembersCache)
+{}
+
+Evaluator::~Evaluator()
+{}
+
+void Evaluator::InvalidateModuleMembers(ICorDebugModule *pModule)
+{
+    CORDB_ADDRESS modAddress;
+    if (SUCCEEDED(pModule->GetBaseAddress(&modAddress)))
+        m_uniqueTypeMembersCache->InvalidateModule(modAddress);
+}
+
+bool Evaluator::FindMethodOverload(const std::string &key, ICorDebugFunction **ppFunction, ICorDebugType **ppResultType, bool &isInstance)
+{
+    TypeMembersCache::overload_ptr_t overload = m_uniqueTypeMembersCache->GetOverload(key);
+    if (!overload)
+        return false;
+
+    overload->function->AddRef();
+    *ppFunction = overload->function.GetPtr();
+    if (overload->resultType)
+    {
+        overload->resultType->AddRef();
+        *ppResultType = overload->resultType.GetPtr();
+    }
+    isInstance = overload->isInstance;
+    return true;
+}
+
+void Evaluator::AddMethodOverload(const std::string &key, ICorDebugFunction *pFunction, ICorDebugType *pResultType, bool isInstance)
+{
+    std::shared_ptr<TypeMembersCache::overload_t> overload(new TypeMembersCache::overload_t);
+    pFunction->AddRef();
+    overload->function = pFunction;
+    if (pResultType)
+        pResultType->AddRef();
+    overload->resultType = pResultType;
+    overload->isInstance = isInstance;
+    m_uniqueTypeMembersCache->PutOverload(key, overload);
+}
+
+void Evaluator::Cleanup()
+{
+    m_uniqueTypeMembersCache->Clear();
+}
+
+size_t Evaluator::GetMemoryUsage()
+{
+    return m_uniqueTypeMembersCache->GetMemoryUsage();
+}
+
+const size_t TypeMembersCache::MaxTypes;
+
+TypeMembersCache::members_ptr_t TypeMembersCache::GetMembers(uint64_t modAddress, mdTypeDef typeDef)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto find = m_members.find(key_t{modAddress, typeDef, std::string()});
+    return find == m_members.end() ? nullptr : find->second;
+}
+
+void TypeMembersCache::PutMembers(uint64_t modAddress, mdTypeDef typeDef, members_ptr_t members)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Note, we don't track usage, just start over in case of overflow (types tables are cheap to rebuild).
+    if (m_members.size() >= MaxTypes)
+        m_members.clear();
+    m_members[key_t{modAddress, typeDef, std::string()}] = std::move(members);
+}
+
+TypeMembersCache::methods_ptr_t TypeMembersCache::GetMethods(uint64_t modAddress, mdTypeDef typeDef, const std::string &generics)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto find = m_methods.find(key_t{modAddress, typeDef, generics});
+    return find == m_methods.end() ? nullptr : find->second;
+}
+
+void TypeMembersCache::PutMethods(uint64_t modAddress, mdTypeDef typeDef, const std::string &generics, methods_ptr_t methods)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_methods.size() >= MaxTypes)
+        m_methods.clear();
+    m_methods[key_t{modAddress, typeDef, generics}] = std::move(methods);
+}
+
+TypeMembersCache::layout_ptr_t TypeMembersCache::GetLayout(uint64_t modAddress, mdTypeDef typeDef, const std::string &typeName)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto find = m_layouts.find(key_t{modAddress, typeDef, typeName});
+    return find == m_layouts.end() ? nullptr : find->second;
+}
+
+void TypeMembersCache::PutLayout(uint64_t modAddress, mdTypeDef typeDef, const std::string &typeName, layout_ptr_t layout)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_layouts.size() >= MaxTypes)
+        m_layouts.clear();
+    m_layouts[key_t{modAddress, typeDef, typeName}] = std::move(layout);
+}
+
+TypeMembersCache::overload_ptr_t TypeMembersCache::GetOverload(const std::string &key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto find = m_overloads.find(key);
+    return find == m_overloads.end() ? nullptr : find->second;
+}
+
+void TypeMembersCache::PutOverload(const std::string &key, overload_ptr_t overload)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_overloads.size() >= MaxTypes)
+        m_overloads.clear();
+    m_overloads[key] = std::move(overload);
+}
+
+void TypeMembersCache::InvalidateModule(uint64_t modAddress)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_overloads.clear();
+    for (auto it = m_members.begin(); it != m_members.end();)
+    {
+        if (it->first.modAddress == modAddress)
+            it = m_members.erase(it);
+        else
+            ++it;
+    }
+    for (auto it = m_methods.begin(); it != m_methods.end();)
+    {
+        if (it->first.modAddress == modAddress)
+            it = m_methods.erase(it);
+        else
+            ++it;
+    }
+    for (auto it = m_layouts.begin(); it != m_layouts.end();)
+    {
+        if (it->first.modAddress == modAddress)
+            it = m_layouts.erase(it);
+        else
+            ++it;
+    }
+}
+
+void TypeMembersCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_members.clear();
+    m_methods.clear();
+    m_layouts.clear();
+    m_overloads.clear();
+}
+
+size_t TypeMembersCache::GetMemoryUsage()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t size = MemorySize::HashNodes(m_members) + MemorySize::HashNodes(m_methods) + MemorySize::HashNodes(m_layouts) +
+                  MemorySize::HashNodes(m_overloads);
+    for (const auto &entry : m_overloads)
+    {
+        size += MemorySize::String(entry.first) + sizeof(overload_t);
+    }
+    for (const auto &entry : m_members)
+    {
+        size += MemorySize::String(entry.first.generics);
+        if (!entry.second)
+            continue;
+
+        size += sizeof(members_t) + MemorySize::Vector(entry.second->fields) + MemorySize::Vector(entry.second->properties) +
+                MemorySize::HashNodes(entry.second->fieldsByName) + MemorySize::HashNodes(entry.second->propertiesByName);
+        for (const auto &field : entry.second->fields)
+        {
+            size += MemorySize::String(field.name);
+        }
+        for (const auto &property : entry.second->properties)
+        {
+            size += MemorySize::String(property.name);
+        }
+    }
+    for (const auto &entry : m_methods)
+    {
+        size += MemorySize::String(entry.first.generics);
+        if (!entry.second)
+            continue;
+
+        size += sizeof(methods_t) + MemorySize::Vector(entry.second->methods);
+        for (const auto &method : entry.second->methods)
+        {
+            size += MemorySize::String(method.name) + MemorySize::Vector(method.argsTypes);
+        }
+    }
+    for (const auto &entry : m_layouts)
+    {
+        size += MemorySize::String(entry.first.generics);
+        if (entry.second)
+            size += sizeof(layout_t) + MemorySize::HashNodes(entry.second->fields);
+    }
+
+    return size;
+}
+
 bool Evaluator::ArgElementType::isAlias(const CorElementType type1, const CorElementType type2, const std::string& name2)
 {
     static const std::unordered_map<CorElementType, ArgElementType> aliases = {
@@ -178,6 +389,21 @@ static void IncIndicies(std::vector<ULONG32> &ind, const std::vector<ULONG32> &d
     }
 }
 
+// Convert element position in array (row-major order) into indicies.
+static void PositionToIndicies(ULONG32 position, const std::vector<ULONG32> &dims, std::vector<ULONG32> &ind)
+{
+    for (int i = static_cast<int32_t>(dims.size()) - 1; i >= 0; --i)
+    {
+        if (dims[i] == 0)
+        {
+            ind[i] = 0;
+            continue;
+        }
+        ind[i] = position % dims[i];
+        position /= dims[i];
+    }
+}
+
 static std::string IndiciesToStr(const std::vector<ULONG32> &ind, const std::vector<ULONG32> &base)
 {
     const size_t ind_size = ind.size();
@@ -486,53 +712,54 @@ HRESULT Evaluator::WalkMethods(ICorDebugValue *pInputTypeValue, WalkMethodsCallb
 static const ULONG SIG_METHOD_VARARG = 0x5; // vararg calling convention
 static const ULONG SIG_METHOD_GENERIC = 0x10; // used to indicate that the method has one or more generic parameters.
 
-static HRESULT InternalWalkMethods(ICorDebugType *pInputType, ICorDebugType **ppResultType, std::vector<Evaluator::ArgElementType> &methodGenerics, Evaluator::WalkMethodsCallback cb)
+// Unique string for type and method generics, used as part of methods cache key.
+static std::string GetGenericsKey(const std::vector<Evaluator::ArgElementType> &typeGenerics, const std::vector<Evaluator::ArgElementType> &methodGenerics)
+{
+    std::ostringstream ss;
+    for (const auto &generic : typeGenerics)
+    {
+        ss << generic.corType << ':' << generic.typeName << ',';
+    }
+    ss << '|';
+    for (const auto &generic : methodGenerics)
+    {
+        ss << generic.corType << ':' << generic.typeName << ',';
+    }
+    return ss.str();
+}
+
+static HRESULT GetTypeMethods(TypeMembersCache *pTypeMembersCache, ICorDebugModule *pModule, mdTypeDef currentTypeDef,
+                              std::vector<Evaluator::ArgElementType> &typeGenerics, std::vector<Evaluator::ArgElementType> &methodGenerics,
+                              TypeMembersCache::methods_ptr_t &methods)
 {
     HRESULT Status;
-    ToRelease<ICorDebugClass> pClass;
-    IfFailRet(pInputType->GetClass(&pClass));
-    ToRelease<ICorDebugModule> pModule;
-    IfFailRet(pClass->GetModule(&pModule));
-    mdTypeDef currentTypeDef;
-    IfFailRet(pClass->GetToken(&currentTypeDef));
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+    const std::string genericsKey = GetGenericsKey(typeGenerics, methodGenerics);
+    methods = pTypeMembersCache->GetMethods(modAddress, currentTypeDef, genericsKey);
+    if (methods)
+        return S_OK;
+
     ToRelease<IUnknown> pMDUnknown;
     IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
     ToRelease<IMetaDataImport> pMD;
     IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
 
-    std::vector<Evaluator::ArgElementType> typeGenerics;
-    ToRelease<ICorDebugTypeEnum> paramTypes;
+    MetadataIndex::index_ptr_t index;
+    IfFailRet(MetadataIndex::GetModuleIndex(pModule, index));
+    const module_metadata_index_t::type_t *pTypeIndex = index->FindType(currentTypeDef);
+    if (pTypeIndex == nullptr)
+        return E_FAIL;
 
-    if (SUCCEEDED(pInputType->EnumerateTypeParameters(&paramTypes)))
-    {
-        ULONG fetched = 0;
-        ToRelease<ICorDebugType> pCurrentTypeParam;
+    std::shared_ptr<TypeMembersCache::methods_t> newMethods(new TypeMembersCache::methods_t);
 
-        while (SUCCEEDED(paramTypes->Next(1, &pCurrentTypeParam, &fetched)) && fetched == 1)
-        {
-            Evaluator::ArgElementType argElType;
-            pCurrentTypeParam->GetType(&argElType.corType);
-            if(argElType.corType == ELEMENT_TYPE_VALUETYPE || argElType.corType == ELEMENT_TYPE_CLASS)
-                IfFailRet(TypePrinter::NameForTypeByType(pCurrentTypeParam, argElType.typeName));
-            typeGenerics.emplace_back(argElType);
-            pCurrentTypeParam.Free();
-        }
-    }
-
-    ULONG numMethods = 0;
-    HCORENUM fEnum = NULL;
-    mdMethodDef methodDef;
-    while(SUCCEEDED(pMD->EnumMethods(&fEnum, currentTypeDef, &methodDef, 1, &numMethods)) && numMethods != 0)
+    for (size_t methodIndex = pTypeIndex->methodsBegin; methodIndex < pTypeIndex->methodsEnd; methodIndex++)
     {
-
-        mdTypeDef memTypeDef;
-        ULONG nameLen;
-        WCHAR szFunctionName[mdNameLen] = {0};
+        const mdMethodDef methodDef = index->methods[methodIndex].methodDef;
         DWORD methodAttr = 0;
         PCCOR_SIGNATURE pSig = NULL;
         ULONG cbSig = 0;
-        if (FAILED(pMD->GetMethodProps(methodDef, &memTypeDef,
-                                     szFunctionName, _countof(szFunctionName), &nameLen,
+        if (FAILED(pMD->GetMethodProps(methodDef, nullptr, nullptr, 0, nullptr,
                                      &methodAttr, &pSig, &cbSig, nullptr,  nullptr)))
             continue;
         ULONG gParams; // Count of signature generics
@@ -562,7 +789,8 @@ static HRESULT InternalWalkMethods(ICorDebugType *pInputType, ICorDebugType **pp
 
         // 4. return type
         Evaluator::ArgElementType returnElementType;
-        IfFailRet(ParseElementType(pMD, &pSig, returnElementType, typeGenerics, methodGenerics));
+        if (FAILED(Status = ParseElementType(pMD, &pSig, returnElementType, typeGenerics, methodGenerics)))
+            return Status;
         if (Status == S_FALSE)
             continue;
 
@@ -570,104 +798,767 @@ static HRESULT InternalWalkMethods(ICorDebugType *pInputType, ICorDebugType **pp
         std::vector<Evaluator::ArgElementType> argElementTypes(cParams);
         for (ULONG i = 0; i < cParams; ++i)
         {
-            IfFailRet(ParseElementType(pMD, &pSig, argElementTypes[i], typeGenerics, methodGenerics));
+            if (FAILED(Status = ParseElementType(pMD, &pSig, argElementTypes[i], typeGenerics, methodGenerics)))
+                return Status;
             if (Status == S_FALSE)
                 break;
         }
         if (Status == S_FALSE)
             continue;
 
-        bool is_static = (methodAttr & mdStatic);
+        newMethods->methods.emplace_back(TypeMembersCache::method_t{methodDef, index->methods[methodIndex].name, (methodAttr & mdStatic) != 0,
+                                                                    std::move(returnElementType), std::move(argElementTypes)});
+    }
+
+    methods = newMethods;
+    pTypeMembersCache->PutMethods(modAddress, currentTypeDef, genericsKey, methods);
+    return S_OK;
+}
+
+static HRESULT InternalWalkMethods(TypeMembersCache *pTypeMembersCache, ICorDebugType *pInputType, ICorDebugType **ppResultType,
+                                   std::vector<Evaluator::ArgElementType> &methodGenerics, Evaluator::WalkMethodsCallback cb)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugClass> pClass;
+    IfFailRet(pInputType->GetClass(&pClass));
+    ToRelease<ICorDebugModule> pModule;
+    IfFailRet(pClass->GetModule(&pModule));
+    mdTypeDef currentTypeDef;
+    IfFailRet(pClass->GetToken(&currentTypeDef));
+
+    std::vector<Evaluator::ArgElementType> typeGenerics;
+    ToRelease<ICorDebugTypeEnum> paramTypes;
+
+    if (SUCCEEDED(pInputType->EnumerateTypeParameters(&paramTypes)))
+    {
+        ULONG fetched = 0;
+        ToRelease<ICorDebugType> pCurrentTypeParam;
+
+        while (SUCCEEDED(paramTypes->Next(1, &pCurrentTypeParam, &fetched)) && fetched == 1)
+        {
+            Evaluator::ArgElementType argElType;
+            pCurrentTypeParam->GetType(&argElType.corType);
+            if(argElType.corType == ELEMENT_TYPE_VALUETYPE || argElType.corType == ELEMENT_TYPE_CLASS)
+                IfFailRet(TypePrinter::NameForTypeByType(pCurrentTypeParam, argElType.typeName));
+            typeGenerics.emplace_back(argElType);
+            pCurrentTypeParam.Free();
+        }
+    }
+
+    TypeMembersCache::methods_ptr_t methods;
+    IfFailRet(GetTypeMethods(pTypeMembersCache, pModule, currentTypeDef, typeGenerics, methodGenerics, methods));
 
+    for (const auto &method : methods->methods)
+    {
         auto getFunction = [&](ICorDebugFunction **ppResultFunction) -> HRESULT
         {
-            return pModule->GetFunctionFromToken(methodDef, ppResultFunction);
+            return pModule->GetFunctionFromToken(method.methodDef, ppResultFunction);
         };
 
-        Status = cb(is_static, to_utf8(szFunctionName), returnElementType, argElementTypes, getFunction);
+        Status = cb(method.isStatic, method.name, method.returnType, method.argsTypes, getFunction);
         if (FAILED(Status))
         {
             pInputType->AddRef();
             *ppResultType = pInputType;
-            pMD->CloseEnum(fEnum);
             return Status;
         }
     }
-    pMD->CloseEnum(fEnum);
 
-    ToRelease<ICorDebugType> iCorBaseType;
-    if(SUCCEEDED(pInputType->GetBase(&iCorBaseType)) && iCorBaseType != NULL)
-    {
-        IfFailRet(InternalWalkMethods(iCorBaseType, ppResultType, methodGenerics, cb));
-    }
+    ToRelease<ICorDebugType> iCorBaseType;
+    if(SUCCEEDED(pInputType->GetBase(&iCorBaseType)) && iCorBaseType != NULL)
+    {
+        IfFailRet(InternalWalkMethods(pTypeMembersCache, iCorBaseType, ppResultType, methodGenerics, cb));
+    }
+
+    return S_OK;
+}
+
+HRESULT Evaluator::WalkMethods(ICorDebugType *pInputType, ICorDebugType **ppResultType, std::vector<Evaluator::ArgElementType> &methodGenerics, Evaluator::WalkMethodsCallback cb)
+{
+    return InternalWalkMethods(m_uniqueTypeMembersCache.get(), pInputType, ppResultType, methodGenerics, cb);
+}
+
+static HRESULT InternalSetValue(EvalStackMachine *pEvalStackMachine, EvalHelpers *pEvalHelpers, ICorDebugThread *pThread, FrameLevel frameLevel,
+                                ICorDebugValue *pValue, Evaluator::SetterData *setterData, const std::string &value, int evalFlags, std::string &output)
+{
+    if (!pThread)
+        return E_FAIL;
+
+    // In case this is not property, just change value itself.
+    if (!setterData)
+        return pEvalStackMachine->SetValueByExpression(pThread, frameLevel, evalFlags, pValue, value, output);
+
+    HRESULT Status;
+    pValue->AddRef();
+    ToRelease<ICorDebugValue> iCorValue(pValue);
+    CorElementType corType;
+    IfFailRet(iCorValue->GetType(&corType));
+
+    if (corType == ELEMENT_TYPE_STRING)
+    {
+        // FIXME investigate, why in this case we can't use ICorDebugReferenceValue::SetValue() for string in iCorValue
+        iCorValue.Free();
+        IfFailRet(pEvalStackMachine->EvaluateExpression(pThread, frameLevel, evalFlags, value, &iCorValue, output));
+
+        CorElementType elemType;
+        IfFailRet(iCorValue->GetType(&elemType));
+        if (elemType != ELEMENT_TYPE_STRING)
+            return E_INVALIDARG;
+    }
+    else // Allow stack machine decide what types are supported.
+    {
+        IfFailRet(pEvalStackMachine->SetValueByExpression(pThread, frameLevel, evalFlags, iCorValue.GetPtr(), value, output));
+    }
+
+    // Call setter.
+    if (!setterData->thisValue)
+    {
+        return pEvalHelpers->EvalFunction(pThread, setterData->setterFunction, setterData->propertyType.GetRef(), 1, iCorValue.GetRef(), 1, nullptr, evalFlags);
+    }
+    else
+    {
+        ICorDebugValue *ppArgsValue[] = {setterData->thisValue, iCorValue};
+        return pEvalHelpers->EvalFunction(pThread, setterData->setterFunction, setterData->propertyType.GetRef(), 1, ppArgsValue, 2, nullptr, evalFlags);
+    }
+}
+
+HRESULT Evaluator::SetValue(ICorDebugThread *pThread, FrameLevel frameLevel, ICorDebugValue *pValue,
+                            SetterData *setterData, const std::string &value, int evalFlags, std::string &output)
+{
+    return InternalSetValue(m_sharedEvalStackMachine.get(), m_sharedEvalHelpers.get(), pThread, frameLevel, pValue, setterData, value, evalFlags, output);
+}
+
+// https://github.com/dotnet/roslyn/blob/d1e617ded188343ba43d24590802dd51e68e8e32/src/Compilers/CSharp/Portable/Symbols/Synthesized/GeneratedNameParser.cs#L13
+static bool IsSynthesizedLocalName(WCHAR *mdName, ULONG nameLen)
+{
+    return (nameLen > 1 && starts_with(mdName, W("<"))) ||
+           (nameLen > 4 && starts_with(mdName, W("CS$<")));
+}
+
+// Note, DebuggerBrowsableAttribute check is part of members table build, since it's expensive (custom attributes enumeration
+// and names resolve for each property) and can't be changed without metadata change.
+static bool IsDebuggerBrowsableNever(IMetaDataImport *pMD, mdProperty propertyDef)
+{
+    // https://github.sec.samsung.net/dotnet/coreclr/blob/9df87a133b0f29f4932f38b7307c87d09ab80d5d/src/System.Private.CoreLib/shared/System/Diagnostics/DebuggerBrowsableAttribute.cs#L17
+    // Since we check only first byte, no reason store it as int (default enum type in c#)
+    enum DebuggerBrowsableState : char
+    {
+        Never = 0,
+        Expanded = 1, 
+        Collapsed = 2,
+        RootHidden = 3
+    };
+
+    const char *g_DebuggerBrowsable = "System.Diagnostics.DebuggerBrowsableAttribute..ctor";
+    bool debuggerBrowsableState_Never = false;
+
+    ULONG numAttributes = 0;
+    HCORENUM hEnum = NULL;
+    mdCustomAttribute attr;
+    while(SUCCEEDED(pMD->EnumCustomAttributes(&hEnum, propertyDef, 0, &attr, 1, &numAttributes)) && numAttributes != 0)
+    {
+        mdToken ptkObj = mdTokenNil;
+        mdToken ptkType = mdTokenNil;
+        void const *ppBlob = 0;
+        ULONG pcbSize = 0;
+        if (FAILED(pMD->GetCustomAttributeProps(attr, &ptkObj, &ptkType, &ppBlob, &pcbSize)))
+            continue;
+
+        std::string mdName;
+        if (FAILED(TypePrinter::NameForToken(ptkType, pMD, mdName, true, nullptr)))
+            continue;
+
+        if (mdName == g_DebuggerBrowsable
+            // In case of DebuggerBrowsableAttribute blob is 8 bytes:
+            // 2 bytes - blob prolog 0x0001
+            // 4 bytes - data (DebuggerBrowsableAttribute::State), default enum type (int)
+            // 2 bytes - alignment
+            // We check only one byte (first data byte), no reason check 4 bytes in our case.
+            && pcbSize > 2
+            && ((char const *)ppBlob)[2] == DebuggerBrowsableState::Never)
+        {
+            debuggerBrowsableState_Never = true;
+            break;
+        }
+    }
+    pMD->CloseEnum(hEnum);
+
+    return debuggerBrowsableState_Never;
+}
+
+// Compiler generated auto-property getter IL is `ldarg.0; ldfld <backing field>; ret` for instance property and
+// `ldsfld <backing field>; ret` for static property.
+static bool IsAutoPropertyGetter(ICorDebugModule *pModule, IMetaDataImport *pMD, mdMethodDef getter, bool isStatic,
+                                 mdFieldDef backingField, const std::string &backingFieldName)
+{
+    static const BYTE CEE_LDARG_0 = 0x02;
+    static const BYTE CEE_LDFLD = 0x7B;
+    static const BYTE CEE_LDSFLD = 0x7E;
+    static const BYTE CEE_RET = 0x2A;
+
+    ToRelease<ICorDebugFunction> iCorFunction;
+    ToRelease<ICorDebugCode> iCorCode;
+    ULONG32 codeSize = 0;
+    const ULONG32 expectedSize = isStatic ? 6 : 7;
+    if (FAILED(pModule->GetFunctionFromToken(getter, &iCorFunction)) ||
+        FAILED(iCorFunction->GetILCode(&iCorCode)) ||
+        FAILED(iCorCode->GetSize(&codeSize)) ||
+        codeSize != expectedSize)
+        return false;
+
+    BYTE code[7];
+    ULONG32 fetched = 0;
+    if (FAILED(iCorCode->GetCode(0, codeSize, codeSize, code, &fetched)) || fetched != codeSize)
+        return false;
+
+    const BYTE *pCode = code;
+    if (isStatic)
+    {
+        if (*pCode++ != CEE_LDSFLD)
+            return false;
+    }
+    else if (*pCode++ != CEE_LDARG_0 || *pCode++ != CEE_LDFLD)
+        return false;
+
+    const mdToken fieldToken = pCode[0] | (pCode[1] << 8) | (pCode[2] << 16) | (mdToken(pCode[3]) << 24);
+    if (pCode[4] != CEE_RET)
+        return false;
+
+    if (fieldToken == backingField)
+        return true;
+
+    // Note, fields of generic types are accessed by member reference to instantiated type.
+    if (TypeFromToken(fieldToken) != mdtMemberRef)
+        return false;
+
+    ULONG nameLen = 0;
+    WCHAR mdName[mdNameLen] = {0};
+    if (FAILED(pMD->GetMemberRefProps(fieldToken, nullptr, mdName, _countof(mdName), &nameLen, nullptr, nullptr)))
+        return false;
+
+    return to_utf8(mdName) == backingFieldName;
+}
+
+namespace
+{
+
+// Methods with bigger IL code are not interpreted, since most likely contain not supported instructions.
+const ULONG32 InterpreterCodeSizeLimit = 256;
+
+// Get same module method IL code and signature data, generic and `void` methods are not supported.
+bool GetInterpretableMethod(ICorDebugModule *pModule, IMetaDataImport *pMD, mdToken methodToken, bool virtualCall,
+                            std::vector<uint8_t> &code, unsigned &argsCount, CorElementType &returnType)
+{
+    if (TypeFromToken(methodToken) != mdtMethodDef)
+        return false;
+
+    DWORD methodAttr = 0;
+    PCCOR_SIGNATURE pSig = nullptr;
+    ULONG sigSize = 0;
+    if (FAILED(pMD->GetMethodProps(methodToken, nullptr, nullptr, 0, nullptr, &methodAttr, &pSig, &sigSize, nullptr, nullptr)))
+        return false;
+
+    // Note, virtual method could be overridden in derived type, real method should be resolved by runtime.
+    if (virtualCall && (methodAttr & mdVirtual) && !(methodAttr & mdFinal))
+        return false;
+
+    ULONG callConv = 0;
+    ULONG paramsCount = 0;
+    ULONG elementType = 0;
+    pSig += CorSigUncompressData(pSig, &callConv);
+    if (callConv & (SIG_METHOD_GENERIC | SIG_METHOD_VARARG))
+        return false;
+    pSig += CorSigUncompressData(pSig, &paramsCount);
+    CorSigUncompressData(pSig, &elementType);
+    returnType = (CorElementType)elementType;
+    if (returnType == ELEMENT_TYPE_VOID)
+        return false;
+    argsCount = paramsCount + ((callConv & IMAGE_CEE_CS_CALLCONV_HASTHIS) ? 1 : 0);
+
+    ToRelease<ICorDebugFunction> iCorFunction;
+    ToRelease<ICorDebugCode> iCorCode;
+    ULONG32 codeSize = 0;
+    if (FAILED(pModule->GetFunctionFromToken(methodToken, &iCorFunction)) ||
+        FAILED(iCorFunction->GetILCode(&iCorCode)) ||
+        FAILED(iCorCode->GetSize(&codeSize)) ||
+        codeSize == 0 || codeSize > InterpreterCodeSizeLimit)
+        return false;
+
+    code.resize(codeSize);
+    ULONG32 fetched = 0;
+    return SUCCEEDED(iCorCode->GetCode(0, codeSize, codeSize, code.data(), &fetched)) && fetched == codeSize;
+}
+
+// Debuggee data access for interpreter, debuggee values are stored as object handles during interpretation.
+class InterpreterContext : public ILInterpreter::IContext
+{
+public:
+
+    InterpreterContext(ICorDebugModule *pModule, IMetaDataImport *pMD, ICorDebugThread *pThread, FrameLevel frameLevel) :
+        m_pModule(pModule),
+        m_pMD(pMD),
+        m_pThread(pThread),
+        m_frameLevel(frameLevel)
+    {}
+
+    size_t AddObject(ICorDebugValue *pValue)
+    {
+        pValue->AddRef();
+        m_objects.emplace_back(pValue);
+        return m_objects.size() - 1;
+    }
+
+    ICorDebugValue *GetObjectValue(size_t handle)
+    {
+        return m_objects[handle].GetPtr();
+    }
+
+    bool LoadField(const ILInterpreter::value_t &object, uint32_t fieldToken, ILInterpreter::value_t &result) override
+    {
+        DWORD fieldAttr = 0;
+        ToRelease<ICorDebugClass> iCorClass;
+        if (!GetFieldClass(fieldToken, fieldAttr, &iCorClass) || (fieldAttr & fdStatic))
+            return false;
+
+        BOOL isNull = FALSE;
+        ToRelease<ICorDebugValue> iCorValue;
+        ToRelease<ICorDebugObjectValue> iCorObjectValue;
+        ToRelease<ICorDebugValue> iCorFieldValue;
+        if (FAILED(DereferenceAndUnboxValue(GetObjectValue(object.object), &iCorValue, &isNull)) || isNull ||
+            FAILED(iCorValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &iCorObjectValue)) ||
+            FAILED(iCorObjectValue->GetFieldValue(iCorClass, fieldToken, &iCorFieldValue)))
+            return false;
+
+        return ReadValue(iCorFieldValue, result);
+    }
+
+    bool LoadStaticField(uint32_t fieldToken, ILInterpreter::value_t &result) override
+    {
+        DWORD fieldAttr = 0;
+        ToRelease<ICorDebugClass> iCorClass;
+        // Note, literal fields don't have storage and must not be accessed by IL code.
+        if (!GetFieldClass(fieldToken, fieldAttr, &iCorClass) || !(fieldAttr & fdStatic) || (fieldAttr & fdLiteral))
+            return false;
+
+        ToRelease<ICorDebugFrame> iCorFrame;
+        ToRelease<ICorDebugValue> iCorFieldValue;
+        // Note, static field is not available in case static constructor was not called yet.
+        if (FAILED(GetFrameAt(m_pThread, m_frameLevel, &iCorFrame)) || iCorFrame == nullptr ||
+            FAILED(iCorClass->GetStaticFieldValue(fieldToken, iCorFrame, &iCorFieldValue)))
+            return false;
+
+        return ReadValue(iCorFieldValue, result);
+    }
+
+    bool GetMethod(uint32_t methodToken, bool virtualCall, std::vector<uint8_t> &code, unsigned &argsCount) override
+    {
+        CorElementType returnType;
+        return GetInterpretableMethod(m_pModule, m_pMD, methodToken, virtualCall, code, argsCount, returnType);
+    }
+
+private:
+
+    ICorDebugModule *m_pModule;
+    IMetaDataImport *m_pMD;
+    ICorDebugThread *m_pThread;
+    FrameLevel m_frameLevel;
+    std::vector<ToRelease<ICorDebugValue>> m_objects;
+
+    // Note, generic types fields are accessed by member reference and not supported.
+    bool GetFieldClass(uint32_t fieldToken, DWORD &fieldAttr, ICorDebugClass **ppClass)
+    {
+        mdTypeDef typeDef = mdTypeDefNil;
+        return TypeFromToken(fieldToken) == mdtFieldDef &&
+               SUCCEEDED(m_pMD->GetFieldProps(fieldToken, &typeDef, nullptr, 0, nullptr, &fieldAttr,
+                                              nullptr, nullptr, nullptr, nullptr, nullptr)) &&
+               SUCCEEDED(m_pModule->GetClassFromToken(typeDef, ppClass));
+    }
+
+    bool ReadValue(ICorDebugValue *pValue, ILInterpreter::value_t &result)
+    {
+        CorElementType corType;
+        if (FAILED(pValue->GetType(&corType)))
+            return false;
+
+        if (corType == ELEMENT_TYPE_CLASS || corType == ELEMENT_TYPE_VALUETYPE || corType == ELEMENT_TYPE_STRING ||
+            corType == ELEMENT_TYPE_SZARRAY || corType == ELEMENT_TYPE_ARRAY || corType == ELEMENT_TYPE_OBJECT ||
+            corType == ELEMENT_TYPE_GENERICINST)
+        {
+            BOOL isNull = FALSE;
+            ToRelease<ICorDebugValue> iCorValue;
+            if (FAILED(DereferenceAndUnboxValue(pValue, &iCorValue, &isNull)) || isNull)
+                return false;
+
+            result = ILInterpreter::value_t::FromObject(AddObject(pValue));
+            return true;
+        }
+
+        ToRelease<ICorDebugGenericValue> iCorGenericValue;
+        ULONG32 size = 0;
+        uint64_t data = 0;
+        if (FAILED(pValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &iCorGenericValue)) ||
+            FAILED(pValue->GetSize(&size)) || size > sizeof(data) ||
+            FAILED(iCorGenericValue->GetValue(&data)))
+            return false;
+
+        switch (corType)
+        {
+            case ELEMENT_TYPE_BOOLEAN:
+            case ELEMENT_TYPE_U1: result = ILInterpreter::value_t::FromInt32(*(uint8_t*)&data); return true;
+            case ELEMENT_TYPE_I1: result = ILInterpreter::value_t::FromInt32(*(int8_t*)&data); return true;
+            case ELEMENT_TYPE_CHAR:
+            case ELEMENT_TYPE_U2: result = ILInterpreter::value_t::FromInt32(*(uint16_t*)&data); return true;
+            case ELEMENT_TYPE_I2: result = ILInterpreter::value_t::FromInt32(*(int16_t*)&data); return true;
+            case ELEMENT_TYPE_I4:
+            case ELEMENT_TYPE_U4: result = ILInterpreter::value_t::FromInt32(*(int32_t*)&data); return true;
+            case ELEMENT_TYPE_I8:
+            case ELEMENT_TYPE_U8: result = ILInterpreter::value_t::FromInt64(*(int64_t*)&data); return true;
+            case ELEMENT_TYPE_R4: result = ILInterpreter::value_t::FromDouble(*(float*)&data); return true;
+            case ELEMENT_TYPE_R8: result = ILInterpreter::value_t::FromDouble(*(double*)&data); return true;
+            default: return false;
+        }
+    }
+};
+
+// Interpret simple property getter (like `return _a + _b;`) without debuggee code execution.
+HRESULT InterpretGetter(ICorDebugModule *pModule, IMetaDataImport *pMD, ICorDebugThread *pThread, FrameLevel frameLevel,
+                        mdMethodDef getter, ICorDebugValue *pThisValue, ICorDebugValue **ppResultValue)
+{
+    HRESULT Status;
+    std::vector<uint8_t> code;
+    unsigned argsCount = 0;
+    CorElementType returnType;
+    // Note, getter is called virtually (same as func-eval do), overridable getters are not interpreted.
+    if (!GetInterpretableMethod(pModule, pMD, getter, true, code, argsCount, returnType) ||
+        argsCount != (pThisValue ? 1 : 0))
+        return E_FAIL;
+
+    InterpreterContext context(pModule, pMD, pThread, frameLevel);
+    std::vector<ILInterpreter::value_t> args;
+    if (pThisValue)
+        args.emplace_back(ILInterpreter::value_t::FromObject(context.AddObject(pThisValue)));
+
+    ILInterpreter interpreter(context);
+    ILInterpreter::value_t result;
+    if (!interpreter.Execute(code, args, result))
+        return E_FAIL;
+
+    if (result.kind == ILInterpreter::value_t::Object)
+    {
+        // Note, object handle could be returned only for reference or value type return type.
+        if (returnType != ELEMENT_TYPE_CLASS && returnType != ELEMENT_TYPE_VALUETYPE && returnType != ELEMENT_TYPE_STRING &&
+            returnType != ELEMENT_TYPE_SZARRAY && returnType != ELEMENT_TYPE_ARRAY && returnType != ELEMENT_TYPE_OBJECT &&
+            returnType != ELEMENT_TYPE_GENERICINST)
+            return E_FAIL;
+
+        *ppResultValue = context.GetObjectValue(result.object);
+        (*ppResultValue)->AddRef();
+        return S_OK;
+    }
+
+    union
+    {
+        uint8_t u1;
+        uint16_t u2;
+        uint32_t u4;
+        uint64_t u8;
+        float r4;
+        double r8;
+    } data;
+    data.u8 = 0;
+
+    switch (returnType)
+    {
+        case ELEMENT_TYPE_BOOLEAN:
+        case ELEMENT_TYPE_I1:
+        case ELEMENT_TYPE_U1:
+            if (result.kind != ILInterpreter::value_t::Int32)
+                return E_FAIL;
+            data.u1 = uint8_t(result.i);
+            break;
+        case ELEMENT_TYPE_CHAR:
+        case ELEMENT_TYPE_I2:
+        case ELEMENT_TYPE_U2:
+            if (result.kind != ILInterpreter::value_t::Int32)
+                return E_FAIL;
+            data.u2 = uint16_t(result.i);
+            break;
+        case ELEMENT_TYPE_I4:
+        case ELEMENT_TYPE_U4:
+            if (result.kind != ILInterpreter::value_t::Int32)
+                return E_FAIL;
+            data.u4 = uint32_t(result.i);
+            break;
+        case ELEMENT_TYPE_I8:
+        case ELEMENT_TYPE_U8:
+            if (result.kind != ILInterpreter::value_t::Int64)
+                return E_FAIL;
+            data.u8 = uint64_t(result.i);
+            break;
+        case ELEMENT_TYPE_R4:
+            if (result.kind != ILInterpreter::value_t::Double)
+                return E_FAIL;
+            data.r4 = float(result.d);
+            break;
+        case ELEMENT_TYPE_R8:
+            if (result.kind != ILInterpreter::value_t::Double)
+                return E_FAIL;
+            data.r8 = result.d;
+            break;
+        default:
+            return E_FAIL;
+    }
+
+    // Note, value creation don't execute debuggee code.
+    ToRelease<ICorDebugEval> iCorEval;
+    IfFailRet(pThread->CreateEval(&iCorEval));
+    IfFailRet(iCorEval->CreateValue(returnType, nullptr, ppResultValue));
+    ToRelease<ICorDebugGenericValue> iCorGenericValue;
+    IfFailRet((*ppResultValue)->QueryInterface(IID_ICorDebugGenericValue, (LPVOID *) &iCorGenericValue));
+    return iCorGenericValue->SetValue(&data);
+}
+
+} // unnamed namespace
+
+static HRESULT GetTypeMembers(TypeMembersCache *pTypeMembersCache, ICorDebugModule *pModule, mdTypeDef currentTypeDef,
+                              TypeMembersCache::members_ptr_t &members)
+{
+    HRESULT Status;
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+    members = pTypeMembersCache->GetMembers(modAddress, currentTypeDef);
+    if (members)
+        return S_OK;
+
+    std::shared_ptr<TypeMembersCache::members_t> newMembers(new TypeMembersCache::members_t);
+    ToRelease<IUnknown> pMDUnknown;
+    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &newMembers->pMD));
+    IMetaDataImport *pMD = newMembers->pMD.GetPtr();
+
+    static const char CompilerGeneratedAttribute[] = "System.Runtime.CompilerServices.CompilerGeneratedAttribute..ctor";
+    // Hidden auto-properties backing fields, field name -> field token.
+    std::unordered_map<std::string, mdFieldDef> backingFields;
+
+    IfFailRet(ForEachFields(pMD, currentTypeDef, [&](mdFieldDef fieldDef) -> HRESULT
+    {
+        ULONG nameLen = 0;
+        DWORD fieldAttr = 0;
+        WCHAR mdName[mdNameLen] = {0};
+        PCCOR_SIGNATURE pSignatureBlob = nullptr;
+        ULONG sigBlobLength = 0;
+        UVCP_CONSTANT pRawValue = nullptr;
+        ULONG rawValueLength = 0;
+        if (FAILED(pMD->GetFieldProps(fieldDef, nullptr, mdName, _countof(mdName), &nameLen, &fieldAttr,
+                                      &pSignatureBlob, &sigBlobLength, nullptr, &pRawValue, &rawValueLength)))
+            return S_OK;
+
+        // Prevent access to internal compiler added fields (without visible name).
+        // Should be accessed by debugger routine only and hidden from user/ide.
+        // More about compiler generated names in Roslyn sources:
+        // https://github.com/dotnet/roslyn/blob/315c2e149ba7889b0937d872274c33fcbfe9af5f/src/Compilers/CSharp/Portable/Symbols/Synthesized/GeneratedNames.cs
+        // Note, uncontrolled access to internal compiler added field or its properties may break debugger work.
+        if (IsSynthesizedLocalName(mdName, nameLen))
+        {
+            std::string name = to_utf8(mdName);
+            if (name.find(">k__BackingField") != std::string::npos && HasAttribute(pMD, fieldDef, CompilerGeneratedAttribute))
+                backingFields.emplace(std::move(name), fieldDef);
+
+            return S_OK;
+        }
+
+        std::string name = to_utf8(mdName);
+        newMembers->fieldsByName[name].emplace_back(newMembers->fields.size());
+        newMembers->fields.emplace_back(TypeMembersCache::field_t{fieldDef, std::move(name), fieldAttr,
+                                                                  pSignatureBlob, sigBlobLength, pRawValue, rawValueLength});
+        return S_OK;
+    }));
+    IfFailRet(ForEachProperties(pMD, currentTypeDef, [&](mdProperty propertyDef) -> HRESULT
+    {
+        mdTypeDef  propertyClass;
+
+        ULONG propertyNameLen = 0;
+        UVCP_CONSTANT pDefaultValue;
+        ULONG cchDefaultValue;
+        mdMethodDef mdGetter;
+        mdMethodDef mdSetter;
+        WCHAR propertyName[mdNameLen] = W("\0");
+        if (FAILED(pMD->GetPropertyProps(propertyDef, &propertyClass, propertyName, _countof(propertyName),
+                                         &propertyNameLen, nullptr, nullptr, nullptr, nullptr, &pDefaultValue,
+                                         &cchDefaultValue, &mdSetter, &mdGetter, nullptr, 0, nullptr)))
+            return S_OK;
+
+        DWORD getterAttr = 0;
+        if (FAILED(pMD->GetMethodProps(mdGetter, NULL, NULL, 0, NULL, &getterAttr, NULL, NULL, NULL, NULL)))
+            return S_OK;
+
+        if (IsDebuggerBrowsableNever(pMD, propertyDef))
+            return S_OK;
+
+        std::string name = to_utf8(propertyName);
+        const bool isStatic = (getterAttr & mdStatic) != 0;
+        mdFieldDef backingField = mdFieldDefNil;
+        // Note, overridable virtual auto-property could be overridden in derived type, getter must be called in this case.
+        const bool overridable = (getterAttr & mdVirtual) && !(getterAttr & mdFinal);
+        auto findField = overridable ? backingFields.end() : backingFields.find("<" + name + ">k__BackingField");
+        if (findField != backingFields.end() &&
+            IsAutoPropertyGetter(pModule, pMD, mdGetter, isStatic, findField->second, findField->first))
+            backingField = findField->second;
+
+        newMembers->propertiesByName[name].emplace_back(newMembers->properties.size());
+        newMembers->properties.emplace_back(TypeMembersCache::property_t{std::move(name), mdGetter, mdSetter, isStatic, backingField});
+        return S_OK;
+    }));
+
+    members = newMembers;
+    pTypeMembersCache->PutMembers(modAddress, currentTypeDef, members);
+    return S_OK;
+}
+
+static HRESULT InternalWalkArrayElements(ICorDebugArrayValue *pArrayValue, ULONG32 start, ULONG32 end, Evaluator::WalkMembersCallback cb)
+{
+    HRESULT Status;
+    ULONG32 nRank;
+    IfFailRet(pArrayValue->GetRank(&nRank));
+
+    ULONG32 cElements;
+    IfFailRet(pArrayValue->GetCount(&cElements));
+
+    if (end > cElements)
+        end = cElements;
+    if (start >= end)
+        return S_OK;
+
+    std::vector<ULONG32> dims(nRank, 0);
+    IfFailRet(pArrayValue->GetDimensions(nRank, &dims[0]));
+
+    std::vector<ULONG32> base(nRank, 0);
+    BOOL hasBaseIndicies = FALSE;
+    if (SUCCEEDED(pArrayValue->HasBaseIndicies(&hasBaseIndicies)) && hasBaseIndicies)
+        IfFailRet(pArrayValue->GetBaseIndicies(nRank, &base[0]));
+
+    std::vector<ULONG32> ind(nRank, 0);
+    PositionToIndicies(start, dims, ind);
+
+    for (ULONG32 i = start; i < end; ++i)
+    {
+        auto getValue = [&](ICorDebugValue **ppResultValue, int) -> HRESULT
+        {
+            IfFailRet(pArrayValue->GetElementAtPosition(i, ppResultValue));
+            return S_OK;
+        };
+
+        IfFailRet(cb(nullptr, false, "[" + IndiciesToStr(ind, base) + "]", getValue, nullptr));
+        IncIndicies(ind, dims);
+    }
+
+    return S_OK;
+}
+
+// Return S_FALSE in case value is not array (or null).
+static HRESULT GetArrayValue(ICorDebugValue *pInputValue, ICorDebugArrayValue **ppArrayValue)
+{
+    HRESULT Status;
+    CorElementType inputCorType;
+    IfFailRet(pInputValue->GetType(&inputCorType));
+    if (inputCorType == ELEMENT_TYPE_PTR)
+        return S_FALSE;
+
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (!pValue.GetPtr())
+        return S_FALSE;
+
+    if (FAILED(pValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID *) ppArrayValue)))
+        return S_FALSE;
 
     return S_OK;
 }
 
-HRESULT Evaluator::WalkMethods(ICorDebugType *pInputType, ICorDebugType **ppResultType, std::vector<Evaluator::ArgElementType> &methodGenerics, Evaluator::WalkMethodsCallback cb)
+HRESULT Evaluator::GetArrayElementsCount(ICorDebugValue *pValue, ULONG32 &count)
 {
-    return InternalWalkMethods(pInputType, ppResultType, methodGenerics, cb);
-}
+    HRESULT Status;
+    ToRelease<ICorDebugArrayValue> pArrayValue;
+    IfFailRet(GetArrayValue(pValue, &pArrayValue));
+    if (Status == S_FALSE)
+    {
+        EvalIntrinsics::ElementsView view;
+        if (EvalIntrinsics::GetElementsView(pValue, view) != S_OK)
+            return EvalIntrinsics::GetHashItemsCount(pValue, count);
 
-static HRESULT InternalSetValue(EvalStackMachine *pEvalStackMachine, EvalHelpers *pEvalHelpers, ICorDebugThread *pThread, FrameLevel frameLevel,
-                                ICorDebugValue *pValue, Evaluator::SetterData *setterData, const std::string &value, int evalFlags, std::string &output)
-{
-    if (!pThread)
-        return E_FAIL;
+        count = view.length;
+        return S_OK;
+    }
 
-    // In case this is not property, just change value itself.
-    if (!setterData)
-        return pEvalStackMachine->SetValueByExpression(pThread, frameLevel, evalFlags, pValue, value, output);
+    return pArrayValue->GetCount(&count);
+}
 
+static HRESULT InternalWalkViewElements(const EvalIntrinsics::ElementsView &view, ULONG32 start, ULONG32 end, Evaluator::WalkMembersCallback cb)
+{
     HRESULT Status;
-    pValue->AddRef();
-    ToRelease<ICorDebugValue> iCorValue(pValue);
-    CorElementType corType;
-    IfFailRet(iCorValue->GetType(&corType));
+    if (end > view.length)
+        end = view.length;
 
-    if (corType == ELEMENT_TYPE_STRING)
+    for (ULONG32 i = start; i < end; ++i)
     {
-        // FIXME investigate, why in this case we can't use ICorDebugReferenceValue::SetValue() for string in iCorValue
-        iCorValue.Free();
-        IfFailRet(pEvalStackMachine->EvaluateExpression(pThread, frameLevel, evalFlags, value, &iCorValue, output));
+        auto getValue = [&](ICorDebugValue **ppResultValue, int) -> HRESULT
+        {
+            return EvalIntrinsics::GetViewElement(view, i, ppResultValue);
+        };
 
-        CorElementType elemType;
-        IfFailRet(iCorValue->GetType(&elemType));
-        if (elemType != ELEMENT_TYPE_STRING)
-            return E_INVALIDARG;
-    }
-    else // Allow stack machine decide what types are supported.
-    {
-        IfFailRet(pEvalStackMachine->SetValueByExpression(pThread, frameLevel, evalFlags, iCorValue.GetPtr(), value, output));
+        IfFailRet(cb(nullptr, false, "[" + std::to_string(i) + "]", getValue, nullptr));
     }
 
-    // Call setter.
-    if (!setterData->thisValue)
-    {
-        return pEvalHelpers->EvalFunction(pThread, setterData->setterFunction, setterData->propertyType.GetRef(), 1, iCorValue.GetRef(), 1, nullptr, evalFlags);
-    }
-    else
-    {
-        ICorDebugValue *ppArgsValue[] = {setterData->thisValue, iCorValue};
-        return pEvalHelpers->EvalFunction(pThread, setterData->setterFunction, setterData->propertyType.GetRef(), 1, ppArgsValue, 2, nullptr, evalFlags);
-    }
+    return S_OK;
 }
 
-HRESULT Evaluator::SetValue(ICorDebugThread *pThread, FrameLevel frameLevel, ICorDebugValue *pValue,
-                            SetterData *setterData, const std::string &value, int evalFlags, std::string &output)
+// Dictionary items are named by printed key (`[key]`), HashSet<T> items by index.
+static HRESULT InternalWalkHashItems(ICorDebugValue *pValue, ULONG32 start, ULONG32 end, Evaluator::WalkMembersCallback cb)
 {
-    return InternalSetValue(m_sharedEvalStackMachine.get(), m_sharedEvalHelpers.get(), pThread, frameLevel, pValue, setterData, value, evalFlags, output);
+    ULONG32 index = start;
+    HRESULT Status = EvalIntrinsics::WalkHashItems(pValue, start, end, [&](ICorDebugValue *pKey, ICorDebugValue *pItemValue) -> HRESULT
+    {
+        ICorDebugValue *pResult = pItemValue ? pItemValue : pKey;
+        auto getValue = [&](ICorDebugValue **ppResultValue, int) -> HRESULT
+        {
+            pResult->AddRef();
+            *ppResultValue = pResult;
+            return S_OK;
+        };
+
+        std::string name;
+        if (!pItemValue || FAILED(PrintValue(pKey, name)))
+            name = std::to_string(index);
+        index++;
+
+        return cb(nullptr, false, "[" + name + "]", getValue, nullptr);
+    });
+
+    return Status == S_FALSE ? E_INVALIDARG : Status;
 }
 
-// https://github.com/dotnet/roslyn/blob/d1e617ded188343ba43d24590802dd51e68e8e32/src/Compilers/CSharp/Portable/Symbols/Synthesized/GeneratedNameParser.cs#L13
-static bool IsSynthesizedLocalName(WCHAR *mdName, ULONG nameLen)
+HRESULT Evaluator::WalkArrayElements(ICorDebugValue *pValue, ULONG32 start, ULONG32 end, WalkMembersCallback cb)
 {
-    return (nameLen > 1 && starts_with(mdName, W("<"))) ||
-           (nameLen > 4 && starts_with(mdName, W("CS$<")));
+    HRESULT Status;
+    ToRelease<ICorDebugArrayValue> pArrayValue;
+    IfFailRet(GetArrayValue(pValue, &pArrayValue));
+    if (Status == S_FALSE)
+    {
+        EvalIntrinsics::ElementsView view;
+        if (EvalIntrinsics::GetElementsView(pValue, view) != S_OK)
+            return InternalWalkHashItems(pValue, start, end, cb);
+
+        return InternalWalkViewElements(view, start, end, cb);
+    }
+
+    return InternalWalkArrayElements(pArrayValue, start, end, cb);
 }
 
-static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, ICorDebugValue *pInputValue, ICorDebugThread *pThread, FrameLevel frameLevel,
-                                   ICorDebugType *pTypeCast, bool provideSetterData, Evaluator::WalkMembersCallback cb)
+// Note, in case memberName is not empty, only members with this name will be provided to callback for type fields and properties.
+static HRESULT InternalWalkMembers(TypeMembersCache *pTypeMembersCache, EvalHelpers *pEvalHelpers, ICorDebugValue *pInputValue, ICorDebugThread *pThread,
+                                   FrameLevel frameLevel, ICorDebugType *pTypeCast, bool provideSetterData, Evaluator::WalkMembersCallback cb,
+                                   const std::string &memberName = std::string())
 {
     HRESULT Status = S_OK;
 
@@ -696,35 +1587,9 @@ static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, ICorDebugValue *pI
     ToRelease<ICorDebugArrayValue> pArrayValue;
     if (SUCCEEDED(pValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID *) &pArrayValue)))
     {
-        ULONG32 nRank;
-        IfFailRet(pArrayValue->GetRank(&nRank));
-
         ULONG32 cElements;
         IfFailRet(pArrayValue->GetCount(&cElements));
-
-        std::vector<ULONG32> dims(nRank, 0);
-        IfFailRet(pArrayValue->GetDimensions(nRank, &dims[0]));
-
-        std::vector<ULONG32> base(nRank, 0);
-        BOOL hasBaseIndicies = FALSE;
-        if (SUCCEEDED(pArrayValue->HasBaseIndicies(&hasBaseIndicies)) && hasBaseIndicies)
-            IfFailRet(pArrayValue->GetBaseIndicies(nRank, &base[0]));
-
-        std::vector<ULONG32> ind(nRank, 0);
-
-        for (ULONG32 i = 0; i < cElements; ++i)
-        {
-            auto getValue = [&](ICorDebugValue **ppResultValue, int) -> HRESULT
-            {
-                IfFailRet(pArrayValue->GetElementAtPosition(i, ppResultValue));
-                return S_OK;
-            };
-
-            IfFailRet(cb(nullptr, false, "[" + IndiciesToStr(ind, base) + "]", getValue, nullptr));
-            IncIndicies(ind, dims);
-        }
-
-        return S_OK;
+        return InternalWalkArrayElements(pArrayValue, 0, cElements, cb);
     }
 
     ToRelease<ICorDebugValue2> pValue2;
@@ -741,9 +1606,7 @@ static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, ICorDebugValue *pI
         pType = pTypeCast;
     }
 
-    std::string className;
-    TypePrinter::GetTypeOfValue(pType, className);
-    if (className == "decimal") // TODO: implement mechanism for walking over custom type fields
+    if (WellKnownTypes::IsType(pType, WellKnownTypes::Type::Decimal)) // TODO: implement mechanism for walking over custom type fields
         return S_OK;
 
     CorElementType corElemType;
@@ -757,179 +1620,140 @@ static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, ICorDebugValue *pI
     IfFailRet(pClass->GetModule(&pModule));
     mdTypeDef currentTypeDef;
     IfFailRet(pClass->GetToken(&currentTypeDef));
-    ToRelease<IUnknown> pMDUnknown;
-    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
-    ToRelease<IMetaDataImport> pMD;
-    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
-    IfFailRet(ForEachFields(pMD, currentTypeDef, [&](mdFieldDef fieldDef) -> HRESULT
+    TypeMembersCache::members_ptr_t members;
+    IfFailRet(GetTypeMembers(pTypeMembersCache, pModule, currentTypeDef, members));
+
+    auto getFieldValue = [&](mdFieldDef fieldDef, bool is_static, ICorDebugValue **ppResultValue) -> HRESULT
     {
-        ULONG nameLen = 0;
-        DWORD fieldAttr = 0;
-        WCHAR mdName[mdNameLen] = {0};
-        PCCOR_SIGNATURE pSignatureBlob = nullptr;
-        ULONG sigBlobLength = 0;
-        UVCP_CONSTANT pRawValue = nullptr;
-        ULONG rawValueLength = 0;
-        if (SUCCEEDED(pMD->GetFieldProps(fieldDef, nullptr, mdName, _countof(mdName), &nameLen, &fieldAttr,
-                                         &pSignatureBlob, &sigBlobLength, nullptr, &pRawValue, &rawValueLength)))
+        if (is_static)
         {
-            // Prevent access to internal compiler added fields (without visible name).
-            // Should be accessed by debugger routine only and hidden from user/ide.
-            // More about compiler generated names in Roslyn sources:
-            // https://github.com/dotnet/roslyn/blob/315c2e149ba7889b0937d872274c33fcbfe9af5f/src/Compilers/CSharp/Portable/Symbols/Synthesized/GeneratedNames.cs
-            // Note, uncontrolled access to internal compiler added field or its properties may break debugger work.
-            if (IsSynthesizedLocalName(mdName, nameLen))
-                return S_OK;
-
-            bool is_static = (fieldAttr & fdStatic);
-            if (isNull && !is_static)
-                return S_OK;
-
-            std::string name = to_utf8(mdName);
-
-            auto getValue = [&](ICorDebugValue **ppResultValue, int) -> HRESULT
-            {
-                if (fieldAttr & fdLiteral)
-                {
-                    IfFailRet(pEvalHelpers->GetLiteralValue(pThread, pType, pModule, pSignatureBlob, sigBlobLength, pRawValue, rawValueLength, ppResultValue));
-                }
-                else if (fieldAttr & fdStatic)
-                {
-                    if (!pThread)
-                        return E_FAIL;
-
-                    ToRelease<ICorDebugFrame> pFrame;
-                    IfFailRet(GetFrameAt(pThread, frameLevel, &pFrame));
+            if (!pThread)
+                return E_FAIL;
 
-                    if (pFrame == nullptr)
-                        return E_FAIL;
-
-                    IfFailRet(pType->GetStaticFieldValue(fieldDef, pFrame, ppResultValue));
-                }
-                else
-                {
-                    // Get pValue again, since it could be neutered at eval call in `cb` on previous cycle.
-                    pValue.Free();
-                    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
-                    ToRelease<ICorDebugObjectValue> pObjValue;
-                    IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &pObjValue));
-                    IfFailRet(pObjValue->GetFieldValue(pClass, fieldDef, ppResultValue));
-                }
+            ToRelease<ICorDebugFrame> pFrame;
+            IfFailRet(GetFrameAt(pThread, frameLevel, &pFrame));
 
-                return S_OK;
-            };
+            if (pFrame == nullptr)
+                return E_FAIL;
 
-            IfFailRet(cb(pType, is_static, name, getValue, nullptr));
+            IfFailRet(pType->GetStaticFieldValue(fieldDef, pFrame, ppResultValue));
+        }
+        else
+        {
+            // Get pValue again, since it could be neutered at eval call in `cb` on previous cycle.
+            pValue.Free();
+            IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+            ToRelease<ICorDebugObjectValue> pObjValue;
+            IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &pObjValue));
+            IfFailRet(pObjValue->GetFieldValue(pClass, fieldDef, ppResultValue));
         }
+
         return S_OK;
-    }));
-    IfFailRet(ForEachProperties(pMD, currentTypeDef, [&](mdProperty propertyDef) -> HRESULT
+    };
+
+    auto walkField = [&](const TypeMembersCache::field_t &field) -> HRESULT
     {
-        mdTypeDef  propertyClass;
+        bool is_static = (field.attr & fdStatic);
+        if (isNull && !is_static)
+            return S_OK;
 
-        ULONG propertyNameLen = 0;
-        UVCP_CONSTANT pDefaultValue;
-        ULONG cchDefaultValue;
-        mdMethodDef mdGetter;
-        mdMethodDef mdSetter;
-        WCHAR propertyName[mdNameLen] = W("\0");
-        if (SUCCEEDED(pMD->GetPropertyProps(propertyDef, &propertyClass, propertyName, _countof(propertyName),
-                                            &propertyNameLen, nullptr, nullptr, nullptr, nullptr, &pDefaultValue,
-                                            &cchDefaultValue, &mdSetter, &mdGetter, nullptr, 0, nullptr)))
+        auto getValue = [&](ICorDebugValue **ppResultValue, int) -> HRESULT
         {
-            DWORD getterAttr = 0;
-            if (FAILED(pMD->GetMethodProps(mdGetter, NULL, NULL, 0, NULL, &getterAttr, NULL, NULL, NULL, NULL)))
+            if (field.attr & fdLiteral)
+            {
+                IfFailRet(pEvalHelpers->GetLiteralValue(pThread, pType, pModule, field.pSignatureBlob, field.sigBlobLength,
+                                                        field.pRawValue, field.rawValueLength, ppResultValue));
                 return S_OK;
+            }
 
-            bool is_static = (getterAttr & mdStatic);
-            if (isNull && !is_static)
-                return S_OK;
+            return getFieldValue(field.fieldDef, is_static, ppResultValue);
+        };
 
-            // https://github.sec.samsung.net/dotnet/coreclr/blob/9df87a133b0f29f4932f38b7307c87d09ab80d5d/src/System.Private.CoreLib/shared/System/Diagnostics/DebuggerBrowsableAttribute.cs#L17
-            // Since we check only first byte, no reason store it as int (default enum type in c#)
-            enum DebuggerBrowsableState : char
-            {
-                Never = 0,
-                Expanded = 1, 
-                Collapsed = 2,
-                RootHidden = 3
-            };
+        return cb(pType, is_static, field.name, getValue, nullptr);
+    };
 
-            const char *g_DebuggerBrowsable = "System.Diagnostics.DebuggerBrowsableAttribute..ctor";
-            bool debuggerBrowsableState_Never = false;
+    auto walkProperty = [&](const TypeMembersCache::property_t &property) -> HRESULT
+    {
+        bool is_static = property.isStatic;
+        if (isNull && !is_static)
+            return S_OK;
 
-            ULONG numAttributes = 0;
-            HCORENUM hEnum = NULL;
-            mdCustomAttribute attr;
-            while(SUCCEEDED(pMD->EnumCustomAttributes(&hEnum, propertyDef, 0, &attr, 1, &numAttributes)) && numAttributes != 0)
-            {
-                mdToken ptkObj = mdTokenNil;
-                mdToken ptkType = mdTokenNil;
-                void const *ppBlob = 0;
-                ULONG pcbSize = 0;
-                if (FAILED(pMD->GetCustomAttributeProps(attr, &ptkObj, &ptkType, &ppBlob, &pcbSize)))
-                    continue;
+        auto getValue = [&](ICorDebugValue **ppResultValue, int evalFlags) -> HRESULT
+        {
+            if (!is_static && EvalIntrinsics::GetMember(pThread, pInputValue, property.name, ppResultValue) == S_OK)
+                return S_OK;
 
-                std::string mdName;
-                if (FAILED(TypePrinter::NameForToken(ptkType, pMD, mdName, true, nullptr)))
-                    continue;
+            // Note, auto-property value is read directly, so, it's available even if evaluation is not allowed.
+            if (property.backingField != mdFieldDefNil)
+                return getFieldValue(property.backingField, is_static, ppResultValue);
 
-                if (mdName == g_DebuggerBrowsable
-                    // In case of DebuggerBrowsableAttribute blob is 8 bytes:
-                    // 2 bytes - blob prolog 0x0001
-                    // 4 bytes - data (DebuggerBrowsableAttribute::State), default enum type (int)
-                    // 2 bytes - alignment
-                    // We check only one byte (first data byte), no reason check 4 bytes in our case.
-                    && pcbSize > 2
-                    && ((char const *)ppBlob)[2] == DebuggerBrowsableState::Never)
-                {
-                    debuggerBrowsableState_Never = true;
-                    break;
-                }
-            }
-            pMD->CloseEnum(hEnum);
+            if (!pThread)
+                return E_FAIL;
 
-            if (debuggerBrowsableState_Never)
+            // Note, simple getters are interpreted, evaluation in debuggee is used as fallback.
+            if (SUCCEEDED(InterpretGetter(pModule, members->pMD, pThread, frameLevel, property.getter,
+                                          is_static ? nullptr : pInputValue, ppResultValue)))
                 return S_OK;
 
-            std::string name = to_utf8(propertyName);
+            ToRelease<ICorDebugFunction> iCorFunc;
+            IfFailRet(pModule->GetFunctionFromToken(property.getter, &iCorFunc));
 
-            auto getValue = [&](ICorDebugValue **ppResultValue, int evalFlags) -> HRESULT
-            {
-                if (!pThread)
-                    return E_FAIL;
+            return pEvalHelpers->EvalFunction(pThread, iCorFunc, pType.GetRef(), 1, is_static ? nullptr : &pInputValue, is_static ? 0 : 1, ppResultValue, evalFlags);
+        };
 
-                ToRelease<ICorDebugFunction> iCorFunc;
-                IfFailRet(pModule->GetFunctionFromToken(mdGetter, &iCorFunc));
+        if (provideSetterData)
+        {
+            ToRelease<ICorDebugFunction> iCorFuncSetter;
+            if (FAILED(pModule->GetFunctionFromToken(property.setter, &iCorFuncSetter)))
+            {
+                iCorFuncSetter.Free();
+            }
+            Evaluator::SetterData setterData(is_static ? nullptr : pInputValue, pType, iCorFuncSetter);
+            setterData.autoProperty = property.backingField != mdFieldDefNil;
+            return cb(pType, is_static, property.name, getValue, &setterData);
+        }
 
-                return pEvalHelpers->EvalFunction(pThread, iCorFunc, pType.GetRef(), 1, is_static ? nullptr : &pInputValue, is_static ? 0 : 1, ppResultValue, evalFlags);
-            };
+        return cb(pType, is_static, property.name, getValue, nullptr);
+    };
 
-            if (provideSetterData)
+    if (memberName.empty())
+    {
+        for (const auto &field : members->fields)
+        {
+            IfFailRet(walkField(field));
+        }
+        for (const auto &property : members->properties)
+        {
+            IfFailRet(walkProperty(property));
+        }
+    }
+    else
+    {
+        auto findFields = members->fieldsByName.find(memberName);
+        if (findFields != members->fieldsByName.end())
+        {
+            for (size_t index : findFields->second)
             {
-                ToRelease<ICorDebugFunction> iCorFuncSetter;
-                if (FAILED(pModule->GetFunctionFromToken(mdSetter, &iCorFuncSetter)))
-                {
-                    iCorFuncSetter.Free();
-                }
-                Evaluator::SetterData setterData(is_static ? nullptr : pInputValue, pType, iCorFuncSetter);
-                IfFailRet(cb(pType, is_static, name, getValue, &setterData));
+                IfFailRet(walkField(members->fields[index]));
             }
-            else
+        }
+        auto findProperties = members->propertiesByName.find(memberName);
+        if (findProperties != members->propertiesByName.end())
+        {
+            for (size_t index : findProperties->second)
             {
-                IfFailRet(cb(pType, is_static, name, getValue, nullptr));
+                IfFailRet(walkProperty(members->properties[index]));
             }
         }
-        return S_OK;
-    }));
+    }
 
-    std::string baseTypeName;
     ToRelease<ICorDebugType> pBaseType;
-    if(SUCCEEDED(pType->GetBase(&pBaseType)) && pBaseType != NULL && SUCCEEDED(TypePrinter::GetTypeOfValue(pBaseType, baseTypeName)))
+    if(SUCCEEDED(pType->GetBase(&pBaseType)) && pBaseType != NULL)
     {
-        if(baseTypeName == "System.Enum")
+        if(WellKnownTypes::IsType(pBaseType, WellKnownTypes::Type::Enum))
             return S_OK;
-        else if (baseTypeName != "object" && baseTypeName != "System.Object" && baseTypeName != "System.ValueType")
+        else if (!WellKnownTypes::IsType(pBaseType, WellKnownTypes::Type::Object) &&
+                 !WellKnownTypes::IsType(pBaseType, WellKnownTypes::Type::ValueType))
         {
             if (pThread)
             {
@@ -937,7 +1761,7 @@ static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, ICorDebugValue *pI
                 IfFailRet(pEvalHelpers->CreatTypeObjectStaticConstructor(pThread, pBaseType));
             }
             // Add fields of base class
-            IfFailRet(InternalWalkMembers(pEvalHelpers, pInputValue, pThread, frameLevel, pBaseType, provideSetterData, cb));
+            IfFailRet(InternalWalkMembers(pTypeMembersCache, pEvalHelpers, pInputValue, pThread, frameLevel, pBaseType, provideSetterData, cb, memberName));
         }
     }
 
@@ -951,7 +1775,114 @@ HRESULT Evaluator::WalkMembers(
     bool provideSetterData,
     WalkMembersCallback cb)
 {
-    return InternalWalkMembers(m_sharedEvalHelpers.get(), pValue, pThread, frameLevel, nullptr, provideSetterData, cb);
+    return InternalWalkMembers(m_uniqueTypeMembersCache.get(), m_sharedEvalHelpers.get(), pValue, pThread, frameLevel, nullptr, provideSetterData, cb);
+}
+
+// Calculate offsets of instance fields of primitive types in value data. Note, runtime don't provide fields layout for
+// value type without object, so, field offset is calculated by field value address (once for exact type).
+static HRESULT GetValueTypeLayout(ICorDebugValue *pValue, ICorDebugClass *pClass, const TypeMembersCache::members_t &members,
+                                  TypeMembersCache::layout_t &layout)
+{
+    HRESULT Status;
+    IfFailRet(pValue->GetSize(&layout.size));
+    CORDB_ADDRESS address = 0;
+    IfFailRet(pValue->GetAddress(&address));
+    if (address == 0)
+        return S_FALSE; // value is not in memory (for example, enregistered)
+
+    ToRelease<ICorDebugObjectValue> pObjValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &pObjValue));
+
+    for (const auto &field : members.fields)
+    {
+        if (field.attr & (fdStatic | fdLiteral))
+            continue;
+
+        // Field signature: calling convention and single element type for primitive types.
+        PCCOR_SIGNATURE pSig = field.pSignatureBlob;
+        if (field.sigBlobLength != 2 || CorSigUncompressCallingConv(pSig) != IMAGE_CEE_CS_CALLCONV_FIELD)
+            continue;
+        CorElementType type = CorSigUncompressElementType(pSig);
+        const ULONG32 size = GetPrimitiveTypeSize(type);
+        if (size == 0)
+            continue;
+
+        ToRelease<ICorDebugValue> pFieldValue;
+        CORDB_ADDRESS fieldAddress = 0;
+        if (FAILED(pObjValue->GetFieldValue(pClass, field.fieldDef, &pFieldValue)) ||
+            FAILED(pFieldValue->GetAddress(&fieldAddress)) ||
+            fieldAddress < address || fieldAddress - address + size > layout.size)
+            return S_FALSE;
+
+        layout.fields.emplace(field.fieldDef, TypeMembersCache::field_layout_t{type, ULONG32(fieldAddress - address)});
+    }
+
+    return S_OK;
+}
+
+HRESULT Evaluator::WalkPrimitiveFields(ICorDebugValue *pInputValue, WalkPrimitiveFieldsCallback cb)
+{
+    HRESULT Status;
+    BOOL isNull = TRUE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (isNull)
+        return S_FALSE;
+
+    CorElementType corElemType;
+    IfFailRet(pValue->GetType(&corElemType));
+    if (corElemType != ELEMENT_TYPE_VALUETYPE)
+        return S_FALSE;
+
+    ToRelease<ICorDebugValue2> pValue2;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugValue2, (LPVOID *) &pValue2));
+    ToRelease<ICorDebugType> pType;
+    IfFailRet(pValue2->GetExactType(&pType));
+    if (WellKnownTypes::IsType(pType, WellKnownTypes::Type::Decimal))
+        return S_FALSE;
+
+    ToRelease<ICorDebugClass> pClass;
+    IfFailRet(pType->GetClass(&pClass));
+    ToRelease<ICorDebugModule> pModule;
+    IfFailRet(pClass->GetModule(&pModule));
+    mdTypeDef typeDef;
+    IfFailRet(pClass->GetToken(&typeDef));
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+    std::string typeName;
+    IfFailRet(TypePrinter::GetTypeOfValue(pType, typeName));
+
+    TypeMembersCache::members_ptr_t members;
+    IfFailRet(GetTypeMembers(m_uniqueTypeMembersCache.get(), pModule, typeDef, members));
+
+    TypeMembersCache::layout_ptr_t layout = m_uniqueTypeMembersCache->GetLayout(modAddress, typeDef, typeName);
+    if (!layout)
+    {
+        std::shared_ptr<TypeMembersCache::layout_t> newLayout(new TypeMembersCache::layout_t);
+        if ((Status = GetValueTypeLayout(pValue, pClass, *members, *newLayout)) != S_OK)
+            return FAILED(Status) ? Status : S_FALSE;
+        layout = newLayout;
+        m_uniqueTypeMembersCache->PutLayout(modAddress, typeDef, typeName, layout);
+    }
+
+    ULONG32 size;
+    IfFailRet(pValue->GetSize(&size));
+    if (size != layout->size)
+        return S_FALSE;
+
+    ToRelease<ICorDebugGenericValue> pGenericValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &pGenericValue));
+    std::vector<BYTE> data(size);
+    IfFailRet(pGenericValue->GetValue(data.data()));
+
+    for (const auto &field : members->fields)
+    {
+        auto find = layout->fields.find(field.fieldDef);
+        if (find != layout->fields.end())
+            IfFailRet(cb(field.name, find->second.type, &data[find->second.offset]));
+    }
+
+    return S_OK;
 }
 
 enum class GeneratedCodeKind
@@ -1230,21 +2161,8 @@ static HRESULT WalkGeneratedClassFields(IMetaDataImport *pMD, ICorDebugValue *pI
     mdTypeDef currentTypeDef;
     IfFailRet(GetClassAndTypeDefByValue(pValue, &pClass, currentTypeDef));
 
-    struct hoisted_local_scope_t
-    {
-        uint32_t startOffset;
-        uint32_t length;
-    };
-    struct hoisted_local_scope_t_deleter
-    {
-        void operator()(hoisted_local_scope_t *p) const
-        {
-            Interop::CoTaskMemFree(p);
-        }
-    };
-
-    int32_t hoistedLocalScopesCount = -1;
-    std::unique_ptr<hoisted_local_scope_t, hoisted_local_scope_t_deleter> hoistedLocalScopes;
+    bool methodLocalsRequested = false;
+    std::shared_ptr<const MethodLocals> methodLocals;
 
     IfFailRet(ForEachFields(pMD, currentTypeDef, [&](mdFieldDef fieldDef) -> HRESULT
     {
@@ -1278,23 +2196,21 @@ static HRESULT WalkGeneratedClassFields(IMetaDataImport *pMD, ICorDebugValue *pI
         }
         else if (generatedNameKind == GeneratedNameKind::HoistedLocalField)
         {
-            if (hoistedLocalScopesCount == -1)
+            if (!methodLocalsRequested)
             {
-                PVOID data = nullptr;
-                if (SUCCEEDED(pModules->GetHoistedLocalScopes(pModule, methodDef, methodVersion, &data, hoistedLocalScopesCount)) && data)
-                    hoistedLocalScopes.reset((hoisted_local_scope_t*)data);
-                else
-                    hoistedLocalScopesCount = 0;
+                methodLocalsRequested = true;
+                if (FAILED(pModules->GetMethodLocals(pModule, methodDef, methodVersion, methodLocals)))
+                    methodLocals.reset();
             }
 
             // Check, that hoisted local is in scope.
             // Note, in case we have any issue - ignore this check and show variable, since this is not fatal error.
             int32_t index;
-            if (hoistedLocalScopesCount > 0 &&
+            if (methodLocals &&
                 SUCCEEDED(TryParseSlotIndex(mdName, index)) &&
-                hoistedLocalScopesCount > index &&
-                (currentIlOffset < hoistedLocalScopes.get()[index].startOffset ||
-                 currentIlOffset >= hoistedLocalScopes.get()[index].startOffset + hoistedLocalScopes.get()[index].length))
+                index >= 0 && (size_t)index < methodLocals->hoistedLocalScopes.size() &&
+                (currentIlOffset < methodLocals->hoistedLocalScopes[index].startOffset ||
+                 currentIlOffset >= methodLocals->hoistedLocalScopes[index].startOffset + methodLocals->hoistedLocalScopes[index].length))
                 return S_OK; // Return with success to continue walk.
 
             WSTRING wLocalName;
@@ -1452,16 +2368,17 @@ static HRESULT InternalWalkStackVars(Modules *pModules, ICorDebugThread *pThread
         pILFrame.Free();
     }
 
+    // Note, locals table is cached for method version, so, only local index and IL offset lookup is needed here.
+    std::shared_ptr<const MethodLocals> methodLocals;
+    if (cLocals > 0 && FAILED(pModules->GetMethodLocals(pModule, methodDef, methodVersion, methodLocals)))
+        cLocals = 0;
+
     for (ULONG i = 0; i < cLocals; i++)
     {
-        WSTRING wLocalName;
-        ULONG32 ilStart;
-        ULONG32 ilEnd;
-        if (FAILED(pModules->GetFrameNamedLocalVariable(pModule, methodDef, methodVersion, i, wLocalName, &ilStart, &ilEnd)))
-            continue;
-
-        if (currentIlOffset < ilStart || currentIlOffset >= ilEnd)
+        const WSTRING *pLocalName = methodLocals->FindLocal(i, currentIlOffset);
+        if (!pLocalName)
             continue;
+        const WSTRING &wLocalName = *pLocalName;
 
         auto getValue = [&](ICorDebugValue **ppResultValue, int) -> HRESULT
         {
@@ -1503,7 +2420,7 @@ HRESULT Evaluator::WalkStackVars(ICorDebugThread *pThread, FrameLevel frameLevel
     return InternalWalkStackVars(m_sharedModules.get(), pThread, frameLevel, cb);
 }
 
-static HRESULT FollowFields(EvalHelpers *pEvalHelpers, ICorDebugThread *pThread, FrameLevel frameLevel, ICorDebugValue *pValue,
+static HRESULT FollowFields(TypeMembersCache *pTypeMembersCache, EvalHelpers *pEvalHelpers, ICorDebugThread *pThread, FrameLevel frameLevel, ICorDebugValue *pValue,
                             Evaluator::ValueKind valueKind, std::vector<std::string> &identifiers, int nextIdentifier,
                             ICorDebugValue **ppResult, std::unique_ptr<Evaluator::SetterData> *resultSetterData, int evalFlags)
 {
@@ -1522,7 +2439,16 @@ static HRESULT FollowFields(EvalHelpers *pEvalHelpers, ICorDebugThread *pThread,
 
         ToRelease<ICorDebugValue> pClassValue(std::move(pResultValue));
 
-        InternalWalkMembers(pEvalHelpers, pClassValue, pThread, frameLevel, nullptr, !!resultSetterData, [&](
+        // Note, intrinsics provide read-only values, so, setter data is not provided.
+        if (valueKind == Evaluator::ValueIsVariable &&
+            EvalIntrinsics::GetMember(pThread, pClassValue, identifiers[i], &pResultValue) == S_OK)
+        {
+            if (resultSetterData)
+                (*resultSetterData).reset();
+            continue;
+        }
+
+        InternalWalkMembers(pTypeMembersCache, pEvalHelpers, pClassValue, pThread, frameLevel, nullptr, !!resultSetterData, [&](
             ICorDebugType *pType,
             bool is_static,
             const std::string &memberName,
@@ -1542,7 +2468,7 @@ static HRESULT FollowFields(EvalHelpers *pEvalHelpers, ICorDebugThread *pThread,
                 (*resultSetterData).reset(new Evaluator::SetterData(*setterData));
 
             return E_ABORT; // Fast exit from cycle with result.
-        });
+        }, identifiers[i]);
 
         if (!pResultValue)
             return E_FAIL;
@@ -1554,7 +2480,7 @@ static HRESULT FollowFields(EvalHelpers *pEvalHelpers, ICorDebugThread *pThread,
     return S_OK;
 }
 
-static HRESULT FollowNestedFindValue(Modules *pModules, EvalHelpers *pEvalHelpers, ICorDebugThread *pThread, FrameLevel frameLevel,
+static HRESULT FollowNestedFindValue(TypeMembersCache *pTypeMembersCache, Modules *pModules, EvalHelpers *pEvalHelpers, ICorDebugThread *pThread, FrameLevel frameLevel,
                                      const std::string &methodClass, std::vector<std::string> &identifiers, ICorDebugValue **ppResult,
                                      std::unique_ptr<Evaluator::SetterData> *resultSetterData, int evalFlags)
 {
@@ -1597,7 +2523,7 @@ static HRESULT FollowNestedFindValue(Modules *pModules, EvalHelpers *pEvalHelper
             ToRelease<ICorDebugValue> pTypeObject;
             if (S_OK == pEvalHelpers->CreatTypeObjectStaticConstructor(pThread, pType, &pTypeObject))
             {
-                if (SUCCEEDED(FollowFields(pEvalHelpers, pThread, frameLevel, pTypeObject, Evaluator::ValueIsClass, staticName, 0, ppResult, resultSetterData, evalFlags)))
+                if (SUCCEEDED(FollowFields(pTypeMembersCache, pEvalHelpers, pThread, frameLevel, pTypeObject, Evaluator::ValueIsClass, staticName, 0, ppResult, resultSetterData, evalFlags)))
                     return S_OK;
             }
             trim = true;
@@ -1607,7 +2533,7 @@ static HRESULT FollowNestedFindValue(Modules *pModules, EvalHelpers *pEvalHelper
         ToRelease<ICorDebugValue> pTypeObject;
         IfFailRet(pEvalHelpers->CreatTypeObjectStaticConstructor(pThread, pType, &pTypeObject));
         if (Status == S_OK && // type have static members (S_FALSE if type don't have static members)
-            SUCCEEDED(FollowFields(pEvalHelpers, pThread, frameLevel, pTypeObject, Evaluator::ValueIsClass, fieldName, 0, ppResult, resultSetterData, evalFlags)))
+            SUCCEEDED(FollowFields(pTypeMembersCache, pEvalHelpers, pThread, frameLevel, pTypeObject, Evaluator::ValueIsClass, fieldName, 0, ppResult, resultSetterData, evalFlags)))
             return S_OK;
 
         trim = true;
@@ -1616,7 +2542,7 @@ static HRESULT FollowNestedFindValue(Modules *pModules, EvalHelpers *pEvalHelper
     return E_FAIL;
 }
 
-static HRESULT InternalResolveIdentifiers(Modules *pModules, EvalHelpers *pEvalHelpers, ICorDebugThread *pThread, FrameLevel frameLevel, ICorDebugValue *pInputValue,
+static HRESULT InternalResolveIdentifiers(TypeMembersCache *pTypeMembersCache, Modules *pModules, EvalHelpers *pEvalHelpers, ICorDebugThread *pThread, FrameLevel frameLevel, ICorDebugValue *pInputValue,
                                           Evaluator::SetterData *inputSetterData, std::vector<std::string> &identifiers, ICorDebugValue **ppResultValue,
                                           std::unique_ptr<Evaluator::SetterData> *resultSetterData, ICorDebugType **ppResultType, int evalFlags)
 {
@@ -1630,7 +2556,7 @@ static HRESULT InternalResolveIdentifiers(Modules *pModules, EvalHelpers *pEvalH
     }
     else if (pInputValue)
     {
-        return FollowFields(pEvalHelpers, pThread, frameLevel, pInputValue, Evaluator::ValueIsVariable, identifiers, 0, ppResultValue, resultSetterData, evalFlags);
+        return FollowFields(pTypeMembersCache, pEvalHelpers, pThread, frameLevel, pInputValue, Evaluator::ValueIsVariable, identifiers, 0, ppResultValue, resultSetterData, evalFlags);
     }
 
     HRESULT Status;
@@ -1678,7 +2604,7 @@ static HRESULT InternalResolveIdentifiers(Modules *pModules, EvalHelpers *pEvalH
         if (identifiers[nextIdentifier] == "this")
             nextIdentifier++; // skip first identifier with "this" (we have it in pThisValue), check rest
 
-        if (SUCCEEDED(FollowFields(pEvalHelpers, pThread, frameLevel, pThisValue, Evaluator::ValueIsVariable, identifiers, nextIdentifier, &pResolvedValue, resultSetterData, evalFlags)))
+        if (SUCCEEDED(FollowFields(pTypeMembersCache, pEvalHelpers, pThread, frameLevel, pThisValue, Evaluator::ValueIsVariable, identifiers, nextIdentifier, &pResolvedValue, resultSetterData, evalFlags)))
         {
             *ppResultValue = pResolvedValue.Detach();
             return S_OK;
@@ -1696,7 +2622,7 @@ static HRESULT InternalResolveIdentifiers(Modules *pModules, EvalHelpers *pEvalH
         std::string methodName;
         TypePrinter::GetTypeAndMethod(pFrame, methodClass, methodName);
 
-        if (SUCCEEDED(FollowNestedFindValue(pModules, pEvalHelpers, pThread, frameLevel, methodClass, identifiers, &pResolvedValue, resultSetterData, evalFlags)))
+        if (SUCCEEDED(FollowNestedFindValue(pTypeMembersCache, pModules, pEvalHelpers, pThread, frameLevel, methodClass, identifiers, &pResolvedValue, resultSetterData, evalFlags)))
         {
             *ppResultValue = pResolvedValue.Detach();
             return S_OK;
@@ -1740,7 +2666,7 @@ static HRESULT InternalResolveIdentifiers(Modules *pModules, EvalHelpers *pEvalH
     }
 
     ToRelease<ICorDebugValue> pValue(std::move(pResolvedValue));
-    IfFailRet(FollowFields(pEvalHelpers, pThread, frameLevel, pValue, valueKind, identifiers, nextIdentifier, &pResolvedValue, resultSetterData, evalFlags));
+    IfFailRet(FollowFields(pTypeMembersCache, pEvalHelpers, pThread, frameLevel, pValue, valueKind, identifiers, nextIdentifier, &pResolvedValue, resultSetterData, evalFlags));
 
     *ppResultValue = pResolvedValue.Detach();
     return S_OK;
@@ -1750,7 +2676,7 @@ HRESULT Evaluator::ResolveIdentifiers(ICorDebugThread *pThread, FrameLevel frame
                                       std::vector<std::string> &identifiers, ICorDebugValue **ppResultValue, std::unique_ptr<SetterData> *resultSetterData,
                                       ICorDebugType **ppResultType, int evalFlags)
 {
-    return InternalResolveIdentifiers(m_sharedModules.get(), m_sharedEvalHelpers.get(), pThread, frameLevel, pInputValue,
+    return InternalResolveIdentifiers(m_uniqueTypeMembersCache.get(), m_sharedModules.get(), m_sharedEvalHelpers.get(), pThread, frameLevel, pInputValue,
                                       inputSetterData, identifiers, ppResultValue, resultSetterData, ppResultType, evalFlags);
 }
 
@@ -1782,42 +2708,33 @@ HRESULT Evaluator::LookupExtensionMethods(ICorDebugType *pType,
     }
 
     m_sharedModules->ForEachModule([&](ICorDebugModule *pModule)->HRESULT {
-        ULONG typesCnt = 0;
-        HCORENUM fTypeEnum = NULL;
-        mdTypeDef mdType = mdTypeDefNil;
+        MetadataIndex::index_ptr_t index;
+        IfFailRet(MetadataIndex::GetModuleIndex(pModule, index));
 
         ToRelease<IUnknown> pMDUnknown;
         IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
         ToRelease<IMetaDataImport> pMD;
         IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
 
-        while (SUCCEEDED(pMD->EnumTypeDefs(&fTypeEnum, &mdType, 1, &typesCnt)) && typesCnt != 0)
+        for (const auto &type : index->types)
         {
-            std::string typeName;
-            if (!HasAttribute(pMD, mdType, attributeName))
+            if (!HasAttribute(pMD, type.typeDef, attributeName))
                 continue;
-            if(FAILED(TypePrinter::NameForToken(mdType, pMD, typeName, false, nullptr)))
-                continue;
-            HCORENUM fFuncEnum = NULL;
-            mdMethodDef mdMethod = mdMethodDefNil;
-            ULONG methodsCnt = 0;
 
-            while (SUCCEEDED(pMD->EnumMethods(&fFuncEnum, mdType, &mdMethod, 1, &methodsCnt)) && methodsCnt != 0)
+            for (size_t methodIndex = type.methodsBegin; methodIndex < type.methodsEnd; methodIndex++)
             {
-                mdTypeDef memTypeDef;
-                ULONG nameLen;
-                WCHAR szFuncName[mdNameLen] = {0};
+                if (index->methods[methodIndex].name != methodName)
+                    continue;
+
+                const mdMethodDef mdMethod = index->methods[methodIndex].methodDef;
                 PCCOR_SIGNATURE pSig = NULL;
                 ULONG cbSig = 0;
 
-                if(FAILED(pMD->GetMethodProps(mdMethod, &memTypeDef, szFuncName, _countof(szFuncName), &nameLen,
+                if(FAILED(pMD->GetMethodProps(mdMethod, nullptr, nullptr, 0, nullptr,
                                                 nullptr, &pSig, &cbSig, nullptr, nullptr)))
                     continue;
                 if (!HasAttribute(pMD, mdMethod, attributeName))
                     continue;
-                std::string fullName = to_utf8(szFuncName);
-                if (fullName != methodName)
-                    continue;
                 ULONG cParams; // Count of signature parameters.
                 ULONG gParams; // count of generic parameters;
                 ULONG elementSize;
@@ -1925,8 +2842,6 @@ HRESULT Evaluator::LookupExtensionMethods(ICorDebugType *pType,
                                 {
                                     pModule->GetFunctionFromToken(mdMethod, ppCorFunc);
                                     pMDI->CloseEnum(ifEnum);
-                                    pMD->CloseEnum(fFuncEnum);
-                                    pMD->CloseEnum(fTypeEnum);
                                     return E_ABORT;
                                 }
                             }
@@ -1952,15 +2867,11 @@ HRESULT Evaluator::LookupExtensionMethods(ICorDebugType *pType,
                     if(found)
                     {
                         pModule->GetFunctionFromToken(mdMethod, ppCorFunc);
-                        pMD->CloseEnum(fFuncEnum);
-                        pMD->CloseEnum(fTypeEnum);
                         return E_ABORT;
                     }
                 }
             }
-            pMD->CloseEnum(fFuncEnum);
         }
-        pMD->CloseEnum(fTypeEnum);
         return S_OK;
     });
     return S_OK;
@@ -8,10 +8,12 @@
 #include "cordebug.h"
 
 #include <functional>
+#include <unordered_map>
 #include <unordered_set>
 #include <list>
 #include <vector>
 #include <mutex>
+#include <memory>
 #include "interfaces/types.h"
 #include "utils/torelease.h"
 
@@ -22,6 +24,8 @@ class Modules;
 class EvalHelpers;
 class EvalStackMachine;
 
+class TypeMembersCache;
+
 class Evaluator
 {
 public:
@@ -54,13 +58,17 @@ public:
         ToRelease<ICorDebugValue> thisValue;
         ToRelease<ICorDebugType> propertyType;
         ToRelease<ICorDebugFunction> setterFunction;
+        // Property getter don't need evaluation, value is read from backing field.
+        bool autoProperty;
 
-        SetterData(ICorDebugValue *pValue, ICorDebugType *pType, ICorDebugFunction *pFunction)
+        SetterData(ICorDebugValue *pValue, ICorDebugType *pType, ICorDebugFunction *pFunction) :
+            autoProperty(false)
         {
             Set(pValue, pType, pFunction);
         };
 
-        SetterData(SetterData &setterData)
+        SetterData(SetterData &setterData) :
+            autoProperty(setterData.autoProperty)
         {
             Set(setterData.thisValue.GetPtr(), setterData.propertyType.GetPtr(), setterData.setterFunction.GetPtr());
         };
@@ -84,8 +92,9 @@ public:
     typedef std::function<HRESULT(ICorDebugValue**,int)> GetValueCallback;
     typedef std::function<HRESULT(ICorDebugType*,bool,const std::string&,GetValueCallback,SetterData*)> WalkMembersCallback;
     typedef std::function<HRESULT(const std::string&,GetValueCallback)> WalkStackVarsCallback;
+    typedef std::function<HRESULT(const std::string&,CorElementType,const BYTE*)> WalkPrimitiveFieldsCallback;
     typedef std::function<HRESULT(ICorDebugFunction**)> GetFunctionCallback;
-    typedef std::function<HRESULT(bool,const std::string&,ReturnElementType&,std::vector<ArgElementType>&,GetFunctionCallback)> WalkMethodsCallback;
+    typedef std::function<HRESULT(bool,const std::string&,const ReturnElementType&,const std::vector<ArgElementType>&,GetFunctionCallback)> WalkMethodsCallback;
 
     enum ValueKind
     {
@@ -96,11 +105,8 @@ public:
 
     Evaluator(std::shared_ptr<Modules> &sharedModules,
               std::shared_ptr<EvalHelpers> &sharedEvalHelpers,
-              std::shared_ptr<EvalStackMachine> &sharedEvalStackMachine) :
-        m_sharedModules(sharedModules),
-        m_sharedEvalHelpers(sharedEvalHelpers),
-        m_sharedEvalStackMachine(sharedEvalStackMachine)
-    {}
+              std::shared_ptr<EvalStackMachine> &sharedEvalStackMachine);
+    ~Evaluator();
 
     HRESULT ResolveIdentifiers(
         ICorDebugThread *pThread,
@@ -120,6 +126,24 @@ public:
         bool provideSetterData,
         WalkMembersCallback cb);
 
+    // Fast path for value type instance fields of primitive types: whole value data is read by one call and fields data
+    // is provided from it by cached fields layout of exact type (no ICorDebugValue created and read for each field).
+    // Callback is called with field name, field type and pointer to field data. Return S_FALSE in case value is not
+    // value type or layout can't be calculated, in this case WalkMembers() must be used.
+    HRESULT WalkPrimitiveFields(ICorDebugValue *pValue, WalkPrimitiveFieldsCallback cb);
+
+    // Return S_FALSE in case value is not array, elements view (Span<T>, Memory<T>, etc, see EvalIntrinsics::GetElementsView())
+    // or hash collection (Dictionary<TKey,TValue>, HashSet<T>, etc, see EvalIntrinsics::WalkHashItems()).
+    HRESULT GetArrayElementsCount(ICorDebugValue *pValue, ULONG32 &count);
+    // Walk array (or elements view) elements with positions in [start, end) range only, element access by position is O(1),
+    // so, there is no need walk over all elements before `start`. Hash collections items before `start` are skipped
+    // by raw entries data (no ICorDebugValue created for them).
+    HRESULT WalkArrayElements(
+        ICorDebugValue *pValue,
+        ULONG32 start,
+        ULONG32 end,
+        WalkMembersCallback cb);
+
     HRESULT WalkStackVars(
         ICorDebugThread *pThread,
         FrameLevel frameLevel,
@@ -146,12 +170,156 @@ public:
 
     ArgElementType GetElementTypeByTypeName(const std::string typeName);
 
+    // Cache of method calls overloads resolution, aimed to avoid methods walk over type hierarchy (and extension methods
+    // search in all modules) for each call. Note, key must describe receiver type, method name, search kind (static or
+    // instance), arguments and method generics types. For extension method `pResultType` is nullptr.
+    bool FindMethodOverload(const std::string &key, ICorDebugFunction **ppFunction, ICorDebugType **ppResultType, bool &isInstance);
+    void AddMethodOverload(const std::string &key, ICorDebugFunction *pFunction, ICorDebugType *pResultType, bool isInstance);
+
+    // Must be called in case module unloaded or its metadata changed (Hot Reload).
+    void InvalidateModuleMembers(ICorDebugModule *pModule);
+    void Cleanup();
+    // Approximate heap memory size of types members cache.
+    size_t GetMemoryUsage();
+
 private:
 
     std::shared_ptr<Modules> m_sharedModules;
     std::shared_ptr<EvalHelpers> m_sharedEvalHelpers;
     std::shared_ptr<EvalStackMachine> m_sharedEvalStackMachine;
+    // Note, m_uniqueTypeMembersCache have its own mutex for private data state sync.
+    std::unique_ptr<TypeMembersCache> m_uniqueTypeMembersCache;
+
+};
+
+// Cache of types members metadata (fields, properties and methods with parsed signatures), aimed to avoid metadata
+// enumeration, signatures parsing and names conversion at each members walk (`a.b.c` resolve, object expansion, method call).
+// Note, members stored in declaration order, since walk routines stop on first found member. Table is related to
+// exact type only (without base types), fields and properties data don't depend on generic instantiation, methods do.
+class TypeMembersCache
+{
+public:
+
+    struct field_t
+    {
+        mdFieldDef fieldDef;
+        std::string name;
+        DWORD attr;
+        PCCOR_SIGNATURE pSignatureBlob;
+        ULONG sigBlobLength;
+        UVCP_CONSTANT pRawValue;
+        ULONG rawValueLength;
+    };
+
+    struct property_t
+    {
+        std::string name;
+        mdMethodDef getter;
+        mdMethodDef setter;
+        bool isStatic;
+        mdFieldDef backingField; // not mdFieldDefNil for auto-property, value is read from field without getter evaluation
+    };
+
+    struct members_t
+    {
+        // Signature and raw value blobs are owned by metadata.
+        ToRelease<IMetaDataImport> pMD;
+        // Note, compiler generated fields and properties with `DebuggerBrowsableState.Never` are not included.
+        std::vector<field_t> fields;
+        std::vector<property_t> properties;
+        // Indexes in fields and properties vectors, in declaration order.
+        std::unordered_map<std::string, std::vector<size_t>> fieldsByName;
+        std::unordered_map<std::string, std::vector<size_t>> propertiesByName;
+    };
+
+    struct method_t
+    {
+        mdMethodDef methodDef;
+        std::string name;
+        bool isStatic;
+        Evaluator::ReturnElementType returnType;
+        std::vector<Evaluator::ArgElementType> argsTypes;
+    };
+
+    struct methods_t
+    {
+        std::vector<method_t> methods;
+    };
+
+    struct field_layout_t
+    {
+        CorElementType type;
+        ULONG32 offset;
+    };
+
+    // Layout of value type instance fields of primitive types, related to exact type (generic instantiation).
+    struct layout_t
+    {
+        ULONG32 size;
+        std::unordered_map<mdFieldDef, field_layout_t> fields;
+    };
+
+    // Resolved method call overload, method could be found in base type or be extension method.
+    struct overload_t
+    {
+        ToRelease<ICorDebugFunction> function;
+        ToRelease<ICorDebugType> resultType; // type, where method was found, nullptr for extension method
+        bool isInstance;
+    };
+
+    typedef std::shared_ptr<const members_t> members_ptr_t;
+    typedef std::shared_ptr<const methods_t> methods_ptr_t;
+    typedef std::shared_ptr<const layout_t> layout_ptr_t;
+    typedef std::shared_ptr<const overload_t> overload_ptr_t;
+
+    static const size_t MaxTypes = 1024;
+
+    // Return nullptr in case no data in cache.
+    members_ptr_t GetMembers(uint64_t modAddress, mdTypeDef typeDef);
+    void PutMembers(uint64_t modAddress, mdTypeDef typeDef, members_ptr_t members);
+    // Note, generics - unique string for type and method generics (instantiation).
+    methods_ptr_t GetMethods(uint64_t modAddress, mdTypeDef typeDef, const std::string &generics);
+    void PutMethods(uint64_t modAddress, mdTypeDef typeDef, const std::string &generics, methods_ptr_t methods);
+    // Note, typeName - full name of exact type (with generic arguments).
+    layout_ptr_t GetLayout(uint64_t modAddress, mdTypeDef typeDef, const std::string &typeName);
+    void PutLayout(uint64_t modAddress, mdTypeDef typeDef, const std::string &typeName, layout_ptr_t layout);
+    // Note, key - unique string for method call (see Evaluator::FindMethodOverload()).
+    overload_ptr_t GetOverload(const std::string &key);
+    void PutOverload(const std::string &key, overload_ptr_t overload);
+    // Remove all module's types data (for example, in case of module unload or Hot Reload delta applied).
+    // Note, all overloads are removed too, since resolution could involve types of any module.
+    void InvalidateModule(uint64_t modAddress);
+    void Clear();
+    // Approximate heap memory size, metadata blobs are owned by metadata and not included.
+    size_t GetMemoryUsage();
+
+private:
+
+    struct key_t
+    {
+        uint64_t modAddress;
+        mdTypeDef typeDef;
+        std::string generics;
+
+        bool operator == (const key_t &other) const
+        {
+            return modAddress == other.modAddress && typeDef == other.typeDef && generics == other.generics;
+        }
+    };
+
+    struct key_t_hash
+    {
+        size_t operator()(const key_t &key) const
+        {
+            return std::hash<uint64_t>()(key.modAddress ^ ((uint64_t)key.typeDef << 24)) ^ std::hash<std::string>()(key.generics);
+        }
+    };
 
+    std::mutex m_mutex;
+    std::unordered_map<key_t, members_ptr_t, key_t_hash> m_members;
+    std::unordered_map<key_t, methods_ptr_t, key_t_hash> m_methods;
+    std::unordered_map<key_t, layout_ptr_t, key_t_hash> m_layouts;
+    std::unordered_map<std::string, overload_ptr_t> m_overloads;
 };
 
 } // namespace netcoredbg
@@ -3,7 +3,11 @@
 // See the LICENSE file in the project root for more information.
 
 #include "debugger/evalwaiter.h"
+#include <algorithm>
+#include <vector>
 #include "utils/platform.h"
+#include "utils/perfcounters.h"
+#include "utils/tracerecorder.h"
 #include "debugger/threads.h"
 #ifdef INTEROP_DEBUGGING
 #include "debugger/interop_debugging.h"
@@ -12,46 +16,98 @@
 namespace netcoredbg
 {
 
-void EvalWaiter::NotifyEvalComplete(ICorDebugThread *pThread, ICorDebugEval *pEval)
+const unsigned EvalWaiter::DefaultEvalTimeout;
+const unsigned EvalWaiter::DefaultMaxParallelEvals;
+const unsigned EvalWaiter::MaxParallelEvalsLimit;
+const unsigned EvalWaiter::AdaptiveCheckInterval;
+const unsigned EvalWaiter::EvalAbortTimeout;
+
+static PerfCounters::Counter funcEvalsCounter("funcEvals");
+static PerfCounters::Counter funcEvalsTimeCounter("funcEvalsTimeUs");
+
+void EvalWaiter::SetMaxParallelEvals(unsigned count)
+{
+    m_maxParallelEvals = std::max(1u, std::min(count, MaxParallelEvalsLimit));
+}
+
+bool EvalWaiter::NotifyEvalComplete(ICorDebugThread *pThread, ICorDebugEval *pEval)
 {
     std::lock_guard<std::mutex> lock(m_evalResultMutex);
     if (!pThread)
     {
-        m_evalResult.reset(nullptr);
-        return;
+        m_evalResults.clear();
+        return false;
     }
 
     DWORD threadId = 0;
     pThread->GetID(&threadId);
 
+    auto find = std::find_if(m_evalResults.begin(), m_evalResults.end(),
+                             [&](const evalResult_t &entry) { return entry.threadId == threadId && !entry.data; });
+    if (find == m_evalResults.end())
+        return false;
+
     std::unique_ptr<evalResultData_t> ppEvalResult(new evalResultData_t);
     if (pEval)
     {
         // CORDBG_S_FUNC_EVAL_HAS_NO_RESULT: Some Func evals will lack a return value, such as those whose return type is void.
         (*ppEvalResult).Status = pEval->GetResult(&((*ppEvalResult).iCorEval));
     }
+    find->data = std::move(ppEvalResult);
 
-    if (!m_evalResult || m_evalResult->threadId != threadId)
-        return;
+    // Note, eval results (and any other values) could be used only in synchronized process, so, results are provided
+    // to waiters only when all group evals complete, until this process must be continued by caller.
+    for (const auto &entry : m_evalResults)
+    {
+        if (!entry.data)
+            return true;
+    }
 
-    m_evalResult->promiseValue.set_value(std::move(ppEvalResult));
-    m_evalResult.reset(nullptr);
+    for (auto &entry : m_evalResults)
+    {
+        entry.data->canceled = entry.canceled;
+        entry.data->crossThreadDependency = entry.crossThreadDependency;
+        entry.promiseValue.set_value(std::move(entry.data));
+    }
+    m_evalResults.clear();
+    return false;
 }
 
 bool EvalWaiter::IsEvalRunning()
 {
     std::lock_guard<std::mutex> lock(m_evalResultMutex);
 
-    return !!m_evalResult;
+    return !m_evalResults.empty();
+}
+
+bool EvalWaiter::IsEvalCompleted(DWORD threadId)
+{
+    std::lock_guard<std::mutex> lock(m_evalResultMutex);
+
+    // Note, in case eval not found, result already provided (or eval fatal error happens, see WaitResult()).
+    auto find = std::find_if(m_evalResults.begin(), m_evalResults.end(),
+                             [&](const evalResult_t &entry) { return entry.threadId == threadId; });
+    return find == m_evalResults.end() || !!find->data;
+}
+
+void EvalWaiter::SetEvalCrossThreadDependency(DWORD threadId)
+{
+    std::lock_guard<std::mutex> lock(m_evalResultMutex);
+
+    for (auto &entry : m_evalResults)
+    {
+        if (entry.threadId == threadId)
+            entry.crossThreadDependency = true;
+    }
 }
 
 #ifdef INTEROP_DEBUGGING
-// Return thread ID for running evaluation, or 0 in case no evaluation running now.
-DWORD EvalWaiter::GetEvalRunningThreadID()
+bool EvalWaiter::IsEvalRunningOnThread(DWORD threadId)
 {
     std::lock_guard<std::mutex> lock(m_evalResultMutex);
 
-    return !!m_evalResult ? m_evalResult->threadId : 0;
+    return std::find_if(m_evalResults.begin(), m_evalResults.end(),
+                        [&](const evalResult_t &entry) { return entry.threadId == threadId; }) != m_evalResults.end();
 }
 
 void EvalWaiter::SetInteropDebugger(std::shared_ptr<InteropDebugging::InteropDebugger> &sharedInteropDebugger)
@@ -69,70 +125,322 @@ void EvalWaiter::CancelEvalRunning()
 {
     std::lock_guard<std::mutex> lock(m_evalResultMutex);
 
-    if (!m_evalResult)
+    for (auto &entry : m_evalResults)
+    {
+        if (entry.data)
+            continue;
+
+        ToRelease<ICorDebugEval2> iCorEval2;
+        if (SUCCEEDED(entry.pEval->Abort()) ||
+            (SUCCEEDED(entry.pEval->QueryInterface(IID_ICorDebugEval2, (LPVOID*) &iCorEval2)) &&
+             SUCCEEDED(iCorEval2->RudeAbort())))
+            entry.canceled = true;
+    }
+}
+
+ICorDebugEval *EvalWaiter::FindEvalForThread(ICorDebugThread *pThread)
+{
+    std::lock_guard<std::mutex> lock(m_evalResultMutex);
+
+    DWORD threadId = 0;
+    if (FAILED(pThread->GetID(&threadId)))
+        return nullptr;
+
+    for (const auto &entry : m_evalResults)
+    {
+        if (entry.threadId == threadId)
+            return entry.pEval;
+    }
+    return nullptr;
+}
+
+// Note, process will be stopped during check and continued in case thread is not blocked.
+bool EvalWaiter::IsEvalThreadBlocked(ICorDebugProcess *pProcess, ICorDebugThread *pThread)
+{
+    if (FAILED(pProcess->Stop(0)))
+        return false;
+
+    CorDebugUserState userState = USER_NONE;
+    if (SUCCEEDED(pThread->GetUserState(&userState)) && (userState & USER_WAIT_SLEEP_JOIN))
+        return true;
+
+    pProcess->Continue(0);
+    return false;
+}
+
+void EvalWaiter::ScheduleGroup()
+{
+    if (m_groupRunning || m_pendingEvals.empty())
         return;
 
-    ToRelease<ICorDebugEval2> iCorEval2;
-    if (SUCCEEDED(m_evalResult->pEval->Abort()) ||
-        (SUCCEEDED(m_evalResult->pEval->QueryInterface(IID_ICorDebugEval2, (LPVOID*) &iCorEval2)) &&
-         SUCCEEDED(iCorEval2->RudeAbort())))
-        m_evalCanceled = true;
+    const unsigned maxEvals = m_maxParallelEvals;
+    evalGroup_t *group = new evalGroup_t;
+    for (auto it = m_pendingEvals.begin(); it != m_pendingEvals.end() && group->evals.size() < maxEvals;)
+    {
+        // Only one eval per thread could be run.
+        if (std::find(group->evalThreads.begin(), group->evalThreads.end(), (*it)->threadId) != group->evalThreads.end())
+        {
+            ++it;
+            continue;
+        }
+
+        (*it)->group = group;
+        group->evals.push_back(*it);
+        group->evalThreads.push_back((*it)->threadId);
+        it = m_pendingEvals.erase(it);
+    }
+    group->evals.front()->leader = true;
+    m_groupRunning = true;
 }
 
-std::future<std::unique_ptr<EvalWaiter::evalResultData_t> > EvalWaiter::RunEval(
-    HRESULT &Status,
-    ICorDebugProcess *pProcess,
-    ICorDebugThread *pThread,
-    ICorDebugEval *pEval,
-    WaitEvalResultCallback cbSetupEval)
+// Note, we need suspend during eval all managed threads, that not used for eval (delegates, reverse pinvokes, managed threads).
+// Threads, that was already suspended by debugger (non-stop mode stopped threads), must stay suspended after eval.
+void EvalWaiter::ChangeThreadsState(ICorDebugProcess *pProcess, CorDebugThreadState state, evalGroup_t &group)
 {
-    std::promise<std::unique_ptr<evalResultData_t > > p;
-    auto f = p.get_future();
-    if (!f.valid())
+    ToRelease<ICorDebugThreadEnum> iCorThreadEnum;
+    pProcess->EnumerateThreads(&iCorThreadEnum);
+    ULONG fetched = 0;
+    ToRelease<ICorDebugThread> iCorThread;
+    while (SUCCEEDED(iCorThreadEnum->Next(1, &iCorThread, &fetched)) && fetched == 1)
     {
-        LOGE("get_future() returns not valid promise object");
+        DWORD tid = 0;
+        CorDebugThreadState prevState;
+        if (state == THREAD_SUSPEND && SUCCEEDED(iCorThread->GetID(&tid)) &&
+            SUCCEEDED(iCorThread->GetDebugState(&prevState)) && prevState == THREAD_SUSPEND)
+        {
+            group.suspendedThreads.push_back(tid);
+        }
+
+        if (SUCCEEDED(iCorThread->GetID(&tid)) &&
+            std::find(group.evalThreads.begin(), group.evalThreads.end(), tid) == group.evalThreads.end() &&
+            std::find(group.suspendedThreads.begin(), group.suspendedThreads.end(), tid) == group.suspendedThreads.end())
+        {
+            if (FAILED(iCorThread->SetDebugState(state)))
+            {
+                if (state == THREAD_SUSPEND)
+                    LOGW("%s %s", "SetDebugState(THREAD_SUSPEND) during eval setup failed.",
+                        "This may change the state of the process and any breakpoints and exceptions encountered will be skipped.");
+                else
+                    LOGW("SetDebugState(THREAD_RUN) during eval failed. Process state was not restored.");
+            }
+        }
+        iCorThread.Free();
     }
+}
 
-    DWORD threadId = 0;
-    pThread->GetID(&threadId);
+// Setup all group evals and run them by one process continue.
+void EvalWaiter::RunGroup(ICorDebugProcess *pProcess, evalGroup_t &group)
+{
+    // Note, in non-stop mode eval thread could be suspended by debugger.
+    for (auto eval : group.evals)
+    {
+        m_evalsCount++;
+
+        CorDebugThreadState evalThreadState = THREAD_RUN;
+        if (SUCCEEDED(eval->pThread->GetDebugState(&evalThreadState)) && evalThreadState == THREAD_SUSPEND)
+        {
+            if (FAILED(eval->Status = eval->pThread->SetDebugState(THREAD_RUN)))
+                continue;
+            group.suspendedEvalThreads.push_back(eval);
+        }
+        eval->Status = S_OK;
+    }
+
+    SetEnableCustomNotification(pProcess, TRUE);
+    ChangeThreadsState(pProcess, THREAD_SUSPEND, group);
 
     std::lock_guard<std::mutex> lock(m_evalResultMutex);
-    assert(!m_evalResult); // We can have only 1 eval, and previous must be completed.
-    m_evalResult.reset(new evalResult_t{threadId, pEval, std::move(p)});
+    assert(m_evalResults.empty()); // Previous group must be completed.
 
-    // We don't have easy way to abort setuped eval in case of some error in debugger API,
-    // try setup eval only if all is OK right before we run process.
-    if (FAILED(Status = cbSetupEval(pEval)))
+    bool evalsReady = false;
+    for (auto eval : group.evals)
     {
-        LOGE("Setup eval failed, %0x", Status);
-        m_evalResult.reset(nullptr);
+        if (FAILED(eval->Status) ||
+            FAILED(eval->Status = eval->pThread->CreateEval(&eval->iCorEval)))
+            continue;
+
+        std::promise<std::unique_ptr<evalResultData_t > > p;
+        eval->future = p.get_future();
+        if (!eval->future.valid())
+        {
+            LOGE("get_future() returns not valid promise object");
+        }
+
+        // We don't have easy way to abort setuped eval in case of some error in debugger API,
+        // try setup eval only if all is OK right before we run process.
+        if (FAILED(eval->Status = (*eval->cbSetupEval)(eval->iCorEval)))
+        {
+            LOGE("Setup eval failed, %0x", eval->Status);
+            continue;
+        }
+
+        m_evalResults.emplace_back(eval->threadId, eval->iCorEval.GetPtr(), std::move(p));
+        evalsReady = true;
     }
-    else if (FAILED(Status = pProcess->Continue(0)))
+
+    if (!evalsReady)
+        return;
+
+    HRESULT Status;
+    if (FAILED(Status = pProcess->Continue(0)))
     {
         LOGE("Continue() failed, %0x", Status);
-        m_evalResult.reset(nullptr);
+        m_evalResults.clear();
+        for (auto eval : group.evals)
+        {
+            if (SUCCEEDED(eval->Status))
+                eval->Status = Status;
+        }
     }
+}
 
-    return f;
+// Restore threads states after all group evals waiting done.
+void EvalWaiter::EndGroup(ICorDebugProcess *pProcess, evalGroup_t &group)
+{
+    SetEnableCustomNotification(pProcess, FALSE);
+
+    ChangeThreadsState(pProcess, THREAD_RUN, group);
+    for (auto eval : group.suspendedEvalThreads)
+    {
+        eval->pThread->SetDebugState(THREAD_SUSPEND);
+    }
 }
 
-ICorDebugEval *EvalWaiter::FindEvalForThread(ICorDebugThread *pThread)
+HRESULT EvalWaiter::WaitResult(ICorDebugProcess *pProcess, pendingEval_t &eval, int evalFlags, ICorDebugValue **ppEvalResult)
 {
-    std::lock_guard<std::mutex> lock(m_evalResultMutex);
+    HRESULT Status;
+    IfFailRet(eval.Status);
 
-    DWORD threadId = 0;
-    if (FAILED(pThread->GetID(&threadId)) || !m_evalResult)
-        return nullptr;
+    auto &f = eval.future;
+    if (!f.valid())
+        return E_FAIL;
+
+    try
+    {
+        // NOTE
+        // MSVS 2017 debugger and newer use config file
+        // C:\Program Files (x86)\Microsoft Visual Studio\YYYY\VERSION\Common7\IDE\Profiles\CSharp.vssettings
+        // by default NormalEvalTimeout is 5000 milliseconds
+        const unsigned evalTimeout = GetEvalFlagsTimeout(evalFlags) ? GetEvalFlagsTimeout(evalFlags) : m_evalTimeout.load();
+
+        std::future_status timeoutStatus = std::future_status::timeout;
+        bool evalThreadBlocked = false;
+        if (m_adaptiveEvalTimeout && evalTimeout > AdaptiveCheckInterval)
+        {
+            // Thread must be blocked during two checks in a row, in order to ignore short-time waits.
+            unsigned blockedChecks = 0;
+            for (unsigned elapsed = 0; elapsed < evalTimeout; elapsed += AdaptiveCheckInterval)
+            {
+                timeoutStatus = f.wait_for(std::chrono::milliseconds(std::min(AdaptiveCheckInterval, evalTimeout - elapsed)));
+                if (timeoutStatus != std::future_status::timeout || IsEvalCompleted(eval.threadId))
+                    break;
+
+                if (!IsEvalThreadBlocked(pProcess, eval.pThread))
+                {
+                    blockedChecks = 0;
+                    continue;
+                }
+
+                if (++blockedChecks == 2)
+                {
+                    evalThreadBlocked = true;
+                    break;
+                }
+                pProcess->Continue(0);
+            }
+        }
+        else
+        {
+            timeoutStatus = f.wait_for(std::chrono::milliseconds(evalTimeout));
+        }
+
+        if (!evalThreadBlocked && timeoutStatus == std::future_status::timeout && IsEvalCompleted(eval.threadId))
+        {
+            // Eval completed, but other group evals still running, timeouts of other evals are cared by their waiters.
+            f.wait();
+        }
+        else if (evalThreadBlocked)
+        {
+            // Process already stopped by IsEvalThreadBlocked() here.
+            LOGW("Evaluation thread is blocked, evaluation aborted.");
+
+            if (FAILED(eval.iCorEval->Abort()))
+            {
+                ToRelease<ICorDebugEval2> iCorEval2;
+                if (SUCCEEDED(eval.iCorEval->QueryInterface(IID_ICorDebugEval2, (LPVOID*) &iCorEval2)))
+                    iCorEval2->RudeAbort();
+            }
+
+            SetEvalCrossThreadDependency(eval.threadId);
+            pProcess->Continue(0);
+        }
+        else if (timeoutStatus == std::future_status::timeout)
+        {
+            LOGW("Evaluation timed out.");
+            LOGW("%s %s", "To prevent an unsafe abort when evaluating, all threads were allowed to run.",
+                 "This may have changed the state of the process and any breakpoints and exceptions encountered have been skipped.");
+
+            // NOTE
+            // All CoreCLR releases at least till version 3.1.3, don't have proper x86 implementation for ICorDebugEval::Abort().
+            // This issue looks like CoreCLR terminate managed process execution instead of abort evaluation.
+
+            // In this case we have same behaviour as MS vsdbg and MSVS C# debugger - run all managed threads and try to abort eval by any cost.
+            // Ignore errors here, this our last chance prevent debugger hangs.
+            pProcess->Stop(0);
+            ChangeThreadsState(pProcess, THREAD_RUN, *eval.group);
 
-    return m_evalResult->threadId == threadId ? m_evalResult->pEval : nullptr;
+            if (FAILED(eval.iCorEval->Abort()))
+            {
+                ToRelease<ICorDebugEval2> iCorEval2;
+                if (SUCCEEDED(eval.iCorEval->QueryInterface(IID_ICorDebugEval2, (LPVOID*) &iCorEval2)))
+                    iCorEval2->RudeAbort();
+            }
+
+            eval.timedOut = true;
+            pProcess->Continue(0);
+        }
+        // Wait for 5 more seconds, give `Abort()` a chance.
+        timeoutStatus = f.wait_for(std::chrono::milliseconds(EvalAbortTimeout));
+        if (timeoutStatus == std::future_status::timeout)
+        {
+            // Looks like can't be aborted, this is fatal error for debugger (debuggee have inconsistent state now).
+            // Note, all group evals are dropped, other group waiters will get error.
+            pProcess->Stop(0);
+            m_evalResultMutex.lock();
+            m_evalResults.clear();
+            m_evalResultMutex.unlock();
+            LOGE("Fatal error, eval abort failed.");
+            return E_UNEXPECTED;
+        }
+
+        auto evalResult = f.get();
+        eval.canceled = evalResult.get()->canceled;
+        eval.crossThreadDependency = evalResult.get()->crossThreadDependency;
+        IfFailRet(evalResult.get()->Status);
+
+        if (!ppEvalResult)
+            return S_OK;
+
+        *ppEvalResult = evalResult.get()->iCorEval.Detach();
+        return evalResult.get()->Status;
+    }
+    catch (const std::future_error&)
+    {
+        return E_FAIL;
+    }
 }
 
 HRESULT EvalWaiter::WaitEvalResult(ICorDebugThread *pThread,
                                   ICorDebugValue **ppEvalResult,
-                                  WaitEvalResultCallback cbSetupEval)
+                                  WaitEvalResultCallback cbSetupEval,
+                                  int evalFlags)
 {
-    // Important! Evaluation should be proceed only for 1 thread.
-    std::lock_guard<std::mutex> lock(m_waitEvalResultMutex);
+    if (m_funcEvalDisabled)
+        return CORDBG_E_TARGET_READONLY;
+
+    funcEvalsCounter.Add();
+    PerfCounters::ScopedTime time(funcEvalsTimeCounter);
+    TraceRecorder::ScopedEvent traceEvent("eval", "WaitEvalResult");
 
     // During evaluation could be implicitly executing user code, that could provoke callback calls like - breakpoints, exceptions, etc.
     // Make sure, that all managed callbacks ignore standard logic during evaluation and don't pause/interrupt managed code execution.
@@ -151,130 +459,78 @@ HRESULT EvalWaiter::WaitEvalResult(ICorDebugThread *pThread,
         return COR_E_THREADSTATE;
 #endif // INTEROP_DEBUGGING
 
-    // Note, we need suspend during eval all managed threads, that not used for eval (delegates, reverse pinvokes, managed threads).
-    auto ChangeThreadsState = [&](CorDebugThreadState state)
+    // Important! Only one group of evals could be run at once (only one eval per thread), evals requested during group
+    // run are queued and next group is formed from them (see SetMaxParallelEvals()).
+    pendingEval_t eval(pThread, evalThreadId, &cbSetupEval);
+    std::unique_ptr<evalGroup_t> group; // owned by group leader
     {
-        ToRelease<ICorDebugThreadEnum> iCorThreadEnum;
-        iCorProcess->EnumerateThreads(&iCorThreadEnum);
-        ULONG fetched = 0;
-        ToRelease<ICorDebugThread> iCorThread;
-        while (SUCCEEDED(iCorThreadEnum->Next(1, &iCorThread, &fetched)) && fetched == 1)
-        {
-            DWORD tid = 0;
-            if (SUCCEEDED(iCorThread->GetID(&tid)) && evalThreadId != tid)
-            {
-                if (FAILED(iCorThread->SetDebugState(state)))
-                {
-                    if (state == THREAD_SUSPEND)
-                        LOGW("%s %s", "SetDebugState(THREAD_SUSPEND) during eval setup failed.",
-                            "This may change the state of the process and any breakpoints and exceptions encountered will be skipped.");
-                    else
-                        LOGW("SetDebugState(THREAD_RUN) during eval failed. Process state was not restored.");
-                }
-            }
-            iCorThread.Free();
-        }
-    };
+        std::unique_lock<std::mutex> lock(m_scheduleMutex);
+        m_pendingEvals.push_back(&eval);
+        ScheduleGroup();
+        m_scheduleCV.notify_all();
+        m_scheduleCV.wait(lock, [&]() { return eval.group != nullptr; });
+        if (eval.leader)
+            group.reset(eval.group);
+    }
 
-    bool evalTimeOut = false;
-    auto WaitResult = [&]() -> HRESULT
+    if (eval.leader)
     {
-        ChangeThreadsState(THREAD_SUSPEND);
-
-        ToRelease<ICorDebugEval> iCorEval;
-        IfFailRet(pThread->CreateEval(&iCorEval));
-
-        try
-        {
-            auto f = RunEval(Status, iCorProcess, pThread, iCorEval, cbSetupEval);
-            IfFailRet(Status);
-
-            if (!f.valid())
-                return E_FAIL;
-
-            // NOTE
-            // MSVS 2017 debugger and newer use config file
-            // C:\Program Files (x86)\Microsoft Visual Studio\YYYY\VERSION\Common7\IDE\Profiles\CSharp.vssettings
-            // by default NormalEvalTimeout is 5000 milliseconds
-            //
-            // TODO add timeout configuration feature (care about VSCode, MSVS with Tizen plugin, standalone usage)
-
-            std::future_status timeoutStatus = f.wait_for(std::chrono::milliseconds(5000));
-            if (timeoutStatus == std::future_status::timeout)
-            {
-                LOGW("Evaluation timed out.");
-                LOGW("%s %s", "To prevent an unsafe abort when evaluating, all threads were allowed to run.",
-                     "This may have changed the state of the process and any breakpoints and exceptions encountered have been skipped.");
-
-                // NOTE
-                // All CoreCLR releases at least till version 3.1.3, don't have proper x86 implementation for ICorDebugEval::Abort().
-                // This issue looks like CoreCLR terminate managed process execution instead of abort evaluation.
-
-                // In this case we have same behaviour as MS vsdbg and MSVS C# debugger - run all managed threads and try to abort eval by any cost.
-                // Ignore errors here, this our last chance prevent debugger hangs.
-                iCorProcess->Stop(0);
-                ChangeThreadsState(THREAD_RUN);
-
-                if (FAILED(iCorEval->Abort()))
-                {
-                    ToRelease<ICorDebugEval2> iCorEval2;
-                    if (SUCCEEDED(iCorEval->QueryInterface(IID_ICorDebugEval2, (LPVOID*) &iCorEval2)))
-                        iCorEval2->RudeAbort();
-                }
+        RunGroup(iCorProcess, *group);
 
-                evalTimeOut = true;
-                iCorProcess->Continue(0);
-            }
-            // Wait for 5 more seconds, give `Abort()` a chance.
-            timeoutStatus = f.wait_for(std::chrono::milliseconds(5000));
-            if (timeoutStatus == std::future_status::timeout)
-            {
-                // Looks like can't be aborted, this is fatal error for debugger (debuggee have inconsistent state now).
-                iCorProcess->Stop(0);
-                m_evalResultMutex.lock();
-                m_evalResult.reset(nullptr);
-                m_evalResultMutex.unlock();
-                LOGE("Fatal error, eval abort failed.");
-                return E_UNEXPECTED;
-            }
-
-            auto evalResult = f.get();
-            IfFailRet(evalResult.get()->Status);
-
-            if (!ppEvalResult)
-                return S_OK;
-
-            *ppEvalResult = evalResult.get()->iCorEval.Detach();
-            return evalResult.get()->Status;
-        }
-        catch (const std::future_error&)
+        std::lock_guard<std::mutex> lock(m_scheduleMutex);
+        for (auto member : group->evals)
         {
-            return E_FAIL;
+            member->started = true;
         }
-    };
-
-    SetEnableCustomNotification(iCorProcess, TRUE);
-
-    m_evalCanceled = false;
-    m_evalCrossThreadDependency = false;
-    HRESULT ret = WaitResult();
+        m_scheduleCV.notify_all();
+    }
+    else
+    {
+        std::unique_lock<std::mutex> lock(m_scheduleMutex);
+        m_scheduleCV.wait(lock, [&]() { return eval.started; });
+    }
 
-    SetEnableCustomNotification(iCorProcess, FALSE);
+    HRESULT ret = WaitResult(iCorProcess, eval, evalFlags, ppEvalResult);
 
     if (ret == CORDBG_S_FUNC_EVAL_ABORTED)
     {
-        if (m_evalCrossThreadDependency)
+        if (eval.crossThreadDependency)
             ret = CORDBG_E_CANT_CALL_ON_THIS_THREAD;
         else
-            ret = m_evalCanceled ? COR_E_OPERATIONCANCELED : COR_E_TIMEOUT;
+            ret = eval.canceled ? COR_E_OPERATIONCANCELED : COR_E_TIMEOUT;
     }
     // In this case we have same behaviour as MS vsdbg and MSVS C# debugger - in case it was aborted with timeout, show proper error.
-    else if (evalTimeOut)
+    else if (eval.timedOut)
     {
         ret = (ret == E_UNEXPECTED) ? E_UNEXPECTED : COR_E_TIMEOUT;
     }
 
-    ChangeThreadsState(THREAD_RUN);
+    std::unique_lock<std::mutex> lock(m_scheduleMutex);
+    eval.finished = true;
+    m_scheduleCV.notify_all();
+    if (!eval.leader)
+    {
+        // Note, group members must not exit before leader restore threads states.
+        m_scheduleCV.wait(lock, [&]() { return eval.released; });
+        return ret;
+    }
+
+    m_scheduleCV.wait(lock, [&]()
+    {
+        return std::all_of(group->evals.begin(), group->evals.end(), [](pendingEval_t *member) { return member->finished; });
+    });
+    lock.unlock();
+
+    EndGroup(iCorProcess, *group);
+
+    lock.lock();
+    for (auto member : group->evals)
+    {
+        member->released = true;
+    }
+    m_groupRunning = false;
+    ScheduleGroup();
+    m_scheduleCV.notify_all();
     return ret;
 }
 
@@ -284,7 +540,7 @@ HRESULT EvalWaiter::ManagedCallbackCustomNotification(ICorDebugThread *pThread)
     // All CoreCLR releases at least till version 3.1.3, don't have proper x86 implementation for ICorDebugEval::Abort().
     // This issue looks like CoreCLR terminate managed process execution instead of abort evaluation.
 
-    // Note, could by only one eval running, but we need ignore custom notification from threads created during eval.
+    // Note, could by only one eval per thread running, but we need ignore custom notification from threads created during eval.
     // In this case we have same behaviour as MSVS C# debugger (ATM vsdbg don't support Debugger.NotifyOfCrossThreadDependency).
     ICorDebugEval *pEval = FindEvalForThread(pThread);
     if (pEval == nullptr)
@@ -300,7 +556,9 @@ HRESULT EvalWaiter::ManagedCallbackCustomNotification(ICorDebugThread *pThread)
         return Status;
     }
 
-    m_evalCrossThreadDependency = true;
+    DWORD threadId = 0;
+    pThread->GetID(&threadId);
+    SetEvalCrossThreadDependency(threadId);
     return S_OK;
 }
 
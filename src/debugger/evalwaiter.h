@@ -7,8 +7,14 @@
 #include "cor.h"
 #include "cordebug.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <future>
+#include <list>
+#include <mutex>
+#include <vector>
+#include "interfaces/types.h"
 #include "utils/torelease.h"
 
 namespace netcoredbg
@@ -29,33 +35,75 @@ public:
 
     typedef std::function<HRESULT(ICorDebugEval*)> WaitEvalResultCallback;
 
-    EvalWaiter() : m_evalCanceled(false), m_evalCrossThreadDependency(false) {}
+    // Same as MSVS NormalEvalTimeout default value (in milliseconds).
+    static const unsigned DefaultEvalTimeout = 5000;
+    // By default evaluations are run one by one.
+    static const unsigned DefaultMaxParallelEvals = 1;
+    static const unsigned MaxParallelEvalsLimit = 16;
+
+    EvalWaiter() :
+        m_evalTimeout(DefaultEvalTimeout),
+        m_adaptiveEvalTimeout(false),
+        m_maxParallelEvals(DefaultMaxParallelEvals),
+        m_evalsCount(0),
+        m_funcEvalDisabled(false),
+        m_groupRunning(false)
+    {}
+
+    // Note, per-request timeout from evalFlags (see EVAL_TIMEOUT_MASK) have priority over this setting.
+    void SetEvalTimeout(unsigned timeout) { m_evalTimeout = timeout ? timeout : DefaultEvalTimeout; }
+    unsigned GetEvalTimeout() const { return m_evalTimeout; }
+    // In adaptive mode, eval thread state is periodically checked during eval and eval aborted before timeout,
+    // in case thread blocked in wait/sleep/join (for example, waiting for lock owned by thread suspended during eval).
+    void SetAdaptiveEvalTimeout(bool enable) { m_adaptiveEvalTimeout = enable; }
+    bool IsAdaptiveEvalTimeout() const { return m_adaptiveEvalTimeout; }
+    // Evaluations requested at same time for different threads (for example, by requests of different lanes) could be run
+    // as group by one process continue, instead of one by one. Note, `0` is same as `1` (parallel evaluation disabled),
+    // count bigger than MaxParallelEvalsLimit is truncated.
+    void SetMaxParallelEvals(unsigned count);
+    unsigned GetMaxParallelEvals() const { return m_maxParallelEvals; }
+    // Note, dump analysis can't run any code in target, all evaluations with function call fail in this case.
+    void SetFuncEvalDisabled(bool disable) { m_funcEvalDisabled = disable; }
 
     bool IsEvalRunning();
+    // Count of evaluations run, could be used in order to detect that process was continued (and values neutered).
+    uint64_t GetEvalsCount() const { return m_evalsCount; }
 #ifdef INTEROP_DEBUGGING
-    DWORD GetEvalRunningThreadID();
+    bool IsEvalRunningOnThread(DWORD threadId);
     void SetInteropDebugger(std::shared_ptr<InteropDebugging::InteropDebugger> &sharedInteropDebugger);
     void ResetInteropDebugger();
 #endif // INTEROP_DEBUGGING
+    // Abort all running evaluations.
     void CancelEvalRunning();
     ICorDebugEval *FindEvalForThread(ICorDebugThread *pThread);
 
     HRESULT WaitEvalResult(ICorDebugThread *pThread,
                            ICorDebugValue **ppEvalResult,
-                           WaitEvalResultCallback cbSetupEval);
+                           WaitEvalResultCallback cbSetupEval,
+                           int evalFlags = defaultEvalFlags);
 
-    // Should be called by ICorDebugManagedCallback.
-    void NotifyEvalComplete(ICorDebugThread *pThread, ICorDebugEval *pEval);
+    // Should be called by ICorDebugManagedCallback. Return true in case other evaluations of group still running,
+    // in this case process must be continued by caller.
+    bool NotifyEvalComplete(ICorDebugThread *pThread, ICorDebugEval *pEval);
     HRESULT ManagedCallbackCustomNotification(ICorDebugThread *pThread);
     HRESULT SetupCrossThreadDependencyNotificationClass(ICorDebugModule *pModule);
 
 private:
 
-    bool m_evalCanceled;
-    bool m_evalCrossThreadDependency;
+    // Eval thread state check interval for adaptive mode, in milliseconds.
+    static const unsigned AdaptiveCheckInterval = 500;
+    // Time for eval abort after timeout, in milliseconds.
+    static const unsigned EvalAbortTimeout = 5000;
+
+    std::atomic<unsigned> m_evalTimeout;
+    std::atomic<bool> m_adaptiveEvalTimeout;
+    std::atomic<unsigned> m_maxParallelEvals;
+    std::atomic<uint64_t> m_evalsCount;
+    std::atomic<bool> m_funcEvalDisabled;
 
     ToRelease<ICorDebugClass> m_iCorCrossThreadDependencyNotification;
     HRESULT SetEnableCustomNotification(ICorDebugProcess *pProcess, BOOL fEnable);
+    bool IsEvalThreadBlocked(ICorDebugProcess *pProcess, ICorDebugThread *pThread);
 
 #ifdef INTEROP_DEBUGGING
     std::shared_ptr<InteropDebugging::InteropDebugger> m_sharedInteropDebugger;
@@ -65,6 +113,8 @@ private:
     {
         ToRelease<ICorDebugValue> iCorEval;
         HRESULT Status = E_FAIL;
+        bool canceled = false;
+        bool crossThreadDependency = false;
     };
 
     struct evalResult_t {
@@ -77,12 +127,17 @@ private:
         evalResult_t(DWORD threadId_, ICorDebugEval *pEval_, std::promise< std::unique_ptr<evalResultData_t> > &&promiseValue_) :
             threadId(threadId_),
             pEval(pEval_),
-            promiseValue(std::move(promiseValue_))
+            promiseValue(std::move(promiseValue_)),
+            canceled(false),
+            crossThreadDependency(false)
         {}
         evalResult_t(evalResult_t &&B) :
             threadId(B.threadId),
             pEval(B.pEval),
-            promiseValue(std::move(B.promiseValue))
+            promiseValue(std::move(B.promiseValue)),
+            data(std::move(B.data)),
+            canceled(B.canceled),
+            crossThreadDependency(B.crossThreadDependency)
         {}
 
         ~evalResult_t() = default;
@@ -90,18 +145,68 @@ private:
         DWORD threadId;
         ICorDebugEval *pEval;
         std::promise< std::unique_ptr<evalResultData_t> > promiseValue;
+        // Completed eval result, provided to waiter only after all evals of group completed.
+        std::unique_ptr<evalResultData_t> data;
+        bool canceled;
+        bool crossThreadDependency;
     };
 
-    std::mutex m_waitEvalResultMutex;
+    // Running evals (one per thread), all evals of group are run by one process continue.
     std::mutex m_evalResultMutex;
-    std::unique_ptr<evalResult_t> m_evalResult;
-
-    std::future< std::unique_ptr<evalResultData_t> > RunEval(
-        HRESULT &Status,
-        ICorDebugProcess *pProcess,
-        ICorDebugThread *pThread,
-        ICorDebugEval *pEval,
-        WaitEvalResultCallback cbSetupEval);
+    std::list<evalResult_t> m_evalResults;
+
+    struct evalGroup_t;
+
+    // Eval requested by WaitEvalResult() call, lives on stack of WaitEvalResult() caller. Note, group leader (first eval
+    // of group) setup all group evals and restore threads states after all group evals waiting done.
+    struct pendingEval_t
+    {
+        ICorDebugThread *pThread;
+        DWORD threadId;
+        WaitEvalResultCallback *cbSetupEval;
+
+        evalGroup_t *group = nullptr;
+        bool leader = false;
+        bool started = false;  // group setup done (or failed), eval result could be waited
+        bool finished = false; // eval result waiting done
+        bool released = false; // threads states restored, entry not used by leader anymore
+        bool timedOut = false;
+        bool canceled = false;
+        bool crossThreadDependency = false;
+
+        HRESULT Status = E_FAIL; // eval setup status
+        ToRelease<ICorDebugEval> iCorEval;
+        std::future< std::unique_ptr<evalResultData_t> > future;
+
+        pendingEval_t(ICorDebugThread *pThread_, DWORD threadId_, WaitEvalResultCallback *cbSetupEval_) :
+            pThread(pThread_), threadId(threadId_), cbSetupEval(cbSetupEval_)
+        {}
+    };
+
+    struct evalGroup_t
+    {
+        std::vector<pendingEval_t*> evals;
+        std::vector<DWORD> evalThreads;
+        // Eval threads, that was suspended by debugger before eval (non-stop mode).
+        std::vector<pendingEval_t*> suspendedEvalThreads;
+        // Threads, that was already suspended by debugger (non-stop mode stopped threads), must stay suspended after eval.
+        std::vector<DWORD> suspendedThreads;
+    };
+
+    std::mutex m_scheduleMutex;
+    std::condition_variable m_scheduleCV;
+    bool m_groupRunning;
+    std::list<pendingEval_t*> m_pendingEvals;
+    // Note, must be called with m_scheduleMutex locked.
+    void ScheduleGroup();
+
+    void ChangeThreadsState(ICorDebugProcess *pProcess, CorDebugThreadState state, evalGroup_t &group);
+    void RunGroup(ICorDebugProcess *pProcess, evalGroup_t &group);
+    void EndGroup(ICorDebugProcess *pProcess, evalGroup_t &group);
+    // Return true in case eval result is ready or eval already completed, but other group evals still running.
+    bool IsEvalCompleted(DWORD threadId);
+    void SetEvalCrossThreadDependency(DWORD threadId);
+    HRESULT WaitResult(ICorDebugProcess *pProcess, pendingEval_t &eval, int evalFlags, ICorDebugValue **ppEvalResult);
 
 };
 
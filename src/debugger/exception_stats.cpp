@@ -0,0 +1,102 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/exception_stats.h"
+
+#include <thread>
+
+namespace netcoredbg
+{
+
+namespace
+{
+
+    uint64_t Mix(uint64_t hash, uint64_t value)
+    {
+        hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    uint64_t GetHash(const ExceptionStats::exc_key_t &key)
+    {
+        uint64_t hash = Mix(0, key.typeModule);
+        hash = Mix(hash, key.typeToken);
+        hash = Mix(hash, key.methodModule);
+        hash = Mix(hash, key.methodToken);
+        hash = Mix(hash, key.ilOffset);
+        // Note, 0 is reserved for free slot.
+        return hash == 0 ? 1 : hash;
+    }
+
+} // unnamed namespace
+
+const size_t ExceptionStats::Capacity;
+
+ExceptionStats::ExceptionStats() :
+    m_slots(new slot_t[Capacity]),
+    m_dropped(0)
+{}
+
+bool ExceptionStats::Add(const exc_key_t &key)
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2");
+
+    const uint64_t hash = GetHash(key);
+    size_t index = size_t(hash) & (Capacity - 1);
+
+    // Linear probing, slot is claimed by hash with CAS, key is written by claimer and published by `ready` flag.
+    for (size_t probe = 0; probe < Capacity; probe++, index = (index + 1) & (Capacity - 1))
+    {
+        slot_t &slot = m_slots[index];
+        uint64_t slotHash = slot.hash.load(std::memory_order_acquire);
+        if (slotHash == 0)
+        {
+            if (slot.hash.compare_exchange_strong(slotHash, hash, std::memory_order_acq_rel))
+            {
+                slot.key = key;
+                slot.count.store(1, std::memory_order_relaxed);
+                slot.ready.store(true, std::memory_order_release);
+                return true;
+            }
+            // Note, in case of CAS fail `slotHash` have hash of key, that claimed this slot.
+        }
+
+        if (slotHash != hash)
+            continue;
+
+        // Same hash claimed slot, but key could be not written yet (claimer thread is between CAS and `ready` store).
+        while (!slot.ready.load(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+
+        if (slot.key == key)
+        {
+            slot.count.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void ExceptionStats::GetEntries(std::vector<entry_t> &entries, bool reset)
+{
+    for (size_t i = 0; i < Capacity; i++)
+    {
+        slot_t &slot = m_slots[i];
+        if (!slot.ready.load(std::memory_order_acquire))
+            continue;
+
+        const uint64_t count = reset ? slot.count.exchange(0, std::memory_order_relaxed) : slot.count.load(std::memory_order_relaxed);
+        if (count != 0)
+            entries.emplace_back(slot.key, count);
+    }
+
+    if (reset)
+        m_dropped.store(0, std::memory_order_relaxed);
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,77 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace netcoredbg
+{
+
+// Lock-free aggregation table for thrown exceptions statistics. Exceptions are added directly from managed callback
+// thread (without any lock), entries could be read at any time from protocol thread. Table have fixed capacity and
+// never free entries, reset drop counts only. Exceptions and throw-sites are stored as identity only (module address
+// and tokens), names are resolved by caller on demand.
+class ExceptionStats
+{
+public:
+
+    struct exc_key_t
+    {
+        uint64_t typeModule;    // exception type module base address
+        uint32_t typeToken;     // exception type typedef token
+        uint64_t methodModule;  // throw-site method module base address, 0 if exception was thrown outside of managed code
+        uint32_t methodToken;   // throw-site method token
+        uint32_t ilOffset;      // throw-site IL offset
+
+        exc_key_t(uint64_t typeModule_, uint32_t typeToken_, uint64_t methodModule_, uint32_t methodToken_, uint32_t ilOffset_) :
+            typeModule(typeModule_), typeToken(typeToken_), methodModule(methodModule_), methodToken(methodToken_), ilOffset(ilOffset_)
+        {}
+
+        bool operator==(const exc_key_t &other) const
+        {
+            return typeModule == other.typeModule && typeToken == other.typeToken && methodModule == other.methodModule &&
+                   methodToken == other.methodToken && ilOffset == other.ilOffset;
+        }
+    };
+
+    struct entry_t
+    {
+        exc_key_t key;
+        uint64_t count;
+
+        entry_t(const exc_key_t &key_, uint64_t count_) : key(key_), count(count_) {}
+    };
+
+    // Unique throw-sites limit, must be power of 2.
+    static const size_t Capacity = 4096;
+
+    ExceptionStats();
+
+    // Return `false` in case table is full and exception was counted as dropped.
+    bool Add(const exc_key_t &key);
+    // Entries with not zero count, in table order. In case `reset` is true, counts are reset during read.
+    void GetEntries(std::vector<entry_t> &entries, bool reset);
+    uint64_t GetDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+
+    struct slot_t
+    {
+        std::atomic<uint64_t> hash;  // 0 - free slot, otherwise slot claimed by key with this hash
+        std::atomic<bool> ready;     // key was written, could be read
+        exc_key_t key;
+        std::atomic<uint64_t> count;
+
+        slot_t() : hash(0), ready(false), key(0, 0, 0, 0, 0), count(0) {}
+    };
+
+    std::unique_ptr<slot_t[]> m_slots;
+    std::atomic<uint64_t> m_dropped;
+};
+
+} // namespace netcoredbg
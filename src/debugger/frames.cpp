@@ -2,7 +2,12 @@
 // Distributed under the MIT License.
 // See the LICENSE file in the project root for more information.
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 #include "debugger/frames.h"
 #include "metadata/typeprinter.h"
 #include "utils/platform.h"
@@ -29,6 +34,22 @@ namespace
 } // unnamed namespace
 #endif // INTEROP_DEBUGGING
 
+namespace
+{
+    // Note, set at debugger start, same for all walks, so frames levels are same for stack trace and GetFrameAt().
+    std::atomic<bool> g_nativeFramePlaceholders(true);
+
+    bool IsInteropSession()
+    {
+#ifdef INTEROP_DEBUGGING
+        std::lock_guard<std::mutex> lock(g_mutexInteropDebugger);
+        return g_pInteropDebugger != nullptr;
+#else
+        return false;
+#endif // INTEROP_DEBUGGING
+    }
+} // unnamed namespace
+
 static std::uintptr_t GetIP(CONTEXT *context)
 {
 #if defined(_TARGET_AMD64_)
@@ -148,7 +169,8 @@ static HRESULT EmptyContextForTopFrame(ICorDebugThread *pThread, WalkFramesCallb
 #endif // DEBUGGER_UNIX_ARM
 #endif // INTEROP_DEBUGGING
 
-static HRESULT UnwindNativeFrames(ICorDebugThread *pThread, bool firstFrame, CONTEXT *pStartContext, CONTEXT *pEndContext, WalkFramesCallback cb)
+static HRESULT UnwindNativeFrames(ICorDebugThread *pThread, bool firstFrame, CONTEXT *pStartContext, CONTEXT *pEndContext, WalkFramesCallback cb,
+                                  WalkFramesNativeFilter nativeFilter)
 {
 #ifdef INTEROP_DEBUGGING
     std::lock_guard<std::mutex> lock(g_mutexInteropDebugger);
@@ -170,7 +192,7 @@ static HRESULT UnwindNativeFrames(ICorDebugThread *pThread, bool firstFrame, CON
     return g_pInteropDebugger->UnwindNativeFrames(threadId, firstFrame, endAddr, pStartContext, [&](NativeFrame &nativeFrame)
     {
         return cb(FrameNative, nativeFrame.addr, nullptr, &nativeFrame);
-    });
+    }, nativeFilter);
 #else
     // In case not interop build we merge "CoreCLR native frame" and "user's native frame" into "[Native Frames]".
     return S_OK;
@@ -178,7 +200,8 @@ static HRESULT UnwindNativeFrames(ICorDebugThread *pThread, bool firstFrame, CON
 }
 
 #ifdef INTEROP_DEBUGGING
-static HRESULT UnwindInlinedTopNativeFrames(ICorDebugThread *pThread, ICorDebugFunction *pFunction, CONTEXT &currentCtx, WalkFramesCallback cb)
+static HRESULT UnwindInlinedTopNativeFrames(ICorDebugThread *pThread, ICorDebugFunction *pFunction, CONTEXT &currentCtx, WalkFramesCallback cb,
+                                            WalkFramesNativeFilter nativeFilter)
 {
     ToRelease<ICorDebugFunction2> iCorFunc2;
     BOOL bJustMyCode;
@@ -218,14 +241,73 @@ static HRESULT UnwindInlinedTopNativeFrames(ICorDebugThread *pThread, ICorDebugF
     IfFailRet(g_pInteropDebugger->UnwindNativeFrames(threadId, firstFrame, GetIP(&currentCtx), nullptr, [&](NativeFrame &nativeFrame)
     {
         return cb(FrameNative, nativeFrame.addr, nullptr, &nativeFrame);
-    }));
+    }, nativeFilter));
 
     return S_OK;
 }
 #endif // INTEROP_DEBUGGING
 
+// Pure managed session (no interop debugger) can't unwind native code, native frames of unmanaged chains are merged
+// into CoreCLR native frames ("[Native Frames]"), so, unmanaged chains registers contexts and native unwinding are not
+// needed. Registers context is read only for reported frames (frame address) and for top frame (FP fix).
+static HRESULT WalkManagedFrames(ICorDebugStackWalk *pStackWalk, WalkFramesCallback &cb)
+{
+    HRESULT Status;
+    static const ULONG32 ctxFlags = CONTEXT_CONTROL | CONTEXT_INTEGER;
+    const bool nativeFramePlaceholders = g_nativeFramePlaceholders.load();
+    CONTEXT currentCtx;
+    ULONG32 contextSize;
+    int level = -1;
+
+    for (Status = S_OK; ; Status = pStackWalk->Next())
+    {
+        if (Status == CORDBG_S_AT_END_OF_STACK)
+            break;
+
+        level++;
+
+        IfFailRet(Status);
+
+        ToRelease<ICorDebugFrame> iCorFrame;
+        IfFailRet(pStackWalk->GetFrame(&iCorFrame));
+        // S_FALSE - native stack frame (start of unmanaged chain), S_OK with nulled frame - runtime explicit frame.
+        if (Status == S_FALSE || iCorFrame == NULL)
+            continue;
+
+        ToRelease<ICorDebugRuntimeUnwindableFrame> iCorRuntimeUnwindableFrame;
+        if (SUCCEEDED(iCorFrame->QueryInterface(IID_ICorDebugRuntimeUnwindableFrame, (LPVOID *) &iCorRuntimeUnwindableFrame)))
+            continue;
+
+        FrameType frameType = FrameCLRManaged;
+        ToRelease<ICorDebugFunction> iCorFunction;
+        if (FAILED(iCorFrame->GetFunction(&iCorFunction)))
+        {
+            ToRelease<ICorDebugNativeFrame> iCorNativeFrame;
+            frameType = SUCCEEDED(iCorFrame->QueryInterface(IID_ICorDebugNativeFrame, (LPVOID*) &iCorNativeFrame)) ? FrameCLRNative : FrameUnknown;
+        }
+
+        const bool reportFrame = frameType != FrameCLRNative || nativeFramePlaceholders;
+        if (!reportFrame && level != 0)
+            continue;
+
+        memset(&currentCtx, 0, sizeof(CONTEXT));
+        IfFailRet(pStackWalk->GetContext(ctxFlags, sizeof(CONTEXT), &contextSize, (BYTE*) &currentCtx));
+        // Same as WalkFrames() do, see comment there.
+        if (level == 0 && GetSP(&currentCtx) != 0 && GetFP(&currentCtx) == 0)
+        {
+            SetFP(&currentCtx, GetSP(&currentCtx));
+            IfFailRet(pStackWalk->SetContext(SET_CONTEXT_FLAG_UNWIND_FRAME, sizeof(CONTEXT), (BYTE*) &currentCtx));
+        }
+
+        if (reportFrame)
+            IfFailRet(cb(frameType, GetIP(&currentCtx), iCorFrame, nullptr));
+    }
+
+    return S_OK;
+}
+
 // From https://github.com/SymbolSource/Microsoft.Samples.Debugging/blob/master/src/debugger/mdbgeng/FrameFactory.cs
-HRESULT WalkFrames(ICorDebugThread *pThread, WalkFramesCallback cb)
+HRESULT WalkFrames(ICorDebugThread *pThread, WalkFramesCallback cb, WalkFramesNativeFilter nativeFilter)
 {
     HRESULT Status;
 
@@ -234,6 +316,9 @@ HRESULT WalkFrames(ICorDebugThread *pThread, WalkFramesCallback cb)
     ToRelease<ICorDebugStackWalk> iCorStackWalk;
     IfFailRet(iCorThread3->CreateStackWalk(&iCorStackWalk));
 
+    if (!IsInteropSession())
+        return WalkManagedFrames(iCorStackWalk, cb);
+
     static const ULONG32 ctxFlags = CONTEXT_CONTROL | CONTEXT_INTEGER;
     CONTEXT ctxUnmanagedChain;
     bool ctxUnmanagedChainValid = false;
@@ -314,7 +399,7 @@ HRESULT WalkFrames(ICorDebugThread *pThread, WalkFramesCallback cb)
             else
 #endif // DEBUGGER_UNIX_ARM
 #endif // INTEROP_DEBUGGING
-            IfFailRet(UnwindNativeFrames(pThread, !firstFrame, &ctxUnmanagedChain, &currentCtx, cb));
+            IfFailRet(UnwindNativeFrames(pThread, !firstFrame, &ctxUnmanagedChain, &currentCtx, cb, nativeFilter));
             level++;
             // Clear out the CONTEXT
             memset(&ctxUnmanagedChain, 0, sizeof(CONTEXT));
@@ -328,7 +413,7 @@ HRESULT WalkFrames(ICorDebugThread *pThread, WalkFramesCallback cb)
 #ifdef INTEROP_DEBUGGING
             // In case of optimized managed code, top frame could be native (optimized code could have inlined pinvoke).
             // Note, breakpoint can't be set in optimized managed code and step can't stop here, since this code is not JMC for sure.
-            if (level == 0 && FAILED(Status = UnwindInlinedTopNativeFrames(pThread, iCorFunction.GetPtr(), currentCtx, cb)))
+            if (level == 0 && FAILED(Status = UnwindInlinedTopNativeFrames(pThread, iCorFunction.GetPtr(), currentCtx, cb, nativeFilter)))
                 return Status;
 #endif // INTEROP_DEBUGGING
 
@@ -356,7 +441,7 @@ HRESULT WalkFrames(ICorDebugThread *pThread, WalkFramesCallback cb)
             else
 #endif // DEBUGGER_UNIX_ARM
 #endif // INTEROP_DEBUGGING
-            IfFailRet(UnwindNativeFrames(pThread, firstFrame, nullptr, &currentCtx, cb));
+            IfFailRet(UnwindNativeFrames(pThread, firstFrame, nullptr, &currentCtx, cb, nativeFilter));
         }
         IfFailRet(cb(FrameCLRNative, GetIP(&currentCtx), iCorFrame, nullptr));
     }
@@ -365,7 +450,7 @@ HRESULT WalkFrames(ICorDebugThread *pThread, WalkFramesCallback cb)
     if (ctxUnmanagedChainValid)
     {
         if (level == 0) // in case this is first and last frame - unwind all
-            IfFailRet(UnwindNativeFrames(pThread, firstFrame, nullptr, nullptr, cb));
+            IfFailRet(UnwindNativeFrames(pThread, firstFrame, nullptr, nullptr, cb, nativeFilter));
         else
         {
 #ifdef INTEROP_DEBUGGING
@@ -377,13 +462,62 @@ HRESULT WalkFrames(ICorDebugThread *pThread, WalkFramesCallback cb)
             else
 #endif // DEBUGGER_UNIX_ARM
 #endif // INTEROP_DEBUGGING
-            IfFailRet(UnwindNativeFrames(pThread, !firstFrame, &ctxUnmanagedChain, nullptr, cb));
+            IfFailRet(UnwindNativeFrames(pThread, !firstFrame, &ctxUnmanagedChain, nullptr, cb, nativeFilter));
         }
     }
 
     return S_OK;
 }
 
+namespace
+{
+    // Top frames of threads for current stop, filled by frames walk in GetFrameAt(), aimed to provide frame for level without frames walk.
+    // Note, CoreCLR neuter all frames at any process continue (including func-eval), so, cached frame is checked before use.
+    struct thread_frames_t
+    {
+        std::vector<ToRelease<ICorDebugFrame>> frames; // nullptr for not managed frame
+        bool complete = false; // all thread's frames walked
+    };
+    std::mutex g_framesCacheMutex;
+    std::unordered_map<DWORD, thread_frames_t> g_framesCache;
+    // Note, frames walk don't hold mutex, generation prevent store of outdated frames, if cache was invalidated during walk.
+    uint64_t g_framesCacheGeneration = 0;
+
+    // Return S_FALSE in case cache don't have data for this level.
+    HRESULT GetCachedFrameAt(DWORD threadId, FrameLevel level, ICorDebugFrame **ppFrame, size_t &cachedFrames)
+    {
+        cachedFrames = 0;
+        auto find = g_framesCache.find(threadId);
+        if (find == g_framesCache.end())
+            return S_FALSE;
+
+        thread_frames_t &threadFrames = find->second;
+        if (size_t(level) >= threadFrames.frames.size())
+        {
+            if (threadFrames.complete)
+                return E_FAIL;
+            cachedFrames = threadFrames.frames.size();
+            return S_FALSE;
+        }
+
+        ICorDebugFrame *pFrame = threadFrames.frames[int(level)].GetPtr();
+        if (pFrame == nullptr)
+            return E_FAIL;
+
+        // Note, any call for neutered frame fail with CORDBG_E_OBJECT_NEUTERED.
+        mdMethodDef methodDef;
+        if (FAILED(pFrame->GetFunctionToken(&methodDef)))
+        {
+            g_framesCache.erase(find);
+            return S_FALSE;
+        }
+
+        pFrame->AddRef();
+        *ppFrame = pFrame;
+        return S_OK;
+    }
+} // unnamed namespace
+
 HRESULT GetFrameAt(ICorDebugThread *pThread, FrameLevel level, ICorDebugFrame **ppFrame)
 {
     // Try get 0 (current active) frame in fast way, if possible.
@@ -392,32 +526,67 @@ HRESULT GetFrameAt(ICorDebugThread *pThread, FrameLevel level, ICorDebugFrame **
         *ppFrame != nullptr)
         return S_OK;
 
-    int currentFrame = -1;
+    HRESULT Status;
+    DWORD threadId = 0;
+    IfFailRet(pThread->GetID(&threadId));
 
-    WalkFrames(pThread, [&](
+    size_t cachedFrames;
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(g_framesCacheMutex);
+        if ((Status = GetCachedFrameAt(threadId, level, ppFrame, cachedFrames)) != S_FALSE)
+            return Status;
+        generation = g_framesCacheGeneration;
+    }
+
+    // Note, in case frames for deep levels requested one by one, walk at least twice more frames than before.
+    const int walkLevel = std::max(int(level), int(cachedFrames * 2));
+    thread_frames_t threadFrames;
+    Status = WalkFrames(pThread, [&](
         FrameType frameType,
         std::uintptr_t addr,
         ICorDebugFrame *pFrame,
         NativeFrame *pNative)
     {
-        currentFrame++;
+        if ((int)threadFrames.frames.size() > walkLevel)
+            return E_ABORT; // Fast exit from cycle.
 
-        if (currentFrame < int(level))
-            return S_OK;
-        else if (currentFrame > int(level))
-            return E_FAIL;
+        if (frameType == FrameCLRManaged)
+            pFrame->AddRef();
+        threadFrames.frames.emplace_back(frameType == FrameCLRManaged ? pFrame : nullptr);
+        return S_OK;
+    },
+    []()
+    {
+        return false; // Only managed frame could be found, native frames symbolization is not required.
+    });
+    threadFrames.complete = SUCCEEDED(Status);
 
-        if (currentFrame != int(level) || frameType != FrameCLRManaged)
-            return S_OK;
+    if (size_t(level) < threadFrames.frames.size() && threadFrames.frames[int(level)] != nullptr)
+    {
+        threadFrames.frames[int(level)]->AddRef();
+        *ppFrame = threadFrames.frames[int(level)].GetPtr();
+    }
 
-        pFrame->AddRef();
-        *ppFrame = pFrame;
-        return E_ABORT; // Fast exit from cycle.
-    });
+    std::lock_guard<std::mutex> lock(g_framesCacheMutex);
+    if (generation == g_framesCacheGeneration)
+        g_framesCache[threadId] = std::move(threadFrames);
 
     return *ppFrame != nullptr ? S_OK : E_FAIL;
 }
 
+void SetNativeFramePlaceholders(bool enable)
+{
+    g_nativeFramePlaceholders.store(enable);
+}
+
+void InvalidateFramesCache()
+{
+    std::lock_guard<std::mutex> lock(g_framesCacheMutex);
+    g_framesCache.clear();
+    g_framesCacheGeneration++;
+}
+
 const char *GetInternalTypeName(CorDebugInternalFrameType frameType)
 {
     switch(frameType)
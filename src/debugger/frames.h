@@ -32,12 +32,22 @@ struct NativeFrame
 };
 
 typedef std::function<HRESULT(FrameType,std::uintptr_t,ICorDebugFrame*,NativeFrame*)> WalkFramesCallback;
+// Called before each native frame symbolization, return `false` in case next frame will be skipped by WalkFramesCallback.
+typedef std::function<bool()> WalkFramesNativeFilter;
 
 struct Thread;
 
+// Note, frames walked by GetFrameAt() are cached till InvalidateFramesCache() call, so, frame lookup by level don't walk stack each time.
 HRESULT GetFrameAt(ICorDebugThread *pThread, FrameLevel level, ICorDebugFrame **ppFrame);
+// Called with stack trace cache invalidate, release all cached frames.
+void InvalidateFramesCache();
 const char *GetInternalTypeName(CorDebugInternalFrameType frameType);
-HRESULT WalkFrames(ICorDebugThread *pThread, WalkFramesCallback cb);
+// Note, in session without interop debugging native code is not unwound, `nativeFilter` is not called and
+// CoreCLR native frames (FrameCLRNative) are placeholders for all native frames between managed frames.
+HRESULT WalkFrames(ICorDebugThread *pThread, WalkFramesCallback cb, WalkFramesNativeFilter nativeFilter = nullptr);
+// Don't report CoreCLR native frames in session without interop debugging, only managed frames are walked.
+// Must be called before debugging start, since frames levels depend on it.
+void SetNativeFramePlaceholders(bool enable);
 
 #ifdef INTEROP_DEBUGGING
 namespace InteropDebugging
@@ -0,0 +1,133 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/gcroot_search.h"
+
+#include <algorithm>
+
+namespace netcoredbg
+{
+
+const uint32_t GCRootSearch::RootFlag;
+
+GCRootSearch::GCRootSearch(uint32_t pointerSize, uint64_t memoryLimit) :
+    m_pointerSize(pointerSize == 0 ? sizeof(void*) : pointerSize),
+    m_memoryLimit(memoryLimit)
+{
+}
+
+void GCRootSearch::AddSegment(uint64_t start, uint64_t end)
+{
+    if (end > start)
+        m_segments.emplace_back(start, end);
+}
+
+void GCRootSearch::AddRoot(uint32_t rootId, uint64_t address)
+{
+    if (address != 0)
+        m_roots.emplace_back(rootId, address);
+}
+
+bool GCRootSearch::TestAndSetVisited(uint64_t address)
+{
+    auto it = std::upper_bound(m_segments.begin(), m_segments.end(), address,
+                               [](uint64_t value, const segment_t &segment) { return value < segment.start; });
+    if (it == m_segments.begin() || address >= (--it)->end)
+        return !m_outOfSegments.insert(address).second;
+
+    const uint64_t bit = it->bitsOffset + (address - it->start) / m_pointerSize;
+    uint64_t &word = m_bitmap[bit / 64];
+    const uint64_t mask = uint64_t(1) << (bit % 64);
+    if (word & mask)
+        return true;
+    word |= mask;
+    return false;
+}
+
+uint64_t GCRootSearch::GetMemoryUsage() const
+{
+    // Note, unordered_set node size is implementation defined, count address, hash and pointer to next node.
+    return m_bitmap.size() * sizeof(uint64_t) + m_outOfSegments.size() * sizeof(uint64_t) * 3 +
+           m_objects.size() * (sizeof(uint64_t) + sizeof(uint32_t));
+}
+
+void GCRootSearch::GetPath(uint32_t index, uint32_t &rootId, std::vector<uint64_t> &path) const
+{
+    path.clear();
+    while (true)
+    {
+        path.push_back(m_objects[index]);
+        if (m_parents[index] & RootFlag)
+        {
+            rootId = m_parents[index] & ~RootFlag;
+            break;
+        }
+        index = m_parents[index];
+    }
+    std::reverse(path.begin(), path.end());
+}
+
+GCRootSearch::Result GCRootSearch::Find(uint64_t target, const ReferencesCallback &getReferences, uint32_t &rootId,
+                                        std::vector<uint64_t> &path)
+{
+    // Note, overlapped segments are not expected, but must not break bitmap indexing.
+    std::sort(m_segments.begin(), m_segments.end(), [](const segment_t &a, const segment_t &b) { return a.start < b.start; });
+    uint64_t bitsCount = 0;
+    for (size_t i = 0; i < m_segments.size(); i++)
+    {
+        if (i > 0 && m_segments[i].start < m_segments[i - 1].end)
+            m_segments[i].start = m_segments[i - 1].end;
+        if (m_segments[i].end < m_segments[i].start)
+            m_segments[i].end = m_segments[i].start;
+
+        m_segments[i].bitsOffset = bitsCount;
+        bitsCount += (m_segments[i].end - m_segments[i].start + m_pointerSize - 1) / m_pointerSize;
+    }
+    if ((bitsCount + 63) / 64 * sizeof(uint64_t) > m_memoryLimit)
+        return Result::MemoryLimit;
+    m_bitmap.assign((bitsCount + 63) / 64, 0);
+
+    for (const root_t &root : m_roots)
+    {
+        if (TestAndSetVisited(root.address))
+            continue;
+
+        m_objects.push_back(root.address);
+        m_parents.push_back(RootFlag | root.rootId);
+        if (root.address == target)
+        {
+            GetPath(uint32_t(m_objects.size() - 1), rootId, path);
+            return Result::Found;
+        }
+    }
+
+    std::vector<uint64_t> references;
+    for (size_t head = 0; head < m_objects.size(); head++)
+    {
+        references.clear();
+        if (!getReferences(m_objects[head], references))
+            return Result::Aborted;
+
+        for (uint64_t reference : references)
+        {
+            if (reference == 0 || TestAndSetVisited(reference))
+                continue;
+
+            if (m_objects.size() >= RootFlag || GetMemoryUsage() > m_memoryLimit)
+                return Result::MemoryLimit;
+
+            m_objects.push_back(reference);
+            m_parents.push_back(uint32_t(head));
+            if (reference == target)
+            {
+                GetPath(uint32_t(m_objects.size() - 1), rootId, path);
+                return Result::Found;
+            }
+        }
+    }
+
+    return Result::NotFound;
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,80 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+namespace netcoredbg
+{
+
+// Breadth-first search of shortest references path from GC roots to target object. Designed for large heaps:
+// visited objects are marked in bitmap (one bit per pointer size slot of heap segments), frontier and parents are
+// stored in flat arrays (12 bytes per reached object). Objects outside of heap segments are tracked by address set.
+class GCRootSearch
+{
+public:
+
+    enum class Result
+    {
+        Found,
+        NotFound,
+        MemoryLimit,
+        Aborted
+    };
+
+    // Fill addresses of objects referenced by object at `address` (except null references), return `false` to abort search.
+    typedef std::function<bool(uint64_t address, std::vector<uint64_t> &references)> ReferencesCallback;
+
+    GCRootSearch(uint32_t pointerSize, uint64_t memoryLimit);
+
+    // Segments and roots must be added before search.
+    void AddSegment(uint64_t start, uint64_t end);
+    void AddRoot(uint32_t rootId, uint64_t address);
+    // In case of success, `path` contains objects from root object to target.
+    Result Find(uint64_t target, const ReferencesCallback &getReferences, uint32_t &rootId, std::vector<uint64_t> &path);
+
+private:
+
+    struct segment_t
+    {
+        uint64_t start;
+        uint64_t end;
+        uint64_t bitsOffset;
+
+        segment_t(uint64_t start_, uint64_t end_) : start(start_), end(end_), bitsOffset(0) {}
+    };
+
+    struct root_t
+    {
+        uint32_t rootId;
+        uint64_t address;
+
+        root_t(uint32_t rootId_, uint64_t address_) : rootId(rootId_), address(address_) {}
+    };
+
+    // Root objects have parent with RootFlag and root id.
+    static const uint32_t RootFlag = 0x80000000;
+
+    // Return `true` in case object was already visited.
+    bool TestAndSetVisited(uint64_t address);
+    uint64_t GetMemoryUsage() const;
+    void GetPath(uint32_t index, uint32_t &rootId, std::vector<uint64_t> &path) const;
+
+    uint32_t m_pointerSize;
+    uint64_t m_memoryLimit;
+    std::vector<segment_t> m_segments;
+    std::vector<root_t> m_roots;
+    std::vector<uint64_t> m_bitmap;
+    std::unordered_set<uint64_t> m_outOfSegments;
+    // Reached objects in discovery order (BFS queue) and parent index for each object.
+    std::vector<uint64_t> m_objects;
+    std::vector<uint32_t> m_parents;
+};
+
+} // namespace netcoredbg
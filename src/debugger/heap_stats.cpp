@@ -0,0 +1,61 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/heap_stats.h"
+
+#include <algorithm>
+
+namespace netcoredbg
+{
+
+HeapStats::HeapStats() :
+    m_lastKey(nullptr),
+    m_lastCounters(nullptr),
+    m_objectsCount(0),
+    m_totalSize(0)
+{
+}
+
+void HeapStats::Add(const type_key_t &key, uint64_t size)
+{
+    if (m_lastKey == nullptr || !(*m_lastKey == key))
+    {
+        auto it = m_types.emplace(key, counters_t()).first;
+        m_lastKey = &it->first;
+        m_lastCounters = &it->second;
+    }
+
+    m_lastCounters->count++;
+    m_lastCounters->size += size;
+    m_objectsCount++;
+    m_totalSize += size;
+}
+
+void HeapStats::GetTop(size_t count, bool byCount, std::vector<entry_t> &entries) const
+{
+    entries.clear();
+    entries.reserve(m_types.size());
+    for (const auto &type : m_types)
+    {
+        entries.emplace_back(type.first, type.second.count, type.second.size);
+    }
+
+    // Note, types order in unordered_map is not defined, compare keys for stable result.
+    auto compare = [byCount](const entry_t &a, const entry_t &b)
+    {
+        const uint64_t first = byCount ? a.count : a.size;
+        const uint64_t second = byCount ? b.count : b.size;
+        if (first != second)
+            return first > second;
+        if (a.key.token1 != b.key.token1)
+            return a.key.token1 < b.key.token1;
+        return a.key.token2 < b.key.token2;
+    };
+
+    count = std::min(count, entries.size());
+    std::partial_sort(entries.begin(), entries.begin() + count, entries.end(), compare);
+    entries.erase(entries.begin() + count, entries.end());
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,79 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace netcoredbg
+{
+
+// Managed heap objects aggregation by type. Types are stored as runtime type identity only (COR_TYPEID tokens),
+// so, memory is bounded by number of types in heap (not number of objects), names are resolved by caller on demand.
+class HeapStats
+{
+public:
+
+    struct type_key_t
+    {
+        uint64_t token1;
+        uint64_t token2;
+
+        type_key_t(uint64_t token1_, uint64_t token2_) : token1(token1_), token2(token2_) {}
+
+        bool operator==(const type_key_t &other) const
+        {
+            return token1 == other.token1 && token2 == other.token2;
+        }
+    };
+
+    struct entry_t
+    {
+        type_key_t key;
+        uint64_t count;
+        uint64_t size;
+
+        entry_t(const type_key_t &key_, uint64_t count_, uint64_t size_) : key(key_), count(count_), size(size_) {}
+    };
+
+    HeapStats();
+
+    void Add(const type_key_t &key, uint64_t size);
+    // Top `count` types sorted by size (or by objects count) in descending order.
+    void GetTop(size_t count, bool byCount, std::vector<entry_t> &entries) const;
+    uint64_t GetObjectsCount() const { return m_objectsCount; }
+    uint64_t GetTotalSize() const { return m_totalSize; }
+    size_t GetTypesCount() const { return m_types.size(); }
+
+private:
+
+    struct counters_t
+    {
+        uint64_t count;
+        uint64_t size;
+
+        counters_t() : count(0), size(0) {}
+    };
+
+    struct key_hash_t
+    {
+        size_t operator()(const type_key_t &key) const
+        {
+            return std::hash<uint64_t>()(key.token1 ^ (key.token2 * 0x9e3779b97f4a7c15ULL));
+        }
+    };
+
+    std::unordered_map<type_key_t, counters_t, key_hash_t> m_types;
+    // Note, objects of same type are usually allocated together, so, last type lookup is cached.
+    // Pointer to unordered_map value is stable until entry erase.
+    const type_key_t *m_lastKey;
+    counters_t *m_lastCounters;
+    uint64_t m_objectsCount;
+    uint64_t m_totalSize;
+};
+
+} // namespace netcoredbg
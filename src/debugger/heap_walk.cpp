@@ -0,0 +1,583 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/heap_walk.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#include "debugger/gcroot_search.h"
+#include "debugger/heap_stats.h"
+#include "metadata/typeprinter.h"
+#include "utils/cancellation.h"
+#include "utils/logger.h"
+#include "utils/torelease.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+
+    // Objects fetched from heap enumerator at once.
+    const ULONG HeapObjectsBatch = 1024;
+    // Partial statistics provided to progress callback each ProgressObjectsCount objects.
+    const uint64_t ProgressObjectsCount = 1024 * 1024;
+
+    // COR_TYPEID tokens.
+    typedef std::pair<uint64_t, uint64_t> type_id_t;
+
+    struct type_id_hash_t
+    {
+        size_t operator()(const type_id_t &key) const
+        {
+            return std::hash<uint64_t>()(key.first ^ (key.second * 0x9e3779b97f4a7c15ULL));
+        }
+    };
+
+    class TypeNames
+    {
+    public:
+
+        TypeNames(ICorDebugProcess5 *pProcess5) : m_pProcess5(pProcess5) {}
+
+        // Note, same top types are resolved for each partial statistics, names are cached during walk.
+        const std::string &Get(const HeapStats::type_key_t &key)
+        {
+            const type_id_t cacheKey(key.token1, key.token2);
+            auto find = m_names.find(cacheKey);
+            if (find != m_names.end())
+                return find->second;
+
+            std::string &name = m_names[cacheKey];
+            COR_TYPEID typeId;
+            typeId.token1 = key.token1;
+            typeId.token2 = key.token2;
+            ToRelease<ICorDebugType> iCorType;
+            if (FAILED(m_pProcess5->GetTypeForTypeID(typeId, &iCorType)) ||
+                FAILED(TypePrinter::GetTypeOfValue(iCorType, name)) ||
+                name.empty())
+            {
+                // Note, free space (gaps between objects) is reported by runtime as objects of special type too.
+                name = "<unknown type>";
+            }
+            return name;
+        }
+
+    private:
+
+        ICorDebugProcess5 *m_pProcess5;
+        std::unordered_map<type_id_t, std::string, type_id_hash_t> m_names;
+    };
+
+    void FillStatistics(const HeapStats &stats, TypeNames &names, unsigned topCount, bool sortByCount, bool complete,
+                        HeapStatistics &statistics)
+    {
+        statistics.objectsCount = stats.GetObjectsCount();
+        statistics.totalSize = stats.GetTotalSize();
+        statistics.typesCount = stats.GetTypesCount();
+        statistics.complete = complete;
+
+        std::vector<HeapStats::entry_t> entries;
+        stats.GetTop(topCount, sortByCount, entries);
+        statistics.types.clear();
+        statistics.types.reserve(entries.size());
+        for (const auto &entry : entries)
+        {
+            statistics.types.emplace_back();
+            HeapTypeStatistic &type = statistics.types.back();
+            type.typeName = names.Get(entry.key);
+            type.count = entry.count;
+            type.size = entry.size;
+        }
+    }
+
+    // Types hierarchy depth limit for derived types check.
+    const int TypeHierarchyDepthLimit = 32;
+
+    // Memoized check, that type is base type or derived from it.
+    class DerivedTypes
+    {
+    public:
+
+        DerivedTypes(ICorDebugProcess5 *pProcess5, COR_TYPEID baseTypeId) :
+            m_pProcess5(pProcess5), m_base(baseTypeId.token1, baseTypeId.token2), m_lastKey(0, 0), m_lastResult(false)
+        {}
+
+        bool IsDerived(COR_TYPEID typeId)
+        {
+            // Note, heap usually have sequences of objects with same type.
+            const type_id_t key(typeId.token1, typeId.token2);
+            if (key == m_lastKey)
+                return m_lastResult;
+
+            m_lastKey = key;
+            m_lastResult = Check(typeId);
+            return m_lastResult;
+        }
+
+    private:
+
+        ICorDebugProcess5 *m_pProcess5;
+        type_id_t m_base;
+        std::unordered_map<type_id_t, bool, type_id_hash_t> m_types;
+        type_id_t m_lastKey;
+        bool m_lastResult;
+
+        bool Check(COR_TYPEID typeId)
+        {
+            // Note, all types of hierarchy, that was not checked before, are stored with same result.
+            std::vector<type_id_t> chain;
+            bool result = false;
+            COR_TYPEID currentId = typeId;
+            for (int depth = 0; depth < TypeHierarchyDepthLimit; depth++)
+            {
+                const type_id_t current(currentId.token1, currentId.token2);
+                if (current == m_base)
+                {
+                    result = true;
+                    break;
+                }
+                auto find = m_types.find(current);
+                if (find != m_types.end())
+                {
+                    result = find->second;
+                    break;
+                }
+                chain.push_back(current);
+
+                COR_TYPE_LAYOUT layout;
+                if (FAILED(m_pProcess5->GetTypeLayout(currentId, &layout)) ||
+                    (layout.parentID.token1 == 0 && layout.parentID.token2 == 0))
+                    break;
+                currentId = layout.parentID;
+            }
+
+            for (const auto &entry : chain)
+            {
+                m_types[entry] = result;
+            }
+            return result;
+        }
+    };
+
+    // Memory limit for root path search data (visited bitmap, frontier and parents).
+    const uint64_t RootSearchMemoryLimit = uint64_t(1024) * 1024 * 1024;
+    // Roots fetched from references enumerator at once.
+    const ULONG RootsBatch = 256;
+    // Array elements read from debuggee memory at once.
+    const uint32_t ArrayReadBytes = 64 * 1024;
+    // Nested value types fields depth limit.
+    const int ValueTypeDepthLimit = 8;
+
+    bool IsReferenceElementType(CorElementType elementType)
+    {
+        return elementType == ELEMENT_TYPE_CLASS || elementType == ELEMENT_TYPE_OBJECT || elementType == ELEMENT_TYPE_STRING ||
+               elementType == ELEMENT_TYPE_SZARRAY || elementType == ELEMENT_TYPE_ARRAY;
+    }
+
+    const char *GetRootKind(CorGCReferenceType type)
+    {
+        switch (type)
+        {
+            case CorHandleStrong: return "strong handle";
+            case CorHandleStrongPinning: return "pinned handle";
+            case CorHandleStrongRefCount: return "ref counted handle";
+            case CorHandleStrongDependent: return "dependent handle";
+            case CorHandleStrongAsyncPinned: return "async pinned handle";
+            case CorHandleStrongSizedByref: return "sized ref handle";
+            case CorReferenceStack: return "stack";
+            case CorReferenceFinalizer: return "finalizer queue";
+            default: return "handle";
+        }
+    }
+
+    // Objects references extraction by runtime types layout, references offsets are calculated once for each type.
+    class ReferencesReader
+    {
+    public:
+
+        ReferencesReader(ICorDebugProcess *pProcess, ICorDebugProcess5 *pProcess5, uint32_t pointerSize) :
+            m_pProcess(pProcess), m_pProcess5(pProcess5), m_pointerSize(pointerSize)
+        {}
+
+        // Note, objects with unknown layout (or not readable memory) are treated as objects without references.
+        void GetReferences(uint64_t address, std::vector<uint64_t> &references);
+
+    private:
+
+        struct type_refs_t
+        {
+            bool isArray;
+            bool elementIsReference;
+            uint32_t firstElementOffset;
+            uint32_t elementSize;
+            uint32_t countOffset;
+            uint32_t readSize;              // object bytes, that contain all references (not array)
+            std::vector<uint32_t> offsets;  // references offsets from object start (or from array element start)
+
+            type_refs_t() : isArray(false), elementIsReference(false), firstElementOffset(0), elementSize(0), countOffset(0), readSize(0) {}
+        };
+
+        HRESULT AddFieldsReferences(COR_TYPEID typeId, uint32_t baseOffset, int depth, std::vector<uint32_t> &offsets);
+        HRESULT GetTypeReferences(COR_TYPEID typeId, type_refs_t &refs);
+        uint64_t ReadPointer(const BYTE *buffer);
+
+        ICorDebugProcess *m_pProcess;
+        ICorDebugProcess5 *m_pProcess5;
+        uint32_t m_pointerSize;
+        std::unordered_map<type_id_t, type_refs_t, type_id_hash_t> m_types;
+        std::vector<BYTE> m_buffer;
+    };
+
+    // Note, instance fields offsets are provided by runtime from object start for reference types and from value start
+    // for value types, fields of parent types are provided for parent type only.
+    HRESULT ReferencesReader::AddFieldsReferences(COR_TYPEID typeId, uint32_t baseOffset, int depth, std::vector<uint32_t> &offsets)
+    {
+        HRESULT Status;
+        COR_TYPE_LAYOUT layout;
+        IfFailRet(m_pProcess5->GetTypeLayout(typeId, &layout));
+
+        if (layout.type != ELEMENT_TYPE_VALUETYPE && (layout.parentID.token1 != 0 || layout.parentID.token2 != 0))
+            IfFailRet(AddFieldsReferences(layout.parentID, baseOffset, depth, offsets));
+
+        if (layout.numFields == 0)
+            return S_OK;
+
+        std::vector<COR_FIELD> fields(layout.numFields);
+        ULONG32 fetched = 0;
+        IfFailRet(m_pProcess5->GetTypeFields(typeId, layout.numFields, fields.data(), &fetched));
+        for (ULONG32 i = 0; i < fetched && i < layout.numFields; i++)
+        {
+            if (IsReferenceElementType(fields[i].fieldType))
+                offsets.push_back(baseOffset + fields[i].offset);
+            else if (fields[i].fieldType == ELEMENT_TYPE_VALUETYPE && depth < ValueTypeDepthLimit)
+                IfFailRet(AddFieldsReferences(fields[i].id, baseOffset + fields[i].offset, depth + 1, offsets));
+        }
+        return S_OK;
+    }
+
+    HRESULT ReferencesReader::GetTypeReferences(COR_TYPEID typeId, type_refs_t &refs)
+    {
+        HRESULT Status;
+        COR_TYPE_LAYOUT layout;
+        IfFailRet(m_pProcess5->GetTypeLayout(typeId, &layout));
+
+        if (layout.type == ELEMENT_TYPE_STRING)
+            return S_OK;
+
+        if (layout.type == ELEMENT_TYPE_SZARRAY || layout.type == ELEMENT_TYPE_ARRAY)
+        {
+            COR_ARRAY_LAYOUT arrayLayout;
+            IfFailRet(m_pProcess5->GetArrayLayout(typeId, &arrayLayout));
+            refs.isArray = true;
+            refs.firstElementOffset = arrayLayout.firstElementOffset;
+            refs.elementSize = arrayLayout.elementSize;
+            refs.countOffset = arrayLayout.countOffset;
+            refs.elementIsReference = IsReferenceElementType(arrayLayout.componentType);
+            if (!refs.elementIsReference && arrayLayout.componentType == ELEMENT_TYPE_VALUETYPE)
+                IfFailRet(AddFieldsReferences(arrayLayout.componentID, 0, 0, refs.offsets));
+            return S_OK;
+        }
+
+        // Note, boxed value fields are located after method table pointer.
+        const uint32_t baseOffset = layout.type == ELEMENT_TYPE_VALUETYPE ? layout.boxOffset : 0;
+        IfFailRet(AddFieldsReferences(typeId, baseOffset, 0, refs.offsets));
+        for (uint32_t offset : refs.offsets)
+        {
+            refs.readSize = std::max(refs.readSize, offset + m_pointerSize);
+        }
+        return S_OK;
+    }
+
+    uint64_t ReferencesReader::ReadPointer(const BYTE *buffer)
+    {
+        if (m_pointerSize == sizeof(uint32_t))
+        {
+            uint32_t value;
+            memcpy(&value, buffer, sizeof(value));
+            return value;
+        }
+        uint64_t value;
+        memcpy(&value, buffer, sizeof(value));
+        return value;
+    }
+
+    void ReferencesReader::GetReferences(uint64_t address, std::vector<uint64_t> &references)
+    {
+        COR_TYPEID typeId;
+        if (FAILED(m_pProcess5->GetTypeID(address, &typeId)))
+            return;
+
+        const type_id_t key(typeId.token1, typeId.token2);
+        auto find = m_types.find(key);
+        if (find == m_types.end())
+        {
+            type_refs_t refs;
+            if (FAILED(GetTypeReferences(typeId, refs)))
+                refs = type_refs_t();
+            find = m_types.emplace(key, std::move(refs)).first;
+        }
+        const type_refs_t &refs = find->second;
+
+        SIZE_T read = 0;
+        if (!refs.isArray)
+        {
+            if (refs.readSize == 0)
+                return;
+
+            m_buffer.resize(refs.readSize);
+            if (FAILED(m_pProcess->ReadMemory(address, refs.readSize, m_buffer.data(), &read)) || read != refs.readSize)
+                return;
+            for (uint32_t offset : refs.offsets)
+            {
+                references.push_back(ReadPointer(m_buffer.data() + offset));
+            }
+            return;
+        }
+
+        if ((!refs.elementIsReference && refs.offsets.empty()) || refs.elementSize == 0)
+            return;
+
+        uint32_t count = 0;
+        if (FAILED(m_pProcess->ReadMemory(address + refs.countOffset, sizeof(count), (BYTE*)&count, &read)) || read != sizeof(count))
+            return;
+
+        // Note, huge arrays are read by parts in order to keep buffer small.
+        const uint32_t chunkElements = std::max<uint32_t>(1, ArrayReadBytes / refs.elementSize);
+        for (uint32_t first = 0; first < count; first += chunkElements)
+        {
+            const uint32_t elements = std::min(chunkElements, count - first);
+            const uint32_t size = elements * refs.elementSize;
+            m_buffer.resize(size);
+            if (FAILED(m_pProcess->ReadMemory(address + refs.firstElementOffset + uint64_t(first) * refs.elementSize,
+                                              size, m_buffer.data(), &read)) || read != size)
+                return;
+
+            for (uint32_t i = 0; i < elements; i++)
+            {
+                const BYTE *element = m_buffer.data() + i * refs.elementSize;
+                if (refs.elementIsReference)
+                    references.push_back(ReadPointer(element));
+                else
+                {
+                    for (uint32_t offset : refs.offsets)
+                    {
+                        references.push_back(ReadPointer(element + offset));
+                    }
+                }
+            }
+        }
+    }
+
+    // Object address, referenced by GC reference location.
+    HRESULT GetRootObject(ICorDebugValue *pLocation, uint64_t &address)
+    {
+        HRESULT Status;
+        CORDB_ADDRESS objectAddress = 0;
+        ToRelease<ICorDebugReferenceValue> pRefValue;
+        if (SUCCEEDED(pLocation->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &pRefValue)))
+        {
+            BOOL isNull = TRUE;
+            IfFailRet(pRefValue->IsNull(&isNull));
+            if (isNull)
+                return S_FALSE;
+            IfFailRet(pRefValue->GetValue(&objectAddress));
+        }
+        else
+        {
+            IfFailRet(pLocation->GetAddress(&objectAddress));
+        }
+
+        address = objectAddress;
+        return S_OK;
+    }
+
+} // unnamed namespace
+
+HRESULT HeapWalk::GetStatistics(ICorDebugProcess *pProcess, unsigned topCount, bool sortByCount, const ProgressCallback &progress,
+                                HeapStatistics &statistics)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugProcess5> pProcess5;
+    IfFailRet(pProcess->QueryInterface(IID_ICorDebugProcess5, (LPVOID*) &pProcess5));
+
+    // Note, GC structures are not valid in case process was stopped during GC.
+    COR_HEAPINFO heapInfo;
+    IfFailRet(pProcess5->GetGCHeapInformation(&heapInfo));
+    if (!heapInfo.areGCStructuresValid)
+    {
+        LOGW("GC structures are not valid, heap can't be walked.");
+        return CORDBG_E_GC_STRUCTURES_INVALID;
+    }
+
+    ToRelease<ICorDebugHeapEnum> pHeapEnum;
+    IfFailRet(pProcess5->EnumerateHeap(&pHeapEnum));
+
+    HeapStats stats;
+    TypeNames names(pProcess5);
+    std::vector<COR_HEAPOBJECT> objects(HeapObjectsBatch);
+    uint64_t nextProgress = ProgressObjectsCount;
+    ULONG fetched = 0;
+    do
+    {
+        if (Cancellation::IsRequested())
+            return COR_E_OPERATIONCANCELED;
+
+        fetched = 0;
+        IfFailRet(pHeapEnum->Next(HeapObjectsBatch, objects.data(), &fetched));
+        for (ULONG i = 0; i < fetched; i++)
+        {
+            stats.Add(HeapStats::type_key_t(objects[i].type.token1, objects[i].type.token2), objects[i].size);
+        }
+
+        if (progress && stats.GetObjectsCount() >= nextProgress)
+        {
+            nextProgress = stats.GetObjectsCount() + ProgressObjectsCount;
+            HeapStatistics partial;
+            FillStatistics(stats, names, topCount, sortByCount, false, partial);
+            progress(partial);
+        }
+    }
+    while (fetched == HeapObjectsBatch);
+
+    FillStatistics(stats, names, topCount, sortByCount, true, statistics);
+    return S_OK;
+}
+
+HRESULT HeapWalk::EnumerateDerivedObjects(ICorDebugProcess *pProcess, COR_TYPEID baseTypeId, const ObjectCallback &callback)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugProcess5> pProcess5;
+    IfFailRet(pProcess->QueryInterface(IID_ICorDebugProcess5, (LPVOID*) &pProcess5));
+
+    COR_HEAPINFO heapInfo;
+    IfFailRet(pProcess5->GetGCHeapInformation(&heapInfo));
+    if (!heapInfo.areGCStructuresValid)
+    {
+        LOGW("GC structures are not valid, heap can't be walked.");
+        return CORDBG_E_GC_STRUCTURES_INVALID;
+    }
+
+    ToRelease<ICorDebugHeapEnum> pHeapEnum;
+    IfFailRet(pProcess5->EnumerateHeap(&pHeapEnum));
+
+    DerivedTypes derivedTypes(pProcess5, baseTypeId);
+    std::vector<COR_HEAPOBJECT> objects(HeapObjectsBatch);
+    ULONG fetched = 0;
+    do
+    {
+        if (Cancellation::IsRequested())
+            return COR_E_OPERATIONCANCELED;
+
+        fetched = 0;
+        IfFailRet(pHeapEnum->Next(HeapObjectsBatch, objects.data(), &fetched));
+        for (ULONG i = 0; i < fetched; i++)
+        {
+            if (derivedTypes.IsDerived(objects[i].type))
+                IfFailRet(callback(objects[i].address, objects[i].type));
+        }
+    }
+    while (fetched == HeapObjectsBatch);
+
+    return S_OK;
+}
+
+HRESULT HeapWalk::FindRootPath(ICorDebugProcess *pProcess, uint64_t address, GCRootPath &path)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugProcess5> pProcess5;
+    IfFailRet(pProcess->QueryInterface(IID_ICorDebugProcess5, (LPVOID*) &pProcess5));
+
+    COR_HEAPINFO heapInfo;
+    IfFailRet(pProcess5->GetGCHeapInformation(&heapInfo));
+    if (!heapInfo.areGCStructuresValid)
+    {
+        LOGW("GC structures are not valid, heap can't be walked.");
+        return CORDBG_E_GC_STRUCTURES_INVALID;
+    }
+
+    GCRootSearch search(heapInfo.pointerSize, RootSearchMemoryLimit);
+
+    ToRelease<ICorDebugHeapSegmentEnum> pSegmentEnum;
+    IfFailRet(pProcess5->EnumerateHeapRegions(&pSegmentEnum));
+    COR_SEGMENT segment;
+    ULONG fetched = 0;
+    while (SUCCEEDED(pSegmentEnum->Next(1, &segment, &fetched)) && fetched == 1)
+    {
+        search.AddSegment(segment.start, segment.end);
+    }
+
+    // Note, root id is index of root kind in `kinds`, all roots of same kind are not distinguished.
+    std::vector<CorGCReferenceType> kinds;
+    ToRelease<ICorDebugGCReferenceEnum> pRefEnum;
+    IfFailRet(pProcess5->EnumerateGCReferences(FALSE, &pRefEnum));
+    std::vector<COR_GC_REFERENCE> roots(RootsBatch);
+    do
+    {
+        if (Cancellation::IsRequested())
+            return COR_E_OPERATIONCANCELED;
+
+        fetched = 0;
+        IfFailRet(pRefEnum->Next(RootsBatch, roots.data(), &fetched));
+        for (ULONG i = 0; i < fetched; i++)
+        {
+            ToRelease<ICorDebugAppDomain> pDomain(roots[i].Domain);
+            ToRelease<ICorDebugValue> pLocation(roots[i].Location);
+            uint64_t rootAddress = 0;
+            if (!pLocation || GetRootObject(pLocation, rootAddress) != S_OK)
+                continue;
+
+            auto find = std::find(kinds.begin(), kinds.end(), roots[i].Type);
+            if (find == kinds.end())
+                find = kinds.insert(kinds.end(), roots[i].Type);
+            search.AddRoot(uint32_t(find - kinds.begin()), rootAddress);
+        }
+    }
+    while (fetched == RootsBatch);
+
+    ReferencesReader reader(pProcess, pProcess5, heapInfo.pointerSize);
+    uint64_t processed = 0;
+    uint32_t rootId = 0;
+    std::vector<uint64_t> objects;
+    const GCRootSearch::Result result = search.Find(address, [&](uint64_t object, std::vector<uint64_t> &references)
+    {
+        if ((++processed % HeapObjectsBatch) == 0 && Cancellation::IsRequested())
+            return false;
+
+        reader.GetReferences(object, references);
+        return true;
+    }, rootId, objects);
+
+    path.rootKind.clear();
+    path.objects.clear();
+    switch (result)
+    {
+        case GCRootSearch::Result::Aborted:
+            return COR_E_OPERATIONCANCELED;
+        case GCRootSearch::Result::MemoryLimit:
+            LOGW("GC root path search memory limit exceeded.");
+            return E_OUTOFMEMORY;
+        case GCRootSearch::Result::NotFound:
+            return S_OK;
+        case GCRootSearch::Result::Found:
+            break;
+    }
+
+    TypeNames names(pProcess5);
+    path.rootKind = GetRootKind(kinds[rootId]);
+    for (uint64_t object : objects)
+    {
+        path.objects.emplace_back();
+        path.objects.back().address = object;
+        COR_TYPEID typeId;
+        path.objects.back().typeName = SUCCEEDED(pProcess5->GetTypeID(object, &typeId))
+                                       ? names.Get(HeapStats::type_key_t(typeId.token1, typeId.token2))
+                                       : "<unknown type>";
+    }
+    return S_OK;
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,40 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <functional>
+#include "interfaces/types.h"
+
+namespace netcoredbg
+{
+
+namespace HeapWalk
+{
+    typedef std::function<void(const HeapStatistics &partial)> ProgressCallback;
+
+    // Iterative GC heap walk with ICorDebugProcess5::EnumerateHeap, process must be stopped. Objects are aggregated by
+    // runtime type identity only, so, memory usage depends on types count (not heap size). Types names are resolved for
+    // top `topCount` types only. Walk could be canceled (see Cancellation), `progress` (could be empty) is called each
+    // 1M objects with partial statistics.
+    HRESULT GetStatistics(ICorDebugProcess *pProcess, unsigned topCount, bool sortByCount, const ProgressCallback &progress,
+                          HeapStatistics &statistics);
+
+    // Breadth-first search of shortest references path from GC roots to object at `address` (see GCRootSearch), process
+    // must be stopped. Weak references are not roots. Return E_OUTOFMEMORY in case of search memory limit exceed.
+    HRESULT FindRootPath(ICorDebugProcess *pProcess, uint64_t address, GCRootPath &path);
+
+    // Return failure code in order to abort walk.
+    typedef std::function<HRESULT(uint64_t address, COR_TYPEID typeId)> ObjectCallback;
+
+    // Heap walk, that provide objects of `baseTypeId` type and derived types only, process must be stopped. Derived types
+    // set is built during walk, each type met in heap (and its parents) is checked once, so, objects of other types cost
+    // hash lookup only. Walk could be canceled (see Cancellation).
+    HRESULT EnumerateDerivedObjects(ICorDebugProcess *pProcess, COR_TYPEID baseTypeId, const ObjectCallback &callback);
+}
+
+} // namespace netcoredbg
@@ -78,8 +78,8 @@ HRESULT UpdateApplication(ICorDebugThread *pThread, Modules *pModules, Evaluator
         pEvaluator->WalkMethods(updateHandlerType.GetPtr(), &iCorResultType, emptyVector, [&](
             bool is_static,
             const std::string &methodName,
-            Evaluator::ReturnElementType &methodRet,
-            std::vector<Evaluator::ArgElementType> &methodArgs,
+            const Evaluator::ReturnElementType &methodRet,
+            const std::vector<Evaluator::ArgElementType> &methodArgs,
             Evaluator::GetFunctionCallback getFunction)
         {
             
@@ -0,0 +1,189 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/il_call_sites.h"
+
+#include <cstring>
+
+namespace netcoredbg
+{
+
+namespace
+{
+
+    // ECMA-335 Partition III opcodes, that need special care during scan.
+    enum : uint8_t
+    {
+        CEE_CALL = 0x28,
+        CEE_SWITCH = 0x45,
+        CEE_CALLVIRT = 0x6F,
+        CEE_NEWOBJ = 0x73,
+        CEE_PREFIX1 = 0xFE
+    };
+
+    const int OperandNone = 0;
+    const int OperandInvalid = -1;
+    const int OperandSwitch = -2;
+
+    // Operand size of one byte opcode.
+    int OperandSize(uint8_t opcode)
+    {
+        if (opcode <= 0x0D) return OperandNone;     // nop ... stloc.3
+        if (opcode <= 0x13) return 1;               // ldarg.s ... stloc.s
+        if (opcode <= 0x1E) return OperandNone;     // ldnull, ldc.i4.m1 ... ldc.i4.8
+        switch (opcode)
+        {
+            case 0x1F: return 1;                    // ldc.i4.s
+            case 0x20: return 4;                    // ldc.i4
+            case 0x21: return 8;                    // ldc.i8
+            case 0x22: return 4;                    // ldc.r4
+            case 0x23: return 8;                    // ldc.r8
+            case 0x24: return OperandInvalid;
+            case 0x25:                              // dup
+            case 0x26: return OperandNone;          // pop
+            case 0x27:                              // jmp
+            case 0x28:                              // call
+            case 0x29: return 4;                    // calli
+            case 0x2A: return OperandNone;          // ret
+            default: break;
+        }
+        if (opcode <= 0x37) return 1;               // br.s ... blt.un.s
+        if (opcode <= 0x44) return 4;               // br ... blt.un
+        if (opcode == CEE_SWITCH) return OperandSwitch;
+        if (opcode <= 0x6E) return OperandNone;     // ldind.*, stind.*, arithmetic, conv.*
+        if (opcode <= 0x75) return 4;               // callvirt, cpobj, ldobj, ldstr, newobj, castclass, isinst
+        switch (opcode)
+        {
+            case 0x76: return OperandNone;          // conv.r.un
+            case 0x77:
+            case 0x78: return OperandInvalid;
+            case 0x79: return 4;                    // unbox
+            case 0x7A: return OperandNone;          // throw
+            default: break;
+        }
+        if (opcode <= 0x81) return 4;               // ldfld ... stobj
+        if (opcode <= 0x8B) return OperandNone;     // conv.ovf.*.un
+        if (opcode <= 0x8D) return 4;               // box, newarr
+        if (opcode == 0x8E) return OperandNone;     // ldlen
+        if (opcode == 0x8F) return 4;               // ldelema
+        if (opcode <= 0xA2) return OperandNone;     // ldelem.*, stelem.*
+        if (opcode <= 0xA5) return 4;               // ldelem, stelem, unbox.any
+        if (opcode <= 0xB2) return OperandInvalid;
+        if (opcode <= 0xBA) return OperandNone;     // conv.ovf.*
+        if (opcode <= 0xC1) return OperandInvalid;
+        switch (opcode)
+        {
+            case 0xC2: return 4;                    // refanyval
+            case 0xC3: return OperandNone;          // ckfinite
+            case 0xC6: return 4;                    // mkrefany
+            case 0xD0: return 4;                    // ldtoken
+            case 0xDD: return 4;                    // leave
+            case 0xDE: return 1;                    // leave.s
+            case 0xDF:                              // stind.i
+            case 0xE0: return OperandNone;          // conv.u
+            default: break;
+        }
+        if (opcode >= 0xD1 && opcode <= 0xDC) return OperandNone; // conv.u2 ... endfinally
+        return OperandInvalid;
+    }
+
+    // Operand size of two bytes opcode (second byte after CEE_PREFIX1).
+    int OperandSizePrefix1(uint8_t opcode)
+    {
+        switch (opcode)
+        {
+            case 0x00:                              // arglist
+            case 0x01:                              // ceq
+            case 0x02:                              // cgt
+            case 0x03:                              // cgt.un
+            case 0x04:                              // clt
+            case 0x05: return OperandNone;          // clt.un
+            case 0x06:                              // ldftn
+            case 0x07: return 4;                    // ldvirtftn
+            case 0x09:                              // ldarg
+            case 0x0A:                              // ldarga
+            case 0x0B:                              // starg
+            case 0x0C:                              // ldloc
+            case 0x0D:                              // ldloca
+            case 0x0E: return 2;                    // stloc
+            case 0x0F:                              // localloc
+            case 0x11: return OperandNone;          // endfilter
+            case 0x12: return 1;                    // unaligned.
+            case 0x13:                              // volatile.
+            case 0x14: return OperandNone;          // tail.
+            case 0x15:                              // initobj
+            case 0x16: return 4;                    // constrained.
+            case 0x17:                              // cpblk
+            case 0x18: return OperandNone;          // initblk
+            case 0x19: return 1;                    // no.
+            case 0x1A: return OperandNone;          // rethrow
+            case 0x1C: return 4;                    // sizeof
+            case 0x1D:                              // refanytype
+            case 0x1E: return OperandNone;          // readonly.
+            default: return OperandInvalid;
+        }
+    }
+
+    uint32_t ReadUInt32(const uint8_t *data)
+    {
+        // Note, IL is little endian, same as all supported targets.
+        uint32_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+} // unnamed namespace
+
+namespace ILCallSites
+{
+
+bool Find(const std::vector<uint8_t> &code, uint32_t startOffset, uint32_t endOffset, std::vector<call_site_t> &calls)
+{
+    if (endOffset > code.size())
+        endOffset = (uint32_t)code.size();
+
+    size_t ip = startOffset;
+    while (ip < endOffset)
+    {
+        const size_t instructionOffset = ip;
+        const uint8_t opcode = code[ip++];
+
+        int operandSize;
+        if (opcode == CEE_PREFIX1)
+        {
+            if (ip >= code.size())
+                return false;
+            operandSize = OperandSizePrefix1(code[ip++]);
+        }
+        else
+        {
+            operandSize = OperandSize(opcode);
+        }
+
+        if (operandSize == OperandSwitch)
+        {
+            if (code.size() < ip + sizeof(uint32_t))
+                return false;
+            const uint32_t targetsCount = ReadUInt32(code.data() + ip);
+            if ((code.size() - ip - sizeof(uint32_t)) / sizeof(uint32_t) < targetsCount)
+                return false;
+            operandSize = int(sizeof(uint32_t) * (targetsCount + 1));
+        }
+        else if (operandSize == OperandInvalid || code.size() < ip + operandSize)
+        {
+            return false;
+        }
+
+        if (opcode == CEE_CALL || opcode == CEE_CALLVIRT || opcode == CEE_NEWOBJ)
+            calls.emplace_back((uint32_t)instructionOffset, ReadUInt32(code.data() + ip), opcode == CEE_NEWOBJ);
+
+        ip += operandSize;
+    }
+
+    return true;
+}
+
+} // namespace ILCallSites
+
+} // namespace netcoredbg
@@ -0,0 +1,33 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace netcoredbg
+{
+
+namespace ILCallSites
+{
+    struct call_site_t
+    {
+        uint32_t ilOffset;     // IL offset of call instruction
+        uint32_t methodToken;  // MethodDef, MemberRef or MethodSpec token
+        bool newObj;           // `newobj` (constructor call)
+
+        call_site_t(uint32_t ilOffset_, uint32_t methodToken_, bool newObj_) :
+            ilOffset(ilOffset_), methodToken(methodToken_), newObj(newObj_)
+        {}
+    };
+
+    // Find all `call`, `callvirt` and `newobj` instructions in [startOffset, endOffset) IL code range, calls are provided
+    // in IL order. Note, `startOffset` must be instruction start (for example, sequence point IL offset).
+    // Return false in case of broken IL code (unknown opcode or truncated instruction).
+    bool Find(const std::vector<uint8_t> &code, uint32_t startOffset, uint32_t endOffset, std::vector<call_site_t> &calls);
+}
+
+} // namespace netcoredbg
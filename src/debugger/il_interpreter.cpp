@@ -0,0 +1,636 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/il_interpreter.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace netcoredbg
+{
+
+namespace
+{
+
+    typedef ILInterpreter::value_t value_t;
+
+    // ECMA-335 Partition III opcodes, only supported by interpreter.
+    enum : uint8_t
+    {
+        CEE_NOP = 0x00,
+        CEE_LDARG_0 = 0x02,
+        CEE_LDARG_3 = 0x05,
+        CEE_LDLOC_0 = 0x06,
+        CEE_LDLOC_3 = 0x09,
+        CEE_STLOC_0 = 0x0A,
+        CEE_STLOC_3 = 0x0D,
+        CEE_LDARG_S = 0x0E,
+        CEE_LDLOC_S = 0x11,
+        CEE_STLOC_S = 0x13,
+        CEE_LDC_I4_M1 = 0x15,
+        CEE_LDC_I4_8 = 0x1E,
+        CEE_LDC_I4_S = 0x1F,
+        CEE_LDC_I4 = 0x20,
+        CEE_LDC_I8 = 0x21,
+        CEE_LDC_R4 = 0x22,
+        CEE_LDC_R8 = 0x23,
+        CEE_DUP = 0x25,
+        CEE_POP = 0x26,
+        CEE_CALL = 0x28,
+        CEE_RET = 0x2A,
+        CEE_BR_S = 0x2B,
+        CEE_BRFALSE_S = 0x2C,
+        CEE_BRTRUE_S = 0x2D,
+        CEE_BEQ_S = 0x2E,
+        CEE_BLT_UN_S = 0x37,
+        CEE_BR = 0x38,
+        CEE_BRFALSE = 0x39,
+        CEE_BRTRUE = 0x3A,
+        CEE_BEQ = 0x3B,
+        CEE_BLT_UN = 0x44,
+        CEE_ADD = 0x58,
+        CEE_SUB = 0x59,
+        CEE_MUL = 0x5A,
+        CEE_DIV = 0x5B,
+        CEE_DIV_UN = 0x5C,
+        CEE_REM = 0x5D,
+        CEE_REM_UN = 0x5E,
+        CEE_AND = 0x5F,
+        CEE_OR = 0x60,
+        CEE_XOR = 0x61,
+        CEE_SHL = 0x62,
+        CEE_SHR = 0x63,
+        CEE_SHR_UN = 0x64,
+        CEE_NEG = 0x65,
+        CEE_NOT = 0x66,
+        CEE_CONV_I1 = 0x67,
+        CEE_CONV_I2 = 0x68,
+        CEE_CONV_I4 = 0x69,
+        CEE_CONV_I8 = 0x6A,
+        CEE_CONV_R4 = 0x6B,
+        CEE_CONV_R8 = 0x6C,
+        CEE_CONV_U4 = 0x6D,
+        CEE_CONV_U8 = 0x6E,
+        CEE_CALLVIRT = 0x6F,
+        CEE_LDFLD = 0x7B,
+        CEE_LDSFLD = 0x7E,
+        CEE_CONV_U2 = 0xD1,
+        CEE_CONV_U1 = 0xD2,
+        CEE_CONV_I = 0xD3,
+        CEE_CONV_U = 0xE0,
+        CEE_PREFIX1 = 0xFE
+    };
+
+    // Two bytes opcodes (second byte after CEE_PREFIX1).
+    enum : uint8_t
+    {
+        CEE_CEQ = 0x01,
+        CEE_CGT = 0x02,
+        CEE_CGT_UN = 0x03,
+        CEE_CLT = 0x04,
+        CEE_CLT_UN = 0x05
+    };
+
+    // Note, comparison branches have same order in short and long forms.
+    enum class Condition
+    {
+        Eq, Ge, Gt, Le, Lt, NeUn, GeUn, GtUn, LeUn, LtUn
+    };
+
+    template <typename T>
+    bool Read(const std::vector<uint8_t> &code, size_t &ip, T &value)
+    {
+        if (code.size() < ip + sizeof(T))
+            return false;
+
+        // Note, IL is little endian, same as all supported targets.
+        memcpy(&value, code.data() + ip, sizeof(T));
+        ip += sizeof(T);
+        return true;
+    }
+
+    bool IsInteger(const value_t &value)
+    {
+        return value.kind == value_t::Int32 || value.kind == value_t::Int64;
+    }
+
+    value_t MakeInteger(value_t::kind_t kind, uint64_t bits)
+    {
+        return kind == value_t::Int32 ? value_t::FromInt32(int32_t(uint32_t(bits))) : value_t::FromInt64(int64_t(bits));
+    }
+
+    uint64_t UnsignedBits(const value_t &value)
+    {
+        return value.kind == value_t::Int32 ? uint64_t(uint32_t(value.i)) : uint64_t(value.i);
+    }
+
+    // Note, same as CLR, Int32 and Int64 (and Double) operands can't be mixed without explicit conversion.
+    bool BinaryOp(uint8_t opcode, const value_t &a, const value_t &b, value_t &result)
+    {
+        if (a.kind != b.kind)
+            return false;
+
+        if (a.kind == value_t::Double)
+        {
+            switch (opcode)
+            {
+                case CEE_ADD: result = value_t::FromDouble(a.d + b.d); return true;
+                case CEE_SUB: result = value_t::FromDouble(a.d - b.d); return true;
+                case CEE_MUL: result = value_t::FromDouble(a.d * b.d); return true;
+                case CEE_DIV: result = value_t::FromDouble(a.d / b.d); return true;
+                case CEE_REM: result = value_t::FromDouble(std::fmod(a.d, b.d)); return true;
+                default: return false;
+            }
+        }
+
+        if (!IsInteger(a))
+            return false;
+
+        const bool is32 = a.kind == value_t::Int32;
+        const uint64_t ua = UnsignedBits(a);
+        const uint64_t ub = UnsignedBits(b);
+        switch (opcode)
+        {
+            case CEE_ADD: result = MakeInteger(a.kind, ua + ub); return true;
+            case CEE_SUB: result = MakeInteger(a.kind, ua - ub); return true;
+            case CEE_MUL: result = MakeInteger(a.kind, ua * ub); return true;
+            case CEE_AND: result = MakeInteger(a.kind, ua & ub); return true;
+            case CEE_OR:  result = MakeInteger(a.kind, ua | ub); return true;
+            case CEE_XOR: result = MakeInteger(a.kind, ua ^ ub); return true;
+            default: break;
+        }
+
+        // Note, DivideByZeroException and OverflowException must be thrown by debuggee code.
+        if (b.i == 0)
+            return false;
+
+        switch (opcode)
+        {
+            case CEE_DIV:
+            case CEE_REM:
+                if (b.i == -1 && a.i == (is32 ? std::numeric_limits<int32_t>::min() : std::numeric_limits<int64_t>::min()))
+                    return false;
+                result = MakeInteger(a.kind, uint64_t(opcode == CEE_DIV ? a.i / b.i : a.i % b.i));
+                return true;
+            case CEE_DIV_UN: result = MakeInteger(a.kind, ua / ub); return true;
+            case CEE_REM_UN: result = MakeInteger(a.kind, ua % ub); return true;
+            default: return false;
+        }
+    }
+
+    bool ShiftOp(uint8_t opcode, const value_t &a, const value_t &b, value_t &result)
+    {
+        if (!IsInteger(a) || b.kind != value_t::Int32)
+            return false;
+
+        const unsigned shift = unsigned(b.i) & (a.kind == value_t::Int32 ? 31 : 63);
+        switch (opcode)
+        {
+            case CEE_SHL: result = MakeInteger(a.kind, UnsignedBits(a) << shift); return true;
+            case CEE_SHR_UN: result = MakeInteger(a.kind, UnsignedBits(a) >> shift); return true;
+            case CEE_SHR:
+                // Note, arithmetic shift for negative values without implementation defined behaviour.
+                result = MakeInteger(a.kind, a.i < 0 ? ~(~uint64_t(a.i) >> shift) : uint64_t(a.i) >> shift);
+                return true;
+            default: return false;
+        }
+    }
+
+    bool Compare(const value_t &a, const value_t &b, bool isUnsigned, int &order, bool &unordered)
+    {
+        if (a.kind != b.kind)
+            return false;
+
+        unordered = false;
+        if (a.kind == value_t::Double)
+        {
+            if (std::isnan(a.d) || std::isnan(b.d))
+            {
+                unordered = true;
+                order = 0;
+                return true;
+            }
+            order = a.d < b.d ? -1 : (a.d > b.d ? 1 : 0);
+            return true;
+        }
+
+        if (!IsInteger(a))
+            return false;
+
+        if (isUnsigned)
+            order = UnsignedBits(a) < UnsignedBits(b) ? -1 : (UnsignedBits(a) > UnsignedBits(b) ? 1 : 0);
+        else
+            order = a.i < b.i ? -1 : (a.i > b.i ? 1 : 0);
+        return true;
+    }
+
+    bool CheckCondition(Condition condition, const value_t &a, const value_t &b, bool &result)
+    {
+        const bool isUnsigned = condition >= Condition::NeUn;
+        int order = 0;
+        bool unordered = false;
+        if (!Compare(a, b, isUnsigned, order, unordered))
+            return false;
+
+        switch (condition)
+        {
+            case Condition::Eq:   result = !unordered && order == 0; return true;
+            case Condition::Ge:   result = !unordered && order >= 0; return true;
+            case Condition::Gt:   result = !unordered && order > 0; return true;
+            case Condition::Le:   result = !unordered && order <= 0; return true;
+            case Condition::Lt:   result = !unordered && order < 0; return true;
+            case Condition::NeUn: result = unordered || order != 0; return true;
+            case Condition::GeUn: result = unordered || order >= 0; return true;
+            case Condition::GtUn: result = unordered || order > 0; return true;
+            case Condition::LeUn: result = unordered || order <= 0; return true;
+            case Condition::LtUn: result = unordered || order < 0; return true;
+        }
+        return false;
+    }
+
+    bool Convert(uint8_t opcode, const value_t &value, value_t &result)
+    {
+        if (opcode == CEE_CONV_R4 || opcode == CEE_CONV_R8)
+        {
+            double d;
+            if (value.kind == value_t::Double)
+                d = value.d;
+            else if (IsInteger(value))
+                d = double(value.i);
+            else
+                return false;
+
+            result = value_t::FromDouble(opcode == CEE_CONV_R4 ? double(float(d)) : d);
+            return true;
+        }
+
+        int64_t i;
+        if (IsInteger(value))
+        {
+            i = value.i;
+        }
+        else if (value.kind == value_t::Double)
+        {
+            // Note, result of out of range conversion is unspecified, let debuggee code calculate it.
+            if (std::isnan(value.d) || value.d <= -9223372036854775808.0 || value.d >= 9223372036854775808.0)
+                return false;
+            i = int64_t(value.d);
+        }
+        else
+            return false;
+
+        switch (opcode)
+        {
+            case CEE_CONV_I1: result = value_t::FromInt32(int8_t(i)); return true;
+            case CEE_CONV_I2: result = value_t::FromInt32(int16_t(i)); return true;
+            case CEE_CONV_I4: result = value_t::FromInt32(int32_t(uint32_t(i))); return true;
+            case CEE_CONV_U1: result = value_t::FromInt32(uint8_t(i)); return true;
+            case CEE_CONV_U2: result = value_t::FromInt32(uint16_t(i)); return true;
+            case CEE_CONV_U4: result = value_t::FromInt32(int32_t(uint32_t(i))); return true;
+            case CEE_CONV_I8:
+            case CEE_CONV_I:
+                result = value_t::FromInt64(i);
+                return true;
+            case CEE_CONV_U8:
+            case CEE_CONV_U:
+                // Note, Int32 is zero extended for unsigned conversion.
+                result = value_t::FromInt64(value.kind == value_t::Int32 ? int64_t(uint32_t(i)) : i);
+                return true;
+            default: return false;
+        }
+    }
+
+} // unnamed namespace
+
+const unsigned ILInterpreter::DefaultBudget;
+const unsigned ILInterpreter::MaxCallDepth;
+
+bool ILInterpreter::Execute(const std::vector<uint8_t> &code, const std::vector<value_t> &args, value_t &result)
+{
+    return Execute(code, args, result, 0);
+}
+
+bool ILInterpreter::Execute(const std::vector<uint8_t> &code, const std::vector<value_t> &args, value_t &result, unsigned depth)
+{
+    std::vector<value_t> stack;
+    std::vector<value_t> locals;
+    size_t ip = 0;
+
+    auto pop = [&](value_t &value) -> bool
+    {
+        if (stack.empty())
+            return false;
+        value = stack.back();
+        stack.pop_back();
+        return true;
+    };
+
+    auto loadArg = [&](size_t index) -> bool
+    {
+        if (index >= args.size())
+            return false;
+        stack.push_back(args[index]);
+        return true;
+    };
+
+    auto loadLocal = [&](size_t index) -> bool
+    {
+        if (index >= locals.size() || locals[index].kind == value_t::Empty)
+            return false;
+        stack.push_back(locals[index]);
+        return true;
+    };
+
+    auto storeLocal = [&](size_t index) -> bool
+    {
+        if (locals.size() <= index)
+            locals.resize(index + 1);
+        return pop(locals[index]);
+    };
+
+    // Note, branch target is relative to next instruction.
+    auto branch = [&](int32_t offset) -> bool
+    {
+        const int64_t target = int64_t(ip) + offset;
+        if (target < 0 || target >= int64_t(code.size()))
+            return false;
+        ip = size_t(target);
+        return true;
+    };
+
+    auto isTrue = [&](bool &value) -> bool
+    {
+        value_t v;
+        if (!pop(v) || !IsInteger(v))
+            return false;
+        value = v.i != 0;
+        return true;
+    };
+
+    while (ip < code.size())
+    {
+        if (m_budget == 0)
+            return false;
+        m_budget--;
+
+        const uint8_t opcode = code[ip++];
+        value_t a, b;
+        switch (opcode)
+        {
+            case CEE_NOP:
+                break;
+
+            case CEE_LDARG_0: case CEE_LDARG_0 + 1: case CEE_LDARG_0 + 2: case CEE_LDARG_3:
+                if (!loadArg(opcode - CEE_LDARG_0))
+                    return false;
+                break;
+
+            case CEE_LDLOC_0: case CEE_LDLOC_0 + 1: case CEE_LDLOC_0 + 2: case CEE_LDLOC_3:
+                if (!loadLocal(opcode - CEE_LDLOC_0))
+                    return false;
+                break;
+
+            case CEE_STLOC_0: case CEE_STLOC_0 + 1: case CEE_STLOC_0 + 2: case CEE_STLOC_3:
+                if (!storeLocal(opcode - CEE_STLOC_0))
+                    return false;
+                break;
+
+            case CEE_LDARG_S:
+            case CEE_LDLOC_S:
+            case CEE_STLOC_S:
+            {
+                uint8_t index;
+                if (!Read(code, ip, index))
+                    return false;
+                if (!(opcode == CEE_LDARG_S ? loadArg(index) : (opcode == CEE_LDLOC_S ? loadLocal(index) : storeLocal(index))))
+                    return false;
+                break;
+            }
+
+            case CEE_LDC_I4_M1: case CEE_LDC_I4_M1 + 1: case CEE_LDC_I4_M1 + 2: case CEE_LDC_I4_M1 + 3:
+            case CEE_LDC_I4_M1 + 4: case CEE_LDC_I4_M1 + 5: case CEE_LDC_I4_M1 + 6: case CEE_LDC_I4_M1 + 7:
+            case CEE_LDC_I4_8:
+                stack.push_back(value_t::FromInt32(int32_t(opcode) - CEE_LDC_I4_M1 - 1));
+                break;
+
+            case CEE_LDC_I4_S:
+            {
+                int8_t value;
+                if (!Read(code, ip, value))
+                    return false;
+                stack.push_back(value_t::FromInt32(value));
+                break;
+            }
+
+            case CEE_LDC_I4:
+            {
+                int32_t value;
+                if (!Read(code, ip, value))
+                    return false;
+                stack.push_back(value_t::FromInt32(value));
+                break;
+            }
+
+            case CEE_LDC_I8:
+            {
+                int64_t value;
+                if (!Read(code, ip, value))
+                    return false;
+                stack.push_back(value_t::FromInt64(value));
+                break;
+            }
+
+            case CEE_LDC_R4:
+            {
+                float value;
+                if (!Read(code, ip, value))
+                    return false;
+                stack.push_back(value_t::FromDouble(value));
+                break;
+            }
+
+            case CEE_LDC_R8:
+            {
+                double value;
+                if (!Read(code, ip, value))
+                    return false;
+                stack.push_back(value_t::FromDouble(value));
+                break;
+            }
+
+            case CEE_DUP:
+                if (stack.empty())
+                    return false;
+                stack.push_back(stack.back());
+                break;
+
+            case CEE_POP:
+                if (!pop(a))
+                    return false;
+                break;
+
+            case CEE_CALL:
+            case CEE_CALLVIRT:
+            {
+                uint32_t token;
+                std::vector<uint8_t> methodCode;
+                unsigned argsCount = 0;
+                if (depth + 1 >= MaxCallDepth ||
+                    !Read(code, ip, token) ||
+                    !m_context.GetMethod(token, opcode == CEE_CALLVIRT, methodCode, argsCount) ||
+                    stack.size() < argsCount)
+                    return false;
+
+                // Note, context provide only not null objects, so, `callvirt` null check is not needed in this case.
+                if (opcode == CEE_CALLVIRT && (argsCount == 0 || stack[stack.size() - argsCount].kind != value_t::Object))
+                    return false;
+
+                std::vector<value_t> methodArgs(stack.end() - argsCount, stack.end());
+                stack.resize(stack.size() - argsCount);
+                if (!Execute(methodCode, methodArgs, a, depth + 1))
+                    return false;
+                stack.push_back(a);
+                break;
+            }
+
+            case CEE_RET:
+                // Note, methods without return value are not supported.
+                if (stack.size() != 1)
+                    return false;
+                result = stack.back();
+                return true;
+
+            case CEE_BR_S:
+            case CEE_BR:
+            case CEE_BRFALSE_S:
+            case CEE_BRFALSE:
+            case CEE_BRTRUE_S:
+            case CEE_BRTRUE:
+            {
+                int32_t offset;
+                if (opcode <= CEE_BRTRUE_S)
+                {
+                    int8_t shortOffset;
+                    if (!Read(code, ip, shortOffset))
+                        return false;
+                    offset = shortOffset;
+                }
+                else if (!Read(code, ip, offset))
+                    return false;
+
+                bool condition = true;
+                if (opcode != CEE_BR_S && opcode != CEE_BR)
+                {
+                    if (!isTrue(condition))
+                        return false;
+                    if (opcode == CEE_BRFALSE_S || opcode == CEE_BRFALSE)
+                        condition = !condition;
+                }
+                if (condition && !branch(offset))
+                    return false;
+                break;
+            }
+
+            case CEE_ADD: case CEE_SUB: case CEE_MUL: case CEE_DIV: case CEE_DIV_UN: case CEE_REM: case CEE_REM_UN:
+            case CEE_AND: case CEE_OR: case CEE_XOR:
+                if (!pop(b) || !pop(a) || !BinaryOp(opcode, a, b, a))
+                    return false;
+                stack.push_back(a);
+                break;
+
+            case CEE_SHL: case CEE_SHR: case CEE_SHR_UN:
+                if (!pop(b) || !pop(a) || !ShiftOp(opcode, a, b, a))
+                    return false;
+                stack.push_back(a);
+                break;
+
+            case CEE_NEG:
+                if (!pop(a))
+                    return false;
+                if (a.kind == value_t::Double)
+                    a.d = -a.d;
+                else if (IsInteger(a))
+                    a = MakeInteger(a.kind, 0 - UnsignedBits(a));
+                else
+                    return false;
+                stack.push_back(a);
+                break;
+
+            case CEE_NOT:
+                if (!pop(a) || !IsInteger(a))
+                    return false;
+                stack.push_back(MakeInteger(a.kind, ~UnsignedBits(a)));
+                break;
+
+            case CEE_CONV_I1: case CEE_CONV_I2: case CEE_CONV_I4: case CEE_CONV_I8: case CEE_CONV_R4: case CEE_CONV_R8:
+            case CEE_CONV_U4: case CEE_CONV_U8: case CEE_CONV_U2: case CEE_CONV_U1: case CEE_CONV_I: case CEE_CONV_U:
+                if (!pop(a) || !Convert(opcode, a, a))
+                    return false;
+                stack.push_back(a);
+                break;
+
+            case CEE_LDFLD:
+            case CEE_LDSFLD:
+            {
+                uint32_t token;
+                if (!Read(code, ip, token))
+                    return false;
+                if (opcode == CEE_LDFLD)
+                {
+                    if (!pop(a) || a.kind != value_t::Object || !m_context.LoadField(a, token, b))
+                        return false;
+                }
+                else if (!m_context.LoadStaticField(token, b))
+                    return false;
+                stack.push_back(b);
+                break;
+            }
+
+            case CEE_PREFIX1:
+            {
+                uint8_t opcode2;
+                if (!Read(code, ip, opcode2) || opcode2 < CEE_CEQ || opcode2 > CEE_CLT_UN)
+                    return false;
+
+                static const Condition conditions[] = { Condition::Eq, Condition::Gt, Condition::GtUn, Condition::Lt, Condition::LtUn };
+                bool condition = false;
+                if (!pop(b) || !pop(a) || !CheckCondition(conditions[opcode2 - CEE_CEQ], a, b, condition))
+                    return false;
+                stack.push_back(value_t::FromInt32(condition ? 1 : 0));
+                break;
+            }
+
+            default:
+            {
+                const bool shortForm = opcode >= CEE_BEQ_S && opcode <= CEE_BLT_UN_S;
+                if (!shortForm && (opcode < CEE_BEQ || opcode > CEE_BLT_UN))
+                    return false; // not supported instruction
+
+                int32_t offset;
+                if (shortForm)
+                {
+                    int8_t shortOffset;
+                    if (!Read(code, ip, shortOffset))
+                        return false;
+                    offset = shortOffset;
+                }
+                else if (!Read(code, ip, offset))
+                    return false;
+
+                bool condition = false;
+                if (!pop(b) || !pop(a) ||
+                    !CheckCondition(Condition(opcode - (shortForm ? CEE_BEQ_S : CEE_BEQ)), a, b, condition))
+                    return false;
+                if (condition && !branch(offset))
+                    return false;
+                break;
+            }
+        }
+    }
+
+    return false; // no `ret` at the end of code
+}
+
+} // namespace netcoredbg
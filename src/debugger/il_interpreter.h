@@ -0,0 +1,74 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace netcoredbg
+{
+
+// Side-effect-free interpreter for tiny methods (like `return _a + _b;` property getters), that could be executed
+// without debuggee resume. Only loads, arithmetic, comparisons, branches and calls to other interpretable methods are
+// supported, any other instruction (stores to fields, allocations, exceptions...) fail interpretation, so, caller
+// should fallback to evaluation in debuggee.
+class ILInterpreter
+{
+public:
+
+    struct value_t
+    {
+        enum kind_t : uint8_t
+        {
+            Empty,
+            Int32,
+            Int64,
+            Double,
+            Object  // debuggee value (object or value type), handle is provided by context
+        };
+
+        kind_t kind;
+        int64_t i;      // Int32 and Int64 value
+        double d;       // Double value
+        size_t object;  // Object handle
+
+        value_t() : kind(Empty), i(0), d(0), object(0) {}
+
+        static value_t FromInt32(int32_t value) { value_t v; v.kind = Int32; v.i = value; return v; }
+        static value_t FromInt64(int64_t value) { value_t v; v.kind = Int64; v.i = value; return v; }
+        static value_t FromDouble(double value) { value_t v; v.kind = Double; v.d = value; return v; }
+        static value_t FromObject(size_t handle) { value_t v; v.kind = Object; v.object = handle; return v; }
+    };
+
+    // Debuggee access, implementation must not execute any debuggee code. In case of `false` result interpretation fail.
+    // Note, null references must not be provided as Object values.
+    class IContext
+    {
+    public:
+        virtual ~IContext() {}
+        virtual bool LoadField(const value_t &object, uint32_t fieldToken, value_t &result) = 0;
+        virtual bool LoadStaticField(uint32_t fieldToken, value_t &result) = 0;
+        // Provide method IL code and arguments count (include `this`) for call, method must return value.
+        virtual bool GetMethod(uint32_t methodToken, bool virtualCall, std::vector<uint8_t> &code, unsigned &argsCount) = 0;
+    };
+
+    // Executed instructions limit, include all nested calls.
+    static const unsigned DefaultBudget = 1000;
+    static const unsigned MaxCallDepth = 8;
+
+    explicit ILInterpreter(IContext &context, unsigned budget = DefaultBudget) : m_context(context), m_budget(budget) {}
+
+    bool Execute(const std::vector<uint8_t> &code, const std::vector<value_t> &args, value_t &result);
+
+private:
+
+    IContext &m_context;
+    unsigned m_budget;
+
+    bool Execute(const std::vector<uint8_t> &code, const std::vector<value_t> &args, value_t &result, unsigned depth);
+};
+
+} // namespace netcoredbg
@@ -0,0 +1,202 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/interop_arm32_decode_helpers.h"
+#include <cstddef>
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+
+namespace
+{
+    // Note, C++11 have no std::make_index_sequence, log depth implementation in order to stay in default template depth limits.
+    template<std::size_t... I> struct index_seq_t { typedef index_seq_t type; };
+
+    template<class S1, class S2> struct concat_seq_t;
+    template<std::size_t... I1, std::size_t... I2>
+    struct concat_seq_t<index_seq_t<I1...>, index_seq_t<I2...>> : index_seq_t<I1..., (sizeof...(I1) + I2)...> {};
+
+    template<std::size_t N>
+    struct make_index_seq_t : concat_seq_t<typename make_index_seq_t<N / 2>::type, typename make_index_seq_t<N - N / 2>::type> {};
+    template<> struct make_index_seq_t<0> : index_seq_t<> {};
+    template<> struct make_index_seq_t<1> : index_seq_t<0> {};
+
+    template<typename T, std::size_t N>
+    struct lookup_table_t
+    {
+        T data[N];
+    };
+
+    // Arm code classes table, index is instruction bits [31:24] (condition and op).
+
+    constexpr uint32_t INST_NV = 0xf; // unconditional
+
+    constexpr arm32_insn_class_e ArmConditionTrueClass(uint32_t op)
+    {
+        return op <= 0x3 ? arm32_insn_class_e::ArmMiscellaneous :
+               op <= 0x7 ? arm32_insn_class_e::ArmMemory :
+               op <= 0x9 ? arm32_insn_class_e::ArmMultipleMemory :
+               op <= 0xb ? arm32_insn_class_e::ArmBranch :
+                           arm32_insn_class_e::Default; // coprocessor operations and system calls
+    }
+
+    constexpr arm32_insn_class_e ArmUnconditionalClass(uint32_t op)
+    {
+        return op == 0xb ? arm32_insn_class_e::ArmUncondBranch : // Note, 0xa (BLX <label> with H = 0) is not handled.
+               (op >= 0xc && op <= 0xe) ? arm32_insn_class_e::ArmUncondCoprocessor :
+                                          arm32_insn_class_e::Default;
+    }
+
+    constexpr arm32_insn_class_e ArmClass(uint32_t index)
+    {
+        return (index >> 4) == INST_NV ? ArmUnconditionalClass(index & 0xf) : ArmConditionTrueClass(index & 0xf);
+    }
+
+    template<std::size_t... I>
+    constexpr lookup_table_t<arm32_insn_class_e, sizeof...(I)> MakeArmTable(index_seq_t<I...>)
+    {
+        return {{ ArmClass(I)... }};
+    }
+
+    constexpr lookup_table_t<arm32_insn_class_e, 256> armTable = MakeArmTable(make_index_seq_t<256>::type());
+
+    // Thumb code patterns, first matched pattern define instruction class.
+    // Tables contain bit mask of patterns that could be matched for instruction high bits, so,
+    // only few (usually one or zero) patterns must be checked for instruction.
+
+    struct thumb_pattern_t
+    {
+        uint32_t mask;
+        uint32_t opcode;
+        arm32_insn_class_e insnClass;
+    };
+
+    constexpr thumb_pattern_t thumb16Patterns[] =
+    {
+        {0xff00, 0x4700, arm32_insn_class_e::Thumb16BranchExchange},   // BX REG, BLX REG
+        {0xff87, 0x4687, arm32_insn_class_e::Thumb16MovPC},            // MOV PC, REG
+        {0xff00, 0xbd00, arm32_insn_class_e::Thumb16PopPC},            // POP {reglist, PC}
+        {0xf500, 0xb100, arm32_insn_class_e::Thumb16CompareAndBranch}, // CBZ, CBNZ
+        {0xf000, 0xd000, arm32_insn_class_e::Thumb16CondBranch},       // Conditional branch
+        {0xf800, 0xe000, arm32_insn_class_e::Thumb16UncondBranch}      // Unconditional branch
+    };
+    constexpr std::size_t thumb16PatternsCount = sizeof(thumb16Patterns) / sizeof(thumb16Patterns[0]);
+
+    constexpr thumb_pattern_t thumb32Patterns[] =
+    {
+        // mask/opcode - instr2(16bit):instr1(16bit)
+        {0x8000f800, 0x8000f000, arm32_insn_class_e::Thumb32BranchesMiscControl}, // Branches, miscellaneous control instructions
+        {0x2000ffd0, 0x0000e910, arm32_insn_class_e::Thumb32LDM}, // LDMDB
+        {0x2000ffd0, 0x0000e890, arm32_insn_class_e::Thumb32LDM}, // LDMIA
+        {0xffffffd0, 0xc000e990, arm32_insn_class_e::Thumb32RFE}, // RFEDB
+        {0xffffffd0, 0xc000e810, arm32_insn_class_e::Thumb32RFE}, // RFEIA
+        {0xf0f0ffef, 0x0000ea4f, arm32_insn_class_e::Thumb32MOV}, // MOV{S}
+        {0xfff0fff0, 0xf000e8d0, arm32_insn_class_e::Thumb32TBB}, // TBB
+        {0xfff0fff0, 0xf010e8d0, arm32_insn_class_e::Thumb32TBH}, // TBH
+        {0xf000ff70, 0xf000f850, arm32_insn_class_e::Thumb32LDR}, // LDR, where Rm is PC
+    };
+    constexpr std::size_t thumb32PatternsCount = sizeof(thumb32Patterns) / sizeof(thumb32Patterns[0]);
+
+    // Return bit mask of patterns, that could be matched by instruction with `highBits` (`highMask` bits of instruction).
+    constexpr uint16_t ThumbCandidates(const thumb_pattern_t *patterns, std::size_t count, uint32_t highBits, uint32_t highMask, std::size_t i = 0)
+    {
+        return i == count ? 0 :
+            ((((highBits ^ patterns[i].opcode) & patterns[i].mask & highMask) == 0 ? (uint16_t)(1 << i) : (uint16_t)0) |
+             ThumbCandidates(patterns, count, highBits, highMask, i + 1));
+    }
+
+    // Thumb 16-bit table, index is instruction bits [15:8].
+    template<std::size_t... I>
+    constexpr lookup_table_t<uint16_t, sizeof...(I)> MakeThumb16Table(index_seq_t<I...>)
+    {
+        return {{ ThumbCandidates(thumb16Patterns, thumb16PatternsCount, I << 8, 0xff00)... }};
+    }
+
+    constexpr lookup_table_t<uint16_t, 256> thumb16Table = MakeThumb16Table(make_index_seq_t<256>::type());
+
+    // Thumb 32-bit table, index is first halfword bits [12:4] (bits [15:13] are `111` for all 32-bit instructions).
+    template<std::size_t... I>
+    constexpr lookup_table_t<uint16_t, sizeof...(I)> MakeThumb32Table(index_seq_t<I...>)
+    {
+        return {{ ThumbCandidates(thumb32Patterns, thumb32PatternsCount, 0xe000 | (I << 4), 0xfff0)... }};
+    }
+
+    constexpr lookup_table_t<uint16_t, 512> thumb32Table = MakeThumb32Table(make_index_seq_t<512>::type());
+
+    static_assert(thumb16PatternsCount <= 16 && thumb32PatternsCount <= 16, "Candidates bit mask must fit uint16_t");
+
+    arm32_insn_class_e MatchThumbPatterns(const thumb_pattern_t *patterns, uint16_t candidates, uint32_t data)
+    {
+        // Note, candidates checked from lowest bit, so, patterns order is preserved.
+        for (; candidates != 0; candidates &= candidates - 1)
+        {
+            const thumb_pattern_t &pattern = patterns[__builtin_ctz(candidates)];
+            if ((data & pattern.mask) == pattern.opcode)
+                return pattern.insnClass;
+        }
+        return arm32_insn_class_e::Default;
+    }
+
+    // Condition table, index is condition, bit `n` is set in case condition passed for NZCV flags value `n`.
+
+    constexpr bool ConditionPassed(uint32_t cond, bool N, bool Z, bool C, bool V)
+    {
+        return cond == 0x0 ? Z :                 // INST_EQ
+               cond == 0x1 ? !Z :                // INST_NE
+               cond == 0x2 ? C :                 // INST_CS
+               cond == 0x3 ? !C :                // INST_CC
+               cond == 0x4 ? N :                 // INST_MI
+               cond == 0x5 ? !N :                // INST_PL
+               cond == 0x6 ? V :                 // INST_VS
+               cond == 0x7 ? !V :                // INST_VC
+               cond == 0x8 ? (C && !Z) :         // INST_HI
+               cond == 0x9 ? !(C && !Z) :        // INST_LS
+               cond == 0xa ? (N == V) :          // INST_GE
+               cond == 0xb ? (N != V) :          // INST_LT
+               cond == 0xc ? (!Z && N == V) :    // INST_GT
+               cond == 0xd ? (Z || N != V) :     // INST_LE
+                             true;               // INST_AL, INST_NV
+    }
+
+    constexpr uint16_t ConditionFlagsMask(uint32_t cond, uint32_t nzcv = 0)
+    {
+        return nzcv == 16 ? 0 :
+            ((ConditionPassed(cond, nzcv & 0x8, nzcv & 0x4, nzcv & 0x2, nzcv & 0x1) ? (uint16_t)(1 << nzcv) : (uint16_t)0) |
+             ConditionFlagsMask(cond, nzcv + 1));
+    }
+
+    template<std::size_t... I>
+    constexpr lookup_table_t<uint16_t, sizeof...(I)> MakeConditionTable(index_seq_t<I...>)
+    {
+        return {{ ConditionFlagsMask(I)... }};
+    }
+
+    constexpr lookup_table_t<uint16_t, 16> conditionTable = MakeConditionTable(make_index_seq_t<16>::type());
+
+} // unnamed namespace
+
+arm32_insn_class_e ARM32_ClassifyArmInsn(uint32_t insn)
+{
+    return armTable.data[insn >> 24];
+}
+
+arm32_insn_class_e ARM32_ClassifyThumb16Insn(uint16_t inst1)
+{
+    return MatchThumbPatterns(thumb16Patterns, thumb16Table.data[inst1 >> 8], inst1);
+}
+
+arm32_insn_class_e ARM32_ClassifyThumb32Insn(uint16_t inst1, uint16_t inst2)
+{
+    return MatchThumbPatterns(thumb32Patterns, thumb32Table.data[(inst1 >> 4) & 0x1ff], ((uint32_t)inst2 << 16) | inst1);
+}
+
+bool ARM32_IsConditionPassed(uint32_t cond, uint32_t regPS)
+{
+    return (conditionTable.data[cond & 0xf] >> (regPS >> 28)) & 1;
+}
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
@@ -0,0 +1,51 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#include <cstdint>
+
+// Note, instructions classification for software single step have no platform dependencies (work with instruction bits only),
+// so, could be compiled and tested on any host.
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+
+    // Instruction classes with own next PC calculation logic, all other instructions have `Default` class (next PC is PC + instruction size).
+    enum class arm32_insn_class_e : uint8_t
+    {
+        Default = 0,
+        // Arm code, note, condition must be checked by caller for all not unconditional classes.
+        ArmUncondBranch,            // BLX <label>
+        ArmUncondCoprocessor,       // unconditional coprocessor operations
+        ArmMiscellaneous,           // multiply, swap, branch and exchange, data operations
+        ArmMemory,                  // single data transfer
+        ArmMultipleMemory,          // block data transfer
+        ArmBranch,                  // B, BL
+        // Thumb 16-bit code
+        Thumb16BranchExchange,      // BX, BLX register
+        Thumb16MovPC,               // MOV PC, register
+        Thumb16PopPC,               // POP {reglist, PC}
+        Thumb16CompareAndBranch,    // CBZ, CBNZ
+        Thumb16CondBranch,          // conditional branch, SVC
+        Thumb16UncondBranch,        // unconditional branch
+        // Thumb 32-bit code
+        Thumb32BranchesMiscControl, // B, BL, BLX, SUBS PC, LR, conditional branch
+        Thumb32LDM,                 // LDMIA, LDMDB
+        Thumb32RFE,                 // RFEIA, RFEDB
+        Thumb32MOV,                 // MOV{S}
+        Thumb32TBB,
+        Thumb32TBH,
+        Thumb32LDR                  // LDR to PC
+    };
+
+    arm32_insn_class_e ARM32_ClassifyArmInsn(uint32_t insn);
+    arm32_insn_class_e ARM32_ClassifyThumb16Insn(uint16_t inst1);
+    arm32_insn_class_e ARM32_ClassifyThumb32Insn(uint16_t inst1, uint16_t inst2);
+    // Check instruction (or IT block) condition with CPSR flags.
+    bool ARM32_IsConditionPassed(uint32_t cond, uint32_t regPS);
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
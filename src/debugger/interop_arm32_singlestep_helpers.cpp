@@ -4,13 +4,14 @@
 
 #include "debugger/interop_arm32_singlestep_helpers.h"
 #include "debugger/interop_brk_helpers.h"
+#include "debugger/interop_arm32_decode_helpers.h"
 
 #include <sys/uio.h> // iovec
 #include <elf.h> // NT_PRSTATUS
 #include <errno.h>
 #include <string.h>
 #include <assert.h>
-#include <functional>
+#include <utility>
 #include "utils/logger.h"
 
 
@@ -47,22 +48,70 @@ static bool IsExecutingThumb(const user_regs_struct &regs)
   return cpsr & 0x20;
 }
 
-template<typename T>
-bool GetDataFromMemory(pid_t pid, std::uintptr_t addr, T &result)
+// Cache of debuggee memory words read during one software single step. Thread is stopped, so, same words
+// (instruction, IT block instructions, next PC instruction) are read by ptrace only once.
+class SingleStepMemory
 {
-    errno = 0;
-    word_t wData = async_ptrace(PTRACE_PEEKDATA, pid, (void*)addr, nullptr);
-    if (errno != 0)
+public:
+
+    explicit SingleStepMemory(pid_t pid) :
+        m_pid(pid)
+    {}
+
+    template<typename T>
+    bool Read(std::uintptr_t addr, T &result)
     {
-        LOGE("Ptrace peekdata error: %s", strerror(errno));
-        return false;
+        static_assert(sizeof(word_t) % sizeof(T) == 0, "Result with type `T` must be element of `word_t`-size array");
+
+        for (auto &entry : m_words)
+        {
+            if (addr >= entry.first && addr + sizeof(T) <= entry.first + sizeof(word_t))
+            {
+                // Note, little-endian only architectures are supported now.
+                memcpy(&result, (const char*)&entry.second + (addr - entry.first), sizeof(T));
+                return true;
+            }
+        }
+
+        errno = 0;
+        word_t wData = async_ptrace(PTRACE_PEEKDATA, m_pid, (void*)addr, nullptr);
+        if (errno != 0)
+        {
+            LOGE("Ptrace peekdata error: %s", strerror(errno));
+            return false;
+        }
+
+        m_words.emplace_back(addr, wData);
+        memcpy(&result, &wData, sizeof(T));
+        return true;
     }
 
-    // Note, little-endian only architectures are supported now.
-    assert(sizeof(word_t) % sizeof(T) == 0); // result with type `T` must be element of `word_t`-size array
-    result = ((T*)&wData)[0]; // just get first element of array
-    return true;
-}
+    bool Write(std::uintptr_t addr, word_t data)
+    {
+        if (async_ptrace(PTRACE_POKEDATA, m_pid, (void*)addr, (void*)data) == -1)
+        {
+            LOGE("Ptrace pokedata error: %s", strerror(errno));
+            return false;
+        }
+
+        // Drop all words that overlap changed memory.
+        for (auto it = m_words.begin(); it != m_words.end();)
+        {
+            if (it->first < addr + sizeof(word_t) && addr < it->first + sizeof(word_t))
+                it = m_words.erase(it);
+            else
+                ++it;
+        }
+        m_words.emplace_back(addr, data);
+        return true;
+    }
+
+private:
+
+    pid_t m_pid;
+    // Note, only few words are read during single step, linear search is faster than any map here.
+    std::vector<std::pair<std::uintptr_t, word_t>> m_words;
+};
 
 static inline std::uint32_t MakeSubmask(std::uint32_t x)
 {
@@ -90,41 +139,13 @@ static inline std::uintptr_t CalculateBranchDest(std::uint32_t addr, std::uint32
     return addr + 8 + (GetSBits(instr, 0, 23) << 2);
 }
 
-constexpr std::uint32_t INST_AL = 0xe; // allways
 constexpr std::uint32_t INST_NV = 0xf; // unconditional/allways
 
-constexpr std::uint32_t FLAG_N = 0x80000000;
-constexpr std::uint32_t FLAG_Z = 0x40000000;
 constexpr std::uint32_t FLAG_C = 0x20000000;
-constexpr std::uint32_t FLAG_V = 0x10000000;
 
-static bool IsConditionTrue(std::uint32_t cond, std::uint32_t regPS)
+static inline bool IsConditionTrue(std::uint32_t cond, std::uint32_t regPS)
 {
-    if (cond == INST_AL || cond == INST_NV)
-        return true;
-
-    static std::vector<std::function<bool(std::uint32_t)>> conditionLogic
-    {
-        [](std::uint32_t regPS) {return ((regPS & FLAG_Z) != 0);}, // INST_EQ = 0x0
-        [](std::uint32_t regPS) {return ((regPS & FLAG_Z) == 0);}, // INST_NE = 0x1
-        [](std::uint32_t regPS) {return ((regPS & FLAG_C) != 0);}, // INST_CS = 0x2
-        [](std::uint32_t regPS) {return ((regPS & FLAG_C) == 0);}, // INST_CC = 0x3
-        [](std::uint32_t regPS) {return ((regPS & FLAG_N) != 0);}, // INST_MI = 0x4
-        [](std::uint32_t regPS) {return ((regPS & FLAG_N) == 0);}, // INST_PL = 0x5
-        [](std::uint32_t regPS) {return ((regPS & FLAG_V) != 0);}, // INST_VS = 0x6
-        [](std::uint32_t regPS) {return ((regPS & FLAG_V) == 0);}, // INST_VC = 0x7
-        [](std::uint32_t regPS) {return ((regPS & (FLAG_C | FLAG_Z)) == FLAG_C);}, // INST_HI = 0x8
-        [](std::uint32_t regPS) {return ((regPS & (FLAG_C | FLAG_Z)) != FLAG_C);}, // INST_LS = 0x9
-        [](std::uint32_t regPS) {return (((regPS & FLAG_N) == 0) == ((regPS & FLAG_V) == 0));}, // INST_GE = 0xa
-        [](std::uint32_t regPS) {return (((regPS & FLAG_N) == 0) != ((regPS & FLAG_V) == 0));}, // INST_LT = 0xb
-        [](std::uint32_t regPS) {return (((regPS & FLAG_Z) == 0) && (((regPS & FLAG_N) == 0) == ((regPS & FLAG_V) == 0)));}, // INST_GT = 0xc
-        [](std::uint32_t regPS) {return (((regPS & FLAG_Z) != 0) || (((regPS & FLAG_N) == 0) != ((regPS & FLAG_V) == 0)));}  // INST_LE = 0xd
-    };
-
-    if (conditionLogic.size() < cond)
-        return conditionLogic[cond](regPS);
-
-    return true;
+    return ARM32_IsConditionPassed(cond, regPS);
 }
 
 static std::uint32_t ShiftRegValue(const user_regs_struct &regs, std::uint32_t inst, bool carry, std::uint32_t regPC)
@@ -156,7 +177,8 @@ static std::uint32_t ShiftRegValue(const user_regs_struct &regs, std::uint32_t i
     int offsetReg = GetBits(inst, 0, 3);
     std::uint32_t result = (offsetReg == REG_PC ? (regPC + (GetBit(inst, 4) ? 12 : 8)) : (std::uint32_t)(regs.uregs[offsetReg]));
 
-    static std::vector<std::function<void(std::uint32_t,bool,std::uint32_t&)>> shiftLogic
+    typedef void (*ShiftOperation)(std::uint32_t, bool, std::uint32_t&);
+    static const ShiftOperation shiftLogic[] =
     {
         [](std::uint32_t shift, bool, std::uint32_t &result) { result = shift >= 32 ? 0 : result << shift;}, // LSL = 0
         [](std::uint32_t shift, bool, std::uint32_t &result) { result = shift >= 32 ? 0 : result >> shift;}, // LSR = 1
@@ -177,9 +199,7 @@ static std::uint32_t ShiftRegValue(const user_regs_struct &regs, std::uint32_t i
         }                                                                                                     // ROR/RRX = 3
     };
 
-    std::uint32_t shiftType = GetBits(inst, 5, 6);
-    if (shiftLogic.size() < shiftType)
-        shiftLogic[shiftType](shift, carry, result);
+    shiftLogic[GetBits(inst, 5, 6)](shift, carry, result);
 
     return result;
 }
@@ -202,7 +222,7 @@ static bool ArmUnconditional_CoprocessorOperations(std::uintptr_t, std::uint32_t
     return true;
 };
 
-static bool ArmConditionTrue_Miscellaneous(pid_t, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
+static bool ArmConditionTrue_Miscellaneous(SingleStepMemory&, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
                                            std::uint32_t currentInstr, std::uintptr_t &nextPC, bool &switchToThumbCode)
 {
     // Multiply and Multiply-Accumulate (MUL, MLA)
@@ -276,7 +296,8 @@ static bool ArmConditionTrue_Miscellaneous(pid_t, const user_regs_struct &regs,
         operand2 = ShiftRegValue(regs, currentInstr, carry, currentPC);
     }
 
-    static std::vector<std::function<std::uintptr_t(std::uintptr_t,std::uintptr_t,std::uintptr_t, bool)>> dataOperations
+    typedef std::uintptr_t (*DataOperation)(std::uintptr_t, std::uintptr_t, std::uintptr_t, bool);
+    static const DataOperation dataOperations[] =
     {
         [](std::uintptr_t, std::uintptr_t operand1, std::uintptr_t operand2, bool) { return operand1 & operand2; }, // and = 0x0
         [](std::uintptr_t, std::uintptr_t operand1, std::uintptr_t operand2, bool) { return operand1 ^ operand2; }, // eor = 0x1
@@ -302,7 +323,7 @@ static bool ArmConditionTrue_Miscellaneous(pid_t, const user_regs_struct &regs,
     return true;
 };
 
-static bool ArmConditionTrue_MemoryOperations(pid_t pid, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
+static bool ArmConditionTrue_MemoryOperations(SingleStepMemory &memory, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
                                               std::uint32_t currentInstr, std::uintptr_t &nextPC, bool&)
 {
     // We care about LDR only here.
@@ -334,7 +355,7 @@ static bool ArmConditionTrue_MemoryOperations(pid_t pid, const user_regs_struct
                 baseData -= offset; // down
         }
 
-        if (!GetDataFromMemory(pid, baseData, nextPC))
+        if (!memory.Read(baseData, nextPC))
         {
             LOGE("Failed next PC calculation");
             return false;
@@ -344,7 +365,7 @@ static bool ArmConditionTrue_MemoryOperations(pid_t pid, const user_regs_struct
     return true;
 };
 
-static bool ArmConditionTrue_MultipleMemoryOperations(pid_t pid, const user_regs_struct &regs, std::uintptr_t, std::uintptr_t,
+static bool ArmConditionTrue_MultipleMemoryOperations(SingleStepMemory &memory, const user_regs_struct &regs, std::uintptr_t, std::uintptr_t,
                                                       std::uint32_t currentInstr, std::uintptr_t &nextPC, bool&)
 {
     if (GetBit(currentInstr, 20) && GetBit(currentInstr, REG_PC)) // LDM (in case PC also included in register list)
@@ -364,7 +385,7 @@ static bool ArmConditionTrue_MultipleMemoryOperations(pid_t pid, const user_regs
 
         std::uint32_t baseReg = GetBits(currentInstr, 16, 19);
         std::uintptr_t addr = std::uintptr_t(regs.uregs[baseReg]) + offset;
-        if (!GetDataFromMemory(pid, addr, nextPC))
+        if (!memory.Read(addr, nextPC))
         {
             LOGE("Failed next PC calculation");
             return false;
@@ -374,7 +395,7 @@ static bool ArmConditionTrue_MultipleMemoryOperations(pid_t pid, const user_regs
     return true;
 };
 
-static bool ArmConditionTrue_Branches(pid_t, const user_regs_struct&, std::uintptr_t, std::uintptr_t currentPC,
+static bool ArmConditionTrue_Branches(SingleStepMemory&, const user_regs_struct&, std::uintptr_t, std::uintptr_t currentPC,
                                       std::uint32_t currentInstr, std::uintptr_t &nextPC, bool&)
 {
     nextPC = CalculateBranchDest(currentPC, currentInstr);
@@ -382,63 +403,37 @@ static bool ArmConditionTrue_Branches(pid_t, const user_regs_struct&, std::uintp
 };
 
 // Get next possible addresses for Arm instruction subset.
-static bool GetArmCodeNextPCs(pid_t pid, const user_regs_struct &regs, std::vector<sw_singlestep_nextpc_t> &swSingleStepNextPCs)
+static bool GetArmCodeNextPCs(SingleStepMemory &memory, const user_regs_struct &regs, std::vector<sw_singlestep_nextpc_t> &swSingleStepNextPCs)
 {
     std::uintptr_t currentPC = std::uintptr_t(regs.uregs[REG_PC]);
     std::uintptr_t nextPC = currentPC + 4; // default PC changes
     bool switchToThumbCode = false;
 
     std::uint32_t currentInstr = 0;
-    if (!GetDataFromMemory<std::uint32_t>(pid, currentPC, currentInstr))
+    if (!memory.Read<std::uint32_t>(currentPC, currentInstr))
         return false;
 
     std::uintptr_t currentPS = regs.uregs[REG_CPSR];
 
-    constexpr unsigned unconditionalOpsShift = 0xa;
-    static std::vector<std::function<bool(std::uintptr_t, std::uint32_t, std::uintptr_t&, bool&)>> unconditionalOperations
-    {
-        // branches
-        ArmUnconditional_Branches, // 0xa - branch and change to Thumb
-        ArmUnconditional_Branches, // 0xb - branch & link and change to Thumb
-        // coprocessor operations
-        ArmUnconditional_CoprocessorOperations, // 0xc
-        ArmUnconditional_CoprocessorOperations, // 0xd
-        ArmUnconditional_CoprocessorOperations  // 0xe
-    };
-
-    static std::vector<std::function<bool(pid_t, const user_regs_struct&, std::uintptr_t, std::uintptr_t, std::uint32_t, std::uintptr_t&, bool&)>> conditionTrueOperations
-    {
-        // miscellaneous instructions (multiply, swap, branch and exchange, data operations)
-        ArmConditionTrue_Miscellaneous, // 0x0
-        ArmConditionTrue_Miscellaneous, // 0x1
-        ArmConditionTrue_Miscellaneous, // 0x2
-        ArmConditionTrue_Miscellaneous, // 0x3
-        // memory operations
-        ArmConditionTrue_MemoryOperations, // 0x4
-        ArmConditionTrue_MemoryOperations, // 0x5
-        ArmConditionTrue_MemoryOperations, // 0x6
-        ArmConditionTrue_MemoryOperations, // 0x7
-        // block/multiple memory operations
-        ArmConditionTrue_MultipleMemoryOperations, // 0x8
-        ArmConditionTrue_MultipleMemoryOperations, // 0x9
-        // branches
-        ArmConditionTrue_Branches, // 0xa - branch
-        ArmConditionTrue_Branches, // 0xb - branch & link
-        // coprocessor operations (do nothing)
-        // 0xc
-        // 0xd
-        // 0xe
-        // system calls (do nothing)
-        // 0xf - TODO care about SIGRETURN/RT_SIGRETURN syscalls.
-    };
+    // Note, unconditional (0xf) coprocessor operations and system calls have `Default` class (do nothing).
+    // TODO care about SIGRETURN/RT_SIGRETURN syscalls.
+    arm32_insn_class_e insnClass = ARM32_ClassifyArmInsn(currentInstr);
 
     if (GetBits(currentInstr, 28, 31) == INST_NV)
     {
         unsigned op = GetBits(currentInstr, 24, 27);
-        if (op > unconditionalOpsShift && op < unconditionalOpsShift + unconditionalOperations.size())
+        switch (insnClass)
         {
-            if (!unconditionalOperations[op - unconditionalOpsShift](currentPC, currentInstr, nextPC, switchToThumbCode))
+        case arm32_insn_class_e::ArmUncondBranch: // branch & link and change to Thumb
+            if (!ArmUnconditional_Branches(currentPC, currentInstr, nextPC, switchToThumbCode))
+                return false;
+            break;
+        case arm32_insn_class_e::ArmUncondCoprocessor:
+            if (!ArmUnconditional_CoprocessorOperations(currentPC, currentInstr, nextPC, switchToThumbCode))
                 return false;
+            break;
+        default:
+            break;
         }
 
         // Note, Linux kernel could offers some helpers/intrisics in a high page that we can't read (and write).
@@ -455,11 +450,26 @@ static bool GetArmCodeNextPCs(pid_t pid, const user_regs_struct &regs, std::vect
     else if (IsConditionTrue(GetBits(currentInstr, 28, 31), currentPS))
     {
         unsigned op = GetBits(currentInstr, 24, 27);
-        if (op < conditionTrueOperations.size())
+        bool result = true;
+        switch (insnClass)
         {
-            if (!conditionTrueOperations[op](pid, regs, currentPS, currentPC, currentInstr, nextPC, switchToThumbCode))
-                return false;
+        case arm32_insn_class_e::ArmMiscellaneous: // multiply, swap, branch and exchange, data operations
+            result = ArmConditionTrue_Miscellaneous(memory, regs, currentPS, currentPC, currentInstr, nextPC, switchToThumbCode);
+            break;
+        case arm32_insn_class_e::ArmMemory:
+            result = ArmConditionTrue_MemoryOperations(memory, regs, currentPS, currentPC, currentInstr, nextPC, switchToThumbCode);
+            break;
+        case arm32_insn_class_e::ArmMultipleMemory:
+            result = ArmConditionTrue_MultipleMemoryOperations(memory, regs, currentPS, currentPC, currentInstr, nextPC, switchToThumbCode);
+            break;
+        case arm32_insn_class_e::ArmBranch: // branch, branch & link
+            result = ArmConditionTrue_Branches(memory, regs, currentPS, currentPC, currentInstr, nextPC, switchToThumbCode);
+            break;
+        default: // coprocessor operations and system calls (do nothing)
+            break;
         }
+        if (!result)
+            return false;
 
         // Note, Linux kernel could offers some helpers/intrisics in a high page that we can't read (and write).
         // For BL and BLX move to address of following instruction, in case tail called functions return to the address in LR.
@@ -496,7 +506,7 @@ static std::uint32_t ThumbAdvanceITState(std::uint32_t itstate)
     return ((itstate & 0x0f) == 0) ? 0 : itstate;
 }
 
-static bool GetThumbConditionalBlockNextPCs(pid_t pid, std::uintptr_t currentPS, std::uintptr_t currentPC, std::uint16_t inst1, std::vector<sw_singlestep_nextpc_t> &swSingleStepNextPCs)
+static bool GetThumbConditionalBlockNextPCs(SingleStepMemory &memory, std::uintptr_t currentPS, std::uintptr_t currentPC, std::uint16_t inst1, std::vector<sw_singlestep_nextpc_t> &swSingleStepNextPCs)
 {
     // In Linux, breakpoint is illegal instruction. IT can disable illegal instruction execution.
     // This mean, we could never reach this breakpoint. Plus, conditional instructions can change flags,
@@ -509,7 +519,7 @@ static bool GetThumbConditionalBlockNextPCs(pid_t pid, std::uintptr_t currentPS,
 
         while (ITState != 0 && !IsConditionTrue(ITState >> 4, currentPS))
         {
-            if (!GetDataFromMemory<std::uint16_t>(pid, nextPC, inst1))
+            if (!memory.Read<std::uint16_t>(nextPC, inst1))
                 return false;
 
             nextPC += ThumbInsnructionSize(inst1);
@@ -535,7 +545,7 @@ static bool GetThumbConditionalBlockNextPCs(pid_t pid, std::uintptr_t currentPS,
 
         while (ITState != 0 && !IsConditionTrue(ITState >> 4, currentPS))
         {
-            if (!GetDataFromMemory<std::uint16_t>(pid, nextPC, inst1))
+            if (!memory.Read<std::uint16_t>(nextPC, inst1))
                 return false;
 
             nextPC += ThumbInsnructionSize(inst1);
@@ -560,7 +570,7 @@ static bool GetThumbConditionalBlockNextPCs(pid_t pid, std::uintptr_t currentPS,
     // "skip" all instruction with the same condition or till this block ends.
     do
     {
-        if (!GetDataFromMemory<std::uint16_t>(pid, nextPC, inst1))
+        if (!memory.Read<std::uint16_t>(nextPC, inst1))
             return false;
 
         nextPC += ThumbInsnructionSize(inst1);
@@ -572,12 +582,7 @@ static bool GetThumbConditionalBlockNextPCs(pid_t pid, std::uintptr_t currentPS,
     return true;
 }
 
-static bool Thumb16_Default(pid_t, const user_regs_struct&, std::uintptr_t, std::uintptr_t, std::uint16_t, std::uintptr_t&, bool&)
-{
-    return true;
-};
-
-static bool Thumb16_BranchExchangeAndDataProcessing(pid_t, const user_regs_struct &regs, std::uintptr_t, std::uintptr_t currentPC,
+static bool Thumb16_BranchExchangeAndDataProcessing(SingleStepMemory&, const user_regs_struct &regs, std::uintptr_t, std::uintptr_t currentPC,
                                                     std::uint16_t inst1, std::uintptr_t &nextPC, bool &switchToThumbCode)
 {
     if ((inst1 & 0xff00) == 0x4700) // BX REG, BLX REG
@@ -614,7 +619,7 @@ static bool Thumb16_BranchExchangeAndDataProcessing(pid_t, const user_regs_struc
     return true;
 };
 
-static bool Thumb16_Miscellaneous(pid_t pid, const user_regs_struct &regs, std::uintptr_t, std::uintptr_t currentPC,
+static bool Thumb16_Miscellaneous(SingleStepMemory &memory, const user_regs_struct &regs, std::uintptr_t, std::uintptr_t currentPC,
                                   std::uint16_t inst1, std::uintptr_t &nextPC, bool &switchToThumbCode)
 {
     if ((inst1 & 0xff00) == 0xbd00) // POP {reglist, PC}
@@ -622,7 +627,7 @@ static bool Thumb16_Miscellaneous(pid_t pid, const user_regs_struct &regs, std::
         // Count offset for all registers that are set in register list. Note, PC stored above all of the other registers.
         int offset = __builtin_popcountl(GetBits(inst1, 0, 7)) * 4;
         std::uintptr_t regSP = std::uintptr_t(regs.uregs[REG_SP]);
-        if (!GetDataFromMemory<std::uint32_t>(pid, regSP + offset, nextPC))
+        if (!memory.Read<std::uint32_t>(regSP + offset, nextPC))
             return false;
         // Bit[0] of the loaded value determines whether execution continues after this branch in ARM state or in Thumb state.
         if ((nextPC & 1) == 0)
@@ -646,7 +651,7 @@ static bool Thumb16_Miscellaneous(pid_t pid, const user_regs_struct &regs, std::
     return true;
 };
 
-static bool Thumb16_ConditionalBranch(pid_t, const user_regs_struct&, std::uintptr_t currentPS, std::uintptr_t currentPC,
+static bool Thumb16_ConditionalBranch(SingleStepMemory&, const user_regs_struct&, std::uintptr_t currentPS, std::uintptr_t currentPC,
                                       std::uint16_t inst1, std::uintptr_t &nextPC, bool&)
 {
     if ((inst1 & 0xf000) == 0xd000) // Conditional branch
@@ -666,7 +671,7 @@ static bool Thumb16_ConditionalBranch(pid_t, const user_regs_struct&, std::uintp
     return true;
 };
 
-static bool Thumb16_UnconditionalBranch(pid_t, const user_regs_struct&, std::uintptr_t, std::uintptr_t currentPC,
+static bool Thumb16_UnconditionalBranch(SingleStepMemory&, const user_regs_struct&, std::uintptr_t, std::uintptr_t currentPC,
                                         std::uint16_t inst1, std::uintptr_t &nextPC, bool&)
 {
     if ((inst1 & 0xf800) == 0xe000) // unconditional branch
@@ -678,7 +683,7 @@ static bool Thumb16_UnconditionalBranch(pid_t, const user_regs_struct&, std::uin
     return true;
 };
 
-static bool Thumb32_BranchesMiscControl(pid_t pid, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
+static bool Thumb32_BranchesMiscControl(SingleStepMemory &memory, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
                                         std::uint16_t inst1, std::uint16_t inst2, std::uintptr_t &nextPC, bool &switchToThumbCode)
 {
     if ((inst2 & 0x1000) != 0 || (inst2 & 0xd001) == 0xc000) // B, BL, BLX
@@ -733,14 +738,14 @@ static bool Thumb32_BranchesMiscControl(pid_t pid, const user_regs_struct &regs,
     return true;
 }
 
-static bool Thumb32_LDM(pid_t pid, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
+static bool Thumb32_LDM(SingleStepMemory &memory, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
                         std::uint16_t inst1, std::uint16_t inst2, std::uintptr_t &nextPC, bool &switchToThumbCode)
 {
     auto loadPC = [&](std::int32_t offset)
     {
         int baseReg = GetBits(inst1, 0, 3);
         std::uintptr_t addr = std::uintptr_t(regs.uregs[baseReg]);
-        if (!GetDataFromMemory<std::uint32_t>(pid, addr + offset, nextPC))
+        if (!memory.Read<std::uint32_t>(addr + offset, nextPC))
             return false;
 
         if ((nextPC & 1) == 0)
@@ -766,18 +771,18 @@ static bool Thumb32_LDM(pid_t pid, const user_regs_struct &regs, std::uintptr_t
     return true;
 }
 
-static bool Thumb32_RFE(pid_t pid, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
+static bool Thumb32_RFE(SingleStepMemory &memory, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
                         std::uint16_t inst1, std::uint16_t inst2, std::uintptr_t &nextPC, bool &switchToThumbCode)
 {
     auto loadPC = [&](std::int32_t offset)
     {
         int baseReg = GetBits(inst1, 0, 3);
         std::uintptr_t addr = std::uintptr_t(regs.uregs[baseReg]);
-        if (!GetDataFromMemory<std::uint32_t>(pid, addr + offset, nextPC))
+        if (!memory.Read<std::uint32_t>(addr + offset, nextPC))
             return false;
 
         std::uint32_t nextCPSR = 0;
-        if (!GetDataFromMemory<std::uint32_t>(pid, addr + offset + 4, nextCPSR))
+        if (!memory.Read<std::uint32_t>(addr + offset + 4, nextCPSR))
             return false;
 
         // FIXME for `M profiles` (Cortex-M), XPSR_T_BIT must be used instead.
@@ -802,7 +807,7 @@ static bool Thumb32_RFE(pid_t pid, const user_regs_struct &regs, std::uintptr_t
     return true;
 }
 
-static bool Thumb32_MOV(pid_t pid, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
+static bool Thumb32_MOV(SingleStepMemory &memory, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
                         std::uint16_t inst1, std::uint16_t inst2, std::uintptr_t &nextPC, bool &switchToThumbCode)
 {
     if (GetBits(inst2, 8, 11) == REG_PC) // only if <Rd> is PC
@@ -814,7 +819,7 @@ static bool Thumb32_MOV(pid_t pid, const user_regs_struct &regs, std::uintptr_t
     return true;
 }
 
-static bool Thumb32_LDR(pid_t pid, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
+static bool Thumb32_LDR(SingleStepMemory &memory, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
                         std::uint16_t inst1, std::uint16_t inst2, std::uintptr_t &nextPC, bool &switchToThumbCode)
 {
     int rn = GetBits(inst1, 0, 3);
@@ -822,7 +827,7 @@ static bool Thumb32_LDR(pid_t pid, const user_regs_struct &regs, std::uintptr_t
 
     auto loadPC = [&]()
     {
-        return GetDataFromMemory<std::uint32_t>(pid, base, nextPC);
+        return memory.Read<std::uint32_t>(base, nextPC);
     };
 
     if (rn == REG_PC)
@@ -862,7 +867,7 @@ static bool Thumb32_LDR(pid_t pid, const user_regs_struct &regs, std::uintptr_t
     return true;
 }
 
-static bool Thumb32_TBB(pid_t pid, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
+static bool Thumb32_TBB(SingleStepMemory &memory, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
                         std::uint16_t inst1, std::uint16_t inst2, std::uintptr_t &nextPC, bool &switchToThumbCode)
 {
     std::uintptr_t table;
@@ -875,7 +880,7 @@ static bool Thumb32_TBB(pid_t pid, const user_regs_struct &regs, std::uintptr_t
     std::uintptr_t offset = std::uintptr_t(regs.uregs[GetBits(inst2, 0, 3)]);
 
     std::uint8_t tmp = 0;
-    if (!GetDataFromMemory<std::uint8_t>(pid, table + offset, tmp))
+    if (!memory.Read<std::uint8_t>(table + offset, tmp))
         return false;
 
     std::uintptr_t length = 2 * tmp;
@@ -885,7 +890,7 @@ static bool Thumb32_TBB(pid_t pid, const user_regs_struct &regs, std::uintptr_t
     return true;
 }
 
-static bool Thumb32_TBH(pid_t pid, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
+static bool Thumb32_TBH(SingleStepMemory &memory, const user_regs_struct &regs, std::uintptr_t currentPS, std::uintptr_t currentPC,
                         std::uint16_t inst1, std::uint16_t inst2, std::uintptr_t &nextPC, bool &switchToThumbCode)
 {
     std::uintptr_t table;
@@ -898,7 +903,7 @@ static bool Thumb32_TBH(pid_t pid, const user_regs_struct &regs, std::uintptr_t
     std::uintptr_t offset = 2 * std::uintptr_t(regs.uregs[GetBits(inst2, 0, 3)]);
 
     std::uint16_t tmp = 0;
-    if (!GetDataFromMemory<std::uint16_t>(pid, table + offset, tmp))
+    if (!memory.Read<std::uint16_t>(table + offset, tmp))
         return false;
 
     std::uintptr_t length = 2 * tmp;
@@ -908,7 +913,7 @@ static bool Thumb32_TBH(pid_t pid, const user_regs_struct &regs, std::uintptr_t
     return true;
 }
 
-static bool FixThumbCodeNextPCs(pid_t pid, const user_regs_struct &regs, std::vector<sw_singlestep_nextpc_t> &swSingleStepNextPCs)
+static bool FixThumbCodeNextPCs(SingleStepMemory &memory, const user_regs_struct &regs, std::vector<sw_singlestep_nextpc_t> &swSingleStepNextPCs)
 {
     // Note, Linux kernel could offers some helpers/intrisics in a high page that we can't read (and write).
     // For BL and BLX move to address of following instruction, in case tail called functions return to the address in LR.
@@ -923,7 +928,7 @@ static bool FixThumbCodeNextPCs(pid_t pid, const user_regs_struct &regs, std::ve
         bool isBLorBLX = false;
         std::uintptr_t incrPC = 0;
         std::uint16_t inst1 = 0;
-        if (!GetDataFromMemory<std::uint16_t>(pid, currentPC, inst1))
+        if (!memory.Read<std::uint16_t>(currentPC, inst1))
             return false;
 
         if (GetBits(inst1, 8, 15) == 0x47 && GetBit(inst1, 7)) // BLX register
@@ -934,7 +939,7 @@ static bool FixThumbCodeNextPCs(pid_t pid, const user_regs_struct &regs, std::ve
         else if (ThumbInsnructionSize(inst1) == 4) // 32-bit instruction
         {
             std::uint16_t inst2 = 0;
-            if (!GetDataFromMemory<std::uint16_t>(pid, currentPC + 2, inst2))
+            if (!memory.Read<std::uint16_t>(currentPC + 2, inst2))
                 return false;
 
             if ((inst1 & 0xf800) == 0xf000 && GetBits(inst2, 14, 15) == 0x3) // BL <label> or BLX <label>
@@ -956,89 +961,86 @@ static bool FixThumbCodeNextPCs(pid_t pid, const user_regs_struct &regs, std::ve
 }
 
 // Get next possible addresses for Thumb instruction subset.
-static bool GetThumbCodeNextPCs(pid_t pid, const user_regs_struct &regs, std::vector<sw_singlestep_nextpc_t> &swSingleStepNextPCs)
+static bool GetThumbCodeNextPCs(SingleStepMemory &memory, const user_regs_struct &regs, std::vector<sw_singlestep_nextpc_t> &swSingleStepNextPCs)
 {
     std::uintptr_t currentPC = std::uintptr_t(regs.uregs[REG_PC]);
     std::uint32_t currentData32 = 0;
-    if (!GetDataFromMemory<std::uint32_t>(pid, currentPC, currentData32))
+    if (!memory.Read<std::uint32_t>(currentPC, currentData32))
         return false;
 
-    static std::vector<std::function<bool(pid_t, const user_regs_struct&, std::uintptr_t, std::uintptr_t, std::uint16_t, std::uintptr_t&, bool&)>> thumb16Operations
-    {
-        Thumb16_Default, // 0x0
-        Thumb16_Default, // 0x1
-        Thumb16_Default, // 0x2
-        Thumb16_Default, // 0x3
-        Thumb16_BranchExchangeAndDataProcessing, // 0x4 - Branch Exchange, Data-processing register
-        Thumb16_Default, // 0x5
-        Thumb16_Default, // 0x6
-        Thumb16_Default, // 0x7
-        Thumb16_Default, // 0x8
-        Thumb16_Default, // 0x9
-        Thumb16_Default, // 0xa
-        Thumb16_Miscellaneous, // 0xb - POP {reglist, pc}, CBZ or CBNZ (Compare and Branch on Zero, Compare and Branch on Non-Zero)
-        Thumb16_Default, // 0xc
-        Thumb16_ConditionalBranch, // 0xd - Conditional branch
-        Thumb16_UnconditionalBranch // 0xe - Unconditional branch
-    };
-
-    struct thumb32entry
-    {
-        std::uint32_t mask;
-        std::uint32_t opcode;
-        std::function<bool(pid_t, const user_regs_struct&, std::uintptr_t, std::uintptr_t, std::uint16_t, std::uint16_t, std::uintptr_t&, bool&)> func;
-    };
-    static std::vector<thumb32entry> thumb32Operations
-    {
-        // mask/opcode - instr2(16bit):instr1(16bit)
-        {0x8000f800, 0x8000f000, Thumb32_BranchesMiscControl}, // Branches, miscellaneous control instructions
-        {0x2000ffd0, 0x0000e910, Thumb32_LDM}, // LDMDB
-        {0x2000ffd0, 0x0000e890, Thumb32_LDM}, // LDMIA
-        {0xffffffd0, 0xc000e990, Thumb32_RFE}, // RFEDB
-        {0xffffffd0, 0xc000e810, Thumb32_RFE}, // RFEIA
-        {0xf0f0ffef, 0x0000ea4f, Thumb32_MOV}, // MOV{S}
-        {0xfff0fff0, 0xf000e8d0, Thumb32_TBB}, // TBB
-        {0xfff0fff0, 0xf010e8d0, Thumb32_TBH}, // TBH
-        {0xf000ff70, 0xf000f850, Thumb32_LDR}, // LDR, where Rm is PC
-    };
-
     std::uintptr_t currentPS = std::uintptr_t(regs.uregs[REG_CPSR]);
-    if (!GetThumbConditionalBlockNextPCs(pid, currentPS, currentPC, ((std::uint16_t*)&currentData32)[0], swSingleStepNextPCs))
+    if (!GetThumbConditionalBlockNextPCs(memory, currentPS, currentPC, ((std::uint16_t*)&currentData32)[0], swSingleStepNextPCs))
         return false;
     else if (swSingleStepNextPCs.empty())
     {
         std::uintptr_t nextPC = currentPC + 2; // default PC changes for thumb16
         bool switchToThumbCode = true;
 
+        std::uint16_t inst1 = ((std::uint16_t*)&currentData32)[0];
+        std::uint16_t inst2 = ((std::uint16_t*)&currentData32)[1];
+        bool result = true;
+
         if (!IsThumbOpcode32Bits(currentData32)) // 16-bit instruction
         {
-            unsigned op = GetBits(currentData32, 12, 15);
-            if (op < thumb16Operations.size())
+            switch (ARM32_ClassifyThumb16Insn(inst1))
             {
-                if (!thumb16Operations[op](pid, regs, currentPS, currentPC, ((std::uint16_t*)&currentData32)[0], nextPC, switchToThumbCode))
-                    return false;
+            case arm32_insn_class_e::Thumb16BranchExchange:
+            case arm32_insn_class_e::Thumb16MovPC:
+                result = Thumb16_BranchExchangeAndDataProcessing(memory, regs, currentPS, currentPC, inst1, nextPC, switchToThumbCode);
+                break;
+            case arm32_insn_class_e::Thumb16PopPC:
+            case arm32_insn_class_e::Thumb16CompareAndBranch:
+                result = Thumb16_Miscellaneous(memory, regs, currentPS, currentPC, inst1, nextPC, switchToThumbCode);
+                break;
+            case arm32_insn_class_e::Thumb16CondBranch:
+                result = Thumb16_ConditionalBranch(memory, regs, currentPS, currentPC, inst1, nextPC, switchToThumbCode);
+                break;
+            case arm32_insn_class_e::Thumb16UncondBranch:
+                result = Thumb16_UnconditionalBranch(memory, regs, currentPS, currentPC, inst1, nextPC, switchToThumbCode);
+                break;
+            default:
+                break;
             }
         }
         else // 32-bit instruction
         {
             nextPC = currentPC + 4; // default PC changes for thumb32
 
-            for (auto &entry : thumb32Operations)
+            switch (ARM32_ClassifyThumb32Insn(inst1, inst2))
             {
-                if ((currentData32 & entry.mask) == entry.opcode)
-                {
-                    if (!entry.func(pid, regs, currentPS, currentPC, ((std::uint16_t*)&currentData32)[0], ((std::uint16_t*)&currentData32)[1], nextPC, switchToThumbCode))
-                        return false;
-
-                    break;
-                }
+            case arm32_insn_class_e::Thumb32BranchesMiscControl:
+                result = Thumb32_BranchesMiscControl(memory, regs, currentPS, currentPC, inst1, inst2, nextPC, switchToThumbCode);
+                break;
+            case arm32_insn_class_e::Thumb32LDM:
+                result = Thumb32_LDM(memory, regs, currentPS, currentPC, inst1, inst2, nextPC, switchToThumbCode);
+                break;
+            case arm32_insn_class_e::Thumb32RFE:
+                result = Thumb32_RFE(memory, regs, currentPS, currentPC, inst1, inst2, nextPC, switchToThumbCode);
+                break;
+            case arm32_insn_class_e::Thumb32MOV:
+                result = Thumb32_MOV(memory, regs, currentPS, currentPC, inst1, inst2, nextPC, switchToThumbCode);
+                break;
+            case arm32_insn_class_e::Thumb32TBB:
+                result = Thumb32_TBB(memory, regs, currentPS, currentPC, inst1, inst2, nextPC, switchToThumbCode);
+                break;
+            case arm32_insn_class_e::Thumb32TBH:
+                result = Thumb32_TBH(memory, regs, currentPS, currentPC, inst1, inst2, nextPC, switchToThumbCode);
+                break;
+            case arm32_insn_class_e::Thumb32LDR:
+                result = Thumb32_LDR(memory, regs, currentPS, currentPC, inst1, inst2, nextPC, switchToThumbCode);
+                break;
+            default:
+                break;
             }
         }
 
+        if (!result)
+            return false;
+
         swSingleStepNextPCs.emplace_back(nextPC, switchToThumbCode);
     }
 
-    return FixThumbCodeNextPCs(pid, regs, swSingleStepNextPCs);
+    return FixThumbCodeNextPCs(memory, regs, swSingleStepNextPCs);
 }
 
 bool ARM32_RemoveSoftwareSingleStepBreakpoints(pid_t pid, std::vector<sw_singlestep_brk_t> &swSingleStepBreakpoints)
@@ -1079,17 +1081,18 @@ bool ARM32_DoSoftwareSingleStep(pid_t pid, std::vector<sw_singlestep_brk_t> &swS
     }
 
     std::vector<sw_singlestep_nextpc_t> swSingleStepNextPCs;
+    SingleStepMemory memory(pid);
 
     if (!IsExecutingThumb(regs))
     {
         // TODO care about atomic sequence of instructions beginning with LDREX{,B,H,D} and ending with STREX{,B,H,D}.
-        if (!GetArmCodeNextPCs(pid, regs, swSingleStepNextPCs))
+        if (!GetArmCodeNextPCs(memory, regs, swSingleStepNextPCs))
             return false;
     }
     else
     {
         // TODO care about atomic sequence of instructions beginning with LDREX{,B,H,D} and ending with STREX{,B,H,D}.
-        if (!GetThumbCodeNextPCs(pid, regs, swSingleStepNextPCs))
+        if (!GetThumbCodeNextPCs(memory, regs, swSingleStepNextPCs))
             return false;
     }
 
@@ -1098,22 +1101,15 @@ bool ARM32_DoSoftwareSingleStep(pid_t pid, std::vector<sw_singlestep_brk_t> &swS
 
     for (auto &entry : swSingleStepNextPCs)
     {
-        errno = 0;  // Since the value returned by a successful PTRACE_PEEK* request may be -1, the caller must clear errno before the call,
-                    // and then check it afterward to determine whether or not an error occurred.
-        word_t nextPCData = async_ptrace(PTRACE_PEEKDATA, pid, (void*)entry.addr, nullptr);
-        if (errno != 0)
-        {
-            LOGE("Ptrace peekdata error: %s", strerror(errno));
+        // Note, next PC instruction could be already read during next PC calculation (for example, IT block).
+        word_t nextPCData = 0;
+        if (!memory.Read(entry.addr, nextPCData))
             return false;
-        }
 
         word_t dataWithBrk = EncodeBrkOpcode(nextPCData, entry.isThumb);
 
-        if (async_ptrace(PTRACE_POKEDATA, pid, (void*)entry.addr, (void*)dataWithBrk) == -1)
-        {
-            LOGE("Ptrace pokedata error: %s", strerror(errno));
+        if (!memory.Write(entry.addr, dataWithBrk))
             return false;
-        }
 
         swSingleStepBreakpoints.emplace_back(entry.addr, nextPCData);
     }
@@ -3,6 +3,7 @@
 // See the LICENSE file in the project root for more information.
 
 #include "debugger/interop_brk_helpers.h"
+#include "debugger/interop_displaced_step_helpers.h"
 
 #include <sys/uio.h> // iovec
 #include <elf.h> // NT_PRSTATUS
@@ -201,5 +202,217 @@ bool StepOverBrk(pid_t pid, std::uintptr_t addr, word_t restoreData, std::functi
     return true;
 }
 
+#if DEBUGGER_UNIX_AMD64 || DEBUGGER_UNIX_ARM64
+
+static bool GetThreadRegs(pid_t pid, user_regs_struct &regs)
+{
+    iovec iov;
+    iov.iov_base = &regs;
+    iov.iov_len = sizeof(user_regs_struct);
+    if (async_ptrace(PTRACE_GETREGSET, pid, (void*)NT_PRSTATUS, &iov) == -1)
+    {
+        LOGE("Ptrace getregset error: %s\n", strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+static bool SetThreadRegs(pid_t pid, user_regs_struct &regs)
+{
+    iovec iov;
+    iov.iov_base = &regs;
+    iov.iov_len = sizeof(user_regs_struct);
+    if (async_ptrace(PTRACE_SETREGSET, pid, (void*)NT_PRSTATUS, &iov) == -1)
+    {
+        LOGE("Ptrace setregset error: %s\n", strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+static bool WriteDisplacedStepBuf(pid_t pid, std::uintptr_t bufAddr, const uint8_t *code, size_t size)
+{
+    static_assert(DisplacedStepBufSize % sizeof(word_t) == 0, "Scratch buffer must be word aligned");
+    assert(size <= DisplacedStepBufSize);
+
+    uint8_t buf[DisplacedStepBufSize];
+    memset(buf, 0, sizeof(buf));
+    memcpy(buf, code, size);
+
+    for (size_t i = 0; i < DisplacedStepBufSize; i += sizeof(word_t))
+    {
+        word_t data;
+        memcpy(&data, buf + i, sizeof(word_t));
+        if (async_ptrace(PTRACE_POKEDATA, pid, (void*)(bufAddr + i), (void*)data) == -1)
+        {
+            LOGE("Ptrace pokedata error: %s\n", strerror(errno));
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif // DEBUGGER_UNIX_AMD64 || DEBUGGER_UNIX_ARM64
+
+#if DEBUGGER_UNIX_AMD64
+
+// Note, `reg` in ModRM order.
+static unsigned long long &AMD64_GetReg(user_regs_struct &regs, int reg)
+{
+    switch (reg)
+    {
+        case 0: return regs.rax;
+        case 1: return regs.rcx;
+        case 2: return regs.rdx;
+        case 3: return regs.rbx;
+        case 4: return regs.rsp;
+        case 5: return regs.rbp;
+        case 6: return regs.rsi;
+        default: return regs.rdi;
+    }
+}
+
+bool DisplacedStepOverBrk(pid_t pid, std::uintptr_t addr, const uint8_t *code, std::uintptr_t bufAddr,
+                          std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk, bool &stepResult)
+{
+    amd64_displaced_insn_t insn;
+    if (!AMD64_PrepareDisplacedInsn(code, DisplacedStepBufSize, insn))
+        return false;
+
+    user_regs_struct regs;
+    if (!GetThreadRegs(pid, regs) || !WriteDisplacedStepBuf(pid, bufAddr, insn.code, insn.length))
+        return false;
+
+    user_regs_struct origRegs = regs;
+    // Note, PC was already changed by int3 execution, but we don't care, since PC point to scratch buffer now.
+    regs.rip = bufAddr;
+    if (insn.ripReg != -1)
+        AMD64_GetReg(regs, insn.ripReg) = addr + insn.length;
+
+    if (!SetThreadRegs(pid, regs))
+        return false;
+
+    stepResult = false;
+    if (!SingleStepOnBrk(pid, addr) || !GetThreadRegs(pid, regs))
+        return true;
+
+    if (insn.ripReg != -1)
+        AMD64_GetReg(regs, insn.ripReg) = AMD64_GetReg(origRegs, insn.ripReg);
+
+    // Note, PC at buffer start in case instruction was not executed (signal received), thread will stop at this breakpoint again.
+    if (regs.rip == bufAddr || insn.relativeBranch || regs.rip == bufAddr + insn.length)
+        regs.rip = addr + (regs.rip - bufAddr);
+    // else - absolute address (ret, indirect jump or call, rt_sigreturn syscall...)
+
+    if (insn.returnAddress && regs.rsp == origRegs.rsp - sizeof(word_t))
+    {
+        errno = 0;
+        word_t retAddr = async_ptrace(PTRACE_PEEKDATA, pid, (void*)regs.rsp, nullptr);
+        if (errno != 0)
+        {
+            LOGE("Ptrace peekdata error: %s", strerror(errno));
+            return true;
+        }
+
+        if (retAddr == bufAddr + insn.length &&
+            async_ptrace(PTRACE_POKEDATA, pid, (void*)regs.rsp, (void*)(word_t)(addr + insn.length)) == -1)
+        {
+            LOGE("Ptrace pokedata error: %s\n", strerror(errno));
+            return true;
+        }
+    }
+
+    stepResult = SetThreadRegs(pid, regs);
+    return true;
+}
+
+#elif DEBUGGER_UNIX_ARM64
+
+bool DisplacedStepOverBrk(pid_t pid, std::uintptr_t addr, const uint8_t *code, std::uintptr_t bufAddr,
+                          std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk, bool &stepResult)
+{
+    uint32_t opcode;
+    memcpy(&opcode, code, sizeof(opcode));
+    arm64_displaced_insn_t insn;
+    if (!ARM64_PrepareDisplacedInsn(opcode, addr, insn))
+        return false;
+
+    word_t loadValue = 0;
+    if (insn.type == arm64_displaced_e::LoadLiteral)
+    {
+        errno = 0;
+        loadValue = async_ptrace(PTRACE_PEEKDATA, pid, (void*)insn.target, nullptr);
+        // Note, in case of error execute instruction in place, so, thread will get proper signal.
+        if (errno != 0)
+            return false;
+
+        if (insn.loadSize == 4)
+            loadValue = insn.loadSigned ? (word_t)(int64_t)(int32_t)(uint32_t)loadValue : (loadValue & 0xffffffff);
+    }
+
+    user_regs_struct regs;
+    if (!GetThreadRegs(pid, regs) || !WriteDisplacedStepBuf(pid, bufAddr, (const uint8_t*)&insn.code, sizeof(insn.code)))
+        return false;
+
+    regs.pc = bufAddr;
+    if (!SetThreadRegs(pid, regs))
+        return false;
+
+    stepResult = false;
+    if (!SingleStepOnBrk(pid, addr) || !GetThreadRegs(pid, regs))
+        return true;
+
+    const std::uintptr_t nextAddr = addr + sizeof(uint32_t);
+
+    // Note, PC at buffer start in case instruction was not executed (signal received), thread will stop at this breakpoint again.
+    if (regs.pc == bufAddr)
+        regs.pc = addr;
+    else
+    {
+        switch (insn.type)
+        {
+            case arm64_displaced_e::Copy:
+                if (regs.pc == bufAddr + sizeof(uint32_t))
+                    regs.pc = nextAddr;
+                // else - absolute address (rt_sigreturn syscall...)
+                break;
+            case arm64_displaced_e::BranchReg:
+                if (regs.regs[30] == bufAddr + sizeof(uint32_t)) // BLR
+                    regs.regs[30] = nextAddr;
+                break;
+            case arm64_displaced_e::CondBranch:
+                regs.pc = regs.pc == bufAddr + 2 * sizeof(uint32_t) ? insn.target : nextAddr;
+                break;
+            case arm64_displaced_e::Branch:
+                regs.pc = insn.target;
+                if (insn.link)
+                    regs.regs[30] = nextAddr;
+                break;
+            case arm64_displaced_e::Adr:
+                if (insn.reg != 31)
+                    regs.regs[insn.reg] = insn.target;
+                regs.pc = nextAddr;
+                break;
+            case arm64_displaced_e::LoadLiteral:
+                if (insn.reg != 31)
+                    regs.regs[insn.reg] = loadValue;
+                regs.pc = nextAddr;
+                break;
+        }
+    }
+
+    stepResult = SetThreadRegs(pid, regs);
+    return true;
+}
+
+#else
+
+bool DisplacedStepOverBrk(pid_t, std::uintptr_t, const uint8_t*, std::uintptr_t, std::function<bool(pid_t, std::uintptr_t)>, bool&)
+{
+    return false; // Not implemented, breakpoint step over with original code restore in memory.
+}
+
+#endif
+
 } // namespace InteropDebugging
 } // namespace netcoredbg
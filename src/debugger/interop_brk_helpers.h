@@ -21,6 +21,15 @@ namespace InteropDebugging
     word_t RestoredOpcode(word_t dataWithBrk, word_t restoreData);
     bool StepOverBrk(pid_t pid, std::uintptr_t addr, word_t restoreData, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk);
 
+    // Scratch buffer size for displaced stepping, also size of original code at breakpoint address.
+    const size_t DisplacedStepBufSize = 16;
+    // Execute instruction covered by breakpoint out-of-line (in scratch buffer at `bufAddr`), so, breakpoint stay in memory
+    // and other threads could continue execution during step. `code` is original code at `addr` (without breakpoints).
+    // Return `false` in case instruction can't be executed out-of-line (thread was not changed), caller should use StepOverBrk() in this case.
+    // In case instruction was executed out-of-line, `stepResult` have `false` for fatal error.
+    bool DisplacedStepOverBrk(pid_t pid, std::uintptr_t addr, const uint8_t *code, std::uintptr_t bufAddr,
+                              std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk, bool &stepResult);
+
 #if DEBUGGER_UNIX_ARM
     bool IsThumbOpcode32Bits(word_t data);
 #endif
@@ -22,7 +22,9 @@
 #include <dirent.h>
 #include <unistd.h> // usleep
 
+#include <cstdio>
 #include <vector>
+#include <unordered_set>
 #include <algorithm>
 #include <sstream>
 #include "interfaces/iprotocol.h"
@@ -37,6 +39,8 @@
 #include "elf++.h"
 #include "dwarf++.h"
 #include "utils/filesystem.h"
+#include "utils/perfcounters.h"
+#include "utils/tracerecorder.h"
 
 
 namespace netcoredbg
@@ -47,6 +51,12 @@ namespace InteropDebugging
 namespace
 {
     constexpr pid_t g_waitForAllThreads = -1;
+
+    PerfCounters::Counter interopStopThreadsTimeCounter("interopStopThreadsTimeUs");
+    PerfCounters::Counter interopWaitThreadsStopTimeCounter("interopWaitThreadsStopTimeUs");
+    PerfCounters::Counter interopContinueThreadsTimeCounter("interopContinueThreadsTimeUs");
+    PerfCounters::Counter interopContinuedThreadsCounter("interopContinuedThreads");
+    PerfCounters::Counter interopPassedSignalsCounter("interopPassedSignals");
 } // unnamed namespace
 
 
@@ -266,34 +276,39 @@ bool InteropDebuggerBase::SingleStepOnBrk(pid_t pid, std::uintptr_t addr)
 // NOTE caller must care about m_waitpidMutex.
 void InteropDebuggerBase::WaitThreadStop(pid_t stoppedPid, std::vector<pid_t> *stoppedTreads)
 {
-    auto AllRequestedThreadsNotRunning = [&]() -> bool
+    // Note, collect requested running threads once and remove them at stop or exit, instead of check all requested threads
+    // for each waitpid() status (with thousands of threads it take most of all threads stop time).
+    std::unordered_set<pid_t> runningTIDs;
+    auto AddIfRunning = [&](pid_t entry)
     {
-        if (stoppedTreads != nullptr)
-        {
-            if (std::find_if(stoppedTreads->begin(), stoppedTreads->end(), [this](pid_t entry)
-                                                                            {// NOTE some threads could exit, don't create m_TIDs entry by m_TIDs[] request.
-                                                                                auto find = m_TIDs.find(entry);
-                                                                                return find == m_TIDs.end() ? false : find->second.stat == thread_stat_e::running;
-                                                                            }) == stoppedTreads->end())
-                return true;
-        }
-        else if (stoppedPid == g_waitForAllThreads)
+        // NOTE some threads could exit, don't create m_TIDs entry by m_TIDs[] request.
+        auto find = m_TIDs.find(entry);
+        if (find != m_TIDs.end() && find->second.stat == thread_stat_e::running)
+            runningTIDs.insert(entry);
+    };
+    if (stoppedTreads != nullptr)
+    {
+        for (pid_t entry : *stoppedTreads)
         {
-            if (std::find_if(m_TIDs.begin(), m_TIDs.end(), [](std::pair<pid_t, thread_status_t> entry){return entry.second.stat == thread_stat_e::running;}) == m_TIDs.end())
-                return true;
+            AddIfRunning(entry);
         }
-        else
+    }
+    else if (stoppedPid == g_waitForAllThreads)
+    {
+        for (const auto &entry : m_TIDs)
         {
-            // NOTE thread could exit, don't create m_TIDs entry by m_TIDs[] request.
-            auto find = m_TIDs.find(stoppedPid);
-            if (find == m_TIDs.end() || find->second.stat != thread_stat_e::running)
-                return true;
+            if (entry.second.stat == thread_stat_e::running)
+                runningTIDs.insert(entry.first);
         }
-        return false;
-    };
-    if (AllRequestedThreadsNotRunning())
+    }
+    else
+        AddIfRunning(stoppedPid);
+
+    if (runningTIDs.empty())
         return;
 
+    PerfCounters::ScopedTime time(interopWaitThreadsStopTimeCounter);
+
     // At this point all threads must be stopped or interrupted, we need parse all signals now.
     pid_t pid = 0;
     int status = 0;
@@ -314,7 +329,8 @@ void InteropDebuggerBase::WaitThreadStop(pid_t stoppedPid, std::vector<pid_t> *s
                 m_NotifyLastThreadExited(status);
             }
 
-            if (AllRequestedThreadsNotRunning())
+            runningTIDs.erase(pid);
+            if (runningTIDs.empty() || m_TIDs.empty())
                 break;
 
             continue;
@@ -339,14 +355,18 @@ void InteropDebuggerBase::WaitThreadStop(pid_t stoppedPid, std::vector<pid_t> *s
         }
 
         if (m_TIDs.find(pid) == m_TIDs.end())
+        {
             pProtocol->EmitThreadEvent(ThreadEvent(NativeThreadStarted, ThreadId(pid), true));
+            m_sharedBreakpoints->InteropSetupDataBreakpoints(pid);
+        }
 
         m_TIDs[pid].stat = thread_stat_e::stopped; // if we here, this mean we get some stop signal for this thread
         m_TIDs[pid].stop_signal = stop_signal;
         m_TIDs[pid].event = (unsigned)status >> 16;
         m_changedThreads.emplace_back(pid);
 
-        if (AllRequestedThreadsNotRunning())
+        runningTIDs.erase(pid);
+        if (runningTIDs.empty())
             break;
     }
 }
@@ -381,7 +401,9 @@ void InteropDebuggerHelpers::StopAndDetach(pid_t tgid)
     }
 
     m_sharedBreakpoints->InteropRemoveAllAtDetach(tgid);
+    m_sharedBreakpoints->InteropRemoveAllDataBreakpointsAtDetach([&](const std::vector<hw_watchpoint_t> &slots) { BrkSetAllThreadsWatchpoints(slots); });
     m_uniqueInteropLibraries->RemoveAllLibraries();
+    FlushUnwindCache(0, 0);
 
     for (const auto &tid : m_TIDs)
     {
@@ -397,13 +419,25 @@ void InteropDebuggerHelpers::StopAndDetach(pid_t tgid)
 // NOTE caller must care about m_waitpidMutex.
 static void StopAllRunningThreads(const std::unordered_map<pid_t, thread_status_t> &TIDs)
 {
+    PerfCounters::ScopedTime time(interopStopThreadsTimeCounter);
+
+    std::vector<ptrace_batch_entry_t> requests;
     for (const auto &tid : TIDs)
     {
-        if (tid.second.stat == thread_stat_e::running &&
-            async_ptrace(PTRACE_INTERRUPT, tid.first, nullptr, nullptr) == -1)
-        {
-            LOGW("Ptrace interrupt error: %s\n", strerror(errno));
-        }
+        if (tid.second.stat == thread_stat_e::running)
+            requests.push_back({PTRACE_INTERRUPT, tid.first, nullptr, nullptr, 0, 0});
+    }
+
+    if (!async_ptrace_batch(requests))
+    {
+        LOGE("Ptrace interrupt error: ptrace thread not running\n");
+        return;
+    }
+
+    for (const auto &entry : requests)
+    {
+        if (entry.result == -1)
+            LOGW("Ptrace interrupt error: %s\n", strerror(entry.error));
     }
 }
 
@@ -417,6 +451,8 @@ void InteropDebuggerHelpers::Detach(pid_t tgid)
 // Note, InteropDebugging::Shutdown() must be called only in case process stopped or finished.
 void InteropDebugger::Shutdown()
 {
+    ShutdownLibEventWorkerThread();
+
     std::unique_lock<std::mutex> lock(m_waitpidMutex);
 
     if (m_waitpidThreadStatus == WaitpidThreadStatus::WORK ||
@@ -513,45 +549,138 @@ static HRESULT SeizeAndInterruptAllThreads(std::unordered_map<pid_t, thread_stat
     return S_OK;
 }
 
-void InteropDebuggerHelpers::LoadLib(pid_t pid, const std::string &libLoadName, const std::string &realLibName, std::uintptr_t startAddr, std::uintptr_t endAddr)
+// NOTE caller must care about m_waitpidMutex.
+void InteropDebuggerHelpers::LoadLib(pid_t /*pid*/, const std::string &libLoadName, const std::string &realLibName, std::uintptr_t startAddr, std::uintptr_t endAddr)
+{
+    std::lock_guard<std::mutex> lock(m_libEventMutex);
+    m_libEvents.emplace_back(true, libLoadName, realLibName, startAddr, endAddr);
+    m_libEventCV.notify_one();
+}
+
+// NOTE caller must care about m_waitpidMutex.
+void InteropDebuggerHelpers::UnloadLib(const std::string &realLibName)
+{
+    // Note, unload also queued, since it must be processed in same order with load (same address could be reused by next lib).
+    std::lock_guard<std::mutex> lock(m_libEventMutex);
+    m_libEvents.emplace_back(false, "", realLibName, 0, 0);
+    m_libEventCV.notify_one();
+}
+
+void InteropDebuggerHelpers::InitLibEventWorkerThread()
+{
+    m_libEventNeedExit = false;
+    m_libEventWorker = std::thread(&InteropDebuggerHelpers::LibEventWorker, this);
+}
+
+// Note, must be called without m_waitpidMutex lock, since worker could wait for m_waitpidMutex in order to setup breakpoints.
+void InteropDebuggerHelpers::ShutdownLibEventWorkerThread()
 {
-    Module module;
-    module.id = ""; // TODO add "The `id` field is an opaque identifier of the library"
-    module.name = GetBasename(realLibName);
-    module.path = realLibName;
-    module.baseAddress = startAddr;
-    module.size = endAddr - startAddr;
-    m_uniqueInteropLibraries->AddLibrary(libLoadName, realLibName, startAddr, endAddr, module.symbolStatus);
-
-    if (module.symbolStatus == SymbolStatus::SymbolsLoaded)
-    {
-        std::vector<BreakpointEvent> events;
-        m_sharedBreakpoints->InteropLoadModule(pid, startAddr, m_uniqueInteropLibraries.get(), events);
-        for (const BreakpointEvent &event : events)
-            pProtocol->EmitBreakpointEvent(event);
+    std::unique_lock<std::mutex> lock(m_libEventMutex);
+    if (!m_libEventWorker.joinable())
+    {
+        m_libEvents.clear();
+        return;
     }
 
-    pProtocol->EmitModuleEvent(ModuleEvent(ModuleNew, module));
+    m_libEventNeedExit = true;
+    m_libEventCV.notify_one();
+    lock.unlock();
+
+    m_libEventWorker.join();
+
+    lock.lock();
+    // Note, not processed events are not needed anymore, since we detach from process.
+    m_libEvents.clear();
 }
 
-void InteropDebuggerHelpers::UnloadLib(const std::string &realLibName)
+void InteropDebuggerHelpers::LibEventWorker()
 {
-    Module module;
-    module.id = ""; // TODO add "The `id` field is an opaque identifier of the library"
-    module.name = GetBasename(realLibName);
-    module.path = realLibName;
-    pProtocol->EmitModuleEvent(ModuleEvent(ModuleRemoved, module));
-    std::uintptr_t startAddr = 0;
-    std::uintptr_t endAddr = 0;
-    if (m_uniqueInteropLibraries->RemoveLibrary(realLibName, startAddr, endAddr))
-    {
-        std::vector<BreakpointEvent> events;
-        m_sharedBreakpoints->InteropUnloadModule(startAddr, endAddr, events);
-        for (const BreakpointEvent &event : events)
-            pProtocol->EmitBreakpointEvent(event);
+    std::unique_lock<std::mutex> lock(m_libEventMutex);
+
+    while (true)
+    {
+        m_libEventCV.wait(lock, [this]() { return m_libEventNeedExit || !m_libEvents.empty(); });
+
+        if (m_libEventNeedExit)
+            break;
+
+        // Take all events at once, so, all libs loaded since last wake up are processed as one batch.
+        std::list<lib_event_t> libEvents;
+        libEvents.swap(m_libEvents);
+        lock.unlock();
+
+        ProcessLibEvents(libEvents);
+
+        lock.lock();
     }
 }
 
+void InteropDebuggerHelpers::ProcessLibEvents(std::list<lib_event_t> &libEvents)
+{
+    std::vector<BreakpointEvent> events;
+    std::vector<std::uintptr_t> libsWithSymbols;
+
+    for (const auto &entry : libEvents)
+    {
+        Module module;
+        module.id = ""; // TODO add "The `id` field is an opaque identifier of the library"
+        module.name = GetBasename(entry.realLibName);
+        module.path = entry.realLibName;
+
+        if (entry.load)
+        {
+            module.baseAddress = entry.startAddr;
+            module.size = entry.endAddr - entry.startAddr;
+            // Note, debug info loading is the most expensive part, executed without m_waitpidMutex lock.
+            m_uniqueInteropLibraries->AddLibrary(entry.libLoadName, entry.realLibName, entry.startAddr, entry.endAddr, module.symbolStatus);
+            if (module.symbolStatus == SymbolStatus::SymbolsLoaded)
+                libsWithSymbols.emplace_back(entry.startAddr);
+
+            pProtocol->EmitModuleEvent(ModuleEvent(ModuleNew, module));
+            continue;
+        }
+
+        pProtocol->EmitModuleEvent(ModuleEvent(ModuleRemoved, module));
+        std::uintptr_t startAddr = 0;
+        std::uintptr_t endAddr = 0;
+        if (m_uniqueInteropLibraries->RemoveLibrary(entry.realLibName, startAddr, endAddr))
+        {
+            FlushUnwindCache(startAddr, endAddr);
+            libsWithSymbols.erase(std::remove(libsWithSymbols.begin(), libsWithSymbols.end(), startAddr), libsWithSymbols.end());
+
+            std::lock_guard<std::mutex> lock(m_waitpidMutex);
+            m_sharedBreakpoints->InteropUnloadModule(startAddr, endAddr, events);
+        }
+    }
+
+    if (!libsWithSymbols.empty())
+    {
+        std::lock_guard<std::mutex> lock(m_waitpidMutex);
+
+        if (m_TGID != 0 && !m_TIDs.empty())
+        {
+            // Debuggee was continued after link map change, so, all threads must be stopped before first breakpoint
+            // insertion. Note, only one stop-all for all resolved breakpoints of whole batch.
+            bool allThreadsWereStopped = false;
+            auto StopAllThreads = [&]() { BrkStopAllThreads(allThreadsWereStopped); };
+            // Note, any traced thread could be used for memory access, all of them will be stopped before access.
+            const pid_t pid = m_TIDs.begin()->first;
+
+            for (std::uintptr_t startAddr : libsWithSymbols)
+            {
+                m_sharedBreakpoints->InteropLoadModule(pid, startAddr, m_uniqueInteropLibraries.get(), events, StopAllThreads);
+            }
+
+            // Continue threads execution with care about stop events (CallbacksQueue).
+            if (allThreadsWereStopped)
+                ParseThreadsChanges();
+        }
+    }
+
+    for (const BreakpointEvent &event : events)
+        pProtocol->EmitBreakpointEvent(event);
+}
+
 static bool AddSignalEventForUserCode(pid_t pid, InteropLibraries *pInteropLibraries, const std::string &signal, thread_status_t &threadStatus)
 {
     // get registers (we need real breakpoint address for check)
@@ -596,7 +725,7 @@ static bool AddSignalEventForCallerInUserCode(pid_t pid, pid_t TGID, InteropLibr
     int frameCount = 0;
     bool isUserDebuggingCode = false;
     std::uintptr_t breakAddr = 0;
-    ThreadStackUnwind(pid, nullptr, [&](std::uintptr_t addr)
+    ThreadStackUnwind(pid, pInteropLibraries, nullptr, [&](std::uintptr_t addr)
     {
         frameCount++;
 
@@ -702,9 +831,8 @@ void InteropDebuggerSignals::Parse_SIGTRAP__NOT_PTRACE_EVENT(pid_t pid)
                     m_TIDs[pid].addrStepOverBreakpointFailed = 0;
                     if (addrStepOverBreakpointFailed == brkAddr)
                     {
-                        StopAllRunningThreads(m_TIDs);
-                        WaitThreadStop(g_waitForAllThreads);
-                        m_sharedBreakpoints->InteropStepOverBrk(pid, brkAddr, [&](pid_t step_pid, std::uintptr_t step_addr) {return SingleStepOnBrk(step_pid, step_addr);});
+                        m_sharedBreakpoints->InteropStepOverBrk(pid, brkAddr, [&]() { StopAllRunningThreads(m_TIDs); WaitThreadStop(g_waitForAllThreads); },
+                                                                [&](pid_t step_pid, std::uintptr_t step_addr) {return SingleStepOnBrk(step_pid, step_addr);});
                         break;
                     }
                 }
@@ -712,16 +840,16 @@ void InteropDebuggerSignals::Parse_SIGTRAP__NOT_PTRACE_EVENT(pid_t pid)
                 if (m_sharedBreakpoints->IsInteropRendezvousBreakpoint(brkAddr))
                 {
                     m_sharedBreakpoints->InteropChangeRendezvousState(m_TGID, pid);
-                    m_sharedBreakpoints->InteropStepOverBrk(pid, brkAddr, [&](pid_t step_pid, std::uintptr_t step_addr) {return SingleStepOnBrk(step_pid, step_addr);});
+                    m_sharedBreakpoints->InteropStepOverBrk(pid, brkAddr, [](){},
+                                                            [&](pid_t step_pid, std::uintptr_t step_addr) {return SingleStepOnBrk(step_pid, step_addr);});
                 }
                 else if (m_sharedBreakpoints->IsInteropBreakpoint(brkAddr))
                 {
                     // Ignore breakpoints during managed evaluation.
-                    if (m_sharedEvalWaiter->GetEvalRunningThreadID() == (DWORD)pid)
+                    if (m_sharedEvalWaiter->IsEvalRunningOnThread((DWORD)pid))
                     {
-                        StopAllRunningThreads(m_TIDs);
-                        WaitThreadStop(g_waitForAllThreads);
-                        m_sharedBreakpoints->InteropStepOverBrk(pid, brkAddr, [&](pid_t step_pid, std::uintptr_t step_addr) {return SingleStepOnBrk(step_pid, step_addr);});
+                        m_sharedBreakpoints->InteropStepOverBrk(pid, brkAddr, [&]() { StopAllRunningThreads(m_TIDs); WaitThreadStop(g_waitForAllThreads); },
+                                                                [&](pid_t step_pid, std::uintptr_t step_addr) {return SingleStepOnBrk(step_pid, step_addr);});
                         break;
                     }
 
@@ -739,6 +867,34 @@ void InteropDebuggerSignals::Parse_SIGTRAP__NOT_PTRACE_EVENT(pid_t pid)
 
                 break;
             }
+            case TRAP_HWBKPT:
+            {
+                std::uintptr_t dataAddr = 0;
+                if (!m_sharedBreakpoints->IsInteropDataBreakpointHit(pid, ptrace_info, dataAddr))
+                    break;
+
+                m_TIDs[pid].stop_signal = 0;
+
+                // Ignore data breakpoints during managed evaluation.
+                if (m_sharedEvalWaiter->IsEvalRunningOnThread((DWORD)pid))
+                {
+                    m_sharedBreakpoints->InteropStepOverDataBreakpoint(pid, [&](pid_t step_pid, std::uintptr_t step_addr) {return SingleStepOnBrk(step_pid, step_addr);});
+                    break;
+                }
+
+                user_regs_struct regs;
+                iovec iov;
+                iov.iov_base = &regs;
+                iov.iov_len = sizeof(user_regs_struct);
+                if (async_ptrace(PTRACE_GETREGSET, pid, (void*)NT_PRSTATUS, &iov) == -1)
+                    LOGW("Ptrace getregset error: %s\n", strerror(errno));
+
+                m_TIDs[pid].stat = thread_stat_e::stopped_data_breakpoint_event_detected;
+                m_TIDs[pid].stop_event_data.addr = GetBreakAddrByPC(regs);
+                m_TIDs[pid].stop_event_data.dataAddr = dataAddr;
+                m_eventedThreads.emplace_back(pid);
+                break;
+            }
             case SI_USER:
             case SI_TKILL:
                 // Care about `raise()` and `kill()` for SIGTRAP in user code.
@@ -823,27 +979,46 @@ void InteropDebuggerBase::ParseThreadsChanges()
     }
 
     // NOTE we use second cycle, since during first (parsing) we may need stop all running threads (for example, in case user breakpoint during eval).
+    PerfCounters::ScopedTime time(interopContinueThreadsTimeCounter);
+
+    // Note, thread could be added into m_changedThreads multiple times.
+    std::unordered_set<pid_t> continueTIDs;
+    std::vector<ptrace_batch_entry_t> requests;
     for (const auto &pid : m_changedThreads)
     {
         if (m_TIDs[pid].stat != thread_stat_e::stopped &&
             m_TIDs[pid].stat != thread_stat_e::stopped_on_event_need_continue)
             continue;
 
-        if (async_ptrace(PTRACE_CONT, pid, nullptr, (void*)((word_t)m_TIDs[pid].stop_signal)) == -1)
-            LOGW("Ptrace cont error: %s", strerror(errno));
+        if (continueTIDs.insert(pid).second)
+            requests.push_back({PTRACE_CONT, pid, nullptr, (void*)((word_t)m_TIDs[pid].stop_signal), 0, 0});
+    }
+
+    m_changedThreads.clear();
+
+    if (!async_ptrace_batch(requests))
+    {
+        LOGE("Ptrace cont error: ptrace thread not running");
+        return;
+    }
+
+    for (const auto &entry : requests)
+    {
+        if (entry.result == -1)
+            LOGW("Ptrace cont error: %s", strerror(entry.error));
         else
         {
-            m_TIDs[pid].stat = thread_stat_e::running;
-            m_TIDs[pid].stop_signal = 0;
+            m_TIDs[entry.pid].stat = thread_stat_e::running;
+            m_TIDs[entry.pid].stop_signal = 0;
         }
     }
-
-    m_changedThreads.clear();
+    interopContinuedThreadsCounter.Add(requests.size());
 }
 
 // Separate thread for callbacks setup in order to make waitpid and CoreCLR debug API work in the same time.
 void InteropDebuggerBase::CallbackEventWorker()
 {
+    TraceRecorder::SetThreadName("InteropCallbackEventWorker");
     std::unique_lock<std::mutex> lock(m_callbackEventMutex);
     m_callbackEventCV.notify_one(); // notify WaitpidWorker(), that thread init complete
 
@@ -854,6 +1029,7 @@ void InteropDebuggerBase::CallbackEventWorker()
         if (m_callbackEventNeedExit)
             break;
 
+        TraceRecorder::ScopedEvent traceEvent("interop", "CallbackEvents");
         // m_sharedCallbacksQueue's wrapper that care about m_callbacksMutex lock before code execution in lambda.
         m_sharedCallbacksQueue->AddInteropCallbackToQueue([&]()
         {
@@ -883,6 +1059,18 @@ void InteropDebuggerBase::CallbackEventWorker()
                            find->second.stat = thread_stat_e::stopped_signal_event_in_progress;
                     }
                     break;
+                case thread_stat_e::stopped_data_breakpoint_event_detected:
+                    m_sharedCallbacksQueue->EmplaceBackInterop(CallbackQueueCall::InteropDataBreakpoint, entry.pid, entry.stop_event_data.addr, "",
+                                                               entry.stop_event_data.dataAddr);
+                    {
+                        // Important! Lock sequence must be (1)m_callbackEventMutex -> (2)m_waitpidMutex only!
+                        // Important! Lock sequence must be (1)m_callbacksMutex -> (2)m_waitpidMutex only!
+                        std::lock_guard<std::mutex> lock(m_waitpidMutex);
+                        auto find = m_TIDs.find(entry.pid);
+                        if (find != m_TIDs.end())
+                           find->second.stat = thread_stat_e::stopped_data_breakpoint_event_in_progress;
+                    }
+                    break;
                 default:
                     LOGW("This event type is not stop event: %d", entry.stat);
                     break;
@@ -920,6 +1108,9 @@ void InteropDebuggerBase::ParseThreadsEvents()
         case thread_stat_e::stopped_signal_event_detected:
             m_callbackEvents.emplace_back(pid, m_TIDs[pid].stat, m_TIDs[pid].stop_event_data);
             break;
+        case thread_stat_e::stopped_data_breakpoint_event_detected:
+            m_callbackEvents.emplace_back(pid, m_TIDs[pid].stat, m_TIDs[pid].stop_event_data);
+            break;
         default:
             LOGW("This event type is not stop event: %d", m_TIDs[pid].stat);
             break;
@@ -945,14 +1136,21 @@ void InteropDebugger::ContinueAllThreadsWithEvents()
         switch (tid.second.stat)
         {
         case thread_stat_e::stopped_breakpoint_event_in_progress:
-            BrkStopAllThreads(allThreadsWereStopped);
-            m_sharedBreakpoints->InteropStepOverBrk(tid.first, tid.second.stop_event_data.addr, 
+            m_sharedBreakpoints->InteropStepOverBrk(tid.first, tid.second.stop_event_data.addr,
+                                                    [&]() { BrkStopAllThreads(allThreadsWereStopped); },
                                                     [&](pid_t step_pid, std::uintptr_t step_addr) {return SingleStepOnBrk(step_pid, step_addr);});
             break;
         case thread_stat_e::stopped_signal_event_in_progress:
             tid.second.stat = thread_stat_e::stopped_on_event_need_continue;
             m_changedThreads.emplace_back(tid.first);
             break;
+        case thread_stat_e::stopped_data_breakpoint_event_in_progress:
+            tid.second.stat = thread_stat_e::stopped;
+            tid.second.stop_signal = 0;
+            m_changedThreads.emplace_back(tid.first);
+            // Note, we don't need stop all threads here, since only this thread watchpoints are changed during step over.
+            m_sharedBreakpoints->InteropStepOverDataBreakpoint(tid.first, [&](pid_t step_pid, std::uintptr_t step_addr) {return SingleStepOnBrk(step_pid, step_addr);});
+            break;
         case thread_stat_e::stopped_on_event_as_native_thread:
             tid.second.stat = thread_stat_e::stopped;
             tid.second.stop_signal = 0;
@@ -1116,7 +1314,7 @@ HRESULT InteropDebugger::StopAllNativeThreads(ICorDebugProcess *pProcess)
 
         bool skipThread = false;
         bool reachedStopFrames = false;
-        ThreadStackUnwind(nativeThread.first, nullptr, [&](std::uintptr_t addr)
+        ThreadStackUnwind(nativeThread.first, m_uniqueInteropLibraries.get(), nullptr, [&](std::uintptr_t addr)
         {
 #if defined(DEBUGGER_UNIX_ARM)
             addr = addr & ~((std::uintptr_t)1); // convert to proper (even) address (debug info use only even addresses)
@@ -1159,6 +1357,7 @@ void InteropDebuggerBase::InitWaitpidWorkerThread()
 
 void InteropDebuggerBase::WaitpidWorker()
 {
+    TraceRecorder::SetThreadName("WaitpidWorker");
     std::unique_lock<std::mutex> lockEvent(m_callbackEventMutex);
     m_callbackEventNeedExit = false;
     m_callbackEventWorker = std::thread(&InteropDebuggerBase::CallbackEventWorker, this);
@@ -1265,8 +1464,52 @@ void InteropDebuggerBase::WaitpidWorker()
             }
         }
 
+        // Signals, that are not used by debugger, are handled by policy directly here, without threads changes parsing
+        // (done only when waitpid have no changes) and callbacks queue round-trip, so, debuggee that use signals intensively
+        // (timers, SIGCHLD, SIGPIPE) is not slowed down. Note, only running thread signal could be handled in this way,
+        // threads stopped by debugger (or with not parsed yet stop) must be processed by common logic.
+        SignalAction signalAction;
+        auto findTID = m_TIDs.find(pid);
+        if (findTID != m_TIDs.end() && findTID->second.stat == thread_stat_e::running &&
+            ((unsigned)status >> 16) == 0 && // not ptrace event
+            m_signalPolicy.Get((int)stop_signal, signalAction))
+        {
+            if (signalAction == SignalAction::Stop)
+            {
+                user_regs_struct regs;
+                iovec iov;
+                iov.iov_base = &regs;
+                iov.iov_len = sizeof(user_regs_struct);
+                if (async_ptrace(PTRACE_GETREGSET, pid, (void*)NT_PRSTATUS, &iov) != -1)
+                {
+                    // Note, signal is kept in `stop_signal` and delivered at continue (see ContinueAllThreadsWithEvents()).
+                    findTID->second.stat = thread_stat_e::stopped_signal_event_detected;
+                    findTID->second.stop_signal = stop_signal;
+                    findTID->second.event = 0;
+                    findTID->second.stop_event_data.addr = GetBreakAddrByPC(regs);
+                    findTID->second.stop_event_data.signal = SignalPolicy::GetSignalName((int)stop_signal);
+                    m_eventedThreads.emplace_back(pid);
+                    continue;
+                }
+                LOGW("Ptrace getregset error: %s\n", strerror(errno));
+            }
+            else if (signalAction == SignalAction::Print)
+            {
+                pProtocol->EmitOutputEvent(OutputConsole, "Thread " + std::to_string(pid) + " received signal " +
+                                                          SignalPolicy::GetSignalName((int)stop_signal) + "\n");
+            }
+
+            if (async_ptrace(PTRACE_CONT, pid, nullptr, (void*)((word_t)stop_signal)) == -1)
+                LOGW("Ptrace cont error: %s", strerror(errno));
+            interopPassedSignalsCounter.Add(1);
+            continue;
+        }
+
         if (m_TIDs.find(pid) == m_TIDs.end())
+        {
             pProtocol->EmitThreadEvent(ThreadEvent(NativeThreadStarted, ThreadId(pid), true));
+            m_sharedBreakpoints->InteropSetupDataBreakpoints(pid);
+        }
 
         m_TIDs[pid].stat = thread_stat_e::stopped; // if we here, this mean we get some stop signal for this thread
         m_TIDs[pid].stop_signal = stop_signal;
@@ -1298,6 +1541,11 @@ HRESULT InteropDebugger::Init(pid_t pid, std::shared_ptr<CallbacksQueue> &shared
     {
         // Note, we could attach and interrupt some threads already, must be detached first.
         StopAndDetach(pid);
+        {
+            // Note, lib events worker was not started yet, drop events queued by rendezvous setup.
+            std::lock_guard<std::mutex> lockLibEvent(m_libEventMutex);
+            m_libEvents.clear();
+        }
         GetWaitpid().SetInteropWaitpidMode(false);
         m_waitpidThreadStatus = WaitpidThreadStatus::UNKNOWN;
         async_ptrace_shutdown();
@@ -1326,6 +1574,9 @@ HRESULT InteropDebugger::Init(pid_t pid, std::shared_ptr<CallbacksQueue> &shared
     if (!m_sharedBreakpoints->InteropSetupRendezvousBrk(pid, loadLib, unloadLib, isThumbCode, error_n))
         return ExitWithError();
 
+    // Note, all already loaded libs queued at rendezvous setup, will be processed as first batch.
+    InitLibEventWorkerThread();
+
     // At this point all threads are stopped, continue execution for all not event-related stopped threads.
     ParseThreadsChanges();
 
@@ -1383,6 +1634,16 @@ void InteropDebuggerHelpers::BrkFixAllThreads(std::uintptr_t checkAddr)
     }
 }
 
+// Note, all threads must be stopped, since debug registers could be changed for stopped threads only.
+void InteropDebuggerHelpers::BrkSetAllThreadsWatchpoints(const std::vector<hw_watchpoint_t> &slots)
+{
+    for (const auto &entry : m_TIDs)
+    {
+        // Will hope, in case of error thread already exited (error logged by SetHWWatchpoints()).
+        SetHWWatchpoints(entry.first, slots);
+    }
+}
+
 HRESULT InteropDebugger::SetLineBreakpoints(const std::string& filename, const std::vector<LineBreakpoint> &lineBreakpoints, std::vector<Breakpoint> &breakpoints)
 {
     std::lock_guard<std::mutex> lock(m_waitpidMutex);
@@ -1399,6 +1660,22 @@ HRESULT InteropDebugger::SetLineBreakpoints(const std::string& filename, const s
     return Status;
 }
 
+HRESULT InteropDebugger::SetDataBreakpoints(const std::vector<DataBreakpoint> &dataBreakpoints, std::vector<Breakpoint> &breakpoints)
+{
+    std::lock_guard<std::mutex> lock(m_waitpidMutex);
+
+    bool allThreadsWereStopped = false;
+    auto StopAllThreads = [&]() { BrkStopAllThreads(allThreadsWereStopped); };
+    auto SetAllThreads = [&](const std::vector<hw_watchpoint_t> &slots) { BrkSetAllThreadsWatchpoints(slots); };
+    HRESULT Status = m_sharedBreakpoints->InteropSetDataBreakpoints(m_TGID, dataBreakpoints, breakpoints, StopAllThreads, SetAllThreads);
+
+    // Continue threads execution with care about stop events (CallbacksQueue).
+    if (allThreadsWereStopped)
+        ParseThreadsChanges();
+
+    return Status;
+}
+
 HRESULT InteropDebugger::AllBreakpointsActivate(bool act)
 {
     std::lock_guard<std::mutex> lock(m_waitpidMutex);
@@ -1406,7 +1683,8 @@ HRESULT InteropDebugger::AllBreakpointsActivate(bool act)
     bool allThreadsWereStopped = false;
     auto StopAllThreads = [&]() { BrkStopAllThreads(allThreadsWereStopped); };
     auto FixAllThreads = [&](std::uintptr_t checkAddr) { BrkFixAllThreads(checkAddr); };
-    HRESULT Status = m_sharedBreakpoints->InteropAllBreakpointsActivate(m_TGID, act, StopAllThreads, FixAllThreads);
+    auto SetAllThreads = [&](const std::vector<hw_watchpoint_t> &slots) { BrkSetAllThreadsWatchpoints(slots); };
+    HRESULT Status = m_sharedBreakpoints->InteropAllBreakpointsActivate(m_TGID, act, StopAllThreads, FixAllThreads, SetAllThreads);
 
     // Continue threads execution with care about stop events (CallbacksQueue).
     if (allThreadsWereStopped)
@@ -1422,7 +1700,8 @@ HRESULT InteropDebugger::BreakpointActivate(uint32_t id, bool act)
     bool allThreadsWereStopped = false;
     auto StopAllThreads = [&]() { BrkStopAllThreads(allThreadsWereStopped); };
     auto FixAllThreads = [&](std::uintptr_t checkAddr) { BrkFixAllThreads(checkAddr); };
-    HRESULT Status = m_sharedBreakpoints->InteropBreakpointActivate(m_TGID, id, act, StopAllThreads, FixAllThreads);
+    auto SetAllThreads = [&](const std::vector<hw_watchpoint_t> &slots) { BrkSetAllThreadsWatchpoints(slots); };
+    HRESULT Status = m_sharedBreakpoints->InteropBreakpointActivate(m_TGID, id, act, StopAllThreads, FixAllThreads, SetAllThreads);
 
     // Continue threads execution with care about stop events (CallbacksQueue).
     if (allThreadsWereStopped)
@@ -1524,7 +1803,8 @@ static std::array<unw_word_t, UNW_REG_LAST + 1> *InitContextRegs(std::array<unw_
 }
 
 HRESULT InteropDebugger::UnwindNativeFrames(pid_t pid, bool firstFrame, std::uintptr_t endAddr, CONTEXT *pStartContext,
-                                            std::function<HRESULT(NativeFrame &nativeFrame)> nativeFramesCallback)
+                                            std::function<HRESULT(NativeFrame &nativeFrame)> nativeFramesCallback,
+                                            std::function<bool()> frameInfoRequired)
 {
     std::lock_guard<std::mutex> lock(m_waitpidMutex);
 
@@ -1563,7 +1843,7 @@ HRESULT InteropDebugger::UnwindNativeFrames(pid_t pid, bool firstFrame, std::uin
     addrFrames.reserve(maxFrames);
 
     std::array<unw_word_t, UNW_REG_LAST + 1> contextRegs;
-    ThreadStackUnwind(pid, pStartContext ? InitContextRegs(contextRegs, pStartContext) : nullptr, [&](std::uintptr_t addr)
+    ThreadStackUnwind(pid, m_uniqueInteropLibraries.get(), pStartContext ? InitContextRegs(contextRegs, pStartContext) : nullptr, [&](std::uintptr_t addr)
     {
 
 #if defined(DEBUGGER_UNIX_ARM)
@@ -1595,7 +1875,11 @@ HRESULT InteropDebugger::UnwindNativeFrames(pid_t pid, bool firstFrame, std::uin
         std::uintptr_t libStartAddr = 0;
         std::uintptr_t procStartAddr = 0;
         // Note, in case unwind we need info for address that is part of previous (already executed) code for all frames except first.
-        m_uniqueInteropLibraries->FindDataForAddr(firstFrame ? addr : addr - 1, result.libName, libStartAddr, result.procName, procStartAddr, result.fullSourcePath, result.lineNum);
+        // Library name is always required, since it is used for "End" point detection.
+        if (frameInfoRequired && !frameInfoRequired())
+            m_uniqueInteropLibraries->FindLibForAddr(firstFrame ? addr : addr - 1, result.libName, libStartAddr);
+        else
+            m_uniqueInteropLibraries->FindDataForAddr(firstFrame ? addr : addr - 1, result.libName, libStartAddr, result.procName, procStartAddr, result.fullSourcePath, result.lineNum);
         firstFrame = false;
 
         if (endAddr != 0 && !endAddrReached && result.libName.empty())
@@ -1686,19 +1970,96 @@ bool InteropDebugger::IsManagedThreadWasStoppedInNativeCode(pid_t pid)
     return tid->second.stat != thread_stat_e::running;
 }
 
-void InteropDebugger::WalkAllThreads(std::function<void(pid_t, bool)> cb)
+static std::string ReadNativeThreadName(pid_t tgid, pid_t tid)
+{
+    char commFileName[64];
+    snprintf(commFileName, sizeof(commFileName), "/proc/%d/task/%d/comm", tgid, tid);
+
+    std::string name;
+    FILE *commFile = fopen(commFileName, "r");
+    if (commFile == nullptr)
+        return name;
+
+    char buffer[64]; // Note, kernel limit comm by TASK_COMM_LEN (16 bytes).
+    if (fgets(buffer, sizeof(buffer), commFile) != nullptr)
+    {
+        name = buffer;
+        if (!name.empty() && name.back() == '\n')
+            name.pop_back();
+    }
+    fclose(commFile);
+    return name;
+}
+
+void InteropDebugger::WalkAllThreads(std::function<void(pid_t, bool, const std::string&)> cb, bool refreshNames)
 {
     std::lock_guard<std::mutex> lock(m_waitpidMutex);
 
     if (m_TIDs.empty())
         return;
 
-    std::map<pid_t, thread_status_t> orderedTIDs(m_TIDs.begin(), m_TIDs.end());
+    // Note, sort TIDs only, copy of whole threads table is not needed here.
+    std::vector<pid_t> orderedTIDs;
+    orderedTIDs.reserve(m_TIDs.size());
+    for (auto &tid : m_TIDs)
+    {
+        if (refreshNames || !tid.second.nameRead)
+        {
+            tid.second.name = ReadNativeThreadName(m_TGID, tid.first);
+            tid.second.nameRead = true;
+        }
+        orderedTIDs.emplace_back(tid.first);
+    }
+    std::sort(orderedTIDs.begin(), orderedTIDs.end());
+
+    for (pid_t tid : orderedTIDs)
+    {
+        const thread_status_t &status = m_TIDs[tid];
+        cb(tid, status.stat == thread_stat_e::running, status.name);
+    }
+}
+
+HRESULT InteropDebugger::ReadMemory(std::uintptr_t addr, char *buffer, size_t size, size_t &read)
+{
+    // Note, transfer could be partial at iovec granularity only, so, remote iovec is provided for each page, in order
+    // to read all memory till first unreadable page. Up to UIO_MAXIOV pages are read by one syscall.
+    static const size_t MaxIovecs = 1024;
+    static const std::uintptr_t pageSize = (std::uintptr_t)sysconf(_SC_PAGESIZE);
+
+    read = 0;
+    if (m_TGID == 0)
+        return E_FAIL;
 
-    for (auto &tid : orderedTIDs)
+    std::vector<iovec> remoteIovecs;
+    remoteIovecs.reserve(std::min(MaxIovecs, size / pageSize + 2));
+    while (read < size)
     {
-        cb(tid.first, tid.second.stat == thread_stat_e::running);
+        remoteIovecs.clear();
+        std::uintptr_t chunkAddr = addr + read;
+        size_t chunkSize = 0;
+        while (remoteIovecs.size() < MaxIovecs && read + chunkSize < size)
+        {
+            const std::uintptr_t pageEnd = (chunkAddr & ~(pageSize - 1)) + pageSize;
+            const size_t partSize = std::min<size_t>(pageEnd - chunkAddr, size - read - chunkSize);
+            remoteIovecs.push_back({(void*)chunkAddr, partSize});
+            chunkAddr += partSize;
+            chunkSize += partSize;
+        }
+
+        iovec localIovec {buffer + read, chunkSize};
+        const ssize_t result = process_vm_readv(m_TGID, &localIovec, 1, remoteIovecs.data(), remoteIovecs.size(), 0);
+        if (result <= 0)
+            break;
+
+        read += (size_t)result;
+        if ((size_t)result < chunkSize)
+            break;
     }
+
+    if (read > 0)
+        m_sharedBreakpoints->InteropRestoreOriginalData(addr, buffer, read);
+
+    return read > 0 || size == 0 ? S_OK : E_FAIL;
 }
 
 } // namespace InteropDebugging
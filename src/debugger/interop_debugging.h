@@ -17,6 +17,8 @@
 #include <unordered_map>
 #include "interfaces/types.h"
 #include "debugger/frames.h"
+#include "debugger/interop_watchpoint_helpers.h"
+#include "debugger/interop_signal_policy.h"
 
 namespace netcoredbg
 {
@@ -41,6 +43,8 @@ enum class thread_stat_e
     stopped_breakpoint_event_in_progress,
     stopped_signal_event_detected,
     stopped_signal_event_in_progress,
+    stopped_data_breakpoint_event_detected,
+    stopped_data_breakpoint_event_in_progress,
     stopped_on_event_need_continue,
     running
 };
@@ -49,6 +53,7 @@ struct stop_event_data_t
 {
     std::uintptr_t addr = 0;
     std::string signal;
+    std::uintptr_t dataAddr = 0; // watched address for data breakpoint event
 };
 
 struct thread_status_t
@@ -63,6 +68,11 @@ struct thread_status_t
 
     // Data, that should be stored in order to create stop event (CallbacksQueue) and/or continue thread execution.
     stop_event_data_t stop_event_data;
+
+    // Native thread name from `/proc/<pid>/task/<tid>/comm`, read at first threads request only.
+    // Note, entry lifetime is bound to clone/exit ptrace events, so, name is never read twice for same thread.
+    std::string name;
+    bool nameRead = false;
 };
 
 struct callback_event_t
@@ -78,6 +88,23 @@ struct callback_event_t
     {}
 };
 
+struct lib_event_t
+{
+    bool load; // load or unload
+    std::string libLoadName;
+    std::string realLibName;
+    std::uintptr_t startAddr;
+    std::uintptr_t endAddr;
+
+    lib_event_t(bool load_, const std::string &libLoadName_, const std::string &realLibName_, std::uintptr_t startAddr_, std::uintptr_t endAddr_) :
+        load(load_),
+        libLoadName(libLoadName_),
+        realLibName(realLibName_),
+        startAddr(startAddr_),
+        endAddr(endAddr_)
+    {}
+};
+
 class InteropDebuggerBase
 {
 protected:
@@ -127,6 +154,9 @@ protected:
 
     bool m_HWSingleStepSupported = true;
 
+    // Note, table is read by waitpid thread without m_waitpidMutex lock.
+    SignalPolicy m_signalPolicy;
+
     void WaitThreadStop(pid_t stoppedPid, std::vector<pid_t> *stopTreads = nullptr);
     bool SingleStepOnBrk(pid_t pid, std::uintptr_t addr);
     void ParseThreadsEvents();
@@ -163,8 +193,25 @@ protected:
     void LoadLib(pid_t pid, const std::string &libLoadName, const std::string &realLibName, std::uintptr_t startAddr, std::uintptr_t endAddr);
     void UnloadLib(const std::string &realLibName);
 
+    // Libs load/unload events from rendezvous breakpoint are processed by separate thread in batches, so, debuggee could
+    // continue execution right after link map changes detected. Debug info loading and native breakpoints resolve could
+    // take a lot of time (for example, plugin host that load hundreds of libs at start). Note, this mean breakpoint in code
+    // executed right after lib load (for example, lib's constructors) could be resolved too late.
+    // Important! Lock sequence must be (1)m_waitpidMutex -> (2)m_libEventMutex only!
+    std::mutex m_libEventMutex;
+    std::thread m_libEventWorker;
+    bool m_libEventNeedExit = false;
+    std::condition_variable m_libEventCV;
+    std::list<lib_event_t> m_libEvents;
+
+    void InitLibEventWorkerThread();
+    void ShutdownLibEventWorkerThread();
+    void LibEventWorker();
+    void ProcessLibEvents(std::list<lib_event_t> &libEvents);
+
     void BrkStopAllThreads(bool &allThreadsWereStopped);
     void BrkFixAllThreads(std::uintptr_t checkAddr);
+    void BrkSetAllThreadsWatchpoints(const std::vector<hw_watchpoint_t> &slots);
 };
 
 class InteropDebugger final : InteropDebuggerHelpers
@@ -184,15 +231,26 @@ public:
     void ContinueAllThreadsWithEvents();
     HRESULT StopAllNativeThreads(ICorDebugProcess *pProcess);
     HRESULT SetLineBreakpoints(const std::string& filename, const std::vector<LineBreakpoint> &lineBreakpoints, std::vector<Breakpoint> &breakpoints);
+    HRESULT SetDataBreakpoints(const std::vector<DataBreakpoint> &dataBreakpoints, std::vector<Breakpoint> &breakpoints);
     HRESULT AllBreakpointsActivate(bool act);
     HRESULT BreakpointActivate(uint32_t id, bool act);
 
     HRESULT GetFrameForAddr(std::uintptr_t addr, StackFrame &frame);
+    // Note, `frameInfoRequired` (if provided) called before each frame symbolization, in case it return `false`, callback
+    // get frame with library name only (frame will be skipped by caller, for example, frame is out of requested stack trace range).
     HRESULT UnwindNativeFrames(pid_t pid, bool firstFrame, std::uintptr_t endAddr, CONTEXT *pStartContext,
-                               std::function<HRESULT(NativeFrame &nativeFrame)> nativeFramesCallback);
+                               std::function<HRESULT(NativeFrame &nativeFrame)> nativeFramesCallback,
+                               std::function<bool()> frameInfoRequired = nullptr);
+
+    // Return false in case signal can't be configured (used by debugger itself).
+    bool SetSignalAction(int signal, SignalAction action) { return m_signalPolicy.Set(signal, action); }
 
     bool IsManagedThreadWasStoppedInNativeCode(pid_t pid);
-    void WalkAllThreads(std::function<void(pid_t, bool)> cb);
+    // Walk all native threads ordered by TID, provide thread running status and native thread name.
+    // In case `refreshNames` is true, names of all threads are re-read (thread name could be changed by thread itself).
+    void WalkAllThreads(std::function<void(pid_t, bool, const std::string&)> cb, bool refreshNames);
+    // Read debuggee memory, read stop at first unreadable page. Native breakpoints opcodes are replaced by original code.
+    HRESULT ReadMemory(std::uintptr_t addr, char *buffer, size_t size, size_t &read);
 };
 
 } // namespace InteropDebugging
@@ -0,0 +1,483 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/interop_displaced_step_helpers.h"
+#include <string.h>
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+
+namespace
+{
+    // AMD64 opcode flags.
+    const uint16_t opNone        = 0;
+    const uint16_t opModRM       = 1 << 0;
+    const uint16_t opImm8        = 1 << 1;
+    const uint16_t opImm16       = 1 << 2;
+    const uint16_t opImmZ        = 1 << 3; // 16 or 32 bits, depends on operand size
+    const uint16_t opImmV        = 1 << 4; // 16, 32 or 64 bits, depends on operand size
+    const uint16_t opMoffs       = 1 << 5; // 32 or 64 bits, depends on address size
+    const uint16_t opRel         = 1 << 6; // immediate is relative branch offset
+    const uint16_t opCall        = 1 << 7; // push return address
+    const uint16_t opGroup       = 1 << 8; // instruction depends on ModRM.reg
+    const uint16_t opUnsupported = 1 << 15;
+
+    uint16_t AMD64_OneByteOpcodeFlags(uint8_t op)
+    {
+        if (op < 0x40)
+        {
+            switch (op & 0x7)
+            {
+                case 0: case 1: case 2: case 3: return opModRM;
+                case 4: return opImm8;
+                case 5: return opImmZ;
+                default: return opUnsupported; // invalid in 64-bit mode or prefixes (handled by caller)
+            }
+        }
+
+        if (op < 0x60) // 0x40-0x4F REX prefixes (handled by caller), 0x50-0x5F push/pop
+            return opNone;
+        if (op >= 0x70 && op <= 0x7F) // jcc rel8
+            return opImm8 | opRel;
+        if (op >= 0x84 && op <= 0x8E)
+            return opModRM;
+        if (op >= 0x90 && op <= 0x9F)
+            return op == 0x9A ? opUnsupported : opNone;
+        if (op >= 0xA0 && op <= 0xA3)
+            return opMoffs;
+        if (op >= 0xA4 && op <= 0xAF)
+            return op == 0xA8 ? opImm8 : (op == 0xA9 ? opImmZ : opNone);
+        if (op >= 0xB0 && op <= 0xB7)
+            return opImm8;
+        if (op >= 0xB8 && op <= 0xBF)
+            return opImmV;
+        if (op >= 0xD8 && op <= 0xDF) // x87
+            return opModRM;
+        if (op >= 0xE0 && op <= 0xE3) // loop, jrcxz
+            return opImm8 | opRel;
+        if (op >= 0xE4 && op <= 0xE7)
+            return opImm8;
+        if (op >= 0xEC && op <= 0xEF)
+            return opNone;
+        if (op >= 0xF8 && op <= 0xFD)
+            return opNone;
+
+        switch (op)
+        {
+            case 0x63: return opModRM;
+            case 0x68: return opImmZ;
+            case 0x69: return opModRM | opImmZ;
+            case 0x6A: return opImm8;
+            case 0x6B: return opModRM | opImm8;
+            case 0x6C: case 0x6D: case 0x6E: case 0x6F: return opNone;
+            case 0x80: return opModRM | opImm8;
+            case 0x81: return opModRM | opImmZ;
+            case 0x83: return opModRM | opImm8;
+            case 0x8F: return opModRM | opGroup;
+            case 0xC0: case 0xC1: return opModRM | opImm8;
+            case 0xC2: return opImm16; // ret imm16
+            case 0xC3: return opNone;  // ret
+            case 0xC6: return opModRM | opImm8;
+            case 0xC7: return opModRM | opImmZ | opGroup;
+            case 0xC8: return opImm16 | opImm8;
+            case 0xC9: return opNone;
+            case 0xCD: return opImm8;
+            case 0xD0: case 0xD1: case 0xD2: case 0xD3: return opModRM;
+            case 0xD7: return opNone;
+            case 0xE8: return opImmZ | opRel | opCall;
+            case 0xE9: return opImmZ | opRel;
+            case 0xEB: return opImm8 | opRel;
+            case 0xF4: case 0xF5: return opNone;
+            case 0xF6: case 0xF7: return opModRM | opGroup;
+            case 0xFE: return opModRM;
+            case 0xFF: return opModRM | opGroup;
+            default: return opUnsupported; // invalid in 64-bit mode, far branches, int3, iret...
+        }
+    }
+
+    uint16_t AMD64_TwoByteOpcodeFlags(uint8_t op)
+    {
+        if ((op >= 0x10 && op <= 0x23) || (op >= 0x28 && op <= 0x2F) || (op >= 0x40 && op <= 0x6F) ||
+            (op >= 0x90 && op <= 0x9F) || (op >= 0xB0 && op <= 0xB9) || (op >= 0xBB && op <= 0xC1) || op >= 0xD0)
+            return opModRM;
+        if (op >= 0x70 && op <= 0x73)
+            return opModRM | opImm8;
+        if (op >= 0x80 && op <= 0x8F) // jcc rel32
+            return opImmZ | opRel;
+        if (op >= 0xC8 && op <= 0xCF) // bswap
+            return opNone;
+
+        switch (op)
+        {
+            case 0x00: case 0x01: case 0x02: case 0x03: case 0x0D: return opModRM;
+            case 0x05: case 0x06: case 0x07: case 0x08: case 0x09: case 0x0E: return opNone;
+            case 0x30: case 0x31: case 0x32: case 0x33: case 0x34: case 0x35: case 0x37: return opNone;
+            case 0x74: case 0x75: case 0x76: case 0x78: case 0x79: case 0x7C: case 0x7D: case 0x7E: case 0x7F: return opModRM;
+            case 0x77: return opNone;
+            case 0xA0: case 0xA1: case 0xA2: case 0xA8: case 0xA9: case 0xAA: return opNone;
+            case 0xA3: case 0xA5: case 0xAB: case 0xAD: case 0xAE: case 0xAF: return opModRM;
+            case 0xA4: case 0xAC: case 0xBA: case 0xC2: case 0xC4: case 0xC5: case 0xC6: return opModRM | opImm8;
+            case 0xC3: case 0xC7: return opModRM;
+            default: return opUnsupported; // ud2, 3DNow!, invalid opcodes
+        }
+    }
+
+    // VEX/EVEX encoded instruction, have ModRM (except `vzeroupper`/`vzeroall`).
+    uint16_t AMD64_VexOpcodeFlags(unsigned map, uint8_t op)
+    {
+        switch (map)
+        {
+            case 1:
+                if (op == 0x77)
+                    return opNone;
+                if ((op >= 0x70 && op <= 0x73) || op == 0xC2 || op == 0xC4 || op == 0xC5 || op == 0xC6)
+                    return opModRM | opImm8;
+                return opModRM;
+            case 2:
+                return opModRM;
+            case 3:
+                return opModRM | opImm8;
+            default:
+                return opUnsupported;
+        }
+    }
+
+    int64_t SignExtend(uint64_t value, unsigned bits)
+    {
+        uint64_t mask = uint64_t(1) << (bits - 1);
+        value &= (uint64_t(1) << bits) - 1;
+        return int64_t((value ^ mask) - mask);
+    }
+
+} // unnamed namespace
+
+bool AMD64_PrepareDisplacedInsn(const uint8_t *insn, size_t size, amd64_displaced_insn_t &displaced)
+{
+    if (size > AMD64_MaxInsnSize)
+        size = AMD64_MaxInsnSize;
+
+    size_t i = 0;
+    bool opSize16 = false;
+    bool addrSize32 = false;
+    bool legacySIMDPrefix = false; // 66, F2, F3 (not allowed with VEX/EVEX)
+
+    // Legacy prefixes.
+    for (; i < size; i++)
+    {
+        uint8_t prefix = insn[i];
+        if (prefix == 0x66)
+        {
+            opSize16 = true;
+            legacySIMDPrefix = true;
+        }
+        else if (prefix == 0x67)
+            addrSize32 = true;
+        else if (prefix == 0xF2 || prefix == 0xF3)
+            legacySIMDPrefix = true;
+        else if (prefix != 0xF0 && prefix != 0x2E && prefix != 0x36 && prefix != 0x3E && prefix != 0x26 && prefix != 0x64 && prefix != 0x65)
+            break;
+    }
+
+    // REX prefix, must be right before opcode.
+    int rexOffset = -1;
+    bool rexW = false;
+    if (i < size && (insn[i] & 0xF0) == 0x40)
+    {
+        rexOffset = (int)i;
+        rexW = (insn[i] & 0x8) != 0;
+        i++;
+    }
+
+    if (i >= size)
+        return false;
+
+    int vexBOffset = -1; // byte with inverted B bit (bit 5) of VEX/EVEX prefix
+    int vvvv = -1;
+    uint16_t flags = opUnsupported;
+    bool cmpxchg8b16b = false;
+    uint8_t op = insn[i];
+
+    if (op == 0xC4 || op == 0xC5 || op == 0x62)
+    {
+        if (rexOffset != -1 || legacySIMDPrefix)
+            return false;
+
+        unsigned map = 1;
+        if (op == 0xC5)
+        {
+            if (i + 2 >= size)
+                return false;
+            vvvv = (~insn[i + 1] >> 3) & 0xF;
+            i += 2;
+        }
+        else if (op == 0xC4)
+        {
+            if (i + 3 >= size)
+                return false;
+            vexBOffset = (int)i + 1;
+            map = insn[i + 1] & 0x1F;
+            rexW = (insn[i + 2] & 0x80) != 0;
+            vvvv = (~insn[i + 2] >> 3) & 0xF;
+            i += 3;
+        }
+        else // EVEX
+        {
+            if (i + 4 >= size)
+                return false;
+            // Note, P0 bit 3 and P1 bit 2 have fixed values, other values are not EVEX (for example, APX extensions).
+            if ((insn[i + 1] & 0x08) != 0 || (insn[i + 2] & 0x04) == 0)
+                return false;
+            vexBOffset = (int)i + 1;
+            map = insn[i + 1] & 0x7;
+            rexW = (insn[i + 2] & 0x80) != 0;
+            vvvv = (~insn[i + 2] >> 3) & 0xF;
+            i += 4;
+        }
+
+        op = insn[i];
+        flags = AMD64_VexOpcodeFlags(map, op);
+    }
+    else if (op == 0x0F)
+    {
+        if (i + 1 >= size)
+            return false;
+
+        i++;
+        op = insn[i];
+        if (op == 0x38 || op == 0x3A)
+        {
+            if (i + 1 >= size)
+                return false;
+
+            flags = op == 0x38 ? opModRM : (opModRM | opImm8);
+            i++;
+            op = insn[i];
+        }
+        else
+        {
+            flags = AMD64_TwoByteOpcodeFlags(op);
+            cmpxchg8b16b = op == 0xC7;
+        }
+    }
+    else
+    {
+        flags = AMD64_OneByteOpcodeFlags(op);
+    }
+
+    if (flags & opUnsupported)
+        return false;
+
+    i++; // opcode
+
+    int modrmOffset = -1;
+    bool ripRelative = false;
+    if (flags & opModRM)
+    {
+        if (i >= size)
+            return false;
+
+        modrmOffset = (int)i;
+        uint8_t modrm = insn[i];
+        uint8_t mod = modrm >> 6;
+        uint8_t reg = (modrm >> 3) & 0x7;
+        uint8_t rm = modrm & 0x7;
+        i++;
+
+        if (flags & opGroup)
+        {
+            switch (op)
+            {
+                case 0x8F: // pop r/m, other is XOP prefix
+                    if (reg != 0)
+                        return false;
+                    break;
+                case 0xC7: // mov r/m, imm, `C7 F8` is xbegin with relative offset
+                    if (reg != 0)
+                        return false;
+                    break;
+                case 0xF6: // test r/m, imm8
+                    if (reg == 0 || reg == 1)
+                        flags |= opImm8;
+                    break;
+                case 0xF7: // test r/m, imm
+                    if (reg == 0 || reg == 1)
+                        flags |= opImmZ;
+                    break;
+                case 0xFF:
+                    if (reg == 2) // call r/m
+                        flags |= opCall;
+                    else if (reg == 3 || reg == 5 || reg == 7) // far call/jmp
+                        return false;
+                    break;
+            }
+        }
+
+        if (mod != 3)
+        {
+            if (rm == 4) // SIB
+            {
+                if (i >= size)
+                    return false;
+                uint8_t base = insn[i] & 0x7;
+                i++;
+                if (mod == 0 && base == 5)
+                    i += 4;
+            }
+            else if (mod == 0 && rm == 5)
+            {
+                ripRelative = true;
+                i += 4;
+            }
+
+            if (mod == 1)
+                i += 1;
+            else if (mod == 2)
+                i += 4;
+        }
+
+        // Note, 32-bit address size with RIP-relative operand use EIP (result truncated to 32 bits).
+        if (ripRelative && addrSize32)
+            return false;
+    }
+
+    // Relative branch offset size with operand size prefix is CPU vendor specific.
+    if ((flags & opRel) && (flags & opImmZ) && opSize16)
+        return false;
+
+    if (flags & opImm8)
+        i += 1;
+    if (flags & opImm16)
+        i += 2;
+    if (flags & opImmZ)
+        i += opSize16 ? 2 : 4;
+    if (flags & opImmV)
+        i += rexW ? 8 : (opSize16 ? 2 : 4);
+    if (flags & opMoffs)
+        i += addrSize32 ? 4 : 8;
+
+    if (i > size)
+        return false;
+
+    displaced.length = i;
+    memcpy(displaced.code, insn, i);
+    displaced.ripReg = -1;
+    displaced.relativeBranch = (flags & opRel) != 0;
+    displaced.returnAddress = (flags & opCall) != 0;
+
+    if (!ripRelative)
+        return true;
+
+    // Replace RIP-relative operand by base register + disp32 (same displacement), base register will have original RIP value.
+    // Don't use RAX, RCX and RDX (implicit operands for many instructions), RSP and registers used by instruction itself.
+    unsigned usedRegs = (1 << 0) | (1 << 1) | (1 << 2) | (1 << 4);
+    usedRegs |= 1 << ((insn[modrmOffset] >> 3) & 0x7);
+    if (vvvv != -1)
+        usedRegs |= 1 << (vvvv & 0x7);
+    if (cmpxchg8b16b)
+        usedRegs |= 1 << 3; // RBX is implicit operand
+
+    for (int reg = 3; reg < 8; reg++)
+    {
+        if (usedRegs & (1 << reg))
+            continue;
+
+        displaced.ripReg = reg;
+        break;
+    }
+    if (displaced.ripReg == -1)
+        return false;
+
+    // mod = 10 (base + disp32), rm = base register, REX.B/VEX.B/EVEX.B must be 0 (for EVEX/VEX B bit is inverted).
+    displaced.code[modrmOffset] = (uint8_t)(0x80 | (insn[modrmOffset] & 0x38) | displaced.ripReg);
+    if (vexBOffset != -1)
+        displaced.code[vexBOffset] |= 0x20;
+    else if (rexOffset != -1)
+        displaced.code[rexOffset] &= ~0x01;
+
+    return true;
+}
+
+bool ARM64_PrepareDisplacedInsn(uint32_t insn, std::uintptr_t addr, arm64_displaced_insn_t &displaced)
+{
+    displaced = arm64_displaced_insn_t();
+
+    // B, BL
+    if ((insn & 0x7C000000) == 0x14000000)
+    {
+        displaced.type = arm64_displaced_e::Branch;
+        displaced.target = addr + SignExtend(insn & 0x3FFFFFF, 26) * 4;
+        displaced.link = (insn & 0x80000000) != 0;
+        return true;
+    }
+
+    // B.cond, BC.cond, CBZ, CBNZ (imm19 offset)
+    if ((insn & 0xFF000000) == 0x54000000 || (insn & 0x7E000000) == 0x34000000)
+    {
+        displaced.type = arm64_displaced_e::CondBranch;
+        displaced.target = addr + SignExtend((insn >> 5) & 0x7FFFF, 19) * 4;
+        displaced.code = (insn & ~(uint32_t(0x7FFFF) << 5)) | (2 << 5);
+        return true;
+    }
+
+    // TBZ, TBNZ (imm14 offset)
+    if ((insn & 0x7E000000) == 0x36000000)
+    {
+        displaced.type = arm64_displaced_e::CondBranch;
+        displaced.target = addr + SignExtend((insn >> 5) & 0x3FFF, 14) * 4;
+        displaced.code = (insn & ~(uint32_t(0x3FFF) << 5)) | (2 << 5);
+        return true;
+    }
+
+    // ADR, ADRP
+    if ((insn & 0x1F000000) == 0x10000000)
+    {
+        int64_t imm = SignExtend((((insn >> 5) & 0x7FFFF) << 2) | ((insn >> 29) & 0x3), 21);
+        displaced.type = arm64_displaced_e::Adr;
+        displaced.reg = insn & 0x1F;
+        if (insn & 0x80000000)
+            displaced.target = (addr & ~std::uintptr_t(0xFFF)) + imm * 4096;
+        else
+            displaced.target = addr + imm;
+        return true;
+    }
+
+    // LDR (literal), LDRSW (literal), PRFM (literal)
+    if ((insn & 0x3B000000) == 0x18000000)
+    {
+        if (insn & 0x04000000) // SIMD&FP register
+            return false;
+
+        uint32_t opc = insn >> 30;
+        if (opc == 3) // PRFM, just execute NOP
+            return true;
+
+        displaced.type = arm64_displaced_e::LoadLiteral;
+        displaced.target = addr + SignExtend((insn >> 5) & 0x7FFFF, 19) * 4;
+        displaced.reg = insn & 0x1F;
+        displaced.loadSize = opc == 1 ? 8 : 4;
+        displaced.loadSigned = opc == 2;
+        return true;
+    }
+
+    // BR, BLR, RET (including pointer authentication variants)
+    if ((insn & 0xFE000000) == 0xD6000000)
+    {
+        displaced.type = arm64_displaced_e::BranchReg;
+        displaced.code = insn;
+        return true;
+    }
+
+    // Exception generation, only SVC could be executed out-of-line (BRK, HLT, HVC, SMC...).
+    if ((insn & 0xFF000000) == 0xD4000000 && (insn & 0xFFE0001F) != 0xD4000001)
+        return false;
+
+    displaced.type = arm64_displaced_e::Copy;
+    displaced.code = insn;
+    return true;
+}
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
@@ -0,0 +1,60 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Note, instructions analysis for displaced (out-of-line) stepping have no platform dependencies (work with instruction bytes only),
+// so, all architectures code could be compiled and tested on any host.
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+
+    const size_t AMD64_MaxInsnSize = 15;
+
+    struct amd64_displaced_insn_t
+    {
+        uint8_t code[AMD64_MaxInsnSize]; // instruction for scratch buffer
+        size_t length = 0;               // instruction length, same for original and displaced instruction
+        // Register (0-7, ModRM order) used as base instead of RIP for RIP-relative operand, must be set to
+        // original `addr + length` before step and restored after, `-1` in case instruction don't use RIP-relative operand.
+        int ripReg = -1;
+        bool relativeBranch = false;     // PC after step is relative to scratch buffer even if branch was taken
+        bool returnAddress = false;      // call, return address on stack is relative to scratch buffer
+    };
+
+    // Return `false` in case instruction can't be executed out-of-line (unknown or unsupported encoding).
+    bool AMD64_PrepareDisplacedInsn(const uint8_t *insn, size_t size, amd64_displaced_insn_t &displaced);
+
+    const uint32_t ARM64_NopInsn = 0xd503201f;
+
+    enum class arm64_displaced_e
+    {
+        Copy,        // execute `code` in scratch buffer, PC relative to scratch buffer after step
+        BranchReg,   // execute `code` in scratch buffer, PC is absolute address after step (BR, BLR, RET)
+        CondBranch,  // execute `code` with branch to scratch + 8, in case of taken branch PC must be `target`
+        Branch,      // B/BL, PC must be `target` (NOP executed in scratch buffer), for BL X30 must be `addr + 4`
+        Adr,         // ADR/ADRP, `reg` must be `target` (NOP executed in scratch buffer)
+        LoadLiteral  // LDR/LDRSW literal, `reg` must be loaded from `target` (NOP executed in scratch buffer)
+    };
+
+    struct arm64_displaced_insn_t
+    {
+        arm64_displaced_e type = arm64_displaced_e::Copy;
+        uint32_t code = ARM64_NopInsn; // instruction for scratch buffer
+        std::uintptr_t target = 0;
+        unsigned reg = 31;             // `31` for XZR, no register write need
+        bool link = false;
+        unsigned loadSize = 0;         // 4 or 8 bytes
+        bool loadSigned = false;
+    };
+
+    // Return `false` in case instruction can't be executed out-of-line (SIMD literal load, BRK, HLT...).
+    bool ARM64_PrepareDisplacedInsn(uint32_t insn, std::uintptr_t addr, arm64_displaced_insn_t &displaced);
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
@@ -6,11 +6,14 @@
 #include "debugger/interop_ptrace_helpers.h"
 
 #include <sys/uio.h>
+#include <algorithm>
+#include <cstring>
 #include <fcntl.h>
 #include <unistd.h>
 #include <link.h>
 #include "elf++.h"
 #include "utils/limits.h"
+#include "utils/platform.h"
 #include "utils/torelease.h"
 
 
@@ -98,40 +101,14 @@ static bool GetProcData(pid_t pid, std::string &execName, std::uintptr_t &startA
     if (!GetExecName(pid, execName))
         return false;
 
-    char mapFileName[256];
-    snprintf(mapFileName, sizeof(mapFileName), "/proc/%d/task/%d/maps", pid, pid);
-
-    FILE *mapsFile = fopen(mapFileName, "r");
-    if (mapsFile == nullptr)
-    {
-        LOGE("fopen error for %s file: %s\n", mapFileName, strerror(errno));
+    ProcessMaps maps;
+    if (!maps.Refresh(pid, pid))
         return false;
-    }
-
-    char *line = nullptr;
-    size_t lineLen = 0;
-    while (getline(&line, &lineLen, mapsFile) != -1)
-    {
-        void *startAddress, *endAddress, *offset;
-        int devHi, devLo, inode;
-        char moduleName[PATH_MAX];
-
-        if (sscanf(line, "%p-%p %*[-rwxsp] %p %x:%x %d %s\n", &startAddress, &endAddress, &offset, &devHi, &devLo, &inode, moduleName) == 7)
-        {
-            if (inode == 0 || execName != moduleName)
-                continue;
-
-            startAddr = (std::uintptr_t)startAddress;
-            break;
-        }
-    }
-
-    free(line); // Note, we did not allocate this, but as per contract of getline we should free it
-    fclose(mapsFile);
 
+    startAddr = maps.GetFileStartAddr(execName);
     if (startAddr == 0)
     {
-        LOGE("GetProcData error, can't find in %s start address for %s\n", mapFileName, execName.c_str());
+        LOGE("GetProcData error, can't find in /proc/%d/task/%d/maps start address for %s\n", pid, pid, execName.c_str());
         return false;
     }
 
@@ -225,50 +202,248 @@ int GetRendezvousBrkState(pid_t pid, std::uintptr_t rendezvousAddr)
     return rendezvousData.r_state;
 }
 
-std::uintptr_t GetLibEndAddrAndRealName(pid_t TGID, pid_t pid, std::string &realLibName, std::uintptr_t libAddr)
+std::uintptr_t GetProcessEntryAddr(pid_t pid)
 {
-    char mapFileName[256];
-    if (pid)
-        snprintf(mapFileName, sizeof(mapFileName), "/proc/%d/task/%d/maps", TGID, pid);
-    else
-        snprintf(mapFileName, sizeof(mapFileName), "/proc/%d/maps", TGID);
+    char auxvFileName[256];
+    snprintf(auxvFileName, sizeof(auxvFileName), "/proc/%d/auxv", pid);
 
-    FILE *mapsFile = fopen(mapFileName, "r");
-    if (mapsFile == nullptr)
+    FILE *auxvFile = fopen(auxvFileName, "r");
+    if (auxvFile == nullptr)
+    {
+        LOGE("fopen error for %s file: %s\n", auxvFileName, strerror(errno));
         return 0;
+    }
 
-    std::uintptr_t endAddr = 0;
-    assert(realLibName.empty());
+    std::uintptr_t entryAddr = 0;
+    ElfW(auxv_t) auxv;
+    while (fread(&auxv, sizeof(auxv), 1, auxvFile) == 1 && auxv.a_type != AT_NULL)
+    {
+        if (auxv.a_type == AT_ENTRY)
+        {
+            entryAddr = auxv.a_un.a_val;
+            break;
+        }
+    }
 
-    char *line = nullptr;
-    size_t lineLen = 0;
-    while (getline(&line, &lineLen, mapsFile) != -1)
+    fclose(auxvFile);
+    return entryAddr;
+}
+
+namespace
+{
+    std::uintptr_t ParseHex(const char *&ptr, const char *end)
     {
-        void *startAddress, *endAddress, *offset;
-        int devHi, devLo, inode;
-        char moduleName[PATH_MAX];
+        std::uintptr_t result = 0;
+        for (; ptr != end; ++ptr)
+        {
+            char c = *ptr;
+            if (c >= '0' && c <= '9')
+                result = (result << 4) | (c - '0');
+            else if (c >= 'a' && c <= 'f')
+                result = (result << 4) | (c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F')
+                result = (result << 4) | (c - 'A' + 10);
+            else
+                break;
+        }
+        return result;
+    }
 
-        if (sscanf(line, "%p-%p %*[-rwxsp] %p %x:%x %d %s\n", &startAddress, &endAddress, &offset, &devHi, &devLo, &inode, moduleName) == 7)
+    unsigned long long ParseDec(const char *&ptr, const char *end)
+    {
+        unsigned long long result = 0;
+        for (; ptr != end && *ptr >= '0' && *ptr <= '9'; ++ptr)
         {
-            if (inode == 0)
-                continue;
+            result = result * 10 + (*ptr - '0');
+        }
+        return result;
+    }
+
+    void SkipField(const char *&ptr, const char *end)
+    {
+        while (ptr != end && *ptr != ' ')
+            ++ptr;
+        while (ptr != end && *ptr == ' ')
+            ++ptr;
+    }
 
-            if (endAddr != 0 && realLibName != moduleName)
+    bool ReadFile(const char *fileName, std::string &data)
+    {
+        int fd = open(fileName, O_RDONLY);
+        if (fd == -1)
+        {
+            LOGE("open error for %s file: %s\n", fileName, strerror(errno));
+            return false;
+        }
+
+        // Note, procfs files have zero size, read until EOF.
+        const size_t chunkSize = 64 * 1024;
+        data.clear();
+        for (;;)
+        {
+            size_t oldSize = data.size();
+            data.resize(oldSize + chunkSize);
+            ssize_t readSize = read(fd, &data[oldSize], chunkSize);
+            if (readSize == -1 && errno == EINTR)
+            {
+                data.resize(oldSize);
+                continue;
+            }
+            if (readSize <= 0)
+            {
+                data.resize(oldSize);
+                if (readSize == -1)
+                {
+                    LOGE("read error for %s file: %s\n", fileName, strerror(errno));
+                    close(fd);
+                    return false;
+                }
                 break;
+            }
+            data.resize(oldSize + readSize);
+        }
+
+        close(fd);
+        return true;
+    }
+
+} // unnamed namespace
+
+bool ProcessMaps::Refresh(pid_t TGID, pid_t pid)
+{
+    m_entries.clear();
+
+    char mapFileName[256];
+    if (pid)
+        snprintf(mapFileName, sizeof(mapFileName), "/proc/%d/task/%d/maps", TGID, pid);
+    else
+        snprintf(mapFileName, sizeof(mapFileName), "/proc/%d/maps", TGID);
 
-            if ((std::uintptr_t)startAddress == libAddr)
-                realLibName = moduleName;
+    std::string data;
+    if (!ReadFile(mapFileName, data))
+        return false;
+
+    // Line format: "start-end perms offset dev inode pathname", for example:
+    // 7f2c1a200000-7f2c1a222000 r--p 00000000 08:01 1234567    /usr/lib/x86_64-linux-gnu/libc.so.6
+    const char *ptr = data.data();
+    const char *dataEnd = ptr + data.size();
+    while (ptr != dataEnd)
+    {
+        const char *lineEnd = static_cast<const char*>(memchr(ptr, '\n', dataEnd - ptr));
+        if (lineEnd == nullptr)
+            lineEnd = dataEnd;
 
-            if (!realLibName.empty())
-                endAddr = (std::uintptr_t)endAddress;
+        std::uintptr_t startAddr = ParseHex(ptr, lineEnd);
+        if (ptr != lineEnd && *ptr == '-')
+        {
+            ++ptr;
+            std::uintptr_t endAddr = ParseHex(ptr, lineEnd);
+            SkipField(ptr, lineEnd); // end address
+            SkipField(ptr, lineEnd); // perms
+            SkipField(ptr, lineEnd); // offset
+            SkipField(ptr, lineEnd); // dev
+            unsigned long long inode = ParseDec(ptr, lineEnd);
+            while (ptr != lineEnd && *ptr == ' ')
+                ++ptr;
+
+            // Note, anonymous mappings, heap, stack and vdso have zero inode.
+            if (inode != 0 && ptr != lineEnd)
+                m_entries.emplace_back(startAddr, endAddr, std::string(ptr, lineEnd));
         }
+
+        ptr = lineEnd == dataEnd ? dataEnd : lineEnd + 1;
     }
 
-    free(line); // Note, we did not allocate this, but as per contract of getline we should free it
-    fclose(mapsFile);
+    return true;
+}
+
+void ProcessMaps::Clear()
+{
+    m_entries.clear();
+}
+
+std::uintptr_t ProcessMaps::GetLibEndAddrAndRealName(std::uintptr_t libAddr, std::string &realLibName) const
+{
+    assert(realLibName.empty());
+
+    // Note, kernel provide mappings sorted by address.
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), libAddr,
+                               [](const map_entry_t &entry, std::uintptr_t addr) { return entry.startAddr < addr; });
+    if (it == m_entries.end() || it->startAddr != libAddr)
+        return 0;
+
+    realLibName = it->name;
+    std::uintptr_t endAddr = it->endAddr;
+    // All file mappings (segments) of library follow each other, anonymous mappings between them (.bss) are ignored.
+    for (++it; it != m_entries.end() && it->name == realLibName; ++it)
+    {
+        endAddr = it->endAddr;
+    }
 
     return endAddr;
 }
 
+std::uintptr_t ProcessMaps::GetFileStartAddr(const std::string &fileName) const
+{
+    for (auto &entry : m_entries)
+    {
+        if (entry.name == fileName)
+            return entry.startAddr;
+    }
+    return 0;
+}
+
+const size_t RemoteMemoryCache::MaxPages;
+
+RemoteMemoryCache::RemoteMemoryCache(pid_t pid) :
+    m_pid(pid),
+    m_pageSize(OSPageSize())
+{
+}
+
+void RemoteMemoryCache::Clear()
+{
+    m_pages.clear();
+}
+
+const char *RemoteMemoryCache::GetPage(std::uintptr_t pageAddr)
+{
+    auto find = m_pages.find(pageAddr);
+    if (find != m_pages.end())
+        return find->second.get();
+
+    if (m_pages.size() >= MaxPages)
+        m_pages.clear();
+
+    std::unique_ptr<char[]> page(new char[m_pageSize]);
+    iovec local_iov {page.get(), m_pageSize};
+    iovec remote_iov {(void*)pageAddr, m_pageSize};
+    // Note, page could be partially read only in case of error, treat it as unreadable.
+    if (process_vm_readv(m_pid, &local_iov, 1, &remote_iov, 1, 0) != (ssize_t)m_pageSize)
+        page.reset();
+
+    return (m_pages[pageAddr] = std::move(page)).get();
+}
+
+bool RemoteMemoryCache::ReadWord(std::uintptr_t addr, word_t &value)
+{
+    char *valuePtr = reinterpret_cast<char*>(&value);
+    size_t copied = 0;
+    // Note, unaligned word could cross page boundary.
+    while (copied < sizeof(word_t))
+    {
+        std::uintptr_t pageAddr = (addr + copied) & ~(m_pageSize - 1);
+        const char *page = GetPage(pageAddr);
+        if (page == nullptr)
+            return false;
+
+        std::uintptr_t pageOffset = addr + copied - pageAddr;
+        size_t size = std::min(sizeof(word_t) - copied, (size_t)(m_pageSize - pageOffset));
+        memcpy(valuePtr + copied, page + pageOffset, size);
+        copied += size;
+    }
+    return true;
+}
+
 } // namespace InteropDebugging
 } // namespace netcoredbg
@@ -6,9 +6,12 @@
 #ifdef INTEROP_DEBUGGING
 
 #include <sys/types.h>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <functional>
+#include "debugger/interop_ptrace_helpers.h"
 
 namespace netcoredbg
 {
@@ -20,8 +23,66 @@ namespace InteropDebugging
     void GetProcessLibs(pid_t pid, std::uintptr_t rendezvousAddr, RendListCallback cb);
     std::uintptr_t GetRendezvousBrkAddr(pid_t pid, std::uintptr_t rendezvousAddr);
     int GetRendezvousBrkState(pid_t pid, std::uintptr_t rendezvousAddr);
+    // Return executable entry point address (code that executed only once at process start), `0` in case of error.
+    std::uintptr_t GetProcessEntryAddr(pid_t pid);
 
-    std::uintptr_t GetLibEndAddrAndRealName(pid_t TGID, pid_t pid, std::string &realLibName, std::uintptr_t libAddr);
+    // Parsed file backed memory mappings of process (/proc/<pid>/maps). Aimed to read and parse maps file once
+    // per rendezvous state change instead of once per each loaded library.
+    class ProcessMaps
+    {
+    public:
+
+        // Re-read maps file, must be called after process mappings changes (rendezvous state changes).
+        // Note, in case `pid` is not `0`, /proc/<TGID>/task/<pid>/maps is used.
+        bool Refresh(pid_t TGID, pid_t pid);
+        void Clear();
+        // Return `0` in case no library mapping with this start address.
+        std::uintptr_t GetLibEndAddrAndRealName(std::uintptr_t libAddr, std::string &realLibName) const;
+        // Return first mapping start address for file, `0` in case file not mapped.
+        std::uintptr_t GetFileStartAddr(const std::string &fileName) const;
+
+    private:
+
+        struct map_entry_t
+        {
+            std::uintptr_t startAddr;
+            std::uintptr_t endAddr;
+            std::string name;
+
+            map_entry_t(std::uintptr_t startAddr_, std::uintptr_t endAddr_, std::string &&name_) :
+                startAddr(startAddr_), endAddr(endAddr_), name(std::move(name_))
+            {}
+        };
+
+        std::vector<map_entry_t> m_entries;
+    };
+
+    // Page granular cache of debuggee process memory, each page read by one process_vm_readv() call.
+    // Aimed to replace word by word PTRACE_PEEKDATA reads (each is syscall through ptrace helper thread).
+    // Note, memory changes are not tracked, cache must be used only while thread is stopped.
+    class RemoteMemoryCache
+    {
+    public:
+
+        // Note, at pages limit all cached pages are dropped.
+        static const size_t MaxPages = 256;
+
+        explicit RemoteMemoryCache(pid_t pid);
+
+        // Return false in case memory could not be read by process_vm_readv() (caller could use PTRACE_PEEKDATA
+        // in this case, since ptrace ignore memory protection).
+        bool ReadWord(std::uintptr_t addr, word_t &value);
+        void Clear();
+
+    private:
+
+        pid_t m_pid;
+        std::uintptr_t m_pageSize;
+        // m_pages - page start address to page data, nullptr for unreadable page
+        std::unordered_map<std::uintptr_t, std::unique_ptr<char[]>> m_pages;
+
+        const char *GetPage(std::uintptr_t pageAddr);
+    };
 
 } // namespace InteropDebugging
 } // namespace netcoredbg
@@ -48,6 +48,8 @@ namespace
     ptrace_args_t g_ptraceArgs;
     long g_ptraceResult = 0;
     int g_errno = 0;
+    // In case not nullptr, batch of requests should be executed instead of g_ptraceArgs.
+    std::vector<ptrace_batch_entry_t> *g_ptraceBatch = nullptr;
 
 } // unnamed namespace
 
@@ -64,10 +66,22 @@ static void PtraceWorker()
         if (g_exitPtraceWorker)
             break;
 
-        errno = 0;
-        g_ptraceResult = ptrace(g_ptraceArgs.request, g_ptraceArgs.pid, g_ptraceArgs.addr, g_ptraceArgs.data);
-        g_errno = errno;
-        g_ptraceCV.notify_one(); // notify async_ptrace(), that result is ready
+        if (g_ptraceBatch != nullptr)
+        {
+            for (auto &entry : *g_ptraceBatch)
+            {
+                errno = 0;
+                entry.result = ptrace(entry.request, entry.pid, entry.addr, entry.data);
+                entry.error = errno;
+            }
+        }
+        else
+        {
+            errno = 0;
+            g_ptraceResult = ptrace(g_ptraceArgs.request, g_ptraceArgs.pid, g_ptraceArgs.addr, g_ptraceArgs.data);
+            g_errno = errno;
+        }
+        g_ptraceCV.notify_one(); // notify async_ptrace() or async_ptrace_batch(), that result is ready
     }
 
     g_ptraceCV.notify_one(); // notify async_ptrace_shutdown(), that execution exit from PtraceWorker()
@@ -122,5 +136,25 @@ long async_ptrace(__ptrace_request request, pid_t pid, void *addr, void *data)
     return g_ptraceResult;
 }
 
+bool async_ptrace_batch(std::vector<ptrace_batch_entry_t> &requests)
+{
+    if (requests.empty())
+        return true;
+
+    std::lock_guard<std::mutex> lockCommand(g_ptraceCommandMutex);
+    std::unique_lock<std::mutex> lock(g_ptraceMutex);
+
+    if (g_ptraceThreadStatus != PtraceThreadStatus::WORK)
+        return false;
+
+    g_ptraceBatch = &requests;
+
+    g_ptraceCV.notify_one(); // notify PtraceWorker for call real ptrace for all requests
+    g_ptraceCV.wait(lock); // wait for results in requests
+
+    g_ptraceBatch = nullptr;
+    return true;
+}
+
 } // namespace InteropDebugging
 } // namespace netcoredbg
@@ -9,6 +9,7 @@
 #include <sys/types.h>
 #include <sys/user.h>
 #include <cstdint>
+#include <vector>
 
 namespace netcoredbg
 {
@@ -31,6 +32,19 @@ namespace InteropDebugging
     // Note, this function call will provide `errno` of real ptrace() call.
     long async_ptrace(__ptrace_request request, pid_t pid, void *addr, void *data);
 
+    struct ptrace_batch_entry_t
+    {
+        __ptrace_request request;
+        pid_t pid;
+        void *addr;
+        void *data;
+        long result;
+        int error; // `errno` of real ptrace() call
+    };
+    // Execute all requests with one ptrace thread wakeup, aimed for requests to many threads (stop/continue all threads).
+    // Note, return false in case ptrace thread don't work (no requests executed), otherwise each entry provide own result.
+    bool async_ptrace_batch(std::vector<ptrace_batch_entry_t> &requests);
+
 } // namespace InteropDebugging
 } // namespace netcoredbg
 
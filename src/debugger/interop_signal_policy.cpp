@@ -0,0 +1,129 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/interop_signal_policy.h"
+
+#include <signal.h>
+#include <cstdlib>
+#include <cstring>
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+
+namespace
+{
+
+    struct SignalName
+    {
+        int signal;
+        const char *name;
+    };
+
+    const SignalName g_signalNames[] =
+    {
+        { SIGHUP,    "SIGHUP" },
+        { SIGINT,    "SIGINT" },
+        { SIGQUIT,   "SIGQUIT" },
+        { SIGILL,    "SIGILL" },
+        { SIGTRAP,   "SIGTRAP" },
+        { SIGABRT,   "SIGABRT" },
+        { SIGBUS,    "SIGBUS" },
+        { SIGFPE,    "SIGFPE" },
+        { SIGKILL,   "SIGKILL" },
+        { SIGUSR1,   "SIGUSR1" },
+        { SIGSEGV,   "SIGSEGV" },
+        { SIGUSR2,   "SIGUSR2" },
+        { SIGPIPE,   "SIGPIPE" },
+        { SIGALRM,   "SIGALRM" },
+        { SIGTERM,   "SIGTERM" },
+        { SIGCHLD,   "SIGCHLD" },
+        { SIGCONT,   "SIGCONT" },
+        { SIGSTOP,   "SIGSTOP" },
+        { SIGTSTP,   "SIGTSTP" },
+        { SIGTTIN,   "SIGTTIN" },
+        { SIGTTOU,   "SIGTTOU" },
+        { SIGURG,    "SIGURG" },
+        { SIGXCPU,   "SIGXCPU" },
+        { SIGXFSZ,   "SIGXFSZ" },
+        { SIGVTALRM, "SIGVTALRM" },
+        { SIGPROF,   "SIGPROF" },
+        { SIGWINCH,  "SIGWINCH" },
+        { SIGIO,     "SIGIO" },
+        { SIGSYS,    "SIGSYS" }
+    };
+
+} // unnamed namespace
+
+SignalPolicy::SignalPolicy()
+{
+    for (auto &action : m_actions)
+    {
+        action = static_cast<uint8_t>(SignalAction::Pass);
+    }
+}
+
+bool SignalPolicy::IsConfigurable(int signal)
+{
+    return signal > 0 && signal < MaxSignal &&
+           signal != SIGTRAP && signal != SIGILL && signal != SIGSTOP && signal != SIGKILL;
+}
+
+bool SignalPolicy::Set(int signal, SignalAction action)
+{
+    if (!IsConfigurable(signal))
+        return false;
+
+    m_actions[signal].store(static_cast<uint8_t>(action), std::memory_order_relaxed);
+    return true;
+}
+
+bool SignalPolicy::Get(int signal, SignalAction &action) const
+{
+    if (!IsConfigurable(signal))
+        return false;
+
+    action = static_cast<SignalAction>(m_actions[signal].load(std::memory_order_relaxed));
+    return true;
+}
+
+int SignalPolicy::ParseSignal(const std::string &signal)
+{
+    if (signal.empty())
+        return 0;
+
+    if (signal[0] >= '0' && signal[0] <= '9')
+    {
+        char *end;
+        const unsigned long result = strtoul(signal.c_str(), &end, 10);
+        return *end == 0 && result < (unsigned long)MaxSignal ? int(result) : 0;
+    }
+
+    const std::string name = signal.compare(0, 3, "SIG") == 0 ? signal : "SIG" + signal;
+    for (const auto &entry : g_signalNames)
+    {
+        if (name == entry.name)
+            return entry.signal;
+    }
+
+    // Realtime signals without names, "SIG<N>" format (same as GetSignalName() provide).
+    if (name.size() > 3 && name[3] >= '0' && name[3] <= '9')
+        return ParseSignal(name.substr(3));
+
+    return 0;
+}
+
+std::string SignalPolicy::GetSignalName(int signal)
+{
+    for (const auto &entry : g_signalNames)
+    {
+        if (entry.signal == signal)
+            return entry.name;
+    }
+    return "SIG" + std::to_string(signal);
+}
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
@@ -0,0 +1,57 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Note, this file have no PAL dependencies, since it's included into IDebugger interface and unit tests.
+
+namespace netcoredbg
+{
+
+// Interop mode action for signal delivered to debuggee thread.
+enum class SignalAction
+{
+    Stop,   // stop all threads and report stop event, signal is delivered at continue
+    Print,  // print signal info and deliver signal without stop
+    Pass    // deliver signal without stop silently
+};
+
+namespace InteropDebugging
+{
+
+// Per-signal actions table for interop mode. Table is read by waitpid thread for each delivered signal, so, read is
+// lock-free (changes are rare and could be applied with some delay, for signals delivered after change).
+// Note, signals used by debugger itself (SIGTRAP, SIGILL, SIGSTOP) and can't be handled by debuggee (SIGKILL) are not
+// configurable and always handled by debugger internal logic.
+class SignalPolicy
+{
+public:
+
+    static const int MaxSignal = 65; // Linux _NSIG
+
+    // Note, all signals are passed silently by default, runtime use signals (for example, SIGSEGV for NullReferenceException
+    // and SIGRTMIN for threads activation) and stop at them could change runtime behaviour.
+    SignalPolicy();
+
+    // Return false in case signal is not configurable.
+    bool Set(int signal, SignalAction action);
+    // Return false in case signal is not configurable, `action` is not changed in this case.
+    bool Get(int signal, SignalAction &action) const;
+    static bool IsConfigurable(int signal);
+
+    // Signal could be provided by name ("SIGPIPE" or "PIPE", case sensitive) or by number, return 0 in case of error.
+    static int ParseSignal(const std::string &signal);
+    // Return "SIG<N>" for signals without name (realtime signals).
+    static std::string GetSignalName(int signal);
+
+private:
+
+    std::atomic<uint8_t> m_actions[MaxSignal];
+};
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
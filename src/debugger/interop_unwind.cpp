@@ -4,12 +4,14 @@
 
 #include "debugger/interop_unwind.h"
 #include "debugger/interop_ptrace_helpers.h"
+#include "debugger/interop_mem_helpers.h"
 
 #include <libunwind-ptrace.h> // _UPT_find_proc_info()
 #include <sys/mman.h>
 #include <array>
 #include <cstring>
 #include <errno.h>
+#include <mutex>
 #include <sys/uio.h> // iovec
 #include <elf.h> // NT_PRSTATUS
 #include "utils/logger.h"
@@ -37,14 +39,19 @@ struct elf_dyn_info_t
 #endif
 };
 
+// Note, same layout as libunwind-ptrace's UPT_info have, since _UPT_find_proc_info() use it as argument.
+struct libunwind_UPT_info_t
+{
+    pid_t pid; // the process-id of the child we're unwinding
+    elf_dyn_info_t edi;
+};
+
 struct UPT_info
 {
-    struct
-    {
-        pid_t pid; // the process-id of the child we're unwinding
-        elf_dyn_info_t edi;
-    } libunwind_UPT_info;
+    libunwind_UPT_info_t libunwind_UPT_info;
     const std::array<unw_word_t, UNW_REG_LAST + 1> *contextRegs;
+    RemoteMemoryCache *memCache;
+    InteropLibraries *interopLibraries;
 };
 
 static inline void invalidate_edi(elf_dyn_info_t *edi)
@@ -61,6 +68,34 @@ static inline void invalidate_edi(elf_dyn_info_t *edi)
 #endif
 }
 
+// Note, edi hold only one ELF image data, but all addresses from one library belong to same image,
+// so, library's edi loaded once at first unwind through this library and reused after.
+struct LibraryUnwindInfo
+{
+    std::mutex mutex;
+    libunwind_UPT_info_t libunwind_UPT_info;
+
+    LibraryUnwindInfo()
+    {
+        libunwind_UPT_info.pid = 0;
+        libunwind_UPT_info.edi.ei.image = nullptr;
+        invalidate_edi(&libunwind_UPT_info.edi);
+    }
+
+    ~LibraryUnwindInfo()
+    {
+        invalidate_edi(&libunwind_UPT_info.edi);
+    }
+
+    LibraryUnwindInfo(const LibraryUnwindInfo&) = delete;
+    LibraryUnwindInfo& operator=(const LibraryUnwindInfo&) = delete;
+};
+
+std::shared_ptr<LibraryUnwindInfo> CreateLibraryUnwindInfo()
+{
+    return std::make_shared<LibraryUnwindInfo>();
+}
+
 // ptrace related registers data (see <sys/user.h>).
 static std::array<int, UNW_REG_LAST + 1> InitPtraceRegOffset()
 {
@@ -157,7 +192,8 @@ const std::array<int, UNW_REG_LAST + 1> g_ptraceRegOffset(InitPtraceRegOffset())
 
 
 
-static void *UnwindContextCreate(pid_t pid, const std::array<unw_word_t, UNW_REG_LAST + 1> *contextRegs)
+static void *UnwindContextCreate(pid_t pid, InteropLibraries *pInteropLibraries, const std::array<unw_word_t, UNW_REG_LAST + 1> *contextRegs,
+                                 RemoteMemoryCache *memCache)
 {
     UPT_info *ui = (UPT_info*)malloc(sizeof(UPT_info));
     if (!ui)
@@ -166,6 +202,8 @@ static void *UnwindContextCreate(pid_t pid, const std::array<unw_word_t, UNW_REG
     memset(ui, 0, sizeof(*ui));
     ui->libunwind_UPT_info.pid = pid;
     ui->contextRegs = contextRegs;
+    ui->memCache = memCache;
+    ui->interopLibraries = pInteropLibraries;
     ui->libunwind_UPT_info.edi.di_cache.format = -1;
     ui->libunwind_UPT_info.edi.di_debug.format = -1;
     return ui;
@@ -181,7 +219,17 @@ static void UnwindContextDestroy(void *ptr)
 static int FindProcInfo(unw_addr_space_t as, unw_word_t ip, unw_proc_info_t *pi, int need_unwind_info, void *arg)
 {
     UPT_info *ui = (UPT_info*)arg;
-    return _UPT_find_proc_info(as, ip, pi, need_unwind_info, &ui->libunwind_UPT_info);
+    std::shared_ptr<LibraryUnwindInfo> libUnwindInfo;
+    if (ui->interopLibraries)
+        libUnwindInfo = ui->interopLibraries->GetUnwindInfoForAddr(ip);
+
+    if (!libUnwindInfo)
+        return _UPT_find_proc_info(as, ip, pi, need_unwind_info, &ui->libunwind_UPT_info);
+
+    std::lock_guard<std::mutex> lock(libUnwindInfo->mutex);
+    // Note, pid used for ELF image search in /proc/<pid>/maps on cache miss only, thread that was used at first load could already exit.
+    libUnwindInfo->libunwind_UPT_info.pid = ui->libunwind_UPT_info.pid;
+    return _UPT_find_proc_info(as, ip, pi, need_unwind_info, &libUnwindInfo->libunwind_UPT_info);
 }
 
 static void PutUnwindInfo(unw_addr_space_t as, unw_proc_info_t *pi, void *arg)
@@ -208,6 +256,14 @@ static int AccessMem(unw_addr_space_t as, unw_word_t addr, unw_word_t *val, int
     if (!ui)
         return -UNW_EINVAL;
 
+    static_assert(sizeof(unw_word_t) == sizeof(word_t), "unw_word_t and word_t must have same size");
+    word_t value;
+    if (ui->memCache && ui->memCache->ReadWord(addr, value))
+    {
+        *val = value;
+        return 0;
+    }
+
     errno = 0;
     *val = async_ptrace(PTRACE_PEEKDATA, ui->libunwind_UPT_info.pid, (void*)addr, 0);
 
@@ -265,15 +321,16 @@ static int ResumeExecution(unw_addr_space_t, unw_cursor_t *, void *)
     return -UNW_EINVAL;
 }
 
-void ThreadStackUnwind(pid_t pid, std::array<unw_word_t, UNW_REG_LAST + 1> *contextRegs, std::function<bool(std::uintptr_t)> threadStackUnwindCallback)
+namespace
 {
-    // TODO ? setup for arm32 env UNW_ARM_UNWIND_METHOD with value UNW_ARM_METHOD_FRAME (looks like all unwinding good by default, no unwind method changes needed)
-
-    // TODO ? use global cache for libunwinde (increase unwinding speed in exchange of memory usage)
-    //  - unw_create_addr_space() at "unwind init"
-    //  - unw_set_caching_policy() with UNW_CACHE_GLOBAL https://www.nongnu.org/libunwind/man/unw_set_caching_policy(3).html
-    //  - unw_flush_cache() in case some lib unload or at "unwind shutdown" https://www.nongnu.org/libunwind/man/unw_flush_cache(3).html
+    std::mutex g_addrSpaceMutex;
+    unw_addr_space_t g_addrSpace = nullptr;
+}
 
+// Note, address space is created once and never destroyed, since all debuggee's threads share same address space,
+// libunwind's global cache (unwind data for addresses) is reused for all unwinds and flushed at library unload.
+static unw_addr_space_t GetAddrSpace()
+{
     static unw_accessors_t accessors =
     {
         .find_proc_info             = FindProcInfo,
@@ -286,8 +343,38 @@ void ThreadStackUnwind(pid_t pid, std::array<unw_word_t, UNW_REG_LAST + 1> *cont
         .get_proc_name              = GetProcName
     };
 
-    unw_addr_space_t addrSpace = unw_create_addr_space(&accessors, 0);
-    void *unwind_context = UnwindContextCreate(pid, contextRegs);
+    std::lock_guard<std::mutex> lock(g_addrSpaceMutex);
+    if (g_addrSpace == nullptr)
+    {
+        g_addrSpace = unw_create_addr_space(&accessors, 0);
+        if (g_addrSpace != nullptr && unw_set_caching_policy(g_addrSpace, UNW_CACHE_GLOBAL) != 0)
+            LOGW("Can't enable libunwind global cache");
+    }
+    return g_addrSpace;
+}
+
+void FlushUnwindCache(std::uintptr_t startAddr, std::uintptr_t endAddr)
+{
+    std::lock_guard<std::mutex> lock(g_addrSpaceMutex);
+    if (g_addrSpace != nullptr)
+        unw_flush_cache(g_addrSpace, startAddr, endAddr);
+}
+
+void ThreadStackUnwind(pid_t pid, InteropLibraries *pInteropLibraries, std::array<unw_word_t, UNW_REG_LAST + 1> *contextRegs,
+                       std::function<bool(std::uintptr_t)> threadStackUnwindCallback)
+{
+    // TODO ? setup for arm32 env UNW_ARM_UNWIND_METHOD with value UNW_ARM_METHOD_FRAME (looks like all unwinding good by default, no unwind method changes needed)
+
+    unw_addr_space_t addrSpace = GetAddrSpace();
+    if (addrSpace == nullptr)
+    {
+        LOGE("ERROR: cannot create address space for remote unwinding");
+        return;
+    }
+
+    // Note, thread is stopped during unwind, so, debuggee memory could be cached for all unwind steps.
+    RemoteMemoryCache memCache(pid);
+    void *unwind_context = UnwindContextCreate(pid, pInteropLibraries, contextRegs, &memCache);
     unw_cursor_t unwind_cursor;
     if (unw_init_remote(&unwind_cursor, addrSpace, unwind_context) < 0)
         LOGE("ERROR: cannot initialize cursor for remote unwinding");
@@ -321,7 +408,6 @@ void ThreadStackUnwind(pid_t pid, std::array<unw_word_t, UNW_REG_LAST + 1> *cont
         while (unw_step(&unwind_cursor) > 0);
     }
     UnwindContextDestroy(unwind_context);
-    unw_destroy_addr_space(addrSpace);
 }
 
 
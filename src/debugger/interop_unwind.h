@@ -6,7 +6,9 @@
 #ifdef INTEROP_DEBUGGING
 
 #include <sys/types.h>
+#include <array>
 #include <functional>
+#include <memory>
 #include <libunwind.h>
 
 namespace netcoredbg
@@ -14,7 +16,18 @@ namespace netcoredbg
 namespace InteropDebugging
 {
 
-void ThreadStackUnwind(pid_t pid, std::array<unw_word_t, UNW_REG_LAST + 1> *contextRegs, std::function<bool(std::uintptr_t)> threadStackUnwindCallback);
+class InteropLibraries;
+
+// Library's unwind tables cache (mapped ELF image with found .eh_frame_hdr/.debug_frame tables), owned by
+// library's info, aimed to avoid ELF image load and unwind tables search for each thread unwind.
+struct LibraryUnwindInfo;
+std::shared_ptr<LibraryUnwindInfo> CreateLibraryUnwindInfo();
+
+// Flush libunwind's cached unwind data, must be called at library unload.
+void FlushUnwindCache(std::uintptr_t startAddr, std::uintptr_t endAddr);
+
+// Note, pInteropLibraries is optional, in case it provided, libraries unwind tables cache is used.
+void ThreadStackUnwind(pid_t pid, InteropLibraries *pInteropLibraries, std::array<unw_word_t, UNW_REG_LAST + 1> *contextRegs, std::function<bool(std::uintptr_t)> threadStackUnwindCallback);
 
 } // namespace InteropDebugging
 } // namespace netcoredbg
@@ -0,0 +1,342 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/interop_watchpoint_helpers.h"
+#include "debugger/interop_ptrace_helpers.h"
+
+#include <sys/uio.h> // iovec
+#include <elf.h> // NT_ARM_HW_WATCH
+#include <stddef.h> // offsetof
+#include <errno.h>
+#include <string.h>
+#include "utils/logger.h"
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+
+#if DEBUGGER_UNIX_AMD64 || DEBUGGER_UNIX_X86
+
+namespace
+{
+    const unsigned x86WatchpointsCount = 4; // DR0-DR3
+
+    void *DebugRegOffset(unsigned index)
+    {
+        return (void*)(offsetof(struct user, u_debugreg) + index * sizeof(((struct user*)nullptr)->u_debugreg[0]));
+    }
+
+    // In case of error, return `errno`.
+    int PokeDebugReg(pid_t pid, unsigned index, word_t value)
+    {
+        if (async_ptrace(PTRACE_POKEUSER, pid, DebugRegOffset(index), (void*)value) == -1)
+        {
+            int err_code = errno;
+            LOGE("Ptrace pokeuser error: %s\n", strerror(err_code));
+            return err_code;
+        }
+        return 0;
+    }
+
+    // DR7 R/Wn field: 01 - data writes, 11 - data reads or writes (read only is not supported by hardware).
+    word_t EncodeRW(DataBreakpointAccess access)
+    {
+        return access == DataBreakpointAccess::Write ? 0x1 : 0x3;
+    }
+
+    // DR7 LENn field: 00 - 1 byte, 01 - 2 bytes, 11 - 4 bytes, 10 - 8 bytes.
+    word_t EncodeLen(uint32_t size)
+    {
+        switch (size)
+        {
+        case 1: return 0x0;
+        case 2: return 0x1;
+        case 8: return 0x2;
+        default: return 0x3;
+        }
+    }
+
+} // unnamed namespace
+
+unsigned GetHWWatchpointsCount(pid_t)
+{
+    return x86WatchpointsCount;
+}
+
+bool IsHWWatchpointSupported(std::uintptr_t addr, uint32_t size, DataBreakpointAccess access)
+{
+    if (access == DataBreakpointAccess::Read)
+        return false;
+
+#if DEBUGGER_UNIX_AMD64
+    if (size != 1 && size != 2 && size != 4 && size != 8)
+        return false;
+#else
+    if (size != 1 && size != 2 && size != 4)
+        return false;
+#endif
+
+    return addr != 0 && addr % size == 0;
+}
+
+int SetHWWatchpoints(pid_t pid, const std::vector<hw_watchpoint_t> &slots)
+{
+    // Note, kernel validate DR7 with current addresses, disable all slots first in order to change addresses.
+    int err_code = PokeDebugReg(pid, 7, 0);
+    if (err_code != 0)
+        return err_code;
+
+    word_t dr7 = 0;
+    for (unsigned i = 0; i < slots.size() && i < x86WatchpointsCount; i++)
+    {
+        if (slots[i].addr == 0)
+            continue;
+
+        if ((err_code = PokeDebugReg(pid, i, (word_t)slots[i].addr)) != 0)
+            return err_code;
+
+        dr7 |= word_t(1) << (i * 2); // local enable
+        dr7 |= (EncodeRW(slots[i].access) | (EncodeLen(slots[i].size) << 2)) << (16 + i * 4);
+    }
+
+    if (dr7 == 0)
+        return 0;
+
+    return PokeDebugReg(pid, 7, dr7);
+}
+
+int GetHWWatchpointHit(pid_t pid, const siginfo_t &siginfo, const std::vector<hw_watchpoint_t> &slots)
+{
+    if (siginfo.si_code != TRAP_HWBKPT)
+        return -1;
+
+    errno = 0;
+    word_t dr6 = async_ptrace(PTRACE_PEEKUSER, pid, DebugRegOffset(6), nullptr);
+    if (errno != 0)
+    {
+        LOGE("Ptrace peekuser error: %s\n", strerror(errno));
+        return -1;
+    }
+
+    // Note, DR6 status bits are not cleared by hardware, reset them for next trap.
+    PokeDebugReg(pid, 6, 0);
+
+    for (unsigned i = 0; i < slots.size() && i < x86WatchpointsCount; i++)
+    {
+        if ((dr6 & (word_t(1) << i)) && slots[i].addr != 0)
+            return (int)i;
+    }
+
+    return -1;
+}
+
+bool NeedStepOverHWWatchpoint()
+{
+    return false; // Trap happens after instruction execution.
+}
+
+#elif DEBUGGER_UNIX_ARM64
+
+#ifndef NT_ARM_HW_WATCH
+#define NT_ARM_HW_WATCH 0x403
+#endif
+
+namespace
+{
+    // Same layout as `user_hwdebug_state` from <asm/ptrace.h> (we don't include it, since it conflicts with glibc headers).
+    struct arm64_hwdebug_state_t
+    {
+        uint32_t dbg_info;
+        uint32_t pad;
+        struct
+        {
+            uint64_t addr;
+            uint32_t ctrl;
+            uint32_t pad;
+        } dbg_regs[16];
+    };
+
+    const std::uintptr_t arm64WatchpointAlignMask = 0x7; // watchpoint cover 8 bytes aligned doubleword
+
+    // WCR: E (bit 0) - enable, PAC (bits 1-2) - 0b10 EL0 only, LSC (bits 3-4) - load/store, BAS (bits 5-12) - byte address select.
+    uint32_t EncodeCtrl(const hw_watchpoint_t &slot)
+    {
+        uint32_t lsc = slot.access == DataBreakpointAccess::Read ? 0x1 : (slot.access == DataBreakpointAccess::Write ? 0x2 : 0x3);
+        uint32_t bas = ((1u << slot.size) - 1) << (slot.addr & arm64WatchpointAlignMask);
+        return (bas << 5) | (lsc << 3) | (0x2 << 1) | 0x1;
+    }
+
+} // unnamed namespace
+
+unsigned GetHWWatchpointsCount(pid_t pid)
+{
+    arm64_hwdebug_state_t state;
+    memset(&state, 0, sizeof(state));
+    iovec iov;
+    iov.iov_base = &state;
+    iov.iov_len = sizeof(state);
+    if (async_ptrace(PTRACE_GETREGSET, pid, (void*)NT_ARM_HW_WATCH, &iov) == -1)
+    {
+        LOGW("Ptrace getregset error: %s\n", strerror(errno));
+        return 0;
+    }
+
+    unsigned count = state.dbg_info & 0xff;
+    return count > 16 ? 16 : count;
+}
+
+bool IsHWWatchpointSupported(std::uintptr_t addr, uint32_t size, DataBreakpointAccess access)
+{
+    if (size != 1 && size != 2 && size != 4 && size != 8)
+        return false;
+
+    return addr != 0 && addr % size == 0;
+}
+
+int SetHWWatchpoints(pid_t pid, const std::vector<hw_watchpoint_t> &slots)
+{
+    arm64_hwdebug_state_t state;
+    memset(&state, 0, sizeof(state));
+    size_t count = slots.size() > 16 ? 16 : slots.size();
+    for (size_t i = 0; i < count; i++)
+    {
+        if (slots[i].addr == 0)
+            continue;
+
+        state.dbg_regs[i].addr = slots[i].addr & ~arm64WatchpointAlignMask;
+        state.dbg_regs[i].ctrl = EncodeCtrl(slots[i]);
+    }
+
+    iovec iov;
+    iov.iov_base = &state;
+    iov.iov_len = offsetof(arm64_hwdebug_state_t, dbg_regs) + count * sizeof(state.dbg_regs[0]);
+    if (async_ptrace(PTRACE_SETREGSET, pid, (void*)NT_ARM_HW_WATCH, &iov) == -1)
+    {
+        int err_code = errno;
+        LOGE("Ptrace setregset error: %s\n", strerror(err_code));
+        return err_code;
+    }
+
+    return 0;
+}
+
+int GetHWWatchpointHit(pid_t, const siginfo_t &siginfo, const std::vector<hw_watchpoint_t> &slots)
+{
+    if (siginfo.si_code != TRAP_HWBKPT)
+        return -1;
+
+    // Note, `si_addr` is accessed data address, that could be lower than watched address in case of wide access (for example, `stp`),
+    // but it always belong to same doubleword.
+    std::uintptr_t accessAddr = (std::uintptr_t)siginfo.si_addr & ~arm64WatchpointAlignMask;
+    for (size_t i = 0; i < slots.size(); i++)
+    {
+        if (slots[i].addr != 0 && (slots[i].addr & ~arm64WatchpointAlignMask) == accessAddr)
+            return (int)i;
+    }
+
+    return -1;
+}
+
+bool NeedStepOverHWWatchpoint()
+{
+    return true; // Trap happens before instruction execution.
+}
+
+#elif DEBUGGER_UNIX_ARM
+
+namespace
+{
+    const std::uintptr_t arm32WatchpointAlignMask = 0x3; // watchpoint cover 4 bytes aligned word
+
+    // Note, hardware breakpoints registers indexes start from 1, watchpoints have negative indexes:
+    // -(2 * i + 1) - address register, -(2 * i + 2) - control register for watchpoint `i`.
+    // In case of error, return `errno`.
+    int SetHBPReg(pid_t pid, long index, uint32_t value)
+    {
+        if (async_ptrace((__ptrace_request)PTRACE_SETHBPREGS, pid, (void*)index, &value) == -1)
+        {
+            int err_code = errno;
+            LOGE("Ptrace sethbpregs error: %s\n", strerror(err_code));
+            return err_code;
+        }
+        return 0;
+    }
+
+    // Control register: enable (bit 0), privilege (bits 1-2) - 0b10 user only, type (bits 3-4) - load/store, BAS (bits 5-8) - byte address select.
+    uint32_t EncodeCtrl(const hw_watchpoint_t &slot)
+    {
+        uint32_t type = slot.access == DataBreakpointAccess::Read ? 0x1 : (slot.access == DataBreakpointAccess::Write ? 0x2 : 0x3);
+        uint32_t bas = ((1u << slot.size) - 1) << (slot.addr & arm32WatchpointAlignMask);
+        return (bas << 5) | (type << 3) | (0x2 << 1) | 0x1;
+    }
+
+} // unnamed namespace
+
+unsigned GetHWWatchpointsCount(pid_t pid)
+{
+    uint32_t info = 0;
+    if (async_ptrace((__ptrace_request)PTRACE_GETHBPREGS, pid, nullptr, &info) == -1)
+    {
+        LOGW("Ptrace gethbpregs error: %s\n", strerror(errno));
+        return 0;
+    }
+
+    return (info >> 8) & 0xff;
+}
+
+bool IsHWWatchpointSupported(std::uintptr_t addr, uint32_t size, DataBreakpointAccess access)
+{
+    if (size != 1 && size != 2 && size != 4)
+        return false;
+
+    return addr != 0 && addr % size == 0;
+}
+
+int SetHWWatchpoints(pid_t pid, const std::vector<hw_watchpoint_t> &slots)
+{
+    int err_code = 0;
+    for (size_t i = 0; i < slots.size(); i++)
+    {
+        // Disable slot first, since kernel validate control register with current address.
+        if ((err_code = SetHBPReg(pid, -(long)(i * 2 + 2), 0)) != 0)
+            return err_code;
+
+        if (slots[i].addr == 0)
+            continue;
+
+        if ((err_code = SetHBPReg(pid, -(long)(i * 2 + 1), (uint32_t)(slots[i].addr & ~arm32WatchpointAlignMask))) != 0 ||
+            (err_code = SetHBPReg(pid, -(long)(i * 2 + 2), EncodeCtrl(slots[i]))) != 0)
+            return err_code;
+    }
+
+    return 0;
+}
+
+int GetHWWatchpointHit(pid_t, const siginfo_t &siginfo, const std::vector<hw_watchpoint_t> &slots)
+{
+    if (siginfo.si_code != TRAP_HWBKPT)
+        return -1;
+
+    std::uintptr_t accessAddr = (std::uintptr_t)siginfo.si_addr & ~arm32WatchpointAlignMask;
+    for (size_t i = 0; i < slots.size(); i++)
+    {
+        if (slots[i].addr != 0 && (slots[i].addr & ~arm32WatchpointAlignMask) == accessAddr)
+            return (int)i;
+    }
+
+    return -1;
+}
+
+bool NeedStepOverHWWatchpoint()
+{
+    return true; // Trap happens before instruction execution.
+}
+
+#else
+#error "Unsupported platform"
+#endif
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
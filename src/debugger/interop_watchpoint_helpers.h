@@ -0,0 +1,46 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#ifdef INTEROP_DEBUGGING
+
+#include <sys/types.h>
+#include <signal.h>
+#include <cstdint>
+#include <vector>
+#include "interfaces/types.h"
+
+#ifndef TRAP_HWBKPT
+#define TRAP_HWBKPT 4 // hardware breakpoint/watchpoint
+#endif
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+
+    struct hw_watchpoint_t
+    {
+        std::uintptr_t addr = 0; // `0` for free slot
+        uint32_t size = 0;
+        DataBreakpointAccess access = DataBreakpointAccess::Write;
+    };
+
+    // Return hardware watchpoints count available for thread, `0` in case hardware watchpoints not supported.
+    unsigned GetHWWatchpointsCount(pid_t pid);
+    // Check that watchpoint with this size, alignment and access type could be set by hardware.
+    bool IsHWWatchpointSupported(std::uintptr_t addr, uint32_t size, DataBreakpointAccess access);
+    // Write all slots into thread's debug registers, free slots are disabled. Thread must be stopped.
+    // In case of error, return `errno`.
+    int SetHWWatchpoints(pid_t pid, const std::vector<hw_watchpoint_t> &slots);
+    // Return triggered slot index for SIGTRAP, `-1` in case this is not hardware watchpoint trap.
+    int GetHWWatchpointHit(pid_t pid, const siginfo_t &siginfo, const std::vector<hw_watchpoint_t> &slots);
+    // Return true in case trap happens before memory access instruction execution (ARM/ARM64),
+    // so, thread must step over this instruction with disabled watchpoints first.
+    bool NeedStepOverHWWatchpoint();
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
+
+#endif // INTEROP_DEBUGGING
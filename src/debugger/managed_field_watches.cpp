@@ -0,0 +1,132 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/managed_field_watches.h"
+
+namespace netcoredbg
+{
+
+const size_t ManagedFieldWatches::MaxWatches;
+
+std::uintptr_t ManagedFieldWatches::GetObjectAddress(ICorDebugHandleValue *pHandle)
+{
+    BOOL isNull = TRUE;
+    CORDB_ADDRESS address = 0;
+    if (FAILED(pHandle->IsNull(&isNull)) || isNull ||
+        FAILED(pHandle->GetValue(&address)))
+        return 0;
+
+    return (std::uintptr_t)address;
+}
+
+HRESULT ManagedFieldWatches::Add(ICorDebugValue *pObjectValue, CORDB_ADDRESS fieldAddress, ULONG32 fieldSize, const std::string &name, uint32_t &id)
+{
+    HRESULT Status;
+    CORDB_ADDRESS objectAddress = 0;
+    ULONG32 objectSize = 0;
+    IfFailRet(pObjectValue->GetAddress(&objectAddress));
+    IfFailRet(pObjectValue->GetSize(&objectSize));
+    if (fieldAddress < objectAddress || fieldAddress + fieldSize > objectAddress + objectSize)
+        return E_INVALIDARG;
+
+    ToRelease<ICorDebugHeapValue2> iCorHeapValue2;
+    ToRelease<ICorDebugHandleValue> iCorHandle;
+    IfFailRet(pObjectValue->QueryInterface(IID_ICorDebugHeapValue2, (LPVOID*) &iCorHeapValue2));
+    IfFailRet(iCorHeapValue2->CreateHandle(HANDLE_STRONG, &iCorHandle));
+
+    // Note, handle value provide object address, that could be different from value address (for example, boxed value).
+    const std::uintptr_t handleAddress = GetObjectAddress(iCorHandle);
+    if (handleAddress == 0 || handleAddress > fieldAddress)
+    {
+        iCorHandle->Dispose();
+        return E_FAIL;
+    }
+
+    std::lock_guard<std::mutex> lock(m_watchesMutex);
+    if (m_watches.size() >= MaxWatches)
+    {
+        iCorHandle->Dispose();
+        return E_OUTOFMEMORY;
+    }
+
+    id = m_nextId++;
+    watch_t &watch = m_watches[id];
+    watch.offset = ULONG32(fieldAddress - handleAddress);
+    watch.size = fieldSize;
+    watch.address = (std::uintptr_t)fieldAddress;
+    watch.name = name;
+    watch.iCorHandle = iCorHandle.Detach();
+    return S_OK;
+}
+
+bool ManagedFieldWatches::GetField(uint32_t id, std::uintptr_t &address, uint32_t &size, std::string &name)
+{
+    std::lock_guard<std::mutex> lock(m_watchesMutex);
+    auto find = m_watches.find(id);
+    if (find == m_watches.end())
+        return false;
+
+    address = find->second.address;
+    size = find->second.size;
+    name = find->second.name;
+    return true;
+}
+
+void ManagedFieldWatches::Suspend()
+{
+    std::lock_guard<std::mutex> lock(m_watchesMutex);
+    for (auto &entry : m_watches)
+    {
+        entry.second.address = 0;
+    }
+}
+
+bool ManagedFieldWatches::Update()
+{
+    std::lock_guard<std::mutex> lock(m_watchesMutex);
+    bool changed = false;
+    for (auto &entry : m_watches)
+    {
+        watch_t &watch = entry.second;
+        const std::uintptr_t objectAddress = GetObjectAddress(watch.iCorHandle);
+        const std::uintptr_t address = objectAddress == 0 ? 0 : objectAddress + watch.offset;
+        if (address != watch.address)
+        {
+            watch.address = address;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+void ManagedFieldWatches::Retain(const std::unordered_set<uint32_t> &ids)
+{
+    std::lock_guard<std::mutex> lock(m_watchesMutex);
+    for (auto it = m_watches.begin(); it != m_watches.end();)
+    {
+        if (ids.find(it->first) != ids.end())
+        {
+            ++it;
+            continue;
+        }
+
+        it->second.iCorHandle->Dispose();
+        it = m_watches.erase(it);
+    }
+}
+
+bool ManagedFieldWatches::Empty()
+{
+    std::lock_guard<std::mutex> lock(m_watchesMutex);
+    return m_watches.empty();
+}
+
+void ManagedFieldWatches::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_watchesMutex);
+    // Note, handles are not disposed, since process could be already exited.
+    m_watches.clear();
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,61 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include "utils/torelease.h"
+
+namespace netcoredbg
+{
+
+// Managed object instance fields, watched by data breakpoints (see DataBreakpoint::managedFieldId). Object is kept by
+// strong handle, field address is calculated from current object address and field offset, so, after object relocation
+// by GC watched address could be updated by Update() call.
+class ManagedFieldWatches
+{
+public:
+
+    // Watches are created by "data breakpoint info" requests, not used watches are released by Retain().
+    static const size_t MaxWatches = 256;
+
+    // `pObjectValue` must be dereferenced heap object value, field must be inside of object.
+    HRESULT Add(ICorDebugValue *pObjectValue, CORDB_ADDRESS fieldAddress, ULONG32 fieldSize, const std::string &name, uint32_t &id);
+    // Return `false` in case watch not found or object was collected, `address` is 0 in case GC is in progress (see Suspend()).
+    bool GetField(uint32_t id, std::uintptr_t &address, uint32_t &size, std::string &name);
+    // Object could be moved during GC, so, watched addresses must not be used till Update() call.
+    void Suspend();
+    // Re-read objects addresses, return `true` in case any field address was changed (or watches were suspended).
+    bool Update();
+    // Release all watches, that are not in `ids`.
+    void Retain(const std::unordered_set<uint32_t> &ids);
+    bool Empty();
+    void Clear();
+
+private:
+
+    struct watch_t
+    {
+        ToRelease<ICorDebugHandleValue> iCorHandle;
+        ULONG32 offset;
+        uint32_t size;
+        std::uintptr_t address; // 0 in case suspended or object was collected
+        std::string name;
+    };
+
+    std::mutex m_watchesMutex;
+    uint32_t m_nextId = 1;
+    std::unordered_map<uint32_t, watch_t> m_watches;
+
+    static std::uintptr_t GetObjectAddress(ICorDebugHandleValue *pHandle);
+};
+
+} // namespace netcoredbg
@@ -10,18 +10,33 @@
 #include "debugger/callbacksqueue.h"
 #include "debugger/threads.h"
 #include "debugger/evalwaiter.h"
+#include "debugger/evaluator.h"
 #include "debugger/breakpoints.h"
+#include "debugger/steppers.h"
+#include "debugger/stepstats.h"
 #include "debugger/waitpid.h"
 #include "debugger/evalstackmachine.h"
 #include "metadata/modules.h"
+#include "metadata/wellknown_types.h"
 #include "interfaces/iprotocol.h"
 #include "utils/utf.h"
+#include "utils/perfcounters.h"
+#include "utils/sequenced_executor.h"
+#include "utils/tracerecorder.h"
 #include "managed/interop.h"
 
 
 namespace netcoredbg
 {
 
+// Note, count all runtime breakpoint callbacks, including breakpoints with false conditions.
+static PerfCounters::Counter breakpointHitsCounter("breakpointHits");
+
+// Note, managed callbacks are called by runtime's debugger thread.
+#define TraceCallbackEntry() \
+    TraceRecorder::SetThreadName("ManagedCallback"); \
+    TraceRecorder::ScopedEvent _trace_callback_entry_("ManagedCallback", __func__)
+
 ULONG ManagedCallback::GetRefCount()
 {
     LogFuncEntry();
@@ -49,6 +64,10 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::QueryInterface(REFIID riid, VOID** pp
     {
         *ppInterface = static_cast<ICorDebugManagedCallback3*>(this);
     }
+    else if (riid == IID_ICorDebugManagedCallback4)
+    {
+        *ppInterface = static_cast<ICorDebugManagedCallback4*>(this);
+    }
     else if (riid == IID_IUnknown)
     {
         *ppInterface = static_cast<IUnknown*>(static_cast<ICorDebugManagedCallback*>(this));
@@ -91,12 +110,21 @@ ULONG STDMETHODCALLTYPE ManagedCallback::Release()
 HRESULT STDMETHODCALLTYPE ManagedCallback::Breakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint)
 {
     LogFuncEntry();
-    return m_sharedCallbacksQueue->AddCallbackToQueue(pAppDomain, [&]()
+    TraceCallbackEntry();
+    breakpointHitsCounter.Add();
+    return m_sharedCallbacksQueue->AddFilteredCallbackToQueue(pAppDomain, [&]() -> bool
     {
+        // Trace points hits are recorded directly in callback thread and continued without callbacks worker thread handoff.
+        // Note, in case of pending application update, callbacks worker must be reached first (see CallbacksWorkerBreakpoint()).
+        if (!m_debugger.m_sharedBreakpoints->IsApplicationReloadPending() &&
+            m_debugger.m_sharedBreakpoints->ManagedCallbackTraceBreakpoint(pThread, pBreakpoint))
+            return false;
+
         pAppDomain->AddRef();
         pThread->AddRef();
         pBreakpoint->AddRef();
-        m_sharedCallbacksQueue->EmplaceBack(CallbackQueueCall::Breakpoint, pAppDomain, pThread, pBreakpoint, STEP_NORMAL, ExceptionCallbackType::FIRST_CHANCE);
+        m_sharedCallbacksQueue->EmplaceBack(CallbackQueueCall::Breakpoint, pAppDomain, pThread, pBreakpoint, STEP_NORMAL);
+        return true;
     });
 }
 
@@ -104,22 +132,39 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::StepComplete(ICorDebugAppDomain *pApp
                                                         ICorDebugStepper *pStepper, CorDebugStepReason reason)
 {
     LogFuncEntry();
-    return m_sharedCallbacksQueue->AddCallbackToQueue(pAppDomain, [&]()
+    TraceCallbackEntry();
+    StepStats::MarkStepComplete();
+    return m_sharedCallbacksQueue->AddFilteredCallbackToQueue(pAppDomain, [&]() -> bool
     {
+        CallbackQueueCall call = CallbackQueueCall::StepComplete;
+        // Check steppers directly in callback thread, step complete in hidden or filtered code need new step setup only
+        // and could be continued without callbacks worker thread handoff.
+        // Note, in case of pending application update, callbacks worker must be reached first (see CallbacksWorkerStepComplete()).
+        if (!m_debugger.m_sharedBreakpoints->IsApplicationReloadPending())
+        {
+            // S_FALSE - not error and steppers not affect on callback (callback will emit stop event)
+            if (S_FALSE != m_debugger.m_uniqueSteppers->ManagedCallbackStepComplete(pThread, reason))
+                return false;
+
+            call = CallbackQueueCall::StepCompleteFiltered;
+        }
+
         pAppDomain->AddRef();
         pThread->AddRef();
-        m_sharedCallbacksQueue->EmplaceBack(CallbackQueueCall::StepComplete, pAppDomain, pThread, nullptr, reason, ExceptionCallbackType::FIRST_CHANCE);
+        m_sharedCallbacksQueue->EmplaceBack(call, pAppDomain, pThread, nullptr, reason);
+        return true;
     });
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::Break(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->AddCallbackToQueue(pAppDomain, [&]()
     {
         pAppDomain->AddRef();
         pThread->AddRef();
-        m_sharedCallbacksQueue->EmplaceBack(CallbackQueueCall::Break, pAppDomain, pThread, nullptr, STEP_NORMAL, ExceptionCallbackType::FIRST_CHANCE);
+        m_sharedCallbacksQueue->EmplaceBack(CallbackQueueCall::Break, pAppDomain, pThread, nullptr, STEP_NORMAL);
     });
 }
 
@@ -127,20 +172,26 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::Exception(ICorDebugAppDomain *pAppDom
 {
     // Obsolete callback
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::EvalComplete(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugEval *pEval)
 {
     LogFuncEntry();
-    m_debugger.m_sharedEvalWaiter->NotifyEvalComplete(pThread, pEval);
+    TraceCallbackEntry();
+    // Note, in case other evals of group still running, process must be continued.
+    if (m_debugger.m_sharedEvalWaiter->NotifyEvalComplete(pThread, pEval))
+        return pAppDomain->Continue(0);
     return S_OK; // Eval-related routine - no callbacks queue related code here.
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::EvalException(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugEval *pEval)
 {
     LogFuncEntry();
-    m_debugger.m_sharedEvalWaiter->NotifyEvalComplete(pThread, pEval);
+    TraceCallbackEntry();
+    if (m_debugger.m_sharedEvalWaiter->NotifyEvalComplete(pThread, pEval))
+        return pAppDomain->Continue(0);
     return S_OK; // Eval-related routine - no callbacks queue related code here.
 }
 
@@ -151,6 +202,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::EvalException(ICorDebugAppDomain *pAp
 HRESULT STDMETHODCALLTYPE ManagedCallback::CreateProcess(ICorDebugProcess *pProcess)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
 
     // ManagedPart must be initialized only once for process, since CoreCLR don't support unload and reinit
     // for global variables. coreclr_shutdown only should be called on process exit.
@@ -180,7 +232,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::CreateProcess(ICorDebugProcess *pProc
 
         m_debugger.m_sharedEvalWaiter->NotifyEvalComplete(nullptr, nullptr);
 
-        m_debugger.pProtocol->EmitExitedEvent(ExitedEvent(GetWaitpid().GetExitCode()));
+        m_debugger.pProtocol->EmitExitedEvent(ExitedEvent(GetWaitpid().GetExitCode((pid_t)m_debugger.m_processId)));
         m_debugger.NotifyProcessExited();
         m_debugger.pProtocol->EmitTerminatedEvent();
         m_debugger.m_ioredirect.async_cancel();
@@ -209,7 +261,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::CreateProcess(ICorDebugProcess *pProc
             // Don't AddRef() here for pAppDomain! We get it with AddRef() from Next() and will release in m_callbacksQueue by ToRelease destructor.
             return m_sharedCallbacksQueue->AddCallbackToQueue(pAppDomain, [&]()
             {
-                m_sharedCallbacksQueue->EmplaceBack(CallbackQueueCall::CreateProcess, pAppDomain, nullptr, nullptr, STEP_NORMAL, ExceptionCallbackType::FIRST_CHANCE);
+                m_sharedCallbacksQueue->EmplaceBack(CallbackQueueCall::CreateProcess, pAppDomain, nullptr, nullptr, STEP_NORMAL);
             });
         }
     }
@@ -220,6 +272,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::CreateProcess(ICorDebugProcess *pProc
 HRESULT STDMETHODCALLTYPE ManagedCallback::ExitProcess(ICorDebugProcess *pProcess)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
 
     if (m_debugger.m_sharedEvalWaiter->IsEvalRunning())
         LOGW("The target process exited while evaluating the function.");
@@ -233,7 +286,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ExitProcess(ICorDebugProcess *pProces
     // C# Main() return values is int (signed int) or void (return 0)
     int exitCode = 0;
 #ifdef FEATURE_PAL
-    exitCode = GetWaitpid().GetExitCode();
+    exitCode = GetWaitpid().GetExitCode((pid_t)m_debugger.m_processId);
 #else
     HPROCESS hProcess;
     DWORD dwExitCode = 0;
@@ -244,6 +297,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ExitProcess(ICorDebugProcess *pProces
     }
 #endif // FEATURE_PAL
 
+    m_debugger.WaitLoadModuleTasks();
     m_debugger.pProtocol->EmitExitedEvent(ExitedEvent(exitCode));
     m_debugger.NotifyProcessExited();
     m_debugger.pProtocol->EmitTerminatedEvent();
@@ -254,6 +308,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ExitProcess(ICorDebugProcess *pProces
 HRESULT STDMETHODCALLTYPE ManagedCallback::CreateThread(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
 
     if (m_debugger.m_sharedEvalWaiter->IsEvalRunning())
         LOGW("Thread was created by user code during evaluation with implicit user code execution.");
@@ -268,6 +323,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::CreateThread(ICorDebugAppDomain *pApp
 HRESULT STDMETHODCALLTYPE ManagedCallback::ExitThread(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
 
     ThreadId threadId(getThreadId(pThread));
     m_debugger.m_sharedThreads->Remove(threadId);
@@ -285,31 +341,50 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ExitThread(ICorDebugAppDomain *pAppDo
 HRESULT STDMETHODCALLTYPE ManagedCallback::LoadModule(ICorDebugAppDomain *pAppDomain, ICorDebugModule *pModule)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
 
-    Module module;
-    std::string outputText;
-    m_debugger.m_sharedModules->TryLoadModuleSymbols(pModule, module, m_debugger.IsJustMyCode(), m_debugger.IsHotReload(), outputText);
-    if (!outputText.empty())
-    {
-        m_debugger.pProtocol->EmitOutputEvent(OutputStdErr, outputText);
-    }
-    m_debugger.pProtocol->EmitModuleEvent(ModuleEvent(ModuleNew, module));
+    // At attach, runtime send LoadModule callbacks for all already loaded modules, load symbols for them in parallel.
+    if (m_debugger.m_startMethod == StartAttach)
+        m_debugger.m_sharedModules->PreloadModulesSymbols(pAppDomain);
+
+    // Note, only symbols load (with JMC statuses) and breakpoints setup must be done before module code execution,
+    // protocol events emission and symbols memory limit check are done by worker after process continue.
+    std::shared_ptr<Module> module(new Module);
+    std::shared_ptr<std::string> outputText(new std::string);
+    m_debugger.m_sharedModules->TryLoadModuleSymbols(pModule, *module, m_debugger.IsJustMyCode(), m_debugger.IsDeferredJMC(),
+                                                     m_debugger.IsHotReload(), *outputText);
 
-    if (module.symbolStatus == SymbolsLoaded)
+    std::shared_ptr<std::vector<BreakpointEvent>> events(new std::vector<BreakpointEvent>);
+    if (module->symbolStatus == SymbolsLoaded)
+        m_debugger.m_sharedBreakpoints->ManagedCallbackLoadModule(pModule, *events);
+    m_debugger.m_sharedBreakpoints->ManagedCallbackLoadModuleAll(pModule);
+
+    ManagedDebuggerHelpers &debugger = m_debugger;
+    m_debugger.m_uniqueLoadModuleExecutor->Post([&debugger, module, outputText, events]()
     {
-        std::vector<BreakpointEvent> events;
-        m_debugger.m_sharedBreakpoints->ManagedCallbackLoadModule(pModule, events);
-        for (const BreakpointEvent &event : events)
+        if (!outputText->empty())
         {
-            m_debugger.pProtocol->EmitBreakpointEvent(event);
+            debugger.pProtocol->EmitOutputEvent(OutputStdErr, *outputText);
         }
-    }
-    m_debugger.m_sharedBreakpoints->ManagedCallbackLoadModuleAll(pModule);
+        debugger.pProtocol->EmitModuleEvent(ModuleEvent(ModuleNew, *module));
+        debugger.EmitNewLoadedSources();
+
+        for (const BreakpointEvent &event : *events)
+        {
+            debugger.pProtocol->EmitBreakpointEvent(event);
+        }
+
+        // Note, check limit after breakpoints resolve, so, modules with new breakpoints keep symbols.
+        if (module->symbolStatus == SymbolsLoaded)
+            debugger.CheckSymbolsMemoryLimit();
+    });
 
     // enable Debugger.NotifyOfCrossThreadDependency after System.Private.CoreLib.dll loaded (trigger for 1 time call only)
-    if (module.name == "System.Private.CoreLib.dll")
+    // Note, this is done synchronously, since evaluations could be requested at any stop after this callback.
+    if (module->name == "System.Private.CoreLib.dll")
     {
         m_debugger.m_sharedEvalWaiter->SetupCrossThreadDependencyNotificationClass(pModule);
+        WellKnownTypes::Init(pModule);
         m_debugger.m_sharedEvalStackMachine->FindPredefinedTypes(pModule);
     }
 
@@ -319,24 +394,32 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::LoadModule(ICorDebugAppDomain *pAppDo
 HRESULT STDMETHODCALLTYPE ManagedCallback::UnloadModule(ICorDebugAppDomain *pAppDomain, ICorDebugModule *pModule)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
+    m_debugger.m_sharedEvaluator->InvalidateModuleMembers(pModule);
+    m_debugger.m_sharedEvalHelpers->InvalidateModuleMethods(pModule);
+    m_debugger.m_sharedBreakpoints->ManagedCallbackUnloadModule(pModule);
+    m_debugger.m_sharedModules->ModuleUnloaded(pModule);
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::LoadClass(ICorDebugAppDomain *pAppDomain, ICorDebugClass *c)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::UnloadClass(ICorDebugAppDomain *pAppDomain, ICorDebugClass *c)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::DebuggerError(ICorDebugProcess *pProcess, HRESULT errorHR, DWORD errorCode)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueProcess(pProcess);
 }
 
@@ -344,6 +427,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::LogMessage(ICorDebugAppDomain *pAppDo
                                                       LONG lLevel, WCHAR *pLogSwitchName, WCHAR *pMessage)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
 
     if (m_debugger.m_sharedEvalWaiter->IsEvalRunning())
     {
@@ -371,48 +455,60 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::LogSwitch(ICorDebugAppDomain *pAppDom
                                                      ULONG ulReason, WCHAR *pLogSwitchName, WCHAR *pParentName)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::CreateAppDomain(ICorDebugProcess *pProcess, ICorDebugAppDomain *pAppDomain)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueProcess(pProcess);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::ExitAppDomain(ICorDebugProcess *pProcess, ICorDebugAppDomain *pAppDomain)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueProcess(pProcess);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::LoadAssembly(ICorDebugAppDomain *pAppDomain, ICorDebugAssembly *pAssembly)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::UnloadAssembly(ICorDebugAppDomain *pAppDomain, ICorDebugAssembly *pAssembly)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::ControlCTrap(ICorDebugProcess *pProcess)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueProcess(pProcess);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::NameChange(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
+    // Note, pThread is null in case of AppDomain name change.
+    if (pThread != nullptr)
+        m_debugger.m_sharedThreads->InvalidateThreadName(getThreadId(pThread));
+
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::UpdateModuleSymbols(ICorDebugAppDomain *pAppDomain, ICorDebugModule *pModule, IStream *pSymbolStream)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
@@ -420,6 +516,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::EditAndContinueRemap(ICorDebugAppDoma
                                                                 ICorDebugFunction *pFunction, BOOL fAccurate)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
@@ -427,6 +524,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::BreakpointSetError(ICorDebugAppDomain
                                                               ICorDebugBreakpoint *pBreakpoint, DWORD dwError)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
@@ -437,24 +535,28 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::FunctionRemapOpportunity(ICorDebugApp
                                                                     ICorDebugFunction *pOldFunction, ICorDebugFunction *pNewFunction, ULONG32 oldILOffset)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::CreateConnection(ICorDebugProcess *pProcess, CONNID dwConnectionId, WCHAR *pConnName)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueProcess(pProcess);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::ChangeConnection(ICorDebugProcess *pProcess, CONNID dwConnectionId)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueProcess(pProcess);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::DestroyConnection(ICorDebugProcess *pProcess, CONNID dwConnectionId)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueProcess(pProcess);
 }
 
@@ -511,8 +613,19 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::Exception(ICorDebugAppDomain *pAppDom
                                                      ULONG32 nOffset, CorDebugExceptionCallbackType dwEventType, DWORD dwFlags)
 {
     LogFuncEntry();
-    return m_sharedCallbacksQueue->AddCallbackToQueue(pAppDomain, [&]()
+    TraceCallbackEntry();
+    return m_sharedCallbacksQueue->AddFilteredCallbackToQueue(pAppDomain, [&]() -> bool
     {
+        // In exception statistics mode handled exceptions are counted and continued immediately, unhandled exceptions are stopped as usual.
+        // Note, in case of pending application update, callbacks worker must be reached (see CallbacksWorkerException()).
+        if (dwEventType != DEBUG_EXCEPTION_UNHANDLED &&
+            m_debugger.m_sharedBreakpoints->ManagedCallbackExceptionStatistics(pThread, pFrame, dwEventType == DEBUG_EXCEPTION_FIRST_CHANCE) &&
+            !m_debugger.m_sharedBreakpoints->IsApplicationReloadPending())
+            return false;
+
+        // Note, runtime already checked JMC statuses for this exception, but all next exceptions will be provided with proper type.
+        m_debugger.m_sharedModules->ApplyDeferredJMC();
+
         // pFrame could be neutered in case of evaluation during brake, do all stuff with pFrame in callback itself.
         ExceptionCallbackType eventType;
         std::string excModule;
@@ -534,9 +647,17 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::Exception(ICorDebugAppDomain *pAppDom
             break;
         }
 
+        // Filter exception directly in callback thread, most exceptions don't need stop event (for example, with "user-unhandled"
+        // filter only) and could be continued without callbacks worker thread handoff.
+        // Note, in case of pending application update, callbacks worker must be reached (see CallbacksWorkerException()).
+        if (m_debugger.m_sharedBreakpoints->ManagedCallbackExceptionFilter(pThread, eventType, excModule) != S_FALSE &&
+            !m_debugger.m_sharedBreakpoints->IsApplicationReloadPending())
+            return false;
+
         pAppDomain->AddRef();
         pThread->AddRef();
-        m_sharedCallbacksQueue->EmplaceBack(CallbackQueueCall::Exception, pAppDomain, pThread, nullptr, STEP_NORMAL, eventType, excModule);
+        m_sharedCallbacksQueue->EmplaceBack(CallbackQueueCall::Exception, pAppDomain, pThread, nullptr, STEP_NORMAL, excModule);
+        return true;
     });
 }
 
@@ -544,18 +665,21 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ExceptionUnwind(ICorDebugAppDomain *p
                                                            CorDebugExceptionUnwindCallbackType dwEventType, DWORD dwFlags)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::FunctionRemapComplete(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugFunction *pFunction)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::MDANotification(ICorDebugController *pController, ICorDebugThread *pThread, ICorDebugMDA *pMDA)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     ToRelease<ICorDebugProcess> iCorProcess;
     pThread->GetProcess(&iCorProcess);
     return m_sharedCallbacksQueue->ContinueProcess(iCorProcess);
@@ -567,9 +691,37 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::MDANotification(ICorDebugController *
 HRESULT STDMETHODCALLTYPE ManagedCallback::CustomNotification(ICorDebugThread *pThread, ICorDebugAppDomain *pAppDomain)
 {
     LogFuncEntry();
+    TraceCallbackEntry();
     m_debugger.m_sharedEvalWaiter->ManagedCallbackCustomNotification(pThread);
     pAppDomain->Continue(0); // Eval-related routine - ignore callbacks queue, continue process execution.
     return S_OK;
 }
 
+// ICorDebugManagedCallback4
+
+// Note, GC notifications are enabled only in case managed fields are watched by data breakpoints.
+HRESULT STDMETHODCALLTYPE ManagedCallback::BeforeGarbageCollection(ICorDebugProcess *pProcess)
+{
+    LogFuncEntry();
+    TraceCallbackEntry();
+    m_debugger.ManagedCallbackGarbageCollection(true);
+    return m_sharedCallbacksQueue->ContinueProcess(pProcess);
+}
+
+HRESULT STDMETHODCALLTYPE ManagedCallback::AfterGarbageCollection(ICorDebugProcess *pProcess)
+{
+    LogFuncEntry();
+    TraceCallbackEntry();
+    m_debugger.ManagedCallbackGarbageCollection(false);
+    return m_sharedCallbacksQueue->ContinueProcess(pProcess);
+}
+
+// Note, runtime's data breakpoints are Windows only, data breakpoints are implemented by interop debugger.
+HRESULT STDMETHODCALLTYPE ManagedCallback::DataBreakpoint(ICorDebugProcess *pProcess, ICorDebugThread *pThread, BYTE *pContext, ULONG32 contextSize)
+{
+    LogFuncEntry();
+    TraceCallbackEntry();
+    return m_sharedCallbacksQueue->ContinueProcess(pProcess);
+}
+
 } // namespace netcoredbg
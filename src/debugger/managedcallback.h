@@ -11,7 +11,7 @@
 namespace netcoredbg
 {
 
-class ManagedCallback final : public ICorDebugManagedCallback, ICorDebugManagedCallback2, ICorDebugManagedCallback3
+class ManagedCallback final : public ICorDebugManagedCallback, ICorDebugManagedCallback2, ICorDebugManagedCallback3, ICorDebugManagedCallback4
 {
 private:
 
@@ -83,6 +83,12 @@ public:
     // ICorDebugManagedCallback3
 
     HRESULT STDMETHODCALLTYPE CustomNotification(ICorDebugThread *pThread, ICorDebugAppDomain *pAppDomain) override;
+
+    // ICorDebugManagedCallback4
+
+    HRESULT STDMETHODCALLTYPE BeforeGarbageCollection(ICorDebugProcess *pProcess) override;
+    HRESULT STDMETHODCALLTYPE AfterGarbageCollection(ICorDebugProcess *pProcess) override;
+    HRESULT STDMETHODCALLTYPE DataBreakpoint(ICorDebugProcess *pProcess, ICorDebugThread *pThread, BYTE *pContext, ULONG32 contextSize) override;
 };
 
 } // namespace netcoredbg
@@ -13,7 +13,11 @@
 #include <stdexcept>
 #include <vector>
 #include <map>
+#include <algorithm>
+#include <unordered_set>
 #include <fstream>
+#include <future>
+#include <atomic>
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -34,21 +38,37 @@
 #include "debugger/breakpoint_interop_rendezvous.h"
 #include "debugger/breakpoints_interop.h"
 #include "debugger/breakpoints_interop_line.h"
+#include "debugger/breakpoints_interop_data.h"
 #include "debugger/breakpoints.h"
+#include "debugger/breakpointutils.h"
+#include "debugger/heap_walk.h"
+#include "debugger/il_call_sites.h"
 #include "debugger/hotreloadhelpers.h"
 #include "debugger/manageddebugger.h"
 #include "debugger/managedcallback.h"
+#include "debugger/managed_field_watches.h"
 #include "debugger/callbacksqueue.h"
+#include "debugger/dumptarget.h"
+#include "debugger/sampling_profiler.h"
+#include "debugger/async_stack.h"
+#include "debugger/task_groups.h"
 #include "debugger/stepper_simple.h"
 #include "debugger/stepper_async.h"
 #include "debugger/steppers.h"
+#include "debugger/stepstats.h"
+#include "debugger/triage_snapshot.h"
+#include "debugger/valueprint.h"
 #include "managed/interop.h"
 #include "metadata/interop_libraries.h"
+#include "utils/cancellation.h"
 #include "utils/utf.h"
 #include "utils/dynlibs.h"
 #include "metadata/modules.h"
 #include "metadata/typeprinter.h"
+#include "metadata/wellknown_types.h"
 #include "utils/logger.h"
+#include "utils/perfcounters.h"
+#include "utils/sequenced_executor.h"
 #include "debugger/waitpid.h"
 #include "utils/iosystem.h"
 
@@ -76,6 +96,16 @@ namespace
 {
     const auto startupWaitTimeout = std::chrono::milliseconds(5000);
 
+    // Hot Reload stages time, see HotReloadApplyDeltas().
+    PerfCounters::Counter hotReloadApplyChangesTimeCounter("hotReloadApplyChangesTimeUs");
+    PerfCounters::Counter hotReloadPdbDeltaLoadTimeCounter("hotReloadPdbDeltaLoadTimeUs");
+    PerfCounters::Counter hotReloadSymbolsUpdateTimeCounter("hotReloadSymbolsUpdateTimeUs");
+    PerfCounters::Counter hotReloadApplicationUpdateTimeCounter("hotReloadApplicationUpdateTimeUs");
+
+    // Note, process start substitutes standard files and changes working directory of debugger process,
+    // so, in case few sessions served at once (see `--max-sessions`), processes must be started one by one.
+    std::mutex processStartMutex;
+
     const std::string envDOTNET_STARTUP_HOOKS = "DOTNET_STARTUP_HOOKS";
 #ifdef FEATURE_PAL
     const char delimiterDOTNET_STARTUP_HOOKS = ':';
@@ -107,6 +137,26 @@ namespace
 
         return 0;
     }
+
+    // In non-stop mode, stop process during stopped threads inspection (stack trace, variables, evaluation).
+    class InspectionScope
+    {
+    public:
+
+        InspectionScope(bool nonStop, CallbacksQueue *pQueue, ICorDebugProcess *pProcess) :
+            m_pQueue(nonStop && pQueue && pQueue->BeginInspection(pProcess) == S_OK ? pQueue : nullptr)
+        {}
+
+        ~InspectionScope()
+        {
+            if (m_pQueue)
+                m_pQueue->EndInspection();
+        }
+
+    private:
+
+        CallbacksQueue *m_pQueue;
+    };
 }
 
 // Caller must care about m_debugProcessRWLock.
@@ -158,6 +208,26 @@ void ManagedDebuggerBase::DisableAllBreakpointsAndSteppers()
 void ManagedDebuggerBase::SetLastStoppedThread(ICorDebugThread *pThread)
 {
     SetLastStoppedThreadId(getThreadId(pThread));
+    PrefetchSourceLinkSources(pThread);
+}
+
+// Note, called at stop, process is stopped, so, frames could be walked directly (stack trace is not requested by client yet).
+void ManagedDebuggerBase::PrefetchSourceLinkSources(ICorDebugThread *pThread)
+{
+    unsigned framesCount = m_sharedModules->GetSourceLinkPrefetchFrames();
+    ToRelease<ICorDebugFrame> pFrame;
+    if (framesCount == 0 || FAILED(pThread->GetActiveFrame(&pFrame)))
+        return;
+
+    for (unsigned i = 0; i < framesCount && pFrame != nullptr; i++)
+    {
+        m_sharedModules->PrefetchSourceLinkSource(pFrame);
+
+        ICorDebugFrame *pCaller = nullptr;
+        if (FAILED(pFrame->GetCaller(&pCaller)))
+            break;
+        pFrame = pCaller;
+    }
 }
 
 void ManagedDebuggerBase::SetLastStoppedThreadId(ThreadId threadId)
@@ -165,6 +235,10 @@ void ManagedDebuggerBase::SetLastStoppedThreadId(ThreadId threadId)
     std::lock_guard<std::mutex> lock(m_lastStoppedMutex);
     m_lastStoppedThreadId = threadId;
 
+    // Note, "run to cursor" or "step into target" temporary breakpoint is removed at any debuggee stop.
+    if (threadId != ThreadId::AllThreads)
+        m_sharedBreakpoints->DeleteTemporaryBreakpoint();
+
     std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
 
     m_sharedBreakpoints->SetLastStoppedIlOffset(m_iCorProcess, m_lastStoppedThreadId);
@@ -175,6 +249,16 @@ void ManagedDebuggerBase::InvalidateLastStoppedThreadId()
     SetLastStoppedThreadId(ThreadId::AllThreads);
 }
 
+void ManagedDebuggerBase::InvalidateStackTraceCache()
+{
+    InvalidateFramesCache();
+    m_uniqueAsyncStack->InvalidateCache();
+
+    std::lock_guard<std::mutex> lock(m_stackTraceCacheMutex);
+    m_stackTraceCache.clear();
+    m_stackTraceCacheGeneration++;
+}
+
 ThreadId ManagedDebugger::GetLastStoppedThreadId()
 {
     LogFuncEntry();
@@ -186,6 +270,9 @@ ThreadId ManagedDebugger::GetLastStoppedThreadId()
 ManagedDebuggerBase::ManagedDebuggerBase(IProtocol *pProtocol_) :
     m_processAttachedState(ProcessAttachedState::Unattached),
     m_lastStoppedThreadId(ThreadId::AllThreads),
+    m_stackTraceCacheGeneration(0),
+    m_stepInTargetsThreadId(ThreadId::AllThreads),
+    m_stepInTargetsGeneration(0),
     m_startMethod(StartNone),
     m_isConfigurationDone(false),
     pProtocol(pProtocol_),
@@ -200,22 +287,34 @@ ManagedDebuggerBase::ManagedDebuggerBase(IProtocol *pProtocol_) :
     m_sharedBreakpoints(new Breakpoints(m_sharedModules, m_sharedEvaluator, m_sharedEvalHelpers, m_sharedVariables)),
     m_sharedCallbacksQueue(nullptr),
     m_uniqueManagedCallback(nullptr),
+    m_uniqueSamplingProfiler(new SamplingProfiler(m_sharedModules)),
+    m_uniqueAsyncStack(new AsyncStack(m_sharedModules)),
+    m_uniqueManagedFieldWatches(new ManagedFieldWatches),
+    m_uniqueLoadModuleExecutor(new SequencedExecutor("LoadModuleWorker")),
 #ifdef INTEROP_DEBUGGING
     m_sharedInteropDebugger(new InteropDebugging::InteropDebugger(pProtocol, m_sharedBreakpoints, m_sharedEvalWaiter)),
 #endif // INTEROP_DEBUGGING
     m_justMyCode(true),
     m_stepFiltering(true),
+    m_deferredJMC(false),
     m_hotReload(false),
     m_interopDebugging(false),
+    m_nonStop(false),
     m_unregisterToken(nullptr),
     m_processId(0),
     m_ioredirect(
         { IOSystem::unnamed_pipe(), IOSystem::unnamed_pipe(), IOSystem::unnamed_pipe() },
         std::bind(&ManagedDebugger::InputCallback, this, std::placeholders::_1, std::placeholders::_2)
-    )
+    ),
+    m_symbolsIdleExit(false)
 {
     m_sharedEvalStackMachine->SetupEval(m_sharedEvaluator, m_sharedEvalHelpers, m_sharedEvalWaiter);
     m_sharedThreads->SetEvaluator(m_sharedEvaluator);
+    m_sharedModules->SetSymbolsDownloadedCallback([this](const Module &module)
+    {
+        pProtocol->EmitModuleEvent(ModuleEvent(ModuleChanged, module));
+        EmitNewLoadedSources();
+    });
 #ifdef INTEROP_DEBUGGING
     // Note, we don't care about m_interopDebugging here, since m_interopDebugging could be changed with env parsing before real start/attach.
     m_sharedEvalWaiter->SetInteropDebugger(m_sharedInteropDebugger);
@@ -232,10 +331,21 @@ ManagedDebugger::ManagedDebugger(IProtocol *pProtocol_) :
 
 ManagedDebuggerBase::~ManagedDebuggerBase()
 {
+    m_uniqueSamplingProfiler->Stop();
+
+    {
+        std::lock_guard<std::mutex> lock(m_symbolsIdleMutex);
+        m_symbolsIdleExit = true;
+        m_symbolsIdleCV.notify_all();
+    }
+    if (m_symbolsIdleWorker.joinable())
+        m_symbolsIdleWorker.join();
+
 #ifdef INTEROP_DEBUGGING
     // Note, we don't care about m_interopDebugging here, since m_interopDebugging could be changed with env parsing before real start/attach.
     m_sharedEvalWaiter->ResetInteropDebugger();
 #endif // INTEROP_DEBUGGING
+    m_sharedModules->SetSymbolsDownloadedCallback(nullptr);
     m_sharedThreads->ResetEvaluator();
     m_sharedEvalStackMachine->ResetEval();
 }
@@ -253,6 +363,7 @@ HRESULT ManagedDebugger::Initialize()
 HRESULT ManagedDebuggerHelpers::RunIfReady()
 {
     FrameId::invalidate();
+    InvalidateStackTraceCache();
 
     if (m_startMethod == StartNone || !m_isConfigurationDone)
         return S_OK;
@@ -263,6 +374,8 @@ HRESULT ManagedDebuggerHelpers::RunIfReady()
             return RunProcess(m_execPath, m_execArgs);
         case StartAttach:
             return AttachToProcess();
+        case StartDump:
+            return S_OK; // Dump is opened at OpenDump() call, no process start.
         default:
             return E_FAIL;
     }
@@ -280,6 +393,14 @@ HRESULT ManagedDebugger::Attach(int pid)
     return RunIfReady();
 }
 
+HRESULT ManagedDebugger::OpenDump(const std::string &dumpPath)
+{
+    LogFuncEntry();
+
+    m_startMethod = StartDump;
+    return OpenDumpProcess(dumpPath);
+}
+
 HRESULT ManagedDebugger::Launch(const std::string &fileExec, const std::vector<std::string> &execArgs,
                                 const std::map<std::string, std::string> &env, const std::string &cwd, bool stopAtEntry)
 {
@@ -300,6 +421,10 @@ HRESULT ManagedDebugger::ConfigurationDone()
 
     m_isConfigurationDone = true;
 
+    // Note, first expression evaluation (watch, hover, conditional breakpoint) loads Roslyn, do this in advance,
+    // when startup sequence is done and debuggee is starting.
+    Interop::WarmUpExpressionCompiler();
+
     return RunIfReady();
 }
 
@@ -319,6 +444,12 @@ HRESULT ManagedDebugger::Disconnect(DisconnectAction action)
                 case StartAttach:
                     terminate = false;
                     break;
+                case StartDump:
+                    // Note, dump have no process for detach or terminate, just free all dump related objects.
+                    NotifyProcessExited();
+                    Cleanup();
+                    pProtocol->EmitTerminatedEvent();
+                    return S_OK;
                 default:
                     return E_FAIL;
             }
@@ -338,6 +469,9 @@ HRESULT ManagedDebugger::Disconnect(DisconnectAction action)
             return E_FAIL;
     }
 
+    // Note, sampling must not stop/continue process during detach or terminate.
+    m_uniqueSamplingProfiler->Stop();
+
 #ifdef INTEROP_DEBUGGING
     if (m_interopDebugging)
         m_sharedInteropDebugger->Shutdown();
@@ -363,6 +497,7 @@ HRESULT ManagedDebugger::StepCommand(ThreadId threadId, StepType stepType)
     std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
     HRESULT Status;
     IfFailRet(CheckDebugProcess());
+    IfFailRet(CheckNotDump());
 
     if (m_sharedEvalWaiter->IsEvalRunning())
     {
@@ -371,19 +506,36 @@ HRESULT ManagedDebugger::StepCommand(ThreadId threadId, StepType stepType)
         return E_UNEXPECTED;
     }
 
+    if (m_nonStop)
+    {
+        InvalidateStackTraceCache();
+        Status = m_sharedCallbacksQueue->NonStopContinue(m_iCorProcess, threadId, [&](ICorDebugThread *pThread)
+        {
+            // Note, runtime use JMC statuses for stepping, all deferred statuses must be applied before stepper setup.
+            m_sharedModules->ApplyDeferredJMC();
+            return m_uniqueSteppers->SetupStep(pThread, stepType);
+        });
+        if (Status != S_FALSE)
+            return Status;
+    }
+
     if (m_sharedCallbacksQueue->IsRunning())
     {
         LOGW("Can't 'Step', process already running.");
         return E_FAIL;
     }
 
+    // Note, runtime use JMC statuses for stepping, all deferred statuses must be applied before stepper setup.
+    m_sharedModules->ApplyDeferredJMC();
+
     ToRelease<ICorDebugThread> pThread;
     IfFailRet(m_iCorProcess->GetThread(int(threadId), &pThread));
     IfFailRet(m_uniqueSteppers->SetupStep(pThread, stepType));
 
     m_sharedVariables->Clear(); // Important, must be sync with MIProtocol m_vars.clear()
     FrameId::invalidate(); // Clear all created during break frames.
-    pProtocol->EmitContinuedEvent(threadId); // VSCode protocol need thread ID.
+    InvalidateStackTraceCache();
+    pProtocol->EmitContinuedEvent(threadId, true); // VSCode protocol need thread ID.
 
     // Note, process continue must be after event emitted, since we could get new stop event from queue here.
     if (FAILED(Status = m_sharedCallbacksQueue->Continue(m_iCorProcess)))
@@ -399,6 +551,7 @@ HRESULT ManagedDebugger::Continue(ThreadId threadId)
     std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
     HRESULT Status;
     IfFailRet(CheckDebugProcess());
+    IfFailRet(CheckNotDump());
 
     if (m_sharedEvalWaiter->IsEvalRunning())
     {
@@ -407,6 +560,14 @@ HRESULT ManagedDebugger::Continue(ThreadId threadId)
         return E_UNEXPECTED;
     }
 
+    if (m_nonStop)
+    {
+        InvalidateStackTraceCache();
+        Status = m_sharedCallbacksQueue->NonStopContinue(m_iCorProcess, threadId, nullptr);
+        if (Status != S_FALSE)
+            return Status;
+    }
+
     if (m_sharedCallbacksQueue->IsRunning())
     {
         LOGI("Can't 'Continue', process already running.");
@@ -415,7 +576,8 @@ HRESULT ManagedDebugger::Continue(ThreadId threadId)
 
     m_sharedVariables->Clear(); // Important, must be sync with MIProtocol m_vars.clear()
     FrameId::invalidate(); // Clear all created during break frames.
-    pProtocol->EmitContinuedEvent(threadId); // VSCode protocol need thread ID.
+    InvalidateStackTraceCache();
+    pProtocol->EmitContinuedEvent(threadId, true); // VSCode protocol need thread ID.
 
     // Note, process continue must be after event emitted, since we could get new stop event from queue here.
     if (FAILED(Status = m_sharedCallbacksQueue->Continue(m_iCorProcess)))
@@ -424,6 +586,236 @@ HRESULT ManagedDebugger::Continue(ThreadId threadId)
     return Status;
 }
 
+HRESULT ManagedDebugger::RunToLine(ThreadId threadId, const std::string &filename, int linenum)
+{
+    LogFuncEntry();
+
+    {
+        std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+        HRESULT Status;
+        IfFailRet(CheckDebugProcess());
+        IfFailRet(CheckNotDump());
+
+        if (!m_nonStop && m_sharedCallbacksQueue->IsRunning())
+        {
+            LOGW("Can't 'Run to line', process already running.");
+            return E_FAIL;
+        }
+
+        // Note, breakpoints in not user code are filtered by JMC status.
+        m_sharedModules->ApplyDeferredJMC();
+        IfFailRet(m_sharedBreakpoints->SetTemporaryBreakpoint(filename, linenum));
+    }
+
+    // Note, Continue() take m_debugProcessRWLock reader lock by itself.
+    HRESULT Status = Continue(threadId);
+    if (FAILED(Status))
+        m_sharedBreakpoints->DeleteTemporaryBreakpoint();
+
+    return Status;
+}
+
+// Resolve called method token to method definition in same module, calls of methods from other modules are not resolved.
+static HRESULT ResolveCallTarget(IMetaDataImport *pMD, mdToken token, mdMethodDef &methodDef)
+{
+    HRESULT Status;
+    if (TypeFromToken(token) == mdtMethodSpec)
+    {
+        ToRelease<IMetaDataImport2> pMD2;
+        IfFailRet(pMD->QueryInterface(IID_IMetaDataImport2, (LPVOID*) &pMD2));
+        IfFailRet(pMD2->GetMethodSpecProps(token, &token, nullptr, nullptr));
+    }
+
+    if (TypeFromToken(token) == mdtMethodDef)
+    {
+        methodDef = token;
+        return S_OK;
+    }
+
+    if (TypeFromToken(token) != mdtMemberRef)
+        return E_FAIL;
+
+    mdToken parent = mdTokenNil;
+    WCHAR name[mdNameLen];
+    ULONG nameLen = 0;
+    PCCOR_SIGNATURE pSig = nullptr;
+    ULONG sigSize = 0;
+    IfFailRet(pMD->GetMemberRefProps(token, &parent, name, _countof(name), &nameLen, &pSig, &sigSize));
+
+    // Note, methods of generic types are called by member reference to instantiated type (type spec).
+    if (TypeFromToken(parent) == mdtTypeSpec)
+    {
+        PCCOR_SIGNATURE pSpecSig = nullptr;
+        ULONG specSigSize = 0;
+        IfFailRet(pMD->GetTypeSpecFromToken(parent, &pSpecSig, &specSigSize));
+        ULONG elementType = 0;
+        pSpecSig += CorSigUncompressData(pSpecSig, &elementType);
+        if (elementType != ELEMENT_TYPE_GENERICINST)
+            return E_FAIL;
+        pSpecSig += CorSigUncompressData(pSpecSig, &elementType); // ELEMENT_TYPE_CLASS or ELEMENT_TYPE_VALUETYPE
+        CorSigUncompressToken(pSpecSig, &parent);
+    }
+
+    if (TypeFromToken(parent) != mdtTypeDef)
+        return E_FAIL;
+
+    return pMD->FindMethod(parent, name, pSig, sigSize, &methodDef);
+}
+
+HRESULT ManagedDebugger::GetStepInTargets(FrameId frameId, std::vector<StepInTarget> &targets)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+
+    if (m_sharedCallbacksQueue->IsRunning())
+    {
+        LOGW("Can't get step into targets, process is running.");
+        return E_FAIL;
+    }
+
+    targets.clear();
+    ThreadId threadId = frameId.getThread();
+
+    unsigned generation;
+    {
+        std::lock_guard<std::mutex> lock(m_stackTraceCacheMutex);
+        generation = m_stackTraceCacheGeneration;
+    }
+
+    std::lock_guard<std::mutex> lock(m_stepInTargetsMutex);
+    m_stepInTargets.clear();
+    m_stepInTargetsThreadId = threadId;
+    m_stepInTargetsGeneration = generation;
+
+    // Note, step into target is step over with additional breakpoint, so, only top frame calls could be targets.
+    if (frameId.getLevel() != FrameLevel(0))
+        return S_OK;
+
+    ToRelease<ICorDebugThread> pThread;
+    IfFailRet(m_iCorProcess->GetThread(int(threadId), &pThread));
+    ToRelease<ICorDebugFrame> pFrame;
+    IfFailRet(pThread->GetActiveFrame(&pFrame));
+    if (pFrame == nullptr)
+        return E_FAIL;
+
+    COR_DEBUG_STEP_RANGE range;
+    IfFailRet(m_sharedModules->GetStepRangeFromCurrentIP(pThread, &range));
+
+    ToRelease<ICorDebugILFrame> pILFrame;
+    IfFailRet(pFrame->QueryInterface(IID_ICorDebugILFrame, (LPVOID*) &pILFrame));
+    ULONG32 ilOffset;
+    CorDebugMappingResult mappingResult;
+    IfFailRet(pILFrame->GetIP(&ilOffset, &mappingResult));
+
+    ToRelease<ICorDebugFunction> pFunc;
+    IfFailRet(pFrame->GetFunction(&pFunc));
+    ToRelease<ICorDebugCode> pCode;
+    IfFailRet(pFunc->GetILCode(&pCode));
+    ULONG32 codeSize = 0;
+    IfFailRet(pCode->GetSize(&codeSize));
+    std::vector<uint8_t> code(codeSize);
+    ULONG32 fetched = 0;
+    IfFailRet(pCode->GetCode(0, codeSize, codeSize, code.data(), &fetched));
+    code.resize(fetched);
+
+    // Note, calls before current IP at this line were already executed.
+    std::vector<ILCallSites::call_site_t> calls;
+    if (!ILCallSites::Find(code, range.startOffset, range.endOffset, calls))
+        return E_FAIL;
+
+    ToRelease<ICorDebugModule> pModule;
+    IfFailRet(pFunc->GetModule(&pModule));
+    ToRelease<IUnknown> pMDUnknown;
+    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+    ToRelease<IMetaDataImport> pMD;
+    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
+
+    std::unordered_set<mdMethodDef> added;
+    for (const auto &call : calls)
+    {
+        mdMethodDef methodToken = mdMethodDefNil;
+        if (call.ilOffset < ilOffset ||
+            FAILED(ResolveCallTarget(pMD, call.methodToken, methodToken)) ||
+            !added.insert(methodToken).second)
+            continue;
+
+        // Note, in case of async method, user code is in state machine `MoveNext()` method, not in kickoff method.
+        mdMethodDef targetToken = methodToken;
+        mdMethodDef moveNextToken = mdMethodDefNil;
+        if (SUCCEEDED(m_sharedModules->GetStateMachineMethod(pModule, methodToken, moveNextToken)))
+            targetToken = moveNextToken;
+
+        ToRelease<ICorDebugFunction> pTargetFunc;
+        ULONG32 targetVersion = 0;
+        ULONG32 targetILOffset = 0;
+        if (FAILED(Status = BreakpointUtils::SkipBreakpoint(pModule, targetToken, m_justMyCode)) || Status == S_OK || // S_FALSE - don't skip
+            FAILED(pModule->GetFunctionFromToken(targetToken, &pTargetFunc)) ||
+            FAILED(pTargetFunc->GetCurrentVersionNumber(&targetVersion)) ||
+            FAILED(m_sharedModules->GetNextUserCodeILOffsetInMethod(pModule, targetToken, targetVersion, 0, targetILOffset)))
+            continue;
+
+        std::string label;
+        if (call.newObj)
+        {
+            mdTypeDef classToken = mdTypeDefNil;
+            if (FAILED(pMD->GetMethodProps(methodToken, &classToken, nullptr, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr)) ||
+                FAILED(TypePrinter::NameForTypeDef(classToken, pMD, label, nullptr)))
+                continue;
+            label = "new " + label;
+        }
+        else if (FAILED(TypePrinter::NameForToken(methodToken, pMD, label, true, nullptr)))
+        {
+            continue;
+        }
+
+        pModule->AddRef();
+        m_stepInTargets.emplace_back(pModule.GetPtr(), targetToken, targetILOffset);
+        targets.emplace_back(int(m_stepInTargets.size()), label);
+    }
+
+    return S_OK;
+}
+
+HRESULT ManagedDebugger::StepIntoTarget(ThreadId threadId, int targetId)
+{
+    LogFuncEntry();
+
+    {
+        std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+        HRESULT Status;
+        IfFailRet(CheckDebugProcess());
+        IfFailRet(CheckNotDump());
+
+        unsigned generation;
+        {
+            std::lock_guard<std::mutex> lock(m_stackTraceCacheMutex);
+            generation = m_stackTraceCacheGeneration;
+        }
+
+        std::lock_guard<std::mutex> lock(m_stepInTargetsMutex);
+        if (m_stepInTargetsGeneration != generation || m_stepInTargetsThreadId != threadId ||
+            targetId <= 0 || targetId > (int)m_stepInTargets.size())
+        {
+            LOGE("Step into target error, no target with ID %i for thread %i", targetId, int(threadId));
+            return E_INVALIDARG;
+        }
+
+        const StepInTargetEntry &target = m_stepInTargets[targetId - 1];
+        IfFailRet(m_sharedBreakpoints->SetTemporaryBreakpoint(target.iCorModule, target.methodToken, target.ilOffset));
+    }
+
+    // Note, in case target method is not called at this line, step over stop at next line and remove temporary breakpoint.
+    // StepCommand() take m_debugProcessRWLock reader lock by itself.
+    HRESULT Status = StepCommand(threadId, StepType::STEP_OVER);
+    if (FAILED(Status))
+        m_sharedBreakpoints->DeleteTemporaryBreakpoint();
+
+    return Status;
+}
+
 HRESULT ManagedDebugger::Pause(ThreadId lastStoppedThread, EventFormat eventFormat)
 {
     LogFuncEntry();
@@ -431,11 +823,20 @@ HRESULT ManagedDebugger::Pause(ThreadId lastStoppedThread, EventFormat eventForm
     std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
     HRESULT Status;
     IfFailRet(CheckDebugProcess());
+    IfFailRet(CheckNotDump());
+
+    // Note, in non-stop mode only requested thread is paused, in case of "all threads" request process is paused.
+    if (m_nonStop && lastStoppedThread != ThreadId::AllThreads)
+    {
+        IfFailRet(m_sharedCallbacksQueue->NonStopPause(m_iCorProcess, lastStoppedThread));
+        if (Status == S_OK)
+            return S_OK;
+    }
 
     return m_sharedCallbacksQueue->Pause(m_iCorProcess, lastStoppedThread, eventFormat);
 }
 
-HRESULT ManagedDebugger::GetThreads(std::vector<Thread> &threads, bool withNativeThreads)
+HRESULT ManagedDebugger::GetThreads(std::vector<Thread> &threads, bool withNativeThreads, bool refreshNativeNames)
 {
     LogFuncEntry();
 
@@ -445,8 +846,9 @@ HRESULT ManagedDebugger::GetThreads(std::vector<Thread> &threads, bool withNativ
 
 #ifdef INTEROP_DEBUGGING
     if (m_interopDebugging && withNativeThreads)
-        return m_sharedThreads->GetInteropThreadsWithState(m_iCorProcess, m_sharedInteropDebugger.get(), threads);
+        return m_sharedThreads->GetInteropThreadsWithState(m_iCorProcess, m_sharedInteropDebugger.get(), threads, refreshNativeNames);
 #endif // INTEROP_DEBUGGING
+    (void)refreshNativeNames;
     return m_sharedThreads->GetThreadsWithState(m_iCorProcess, threads);
 }
 
@@ -519,9 +921,12 @@ static HRESULT EnumerateCLRs(dbgshim_t &dbgshim, DWORD pid, HANDLE **ppHandleArr
         if (hr == E_INVALIDARG || hr == E_FAIL)
             return hr;
 
+        // Note, don't sleep after last attempt.
+        if (++numTries == tryCount)
+            break;
+
         // Sleep and retry enumerating the runtimes
         USleep(100*1000);
-        numTries++;
 
         // if (m_canceled)
         // {
@@ -535,12 +940,43 @@ static HRESULT EnumerateCLRs(dbgshim_t &dbgshim, DWORD pid, HANDLE **ppHandleArr
     return hr;
 }
 
+#ifdef __linux__
+// Find already loaded libcoreclr.so in process mappings, this is single file read without dbgshim's
+// startup events handles creation and without retries.
+static std::string GetCLRPathFromProcessMaps(DWORD pid)
+{
+    static const std::string coreclrName = "/libcoreclr.so";
+
+    std::ifstream mapsFile("/proc/" + std::to_string(pid) + "/maps");
+    std::string line;
+    while (std::getline(mapsFile, line))
+    {
+        // Line format: "start-end perms offset dev inode pathname".
+        if (line.size() <= coreclrName.size() ||
+            line.compare(line.size() - coreclrName.size(), coreclrName.size(), coreclrName) != 0)
+            continue;
+
+        const std::string::size_type pathPos = line.find('/');
+        if (pathPos != std::string::npos)
+            return line.substr(pathPos);
+    }
+
+    return std::string();
+}
+#endif // __linux__
+
 static std::string GetCLRPath(dbgshim_t &dbgshim, DWORD pid, int timeoutSec = 3)
 {
+#ifdef __linux__
+    std::string mapsResult = GetCLRPathFromProcessMaps(pid);
+    if (!mapsResult.empty())
+        return mapsResult;
+#endif // __linux__
+
     HANDLE* pHandleArray;
     LPWSTR* pStringArray;
     DWORD dwArrayLength;
-    const int tryCount = timeoutSec * 10; // 100ms interval between attempts
+    const int tryCount = timeoutSec > 0 ? timeoutSec * 10 : 1; // 100ms interval between attempts, at least one attempt
     if (FAILED(EnumerateCLRs(dbgshim, pid, &pHandleArray, &pStringArray, &dwArrayLength, tryCount)) || dwArrayLength == 0)
         return std::string();
 
@@ -723,6 +1159,8 @@ HRESULT ManagedDebuggerHelpers::RunProcess(const std::string& fileExec, const st
     }
 #endif INTEROP_DEBUGGING
 
+    std::unique_lock<std::mutex> lockProcessStart(processStartMutex);
+
     // cwd in launch.json set working directory for debugger https://code.visualstudio.com/docs/python/debugging#_cwd
     if (!m_cwd.empty())
     {
@@ -738,6 +1176,7 @@ HRESULT ManagedDebuggerHelpers::RunProcess(const std::string& fileExec, const st
                                      &m_processId, &resumeHandle));
             return Status;
         });
+    lockProcessStart.unlock();
 
     if (FAILED(Status))
         return Status;
@@ -777,6 +1216,11 @@ HRESULT ManagedDebuggerBase::CheckNoProcess()
     return S_OK;
 }
 
+HRESULT ManagedDebuggerBase::CheckNotDump()
+{
+    return m_startMethod == StartDump ? CORDBG_E_TARGET_READONLY : S_OK;
+}
+
 HRESULT ManagedDebuggerHelpers::DetachFromProcess()
 {
     do {
@@ -794,6 +1238,10 @@ HRESULT ManagedDebuggerHelpers::DetachFromProcess()
 
         DisableAllBreakpointsAndSteppers();
 
+        // Note, threads suspended by debugger in non-stop mode must be resumed, or they will stay suspended after detach.
+        if (m_nonStop && m_sharedCallbacksQueue)
+            m_sharedCallbacksQueue->NonStopContinue(m_iCorProcess, ThreadId::AllThreads, nullptr);
+
         HRESULT Status;
         if (FAILED(Status = m_iCorProcess->Detach()))
             LOGE("Process detach failed: %s", errormessage(Status));
@@ -839,14 +1287,29 @@ HRESULT ManagedDebuggerHelpers::TerminateProcess()
 
 void ManagedDebuggerBase::Cleanup()
 {
+    WaitLoadModuleTasks();
+    // Note, samples are kept for export after debug session end, but modules names are not available any more.
+    m_uniqueSamplingProfiler->Stop();
     m_sharedModules->CleanupAllModules();
     m_sharedEvalHelpers->Cleanup();
+    m_sharedEvaluator->Cleanup();
+    WellKnownTypes::Shutdown();
+    ClearValuePrintCache();
     m_sharedVariables->Clear(); // Important, must be sync with MIProtocol m_vars.clear()
+    m_sharedVariables->Cleanup();
+    m_uniqueManagedFieldWatches->Clear();
+    {
+        std::lock_guard<std::mutex> lock(m_dataBreakpointsMutex);
+        m_dataBreakpoints.clear();
+    }
+    InvalidateStackTraceCache();
     pProtocol->Cleanup();
 
     std::lock_guard<Utility::RWLock::Writer> guardProcessRWLock(m_debugProcessRWLock.writer);
 
+    // Note, dump process object is created without ICorDebug and managed callback.
     assert((m_iCorProcess && m_iCorDebug && m_uniqueManagedCallback && m_sharedCallbacksQueue) ||
+           (m_iCorProcess && m_uniqueDumpDataTarget && m_sharedCallbacksQueue) ||
            (!m_iCorProcess && !m_iCorDebug && !m_uniqueManagedCallback && !m_sharedCallbacksQueue));
 
     if (!m_iCorProcess)
@@ -854,15 +1317,26 @@ void ManagedDebuggerBase::Cleanup()
 
     m_iCorProcess.Free();
 
-    m_iCorDebug->Terminate();
-    m_iCorDebug.Free();
+    if (m_iCorDebug)
+    {
+        m_iCorDebug->Terminate();
+        m_iCorDebug.Free();
+    }
 
-    if (m_uniqueManagedCallback->GetRefCount() > 0)
+    if (m_uniqueManagedCallback && m_uniqueManagedCallback->GetRefCount() > 0)
     {
         LOGW("ManagedCallback was not properly released by ICorDebug");
     }
     m_uniqueManagedCallback.reset(nullptr);
     m_sharedCallbacksQueue = nullptr;
+
+    if (m_uniqueDumpDataTarget && m_uniqueDumpDataTarget->GetRefCount() > 0)
+    {
+        LOGW("Dump data target was not properly released by DBI");
+    }
+    m_uniqueDumpDataTarget.reset(nullptr);
+    m_uniqueDumpLibraryProvider.reset(nullptr);
+    m_sharedEvalWaiter->SetFuncEvalDisabled(false);
 }
 
 HRESULT ManagedDebuggerHelpers::AttachToProcess()
@@ -871,9 +1345,36 @@ HRESULT ManagedDebuggerHelpers::AttachToProcess()
 
     IfFailRet(CheckNoProcess());
 
-    m_clrPath = GetCLRPath(m_dbgshim, m_processId);
+    const auto attachStart = std::chrono::steady_clock::now();
+    auto elapsedMs = [&attachStart]() -> long long
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - attachStart).count();
+    };
+
+    // Note, only one dbgshim enumeration attempt, in case runtime is not loaded yet, don't poll with sleeps,
+    // but wait for runtime startup event from dbgshim, StartupCallback() will attach to process.
+    m_clrPath = GetCLRPath(m_dbgshim, m_processId, 0);
+    LOGI("Attach: CLR discovery %lld ms, %s", elapsedMs(), m_clrPath.empty() ? "runtime not loaded yet" : m_clrPath.c_str());
     if (m_clrPath.empty())
-        return E_INVALIDARG; // Unable to find libcoreclr.so
+    {
+        IfFailRet(m_dbgshim.RegisterForRuntimeStartup(m_processId, ManagedDebugger::StartupCallback, this, &m_unregisterToken));
+
+        std::unique_lock<std::mutex> lockAttachedMutex(m_processAttachedMutex);
+        if (!m_processAttachedCV.wait_for(lockAttachedMutex, startupWaitTimeout, [this]{return m_processAttachedState == ProcessAttachedState::Attached;}))
+        {
+            lockAttachedMutex.unlock();
+            if (m_unregisterToken)
+            {
+                m_dbgshim.UnregisterForRuntimeStartup(m_unregisterToken);
+                m_unregisterToken = nullptr;
+            }
+            LOGE("Attach: runtime startup wait failed after %lld ms", elapsedMs());
+            return E_INVALIDARG; // Unable to find libcoreclr.so
+        }
+
+        LOGI("Attach: attached on runtime startup in %lld ms", elapsedMs());
+        return S_OK;
+    }
 
     WCHAR pBuffer[100];
     DWORD dwLength;
@@ -887,6 +1388,7 @@ HRESULT ManagedDebuggerHelpers::AttachToProcess()
     ToRelease<IUnknown> pCordb;
 
     IfFailRet(m_dbgshim.CreateDebuggingInterfaceFromVersionEx(CorDebugVersion_4_0, pBuffer, &pCordb));
+    LOGI("Attach: debugging interface created in %lld ms", elapsedMs());
 
     m_unregisterToken = nullptr;
     IfFailRet(Startup(pCordb));
@@ -895,9 +1397,146 @@ HRESULT ManagedDebuggerHelpers::AttachToProcess()
     if (!m_processAttachedCV.wait_for(lockAttachedMutex, startupWaitTimeout, [this]{return m_processAttachedState == ProcessAttachedState::Attached;}))
         return E_FAIL;
 
+    LOGI("Attach: attached in %lld ms", elapsedMs());
+    return S_OK;
+}
+
+// CLSID_CLRDebugging from metahost.h, dbgshim's CLRCreateInstance() provide ICLRDebugging for this class only.
+static const GUID CLSID_CLRDebugging = { 0xbacc578d, 0xfbdd, 0x48a4, { 0x96, 0x9f, 0x02, 0xd9, 0x32, 0xb7, 0x46, 0x34 } };
+
+HRESULT ManagedDebuggerHelpers::OpenDumpProcess(const std::string &dumpPath)
+{
+    HRESULT Status;
+
+    IfFailRet(CheckNoProcess());
+
+    if (m_dbgshim.CLRCreateInstance == nullptr)
+    {
+        LOGE("Dump analysis is not supported, dbgshim don't provide CLRCreateInstance");
+        return E_NOTIMPL;
+    }
+
+    std::unique_ptr<DumpDataTarget> dataTarget(new DumpDataTarget());
+    IfFailRet(dataTarget->Open(dumpPath));
+
+    uint64_t clrBase = 0;
+    if (!dataTarget->GetDump().FindModuleBase("libcoreclr.so", clrBase, m_clrPath))
+    {
+        LOGE("Can't find libcoreclr.so in dump %s", dumpPath.c_str());
+        return E_INVALIDARG;
+    }
+    const std::string::size_type dirEnd = m_clrPath.rfind(DIRECTORY_SEPARATOR_STR_A);
+    std::unique_ptr<DumpLibraryProvider> libraryProvider(new DumpLibraryProvider(dirEnd == std::string::npos ? "." : m_clrPath.substr(0, dirEnd)));
+    LOGI("Dump: runtime %s at 0x%llx", m_clrPath.c_str(), (unsigned long long)clrBase);
+
+    ToRelease<ICLRDebugging> iCLRDebugging;
+    IfFailRet(m_dbgshim.CLRCreateInstance(CLSID_CLRDebugging, IID_ICLRDebugging, (LPVOID*)&iCLRDebugging));
+
+    CLR_DEBUGGING_VERSION maxDebuggerSupportedVersion;
+    maxDebuggerSupportedVersion.wStructVersion = 0;
+    maxDebuggerSupportedVersion.wMajor = 0xffff;
+    maxDebuggerSupportedVersion.wMinor = 0xffff;
+    maxDebuggerSupportedVersion.wBuild = 0xffff;
+    maxDebuggerSupportedVersion.wRevision = 0xffff;
+    CLR_DEBUGGING_VERSION version;
+    CLR_DEBUGGING_PROCESS_FLAGS flags;
+    ToRelease<IUnknown> pUnknown;
+    Status = iCLRDebugging->OpenVirtualProcess(clrBase, dataTarget.get(), libraryProvider.get(), &maxDebuggerSupportedVersion,
+                                               IID_ICorDebugProcess, &pUnknown, &version, &flags);
+    if (FAILED(Status))
+    {
+        LOGE("OpenVirtualProcess failed: %s", errormessage(Status));
+        return Status;
+    }
+
+    ToRelease<ICorDebugProcess> iCorProcess;
+    IfFailRet(pUnknown->QueryInterface(IID_ICorDebugProcess, (void **)&iCorProcess));
+
+    std::unique_lock<Utility::RWLock::Writer> lockProcessRWLock(m_debugProcessRWLock.writer);
+
+    m_iCorProcess = iCorProcess.Detach();
+    m_uniqueDumpDataTarget = std::move(dataTarget);
+    m_uniqueDumpLibraryProvider = std::move(libraryProvider);
+    // Note, there are no callbacks for dump, queue is used only for "process stopped" state tracking.
+    m_sharedCallbacksQueue.reset(new CallbacksQueue(*this));
+    m_sharedCallbacksQueue->MarkStopped();
+    m_sharedEvalWaiter->SetFuncEvalDisabled(true);
+
+    lockProcessRWLock.unlock();
+
+    NotifyProcessCreated();
+    LoadDumpModulesAndThreads();
+
+    const std::vector<CoreDump::Thread> &threads = m_uniqueDumpDataTarget->GetDump().Threads();
+    // Note, first thread in dump is thread that cause dump creation (crashed thread for createdump).
+    ThreadId threadId(threads.front().tid);
+    SetLastStoppedThreadId(threadId);
+    pProtocol->EmitStoppedEvent(StoppedEvent(StopPause, threadId));
     return S_OK;
 }
 
+// Note, dump have no debugger callbacks, so, all modules and threads are enumerated at dump open.
+void ManagedDebuggerHelpers::LoadDumpModulesAndThreads()
+{
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+
+    ToRelease<ICorDebugAppDomainEnum> domains;
+    if (SUCCEEDED(m_iCorProcess->EnumerateAppDomains(&domains)))
+    {
+        ICorDebugAppDomain *curDomain;
+        ULONG domainsFetched = 0;
+        while (SUCCEEDED(domains->Next(1, &curDomain, &domainsFetched)) && domainsFetched == 1)
+        {
+            ToRelease<ICorDebugAppDomain> pDomain(curDomain);
+            ToRelease<ICorDebugAssemblyEnum> assemblies;
+            if (FAILED(pDomain->EnumerateAssemblies(&assemblies)))
+                continue;
+
+            ICorDebugAssembly *curAssembly;
+            ULONG assembliesFetched = 0;
+            while (SUCCEEDED(assemblies->Next(1, &curAssembly, &assembliesFetched)) && assembliesFetched == 1)
+            {
+                ToRelease<ICorDebugAssembly> pAssembly(curAssembly);
+                ToRelease<ICorDebugModuleEnum> modules;
+                if (FAILED(pAssembly->EnumerateModules(&modules)))
+                    continue;
+
+                ICorDebugModule *curModule;
+                ULONG modulesFetched = 0;
+                while (SUCCEEDED(modules->Next(1, &curModule, &modulesFetched)) && modulesFetched == 1)
+                {
+                    ToRelease<ICorDebugModule> pModule(curModule);
+                    Module module;
+                    std::string outputText;
+                    m_sharedModules->TryLoadModuleSymbols(pModule, module, IsJustMyCode(), IsDeferredJMC(), false, outputText);
+                    if (!outputText.empty())
+                        pProtocol->EmitOutputEvent(OutputStdErr, outputText);
+                    pProtocol->EmitModuleEvent(ModuleEvent(ModuleNew, module));
+
+                    if (module.name == "System.Private.CoreLib.dll")
+                    {
+                        WellKnownTypes::Init(pModule);
+                        m_sharedEvalStackMachine->FindPredefinedTypes(pModule);
+                    }
+                }
+            }
+        }
+    }
+    EmitNewLoadedSources();
+
+    ToRelease<ICorDebugThreadEnum> threads;
+    if (FAILED(m_iCorProcess->EnumerateThreads(&threads)))
+        return;
+
+    ICorDebugThread *curThread;
+    ULONG threadsFetched = 0;
+    while (SUCCEEDED(threads->Next(1, &curThread, &threadsFetched)) && threadsFetched == 1)
+    {
+        ToRelease<ICorDebugThread> pThread(curThread);
+        m_sharedThreads->Add(getThreadId(pThread), true);
+    }
+}
+
 HRESULT ManagedDebugger::GetExceptionInfo(ThreadId threadId, ExceptionInfo &exceptionInfo)
 {
     LogFuncEntry();
@@ -905,6 +1544,7 @@ HRESULT ManagedDebugger::GetExceptionInfo(ThreadId threadId, ExceptionInfo &exce
     std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
     HRESULT Status;
     IfFailRet(CheckDebugProcess());
+    InspectionScope inspection(m_nonStop, m_sharedCallbacksQueue.get(), m_iCorProcess);
 
     ToRelease<ICorDebugThread> iCorThread;
     IfFailRet(m_iCorProcess->GetThread(int(threadId), &iCorThread));
@@ -917,19 +1557,127 @@ HRESULT ManagedDebugger::SetExceptionBreakpoints(const std::vector<ExceptionBrea
     return m_sharedBreakpoints->SetExceptionBreakpoints(exceptionBreakpoints, breakpoints);
 }
 
-HRESULT ManagedDebugger::UpdateLineBreakpoint(int id, int linenum, Breakpoint &breakpoint)
+HRESULT ManagedDebugger::SetDataBreakpoints(const std::vector<DataBreakpoint> &dataBreakpoints, std::vector<Breakpoint> &breakpoints)
 {
     LogFuncEntry();
 
-    bool haveProcess = HaveDebugProcess();
-    return m_sharedBreakpoints->UpdateLineBreakpoint(haveProcess, id, linenum, breakpoint);
-}
-
 #ifdef INTEROP_DEBUGGING
+    // Note, data breakpoints use hardware watchpoints through ptrace, so, debuggee process must be controlled by interop debugger.
+    if (m_interopDebugging)
+    {
+        std::lock_guard<std::mutex> lock(m_dataBreakpointsMutex);
+        m_dataBreakpoints = dataBreakpoints;
 
-static bool isNativeSource(const std::string &filename)
-{
-    // Detect native code breakpoint by extension:
+        std::unordered_set<uint32_t> fieldIds;
+        for (const auto &entry : dataBreakpoints)
+        {
+            if (entry.managedFieldId != 0)
+                fieldIds.insert(entry.managedFieldId);
+        }
+        m_uniqueManagedFieldWatches->Retain(fieldIds);
+
+        // Note, GC notifications stop process before and after each GC, enable them only in case managed fields are watched.
+        {
+            std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+            ToRelease<ICorDebugProcess8> iCorProcess8;
+            if (m_iCorProcess && SUCCEEDED(m_iCorProcess->QueryInterface(IID_ICorDebugProcess8, (LPVOID*) &iCorProcess8)))
+                iCorProcess8->EnableGCNotificationEvents(fieldIds.empty() ? FALSE : TRUE);
+        }
+
+        return ApplyDataBreakpoints(breakpoints);
+    }
+#endif // INTEROP_DEBUGGING
+
+    return dataBreakpoints.empty() ? S_OK : E_NOTIMPL;
+}
+
+HRESULT ManagedDebuggerBase::ApplyDataBreakpoints(std::vector<Breakpoint> &breakpoints)
+{
+#ifdef INTEROP_DEBUGGING
+    std::vector<DataBreakpoint> dataBreakpoints(m_dataBreakpoints);
+    for (auto &entry : dataBreakpoints)
+    {
+        uint32_t size = 0;
+        std::string name;
+        // Note, address is 0 in case object is moving by GC now or was collected, watchpoint is not set in this case.
+        if (entry.managedFieldId != 0 && !m_uniqueManagedFieldWatches->GetField(entry.managedFieldId, entry.address, size, name))
+            entry.address = 0;
+    }
+
+    return m_sharedInteropDebugger->SetDataBreakpoints(dataBreakpoints, breakpoints);
+#else
+    return m_dataBreakpoints.empty() ? S_OK : E_NOTIMPL;
+#endif // INTEROP_DEBUGGING
+}
+
+// Note, during GC objects are moved and other objects data could be written at watched address, so, managed fields
+// watchpoints are removed till GC end and set again at new objects addresses.
+void ManagedDebuggerBase::ManagedCallbackGarbageCollection(bool started)
+{
+    if (!m_interopDebugging || m_uniqueManagedFieldWatches->Empty())
+        return;
+
+    if (started)
+        m_uniqueManagedFieldWatches->Suspend();
+    else if (!m_uniqueManagedFieldWatches->Update())
+        return;
+
+    std::lock_guard<std::mutex> lock(m_dataBreakpointsMutex);
+    std::vector<Breakpoint> breakpoints;
+    if (FAILED(ApplyDataBreakpoints(breakpoints)))
+        LOGW("Could not update managed fields data breakpoints at GC");
+}
+
+HRESULT ManagedDebugger::GetFieldDataBreakpointInfo(uint32_t variablesReference, const std::string &name, DataBreakpoint &dataBreakpoint,
+                                                    std::string &description)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+
+    if (!m_interopDebugging)
+    {
+        description = "Data breakpoints require interop debugging mode.";
+        return S_FALSE;
+    }
+
+    ToRelease<ICorDebugValue> iCorObjectValue;
+    CORDB_ADDRESS fieldAddress = 0;
+    ULONG32 fieldSize = 0;
+    IfFailRet(m_sharedVariables->GetFieldLocation(m_iCorProcess, variablesReference, name, &iCorObjectValue, fieldAddress, fieldSize));
+    if (Status == S_FALSE)
+    {
+        description = "Data breakpoints are supported for instance fields of reference type objects only.";
+        return S_FALSE;
+    }
+
+    uint32_t id = 0;
+    if (FAILED(m_uniqueManagedFieldWatches->Add(iCorObjectValue, fieldAddress, fieldSize, name, id)))
+    {
+        description = "Could not track object of field '" + name + "'.";
+        return S_FALSE;
+    }
+
+    dataBreakpoint = DataBreakpoint((std::uintptr_t)fieldAddress, fieldSize, DataBreakpointAccess::Write, id);
+    description = name;
+    return S_OK;
+}
+
+HRESULT ManagedDebugger::UpdateLineBreakpoint(int id, int linenum, Breakpoint &breakpoint)
+{
+    LogFuncEntry();
+
+    bool haveProcess = HaveDebugProcess();
+    return m_sharedBreakpoints->UpdateLineBreakpoint(haveProcess, id, linenum, breakpoint);
+}
+
+#ifdef INTEROP_DEBUGGING
+
+static bool isNativeSource(const std::string &filename)
+{
+    // Detect native code breakpoint by extension:
     // https://gcc.gnu.org/onlinedocs/gcc-12.2.0/gcc/Overall-Options.html
     static std::unordered_set<std::string> fileExtension{"c", "C", "cc", "cp", "cxx", "cpp", "CPP", "c++",
                                                          "i", "ii", "m", "M", "mi", "mm", "mii",
@@ -1067,7 +1815,7 @@ HRESULT ManagedDebuggerBase::GetFrameLocation(ICorDebugFrame *pFrame, ThreadId t
     IfFailRet(pFrame->QueryInterface(IID_ICorDebugNativeFrame, (LPVOID*) &pNativeFrame));
     IfFailRet(pNativeFrame->GetIP(&nOffset));
 
-    IfFailRet(GetModuleId(pModule, stackFrame.moduleId));
+    IfFailRet(m_sharedModules->GetModuleIdCached(pModule, stackFrame.moduleId));
 
     stackFrame.clrAddr.methodToken = methodToken;
     stackFrame.clrAddr.ilOffset = ilOffset;
@@ -1086,7 +1834,48 @@ HRESULT ManagedDebuggerBase::GetFrameLocation(ICorDebugFrame *pFrame, ThreadId t
     return S_OK;
 }
 
-static std::string GetModuleNameForFrame(ICorDebugFrame *pFrame)
+static void GetAsyncFrameLocation(Modules *pModules, const AsyncStack::frame_t &asyncFrame, ThreadId threadId, FrameLevel level,
+                                  const char *prefix, StackFrame &stackFrame)
+{
+    std::string methodName;
+    stackFrame = StackFrame(threadId, level, "");
+    pModules->GetModuleInfo(asyncFrame.modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
+    {
+        stackFrame.moduleId = mdInfo.m_id;
+        stackFrame.moduleOrLibName = mdInfo.m_name;
+
+        HRESULT Status;
+        ToRelease<IUnknown> pMDUnknown;
+        ToRelease<IMetaDataImport> pMDImport;
+        IfFailRet(mdInfo.m_iCorModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+        IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMDImport));
+        return TypePrinter::NameForToken(asyncFrame.methodToken, pMDImport, methodName, true, nullptr);
+    });
+    // [Async] Namespace.Class.<Method>d__0.MoveNext(), same as physical frame of state machine.
+    stackFrame.methodName = prefix + (methodName.empty() ? std::string("?") : methodName + "()");
+
+    Modules::SequencePoint sp;
+    if (asyncFrame.haveILOffset &&
+        SUCCEEDED(pModules->GetSequencePointByILOffset(asyncFrame.modAddress, asyncFrame.methodToken, asyncFrame.methodVersion,
+                                                       asyncFrame.ilOffset, sp)))
+    {
+        stackFrame.source = Source(sp.document);
+        stackFrame.line = sp.startLine;
+        stackFrame.column = sp.startColumn;
+        stackFrame.endLine = sp.endLine;
+        stackFrame.endColumn = sp.endColumn;
+    }
+
+    stackFrame.clrAddr.methodToken = asyncFrame.methodToken;
+    stackFrame.clrAddr.ilOffset = asyncFrame.ilOffset;
+    stackFrame.clrAddr.methodVersion = asyncFrame.methodVersion;
+    // Note, logical frame don't have native code address.
+    stackFrame.addr = 0;
+    stackFrame.unknownFrameAddr = true;
+    stackFrame.activeStatementFlags |= StackFrame::ActiveStatementFlags::NonLeafFrame;
+}
+
+static std::string GetModuleNameForFrame(Modules *pModules, ICorDebugFrame *pFrame)
 {
     ToRelease<ICorDebugFunction> pFunc;
     if (!pFrame || FAILED(pFrame->GetFunction(&pFunc)))
@@ -1096,12 +1885,7 @@ static std::string GetModuleNameForFrame(ICorDebugFrame *pFrame)
     if (FAILED(pFunc->GetModule(&pModule)))
         return std::string{};
 
-    WCHAR name[mdNameLen];
-    ULONG32 name_len = 0;
-    if (FAILED(pModule->GetName(_countof(name), &name_len, name)))
-        return std::string{};
-
-    return GetBasename(to_utf8(name));
+    return GetBasename(pModules->GetModuleFileNameCached(pModule));
 }
 
 HRESULT ManagedDebuggerBase::GetManagedStackTrace(ICorDebugThread *pThread, ThreadId threadId, FrameLevel startFrame, unsigned maxFrames,
@@ -1128,18 +1912,35 @@ HRESULT ManagedDebuggerBase::GetManagedStackTrace(ICorDebugThread *pThread, Thre
     static const std::string FrameCLRNativeText = "[Native Frames]";
 #endif // INTEROP_DEBUGGING
 
-    IfFailRet(WalkFrames(pThread, [&](
+    // Async methods MoveNext() frames, from top to bottom. Note, Hot Reload need physical frames only.
+    std::vector<ToRelease<ICorDebugFrame>> asyncMoveNextFrames;
+
+    // Note, frame after requested range is walked in order to know, that stack have more frames.
+    bool moreFrames = false;
+    Status = WalkFrames(pThread, [&](
         FrameType frameType,
         std::uintptr_t addr,
         ICorDebugFrame *pFrame,
         NativeFrame *pNative)
     {
+        if (Cancellation::IsRequested())
+            return COR_E_OPERATIONCANCELED;
+
         currentFrame++;
 
+        if (!hotReloadAwareCaller && frameType == FrameCLRManaged && m_uniqueAsyncStack->IsAsyncMoveNextFrame(pFrame))
+        {
+            pFrame->AddRef();
+            asyncMoveNextFrames.emplace_back(pFrame);
+        }
+
         if (currentFrame < int(startFrame))
             return S_OK;
         if (maxFrames != 0 && currentFrame >= int(startFrame) + int(maxFrames))
-            return S_OK;
+        {
+            moreFrames = true;
+            return E_ABORT; // Fast exit from cycle.
+        }
 
         switch(frameType)
         {
@@ -1185,14 +1986,49 @@ HRESULT ManagedDebuggerBase::GetManagedStackTrace(ICorDebugThread *pThread, Thre
                     stackFrames.push_back(stackFrame);
                     stackFrames.back().addr = addr;
                     stackFrames.back().unknownFrameAddr = !addr; // Could be 0 here only in case some CoreCLR registers context issue.
-                    stackFrames.back().moduleOrLibName = GetModuleNameForFrame(pFrame);
+                    stackFrames.back().moduleOrLibName = GetModuleNameForFrame(m_sharedModules.get(), pFrame);
                     AddFrameStatementFlag();
                 }
                 break;
         }
 
         return S_OK;
-    }));
+    },
+    [&]()
+    {
+        // Native frames out of requested range are not symbolized.
+        return currentFrame + 1 >= int(startFrame);
+    });
+    if (FAILED(Status) && !moreFrames)
+        return Status;
+
+    // Logical callers of async method are added after physical stack, so, all physical frames must be walked first.
+    // Note, top async method frames could be in synchronous part (no task created yet) with callers on physical stack,
+    // first async method frame with task provide logical callers.
+    ToRelease<ICorDebugProcess> iCorProcess;
+    std::vector<AsyncStack::frame_t> asyncCallers;
+    if (!moreFrames && !asyncMoveNextFrames.empty() && SUCCEEDED(pThread->GetProcess(&iCorProcess)))
+    {
+        for (auto &asyncFrame : asyncMoveNextFrames)
+        {
+            asyncCallers.clear();
+            if (m_uniqueAsyncStack->GetFrameAsyncCallers(iCorProcess, asyncFrame, asyncCallers) == S_OK)
+                break;
+        }
+    }
+
+    for (const auto &asyncCaller : asyncCallers)
+    {
+        currentFrame++;
+
+        if (currentFrame < int(startFrame))
+            continue;
+        if (maxFrames != 0 && currentFrame >= int(startFrame) + int(maxFrames))
+            break;
+
+        stackFrames.emplace_back();
+        GetAsyncFrameLocation(m_sharedModules.get(), asyncCaller, threadId, FrameLevel{currentFrame}, "[Async] ", stackFrames.back());
+    }
 
     totalFrames = currentFrame + 1;
 
@@ -1207,6 +2043,7 @@ HRESULT ManagedDebuggerBase::GetNativeStackTrace(ThreadId threadId, FrameLevel s
     HRESULT Status;
     int currentFrame = -1;
 
+    bool moreFrames = false;
     Status = m_sharedInteropDebugger->UnwindNativeFrames(int(threadId), true, 0, nullptr, [&](NativeFrame &nativeFrame)
     {
         currentFrame++;
@@ -1214,7 +2051,10 @@ HRESULT ManagedDebuggerBase::GetNativeStackTrace(ThreadId threadId, FrameLevel s
         if (currentFrame < int(startFrame))
             return S_OK;
         if (maxFrames != 0 && currentFrame >= int(startFrame) + int(maxFrames))
-            return S_OK;
+        {
+            moreFrames = true;
+            return E_ABORT; // Fast exit from cycle.
+        }
 
         stackFrames.emplace_back(threadId, FrameLevel{currentFrame}, nativeFrame.procName);
         stackFrames.back().addr = nativeFrame.addr;
@@ -1229,22 +2069,36 @@ HRESULT ManagedDebuggerBase::GetNativeStackTrace(ThreadId threadId, FrameLevel s
             stackFrames.back().activeStatementFlags |= StackFrame::ActiveStatementFlags::NonLeafFrame;
 
         return S_OK;
+    },
+    [&]()
+    {
+        return currentFrame + 1 >= int(startFrame);
     });
 
     totalFrames = currentFrame + 1;
-    
-    return Status;
+
+    return moreFrames ? S_OK : Status;
 }
 #endif // INTEROP_DEBUGGING
 
-HRESULT ManagedDebugger::GetStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames, bool hotReloadAwareCaller)
+static void CopyStackFramesRange(const std::vector<StackFrame> &topFrames, int topTotalFrames, FrameLevel startFrame, unsigned maxFrames,
+                                 std::vector<StackFrame> &stackFrames, int &totalFrames)
 {
-    LogFuncEntry();
+    totalFrames = topTotalFrames;
+    const int framesCount = (int)topFrames.size();
+    if (int(startFrame) >= framesCount)
+        return;
 
-    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
-    HRESULT Status;
-    IfFailRet(CheckDebugProcess());
+    auto first = topFrames.begin() + int(startFrame);
+    auto last = (maxFrames == 0 || int(maxFrames) >= framesCount - int(startFrame)) ? topFrames.end() : first + maxFrames;
+    stackFrames.insert(stackFrames.end(), first, last);
+}
 
+// Caller must care about m_debugProcessRWLock.
+HRESULT ManagedDebuggerBase::GetThreadStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames,
+                                                 int &totalFrames, bool hotReloadAwareCaller)
+{
+    HRESULT Status;
     ToRelease<ICorDebugThread> pThread;
     if (SUCCEEDED(Status = m_iCorProcess->GetThread(int(threadId), &pThread)))
         return GetManagedStackTrace(pThread, threadId, startFrame, maxFrames, stackFrames, totalFrames, hotReloadAwareCaller);
@@ -1258,6 +2112,67 @@ HRESULT ManagedDebugger::GetStackTrace(ThreadId threadId, FrameLevel startFrame,
     return Status;
 }
 
+HRESULT ManagedDebugger::GetStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames, bool hotReloadAwareCaller)
+{
+    LogFuncEntry();
+    StepStats::ScopedTimer timer(StepStats::Phase::StackTrace);
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+    InspectionScope inspection(m_nonStop, m_sharedCallbacksQueue.get(), m_iCorProcess);
+
+    return GetCachedStackTrace(threadId, startFrame, maxFrames, stackFrames, totalFrames, hotReloadAwareCaller);
+}
+
+// Caller must care about m_debugProcessRWLock.
+HRESULT ManagedDebugger::GetCachedStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames,
+                                             int &totalFrames, bool hotReloadAwareCaller)
+{
+    HRESULT Status;
+    // Note, stack trace could be requested during stop event emit, while process still marked as running, don't cache it in this case.
+    // Same for func-eval, since debuggee is resumed and thread stack have eval frames.
+    if (m_sharedCallbacksQueue->IsRunning() || m_sharedEvalWaiter->IsEvalRunning())
+        return GetThreadStackTrace(threadId, startFrame, maxFrames, stackFrames, totalFrames, hotReloadAwareCaller);
+
+    // Note, frames JMC status is part of stack trace (user code frames).
+    m_sharedModules->ApplyDeferredJMC();
+
+    const auto key = std::make_pair(threadId, hotReloadAwareCaller);
+    // Top frames count, that must be walked, 0 - all frames.
+    int walkFrames = maxFrames == 0 ? 0 : int(startFrame) + int(maxFrames);
+    unsigned generation;
+    {
+        std::lock_guard<std::mutex> lock(m_stackTraceCacheMutex);
+        auto find = m_stackTraceCache.find(key);
+        if (find != m_stackTraceCache.end())
+        {
+            const StackTraceCacheEntry &entry = find->second;
+            const int cachedFrames = (int)entry.frames.size();
+            if (cachedFrames == entry.totalFrames || (walkFrames != 0 && walkFrames <= cachedFrames))
+            {
+                CopyStackFramesRange(entry.frames, entry.totalFrames, startFrame, maxFrames, stackFrames, totalFrames);
+                return S_OK;
+            }
+            // Note, client page through deep stack, walk at least twice more frames than before, so, N pages don't cost N walks.
+            if (walkFrames != 0)
+                walkFrames = std::max(walkFrames, cachedFrames * 2);
+        }
+        generation = m_stackTraceCacheGeneration;
+    }
+
+    // Note, frames walk done without cache lock, since stack trace requests for different threads could be processed in parallel.
+    StackTraceCacheEntry entry;
+    IfFailRet(GetThreadStackTrace(threadId, FrameLevel(0), walkFrames, entry.frames, entry.totalFrames, hotReloadAwareCaller));
+    CopyStackFramesRange(entry.frames, entry.totalFrames, startFrame, maxFrames, stackFrames, totalFrames);
+
+    std::lock_guard<std::mutex> lock(m_stackTraceCacheMutex);
+    if (generation == m_stackTraceCacheGeneration)
+        m_stackTraceCache[key] = std::move(entry);
+
+    return S_OK;
+}
+
 int ManagedDebugger::GetNamedVariables(uint32_t variablesReference)
 {
     LogFuncEntry();
@@ -1277,6 +2192,7 @@ HRESULT ManagedDebugger::GetVariables(
     std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
     HRESULT Status;
     IfFailRet(CheckDebugProcess());
+    InspectionScope inspection(m_nonStop, m_sharedCallbacksQueue.get(), m_iCorProcess);
 
     return m_sharedVariables->GetVariables(m_iCorProcess, variablesReference, filter, start, count, variables);
 }
@@ -1288,6 +2204,7 @@ HRESULT ManagedDebugger::GetScopes(FrameId frameId, std::vector<Scope> &scopes)
     std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
     HRESULT Status;
     IfFailRet(CheckDebugProcess());
+    InspectionScope inspection(m_nonStop, m_sharedCallbacksQueue.get(), m_iCorProcess);
 
     return m_sharedVariables->GetScopes(m_iCorProcess, frameId, scopes);
 }
@@ -1299,10 +2216,37 @@ HRESULT ManagedDebugger::Evaluate(FrameId frameId, const std::string &expression
     std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
     HRESULT Status;
     IfFailRet(CheckDebugProcess());
+    InspectionScope inspection(m_nonStop, m_sharedCallbacksQueue.get(), m_iCorProcess);
 
     return m_sharedVariables->Evaluate(m_iCorProcess, frameId, expression, variable, output);
 }
 
+HRESULT ManagedDebugger::EvaluateBatch(FrameId frameId, const std::vector<std::string> &expressions, std::vector<Variable> &variables,
+                                       std::vector<HRESULT> &statuses, std::vector<std::string> &outputs)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+    InspectionScope inspection(m_nonStop, m_sharedCallbacksQueue.get(), m_iCorProcess);
+
+    return m_sharedVariables->EvaluateBatch(m_iCorProcess, frameId, expressions, variables, statuses, outputs);
+}
+
+HRESULT ManagedDebugger::ReadString(FrameId frameId, const std::string &expression, int evalFlags, uint32_t offset, uint32_t count,
+                                    std::string &value, uint32_t &read, uint32_t &length)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+    InspectionScope inspection(m_nonStop, m_sharedCallbacksQueue.get(), m_iCorProcess);
+
+    return m_sharedVariables->ReadString(m_iCorProcess, frameId, expression, evalFlags, offset, count, value, read, length);
+}
+
 void ManagedDebugger::CancelEvalRunning()
 {
     LogFuncEntry();
@@ -1317,6 +2261,8 @@ HRESULT ManagedDebugger::SetVariable(const std::string &name, const std::string
     std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
     HRESULT Status;
     IfFailRet(CheckDebugProcess());
+    IfFailRet(CheckNotDump());
+    InspectionScope inspection(m_nonStop, m_sharedCallbacksQueue.get(), m_iCorProcess);
 
     return m_sharedVariables->SetVariable(m_iCorProcess, name, value, ref, output);
 }
@@ -1328,6 +2274,8 @@ HRESULT ManagedDebugger::SetExpression(FrameId frameId, const std::string &expre
     std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
     HRESULT Status;
     IfFailRet(CheckDebugProcess());
+    IfFailRet(CheckNotDump());
+    InspectionScope inspection(m_nonStop, m_sharedCallbacksQueue.get(), m_iCorProcess);
 
     return m_sharedVariables->SetExpression(m_iCorProcess, frameId, expression, evalFlags, value, output);
 }
@@ -1339,6 +2287,18 @@ void ManagedDebugger::FindFileNames(string_view pattern, unsigned limit, SearchC
     m_sharedModules->FindFileNames(pattern, limit, cb);
 }
 
+unsigned ManagedDebugger::GetLoadedSources(unsigned startIndex, unsigned count, SearchCallback cb)
+{
+    LogFuncEntry();
+    return m_sharedModules->GetLoadedSources(startIndex, count, cb);
+}
+
+void ManagedDebugger::SearchSources(string_view pattern, unsigned limit, SearchCallback cb)
+{
+    LogFuncEntry();
+    m_sharedModules->SearchSources(pattern, limit, cb);
+}
+
 void ManagedDebugger::FindFunctions(string_view pattern, unsigned limit, SearchCallback cb)
 {
     LogFuncEntry();
@@ -1353,110 +2313,730 @@ void ManagedDebugger::FindVariables(ThreadId thread, FrameLevel framelevel, stri
     if (FAILED(CheckDebugProcess()))
         return;
 
-    StackFrame frame{thread, framelevel, ""};
-    std::vector<Scope> scopes;
-    std::vector<Variable> variables;
-    HRESULT status = m_sharedVariables->GetScopes(m_iCorProcess, frame.id, scopes);
-    if (FAILED(status))
-    {
-        LOGW("GetScopes failed: %s", errormessage(status));
-        return;
-    }
-
-    if (scopes.empty() || scopes[0].variablesReference == 0)
-    {
-        LOGW("no variables in visible scopes");
-        return;
-    }
+    // Note, for "expression.member" pattern members of expression value are completed, otherwise stack variables.
+    const size_t dot = pattern.rfind('.');
+    const std::string expression = dot == string_view::npos ? std::string() : std::string(pattern.substr(0, dot));
+    const string_view member = dot == string_view::npos ? string_view() : pattern.substr(dot + 1);
 
-    status = m_sharedVariables->GetVariables(m_iCorProcess, scopes[0].variablesReference, VariablesNamed, 0, 0, variables);
+    StackFrame frame{thread, framelevel, ""};
+    std::shared_ptr<const std::vector<std::string>> names;
+    HRESULT status = m_sharedVariables->GetCompletionNames(m_iCorProcess, frame.id, expression, names);
     if (FAILED(status))
     {
-        LOGW("GetVariables failed: %s", errormessage(status));
+        LOGW("GetCompletionNames failed: %s", errormessage(status));
         return;
     }
 
-    for (const Variable& var : variables)
+    std::string completion;
+    for (const std::string &name : *names)
     {
-        LOGD("var: '%s'", var.name.c_str());
-
         if (limit == 0)
             break;
 
-        auto pos = var.name.find(pattern.data(), 0, pattern.size());
-        if (pos != std::string::npos && (pos == 0 || var.name[pos-1] == '.'))
+        if (expression.empty())
+        {
+            auto pos = name.find(pattern.data(), 0, pattern.size());
+            if (pos == std::string::npos || (pos != 0 && name[pos-1] != '.'))
+                continue;
+
+            cb(name.c_str());
+        }
+        else
         {
-            limit--;
-            cb(var.name.c_str());
+            if (name.compare(0, member.size(), member.data(), member.size()) != 0)
+                continue;
+
+            completion = expression + "." + name;
+            cb(completion.c_str());
         }
+        limit--;
     }
 }
 
-
-void ManagedDebuggerBase::InputCallback(IORedirectHelper::StreamType type, span<char> text)
+HRESULT ManagedDebugger::StartSampling(unsigned interval)
 {
-    pProtocol->EmitOutputEvent(type == IOSystem::Stderr ? OutputStdErr : OutputStdOut, {text.begin(), text.size()});
-}
+    LogFuncEntry();
 
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+    IfFailRet(CheckNotDump());
 
-void ManagedDebugger::EnumerateBreakpoints(std::function<bool (const BreakpointInfo&)>&& callback)
-{
-    LogFuncEntry();
-    return m_sharedBreakpoints->EnumerateBreakpoints(std::move(callback));
+#ifdef INTEROP_DEBUGGING
+    // Note, native frames unwind need all native threads stopped by interop debugger, that is not stop for sample.
+    if (m_interopDebugging)
+        return E_NOTIMPL;
+#endif // INTEROP_DEBUGGING
+
+    return m_uniqueSamplingProfiler->Start(interval, [this](std::vector<StackSamples::stack_t> &stacks) -> HRESULT
+    {
+        std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+        HRESULT Status;
+        IfFailRet(CheckDebugProcess());
+
+        return m_sharedCallbacksQueue->StopForSample(m_iCorProcess, [&]()
+        {
+            return SamplingProfiler::CollectThreadsStacks(m_iCorProcess, stacks);
+        });
+    });
 }
 
-static HRESULT GetModuleOfCurrentThreadCode(ICorDebugProcess *pProcess, int lastStoppedThreadId, ICorDebugModule **ppModule)
+HRESULT ManagedDebugger::StopSampling(uint64_t &samplesCount)
 {
-    HRESULT Status;
-    ToRelease<ICorDebugThread> pThread;
-    IfFailRet(pProcess->GetThread(lastStoppedThreadId, &pThread));
+    LogFuncEntry();
 
-    ToRelease<ICorDebugFrame> pFrame;
-    IfFailRet(pThread->GetActiveFrame(&pFrame));
-    if (pFrame == nullptr)
+    if (!m_uniqueSamplingProfiler->IsRunning())
         return E_FAIL;
 
-    mdMethodDef methodToken;
-    IfFailRet(pFrame->GetFunctionToken(&methodToken));
-    ToRelease<ICorDebugFunction> pFunc;
-    IfFailRet(pFrame->GetFunction(&pFunc));
-    return pFunc->GetModule(ppModule);
+    m_uniqueSamplingProfiler->Stop();
+    samplesCount = m_uniqueSamplingProfiler->GetSamplesCount();
+    return S_OK;
 }
 
-HRESULT ManagedDebugger::GetSourceFile(const std::string &sourcePath, char** fileBuf, int* fileLen)
+HRESULT ManagedDebugger::ExportSamples(SamplesFormat format, std::string &output)
 {
+    LogFuncEntry();
+
+    // Note, module's metadata could be used only with process object (if process was not exited yet).
     std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
-    HRESULT Status;
-    IfFailRet(CheckDebugProcess());
+    return m_uniqueSamplingProfiler->Export(format, output);
+}
 
-    ToRelease<ICorDebugModule> pModule;
-    IfFailRet(GetModuleOfCurrentThreadCode(m_iCorProcess, int(GetLastStoppedThreadId()), &pModule));
-    return m_sharedModules->GetSource(pModule, sourcePath, fileBuf, fileLen);
+void ManagedDebugger::SetExceptionStatistics(bool enable)
+{
+    LogFuncEntry();
+
+    m_sharedBreakpoints->SetExceptionStatistics(enable);
 }
 
-void ManagedDebugger::FreeUnmanaged(PVOID mem)
+bool ManagedDebugger::IsExceptionStatistics()
 {
-    Interop::CoTaskMemFree(mem);
+    return m_sharedBreakpoints->IsExceptionStatistics();
 }
 
-IDebugger::AsyncResult ManagedDebugger::ProcessStdin(InStream& stream)
+HRESULT ManagedDebugger::GetExceptionStatistics(std::vector<ExceptionStatistic> &statistics, uint64_t &droppedCount, bool reset)
 {
     LogFuncEntry();
-    return m_ioredirect.async_input(stream);
-}
 
+    // Note, module's metadata could be used only with process object (if process was not exited yet).
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    return m_sharedBreakpoints->GetExceptionStatistics(m_sharedModules.get(), statistics, droppedCount, reset);
+}
 
-void ManagedDebugger::SetJustMyCode(bool enable)
+HRESULT ManagedDebugger::GetTraceRecords(std::vector<TraceRecord> &records, uint64_t &overwrittenCount, bool drain)
 {
-    m_justMyCode = enable;
-    m_uniqueSteppers->SetJustMyCode(enable);
-    m_sharedBreakpoints->SetJustMyCode(enable);
+    LogFuncEntry();
+
+    // Note, module's metadata could be used only with process object (if process was not exited yet).
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    return m_sharedBreakpoints->GetTraceRecords(m_sharedModules.get(), records, overwrittenCount, drain);
 }
 
-void ManagedDebugger::SetStepFiltering(bool enable)
+HRESULT ManagedDebugger::ClearTraceRecords()
 {
-    m_stepFiltering = enable;
-    m_uniqueSteppers->SetStepFiltering(enable);
+    LogFuncEntry();
+
+    m_sharedBreakpoints->ClearTraceRecords();
+    return S_OK;
+}
+
+HRESULT ManagedDebugger::GetHeapStatistics(unsigned topCount, bool sortByCount, HeapStatisticsCallback callback, HeapStatistics &statistics)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+
+    // Note, GC heap is consistent only in case process is stopped.
+    if (m_sharedCallbacksQueue->IsRunning())
+    {
+        LOGW("Can't walk heap, process is running.");
+        return E_FAIL;
+    }
+
+    return HeapWalk::GetStatistics(m_iCorProcess, topCount, sortByCount, callback, statistics);
+}
+
+HRESULT ManagedDebugger::FindGCRootPath(FrameId frameId, const std::string &expression, int evalFlags, GCRootPath &path)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+
+    if (m_sharedCallbacksQueue->IsRunning())
+    {
+        LOGW("Can't find GC root path, process is running.");
+        return E_FAIL;
+    }
+
+    uint64_t address = 0;
+    {
+        InspectionScope inspection(m_nonStop, m_sharedCallbacksQueue.get(), m_iCorProcess);
+        IfFailRet(m_sharedVariables->GetObjectAddress(m_iCorProcess, frameId, expression, evalFlags, address));
+    }
+
+    return HeapWalk::FindRootPath(m_iCorProcess, address, path);
+}
+
+HRESULT ManagedDebugger::GetAsyncTasks(bool includeCompleted, std::vector<AsyncTaskGroup> &groups, uint64_t &tasksCount)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+
+    if (m_sharedCallbacksQueue->IsRunning())
+    {
+        LOGW("Can't walk heap, process is running.");
+        return E_FAIL;
+    }
+
+    // Note, Task type id is resolved once per request, derived types (Task<T>, state machine boxes, promises) are
+    // collected during heap walk.
+    ToRelease<ICorDebugClass> iCorTaskClass;
+    IfFailRet(WellKnownTypes::GetClass(WellKnownTypes::Type::Task, &iCorTaskClass));
+    if (Status == S_FALSE)
+        return E_FAIL;
+    ToRelease<ICorDebugClass2> iCorTaskClass2;
+    IfFailRet(iCorTaskClass->QueryInterface(IID_ICorDebugClass2, (LPVOID*) &iCorTaskClass2));
+    ToRelease<ICorDebugType> iCorTaskType;
+    IfFailRet(iCorTaskClass2->GetParameterizedType(ELEMENT_TYPE_CLASS, 0, nullptr, &iCorTaskType));
+    ToRelease<ICorDebugType2> iCorTaskType2;
+    IfFailRet(iCorTaskType->QueryInterface(IID_ICorDebugType2, (LPVOID*) &iCorTaskType2));
+    COR_TYPEID taskTypeId;
+    IfFailRet(iCorTaskType2->GetTypeID(&taskTypeId));
+
+    TaskGroups taskGroups;
+    IfFailRet(HeapWalk::EnumerateDerivedObjects(m_iCorProcess, taskTypeId, [&](uint64_t address, COR_TYPEID typeId) -> HRESULT
+    {
+        int32_t stateFlags = 0;
+        AsyncStack::frame_t frame;
+        const HRESULT hr = m_uniqueAsyncStack->GetTaskState(m_iCorProcess, address, stateFlags, frame);
+        if (FAILED(hr))
+            return S_OK; // Note, ignore tasks with unknown layout.
+
+        const TaskGroups::Status status = TaskGroups::GetStatus(stateFlags);
+        if (!includeCompleted && TaskGroups::IsCompleted(status))
+            return S_OK;
+
+        const int32_t state = hr == S_OK ? frame.state : TaskGroups::NoState;
+        taskGroups.Add(TaskGroups::key_t(status, typeId.token1, typeId.token2, state), address);
+        return S_OK;
+    }));
+
+    tasksCount = taskGroups.GetTasksCount();
+    std::vector<TaskGroups::group_t> result;
+    taskGroups.GetGroups(result);
+
+    ToRelease<ICorDebugProcess5> iCorProcess5;
+    IfFailRet(m_iCorProcess->QueryInterface(IID_ICorDebugProcess5, (LPVOID*) &iCorProcess5));
+    groups.reserve(result.size());
+    for (const auto &entry : result)
+    {
+        groups.emplace_back();
+        AsyncTaskGroup &group = groups.back();
+        group.status = TaskGroups::GetStatusName(entry.key.status);
+        group.state = entry.key.state;
+        group.count = entry.count;
+        group.tasks = entry.tasks;
+
+        // Note, tasks of group have same state machine (or same type) and same await point, first task async stack is provided.
+        std::vector<AsyncStack::frame_t> asyncStack;
+        if (!entry.tasks.empty())
+            m_uniqueAsyncStack->GetTaskAsyncStack(m_iCorProcess, entry.tasks.front(), asyncStack);
+        for (size_t i = 0; i < asyncStack.size(); i++)
+        {
+            group.asyncStack.emplace_back();
+            GetAsyncFrameLocation(m_sharedModules.get(), asyncStack[i], ThreadId{}, FrameLevel{int(i)}, "", group.asyncStack.back());
+        }
+
+        if (entry.key.state != TaskGroups::NoState && !group.asyncStack.empty())
+        {
+            group.name = group.asyncStack.front().methodName;
+            continue;
+        }
+
+        COR_TYPEID typeId;
+        typeId.token1 = entry.key.token1;
+        typeId.token2 = entry.key.token2;
+        ToRelease<ICorDebugType> iCorType;
+        if (FAILED(iCorProcess5->GetTypeForTypeID(typeId, &iCorType)) ||
+            FAILED(TypePrinter::GetTypeOfValue(iCorType, group.name)) ||
+            group.name.empty())
+            group.name = "<unknown type>";
+    }
+
+    return S_OK;
+}
+
+// Note, snapshot must be compact, deep stacks (recursion) and long strings are truncated.
+static const unsigned SnapshotMaxFrames = 64;
+static const ULONG32 SnapshotMaxStringLength = 256;
+static const unsigned SnapshotMaxWorkers = 4;
+
+HRESULT ManagedDebugger::SnapshotAndDetach(unsigned localsFrames, std::string &output)
+{
+    LogFuncEntry();
+
+    // Note, sampling must not stop/continue process during snapshot and detach.
+    m_uniqueSamplingProfiler->Stop();
+
+    TriageSnapshot snapshot;
+    std::chrono::steady_clock::time_point stopTime;
+    {
+        std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+        HRESULT Status;
+        IfFailRet(CheckDebugProcess());
+
+        if (m_sharedEvalWaiter->IsEvalRunning())
+        {
+            LOGE("Can't create snapshot during running evaluation.");
+            return E_UNEXPECTED;
+        }
+
+        stopTime = std::chrono::steady_clock::now();
+        if (m_startMethod != StartDump)
+            IfFailRet(m_sharedCallbacksQueue->Stop(m_iCorProcess));
+        // Note, frames cache could be created before process was continued by sampling or non-stop mode.
+        InvalidateStackTraceCache();
+
+        DWORD pid = 0;
+        if (SUCCEEDED(m_iCorProcess->GetID(&pid)))
+            snapshot.processId = pid;
+
+        std::vector<ToRelease<ICorDebugThread>> threads;
+        ToRelease<ICorDebugThreadEnum> pThreads;
+        IfFailRet(m_iCorProcess->EnumerateThreads(&pThreads));
+        ICorDebugThread *curThread;
+        ULONG threadsFetched = 0;
+        while (SUCCEEDED(pThreads->Next(1, &curThread, &threadsFetched)) && threadsFetched == 1)
+        {
+            threads.emplace_back(curThread);
+        }
+        snapshot.threads.resize(threads.size());
+
+        // Note, all data are read by DBI from stopped process, threads are independent, so, walk them in parallel, modules
+        // symbols and evaluator caches are thread-safe (same as for pipelined read-only protocol requests).
+        std::atomic<size_t> nextThread(0);
+        auto worker = [&]()
+        {
+            for (size_t i = nextThread++; i < threads.size(); i = nextThread++)
+            {
+                ICorDebugThread *pThread = threads[i].GetPtr();
+                TriageSnapshot::Thread &thread = snapshot.threads[i];
+                const ThreadId threadId(getThreadId(pThread));
+                thread.id = int(threadId);
+
+                ToRelease<ICorDebugValue> pException;
+                if (SUCCEEDED(pThread->GetCurrentException(&pException)) && pException != nullptr)
+                {
+                    if (FAILED(TypePrinter::GetTypeOfValue(pException, thread.exceptionType)))
+                        thread.exceptionType = "<unknown exception>";
+                    m_sharedEvaluator->WalkMembers(pException, pThread, FrameLevel{0}, false, [&](
+                        ICorDebugType*, bool, const std::string &memberName, Evaluator::GetValueCallback getValue, Evaluator::SetterData*)
+                    {
+                        if (memberName != "_message")
+                            return S_OK;
+
+                        ToRelease<ICorDebugValue> pMessage;
+                        BOOL isNull = TRUE;
+                        ToRelease<ICorDebugReferenceValue> pReference;
+                        if (SUCCEEDED(getValue(&pMessage, defaultEvalFlags | EVAL_NOFUNCEVAL)) &&
+                            SUCCEEDED(pMessage->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &pReference)) &&
+                            SUCCEEDED(pReference->IsNull(&isNull)) && isNull == FALSE)
+                        {
+                            PrintValue(pMessage, thread.exceptionMessage, false, SnapshotMaxStringLength);
+                        }
+                        return E_ABORT; // Fast exit from cycle.
+                    });
+                }
+
+                int level = 0;
+                WalkFrames(pThread, [&](FrameType frameType, std::uintptr_t, ICorDebugFrame *pFrame, NativeFrame*)
+                {
+                    if (frameType != FrameCLRManaged)
+                        return S_OK;
+
+                    if (thread.frames.size() == SnapshotMaxFrames)
+                    {
+                        thread.truncated = true;
+                        return E_ABORT;
+                    }
+
+                    const FrameLevel frameLevel{level++};
+                    thread.frames.emplace_back();
+                    TriageSnapshot::Frame &frame = thread.frames.back();
+                    StackFrame stackFrame;
+                    GetFrameLocation(pFrame, threadId, frameLevel, stackFrame, false);
+                    frame.methodName = std::move(stackFrame.methodName);
+                    frame.module = GetModuleNameForFrame(m_sharedModules.get(), pFrame);
+                    frame.source = std::move(stackFrame.source.path);
+                    frame.line = stackFrame.line;
+
+                    if (thread.frames.size() > localsFrames)
+                        return S_OK;
+
+                    m_sharedEvaluator->WalkStackVars(pThread, frameLevel, [&](const std::string &name, Evaluator::GetValueCallback getValue) -> HRESULT
+                    {
+                        TriageSnapshot::Local local;
+                        local.name = name;
+                        ToRelease<ICorDebugValue> pValue;
+                        if (SUCCEEDED(getValue(&pValue, defaultEvalFlags | EVAL_NOFUNCEVAL)) && pValue != nullptr)
+                        {
+                            TypePrinter::GetTypeOfValue(pValue, local.type);
+                            PrintValue(pValue, local.value, true, SnapshotMaxStringLength);
+                        }
+                        frame.locals.emplace_back(std::move(local));
+                        return S_OK;
+                    });
+                    return S_OK;
+                });
+            }
+        };
+
+        std::vector<std::thread> workers;
+        const unsigned workersCount = std::min<unsigned>(std::min(SnapshotMaxWorkers, std::thread::hardware_concurrency()), threads.size());
+        for (unsigned i = 1; i < workersCount; i++)
+        {
+            workers.emplace_back(worker);
+        }
+        worker();
+        for (auto &thread : workers)
+        {
+            thread.join();
+        }
+    }
+
+    // Note, dump have no process for detach.
+    if (m_startMethod != StartDump)
+    {
+        HRESULT Status;
+        IfFailRet(DetachFromProcess());
+        pProtocol->EmitTerminatedEvent();
+    }
+
+    snapshot.frozenMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - stopTime).count();
+    LOGI("Snapshot: %zu threads, process frozen %llu ms", snapshot.threads.size(), (unsigned long long)snapshot.frozenMs);
+    ExportTriageSnapshotJson(snapshot, output);
+    return S_OK;
+}
+
+
+void ManagedDebuggerBase::InputCallback(IORedirectHelper::StreamType type, span<char> text)
+{
+    pProtocol->EmitOutputEvent(type == IOSystem::Stderr ? OutputStdErr : OutputStdOut, {text.begin(), text.size()});
+}
+
+
+void ManagedDebugger::EnumerateBreakpoints(std::function<bool (const BreakpointInfo&)>&& callback)
+{
+    LogFuncEntry();
+    return m_sharedBreakpoints->EnumerateBreakpoints(std::move(callback));
+}
+
+static HRESULT GetModuleOfCurrentThreadCode(ICorDebugProcess *pProcess, int lastStoppedThreadId, ICorDebugModule **ppModule)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugThread> pThread;
+    IfFailRet(pProcess->GetThread(lastStoppedThreadId, &pThread));
+
+    ToRelease<ICorDebugFrame> pFrame;
+    IfFailRet(pThread->GetActiveFrame(&pFrame));
+    if (pFrame == nullptr)
+        return E_FAIL;
+
+    mdMethodDef methodToken;
+    IfFailRet(pFrame->GetFunctionToken(&methodToken));
+    ToRelease<ICorDebugFunction> pFunc;
+    IfFailRet(pFrame->GetFunction(&pFunc));
+    return pFunc->GetModule(ppModule);
+}
+
+HRESULT ManagedDebugger::GetSourceFile(const std::string &sourcePath, std::shared_ptr<const char> &fileBuf, int &fileLen)
+{
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+
+    ToRelease<ICorDebugModule> pModule;
+    IfFailRet(GetModuleOfCurrentThreadCode(m_iCorProcess, int(GetLastStoppedThreadId()), &pModule));
+    return m_sharedModules->GetSource(pModule, sourcePath, fileBuf, fileLen);
+}
+
+HRESULT ManagedDebugger::Disassemble(std::uintptr_t address, int64_t offset, int instructionOffset, int instructionCount,
+                                     bool resolveSymbols, std::vector<DisassembledInstruction> &instructions)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+    if (instructionCount <= 0)
+        return E_INVALIDARG;
+    InspectionScope inspection(m_nonStop, m_sharedCallbacksQueue.get(), m_iCorProcess);
+
+    const CORDB_ADDRESS startAddress = CORDB_ADDRESS(int64_t(address) + offset);
+    NativeCodeCache::entry_t nativeCode;
+    IfFailRet(m_sharedModules->GetNativeCodeByAddress(m_iCorProcess, startAddress, nativeCode));
+
+    std::vector<native_code_t::instruction_t> result;
+    nativeCode->Disassemble(startAddress, instructionOffset, unsigned(instructionCount), result);
+
+    std::string methodName;
+    if (resolveSymbols)
+    {
+        m_sharedModules->GetModuleInfo(nativeCode->modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
+        {
+            ToRelease<IUnknown> pMDUnknown;
+            ToRelease<IMetaDataImport> pMDImport;
+            IfFailRet(mdInfo.m_iCorModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+            IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMDImport));
+            return TypePrinter::NameForToken(nativeCode->methodToken, pMDImport, methodName, true, nullptr);
+        });
+    }
+
+    instructions.reserve(result.size());
+    bool symbolProvided = false;
+    for (const auto &entry : result)
+    {
+        instructions.emplace_back();
+        DisassembledInstruction &instruction = instructions.back();
+        instruction.address = std::uintptr_t(entry.address);
+        instruction.valid = entry.valid;
+        if (!entry.valid)
+            continue;
+
+        instruction.instructionBytes = entry.bytes;
+        instruction.instruction = entry.text;
+        // Note, symbol is provided for first instruction of method only, all other instructions belong to same method.
+        if (!symbolProvided)
+        {
+            instruction.symbol = methodName;
+            symbolProvided = true;
+        }
+
+        Modules::SequencePoint sp;
+        if (entry.ilOffset < native_code_t::Epilog &&
+            SUCCEEDED(m_sharedModules->GetSequencePointByILOffset(nativeCode->modAddress, nativeCode->methodToken,
+                                                                  nativeCode->methodVersion, entry.ilOffset, sp)))
+        {
+            instruction.source = Source(sp.document);
+            instruction.line = sp.startLine;
+            instruction.endLine = sp.endLine;
+        }
+    }
+
+    return S_OK;
+}
+
+// Note, one ReadMemory() call for whole chunk, in case chunk read failed (have unreadable pages), chunk is read page by page
+// till first unreadable page.
+static const size_t ReadMemoryChunkSize = 64 * 1024;
+static const size_t ReadMemoryPageSize = 4096; // minimal page size for all supported platforms
+
+static void ReadMemoryByChunks(ICorDebugProcess *pProcess, CORDB_ADDRESS address, char *buffer, size_t size, size_t &read)
+{
+    read = 0;
+    while (read < size)
+    {
+        const size_t chunkSize = std::min(ReadMemoryChunkSize, size - read);
+        SIZE_T chunkRead = 0;
+        if (SUCCEEDED(pProcess->ReadMemory(address + read, (DWORD)chunkSize, (BYTE*)buffer + read, &chunkRead)) &&
+            chunkRead == chunkSize)
+        {
+            read += chunkSize;
+            continue;
+        }
+
+        while (read < size)
+        {
+            const CORDB_ADDRESS pageAddress = address + read;
+            const size_t partSize = std::min<size_t>(ReadMemoryPageSize - pageAddress % ReadMemoryPageSize, size - read);
+            SIZE_T partRead = 0;
+            if (FAILED(pProcess->ReadMemory(pageAddress, (DWORD)partSize, (BYTE*)buffer + read, &partRead)) || partRead == 0)
+                return;
+
+            read += partRead;
+            if (partRead < partSize)
+                return;
+        }
+    }
+}
+
+HRESULT ManagedDebugger::ReadMemory(std::uintptr_t address, int64_t offset, uint32_t count, std::string &data, uint32_t &unreadableBytes)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+
+    const std::uintptr_t startAddress = std::uintptr_t(int64_t(address) + offset);
+    data.resize(count);
+    size_t read = 0;
+    if (count > 0)
+    {
+#ifdef INTEROP_DEBUGGING
+        // Note, process_vm_readv() is much faster than runtime's data target reads, breakpoints opcodes are removed
+        // by interop debugger for native breakpoints and by runtime for managed breakpoints (see below).
+        if (m_interopDebugging)
+            m_sharedInteropDebugger->ReadMemory(startAddress, &data[0], count, read);
+        else
+#endif // INTEROP_DEBUGGING
+        // Note, ICorDebugProcess::ReadMemory() provide original code bytes without managed breakpoints opcodes.
+        ReadMemoryByChunks(m_iCorProcess, startAddress, &data[0], count, read);
+    }
+    data.resize(read);
+    unreadableBytes = count - (uint32_t)read;
+
+    return S_OK;
+}
+
+HRESULT ManagedDebugger::WriteMemory(std::uintptr_t address, int64_t offset, const std::string &data, bool allowPartial, uint32_t &bytesWritten)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess());
+    IfFailRet(CheckNotDump());
+
+    bytesWritten = 0;
+    if (data.empty())
+        return S_OK;
+
+    // Note, runtime care about managed breakpoints opcodes in written memory.
+    SIZE_T written = 0;
+    Status = m_iCorProcess->WriteMemory(CORDB_ADDRESS(int64_t(address) + offset), (DWORD)data.size(), (BYTE*)data.data(), &written);
+    if (FAILED(Status) && !(allowPartial && written > 0))
+        return Status;
+    bytesWritten = (uint32_t)written;
+
+    return S_OK;
+}
+
+IDebugger::AsyncResult ManagedDebugger::ProcessStdin(InStream& stream)
+{
+    LogFuncEntry();
+    return m_ioredirect.async_input(stream);
+}
+
+void ManagedDebugger::SetOutputPassthrough()
+{
+    m_ioredirect.set_passthrough(std::get<IOSystem::Stdout>(IOSystem::get_std_files()));
+}
+
+
+void ManagedDebugger::SetJustMyCode(bool enable)
+{
+    m_justMyCode = enable;
+    m_uniqueSteppers->SetJustMyCode(enable);
+    m_sharedBreakpoints->SetJustMyCode(enable);
+
+    // Note, already loaded modules have JMC statuses applied at load, toggle changes for them are deferred, but modules
+    // from current stacks are processed immediately, since they are most likely involved into next step.
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    std::unordered_set<CORDB_ADDRESS> priorityModules;
+    if (SUCCEEDED(CheckDebugProcess()) && SUCCEEDED(CheckNotDump()) && !m_nonStop && !m_sharedCallbacksQueue->IsRunning())
+    {
+        ToRelease<ICorDebugThreadEnum> iCorThreadEnum;
+        if (SUCCEEDED(m_iCorProcess->EnumerateThreads(&iCorThreadEnum)))
+        {
+            ULONG fetched = 0;
+            ToRelease<ICorDebugThread> iCorThread;
+            while (SUCCEEDED(iCorThreadEnum->Next(1, &iCorThread, &fetched)) && fetched == 1)
+            {
+                WalkFrames(iCorThread, [&](FrameType frameType, std::uintptr_t, ICorDebugFrame *pFrame, NativeFrame *)
+                {
+                    if (frameType != FrameCLRManaged)
+                        return S_OK;
+
+                    ToRelease<ICorDebugFunction> iCorFunction;
+                    ToRelease<ICorDebugModule> iCorModule;
+                    CORDB_ADDRESS modAddress;
+                    if (SUCCEEDED(pFrame->GetFunction(&iCorFunction)) &&
+                        SUCCEEDED(iCorFunction->GetModule(&iCorModule)) &&
+                        SUCCEEDED(iCorModule->GetBaseAddress(&modAddress)))
+                        priorityModules.insert(modAddress);
+
+                    return S_OK;
+                });
+                iCorThread.Free();
+            }
+        }
+    }
+
+    m_sharedModules->SetJustMyCode(enable, priorityModules);
+}
+
+void ManagedDebugger::SetStepFiltering(bool enable)
+{
+    m_stepFiltering = enable;
+    m_uniqueSteppers->SetStepFiltering(enable);
+}
+
+unsigned ManagedDebugger::GetEvalTimeout() const
+{
+    return m_sharedEvalWaiter->GetEvalTimeout();
+}
+
+void ManagedDebugger::SetEvalTimeout(unsigned timeout)
+{
+    m_sharedEvalWaiter->SetEvalTimeout(timeout);
+}
+
+bool ManagedDebugger::IsAdaptiveEvalTimeout() const
+{
+    return m_sharedEvalWaiter->IsAdaptiveEvalTimeout();
+}
+
+void ManagedDebugger::SetAdaptiveEvalTimeout(bool enable)
+{
+    m_sharedEvalWaiter->SetAdaptiveEvalTimeout(enable);
+}
+
+unsigned ManagedDebugger::GetMaxParallelEvals() const
+{
+    return m_sharedEvalWaiter->GetMaxParallelEvals();
+}
+
+void ManagedDebugger::SetMaxParallelEvals(unsigned count)
+{
+    m_sharedEvalWaiter->SetMaxParallelEvals(count);
+}
+
+bool ManagedDebugger::IsDeferPropertiesEvaluation() const
+{
+    return m_sharedVariables->IsDeferPropertiesEvaluation();
+}
+
+void ManagedDebugger::SetDeferPropertiesEvaluation(bool enable)
+{
+    m_sharedVariables->SetDeferPropertiesEvaluation(enable);
+}
+
+bool ManagedDebugger::IsArrayPreview() const
+{
+    return m_sharedVariables->IsArrayPreview();
+}
+
+void ManagedDebugger::SetArrayPreview(bool enable)
+{
+    m_sharedVariables->SetArrayPreview(enable);
+}
+
+unsigned ManagedDebugger::GetEvalBudget() const
+{
+    return m_sharedVariables->GetEvalBudget();
+}
+
+void ManagedDebugger::SetEvalBudget(unsigned budget)
+{
+    m_sharedVariables->SetEvalBudget(budget);
 }
 
 HRESULT ManagedDebugger::SetHotReload(bool enable)
@@ -1471,6 +3051,90 @@ HRESULT ManagedDebugger::SetHotReload(bool enable)
     return S_OK;
 }
 
+void ManagedDebugger::SetSymbolsMemoryLimit(uint64_t limit)
+{
+    m_sharedModules->SetSymbolsMemoryLimit(limit);
+}
+
+void ManagedDebugger::SetSymbolsIdleTimeout(unsigned minutes)
+{
+    m_sharedModules->SetSymbolsIdleTimeout((uint64_t)minutes * 60);
+    if (minutes == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_symbolsIdleMutex);
+    if (!m_symbolsIdleWorker.joinable())
+        m_symbolsIdleWorker = std::thread(&ManagedDebugger::SymbolsIdleWorker, this);
+    m_symbolsIdleCV.notify_all();
+}
+
+void ManagedDebugger::SetSymbolServers(const std::string &servers, const std::string &cachePath)
+{
+    m_sharedModules->SetSymbolServers(servers, cachePath);
+}
+
+void ManagedDebugger::SetSourceLink(bool enable, unsigned prefetchFrames)
+{
+    m_sharedModules->SetSourceLink(enable, prefetchFrames);
+}
+
+void ManagedDebugger::GetMemoryUsage(MemoryUsage &usage)
+{
+    m_sharedModules->GetMemoryUsage(usage);
+    usage.evalCaches = m_sharedEvaluator->GetMemoryUsage();
+}
+
+void ManagedDebuggerBase::EmitNewLoadedSources()
+{
+    // Note, protocol only queue events, so, sources are provided without copy under sources lock.
+    m_sharedModules->TakeNewLoadedSources([&](const char *path)
+    {
+        pProtocol->EmitLoadedSourceEvent(Source(path));
+    });
+}
+
+void ManagedDebuggerBase::WaitLoadModuleTasks()
+{
+    m_uniqueLoadModuleExecutor->WaitIdle();
+}
+
+void ManagedDebuggerBase::CheckSymbolsMemoryLimit()
+{
+    if (m_sharedModules->GetSymbolsMemoryLimit() == 0)
+        return;
+
+    std::unordered_set<CORDB_ADDRESS> usedModules;
+    m_sharedBreakpoints->GetModulesWithBreakpoints(usedModules);
+    m_sharedModules->UnloadUnusedSymbols(usedModules);
+}
+
+void ManagedDebuggerBase::SymbolsIdleWorker()
+{
+    // Note, idle timeout is minutes based, so, one minute check interval is enough.
+    static const uint64_t MaxCheckInterval = 60;
+
+    std::unique_lock<std::mutex> lock(m_symbolsIdleMutex);
+    while (!m_symbolsIdleExit)
+    {
+        const uint64_t idleTimeout = m_sharedModules->GetSymbolsIdleTimeout();
+        if (idleTimeout == 0)
+        {
+            m_symbolsIdleCV.wait(lock);
+            continue;
+        }
+
+        if (m_symbolsIdleCV.wait_for(lock, std::chrono::seconds(std::min(idleTimeout, MaxCheckInterval)), [this]{ return m_symbolsIdleExit; }))
+            break;
+
+        // Note, don't hold m_symbolsIdleMutex during check, since destructor wait for worker exit.
+        lock.unlock();
+        std::unordered_set<CORDB_ADDRESS> usedModules;
+        m_sharedBreakpoints->GetModulesWithBreakpoints(usedModules);
+        m_sharedModules->UnloadUnusedSymbols(usedModules);
+        lock.lock();
+    }
+}
+
 #ifdef INTEROP_DEBUGGING
 void ManagedDebugger::SetInteropDebugging(bool enable)
 {
@@ -1478,6 +3142,25 @@ void ManagedDebugger::SetInteropDebugging(bool enable)
 }
 #endif
 
+HRESULT ManagedDebugger::SetSignalAction(const std::string &signal, SignalAction action)
+{
+    LogFuncEntry();
+
+#ifdef INTEROP_DEBUGGING
+    const int signalNumber = InteropDebugging::SignalPolicy::ParseSignal(signal);
+    if (signalNumber == 0 || !m_sharedInteropDebugger->SetSignalAction(signalNumber, action))
+    {
+        LOGE("Signal %s can't be configured", signal.c_str());
+        return E_INVALIDARG;
+    }
+    return S_OK;
+#else
+    (void)signal;
+    (void)action;
+    return E_NOTIMPL;
+#endif // INTEROP_DEBUGGING
+}
+
 static HRESULT ApplyMetadataAndILDeltas(Modules *pModules, const std::string &dllFileName, const std::string &deltaMD, const std::string &deltaIL)
 {
     HRESULT Status;
@@ -1511,15 +3194,19 @@ static HRESULT ApplyMetadataAndILDeltas(Modules *pModules, const std::string &dl
     return S_OK;
 }
 
-HRESULT ManagedDebuggerBase::ApplyPdbDeltaAndLineUpdates(const std::string &dllFileName, const std::string &deltaPDB, const std::string &lineUpdates,
+HRESULT ManagedDebuggerBase::ApplyPdbDeltaAndLineUpdates(const std::string &dllFileName, pdb_delta_t &pdbDelta,
                                                          std::string &updatedDLL, std::unordered_set<mdTypeDef> &updatedTypeTokens)
 {
     HRESULT Status;
     ToRelease<ICorDebugModule> pModule;
     IfFailRet(m_sharedModules->GetModuleWithName(dllFileName, &pModule, true));
 
-    std::unordered_set<mdMethodDef> pdbMethodTokens;
-    IfFailRet(m_sharedModules->ApplyPdbDeltaAndLineUpdates(pModule, m_justMyCode, deltaPDB, lineUpdates, pdbMethodTokens));
+    std::unordered_set<unsigned> updatedSources;
+    IfFailRet(m_sharedModules->ApplyPdbDeltaAndLineUpdates(pModule, m_justMyCode, pdbDelta, updatedSources));
+    const std::unordered_set<mdMethodDef> &pdbMethodTokens = pdbDelta.methodTokens;
+    // Module metadata was changed, cached types members data could be outdated now.
+    m_sharedEvaluator->InvalidateModuleMembers(pModule);
+    m_sharedEvalHelpers->InvalidateModuleMethods(pModule);
 
     updatedDLL = GetModuleFileName(pModule);
     for (const auto &methodToken : pdbMethodTokens)
@@ -1533,15 +3220,75 @@ HRESULT ManagedDebuggerBase::ApplyPdbDeltaAndLineUpdates(const std::string &dllF
             updatedTypeTokens.insert(typeDef);
     }
 
-    // Since we could have new code lines and new methods added, check all breakpoints again.
+    // Since we could have new code lines and new methods added, check breakpoints in updated sources again.
     std::vector<BreakpointEvent> events;
-    m_sharedBreakpoints->UpdateBreakpointsOnHotReload(pModule, pdbMethodTokens, events);
+    m_sharedBreakpoints->UpdateBreakpointsOnHotReload(pModule, pdbMethodTokens, updatedSources, events);
     for (const BreakpointEvent &event : events)
         pProtocol->EmitBreakpointEvent(event);
 
+    // Note, this is not critical for deltas apply, in case of fail we just keep all symbol readers.
+    if (FAILED(DisposeOutdatedDeltaSymbolReaders(pModule)))
+        LOGW("Can't dispose outdated delta symbol readers.");
+
     return S_OK;
 }
 
+// Long Hot Reload session produce symbol reader for each delta, but old methods versions are not used after new version applied,
+// except frames that still execute old code. Caller must care, that process is stopped.
+HRESULT ManagedDebuggerBase::DisposeOutdatedDeltaSymbolReaders(ICorDebugModule *pModule)
+{
+    HRESULT Status;
+    std::vector<ULONG32> outdatedVersions;
+    IfFailRet(m_sharedModules->GetOutdatedDeltaSymbolReaders(pModule, outdatedVersions));
+    if (outdatedVersions.empty())
+        return S_OK;
+
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+
+    // Note, method version is apply number for module, so, we need only versions of executed methods from this module.
+    std::unordered_set<ULONG32> activeVersions;
+    ToRelease<ICorDebugThreadEnum> iCorThreadEnum;
+    IfFailRet(m_iCorProcess->EnumerateThreads(&iCorThreadEnum));
+    ULONG fetched = 0;
+    ToRelease<ICorDebugThread> iCorThread;
+    while (SUCCEEDED(iCorThreadEnum->Next(1, &iCorThread, &fetched)) && fetched == 1)
+    {
+        IfFailRet(WalkFrames(iCorThread, [&](FrameType frameType, std::uintptr_t, ICorDebugFrame *pFrame, NativeFrame *)
+        {
+            if (frameType != FrameCLRManaged)
+                return S_OK;
+
+            ToRelease<ICorDebugFunction> iCorFunction;
+            ToRelease<ICorDebugModule> iCorModule;
+            CORDB_ADDRESS frameModAddress;
+            ToRelease<ICorDebugCode> iCorCode;
+            ULONG32 methodVersion;
+            if (FAILED(pFrame->GetFunction(&iCorFunction)) ||
+                FAILED(iCorFunction->GetModule(&iCorModule)) ||
+                FAILED(iCorModule->GetBaseAddress(&frameModAddress)) ||
+                frameModAddress != modAddress ||
+                FAILED(iCorFunction->GetILCode(&iCorCode)) ||
+                FAILED(iCorCode->GetVersionNumber(&methodVersion)))
+                return S_OK;
+
+            activeVersions.insert(methodVersion);
+            return S_OK;
+        }));
+        iCorThread.Free();
+    }
+
+    outdatedVersions.erase(std::remove_if(outdatedVersions.begin(), outdatedVersions.end(), [&](ULONG32 version)
+    {
+        return activeVersions.find(version) != activeVersions.end();
+    }), outdatedVersions.end());
+
+    if (outdatedVersions.empty())
+        return S_OK;
+
+    return m_sharedModules->DisposeDeltaSymbolReaders(pModule, outdatedVersions);
+}
+
 HRESULT ManagedDebuggerBase::FindEvalCapableThread(ToRelease<ICorDebugThread> &pThread)
 {
     ThreadId lastStoppedId = GetLastStoppedThreadId();
@@ -1582,19 +3329,58 @@ HRESULT ManagedDebugger::HotReloadApplyDeltas(const std::string &dllFileName, co
 
     // Deltas can be applied only on stopped debuggee process. For Hot Reload scenario we temporary stop it and continue after deltas applied.
     HRESULT Status;
+    IfFailRet(CheckNotDump());
     IfFailRet(m_sharedCallbacksQueue->Stop(m_iCorProcess));
     bool continueProcess = (Status == S_OK); // Was stopped by m_sharedCallbacksQueue->Stop() call.
 
-    IfFailRet(ApplyMetadataAndILDeltas(m_sharedModules.get(), dllFileName, deltaMD, deltaIL));
+    auto stageStart = std::chrono::steady_clock::now();
+    auto stageEnd = [&stageStart](PerfCounters::Counter &counter) -> long long
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const long long us = std::chrono::duration_cast<std::chrono::microseconds>(now - stageStart).count();
+        stageStart = now;
+        counter.Add(uint64_t(us));
+        return us / 1000;
+    };
+
+    // Note, delta PDB load and line updates parse don't depend on module state, so, runtime applies metadata/IL delta at same time.
+    pdb_delta_t pdbDelta;
+    long long pdbDeltaLoadMs = 0;
+    std::future<HRESULT> pdbDeltaLoad = std::async(std::launch::async, [&]() -> HRESULT
+    {
+        const auto loadStart = std::chrono::steady_clock::now();
+        const HRESULT loadStatus = m_sharedModules->LoadPdbDeltaAndLineUpdates(deltaPDB, lineUpdates, pdbDelta);
+        const long long us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - loadStart).count();
+        hotReloadPdbDeltaLoadTimeCounter.Add(uint64_t(us));
+        pdbDeltaLoadMs = us / 1000;
+        return loadStatus;
+    });
+    const HRESULT applyStatus = ApplyMetadataAndILDeltas(m_sharedModules.get(), dllFileName, deltaMD, deltaIL);
+    const long long applyChangesMs = stageEnd(hotReloadApplyChangesTimeCounter);
+    Status = pdbDeltaLoad.get();
+    stageStart = std::chrono::steady_clock::now();
+
     std::string updatedDLL;
     std::unordered_set<mdTypeDef> updatedTypeTokens;
-    IfFailRet(ApplyPdbDeltaAndLineUpdates(dllFileName, deltaPDB, lineUpdates, updatedDLL, updatedTypeTokens));
+    if (SUCCEEDED(applyStatus) && SUCCEEDED(Status))
+        Status = ApplyPdbDeltaAndLineUpdates(dllFileName, pdbDelta, updatedDLL, updatedTypeTokens);
+    // Note, symbol reader ownership is moved to module only in case delta PDB was applied.
+    if (pdbDelta.symbolReaderHandle != nullptr)
+        Interop::DisposeSymbols(pdbDelta.symbolReaderHandle);
+    IfFailRet(applyStatus);
+    IfFailRet(Status);
+    InvalidateStackTraceCache(); // Line updates could change frames location.
+    const long long symbolsUpdateMs = stageEnd(hotReloadSymbolsUpdateTimeCounter);
 
     ToRelease<ICorDebugThread> pThread;
     if (SUCCEEDED(FindEvalCapableThread(pThread)))
         IfFailRet(HotReloadHelpers::UpdateApplication(pThread, m_sharedModules.get(), m_sharedEvaluator.get(), m_sharedEvalHelpers.get(), updatedDLL, updatedTypeTokens));
     else
         IfFailRet(m_sharedBreakpoints->SetHotReloadBreakpoint(updatedDLL, updatedTypeTokens));
+    const long long applicationUpdateMs = stageEnd(hotReloadApplicationUpdateTimeCounter);
+
+    LOGI("Hot Reload: metadata/IL delta %lld ms, delta PDB load %lld ms (in parallel), symbols and breakpoints update %lld ms, "
+         "application update %lld ms", applyChangesMs, pdbDeltaLoadMs, symbolsUpdateMs, applicationUpdateMs);
 
     if (continueProcess)
         IfFailRet(m_sharedCallbacksQueue->Continue(m_iCorProcess));
@@ -9,6 +9,7 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <thread>
 #include "interfaces/idebugger.h"
 #include "debugger/dbgshim.h"
 #include "debugger/interop_debugging.h"
@@ -36,6 +37,13 @@ class ManagedCallback;
 class CallbacksQueue;
 class Breakpoints;
 class Modules;
+class SamplingProfiler;
+class AsyncStack;
+class DumpDataTarget;
+class DumpLibraryProvider;
+class ManagedFieldWatches;
+class SequencedExecutor;
+struct pdb_delta_t;
 
 enum class ProcessAttachedState
 {
@@ -47,7 +55,8 @@ enum StartMethod
 {
     StartNone,
     StartLaunch,
-    StartAttach
+    StartAttach,
+    StartDump
     //StartAttachForSuspendedLaunch
 };
 
@@ -69,9 +78,45 @@ protected:
     ThreadId m_lastStoppedThreadId;
 
     void SetLastStoppedThread(ICorDebugThread *pThread);
+    // Queue SourceLink sources download for thread's top frames, that missed on disk.
+    void PrefetchSourceLinkSources(ICorDebugThread *pThread);
     void SetLastStoppedThreadId(ThreadId threadId);
     void InvalidateLastStoppedThreadId();
 
+    // Top frames of threads stack traces for current stop, aimed to serve paged stack trace requests without frames walk.
+    // Note, stack walk stop after requested frames, so, cached frames could be only part of stack trace.
+    struct StackTraceCacheEntry
+    {
+        std::vector<StackFrame> frames;
+        int totalFrames; // frames.size() in case all frames cached, frames.size() + 1 in case stack have more frames
+    };
+    // Key - thread id and hotReloadAwareCaller flag (frames location depends on it).
+    std::mutex m_stackTraceCacheMutex;
+    std::map<std::pair<ThreadId, bool>, StackTraceCacheEntry> m_stackTraceCache;
+    // Note, changed on each invalidate, in order to prevent cache filling with data that was collected before invalidate call.
+    unsigned m_stackTraceCacheGeneration;
+
+    // Must be called on any process continue (continue, step, etc.) and Hot Reload delta apply.
+    // Note, async call stacks cache (see AsyncStack) is invalidated too.
+    void InvalidateStackTraceCache();
+
+    // Step into targets provided by last GetStepInTargets() call, target id is index + 1.
+    // Note, targets are valid till stack trace cache invalidate (generation changed on any process continue).
+    struct StepInTargetEntry
+    {
+        ToRelease<ICorDebugModule> iCorModule;
+        mdMethodDef methodToken;
+        ULONG32 ilOffset;
+
+        StepInTargetEntry(ICorDebugModule *pModule, mdMethodDef methodToken_, ULONG32 ilOffset_) :
+            iCorModule(pModule), methodToken(methodToken_), ilOffset(ilOffset_)
+        {}
+    };
+    std::mutex m_stepInTargetsMutex;
+    ThreadId m_stepInTargetsThreadId;
+    unsigned m_stepInTargetsGeneration;
+    std::vector<StepInTargetEntry> m_stepInTargets;
+
     StartMethod m_startMethod;
     std::string m_execPath;
     std::vector<std::string> m_execArgs;
@@ -91,18 +136,37 @@ protected:
     std::shared_ptr<Breakpoints> m_sharedBreakpoints;
     std::shared_ptr<CallbacksQueue> m_sharedCallbacksQueue;
     std::unique_ptr<ManagedCallback> m_uniqueManagedCallback;
+    std::unique_ptr<SamplingProfiler> m_uniqueSamplingProfiler;
+    std::unique_ptr<AsyncStack> m_uniqueAsyncStack;
+    std::unique_ptr<ManagedFieldWatches> m_uniqueManagedFieldWatches;
+    // LoadModule callback work, that don't need to be done before module code execution (protocol events, symbols memory limit
+    // check), executed after callback continue process. Note, tasks must not use callbacks queue lock.
+    std::unique_ptr<SequencedExecutor> m_uniqueLoadModuleExecutor;
 #ifdef INTEROP_DEBUGGING
     std::shared_ptr<InteropDebugging::InteropDebugger> m_sharedInteropDebugger;
 #endif // INTEROP_DEBUGGING
 
+    // Last requested data breakpoints, managed fields addresses (see ManagedFieldWatches) are resolved at each
+    // data breakpoints setup, so, data breakpoints are set again after object relocation by GC.
+    std::mutex m_dataBreakpointsMutex;
+    std::vector<DataBreakpoint> m_dataBreakpoints;
+
+    // Caller must care about m_dataBreakpointsMutex.
+    HRESULT ApplyDataBreakpoints(std::vector<Breakpoint> &breakpoints);
+    // Called by managed callback before (`started` is true) and after garbage collection, process is stopped.
+    void ManagedCallbackGarbageCollection(bool started);
+
     Utility::RWLock m_debugProcessRWLock;
     ToRelease<ICorDebug> m_iCorDebug;
     ToRelease<ICorDebugProcess> m_iCorProcess;
 
     bool m_justMyCode;
     bool m_stepFiltering;
+    bool m_deferredJMC;
     bool m_hotReload;
     bool m_interopDebugging;
+    // Non-stop mode, stop event suspend event thread only, all other threads continue execution.
+    bool m_nonStop;
 
     PVOID m_unregisterToken;
     DWORD m_processId;
@@ -113,6 +177,12 @@ protected:
 
     HRESULT CheckDebugProcess();
     bool HaveDebugProcess();
+    // Dump is read-only, return CORDBG_E_TARGET_READONLY for all requests that continue or change process.
+    HRESULT CheckNotDump();
+
+    // Dump analysis related, process object is provided by ICLRDebugging::OpenVirtualProcess() for dump data target.
+    std::unique_ptr<DumpDataTarget> m_uniqueDumpDataTarget;
+    std::unique_ptr<DumpLibraryProvider> m_uniqueDumpLibraryProvider;
 
     void InputCallback(IORedirectHelper::StreamType, span<char> text);
 
@@ -120,15 +190,39 @@ protected:
     void DisableAllBreakpointsAndSteppers();
 
     HRESULT GetFrameLocation(ICorDebugFrame *pFrame, ThreadId threadId, FrameLevel level, StackFrame &stackFrame, bool hotReloadAwareCaller = false);
+    // Note, in case maxFrames is not 0, stack walk stop after requested frames and totalFrames is `startFrame + maxFrames + 1`
+    // in case stack have more frames (same as DAP client expect for "more frames available" case).
     HRESULT GetManagedStackTrace(ICorDebugThread *pThread, ThreadId threadId, FrameLevel startFrame, unsigned maxFrames,
                                  std::vector<StackFrame> &stackFrames, int &totalFrames, bool hotReloadAwareCaller);
 #ifdef INTEROP_DEBUGGING
     HRESULT GetNativeStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames);
 #endif // INTEROP_DEBUGGING
+    // Caller must care about m_debugProcessRWLock.
+    HRESULT GetThreadStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames,
+                                bool hotReloadAwareCaller);
+    // Same as GetStackTrace(), but caller must care about m_debugProcessRWLock and process check.
+    // Note, could be called for different threads in parallel.
+    HRESULT GetCachedStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames,
+                                bool hotReloadAwareCaller);
 
     HRESULT FindEvalCapableThread(ToRelease<ICorDebugThread> &pThread);
-    HRESULT ApplyPdbDeltaAndLineUpdates(const std::string &dllFileName, const std::string &deltaPDB, const std::string &lineUpdates,
+    HRESULT ApplyPdbDeltaAndLineUpdates(const std::string &dllFileName, pdb_delta_t &pdbDelta,
                                         std::string &updatedDLL, std::unordered_set<mdTypeDef> &updatedTypeTokens);
+    HRESULT DisposeOutdatedDeltaSymbolReaders(ICorDebugModule *pModule);
+    // Unload not used symbol readers in case symbols memory limit exceeded, modules with breakpoints keep symbols.
+    void CheckSymbolsMemoryLimit();
+    // Emit protocol events for sources, that was loaded (with modules symbols) since previous call.
+    void EmitNewLoadedSources();
+    // Wait for LoadModule callbacks asynchronous work, so, modules events are emitted before stop or exit events.
+    void WaitLoadModuleTasks();
+
+    // Symbols idle timeout related, worker periodically unload symbol readers of modules without symbols access.
+    std::mutex m_symbolsIdleMutex;
+    std::condition_variable m_symbolsIdleCV;
+    bool m_symbolsIdleExit;
+    std::thread m_symbolsIdleWorker;
+
+    void SymbolsIdleWorker();
 };
 
 class ManagedDebuggerHelpers : public ManagedDebuggerBase
@@ -144,6 +238,8 @@ protected:
     HRESULT RunIfReady();
     HRESULT RunProcess(const std::string& fileExec, const std::vector<std::string>& execArgs);
     HRESULT AttachToProcess();
+    HRESULT OpenDumpProcess(const std::string &dumpPath);
+    void LoadDumpModulesAndThreads();
     HRESULT DetachFromProcess();
     HRESULT TerminateProcess();
 };
@@ -157,14 +253,37 @@ public:
     void SetJustMyCode(bool enable) override;
     bool IsStepFiltering() const override { return m_stepFiltering; }
     void SetStepFiltering(bool enable) override;
+    bool IsDeferredJMC() const override { return m_deferredJMC; }
+    void SetDeferredJMC(bool enable) override { m_deferredJMC = enable; }
+    unsigned GetEvalTimeout() const override;
+    void SetEvalTimeout(unsigned timeout) override;
+    bool IsAdaptiveEvalTimeout() const override;
+    void SetAdaptiveEvalTimeout(bool enable) override;
+    unsigned GetMaxParallelEvals() const override;
+    void SetMaxParallelEvals(unsigned count) override;
+    bool IsDeferPropertiesEvaluation() const override;
+    void SetDeferPropertiesEvaluation(bool enable) override;
+    bool IsArrayPreview() const override;
+    void SetArrayPreview(bool enable) override;
+    unsigned GetEvalBudget() const override;
+    void SetEvalBudget(unsigned budget) override;
     bool IsHotReload() const override { return m_hotReload; }
     HRESULT SetHotReload(bool enable) override;
+    void SetSymbolsMemoryLimit(uint64_t limit) override;
+    void SetSymbolsIdleTimeout(unsigned minutes) override;
+    void SetSymbolServers(const std::string &servers, const std::string &cachePath) override;
+    void SetSourceLink(bool enable, unsigned prefetchFrames) override;
+    void GetMemoryUsage(MemoryUsage &usage) override;
+    bool IsNonStop() const override { return m_nonStop; }
+    void SetNonStop(bool enable) override { m_nonStop = enable; }
 #ifdef INTEROP_DEBUGGING
     void SetInteropDebugging(bool enable) override;
 #endif
+    HRESULT SetSignalAction(const std::string &signal, SignalAction action) override;
 
     HRESULT Initialize() override;
     HRESULT Attach(int pid) override;
+    HRESULT OpenDump(const std::string &dumpPath) override;
     HRESULT Launch(const std::string &fileExec, const std::vector<std::string> &execArgs, const std::map<std::string, std::string> &env,
                    const std::string &cwd, bool stopAtEntry = false) override;
     HRESULT ConfigurationDone() override;
@@ -174,35 +293,63 @@ public:
     ThreadId GetLastStoppedThreadId() override;
     HRESULT Continue(ThreadId threadId) override;
     HRESULT Pause(ThreadId lastStoppedThread, EventFormat eventFormat) override;
-    HRESULT GetThreads(std::vector<Thread> &threads, bool withNativeThreads = false) override;
+    HRESULT GetThreads(std::vector<Thread> &threads, bool withNativeThreads = false, bool refreshNativeNames = false) override;
     HRESULT UpdateLineBreakpoint(int id, int linenum, Breakpoint &breakpoint) override;
     HRESULT SetLineBreakpoints(const std::string& filename, const std::vector<LineBreakpoint> &lineBreakpoints, std::vector<Breakpoint> &breakpoints) override;
     HRESULT SetFuncBreakpoints(const std::vector<FuncBreakpoint> &funcBreakpoints, std::vector<Breakpoint> &breakpoints) override;
     HRESULT SetExceptionBreakpoints(const std::vector<ExceptionBreakpoint> &exceptionBreakpoints, std::vector<Breakpoint> &breakpoints) override;
+    HRESULT SetDataBreakpoints(const std::vector<DataBreakpoint> &dataBreakpoints, std::vector<Breakpoint> &breakpoints) override;
+    HRESULT GetFieldDataBreakpointInfo(uint32_t variablesReference, const std::string &name, DataBreakpoint &dataBreakpoint,
+                                       std::string &description) override;
     HRESULT BreakpointActivate(int id, bool act) override;
     void EnumerateBreakpoints(std::function<bool (const IDebugger::BreakpointInfo&)>&& callback) override;
     HRESULT AllBreakpointsActivate(bool act) override;
     HRESULT GetStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames, bool hotReloadAwareCaller = false) override;
     HRESULT StepCommand(ThreadId threadId, StepType stepType) override;
+    HRESULT RunToLine(ThreadId threadId, const std::string &filename, int linenum) override;
+    HRESULT GetStepInTargets(FrameId frameId, std::vector<StepInTarget> &targets) override;
+    HRESULT StepIntoTarget(ThreadId threadId, int targetId) override;
     HRESULT GetScopes(FrameId frameId, std::vector<Scope> &scopes) override;
     HRESULT GetVariables(uint32_t variablesReference, VariablesFilter filter, int start, int count, std::vector<Variable> &variables) override;
     int GetNamedVariables(uint32_t variablesReference) override;
     HRESULT Evaluate(FrameId frameId, const std::string &expression, Variable &variable, std::string &output) override;
+    HRESULT EvaluateBatch(FrameId frameId, const std::vector<std::string> &expressions, std::vector<Variable> &variables,
+                          std::vector<HRESULT> &statuses, std::vector<std::string> &outputs) override;
+    HRESULT ReadString(FrameId frameId, const std::string &expression, int evalFlags, uint32_t offset, uint32_t count,
+                       std::string &value, uint32_t &read, uint32_t &length) override;
     void CancelEvalRunning() override;
     HRESULT SetVariable(const std::string &name, const std::string &value, uint32_t ref, std::string &output) override;
     HRESULT SetExpression(FrameId frameId, const std::string &expression, int evalFlags, const std::string &value, std::string &output) override;
     HRESULT GetExceptionInfo(ThreadId threadId, ExceptionInfo &exceptionInfo) override;
-    HRESULT GetSourceFile(const std::string &sourcePath, char** fileBuf, int* fileLen) override;
-    void FreeUnmanaged(PVOID mem) override;
+    HRESULT GetSourceFile(const std::string &sourcePath, std::shared_ptr<const char> &fileBuf, int &fileLen) override;
+    HRESULT Disassemble(std::uintptr_t address, int64_t offset, int instructionOffset, int instructionCount,
+                        bool resolveSymbols, std::vector<DisassembledInstruction> &instructions) override;
+    HRESULT ReadMemory(std::uintptr_t address, int64_t offset, uint32_t count, std::string &data, uint32_t &unreadableBytes) override;
+    HRESULT WriteMemory(std::uintptr_t address, int64_t offset, const std::string &data, bool allowPartial, uint32_t &bytesWritten) override;
     HRESULT HotReloadApplyDeltas(const std::string &dllFileName, const std::string &deltaMD, const std::string &deltaIL,
                                  const std::string &deltaPDB, const std::string &lineUpdates) override;
 
     void FindFileNames(string_view pattern, unsigned limit, SearchCallback) override;
+    unsigned GetLoadedSources(unsigned startIndex, unsigned count, SearchCallback) override;
+    void SearchSources(string_view pattern, unsigned limit, SearchCallback) override;
     void FindFunctions(string_view pattern, unsigned limit, SearchCallback) override;
     void FindVariables(ThreadId, FrameLevel, string_view pattern, unsigned limit, SearchCallback) override;
+    HRESULT StartSampling(unsigned interval) override;
+    HRESULT StopSampling(uint64_t &samplesCount) override;
+    HRESULT ExportSamples(SamplesFormat format, std::string &output) override;
+    void SetExceptionStatistics(bool enable) override;
+    bool IsExceptionStatistics() override;
+    HRESULT GetExceptionStatistics(std::vector<ExceptionStatistic> &statistics, uint64_t &droppedCount, bool reset) override;
+    HRESULT GetTraceRecords(std::vector<TraceRecord> &records, uint64_t &overwrittenCount, bool drain) override;
+    HRESULT ClearTraceRecords() override;
+    HRESULT GetHeapStatistics(unsigned topCount, bool sortByCount, HeapStatisticsCallback callback, HeapStatistics &statistics) override;
+    HRESULT FindGCRootPath(FrameId frameId, const std::string &expression, int evalFlags, GCRootPath &path) override;
+    HRESULT GetAsyncTasks(bool includeCompleted, std::vector<AsyncTaskGroup> &groups, uint64_t &tasksCount) override;
+    HRESULT SnapshotAndDetach(unsigned localsFrames, std::string &output) override;
 
     // pass some data to debugee stdin
     IDebugger::AsyncResult ProcessStdin(InStream &) override;
+    void SetOutputPassthrough() override;
 };
 
 } // namespace netcoredbg
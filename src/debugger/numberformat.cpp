@@ -0,0 +1,202 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/numberformat.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace netcoredbg
+{
+
+namespace NumberFormat
+{
+
+// Integer is divided by 10^9 (biggest power of 10 in 32 bits), so, each division provide 9 digits at once,
+// instead of one digit per long division pass.
+static const uint32_t ChunkDivisor = 1000000000;
+static const size_t ChunkDigits = 9;
+
+std::string UIntToString(uint32_t *words, size_t count)
+{
+    while (count > 0 && words[count - 1] == 0)
+        count--;
+
+    if (count == 0)
+        return "0";
+
+    // Chunks are produced from least significant, so, digits are written from buffer end.
+    // Note, each 32-bit word provide less than 10 decimal digits.
+    std::string buffer(count * 10 + ChunkDigits, '0');
+    size_t pos = buffer.size();
+
+    while (count > 0)
+    {
+        uint64_t remainder = 0;
+        for (size_t i = count; i-- > 0;)
+        {
+            const uint64_t dividend = (remainder << 32) | words[i];
+            words[i] = static_cast<uint32_t>(dividend / ChunkDivisor);
+            remainder = dividend % ChunkDivisor;
+        }
+        while (count > 0 && words[count - 1] == 0)
+            count--;
+
+        uint32_t chunk = static_cast<uint32_t>(remainder);
+        const size_t end = pos - ChunkDigits;
+        // Note, leading zeros are written for all chunks, but not for most significant one.
+        while (pos > end && (chunk != 0 || count > 0))
+        {
+            buffer[--pos] = static_cast<char>('0' + chunk % 10);
+            chunk /= 10;
+        }
+    }
+
+    return buffer.substr(pos);
+}
+
+std::string DecimalToString(uint32_t hi, uint32_t mid, uint32_t lo, uint32_t flags)
+{
+    static const uint32_t ScaleMask = 0x00FF0000ul;
+    static const uint32_t ScaleShift = 16;
+    static const uint32_t SignMask = 1ul << 31;
+
+    uint32_t words[3] = { lo, mid, hi };
+    std::string output = UIntToString(words, 3);
+
+    const size_t scale = (flags & ScaleMask) >> ScaleShift;
+    const size_t len = output.length();
+
+    if (len > scale)
+    {
+        if (scale != 0)
+            output.insert(len - scale, 1, '.');
+    }
+    else
+    {
+        output.insert(0, "0.");
+        output.insert(2, scale - len, '0');
+    }
+
+    if (flags & SignMask)
+        output.insert(0, 1, '-');
+
+    return output;
+}
+
+std::string BigIntegerToString(bool negative, uint32_t *words, size_t count)
+{
+    std::string output = UIntToString(words, count);
+    if (negative && output != "0")
+        output.insert(0, 1, '-');
+    return output;
+}
+
+static const uint64_t TicksPerSecond = 10000000;
+static const uint64_t TicksPerMinute = TicksPerSecond * 60;
+static const uint64_t TicksPerDay = TicksPerSecond * 60 * 60 * 24;
+static const uint64_t DateTimeTicksMask = 0x3FFFFFFFFFFFFFFFull;
+// Note, DateTime.MaxValue ticks, bigger ticks could be only in case of broken data.
+static const uint64_t DateTimeMaxTicks = 3155378975999999999ull;
+
+// Same as DateTime.GetDate() (days from 0001-01-01 to date conversion by 400, 100, 4 and 1 years periods).
+static void TicksToDate(uint64_t ticks, unsigned &year, unsigned &month, unsigned &day)
+{
+    static const unsigned DaysPer400Years = 146097;
+    static const unsigned DaysPer100Years = 36524;
+    static const unsigned DaysPer4Years = 1461;
+    static const unsigned DaysPerYear = 365;
+    static const unsigned DaysToMonth365[13] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365};
+    static const unsigned DaysToMonth366[13] = {0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366};
+
+    unsigned n = unsigned(ticks / TicksPerDay);
+    const unsigned y400 = n / DaysPer400Years;
+    n -= y400 * DaysPer400Years;
+    unsigned y100 = n / DaysPer100Years;
+    if (y100 == 4)
+        y100 = 3;
+    n -= y100 * DaysPer100Years;
+    const unsigned y4 = n / DaysPer4Years;
+    n -= y4 * DaysPer4Years;
+    unsigned y1 = n / DaysPerYear;
+    if (y1 == 4)
+        y1 = 3;
+    n -= y1 * DaysPerYear;
+
+    year = y400 * 400 + y100 * 100 + y4 * 4 + y1 + 1;
+    const bool leapYear = y1 == 3 && (y4 != 24 || y100 == 3);
+    const unsigned *days = leapYear ? DaysToMonth366 : DaysToMonth365;
+    month = 1;
+    while (n >= days[month])
+        month++;
+    day = n - days[month - 1] + 1;
+}
+
+std::string DateTimeToString(uint64_t dateData)
+{
+    uint64_t ticks = dateData & DateTimeTicksMask;
+    if (ticks > DateTimeMaxTicks)
+        ticks = DateTimeMaxTicks;
+
+    unsigned year, month, day;
+    TicksToDate(ticks, year, month, day);
+    const unsigned seconds = unsigned((ticks % TicksPerDay) / TicksPerSecond);
+
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%02u/%02u/%04u %02u:%02u:%02u", month, day, year, seconds / 3600, seconds / 60 % 60, seconds % 60);
+    return buf;
+}
+
+std::string DateTimeOffsetToString(uint64_t dateData, int16_t offsetMinutes)
+{
+    // Note, local date and time is printed, same as DateTimeOffset.ToString() do.
+    const int64_t offsetTicks = int64_t(offsetMinutes) * int64_t(TicksPerMinute);
+    const int64_t ticks = int64_t(dateData & DateTimeTicksMask) + offsetTicks;
+    std::string output = DateTimeToString(ticks < 0 ? 0 : uint64_t(ticks));
+
+    const unsigned offset = unsigned(offsetMinutes < 0 ? -int(offsetMinutes) : int(offsetMinutes));
+    char buf[16];
+    snprintf(buf, sizeof(buf), " %c%02u:%02u", offsetMinutes < 0 ? '-' : '+', offset / 60, offset % 60);
+    return output + buf;
+}
+
+std::string TimeSpanToString(int64_t ticks)
+{
+    // Note, magnitude is calculated as unsigned, since -TimeSpan.MinValue.Ticks can't be represented by int64_t.
+    const uint64_t magnitude = ticks < 0 ? 0 - uint64_t(ticks) : uint64_t(ticks);
+    const uint64_t days = magnitude / TicksPerDay;
+    const uint64_t time = magnitude % TicksPerDay;
+    const unsigned seconds = unsigned(time / TicksPerSecond);
+    const unsigned fraction = unsigned(time % TicksPerSecond);
+
+    char buf[48];
+    int length = 0;
+    if (ticks < 0)
+        buf[length++] = '-';
+    if (days != 0)
+        length += snprintf(buf + length, sizeof(buf) - length, "%llu.", (unsigned long long)days);
+    length += snprintf(buf + length, sizeof(buf) - length, "%02u:%02u:%02u", seconds / 3600, seconds / 60 % 60, seconds % 60);
+    if (fraction != 0)
+        snprintf(buf + length, sizeof(buf) - length, ".%07u", fraction);
+    return buf;
+}
+
+std::string GuidToString(const uint8_t *data)
+{
+    // Guid fields: int _a; short _b; short _c; byte _d, _e, _f, _g, _h, _i, _j, _k (sequential layout).
+    uint32_t a;
+    uint16_t b, c;
+    memcpy(&a, data, sizeof(a));
+    memcpy(&b, data + 4, sizeof(b));
+    memcpy(&c, data + 6, sizeof(c));
+
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%08x-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x", unsigned(a), unsigned(b), unsigned(c),
+             data[8], data[9], data[10], data[11], data[12], data[13], data[14], data[15]);
+    return buf;
+}
+
+} // namespace NumberFormat
+
+} // namespace netcoredbg
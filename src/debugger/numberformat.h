@@ -0,0 +1,44 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace netcoredbg
+{
+
+namespace NumberFormat
+{
+    // Decimal digits of unsigned integer provided as little-endian 32-bit words. Note, `words` are used as
+    // scratch buffer and contain zero after call.
+    std::string UIntToString(uint32_t *words, size_t count);
+
+    // System.Decimal value, `hi`, `mid` and `lo` are 96-bit integer parts, `flags` contain scale and sign
+    // (same as decimal.GetBits() provide).
+    std::string DecimalToString(uint32_t hi, uint32_t mid, uint32_t lo, uint32_t flags);
+
+    // System.Numerics.BigInteger value, magnitude provided as little-endian 32-bit words (`words` are used as
+    // scratch buffer, see UIntToString()).
+    std::string BigIntegerToString(bool negative, uint32_t *words, size_t count);
+
+    // Following functions format values same as ToString() with invariant culture do, values are decoded from
+    // raw fields data, so, no func-eval needed.
+
+    // System.DateTime value (`_dateData` field: ticks and kind in 2 high bits), "MM/dd/yyyy HH:mm:ss" format.
+    std::string DateTimeToString(uint64_t dateData);
+
+    // System.DateTimeOffset value, `dateData` is UTC date and time, "MM/dd/yyyy HH:mm:ss +hh:mm" format.
+    std::string DateTimeOffsetToString(uint64_t dateData, int16_t offsetMinutes);
+
+    // System.TimeSpan value (`_ticks` field), "[-][d.]hh:mm:ss[.fffffff]" format.
+    std::string TimeSpanToString(int64_t ticks);
+
+    // System.Guid value (16 bytes of structure in target byte order), "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx" format.
+    std::string GuidToString(const uint8_t *data);
+
+} // namespace NumberFormat
+
+} // namespace netcoredbg
@@ -0,0 +1,242 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/sampling_profiler.h"
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include "debugger/frames.h"
+#include "metadata/metadata_index.h"
+#include "metadata/modules.h"
+#include "utils/filesystem.h"
+#include "utils/logger.h"
+#include "utils/torelease.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+
+    typedef StackSamples::frame_t frame_t;
+
+    // Note, not managed frames are stored with zero module address and frame type as token.
+    frame_t GetSampleFrame(FrameType frameType, ICorDebugFrame *pFrame)
+    {
+        if (frameType == FrameCLRManaged)
+        {
+            ToRelease<ICorDebugFunction> iCorFunction;
+            ToRelease<ICorDebugModule> iCorModule;
+            CORDB_ADDRESS modAddress = 0;
+            mdMethodDef methodDef = mdMethodDefNil;
+            if (SUCCEEDED(pFrame->GetFunction(&iCorFunction)) &&
+                SUCCEEDED(iCorFunction->GetModule(&iCorModule)) &&
+                SUCCEEDED(iCorModule->GetBaseAddress(&modAddress)) &&
+                SUCCEEDED(iCorFunction->GetToken(&methodDef)) &&
+                modAddress != 0)
+            {
+                return frame_t(modAddress, methodDef);
+            }
+
+            return frame_t(0, FrameUnknown);
+        }
+
+        if (frameType == FrameCLRInternal)
+        {
+            ToRelease<ICorDebugInternalFrame> iCorInternalFrame;
+            CorDebugInternalFrameType corFrameType;
+            if (SUCCEEDED(pFrame->QueryInterface(IID_ICorDebugInternalFrame, (LPVOID*) &iCorInternalFrame)) &&
+                SUCCEEDED(iCorInternalFrame->GetFrameType(&corFrameType)))
+            {
+                return frame_t(0, FrameCLRInternal | (uint32_t(corFrameType) << 8));
+            }
+
+            return frame_t(0, FrameUnknown);
+        }
+
+        // Same as stack trace without interop, CoreCLR native frame and user's native frames are merged.
+        if (frameType == FrameNative)
+            frameType = FrameCLRNative;
+
+        return frame_t(0, frameType);
+    }
+
+    std::string GetNotManagedFrameName(uint32_t token)
+    {
+        switch (token & 0xff)
+        {
+            case FrameCLRInternal:
+                return std::string("[") + GetInternalTypeName(CorDebugInternalFrameType(token >> 8)) + "]";
+            case FrameCLRNative:
+                return "[Native Frames]";
+            default:
+                return "?";
+        }
+    }
+
+    // Module's names and methods names, resolved at export only.
+    struct module_names_t
+    {
+        std::string name;
+        MetadataIndex::index_ptr_t index;
+        std::unordered_map<mdMethodDef, size_t> methods; // method token -> method index in metadata index
+    };
+
+} // unnamed namespace
+
+HRESULT SamplingProfiler::Start(unsigned intervalMs, CollectCallback collect)
+{
+    if (intervalMs == 0 || !collect)
+        return E_INVALIDARG;
+
+    Stop();
+    m_samples.Clear();
+
+    std::lock_guard<std::mutex> lock(m_workerMutex);
+    m_exit = false;
+    m_worker = std::thread(&SamplingProfiler::Worker, this, std::chrono::milliseconds(intervalMs), std::move(collect));
+    return S_OK;
+}
+
+void SamplingProfiler::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_workerMutex);
+        m_exit = true;
+    }
+    m_workerCV.notify_one();
+
+    if (m_worker.joinable())
+        m_worker.join();
+}
+
+bool SamplingProfiler::IsRunning()
+{
+    std::lock_guard<std::mutex> lock(m_workerMutex);
+    return m_worker.joinable() && !m_exit;
+}
+
+void SamplingProfiler::Worker(std::chrono::milliseconds interval, CollectCallback collect)
+{
+    std::vector<StackSamples::stack_t> stacks;
+    auto nextSample = std::chrono::steady_clock::now() + interval;
+
+    std::unique_lock<std::mutex> lock(m_workerMutex);
+    while (!m_workerCV.wait_until(lock, nextSample, [this](){ return m_exit; }))
+    {
+        lock.unlock();
+
+        stacks.clear();
+        HRESULT Status = collect(stacks);
+        if (Status == S_OK)
+            m_samples.AddSample(stacks);
+        else if (FAILED(Status))
+            LOGW("Stacks sample failed, error 0x%x", Status);
+
+        // Note, in case sample take more than interval, next sample is not delayed by missed samples.
+        nextSample = std::max(nextSample + interval, std::chrono::steady_clock::now());
+
+        lock.lock();
+    }
+}
+
+HRESULT SamplingProfiler::CollectThreadsStacks(ICorDebugProcess *pProcess, std::vector<StackSamples::stack_t> &stacks)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugThreadEnum> iCorThreadEnum;
+    IfFailRet(pProcess->EnumerateThreads(&iCorThreadEnum));
+
+    ULONG fetched = 0;
+    ToRelease<ICorDebugThread> iCorThread;
+    while (SUCCEEDED(iCorThreadEnum->Next(1, &iCorThread, &fetched)) && fetched == 1)
+    {
+        stacks.emplace_back();
+        StackSamples::stack_t &stack = stacks.back();
+
+        // Note, stack is collected even if walk failed in the middle, top frames are the most valuable part of sample.
+        WalkFrames(iCorThread, [&](FrameType frameType, std::uintptr_t, ICorDebugFrame *pFrame, NativeFrame *)
+        {
+            const frame_t frame = GetSampleFrame(frameType, pFrame);
+            // Consecutive not managed frames are collapsed, same as native frames in stack trace.
+            if (frame.module == 0 && !stack.empty() && stack.back() == frame)
+                return S_OK;
+
+            stack.push_back(frame);
+            return S_OK;
+        },
+        []()
+        {
+            return false;
+        });
+
+        std::reverse(stack.begin(), stack.end());
+        iCorThread.Free();
+    }
+
+    return S_OK;
+}
+
+HRESULT SamplingProfiler::Export(SamplesFormat format, std::string &output)
+{
+    std::vector<frame_t> frames;
+    m_samples.GetFrames(frames);
+
+    std::map<uint64_t, module_names_t> modules;
+    for (const frame_t &frame : frames)
+    {
+        if (frame.module != 0)
+            modules.emplace(frame.module, module_names_t());
+    }
+
+    HRESULT Status;
+    IfFailRet(m_sharedModules->ForEachModule([&](ICorDebugModule *pModule)
+    {
+        CORDB_ADDRESS modAddress = 0;
+        if (FAILED(pModule->GetBaseAddress(&modAddress)))
+            return S_OK;
+
+        auto find = modules.find(modAddress);
+        if (find == modules.end())
+            return S_OK;
+
+        module_names_t &names = find->second;
+        names.name = GetBasename(GetModuleFileName(pModule));
+        if (FAILED(MetadataIndex::GetModuleIndex(pModule, names.index)))
+            return S_OK;
+
+        for (size_t i = 0; i < names.index->methods.size(); i++)
+        {
+            names.methods.emplace(names.index->methods[i].methodDef, i);
+        }
+        return S_OK;
+    }));
+
+    auto frameName = [&](const frame_t &frame) -> std::string
+    {
+        if (frame.module == 0)
+            return GetNotManagedFrameName(frame.token);
+
+        // Note, module could be already unloaded.
+        auto find = modules.find(frame.module);
+        if (find == modules.end() || find->second.name.empty())
+            return "<unknown module>!" + std::to_string(frame.token);
+
+        const module_names_t &names = find->second;
+        auto method = names.methods.find(frame.token);
+        if (method == names.methods.end())
+            return names.name + "!" + std::to_string(frame.token);
+
+        return names.name + "!" + names.index->GetMethodFullName(names.index->methods[method->second]);
+    };
+
+    if (format == SamplesFormat::Speedscope)
+        m_samples.ExportSpeedscope(frameName, "netcoredbg", output);
+    else
+        m_samples.ExportFolded(frameName, output);
+
+    return S_OK;
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,63 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "debugger/stack_samples.h"
+#include "interfaces/types.h"
+
+namespace netcoredbg
+{
+
+class Modules;
+
+// Periodically stop process, walk all threads stacks and resume process, each sample is aggregated in memory as collapsed
+// stacks with frames identity only (module address and method token), frames names are resolved at export.
+class SamplingProfiler
+{
+public:
+
+    // Must stop process, collect all threads stacks and resume process, return S_FALSE in case sample was skipped.
+    typedef std::function<HRESULT(std::vector<StackSamples::stack_t> &stacks)> CollectCallback;
+
+    SamplingProfiler(std::shared_ptr<Modules> &sharedModules) : m_sharedModules(sharedModules), m_exit(false) {}
+    ~SamplingProfiler() { Stop(); }
+
+    // Note, previous samples are dropped at start.
+    HRESULT Start(unsigned intervalMs, CollectCallback collect);
+    void Stop();
+    bool IsRunning();
+    uint64_t GetSamplesCount() const { return m_samples.GetSamplesCount(); }
+    // Could be called during sampling or after stop, modules must not be changed during call (process must not be destroyed).
+    HRESULT Export(SamplesFormat format, std::string &output);
+
+    // Collect stacks of all process threads from root to leaf, process must be stopped.
+    // Note, native frames are collapsed and not symbolized, since this is hot path of sampling.
+    static HRESULT CollectThreadsStacks(ICorDebugProcess *pProcess, std::vector<StackSamples::stack_t> &stacks);
+
+private:
+
+    std::shared_ptr<Modules> m_sharedModules;
+    StackSamples m_samples;
+
+    std::mutex m_workerMutex;
+    std::condition_variable m_workerCV;
+    bool m_exit;
+    std::thread m_worker;
+
+    void Worker(std::chrono::milliseconds interval, CollectCallback collect);
+};
+
+} // namespace netcoredbg
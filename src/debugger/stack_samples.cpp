@@ -0,0 +1,151 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/stack_samples.h"
+
+#include <algorithm>
+#include <cstdio>
+#include "utils/jsonstring.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+
+    // Note, frames names are resolved once for each unique frame, not for each frame of each stack.
+    class FramesNames
+    {
+    public:
+
+        FramesNames(const StackSamples::FrameNameCallback &frameName) : m_frameName(frameName) {}
+
+        // Return frame index in unique frames list.
+        size_t GetIndex(const StackSamples::frame_t &frame)
+        {
+            auto find = m_indexes.find(frame);
+            if (find != m_indexes.end())
+                return find->second;
+
+            m_names.emplace_back(m_frameName(frame));
+            return m_indexes.emplace(frame, m_names.size() - 1).first->second;
+        }
+
+        const std::string &GetName(size_t index) const { return m_names[index]; }
+        const std::vector<std::string> &GetNames() const { return m_names; }
+
+    private:
+
+        const StackSamples::FrameNameCallback &m_frameName;
+        std::map<StackSamples::frame_t, size_t> m_indexes;
+        std::vector<std::string> m_names;
+    };
+
+} // unnamed namespace
+
+void StackSamples::AddSample(const std::vector<stack_t> &stacks)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const stack_t &stack : stacks)
+    {
+        if (!stack.empty())
+            m_stacks[stack]++;
+    }
+    m_samplesCount++;
+}
+
+uint64_t StackSamples::GetSamplesCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_samplesCount;
+}
+
+void StackSamples::GetFrames(std::vector<frame_t> &frames) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto &entry : m_stacks)
+    {
+        frames.insert(frames.end(), entry.first.begin(), entry.first.end());
+    }
+    std::sort(frames.begin(), frames.end());
+    frames.erase(std::unique(frames.begin(), frames.end()), frames.end());
+}
+
+void StackSamples::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stacks.clear();
+    m_samplesCount = 0;
+}
+
+void StackSamples::ExportFolded(const FrameNameCallback &frameName, std::string &output) const
+{
+    FramesNames names(frameName);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto &entry : m_stacks)
+    {
+        for (size_t i = 0; i < entry.first.size(); i++)
+        {
+            if (i != 0)
+                output += ';';
+            // Note, ';' is frames separator in folded format.
+            std::string name = names.GetName(names.GetIndex(entry.first[i]));
+            std::replace(name.begin(), name.end(), ';', ':');
+            output += name;
+        }
+        output += ' ';
+        output += std::to_string(entry.second);
+        output += '\n';
+    }
+}
+
+void StackSamples::ExportSpeedscope(const FrameNameCallback &frameName, const std::string &profileName, std::string &output) const
+{
+    FramesNames names(frameName);
+    std::string samples;
+    std::string weights;
+    uint64_t totalWeight = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto &entry : m_stacks)
+        {
+            samples += samples.empty() ? "[" : ",[";
+            for (size_t i = 0; i < entry.first.size(); i++)
+            {
+                if (i != 0)
+                    samples += ',';
+                samples += std::to_string(names.GetIndex(entry.first[i]));
+            }
+            samples += ']';
+
+            if (!weights.empty())
+                weights += ',';
+            weights += std::to_string(entry.second);
+            totalWeight += entry.second;
+        }
+    }
+
+    output += "{\"$schema\":\"https://www.speedscope.app/file-format-schema.json\",\"shared\":{\"frames\":[";
+    for (size_t i = 0; i < names.GetNames().size(); i++)
+    {
+        output += i == 0 ? "{\"name\":" : ",{\"name\":";
+        AppendJsonString(output, names.GetNames()[i]);
+        output += '}';
+    }
+    output += "]},\"profiles\":[{\"type\":\"sampled\",\"name\":";
+    AppendJsonString(output, profileName);
+    output += ",\"unit\":\"none\",\"startValue\":0,\"endValue\":";
+    output += std::to_string(totalWeight);
+    output += ",\"samples\":[";
+    output += samples;
+    output += "],\"weights\":[";
+    output += weights;
+    output += "]}],\"name\":";
+    AppendJsonString(output, profileName);
+    output += ",\"exporter\":\"netcoredbg\"}";
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,64 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace netcoredbg
+{
+
+// Call stacks collected by sampling profiler, aggregated by identical stacks. Frames are stored as identity only
+// (module address and method token), frames names are resolved at export, so, sample add don't need any symbols.
+class StackSamples
+{
+public:
+
+    struct frame_t
+    {
+        uint64_t module; // module base address, 0 for not managed frame
+        uint32_t token;  // method token for managed frame, frame kind for not managed frame
+
+        frame_t(uint64_t module_, uint32_t token_) : module(module_), token(token_) {}
+
+        bool operator<(const frame_t &other) const
+        {
+            return module < other.module || (module == other.module && token < other.token);
+        }
+        bool operator==(const frame_t &other) const
+        {
+            return module == other.module && token == other.token;
+        }
+    };
+    // Frames from root to leaf.
+    typedef std::vector<frame_t> stack_t;
+    // Called once for each unique frame at export.
+    typedef std::function<std::string(const frame_t &frame)> FrameNameCallback;
+
+    StackSamples() : m_samplesCount(0) {}
+
+    // Add stacks collected by one sample (all threads), empty stacks are ignored.
+    void AddSample(const std::vector<stack_t> &stacks);
+    uint64_t GetSamplesCount() const;
+    void GetFrames(std::vector<frame_t> &frames) const;
+    void Clear();
+
+    // "Folded" (collapsed stacks) format, one line per unique stack: `root;...;leaf count`.
+    void ExportFolded(const FrameNameCallback &frameName, std::string &output) const;
+    // Speedscope "sampled" profile JSON, see https://www.speedscope.app/file-format-schema.json
+    void ExportSpeedscope(const FrameNameCallback &frameName, const std::string &profileName, std::string &output) const;
+
+private:
+
+    mutable std::mutex m_mutex;
+    std::map<stack_t, uint64_t> m_stacks;
+    uint64_t m_samplesCount;
+};
+
+} // namespace netcoredbg
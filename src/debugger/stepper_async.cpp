@@ -6,6 +6,7 @@
 #include "debugger/stepper_async.h"
 #include "debugger/threads.h"
 #include "metadata/typeprinter.h"
+#include "metadata/metadata_index.h"
 #include "debugger/evalhelpers.h"
 #include "debugger/valueprint.h"
 #include "utils/utf.h"
@@ -177,34 +178,21 @@ static HRESULT SetNotificationForWaitCompletion(ICorDebugThread *pThread, ICorDe
 
     ToRelease<ICorDebugModule> pModule;
     IfFailRet(pClass->GetModule(&pModule));
-    ToRelease<IUnknown> pMDUnknown;
-    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
-    ToRelease<IMetaDataImport> pMD;
-    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
+    MetadataIndex::index_ptr_t index;
+    IfFailRet(MetadataIndex::GetModuleIndex(pModule, index));
+    const module_metadata_index_t::type_t *pTypeIndex = index->FindType(typeDef);
+    if (pTypeIndex == nullptr)
+        return E_FAIL;
 
-    ULONG numMethods = 0;
-    HCORENUM hEnum = NULL;
-    mdMethodDef methodDef;
     mdMethodDef setNotifDef = mdMethodDefNil;
-    while(SUCCEEDED(pMD->EnumMethods(&hEnum, typeDef, &methodDef, 1, &numMethods)) && numMethods != 0)
+    for (size_t i = pTypeIndex->methodsBegin; i < pTypeIndex->methodsEnd; i++)
     {
-        mdTypeDef memTypeDef;
-        ULONG nameLen;
-        WCHAR szFunctionName[mdNameLen] = {0};
-        if (FAILED(pMD->GetMethodProps(methodDef, &memTypeDef,
-                                       szFunctionName, _countof(szFunctionName), &nameLen,
-                                       nullptr, nullptr, nullptr, nullptr, nullptr)))
+        if (index->methods[i].name == "SetNotificationForWaitCompletion")
         {
-            continue;
+            setNotifDef = index->methods[i].methodDef;
+            break;
         }
-
-        if (!str_equal(szFunctionName, W("SetNotificationForWaitCompletion")))
-            continue;
-
-        setNotifDef = methodDef;
-        break;
     }
-    pMD->CloseEnum(hEnum);
 
     if (setNotifDef == mdMethodDefNil)
         return E_FAIL;
@@ -3,6 +3,8 @@
 // See the LICENSE file in the project root for more information.
 
 #include "debugger/stepper_simple.h"
+#include "debugger/frames.h"
+#include "debugger/stepstats.h"
 #include "debugger/threads.h"
 #include "interfaces/idebugger.h"
 #include "metadata/modules.h"
@@ -10,10 +12,148 @@
 namespace netcoredbg
 {
 
+// Max caller frames checked for user code during step-out.
+static const int MaxStepOutFrames = 128;
+
+// Step-out from method called by not user code (framework callbacks, LINQ lambdas, etc.) with JMC stepper is done by runtime
+// frame by frame till user code reached. In case first caller frame is not user code, setup breakpoint at return address of
+// first user code caller frame instead, so, step-out need only one process continue.
+// Return S_FALSE in case step-out breakpoint is not needed (stepper's step-out should be used).
+HRESULT SimpleStepper::SetupStepOutBreakpoint(ICorDebugThread *pThread)
+{
+    HRESULT Status;
+
+    auto isUserCode = [&](ICorDebugFrame *pFrame) -> bool
+    {
+        if (m_justMyCode)
+        {
+            ToRelease<ICorDebugFunction> iCorFunction;
+            if (FAILED(pFrame->GetFunction(&iCorFunction)) ||
+                !m_sharedModules->GetUserCodeProperty(iCorFunction, UserCodeCache::Property::JMCStatus, [&]() -> bool
+                {
+                    ToRelease<ICorDebugFunction2> iCorFunction2;
+                    BOOL JMCStatus = FALSE;
+                    return SUCCEEDED(iCorFunction->QueryInterface(IID_ICorDebugFunction2, (LPVOID*) &iCorFunction2)) &&
+                           SUCCEEDED(iCorFunction2->GetJMCStatus(&JMCStatus)) &&
+                           JMCStatus != FALSE;
+                }))
+                return false;
+        }
+        // Same as for step complete, step only for code with PDB loaded (no matter JMC enabled or not by user).
+        ULONG32 ipOffset = 0;
+        ULONG32 ilNextUserCodeOffset = 0;
+        return SUCCEEDED(m_sharedModules->GetFrameILAndNextUserCodeILOffset(pFrame, ipOffset, ilNextUserCodeOffset, nullptr));
+    };
+
+    // Note, frames cache can't be used here, since step-out could be setup during step filtering in callback
+    // (process was continued after last stop), walk only managed frames till first user code caller.
+    ToRelease<ICorDebugFrame> iCorFrame;
+    int managedFrames = 0;
+    WalkFrames(pThread, [&](
+        FrameType frameType,
+        std::uintptr_t addr,
+        ICorDebugFrame *pFrame,
+        NativeFrame *pNative)
+    {
+        if (frameType != FrameCLRManaged)
+            return S_OK;
+
+        managedFrames++;
+        if (managedFrames == 1) // current frame
+            return S_OK;
+        if (managedFrames > MaxStepOutFrames)
+            return E_ABORT;
+
+        if (!isUserCode(pFrame))
+            return S_OK;
+
+        pFrame->AddRef();
+        iCorFrame = pFrame;
+        return E_ABORT; // Fast exit from cycle.
+    },
+    []()
+    {
+        return false; // Only managed frames required, native frames symbolization is not needed.
+    });
+
+    // Caller is user code (runtime step-out is fine) or no user code found in callers.
+    if (iCorFrame == nullptr || managedFrames == 2)
+        return S_FALSE;
+
+    ToRelease<ICorDebugNativeFrame> iCorNativeFrame;
+    IfFailRet(iCorFrame->QueryInterface(IID_ICorDebugNativeFrame, (LPVOID*) &iCorNativeFrame));
+    // Note, for caller frame native IP is return address.
+    ULONG32 nativeOffset;
+    IfFailRet(iCorNativeFrame->GetIP(&nativeOffset));
+    ToRelease<ICorDebugCode> iCorNativeCode;
+    IfFailRet(iCorNativeFrame->GetCode(&iCorNativeCode));
+    CORDB_ADDRESS frameStart;
+    CORDB_ADDRESS frameEnd;
+    IfFailRet(iCorFrame->GetStackRange(&frameStart, &frameEnd));
+
+    ToRelease<ICorDebugFunctionBreakpoint> iCorBreakpoint;
+    IfFailRet(iCorNativeCode->CreateBreakpoint(nativeOffset, &iCorBreakpoint));
+    IfFailRet(iCorBreakpoint->Activate(TRUE));
+
+    std::lock_guard<std::mutex> lock(m_stepMutex);
+    DeleteStepOutBreakpoint();
+    m_iCorStepOutBreakpoint = iCorBreakpoint.Detach();
+    m_stepOutThreadId = int(getThreadId(pThread));
+    m_stepOutFrameStart = frameStart;
+
+    return S_OK;
+}
+
+void SimpleStepper::DeleteStepOutBreakpoint()
+{
+    // Note, caller must hold m_stepMutex.
+    if (!m_iCorStepOutBreakpoint)
+        return;
+
+    m_iCorStepOutBreakpoint->Activate(FALSE);
+    m_iCorStepOutBreakpoint.Free();
+    m_stepOutThreadId = 0;
+    m_stepOutFrameStart = 0;
+}
+
+HRESULT SimpleStepper::CheckStepOutBreakpoint(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, bool &reached)
+{
+    reached = false;
+    std::lock_guard<std::mutex> lock(m_stepMutex);
+
+    if (!m_iCorStepOutBreakpoint)
+        return S_FALSE;
+
+    ToRelease<ICorDebugFunctionBreakpoint> iCorFunctionBreakpoint;
+    if (FAILED(pBreakpoint->QueryInterface(IID_ICorDebugFunctionBreakpoint, (LPVOID*) &iCorFunctionBreakpoint)) ||
+        iCorFunctionBreakpoint.GetPtr() != m_iCorStepOutBreakpoint.GetPtr())
+        return S_FALSE;
+
+    // Note, step-out breakpoint could be hit by other thread or by recursive call of same method (other frame), ignore it.
+    ToRelease<ICorDebugFrame> iCorFrame;
+    CORDB_ADDRESS frameStart;
+    CORDB_ADDRESS frameEnd;
+    if (int(getThreadId(pThread)) != m_stepOutThreadId ||
+        FAILED(pThread->GetActiveFrame(&iCorFrame)) || iCorFrame == nullptr ||
+        FAILED(iCorFrame->GetStackRange(&frameStart, &frameEnd)) ||
+        frameStart != m_stepOutFrameStart)
+        return S_OK;
+
+    DeleteStepOutBreakpoint();
+    reached = true;
+    return S_OK;
+}
+
 HRESULT SimpleStepper::SetupStep(ICorDebugThread *pThread, IDebugger::StepType stepType)
 {
     HRESULT Status;
 
+    if (stepType == IDebugger::STEP_OUT && SetupStepOutBreakpoint(pThread) == S_OK)
+    {
+        StepStats::MarkStepStart();
+        return S_OK;
+    }
+
     ToRelease<ICorDebugStepper> pStepper;
     IfFailRet(pThread->CreateStepper(&pStepper));
 
@@ -36,6 +176,7 @@ HRESULT SimpleStepper::SetupStep(ICorDebugThread *pThread, IDebugger::StepType s
     if (stepType == IDebugger::STEP_OUT)
     {
         IfFailRet(pStepper->StepOut());
+        StepStats::MarkStepStart();
 
         std::lock_guard<std::mutex> lock(m_stepMutex);
         m_enabledSimpleStepId = int(threadId);
@@ -43,15 +184,27 @@ HRESULT SimpleStepper::SetupStep(ICorDebugThread *pThread, IDebugger::StepType s
         return S_OK;
     }
 
-    BOOL bStepIn = stepType == IDebugger::STEP_IN;
+    BOOL bStepIn = stepType == IDebugger::STEP_IN || stepType == IDebugger::STEP_IN_INSTRUCTION;
 
     COR_DEBUG_STEP_RANGE range;
-    if (SUCCEEDED(m_sharedModules->GetStepRangeFromCurrentIP(pThread, &range)))
+    if (stepType == IDebugger::STEP_IN_INSTRUCTION || stepType == IDebugger::STEP_OVER_INSTRUCTION)
+    {
+        // Note, instruction range is native code offsets range.
+        if (SUCCEEDED(m_sharedModules->GetInstructionStepRangeFromCurrentIP(pThread, &range)))
+        {
+            IfFailRet(pStepper->SetRangeIL(FALSE));
+            IfFailRet(pStepper->StepRange(bStepIn, &range, 1));
+        }
+        else
+            IfFailRet(pStepper->Step(bStepIn));
+    }
+    else if (SUCCEEDED(m_sharedModules->GetStepRangeFromCurrentIP(pThread, &range)))
     {
         IfFailRet(pStepper->StepRange(bStepIn, &range, 1));
     } else {
         IfFailRet(pStepper->Step(bStepIn));
     }
+    StepStats::MarkStepStart();
 
     std::lock_guard<std::mutex> lock(m_stepMutex);
     m_enabledSimpleStepId = int(threadId);
@@ -132,6 +285,7 @@ HRESULT SimpleStepper::DisableAllSteppers(ICorDebugProcess *pProcess)
 
     m_stepMutex.lock();
     m_enabledSimpleStepId = 0;
+    DeleteStepOutBreakpoint();
     m_stepMutex.unlock();
 
     return S_OK;
@@ -22,7 +22,9 @@ public:
     SimpleStepper(std::shared_ptr<Modules> &sharedModules) :
         m_sharedModules(sharedModules),
         m_justMyCode(true),
-        m_enabledSimpleStepId(0)
+        m_enabledSimpleStepId(0),
+        m_stepOutThreadId(0),
+        m_stepOutFrameStart(0)
     {}
 
     HRESULT SetupStep(ICorDebugThread *pThread, IDebugger::StepType stepType);
@@ -36,6 +38,9 @@ public:
     //     return S_OK;
     HRESULT ManagedCallbackBreakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread);
     HRESULT ManagedCallbackStepComplete();
+    // Return S_FALSE in case pBreakpoint is not step-out breakpoint, S_OK otherwise, `reached` is true in case step-out
+    // breakpoint was hit by stepping thread in target frame (step-out breakpoint is removed in this case).
+    HRESULT CheckStepOutBreakpoint(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, bool &reached);
 
     HRESULT DisableAllSteppers(ICorDebugProcess *pProcess);
 
@@ -48,6 +53,13 @@ private:
 
     std::mutex m_stepMutex;
     int m_enabledSimpleStepId;
+    // Step-out breakpoint at return address of first user code caller frame, see SetupStepOutBreakpoint().
+    ToRelease<ICorDebugFunctionBreakpoint> m_iCorStepOutBreakpoint;
+    int m_stepOutThreadId;
+    CORDB_ADDRESS m_stepOutFrameStart;
+
+    HRESULT SetupStepOutBreakpoint(ICorDebugThread *pThread);
+    void DeleteStepOutBreakpoint();
 };
 
 } // namespace netcoredbg
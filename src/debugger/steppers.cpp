@@ -6,7 +6,9 @@
 #include "debugger/stepper_simple.h"
 #include "debugger/stepper_async.h"
 #include "debugger/steppers.h"
+#include "debugger/stepstats.h"
 #include "metadata/attributes.h"
+#include "metadata/modules.h"
 #include "utils/utf.h"
 
 namespace netcoredbg
@@ -66,13 +68,20 @@ static const std::unordered_set<WSTRING> g_operatorMethodNames
 
 HRESULT Steppers::SetupStep(ICorDebugThread *pThread, IDebugger::StepType stepType)
 {
+    StepStats::ScopedTimer timer(StepStats::Phase::SetupStep);
     HRESULT Status;
     m_filteredPrevStep = false;
+    m_instructionStep = stepType == IDebugger::StepType::STEP_IN_INSTRUCTION ||
+                        stepType == IDebugger::StepType::STEP_OVER_INSTRUCTION;
 
     ToRelease<ICorDebugProcess> pProcess;
     IfFailRet(pThread->GetProcess(&pProcess));
     DisableAllSteppers(pProcess);
 
+    // Note, instruction step is native code related, async methods stepping logic is not applied.
+    if (m_instructionStep)
+        return m_simpleStepper->SetupStep(pThread, stepType);
+
     IfFailRet(m_asyncStepper->SetupStep(pThread, stepType));
     if (Status == S_OK) // S_FALSE = setup simple stepper
         return S_OK;
@@ -80,22 +89,45 @@ HRESULT Steppers::SetupStep(ICorDebugThread *pThread, IDebugger::StepType stepTy
     return m_simpleStepper->SetupStep(pThread, stepType);
 }
 
-HRESULT Steppers::ManagedCallbackBreakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread)
+HRESULT Steppers::ManagedCallbackBreakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, bool &stepComplete)
 {
     HRESULT Status;
+    stepComplete = false;
     // Check async stepping related breakpoints first, since user can't setup breakpoints to await block yield or resume offsets manually,
     // so, async stepping related breakpoints not a part of any user breakpoints related data (that will be checked in separate thread. see code below).
     IfFailRet(m_asyncStepper->ManagedCallbackBreakpoint(pThread));
     if (Status == S_OK) // S_FALSE - no error, but steppers not affect on callback
         return S_OK;
 
+    bool reached = false;
+    IfFailRet(m_simpleStepper->CheckStepOutBreakpoint(pThread, pBreakpoint, reached));
+    if (Status == S_OK) // S_FALSE - not step-out breakpoint
+    {
+        // Note, in case step-out breakpoint hit by other thread or frame, continue step-out.
+        // Return into the middle of line must be finished by step (same as for runtime's step-out), all logic
+        // related to user code check and step filtering is same as for step complete with STEP_RETURN reason.
+        if (reached && ManagedCallbackStepComplete(pThread, CorDebugStepReason::STEP_RETURN) != S_OK)
+            stepComplete = true;
+        return S_OK;
+    }
+
     return m_simpleStepper->ManagedCallbackBreakpoint(pAppDomain, pThread);
 }
 
 HRESULT Steppers::ManagedCallbackStepComplete(ICorDebugThread *pThread, CorDebugStepReason reason)
 {
+    StepStats::ScopedTimer timer(StepStats::Phase::StepFiltering);
     HRESULT Status;
 
+    // Instruction step must stop at any instruction (in the middle of line, hidden sequence points, filtered methods).
+    if (m_instructionStep)
+    {
+        m_instructionStep = false;
+        m_simpleStepper->ManagedCallbackStepComplete();
+        m_asyncStepper->ManagedCallbackStepComplete();
+        return S_FALSE;
+    }
+
     ToRelease<ICorDebugFrame> iCorFrame;
     IfFailRet(pThread->GetActiveFrame(&iCorFrame));
     if (iCorFrame == nullptr)
@@ -148,10 +180,14 @@ HRESULT Steppers::ManagedCallbackStepComplete(ICorDebugThread *pThread, CorDebug
 
         return false;
     };
+    auto isFilteredMethod = [&]() -> bool
+    {
+        return m_sharedModules->GetUserCodeProperty(iCorFunction, UserCodeCache::Property::Filtered, methodShouldBeFltered);
+    };
 
     // https://docs.microsoft.com/en-us/visualstudio/debugger/navigating-through-code-with-the-debugger?view=vs-2019#BKMK_Step_into_properties_and_operators_in_managed_code
     // The debugger steps over properties and operators in managed code by default. In most cases, this provides a better debugging experience.
-    if (m_stepFiltering && methodShouldBeFltered())
+    if (m_stepFiltering && isFilteredMethod())
     {
         IfFailRet(m_simpleStepper->SetupStep(pThread, IDebugger::StepType::STEP_OUT));
         m_filteredPrevStep = true;
@@ -195,11 +231,16 @@ HRESULT Steppers::ManagedCallbackStepComplete(ICorDebugThread *pThread, CorDebug
     {
         static std::vector<std::string> attrNames{DebuggerAttribute::Hidden, DebuggerAttribute::StepThrough};
 
-        if (HasAttribute(iMD, typeDef, DebuggerAttribute::StepThrough) || HasAttribute(iMD, methodDef, attrNames))
+        auto isStepThroughMethod = [&]() -> bool
+        {
+            return HasAttribute(iMD, typeDef, DebuggerAttribute::StepThrough) || HasAttribute(iMD, methodDef, attrNames);
+        };
+
+        if (m_sharedModules->GetUserCodeProperty(iCorFunction, UserCodeCache::Property::StepThrough, isStepThroughMethod))
         {
             IfFailRet(m_simpleStepper->SetupStep(pThread, IDebugger::StepType::STEP_IN));
             // In case step-in will return from filtered method and no user code was called, step-in again.
-            if (!m_stepFiltering && methodShouldBeFltered())
+            if (!m_stepFiltering && isFilteredMethod())
                  m_filteredPrevStep = true;
 
             return S_OK;
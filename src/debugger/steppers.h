@@ -27,7 +27,8 @@ public:
         m_sharedModules(sharedModules),
         m_justMyCode(true),
         m_stepFiltering(true),
-        m_filteredPrevStep(false)
+        m_filteredPrevStep(false),
+        m_instructionStep(false)
     {}
 
     HRESULT SetupStep(ICorDebugThread *pThread, IDebugger::StepType stepType);
@@ -39,7 +40,8 @@ public:
     // Good:
     //     IfFailRet(pThread->GetID(&threadId));
     //     return S_OK;
-    HRESULT ManagedCallbackBreakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread);
+    // `stepComplete` is true in case breakpoint finished step (step-out breakpoint reached), caller must emit step stop.
+    HRESULT ManagedCallbackBreakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, bool &stepComplete);
     HRESULT ManagedCallbackStepComplete(ICorDebugThread *pThread, CorDebugStepReason reason);
 
     HRESULT DisableAllSteppers(ICorDebugProcess *pProcess);
@@ -61,6 +63,8 @@ private:
     // Previous step-in was made in method that must not be stepped. We need store this information in order to step-in again as soon, as we leave this method.
     // Usually this is code related to m_stepFiltering, but in some cases we could also filter compiler generated code and code covered by StepThrough attribute.
     bool m_filteredPrevStep;
+    // Current step have instruction granularity, stop at step complete without any filtering.
+    bool m_instructionStep;
 };
 
 } // namespace netcoredbg
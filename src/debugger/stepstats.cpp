@@ -0,0 +1,126 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/stepstats.h"
+
+namespace netcoredbg
+{
+
+const size_t TimingHistogram::BucketsCount;
+
+size_t TimingHistogram::GetBucketIndex(uint64_t us)
+{
+    size_t index = 0;
+    while (us != 0 && index < BucketsCount - 1)
+    {
+        us >>= 1;
+        index++;
+    }
+    return index;
+}
+
+uint64_t TimingHistogram::GetBucketLimit(size_t index)
+{
+    return index < BucketsCount - 1 ? uint64_t(1) << index : 0;
+}
+
+void TimingHistogram::Add(uint64_t us)
+{
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_totalUs.fetch_add(us, std::memory_order_relaxed);
+    m_buckets[GetBucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t maxUs = m_maxUs.load(std::memory_order_relaxed);
+    while (maxUs < us && !m_maxUs.compare_exchange_weak(maxUs, us, std::memory_order_relaxed))
+    {
+    }
+}
+
+void TimingHistogram::GetSnapshot(snapshot_t &snapshot) const
+{
+    snapshot.count = m_count.load(std::memory_order_relaxed);
+    snapshot.totalUs = m_totalUs.load(std::memory_order_relaxed);
+    snapshot.maxUs = m_maxUs.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < BucketsCount; i++)
+    {
+        snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    }
+}
+
+void TimingHistogram::Reset()
+{
+    m_count.store(0, std::memory_order_relaxed);
+    m_totalUs.store(0, std::memory_order_relaxed);
+    m_maxUs.store(0, std::memory_order_relaxed);
+    for (auto &bucket : m_buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+namespace StepStats
+{
+
+namespace // unnamed namespace
+{
+
+const char *phaseNames[(size_t)Phase::Count] = {
+    "setupStep",
+    "stepComplete",
+    "callbacksQueue",
+    "stepFiltering",
+    "stackTrace",
+    "stoppedEvent"
+};
+
+TimingHistogram histograms[(size_t)Phase::Count];
+
+// Time point of the last step setup end (steady clock ticks), zero in case no step in progress.
+std::atomic<std::chrono::steady_clock::rep> stepStartTicks(0);
+
+} // unnamed namespace
+
+const char *GetPhaseName(Phase phase)
+{
+    return phaseNames[(size_t)phase];
+}
+
+void Add(Phase phase, std::chrono::steady_clock::duration duration)
+{
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    histograms[(size_t)phase].Add(us > 0 ? uint64_t(us) : 0);
+}
+
+void GetSnapshot(Phase phase, TimingHistogram::snapshot_t &snapshot)
+{
+    histograms[(size_t)phase].GetSnapshot(snapshot);
+}
+
+void Reset()
+{
+    for (auto &histogram : histograms)
+    {
+        histogram.Reset();
+    }
+    stepStartTicks.store(0, std::memory_order_relaxed);
+}
+
+void MarkStepStart()
+{
+    stepStartTicks.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+void MarkStepComplete()
+{
+    std::chrono::steady_clock::rep startTicks = stepStartTicks.exchange(0, std::memory_order_relaxed);
+    if (startTicks == 0)
+        return;
+
+    std::chrono::steady_clock::time_point start{std::chrono::steady_clock::duration(startTicks)};
+    Add(Phase::StepComplete, std::chrono::steady_clock::now() - start);
+}
+
+} // namespace StepStats
+
+} // namespace netcoredbg
@@ -0,0 +1,105 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace netcoredbg
+{
+
+// Lock-free histogram of durations with power of two microseconds buckets.
+// Note, all counters use relaxed atomics, so snapshot could be slightly inconsistent (count vs buckets)
+// in case of concurrent Add() calls, this is fine for statistic purposes.
+class TimingHistogram
+{
+public:
+
+    // Bucket 0 count durations less than 1us, bucket N count durations in [2^(N-1), 2^N) us range,
+    // last bucket also count all durations out of range.
+    static const size_t BucketsCount = 24;
+
+    struct snapshot_t
+    {
+        uint64_t count;
+        uint64_t totalUs;
+        uint64_t maxUs;
+        uint64_t buckets[BucketsCount];
+    };
+
+    TimingHistogram()
+    {
+        Reset();
+    }
+
+    void Add(uint64_t us);
+    void GetSnapshot(snapshot_t &snapshot) const;
+    void Reset();
+
+    static size_t GetBucketIndex(uint64_t us);
+    // Return upper bound (exclusive) of bucket in microseconds, zero for last bucket.
+    static uint64_t GetBucketLimit(size_t index);
+
+private:
+
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_totalUs;
+    std::atomic<uint64_t> m_maxUs;
+    std::atomic<uint64_t> m_buckets[BucketsCount];
+};
+
+// Process-wide stepping latency statistic, split by step processing phases.
+namespace StepStats
+{
+    enum class Phase : size_t
+    {
+        SetupStep,          // steppers setup for step request
+        StepComplete,       // runtime StepComplete callback delivery, measured from the end of step setup
+        CallbacksQueue,     // step complete event wait in callbacks queue
+        StepFiltering,      // steppers check (JMC, step filtering, async) at StepComplete
+        StackTrace,         // stack trace request processing
+        StoppedEvent,       // stopped event emit
+        Count // must be last
+    };
+
+    const char *GetPhaseName(Phase phase);
+
+    void Add(Phase phase, std::chrono::steady_clock::duration duration);
+    void GetSnapshot(Phase phase, TimingHistogram::snapshot_t &snapshot);
+    void Reset();
+
+    // Must be called at step setup end.
+    void MarkStepStart();
+    // Must be called at StepComplete callback, add StepComplete phase duration in case step start was marked.
+    void MarkStepComplete();
+
+    class ScopedTimer
+    {
+    public:
+
+        ScopedTimer(Phase phase) :
+            m_phase(phase),
+            m_start(std::chrono::steady_clock::now())
+        {}
+
+        ~ScopedTimer()
+        {
+            Add(m_phase, std::chrono::steady_clock::now() - m_start);
+        }
+
+    private:
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        Phase m_phase;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+} // namespace StepStats
+
+} // namespace netcoredbg
@@ -0,0 +1,106 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/task_groups.h"
+
+#include <algorithm>
+
+namespace netcoredbg
+{
+
+const int32_t TaskGroups::NoState;
+const size_t TaskGroups::MaxGroupTasks;
+
+namespace
+{
+
+    // Task.m_stateFlags bits (see System.Threading.Tasks.Task TASK_STATE_* constants).
+    const int32_t TaskStateStarted = 0x10000;
+    const int32_t TaskStateDelegateInvoked = 0x20000;
+    const int32_t TaskStateFaulted = 0x200000;
+    const int32_t TaskStateCanceled = 0x400000;
+    const int32_t TaskStateWaitingOnChildren = 0x800000;
+    const int32_t TaskStateRanToCompletion = 0x1000000;
+    const int32_t TaskStateWaitingForActivation = 0x2000000;
+
+} // unnamed namespace
+
+TaskGroups::Status TaskGroups::GetStatus(int32_t stateFlags)
+{
+    if (stateFlags & TaskStateFaulted)
+        return Status::Faulted;
+    if (stateFlags & TaskStateCanceled)
+        return Status::Canceled;
+    if (stateFlags & TaskStateRanToCompletion)
+        return Status::RanToCompletion;
+    if (stateFlags & TaskStateWaitingOnChildren)
+        return Status::WaitingForChildrenToComplete;
+    if (stateFlags & TaskStateDelegateInvoked)
+        return Status::Running;
+    if (stateFlags & TaskStateStarted)
+        return Status::WaitingToRun;
+    if (stateFlags & TaskStateWaitingForActivation)
+        return Status::WaitingForActivation;
+    return Status::Created;
+}
+
+const char *TaskGroups::GetStatusName(Status status)
+{
+    switch (status)
+    {
+        case Status::Created: return "Created";
+        case Status::WaitingForActivation: return "WaitingForActivation";
+        case Status::WaitingToRun: return "WaitingToRun";
+        case Status::Running: return "Running";
+        case Status::WaitingForChildrenToComplete: return "WaitingForChildrenToComplete";
+        case Status::RanToCompletion: return "RanToCompletion";
+        case Status::Canceled: return "Canceled";
+        case Status::Faulted: return "Faulted";
+    }
+    return "Unknown";
+}
+
+bool TaskGroups::IsCompleted(Status status)
+{
+    return status == Status::RanToCompletion || status == Status::Canceled || status == Status::Faulted;
+}
+
+void TaskGroups::Add(const key_t &key, uint64_t address)
+{
+    auto it = m_groups.find(key);
+    if (it == m_groups.end())
+        it = m_groups.emplace(key, group_t(key)).first;
+
+    group_t &group = it->second;
+    group.count++;
+    if (group.tasks.size() < MaxGroupTasks)
+        group.tasks.push_back(address);
+    m_tasksCount++;
+}
+
+void TaskGroups::GetGroups(std::vector<group_t> &groups) const
+{
+    groups.clear();
+    groups.reserve(m_groups.size());
+    for (const auto &entry : m_groups)
+    {
+        groups.push_back(entry.second);
+    }
+
+    // Note, groups order in unordered_map is not defined, compare keys for stable result.
+    std::sort(groups.begin(), groups.end(), [](const group_t &a, const group_t &b)
+    {
+        if (a.count != b.count)
+            return a.count > b.count;
+        if (a.key.status != b.key.status)
+            return a.key.status < b.key.status;
+        if (a.key.token1 != b.key.token1)
+            return a.key.token1 < b.key.token1;
+        if (a.key.token2 != b.key.token2)
+            return a.key.token2 < b.key.token2;
+        return a.key.state < b.key.state;
+    });
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,94 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace netcoredbg
+{
+
+// Live tasks aggregation for parallel tasks view. Tasks are grouped by status and by task type identity (COR_TYPEID
+// tokens, state machine box type is unique for each async method) plus state machine state (await point), so, memory
+// is bounded by number of groups, not number of tasks. Only first tasks addresses of each group are stored.
+class TaskGroups
+{
+public:
+
+    // Same as System.Threading.Tasks.TaskStatus.
+    enum class Status : int
+    {
+        Created,
+        WaitingForActivation,
+        WaitingToRun,
+        Running,
+        WaitingForChildrenToComplete,
+        RanToCompletion,
+        Canceled,
+        Faulted
+    };
+
+    // State of tasks without state machine.
+    static const int32_t NoState = INT32_MIN;
+    // Tasks addresses, stored for each group.
+    static const size_t MaxGroupTasks = 8;
+
+    struct key_t
+    {
+        Status status;
+        uint64_t token1;
+        uint64_t token2;
+        int32_t state;
+
+        key_t(Status status_, uint64_t token1_, uint64_t token2_, int32_t state_) :
+            status(status_), token1(token1_), token2(token2_), state(state_)
+        {}
+
+        bool operator==(const key_t &other) const
+        {
+            return status == other.status && token1 == other.token1 && token2 == other.token2 && state == other.state;
+        }
+    };
+
+    struct group_t
+    {
+        key_t key;
+        uint64_t count;
+        std::vector<uint64_t> tasks; // first MaxGroupTasks tasks addresses
+
+        group_t(const key_t &key_) : key(key_), count(0) {}
+    };
+
+    TaskGroups() : m_tasksCount(0) {}
+
+    // Task status by `Task.m_stateFlags` value, same logic as Task.Status property getter.
+    static Status GetStatus(int32_t stateFlags);
+    static const char *GetStatusName(Status status);
+    static bool IsCompleted(Status status);
+
+    void Add(const key_t &key, uint64_t address);
+
+    uint64_t GetTasksCount() const { return m_tasksCount; }
+    // Groups sorted by tasks count (descending), order of groups with same count is stable.
+    void GetGroups(std::vector<group_t> &groups) const;
+
+private:
+
+    struct key_hash_t
+    {
+        size_t operator()(const key_t &key) const
+        {
+            return std::hash<uint64_t>()(key.token1 ^ (key.token2 * 0x9e3779b97f4a7c15ULL) ^
+                                         (uint64_t(uint32_t(key.state)) << 8) ^ uint64_t(key.status));
+        }
+    };
+
+    std::unordered_map<key_t, group_t, key_hash_t> m_groups;
+    uint64_t m_tasksCount;
+};
+
+} // namespace netcoredbg
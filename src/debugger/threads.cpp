@@ -39,13 +39,32 @@ void Threads::Remove(const ThreadId &threadId)
         return;
 
     m_userThreads.erase(it);
+
+    InvalidateThreadName(threadId);
+}
+
+void Threads::InvalidateThreadName(const ThreadId &threadId)
+{
+    std::lock_guard<std::mutex> lock(m_threadNamesMutex);
+    m_threadNames.erase(threadId);
+}
+
+bool Threads::GetCachedThreadName(const ThreadId &userThread, std::string &threadName)
+{
+    std::lock_guard<std::mutex> lock(m_threadNamesMutex);
+    auto find = m_threadNames.find(userThread);
+    if (find == m_threadNames.end())
+        return false;
+
+    threadName = find->second;
+    return true;
 }
 
 std::string Threads::GetThreadName(ICorDebugProcess *pProcess, const ThreadId &userThread)
 {
     std::string threadName = "<No name>";
 
-    if (m_sharedEvaluator)
+    if (m_sharedEvaluator && !GetCachedThreadName(userThread, threadName))
     {
         ToRelease<ICorDebugThread> pThread;
         ToRelease<ICorDebugValue> iCorThreadObject;
@@ -76,6 +95,10 @@ std::string Threads::GetThreadName(ICorDebugProcess *pProcess, const ThreadId &u
 
                 return E_ABORT; // Fast exit from cycle.
             });
+
+            // Note, cache "<No name>" too, since name set for thread object will be reported by NameChange callback.
+            std::lock_guard<std::mutex> lock(m_threadNamesMutex);
+            m_threadNames[userThread] = threadName;
         }
     }
 
@@ -106,36 +129,26 @@ HRESULT Threads::GetThreadsWithState(ICorDebugProcess *pProcess, std::vector<Thr
 
 #ifdef INTEROP_DEBUGGING
 // Caller should guarantee, that pProcess is not null.
-HRESULT Threads::GetInteropThreadsWithState(ICorDebugProcess *pProcess, InteropDebugging::InteropDebugger *pInteropDebugger, std::vector<Thread> &threads)
+HRESULT Threads::GetInteropThreadsWithState(ICorDebugProcess *pProcess, InteropDebugging::InteropDebugger *pInteropDebugger,
+                                            std::vector<Thread> &threads, bool refreshNames)
 {
+    // Note, managed threads set is maintained by CreateThread/ExitThread callbacks and native threads table by
+    // clone/exit ptrace events, so, we don't enumerate ICorDebug threads and read native names on each request.
+    std::unique_lock<Utility::RWLock::Reader> read_lock(m_userThreadsRWLock.reader);
+
     HRESULT Status;
     BOOL managedProcRunning = FALSE;
     IfFailRet(pProcess->IsRunning(&managedProcRunning));
 
-    std::unordered_set<DWORD> managedThreads;
-    ToRelease<ICorDebugThreadEnum> iCorThreadEnum;
-    pProcess->EnumerateThreads(&iCorThreadEnum);
-    ULONG fetched = 0;
-    ToRelease<ICorDebugThread> iCorThread;
-    while (SUCCEEDED(iCorThreadEnum->Next(1, &iCorThread, &fetched)) && fetched == 1)
-    {
-        DWORD tid = 0;
-        if (SUCCEEDED(iCorThread->GetID(&tid)))
-        {
-            managedThreads.emplace(tid);
-        }
-        iCorThread.Free();
-    }
-
-    pInteropDebugger->WalkAllThreads([&](pid_t tid, bool isRunning)
+    pInteropDebugger->WalkAllThreads([&](pid_t tid, bool isRunning, const std::string &nativeName)
     {
         ThreadId threadId(tid);
 
-        if (managedThreads.find((DWORD)tid) != managedThreads.end())
+        if (m_userThreads.find(threadId) != m_userThreads.end())
             threads.emplace_back(threadId, GetThreadName(pProcess, threadId), managedProcRunning == TRUE, true);
         else
-            threads.emplace_back(threadId, "<No name>", isRunning, false);
-    });
+            threads.emplace_back(threadId, nativeName.empty() ? "<No name>" : nativeName, isRunning, false);
+    }, refreshNames);
 
     return S_OK;
 }
@@ -161,6 +174,9 @@ void Threads::SetEvaluator(std::shared_ptr<Evaluator> &sharedEvaluator)
 void Threads::ResetEvaluator()
 {
     m_sharedEvaluator.reset();
+
+    std::lock_guard<std::mutex> lock(m_threadNamesMutex);
+    m_threadNames.clear();
 }
 
 } // namespace netcoredbg
@@ -7,6 +7,8 @@
 #include "cordebug.h"
 
 #include <set>
+#include <map>
+#include <mutex>
 #include <vector>
 #include "interfaces/types.h"
 #include "utils/rwlock.h"
@@ -29,14 +31,22 @@ class Threads
     std::set<ThreadId> m_userThreads;
     ThreadId MainThread;
     std::shared_ptr<Evaluator> m_sharedEvaluator;
+    // Names, that was read from managed thread objects. Invalidated by NameChange callback and thread exit.
+    // Note, m_threadNamesMutex used, since names requested with m_userThreadsRWLock reader lock (could be shared).
+    std::mutex m_threadNamesMutex;
+    std::map<ThreadId, std::string> m_threadNames;
+
+    bool GetCachedThreadName(const ThreadId &userThread, std::string &threadName);
 
 public:
 
     void Add(const ThreadId &threadId, bool processAttached);
     void Remove(const ThreadId &threadId);
+    void InvalidateThreadName(const ThreadId &threadId);
     HRESULT GetThreadsWithState(ICorDebugProcess *pProcess, std::vector<Thread> &threads);
 #ifdef INTEROP_DEBUGGING
-    HRESULT GetInteropThreadsWithState(ICorDebugProcess *pProcess, InteropDebugging::InteropDebugger *pInteropDebugger, std::vector<Thread> &threads);
+    HRESULT GetInteropThreadsWithState(ICorDebugProcess *pProcess, InteropDebugging::InteropDebugger *pInteropDebugger,
+                                       std::vector<Thread> &threads, bool refreshNames);
 #endif // INTEROP_DEBUGGING
     HRESULT GetThreadIds(std::vector<ThreadId> &threads);
     std::string GetThreadName(ICorDebugProcess *pProcess, const ThreadId &userThread);
@@ -0,0 +1,67 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/trace_buffer.h"
+
+namespace netcoredbg
+{
+
+const unsigned TraceBuffer::MaxArgs;
+const size_t TraceBuffer::DefaultCapacity;
+
+TraceBuffer::TraceBuffer(size_t capacity) :
+    m_records(capacity == 0 ? 1 : capacity),
+    m_first(0),
+    m_size(0),
+    m_overwritten(0)
+{}
+
+void TraceBuffer::Push(const record_t &record)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_size == m_records.size())
+    {
+        m_records[m_first] = record;
+        m_first = (m_first + 1) % m_records.size();
+        m_overwritten++;
+        return;
+    }
+
+    m_records[(m_first + m_size) % m_records.size()] = record;
+    m_size++;
+}
+
+void TraceBuffer::GetRecords(std::vector<record_t> &records, bool drain)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    records.reserve(records.size() + m_size);
+    for (size_t i = 0; i < m_size; i++)
+    {
+        records.push_back(m_records[(m_first + i) % m_records.size()]);
+    }
+
+    if (drain)
+    {
+        m_first = 0;
+        m_size = 0;
+    }
+}
+
+uint64_t TraceBuffer::GetOverwrittenCount()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_overwritten;
+}
+
+void TraceBuffer::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_first = 0;
+    m_size = 0;
+    m_overwritten = 0;
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,62 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace netcoredbg
+{
+
+// Preallocated ring buffer for trace breakpoints hits. Records are added from managed callback thread, oldest records
+// are overwritten in case buffer is full. Methods are stored as identity only (module address and token), names are
+// resolved by caller on demand.
+class TraceBuffer
+{
+public:
+
+    // Leading arguments limit (include `this` for instance methods).
+    static const unsigned MaxArgs = 4;
+
+    struct arg_t
+    {
+        uint32_t type;  // CorElementType
+        uint64_t value; // primitive value bits or object address, 0 in case value was not read
+    };
+
+    struct record_t
+    {
+        uint64_t timestamp; // in microseconds
+        uint32_t threadId;
+        uint32_t breakpointId;
+        uint64_t module;    // method module base address
+        uint32_t methodToken;
+        uint32_t ilOffset;
+        uint32_t argsCount;
+        arg_t args[MaxArgs];
+    };
+
+    static const size_t DefaultCapacity = 65536;
+
+    explicit TraceBuffer(size_t capacity = DefaultCapacity);
+
+    void Push(const record_t &record);
+    // Records from oldest to newest. In case `drain` is true, returned records are removed from buffer (streaming).
+    void GetRecords(std::vector<record_t> &records, bool drain);
+    // Records lost since last clear, since buffer was full.
+    uint64_t GetOverwrittenCount();
+    void Clear();
+
+private:
+
+    std::mutex m_mutex;
+    std::vector<record_t> m_records;
+    size_t m_first;
+    size_t m_size;
+    uint64_t m_overwritten;
+};
+
+} // namespace netcoredbg
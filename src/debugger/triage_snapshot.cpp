@@ -0,0 +1,90 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/triage_snapshot.h"
+
+#include "utils/jsonstring.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+
+    void AppendField(std::string &output, const char *name, const std::string &value)
+    {
+        if (value.empty())
+            return;
+
+        output += ",\"";
+        output += name;
+        output += "\":";
+        AppendJsonString(output, value);
+    }
+
+    void AppendFrame(std::string &output, const TriageSnapshot::Frame &frame)
+    {
+        output += "{\"method\":";
+        AppendJsonString(output, frame.methodName);
+        AppendField(output, "module", frame.module);
+        AppendField(output, "source", frame.source);
+        if (frame.line != 0)
+        {
+            output += ",\"line\":";
+            output += std::to_string(frame.line);
+        }
+
+        if (!frame.locals.empty())
+        {
+            output += ",\"locals\":[";
+            for (size_t i = 0; i < frame.locals.size(); i++)
+            {
+                output += i == 0 ? "{\"name\":" : ",{\"name\":";
+                AppendJsonString(output, frame.locals[i].name);
+                AppendField(output, "type", frame.locals[i].type);
+                AppendField(output, "value", frame.locals[i].value);
+                output += '}';
+            }
+            output += ']';
+        }
+        output += '}';
+    }
+
+} // unnamed namespace
+
+void ExportTriageSnapshotJson(const TriageSnapshot &snapshot, std::string &output)
+{
+    output += "{\"pid\":";
+    output += std::to_string(snapshot.processId);
+    output += ",\"frozenMs\":";
+    output += std::to_string(snapshot.frozenMs);
+    output += ",\"threads\":[";
+    for (size_t i = 0; i < snapshot.threads.size(); i++)
+    {
+        const TriageSnapshot::Thread &thread = snapshot.threads[i];
+        output += i == 0 ? "{\"id\":" : ",{\"id\":";
+        output += std::to_string(thread.id);
+        if (!thread.exceptionType.empty())
+        {
+            output += ",\"exception\":{\"type\":";
+            AppendJsonString(output, thread.exceptionType);
+            AppendField(output, "message", thread.exceptionMessage);
+            output += '}';
+        }
+        output += ",\"frames\":[";
+        for (size_t j = 0; j < thread.frames.size(); j++)
+        {
+            if (j != 0)
+                output += ',';
+            AppendFrame(output, thread.frames[j]);
+        }
+        output += ']';
+        if (thread.truncated)
+            output += ",\"truncated\":true";
+        output += '}';
+    }
+    output += "]}";
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,53 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+/// \file triage_snapshot.h  This file contains declaration of process state snapshot, collected in one pass before
+/// detach for production triage (threads stacks, top frames locals and current exceptions).
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace netcoredbg
+{
+
+// Note, all values are collected by raw memory reads only (no func-eval), so, snapshot don't change debuggee state.
+struct TriageSnapshot
+{
+    struct Local
+    {
+        std::string name;
+        std::string type;
+        std::string value; // empty in case value can't be read
+    };
+
+    struct Frame
+    {
+        std::string methodName;
+        std::string module;
+        std::string source; // empty in case no symbols
+        int line = 0;
+        std::vector<Local> locals; // top frames only
+    };
+
+    struct Thread
+    {
+        uint32_t id = 0;
+        std::string exceptionType; // empty in case thread have no current exception
+        std::string exceptionMessage;
+        std::vector<Frame> frames; // managed frames only, from leaf to root
+        bool truncated = false; // stack have more managed frames than collected
+    };
+
+    uint32_t processId = 0;
+    uint64_t frozenMs = 0; // time process was stopped by snapshot
+    std::vector<Thread> threads;
+};
+
+// Compact (no whitespaces) JSON representation of snapshot, empty fields are omitted.
+void ExportTriageSnapshotJson(const TriageSnapshot &snapshot, std::string &output);
+
+} // namespace netcoredbg
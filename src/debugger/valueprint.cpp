@@ -5,15 +5,21 @@
 #include "valueprint.h"
 
 #include <string.h>
+#include <algorithm>
+#include <mutex>
 #include <sstream>
 #include <vector>
 #include <map>
+#include <memory>
 #include <iomanip>
 #include <type_traits>
 
 #include <arrayholder.h>
 
+#include "debugger/evalintrinsics.h"
+#include "debugger/numberformat.h"
 #include "metadata/typeprinter.h"
+#include "metadata/wellknown_types.h"
 #include "utils/torelease.h"
 #include "utils/utf.h"
 #include "managed/interop.h"
@@ -68,7 +74,6 @@ static bool IsEnum(ICorDebugValue *pInputValue)
     ToRelease<ICorDebugValue> pValue;
     if (FAILED(DereferenceAndUnboxValue(pInputValue, &pValue, nullptr))) return false;
 
-    std::string baseTypeName;
     ToRelease<ICorDebugValue2> pValue2;
     ToRelease<ICorDebugType> pType;
     ToRelease<ICorDebugType> pBaseType;
@@ -76,41 +81,62 @@ static bool IsEnum(ICorDebugValue *pInputValue)
     if (FAILED(pValue->QueryInterface(IID_ICorDebugValue2, (LPVOID *) &pValue2))) return false;
     if (FAILED(pValue2->GetExactType(&pType))) return false;
     if (FAILED(pType->GetBase(&pBaseType)) || pBaseType == nullptr) return false;
-    if (FAILED(TypePrinter::GetTypeOfValue(pBaseType, baseTypeName))) return false;
 
-    return baseTypeName == "System.Enum";
+    return WellKnownTypes::IsType(pBaseType, WellKnownTypes::Type::Enum);
 }
 
-static HRESULT PrintEnumValue(ICorDebugValue* pInputValue, BYTE* enumValue, std::string &output)
+// Enum type constants, read from metadata once per type, since enum fields enumeration is much slower than
+// search in table (especially for [Flags] enums with many members).
+struct EnumTypeInfo
 {
-    HRESULT Status = S_OK;
-
-    ToRelease<ICorDebugValue> pValue;
-    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, nullptr));
-
-    mdTypeDef currentTypeDef;
-    ToRelease<ICorDebugClass> pClass;
-    ToRelease<ICorDebugValue2> pValue2;
-    ToRelease<ICorDebugType> pType;
-    ToRelease<ICorDebugModule> pModule;
-    IfFailRet(pValue->QueryInterface(IID_ICorDebugValue2, (LPVOID *) &pValue2));
-    IfFailRet(pValue2->GetExactType(&pType));
-    IfFailRet(pType->GetClass(&pClass));
-    IfFailRet(pClass->GetModule(&pModule));
-    IfFailRet(pClass->GetToken(&currentTypeDef));
-
-    ToRelease<IUnknown> pMDUnknown;
-    ToRelease<IMetaDataImport> pMD;
-    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
-    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
-
+    CorElementType underlyingType = ELEMENT_TYPE_END;
+    bool flags = false;
+    std::vector<std::pair<ULONG64, std::string>> constants; // in metadata order
+};
+// Note, cache is limited, since enum types of unloaded modules are released at process exit or detach only.
+static const size_t MaxEnumTypes = 1024;
+static std::mutex g_enumTypesMutex;
+static std::map<std::pair<CORDB_ADDRESS, mdTypeDef>, std::shared_ptr<const EnumTypeInfo>> g_enumTypes;
+
+static ULONG64 GetEnumConstantValue(CorElementType enumUnderlyingType, const void *data)
+{
+    switch (enumUnderlyingType)
+    {
+        case ELEMENT_TYPE_CHAR:
+        case ELEMENT_TYPE_I1:
+            return (ULONG64)(*((CHAR*)data));
+        case ELEMENT_TYPE_U1:
+            return (ULONG64)(*((BYTE*)data));
+        case ELEMENT_TYPE_I2:
+            return (ULONG64)(*((SHORT*)data));
+        case ELEMENT_TYPE_U2:
+            return (ULONG64)(*((USHORT*)data));
+        case ELEMENT_TYPE_I4:
+            return (ULONG64)(*((INT32*)data));
+        case ELEMENT_TYPE_U4:
+            return (ULONG64)(*((UINT32*)data));
+        case ELEMENT_TYPE_I8:
+            return (ULONG64)(*((INT64*)data));
+        case ELEMENT_TYPE_U8:
+            return (ULONG64)(*((UINT64*)data));
+        case ELEMENT_TYPE_I:
+            return (ULONG64)(*((int*)data));
+        case ELEMENT_TYPE_U:
+        case ELEMENT_TYPE_R4:
+        case ELEMENT_TYPE_R8:
+        // Technically U and the floating-point ones are options in the CLI, but not in the CLS or C#, so these are NYI
+        default:
+            return (ULONG64)0;
+    }
+}
 
+static HRESULT ReadEnumTypeInfo(IMetaDataImport *pMD, mdTypeDef currentTypeDef, EnumTypeInfo &enumType)
+{
     //First, we need to figure out the underlying enum type so that we can correctly type cast the raw values of each enum constant
     //We get that from the non-static field of the enum variable (I think the field is called "value__" or something similar)
     ULONG numFields = 0;
     HCORENUM fEnum = NULL;
     mdFieldDef fieldDef;
-    CorElementType enumUnderlyingType = ELEMENT_TYPE_END;
     while(SUCCEEDED(pMD->EnumFields(&fEnum, currentTypeDef, &fieldDef, 1, &numFields)) && numFields != 0)
     {
         DWORD             fieldAttr = 0;
@@ -121,54 +147,17 @@ static HRESULT PrintEnumValue(ICorDebugValue* pInputValue, BYTE* enumValue, std:
             if((fieldAttr & fdStatic) == 0)
             {
                 CorSigUncompressCallingConv(pSignatureBlob);
-                enumUnderlyingType = CorSigUncompressElementType(pSignatureBlob);
+                enumType.underlyingType = CorSigUncompressElementType(pSignatureBlob);
                 break;
             }
         }
     }
     pMD->CloseEnum(fEnum);
 
-    auto getValue = [&enumUnderlyingType](const void *data)
-    {
-        switch (enumUnderlyingType)
-        {
-            case ELEMENT_TYPE_CHAR:
-            case ELEMENT_TYPE_I1:
-                return (ULONG64)(*((CHAR*)data));
-            case ELEMENT_TYPE_U1:
-                return (ULONG64)(*((BYTE*)data));
-            case ELEMENT_TYPE_I2:
-                return (ULONG64)(*((SHORT*)data));
-            case ELEMENT_TYPE_U2:
-                return (ULONG64)(*((USHORT*)data));
-            case ELEMENT_TYPE_I4:
-                return (ULONG64)(*((INT32*)data));
-            case ELEMENT_TYPE_U4:
-                return (ULONG64)(*((UINT32*)data));
-            case ELEMENT_TYPE_I8:
-                return (ULONG64)(*((LONG*)data));
-            case ELEMENT_TYPE_U8:
-                return (ULONG64)(*((ULONG*)data));
-            case ELEMENT_TYPE_I:
-                return (ULONG64)(*((int*)data));
-            case ELEMENT_TYPE_U:
-            case ELEMENT_TYPE_R4:
-            case ELEMENT_TYPE_R8:
-            // Technically U and the floating-point ones are options in the CLI, but not in the CLS or C#, so these are NYI
-            default:
-                return (ULONG64)0;
-        }
-    };
-
-    // Enum could have explicitly specified any integral numeric type. enumValue type same as enumUnderlyingType.
-    ULONG64 curValue = getValue(enumValue);
-
     // Care about Flags attribute (https://docs.microsoft.com/en-us/dotnet/api/system.flagsattribute),
     // that "Indicates that an enumeration can be treated as a bit field; that is, a set of flags".
-    bool foundFlagsAttr = HasAttribute(pMD, currentTypeDef, "System.FlagsAttribute..ctor");
+    enumType.flags = HasAttribute(pMD, currentTypeDef, "System.FlagsAttribute..ctor");
 
-    ULONG64 remainingValue = curValue;
-    std::map<ULONG64, std::string> OrderedFlags;
     fEnum = NULL;
     while(SUCCEEDED(pMD->EnumFields(&fEnum, currentTypeDef, &fieldDef, 1, &numFields)) && numFields != 0)
     {
@@ -183,29 +172,94 @@ static HRESULT PrintEnumValue(ICorDebugValue* pInputValue, BYTE* enumValue, std:
             if((fieldAttr & enumValueRequiredAttributes) != enumValueRequiredAttributes)
                 continue;
 
-            ULONG64 currentConstValue = getValue(pRawValue);
-            if (currentConstValue == curValue)
-            {
-                pMD->CloseEnum(fEnum);
-                output = to_utf8(mdName);
+            enumType.constants.emplace_back(GetEnumConstantValue(enumType.underlyingType, pRawValue), to_utf8(mdName));
+        }
+    }
+    pMD->CloseEnum(fEnum);
 
-                return S_OK;
-            }
-            if (foundFlagsAttr)
-            {
-                // Flag enumerated constant whose value is zero must be excluded from OR-ed expression.
-                if (currentConstValue == 0)
-                    continue;
+    return S_OK;
+}
 
-                if ((currentConstValue == remainingValue) || ((currentConstValue != 0) && ((currentConstValue & remainingValue) == currentConstValue)))
-                {
-                    OrderedFlags.emplace(std::make_pair(currentConstValue, to_utf8(mdName)));
-                    remainingValue &= ~currentConstValue;
-                }
+static HRESULT GetEnumTypeInfo(ICorDebugValue *pValue, std::shared_ptr<const EnumTypeInfo> &enumType)
+{
+    HRESULT Status = S_OK;
+
+    mdTypeDef currentTypeDef;
+    ToRelease<ICorDebugClass> pClass;
+    ToRelease<ICorDebugValue2> pValue2;
+    ToRelease<ICorDebugType> pType;
+    ToRelease<ICorDebugModule> pModule;
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugValue2, (LPVOID *) &pValue2));
+    IfFailRet(pValue2->GetExactType(&pType));
+    IfFailRet(pType->GetClass(&pClass));
+    IfFailRet(pClass->GetModule(&pModule));
+    IfFailRet(pClass->GetToken(&currentTypeDef));
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+
+    const std::pair<CORDB_ADDRESS, mdTypeDef> key(modAddress, currentTypeDef);
+    {
+        std::lock_guard<std::mutex> lock(g_enumTypesMutex);
+        auto find = g_enumTypes.find(key);
+        if (find != g_enumTypes.end())
+        {
+            enumType = find->second;
+            return S_OK;
+        }
+    }
+
+    ToRelease<IUnknown> pMDUnknown;
+    ToRelease<IMetaDataImport> pMD;
+    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
+
+    std::shared_ptr<EnumTypeInfo> newEnumType(new EnumTypeInfo());
+    IfFailRet(ReadEnumTypeInfo(pMD, currentTypeDef, *newEnumType));
+    enumType = newEnumType;
+
+    std::lock_guard<std::mutex> lock(g_enumTypesMutex);
+    if (g_enumTypes.size() >= MaxEnumTypes)
+        g_enumTypes.clear();
+    g_enumTypes[key] = enumType;
+    return S_OK;
+}
+
+static HRESULT PrintEnumValue(ICorDebugValue* pInputValue, BYTE* enumValue, std::string &output)
+{
+    HRESULT Status = S_OK;
+
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, nullptr));
+
+    std::shared_ptr<const EnumTypeInfo> enumType;
+    IfFailRet(GetEnumTypeInfo(pValue, enumType));
+
+    // Enum could have explicitly specified any integral numeric type. enumValue type same as enumUnderlyingType.
+    ULONG64 curValue = GetEnumConstantValue(enumType->underlyingType, enumValue);
+
+    ULONG64 remainingValue = curValue;
+    std::map<ULONG64, const std::string*> OrderedFlags;
+    for (const auto &constant : enumType->constants)
+    {
+        ULONG64 currentConstValue = constant.first;
+        if (currentConstValue == curValue)
+        {
+            output = constant.second;
+            return S_OK;
+        }
+        if (enumType->flags)
+        {
+            // Flag enumerated constant whose value is zero must be excluded from OR-ed expression.
+            if (currentConstValue == 0)
+                continue;
+
+            if ((currentConstValue == remainingValue) || ((currentConstValue != 0) && ((currentConstValue & remainingValue) == currentConstValue)))
+            {
+                OrderedFlags.emplace(std::make_pair(currentConstValue, &constant.second));
+                remainingValue &= ~currentConstValue;
             }
         }
     }
-    pMD->CloseEnum(fEnum);
 
     // Don't lose data, provide number as-is instead.
     if (!OrderedFlags.empty() && !remainingValue)
@@ -216,7 +270,7 @@ static HRESULT PrintEnumValue(ICorDebugValue* pInputValue, BYTE* enumValue, std:
             if (ss.tellp() > 0)
                 ss << " | ";
 
-            ss  << Flag.second;
+            ss  << *Flag.second;
         }
         output = ss.str();
     }
@@ -255,6 +309,12 @@ static HRESULT GetIntegralValue(ICorDebugValue *pInputValue, T& value)
             break;
         return E_FAIL;
 
+    case ELEMENT_TYPE_I2:
+    case ELEMENT_TYPE_U2:
+        if (typeid(T) == typeid(short) || typeid(T) == typeid(unsigned short))
+            break;
+        return E_FAIL;
+
     case ELEMENT_TYPE_I4:
     case ELEMENT_TYPE_U4:
         if (typeid(T) == typeid(int) || typeid(T) == typeid(unsigned))
@@ -356,6 +416,7 @@ static HRESULT GetDecimalFields(ICorDebugValue *pValue,
     ULONG numFields = 0;
     HCORENUM fEnum = NULL;
     mdFieldDef fieldDef;
+    std::string name;
     while(SUCCEEDED(pMD->EnumFields(&fEnum, currentTypeDef, &fieldDef, 1, &numFields)) && numFields != 0)
     {
         ULONG nameLen = 0;
@@ -373,7 +434,7 @@ static HRESULT GetDecimalFields(ICorDebugValue *pValue,
             IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &pObjValue));
             IfFailRet(pObjValue->GetFieldValue(pClass, fieldDef, &pFieldVal));
 
-            std::string name = to_utf8(mdName /*, nameLen*/);
+            assign_utf8(name, mdName /*, nameLen*/);
 
             if (name == "hi" || name == "_hi32")
             {
@@ -409,94 +470,258 @@ static HRESULT GetDecimalFields(ICorDebugValue *pValue,
     return (has_hi && has_mid && has_lo && has_flags ? S_OK : E_FAIL);
 }
 
-static inline uint64_t Make_64(uint32_t h, uint32_t l) { uint64_t v = h; v <<= 32; v |= l; return v; }
-static inline uint32_t Lo_32(uint64_t v) { return static_cast<uint32_t>(v); }
+// Note, in all runtime versions System.Decimal have same memory layout as native DECIMAL (runtime FCalls use it directly):
+// 32-bit flags, 32-bit high part and 64-bit low part, only fields names differ (`flags`, `hi`, `lo`, `mid` or `_flags`,
+// `_hi32`, `_lo64`). So, value data could be read by one call instead of fields search and read.
+static HRESULT ReadDecimalData(ICorDebugValue *pValue, uint32_t &hi, uint32_t &mid, uint32_t &lo, uint32_t &flags)
+{
+    HRESULT Status;
+    static const ULONG32 DecimalSize = 16;
+    ULONG32 cbSize;
+    IfFailRet(pValue->GetSize(&cbSize));
+    if (cbSize != DecimalSize)
+        return E_FAIL;
 
-bool uint96_is_zero(const uint32_t *v) { return v[0] == 0 && v[1] == 0 && v[2] == 0; }
+    ToRelease<ICorDebugGenericValue> pGenericValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &pGenericValue));
+    BYTE data[DecimalSize];
+    IfFailRet(pGenericValue->GetValue(data));
+
+    uint64_t lo64;
+    memcpy(&flags, data, sizeof(flags));
+    memcpy(&hi, data + 4, sizeof(hi));
+    memcpy(&lo64, data + 8, sizeof(lo64));
+    mid = static_cast<uint32_t>(lo64 >> 32);
+    lo = static_cast<uint32_t>(lo64);
+    return S_OK;
+}
 
-static void udivrem96(uint32_t *divident, uint32_t divisor, uint32_t &remainder)
+static HRESULT PrintDecimalValue(ICorDebugValue *pValue, std::string &output)
 {
-    remainder = 0;
-    for (int i = 2; i >= 0; i--)
+    HRESULT Status = S_OK;
+
+    unsigned int hi;
+    unsigned int mid;
+    unsigned int lo;
+    unsigned int flags;
+
+    if (FAILED(ReadDecimalData(pValue, hi, mid, lo, flags)))
+        IfFailRet(GetDecimalFields(pValue, hi, mid, lo, flags));
+
+    output = NumberFormat::DecimalToString(hi, mid, lo, flags);
+
+    return S_OK;
+}
+
+// Note, BigInteger is not System.Private.CoreLib type, so, it is detected by name.
+static const char BigIntegerTypeName[] = "System.Numerics.BigInteger";
+// Bigger values are not printed, since text is too long for value display in any case.
+static const ULONG32 MaxBigIntegerWords = 1024;
+
+// Two instance fields tokens cache for one type, fields search in metadata is much slower than read.
+// Note, fields could be named differently in different runtime versions, `altName` is checked in case `name` not found.
+struct TypeFieldsCache
+{
+    struct field_name_t
+    {
+        const WCHAR *name;
+        const WCHAR *altName;
+    };
+
+    TypeFieldsCache(field_name_t first, field_name_t second) : names{first, second} {}
+
+    const field_name_t names[2];
+    std::mutex mutex;
+    CORDB_ADDRESS modAddress = 0;
+    mdTypeDef typeDef = mdTypeDefNil;
+    mdFieldDef fields[2] = {mdFieldDefNil, mdFieldDefNil};
+};
+
+// BigInteger fields: `int _sign` and `uint[] _bits`.
+static TypeFieldsCache g_bigIntegerFields({W("_sign"), nullptr}, {W("_bits"), nullptr});
+// DateTimeOffset fields: `DateTime _dateTime` and `short _offsetMinutes` (type have auto layout, so, data can't be read as is).
+static TypeFieldsCache g_dateTimeOffsetFields({W("_dateTime"), W("m_dateTime")}, {W("_offsetMinutes"), W("m_offsetMinutes")});
+
+static HRESULT GetTypeFields(ICorDebugClass *pClass, TypeFieldsCache &cache, mdFieldDef &first, mdFieldDef &second)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugModule> pModule;
+    IfFailRet(pClass->GetModule(&pModule));
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+    mdTypeDef typeDef;
+    IfFailRet(pClass->GetToken(&typeDef));
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.modAddress == modAddress && cache.typeDef == typeDef)
     {
-        uint64_t partial_dividend = Make_64(remainder, divident[i]);
-        if (partial_dividend == 0) {
-            divident[i] = 0;
-            remainder = 0;
-        } else if (partial_dividend < divisor) {
-            divident[i] = 0;
-            remainder = Lo_32(partial_dividend);
-        } else if (partial_dividend == divisor) {
-            divident[i] = 1;
-            remainder = 0;
-        } else {
-            divident[i] = Lo_32(partial_dividend / divisor);
-            remainder = Lo_32(partial_dividend - (divident[i] * divisor));
+        first = cache.fields[0];
+        second = cache.fields[1];
+        return S_OK;
+    }
+
+    ToRelease<IUnknown> pMDUnknown;
+    ToRelease<IMetaDataImport> pMD;
+    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
+    mdFieldDef fields[2];
+    for (int i = 0; i < 2; i++)
+    {
+        if (FAILED(Status = pMD->FindField(typeDef, cache.names[i].name, nullptr, 0, &fields[i])))
+        {
+            if (cache.names[i].altName == nullptr)
+                return Status;
+            IfFailRet(pMD->FindField(typeDef, cache.names[i].altName, nullptr, 0, &fields[i]));
         }
     }
-}
 
-static std::string uint96_to_string(uint32_t *v)
-{
-    static const char *digits = "0123456789";
-    std::string result;
-    do {
-        uint32_t rem;
-        udivrem96(v, 10, rem);
-        result.insert(0, 1, digits[rem]);
-    } while (!uint96_is_zero(v));
-    return result;
+    cache.modAddress = modAddress;
+    cache.typeDef = typeDef;
+    first = cache.fields[0] = fields[0];
+    second = cache.fields[1] = fields[1];
+    return S_OK;
 }
 
-static void PrintDecimal(
-    unsigned int hi,
-    unsigned int mid,
-    unsigned int lo,
-    unsigned int flags,
-    std::string &output)
+static HRESULT PrintBigIntegerValue(ICorDebugValue *pValue, ICorDebugType *pType, std::string &output)
 {
-    uint32_t v[3] = { lo, mid, hi };
+    HRESULT Status;
+    ToRelease<ICorDebugClass> pClass;
+    IfFailRet(pType->GetClass(&pClass));
+    mdFieldDef signField;
+    mdFieldDef bitsField;
+    IfFailRet(GetTypeFields(pClass, g_bigIntegerFields, signField, bitsField));
+
+    ToRelease<ICorDebugObjectValue> pObjValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &pObjValue));
+    ToRelease<ICorDebugValue> pSignValue;
+    IfFailRet(pObjValue->GetFieldValue(pClass, signField, &pSignValue));
+    int sign;
+    IfFailRet(GetIntegralValue(pSignValue, sign));
+
+    ToRelease<ICorDebugValue> pBitsRefValue;
+    IfFailRet(pObjValue->GetFieldValue(pClass, bitsField, &pBitsRefValue));
+    BOOL isNull = TRUE;
+    ToRelease<ICorDebugValue> pBitsValue;
+    IfFailRet(DereferenceAndUnboxValue(pBitsRefValue, &pBitsValue, &isNull));
 
-    output = uint96_to_string(v);
+    // Small values are stored in `_sign` only.
+    if (isNull)
+    {
+        output = std::to_string(sign);
+        return S_OK;
+    }
 
-    static const unsigned int ScaleMask = 0x00FF0000ul;
-    static const unsigned int ScaleShift = 16;
-    static const unsigned int SignMask = 1ul << 31;
+    ToRelease<ICorDebugArrayValue> pArrayValue;
+    IfFailRet(pBitsValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID*) &pArrayValue));
+    ULONG32 cElements;
+    IfFailRet(pArrayValue->GetCount(&cElements));
+    if (cElements > MaxBigIntegerWords)
+        return E_FAIL;
 
-    unsigned int scale = (flags & ScaleMask) >> ScaleShift;
-    bool is_negative = flags & SignMask;
+    std::vector<uint32_t> words(cElements);
+    for (ULONG32 i = 0; i < cElements; i++)
+    {
+        ToRelease<ICorDebugValue> pElementValue;
+        IfFailRet(pArrayValue->GetElementAtPosition(i, &pElementValue));
+        ToRelease<ICorDebugGenericValue> pGenericValue;
+        IfFailRet(pElementValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &pGenericValue));
+        IfFailRet(pGenericValue->GetValue(&words[i]));
+    }
 
-    size_t len = output.length();
+    output = NumberFormat::BigIntegerToString(sign < 0, words.data(), words.size());
+    return S_OK;
+}
 
-    if (len > scale)
+// Note, size of native int depends on debuggee bitness, so, value size is used.
+static void PrintNativeIntValue(bool isSigned, const BYTE *data, ULONG32 size, std::ostringstream &ss)
+{
+    if (size == sizeof(int64_t))
     {
-        if (scale != 0)
-            output.insert(len - scale, 1, '.');
+        uint64_t value;
+        memcpy(&value, data, sizeof(value));
+        if (isSigned)
+            ss << int64_t(value);
+        else
+            ss << value;
     }
     else
     {
-        output.insert(0, "0.");
-        output.insert(2, scale - len, '0');
+        uint32_t value = 0;
+        memcpy(&value, data, std::min<size_t>(size, sizeof(value)));
+        if (isSigned)
+            ss << int32_t(value);
+        else
+            ss << value;
     }
-
-    if (is_negative)
-        output.insert(0, 1, '-');
 }
 
-static HRESULT PrintDecimalValue(ICorDebugValue *pValue, std::string &output)
+static HRESULT PrintDateTimeOffsetValue(ICorDebugValue *pValue, ICorDebugType *pType, std::string &output)
 {
-    HRESULT Status = S_OK;
+    HRESULT Status;
+    ToRelease<ICorDebugClass> pClass;
+    IfFailRet(pType->GetClass(&pClass));
+    mdFieldDef dateTimeField;
+    mdFieldDef offsetField;
+    IfFailRet(GetTypeFields(pClass, g_dateTimeOffsetFields, dateTimeField, offsetField));
+
+    ToRelease<ICorDebugObjectValue> pObjValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &pObjValue));
+    ToRelease<ICorDebugValue> pDateTimeValue;
+    IfFailRet(pObjValue->GetFieldValue(pClass, dateTimeField, &pDateTimeValue));
+    ToRelease<ICorDebugValue> pOffsetValue;
+    IfFailRet(pObjValue->GetFieldValue(pClass, offsetField, &pOffsetValue));
+
+    uint64_t dateData;
+    ULONG32 cbSize;
+    IfFailRet(pDateTimeValue->GetSize(&cbSize));
+    if (cbSize != sizeof(dateData))
+        return E_FAIL;
+    ToRelease<ICorDebugGenericValue> pGenericValue;
+    IfFailRet(pDateTimeValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &pGenericValue));
+    IfFailRet(pGenericValue->GetValue(&dateData));
+    short offsetMinutes;
+    IfFailRet(GetIntegralValue(pOffsetValue, offsetMinutes));
 
-    unsigned int hi;
-    unsigned int mid;
-    unsigned int lo;
-    unsigned int flags;
+    output = NumberFormat::DateTimeOffsetToString(dateData, offsetMinutes);
+    return S_OK;
+}
 
-    IfFailRet(GetDecimalFields(pValue, hi, mid, lo, flags));
+// Print common CoreLib value types same as ToString() do, but without func-eval, values are decoded from raw data
+// (DateTime, TimeSpan, Guid and IntPtr have same layout in all runtime versions). Return S_FALSE for other types.
+static HRESULT PrintWellKnownValue(ICorDebugValue *pValue, ICorDebugType *pType, const BYTE *data, ULONG32 size, std::string &output)
+{
+    if (WellKnownTypes::IsType(pType, WellKnownTypes::Type::DateTime) && size == sizeof(uint64_t))
+    {
+        uint64_t dateData;
+        memcpy(&dateData, data, sizeof(dateData));
+        output = NumberFormat::DateTimeToString(dateData);
+        return S_OK;
+    }
+    if (WellKnownTypes::IsType(pType, WellKnownTypes::Type::TimeSpan) && size == sizeof(int64_t))
+    {
+        int64_t ticks;
+        memcpy(&ticks, data, sizeof(ticks));
+        output = NumberFormat::TimeSpanToString(ticks);
+        return S_OK;
+    }
+    if (WellKnownTypes::IsType(pType, WellKnownTypes::Type::Guid) && size == 16)
+    {
+        output = NumberFormat::GuidToString(data);
+        return S_OK;
+    }
+    if (WellKnownTypes::IsType(pType, WellKnownTypes::Type::DateTimeOffset))
+        return SUCCEEDED(PrintDateTimeOffsetValue(pValue, pType, output)) ? S_OK : S_FALSE;
 
-    PrintDecimal(hi, mid, lo, flags, output);
+    const bool isIntPtr = WellKnownTypes::IsType(pType, WellKnownTypes::Type::IntPtr);
+    if (isIntPtr || WellKnownTypes::IsType(pType, WellKnownTypes::Type::UIntPtr))
+    {
+        std::ostringstream ss;
+        PrintNativeIntValue(isIntPtr, data, size, ss);
+        output = ss.str();
+        return S_OK;
+    }
 
-    return S_OK;
+    return S_FALSE;
 }
 
 static HRESULT PrintArrayValue(ICorDebugValue *pValue, std::string &output)
@@ -560,26 +785,100 @@ static HRESULT PrintArrayValue(ICorDebugValue *pValue, std::string &output)
     return S_OK;
 }
 
-HRESULT PrintStringValue(ICorDebugValue * pValue, std::string &output)
+static bool IsHighSurrogate(WCHAR wch)
+{
+    return wch >= 0xD800 && wch <= 0xDBFF;
+}
+
+HRESULT PrintStringValue(ICorDebugValue * pValue, std::string &output, ULONG32 maxLength, ULONG32 &length)
 {
     HRESULT Status;
 
     ToRelease<ICorDebugStringValue> pStringValue;
     IfFailRet(pValue->QueryInterface(IID_ICorDebugStringValue, (LPVOID*) &pStringValue));
 
-    ULONG32 cchValue;
-    IfFailRet(pStringValue->GetLength(&cchValue));
-    cchValue++;         // Allocate one more for null terminator
+    IfFailRet(pStringValue->GetLength(&length));
+    ULONG32 cchValue = std::min(length, maxLength);
 
-    ArrayHolder<WCHAR> str = new WCHAR[cchValue];
+    ArrayHolder<WCHAR> str = new WCHAR[cchValue + 1]; // Allocate one more for null terminator
 
     ULONG32 cchValueReturned;
     IfFailRet(pStringValue->GetString(
-        cchValue,
+        cchValue + 1,
         &cchValueReturned,
         str));
 
-    output = to_utf8(str);
+    // Note, in case of truncated string, don't split surrogate pair at the end.
+    cchValue = std::min(cchValue, cchValueReturned);
+    if (cchValue > 1 && cchValue < length && IsHighSurrogate(str[cchValue - 1]))
+        cchValue--;
+
+    output.clear();
+    // Note, string could contain null characters, convert it with explicit length.
+    append_utf8(output, str, cchValue);
+
+    return S_OK;
+}
+
+HRESULT PrintStringValue(ICorDebugValue * pValue, std::string &output)
+{
+    ULONG32 length;
+    return PrintStringValue(pValue, output, StringFullLength - 1, length);
+}
+
+HRESULT ReadArrayMemory(ICorDebugProcess *pProcess, ICorDebugValue *pValue, ULONG32 elementSize,
+                        ULONG32 offset, ULONG32 count, BYTE *buffer)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugProcess5> pProcess5;
+    IfFailRet(pProcess->QueryInterface(IID_ICorDebugProcess5, (LPVOID*) &pProcess5));
+
+    CORDB_ADDRESS address;
+    IfFailRet(pValue->GetAddress(&address));
+    COR_TYPEID typeId;
+    IfFailRet(pProcess5->GetTypeID(address, &typeId));
+    COR_ARRAY_LAYOUT layout;
+    IfFailRet(pProcess5->GetArrayLayout(typeId, &layout));
+    if (layout.elementSize != elementSize)
+        return E_FAIL;
+
+    const DWORD size = count * elementSize;
+    SIZE_T read = 0;
+    IfFailRet(pProcess->ReadMemory(address + layout.firstElementOffset + (CORDB_ADDRESS)offset * elementSize, size, buffer, &read));
+    return read == size ? S_OK : E_FAIL;
+}
+
+HRESULT ReadStringValue(ICorDebugProcess *pProcess, ICorDebugValue *pValue, ULONG32 offset, ULONG32 count,
+                        std::string &output, ULONG32 &read, ULONG32 &length)
+{
+    HRESULT Status;
+
+    ToRelease<ICorDebugStringValue> pStringValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugStringValue, (LPVOID*) &pStringValue));
+
+    IfFailRet(pStringValue->GetLength(&length));
+    if (offset > length)
+        return E_INVALIDARG;
+    count = std::min(count, length - offset);
+
+    ArrayHolder<WCHAR> str = new WCHAR[count + 1];
+    if (count > 0 && FAILED(ReadArrayMemory(pProcess, pValue, sizeof(WCHAR), offset, count, (BYTE*)str.GetPtr())))
+    {
+        // Fallback, read string from beginning and use requested part only.
+        ArrayHolder<WCHAR> prefix = new WCHAR[offset + count + 1];
+        ULONG32 cchValueReturned;
+        IfFailRet(pStringValue->GetString(offset + count + 1, &cchValueReturned, prefix));
+        if (cchValueReturned < offset + count)
+            return E_FAIL;
+        memcpy(str.GetPtr(), prefix.GetPtr() + offset, count * sizeof(WCHAR));
+    }
+
+    read = count;
+    if (read > 1 && offset + read < length && IsHighSurrogate(str[read - 1]))
+        read--;
+
+    output.clear();
+    append_utf8(output, str, read);
 
     return S_OK;
 }
@@ -617,7 +916,302 @@ void EscapeString(std::string &s, char q = '\"')
     }
 }
 
-HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape)
+// Print value of primitive type, return false in case type is not primitive.
+static bool PrintPrimitiveValue(CorElementType corElemType, const BYTE *rgbValue, bool escape, std::ostringstream &ss)
+{
+    switch (corElemType)
+    {
+    case ELEMENT_TYPE_BOOLEAN:
+        ss << (rgbValue[0] == 0 ? "false" : "true");
+        break;
+
+    case ELEMENT_TYPE_CHAR:
+        {
+            WCHAR wc = * (WCHAR *) &(rgbValue[0]);
+            std::string printableVal = to_utf8(wc);
+            if (!escape)
+            {
+                ss << printableVal;
+                break;
+            }
+            EscapeString(printableVal, '\'');
+            ss << (unsigned int)wc << " '" << printableVal << "'";
+        }
+        break;
+
+    case ELEMENT_TYPE_I1:
+        ss << (int) *(char*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_U1:
+        ss << (unsigned int) *(unsigned char*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_I2:
+        ss << *(short*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_U2:
+        ss << *(unsigned short*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_I:
+        ss << *(int*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_U:
+        ss << *(unsigned int*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_I4:
+        ss << *(int*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_U4:
+        ss << *(unsigned int*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_I8:
+        ss << *(__int64*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_U8:
+        ss << *(unsigned __int64*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_R4:
+        ss << std::setprecision(8) << *(float*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_R8:
+        ss << std::setprecision(16) << *(double*) &(rgbValue[0]);
+        break;
+
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+ULONG32 GetPrimitiveTypeSize(CorElementType corElemType)
+{
+    switch (corElemType)
+    {
+    case ELEMENT_TYPE_BOOLEAN:
+    case ELEMENT_TYPE_I1:
+    case ELEMENT_TYPE_U1:
+        return 1;
+    case ELEMENT_TYPE_CHAR:
+    case ELEMENT_TYPE_I2:
+    case ELEMENT_TYPE_U2:
+        return 2;
+    case ELEMENT_TYPE_I4:
+    case ELEMENT_TYPE_U4:
+    case ELEMENT_TYPE_R4:
+        return 4;
+    case ELEMENT_TYPE_I8:
+    case ELEMENT_TYPE_U8:
+    case ELEMENT_TYPE_R8:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+HRESULT PrintPrimitiveValue(CorElementType corElemType, const BYTE *data, std::string &output)
+{
+    if (GetPrimitiveTypeSize(corElemType) == 0)
+        return E_INVALIDARG;
+
+    std::ostringstream ss;
+    PrintPrimitiveValue(corElemType, data, true, ss);
+    output = ss.str();
+    return S_OK;
+}
+
+// Same as ReadPrimitiveArrayElements(), but for elements view (see EvalIntrinsics::GetElementsView()), each view chunk
+// is read by one read.
+static HRESULT ReadPrimitiveViewElements(const EvalIntrinsics::ElementsView &view, ULONG32 start, ULONG32 end, std::vector<BYTE> &data)
+{
+    HRESULT Status;
+    const ULONG32 elementSize = GetPrimitiveTypeSize(view.elementType);
+    if (elementSize == 0)
+        return S_FALSE;
+
+    end = std::min(end, view.length);
+    data.clear();
+    if (start >= end)
+        return S_OK;
+
+    data.resize(size_t(end - start) * elementSize);
+    ULONG32 chunkStart = 0;
+    for (const auto &chunk : view.chunks)
+    {
+        const ULONG32 chunkEnd = chunkStart + chunk.length;
+        const ULONG32 readStart = std::max(start, chunkStart);
+        const ULONG32 readEnd = std::min(end, chunkEnd);
+        if (readStart < readEnd)
+        {
+            BYTE *buffer = &data[size_t(readStart - start) * elementSize];
+            const ULONG32 count = readEnd - readStart;
+            if (chunk.owner && chunk.reversed)
+            {
+                IfFailRet(ReadArrayMemory(view.process, chunk.owner, elementSize, chunk.offset + chunkEnd - readEnd, count, buffer));
+                for (ULONG32 i = 0; i < count / 2; i++)
+                {
+                    std::swap_ranges(buffer + i * elementSize, buffer + (i + 1) * elementSize, buffer + (count - 1 - i) * elementSize);
+                }
+            }
+            else if (chunk.owner)
+            {
+                IfFailRet(ReadArrayMemory(view.process, chunk.owner, elementSize, chunk.offset + readStart - chunkStart, count, buffer));
+            }
+            else
+            {
+                const DWORD size = count * elementSize;
+                SIZE_T read = 0;
+                IfFailRet(view.process->ReadMemory(chunk.address + (CORDB_ADDRESS)(readStart - chunkStart) * elementSize,
+                                                   size, buffer, &read));
+                if (read != size)
+                    return E_FAIL;
+            }
+        }
+        if (chunkEnd >= end)
+            break;
+        chunkStart = chunkEnd;
+    }
+
+    return S_OK;
+}
+
+static void AppendArrayPreview(CorElementType elementType, const std::vector<BYTE> &elements, ULONG32 count, ULONG32 cElements,
+                               std::string &output)
+{
+    const ULONG32 elementSize = GetPrimitiveTypeSize(elementType);
+    std::ostringstream ss;
+    ss << " [";
+    for (ULONG32 i = 0; i < count; i++)
+    {
+        if (i > 0)
+            ss << ", ";
+        PrintPrimitiveValue(elementType, &elements[i * elementSize], true, ss);
+    }
+    if (count < cElements)
+        ss << (count > 0 ? ", ..." : "...");
+    ss << "]";
+
+    output += ss.str();
+}
+
+HRESULT PrintArrayPreview(ICorDebugProcess *pProcess, ICorDebugValue *pInputValue, const ArrayPreviewBudget &budget, std::string &output)
+{
+    HRESULT Status;
+
+    BOOL isNull = TRUE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (isNull)
+        return S_FALSE;
+
+    CorElementType corElemType;
+    IfFailRet(pValue->GetType(&corElemType));
+    if (corElemType == ELEMENT_TYPE_VALUETYPE || corElemType == ELEMENT_TYPE_CLASS)
+    {
+        EvalIntrinsics::ElementsView view;
+        if (EvalIntrinsics::GetElementsView(pValue, view) != S_OK)
+            return S_FALSE;
+        const ULONG32 elementSize = GetPrimitiveTypeSize(view.elementType);
+        if (elementSize == 0)
+            return S_FALSE;
+
+        const ULONG32 count = std::min(view.length, std::min(budget.maxElements, budget.maxBytes / elementSize));
+        std::vector<BYTE> elements;
+        IfFailRet(ReadPrimitiveViewElements(view, 0, count, elements));
+        AppendArrayPreview(view.elementType, elements, count, view.length, output);
+        return S_OK;
+    }
+    if (corElemType != ELEMENT_TYPE_SZARRAY)
+        return S_FALSE;
+
+    ToRelease<ICorDebugArrayValue> pArrayValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID*) &pArrayValue));
+
+    CorElementType elementType;
+    IfFailRet(pArrayValue->GetElementType(&elementType));
+    const ULONG32 elementSize = GetPrimitiveTypeSize(elementType);
+    if (elementSize == 0)
+        return S_FALSE;
+
+    ULONG32 cElements;
+    IfFailRet(pArrayValue->GetCount(&cElements));
+    const ULONG32 count = std::min(cElements, std::min(budget.maxElements, budget.maxBytes / elementSize));
+
+    std::vector<BYTE> elements(count * elementSize);
+    if (count > 0 && (pProcess == nullptr ||
+                      FAILED(ReadArrayMemory(pProcess, pValue, elementSize, 0, count, elements.data()))))
+    {
+        // Fallback, read elements one by one (still no more than budget allows).
+        for (ULONG32 i = 0; i < count; i++)
+        {
+            ToRelease<ICorDebugValue> pElementValue;
+            IfFailRet(pArrayValue->GetElementAtPosition(i, &pElementValue));
+            ToRelease<ICorDebugGenericValue> pGenericValue;
+            IfFailRet(pElementValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &pGenericValue));
+            IfFailRet(pGenericValue->GetValue((LPVOID) &elements[i * elementSize]));
+        }
+    }
+
+    AppendArrayPreview(elementType, elements, count, cElements, output);
+    return S_OK;
+}
+
+HRESULT ReadPrimitiveArrayElements(ICorDebugProcess *pProcess, ICorDebugValue *pInputValue, ULONG32 start, ULONG32 end,
+                                   CorElementType &elementType, std::vector<BYTE> &data)
+{
+    HRESULT Status;
+
+    BOOL isNull = TRUE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (isNull)
+        return S_FALSE;
+
+    CorElementType corElemType;
+    IfFailRet(pValue->GetType(&corElemType));
+    if (corElemType == ELEMENT_TYPE_VALUETYPE || corElemType == ELEMENT_TYPE_CLASS)
+    {
+        EvalIntrinsics::ElementsView view;
+        IfFailRet(EvalIntrinsics::GetElementsView(pValue, view));
+        if (Status == S_FALSE)
+            return S_FALSE;
+
+        elementType = view.elementType;
+        return ReadPrimitiveViewElements(view, start, end, data);
+    }
+    if (corElemType != ELEMENT_TYPE_SZARRAY && corElemType != ELEMENT_TYPE_ARRAY)
+        return S_FALSE;
+
+    ToRelease<ICorDebugArrayValue> pArrayValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID*) &pArrayValue));
+
+    IfFailRet(pArrayValue->GetElementType(&elementType));
+    const ULONG32 elementSize = GetPrimitiveTypeSize(elementType);
+    if (elementSize == 0)
+        return S_FALSE;
+
+    ULONG32 cElements;
+    IfFailRet(pArrayValue->GetCount(&cElements));
+    end = std::min(end, cElements);
+    data.clear();
+    if (start >= end)
+        return S_OK;
+
+    data.resize(size_t(end - start) * elementSize);
+    return ReadArrayMemory(pProcess, pValue, elementSize, start, end - start, data.data());
+}
+
+HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape, ULONG32 maxStringLength)
 {
     HRESULT Status;
 
@@ -646,19 +1240,20 @@ HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape
     if (corElemType == ELEMENT_TYPE_STRING)
     {
         std::string raw_str;
-        IfFailRet(PrintStringValue(pValue, raw_str));
+        ULONG32 length;
+        IfFailRet(PrintStringValue(pValue, raw_str, maxStringLength, length));
 
-        if (!escape)
+        if (escape)
         {
-            output = raw_str;
-            return S_OK;
+            EscapeString(raw_str, '"');
+            raw_str.insert(0, 1, '"');
+            raw_str.push_back('"');
         }
 
-        EscapeString(raw_str, '"');
+        if (length > maxStringLength)
+            raw_str += "...(" + std::to_string(length) + ")";
 
-        std::ostringstream ss;
-        ss << "\"" << raw_str << "\"";
-        output = ss.str();
+        output = std::move(raw_str);
         return S_OK;
     }
 
@@ -681,7 +1276,13 @@ HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape
     switch (corElemType)
     {
     default:
-        ss << "(Unhandled CorElementType: 0x" << std::hex << corElemType << ")";
+        if (!PrintPrimitiveValue(corElemType, rgbValue.GetPtr(), escape, ss))
+            ss << "(Unhandled CorElementType: 0x" << std::hex << corElemType << ")";
+        break;
+
+    case ELEMENT_TYPE_I:
+    case ELEMENT_TYPE_U:
+        PrintNativeIntValue(corElemType == ELEMENT_TYPE_I, rgbValue.GetPtr(), cbSize, ss);
         break;
 
     case ELEMENT_TYPE_PTR:
@@ -701,91 +1302,42 @@ HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape
     case ELEMENT_TYPE_VALUETYPE:
     case ELEMENT_TYPE_CLASS:
         {
-            std::string typeName;
-            TypePrinter::GetTypeOfValue(pValue, typeName);
-            if (typeName == "decimal") // TODO: implement mechanism for printing custom type values
+            ToRelease<ICorDebugValue2> pValue2;
+            ToRelease<ICorDebugType> pType;
+            if (FAILED(pValue->QueryInterface(IID_ICorDebugValue2, (LPVOID *) &pValue2)) ||
+                FAILED(pValue2->GetExactType(&pType)))
+            {
+                ss << "{<unknown>}";
+            }
+            else if (WellKnownTypes::IsType(pType, WellKnownTypes::Type::Decimal)) // TODO: implement mechanism for printing custom type values
             {
                 std::string val;
                 PrintDecimalValue(pValue, val);
                 ss << val;
             }
-            else if (typeName == "void")
+            else if (WellKnownTypes::IsType(pType, WellKnownTypes::Type::Void))
             {
                 ss << "Expression has been evaluated and has no value";
             }
-            else
+            else if (corElemType == ELEMENT_TYPE_VALUETYPE &&
+                     PrintWellKnownValue(pValue, pType, rgbValue.GetPtr(), cbSize, output) == S_OK)
             {
-                ss << '{' << typeName << '}';
+                return S_OK;
             }
-        }
-        break;
-
-    case ELEMENT_TYPE_BOOLEAN:
-        ss << (rgbValue[0] == 0 ? "false" : "true");
-        break;
-
-    case ELEMENT_TYPE_CHAR:
-        {
-            WCHAR wc = * (WCHAR *) &(rgbValue[0]);
-            std::string printableVal = to_utf8(wc);
-            if (!escape)
+            else
             {
-                output = printableVal;
-                return S_OK;
+                std::string typeName;
+                TypePrinter::GetTypeOfValue(pType, typeName);
+                std::string val;
+                if (corElemType == ELEMENT_TYPE_VALUETYPE && typeName == BigIntegerTypeName &&
+                    SUCCEEDED(PrintBigIntegerValue(pValue, pType, val)))
+                    ss << val;
+                else
+                    ss << '{' << typeName << '}';
             }
-            EscapeString(printableVal, '\'');
-            ss << (unsigned int)wc << " '" << printableVal << "'";
         }
         break;
 
-    case ELEMENT_TYPE_I1:
-        ss << (int) *(char*) &(rgbValue[0]);
-        break;
-
-    case ELEMENT_TYPE_U1:
-        ss << (unsigned int) *(unsigned char*) &(rgbValue[0]);
-        break;
-
-    case ELEMENT_TYPE_I2:
-        ss << *(short*) &(rgbValue[0]);
-        break;
-
-    case ELEMENT_TYPE_U2:
-        ss << *(unsigned short*) &(rgbValue[0]);
-        break;
-
-    case ELEMENT_TYPE_I:
-        ss << *(int*) &(rgbValue[0]);
-        break;
-
-    case ELEMENT_TYPE_U:
-        ss << *(unsigned int*) &(rgbValue[0]);
-        break;
-
-    case ELEMENT_TYPE_I4:
-        ss << *(int*) &(rgbValue[0]);
-        break;
-
-    case ELEMENT_TYPE_U4:
-        ss << *(unsigned int*) &(rgbValue[0]);
-        break;
-
-    case ELEMENT_TYPE_I8:
-        ss << *(__int64*) &(rgbValue[0]);
-        break;
-
-    case ELEMENT_TYPE_U8:
-        ss << *(unsigned __int64*) &(rgbValue[0]);
-        break;
-
-    case ELEMENT_TYPE_R4:
-        ss << std::setprecision(8) << *(float*) &(rgbValue[0]);
-        break;
-
-    case ELEMENT_TYPE_R8:
-        ss << std::setprecision(16) << *(double*) &(rgbValue[0]);
-        break;
-
     case ELEMENT_TYPE_OBJECT:
         ss << "object";
         break;
@@ -800,4 +1352,18 @@ HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape
     return S_OK;
 }
 
+void ClearValuePrintCache()
+{
+    {
+        std::lock_guard<std::mutex> lock(g_enumTypesMutex);
+        g_enumTypes.clear();
+    }
+    for (TypeFieldsCache *cache : {&g_bigIntegerFields, &g_dateTimeOffsetFields})
+    {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        cache->modAddress = 0;
+        cache->typeDef = mdTypeDefNil;
+    }
+}
+
 } // namespace netcoredbg
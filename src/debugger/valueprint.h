@@ -7,12 +7,57 @@
 #include "cordebug.h"
 
 #include <string>
+#include <vector>
 
 namespace netcoredbg
 {
 
-HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape = true);
+// Max length (in UTF-16 code units) of string values printed for variables, watches and hover, longer strings are
+// truncated and "...(<length>)" marker is added, full value could be read by parts with ReadStringValue().
+const ULONG32 StringPreviewLength = 4096;
+const ULONG32 StringFullLength = ULONG32(-1);
+
+HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape = true, ULONG32 maxStringLength = StringFullLength);
 HRESULT PrintStringValue(ICorDebugValue * pValue, std::string &output);
+// Print first `maxLength` code units of string, `length` is full string length.
+HRESULT PrintStringValue(ICorDebugValue * pValue, std::string &output, ULONG32 maxLength, ULONG32 &length);
+// Read `count` code units of string starting from `offset`, `read` is number of code units actually read (surrogate
+// pair is never split) and `length` is full string length. Note, only requested part is read from debuggee memory.
+HRESULT ReadStringValue(ICorDebugProcess *pProcess, ICorDebugValue *pValue, ULONG32 offset, ULONG32 count,
+                        std::string &output, ULONG32 &read, ULONG32 &length);
+
+// Size of primitive type value, that could be printed from raw data, 0 in case of other types. Note, native int
+// is not included, since its size depends on debuggee bitness.
+ULONG32 GetPrimitiveTypeSize(CorElementType corElemType);
+// Print value of primitive type (see GetPrimitiveTypeSize()) from raw data, same as PrintValue() do.
+HRESULT PrintPrimitiveValue(CorElementType corElemType, const BYTE *data, std::string &output);
+
+// Limits for array preview. Note, preview never run evals (no ToString() or DebuggerDisplay calls), only elements
+// of primitive types are read from debuggee memory, so, budget limit number of elements and bytes read.
+struct ArrayPreviewBudget
+{
+    ULONG32 maxElements = 10;
+    ULONG32 maxBytes = 256;
+};
+
+// Append preview of first elements for one-dimensional array (or elements view, see EvalIntrinsics::GetElementsView()) of
+// primitive type to `output` (for example, "{int[1000000]}" printed by PrintValue() become "{int[1000000]} [1, 2, 3, ...]").
+// Elements are read from debuggee memory in bulk, `pProcess` could be nullptr, in this case array elements read one by one.
+// Return S_FALSE in case value can't be previewed (not array, array of non primitive type, multidimensional array or null).
+HRESULT PrintArrayPreview(ICorDebugProcess *pProcess, ICorDebugValue *pInputValue, const ArrayPreviewBudget &budget, std::string &output);
+// Read raw data of elements at positions [start, end) of array of primitive type (see GetPrimitiveTypeSize()) from debuggee memory
+// by one read, `end` is limited by elements count. Note, multidimensional arrays elements are stored in row-major order, so,
+// positions range is contiguous memory for any rank. Elements views are read by one read for each view chunk.
+// Return S_FALSE in case value is not array or elements view of primitive type (or null).
+HRESULT ReadPrimitiveArrayElements(ICorDebugProcess *pProcess, ICorDebugValue *pInputValue, ULONG32 start, ULONG32 end,
+                                   CorElementType &elementType, std::vector<BYTE> &data);
+// Read raw data of `count` elements of string or array (of any type) starting from `offset` directly from debuggee memory,
+// object layout is provided by runtime. Return E_FAIL in case `elementSize` is not array element size.
+HRESULT ReadArrayMemory(ICorDebugProcess *pProcess, ICorDebugValue *pValue, ULONG32 elementSize,
+                        ULONG32 offset, ULONG32 count, BYTE *buffer);
 HRESULT DereferenceAndUnboxValue(ICorDebugValue * pValue, ICorDebugValue** ppOutputValue, BOOL * pIsNull = nullptr);
+// Release cached enum types constants and fields tokens of types printed by PrintValue(), must be called at debuggee
+// process exit or detach.
+void ClearValuePrintCache();
 
 } // namespace netcoredbg
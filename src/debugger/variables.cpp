@@ -7,6 +7,7 @@
 #include <vector>
 #include <cstring>
 #include <algorithm>
+#include <chrono>
 #include <sstream>
 
 #include "metadata/typeprinter.h"
@@ -17,6 +18,7 @@
 #include "debugger/frames.h"
 #include "debugger/evalstackmachine.h"
 #include "managed/interop.h"
+#include "utils/cancellation.h"
 #include "utils/logger.h"
 #include "utils/utf.h"
 #include "interfaces/types.h"
@@ -24,6 +26,39 @@
 namespace netcoredbg
 {
 
+const size_t PropertyValuesCache::MaxValues;
+
+bool PropertyValuesCache::Find(const key_t &key, ICorDebugValue **ppValue)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_values.find(key);
+    if (it == m_values.end())
+        return false;
+
+    it->second->AddRef();
+    *ppValue = it->second.GetPtr();
+    return true;
+}
+
+void PropertyValuesCache::Add(const key_t &key, ICorDebugValue *pValue)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Note, cache is cleared at each continue, so, just stop caching in case of huge amount of properties evaluated.
+    if (m_values.size() >= MaxValues)
+        return;
+
+    pValue->AddRef();
+    m_values[key] = pValue;
+}
+
+void PropertyValuesCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_values.clear();
+}
+
 static void GetNumChild(Evaluator *pEvaluator, ICorDebugValue *pValue, int &numChild, bool static_members)
 {
     numChild = 0;
@@ -31,6 +66,15 @@ static void GetNumChild(Evaluator *pEvaluator, ICorDebugValue *pValue, int &numC
     if (pValue == nullptr)
         return;
 
+    // Array have elements only (no static members), no reason walk over all elements in order to count them.
+    ULONG32 cElements = 0;
+    if (pEvaluator->GetArrayElementsCount(pValue, cElements) == S_OK)
+    {
+        if (!static_members)
+            numChild = static_cast<int>(std::min<ULONG32>(cElements, INT_MAX));
+        return;
+    }
+
     int numStatic = 0;
     int numInstance = 0;
     // No thread and FrameLevel{0} here, since we need only count children.
@@ -67,44 +111,173 @@ struct VariableMember
     std::string name;
     std::string ownerType;
     ToRelease<ICorDebugValue> value;
-    VariableMember(const std::string &name, const std::string& ownerType, ICorDebugValue *pValue) :
+    int index; // index in walk over members (fetch static or non static members only)
+    bool isProperty;
+    // Property, that was not evaluated since request evaluation budget was used up (provided as lazy variable).
+    bool isDeferred;
+    // Value type field or array element of primitive type, that printed from raw data directly (`value` is not created in this case).
+    bool isPrinted;
+    std::string printedValue;
+    std::string printedType;
+    VariableMember(const std::string &name, const std::string& ownerType, ICorDebugValue *pValue, int index, bool isProperty) :
         name(name),
         ownerType(ownerType),
-        value(pValue)
+        value(pValue),
+        index(index),
+        isProperty(isProperty),
+        isDeferred(false),
+        isPrinted(false)
     {}
     VariableMember(VariableMember &&that) = default;
     VariableMember(const VariableMember &that) = delete;
 };
 
-static void FillValueAndType(VariableMember &member, Variable &var)
+// Note, array preview failure is not an error, value is provided without preview in this case.
+static HRESULT PrintVariableValue(ICorDebugProcess *pProcess, ICorDebugValue *pValue, bool arrayPreview, std::string &value)
+{
+    HRESULT Status;
+    IfFailRet(PrintValue(pValue, value, true, StringPreviewLength));
+    if (arrayPreview)
+        PrintArrayPreview(pProcess, pValue, ArrayPreviewBudget(), value);
+    return S_OK;
+}
+
+static void FillValueAndType(ICorDebugProcess *pProcess, VariableMember &member, Variable &var, bool arrayPreview)
 {
+    if (member.isPrinted)
+    {
+        var.value = member.printedValue;
+        var.type = member.printedType;
+        return;
+    }
     if (member.value == nullptr)
     {
         var.value = "<error>";
         return;
     }
-    PrintValue(member.value, var.value, true);
+    PrintVariableValue(pProcess, member.value, arrayPreview, var.value);
     TypePrinter::GetTypeOfValue(member.value, var.type);
 }
 
-static HRESULT FetchFieldsAndProperties(Evaluator *pEvaluator, ICorDebugValue *pInputValue, ICorDebugThread *pThread,
-                                        FrameLevel frameLevel, std::vector<VariableMember> &members, bool fetchOnlyStatic,
-                                        bool &hasStaticMembers, int childStart, int childEnd, int evalFlags)
+// Limit for array elements read by one debuggee memory read.
+static const ULONG32 MaxArrayChunkElements = 4096;
+
+// Members are fetched in two passes: at first pass all fields values are fetched (no evals need) and entries for properties
+// are reserved, at second pass properties getters are evaluated (in case deferProperties is true, second pass is skipped and
+// properties are provided without values). Properties values are taken from cache, in case was evaluated for same object during
+// this break. In case `evalBudget` (in milliseconds) is not 0, each getter eval timeout is limited by rest of budget and properties
+// that left after budget was used up are marked as deferred.
+static HRESULT FetchFieldsAndProperties(Evaluator *pEvaluator, PropertyValuesCache &propertyValuesCache, ICorDebugValue *pInputValue,
+                                        ICorDebugThread *pThread, FrameLevel frameLevel, std::vector<VariableMember> &members,
+                                        bool fetchOnlyStatic, bool &hasStaticMembers, int childStart, int childEnd, int evalFlags,
+                                        bool deferProperties, unsigned evalBudget)
 {
+    const auto budgetEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds(evalBudget);
+
     hasStaticMembers = false;
     HRESULT Status;
 
     DWORD threadId = 0;
     IfFailRet(pThread->GetID(&threadId));
 
+    // Array elements have O(1) access by position, fetch requested range only.
+    ULONG32 cElements = 0;
+    if (pEvaluator->GetArrayElementsCount(pInputValue, cElements) == S_OK)
+    {
+        if (fetchOnlyStatic || childStart < 0 || childEnd <= childStart)
+            return S_OK;
+
+        // Elements of primitive types are printed from raw data, that read from debuggee memory by chunks, so, large arrays
+        // (including multidimensional) don't need ICorDebugValue creation for each element. In case read failed, elements
+        // are fetched one by one.
+        ToRelease<ICorDebugProcess> pProcess;
+        bool bulkRead = SUCCEEDED(pThread->GetProcess(&pProcess));
+        CorElementType elementType = ELEMENT_TYPE_END;
+        std::string elementTypeName;
+        std::vector<BYTE> chunk;
+        ULONG32 chunkStart = 0;
+        ULONG32 chunkEnd = 0;
+
+        int currentIndex = childStart;
+        return pEvaluator->WalkArrayElements(pInputValue, (ULONG32)childStart, (ULONG32)childEnd, [&](
+            ICorDebugType*,
+            bool,
+            const std::string &name,
+            Evaluator::GetValueCallback getValue,
+            Evaluator::SetterData*)
+        {
+            if (Cancellation::IsRequested())
+                return COR_E_OPERATIONCANCELED;
+
+            const ULONG32 position = (ULONG32)currentIndex;
+            if (bulkRead && position >= chunkEnd)
+            {
+                chunkStart = position;
+                chunkEnd = std::min((ULONG32)childEnd, position + MaxArrayChunkElements);
+                bulkRead = ReadPrimitiveArrayElements(pProcess, pInputValue, chunkStart, chunkEnd, elementType, chunk) == S_OK &&
+                           !chunk.empty();
+                if (bulkRead && elementTypeName.empty())
+                {
+                    // Note, primitive type signature is element type only, enclosing type and metadata are not used for it.
+                    const COR_SIGNATURE sig[] = { static_cast<COR_SIGNATURE>(elementType) };
+                    TypePrinter::NameForTypeSig(sig, nullptr, nullptr, elementTypeName);
+                }
+            }
+            if (bulkRead)
+            {
+                const size_t offset = size_t(position - chunkStart) * GetPrimitiveTypeSize(elementType);
+                if (offset < chunk.size())
+                {
+                    members.emplace_back(name, std::string(), nullptr, currentIndex++, false);
+                    members.back().isPrinted = true;
+                    members.back().printedType = elementTypeName;
+                    return PrintPrimitiveValue(elementType, &chunk[offset], members.back().printedValue);
+                }
+                bulkRead = false;
+            }
+
+            ToRelease<ICorDebugValue> iCorResultValue;
+            const HRESULT getStatus = getValue(&iCorResultValue, evalFlags);
+            if (getStatus == COR_E_OPERATIONCANCELED)
+                return COR_E_OPERATIONCANCELED;
+
+            members.emplace_back(name, std::string(), iCorResultValue.Detach(), currentIndex++, false);
+            // Note, null references in raw memory of Span<T> are provided without value (see EvalIntrinsics::GetViewElement()).
+            if (getStatus == S_FALSE && members.back().value == nullptr)
+            {
+                members.back().isPrinted = true;
+                members.back().printedValue = "null";
+            }
+            return S_OK;
+        });
+    }
+
+    // Fields of primitive types of value type are printed from value data, that read by one call.
+    std::unordered_map<std::string, std::pair<std::string, std::string>> primitiveFields;
+    if (!fetchOnlyStatic)
+    {
+        pEvaluator->WalkPrimitiveFields(pInputValue, [&](const std::string &name, CorElementType type, const BYTE *data) -> HRESULT
+        {
+            auto &field = primitiveFields[name];
+            IfFailRet(PrintPrimitiveValue(type, data, field.first));
+            // Note, primitive type signature is element type only, enclosing type and metadata are not used for it.
+            const COR_SIGNATURE sig[] = { static_cast<COR_SIGNATURE>(type) };
+            TypePrinter::NameForTypeSig(sig, nullptr, nullptr, field.second);
+            return S_OK;
+        });
+    }
+
     int currentIndex = -1;
+    // Indexes in `members` of properties, that must be evaluated at second pass.
+    std::vector<size_t> propertiesToEval;
 
-    IfFailRet(pEvaluator->WalkMembers(pInputValue, pThread, frameLevel, false, [&](
+    // Note, setter data provided for properties only, so, we use it in order to distinguish fields and properties.
+    IfFailRet(pEvaluator->WalkMembers(pInputValue, pThread, frameLevel, true, [&](
         ICorDebugType *pType,
         bool is_static,
         const std::string &name,
         Evaluator::GetValueCallback getValue,
-        Evaluator::SetterData*)
+        Evaluator::SetterData *setterData)
     {
         if (is_static)
             hasStaticMembers = true;
@@ -119,30 +292,222 @@ static HRESULT FetchFieldsAndProperties(Evaluator *pEvaluator, ICorDebugValue *p
         if (currentIndex >= childEnd)
             return S_OK;
 
+        std::string className;
+        if (pType)
+            IfFailRet(TypePrinter::GetTypeOfValue(pType, className));
+
+        // Note, auto-property value is read from backing field without evaluation, same as field value.
+        if (setterData && !setterData->autoProperty)
+        {
+            if (!deferProperties)
+                propertiesToEval.emplace_back(members.size());
+            members.emplace_back(name, className, nullptr, currentIndex, true);
+            return S_OK;
+        }
+
+        if (Cancellation::IsRequested())
+            return COR_E_OPERATIONCANCELED;
+
+        auto findPrimitive = is_static ? primitiveFields.end() : primitiveFields.find(name);
+        if (findPrimitive != primitiveFields.end())
+        {
+            members.emplace_back(name, className, nullptr, currentIndex, false);
+            members.back().isPrinted = true;
+            members.back().printedValue = std::move(findPrimitive->second.first);
+            members.back().printedType = std::move(findPrimitive->second.second);
+            return S_OK;
+        }
+
         // Note, in this case error is not fatal, but if protocol side need cancel command execution, stop walk and return error to caller.
         ToRelease<ICorDebugValue> iCorResultValue;
         if (getValue(&iCorResultValue, evalFlags) == COR_E_OPERATIONCANCELED)
             return COR_E_OPERATIONCANCELED;
 
-        std::string className;
-        if (pType)
-            IfFailRet(TypePrinter::GetTypeOfValue(pType, className));
-
-        members.emplace_back(name, className, iCorResultValue.Detach());
+        members.emplace_back(name, className, iCorResultValue.Detach(), currentIndex, false);
         return S_OK;
     }));
 
+    if (propertiesToEval.empty())
+        return S_OK;
+
+    // Note, only objects in managed heap are cached, value types (locals, eval results) could be placed at same address.
+    CORDB_ADDRESS address = 0;
+    std::string typeName;
+    ToRelease<ICorDebugValue> pValue;
+    CorElementType corElemType;
+    if (SUCCEEDED(DereferenceAndUnboxValue(pInputValue, &pValue)) &&
+        SUCCEEDED(pValue->GetType(&corElemType)) && corElemType == ELEMENT_TYPE_CLASS &&
+        SUCCEEDED(pValue->GetAddress(&address)) && address != 0)
+    {
+        TypePrinter::GetTypeOfValue(pValue, typeName);
+    }
+
+    auto propertyKey = [&](int index)
+    {
+        return PropertyValuesCache::key_t(address, typeName, index, fetchOnlyStatic, evalFlags);
+    };
+
+    if (address != 0)
+    {
+        std::vector<size_t> notCached;
+        for (size_t i : propertiesToEval)
+        {
+            if (!propertyValuesCache.Find(propertyKey(members[i].index), &members[i].value))
+                notCached.push_back(i);
+        }
+        propertiesToEval.swap(notCached);
+        if (propertiesToEval.empty())
+            return S_OK;
+    }
+
+    currentIndex = -1;
+    size_t nextProperty = 0;
+
+    // Note, we use E_ABORT error code as fast way to exit from members walk routine here.
+    if (FAILED(Status = pEvaluator->WalkMembers(pInputValue, pThread, frameLevel, false, [&](
+        ICorDebugType*,
+        bool is_static,
+        const std::string&,
+        Evaluator::GetValueCallback getValue,
+        Evaluator::SetterData*)
+    {
+        bool addMember = fetchOnlyStatic ? is_static : !is_static;
+        if (!addMember)
+            return S_OK;
+
+        ++currentIndex;
+        VariableMember &member = members[propertiesToEval[nextProperty]];
+        if (member.index != currentIndex)
+            return S_OK;
+
+        if (Cancellation::IsRequested())
+            return COR_E_OPERATIONCANCELED;
+
+        int getterEvalFlags = evalFlags;
+        if (evalBudget != 0)
+        {
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(budgetEnd - std::chrono::steady_clock::now()).count();
+            if (left < EVAL_TIMEOUT_UNIT_MS)
+            {
+                for (; nextProperty < propertiesToEval.size(); ++nextProperty)
+                {
+                    members[propertiesToEval[nextProperty]].isDeferred = true;
+                }
+                return E_ABORT;
+            }
+            // Note, per-request eval timeout (if provided) could be less than rest of budget.
+            if (GetEvalFlagsTimeout(evalFlags) == 0 || GetEvalFlagsTimeout(evalFlags) > (unsigned)left)
+                getterEvalFlags = SetEvalFlagsTimeout(evalFlags, (unsigned)left);
+        }
+
+        // Note, in this case error is not fatal, but if protocol side need cancel command execution, stop walk and return error to caller.
+        if (getValue(&member.value, getterEvalFlags) == COR_E_OPERATIONCANCELED)
+            return COR_E_OPERATIONCANCELED;
+
+        if (address != 0 && member.value != nullptr)
+            propertyValuesCache.Add(propertyKey(member.index), member.value);
+
+        ++nextProperty;
+        return nextProperty == propertiesToEval.size() ? E_ABORT : S_OK;
+    })) && Status != E_ABORT)
+    {
+        return Status;
+    }
+
     return S_OK;
 }
 
+void Variables::Clear()
+{
+    {
+        std::lock_guard<Utility::RWLock::Writer> guardGeneration(m_referencesGenerationLock.writer);
+        std::lock_guard<std::mutex> lock(m_referencesMutex);
+
+        // Note, references numbers must fit into int (protocols), start from 1 again after overflow.
+        const uint64_t nextBase = uint64_t(m_referencesBase) + m_references.Size();
+        m_referencesBase = nextBase >= uint64_t(std::numeric_limits<int>::max()) / 2 ? 0 : uint32_t(nextBase);
+        m_references.Reset();
+        m_evaluateNames.Reset();
+    }
+    m_propertyValuesCache.Clear();
+    m_valueChangesTracker.NextStop();
+
+    std::lock_guard<std::mutex> lock(m_completionNamesMutex);
+    m_completionNames.clear();
+}
+
+void Variables::Cleanup()
+{
+    m_watchResultsCache.Clear();
+    m_valueChangesTracker.Clear();
+}
+
+template <class... Args>
+Variables::VariableReference *Variables::NewReference(Args&&... args)
+{
+    if (uint64_t(m_referencesBase) + m_references.Size() >= uint64_t(std::numeric_limits<int>::max()))
+        return nullptr;
+
+    return &m_references.Emplace(std::forward<Args>(args)...);
+}
+
+Variables::VariableReference *Variables::FindReference(uint32_t variablesReference)
+{
+    std::lock_guard<std::mutex> lock(m_referencesMutex);
+
+    if (variablesReference <= m_referencesBase)
+        return nullptr;
+    return m_references.Get(variablesReference - m_referencesBase - 1);
+}
+
 int Variables::GetNamedVariables(uint32_t variablesReference)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
+    std::lock_guard<Utility::RWLock::Reader> guardGeneration(m_referencesGenerationLock.reader);
+    VariableReference *ref = FindReference(variablesReference);
+    return ref ? ref->namedVariables : 0;
+}
+
+// Identify thread's frame at stop: same stack variables could have same data in different methods, but different meaning.
+static HRESULT GetFrameKey(ICorDebugThread *pThread, FrameLevel frameLevel, std::string &key)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugFrame> pFrame;
+    IfFailRet(GetFrameAt(pThread, frameLevel, &pFrame));
+    if (pFrame == nullptr)
+        return E_FAIL;
+
+    mdMethodDef methodDef = mdMethodDefNil;
+    ToRelease<ICorDebugFunction> pFunction;
+    ToRelease<ICorDebugModule> pModule;
+    CORDB_ADDRESS modAddress = 0;
+    IfFailRet(pFrame->GetFunctionToken(&methodDef));
+    IfFailRet(pFrame->GetFunction(&pFunction));
+    IfFailRet(pFunction->GetModule(&pModule));
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+
+    DWORD threadId = 0;
+    IfFailRet(pThread->GetID(&threadId));
 
-    auto it = m_references.find(variablesReference);
-    if (it == m_references.end())
-        return 0;
-    return it->second.namedVariables;
+    key = std::to_string(threadId) + ":" + std::to_string(int(frameLevel)) + ":" +
+          std::to_string(modAddress) + ":" + std::to_string(methodDef);
+    return S_OK;
+}
+
+static HRESULT GetWatchValueData(ICorDebugValue *pValue, std::string &data);
+
+void Variables::TrackValueChange(const std::string &frameKey, ICorDebugValue *pValue, Variable &variable)
+{
+    if (frameKey.empty() || variable.evaluateName.empty())
+        return;
+
+    // Note, values without raw data (value types) are compared by printed value, element type is never 0, so, printed
+    // value data can't be same as raw data.
+    std::string data;
+    if (pValue == nullptr || FAILED(GetWatchValueData(pValue, data)))
+        data = std::string(1, '\0') + variable.value;
+
+    if (m_valueChangesTracker.Update(frameKey + ":" + variable.evaluateName, ValueChangesTracker::Hash(data)))
+        variable.presentationHint.changed = true;
 }
 
 // Caller should guarantee, that pProcess is not null.
@@ -154,53 +519,86 @@ HRESULT Variables::GetVariables(
     int count,
     std::vector<Variable> &variables)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
-
-    auto it = m_references.find(variablesReference);
-    if (it == m_references.end())
+    // Note, generation lock is held till references usage end, references can't be dropped during GetChildren().
+    std::lock_guard<Utility::RWLock::Reader> guardGeneration(m_referencesGenerationLock.reader);
+    VariableReference *pRef = FindReference(variablesReference);
+    if (!pRef)
         return E_FAIL;
 
-    VariableReference &ref = it->second;
+    VariableReference &ref = *pRef;
 
     HRESULT Status;
 
     ToRelease<ICorDebugThread> pThread;
     IfFailRet(pProcess->GetThread(int(ref.frameId.getThread()), &pThread));
 
+    // Note, values changes are not tracked in case frame can't be identified.
+    std::string frameKey;
+    if (FAILED(GetFrameKey(pThread, ref.frameId.getLevel(), frameKey)))
+        frameKey.clear();
+
+    // Note, scope don't have indexed variables and named variables count is not known before enumeration (see GetScopes()).
+    if (ref.IsScope())
+        return filter == VariablesIndexed ? S_OK : GetStackVariables(ref, pThread, frameKey, start, count, variables);
+
     // Named and Indexed variables are in the same index (internally), Named variables go first
     if (filter == VariablesNamed && (start + count > ref.namedVariables || count == 0))
         count = ref.namedVariables - start;
     if (filter == VariablesIndexed)
         start += ref.namedVariables;
 
-    if (ref.IsScope())
+    if (ref.valueKind == ValueIsLazyProperty)
     {
-        IfFailRet(GetStackVariables(ref.frameId, pThread, start, count, variables));
+        IfFailRet(GetLazyProperty(ref, pThread, frameKey, variables));
     }
     else
     {
-        IfFailRet(GetChildren(ref, pThread, start, count, variables));
+        IfFailRet(GetChildren(ref, pThread, frameKey, start, count, variables));
     }
     return S_OK;
 }
 
 HRESULT Variables::AddVariableReference(Variable &variable, FrameId frameId, ICorDebugValue *pValue, ValueKind valueKind)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
-
-    if (m_references.size() == std::numeric_limits<uint32_t>::max())
-        return E_FAIL;
-
+    // Note, children count calculation could be slow, do this without lock.
     int numChild = 0;
     GetNumChild(m_sharedEvaluator.get(), pValue, numChild, valueKind == ValueIsClass);
     if (numChild == 0)
         return S_OK;
 
+    std::lock_guard<std::mutex> lock(m_referencesMutex);
+
     variable.namedVariables = numChild;
-    variable.variablesReference = (uint32_t)m_references.size() + 1;
+    variable.variablesReference = m_referencesBase + (uint32_t)m_references.Size() + 1;
     pValue->AddRef();
-    VariableReference variableReference(variable, frameId, pValue, valueKind);
-    m_references.emplace(std::make_pair(variable.variablesReference, std::move(variableReference)));
+    if (!NewReference(variable, m_evaluateNames.Store(variable.evaluateName), frameId, pValue, valueKind))
+    {
+        pValue->Release();
+        variable.variablesReference = 0;
+        return E_FAIL;
+    }
+
+    return S_OK;
+}
+
+HRESULT Variables::AddLazyPropertyReference(Variable &variable, VariableReference &ownerRef, int memberIndex)
+{
+    std::lock_guard<std::mutex> lock(m_referencesMutex);
+
+    variable.presentationHint.lazy = true;
+    variable.namedVariables = 1;
+    variable.variablesReference = m_referencesBase + (uint32_t)m_references.Size() + 1;
+    ownerRef.iCorValue->AddRef();
+    VariableReference *pRef = NewReference(variable, m_evaluateNames.Store(variable.evaluateName), ownerRef.frameId,
+                                           ownerRef.iCorValue.GetPtr(), ValueIsLazyProperty);
+    if (!pRef)
+    {
+        ownerRef.iCorValue->Release();
+        variable.variablesReference = 0;
+        return E_FAIL;
+    }
+    pRef->lazyMemberIndex = memberIndex;
+    pRef->lazyStaticMember = ownerRef.valueKind == ValueIsClass;
 
     return S_OK;
 }
@@ -223,9 +621,33 @@ HRESULT Variables::GetExceptionVariable(FrameId frameId, ICorDebugThread *pThrea
     return E_FAIL;
 }
 
+HRESULT Variables::FillScopeVars(ScopeVars &scopeVars, ICorDebugThread *pThread, FrameLevel frameLevel)
+{
+    // Note, any func-eval invalidate values.
+    const uint64_t evalsCount = m_sharedEvalHelpers->GetEvalsCount();
+    if (scopeVars.filled && scopeVars.evalsCount == evalsCount)
+        return S_OK;
+
+    scopeVars.vars.clear();
+    HRESULT Status;
+    IfFailRet(m_sharedEvaluator->WalkStackVars(pThread, frameLevel, [&](const std::string &name, Evaluator::GetValueCallback getValue) -> HRESULT
+    {
+        ScopeVar var;
+        var.name = name;
+        var.status = getValue(&var.value, defaultEvalFlags);
+        scopeVars.vars.emplace_back(std::move(var));
+        return S_OK;
+    }));
+
+    scopeVars.filled = true;
+    scopeVars.evalsCount = evalsCount;
+    return S_OK;
+}
+
 HRESULT Variables::GetStackVariables(
-    FrameId frameId,
+    VariableReference &ref,
     ICorDebugThread *pThread,
+    const std::string &frameKey,
     int start,
     int count,
     std::vector<Variable> &variables)
@@ -233,35 +655,50 @@ HRESULT Variables::GetStackVariables(
     HRESULT Status;
     int currentIndex = -1;
     Variable var;
-    if (SUCCEEDED(GetExceptionVariable(frameId, pThread, var)))
+    if (SUCCEEDED(GetExceptionVariable(ref.frameId, pThread, var)))
     {
         variables.push_back(var);
         ++currentIndex;
     }
 
-    if (FAILED(Status = m_sharedEvaluator->WalkStackVars(pThread, frameId.getLevel(),
-        [&](const std::string &name, Evaluator::GetValueCallback getValue) -> HRESULT
+    const bool arrayPreview = m_arrayPreview;
+    ToRelease<ICorDebugProcess> pProcess;
+    if (arrayPreview)
+        pThread->GetProcess(&pProcess);
+
+    // Note, frame is walked once for scope, next requests (for example, paged variables) reuse enumerated values.
+    std::lock_guard<std::mutex> lock(ref.scopeVars->mutex);
+    IfFailRet(FillScopeVars(*ref.scopeVars, pThread, ref.frameId.getLevel()));
+
+    for (size_t i = 0; i < ref.scopeVars->vars.size(); i++)
     {
         ++currentIndex;
 
         if (currentIndex < start)
-            return S_OK;
+            continue;
         if (count != 0 && currentIndex >= start + count)
-            return E_ABORT; // Fast exit from cycle.
+            break;
+
+        if (Cancellation::IsRequested())
+            return COR_E_OPERATIONCANCELED;
+
+        // Note, value printing could run func-eval, that invalidate values of next variables.
+        IfFailRet(FillScopeVars(*ref.scopeVars, pThread, ref.frameId.getLevel()));
+        if (i >= ref.scopeVars->vars.size())
+            break;
+
+        const ScopeVar &scopeVar = ref.scopeVars->vars[i];
+        IfFailRet(scopeVar.status);
 
         Variable var;
-        var.name = name;
+        var.name = scopeVar.name;
         var.evaluateName = var.name;
-        ToRelease<ICorDebugValue> iCorValue;
-        IfFailRet(getValue(&iCorValue, var.evalFlags));
-        IfFailRet(PrintValue(iCorValue, var.value));
+        ICorDebugValue *iCorValue = scopeVar.value.GetPtr();
+        IfFailRet(PrintVariableValue(pProcess, iCorValue, arrayPreview, var.value));
         IfFailRet(TypePrinter::GetTypeOfValue(iCorValue, var.type));
-        IfFailRet(AddVariableReference(var, frameId, iCorValue, ValueIsVariable));
+        IfFailRet(AddVariableReference(var, ref.frameId, iCorValue, ValueIsVariable));
+        TrackValueChange(frameKey, iCorValue, var);
         variables.push_back(var);
-        return S_OK;
-    })) && Status != E_ABORT)
-    {
-        return Status;
     }
 
     return S_OK;
@@ -276,34 +713,90 @@ HRESULT Variables::GetScopes(ICorDebugProcess *pProcess, FrameId frameId, std::v
     HRESULT Status;
     ToRelease<ICorDebugThread> pThread;
     IfFailRet(pProcess->GetThread(int(threadId), &pThread));
-    int namedVariables = 0;
+    ToRelease<ICorDebugFrame> pFrame;
+    IfFailRet(GetFrameAt(pThread, frameId.getLevel(), &pFrame));
+    if (pFrame == nullptr)
+        return E_FAIL;
+
+    // Note, locals (and hoisted locals in display classes) are not enumerated here, since client could never expand
+    // scope, enumeration is deferred till first variables request (see GetStackVariables()).
     uint32_t variablesReference = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_referencesMutex);
 
-    ToRelease<ICorDebugValue> pExceptionValue;
-    if (SUCCEEDED(pThread->GetCurrentException(&pExceptionValue)) && pExceptionValue != nullptr)
-        namedVariables++;
+        variablesReference = m_referencesBase + (uint32_t)m_references.Size() + 1;
+        if (!NewReference(variablesReference, frameId, Scope::DeferredCount))
+            return E_FAIL;
+    }
 
-    IfFailRet(m_sharedEvaluator->WalkStackVars(pThread, frameId.getLevel(),
-        [&](const std::string &name, Evaluator::GetValueCallback) -> HRESULT
-    {
-        namedVariables++;
-        return S_OK;
-    }));
+    scopes.emplace_back(variablesReference, "Locals", Scope::DeferredCount);
 
-    if (namedVariables > 0)
-    {
-        std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
+    return S_OK;
+}
 
-        if (m_references.size() == std::numeric_limits<uint32_t>::max())
-            return E_FAIL;
+HRESULT Variables::GetCompletionNames(ICorDebugProcess *pProcess, FrameId frameId, const std::string &expression,
+                                      std::shared_ptr<const std::vector<std::string>> &names)
+{
+    ThreadId threadId = frameId.getThread();
+    if (!threadId)
+        return E_FAIL;
 
-        variablesReference = (uint32_t)m_references.size() + 1;
-        VariableReference scopeReference(variablesReference, frameId, namedVariables);
-        m_references.emplace(std::make_pair(variablesReference, std::move(scopeReference)));
+    const std::string key = std::to_string(int(threadId)) + ":" + std::to_string(int(frameId.getLevel())) + ":" + expression;
+    {
+        std::lock_guard<std::mutex> lock(m_completionNamesMutex);
+        auto find = m_completionNames.find(key);
+        if (find != m_completionNames.end())
+        {
+            names = find->second;
+            return S_OK;
+        }
     }
 
-    scopes.emplace_back(variablesReference, "Locals", namedVariables);
+    HRESULT Status;
+    ToRelease<ICorDebugThread> pThread;
+    IfFailRet(pProcess->GetThread(int(threadId), &pThread));
+
+    std::shared_ptr<std::vector<std::string>> result(new std::vector<std::string>());
+    if (expression.empty())
+    {
+        ToRelease<ICorDebugValue> pExceptionValue;
+        if (SUCCEEDED(pThread->GetCurrentException(&pExceptionValue)) && pExceptionValue != nullptr)
+            result->emplace_back("$exception");
 
+        // Note, only names are needed, values are not read and printed.
+        IfFailRet(m_sharedEvaluator->WalkStackVars(pThread, frameId.getLevel(),
+            [&](const std::string &name, Evaluator::GetValueCallback) -> HRESULT
+        {
+            result->push_back(name);
+            return S_OK;
+        }));
+    }
+    else
+    {
+        // Note, completion is requested during typing, so, expression evaluation must not change debuggee state.
+        ToRelease<ICorDebugValue> pValue;
+        std::string output;
+        IfFailRet(EvaluateExpression(pThread, frameId.getLevel(), EVAL_NOFUNCEVAL, expression, &pValue, output));
+
+        // Note, members are walked by evaluator's type members cache, values are not read.
+        std::unordered_set<std::string> unique;
+        IfFailRet(m_sharedEvaluator->WalkMembers(pValue, pThread, frameId.getLevel(), false,
+            [&](ICorDebugType*, bool is_static, const std::string &name, Evaluator::GetValueCallback, Evaluator::SetterData*) -> HRESULT
+        {
+            // Static members can't be accessed by instance expression, compiler generated names can't be evaluated.
+            if (is_static || name.empty() || name[0] == '[' || name.find('<') != std::string::npos)
+                return S_OK;
+            if (unique.insert(name).second)
+                result->push_back(name);
+            return S_OK;
+        }));
+    }
+
+    std::lock_guard<std::mutex> lock(m_completionNamesMutex);
+    if (m_completionNames.size() >= MaxCompletionNames)
+        m_completionNames.clear();
+    m_completionNames[key] = result;
+    names = result;
     return S_OK;
 }
 
@@ -323,6 +816,7 @@ static void FixupInheritedFieldNames(std::vector<VariableMember> &members)
 HRESULT Variables::GetChildren(
     VariableReference &ref,
     ICorDebugThread *pThread,
+    const std::string &frameKey,
     int start,
     int count,
     std::vector<Variable> &variables)
@@ -333,13 +827,23 @@ HRESULT Variables::GetChildren(
     if (!ref.iCorValue)
         return S_OK;
 
+    // Note, request could be canceled by protocol side while waiting in queue (for example, user continue execution).
+    if (Cancellation::IsRequested())
+        return COR_E_OPERATIONCANCELED;
+
     HRESULT Status;
     std::vector<VariableMember> members;
     bool hasStaticMembers = false;
 
-    IfFailRet(FetchFieldsAndProperties(m_sharedEvaluator.get(), ref.iCorValue, pThread, ref.frameId.getLevel(),
+    const bool deferProperties = m_deferPropertiesEvaluation;
+    const bool arrayPreview = m_arrayPreview;
+    // Note, process is used for bulk read of array preview elements only.
+    ToRelease<ICorDebugProcess> pProcess;
+    if (arrayPreview)
+        pThread->GetProcess(&pProcess);
+    IfFailRet(FetchFieldsAndProperties(m_sharedEvaluator.get(), m_propertyValuesCache, ref.iCorValue, pThread, ref.frameId.getLevel(),
                                        members, ref.valueKind == ValueIsClass, hasStaticMembers, start,
-                                       count == 0 ? INT_MAX : start + count, ref.evalFlags));
+                                       count == 0 ? INT_MAX : start + count, ref.evalFlags, deferProperties, m_evalBudget));
 
     FixupInheritedFieldNames(members);
 
@@ -349,9 +853,17 @@ HRESULT Variables::GetChildren(
         var.name = it.name;
         bool isIndex = !it.name.empty() && it.name.at(0) == '[';
         if (var.name.find('(') == std::string::npos) // expression evaluator does not support typecasts
-            var.evaluateName = ref.evaluateName + (isIndex ? "" : ".") + var.name;
-        FillValueAndType(it, var);
-        IfFailRet(AddVariableReference(var, ref.frameId, it.value, ValueIsVariable));
+            var.evaluateName = std::string(ref.evaluateName) + (isIndex ? "" : ".") + var.name;
+        if (it.isProperty && (deferProperties || it.isDeferred))
+        {
+            IfFailRet(AddLazyPropertyReference(var, ref, it.index));
+        }
+        else
+        {
+            FillValueAndType(pProcess, it, var, arrayPreview);
+            IfFailRet(AddVariableReference(var, ref.frameId, it.value, ValueIsVariable));
+            TrackValueChange(frameKey, it.value, var);
+        }
         variables.push_back(var);
     }
 
@@ -379,6 +891,311 @@ HRESULT Variables::GetChildren(
     return S_OK;
 }
 
+HRESULT Variables::GetLazyProperty(
+    VariableReference &ref,
+    ICorDebugThread *pThread,
+    const std::string &frameKey,
+    std::vector<Variable> &variables)
+{
+    if (!ref.iCorValue)
+        return E_FAIL;
+
+    HRESULT Status;
+    std::vector<VariableMember> members;
+    bool hasStaticMembers = false;
+
+    IfFailRet(FetchFieldsAndProperties(m_sharedEvaluator.get(), m_propertyValuesCache, ref.iCorValue, pThread, ref.frameId.getLevel(),
+                                       members, ref.lazyStaticMember, hasStaticMembers, ref.lazyMemberIndex,
+                                       ref.lazyMemberIndex + 1, ref.evalFlags, false, 0));
+    if (members.empty())
+        return E_FAIL;
+
+    Variable var(ref.evalFlags);
+    var.name = members[0].name;
+    var.evaluateName = std::string(ref.evaluateName);
+    ToRelease<ICorDebugProcess> pProcess;
+    pThread->GetProcess(&pProcess);
+    FillValueAndType(pProcess, members[0], var, m_arrayPreview);
+    IfFailRet(AddVariableReference(var, ref.frameId, members[0].value, ValueIsVariable));
+    TrackValueChange(frameKey, members[0].value, var);
+    variables.push_back(var);
+
+    return S_OK;
+}
+
+// Raw data of value for watch results dependencies check: element type and value data (object address in case of
+// reference, for byref also data of referenced value, since it could be changed without byref change).
+static HRESULT GetWatchValueData(ICorDebugValue *pValue, std::string &data)
+{
+    HRESULT Status;
+    CorElementType elemType;
+    IfFailRet(pValue->GetType(&elemType));
+    data += char(elemType);
+
+    ToRelease<ICorDebugReferenceValue> pRefValue;
+    if (SUCCEEDED(pValue->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &pRefValue)))
+    {
+        CORDB_ADDRESS address = 0;
+        IfFailRet(pRefValue->GetValue(&address));
+        data.append((const char*)&address, sizeof(address));
+        if (elemType != ELEMENT_TYPE_BYREF || address == 0)
+            return S_OK;
+
+        ToRelease<ICorDebugValue> pDerefValue;
+        IfFailRet(pRefValue->Dereference(&pDerefValue));
+        return GetWatchValueData(pDerefValue, data);
+    }
+
+    ToRelease<ICorDebugGenericValue> pGenericValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &pGenericValue));
+    ULONG32 size = 0;
+    IfFailRet(pValue->GetSize(&size));
+    const size_t offset = data.size();
+    data.resize(offset + size);
+    return pGenericValue->GetValue(&data[offset]);
+}
+
+// Objects with fields read by watch expression are compared by memory content, don't track huge objects.
+static const ULONG32 MaxWatchObjectSize = 64 * 1024;
+
+static HRESULT ReadWatchObjectData(ICorDebugProcess *pProcess, CORDB_ADDRESS address, ULONG32 size, std::string &data)
+{
+    HRESULT Status;
+    data.resize(size);
+    SIZE_T read = 0;
+    IfFailRet(pProcess->ReadMemory(address, size, (BYTE*)&data[0], &read));
+    return read == size ? S_OK : E_FAIL;
+}
+
+// Address and memory of heap object referenced by value. Return S_FALSE in case value is not reference (value type data is
+// part of container or stack variable data) or null reference.
+static HRESULT GetWatchObjectData(ICorDebugProcess *pProcess, ICorDebugValue *pValue, CORDB_ADDRESS &address, std::string &data)
+{
+    HRESULT Status;
+    CorElementType elemType;
+    IfFailRet(pValue->GetType(&elemType));
+    ToRelease<ICorDebugReferenceValue> pRefValue;
+    if (elemType == ELEMENT_TYPE_BYREF ||
+        FAILED(pValue->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &pRefValue)))
+        return S_FALSE;
+
+    BOOL isNull = FALSE;
+    IfFailRet(pRefValue->IsNull(&isNull));
+    if (isNull)
+        return S_FALSE;
+
+    ToRelease<ICorDebugValue> pObjectValue;
+    IfFailRet(pRefValue->Dereference(&pObjectValue));
+    ULONG32 size = 0;
+    IfFailRet(pObjectValue->GetAddress(&address));
+    IfFailRet(pObjectValue->GetSize(&size));
+    if (address == 0 || size == 0 || size > MaxWatchObjectSize)
+        return E_FAIL;
+
+    return ReadWatchObjectData(pProcess, address, size, data);
+}
+
+HRESULT Variables::FillWatchStackVars(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, WatchStackVars &stackVars)
+{
+    // Note, any func-eval invalidate values and could change debuggee state.
+    const uint64_t evalsCount = m_sharedEvalHelpers->GetEvalsCount();
+    if (stackVars.filled && stackVars.evalsCount == evalsCount)
+        return S_OK;
+
+    stackVars.vars.clear();
+    stackVars.filled = true;
+    stackVars.evalsCount = evalsCount;
+
+    // Note, variable, that can't be read, is stored without value (as evaluator, it still shadow `this` members with same name).
+    return m_sharedEvaluator->WalkStackVars(pThread, frameLevel, [&](const std::string &name, Evaluator::GetValueCallback getValue) -> HRESULT
+    {
+        WatchStackVar var;
+        if (FAILED(getValue(&var.value, evalFlags)) || !var.value || FAILED(GetWatchValueData(var.value, var.data)))
+            var.value.Free();
+
+        stackVars.vars.emplace(name, std::move(var));
+        return S_OK;
+    });
+}
+
+// Return S_FALSE in case expression is not pure (see WatchResultsCache) and result can't be cached.
+HRESULT Variables::GetWatchResultKey(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, const std::string &expression,
+                                     std::string &key)
+{
+    if (!m_conditionPredicatesCache.GetPredicate(expression))
+        return S_FALSE;
+
+    HRESULT Status;
+    std::string frameKey;
+    IfFailRet(GetFrameKey(pThread, frameLevel, frameKey));
+
+    key = frameKey + ":" + std::to_string(evalFlags) + ":" + expression;
+    return S_OK;
+}
+
+HRESULT Variables::FindWatchResult(ICorDebugProcess *pProcess, ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags,
+                                   const std::string &key, WatchStackVars &stackVars, Variable &variable)
+{
+    HRESULT Status;
+    IfFailRet(FillWatchStackVars(pThread, frameLevel, evalFlags, stackVars));
+
+    WatchResultsCache::Result result;
+    if (!m_watchResultsCache.Find(key, [&](const WatchResultsCache::Dependency &dependency, std::string &data) -> bool
+    {
+        switch (dependency.kind)
+        {
+            case WatchResultsCache::Dependency::Kind::StackVariable:
+            {
+                auto find = stackVars.vars.find(dependency.name);
+                if (find == stackVars.vars.end() || !find->second.value)
+                    return false;
+                data = find->second.data;
+                return true;
+            }
+            case WatchResultsCache::Dependency::Kind::ThisMember:
+                return stackVars.vars.find(dependency.name) == stackVars.vars.end();
+            case WatchResultsCache::Dependency::Kind::Object:
+                return SUCCEEDED(ReadWatchObjectData(pProcess, dependency.address, ULONG32(dependency.data.size()), data));
+        }
+        return false;
+    }, result))
+        return S_FALSE;
+
+    variable.value = std::move(result.value);
+    variable.type = std::move(result.type);
+    variable.editable = result.editable;
+    variable.variablesReference = 0;
+    return S_OK;
+}
+
+// Collect dependencies of identifiers chain. Only stack variables and instance fields are tracked, return S_FALSE in case
+// chain resolved in any other way (static members, properties, intrinsics, etc.).
+HRESULT Variables::AddWatchDependencies(ICorDebugProcess *pProcess, ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags,
+                                        const std::vector<std::string> &identifiers, WatchStackVars &stackVars,
+                                        std::vector<WatchResultsCache::Dependency> &dependencies)
+{
+    typedef WatchResultsCache::Dependency Dependency;
+
+    HRESULT Status;
+    ToRelease<ICorDebugValue> iCorValue;
+    size_t nextIdentifier = 0;
+    auto find = stackVars.vars.find(identifiers[0]);
+    if (find != stackVars.vars.end())
+    {
+        nextIdentifier = 1;
+    }
+    else
+    {
+        find = stackVars.vars.find("this");
+        if (find == stackVars.vars.end())
+            return S_FALSE;
+        dependencies.emplace_back(Dependency::Kind::ThisMember, identifiers[0], 0, std::string());
+    }
+    if (!find->second.value)
+        return S_FALSE;
+
+    dependencies.emplace_back(Dependency::Kind::StackVariable, find->first, 0, std::string(find->second.data));
+    find->second.value->AddRef();
+    iCorValue = find->second.value.GetPtr();
+
+    for (; nextIdentifier < identifiers.size(); nextIdentifier++)
+    {
+        CORDB_ADDRESS address = 0;
+        std::string data;
+        IfFailRet(Status = GetWatchObjectData(pProcess, iCorValue, address, data));
+        if (Status == S_OK)
+            dependencies.emplace_back(Dependency::Kind::Object, std::string(), address, std::move(data));
+
+        // Note, setter data provided for properties only, so, fields could be detected in this way. Same as evaluator does,
+        // first member with this name is used.
+        bool found = false;
+        ToRelease<ICorDebugValue> iCorMemberValue;
+        m_sharedEvaluator->WalkMembers(iCorValue, pThread, frameLevel, true, [&](ICorDebugType*, bool is_static, const std::string &memberName,
+                                                                                Evaluator::GetValueCallback getValue, Evaluator::SetterData *setterData) -> HRESULT
+        {
+            if (is_static || memberName != identifiers[nextIdentifier])
+                return S_OK;
+
+            found = true;
+            if (!setterData)
+                IfFailRet(getValue(&iCorMemberValue, evalFlags));
+
+            return E_ABORT; // Fast exit from cycle.
+        });
+
+        if (!found || !iCorMemberValue)
+            return S_FALSE;
+
+        iCorValue = iCorMemberValue.Detach();
+    }
+
+    return S_OK;
+}
+
+HRESULT Variables::AddWatchResult(ICorDebugProcess *pProcess, ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags,
+                                  const std::string &key, const std::string &expression, WatchStackVars &stackVars, const Variable &variable)
+{
+    ConditionPredicatesCache::predicate_t predicate = m_conditionPredicatesCache.GetPredicate(expression);
+    if (!predicate)
+        return S_FALSE;
+
+    HRESULT Status;
+    IfFailRet(FillWatchStackVars(pThread, frameLevel, evalFlags, stackVars));
+
+    std::vector<WatchResultsCache::Dependency> dependencies;
+    for (const auto &comparison : predicate->GetComparisons())
+    {
+        if (!comparison.left.IsLiteral() &&
+            (Status = AddWatchDependencies(pProcess, pThread, frameLevel, evalFlags, comparison.left.identifiers, stackVars, dependencies)) != S_OK)
+            return Status;
+        if (comparison.operation != ConditionPredicate::Operation::None && !comparison.right.IsLiteral() &&
+            (Status = AddWatchDependencies(pProcess, pThread, frameLevel, evalFlags, comparison.right.identifiers, stackVars, dependencies)) != S_OK)
+            return Status;
+    }
+
+    WatchResultsCache::Result result;
+    result.value = variable.value;
+    result.type = variable.type;
+    result.editable = variable.editable;
+    m_watchResultsCache.Add(key, std::move(dependencies), result);
+    return S_OK;
+}
+
+HRESULT Variables::EvaluateVariable(
+    ICorDebugProcess *pProcess,
+    ICorDebugThread *pThread,
+    FrameId frameId,
+    const std::string &expression,
+    bool arrayPreview,
+    WatchStackVars &stackVars,
+    Variable &variable,
+    std::string &output)
+{
+    HRESULT Status;
+    FrameLevel frameLevel = frameId.getLevel();
+    variable.evaluateName = expression;
+
+    std::string watchKey;
+    if (GetWatchResultKey(pThread, frameLevel, variable.evalFlags, expression, watchKey) != S_OK)
+        watchKey.clear();
+    else if (FindWatchResult(pProcess, pThread, frameLevel, variable.evalFlags, watchKey, stackVars, variable) == S_OK)
+        return S_OK;
+
+    const uint64_t evalsCount = m_sharedEvalHelpers->GetEvalsCount();
+    ToRelease<ICorDebugValue> pResultValue;
+    IfFailRet(EvaluateExpression(pThread, frameLevel, variable.evalFlags, expression, &pResultValue, output, &variable.editable));
+
+    IfFailRet(PrintVariableValue(pProcess, pResultValue, arrayPreview, variable.value));
+    IfFailRet(TypePrinter::GetTypeOfValue(pResultValue, variable.type));
+    IfFailRet(AddVariableReference(variable, frameId, pResultValue, ValueIsVariable));
+
+    // Note, result with children can't be cached, since variable reference is valid during current stop only.
+    if (!watchKey.empty() && variable.variablesReference == 0 && evalsCount == m_sharedEvalHelpers->GetEvalsCount())
+        AddWatchResult(pProcess, pThread, frameLevel, variable.evalFlags, watchKey, expression, stackVars, variable);
+
+    return S_OK;
+}
+
 HRESULT Variables::Evaluate(
     ICorDebugProcess *pProcess,
     FrameId frameId,
@@ -394,14 +1211,327 @@ HRESULT Variables::Evaluate(
     ToRelease<ICorDebugThread> pThread;
     IfFailRet(pProcess->GetThread(int(threadId), &pThread));
 
+    WatchStackVars stackVars;
+    return EvaluateVariable(pProcess, pThread, frameId, expression, m_arrayPreview, stackVars, variable, output);
+}
+
+HRESULT Variables::EvaluateBatch(
+    ICorDebugProcess *pProcess,
+    FrameId frameId,
+    const std::vector<std::string> &expressions,
+    std::vector<Variable> &variables,
+    std::vector<HRESULT> &statuses,
+    std::vector<std::string> &outputs)
+{
+    if (variables.size() != expressions.size())
+        return E_INVALIDARG;
+
+    ThreadId threadId = frameId.getThread();
+    if (!threadId)
+        return E_FAIL;
+
+    HRESULT Status;
+    ToRelease<ICorDebugThread> pThread;
+    IfFailRet(pProcess->GetThread(int(threadId), &pThread));
+
+    statuses.assign(expressions.size(), S_OK);
+    outputs.assign(expressions.size(), std::string());
+    if (expressions.empty())
+        return S_OK;
+
+    const int batchEvalFlags = variables[0].evalFlags;
+    const bool arrayPreview = m_arrayPreview;
+    // Note, stack variables data for watch results check is collected once for all expressions.
+    WatchStackVars stackVars;
+    m_sharedEvalStackMachine->BeginBatch();
+
+    for (size_t i = 0; i < expressions.size(); i++)
+    {
+        Variable &variable = variables[i];
+        // Resolved values can't be shared for different evalFlags (for example, with and without implicit func-eval).
+        if (variable.evalFlags != batchEvalFlags)
+            continue;
+
+        if (Cancellation::IsRequested())
+        {
+            statuses[i] = COR_E_OPERATIONCANCELED;
+            continue;
+        }
+
+        statuses[i] = EvaluateVariable(pProcess, pThread, frameId, expressions[i], arrayPreview, stackVars, variable, outputs[i]);
+    }
+
+    m_sharedEvalStackMachine->EndBatch();
+
+    for (size_t i = 0; i < expressions.size(); i++)
+    {
+        if (variables[i].evalFlags != batchEvalFlags)
+            statuses[i] = Evaluate(pProcess, frameId, expressions[i], variables[i], outputs[i]);
+    }
+
+    return S_OK;
+}
+
+HRESULT Variables::ReadString(
+    ICorDebugProcess *pProcess,
+    FrameId frameId,
+    const std::string &expression,
+    int evalFlags,
+    uint32_t offset,
+    uint32_t count,
+    std::string &value,
+    uint32_t &read,
+    uint32_t &length)
+{
+    ThreadId threadId = frameId.getThread();
+    if (!threadId)
+        return E_FAIL;
+
+    HRESULT Status;
+    ToRelease<ICorDebugThread> pThread;
+    IfFailRet(pProcess->GetThread(int(threadId), &pThread));
+
     ToRelease<ICorDebugValue> pResultValue;
-    FrameLevel frameLevel = frameId.getLevel();
-    IfFailRet(m_sharedEvalStackMachine->EvaluateExpression(pThread, frameLevel, variable.evalFlags, expression, &pResultValue, output, &variable.editable));
+    std::string output;
+    IfFailRet(EvaluateExpression(pThread, frameId.getLevel(), evalFlags, expression, &pResultValue, output));
+
+    BOOL isNull = TRUE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pResultValue, &pValue, &isNull));
+    CorElementType corElemType;
+    if (isNull || FAILED(pValue->GetType(&corElemType)) || corElemType != ELEMENT_TYPE_STRING)
+        return E_INVALIDARG;
 
-    variable.evaluateName = expression;
-    IfFailRet(PrintValue(pResultValue, variable.value));
-    IfFailRet(TypePrinter::GetTypeOfValue(pResultValue, variable.type));
-    return AddVariableReference(variable, frameId, pResultValue, ValueIsVariable);
+    ULONG32 cRead;
+    ULONG32 cLength;
+    IfFailRet(ReadStringValue(pProcess, pValue, offset, count, value, cRead, cLength));
+    read = cRead;
+    length = cLength;
+    return S_OK;
+}
+
+HRESULT Variables::GetObjectAddress(
+    ICorDebugProcess *pProcess,
+    FrameId frameId,
+    const std::string &expression,
+    int evalFlags,
+    uint64_t &address)
+{
+    ThreadId threadId = frameId.getThread();
+    if (!threadId)
+        return E_FAIL;
+
+    HRESULT Status;
+    ToRelease<ICorDebugThread> pThread;
+    IfFailRet(pProcess->GetThread(int(threadId), &pThread));
+
+    ToRelease<ICorDebugValue> pResultValue;
+    std::string output;
+    IfFailRet(EvaluateExpression(pThread, frameId.getLevel(), evalFlags, expression, &pResultValue, output));
+
+    CorElementType corType;
+    IfFailRet(pResultValue->GetType(&corType));
+    if (corType == ELEMENT_TYPE_BYREF)
+    {
+        ToRelease<ICorDebugReferenceValue> pByRefValue;
+        IfFailRet(pResultValue->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &pByRefValue));
+        pResultValue.Free();
+        IfFailRet(pByRefValue->Dereference(&pResultValue));
+    }
+
+    // Note, only reference type values (and boxed values) are objects in managed heap.
+    ToRelease<ICorDebugReferenceValue> pRefValue;
+    if (FAILED(pResultValue->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &pRefValue)))
+        return E_INVALIDARG;
+
+    BOOL isNull = TRUE;
+    IfFailRet(pRefValue->IsNull(&isNull));
+    if (isNull)
+        return E_INVALIDARG;
+
+    CORDB_ADDRESS objectAddress = 0;
+    IfFailRet(pRefValue->GetValue(&objectAddress));
+    address = objectAddress;
+    return S_OK;
+}
+
+HRESULT Variables::EvaluateAndPrint(
+    ICorDebugThread *pThread,
+    FrameLevel frameLevel,
+    const std::string &expression,
+    std::string &value,
+    std::string &output)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> pResultValue;
+    IfFailRet(EvaluateExpression(pThread, frameLevel, defaultEvalFlags, expression, &pResultValue, output));
+    return PrintValue(pResultValue, value);
+}
+
+HRESULT Variables::EvaluateExpression(
+    ICorDebugThread *pThread,
+    FrameLevel frameLevel,
+    int evalFlags,
+    const std::string &expression,
+    ICorDebugValue **ppResultValue,
+    std::string &output,
+    bool *editable)
+{
+    const uint64_t evalsCount = m_sharedEvalHelpers->GetEvalsCount();
+    HRESULT Status = m_sharedEvalStackMachine->EvaluateExpression(pThread, frameLevel, evalFlags, expression, ppResultValue, output, editable);
+    if (evalsCount != m_sharedEvalHelpers->GetEvalsCount())
+        m_propertyValuesCache.Clear();
+    return Status;
+}
+
+template <class T>
+static T ReadGenericValue(const uint8_t *buffer)
+{
+    T data;
+    memcpy(&data, buffer, sizeof(T));
+    return data;
+}
+
+// Read value, that could be used by ConditionPredicate. Return S_FALSE in case value can't be used.
+static HRESULT GetConditionValue(ICorDebugValue *pInputValue, ConditionPredicate::value_t &value)
+{
+    HRESULT Status;
+    pInputValue->AddRef();
+    ToRelease<ICorDebugValue> pValue(pInputValue);
+    CorElementType corType;
+    IfFailRet(pValue->GetType(&corType));
+
+    if (corType == ELEMENT_TYPE_BYREF)
+    {
+        ToRelease<ICorDebugReferenceValue> pRefValue;
+        IfFailRet(pValue->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &pRefValue));
+        pValue.Free();
+        IfFailRet(pRefValue->Dereference(&pValue));
+        IfFailRet(pValue->GetType(&corType));
+    }
+
+    switch (corType)
+    {
+        case ELEMENT_TYPE_CLASS:
+        case ELEMENT_TYPE_OBJECT:
+        case ELEMENT_TYPE_STRING:
+        case ELEMENT_TYPE_SZARRAY:
+        case ELEMENT_TYPE_ARRAY:
+        {
+            ToRelease<ICorDebugReferenceValue> pRefValue;
+            IfFailRet(pValue->QueryInterface(IID_ICorDebugReferenceValue, (LPVOID*) &pRefValue));
+            BOOL isNull = FALSE;
+            IfFailRet(pRefValue->IsNull(&isNull));
+            value = ConditionPredicate::value_t::Reference(isNull == TRUE);
+            return S_OK;
+        }
+        case ELEMENT_TYPE_BOOLEAN:
+        case ELEMENT_TYPE_CHAR:
+        case ELEMENT_TYPE_I1:
+        case ELEMENT_TYPE_U1:
+        case ELEMENT_TYPE_I2:
+        case ELEMENT_TYPE_U2:
+        case ELEMENT_TYPE_I4:
+        case ELEMENT_TYPE_U4:
+        case ELEMENT_TYPE_I8:
+        case ELEMENT_TYPE_U8:
+        case ELEMENT_TYPE_I:
+        case ELEMENT_TYPE_U:
+        case ELEMENT_TYPE_R4:
+        case ELEMENT_TYPE_R8:
+            break;
+        default:
+            return S_FALSE;
+    }
+
+    ToRelease<ICorDebugGenericValue> pGenericValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &pGenericValue));
+    ULONG32 cbSize = 0;
+    IfFailRet(pValue->GetSize(&cbSize));
+    uint8_t buffer[sizeof(uint64_t)] = {0};
+    if (cbSize > sizeof(buffer))
+        return S_FALSE;
+    IfFailRet(pGenericValue->GetValue(buffer));
+
+    switch (corType)
+    {
+        case ELEMENT_TYPE_BOOLEAN: value = ConditionPredicate::value_t::Bool(ReadGenericValue<uint8_t>(buffer) != 0); break;
+        case ELEMENT_TYPE_CHAR:    value = ConditionPredicate::value_t::Unsigned(ReadGenericValue<uint16_t>(buffer)); break;
+        case ELEMENT_TYPE_I1:      value = ConditionPredicate::value_t::Signed(ReadGenericValue<int8_t>(buffer)); break;
+        case ELEMENT_TYPE_U1:      value = ConditionPredicate::value_t::Unsigned(ReadGenericValue<uint8_t>(buffer)); break;
+        case ELEMENT_TYPE_I2:      value = ConditionPredicate::value_t::Signed(ReadGenericValue<int16_t>(buffer)); break;
+        case ELEMENT_TYPE_U2:      value = ConditionPredicate::value_t::Unsigned(ReadGenericValue<uint16_t>(buffer)); break;
+        case ELEMENT_TYPE_I4:      value = ConditionPredicate::value_t::Signed(ReadGenericValue<int32_t>(buffer)); break;
+        case ELEMENT_TYPE_U4:      value = ConditionPredicate::value_t::Unsigned(ReadGenericValue<uint32_t>(buffer)); break;
+        case ELEMENT_TYPE_I8:      value = ConditionPredicate::value_t::Signed(ReadGenericValue<int64_t>(buffer)); break;
+        case ELEMENT_TYPE_U8:      value = ConditionPredicate::value_t::Unsigned(ReadGenericValue<uint64_t>(buffer)); break;
+        case ELEMENT_TYPE_R4:      value = ConditionPredicate::value_t::Real(ReadGenericValue<float>(buffer)); break;
+        case ELEMENT_TYPE_R8:      value = ConditionPredicate::value_t::Real(ReadGenericValue<double>(buffer)); break;
+        case ELEMENT_TYPE_I:
+            value = ConditionPredicate::value_t::Signed(cbSize == sizeof(int32_t) ? ReadGenericValue<int32_t>(buffer) : ReadGenericValue<int64_t>(buffer));
+            break;
+        case ELEMENT_TYPE_U:
+            value = ConditionPredicate::value_t::Unsigned(cbSize == sizeof(uint32_t) ? ReadGenericValue<uint32_t>(buffer) : ReadGenericValue<uint64_t>(buffer));
+            break;
+        default:
+            return S_FALSE;
+    }
+
+    return S_OK;
+}
+
+HRESULT Variables::GetConditionOperandValue(
+    ICorDebugThread *pThread,
+    FrameLevel frameLevel,
+    const ConditionPredicate::operand_t &operand,
+    ConditionPredicate::value_t &value)
+{
+    if (operand.IsLiteral())
+    {
+        value = operand.literal;
+        return S_OK;
+    }
+
+    // Note, EVAL_NOFUNCEVAL here, since properties getters (and any other code execution) must be processed by stack machine.
+    std::vector<std::string> identifiers(operand.identifiers);
+    ToRelease<ICorDebugValue> pResultValue;
+    if (FAILED(m_sharedEvaluator->ResolveIdentifiers(pThread, frameLevel, nullptr, nullptr, identifiers, &pResultValue, nullptr, nullptr, EVAL_NOFUNCEVAL)) ||
+        !pResultValue)
+        return S_FALSE;
+
+    return GetConditionValue(pResultValue, value);
+}
+
+HRESULT Variables::EvaluateTrivialCondition(
+    ICorDebugThread *pThread,
+    FrameLevel frameLevel,
+    const std::string &condition,
+    bool &result)
+{
+    ConditionPredicatesCache::predicate_t predicate = m_conditionPredicatesCache.GetPredicate(condition);
+    if (!predicate)
+        return S_FALSE;
+
+    HRESULT Status;
+    // Note, operands are read only for calculated comparisons (short-circuit), since next comparisons could depend on
+    // previous (for example, `obj != null && obj.field > 0`).
+    for (const auto &comparison : predicate->GetComparisons())
+    {
+        ConditionPredicate::value_t left;
+        ConditionPredicate::value_t right;
+        if ((Status = GetConditionOperandValue(pThread, frameLevel, comparison.left, left)) != S_OK)
+            return Status;
+        if (comparison.operation != ConditionPredicate::Operation::None &&
+            (Status = GetConditionOperandValue(pThread, frameLevel, comparison.right, right)) != S_OK)
+            return Status;
+
+        if (!ConditionPredicate::Calculate(comparison, left, right, result))
+            return S_FALSE;
+        if (predicate->IsFinalResult(result))
+            break;
+    }
+
+    return S_OK;
 }
 
 HRESULT Variables::SetVariable(
@@ -411,15 +1541,17 @@ HRESULT Variables::SetVariable(
     uint32_t ref,
     std::string &output)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
-
-    auto it = m_references.find(ref);
-    if (it == m_references.end())
+    std::lock_guard<Utility::RWLock::Reader> guardGeneration(m_referencesGenerationLock.reader);
+    VariableReference *pRef = FindReference(ref);
+    if (!pRef)
         return E_FAIL;
 
-    VariableReference &varRef = it->second;
+    VariableReference &varRef = *pRef;
     HRESULT Status;
 
+    // Note, debuggee state will be changed, cached properties values can't be used anymore.
+    m_propertyValuesCache.Clear();
+
     ToRelease<ICorDebugThread> pThread;
     IfFailRet(pProcess->GetThread(int(varRef.frameId.getThread()), &pThread));
 
@@ -435,6 +1567,68 @@ HRESULT Variables::SetVariable(
     return S_OK;
 }
 
+HRESULT Variables::GetFieldLocation(
+    ICorDebugProcess *pProcess,
+    uint32_t ref,
+    const std::string &name,
+    ICorDebugValue **ppObjectValue,
+    CORDB_ADDRESS &fieldAddress,
+    ULONG32 &fieldSize)
+{
+    std::lock_guard<Utility::RWLock::Reader> guardGeneration(m_referencesGenerationLock.reader);
+    VariableReference *pRef = FindReference(ref);
+    if (!pRef)
+        return E_FAIL;
+
+    VariableReference &varRef = *pRef;
+    if (varRef.IsScope() || !varRef.iCorValue)
+        return S_FALSE;
+
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> iCorObjectValue;
+    IfFailRet(DereferenceAndUnboxValue(varRef.iCorValue, &iCorObjectValue, &isNull));
+    CorElementType corType;
+    IfFailRet(iCorObjectValue->GetType(&corType));
+    // Note, value type instance (for example, local variable) is not heap object and can't be tracked by handle.
+    if (isNull || corType != ELEMENT_TYPE_CLASS)
+        return S_FALSE;
+
+    ToRelease<ICorDebugThread> pThread;
+    IfFailRet(pProcess->GetThread(int(varRef.frameId.getThread()), &pThread));
+
+    ToRelease<ICorDebugValue> iCorFieldValue;
+    if (FAILED(Status = m_sharedEvaluator->WalkMembers(varRef.iCorValue, pThread, varRef.frameId.getLevel(), true, [&](
+        ICorDebugType*,
+        bool is_static,
+        const std::string &memberName,
+        Evaluator::GetValueCallback getValue,
+        Evaluator::SetterData *setterData) -> HRESULT
+    {
+        if (memberName != name)
+            return S_OK;
+
+        // Note, auto-property value is backing field value, other properties values are not stored in object.
+        if (!is_static && (!setterData || setterData->autoProperty))
+            getValue(&iCorFieldValue, varRef.evalFlags | EVAL_NOFUNCEVAL);
+        return E_ABORT; // Fast exit from cycle.
+    })) && Status != E_ABORT)
+    {
+        return Status;
+    }
+
+    if (!iCorFieldValue)
+        return S_FALSE;
+
+    // Note, field could be reference, but reference itself (not referenced object) is watched in this case.
+    if (FAILED(iCorFieldValue->GetAddress(&fieldAddress)) || fieldAddress == 0 ||
+        FAILED(iCorFieldValue->GetSize(&fieldSize)))
+        return S_FALSE;
+
+    *ppObjectValue = iCorObjectValue.Detach();
+    return S_OK;
+}
+
 HRESULT Variables::SetStackVariable(
     VariableReference &ref,
     ICorDebugThread *pThread,
@@ -526,6 +1720,7 @@ HRESULT Variables::SetExpression(ICorDebugProcess *pProcess, FrameId frameId, co
         return E_INVALIDARG;
     }
 
+    m_propertyValuesCache.Clear();
     IfFailRet(m_sharedEvaluator->SetValue(pThread, frameId.getLevel(), iCorValue, setterData.get(), value, evalFlags, output));
     IfFailRet(PrintValue(iCorValue, output));
     return S_OK;
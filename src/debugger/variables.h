@@ -7,8 +7,17 @@
 #include "cordebug.h"
 
 #include <mutex>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <tuple>
 #include <unordered_map>
 #include "interfaces/types.h"
+#include "debugger/conditionpredicate.h"
+#include "debugger/watchcache.h"
+#include "utils/arena.h"
+#include "utils/rwlock.h"
+#include "utils/string_view.h"
 #include "utils/torelease.h"
 
 namespace netcoredbg
@@ -19,6 +28,28 @@ class EvalHelpers;
 class EvalWaiter;
 class EvalStackMachine;
 
+// Cache of properties getters results during break, aimed to avoid repeated func-evals for same object (for example, object
+// shown in both locals and watch, or collapsed and expanded again). Note, cached values must not be used after debuggee state
+// changed, so, cache must be cleared at continue/step, variable set and after evaluation, that run any func-eval.
+class PropertyValuesCache
+{
+public:
+
+    // Object address, object type, property index in members walk, static property, eval flags.
+    typedef std::tuple<CORDB_ADDRESS, std::string, int, bool, int> key_t;
+
+    static const size_t MaxValues = 1024;
+
+    bool Find(const key_t &key, ICorDebugValue **ppValue);
+    void Add(const key_t &key, ICorDebugValue *pValue);
+    void Clear();
+
+private:
+
+    std::mutex m_mutex;
+    std::map<key_t, ToRelease<ICorDebugValue>> m_values;
+};
+
 class Variables
 {
 public:
@@ -28,9 +59,27 @@ public:
               std::shared_ptr<EvalStackMachine> &sharedEvalStackMachine) :
         m_sharedEvalHelpers(sharedEvalHelpers),
         m_sharedEvaluator(sharedEvaluator),
-        m_sharedEvalStackMachine(sharedEvalStackMachine)
+        m_sharedEvalStackMachine(sharedEvalStackMachine),
+        m_referencesBase(0),
+        m_deferPropertiesEvaluation(false),
+        m_arrayPreview(false),
+        m_evalBudget(0)
     {}
 
+    // In case enabled, properties getters are not evaluated during children fetch, but provided as lazy variables
+    // (with variable reference to single child with property value, that evaluated at request).
+    bool IsDeferPropertiesEvaluation() const { return m_deferPropertiesEvaluation; }
+    void SetDeferPropertiesEvaluation(bool enable) { m_deferPropertiesEvaluation = enable; }
+
+    // In case enabled, values of one-dimensional arrays of primitive types include first elements (see PrintArrayPreview()).
+    bool IsArrayPreview() const { return m_arrayPreview; }
+    void SetArrayPreview(bool enable) { m_arrayPreview = enable; }
+
+    // Time budget (in milliseconds) for properties getters evaluation during one children fetch, 0 - no limit. Properties,
+    // that left after budget was used up, are provided as lazy variables (same as with deferred properties evaluation).
+    unsigned GetEvalBudget() const { return m_evalBudget; }
+    void SetEvalBudget(unsigned budget) { m_evalBudget = budget; }
+
     int GetNamedVariables(uint32_t variablesReference);
 
     HRESULT GetVariables(
@@ -48,6 +97,16 @@ public:
         uint32_t ref,
         std::string &output);
 
+    // Find instance field `name` of object provided by `ref`, `ppObjectValue` is dereferenced object (heap value).
+    // Return S_FALSE in case member is not instance field (property, static field, etc.) or owner is not heap object.
+    HRESULT GetFieldLocation(
+        ICorDebugProcess *pProcess,
+        uint32_t ref,
+        const std::string &name,
+        ICorDebugValue **ppObjectValue,
+        CORDB_ADDRESS &fieldAddress,
+        ULONG32 &fieldSize);
+
     HRESULT SetExpression(
         ICorDebugProcess *pProcess,
         FrameId frameId,
@@ -61,6 +120,14 @@ public:
         FrameId frameId,
         std::vector<Scope> &scopes);
 
+    // Names for completion (see IDebugger::FindVariables()): frame's stack variables in case `expression` is empty,
+    // otherwise instance members of expression value (evaluated without func-eval). Names are cached till Clear().
+    HRESULT GetCompletionNames(
+        ICorDebugProcess *pProcess,
+        FrameId frameId,
+        const std::string &expression,
+        std::shared_ptr<const std::vector<std::string>> &names);
+
     HRESULT Evaluate(
         ICorDebugProcess *pProcess,
         FrameId frameId,
@@ -68,17 +135,62 @@ public:
         Variable &variable,
         std::string &output);
 
+    // Evaluate expressions in same frame, resolved identifiers prefixes are shared between expressions.
+    // Note, `variables` must have same size as `expressions` (evalFlags of each variable are used for evaluation, expressions
+    // with evalFlags that differ from first variable are evaluated separately), each expression have own status and output.
+    HRESULT EvaluateBatch(
+        ICorDebugProcess *pProcess,
+        FrameId frameId,
+        const std::vector<std::string> &expressions,
+        std::vector<Variable> &variables,
+        std::vector<HRESULT> &statuses,
+        std::vector<std::string> &outputs);
+
+    // Read part of string value of expression (offset and count in UTF-16 code units), see ReadStringValue().
+    HRESULT ReadString(
+        ICorDebugProcess *pProcess,
+        FrameId frameId,
+        const std::string &expression,
+        int evalFlags,
+        uint32_t offset,
+        uint32_t count,
+        std::string &value,
+        uint32_t &read,
+        uint32_t &length);
+
+    // Managed heap address of object, provided by expression (reference type or boxed value only).
+    HRESULT GetObjectAddress(
+        ICorDebugProcess *pProcess,
+        FrameId frameId,
+        const std::string &expression,
+        int evalFlags,
+        uint64_t &address);
+
+    // Evaluate expression and print result value, no variable reference created for result (for example, for log points).
+    HRESULT EvaluateAndPrint(
+        ICorDebugThread *pThread,
+        FrameLevel frameLevel,
+        const std::string &expression,
+        std::string &value,
+        std::string &output);
+
+    // Calculate trivial condition natively without stack machine usage (see ConditionPredicate for supported conditions).
+    // Return S_FALSE in case condition can't be calculated in this way and must be evaluated by stack machine.
+    HRESULT EvaluateTrivialCondition(
+        ICorDebugThread *pThread,
+        FrameLevel frameLevel,
+        const std::string &condition,
+        bool &result);
+
     HRESULT GetExceptionVariable(
         FrameId frameId,
         ICorDebugThread *pThread,
         Variable &variable);
 
-    void Clear()
-    {
-        m_referencesMutex.lock();
-        m_references.clear();
-        m_referencesMutex.unlock();
-    }
+    // Drop all variables references of current stop (generation), must be called at continue/step.
+    void Clear();
+    // Drop data that persist between stops (watch expressions results), must be called at debug session end.
+    void Cleanup();
 
 private:
 
@@ -86,7 +198,23 @@ private:
     {
         ValueIsScope,
         ValueIsClass,
-        ValueIsVariable
+        ValueIsVariable,
+        ValueIsLazyProperty
+    };
+
+    // Stack variables of scope, enumerated on first scope variables request and reused by next requests.
+    struct ScopeVar
+    {
+        std::string name;
+        HRESULT status;
+        ToRelease<ICorDebugValue> value; // nullptr in case variable value can't be read
+    };
+    struct ScopeVars
+    {
+        std::mutex mutex;
+        bool filled = false;
+        uint64_t evalsCount = 0;
+        std::vector<ScopeVar> vars;
     };
 
     struct VariableReference
@@ -96,21 +224,31 @@ private:
         int indexedVariables;
         int evalFlags;
 
-        std::string evaluateName;
+        Utility::string_view evaluateName; // stored in m_evaluateNames
 
         ValueKind valueKind;
-        ToRelease<ICorDebugValue> iCorValue;
+        ToRelease<ICorDebugValue> iCorValue; // in case of ValueIsLazyProperty - property owner object
         FrameId frameId;
 
-        VariableReference(const Variable &variable, FrameId frameId, ICorDebugValue *pValue, ValueKind valueKind) :
+        // ValueIsLazyProperty only, property index in owner's children and owner's kind.
+        int lazyMemberIndex;
+        bool lazyStaticMember;
+
+        // ValueIsScope only.
+        std::unique_ptr<ScopeVars> scopeVars;
+
+        VariableReference(const Variable &variable, Utility::string_view evaluateName, FrameId frameId, ICorDebugValue *pValue,
+                          ValueKind valueKind) :
             variablesReference(variable.variablesReference),
             namedVariables(variable.namedVariables),
             indexedVariables(variable.indexedVariables),
             evalFlags(variable.evalFlags),
-            evaluateName(variable.evaluateName),
+            evaluateName(evaluateName),
             valueKind(valueKind),
             iCorValue(pValue),
-            frameId(frameId)
+            frameId(frameId),
+            lazyMemberIndex(-1),
+            lazyStaticMember(false)
         {}
 
         VariableReference(uint32_t variablesReference, FrameId frameId, int namedVariables) :
@@ -120,7 +258,10 @@ private:
             evalFlags(0), // unused in this case, not involved into GetScopes routine
             valueKind(ValueIsScope),
             iCorValue(nullptr),
-            frameId(frameId)
+            frameId(frameId),
+            lazyMemberIndex(-1),
+            lazyStaticMember(false),
+            scopeVars(new ScopeVars())
         {}
 
         bool IsScope() const { return valueKind == ValueIsScope; }
@@ -129,18 +270,139 @@ private:
         VariableReference(const VariableReference &that) = delete;
     };
 
+    // Create reference with next number, return nullptr in case references numbers are exhausted.
+    // Note, m_referencesMutex must be locked by caller.
+    template <class... Args>
+    VariableReference *NewReference(Args&&... args);
+    // Return nullptr in case reference is not belong to current generation.
+    VariableReference *FindReference(uint32_t variablesReference);
+
     std::shared_ptr<EvalHelpers> m_sharedEvalHelpers;
     std::shared_ptr<Evaluator> m_sharedEvaluator;
     std::shared_ptr<EvalStackMachine> m_sharedEvalStackMachine;
 
-    std::recursive_mutex m_referencesMutex;
-    std::unordered_map<uint32_t, VariableReference> m_references;
+    // Note, references are allocated sequentially from generation base, so, reference is index in dense storage and
+    // all generation references (with evaluate names) are dropped at once at continue, storage memory is reused
+    // by next generations. References of previous generations are not valid (not reused by next generations).
+    // Readers of m_referencesGenerationLock use references objects, writer (Clear) drop generation.
+    // m_referencesMutex protect storages during new references creation and lookup.
+    Utility::RWLock m_referencesGenerationLock;
+    std::mutex m_referencesMutex;
+    uint32_t m_referencesBase;
+    DenseArena<VariableReference> m_references;
+    StringArena m_evaluateNames;
+
+    // Note, m_conditionPredicatesCache have its own mutex for private data state sync.
+    ConditionPredicatesCache m_conditionPredicatesCache;
+    // Note, m_propertyValuesCache have its own mutex for private data state sync.
+    PropertyValuesCache m_propertyValuesCache;
+    // Note, m_watchResultsCache have its own mutex for private data state sync.
+    WatchResultsCache m_watchResultsCache;
+    // Note, m_valueChangesTracker have its own mutex for private data state sync.
+    ValueChangesTracker m_valueChangesTracker;
+
+    // Completion names by frame and expression, completion is requested for each key press with same prefixes.
+    static const size_t MaxCompletionNames = 128;
+    std::mutex m_completionNamesMutex;
+    std::unordered_map<std::string, std::shared_ptr<const std::vector<std::string>>> m_completionNames;
+
+    std::atomic<bool> m_deferPropertiesEvaluation;
+    std::atomic<bool> m_arrayPreview;
+    std::atomic<unsigned> m_evalBudget;
+
+    // Evaluate expression by stack machine. Note, any func-eval could change debuggee state, so, properties values cache
+    // is cleared in case evaluation run func-eval.
+    HRESULT EvaluateExpression(
+        ICorDebugThread *pThread,
+        FrameLevel frameLevel,
+        int evalFlags,
+        const std::string &expression,
+        ICorDebugValue **ppResultValue,
+        std::string &output,
+        bool *editable = nullptr);
+
+    // Stack variables values and raw data of frame for watch results dependencies collection and check.
+    struct WatchStackVar
+    {
+        std::string data;
+        ToRelease<ICorDebugValue> value; // nullptr in case variable value can't be read
+    };
+    struct WatchStackVars
+    {
+        bool filled = false;
+        uint64_t evalsCount = 0;
+        std::unordered_map<std::string, WatchStackVar> vars;
+    };
+
+    HRESULT FillWatchStackVars(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, WatchStackVars &stackVars);
+
+    HRESULT GetWatchResultKey(
+        ICorDebugThread *pThread,
+        FrameLevel frameLevel,
+        int evalFlags,
+        const std::string &expression,
+        std::string &key);
+
+    HRESULT FindWatchResult(
+        ICorDebugProcess *pProcess,
+        ICorDebugThread *pThread,
+        FrameLevel frameLevel,
+        int evalFlags,
+        const std::string &key,
+        WatchStackVars &stackVars,
+        Variable &variable);
+
+    HRESULT AddWatchDependencies(
+        ICorDebugProcess *pProcess,
+        ICorDebugThread *pThread,
+        FrameLevel frameLevel,
+        int evalFlags,
+        const std::vector<std::string> &identifiers,
+        WatchStackVars &stackVars,
+        std::vector<WatchResultsCache::Dependency> &dependencies);
+
+    HRESULT AddWatchResult(
+        ICorDebugProcess *pProcess,
+        ICorDebugThread *pThread,
+        FrameLevel frameLevel,
+        int evalFlags,
+        const std::string &key,
+        const std::string &expression,
+        WatchStackVars &stackVars,
+        const Variable &variable);
+
+    // Evaluate expression into variable (with variable reference for result). Result of pure expression is reused from
+    // previous stops in case dependencies data unchanged (see WatchResultsCache).
+    HRESULT EvaluateVariable(
+        ICorDebugProcess *pProcess,
+        ICorDebugThread *pThread,
+        FrameId frameId,
+        const std::string &expression,
+        bool arrayPreview,
+        WatchStackVars &stackVars,
+        Variable &variable,
+        std::string &output);
+
+    HRESULT GetConditionOperandValue(
+        ICorDebugThread *pThread,
+        FrameLevel frameLevel,
+        const ConditionPredicate::operand_t &operand,
+        ConditionPredicate::value_t &value);
 
     HRESULT AddVariableReference(Variable &variable, FrameId frameId, ICorDebugValue *pValue, ValueKind valueKind);
+    HRESULT AddLazyPropertyReference(Variable &variable, VariableReference &ownerRef, int memberIndex);
+
+    // Mark variable as changed in case its value differ from value shown at previous stops (see ValueChangesTracker).
+    // Note, empty frameKey (see GetFrameKey()) disable tracking.
+    void TrackValueChange(const std::string &frameKey, ICorDebugValue *pValue, Variable &variable);
+
+    // Note, caller must lock scopeVars.mutex.
+    HRESULT FillScopeVars(ScopeVars &scopeVars, ICorDebugThread *pThread, FrameLevel frameLevel);
 
     HRESULT GetStackVariables(
-        FrameId frameId,
+        VariableReference &ref,
         ICorDebugThread *pThread,
+        const std::string &frameKey,
         int start,
         int count,
         std::vector<Variable> &variables);
@@ -148,10 +410,17 @@ private:
     HRESULT GetChildren(
         VariableReference &ref,
         ICorDebugThread *pThread,
+        const std::string &frameKey,
         int start,
         int count,
         std::vector<Variable> &variables);
 
+    HRESULT GetLazyProperty(
+        VariableReference &ref,
+        ICorDebugThread *pThread,
+        const std::string &frameKey,
+        std::vector<Variable> &variables);
+
     HRESULT SetStackVariable(
         VariableReference &ref,
         ICorDebugThread *pThread,
@@ -8,6 +8,7 @@
 
 #include <signal.h>
 #include <mutex>
+#include <unordered_map>
 
 namespace netcoredbg
 {
@@ -19,9 +20,8 @@ class waitpid_t
 private:
     typedef pid_t (*Signature)(pid_t pid, int *status, int options);
     Signature original = nullptr;
-    static constexpr pid_t notConfigured = -1;
-    pid_t trackPID = notConfigured;
-    int exitCode = 0; // same behaviour as CoreCLR have, by default exit code is 0
+    // Note, debugger may serve few sessions at once (see `--max-sessions`), each one tracks own debuggee PID.
+    std::unordered_map<pid_t, int> exitCodes;
     std::recursive_mutex interlock;
 
 #ifdef INTEROP_DEBUGGING
@@ -43,7 +43,7 @@ public:
 
     pid_t operator() (pid_t pid, int *status, int options);
     void SetupTrackingPID(pid_t PID);
-    int GetExitCode();
+    int GetExitCode(pid_t PID);
     void SetExitCode(pid_t PID, int Code);
 
 #ifdef INTEROP_DEBUGGING
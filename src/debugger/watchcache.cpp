@@ -0,0 +1,104 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/watchcache.h"
+
+namespace netcoredbg
+{
+
+const size_t WatchResultsCache::MaxResults;
+
+bool WatchResultsCache::Find(const std::string &key, const ReadCallback &read, Result &result)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto find = m_results.find(key);
+    if (find == m_results.end())
+        return false;
+
+    std::string data;
+    for (const auto &dependency : find->second.dependencies)
+    {
+        data.clear();
+        if (!read(dependency, data) || data != dependency.data)
+        {
+            m_results.erase(find);
+            return false;
+        }
+    }
+
+    result = find->second.result;
+    return true;
+}
+
+void WatchResultsCache::Add(const std::string &key, std::vector<Dependency> &&dependencies, const Result &result)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Note, watch expressions set is usually small, so, huge amount of results means that something else (for example,
+    // hover or REPL) actively use evaluation, just start from scratch in this case.
+    if (m_results.size() >= MaxResults && m_results.find(key) == m_results.end())
+        m_results.clear();
+
+    Entry &entry = m_results[key];
+    entry.dependencies = std::move(dependencies);
+    entry.result = result;
+}
+
+void WatchResultsCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_results.clear();
+}
+
+const size_t ValueChangesTracker::MaxValues;
+
+uint64_t ValueChangesTracker::Hash(const std::string &data)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char c : data)
+    {
+        hash ^= (unsigned char)c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool ValueChangesTracker::Update(const std::string &key, uint64_t hash)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Note, in case of huge amount of shown values (for example, big arrays expanded) just don't track new values.
+    if (m_current.size() < MaxValues || m_current.find(key) != m_current.end())
+        m_current[key] = hash;
+
+    auto find = m_previous.find(key);
+    return find != m_previous.end() && find->second != hash;
+}
+
+void ValueChangesTracker::NextStop()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_current.empty())
+        return;
+
+    if (m_previous.size() + m_current.size() > MaxValues)
+        m_previous.clear();
+
+    for (const auto &entry : m_current)
+    {
+        m_previous[entry.first] = entry.second;
+    }
+    m_current.clear();
+}
+
+void ValueChangesTracker::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_previous.clear();
+    m_current.clear();
+}
+
+} // namespace netcoredbg
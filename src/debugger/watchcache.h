@@ -0,0 +1,104 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+/// \file watchcache.h  This file contains declaration of watch expressions results cache and values changes tracker,
+/// that persist between stops.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <functional>
+#include <unordered_map>
+
+namespace netcoredbg
+{
+
+// Results of pure watch expressions (identifiers of locals, arguments and instance fields, literals and trivial comparisons,
+// see ConditionPredicate) evaluated at previous stops, with raw data of all evaluation inputs (dependencies). Client re-send
+// all watch expressions after each step, in case all dependencies data unchanged, cached result could be used instead of
+// expression evaluation. Note, cache don't know how dependencies data is read, caller provide current data at lookup.
+class WatchResultsCache
+{
+public:
+
+    struct Dependency
+    {
+        enum class Kind
+        {
+            StackVariable, // local variable or argument (including `this`) with `name`, `data` is raw value data
+            ThisMember,    // `name` resolved as implicit `this` member, stack variable with same name must not exist (`data` is empty)
+            Object         // heap object at `address`, fields of which were read, `data` is object memory
+        };
+
+        Kind kind;
+        std::string name;
+        uint64_t address;
+        std::string data;
+
+        Dependency(Kind kind, const std::string &name, uint64_t address, std::string &&data) :
+            kind(kind), name(name), address(address), data(std::move(data))
+        {}
+    };
+
+    struct Result
+    {
+        std::string value;
+        std::string type;
+        bool editable = false;
+    };
+
+    // Read current data of dependency, return false in case dependency can't be read (for example, variable not exist anymore).
+    typedef std::function<bool(const Dependency &dependency, std::string &data)> ReadCallback;
+
+    static const size_t MaxResults = 256;
+
+    // Return false in case no result for key or any dependency data changed (in this case result is dropped from cache).
+    bool Find(const std::string &key, const ReadCallback &read, Result &result);
+    void Add(const std::string &key, std::vector<Dependency> &&dependencies, const Result &result);
+    void Clear();
+
+private:
+
+    struct Entry
+    {
+        std::vector<Dependency> dependencies;
+        Result result;
+    };
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_results;
+};
+
+// Hashes of raw data of values (or object addresses for references) shown to user at previous stops, so, values changed
+// since previous stop could be highlighted by client. Only hashes are stored, debuggee values are not held between stops.
+// Key is provided by caller, it should identify value's frame (thread, method) and evaluate name.
+class ValueChangesTracker
+{
+public:
+
+    static const size_t MaxValues = 16 * 1024;
+
+    // FNV-1a 64 bit hash.
+    static uint64_t Hash(const std::string &data);
+
+    // Remember value's hash for current stop, return true in case value with same key was shown at previous stops
+    // with different hash.
+    bool Update(const std::string &key, uint64_t hash);
+    // Should be called at continue, values shown at current stop become previous stop values.
+    // Note, values shown at older stops are kept, in case value was not shown at last stop (for example, collapsed).
+    void NextStop();
+    void Clear();
+
+private:
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, uint64_t> m_previous;
+    std::unordered_map<std::string, uint64_t> m_current;
+};
+
+} // namespace netcoredbg
@@ -0,0 +1,181 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "embed/libnetcoredbg.h"
+
+#include <exception>
+#include <iostream>
+#include "interfaces/iprotocol.h"
+#include "debugger/manageddebugger.h"
+#include "managed/interop.h"
+#include "utils/logger.h"
+#include "utils/sequenced_executor.h"
+
+namespace netcoredbg
+{
+
+namespace Embedded
+{
+
+namespace
+{
+    // Note, embedded protocol don't read commands and don't write responses, streams are required by IProtocol only.
+    std::istream nullInput(nullptr);
+    std::ostream nullOutput(nullptr);
+
+    // Forward debugger events to tool's callbacks, events data are copied and callbacks are called by own worker thread,
+    // so, debugger threads (and locks, that held during events emission) are never blocked by tool's code.
+    class EmbeddedProtocol : public IProtocol
+    {
+    public:
+
+        explicit EmbeddedProtocol(const Callbacks &callbacks) :
+            IProtocol(nullInput, nullOutput),
+            m_callbacks(callbacks),
+            m_eventsExecutor("EmbeddedEvents")
+        {}
+
+        void WaitEvents()
+        {
+            m_eventsExecutor.WaitIdle();
+        }
+
+        void EmitInitializedEvent() override
+        {
+            if (m_callbacks.initialized)
+                m_eventsExecutor.Post([this]() { m_callbacks.initialized(); });
+        }
+
+        void EmitExecEvent(PID pid, const std::string &argv0) override
+        {
+            if (m_callbacks.exec)
+                m_eventsExecutor.Post([this, pid, argv0]() { m_callbacks.exec(pid, argv0); });
+        }
+
+        void EmitStoppedEvent(const StoppedEvent &event) override
+        {
+            if (m_callbacks.stopped)
+                m_eventsExecutor.Post([this, event]() { m_callbacks.stopped(event); });
+        }
+
+        void EmitExitedEvent(const ExitedEvent &event) override
+        {
+            if (m_callbacks.exited)
+                m_eventsExecutor.Post([this, event]() { m_callbacks.exited(event); });
+        }
+
+        void EmitTerminatedEvent() override
+        {
+            if (m_callbacks.terminated)
+                m_eventsExecutor.Post([this]() { m_callbacks.terminated(); });
+        }
+
+        void EmitContinuedEvent(ThreadId threadId, bool allThreadsContinued) override
+        {
+            if (m_callbacks.continued)
+                m_eventsExecutor.Post([this, threadId, allThreadsContinued]() { m_callbacks.continued(threadId, allThreadsContinued); });
+        }
+
+        void EmitInteropDebuggingErrorEvent(const int error_n) override
+        {
+            if (m_callbacks.interopDebuggingError)
+                m_eventsExecutor.Post([this, error_n]() { m_callbacks.interopDebuggingError(error_n); });
+        }
+
+        void EmitThreadEvent(const ThreadEvent &event) override
+        {
+            if (m_callbacks.thread)
+                m_eventsExecutor.Post([this, event]() { m_callbacks.thread(event); });
+        }
+
+        void EmitModuleEvent(const ModuleEvent &event) override
+        {
+            if (m_callbacks.module)
+                m_eventsExecutor.Post([this, event]() { m_callbacks.module(event); });
+        }
+
+        void EmitLoadedSourceEvent(const Source &source) override
+        {
+            if (m_callbacks.loadedSource)
+                m_eventsExecutor.Post([this, source]() { m_callbacks.loadedSource(source); });
+        }
+
+        void EmitOutputEvent(OutputCategory category, string_view output, string_view source) override
+        {
+            if (!m_callbacks.output)
+                return;
+
+            std::string outputText(output.data(), output.size());
+            std::string sourceText(source.data(), source.size());
+            m_eventsExecutor.Post([this, category, outputText, sourceText]() { m_callbacks.output(category, outputText, sourceText); });
+        }
+
+        void EmitBreakpointEvent(const BreakpointEvent &event) override
+        {
+            if (m_callbacks.breakpoint)
+                m_eventsExecutor.Post([this, event]() { m_callbacks.breakpoint(event); });
+        }
+
+        void Cleanup() override {}
+        void SetLaunchCommand(const std::string &, const std::vector<std::string> &) override {}
+        // Note, tool drive debugger by IDebugger calls directly, no command loop needed.
+        void CommandLoop() override {}
+
+    private:
+
+        Callbacks m_callbacks;
+        SequencedExecutor m_eventsExecutor;
+    };
+
+    // Debugger hold raw pointer to protocol, so, protocol must be released after debugger.
+    struct DebuggerDeleter
+    {
+        std::shared_ptr<EmbeddedProtocol> sharedProtocol;
+
+        void operator()(IDebugger *pDebugger)
+        {
+            delete pDebugger;
+            // Note, all queued events are delivered at protocol (events executor) release.
+            sharedProtocol.reset();
+        }
+    };
+
+} // unnamed namespace
+
+int GetApiVersion()
+{
+    return ApiVersion;
+}
+
+std::shared_ptr<IDebugger> CreateDebugger(const Callbacks &callbacks)
+{
+    DebuggerDeleter deleter;
+    deleter.sharedProtocol.reset(new EmbeddedProtocol(callbacks));
+
+    try
+    {
+        return std::shared_ptr<IDebugger>(new ManagedDebugger(deleter.sharedProtocol.get()), deleter);
+    }
+    catch (const std::exception &e)
+    {
+        LOGE("Embedded debugger creation failed: %s", e.what());
+        return nullptr;
+    }
+}
+
+void WaitEvents(const std::shared_ptr<IDebugger> &sharedDebugger)
+{
+    DebuggerDeleter *pDeleter = std::get_deleter<DebuggerDeleter>(sharedDebugger);
+    if (pDeleter && pDeleter->sharedProtocol)
+        pDeleter->sharedProtocol->WaitEvents();
+}
+
+void Shutdown()
+{
+    Interop::Shutdown();
+}
+
+} // namespace Embedded
+
+} // namespace netcoredbg
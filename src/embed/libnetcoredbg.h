@@ -0,0 +1,61 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include "interfaces/idebugger.h"
+#include "interfaces/types.h"
+
+namespace netcoredbg
+{
+
+// In-process debugger API (libnetcoredbg library), aimed to tools, that drive debugger directly by IDebugger calls and
+// get StackFrame, Variable and other structures without protocol (MI/VSCode) serialization and parsing.
+// Events, that protocols receive by IProtocol, are delivered to callbacks asynchronously: posted by debugger threads
+// (managed callbacks, protocol requests) and called one by one in emission order by library's own thread, so, callbacks
+// could block and call IDebugger methods (for example, GetStackTrace() at stop event).
+namespace Embedded
+{
+    // Incremented in case of incompatible changes of IDebugger, events structures or Callbacks.
+    const int ApiVersion = 1;
+
+    // Any callback could be empty, event is ignored in this case.
+    struct Callbacks
+    {
+        std::function<void()> initialized;
+        std::function<void(PID pid, const std::string &argv0)> exec;
+        std::function<void(const StoppedEvent &event)> stopped;
+        std::function<void(const ExitedEvent &event)> exited;
+        std::function<void()> terminated;
+        std::function<void(ThreadId threadId, bool allThreadsContinued)> continued;
+        std::function<void(const ThreadEvent &event)> thread;
+        std::function<void(const ModuleEvent &event)> module;
+        std::function<void(const Source &source)> loadedSource;
+        std::function<void(OutputCategory category, const std::string &output, const std::string &source)> output;
+        std::function<void(const BreakpointEvent &event)> breakpoint;
+        std::function<void(int error)> interopDebuggingError;
+    };
+
+    // Return `ApiVersion` library was built with, so, tool could check it against header version at runtime.
+    int GetApiVersion();
+
+    // Create debugger session, in case of fail return nullptr. Debugger is not connected to any process, use
+    // IDebugger Launch()/Attach() methods same way as protocols do. Note, at debugger release all not delivered
+    // events are delivered before return.
+    std::shared_ptr<IDebugger> CreateDebugger(const Callbacks &callbacks);
+
+    // Wait for delivery of all events, that were emitted by debugger before this call. Must not be called from callbacks.
+    // Note, `sharedDebugger` must be created by CreateDebugger().
+    void WaitEvents(const std::shared_ptr<IDebugger> &sharedDebugger);
+
+    // Release process-wide state (CoreCLR host and managed part), that shared by all sessions.
+    // Must be called after all debuggers are released, before library unload.
+    void Shutdown();
+
+} // namespace Embedded
+
+} // namespace netcoredbg
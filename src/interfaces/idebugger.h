@@ -10,6 +10,7 @@
 #include <map>
 #include <memory>
 #include "interfaces/types.h"
+#include "debugger/interop_signal_policy.h"
 #include "utils/string_view.h"
 #include "utils/streams.h"
 
@@ -25,7 +26,10 @@ public:
     {
         STEP_IN = 0,
         STEP_OVER,
-        STEP_OUT
+        STEP_OUT,
+        // Native instruction granularity, see Modules::GetInstructionStepRangeFromCurrentIP().
+        STEP_IN_INSTRUCTION,
+        STEP_OVER_INSTRUCTION
     };
 
     enum DisconnectAction
@@ -60,6 +64,9 @@ public:
         Eof         // EOF reached
     };
     virtual IDebugger::AsyncResult ProcessStdin(InStream &) { return IDebugger::AsyncResult::Eof; }
+    // Forward debuggee's stdout/stderr directly to debugger's stdout (if possible), for protocols that print output as is.
+    // Note, IProtocol::EmitOutputEvent() is not called for forwarded output.
+    virtual void SetOutputPassthrough() {}
 
 
     virtual ~IDebugger() {}
@@ -67,13 +74,44 @@ public:
     virtual void SetJustMyCode(bool enable) = 0;
     virtual bool IsStepFiltering() const = 0;
     virtual void SetStepFiltering(bool enable) = 0;
+    virtual bool IsDeferredJMC() const = 0;
+    virtual void SetDeferredJMC(bool enable) = 0;
+    virtual unsigned GetEvalTimeout() const = 0;
+    virtual void SetEvalTimeout(unsigned timeout) = 0;
+    virtual bool IsAdaptiveEvalTimeout() const = 0;
+    virtual void SetAdaptiveEvalTimeout(bool enable) = 0;
+    virtual unsigned GetMaxParallelEvals() const = 0;
+    virtual void SetMaxParallelEvals(unsigned count) = 0;
+    virtual bool IsDeferPropertiesEvaluation() const = 0;
+    virtual void SetDeferPropertiesEvaluation(bool enable) = 0;
+    virtual bool IsArrayPreview() const = 0;
+    virtual void SetArrayPreview(bool enable) = 0;
+    // Properties getters evaluation time budget for one variables request in milliseconds, 0 - no limit.
+    virtual unsigned GetEvalBudget() const = 0;
+    virtual void SetEvalBudget(unsigned budget) = 0;
     virtual bool IsHotReload() const = 0;
     virtual HRESULT SetHotReload(bool enable) = 0;
+    // Symbol readers soft memory limit in bytes, 0 - no limit.
+    virtual void SetSymbolsMemoryLimit(uint64_t limit) = 0;
+    // Time in minutes without symbols access, after that module's symbol reader is unloaded, 0 - never unload idle symbols.
+    virtual void SetSymbolsIdleTimeout(unsigned minutes) = 0;
+    // Symbol servers URLs separated by ';' for PDB download in background, empty cache path - default cache in temp directory.
+    virtual void SetSymbolServers(const std::string &servers, const std::string &cachePath) = 0;
+    // Download sources missed on disk by SourceLink, sources for `prefetchFrames` top frames are prefetched at stop.
+    virtual void SetSourceLink(bool enable, unsigned prefetchFrames) = 0;
+    virtual void GetMemoryUsage(MemoryUsage &usage) = 0;
+    // Non-stop mode, stop events (breakpoint, step, exception, pause of thread) stop event thread only.
+    virtual bool IsNonStop() const = 0;
+    virtual void SetNonStop(bool enable) = 0;
 #ifdef INTEROP_DEBUGGING
     virtual void SetInteropDebugging(bool enable) = 0;
 #endif
+    // Interop mode only, signal could be provided by name or by number (see SignalPolicy::ParseSignal()).
+    virtual HRESULT SetSignalAction(const std::string &signal, SignalAction action) = 0;
     virtual HRESULT Initialize() = 0;
     virtual HRESULT Attach(int pid) = 0;
+    // Open ELF core dump for offline analysis, process in dump can't be continued, changed or used for func-eval.
+    virtual HRESULT OpenDump(const std::string &dumpPath) = 0;
     virtual HRESULT Launch(const std::string &fileExec, const std::vector<std::string> &execArgs, const std::map<std::string, std::string> &env,
         const std::string &cwd, bool stopAtEntry = false) = 0;
     virtual HRESULT ConfigurationDone() = 0;
@@ -81,32 +119,86 @@ public:
     virtual ThreadId GetLastStoppedThreadId() = 0;
     virtual HRESULT Continue(ThreadId threadId) = 0;
     virtual HRESULT Pause(ThreadId lastStoppedThread, EventFormat eventFormat) = 0;
-    virtual HRESULT GetThreads(std::vector<Thread> &threads, bool withNativeThreads = false) = 0;
+    virtual HRESULT GetThreads(std::vector<Thread> &threads, bool withNativeThreads = false, bool refreshNativeNames = false) = 0;
     virtual HRESULT UpdateLineBreakpoint(int id, int linenum, Breakpoint &breakpoint) = 0;
     virtual HRESULT SetLineBreakpoints(const std::string& filename, const std::vector<LineBreakpoint> &lineBreakpoints, std::vector<Breakpoint> &breakpoints) = 0;
     virtual HRESULT SetFuncBreakpoints(const std::vector<FuncBreakpoint> &funcBreakpoints, std::vector<Breakpoint> &breakpoints) = 0;
     virtual HRESULT SetExceptionBreakpoints(const std::vector<ExceptionBreakpoint> &exceptionBreakpoints, std::vector<Breakpoint> &breakpoints) = 0;
+    virtual HRESULT SetDataBreakpoints(const std::vector<DataBreakpoint> &dataBreakpoints, std::vector<Breakpoint> &breakpoints) = 0;
+    // Prepare data breakpoint for instance field `name` of object provided by `variablesReference`, field is watched till
+    // object is alive (GC relocation is tracked by debugger). Return S_FALSE with `description` in case field can't be watched.
+    virtual HRESULT GetFieldDataBreakpointInfo(uint32_t variablesReference, const std::string &name, DataBreakpoint &dataBreakpoint,
+                                               std::string &description) = 0;
     virtual HRESULT BreakpointActivate(int id, bool act) = 0;
     virtual void EnumerateBreakpoints(std::function<bool (const BreakpointInfo&)>&& callback) = 0;
     virtual HRESULT AllBreakpointsActivate(bool act) = 0;
     virtual HRESULT GetStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames, bool hotReloadAwareCaller = false) = 0;
     virtual HRESULT StepCommand(ThreadId threadId, StepType stepType) = 0;
+    // Continue thread execution until source line reached (or any other stop event), internal one-shot breakpoint is used.
+    virtual HRESULT RunToLine(ThreadId threadId, const std::string &filename, int linenum) = 0;
+    // Methods with user code called at current line of top frame, `targets` ids are valid till process continue.
+    virtual HRESULT GetStepInTargets(FrameId frameId, std::vector<StepInTarget> &targets) = 0;
+    // Step over current line, but stop at first user code line of target method in case it called.
+    virtual HRESULT StepIntoTarget(ThreadId threadId, int targetId) = 0;
     virtual HRESULT GetScopes(FrameId frameId, std::vector<Scope> &scopes) = 0;
     virtual HRESULT GetVariables(uint32_t variablesReference, VariablesFilter filter, int start, int count, std::vector<Variable> &variables) = 0;
     virtual int GetNamedVariables(uint32_t variablesReference) = 0;
     virtual HRESULT Evaluate(FrameId frameId, const std::string &expression, Variable &variable, std::string &output) = 0;
+    virtual HRESULT EvaluateBatch(FrameId frameId, const std::vector<std::string> &expressions, std::vector<Variable> &variables,
+                                  std::vector<HRESULT> &statuses, std::vector<std::string> &outputs) = 0;
+    // Read part of string value (offset and count in UTF-16 code units), so, huge strings could be fetched by parts,
+    // `read` is number of code units actually read and `length` is full string length.
+    virtual HRESULT ReadString(FrameId frameId, const std::string &expression, int evalFlags, uint32_t offset, uint32_t count,
+                               std::string &value, uint32_t &read, uint32_t &length) = 0;
     virtual void CancelEvalRunning() = 0;
     virtual HRESULT SetVariable(const std::string &name, const std::string &value, uint32_t ref, std::string &output) = 0;
     virtual HRESULT SetExpression(FrameId frameId, const std::string &expression, int evalFlags, const std::string &value, std::string &output) = 0;
     virtual HRESULT GetExceptionInfo(ThreadId threadId, ExceptionInfo &exceptionInfo) = 0;
-    virtual HRESULT GetSourceFile(const std::string &sourcePath, char** fileBuf, int* fileLen) = 0;
-    virtual void FreeUnmanaged(PVOID mem) = 0;
+    // Note, source embedded into PDB is cached by debugger, returned buffer must not be modified.
+    virtual HRESULT GetSourceFile(const std::string &sourcePath, std::shared_ptr<const char> &fileBuf, int &fileLen) = 0;
+    // Provide `instructionCount` instructions of JIT'ed code, starting from instruction at `address + offset` shifted by
+    // `instructionOffset` instructions (could be negative). Out of JIT'ed code instructions are provided as not valid.
+    virtual HRESULT Disassemble(std::uintptr_t address, int64_t offset, int instructionOffset, int instructionCount,
+                                bool resolveSymbols, std::vector<DisassembledInstruction> &instructions) = 0;
+    // Read `count` bytes of debuggee memory at `address + offset`, `data` contain bytes till first unreadable memory
+    // and `unreadableBytes` is number of requested bytes that can't be read.
+    virtual HRESULT ReadMemory(std::uintptr_t address, int64_t offset, uint32_t count, std::string &data, uint32_t &unreadableBytes) = 0;
+    virtual HRESULT WriteMemory(std::uintptr_t address, int64_t offset, const std::string &data, bool allowPartial, uint32_t &bytesWritten) = 0;
     virtual HRESULT HotReloadApplyDeltas(const std::string &dllFileName, const std::string &deltaMD, const std::string &deltaIL,
                                          const std::string &deltaPDB, const std::string &lineUpdates) = 0;
     typedef std::function<void(const char *)> SearchCallback;
     virtual void FindFileNames(string_view pattern, unsigned limit, SearchCallback) = 0;
+    // Loaded sources full paths, sources indexes are stable during debug session, return all loaded sources count.
+    virtual unsigned GetLoadedSources(unsigned startIndex, unsigned count, SearchCallback) = 0;
+    // Search loaded sources full paths by components prefix or files names fuzzy match.
+    virtual void SearchSources(string_view pattern, unsigned limit, SearchCallback) = 0;
     virtual void FindFunctions(string_view pattern, unsigned limit, SearchCallback) = 0;
     virtual void FindVariables(ThreadId, FrameLevel, string_view, unsigned limit, SearchCallback) = 0;
+    // Sampling profiler, periodically stop process and collect all threads stacks with `interval` in milliseconds.
+    virtual HRESULT StartSampling(unsigned interval) = 0;
+    virtual HRESULT StopSampling(uint64_t &samplesCount) = 0;
+    // Could be called during sampling or after sampling stop, samples are kept till next sampling start.
+    virtual HRESULT ExportSamples(SamplesFormat format, std::string &output) = 0;
+    // Exception statistics mode, first chance exceptions are counted by type and throw-site and continued without stop.
+    virtual void SetExceptionStatistics(bool enable) = 0;
+    virtual bool IsExceptionStatistics() = 0;
+    // Sorted by count, in case `reset` is true, counts are reset after read.
+    virtual HRESULT GetExceptionStatistics(std::vector<ExceptionStatistic> &statistics, uint64_t &droppedCount, bool reset) = 0;
+    // Trace points hits from oldest to newest, in case `drain` is true, returned records are removed (streaming).
+    virtual HRESULT GetTraceRecords(std::vector<TraceRecord> &records, uint64_t &overwrittenCount, bool drain) = 0;
+    virtual HRESULT ClearTraceRecords() = 0;
+    // Walk managed heap of stopped process, objects are aggregated by type, top `topCount` types are provided sorted by
+    // size (or objects count). Callback is called periodically during walk with partial statistics (progress).
+    typedef std::function<void(const HeapStatistics &partial)> HeapStatisticsCallback;
+    virtual HRESULT GetHeapStatistics(unsigned topCount, bool sortByCount, HeapStatisticsCallback callback, HeapStatistics &statistics) = 0;
+    // Find shortest references path from GC roots (stack, handles, finalizer queue) to object, provided by expression.
+    virtual HRESULT FindGCRootPath(FrameId frameId, const std::string &expression, int evalFlags, GCRootPath &path) = 0;
+    // Walk managed heap of stopped process for Task objects, tasks are grouped by status and state machine await point,
+    // groups are sorted by tasks count. Completed tasks are skipped, unless `includeCompleted` is true.
+    virtual HRESULT GetAsyncTasks(bool includeCompleted, std::vector<AsyncTaskGroup> &groups, uint64_t &tasksCount) = 0;
+    // Collect all threads stacks, locals of top `localsFrames` frames and current exceptions in one pass (raw reads only,
+    // no func-eval) and detach immediately. Snapshot is provided as compact JSON.
+    virtual HRESULT SnapshotAndDetach(unsigned localsFrames, std::string &output) = 0;
 };
 
 } // namespace netcoredbg
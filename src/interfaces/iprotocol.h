@@ -36,10 +36,12 @@ public:
     virtual void EmitStoppedEvent(const StoppedEvent &event) = 0;
     virtual void EmitExitedEvent(const ExitedEvent &event) = 0;
     virtual void EmitTerminatedEvent() = 0;
-    virtual void EmitContinuedEvent(ThreadId threadId) = 0;
+    virtual void EmitContinuedEvent(ThreadId threadId, bool allThreadsContinued) = 0;
     virtual void EmitInteropDebuggingErrorEvent(const int error_n) {}
     virtual void EmitThreadEvent(const ThreadEvent &event) = 0;
     virtual void EmitModuleEvent(const ModuleEvent &event) = 0;
+    // Note, sources are never removed during debug session, so, only new loaded sources are provided.
+    virtual void EmitLoadedSourceEvent(const Source &source) {}
     virtual void EmitOutputEvent(OutputCategory category, string_view output, string_view source = "") = 0;
     virtual void EmitBreakpointEvent(const BreakpointEvent &event) = 0;
     virtual void Cleanup() = 0;
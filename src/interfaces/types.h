@@ -19,6 +19,7 @@
 #include <cassert>
 #include <climits>
 #include <cstdint>
+#include <cstdint>
 
 namespace netcoredbg
 {
@@ -286,7 +287,8 @@ enum StopReason
     StopBreakpoint,
     StopException,
     StopPause,
-    StopEntry
+    StopEntry,
+    StopDataBreakpoint
 };
 
 struct StoppedEvent
@@ -369,9 +371,12 @@ struct ModuleEvent
 
 struct Scope
 {
+    // Note, scope variables are enumerated by first variables request, count is not provided in scopes response.
+    static const int DeferredCount = -1;
+
     std::string name;
     uint32_t variablesReference;
-    int namedVariables;
+    int namedVariables; // DeferredCount in case not calculated
     int indexedVariables;
     bool expensive;
 
@@ -386,12 +391,27 @@ struct Scope
     {}
 };
 
+// Method called at current line, that could be stepped into directly (see IDebugger::StepIntoTarget()).
+struct StepInTarget
+{
+    int id;
+    std::string label;
+
+    StepInTarget(int id, const std::string &label) : id(id), label(label) {}
+};
+
 // TODO: Replace strings with enums
 struct VariablePresentationHint
 {
     std::string kind;
     std::vector<std::string> attributes;
     std::string visibility;
+    // Value is not known yet, client should fetch it by requesting variable's children (single child with value).
+    bool lazy;
+    // Value changed since previous stop (see ValueChangesTracker).
+    bool changed;
+
+    VariablePresentationHint() : lazy(false), changed(false) {}
 };
 
 // https://docs.microsoft.com/en-us/visualstudio/extensibility/debugger/reference/evalflags
@@ -407,6 +427,25 @@ enum enum_EVALFLAGS {
 
 #define defaultEvalFlags 0
 
+// Not part of EVALFLAGS, high bits of evalFlags could hold per-request func-eval timeout in 100 ms units
+// (up to ~54 minutes), 0 - debugger's eval timeout setting should be used.
+#define EVAL_TIMEOUT_SHIFT 16
+#define EVAL_TIMEOUT_MASK 0x7fff0000
+#define EVAL_TIMEOUT_UNIT_MS 100
+
+inline int SetEvalFlagsTimeout(int evalFlags, unsigned timeoutMs)
+{
+    unsigned units = (timeoutMs + EVAL_TIMEOUT_UNIT_MS - 1) / EVAL_TIMEOUT_UNIT_MS;
+    if (units > (EVAL_TIMEOUT_MASK >> EVAL_TIMEOUT_SHIFT))
+        units = EVAL_TIMEOUT_MASK >> EVAL_TIMEOUT_SHIFT;
+    return (evalFlags & ~EVAL_TIMEOUT_MASK) | (int)(units << EVAL_TIMEOUT_SHIFT);
+}
+
+inline unsigned GetEvalFlagsTimeout(int evalFlags)
+{
+    return (unsigned)((evalFlags & EVAL_TIMEOUT_MASK) >> EVAL_TIMEOUT_SHIFT) * EVAL_TIMEOUT_UNIT_MS;
+}
+
 struct Variable
 {
     std::string name;
@@ -435,13 +474,23 @@ struct LineBreakpoint
     std::string module;
     int line;
     std::string condition;
+    std::string hitCondition; // `N`, `==N`, `>N`, `>=N`, `<N`, `<=N` or `%N`, where N - hit count
+    std::string logMessage; // not empty for log points, expressions in curly braces are interpolated
+    bool trace; // trace point, hit is recorded into trace buffer without stop (condition and log message are ignored)
+    unsigned traceArgs; // trace point leading arguments count (include `this`), that are recorded with hit (up to 4)
 
     LineBreakpoint(const std::string &module,
                    int linenum,
-                   const std::string &cond = std::string()) :
+                   const std::string &cond = std::string(),
+                   const std::string &hitCond = std::string(),
+                   const std::string &logMsg = std::string()) :
         module(module),
         line(linenum),
-        condition(cond)
+        condition(cond),
+        hitCondition(hitCond),
+        logMessage(logMsg),
+        trace(false),
+        traceArgs(0)
     {}
 };
 
@@ -451,16 +500,155 @@ struct FuncBreakpoint
     std::string func;
     std::string params;
     std::string condition;
+    std::string hitCondition; // same as LineBreakpoint::hitCondition
+    std::string logMessage; // same as LineBreakpoint::logMessage
+    bool trace; // same as LineBreakpoint::trace
+    unsigned traceArgs; // same as LineBreakpoint::traceArgs
 
     FuncBreakpoint(const std::string &module,
                    const std::string &func,
                    const std::string &params,
-                   const std::string &cond = std::string()) :
+                   const std::string &cond = std::string(),
+                   const std::string &hitCond = std::string(),
+                   const std::string &logMsg = std::string()) :
         module(module),
         func(func),
         params(params),
-        condition(cond)
+        condition(cond),
+        hitCondition(hitCond),
+        logMessage(logMsg),
+        trace(false),
+        traceArgs(0)
+    {}
+};
+
+enum class SamplesFormat
+{
+    Folded,     // collapsed stacks, one `root;...;leaf count` line per unique stack
+    Speedscope  // https://www.speedscope.app/file-format-schema.json
+};
+
+// Aggregated first chance exceptions with same type and throw-site (exception statistics mode).
+struct ExceptionStatistic
+{
+    std::string exceptionType;
+    std::string module;         // throw-site module name, empty if exception was thrown outside of managed code
+    std::string method;         // throw-site method full name
+    uint32_t ilOffset;
+    uint64_t count;
+
+    ExceptionStatistic() : ilOffset(0), count(0) {}
+};
+
+// Managed heap objects of one type (heap statistics).
+struct HeapTypeStatistic
+{
+    std::string typeName;
+    uint64_t count;
+    uint64_t size;  // objects size in bytes
+
+    HeapTypeStatistic() : count(0), size(0) {}
+};
+
+struct HeapStatistics
+{
+    uint64_t objectsCount;
+    uint64_t totalSize;
+    uint64_t typesCount;
+    bool complete;                          // `false` for partial statistics, provided during heap walk
+    std::vector<HeapTypeStatistic> types;   // top types, sorted by size or count
+
+    HeapStatistics() : objectsCount(0), totalSize(0), typesCount(0), complete(false) {}
+};
+
+// Object on references path from GC root.
+struct GCRootPathObject
+{
+    uint64_t address;
+    std::string typeName;
+
+    GCRootPathObject() : address(0) {}
+};
+
+// Shortest references path from GC root to object (why object is alive).
+struct GCRootPath
+{
+    std::string rootKind;                   // "stack", "strong handle", "pinned handle", "finalizer queue", ...
+    std::vector<GCRootPathObject> objects;  // from root object to target object, empty in case object is not reachable
+};
+
+// Live tasks with same status and same state machine await point (or same type for tasks without state machine).
+struct AsyncTaskGroup
+{
+    std::string status;                 // TaskStatus name
+    std::string name;                   // state machine MoveNext() or task type name
+    int32_t state;                      // state machine `<>1__state`, INT32_MIN for tasks without state machine
+    uint64_t count;
+    std::vector<uint64_t> tasks;        // first tasks addresses of group
+    std::vector<StackFrame> asyncStack; // first task state machine and awaiting async methods
+
+    AsyncTaskGroup() : state(0), count(0) {}
+};
+
+// Trace point hit, recorded without stop.
+struct TraceRecord
+{
+    uint64_t timestamp;             // monotonic clock, in microseconds
+    ThreadId threadId;
+    uint32_t breakpointId;
+    std::string module;
+    std::string method;             // method full name
+    uint32_t ilOffset;
+    std::vector<std::string> args;  // leading arguments values, primitives and objects addresses only
+
+    TraceRecord() : timestamp(0), breakpointId(0), ilOffset(0) {}
+};
+
+// JIT'ed code instruction for disassemble request.
+struct DisassembledInstruction
+{
+    std::uintptr_t address;
+    std::string instructionBytes;   // hex, space separated
+    std::string instruction;
+    std::string symbol;             // method full name, provided for first instruction of method and in case method changed
+    Source source;
+    int line;
+    int endLine;
+    bool valid;                     // false for dummy entries out of JIT'ed code
+
+    DisassembledInstruction() : address(0), line(0), endLine(0), valid(false) {}
+};
+
+enum class DataBreakpointAccess
+{
+    Write,
+    Read,
+    ReadWrite
+};
+
+// Native memory data breakpoint (hardware watchpoint), available in interop mode only.
+// Managed object field could be watched too (see IDebugger::GetFieldDataBreakpointInfo()), in this case address is
+// resolved by debugger and changed after object relocation by GC.
+struct DataBreakpoint
+{
+    std::uintptr_t address;
+    uint32_t size; // 1, 2, 4 or 8 bytes, address must be aligned to size
+    DataBreakpointAccess access;
+    uint32_t managedFieldId; // 0 in case of native memory
+
+    DataBreakpoint(std::uintptr_t address, uint32_t size, DataBreakpointAccess access, uint32_t managedFieldId = 0) :
+        address(address),
+        size(size),
+        access(access),
+        managedFieldId(managedFieldId)
     {}
+
+    // Note, managed field data breakpoints are compared by field, since address could be changed by GC.
+    bool operator==(const DataBreakpoint &other) const
+    {
+        return (managedFieldId != 0 ? managedFieldId == other.managedFieldId : address == other.address && other.managedFieldId == 0) &&
+               size == other.size && access == other.access;
+    }
 };
 
 // Based on CorDebugExceptionCallbackType, but include info about JMC status in catch handler.
@@ -541,6 +729,24 @@ struct ExceptionBreakpoint
     }
 };
 
+// Approximate memory, used by debugger's symbols related data, in bytes.
+struct MemoryUsage
+{
+    uint64_t symbolReaders;     // PDB data of loaded symbol readers (including Hot Reload delta PDBs)
+    uint64_t modulesSources;    // sources paths and methods ranges tables
+    uint64_t lineUpdates;       // Hot Reload line updates tables
+    uint64_t sequencePoints;    // sequence points cache
+    uint64_t evalCaches;        // types members cache
+    unsigned loadedReaders;
+    unsigned unloadedReaders;   // main PDB readers unloaded by memory limit, will be loaded again on demand
+    uint64_t symbolsLimit;      // symbol readers soft limit, 0 - no limit
+
+    MemoryUsage() :
+        symbolReaders(0), modulesSources(0), lineUpdates(0), sequencePoints(0), evalCaches(0),
+        loadedReaders(0), unloadedReaders(0), symbolsLimit(0)
+    {}
+};
+
 enum class EventFormat
 {
     Default,
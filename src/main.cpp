@@ -4,6 +4,9 @@
 
 #include <string>
 #include <exception>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -11,12 +14,25 @@
 #include "utils/limits.h"
 
 #include "protocols/vscodeprotocol.h"
+#include "protocols/enginelog.h"
+#include "debugger/frames.h"
 #include "debugger/manageddebugger.h"
 #include "protocols/miprotocol.h"
 #include "protocols/cliprotocol.h"
+#include "protocols/compactprotocol.h"
 #include "managed/interop.h"
+#include "metadata/method_ranges_cache.h"
+#include "metadata/module_snapshot_cache.h"
+#include "metadata/resolved_bp_cache.h"
+#include "metadata/sequence_points_cache.h"
+#include "metadata/sourcelink_cache.h"
 #include "utils/utf.h"
 #include "utils/logger.h"
+#include "utils/perfcounters.h"
+#include "utils/tracerecorder.h"
+#ifdef SERVER_COMPRESSION
+#include "utils/compressedstream.h"
+#endif
 #include "buildinfo.h"
 #include "version.h"
 
@@ -46,6 +62,22 @@ namespace netcoredbg
 {
 
 static const uint16_t DEFAULT_SERVER_PORT = 4711;
+// Note, protocol responses (variables, stack traces) could be large, bigger buffers reduce syscalls count for TCP connection.
+static const size_t DEFAULT_SERVER_BUFFER_SIZE = 64 * 1024;
+
+// Low memory footprint profile for embedded devices, budgets are documented in docs/embedded-profile.md.
+#ifdef NCDB_EMBEDDED_PROFILE
+static const bool DEFAULT_EMBEDDED_PROFILE = true;
+#else
+static const bool DEFAULT_EMBEDDED_PROFILE = false;
+#endif
+static const uint64_t EMBEDDED_RANGES_CACHE_SIZE = 8 * 1024 * 1024;
+static const uint64_t EMBEDDED_SNAPSHOTS_CACHE_SIZE = 8 * 1024 * 1024;
+static const size_t EMBEDDED_SOURCES_CACHE_SIZE = 256 * 1024;
+static const uint64_t EMBEDDED_SYMBOLS_MEMORY_LIMIT = 16 * 1024 * 1024;
+static const unsigned EMBEDDED_SYMBOLS_IDLE_TIMEOUT = 5; // minutes
+static const unsigned EMBEDDED_SOURCELINK_PREFETCH_FRAMES = 0;
+static const size_t EMBEDDED_SEQUENCE_POINTS_METHODS = 128;
 
 static void print_help()
 {
@@ -55,27 +87,95 @@ static void print_help()
         "Options:\n"
         "--buildinfo                           Print build info.\n"
         "--attach <process-id>                 Attach the debugger to the specified process id.\n"
+        "--dump <core-file>                    Open ELF core dump (createdump or kernel core file) for offline\n"
+        "                                      analysis, process can't be continued and evaluation is disabled.\n"
         "--interpreter=cli                     Runs the debugger with Command Line Interface. \n"
         "--interpreter=mi                      Puts the debugger into MI mode.\n"
         "--interpreter=vscode                  Puts the debugger into VS Code Debugger mode.\n"
+        "--interpreter=msgpack                 Puts the debugger into compact binary (MessagePack) protocol mode.\n"
+        "--mi-strict-order                     Disable pipelined execution of read-only MI commands with token,\n"
+        "                                      all results are provided in commands order.\n"
 #ifdef INTEROP_DEBUGGING
         "--interop-debugging                   Puts the debugger into interop (mixed) mode.\n"
 #endif
+        "--no-native-frames                    Don't show \"[Native Frames]\" placeholders in stack traces (ignored\n"
+        "                                      in interop mode), only managed frames are walked.\n"
         "--command=<file>                      Interpret commands file at the start.\n"
         "-ex \"<command>\"                       Execute command at the start\n"
+        "--batch                               Execute -ex and --command commands without interactive console\n"
+        "                                      and exit, output is buffered. Only supported by the CLI interpreter.\n"
+        "--batch-results=<file>                Write result of each batch command into file as JSON object per line.\n"
 #ifdef NCDB_DOTNET_STARTUP_HOOK
         "--hot-reload                          Enable Hot Reload feature.\n"
 #endif
         "--run                                 Run program without waiting commands\n"
         "--engineLogging[=<path to log file>]  Enable logging to VsDbg-UI or file for the engine.\n"
         "                                      Only supported by the VsCode interpreter.\n"
+        "--engineLoggingBinary=<path>          Enable engine logging to file in compact binary format, log\n"
+        "                                      could be converted to text by --decode-engine-log option.\n"
+        "--decode-engine-log=<path>            Print binary engine log as text and exit.\n"
         "--server[=port_num]                   Start the debugger listening for requests on the\n"
         "                                      specified TCP/IP port instead of stdin/out. If port is not specified\n"
         "                                      TCP %i will be used.\n"
+        "--server=unix:<path>                  Start the debugger listening for requests on the Unix domain socket\n"
+        "                                      with specified path instead of stdin/out.\n"
+        "--server-buffer-size=<KiB>            Size of input and output buffers for TCP/IP connection, %u KiB by default.\n"
+        "--server-socket-buffer-size=<KiB>     Size of socket send and receive buffers, system default by default.\n"
+#ifdef SERVER_COMPRESSION
+        "--server-compression                  Server mode only: accept deflate compression of TCP/IP connection, in case\n"
+        "                                      client requests it before protocol data (see docs/compression.md).\n"
+#endif
+        "--multi-session                       Server mode only: don't exit after session end and accept next\n"
+        "                                      TCP/IP connection, runtime and managed part are initialized once.\n"
+        "--max-sessions=<N>                    Multi-session mode only: serve up to N sessions (connections) at once,\n"
+        "                                      each one debugs own process. 1 by default (sessions are served one by one).\n"
+        "--no-ranges-cache                     Disable on-disk methods ranges cache.\n"
+        "--ranges-cache-dir=<path>             Directory for methods ranges cache (temp directory by default), directory\n"
+        "                                      could be shared by debugger instances on host.\n"
+        "--ranges-cache-size=<MiB>             Maximum methods ranges cache size, %i MiB by default.\n"
+        "--no-breakpoints-cache                Disable on-disk cache of line breakpoints resolve results, that used for\n"
+        "                                      breakpoints activation at module load in next debug sessions.\n"
+        "--breakpoints-cache-dir=<path>        Directory for breakpoints cache (temp directory by default).\n"
+        "--no-snapshots-cache                  Disable on-disk cache of modules data (JMC, async methods and metadata\n"
+        "                                      index), that stored at debug session end and used by next sessions.\n"
+        "--snapshots-cache-dir=<path>          Directory for modules snapshots cache (temp directory by default).\n"
         "--log[=<type>]                        Enable logging. Supported logging to file and to dlog (only for Tizen)\n"
         "                                      File log by default. File is created in 'current' folder.\n"
+        "--log-level=<level>                   Minimal log level: debug, info, warning, error or fatal.\n"
+        "--perf-counters[=<seconds>]           Enable performance counters, optionally write them into log\n"
+        "                                      with provided interval (in seconds).\n"
+        "--trace-events[=<file>]               Record debugger internal activity timelines, optionally write them\n"
+        "                                      into file in Chrome trace JSON format at exit.\n"
+        "--output-window=<milliseconds>        Debuggee output merge time window (VSCode only), %u ms by default.\n"
+        "--output-window-size=<KiB>            Debuggee output merge size window (VSCode only), %u KiB by default.\n"
+        "--output-rate-limit=<KiB/s>           Debuggee output rate limit (VSCode only), exceeded output is dropped.\n"
+        "--events-window=<milliseconds>        Module and breakpoint events batch time window (VSCode only),\n"
+        "                                      %u ms by default, 0 for no batching.\n"
+        "--sources-cache-size=<KiB>            Maximum size of source files cached for 'list' command (CLI only),\n"
+        "                                      %u KiB by default.\n"
+        "--symbols-memory-limit=<MiB>          Soft limit for loaded symbols (PDB) memory, symbols of modules without\n"
+        "                                      breakpoints and recent use are unloaded and loaded again on demand.\n"
+        "--symbols-idle-timeout=<minutes>      Unload symbols (PDB) of modules without breakpoints and symbols access\n"
+        "                                      during timeout, symbols are loaded again on demand.\n"
+        "--symbol-server=<url>                 Symbol server for PDB download in background for modules without symbols,\n"
+        "                                      could be provided several times.\n"
+        "--symbol-cache=<path>                 Directory for downloaded symbols (temp directory by default), directory\n"
+        "                                      could be shared by debugger instances on host.\n"
+        "--sourcelink[=<frames>]               Download sources missed on disk by SourceLink, sources for top frames\n"
+        "                                      are prefetched at stop, %u frames by default, 0 for no prefetch.\n"
+        "--profile=<name>                      Resources profile: 'standard' or 'embedded' (low memory footprint for\n"
+        "                                      embedded devices, see docs/embedded-profile.md), '%s' by default.\n"
+        "                                      Profile change defaults only, cache and symbols options override it.\n"
         "--version                             Displays the current version.\n",
-        (int)DEFAULT_SERVER_PORT
+        (int)DEFAULT_SERVER_PORT,
+        (unsigned)(DEFAULT_SERVER_BUFFER_SIZE / 1024),
+        (int)(MethodRangesCache::DefaultMaxSize / (1024 * 1024)),
+        OutputCoalescer::Options().windowMs,
+        (unsigned)(OutputCoalescer::Options().windowSize / 1024),
+        EventCoalescer::Options().windowMs,
+        (unsigned)(SourceStorage::DefaultMaxSize / 1024),
+        SourceLinkCache::DefaultPrefetchFrames,
+        DEFAULT_EMBEDDED_PROFILE ? "embedded" : "standard"
     );
 }
 
@@ -106,6 +206,7 @@ template <typename ProtocolType> struct ProtocolDetails { static const char name
 template <> const char ProtocolDetails<MIProtocol>::name[] = "MIProtocol";
 template <> const char ProtocolDetails<VSCodeProtocol>::name[] = "VSCodeProtocol";
 template <> const char ProtocolDetails<CLIProtocol>::name[] = "CLIProtocol";
+template <> const char ProtocolDetails<CompactProtocol>::name[] = "CompactProtocol";
 
 // argument needed for protocol creation
 using Streams = std::pair<std::istream&, std::ostream&>;
@@ -132,18 +233,50 @@ ProtocolHolder instantiate_protocol<CLIProtocol>(Streams streams)
 
 // function creates pair of input/output streams for debugger protocol
 template <typename Holder>
-Streams open_streams(Holder& holder, unsigned server_port, ProtocolConstructor constructor)
+Streams open_streams(Holder& holder, unsigned server_port, const std::string &server_unix_socket, const IOSystem::FileHandle &server_socket,
+                     size_t server_buffer_size, size_t server_socket_buffer_size, bool server_compression, ProtocolConstructor constructor)
 {
-    if (server_port != 0)
+    if (server_port != 0 || !server_unix_socket.empty())
     {
-        IOSystem::FileHandle socket = IOSystem::listen_socket(server_port);
+        // Note, in multi-session mode listening socket is opened once, only connection is accepted for each session.
+        IOSystem::FileHandle socket;
+        if (server_socket)
+            socket = IOSystem::accept_socket(server_socket);
+        else if (server_port != 0)
+            socket = IOSystem::listen_socket(server_port);
+        else
+        {
+            IOSystem::FileHandle listenSocket = IOSystem::server_unix_socket(server_unix_socket);
+            if (listenSocket)
+            {
+                socket = IOSystem::accept_socket(listenSocket);
+                IOSystem::close(listenSocket);
+            }
+            // Note, only one connection is accepted, socket file is not needed anymore.
+            remove(server_unix_socket.c_str());
+        }
+
         if (! socket)
         {
-            fprintf(stderr, "can't open listening socket for port %u\n", server_port);
+            if (server_port != 0)
+                fprintf(stderr, "can't open listening socket for port %u\n", server_port);
+            else
+                fprintf(stderr, "can't open listening socket %s\n", server_unix_socket.c_str());
             exit(EXIT_FAILURE);
         }
 
-        std::iostream *stream = new IOStream(StreamBuf(socket));
+        // Note, protocol messages are small and request/response based, Nagle's algorithm only add latency here.
+        IOSystem::tune_socket(socket, server_socket_buffer_size);
+
+        std::iostream *stream = new IOStream(StreamBuf(socket, server_buffer_size));
+#ifdef SERVER_COMPRESSION
+        // Note, negotiation waits for first client's data, so, it's enabled by option only: MI client may wait for
+        // debugger's prompt first.
+        if (server_compression && StreamCompression::Negotiate(*stream->rdbuf()))
+            stream = new CompressedStream(std::unique_ptr<std::iostream>(stream), server_buffer_size);
+#else
+        (void)server_compression;
+#endif
         holder.push_back(typename Holder::value_type{stream});
         return {*stream, *stream};
     }
@@ -186,7 +319,8 @@ static void FindAndParseArgs(char **argv, std::vector<std::pair<std::string, std
 }
 
 static void CheckStartOptions(ProtocolConstructor &protocol_constructor, std::vector<string_view> &initCommands,
-                              char* argv[], std::string &execFile, bool run, uint16_t serverPort)
+                              char* argv[], std::string &execFile, bool run, bool serverMode,
+                              bool multiSession, DWORD pidDebuggee, const std::string &dumpPath)
 {
     if (protocol_constructor != &instantiate_protocol<CLIProtocol> && !initCommands.empty())
     {
@@ -200,11 +334,23 @@ static void CheckStartOptions(ProtocolConstructor &protocol_constructor, std::ve
         exit(EXIT_FAILURE);
     }
 
-    if (protocol_constructor == &instantiate_protocol<CLIProtocol> && serverPort)
+    if (protocol_constructor == &instantiate_protocol<CLIProtocol> && serverMode)
     {
         fprintf(stderr, "server mode can't be used with CLI interpreter!\n");
         exit(EXIT_FAILURE);
     }
+
+    if (multiSession && (!serverMode || run || pidDebuggee != 0))
+    {
+        fprintf(stderr, "--multi-session option can be used only in server mode, without --run and --attach options!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (!dumpPath.empty() && (run || pidDebuggee != 0 || multiSession))
+    {
+        fprintf(stderr, "--dump option can't be used with --run, --attach and --multi-session options!\n");
+        exit(EXIT_FAILURE);
+    }
 }
 
 static HRESULT AttachToExistingProcess(IDebugger *pDebugger, DWORD pidDebuggee)
@@ -215,6 +361,14 @@ static HRESULT AttachToExistingProcess(IDebugger *pDebugger, DWORD pidDebuggee)
     return pDebugger->ConfigurationDone();
 }
 
+static HRESULT OpenDumpFile(IDebugger *pDebugger, const std::string &dumpPath)
+{
+    HRESULT Status;
+    IfFailRet(pDebugger->Initialize());
+    IfFailRet(pDebugger->OpenDump(dumpPath));
+    return pDebugger->ConfigurationDone();
+}
+
 static HRESULT LaunchNewProcess(IDebugger *pDebugger, std::string &execFile, std::vector<std::string> &execArgs)
 {
     HRESULT Status;
@@ -241,6 +395,7 @@ int
 {
 
     DWORD pidDebuggee = 0;
+    std::string dumpPath;
     // prevent std::cout flush triggered by read operation on std::cin
     std::cin.tie(nullptr);
 
@@ -252,10 +407,13 @@ int
 #endif
 
     bool engineLogging = false;
+    bool engineLoggingBinary = false;
     std::string logFilePath;
 
     std::vector<std::string> initTexts;
     std::vector<string_view> initCommands;
+    bool batchMode = false;
+    std::string batchResults;
 
     uint16_t serverPort = 0;
 
@@ -264,7 +422,37 @@ int
 
     bool needHotReload = false;
     bool needInteropDebugging = false;
+    bool nativeFramePlaceholders = true;
     bool run = false;
+    bool multiSession = false;
+    unsigned maxSessions = 1;
+
+    bool rangesCacheEnabled = true;
+    std::string rangesCacheDir;
+    uint64_t rangesCacheSize = MethodRangesCache::DefaultMaxSize;
+    bool breakpointsCacheEnabled = true;
+    std::string breakpointsCacheDir;
+    bool snapshotsCacheEnabled = true;
+    std::string snapshotsCacheDir;
+    uint64_t snapshotsCacheSize = ModuleSnapshotCache::DefaultMaxSize;
+    size_t sequencePointsMethods = SequencePointsCache::DefaultMaxMethods;
+
+    unsigned perfCountersLogInterval = 0;
+    OutputCoalescer::Options outputOptions;
+    EventCoalescer::Options eventsOptions;
+    bool miStrictOrder = false;
+    size_t sourcesCacheSize = SourceStorage::DefaultMaxSize;
+    uint64_t symbolsMemoryLimit = 0;
+    unsigned symbolsIdleTimeout = 0;
+    std::string symbolServers;
+    std::string symbolCacheDir;
+    bool sourceLink = false;
+    unsigned sourceLinkPrefetchFrames = SourceLinkCache::DefaultPrefetchFrames;
+    size_t serverBufferSize = DEFAULT_SERVER_BUFFER_SIZE;
+    size_t serverSocketBufferSize = 0;
+    bool serverCompression = false;
+    // Note, Unix domain socket is used instead of TCP/IP port, in case path provided.
+    std::string serverUnixSocket;
 
     std::unordered_map<std::string, std::function<void(int& i)>> entireArguments
     {
@@ -284,6 +472,17 @@ int
                 exit(EXIT_FAILURE);
             }
 
+        } },
+        {"--dump", [&](int& i){
+
+            i++;
+            if (i >= argc)
+            {
+                fprintf(stderr, "Error: Missing dump file\n");
+                exit(EXIT_FAILURE);
+            }
+            dumpPath = argv[i];
+
         } },
         { "--interpreter=mi", [&](int& i){
 
@@ -294,6 +493,11 @@ int
 
             protocol_constructor = &instantiate_protocol<VSCodeProtocol>;
 
+        } },
+        { "--interpreter=msgpack", [&](int& i){
+
+            protocol_constructor = &instantiate_protocol<CompactProtocol>;
+
         } },
         { "--interpreter=cli", [&](int& i){
 
@@ -304,16 +508,51 @@ int
 
             needInteropDebugging = true;
 
+        } },
+        { "--no-native-frames", [&](int& i){
+
+            nativeFramePlaceholders = false;
+
         } },
         { "--hot-reload", [&](int& i){
 
             needHotReload = true;
 
+        } },
+        { "--mi-strict-order", [&](int& i){
+
+            miStrictOrder = true;
+
+        } },
+        { "--no-ranges-cache", [&](int& i){
+
+            rangesCacheEnabled = false;
+
+        } },
+        { "--no-breakpoints-cache", [&](int& i){
+
+            breakpointsCacheEnabled = false;
+
+        } },
+        { "--no-snapshots-cache", [&](int& i){
+
+            snapshotsCacheEnabled = false;
+
+        } },
+        { "--sourcelink", [&](int& i){
+
+            sourceLink = true;
+
         } },
         { "--run", [&](int& i){
 
             run = true;
 
+        } },
+        { "--batch", [&](int& i){
+
+            batchMode = true;
+
         } },
         { "-ex", [&](int& i){
 
@@ -369,12 +608,34 @@ int
             snprintf(tmp, sizeof(tmp), "%.*s/%s.%u.log", int(tempdir.size()), tempdir.data(), s, getpid());
             setenv("LOG_OUTPUT", tmp, 1);
 
+        } },
+        { "--perf-counters", [&](int& i){
+
+            PerfCounters::Enable(true);
+
+        } },
+        { "--trace-events", [&](int& i){
+
+            TraceRecorder::Enable(true);
+
         } },
         { "--server", [&](int& i){
 
             serverPort = DEFAULT_SERVER_PORT;
 
         } },
+        { "--multi-session", [&](int& i){
+
+            multiSession = true;
+
+        } },
+#ifdef SERVER_COMPRESSION
+        { "--server-compression", [&](int& i){
+
+            serverCompression = true;
+
+        } },
+#endif
         { "--", [&](int& i){
 
             ++i;
@@ -396,6 +657,19 @@ int
 
     std::vector<std::pair<std::string, std::function<void(int& i)>>> partialArguments
     {
+        // Note, profile is applied before options parsing.
+        { "--profile=", [&](int& i){} },
+        { "--batch-results=", [&](int& i){
+
+            batchMode = true;
+            batchResults = argv[i] + strlen("--batch-results=");
+            if (batchResults.empty())
+            {
+                fprintf(stderr, "Error: Missing batch results file path\n");
+                exit(EXIT_FAILURE);
+            }
+
+        } },
         { "--command=", [&](int& i){
 
             initTexts.push_back(std::string() + "source " + (strchr(argv[i], '=') + 1));
@@ -407,16 +681,211 @@ int
             engineLogging = true;
             logFilePath = argv[i] + strlen("--engineLogging=");
 
+        } },
+        { "--engineLoggingBinary=", [&](int& i){
+
+            engineLogging = true;
+            engineLoggingBinary = true;
+            logFilePath = argv[i] + strlen("--engineLoggingBinary=");
+            if (logFilePath.empty())
+            {
+                fprintf(stderr, "Error: Missing binary engine log file path\n");
+                exit(EXIT_FAILURE);
+            }
+
+        } },
+        { "--decode-engine-log=", [&](int& i){
+
+            std::ifstream input(argv[i] + strlen("--decode-engine-log="), std::ios::in | std::ios::binary);
+            if (!input)
+            {
+                fprintf(stderr, "Error: Can't open binary engine log file\n");
+                exit(EXIT_FAILURE);
+            }
+            if (!DecodeEngineLog(input, std::cout))
+            {
+                std::cout.flush();
+                fprintf(stderr, "Error: Wrong binary engine log format or truncated record\n");
+                exit(EXIT_FAILURE);
+            }
+            std::cout.flush();
+            exit(EXIT_SUCCESS);
+
         } },
         { "--log=", [&](int& i){
 
             setenv("LOG_OUTPUT", *argv + strlen("--log="), 1);
 
+        } },
+        { "--log-level=", [&](int& i){
+
+            setenv("LOG_LEVEL", argv[i] + strlen("--log-level="), 1);
+
+        } },
+        { "--ranges-cache-dir=", [&](int& i){
+
+            rangesCacheDir = argv[i] + strlen("--ranges-cache-dir=");
+
+        } },
+        { "--breakpoints-cache-dir=", [&](int& i){
+
+            breakpointsCacheDir = argv[i] + strlen("--breakpoints-cache-dir=");
+
+        } },
+        { "--snapshots-cache-dir=", [&](int& i){
+
+            snapshotsCacheDir = argv[i] + strlen("--snapshots-cache-dir=");
+
+        } },
+        { "--ranges-cache-size=", [&](int& i){
+
+            char *err;
+            rangesCacheSize = strtoull(argv[i] + strlen("--ranges-cache-size="), &err, 10) * 1024 * 1024;
+            if (*err != 0)
+            {
+                fprintf(stderr, "Error: Wrong methods ranges cache size\n");
+                exit(EXIT_FAILURE);
+            }
+
+        } },
+        { "--trace-events=", [&](int& i){
+
+            TraceRecorder::Enable(true);
+            TraceRecorder::WriteAtExit(argv[i] + strlen("--trace-events="));
+
+        } },
+        { "--perf-counters=", [&](int& i){
+
+            char *err;
+            perfCountersLogInterval = strtoul(argv[i] + strlen("--perf-counters="), &err, 10);
+            if (*err != 0)
+            {
+                fprintf(stderr, "Error: Wrong performance counters log interval\n");
+                exit(EXIT_FAILURE);
+            }
+            PerfCounters::Enable(true);
+
+        } },
+        { "--output-window=", [&](int& i){
+
+            char *err;
+            outputOptions.windowMs = strtoul(argv[i] + strlen("--output-window="), &err, 10);
+            if (*err != 0)
+            {
+                fprintf(stderr, "Error: Wrong output window\n");
+                exit(EXIT_FAILURE);
+            }
+
+        } },
+        { "--output-window-size=", [&](int& i){
+
+            char *err;
+            outputOptions.windowSize = strtoul(argv[i] + strlen("--output-window-size="), &err, 10) * 1024;
+            if (*err != 0)
+            {
+                fprintf(stderr, "Error: Wrong output window size\n");
+                exit(EXIT_FAILURE);
+            }
+
+        } },
+        { "--output-rate-limit=", [&](int& i){
+
+            char *err;
+            outputOptions.rateLimit = strtoul(argv[i] + strlen("--output-rate-limit="), &err, 10) * 1024;
+            if (*err != 0)
+            {
+                fprintf(stderr, "Error: Wrong output rate limit\n");
+                exit(EXIT_FAILURE);
+            }
+
+        } },
+        { "--events-window=", [&](int& i){
+
+            char *err;
+            eventsOptions.windowMs = strtoul(argv[i] + strlen("--events-window="), &err, 10);
+            if (*err != 0)
+            {
+                fprintf(stderr, "Error: Wrong events window\n");
+                exit(EXIT_FAILURE);
+            }
+
+        } },
+        { "--sources-cache-size=", [&](int& i){
+
+            char *err;
+            sourcesCacheSize = strtoul(argv[i] + strlen("--sources-cache-size="), &err, 10) * 1024;
+            if (*err != 0)
+            {
+                fprintf(stderr, "Error: Wrong sources cache size\n");
+                exit(EXIT_FAILURE);
+            }
+
+        } },
+        { "--symbols-memory-limit=", [&](int& i){
+
+            char *err;
+            symbolsMemoryLimit = strtoull(argv[i] + strlen("--symbols-memory-limit="), &err, 10) * 1024 * 1024;
+            if (*err != 0)
+            {
+                fprintf(stderr, "Error: Wrong symbols memory limit\n");
+                exit(EXIT_FAILURE);
+            }
+
+        } },
+        { "--symbols-idle-timeout=", [&](int& i){
+
+            char *err;
+            symbolsIdleTimeout = strtoul(argv[i] + strlen("--symbols-idle-timeout="), &err, 10);
+            if (*err != 0)
+            {
+                fprintf(stderr, "Error: Wrong symbols idle timeout\n");
+                exit(EXIT_FAILURE);
+            }
+
+        } },
+        { "--symbol-server=", [&](int& i){
+
+            if (!symbolServers.empty())
+                symbolServers += ';';
+            symbolServers += argv[i] + strlen("--symbol-server=");
+
+        } },
+        { "--sourcelink=", [&](int& i){
+
+            char *err;
+            sourceLink = true;
+            sourceLinkPrefetchFrames = strtoul(argv[i] + strlen("--sourcelink="), &err, 10);
+            if (*err != 0)
+            {
+                fprintf(stderr, "Error: Wrong SourceLink prefetch frames count\n");
+                exit(EXIT_FAILURE);
+            }
+
+        } },
+        { "--symbol-cache=", [&](int& i){
+
+            symbolCacheDir = argv[i] + strlen("--symbol-cache=");
+
         } },
         { "--server=", [&](int& i){
 
+            static const char unixPrefix[] = "unix:";
+            const char *value = argv[i] + strlen("--server=");
+            if (strncmp(value, unixPrefix, sizeof(unixPrefix) - 1) == 0)
+            {
+                serverPort = 0;
+                serverUnixSocket = value + sizeof(unixPrefix) - 1;
+                if (serverUnixSocket.empty())
+                {
+                    fprintf(stderr, "Error: Missing unix socket path\n");
+                    exit(EXIT_FAILURE);
+                }
+                return;
+            }
+
             char *err;
-            serverPort = static_cast<uint16_t>(strtoul(argv[i] + strlen("--server="), &err, 10));
+            serverUnixSocket.clear();
+            serverPort = static_cast<uint16_t>(strtoul(value, &err, 10));
             if (*err != 0)
             {
                 fprintf(stderr, "Error: Missing process id\n");
@@ -424,8 +893,71 @@ int
             }
 
         } },
+        { "--max-sessions=", [&](int& i){
+
+            char *err;
+            maxSessions = strtoul(argv[i] + strlen("--max-sessions="), &err, 10);
+            if (*err != 0 || maxSessions == 0)
+            {
+                fprintf(stderr, "Error: Wrong sessions count\n");
+                exit(EXIT_FAILURE);
+            }
+
+        } },
+        { "--server-buffer-size=", [&](int& i){
+
+            char *err;
+            serverBufferSize = strtoul(argv[i] + strlen("--server-buffer-size="), &err, 10) * 1024;
+            if (*err != 0 || serverBufferSize == 0)
+            {
+                fprintf(stderr, "Error: Wrong server buffer size\n");
+                exit(EXIT_FAILURE);
+            }
+
+        } },
+        { "--server-socket-buffer-size=", [&](int& i){
+
+            char *err;
+            serverSocketBufferSize = strtoul(argv[i] + strlen("--server-socket-buffer-size="), &err, 10) * 1024;
+            if (*err != 0 || serverSocketBufferSize == 0)
+            {
+                fprintf(stderr, "Error: Wrong server socket buffer size\n");
+                exit(EXIT_FAILURE);
+            }
+
+        } },
     };
 
+    // Note, profile change defaults only, so, it's applied before other options (in any order), that override profile values.
+    bool embeddedProfile = DEFAULT_EMBEDDED_PROFILE;
+    for (int i = 1; i < argc && strcmp(argv[i], "--") != 0; i++)
+    {
+        static const char profileOption[] = "--profile=";
+        if (strncmp(argv[i], profileOption, sizeof(profileOption) - 1) != 0)
+            continue;
+
+        const char *profile = argv[i] + sizeof(profileOption) - 1;
+        if (strcmp(profile, "embedded") == 0)
+            embeddedProfile = true;
+        else if (strcmp(profile, "standard") == 0)
+            embeddedProfile = false;
+        else
+        {
+            fprintf(stderr, "Error: Unknown profile %s\n", profile);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (embeddedProfile)
+    {
+        rangesCacheSize = EMBEDDED_RANGES_CACHE_SIZE;
+        snapshotsCacheSize = EMBEDDED_SNAPSHOTS_CACHE_SIZE;
+        sourcesCacheSize = EMBEDDED_SOURCES_CACHE_SIZE;
+        symbolsMemoryLimit = EMBEDDED_SYMBOLS_MEMORY_LIMIT;
+        symbolsIdleTimeout = EMBEDDED_SYMBOLS_IDLE_TIMEOUT;
+        sourceLinkPrefetchFrames = EMBEDDED_SOURCELINK_PREFETCH_FRAMES;
+        sequencePointsMethods = EMBEDDED_SEQUENCE_POINTS_METHODS;
+    }
+
     for (int i = 1; i < argc; i++)
     {
         auto args = entireArguments.find(std::string(argv[i]));
@@ -439,91 +971,228 @@ int
         }
     }
 
-    CheckStartOptions(protocol_constructor, initCommands, argv, execFile, run, serverPort);
+    const bool serverMode = serverPort != 0 || !serverUnixSocket.empty();
+    CheckStartOptions(protocol_constructor, initCommands, argv, execFile, run, serverMode, multiSession, pidDebuggee, dumpPath);
 
-    LOGI("Netcoredbg started");
-    // Note: there is no possibility to know which exception caused call to std::terminate
-    std::set_terminate([]{ LOGF("Netcoredbg is terminated due to call to std::terminate: see stderr..."); });
-
-    std::vector<std::unique_ptr<std::ios_base> > streams;
-    std::shared_ptr<IProtocol> protocol = protocol_constructor(open_streams(streams, serverPort, protocol_constructor));
-
-    if (engineLogging)
+    if (batchMode && protocol_constructor != &instantiate_protocol<CLIProtocol>)
     {
-        auto p = dynamic_cast<VSCodeProtocol*>(protocol.get());
-        if (!p)
-        {
-            fprintf(stderr, "Error: Engine logging is only supported in VsCode interpreter mode.\n");
-            LOGE("Engine logging is only supported in VsCode interpreter mode.");
-            exit(EXIT_FAILURE);
-        }
-
-        p->EngineLogging(logFilePath);
+        fprintf(stderr, "%s: option --batch can be used only with CLI interpreter!\n", argv[0]);
+        exit(EXIT_FAILURE);
     }
 
-    std::shared_ptr<IDebugger> debugger;
-    try
+    if (maxSessions > 1 && (!multiSession || needInteropDebugging))
     {
-        debugger.reset(new ManagedDebugger(protocol.get()));
+        fprintf(stderr, "--max-sessions option can be used only in multi-session mode, without --interop-debugging option!\n");
+        exit(EXIT_FAILURE);
     }
-    catch (const std::exception &e)
+
+    if (serverCompression && !serverMode)
     {
-        fprintf(stderr, "%s\n", e.what());
+        fprintf(stderr, "--server-compression option can be used only in server mode!\n");
         exit(EXIT_FAILURE);
     }
 
-    protocol->SetDebugger(debugger);
-    if (needHotReload)
+    MethodRangesCache::SetOptions(rangesCacheEnabled, rangesCacheDir, rangesCacheSize);
+    ResolvedBreakpointsCache::SetOptions(breakpointsCacheEnabled, breakpointsCacheDir);
+    ModuleSnapshotCache::SetOptions(snapshotsCacheEnabled, snapshotsCacheDir, snapshotsCacheSize);
+    SequencePointsCache::SetOptions(sequencePointsMethods);
+    SetNativeFramePlaceholders(nativeFramePlaceholders);
+    PerfCounters::StartPeriodicLog(perfCountersLogInterval);
+    TraceRecorder::SetThreadName("Main");
+
+    LOGI("Netcoredbg started, %s profile", embeddedProfile ? "embedded" : "standard");
+    // Note: there is no possibility to know which exception caused call to std::terminate
+    std::set_terminate([]{ LOGF("Netcoredbg is terminated due to call to std::terminate: see stderr..."); });
+
+    IOSystem::FileHandle serverSocket;
+    if (multiSession)
     {
-        if (pidDebuggee == 0)
-            debugger->SetHotReload(needHotReload);
-        else
-            fprintf(stderr, "Warning: Hot Reload can't be be enabled for attached process.\n");
+        serverSocket = serverUnixSocket.empty() ? IOSystem::server_socket(serverPort) : IOSystem::server_unix_socket(serverUnixSocket);
+        if (!serverSocket)
+        {
+            if (serverUnixSocket.empty())
+                fprintf(stderr, "can't open listening socket for port %u\n", serverPort);
+            else
+                fprintf(stderr, "can't open listening socket %s\n", serverUnixSocket.c_str());
+            exit(EXIT_FAILURE);
+        }
+        IOSystem::set_inherit(serverSocket, false);
     }
+
+    // Note, in multi-session mode each session have own protocol and debugger instances (with own ICorDebug instance and
+    // callbacks queue), but CoreCLR host, managed part (see Interop::Init()) and methods ranges cache are initialized by
+    // first session only and reused by all next sessions. By default sessions are served one by one and next clients wait
+    // in listening socket queue, with `--max-sessions` few sessions are served at once (for example, DAP child sessions
+    // for worker processes, see `ncdbg_startChildSession` request).
+    auto serveSession = [&](Streams sessionStreams) -> int
+    {
+        std::shared_ptr<IProtocol> protocol = protocol_constructor(sessionStreams);
+
+        if (engineLogging)
+        {
+            auto p = dynamic_cast<VSCodeProtocol*>(protocol.get());
+            if (!p)
+            {
+                fprintf(stderr, "Error: Engine logging is only supported in VsCode interpreter mode.\n");
+                LOGE("Engine logging is only supported in VsCode interpreter mode.");
+                exit(EXIT_FAILURE);
+            }
+
+            p->EngineLogging(logFilePath, engineLoggingBinary);
+        }
+
+        if (auto p = dynamic_cast<VSCodeProtocol*>(protocol.get()))
+        {
+            p->SetOutputOptions(outputOptions);
+            p->SetEventsOptions(eventsOptions);
+        }
+
+        if (auto p = dynamic_cast<MIProtocol*>(protocol.get()))
+            p->SetStrictOrder(miStrictOrder);
+
+        if (auto p = dynamic_cast<CLIProtocol*>(protocol.get()))
+            p->SetSourcesCacheSize(sourcesCacheSize);
+
+        std::shared_ptr<IDebugger> debugger;
+        try
+        {
+            debugger.reset(new ManagedDebugger(protocol.get()));
+        }
+        catch (const std::exception &e)
+        {
+            fprintf(stderr, "%s\n", e.what());
+            exit(EXIT_FAILURE);
+        }
+
+        protocol->SetDebugger(debugger);
+        debugger->SetSymbolsMemoryLimit(symbolsMemoryLimit);
+        debugger->SetSymbolsIdleTimeout(symbolsIdleTimeout);
+        debugger->SetSymbolServers(symbolServers, symbolCacheDir);
+        debugger->SetSourceLink(sourceLink, sourceLinkPrefetchFrames);
+
+        // Note, CLI prints debuggee output as is, so, in case CLI use stdout, output could be forwarded directly.
+        if (!serverMode && dynamic_cast<CLIProtocol*>(protocol.get()))
+            debugger->SetOutputPassthrough();
+
+        if (needHotReload)
+        {
+            if (pidDebuggee == 0)
+                debugger->SetHotReload(needHotReload);
+            else
+                fprintf(stderr, "Warning: Hot Reload can't be be enabled for attached process.\n");
+        }
 #ifdef INTEROP_DEBUGGING
-    // In case of interop debugging we depend on SIGCHLD set to SIG_DFL by init code.
-    // Note, debugger include corhost (CoreCLR) that could setup sigaction for SIGCHLD and ruin interop debugger work.
-    SetSigactionMode(needInteropDebugging);
-    debugger->SetInteropDebugging(needInteropDebugging);
+        // In case of interop debugging we depend on SIGCHLD set to SIG_DFL by init code.
+        // Note, debugger include corhost (CoreCLR) that could setup sigaction for SIGCHLD and ruin interop debugger work.
+        SetSigactionMode(needInteropDebugging);
+        debugger->SetInteropDebugging(needInteropDebugging);
 #endif
 
-    if (!execFile.empty())
-        protocol->SetLaunchCommand(execFile, execArgs);
+        if (!execFile.empty())
+            protocol->SetLaunchCommand(execFile, execArgs);
 
-    LOGI("pidDebugee %d", pidDebuggee);
-    HRESULT Status;
-    if (pidDebuggee != 0 && FAILED(Status = AttachToExistingProcess(debugger.get(), pidDebuggee)))
-    {
-        fprintf(stderr, "Error: 0x%x Failed to attach to %i\n", Status, pidDebuggee);
-        Interop::Shutdown();
-        return EXIT_FAILURE;
-    }
-    else if (run && FAILED(Status = LaunchNewProcess(debugger.get(), execFile, execArgs)))
-    {
-        fprintf(stderr, "Error: %#x %s\n", Status, errormessage(Status));
-        Interop::Shutdown();
-        return EXIT_FAILURE;
-    }
+        LOGI("pidDebugee %d", pidDebuggee);
+        HRESULT Status;
+        if (pidDebuggee != 0 && FAILED(Status = AttachToExistingProcess(debugger.get(), pidDebuggee)))
+        {
+            fprintf(stderr, "Error: 0x%x Failed to attach to %i\n", Status, pidDebuggee);
+            Interop::Shutdown();
+            return EXIT_FAILURE;
+        }
+        else if (run && FAILED(Status = LaunchNewProcess(debugger.get(), execFile, execArgs)))
+        {
+            fprintf(stderr, "Error: %#x %s\n", Status, errormessage(Status));
+            Interop::Shutdown();
+            return EXIT_FAILURE;
+        }
+        else if (!dumpPath.empty() && FAILED(Status = OpenDumpFile(debugger.get(), dumpPath)))
+        {
+            fprintf(stderr, "Error: %#x Failed to open dump %s\n", Status, dumpPath.c_str());
+            Interop::Shutdown();
+            return EXIT_FAILURE;
+        }
+
+        // switch CLIProtocol to asynchronous mode when attaching
+        auto cliProtocol = dynamic_cast<CLIProtocol*>(protocol.get());
+        if (cliProtocol)
+        {
+            if (pidDebuggee != 0)
+                cliProtocol->SetCommandMode(CLIProtocol::CommandMode::Asynchronous);
+
+            // inform CLIProtocol that process is already running
+            if (run || pidDebuggee)
+                cliProtocol->SetRunningState();
+
+            if (pidDebuggee != 0)
+                cliProtocol->Pause();
 
-    // switch CLIProtocol to asynchronous mode when attaching
-    auto cliProtocol = dynamic_cast<CLIProtocol*>(protocol.get());
-    if (cliProtocol)
+            if (batchMode)
+            {
+                if (!cliProtocol->SetBatchMode(batchResults))
+                {
+                    fprintf(stderr, "can't open batch results file %s\n", batchResults.c_str());
+                    return EXIT_FAILURE;
+                }
+                return SUCCEEDED(cliProtocol->ExecBatch({initCommands})) ? EXIT_SUCCESS : EXIT_FAILURE;
+            }
+
+            // run commands passed in command line via '-ex' option
+            cliProtocol->Source({initCommands});
+        }
+
+        protocol->CommandLoop();
+
+        if (multiSession)
+        {
+            // Note, client could close connection without `disconnect` request, don't leave debuggee for next session.
+            debugger->Disconnect();
+            LOGI("Session finished, waiting for next connection");
+        }
+
+        return EXIT_SUCCESS;
+    };
+
+    if (maxSessions > 1)
     {
-        if (pidDebuggee != 0)
-            cliProtocol->SetCommandMode(CLIProtocol::CommandMode::Asynchronous);
+        std::mutex sessionsMutex;
+        std::condition_variable sessionsCV;
+        unsigned activeSessions = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lockSessionsMutex(sessionsMutex);
+                sessionsCV.wait(lockSessionsMutex, [&]() { return activeSessions < maxSessions; });
+                activeSessions++;
+            }
 
-        // inform CLIProtocol that process is already running
-        if (run || pidDebuggee)
-            cliProtocol->SetRunningState();
+            std::shared_ptr<std::vector<std::unique_ptr<std::ios_base> > > streams(new std::vector<std::unique_ptr<std::ios_base> >());
+            Streams sessionStreams = open_streams(*streams, serverPort, serverUnixSocket, serverSocket, serverBufferSize,
+                                                   serverSocketBufferSize, serverCompression, protocol_constructor);
+            std::thread([&, streams, sessionStreams]()
+            {
+                serveSession(sessionStreams);
 
-        if (pidDebuggee != 0)
-            cliProtocol->Pause();
+                std::lock_guard<std::mutex> lockSessionsMutex(sessionsMutex);
+                activeSessions--;
+                sessionsCV.notify_one();
+            }).detach();
+        }
+    }
 
-        // run commands passed in command line via '-ex' option
-        cliProtocol->Source({initCommands});
+    do
+    {
+        std::vector<std::unique_ptr<std::ios_base> > streams;
+        int status = serveSession(open_streams(streams, serverPort, serverUnixSocket, serverSocket, serverBufferSize,
+                                               serverSocketBufferSize, serverCompression, protocol_constructor));
+        if (status != EXIT_SUCCESS)
+            return status;
     }
+    while (multiSession);
+
+    if (multiSession && !serverUnixSocket.empty())
+        remove(serverUnixSocket.c_str());
 
-    protocol->CommandLoop();
+    PerfCounters::StopPeriodicLog();
     Interop::Shutdown();
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -8,6 +8,7 @@ using System.Diagnostics;
 using System.Runtime.InteropServices;
 using Microsoft.CodeAnalysis;
 using Microsoft.CodeAnalysis.CSharp;
+using Microsoft.CodeAnalysis.CSharp.Syntax;
 using System.Text;
 
 namespace NetCoreDbg
@@ -118,25 +119,6 @@ namespace NetCoreDbg
             { typeof(ulong), ePredefinedType.ULongKeyword }
         };
 
-        static readonly Dictionary<SyntaxKind, ePredefinedType> TypeKindAlias = new Dictionary<SyntaxKind, ePredefinedType>
-        {
-            { SyntaxKind.BoolKeyword,    ePredefinedType.BoolKeyword },
-            { SyntaxKind.ByteKeyword,    ePredefinedType.ByteKeyword },
-            { SyntaxKind.CharKeyword,    ePredefinedType.CharKeyword },
-            { SyntaxKind.DecimalKeyword, ePredefinedType.DecimalKeyword },
-            { SyntaxKind.DoubleKeyword,  ePredefinedType.DoubleKeyword },
-            { SyntaxKind.FloatKeyword,   ePredefinedType.FloatKeyword },
-            { SyntaxKind.IntKeyword,     ePredefinedType.IntKeyword },
-            { SyntaxKind.LongKeyword,    ePredefinedType.LongKeyword },
-            { SyntaxKind.ObjectKeyword,  ePredefinedType.ObjectKeyword },
-            { SyntaxKind.SByteKeyword,   ePredefinedType.SByteKeyword },
-            { SyntaxKind.ShortKeyword,   ePredefinedType.ShortKeyword },
-            { SyntaxKind.StringKeyword,  ePredefinedType.StringKeyword },
-            { SyntaxKind.UShortKeyword,  ePredefinedType.UShortKeyword },
-            { SyntaxKind.UIntKeyword,    ePredefinedType.UIntKeyword },
-            { SyntaxKind.ULongKeyword,   ePredefinedType.ULongKeyword }
-        };
-
         public enum eOpCode
         {
             IdentifierName,
@@ -193,60 +175,123 @@ namespace NetCoreDbg
             ThisExpression
         }
 
-        static readonly Dictionary<SyntaxKind, eOpCode> KindAlias = new Dictionary<SyntaxKind, eOpCode>
+        // Note, Roslyn dependent data is moved out of Evaluation class static fields, since Evaluation class
+        // initialization must not load Microsoft.CodeAnalysis assemblies (CalculationDelegate don't need Roslyn).
+        // Roslyn assemblies are loaded only at first GenerateStackMachineProgram() call.
+        static class SyntaxAliases
+        {
+            internal static readonly Dictionary<SyntaxKind, ePredefinedType> TypeKindAlias = new Dictionary<SyntaxKind, ePredefinedType>
+            {
+                { SyntaxKind.BoolKeyword,    ePredefinedType.BoolKeyword },
+                { SyntaxKind.ByteKeyword,    ePredefinedType.ByteKeyword },
+                { SyntaxKind.CharKeyword,    ePredefinedType.CharKeyword },
+                { SyntaxKind.DecimalKeyword, ePredefinedType.DecimalKeyword },
+                { SyntaxKind.DoubleKeyword,  ePredefinedType.DoubleKeyword },
+                { SyntaxKind.FloatKeyword,   ePredefinedType.FloatKeyword },
+                { SyntaxKind.IntKeyword,     ePredefinedType.IntKeyword },
+                { SyntaxKind.LongKeyword,    ePredefinedType.LongKeyword },
+                { SyntaxKind.ObjectKeyword,  ePredefinedType.ObjectKeyword },
+                { SyntaxKind.SByteKeyword,   ePredefinedType.SByteKeyword },
+                { SyntaxKind.ShortKeyword,   ePredefinedType.ShortKeyword },
+                { SyntaxKind.StringKeyword,  ePredefinedType.StringKeyword },
+                { SyntaxKind.UShortKeyword,  ePredefinedType.UShortKeyword },
+                { SyntaxKind.UIntKeyword,    ePredefinedType.UIntKeyword },
+                { SyntaxKind.ULongKeyword,   ePredefinedType.ULongKeyword }
+            };
+
+            internal static readonly Dictionary<SyntaxKind, eOpCode> KindAlias = new Dictionary<SyntaxKind, eOpCode>
+            {
+                { SyntaxKind.IdentifierName,                eOpCode.IdentifierName },
+                { SyntaxKind.GenericName,                   eOpCode.GenericName },
+                { SyntaxKind.InvocationExpression,          eOpCode.InvocationExpression },
+                { SyntaxKind.ObjectCreationExpression,      eOpCode.ObjectCreationExpression },
+                { SyntaxKind.ElementAccessExpression,       eOpCode.ElementAccessExpression },
+                { SyntaxKind.ElementBindingExpression,      eOpCode.ElementBindingExpression },
+                { SyntaxKind.NumericLiteralExpression,      eOpCode.NumericLiteralExpression },
+                { SyntaxKind.StringLiteralExpression,       eOpCode.StringLiteralExpression },
+                { SyntaxKind.CharacterLiteralExpression,    eOpCode.CharacterLiteralExpression },
+                { SyntaxKind.PredefinedType,                eOpCode.PredefinedType },
+                { SyntaxKind.QualifiedName,                 eOpCode.QualifiedName },
+                { SyntaxKind.AliasQualifiedName,            eOpCode.AliasQualifiedName },
+                { SyntaxKind.MemberBindingExpression,       eOpCode.MemberBindingExpression },
+                { SyntaxKind.ConditionalExpression,         eOpCode.ConditionalExpression },
+                { SyntaxKind.SimpleMemberAccessExpression,  eOpCode.SimpleMemberAccessExpression },
+                { SyntaxKind.PointerMemberAccessExpression, eOpCode.PointerMemberAccessExpression },
+                { SyntaxKind.CastExpression,                eOpCode.CastExpression },
+                { SyntaxKind.AsExpression,                  eOpCode.AsExpression },
+                { SyntaxKind.AddExpression,                 eOpCode.AddExpression },
+                { SyntaxKind.MultiplyExpression,            eOpCode.MultiplyExpression },
+                { SyntaxKind.SubtractExpression,            eOpCode.SubtractExpression },
+                { SyntaxKind.DivideExpression,              eOpCode.DivideExpression },
+                { SyntaxKind.ModuloExpression,              eOpCode.ModuloExpression },
+                { SyntaxKind.LeftShiftExpression,           eOpCode.LeftShiftExpression },
+                { SyntaxKind.RightShiftExpression,          eOpCode.RightShiftExpression },
+                { SyntaxKind.BitwiseAndExpression,          eOpCode.BitwiseAndExpression },
+                { SyntaxKind.BitwiseOrExpression,           eOpCode.BitwiseOrExpression },
+                { SyntaxKind.ExclusiveOrExpression,         eOpCode.ExclusiveOrExpression },
+                { SyntaxKind.LogicalAndExpression,          eOpCode.LogicalAndExpression },
+                { SyntaxKind.LogicalOrExpression,           eOpCode.LogicalOrExpression },
+                { SyntaxKind.EqualsExpression,              eOpCode.EqualsExpression },
+                { SyntaxKind.NotEqualsExpression,           eOpCode.NotEqualsExpression },
+                { SyntaxKind.GreaterThanExpression,         eOpCode.GreaterThanExpression },
+                { SyntaxKind.LessThanExpression,            eOpCode.LessThanExpression },
+                { SyntaxKind.GreaterThanOrEqualExpression,  eOpCode.GreaterThanOrEqualExpression },
+                { SyntaxKind.LessThanOrEqualExpression,     eOpCode.LessThanOrEqualExpression },
+                { SyntaxKind.IsExpression,                  eOpCode.IsExpression },
+                { SyntaxKind.UnaryPlusExpression,           eOpCode.UnaryPlusExpression },
+                { SyntaxKind.UnaryMinusExpression,          eOpCode.UnaryMinusExpression },
+                { SyntaxKind.LogicalNotExpression,          eOpCode.LogicalNotExpression },
+                { SyntaxKind.BitwiseNotExpression,          eOpCode.BitwiseNotExpression },
+                { SyntaxKind.TrueLiteralExpression,         eOpCode.TrueLiteralExpression },
+                { SyntaxKind.FalseLiteralExpression,        eOpCode.FalseLiteralExpression },
+                { SyntaxKind.NullLiteralExpression,         eOpCode.NullLiteralExpression },
+                { SyntaxKind.PreIncrementExpression,        eOpCode.PreIncrementExpression },
+                { SyntaxKind.PostIncrementExpression,       eOpCode.PostIncrementExpression },
+                { SyntaxKind.PreDecrementExpression,        eOpCode.PreDecrementExpression },
+                { SyntaxKind.PostDecrementExpression,       eOpCode.PostDecrementExpression },
+                { SyntaxKind.SizeOfExpression,              eOpCode.SizeOfExpression },
+                { SyntaxKind.TypeOfExpression,              eOpCode.TypeOfExpression },
+                { SyntaxKind.CoalesceExpression,            eOpCode.CoalesceExpression },
+                { SyntaxKind.ThisExpression,                eOpCode.ThisExpression }
+            };
+
+            // Operations, which could be calculated at program generation in case all operands are literals.
+            internal static readonly Dictionary<SyntaxKind, OperationType> FoldingOperations = new Dictionary<SyntaxKind, OperationType>
+            {
+                { SyntaxKind.AddExpression,                 OperationType.AddExpression },
+                { SyntaxKind.SubtractExpression,            OperationType.SubtractExpression },
+                { SyntaxKind.MultiplyExpression,            OperationType.MultiplyExpression },
+                { SyntaxKind.DivideExpression,              OperationType.DivideExpression },
+                { SyntaxKind.ModuloExpression,              OperationType.ModuloExpression },
+                { SyntaxKind.RightShiftExpression,          OperationType.RightShiftExpression },
+                { SyntaxKind.LeftShiftExpression,           OperationType.LeftShiftExpression },
+                { SyntaxKind.BitwiseNotExpression,          OperationType.BitwiseNotExpression },
+                { SyntaxKind.LogicalAndExpression,          OperationType.LogicalAndExpression },
+                { SyntaxKind.LogicalOrExpression,           OperationType.LogicalOrExpression },
+                { SyntaxKind.ExclusiveOrExpression,         OperationType.ExclusiveOrExpression },
+                { SyntaxKind.BitwiseAndExpression,          OperationType.BitwiseAndExpression },
+                { SyntaxKind.BitwiseOrExpression,           OperationType.BitwiseOrExpression },
+                { SyntaxKind.LogicalNotExpression,          OperationType.LogicalNotExpression },
+                { SyntaxKind.EqualsExpression,              OperationType.EqualsExpression },
+                { SyntaxKind.NotEqualsExpression,           OperationType.NotEqualsExpression },
+                { SyntaxKind.LessThanExpression,            OperationType.LessThanExpression },
+                { SyntaxKind.GreaterThanExpression,         OperationType.GreaterThanExpression },
+                { SyntaxKind.LessThanOrEqualExpression,     OperationType.LessThanOrEqualExpression },
+                { SyntaxKind.GreaterThanOrEqualExpression,  OperationType.GreaterThanOrEqualExpression },
+                { SyntaxKind.UnaryPlusExpression,           OperationType.UnaryPlusExpression },
+                { SyntaxKind.UnaryMinusExpression,          OperationType.UnaryMinusExpression }
+            };
+        }
+
+        // Internal names (like `$exception`) are replaced in expression before parsing by placeholders with this prefix
+        // and restored by native part in IdentifierName and StringLiteralExpression (see ReplaceInternalNames()).
+        const string InternalNamesPrefix = "__INTERNAL_NCDB_";
+
+        // Literals types, that could be provided by constant folding.
+        static readonly HashSet<Type> FoldingResultTypes = new HashSet<Type>
         {
-            { SyntaxKind.IdentifierName,                eOpCode.IdentifierName },
-            { SyntaxKind.GenericName,                   eOpCode.GenericName },
-            { SyntaxKind.InvocationExpression,          eOpCode.InvocationExpression },
-            { SyntaxKind.ObjectCreationExpression,      eOpCode.ObjectCreationExpression },
-            { SyntaxKind.ElementAccessExpression,       eOpCode.ElementAccessExpression },
-            { SyntaxKind.ElementBindingExpression,      eOpCode.ElementBindingExpression },
-            { SyntaxKind.NumericLiteralExpression,      eOpCode.NumericLiteralExpression },
-            { SyntaxKind.StringLiteralExpression,       eOpCode.StringLiteralExpression },
-            { SyntaxKind.CharacterLiteralExpression,    eOpCode.CharacterLiteralExpression },
-            { SyntaxKind.PredefinedType,                eOpCode.PredefinedType },
-            { SyntaxKind.QualifiedName,                 eOpCode.QualifiedName },
-            { SyntaxKind.AliasQualifiedName,            eOpCode.AliasQualifiedName },
-            { SyntaxKind.MemberBindingExpression,       eOpCode.MemberBindingExpression },
-            { SyntaxKind.ConditionalExpression,         eOpCode.ConditionalExpression },
-            { SyntaxKind.SimpleMemberAccessExpression,  eOpCode.SimpleMemberAccessExpression },
-            { SyntaxKind.PointerMemberAccessExpression, eOpCode.PointerMemberAccessExpression },
-            { SyntaxKind.CastExpression,                eOpCode.CastExpression },
-            { SyntaxKind.AsExpression,                  eOpCode.AsExpression },
-            { SyntaxKind.AddExpression,                 eOpCode.AddExpression },
-            { SyntaxKind.MultiplyExpression,            eOpCode.MultiplyExpression },
-            { SyntaxKind.SubtractExpression,            eOpCode.SubtractExpression },
-            { SyntaxKind.DivideExpression,              eOpCode.DivideExpression },
-            { SyntaxKind.ModuloExpression,              eOpCode.ModuloExpression },
-            { SyntaxKind.LeftShiftExpression,           eOpCode.LeftShiftExpression },
-            { SyntaxKind.RightShiftExpression,          eOpCode.RightShiftExpression },
-            { SyntaxKind.BitwiseAndExpression,          eOpCode.BitwiseAndExpression },
-            { SyntaxKind.BitwiseOrExpression,           eOpCode.BitwiseOrExpression },
-            { SyntaxKind.ExclusiveOrExpression,         eOpCode.ExclusiveOrExpression },
-            { SyntaxKind.LogicalAndExpression,          eOpCode.LogicalAndExpression },
-            { SyntaxKind.LogicalOrExpression,           eOpCode.LogicalOrExpression },
-            { SyntaxKind.EqualsExpression,              eOpCode.EqualsExpression },
-            { SyntaxKind.NotEqualsExpression,           eOpCode.NotEqualsExpression },
-            { SyntaxKind.GreaterThanExpression,         eOpCode.GreaterThanExpression },
-            { SyntaxKind.LessThanExpression,            eOpCode.LessThanExpression },
-            { SyntaxKind.GreaterThanOrEqualExpression,  eOpCode.GreaterThanOrEqualExpression },
-            { SyntaxKind.LessThanOrEqualExpression,     eOpCode.LessThanOrEqualExpression },
-            { SyntaxKind.IsExpression,                  eOpCode.IsExpression },
-            { SyntaxKind.UnaryPlusExpression,           eOpCode.UnaryPlusExpression },
-            { SyntaxKind.UnaryMinusExpression,          eOpCode.UnaryMinusExpression },
-            { SyntaxKind.LogicalNotExpression,          eOpCode.LogicalNotExpression },
-            { SyntaxKind.BitwiseNotExpression,          eOpCode.BitwiseNotExpression },
-            { SyntaxKind.TrueLiteralExpression,         eOpCode.TrueLiteralExpression },
-            { SyntaxKind.FalseLiteralExpression,        eOpCode.FalseLiteralExpression },
-            { SyntaxKind.NullLiteralExpression,         eOpCode.NullLiteralExpression },
-            { SyntaxKind.PreIncrementExpression,        eOpCode.PreIncrementExpression },
-            { SyntaxKind.PostIncrementExpression,       eOpCode.PostIncrementExpression },
-            { SyntaxKind.PreDecrementExpression,        eOpCode.PreDecrementExpression },
-            { SyntaxKind.PostDecrementExpression,       eOpCode.PostDecrementExpression },
-            { SyntaxKind.SizeOfExpression,              eOpCode.SizeOfExpression },
-            { SyntaxKind.TypeOfExpression,              eOpCode.TypeOfExpression },
-            { SyntaxKind.CoalesceExpression,            eOpCode.CoalesceExpression },
-            { SyntaxKind.ThisExpression,                eOpCode.ThisExpression }
+            typeof(bool), typeof(char), typeof(string), typeof(int), typeof(uint), typeof(long), typeof(ulong),
+            typeof(float), typeof(double), typeof(decimal)
         };
 
         internal const int S_OK = 0;
@@ -258,6 +303,8 @@ namespace NetCoreDbg
             protected uint Flags;
             protected IntPtr argsStructPtr;
             public abstract IntPtr GetStructPtr();
+            // Literal value known at program generation (used for constant folding), null for other commands.
+            public object ConstantValue { get; set; }
         }
 
         public class NoOperandsCommand : ICommand
@@ -270,7 +317,7 @@ namespace NetCoreDbg
 
             public NoOperandsCommand(SyntaxKind kind, uint flags)
             {
-                OpCode = KindAlias[kind];
+                OpCode = SyntaxAliases.KindAlias[kind];
                 Flags = flags;
                 argsStructPtr = IntPtr.Zero;
             }
@@ -322,7 +369,7 @@ namespace NetCoreDbg
 
             public OneOperandCommand(SyntaxKind kind, uint flags, dynamic arg)
             {
-                OpCode = KindAlias[kind];
+                OpCode = SyntaxAliases.KindAlias[kind];
                 Flags = flags;
                 Argument = arg;
                 argsStructPtr = IntPtr.Zero;
@@ -399,7 +446,7 @@ namespace NetCoreDbg
 
             public TwoOperandCommand(SyntaxKind kind, uint flags, params dynamic[] args)
             {
-                OpCode = KindAlias[kind];
+                OpCode = SyntaxAliases.KindAlias[kind];
                 Flags = flags;
                 Arguments = args;
                 argsStructPtr = IntPtr.Zero;
@@ -468,9 +515,6 @@ namespace NetCoreDbg
 
         public class StackMachineProgram
         {
-            public static readonly int ProgramFinished = -1;
-            public static readonly int BeforeFirstCommand = -2;
-            public int CurrentPosition = BeforeFirstCommand;
             public List<ICommand> Commands = new List<ICommand>();
         }
 
@@ -561,10 +605,23 @@ namespace NetCoreDbg
                         */
 
                         case SyntaxKind.IdentifierName:
-                        case SyntaxKind.StringLiteralExpression:
                             stackMachineProgram.Commands.Add(new OneOperandCommand(node.Kind(), CurrentScopeFlags.Peek(), node.GetFirstToken().Value));
                             break;
 
+                        case SyntaxKind.StringLiteralExpression:
+                        case SyntaxKind.NumericLiteralExpression:
+                        case SyntaxKind.CharacterLiteralExpression: // 1 wchar
+                            AddLiteralCommand(node.GetFirstToken().Value, CurrentScopeFlags.Peek());
+                            break;
+
+                        case SyntaxKind.TrueLiteralExpression:
+                            AddLiteralCommand(true, CurrentScopeFlags.Peek());
+                            break;
+
+                        case SyntaxKind.FalseLiteralExpression:
+                            AddLiteralCommand(false, CurrentScopeFlags.Peek());
+                            break;
+
                         case SyntaxKind.GenericName:
                             // GenericName
                             //     \ TypeArgumentList
@@ -654,13 +711,8 @@ namespace NetCoreDbg
                             stackMachineProgram.Commands.Add(new OneOperandCommand(node.Kind(), CurrentScopeFlags.Peek(), ElementAccessArgs));
                             break;
 
-                        case SyntaxKind.NumericLiteralExpression:
-                        case SyntaxKind.CharacterLiteralExpression: // 1 wchar
-                            stackMachineProgram.Commands.Add(new TwoOperandCommand(node.Kind(), CurrentScopeFlags.Peek(), TypeAlias[node.GetFirstToken().Value.GetType()], node.GetFirstToken().Value));
-                            break;
-
                         case SyntaxKind.PredefinedType:
-                            stackMachineProgram.Commands.Add(new OneOperandCommand(node.Kind(), CurrentScopeFlags.Peek(), TypeKindAlias[node.GetFirstToken().Kind()]));
+                            stackMachineProgram.Commands.Add(new OneOperandCommand(node.Kind(), CurrentScopeFlags.Peek(), SyntaxAliases.TypeKindAlias[node.GetFirstToken().Kind()]));
                             break;
 
                         // skip, in case of stack machine program creation we don't use this kinds directly
@@ -678,8 +730,6 @@ namespace NetCoreDbg
                             break;
 
                         case SyntaxKind.SimpleMemberAccessExpression:
-                        case SyntaxKind.TrueLiteralExpression:
-                        case SyntaxKind.FalseLiteralExpression:
                         case SyntaxKind.NullLiteralExpression:
                         case SyntaxKind.ThisExpression:
                         case SyntaxKind.MemberBindingExpression:
@@ -724,7 +774,8 @@ namespace NetCoreDbg
 /*
                         case SyntaxKind.TypeOfExpression:
 */
-                            stackMachineProgram.Commands.Add(new NoOperandsCommand(node.Kind(), CurrentScopeFlags.Peek()));
+                            if (!FoldConstantExpression(node, CurrentScopeFlags.Peek()))
+                                stackMachineProgram.Commands.Add(new NoOperandsCommand(node.Kind(), CurrentScopeFlags.Peek()));
                             break;
 
                         default:
@@ -740,6 +791,82 @@ namespace NetCoreDbg
                 }
             }
 
+            void AddLiteralCommand(object value, uint flags)
+            {
+                ICommand command;
+                if (value is bool)
+                    command = new NoOperandsCommand((bool)value ? SyntaxKind.TrueLiteralExpression : SyntaxKind.FalseLiteralExpression, flags);
+                else if (value is string)
+                    command = new OneOperandCommand(SyntaxKind.StringLiteralExpression, flags, value);
+                else if (value is char)
+                    command = new TwoOperandCommand(SyntaxKind.CharacterLiteralExpression, flags, TypeAlias[typeof(char)], value);
+                else
+                    command = new TwoOperandCommand(SyntaxKind.NumericLiteralExpression, flags, TypeAlias[value.GetType()], value);
+
+                // Note, string with internal name placeholder is changed by native part, so, it can't be used for folding.
+                if (!(value is string) || !((string)value).Contains(InternalNamesPrefix))
+                    command.ConstantValue = value;
+
+                stackMachineProgram.Commands.Add(command);
+            }
+
+            // Calculate expression at program generation in case all operands are literals (`1024 * 1024`, `"abc".Length`),
+            // operands commands are replaced by result literal command.
+            // Note, literal command could be last command of sub-expression only in case sub-expression is this literal,
+            // so, last commands with constant values are exactly operands of current expression.
+            bool FoldConstantExpression(SyntaxNode node, uint flags)
+            {
+                var commands = stackMachineProgram.Commands;
+
+                if (node.Kind() == SyntaxKind.SimpleMemberAccessExpression)
+                {
+                    if (commands.Count < 2 ||
+                        commands[commands.Count - 1].OpCode != eOpCode.IdentifierName ||
+                        ((MemberAccessExpressionSyntax)node).Name.Identifier.ValueText != "Length")
+                        return false;
+
+                    string value = commands[commands.Count - 2].ConstantValue as string;
+                    if (value == null)
+                        return false;
+
+                    commands.RemoveRange(commands.Count - 2, 2);
+                    AddLiteralCommand(value.Length, flags);
+                    return true;
+                }
+
+                OperationType operation;
+                // Note, overflow in checked context is runtime error, calculation is left for program execution.
+                if (!SyntaxAliases.FoldingOperations.TryGetValue(node.Kind(), out operation) || (flags & ~maskChecked) != flagUnchecked)
+                    return false;
+
+                int operandsCount = node is PrefixUnaryExpressionSyntax ? 1 : 2;
+                if (commands.Count < operandsCount)
+                    return false;
+
+                object first = commands[commands.Count - operandsCount].ConstantValue;
+                object second = operandsCount == 2 ? commands[commands.Count - 1].ConstantValue : null;
+                if (first == null || (operandsCount == 2 && second == null))
+                    return false;
+
+                object result;
+                try
+                {
+                    result = operationTypesMap[operation](first, second);
+                }
+                catch
+                {
+                    // Errors (division by zero, operator not allowed for operands types, ...) must be reported at program execution.
+                    return false;
+                }
+
+                if (result == null || !FoldingResultTypes.Contains(result.GetType()))
+                    return false;
+
+                commands.RemoveRange(commands.Count - operandsCount, operandsCount);
+                AddLiteralCommand(result, flags);
+                return true;
+            }
+
 #if DEBUG_STACKMACHINE
             public string GenerateDebugText()
             {
@@ -844,22 +971,29 @@ namespace NetCoreDbg
             }
         }
 
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct stack_command_t
+        {
+            public int Command;
+            public IntPtr Arguments;
+        }
+
         /// <summary>
-        /// Return next stack program command and pointer to argument's structure.
+        /// Return all stack program commands with pointers to argument's structures in one memory block.
         /// Note, managed part will release Arguments unmanaged memory at object finalizer call after ReleaseStackMachineProgram() call.
-        /// Native part must not release Arguments memory, allocated by managed part in this method.
+        /// Native part must not release Arguments memory, allocated by managed part in this method, but must release Commands memory block.
         /// </summary>
         /// <param name="StackProgram">stack machine program handle returned by GenerateStackMachineProgram()</param>
-        /// <param name="Command">next stack machine program command return</param>
-        /// <param name="Arguments">pointer to Arguments unmanaged memory return</param>
+        /// <param name="Count">stack machine program commands count return</param>
+        /// <param name="Commands">pointer to unmanaged memory with stack_command_t array return</param>
         /// <param name="textOutput">BSTR with text information return</param>
         /// <returns>HResult code with execution status</returns>
-        internal static int NextStackCommand(IntPtr StackProgram, out int Command, out IntPtr Arguments, out IntPtr textOutput)
+        internal static int GetStackMachineProgramCommands(IntPtr StackProgram, out int Count, out IntPtr Commands, out IntPtr textOutput)
         {
             Debug.Assert(StackProgram != IntPtr.Zero);
 
-            Command = 0;
-            Arguments = IntPtr.Zero;
+            Count = 0;
+            Commands = IntPtr.Zero;
             textOutput = IntPtr.Zero;
 
             try
@@ -867,25 +1001,31 @@ namespace NetCoreDbg
                 GCHandle gch = GCHandle.FromIntPtr(StackProgram);
                 StackMachineProgram stackProgram = (StackMachineProgram)gch.Target;
 
-                if (stackProgram.CurrentPosition == StackMachineProgram.BeforeFirstCommand)
-                {
-                    stackProgram.CurrentPosition = 0;
-                }
-                else
-                {
-                     stackProgram.CurrentPosition++;
-                }
+                if (stackProgram.Commands.Count == 0)
+                    return S_OK;
 
-                if (stackProgram.CurrentPosition >= stackProgram.Commands.Count)
+                int structSize = Marshal.SizeOf<stack_command_t>();
+                IntPtr commandsPtr = Marshal.AllocCoTaskMem(structSize * stackProgram.Commands.Count);
+                try
                 {
-                    Command = StackMachineProgram.ProgramFinished;
+                    IntPtr currentPtr = commandsPtr;
+                    foreach (var command in stackProgram.Commands)
+                    {
+                        stack_command_t entry;
+                        entry.Command = (int)command.OpCode; // Note, enum must be explicitly converted to int.
+                        entry.Arguments = command.GetStructPtr();
+                        Marshal.StructureToPtr(entry, currentPtr, false);
+                        currentPtr = currentPtr + structSize;
+                    }
                 }
-                else
+                catch
                 {
-                    Command = (int)stackProgram.Commands[stackProgram.CurrentPosition].OpCode; // Note, enum must be explicitly converted to int.
-                    Arguments = stackProgram.Commands[stackProgram.CurrentPosition].GetStructPtr();
+                    Marshal.FreeCoTaskMem(commandsPtr);
+                    throw;
                 }
 
+                Count = stackProgram.Commands.Count;
+                Commands = commandsPtr;
                 return S_OK;
             }
             catch (Exception e)
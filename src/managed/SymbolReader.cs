@@ -7,6 +7,7 @@ using System.Collections.Generic;
 using System.Diagnostics;
 using System.IO;
 using System.IO.Compression;
+using System.Net.Http;
 using System.Reflection.Metadata;
 using System.Reflection.Metadata.Ecma335;
 using System.Reflection.PortableExecutable;
@@ -64,6 +65,8 @@ namespace NetCoreDbg
         {
             public readonly MetadataReaderProvider Provider;
             public readonly MetadataReader Reader;
+            // SourceLink documents map (path pattern -> URL pattern), parsed at first request, lock OpenedReader for access.
+            public List<KeyValuePair<string, string>> SourceLinkDocuments;
 
             public OpenedReader(MetadataReaderProvider provider, MetadataReader reader)
             {
@@ -317,6 +320,29 @@ namespace NetCoreDbg
             }
         }
 
+        /// <summary>
+        /// Get memory size of symbol reader's PDB metadata block
+        /// </summary>
+        /// <param name="symbolReaderHandle">symbol reader handle returned by LoadSymbolsForModule</param>
+        /// <param name="size">PDB metadata size in bytes</param>
+        /// <returns>"Ok" if information is available</returns>
+        internal static RetCode GetSymbolReaderMemorySize(IntPtr symbolReaderHandle, out int size)
+        {
+            Debug.Assert(symbolReaderHandle != IntPtr.Zero);
+            size = 0;
+
+            try
+            {
+                GCHandle gch = GCHandle.FromIntPtr(symbolReaderHandle);
+                size = ((OpenedReader)gch.Target).Reader.MetadataLength;
+                return RetCode.OK;
+            }
+            catch
+            {
+                return RetCode.Exception;
+            }
+        }
+
         internal static SequencePointCollection GetSequencePointCollection(int methodToken, MetadataReader reader)
         {
             Handle handle = GetDeltaRelativeMethodDefinitionHandle(reader, methodToken);
@@ -391,20 +417,35 @@ namespace NetCoreDbg
             return RetCode.OK;
         }
 
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct sequence_point_row_t
+        {
+            public int startLine;
+            public int startColumn;
+            public int endLine;
+            public int endColumn;
+            public int offset;
+            public int documentIndex; // index in documents table, -1 in case sequence point don't have document
+        }
+
         /// <summary>
         /// Get list of all sequence points for method.
+        /// Result provided as one memory block (without any additional allocations for each entry):
+        ///     int pointsCount;
+        ///     int documentsCount;
+        ///     sequence_point_row_t points[pointsCount];
+        ///     int documentsOffsets[documentsCount]; // offset from block start to null-terminated UTF-16 string
+        ///     ... documents strings ...
         /// </summary>
         /// <param name="symbolReaderHandle">symbol reader handle returned by LoadSymbolsForModule</param>
         /// <param name="methodToken">method token</param>
-        /// <param name="points">result - array of sequence points</param>
-        /// <param name="pointsCount">result - count of elements in array of sequence points</param>
+        /// <param name="includeHidden">1 - provide all sequence points (including hidden), 0 - user code sequence points only</param>
+        /// <param name="data">result - memory block with sequence points and documents table</param>
         /// <returns>"Ok" if information is available</returns>
-        private static RetCode GetSequencePoints(IntPtr symbolReaderHandle, int methodToken, out IntPtr points, out int pointsCount)
+        private static RetCode GetSequencePoints(IntPtr symbolReaderHandle, int methodToken, int includeHidden, out IntPtr data)
         {
             Debug.Assert(symbolReaderHandle != IntPtr.Zero);
-            var list = new List<DbgSequencePoint>();
-            pointsCount = 0;
-            points = IntPtr.Zero;
+            data = IntPtr.Zero;
 
             try
             {
@@ -413,45 +454,74 @@ namespace NetCoreDbg
 
                 SequencePointCollection sequencePoints = GetSequencePointCollection(methodToken, reader);
 
+                var list = new List<sequence_point_row_t>();
+                var documentsIndexes = new Dictionary<DocumentHandle, int>();
+                var documents = new List<string>();
+
                 foreach (SequencePoint p in sequencePoints)
                 {
-                    if (p.StartLine == 0 || p.StartLine == SequencePoint.HiddenLine)
+                    if (includeHidden == 0 && (p.StartLine == 0 || p.StartLine == SequencePoint.HiddenLine))
                         continue;
 
-                    string fileName = reader.GetString(reader.GetDocument(p.Document).Name);
-                    list.Add(new DbgSequencePoint()
+                    int documentIndex = -1;
+                    if (!p.Document.IsNil && !documentsIndexes.TryGetValue(p.Document, out documentIndex))
+                    {
+                        documentIndex = documents.Count;
+                        documents.Add(reader.GetString(reader.GetDocument(p.Document).Name));
+                        documentsIndexes.Add(p.Document, documentIndex);
+                    }
+
+                    list.Add(new sequence_point_row_t()
                     {
-                        document =  Marshal.StringToBSTR(fileName),
                         startLine = p.StartLine,
                         endLine = p.EndLine,
                         startColumn = p.StartColumn,
                         endColumn = p.EndColumn,
-                        offset = p.Offset
+                        offset = p.Offset,
+                        documentIndex = documentIndex
                     });
                 }
 
-                if (list.Count == 0)
+                // Note, in case of all sequence points requested, empty result is valid result (method don't have sequence points).
+                if (list.Count == 0 && includeHidden == 0)
                     return RetCode.Fail;
 
-                var structSize = Marshal.SizeOf<DbgSequencePoint>();
-                IntPtr allPoints = Marshal.AllocCoTaskMem(list.Count * structSize);
-                var currentPtr = allPoints;
+                int rowSize = Marshal.SizeOf<sequence_point_row_t>();
+                int stringsOffset = 8 + list.Count * rowSize + documents.Count * 4;
+                int blockSize = stringsOffset;
+                foreach (var document in documents)
+                {
+                    blockSize += (document.Length + 1) * 2;
+                }
 
+                data = Marshal.AllocCoTaskMem(blockSize);
+                Marshal.WriteInt32(data, 0, list.Count);
+                Marshal.WriteInt32(data, 4, documents.Count);
+
+                IntPtr currentPtr = data + 8;
                 foreach (var p in list)
                 {
                     Marshal.StructureToPtr(p, currentPtr, false);
-                    currentPtr = currentPtr + structSize;
+                    currentPtr = currentPtr + rowSize;
                 }
 
-                points = allPoints;
-                pointsCount = list.Count;
+                int currentStringOffset = stringsOffset;
+                foreach (var document in documents)
+                {
+                    Marshal.WriteInt32(currentPtr, currentStringOffset);
+                    currentPtr = currentPtr + 4;
+
+                    Marshal.Copy(document.ToCharArray(), 0, data + currentStringOffset, document.Length);
+                    Marshal.WriteInt16(data, currentStringOffset + document.Length * 2, 0);
+                    currentStringOffset += (document.Length + 1) * 2;
+                }
             }
             catch
             {
-                foreach (var p in list)
-                {
-                    Marshal.FreeBSTR(p.document);
-                }
+                if (data != IntPtr.Zero)
+                    Marshal.FreeCoTaskMem(data);
+
+                data = IntPtr.Zero;
                 return RetCode.Exception;
             }
 
@@ -501,6 +571,62 @@ namespace NetCoreDbg
             }
         }
 
+        /// <summary>
+        /// Find state machine MoveNext() method for async/iterator kickoff method by PDB StateMachineMethod table.
+        /// </summary>
+        /// <param name="symbolReaderHandle">symbol reader handle returned by LoadSymbolsForModule</param>
+        /// <param name="kickoffMethodToken">kickoff method token, for example async Main() method token</param>
+        /// <param name="moveNextMethodToken">state machine MoveNext() method token return</param>
+        /// <returns>"Ok" if kickoff method have state machine</returns>
+        internal static RetCode GetStateMachineMethod(IntPtr symbolReaderHandle, int kickoffMethodToken, out int moveNextMethodToken)
+        {
+            Debug.Assert(symbolReaderHandle != IntPtr.Zero);
+            moveNextMethodToken = 0;
+
+            try
+            {
+                GCHandle gch = GCHandle.FromIntPtr(symbolReaderHandle);
+                MetadataReader reader = ((OpenedReader)gch.Target).Reader;
+
+                // Note, MetadataReader provide only MoveNext() -> kickoff method map (MethodDebugInformation.GetStateMachineKickoffMethod()),
+                // so, read table rows directly instead of enumerate all methods debug information. Each row is
+                // (MoveNextMethod, KickoffMethod) MethodDef rows ids with same column size, table have only rows for async/iterator methods.
+                int rowCount = reader.GetTableRowCount(TableIndex.StateMachineMethod);
+                if (rowCount == 0)
+                    return RetCode.Fail;
+
+                int rowSize = reader.GetTableRowSize(TableIndex.StateMachineMethod);
+                int columnSize = rowSize / 2;
+                int kickoffRowId = MetadataTokens.GetRowNumber(MetadataTokens.EntityHandle(kickoffMethodToken));
+
+                unsafe
+                {
+                    byte* row = reader.MetadataPointer + reader.GetTableMetadataOffset(TableIndex.StateMachineMethod);
+                    for (int i = 0; i < rowCount; i++, row += rowSize)
+                    {
+                        if (ReadColumn(row + columnSize, columnSize) != kickoffRowId)
+                            continue;
+
+                        moveNextMethodToken = MetadataTokens.GetToken(MetadataTokens.MethodDefinitionHandle(ReadColumn(row, columnSize)));
+                        return RetCode.OK;
+                    }
+                }
+
+                return RetCode.Fail;
+            }
+            catch
+            {
+                return RetCode.Exception;
+            }
+        }
+
+        // Note, metadata tables data is little-endian and not aligned.
+        private static unsafe int ReadColumn(byte* column, int columnSize)
+        {
+            return columnSize == 2 ? column[0] | (column[1] << 8)
+                                   : column[0] | (column[1] << 8) | (column[2] << 16) | (column[3] << 24);
+        }
+
         [StructLayout(LayoutKind.Sequential)]
         internal struct method_data_t
         {
@@ -690,6 +816,89 @@ namespace NetCoreDbg
             return RetCode.OK;
         }
 
+        /// <summary>
+        /// Get all documents (sources full paths) for module.
+        /// </summary>
+        /// <param name="symbolReaderHandle">symbol reader handle returned by LoadSymbolsForModule</param>
+        /// <param name="count">entry's count in data</param>
+        /// <param name="data">pointer to memory with array of BSTR</param>
+        /// <returns>"Ok" if information is available</returns>
+        internal static RetCode GetModuleDocuments(IntPtr symbolReaderHandle, out int count, out IntPtr data)
+        {
+            Debug.Assert(symbolReaderHandle != IntPtr.Zero);
+            count = 0;
+            data = IntPtr.Zero;
+            var unmanagedBSTRList = new List<IntPtr>();
+
+            try
+            {
+                GCHandle gch = GCHandle.FromIntPtr(symbolReaderHandle);
+                MetadataReader reader = ((OpenedReader)gch.Target).Reader;
+
+                foreach (DocumentHandle docHandle in reader.Documents)
+                {
+                    unmanagedBSTRList.Add(Marshal.StringToBSTR(reader.GetString(reader.GetDocument(docHandle).Name)));
+                }
+
+                if (unmanagedBSTRList.Count == 0)
+                    return RetCode.OK;
+
+                data = Marshal.AllocCoTaskMem(unmanagedBSTRList.Count * IntPtr.Size);
+                for (int i = 0; i < unmanagedBSTRList.Count; i++)
+                {
+                    Marshal.WriteIntPtr(data, i * IntPtr.Size, unmanagedBSTRList[i]);
+                }
+                count = unmanagedBSTRList.Count;
+            }
+            catch
+            {
+                foreach (var p in unmanagedBSTRList)
+                {
+                    Marshal.FreeBSTR(p);
+                }
+                if (data != IntPtr.Zero)
+                    Marshal.FreeCoTaskMem(data);
+
+                data = IntPtr.Zero;
+                return RetCode.Exception;
+            }
+
+            return RetCode.OK;
+        }
+
+        /// <summary>
+        /// Get PDB checksum (PDB id from #Pdb stream header: GUID and stamp).
+        /// </summary>
+        /// <param name="symbolReaderHandle">symbol reader handle returned by LoadSymbolsForModule</param>
+        /// <param name="pdbChecksum">hex string with PDB id</param>
+        /// <returns>"Ok" if information is available</returns>
+        internal static RetCode GetPdbChecksum(IntPtr symbolReaderHandle, out IntPtr pdbChecksum)
+        {
+            Debug.Assert(symbolReaderHandle != IntPtr.Zero);
+            pdbChecksum = IntPtr.Zero;
+
+            try
+            {
+                GCHandle gch = GCHandle.FromIntPtr(symbolReaderHandle);
+                MetadataReader reader = ((OpenedReader)gch.Target).Reader;
+
+                if (reader.DebugMetadataHeader == null)
+                    return RetCode.Fail;
+
+                var checksum = new StringBuilder();
+                foreach (byte b in reader.DebugMetadataHeader.Id)
+                    checksum.Append(b.ToString("x2"));
+
+                pdbChecksum = Marshal.StringToBSTR(checksum.ToString());
+            }
+            catch
+            {
+                return RetCode.Exception;
+            }
+
+            return RetCode.OK;
+        }
+
         [StructLayout(LayoutKind.Sequential)]
         internal struct resolved_bp_t
         {
@@ -711,6 +920,135 @@ namespace NetCoreDbg
             First, Last
         };
 
+        /// <summary>
+        /// Resolve breakpoint for one source line and add results into list.
+        /// </summary>
+        /// <param name="symbolReaderHandles">array of symbol reader handles returned by LoadSymbolsForModule, one for each token</param>
+        /// <param name="tokenNum">number of elements in Tokens</param>
+        /// <param name="Tokens">array of method tokens, that have sequence point with sourceLine</param>
+        /// <param name="sourceLine">initial source line for resolve</param>
+        /// <param name="nestedToken">close nested token for sourceLine</param>
+        /// <param name="sourcePath">source full path</param>
+        /// <param name="list">list for resolved breakpoints</param>
+        private static void ResolveBreakPointsForSourceLine(IntPtr symbolReaderHandles, int tokenNum, IntPtr Tokens, int sourceLine, int nestedToken,
+                                                            string sourcePath, List<resolved_bp_t> list)
+        {
+            // In case nestedToken + sourceLine is part of constructor (tokenNum > 1) we could have cases:
+            // 1. type FieldName1 = new Type();
+            //    void MethodName() {}; type FieldName2 = new Type(); ...  <-- sourceLine
+            // 2. type FieldName1 = new Type(); void MethodName() {}; ...  <-- sourceLine
+            //    type FieldName2 = new Type();
+            // In first case, we need setup breakpoint in nestedToken's method (MethodName in examples above), in second - ignore it.
+
+            // In case nestedToken + sourceLine in normal method we could have cases:
+            // 1. ... line without code ...                                <-- sourceLine
+            //    void MethodName { ...
+            // 2. ... line with code ... void MethodName { ...             <-- sourceLine
+            // We need check if nestedToken's method code closer to sourceLine than code from methodToken's method.
+            // If sourceLine closer to nestedToken's method code - setup breakpoint in nestedToken's method.
+
+            SequencePoint SequencePointForSourceLine(Position reqPos, ref MetadataReader reader, int methodToken)
+            {
+                // Note, SequencePoints ordered by IL offsets, not by line numbers.
+                // For example, infinite loop `while(true)` will have IL offset after cycle body's code.
+                SequencePoint nearestSP = new SequencePoint();
+
+                foreach (SequencePoint p in GetSequencePointCollection(methodToken, reader))
+                {
+                    if (p.StartLine == 0 || p.StartLine == SequencePoint.HiddenLine || p.EndLine < sourceLine)
+                        continue;
+
+                    // Note, in case of constructors, we must care about source too, since we may have situation when field/property have same line in another source.
+                    var fileName = reader.GetString(reader.GetDocument(p.Document).Name);
+                    if (fileName != sourcePath)
+                        continue;
+
+                    // first access, assign to first user code sequence point
+                    if (nearestSP.StartLine == 0)
+                    {
+                        nearestSP = p;
+                        continue;
+                    }
+
+                    if (p.EndLine != nearestSP.EndLine)
+                    {
+                        if ((reqPos == Position.First && p.EndLine < nearestSP.EndLine) ||
+                            (reqPos == Position.Last && p.EndLine > nearestSP.EndLine))
+                            nearestSP = p;
+                    }
+                    else
+                    {
+                        if ((reqPos == Position.First && p.EndColumn < nearestSP.EndColumn) ||
+                            (reqPos == Position.Last && p.EndColumn > nearestSP.EndColumn))
+                            nearestSP = p;
+                    }
+                }
+
+                return nearestSP;
+            }
+
+            int elementSize = 4;
+            for (int i = 0; i < tokenNum; i++)
+            {
+                IntPtr symbolReaderHandle = Marshal.ReadIntPtr(symbolReaderHandles, i * IntPtr.Size);
+                GCHandle gch = GCHandle.FromIntPtr(symbolReaderHandle);
+                MetadataReader reader = ((OpenedReader)gch.Target).Reader;
+
+                int methodToken = Marshal.ReadInt32(Tokens, i * elementSize);
+                SequencePoint current_p = SequencePointForSourceLine(Position.First, ref reader, methodToken);
+                // Note, we don't check that current_p was found or not, since we know for sure, that sourceLine could be resolved in method.
+                // Same idea for nested_p below, if we have nestedToken - it will be resolved for sure.
+
+                if (nestedToken != 0)
+                {
+                    // Check if nestedToken is within range of current_p. Example -
+                    //     await Parallel.ForEachAsync(userHandlers, parallelOptions, async (uri, token) =>   <- breakpoint at this line
+                    //     {
+                    //        await new HttpClient().GetAsync("https://google.com");
+                    //     });
+                    // nesetedToken here is the annonymous async func, and having a breakpoing at the 1st line should
+                    // break on the outer call.
+                    SequencePoint nested_start_p = SequencePointForSourceLine(Position.First, ref reader, nestedToken);
+                    SequencePoint nested_end_p = SequencePointForSourceLine(Position.Last, ref reader, nestedToken);
+                    if ((nested_start_p.StartLine > current_p.StartLine || (nested_start_p.StartLine == current_p.StartLine && nested_start_p.StartColumn > current_p.StartColumn)) &&
+                        (nested_end_p.EndLine < current_p.EndLine || (nested_end_p.EndLine == current_p.EndLine && nested_end_p.EndColumn < current_p.EndColumn ))
+                    ) {
+                        list.Add(new resolved_bp_t(current_p.StartLine, current_p.EndLine, current_p.Offset, methodToken));
+                        break;
+                    }
+
+                    // Note, sequence points can't partially overlap each other, since same lemmas can't belong to 2 different sequence points for sure.
+                    // In this case we could check not "line" (start line - end line datas) but only "point" (end line data) for
+                    // current method sequence point and first nested method sequence point.
+                    if (current_p.EndLine > nested_start_p.EndLine || (current_p.EndLine == nested_start_p.EndLine && current_p.EndColumn > nested_start_p.EndColumn))
+                    {
+                        list.Add(new resolved_bp_t(nested_start_p.StartLine, nested_start_p.EndLine, nested_start_p.Offset, nestedToken));
+                        // (tokenNum > 1) can have only lines, that added to multiple constructors, in this case - we will have same for all Tokens,
+                        // we need unique tokens only for breakpoints, prevent adding nestedToken multiple times.
+                        break;
+                    }
+                }
+                nestedToken = 0; // Don't check nested block next cycle (will have same results).
+
+                list.Add(new resolved_bp_t(current_p.StartLine, current_p.EndLine, current_p.Offset, methodToken));
+            }
+        }
+
+        private static IntPtr ResolvedBreakPointsToPtr<T>(List<T> list)
+        {
+            int structSize = Marshal.SizeOf<T>();
+            IntPtr data = Marshal.AllocCoTaskMem(list.Count * structSize);
+            IntPtr dataPtr = data;
+
+            foreach (var p in list)
+            {
+                Marshal.StructureToPtr(p, dataPtr, false);
+                dataPtr = dataPtr + structSize;
+            }
+
+            return data;
+        }
+
         /// <summary>
         /// Resolve breakpoints.
         /// </summary>
@@ -732,120 +1070,108 @@ namespace NetCoreDbg
 
             try
             {
-                // In case nestedToken + sourceLine is part of constructor (tokenNum > 1) we could have cases:
-                // 1. type FieldName1 = new Type();
-                //    void MethodName() {}; type FieldName2 = new Type(); ...  <-- sourceLine
-                // 2. type FieldName1 = new Type(); void MethodName() {}; ...  <-- sourceLine
-                //    type FieldName2 = new Type();
-                // In first case, we need setup breakpoint in nestedToken's method (MethodName in examples above), in second - ignore it.
+                ResolveBreakPointsForSourceLine(symbolReaderHandles, tokenNum, Tokens, sourceLine, nestedToken, sourcePath, list);
 
-                // In case nestedToken + sourceLine in normal method we could have cases:
-                // 1. ... line without code ...                                <-- sourceLine
-                //    void MethodName { ...
-                // 2. ... line with code ... void MethodName { ...             <-- sourceLine
-                // We need check if nestedToken's method code closer to sourceLine than code from methodToken's method.
-                // If sourceLine closer to nestedToken's method code - setup breakpoint in nestedToken's method.
+                if (list.Count == 0)
+                    return RetCode.OK;
 
-                SequencePoint SequencePointForSourceLine(Position reqPos, ref MetadataReader reader, int methodToken)
-                {
-                    // Note, SequencePoints ordered by IL offsets, not by line numbers.
-                    // For example, infinite loop `while(true)` will have IL offset after cycle body's code.
-                    SequencePoint nearestSP = new SequencePoint();
+                data = ResolvedBreakPointsToPtr(list);
+                Count = list.Count;
+            }
+            catch
+            {
+                if (data != IntPtr.Zero)
+                    Marshal.FreeCoTaskMem(data);
 
-                    foreach (SequencePoint p in GetSequencePointCollection(methodToken, reader))
-                    {
-                        if (p.StartLine == 0 || p.StartLine == SequencePoint.HiddenLine || p.EndLine < sourceLine)
-                            continue;
+                data = IntPtr.Zero;
+                return RetCode.Exception;
+            }
 
-                        // Note, in case of constructors, we must care about source too, since we may have situation when field/property have same line in another source.
-                        var fileName = reader.GetString(reader.GetDocument(p.Document).Name);
-                        if (fileName != sourcePath)
-                            continue;
+            return RetCode.OK;
+        }
 
-                        // first access, assign to first user code sequence point
-                        if (nearestSP.StartLine == 0)
-                        {
-                            nearestSP = p;
-                            continue;
-                        }
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct resolve_bp_request_t
+        {
+            public IntPtr symbolReaderHandles; // PVOID*
+            public IntPtr Tokens; // mdMethodDef*
+            public int tokenNum;
+            public int sourceLine;
+            public int nestedToken;
+            public int sourcePathIndex; // index in sourcePaths array
+        }
 
-                        if (p.EndLine != nearestSP.EndLine)
-                        {
-                            if ((reqPos == Position.First && p.EndLine < nearestSP.EndLine) ||
-                                (reqPos == Position.Last && p.EndLine > nearestSP.EndLine))
-                                nearestSP = p;
-                        }
-                        else
-                        {
-                            if ((reqPos == Position.First && p.EndColumn < nearestSP.EndColumn) ||
-                                (reqPos == Position.Last && p.EndColumn > nearestSP.EndColumn))
-                                nearestSP = p;
-                        }
-                    }
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct resolved_batch_bp_t
+        {
+            public int startLine;
+            public int endLine;
+            public int ilOffset;
+            public int methodToken;
+            public int requestIndex;
 
-                    return nearestSP;
-                }
+            public resolved_batch_bp_t(resolved_bp_t bp, int requestIndex_)
+            {
+                startLine = bp.startLine;
+                endLine = bp.endLine;
+                ilOffset = bp.ilOffset;
+                methodToken = bp.methodToken;
+                requestIndex = requestIndex_;
+            }
+        }
 
-                int elementSize = 4;
-                for (int i = 0; i < tokenNum; i++)
-                {
-                    IntPtr symbolReaderHandle = Marshal.ReadIntPtr(symbolReaderHandles, i * IntPtr.Size);
-                    GCHandle gch = GCHandle.FromIntPtr(symbolReaderHandle);
-                    MetadataReader reader = ((OpenedReader)gch.Target).Reader;
+        /// <summary>
+        /// Resolve breakpoints for multiple source lines (could be in different sources) in one call.
+        /// </summary>
+        /// <param name="requests">array of resolve_bp_request_t</param>
+        /// <param name="requestNum">number of elements in requests</param>
+        /// <param name="sourcePaths">array of source full paths (LPWStr), that requests refer by index</param>
+        /// <param name="sourcePathNum">number of elements in sourcePaths</param>
+        /// <param name="Count">entry's count in data</param>
+        /// <param name="data">pointer to memory with result (array of resolved_batch_bp_t)</param>
+        /// <returns>"Ok" if information is available</returns>
+        internal static RetCode ResolveBreakPointsBatch(IntPtr requests, int requestNum, IntPtr sourcePaths, int sourcePathNum,
+                                                        out int Count, out IntPtr data)
+        {
+            Debug.Assert(requests != IntPtr.Zero);
+            Count = 0;
+            data = IntPtr.Zero;
+            var batchList = new List<resolved_batch_bp_t>();
 
-                    int methodToken = Marshal.ReadInt32(Tokens, i * elementSize);
-                    SequencePoint current_p = SequencePointForSourceLine(Position.First, ref reader, methodToken);
-                    // Note, we don't check that current_p was found or not, since we know for sure, that sourceLine could be resolved in method.
-                    // Same idea for nested_p below, if we have nestedToken - it will be resolved for sure.
+            try
+            {
+                var paths = new string[sourcePathNum];
+                for (int i = 0; i < sourcePathNum; i++)
+                {
+                    paths[i] = Marshal.PtrToStringUni(Marshal.ReadIntPtr(sourcePaths, i * IntPtr.Size));
+                }
 
-                    if (nestedToken != 0)
+                int requestSize = Marshal.SizeOf<resolve_bp_request_t>();
+                var list = new List<resolved_bp_t>();
+                for (int i = 0; i < requestNum; i++)
+                {
+                    var request = Marshal.PtrToStructure<resolve_bp_request_t>(requests + i * requestSize);
+                    list.Clear();
+                    try
                     {
-                        // Check if nestedToken is within range of current_p. Example -
-                        //     await Parallel.ForEachAsync(userHandlers, parallelOptions, async (uri, token) =>   <- breakpoint at this line
-                        //     {
-                        //        await new HttpClient().GetAsync("https://google.com");
-                        //     });
-                        // nesetedToken here is the annonymous async func, and having a breakpoing at the 1st line should
-                        // break on the outer call.
-                        SequencePoint nested_start_p = SequencePointForSourceLine(Position.First, ref reader, nestedToken);
-                        SequencePoint nested_end_p = SequencePointForSourceLine(Position.Last, ref reader, nestedToken);
-                        if ((nested_start_p.StartLine > current_p.StartLine || (nested_start_p.StartLine == current_p.StartLine && nested_start_p.StartColumn > current_p.StartColumn)) &&
-                            (nested_end_p.EndLine < current_p.EndLine || (nested_end_p.EndLine == current_p.EndLine && nested_end_p.EndColumn < current_p.EndColumn ))
-                        ) {
-                            list.Add(new resolved_bp_t(current_p.StartLine, current_p.EndLine, current_p.Offset, methodToken));
-                            break;
-                        }
-
-                        // Note, sequence points can't partially overlap each other, since same lemmas can't belong to 2 different sequence points for sure.
-                        // In this case we could check not "line" (start line - end line datas) but only "point" (end line data) for
-                        // current method sequence point and first nested method sequence point.
-                        if (current_p.EndLine > nested_start_p.EndLine || (current_p.EndLine == nested_start_p.EndLine && current_p.EndColumn > nested_start_p.EndColumn))
-                        {
-                            list.Add(new resolved_bp_t(nested_start_p.StartLine, nested_start_p.EndLine, nested_start_p.Offset, nestedToken));
-                            // (tokenNum > 1) can have only lines, that added to multiple constructors, in this case - we will have same for all Tokens,
-                            // we need unique tokens only for breakpoints, prevent adding nestedToken multiple times.
-                            break;
-                        }
+                        ResolveBreakPointsForSourceLine(request.symbolReaderHandles, request.tokenNum, request.Tokens, request.sourceLine,
+                                                        request.nestedToken, paths[request.sourcePathIndex], list);
+                    }
+                    catch
+                    {
+                        // Same as for ResolveBreakPoints(), failed request should not affect others.
+                        continue;
                     }
-                    nestedToken = 0; // Don't check nested block next cycle (will have same results).
 
-                    list.Add(new resolved_bp_t(current_p.StartLine, current_p.EndLine, current_p.Offset, methodToken));
+                    foreach (var p in list)
+                        batchList.Add(new resolved_batch_bp_t(p, i));
                 }
 
-                if (list.Count == 0)
+                if (batchList.Count == 0)
                     return RetCode.OK;
 
-                int structSize = Marshal.SizeOf<resolved_bp_t>();
-                data = Marshal.AllocCoTaskMem(list.Count * structSize);
-                IntPtr dataPtr = data;
-
-                foreach (var p in list)
-                {
-                    Marshal.StructureToPtr(p, dataPtr, false);
-                    dataPtr = dataPtr + structSize;
-                }
-
-                Count = list.Count;
+                data = ResolvedBreakPointsToPtr(batchList);
+                Count = batchList.Count;
             }
             catch
             {
@@ -921,68 +1247,85 @@ namespace NetCoreDbg
             return RetCode.Fail;
         }
 
-        internal static RetCode GetLocalVariableNameAndScope(IntPtr symbolReaderHandle, int methodToken, int localIndex, out IntPtr localVarName, out int ilStartOffset, out int ilEndOffset)
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct local_variable_t
         {
-            localVarName = IntPtr.Zero;
-            ilStartOffset = 0;
-            ilEndOffset = 0;
-
-            try
-            {
-                string localVar = null;
-                if (!GetLocalVariableAndScopeByIndex(symbolReaderHandle, methodToken, localIndex, out localVar, out ilStartOffset, out ilEndOffset))
-                    return RetCode.Fail;
-
-                localVarName = Marshal.StringToBSTR(localVar);
-                localVar = null;
-            }
-            catch
-            {
-                return RetCode.Exception;
-            }
-
-            return RetCode.OK;
+            public int index;
+            public int ilStartOffset;
+            public int ilEndOffset;
+            public IntPtr name; // BSTR
         }
 
-        internal static bool GetLocalVariableAndScopeByIndex(IntPtr symbolReaderHandle, int methodToken, int localIndex, out string localVarName, out int ilStartOffset, out int ilEndOffset)
+        /// <summary>
+        /// Returns all local variables names and scopes for method, debugger hidden locals are skipped.
+        /// </summary>
+        /// <param name="symbolReaderHandle">symbol reader handle returned by LoadSymbolsForModule</param>
+        /// <param name="methodToken">method token</param>
+        /// <param name="data">pointer to memory with local_variable_t array</param>
+        /// <param name="count">entry's count in data</param>
+        /// <returns>"Ok" if information is available</returns>
+        internal static RetCode GetLocalVariablesTable(IntPtr symbolReaderHandle, int methodToken, out IntPtr data, out int count)
         {
-            Debug.Assert(symbolReaderHandle != IntPtr.Zero);
-            localVarName = null;
-            ilStartOffset = 0;
-            ilEndOffset = 0;
-
-            // caller must care about exception during this code execution
+            Debug.Assert(symbolReaderHandle != IntPtr.Zero);
+            data = IntPtr.Zero;
+            count = 0;
+            var list = new List<local_variable_t>();
 
-            GCHandle gch = GCHandle.FromIntPtr(symbolReaderHandle);
-            MetadataReader reader = ((OpenedReader)gch.Target).Reader;
+            try
+            {
+                GCHandle gch = GCHandle.FromIntPtr(symbolReaderHandle);
+                MetadataReader reader = ((OpenedReader)gch.Target).Reader;
 
-            Handle handle = GetDeltaRelativeMethodDefinitionHandle(reader, methodToken);
-            if (handle.Kind != HandleKind.MethodDefinition)
-                return false;
+                Handle handle = GetDeltaRelativeMethodDefinitionHandle(reader, methodToken);
+                if (handle.Kind != HandleKind.MethodDefinition)
+                    return RetCode.Fail;
 
-            MethodDebugInformationHandle methodDebugHandle = ((MethodDefinitionHandle)handle).ToDebugInformationHandle();
-            LocalScopeHandleCollection localScopes = reader.GetLocalScopes(methodDebugHandle);
-            foreach (LocalScopeHandle scopeHandle in localScopes)
-            {
-                LocalScope scope = reader.GetLocalScope(scopeHandle);
-                LocalVariableHandleCollection localVars = scope.GetLocalVariables();
-                foreach (LocalVariableHandle varHandle in localVars)
+                MethodDebugInformationHandle methodDebugHandle = ((MethodDefinitionHandle)handle).ToDebugInformationHandle();
+                foreach (LocalScopeHandle scopeHandle in reader.GetLocalScopes(methodDebugHandle))
                 {
-                    LocalVariable localVar = reader.GetLocalVariable(varHandle);
-                    if (localVar.Index == localIndex)
+                    LocalScope scope = reader.GetLocalScope(scopeHandle);
+                    foreach (LocalVariableHandle varHandle in scope.GetLocalVariables())
                     {
+                        LocalVariable localVar = reader.GetLocalVariable(varHandle);
                         if (localVar.Attributes == LocalVariableAttributes.DebuggerHidden)
-                            return false;
+                            continue;
 
-                        localVarName = reader.GetString(localVar.Name);
-                        ilStartOffset = scope.StartOffset;
-                        ilEndOffset = scope.EndOffset;
-                        return true;
+                        list.Add(new local_variable_t() {
+                            index = localVar.Index,
+                            ilStartOffset = scope.StartOffset,
+                            ilEndOffset = scope.EndOffset,
+                            name = Marshal.StringToBSTR(reader.GetString(localVar.Name))
+                        });
                     }
                 }
+
+                if (list.Count == 0)
+                    return RetCode.OK;
+
+                int structSize = Marshal.SizeOf<local_variable_t>();
+                data = Marshal.AllocCoTaskMem(list.Count * structSize);
+                IntPtr currentPtr = data;
+                foreach (var p in list)
+                {
+                    Marshal.StructureToPtr(p, currentPtr, false);
+                    currentPtr = currentPtr + structSize;
+                }
+                count = list.Count;
+            }
+            catch
+            {
+                foreach (var p in list)
+                {
+                    Marshal.FreeBSTR(p.name);
+                }
+                if (data != IntPtr.Zero)
+                    Marshal.FreeCoTaskMem(data);
+                data = IntPtr.Zero;
+
+                return RetCode.Exception;
             }
 
-            return false;
+            return RetCode.OK;
         }
 
         /// <summary>
@@ -1289,20 +1632,22 @@ namespace NetCoreDbg
                     try
                     {
                         int tmpLastIndex = assemblyPath.LastIndexOf(".native_image");
-                        if (tmpLastIndex == -1)
+                        if (tmpLastIndex != -1)
                         {
-                            return null;
+                            string tmpPath = assemblyPath.Substring(0, tmpLastIndex);
+                            pdbStream = TryOpenFile(Path.Combine(Path.GetDirectoryName(tmpPath), GetFileName(pdbPath)));
                         }
-                        string tmpPath = assemblyPath.Substring(0, tmpLastIndex);
-                        pdbPath = Path.Combine(Path.GetDirectoryName(tmpPath), GetFileName(pdbPath));
                     }
                     catch
                     {
                         // invalid characters in CodeView path
                         return null;
                     }
-
-                    pdbStream = TryOpenFile(pdbPath);
+                }
+                if (pdbStream == null)
+                {
+                    // PDB could be downloaded from symbol server before (at previous session or in background).
+                    pdbStream = TryOpenFile(GetSymbolCacheFilePath(data.Path, data.Guid));
                 }
                 if (pdbStream == null)
                 {
@@ -1376,6 +1721,210 @@ namespace NetCoreDbg
             }
         }
 
+        private static readonly object symbolServersLock = new object();
+        private static string[] symbolServers = new string[0];
+        private static string symbolCachePath = null;
+        private static HttpClient httpClient = null;
+        private static readonly TimeSpan DownloadTimeout = TimeSpan.FromSeconds(60);
+
+        private static HttpClient GetHttpClient()
+        {
+            lock (symbolServersLock)
+            {
+                if (httpClient == null)
+                {
+                    httpClient = new HttpClient();
+                    httpClient.Timeout = DownloadTimeout;
+                }
+                return httpClient;
+            }
+        }
+
+        /// <summary>
+        /// Download file, write into unique temporary file and move it to destination at the end, so, other debugger instances
+        /// (or readers of destination file) never see partially written file.
+        /// Note, this is blocking call, must be used from background thread only.
+        /// </summary>
+        /// <param name="url">file URL</param>
+        /// <param name="filePath">destination file path, directory must exist</param>
+        /// <param name="validate">optional downloaded file check</param>
+        /// <returns>true if file was downloaded or destination file already exist</returns>
+        private static bool TryDownloadFile(string url, string filePath, Func<string, bool> validate)
+        {
+            string tmpFilePath = filePath + "." + Guid.NewGuid().ToString("N") + ".tmp";
+            try
+            {
+                using (var response = GetHttpClient().GetAsync(url).Result)
+                {
+                    if (!response.IsSuccessStatusCode)
+                        return false;
+
+                    using (var fileStream = File.Create(tmpFilePath))
+                    {
+                        response.Content.CopyToAsync(fileStream).Wait();
+                    }
+                }
+
+                if (validate != null && !validate(tmpFilePath))
+                    return false;
+
+                try
+                {
+                    File.Move(tmpFilePath, filePath);
+                }
+                catch (IOException)
+                {
+                    // same file was moved by other debugger instance
+                    if (!File.Exists(filePath))
+                        throw;
+                }
+                return true;
+            }
+            catch
+            {
+                // server not available or timeout
+                return false;
+            }
+            finally
+            {
+                try
+                {
+                    if (File.Exists(tmpFilePath))
+                        File.Delete(tmpFilePath);
+                }
+                catch
+                {
+                }
+            }
+        }
+
+        /// <summary>
+        /// Set symbol servers and local symbols cache directory for PDB download.
+        /// </summary>
+        /// <param name="servers">symbol servers URLs separated by ';' or null</param>
+        /// <param name="cachePath">local symbols cache directory or null</param>
+        internal static void SetSymbolServers([MarshalAs(UnmanagedType.LPWStr)] string servers, [MarshalAs(UnmanagedType.LPWStr)] string cachePath)
+        {
+            lock (symbolServersLock)
+            {
+                symbolServers = string.IsNullOrEmpty(servers) ? new string[0] : servers.Split(new char[] { ';' }, StringSplitOptions.RemoveEmptyEntries);
+                symbolCachePath = string.IsNullOrEmpty(cachePath) ? null : cachePath;
+            }
+        }
+
+        /// <summary>
+        /// Build SSQP key for portable PDB, see Symbol Server Query Protocol "SSQP Key Conventions".
+        /// </summary>
+        /// <param name="pdbPath">PDB path from CodeView entry</param>
+        /// <param name="pdbGuid">PDB guid from CodeView entry</param>
+        /// <returns>key in "pdbname/guidFFFFFFFF/pdbname" format</returns>
+        private static string GetSymbolStoreKey(string pdbPath, Guid pdbGuid)
+        {
+            string fileName = GetFileName(pdbPath).ToLowerInvariant();
+            return fileName + "/" + pdbGuid.ToString("N") + "ffffffff/" + fileName;
+        }
+
+        /// <summary>
+        /// Note, local cache use same layout as symbol server (file path is SSQP key), so, it could be shared with other tools.
+        /// </summary>
+        /// <returns>PDB path in local symbols cache or null, if cache not configured</returns>
+        private static string GetSymbolCacheFilePath(string pdbPath, Guid pdbGuid)
+        {
+            string cachePath = symbolCachePath;
+            if (cachePath == null || string.IsNullOrEmpty(GetFileName(pdbPath)))
+                return null;
+
+            try
+            {
+                return Path.Combine(cachePath, GetSymbolStoreKey(pdbPath, pdbGuid).Replace('/', Path.DirectorySeparatorChar));
+            }
+            catch
+            {
+                // invalid characters in CodeView path
+                return null;
+            }
+        }
+
+        private static bool IsPdbMatch(string pdbPath, BlobContentId id)
+        {
+            try
+            {
+                using (var provider = MetadataReaderProvider.FromPortablePdbStream(File.OpenRead(pdbPath)))
+                {
+                    return new BlobContentId(provider.GetMetadataReader().DebugMetadataHeader.Id) == id;
+                }
+            }
+            catch
+            {
+                return false;
+            }
+        }
+
+        /// <summary>
+        /// Download portable PDB for assembly from symbol servers into local symbols cache.
+        /// Note, this is blocking call, must be used from background thread only.
+        /// </summary>
+        /// <param name="assemblyPath">file path of the assembly</param>
+        /// <returns>"Ok" if PDB was downloaded or already in cache, so, LoadSymbolsForModule() could be used again</returns>
+        internal static RetCode DownloadSymbolsForModule([MarshalAs(UnmanagedType.LPWStr)] string assemblyPath)
+        {
+            string[] servers;
+            lock (symbolServersLock)
+            {
+                servers = symbolServers;
+            }
+            if (servers.Length == 0 || symbolCachePath == null)
+                return RetCode.Fail;
+
+            string cacheFilePath;
+            string key;
+            BlobContentId id;
+            try
+            {
+                using (var peStream = TryOpenFile(assemblyPath))
+                {
+                    if (peStream == null)
+                        return RetCode.Fail;
+
+                    using (var peReader = new PEReader(peStream))
+                    {
+                        DebugDirectoryEntry codeViewEntry, embeddedPdbEntry;
+                        ReadPortableDebugTableEntries(peReader, out codeViewEntry, out embeddedPdbEntry);
+                        if (codeViewEntry.DataSize == 0 || embeddedPdbEntry.DataSize != 0)
+                            return RetCode.Fail;
+
+                        var data = peReader.ReadCodeViewDebugDirectoryData(codeViewEntry);
+                        if (data.Age != 1)
+                            return RetCode.Fail;
+
+                        cacheFilePath = GetSymbolCacheFilePath(data.Path, data.Guid);
+                        if (cacheFilePath == null)
+                            return RetCode.Fail;
+
+                        key = GetSymbolStoreKey(data.Path, data.Guid);
+                        id = new BlobContentId(data.Guid, codeViewEntry.Stamp);
+                    }
+                }
+
+                if (File.Exists(cacheFilePath))
+                    return RetCode.OK;
+
+                Directory.CreateDirectory(Path.GetDirectoryName(cacheFilePath));
+            }
+            catch
+            {
+                return RetCode.Fail;
+            }
+
+            foreach (string server in servers)
+            {
+                if (TryDownloadFile(server.TrimEnd('/') + "/" + key, cacheFilePath, (path) => IsPdbMatch(path, id)))
+                    return RetCode.OK;
+            }
+
+            return RetCode.Fail;
+        }
+
         [StructLayout(LayoutKind.Sequential)]
         internal struct AsyncAwaitInfoBlock
         {
@@ -1589,5 +2138,239 @@ namespace NetCoreDbg
             }
             return stream;
         }
+
+        private static readonly Guid SourceLinkGuid = new Guid("CC110556-A091-4D38-9FEC-25AB9A351A6A");
+
+        private static string ReadJsonString(string json, ref int pos)
+        {
+            var result = new StringBuilder();
+            pos++; // skip opening quote
+            while (pos < json.Length && json[pos] != '"')
+            {
+                char c = json[pos++];
+                if (c != '\\')
+                {
+                    result.Append(c);
+                    continue;
+                }
+
+                if (pos >= json.Length)
+                    throw new FormatException();
+                c = json[pos++];
+                switch (c)
+                {
+                    case 'b': result.Append('\b'); break;
+                    case 'f': result.Append('\f'); break;
+                    case 'n': result.Append('\n'); break;
+                    case 'r': result.Append('\r'); break;
+                    case 't': result.Append('\t'); break;
+                    case 'u':
+                        if (pos + 4 > json.Length)
+                            throw new FormatException();
+                        result.Append((char)Convert.ToInt32(json.Substring(pos, 4), 16));
+                        pos += 4;
+                        break;
+                    default: result.Append(c); break; // '"', '\\' and '/'
+                }
+            }
+            if (pos >= json.Length)
+                throw new FormatException();
+            pos++; // skip closing quote
+            return result.ToString();
+        }
+
+        /// <summary>
+        /// Parse "documents" object of SourceLink JSON, see https://github.com/dotnet/designs/blob/main/accepted/2020/diagnostics/source-link.md
+        /// Note, only "documents" is defined by SourceLink format, so, simple scanner is used instead of JSON library dependency.
+        /// </summary>
+        /// <param name="json">SourceLink JSON</param>
+        /// <returns>list of path pattern and URL pattern pairs</returns>
+        private static List<KeyValuePair<string, string>> ParseSourceLinkDocuments(string json)
+        {
+            var documents = new List<KeyValuePair<string, string>>();
+            int pos = 0;
+            while (pos < json.Length && json[pos] != '{') pos++;
+            pos++;
+            while (pos < json.Length)
+            {
+                while (pos < json.Length && json[pos] != '"' && json[pos] != '}') pos++;
+                if (pos >= json.Length || json[pos] == '}')
+                    break;
+
+                string name = ReadJsonString(json, ref pos);
+                while (pos < json.Length && json[pos] != '{' && json[pos] != '"') pos++;
+                if (name != "documents" || pos >= json.Length || json[pos] != '{')
+                {
+                    // unknown property with string value
+                    if (pos < json.Length && json[pos] == '"')
+                        ReadJsonString(json, ref pos);
+                    continue;
+                }
+
+                pos++;
+                while (pos < json.Length)
+                {
+                    while (pos < json.Length && json[pos] != '"' && json[pos] != '}') pos++;
+                    if (pos >= json.Length || json[pos] == '}')
+                        break;
+
+                    string path = ReadJsonString(json, ref pos);
+                    while (pos < json.Length && json[pos] != '"') pos++;
+                    if (pos >= json.Length)
+                        break;
+                    string url = ReadJsonString(json, ref pos);
+                    documents.Add(new KeyValuePair<string, string>(path, url));
+                }
+                break;
+            }
+            return documents;
+        }
+
+        private static List<KeyValuePair<string, string>> GetSourceLinkDocuments(OpenedReader openedReader)
+        {
+            lock (openedReader)
+            {
+                if (openedReader.SourceLinkDocuments != null)
+                    return openedReader.SourceLinkDocuments;
+
+                var documents = new List<KeyValuePair<string, string>>();
+                MetadataReader reader = openedReader.Reader;
+                foreach (var handle in reader.GetCustomDebugInformation(EntityHandle.ModuleDefinition))
+                {
+                    var cdi = reader.GetCustomDebugInformation(handle);
+                    if (reader.GetGuid(cdi.Kind) != SourceLinkGuid)
+                        continue;
+
+                    try
+                    {
+                        byte[] bytes = reader.GetBlobBytes(cdi.Value);
+                        documents = ParseSourceLinkDocuments(Encoding.UTF8.GetString(bytes, 0, bytes.Length));
+                    }
+                    catch (FormatException)
+                    {
+                        // broken SourceLink JSON, same as no SourceLink
+                    }
+                    break;
+                }
+
+                openedReader.SourceLinkDocuments = documents;
+                return documents;
+            }
+        }
+
+        /// <summary>
+        /// Map document path to URL with SourceLink documents map. Exact path match is preferred, in case of patterns with
+        /// trailing '*' the longest one is used, rest of path replace '*' in URL (with '/' as separator).
+        /// </summary>
+        private static string MapSourceLinkUrl(List<KeyValuePair<string, string>> documents, string docPath)
+        {
+            string url = null;
+            int matchLength = -1;
+            foreach (var document in documents)
+            {
+                string pattern = document.Key;
+                if (!pattern.EndsWith("*", StringComparison.Ordinal))
+                {
+                    if (string.Equals(pattern, docPath, StringComparison.OrdinalIgnoreCase))
+                        return document.Value;
+                    continue;
+                }
+
+                string prefix = pattern.Substring(0, pattern.Length - 1);
+                if (prefix.Length <= matchLength || !docPath.StartsWith(prefix, StringComparison.OrdinalIgnoreCase))
+                    continue;
+
+                int starPos = document.Value.IndexOf('*');
+                if (starPos == -1)
+                    continue;
+
+                matchLength = prefix.Length;
+                url = document.Value.Substring(0, starPos) + docPath.Substring(prefix.Length).Replace('\\', '/') + document.Value.Substring(starPos + 1);
+            }
+            return url;
+        }
+
+        /// <summary>
+        /// Get SourceLink URL and content key for document.
+        /// </summary>
+        /// <param name="symbolReaderHandle">symbol reader handle returned by LoadSymbolsForModule</param>
+        /// <param name="fileName">document path</param>
+        /// <param name="url">document URL</param>
+        /// <param name="contentKey">document checksum algorithm and checksum, in order to use it as cached file name</param>
+        /// <returns>"Ok" if document have SourceLink URL and checksum</returns>
+        internal static RetCode GetSourceLinkInfo(IntPtr symbolReaderHandle, [MarshalAs(UnmanagedType.LPWStr)] string fileName, out IntPtr url, out IntPtr contentKey)
+        {
+            Debug.Assert(symbolReaderHandle != IntPtr.Zero);
+            url = IntPtr.Zero;
+            contentKey = IntPtr.Zero;
+
+            try
+            {
+                GCHandle gch = GCHandle.FromIntPtr(symbolReaderHandle);
+                OpenedReader openedReader = (OpenedReader)gch.Target;
+                var documents = GetSourceLinkDocuments(openedReader);
+                if (documents.Count == 0)
+                    return RetCode.Fail;
+
+                MetadataReader reader = openedReader.Reader;
+                foreach (var handle in reader.Documents)
+                {
+                    var doc = reader.GetDocument(handle);
+                    if (reader.GetString(doc.Name) != fileName)
+                        continue;
+
+                    if (doc.Hash.IsNil)
+                        return RetCode.Fail;
+
+                    string docUrl = MapSourceLinkUrl(documents, fileName);
+                    if (docUrl == null)
+                        return RetCode.Fail;
+
+                    var key = new StringBuilder();
+                    key.Append(reader.GetGuid(doc.HashAlgorithm).ToString("N"));
+                    key.Append('-');
+                    foreach (byte b in reader.GetBlobBytes(doc.Hash))
+                        key.Append(b.ToString("x2"));
+
+                    url = Marshal.StringToBSTR(docUrl);
+                    contentKey = Marshal.StringToBSTR(key.ToString());
+                    return RetCode.OK;
+                }
+            }
+            catch
+            {
+                if (url != IntPtr.Zero)
+                    Marshal.FreeBSTR(url);
+                url = IntPtr.Zero;
+                return RetCode.Exception;
+            }
+
+            return RetCode.Fail;
+        }
+
+        /// <summary>
+        /// Download source file by SourceLink URL.
+        /// Note, this is blocking call, must be used from background thread only.
+        /// </summary>
+        /// <param name="url">document URL</param>
+        /// <param name="filePath">destination file path, directory is created if not exist</param>
+        /// <returns>"Ok" if file was downloaded or already exist</returns>
+        internal static RetCode DownloadSource([MarshalAs(UnmanagedType.LPWStr)] string url, [MarshalAs(UnmanagedType.LPWStr)] string filePath)
+        {
+            try
+            {
+                if (File.Exists(filePath))
+                    return RetCode.OK;
+
+                Directory.CreateDirectory(Path.GetDirectoryName(filePath));
+            }
+            catch
+            {
+                return RetCode.Fail;
+            }
+
+            // Note, don't validate file checksum, since source control could change line endings (for example, git autocrlf).
+            return TryDownloadFile(url, filePath, null) ? RetCode.OK : RetCode.Fail;
+        }
     }
 }
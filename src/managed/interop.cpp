@@ -9,6 +9,9 @@
 #include <coreclrhost.h>
 #include <thread>
 #include <string>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
 
 #include "palclr.h"
 #include "utils/platform.h"
@@ -48,6 +51,9 @@ enum class RetCode : int32_t
 };
 
 Utility::RWLock CLRrwlock;
+std::mutex warmUpMutex;
+bool warmUpRequested = false;
+bool warmUpStarted = false;
 void *hostHandle = nullptr;
 unsigned int domainId = 0;
 coreclr_shutdown_ptr shutdownCoreClr = nullptr;
@@ -58,21 +64,30 @@ coreclr_shutdown_ptr shutdownCoreClr = nullptr;
 typedef  int (*ReadMemoryDelegate)(uint64_t, char*, int32_t);
 typedef  PVOID (*LoadSymbolsForModuleDelegate)(const WCHAR*, BOOL, uint64_t, int32_t, uint64_t, int32_t, ReadMemoryDelegate);
 typedef  void (*DisposeDelegate)(PVOID);
-typedef  RetCode (*GetLocalVariableNameAndScope)(PVOID, int32_t, int32_t, BSTR*, uint32_t*, uint32_t*);
+typedef  RetCode (*GetLocalVariablesTable)(PVOID, int32_t, PVOID*, int32_t*);
 typedef  RetCode (*GetHoistedLocalScopes)(PVOID, int32_t, PVOID*, int32_t*);
 typedef  RetCode (*GetSequencePointByILOffsetDelegate)(PVOID, mdMethodDef, uint32_t, PVOID);
-typedef  RetCode (*GetSequencePointsDelegate)(PVOID, mdMethodDef, PVOID*, int32_t*);
+typedef  RetCode (*GetSequencePointsDelegate)(PVOID, mdMethodDef, int32_t, PVOID*);
 typedef  RetCode (*GetNextUserCodeILOffsetDelegate)(PVOID, mdMethodDef, uint32_t, uint32_t*, int32_t*);
 typedef  RetCode (*GetStepRangesFromIPDelegate)(PVOID, int32_t, mdMethodDef, uint32_t*, uint32_t*);
 typedef  RetCode (*GetModuleMethodsRangesDelegate)(PVOID, uint32_t, PVOID, uint32_t, PVOID, PVOID*);
+typedef  RetCode (*GetModuleDocumentsDelegate)(PVOID, int32_t*, PVOID*);
+typedef  RetCode (*GetPdbChecksumDelegate)(PVOID, BSTR*);
 typedef  RetCode (*ResolveBreakPointsDelegate)(PVOID[], int32_t, PVOID, int32_t, int32_t, int32_t*, const WCHAR*, PVOID*);
+typedef  RetCode (*ResolveBreakPointsBatchDelegate)(PVOID, int32_t, PVOID, int32_t, int32_t*, PVOID*);
 typedef  RetCode (*GetAsyncMethodSteppingInfoDelegate)(PVOID, mdMethodDef, PVOID*, int32_t*, uint32_t*);
+typedef  RetCode (*GetStateMachineMethodDelegate)(PVOID, mdMethodDef, mdMethodDef*);
+typedef  RetCode (*GetSymbolReaderMemorySizeDelegate)(PVOID, int32_t*);
 typedef  RetCode (*GetSourceDelegate)(PVOID, const WCHAR*, int32_t*, PVOID*);
 typedef  PVOID (*LoadDeltaPdbDelegate)(const WCHAR*, PVOID*, int32_t*);
+typedef  void (*SetSymbolServersDelegate)(const WCHAR*, const WCHAR*);
+typedef  RetCode (*DownloadSymbolsForModuleDelegate)(const WCHAR*);
+typedef  RetCode (*GetSourceLinkInfoDelegate)(PVOID, const WCHAR*, BSTR*, BSTR*);
+typedef  RetCode (*DownloadSourceDelegate)(const WCHAR*, const WCHAR*);
 typedef  RetCode (*CalculationDelegate)(PVOID, int32_t, PVOID, int32_t, int32_t, int32_t*, PVOID*, BSTR*);
 typedef  int (*GenerateStackMachineProgramDelegate)(const WCHAR*, PVOID*, BSTR*);
 typedef  void (*ReleaseStackMachineProgramDelegate)(PVOID);
-typedef  int (*NextStackCommandDelegate)(PVOID, int32_t*, PVOID*, BSTR*);
+typedef  int (*GetStackMachineProgramCommandsDelegate)(PVOID, int32_t*, PVOID*, BSTR*);
 typedef  RetCode (*StringToUpperDelegate)(const WCHAR*, BSTR*);
 typedef  PVOID (*CoTaskMemAllocDelegate)(int32_t);
 typedef  void (*CoTaskMemFreeDelegate)(PVOID);
@@ -81,20 +96,29 @@ typedef  void (*SysFreeStringDelegate)(PVOID);
 
 LoadSymbolsForModuleDelegate loadSymbolsForModuleDelegate = nullptr;
 DisposeDelegate disposeDelegate = nullptr;
-GetLocalVariableNameAndScope getLocalVariableNameAndScopeDelegate = nullptr;
+GetLocalVariablesTable getLocalVariablesTableDelegate = nullptr;
 GetHoistedLocalScopes getHoistedLocalScopesDelegate = nullptr;
 GetSequencePointByILOffsetDelegate getSequencePointByILOffsetDelegate = nullptr;
 GetSequencePointsDelegate getSequencePointsDelegate = nullptr;
 GetNextUserCodeILOffsetDelegate getNextUserCodeILOffsetDelegate = nullptr;
 GetStepRangesFromIPDelegate getStepRangesFromIPDelegate = nullptr;
 GetModuleMethodsRangesDelegate getModuleMethodsRangesDelegate = nullptr;
+GetModuleDocumentsDelegate getModuleDocumentsDelegate = nullptr;
+GetPdbChecksumDelegate getPdbChecksumDelegate = nullptr;
 ResolveBreakPointsDelegate resolveBreakPointsDelegate = nullptr;
+ResolveBreakPointsBatchDelegate resolveBreakPointsBatchDelegate = nullptr;
 GetAsyncMethodSteppingInfoDelegate getAsyncMethodSteppingInfoDelegate = nullptr;
+GetStateMachineMethodDelegate getStateMachineMethodDelegate = nullptr;
+GetSymbolReaderMemorySizeDelegate getSymbolReaderMemorySizeDelegate = nullptr;
 GetSourceDelegate getSourceDelegate = nullptr;
 LoadDeltaPdbDelegate loadDeltaPdbDelegate = nullptr;
+SetSymbolServersDelegate setSymbolServersDelegate = nullptr;
+DownloadSymbolsForModuleDelegate downloadSymbolsForModuleDelegate = nullptr;
+GetSourceLinkInfoDelegate getSourceLinkInfoDelegate = nullptr;
+DownloadSourceDelegate downloadSourceDelegate = nullptr;
 GenerateStackMachineProgramDelegate generateStackMachineProgramDelegate = nullptr;
 ReleaseStackMachineProgramDelegate releaseStackMachineProgramDelegate = nullptr;
-NextStackCommandDelegate nextStackCommandDelegate = nullptr;
+GetStackMachineProgramCommandsDelegate getStackMachineProgramCommandsDelegate = nullptr;
 StringToUpperDelegate stringToUpperDelegate = nullptr;
 CoTaskMemAllocDelegate coTaskMemAllocDelegate = nullptr;
 CoTaskMemFreeDelegate coTaskMemFreeDelegate = nullptr;
@@ -102,6 +126,10 @@ SysAllocStringLenDelegate sysAllocStringLenDelegate = nullptr;
 SysFreeStringDelegate sysFreeStringDelegate = nullptr;
 CalculationDelegate calculationDelegate = nullptr;
 
+// Note, symbol servers could be configured before managed part initialization, CLRrwlock protect this data too.
+std::string symbolServers;
+std::string symbolCachePath;
+
 constexpr char ManagedPartDllName[] = "ManagedPart";
 constexpr char SymbolReaderClassName[] = "NetCoreDbg.SymbolReader";
 constexpr char EvaluationClassName[] = "NetCoreDbg.Evaluation";
@@ -116,8 +144,52 @@ int ReadMemoryForSymbols(uint64_t address, char *buffer, int cb)
     return 0;
 }
 
+long long ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return (long long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Compile test expression in background thread, so, Roslyn assemblies will be loaded and JIT-ed before first evaluation.
+// Note, must be called with CLRrwlock (reader or writer) and warmUpMutex locked.
+void StartWarmUp()
+{
+    if (!warmUpRequested || warmUpStarted)
+        return;
+
+    warmUpStarted = true;
+    std::thread([]()
+    {
+        auto startTime = std::chrono::steady_clock::now();
+        std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
+        if (!generateStackMachineProgramDelegate || !releaseStackMachineProgramDelegate)
+            return;
+
+        PVOID pStackProgram = nullptr;
+        BSTR wTextOutput = nullptr;
+        generateStackMachineProgramDelegate(to_utf16("1 + 1").c_str(), &pStackProgram, &wTextOutput);
+        if (pStackProgram)
+            releaseStackMachineProgramDelegate(pStackProgram);
+        read_lock.unlock();
+
+        if (wTextOutput)
+            Interop::SysFreeString(wTextOutput);
+
+        LOGI("Startup timing: expression compiler warm up %lld ms", ElapsedMs(startTime));
+    }).detach();
+}
+
 } // unnamed namespace
 
+void WarmUpExpressionCompiler()
+{
+    std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
+    std::lock_guard<std::mutex> lock(warmUpMutex);
+    warmUpRequested = true;
+    // Note, in case managed part is not initialized yet, warm up will be started at the end of Init().
+    if (shutdownCoreClr != nullptr)
+        StartWarmUp();
+}
+
 HRESULT LoadSymbolsForPortablePDB(const std::string &modulePath, BOOL isInMemory, BOOL isFileLayout, ULONG64 peAddress, ULONG64 peSize,
                                   ULONG64 inMemoryPdbAddress, ULONG64 inMemoryPdbSize, VOID **ppSymbolReaderHandle)
 {
@@ -142,11 +214,81 @@ HRESULT LoadSymbolsForPortablePDB(const std::string &modulePath, BOOL isInMemory
     return S_OK;
 }
 
+void SetSymbolServers(const std::string &servers, const std::string &cachePath)
+{
+    std::unique_lock<Utility::RWLock::Writer> write_lock(CLRrwlock.writer);
+    symbolServers = servers;
+    symbolCachePath = cachePath;
+
+    // Note, in case managed part is not initialized yet, settings will be applied at the end of Init().
+    if (setSymbolServersDelegate)
+        setSymbolServersDelegate(to_utf16(symbolServers).c_str(), to_utf16(symbolCachePath).c_str());
+}
+
+HRESULT DownloadSymbolsForModule(const std::string &modulePath)
+{
+    std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
+    if (!downloadSymbolsForModuleDelegate || modulePath.empty() || symbolServers.empty() || symbolCachePath.empty())
+        return E_FAIL;
+
+    RetCode retCode = downloadSymbolsForModuleDelegate(to_utf16(modulePath).c_str());
+    return retCode == RetCode::OK ? S_OK : E_FAIL;
+}
+
+HRESULT GetSourceLinkInfo(PVOID pSymbolReaderHandle, const std::string &sourcePath, std::string &url, std::string &contentKey)
+{
+    std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
+    if (!getSourceLinkInfoDelegate || !pSymbolReaderHandle)
+        return E_FAIL;
+
+    BSTR wUrl = nullptr;
+    BSTR wContentKey = nullptr;
+    RetCode retCode = getSourceLinkInfoDelegate(pSymbolReaderHandle, to_utf16(sourcePath).c_str(), &wUrl, &wContentKey);
+    read_lock.unlock();
+
+    if (retCode != RetCode::OK || !wUrl || !wContentKey)
+    {
+        Interop::SysFreeString(wUrl);
+        Interop::SysFreeString(wContentKey);
+        return E_FAIL;
+    }
+
+    url = to_utf8(wUrl);
+    contentKey = to_utf8(wContentKey);
+    Interop::SysFreeString(wUrl);
+    Interop::SysFreeString(wContentKey);
+
+    return S_OK;
+}
+
+HRESULT DownloadSource(const std::string &url, const std::string &filePath)
+{
+    std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
+    if (!downloadSourceDelegate)
+        return E_FAIL;
+
+    RetCode retCode = downloadSourceDelegate(to_utf16(url).c_str(), to_utf16(filePath).c_str());
+    return retCode == RetCode::OK ? S_OK : E_FAIL;
+}
+
 SequencePoint::~SequencePoint() noexcept
 {
     Interop::SysFreeString(document);
 }
 
+SequencePoints::~SequencePoints() noexcept
+{
+    Reset();
+}
+
+void SequencePoints::Reset(PVOID data)
+{
+    if (m_data)
+        Interop::CoTaskMemFree(m_data);
+
+    m_data = data;
+}
+
 void DisposeSymbols(PVOID pSymbolReaderHandle)
 {
     std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
@@ -166,6 +308,7 @@ void Init(const std::string &coreClrPath)
     if (shutdownCoreClr != nullptr)
         return;
 
+    auto startTime = std::chrono::steady_clock::now();
     std::string clrDir = coreClrPath.substr(0, coreClrPath.rfind(DIRECTORY_SEPARATOR_STR_A));
 
     HRESULT Status;
@@ -179,6 +322,7 @@ void Init(const std::string &coreClrPath)
     if (coreclrLib == nullptr)
         throw std::invalid_argument("Failed to load coreclr path=" + coreClrPath);
 
+    long long loadTime = ElapsedMs(startTime);
     coreclr_initialize_ptr initializeCoreCLR = (coreclr_initialize_ptr)DLSym(coreclrLib, "coreclr_initialize");
     if (initializeCoreCLR == nullptr)
         throw std::invalid_argument("coreclr_initialize not found in lib, CoreCLR path=" + coreClrPath);
@@ -215,6 +359,8 @@ void Init(const std::string &coreClrPath)
     if (FAILED(Status))
         throw std::runtime_error("Fail to initialize CoreCLR " + std::to_string(Status));
 
+    long long initializeTime = ElapsedMs(startTime);
+
     coreclr_create_delegate_ptr createDelegate = (coreclr_create_delegate_ptr)DLSym(coreclrLib, "coreclr_create_delegate");
     if (createDelegate == nullptr)
         throw std::runtime_error("coreclr_create_delegate not found");
@@ -226,21 +372,30 @@ void Init(const std::string &coreClrPath)
     bool allDelegatesCreated = 
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "LoadSymbolsForModule", (void **)&loadSymbolsForModuleDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "Dispose", (void **)&disposeDelegate)) &&
-        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetLocalVariableNameAndScope", (void **)&getLocalVariableNameAndScopeDelegate)) &&
+        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetLocalVariablesTable", (void **)&getLocalVariablesTableDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetHoistedLocalScopes", (void **)&getHoistedLocalScopesDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetSequencePointByILOffset", (void **)&getSequencePointByILOffsetDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetSequencePoints", (void **)&getSequencePointsDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetNextUserCodeILOffset", (void **)&getNextUserCodeILOffsetDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetStepRangesFromIP", (void **)&getStepRangesFromIPDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetModuleMethodsRanges", (void **)&getModuleMethodsRangesDelegate)) &&
+        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetModuleDocuments", (void **)&getModuleDocumentsDelegate)) &&
+        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetPdbChecksum", (void **)&getPdbChecksumDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "ResolveBreakPoints", (void **)&resolveBreakPointsDelegate)) &&
+        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "ResolveBreakPointsBatch", (void **)&resolveBreakPointsBatchDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetAsyncMethodSteppingInfo", (void **)&getAsyncMethodSteppingInfoDelegate)) &&
+        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetStateMachineMethod", (void **)&getStateMachineMethodDelegate)) &&
+        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetSymbolReaderMemorySize", (void **)&getSymbolReaderMemorySizeDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetSource", (void **)&getSourceDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "LoadDeltaPdb", (void **)&loadDeltaPdbDelegate)) &&
+        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "SetSymbolServers", (void **)&setSymbolServersDelegate)) &&
+        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "DownloadSymbolsForModule", (void **)&downloadSymbolsForModuleDelegate)) &&
+        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetSourceLinkInfo", (void **)&getSourceLinkInfoDelegate)) &&
+        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "DownloadSource", (void **)&downloadSourceDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, EvaluationClassName, "CalculationDelegate", (void **)&calculationDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, EvaluationClassName, "GenerateStackMachineProgram", (void **)&generateStackMachineProgramDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, EvaluationClassName, "ReleaseStackMachineProgram", (void **)&releaseStackMachineProgramDelegate)) &&
-        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, EvaluationClassName, "NextStackCommand", (void **)&nextStackCommandDelegate)) &&
+        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, EvaluationClassName, "GetStackMachineProgramCommands", (void **)&getStackMachineProgramCommandsDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, UtilsClassName, "StringToUpper", (void **)&stringToUpperDelegate));
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, UtilsClassName, "CoTaskMemAlloc", (void **)&coTaskMemAllocDelegate));
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, UtilsClassName, "CoTaskMemFree", (void **)&coTaskMemFreeDelegate));
@@ -259,13 +414,22 @@ void Init(const std::string &coreClrPath)
                               getNextUserCodeILOffsetDelegate &&
                               getStepRangesFromIPDelegate &&
                               getModuleMethodsRangesDelegate &&
+                              getModuleDocumentsDelegate &&
+                              getPdbChecksumDelegate &&
                               resolveBreakPointsDelegate &&
+                              resolveBreakPointsBatchDelegate &&
                               getAsyncMethodSteppingInfoDelegate &&
+                              getStateMachineMethodDelegate &&
+                              getSymbolReaderMemorySizeDelegate &&
                               getSourceDelegate &&
                               loadDeltaPdbDelegate &&
+                              setSymbolServersDelegate &&
+                              downloadSymbolsForModuleDelegate &&
+                              getSourceLinkInfoDelegate &&
+                              downloadSourceDelegate &&
                               generateStackMachineProgramDelegate &&
                               releaseStackMachineProgramDelegate &&
-                              nextStackCommandDelegate &&
+                              getStackMachineProgramCommandsDelegate &&
                               stringToUpperDelegate &&
                               coTaskMemAllocDelegate &&
                               coTaskMemFreeDelegate &&
@@ -275,6 +439,16 @@ void Init(const std::string &coreClrPath)
 
     if (!allDelegatesInited)
         throw std::runtime_error("Some delegates nulled");
+
+    if (!symbolServers.empty() || !symbolCachePath.empty())
+        setSymbolServersDelegate(to_utf16(symbolServers).c_str(), to_utf16(symbolCachePath).c_str());
+
+    long long totalTime = ElapsedMs(startTime);
+    LOGI("Startup timing: CoreCLR load %lld ms, CoreCLR initialize %lld ms, managed part delegates %lld ms, total %lld ms",
+         loadTime, initializeTime - loadTime, totalTime - initializeTime, totalTime);
+
+    std::lock_guard<std::mutex> lock(warmUpMutex);
+    StartWarmUp();
 }
 
 // WARNING! Due to CoreCLR limitations, Shutdown() can't be called out of the Main() scope, for example, from global object destructor.
@@ -299,10 +473,22 @@ void Shutdown()
     getNextUserCodeILOffsetDelegate = nullptr;
     getStepRangesFromIPDelegate = nullptr;
     getModuleMethodsRangesDelegate = nullptr;
+    getModuleDocumentsDelegate = nullptr;
+    getPdbChecksumDelegate = nullptr;
     resolveBreakPointsDelegate = nullptr;
+    resolveBreakPointsBatchDelegate = nullptr;
     getAsyncMethodSteppingInfoDelegate = nullptr;
+    getStateMachineMethodDelegate = nullptr;
+    getSymbolReaderMemorySizeDelegate = nullptr;
     getSourceDelegate = nullptr;
     loadDeltaPdbDelegate = nullptr;
+    setSymbolServersDelegate = nullptr;
+    downloadSymbolsForModuleDelegate = nullptr;
+    getSourceLinkInfoDelegate = nullptr;
+    downloadSourceDelegate = nullptr;
+    generateStackMachineProgramDelegate = nullptr;
+    releaseStackMachineProgramDelegate = nullptr;
+    getStackMachineProgramCommandsDelegate = nullptr;
     stringToUpperDelegate = nullptr;
     coTaskMemAllocDelegate = nullptr;
     coTaskMemFreeDelegate = nullptr;
@@ -323,14 +509,17 @@ HRESULT GetSequencePointByILOffset(PVOID pSymbolReaderHandle, mdMethodDef method
     return retCode == RetCode::OK ? S_OK : E_FAIL;
 }
 
-HRESULT GetSequencePoints(PVOID pSymbolReaderHandle, mdMethodDef methodToken, SequencePoint **sequencePoints, int32_t &Count)
+HRESULT GetSequencePoints(PVOID pSymbolReaderHandle, mdMethodDef methodToken, bool includeHidden, SequencePoints &sequencePoints)
 {
     std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
     if (!getSequencePointsDelegate || !pSymbolReaderHandle)
         return E_FAIL;
 
-    RetCode retCode = getSequencePointsDelegate(pSymbolReaderHandle, methodToken, (PVOID*)sequencePoints, &Count);
+    PVOID data = nullptr;
+    RetCode retCode = getSequencePointsDelegate(pSymbolReaderHandle, methodToken, includeHidden ? 1 : 0, &data);
+    read_lock.unlock();
 
+    sequencePoints.Reset(data);
     return retCode == RetCode::OK ? S_OK : E_FAIL;
 }
 
@@ -361,28 +550,43 @@ HRESULT GetStepRangesFromIP(PVOID pSymbolReaderHandle, ULONG32 ip, mdMethodDef M
     return retCode == RetCode::OK ? S_OK : E_FAIL;
 }
 
-HRESULT GetNamedLocalVariableAndScope(PVOID pSymbolReaderHandle, mdMethodDef methodToken, ULONG localIndex,
-                                      WCHAR *localName, ULONG localNameLen, ULONG32 *pIlStart, ULONG32 *pIlEnd)
+HRESULT GetLocalVariables(PVOID pSymbolReaderHandle, mdMethodDef methodToken, std::vector<LocalVariable> &locals)
 {
     std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
-    if (!getLocalVariableNameAndScopeDelegate || !pSymbolReaderHandle || !localName || !pIlStart || !pIlEnd)
+    if (!getLocalVariablesTableDelegate || !pSymbolReaderHandle)
         return E_FAIL;
 
-    BSTR wszLocalName = Interop::SysAllocStringLen(mdNameLen);
-    if (InteropPlatform::SysStringLen(wszLocalName) == 0)
-        return E_OUTOFMEMORY;
-
-    RetCode retCode = getLocalVariableNameAndScopeDelegate(pSymbolReaderHandle, methodToken, localIndex, &wszLocalName, pIlStart, pIlEnd);
+    struct local_variable_t
+    {
+        int32_t index;
+        int32_t ilStartOffset;
+        int32_t ilEndOffset;
+        BSTR name;
+    };
+
+    PVOID data = nullptr;
+    int32_t count = 0;
+    RetCode retCode = getLocalVariablesTableDelegate(pSymbolReaderHandle, methodToken, &data, &count);
     read_lock.unlock();
 
     if (retCode != RetCode::OK)
-    {
-        Interop::SysFreeString(wszLocalName);
         return E_FAIL;
-    }
 
-    wcscpy_s(localName, localNameLen, wszLocalName);
-    Interop::SysFreeString(wszLocalName);
+    locals.reserve(count);
+    local_variable_t *pLocals = static_cast<local_variable_t*>(data);
+    for (int32_t i = 0; i < count; i++)
+    {
+        locals.emplace_back();
+        locals.back().index = (ULONG32)pLocals[i].index;
+        locals.back().ilStart = (ULONG32)pLocals[i].ilStartOffset;
+        locals.back().ilEnd = (ULONG32)pLocals[i].ilEndOffset;
+        if (!pLocals[i].name)
+            continue;
+        locals.back().name = pLocals[i].name;
+        Interop::SysFreeString(pLocals[i].name);
+    }
+    if (data)
+        Interop::CoTaskMemFree(data);
 
     return S_OK;
 }
@@ -427,6 +631,56 @@ HRESULT GetModuleMethodsRanges(PVOID pSymbolReaderHandle, uint32_t constrTokensN
     return retCode == RetCode::OK ? S_OK : E_FAIL;
 }
 
+HRESULT GetModuleDocuments(PVOID pSymbolReaderHandle, std::vector<std::string> &documents)
+{
+    std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
+    if (!getModuleDocumentsDelegate || !pSymbolReaderHandle)
+        return E_FAIL;
+
+    BSTR *allocatedDocuments = nullptr;
+    int32_t documentsCount = 0;
+    RetCode retCode = getModuleDocumentsDelegate(pSymbolReaderHandle, &documentsCount, (PVOID*)&allocatedDocuments);
+    read_lock.unlock();
+
+    if (retCode != RetCode::OK)
+        return E_FAIL;
+
+    if (documentsCount == 0)
+    {
+        assert(allocatedDocuments == nullptr);
+        return S_OK;
+    }
+
+    documents.reserve(documents.size() + documentsCount);
+    for (int32_t i = 0; i < documentsCount; i++)
+    {
+        documents.emplace_back(to_utf8(allocatedDocuments[i]));
+        Interop::SysFreeString(allocatedDocuments[i]);
+    }
+
+    Interop::CoTaskMemFree(allocatedDocuments);
+    return S_OK;
+}
+
+HRESULT GetPdbChecksum(PVOID pSymbolReaderHandle, std::string &pdbChecksum)
+{
+    std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
+    if (!getPdbChecksumDelegate || !pSymbolReaderHandle)
+        return E_FAIL;
+
+    BSTR wPdbChecksum = nullptr;
+    RetCode retCode = getPdbChecksumDelegate(pSymbolReaderHandle, &wPdbChecksum);
+    read_lock.unlock();
+
+    if (retCode != RetCode::OK || !wPdbChecksum)
+        return E_FAIL;
+
+    pdbChecksum = to_utf8(wPdbChecksum);
+    Interop::SysFreeString(wPdbChecksum);
+
+    return S_OK;
+}
+
 HRESULT ResolveBreakPoints(PVOID pSymbolReaderHandles[], int32_t tokenNum, PVOID Tokens, int32_t sourceLine, int32_t nestedToken, int32_t &Count, const std::string &sourcePath, PVOID *data)
 {
     std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
@@ -437,6 +691,30 @@ HRESULT ResolveBreakPoints(PVOID pSymbolReaderHandles[], int32_t tokenNum, PVOID
     return retCode == RetCode::OK ? S_OK : E_FAIL;
 }
 
+HRESULT ResolveBreakPointsBatch(const std::vector<ResolveBreakPointsRequest> &requests, const std::vector<std::string> &sourcePaths, int32_t &Count, PVOID *data)
+{
+    std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
+    if (!resolveBreakPointsBatchDelegate || requests.empty() || !data)
+        return E_FAIL;
+
+    std::vector<WSTRING> wSourcePaths;
+    wSourcePaths.reserve(sourcePaths.size());
+    for (const auto &sourcePath : sourcePaths)
+    {
+        wSourcePaths.emplace_back(to_utf16(sourcePath));
+    }
+    std::vector<const WCHAR*> wSourcePathsPtrs;
+    wSourcePathsPtrs.reserve(wSourcePaths.size());
+    for (const auto &wSourcePath : wSourcePaths)
+    {
+        wSourcePathsPtrs.emplace_back(wSourcePath.c_str());
+    }
+
+    RetCode retCode = resolveBreakPointsBatchDelegate((PVOID)requests.data(), (int32_t)requests.size(),
+                                                      (PVOID)wSourcePathsPtrs.data(), (int32_t)wSourcePathsPtrs.size(), &Count, data);
+    return retCode == RetCode::OK ? S_OK : E_FAIL;
+}
+
 HRESULT GetAsyncMethodSteppingInfo(PVOID pSymbolReaderHandle, mdMethodDef methodToken, std::vector<AsyncAwaitInfoBlock> &AsyncAwaitInfo, ULONG32 *ilOffset)
 {
     std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
@@ -464,6 +742,28 @@ HRESULT GetAsyncMethodSteppingInfo(PVOID pSymbolReaderHandle, mdMethodDef method
     return S_OK;
 }
 
+HRESULT GetStateMachineMethod(PVOID pSymbolReaderHandle, mdMethodDef kickoffMethodToken, mdMethodDef &moveNextMethodToken)
+{
+    std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
+    if (!getStateMachineMethodDelegate || !pSymbolReaderHandle)
+        return E_FAIL;
+
+    RetCode retCode = getStateMachineMethodDelegate(pSymbolReaderHandle, kickoffMethodToken, &moveNextMethodToken);
+    return retCode == RetCode::OK ? S_OK : E_FAIL;
+}
+
+HRESULT GetSymbolReaderMemorySize(PVOID pSymbolReaderHandle, uint64_t &size)
+{
+    std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
+    if (!getSymbolReaderMemorySizeDelegate || !pSymbolReaderHandle)
+        return E_FAIL;
+
+    int32_t readerSize = 0;
+    RetCode retCode = getSymbolReaderMemorySizeDelegate(pSymbolReaderHandle, &readerSize);
+    size = (uint64_t)readerSize;
+    return retCode == RetCode::OK ? S_OK : E_FAIL;
+}
+
 HRESULT GenerateStackMachineProgram(const std::string &expr, PVOID *ppStackProgram, std::string &textOutput)
 {
     std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
@@ -493,17 +793,19 @@ void ReleaseStackMachineProgram(PVOID pStackProgram)
     releaseStackMachineProgramDelegate(pStackProgram);
 }
 
-// Note, managed part will release Ptr unmanaged memory at object finalizer call after ReleaseStackMachineProgram() call.
-// Native part must not release Ptr memory, allocated by managed part.
-HRESULT NextStackCommand(PVOID pStackProgram, int32_t &Command, PVOID &Ptr, std::string &textOutput)
+// Note, managed part will release commands arguments unmanaged memory at object finalizer call after ReleaseStackMachineProgram() call.
+// Native part must not release commands arguments memory, allocated by managed part.
+HRESULT GetStackMachineProgramCommands(PVOID pStackProgram, std::vector<StackCommand> &commands, std::string &textOutput)
 {
     std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
-    if (!nextStackCommandDelegate || !pStackProgram)
+    if (!getStackMachineProgramCommandsDelegate || !pStackProgram)
         return E_FAIL;
 
     textOutput = "";
     BSTR wTextOutput = nullptr;
-    HRESULT Status = nextStackCommandDelegate(pStackProgram, &Command, &Ptr, &wTextOutput);
+    int32_t count = 0;
+    PVOID pCommands = nullptr;
+    HRESULT Status = getStackMachineProgramCommandsDelegate(pStackProgram, &count, &pCommands, &wTextOutput);
     read_lock.unlock();
 
     if (wTextOutput)
@@ -512,6 +814,13 @@ HRESULT NextStackCommand(PVOID pStackProgram, int32_t &Command, PVOID &Ptr, std:
         SysFreeString(wTextOutput);
     }
 
+    if (pCommands == nullptr)
+        return Status;
+
+    if (SUCCEEDED(Status))
+        commands.assign((StackCommand*)pCommands, (StackCommand*)pCommands + count);
+
+    Interop::CoTaskMemFree(pCommands);
     return Status;
 }
 
@@ -531,6 +840,17 @@ PVOID AllocString(const std::string &str)
 
 HRESULT StringToUpper(std::string &String)
 {
+    // Note, most of strings here are source paths with ASCII characters only, convert them without managed part call.
+    if (std::all_of(String.begin(), String.end(), [](char c) { return (unsigned char)c < 0x80; }))
+    {
+        for (char &c : String)
+        {
+            if (c >= 'a' && c <= 'z')
+                c = c - 'a' + 'A';
+        }
+        return S_OK;
+    }
+
     std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
     if (!stringToUpperDelegate)
         return E_FAIL;
@@ -5,6 +5,7 @@
 // Copyright (c) 2017 Samsung Electronics Co., LTD
 #pragma once
 #include "utils/platform.h"
+#include "utils/utf.h"
 
 #include "cor.h"
 #include "cordebug.h"
@@ -67,6 +68,71 @@ namespace Interop
         }
     };
 
+    // All sequence points of method in one memory block allocated by managed part, documents stored once in documents table.
+    class SequencePoints
+    {
+    public:
+
+        struct Row
+        {
+            int32_t startLine;
+            int32_t startColumn;
+            int32_t endLine;
+            int32_t endColumn;
+            int32_t offset;
+            int32_t documentIndex; // -1 in case sequence point don't have document
+        };
+
+        SequencePoints() : m_data(nullptr) {}
+        ~SequencePoints() noexcept;
+
+        SequencePoints(const SequencePoints&) = delete;
+        SequencePoints& operator=(const SequencePoints&) = delete;
+
+        // Take ownership of memory block provided by managed part.
+        void Reset(PVOID data = nullptr);
+
+        int32_t GetCount() const
+        {
+            return m_data ? static_cast<const int32_t*>(m_data)[0] : 0;
+        }
+
+        int32_t GetDocumentsCount() const
+        {
+            return m_data ? static_cast<const int32_t*>(m_data)[1] : 0;
+        }
+
+        const Row &operator[](int32_t index) const
+        {
+            return GetRows()[index];
+        }
+
+        // Return null-terminated UTF-16 string, valid till Reset() call or object destruction.
+        const WCHAR *GetDocument(int32_t documentIndex) const
+        {
+            const int32_t *documentsOffsets = reinterpret_cast<const int32_t*>(GetRows() + GetCount());
+            return reinterpret_cast<const WCHAR*>(static_cast<const char*>(m_data) + documentsOffsets[documentIndex]);
+        }
+
+    private:
+
+        // Memory block layout: int32_t count, int32_t documentsCount, Row rows[count], int32_t documentsOffsets[documentsCount], strings.
+        PVOID m_data;
+
+        const Row *GetRows() const
+        {
+            return reinterpret_cast<const Row*>(static_cast<const int32_t*>(m_data) + 2);
+        }
+    };
+
+    struct LocalVariable
+    {
+        ULONG32 index;
+        ULONG32 ilStart;
+        ULONG32 ilEnd;
+        WSTRING name;
+    };
+
     struct AsyncAwaitInfoBlock
     {
         uint32_t yield_offset;
@@ -78,31 +144,70 @@ namespace Interop
         {}
     };
 
+    // Stack machine program command, arguments memory owned by stack machine program in managed part.
+    struct StackCommand
+    {
+        int32_t command;
+        PVOID arguments;
+    };
+
+    struct ResolveBreakPointsRequest
+    {
+        PVOID *symbolReaderHandles; // one symbol reader handle for each token
+        PVOID Tokens; // mdMethodDef array
+        int32_t tokenNum;
+        int32_t sourceLine;
+        int32_t nestedToken;
+        int32_t sourcePathIndex; // index in sourcePaths array provided to ResolveBreakPointsBatch()
+
+        ResolveBreakPointsRequest(PVOID *symbolReaderHandles_, PVOID Tokens_, int32_t tokenNum_, int32_t sourceLine_, int32_t nestedToken_, int32_t sourcePathIndex_) :
+            symbolReaderHandles(symbolReaderHandles_), Tokens(Tokens_), tokenNum(tokenNum_), sourceLine(sourceLine_), nestedToken(nestedToken_), sourcePathIndex(sourcePathIndex_)
+        {}
+    };
+
     // WARNING! Due to CoreCLR limitations, Init() / Shutdown() sequence can be used only once during process execution.
     // Note, init in case of error will throw exception, since this is fatal for debugger (CoreCLR can't be re-init).
     void Init(const std::string &coreClrPath);
     // WARNING! Due to CoreCLR limitations, Shutdown() can't be called out of the Main() scope, for example, from global object destructor.
     void Shutdown();
+    // Request expression compiler (Roslyn) warm up in background thread, in case managed part is not initialized yet,
+    // warm up will be started right after Init().
+    void WarmUpExpressionCompiler();
 
     HRESULT LoadSymbolsForPortablePDB(const std::string &modulePath, BOOL isInMemory, BOOL isFileLayout, ULONG64 peAddress, ULONG64 peSize,
                                       ULONG64 inMemoryPdbAddress, ULONG64 inMemoryPdbSize, VOID **ppSymbolReaderHandle);
     void DisposeSymbols(PVOID pSymbolReaderHandle);
     HRESULT GetSequencePointByILOffset(PVOID pSymbolReaderHandle, mdMethodDef MethodToken, ULONG32 IlOffset, SequencePoint *sequencePoint);
-    HRESULT GetSequencePoints(PVOID pSymbolReaderHandle, mdMethodDef MethodToken, SequencePoint **sequencePoints, int32_t &Count);
+    // Note, in case includeHidden is false, only user code sequence points provided.
+    HRESULT GetSequencePoints(PVOID pSymbolReaderHandle, mdMethodDef MethodToken, bool includeHidden, SequencePoints &sequencePoints);
     HRESULT GetNextUserCodeILOffset(PVOID pSymbolReaderHandle, mdMethodDef MethodToken, ULONG32 IlOffset, ULONG32 &ilNextOffset, bool *noUserCodeFound);
-    HRESULT GetNamedLocalVariableAndScope(PVOID pSymbolReaderHandle, mdMethodDef methodToken, ULONG localIndex,
-                                          WCHAR *localName, ULONG localNameLen, ULONG32 *pIlStart, ULONG32 *pIlEnd);
+    // Note, debugger hidden locals are not provided, same local index could be provided for different scopes.
+    HRESULT GetLocalVariables(PVOID pSymbolReaderHandle, mdMethodDef methodToken, std::vector<LocalVariable> &locals);
     HRESULT GetHoistedLocalScopes(PVOID pSymbolReaderHandle, mdMethodDef methodToken, PVOID *data, int32_t &hoistedLocalScopesCount);
     HRESULT GetStepRangesFromIP(PVOID pSymbolReaderHandle, ULONG32 ip, mdMethodDef MethodToken, ULONG32 *ilStartOffset, ULONG32 *ilEndOffset);
     HRESULT GetModuleMethodsRanges(PVOID pSymbolReaderHandle, uint32_t constrTokensNum, PVOID constrTokens, uint32_t normalTokensNum, PVOID normalTokens, PVOID *data);
+    HRESULT GetModuleDocuments(PVOID pSymbolReaderHandle, std::vector<std::string> &documents);
+    HRESULT GetPdbChecksum(PVOID pSymbolReaderHandle, std::string &pdbChecksum);
     HRESULT ResolveBreakPoints(PVOID pSymbolReaderHandles[], int32_t tokenNum, PVOID Tokens, int32_t sourceLine, int32_t nestedToken, int32_t &Count, const std::string &sourcePath, PVOID *data);
+    // Note, data contain array of resolved breakpoints with additional `int32_t requestIndex` field (index in requests array).
+    HRESULT ResolveBreakPointsBatch(const std::vector<ResolveBreakPointsRequest> &requests, const std::vector<std::string> &sourcePaths, int32_t &Count, PVOID *data);
     HRESULT GetAsyncMethodSteppingInfo(PVOID pSymbolReaderHandle, mdMethodDef methodToken, std::vector<AsyncAwaitInfoBlock> &AsyncAwaitInfo, ULONG32 *ilOffset);
+    HRESULT GetStateMachineMethod(PVOID pSymbolReaderHandle, mdMethodDef kickoffMethodToken, mdMethodDef &moveNextMethodToken);
+    HRESULT GetSymbolReaderMemorySize(PVOID pSymbolReaderHandle, uint64_t &size);
     HRESULT GetSource(PVOID symbolReaderHandle, const std::string fileName, PVOID *data, int32_t *length);
+    // Symbol servers URLs separated by ';' and local symbols cache directory, used for PDB download.
+    void SetSymbolServers(const std::string &servers, const std::string &cachePath);
+    // Blocking call, download module PDB into local symbols cache, so, LoadSymbolsForPortablePDB() could be used again.
+    HRESULT DownloadSymbolsForModule(const std::string &modulePath);
+    // SourceLink URL and content key (document checksum) for document, in case module's PDB have SourceLink data.
+    HRESULT GetSourceLinkInfo(PVOID pSymbolReaderHandle, const std::string &sourcePath, std::string &url, std::string &contentKey);
+    // Blocking call, download source file by SourceLink URL.
+    HRESULT DownloadSource(const std::string &url, const std::string &filePath);
     HRESULT LoadDeltaPdb(const std::string &pdbPath, VOID **ppSymbolReaderHandle, std::unordered_set<mdMethodDef> &methodTokens);
     HRESULT CalculationDelegate(PVOID firstOp, int32_t firstType, PVOID secondOp, int32_t secondType, int32_t operationType, int32_t &resultType, PVOID *data, std::string &errorText);
     HRESULT GenerateStackMachineProgram(const std::string &expr, PVOID *ppStackProgram, std::string &textOutput);
     void ReleaseStackMachineProgram(PVOID pStackProgram);
-    HRESULT NextStackCommand(PVOID pStackProgram, int32_t &Command, PVOID &Ptr, std::string &textOutput);
+    HRESULT GetStackMachineProgramCommands(PVOID pStackProgram, std::vector<StackCommand> &commands, std::string &textOutput);
     PVOID AllocString(const std::string &str);
     HRESULT StringToUpper(std::string &String);
     BSTR SysAllocStringLen(int32_t size);
@@ -5,45 +5,109 @@
 #include "metadata/async_info.h"
 #include "metadata/modules.h"
 #include "managed/interop.h"
+#include <algorithm>
 
 
 namespace netcoredbg
 {
 
+const size_t AsyncInfo::MaxCachedMethods;
+
+static HRESULT CalculateAsyncMethodSteppingInfo(PVOID pSymbolReaderHandle, mdMethodDef methodToken,
+                                                std::vector<AsyncInfo::AwaitInfo> &awaits, ULONG32 &lastIlOffset)
+{
+    HRESULT Status;
+    std::vector<Interop::AsyncAwaitInfoBlock> AsyncAwaitInfo;
+    IfFailRet(Interop::GetAsyncMethodSteppingInfo(pSymbolReaderHandle, methodToken, AsyncAwaitInfo, &lastIlOffset));
+
+    awaits.reserve(AsyncAwaitInfo.size());
+    for (const auto &entry : AsyncAwaitInfo)
+    {
+        awaits.emplace_back(entry.yield_offset, entry.resume_offset);
+    }
+    // Note, PDB provide awaits in IL order, but we need guarantee this for binary search.
+    std::stable_sort(awaits.begin(), awaits.end(),
+                     [](const AsyncInfo::AwaitInfo &left, const AsyncInfo::AwaitInfo &right) { return left.yield_offset < right.yield_offset; });
+
+    return S_OK;
+}
+
+// Module's PDB async methods info is shared with module snapshot (loaded from previous debug session or stored at session end).
+static bool LoadSnapshotAsyncMethod(ModuleInfo &mdInfo, mdMethodDef methodToken, std::vector<AsyncInfo::AwaitInfo> &awaits,
+                                    ULONG32 &lastIlOffset, HRESULT &retCode)
+{
+    std::lock_guard<std::mutex> lock(mdInfo.m_snapshotState->m_mutex);
+    auto find = mdInfo.m_snapshotState->m_asyncMethods.find(methodToken);
+    if (find == mdInfo.m_snapshotState->m_asyncMethods.end())
+        return false;
+
+    awaits.reserve(find->second.awaits.size());
+    for (const auto &await : find->second.awaits)
+    {
+        awaits.emplace_back(await.yieldOffset, await.resumeOffset);
+    }
+    lastIlOffset = find->second.lastIlOffset;
+    retCode = find->second.retCode;
+    return true;
+}
+
+static void StoreSnapshotAsyncMethod(ModuleInfo &mdInfo, mdMethodDef methodToken, const std::vector<AsyncInfo::AwaitInfo> &awaits,
+                                     ULONG32 lastIlOffset, HRESULT retCode)
+{
+    std::lock_guard<std::mutex> lock(mdInfo.m_snapshotState->m_mutex);
+    if (mdInfo.m_snapshotState->m_key.empty() || mdInfo.m_snapshotState->m_asyncMethods.size() >= ModuleSnapshotCache::MaxAsyncMethods)
+        return;
+
+    module_snapshot_t::async_method_t &asyncMethod = mdInfo.m_snapshotState->m_asyncMethods[methodToken];
+    asyncMethod.methodToken = methodToken;
+    asyncMethod.retCode = retCode;
+    asyncMethod.lastIlOffset = lastIlOffset;
+    asyncMethod.awaits.clear();
+    for (const auto &await : awaits)
+    {
+        asyncMethod.awaits.push_back({await.yield_offset, await.resume_offset});
+    }
+    mdInfo.m_snapshotState->m_changed = true;
+}
+
 // Caller must care about m_asyncMethodSteppingInfoMutex.
-HRESULT AsyncInfo::GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion)
+HRESULT AsyncInfo::GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, AsyncMethodInfo **ppInfo)
 {
     // Note, for normal methods, `Interop::GetAsyncMethodSteppingInfo()` will return error code and set `lastIlOffset` to 0.
     // Error during async info search (debug info not available or method token belong to normal method) is proper behaviour and debugger logic also count on this.
 
-    if (asyncMethodSteppingInfo.modAddress == modAddress &&
-        asyncMethodSteppingInfo.methodToken == methodToken &&
-        asyncMethodSteppingInfo.methodVersion == methodVersion)
-        return asyncMethodSteppingInfo.retCode;
+    const method_key_t key(modAddress, methodToken, methodVersion);
+    auto find = m_asyncMethodsSteppingInfo.find(key);
+    if (find != m_asyncMethodsSteppingInfo.end())
+    {
+        *ppInfo = &find->second;
+        return find->second.retCode;
+    }
 
-    if (!asyncMethodSteppingInfo.awaits.empty())
-        asyncMethodSteppingInfo.awaits.clear();
+    if (m_asyncMethodsSteppingInfo.size() >= MaxCachedMethods)
+        m_asyncMethodsSteppingInfo.clear();
 
-    asyncMethodSteppingInfo.modAddress = modAddress;
-    asyncMethodSteppingInfo.methodToken = methodToken;
-    asyncMethodSteppingInfo.methodVersion = methodVersion;
+    AsyncMethodInfo &asyncMethodSteppingInfo = m_asyncMethodsSteppingInfo[key];
     asyncMethodSteppingInfo.retCode = m_sharedModules->GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
     {
-        if (mdInfo.m_symbolReaderHandles.empty() || mdInfo.m_symbolReaderHandles.size() < methodVersion)
-            return E_FAIL;
-
         HRESULT Status;
-        std::vector<Interop::AsyncAwaitInfoBlock> AsyncAwaitInfo;
-        IfFailRet(Interop::GetAsyncMethodSteppingInfo(mdInfo.m_symbolReaderHandles[methodVersion - 1], methodToken, AsyncAwaitInfo, &asyncMethodSteppingInfo.lastIlOffset));
+        if (methodVersion == 1 &&
+            LoadSnapshotAsyncMethod(mdInfo, methodToken, asyncMethodSteppingInfo.awaits, asyncMethodSteppingInfo.lastIlOffset, Status))
+            return Status;
 
-        for (const auto &entry : AsyncAwaitInfo)
-        {
-            asyncMethodSteppingInfo.awaits.emplace_back(entry.yield_offset, entry.resume_offset);
-        }
+        PVOID pSymbolReaderHandle = mdInfo.GetSymbolReaderHandle(methodVersion);
+        if (pSymbolReaderHandle == nullptr)
+            return E_FAIL;
+
+        Status = CalculateAsyncMethodSteppingInfo(pSymbolReaderHandle, methodToken, asyncMethodSteppingInfo.awaits,
+                                                  asyncMethodSteppingInfo.lastIlOffset);
+        if (methodVersion == 1)
+            StoreSnapshotAsyncMethod(mdInfo, methodToken, asyncMethodSteppingInfo.awaits, asyncMethodSteppingInfo.lastIlOffset, Status);
 
-        return S_OK;
+        return Status;
     });
 
+    *ppInfo = &asyncMethodSteppingInfo;
     return asyncMethodSteppingInfo.retCode;
 }
 
@@ -54,7 +118,8 @@ bool AsyncInfo::IsMethodHaveAwait(CORDB_ADDRESS modAddress, mdMethodDef methodTo
 {
     const std::lock_guard<std::mutex> lock(m_asyncMethodSteppingInfoMutex);
 
-    return SUCCEEDED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion));
+    AsyncMethodInfo *pInfo = nullptr;
+    return SUCCEEDED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion, &pInfo));
 }
 
 // Find await block after IL offset in particular async method and return await info, if present.
@@ -67,25 +132,23 @@ bool AsyncInfo::FindNextAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef methodTo
 {
     const std::lock_guard<std::mutex> lock(m_asyncMethodSteppingInfoMutex);
 
-    if (FAILED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion)))
+    AsyncMethodInfo *pInfo = nullptr;
+    if (FAILED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion, &pInfo)))
         return false;
 
-    for (auto &await : asyncMethodSteppingInfo.awaits)
-    {
-        if (ipOffset <= await.yield_offset)
-        {
-            if (awaitInfo)
-                *awaitInfo = &await;
-            return true;
-        }
-        // Stop search, if IP inside 'await' routine.
-        else if (ipOffset < await.resume_offset)
-        {
-            break;
-        }
-    }
+    // First await block with yield offset not less than IP.
+    auto it = std::lower_bound(pInfo->awaits.begin(), pInfo->awaits.end(), ipOffset,
+                               [](const AwaitInfo &await, ULONG32 offset) { return await.yield_offset < offset; });
+    if (it == pInfo->awaits.end())
+        return false;
 
-    return false;
+    // Stop search, if IP inside previous 'await' routine.
+    if (it != pInfo->awaits.begin() && ipOffset < std::prev(it)->resume_offset)
+        return false;
+
+    if (awaitInfo)
+        *awaitInfo = &(*it);
+    return true;
 }
 
 // Find last IL offset for user code in async method, if present.
@@ -98,10 +161,35 @@ bool AsyncInfo::FindLastIlOffsetAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef
 {
     const std::lock_guard<std::mutex> lock(m_asyncMethodSteppingInfoMutex);
 
-    if (FAILED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion)))
+    AsyncMethodInfo *pInfo = nullptr;
+    if (FAILED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion, &pInfo)))
+        return false;
+
+    lastIlOffset = pInfo->lastIlOffset;
+    return true;
+}
+
+// Find await block, that suspended state machine is waiting for.
+// Note, Roslyn number states of awaits (0, 1, ...) in order of awaits in lowered method body, that is the same as IL order
+// for all awaits except awaits in catch/finally blocks (code of this blocks is moved by compiler), so, result could be
+// wrong await of same method in this case.
+// [in] modAddress - module address;
+// [in] methodToken - MoveNext() method token (from module with address modAddress).
+// [in] state - state machine `<>1__state` field value;
+// [out] awaitInfo - result, await info.
+bool AsyncInfo::FindAwaitInfoByState(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, int32_t state, AwaitInfo &awaitInfo)
+{
+    if (state < 0)
+        return false;
+
+    const std::lock_guard<std::mutex> lock(m_asyncMethodSteppingInfoMutex);
+
+    AsyncMethodInfo *pInfo = nullptr;
+    if (FAILED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion, &pInfo)) ||
+        size_t(state) >= pInfo->awaits.size())
         return false;
 
-    lastIlOffset = asyncMethodSteppingInfo.lastIlOffset;
+    awaitInfo = pInfo->awaits[size_t(state)];
     return true;
 }
 
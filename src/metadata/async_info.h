@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 
 #include "metadata/modules.h"
 
@@ -37,6 +38,8 @@ public:
     bool IsMethodHaveAwait(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion);
     bool FindNextAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, ULONG32 ipOffset, AwaitInfo **awaitInfo);
     bool FindLastIlOffsetAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, ULONG32 &lastIlOffset);
+    // Await info for suspended state machine with `<>1__state` value `state`.
+    bool FindAwaitInfoByState(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, int32_t state, AwaitInfo &awaitInfo);
 
 private:
 
@@ -44,24 +47,51 @@ private:
 
     struct AsyncMethodInfo
     {
-        CORDB_ADDRESS modAddress;
-        mdMethodDef methodToken;
-        ULONG32 methodVersion;
         HRESULT retCode;
 
+        // Sorted by yield_offset.
         std::vector<AwaitInfo> awaits;
         // Part of NotifyDebuggerOfWaitCompletion magic, see ManagedDebugger::SetupAsyncStep().
         ULONG32 lastIlOffset;
 
         AsyncMethodInfo() :
-            modAddress(0), methodToken(mdMethodDefNil), methodVersion(0), retCode(S_OK), awaits(), lastIlOffset(0)
+            retCode(S_OK), awaits(), lastIlOffset(0)
         {};
     };
 
-    AsyncMethodInfo asyncMethodSteppingInfo;
+    struct method_key_t
+    {
+        CORDB_ADDRESS modAddress;
+        mdMethodDef methodToken;
+        ULONG32 methodVersion;
+
+        method_key_t(CORDB_ADDRESS modAddress_, mdMethodDef methodToken_, ULONG32 methodVersion_) :
+            modAddress(modAddress_), methodToken(methodToken_), methodVersion(methodVersion_)
+        {}
+
+        bool operator==(const method_key_t &that) const
+        {
+            return modAddress == that.modAddress && methodToken == that.methodToken && methodVersion == that.methodVersion;
+        }
+    };
+
+    struct method_key_hash
+    {
+        size_t operator()(const method_key_t &key) const
+        {
+            return std::hash<CORDB_ADDRESS>()(key.modAddress) ^
+                   (std::hash<mdMethodDef>()(key.methodToken) << 1) ^
+                   (std::hash<ULONG32>()(key.methodVersion) << 2);
+        }
+    };
+
+    // Stepping info for all methods, that was stepped (including normal methods with error return code).
+    // Note, cache cleared in case MaxCachedMethods reached (in real debug session this is not happens).
+    static const size_t MaxCachedMethods = 1024;
+    std::unordered_map<method_key_t, AsyncMethodInfo, method_key_hash> m_asyncMethodsSteppingInfo;
     std::mutex m_asyncMethodSteppingInfoMutex;
-    // Note, result stored into asyncMethodSteppingInfo.
-    HRESULT GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion);
+    // Note, result pointer valid only with m_asyncMethodSteppingInfoMutex locked.
+    HRESULT GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, AsyncMethodInfo **ppInfo);
 
 };
 
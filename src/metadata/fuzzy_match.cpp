@@ -0,0 +1,95 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/fuzzy_match.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <vector>
+
+namespace netcoredbg
+{
+
+namespace FuzzyMatch
+{
+
+namespace
+{
+    const int MatchScore = 1;
+    const int NameStartBonus = 8;
+    const int WordStartBonus = 6;
+    const int ContiguousBonus = 4;
+
+    char ToLower(char c)
+    {
+        return (char)tolower((unsigned char)c);
+    }
+
+    bool IsWordStart(Utility::string_view name, size_t pos)
+    {
+        if (pos == 0)
+            return true;
+
+        const unsigned char prev = (unsigned char)name[pos - 1];
+        const unsigned char cur = (unsigned char)name[pos];
+        return strchr("._-/\\ ", prev) != nullptr ||
+               (isupper(cur) && islower(prev)) ||
+               (isdigit(cur) && !isdigit(prev));
+    }
+} // unnamed namespace
+
+int Score(Utility::string_view pattern, Utility::string_view name)
+{
+    if (pattern.empty())
+        return 0;
+    if (pattern.size() > name.size())
+        return NoMatch;
+
+    // Note, greedy match could miss best match (for example, word start later in name), so, best score for each pattern
+    // character at each name position is calculated (pattern and names are short, O(pattern * name) is fine).
+    // `prev[j]` - best score with previous pattern character matched at name position `j`, NoMatch in case no match.
+    std::vector<int> prev(name.size(), NoMatch);
+    std::vector<int> cur(name.size(), NoMatch);
+    for (size_t i = 0; i < pattern.size(); i++)
+    {
+        const char p = ToLower(pattern[i]);
+        // Best score of previous pattern character at any position before `j - 1`.
+        int bestBefore = NoMatch;
+        for (size_t j = 0; j < name.size(); j++)
+        {
+            cur[j] = NoMatch;
+            if (i > 0 && j >= 2)
+                bestBefore = std::max(bestBefore, prev[j - 2]);
+
+            if (ToLower(name[j]) != p)
+                continue;
+
+            int bonus = MatchScore;
+            if (j == 0)
+                bonus += NameStartBonus;
+            else if (IsWordStart(name, j))
+                bonus += WordStartBonus;
+
+            if (i == 0)
+            {
+                cur[j] = bonus;
+                continue;
+            }
+
+            int best = bestBefore;
+            if (j >= 1 && prev[j - 1] != NoMatch)
+                best = std::max(best, prev[j - 1] + ContiguousBonus);
+            if (best != NoMatch)
+                cur[j] = best + bonus;
+        }
+        std::swap(prev, cur);
+    }
+
+    return *std::max_element(prev.begin(), prev.end());
+}
+
+} // namespace FuzzyMatch
+
+} // namespace netcoredbg
@@ -0,0 +1,24 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "utils/string_view.h"
+
+namespace netcoredbg
+{
+
+// Fuzzy match of names for IDE "go to file" like search, pattern characters must be found in name in same order
+// (not contiguous), ASCII case insensitive. For example, "mpcs" or "MainPg" match "MainProgram.cs".
+namespace FuzzyMatch
+{
+    const int NoMatch = -1;
+
+    // Return match score (bigger is better) or NoMatch. Characters at name start, at words starts (after separator
+    // or camel case hump) and contiguous characters get bonuses, so, "pc" rank "ProgramCache.cs" before "Epic.cs".
+    int Score(Utility::string_view pattern, Utility::string_view name);
+
+} // namespace FuzzyMatch
+
+} // namespace netcoredbg
@@ -0,0 +1,58 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/generic_args.h"
+
+namespace netcoredbg
+{
+
+namespace TypePrinter
+{
+
+void GenericArgs::Consume(std::string &output, size_t start)
+{
+    if (Remain() == 0)
+        return;
+
+    size_t offset = output.size();
+    unsigned long numArgs = 0;
+    unsigned long multiplier = 1;
+    while (offset > start && output[offset - 1] >= '0' && output[offset - 1] <= '9')
+    {
+        offset--;
+        // Too big number can't be arity, don't care about overflow.
+        if (output.size() - offset > 9)
+            return;
+
+        numArgs += (output[offset] - '0') * multiplier;
+        multiplier *= 10;
+    }
+
+    if (offset == output.size() || offset == start || output[offset - 1] != '`' || numArgs == 0 || numArgs > Remain())
+        return;
+
+    output.resize(offset - 1);
+    output += '<';
+    for (unsigned long i = 0; i < numArgs; i++)
+    {
+        if (i != 0)
+            output += ", ";
+        output += m_names[m_consumed++];
+    }
+    output += '>';
+}
+
+void GenericArgs::Join(std::string &output, char separator) const
+{
+    for (size_t i = 0; i < m_names.size(); i++)
+    {
+        if (i != 0)
+            output += separator;
+        output += m_names[i];
+    }
+}
+
+} // namespace TypePrinter
+
+} // namespace netcoredbg
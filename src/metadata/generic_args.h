@@ -0,0 +1,50 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+/// \file generic_args.h  This file contains declaration of generic arguments list, used for type names formatting.
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include "utils/small_vector.h"
+
+namespace netcoredbg
+{
+
+namespace TypePrinter
+{
+
+/// Generic arguments names of type or method (in order of declaration, enclosing types arguments first),
+/// which are consumed by names of generic types during full type name formatting.
+class GenericArgs
+{
+public:
+    GenericArgs() : m_consumed(0) {}
+
+    /// Returns reference to new (empty) argument name, which should be filled by caller.
+    std::string &Add() { return m_names.emplace_back(); }
+    void Add(const std::string &name) { m_names.emplace_back(name); }
+
+    size_t Size() const { return m_names.size(); }
+    bool Empty() const { return m_names.empty(); }
+    const std::string &operator[](size_t index) const { return m_names[index]; }
+
+    size_t Remain() const { return m_names.size() - m_consumed; }
+
+    /// Function checks name's suffix (located in `output` from `start` position) for generic arity ("`2")
+    /// and replaces it by next consumed arguments ("<int, string>") in place.
+    void Consume(std::string &output, size_t start);
+
+    /// Append all arguments separated by `separator`.
+    void Join(std::string &output, char separator) const;
+
+private:
+    // Note, most of generic types have 1-2 arguments, so, nested generics don't need heap allocations for list.
+    Utility::small_vector<std::string, 4> m_names;
+    size_t m_consumed;
+};
+
+} // namespace TypePrinter
+
+} // namespace netcoredbg
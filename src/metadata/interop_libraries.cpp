@@ -6,11 +6,17 @@
 
 #include <fcntl.h>
 #include <unistd.h>
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+#include <vector>
 #include "elf++.h"
 #include "dwarf++.h"
 #include "utils/logger.h"
 #include <elf.h>
 #include "utils/filesystem.h"
+#include "utils/perfcounters.h"
+#include "debugger/interop_unwind.h"
 #include <cxxabi.h> // demangle
 
 
@@ -24,6 +30,8 @@ namespace
 
     constexpr std::uintptr_t NOT_FOUND = 0;
 
+    PerfCounters::Counter interopAddrDataCacheHitsCounter("interopAddrDataCacheHits");
+
 } // unnamed namespace
 
 static bool OpenElf(const std::string &file, std::unique_ptr<elf::elf> &ef)
@@ -210,11 +218,29 @@ static void CollectProcDataFromElf(std::uintptr_t startAddr, InteropLibraries::L
     info.proceduresDataValid = true;
 }
 
+// Note, only check that file have debuginfo sections, DWARF data parsed at first use (see GetDwarf()),
+// since process could load hundreds of libs and most of them will be never used for breakpoints and stack traces.
 static bool LoadDebuginfoFromFile(const std::string &fileName, InteropLibraries::LibraryInfo &info)
 {
     if (!OpenElf(fileName, info.ef))
         return false;
 
+    if (!info.ef->get_section(".debug_info").valid() ||
+        !info.ef->get_section(".debug_abbrev").valid())
+    {
+        info.ef.reset();
+        return false;
+    }
+
+    return true;
+};
+
+// Return nullptr in case lib don't have debuginfo.
+static dwarf::dwarf *GetDwarf(InteropLibraries::LibraryInfo &info)
+{
+    if (info.dw || !info.ef)
+        return info.dw.get();
+
     try
     {
         info.dw.reset(new dwarf::dwarf(dwarf::elf::create_loader(*(info.ef.get()))));
@@ -222,12 +248,11 @@ static bool LoadDebuginfoFromFile(const std::string &fileName, InteropLibraries:
     catch(const std::exception& e)
     {
         info.ef.reset();
-        LOGI("Load debuginfo failed at dwarf::dwarf() for file %s: %s\n", fileName.c_str(), e.what());
-        return false;
+        LOGI("Load debuginfo failed at dwarf::dwarf() for file %s: %s\n", info.fullName.c_str(), e.what());
     }
 
-    return true;
-};
+    return info.dw.get();
+}
 
 static bool GetFileNameAndPath(const std::string &path, std::string &fileName, std::string &filePath)
 {
@@ -326,15 +351,17 @@ void InteropLibraries::AddLibrary(const std::string &libLoadName, const std::str
         return;
     }
 
-    m_librariesInfoMutex.lock();
-
-    LibraryInfo &info = m_librariesInfo[startAddr];
+    // Note, debug info is loaded without m_librariesInfoMutex lock, since it could take a while and block
+    // address related requests from waitpid thread (for example, IsThumbCode() at breakpoint).
+    LibraryInfo info;
     info.fullName = fullName;
     info.fullLoadName = libLoadName;
     info.libEndAddr = endAddr;
     symbolStatus = LoadDebuginfo(libLoadName, info);
     info.isCoreCLR = IsCoreCLRLibrary(fullName);
 
+    m_librariesInfoMutex.lock();
+    m_librariesInfo[startAddr] = std::move(info);
     m_librariesInfoMutex.unlock();
 }
 
@@ -361,67 +388,103 @@ void InteropLibraries::RemoveAllLibraries()
     m_librariesInfoMutex.unlock();
 }
 
-static std::uintptr_t FindOffsetBySourceAndLineForDwarf(const std::unique_ptr<dwarf::dwarf> &dw, const std::string &fileName, unsigned lineNum,
-                                                        unsigned &resolvedLineNum, std::string &resolvedFullPath)
+// Source lines to addresses index for debuginfo, aimed to avoid all line tables scan for each breakpoint resolve.
+struct DwarfLinesIndex
 {
-    if (!dw) // check if lib have debuginfo loaded
-        return NOT_FOUND;
+    struct line_t
+    {
+        unsigned line;
+        unsigned column;
+        uint32_t pathIndex;
+        std::uintptr_t address;
+    };
 
-    std::uintptr_t tmpAddr = 0;
-    unsigned tmpLineNum = 0;
-    unsigned tmpColumnNum = 0;
-    std::string tmpFullPath;
+    std::vector<std::string> paths;
+    // linesByFileName - file name (without path) to all lines of all sources with this file name, sorted by line and column,
+    //                   for each source's line and column only first address (in line tables order) stored
+    std::unordered_map<std::string, std::vector<line_t>> linesByFileName;
+};
 
+static std::shared_ptr<DwarfLinesIndex> CreateDwarfLinesIndex(dwarf::dwarf *dw)
+{
+    std::shared_ptr<DwarfLinesIndex> index = std::make_shared<DwarfLinesIndex>();
+
+    std::unordered_map<std::string, uint32_t> pathsIndexes;
     for (const auto &cu : dw->compilation_units())
     {
-        // Fast check for all file names in CU.
-        bool nameFound = false;
-        cu.get_line_table().iterate_file_names([&fileName, &nameFound](dwarf::line_table::file* sourceFile)
-        {
-            if (fileName.size() <= sourceFile->path.size() &&
-                std::equal(fileName.rbegin(), fileName.rend(), sourceFile->path.rbegin())) // "end with"
-            {
-                nameFound = true;
-                return false;
-            }
-            return true;
-        });
-        if (!nameFound)
-            continue;
+        const dwarf::line_table::file *prevFile = nullptr;
+        uint32_t pathIndex = 0;
+        std::vector<DwarfLinesIndex::line_t> *lines = nullptr;
 
-        // All lines check.
         for (const auto &line : cu.get_line_table())
         {
             if (line.end_sequence)
                 continue;
 
-            if (fileName.size() > line.file->path.size() ||
-                !std::equal(fileName.rbegin(), fileName.rend(), line.file->path.rbegin()) || // "end with"
-                line.line < lineNum)
-                continue;
-
-            if (!tmpAddr)
+            if (line.file != prevFile)
             {
-                tmpAddr = line.address;
-                tmpLineNum = line.line;
-                tmpColumnNum = line.column;
-                tmpFullPath = line.file->path;
-            }
-            else if (line.line < tmpLineNum || (line.line == tmpLineNum && line.column < tmpColumnNum))
-            {
-                tmpAddr = line.address;
-                tmpLineNum = line.line;
-                tmpColumnNum = line.column;
-                tmpFullPath = line.file->path;
+                prevFile = line.file;
+                auto emplaceResult = pathsIndexes.emplace(line.file->path, (uint32_t)index->paths.size());
+                if (emplaceResult.second)
+                    index->paths.push_back(line.file->path);
+                pathIndex = emplaceResult.first->second;
+                lines = &index->linesByFileName[GetBasename(line.file->path)];
             }
+
+            lines->push_back({line.line, line.column, pathIndex, line.address});
         }
     }
 
-    if (tmpAddr)
+    for (auto &entry : index->linesByFileName)
+    {
+        std::vector<DwarfLinesIndex::line_t> &lines = entry.second;
+        // Note, stable sort and unique, since in case of same line and column first address in line tables order is used.
+        std::stable_sort(lines.begin(), lines.end(), [](const DwarfLinesIndex::line_t &a, const DwarfLinesIndex::line_t &b)
+        {
+            if (a.line != b.line)
+                return a.line < b.line;
+            if (a.column != b.column)
+                return a.column < b.column;
+            return a.pathIndex < b.pathIndex;
+        });
+        lines.erase(std::unique(lines.begin(), lines.end(), [](const DwarfLinesIndex::line_t &a, const DwarfLinesIndex::line_t &b)
+        {
+            return a.line == b.line && a.column == b.column && a.pathIndex == b.pathIndex;
+        }), lines.end());
+        lines.shrink_to_fit();
+    }
+
+    return index;
+}
+
+static std::uintptr_t FindOffsetBySourceAndLineForDwarf(InteropLibraries::LibraryInfo &info, const std::string &fileName, unsigned lineNum,
+                                                        unsigned &resolvedLineNum, std::string &resolvedFullPath)
+{
+    dwarf::dwarf *dw = GetDwarf(info);
+    if (!dw) // check if lib have debuginfo loaded
+        return NOT_FOUND;
+
+    if (!info.dwLinesIndex)
+        info.dwLinesIndex = CreateDwarfLinesIndex(dw);
+
+    auto find = info.dwLinesIndex->linesByFileName.find(GetBasename(fileName));
+    if (find == info.dwLinesIndex->linesByFileName.end())
+        return NOT_FOUND;
+
+    // Find first line (with minimal column) not less than requested one, in source with path "end with" fileName.
+    const std::vector<DwarfLinesIndex::line_t> &lines = find->second;
+    auto it = std::lower_bound(lines.begin(), lines.end(), lineNum,
+                               [](const DwarfLinesIndex::line_t &line, unsigned value) { return line.line < value; });
+    for (; it != lines.end(); ++it)
     {
-        resolvedLineNum = tmpLineNum;
-        resolvedFullPath = tmpFullPath;
-        return tmpAddr;
+        const std::string &path = info.dwLinesIndex->paths[it->pathIndex];
+        if (fileName.size() > path.size() ||
+            !std::equal(fileName.rbegin(), fileName.rend(), path.rbegin())) // "end with"
+            continue;
+
+        resolvedLineNum = it->line;
+        resolvedFullPath = path;
+        return it->address;
     }
 
     return NOT_FOUND;
@@ -439,7 +502,7 @@ std::uintptr_t InteropLibraries::FindAddrBySourceAndLineForLib(std::uintptr_t li
     if (find->second.isCoreCLR) // NOTE we don't allow setup breakpoint in CoreCLR native code
         return NOT_FOUND;
 
-    std::uintptr_t offset = FindOffsetBySourceAndLineForDwarf(find->second.dw, fileName, lineNum, resolvedLineNum, resolvedFullPath);
+    std::uintptr_t offset = FindOffsetBySourceAndLineForDwarf(find->second, fileName, lineNum, resolvedLineNum, resolvedFullPath);
     if (offset == NOT_FOUND)
         return NOT_FOUND;
 
@@ -458,7 +521,7 @@ std::uintptr_t InteropLibraries::FindAddrBySourceAndLine(const std::string &file
         if (debugInfo.second.isCoreCLR) // NOTE we don't allow setup breakpoint in CoreCLR native code
             continue;
 
-        std::uintptr_t offset = FindOffsetBySourceAndLineForDwarf(debugInfo.second.dw, fileName, lineNum, resolvedLineNum, resolvedFullPath);
+        std::uintptr_t offset = FindOffsetBySourceAndLineForDwarf(debugInfo.second, fileName, lineNum, resolvedLineNum, resolvedFullPath);
         if (offset == NOT_FOUND)
             continue;
 
@@ -487,37 +550,6 @@ void InteropLibraries::FindLibraryInfoForAddr(std::uintptr_t addr, std::function
     }
 }
 
-static bool FindDwarfDieByAddr(const dwarf::die &d, dwarf::taddr addr, dwarf::die &node)
-{
-    // Scan children first to find most specific DIE
-    for (const auto &child : d)
-    {
-        if (FindDwarfDieByAddr(child, addr, node))
-                return true;
-    }
-
-    switch (d.tag)
-    {
-    case dwarf::DW_TAG::subprogram:
-    case dwarf::DW_TAG::inlined_subroutine:
-        try
-        {
-            if (die_pc_range(d).contains(addr))
-            {
-                node = d;
-                return true;
-            }
-        }
-        catch (std::out_of_range &e) {}
-        catch (dwarf::value_type_mismatch &e) {}
-        break;
-    default:
-        break;
-    }
-
-    return false;
-}
-
 static void ParseDwarfDie(const dwarf::die &node, std::string &methodName, std::string &methodLinkageName)
 {
     for (auto &attr : node.attributes())
@@ -560,54 +592,240 @@ static bool DemangleCXXABI(const char *mangledName, std::string &realName)
     return false;
 }
 
-static void FindDataForAddrInDebugInfo(dwarf::dwarf *dw, std::uintptr_t addr, std::string &procName, std::string &fullSourcePath, int &lineNum)
+// Flat sorted address ranges tables for debuginfo, aimed to avoid compilation units and DIEs tree scan for each address.
+// Note, DIEs ranges tables are built for each compilation unit separately at first address search in unit,
+// since we need DIE objects for method name and all library's DIEs could take too much memory.
+struct DwarfAddrIndex
 {
-    if (!dw)
-        return;
+    struct range_t
+    {
+        dwarf::taddr low;
+        dwarf::taddr high; // have same logic as STL `end()` iterator - "first address after"
+        size_t index; // index in dwarf::compilation_units() for units ranges or in procs for unit's ranges
+    };
 
-    // TODO use `.debug_aranges`
+    struct proc_t
+    {
+        dwarf::die node;
+        bool nameValid = false;
+        std::string name;
+
+        proc_t(const dwarf::die &node_) : node(node_) {}
+    };
+
+    struct unit_data_t
+    {
+        bool valid = false;
+        // ranges - not overlapped ranges sorted by address, each range related to most specific subprogram or inlined subroutine
+        std::vector<range_t> ranges;
+        std::vector<proc_t> procs;
+    };
+
+    std::vector<range_t> unitsRanges; // sorted by address
+    std::vector<unit_data_t> units;
+};
+
+static bool RangeLowLess(dwarf::taddr addr, const DwarfAddrIndex::range_t &range)
+{
+    return addr < range.low;
+}
+
+// Return nullptr in case no range contains addr.
+static const DwarfAddrIndex::range_t *FindRange(const std::vector<DwarfAddrIndex::range_t> &ranges, dwarf::taddr addr)
+{
+    auto upper_bound = std::upper_bound(ranges.begin(), ranges.end(), addr, RangeLowLess);
+    if (upper_bound == ranges.begin())
+        return nullptr;
 
-    for (auto &cu : dw->compilation_units())
+    auto closest_lower = std::prev(upper_bound);
+    return addr < closest_lower->high ? &(*closest_lower) : nullptr;
+}
+
+static void AddDiePcRanges(const dwarf::die &d, size_t index, std::vector<DwarfAddrIndex::range_t> &ranges)
+{
+    try
     {
-        try
+        for (const auto &entry : die_pc_range(d))
         {
-            if (!die_pc_range(cu.root()).contains(addr))
-                continue;
+            if (entry.low < entry.high)
+                ranges.push_back({entry.low, entry.high, index});
         }
-        catch (std::out_of_range &e) {continue;}
-        catch (dwarf::value_type_mismatch &e) {continue;}
+    }
+    catch (std::out_of_range &e) {}
+    catch (dwarf::value_type_mismatch &e) {}
+}
 
-        // Map address to source file and line
-        auto &lt = cu.get_line_table();
-        auto it = lt.find_address(addr);
-        if (it == lt.end())
-            return;
+static std::shared_ptr<DwarfAddrIndex> CreateDwarfAddrIndex(dwarf::dwarf *dw)
+{
+    std::shared_ptr<DwarfAddrIndex> index = std::make_shared<DwarfAddrIndex>();
 
-        fullSourcePath = it->file->path;
-        lineNum = it->line;
+    // TODO use `.debug_aranges`
+    const auto &units = dw->compilation_units();
+    index->units.resize(units.size());
+    for (size_t i = 0; i < units.size(); i++)
+    {
+        AddDiePcRanges(units[i].root(), i, index->unitsRanges);
+    }
+    // Note, stable sort, in case of overlapped ranges first unit have priority.
+    std::stable_sort(index->unitsRanges.begin(), index->unitsRanges.end(),
+                     [](const DwarfAddrIndex::range_t &a, const DwarfAddrIndex::range_t &b) { return a.low < b.low; });
 
-        // Map address to method name
-        // TODO index/helper/something for looking up address
-        dwarf::die node;
-        if (FindDwarfDieByAddr(cu.root(), addr, node))
-        {
-            std::string methodName;
-            std::string methodLinkageName;
-            ParseDwarfDie(node, methodName, methodLinkageName);
+    return index;
+}
 
-            if (!methodLinkageName.empty())
+struct die_interval_t
+{
+    dwarf::taddr low;
+    dwarf::taddr high;
+    unsigned depth;
+    size_t procIndex; // also DIEs tree pre-order number
+};
+
+static void CollectDieIntervals(const dwarf::die &d, unsigned depth, DwarfAddrIndex::unit_data_t &unitData, std::vector<die_interval_t> &intervals)
+{
+    if (d.tag == dwarf::DW_TAG::subprogram || d.tag == dwarf::DW_TAG::inlined_subroutine)
+    {
+        std::vector<DwarfAddrIndex::range_t> ranges;
+        AddDiePcRanges(d, unitData.procs.size(), ranges);
+        if (!ranges.empty())
+        {
+            for (const auto &range : ranges)
             {
-                if (!DemangleCXXABI(methodLinkageName.c_str(), procName))
-                    procName = methodLinkageName + "()";
+                intervals.push_back({range.low, range.high, depth, range.index});
             }
-            else if (!methodName.empty())
-                procName = methodName + "()";
+            unitData.procs.emplace_back(d);
+        }
+    }
+
+    for (const auto &child : d)
+    {
+        CollectDieIntervals(child, depth + 1, unitData, intervals);
+    }
+}
+
+// Convert nested (and in theory, overlapped) DIEs intervals into not overlapped ranges, where each address
+// belong to most specific (deepest) DIE, for same depth - first DIE in tree order.
+static void BuildUnitRanges(const dwarf::compilation_unit &cu, DwarfAddrIndex::unit_data_t &unitData)
+{
+    unitData.valid = true;
+
+    std::vector<die_interval_t> intervals;
+    CollectDieIntervals(cu.root(), 0, unitData, intervals);
+    if (intervals.empty())
+        return;
+
+    struct event_t
+    {
+        dwarf::taddr addr;
+        bool start;
+        size_t interval;
+    };
+    std::vector<event_t> events;
+    events.reserve(intervals.size() * 2);
+    for (size_t i = 0; i < intervals.size(); i++)
+    {
+        events.push_back({intervals[i].low, true, i});
+        events.push_back({intervals[i].high, false, i});
+    }
+    std::sort(events.begin(), events.end(), [](const event_t &a, const event_t &b) { return a.addr < b.addr; });
+
+    auto priorityLess = [&](size_t a, size_t b)
+    {
+        if (intervals[a].depth != intervals[b].depth)
+            return intervals[a].depth > intervals[b].depth;
+        if (intervals[a].procIndex != intervals[b].procIndex)
+            return intervals[a].procIndex < intervals[b].procIndex;
+        return a < b;
+    };
+    std::set<size_t, decltype(priorityLess)> active(priorityLess);
+
+    dwarf::taddr prevAddr = 0;
+    for (size_t i = 0; i < events.size(); )
+    {
+        dwarf::taddr addr = events[i].addr;
+        if (!active.empty() && prevAddr < addr)
+        {
+            size_t procIndex = intervals[*active.begin()].procIndex;
+            if (!unitData.ranges.empty() && unitData.ranges.back().high == prevAddr && unitData.ranges.back().index == procIndex)
+                unitData.ranges.back().high = addr;
             else
-                procName = "unknown";
+                unitData.ranges.push_back({prevAddr, addr, procIndex});
+        }
 
-            break;
+        for (; i < events.size() && events[i].addr == addr; i++)
+        {
+            if (events[i].start)
+                active.insert(events[i].interval);
+            else
+                active.erase(events[i].interval);
         }
+        prevAddr = addr;
+    }
+}
+
+static const std::string &GetProcName(DwarfAddrIndex::proc_t &proc)
+{
+    if (proc.nameValid)
+        return proc.name;
+
+    proc.nameValid = true;
+    std::string methodName;
+    std::string methodLinkageName;
+    ParseDwarfDie(proc.node, methodName, methodLinkageName);
+
+    if (!methodLinkageName.empty())
+    {
+        if (!DemangleCXXABI(methodLinkageName.c_str(), proc.name))
+            proc.name = methodLinkageName + "()";
     }
+    else if (!methodName.empty())
+        proc.name = methodName + "()";
+    else
+        proc.name = "unknown";
+
+    return proc.name;
+}
+
+static const std::string &GetProcDisplayName(InteropLibraries::LibraryInfo::proc_data_t &procData)
+{
+    if (procData.procDisplayName.empty() && !DemangleCXXABI(procData.procName.c_str(), procData.procDisplayName))
+        procData.procDisplayName = procData.procName + "()";
+
+    return procData.procDisplayName;
+}
+
+static void FindDataForAddrInDebugInfo(InteropLibraries::LibraryInfo &info, std::uintptr_t addr, std::string &procName, std::string &fullSourcePath, int &lineNum)
+{
+    dwarf::dwarf *dw = GetDwarf(info);
+    if (!dw)
+        return;
+
+    if (!info.dwAddrIndex)
+        info.dwAddrIndex = CreateDwarfAddrIndex(dw);
+
+    const DwarfAddrIndex::range_t *unitRange = FindRange(info.dwAddrIndex->unitsRanges, addr);
+    if (unitRange == nullptr)
+        return;
+
+    const dwarf::compilation_unit &cu = dw->compilation_units()[unitRange->index];
+
+    // Map address to source file and line
+    auto &lt = cu.get_line_table();
+    auto it = lt.find_address(addr);
+    if (it == lt.end())
+        return;
+
+    fullSourcePath = it->file->path;
+    lineNum = it->line;
+
+    // Map address to method name
+    DwarfAddrIndex::unit_data_t &unitData = info.dwAddrIndex->units[unitRange->index];
+    if (!unitData.valid)
+        BuildUnitRanges(cu, unitData);
+
+    const DwarfAddrIndex::range_t *procRange = FindRange(unitData.ranges, addr);
+    if (procRange != nullptr)
+        procName = GetProcName(unitData.procs[procRange->index]);
 }
 
 void InteropLibraries::FindDataForAddr(std::uintptr_t addr, std::string &libName, std::uintptr_t &libStartAddr, std::string &procName,
@@ -618,28 +836,58 @@ void InteropLibraries::FindDataForAddr(std::uintptr_t addr, std::string &libName
         libName = GetBasename(info.fullName);
         libStartAddr = startAddr;
 
-        FindDataForAddrInDebugInfo(info.dw.get(), addr - startAddr, procName, fullSourcePath, lineNum);
-        if (!procName.empty())
+        auto find = info.addrDataCache.find(addr - startAddr);
+        if (find != info.addrDataCache.end())
+        {
+            interopAddrDataCacheHitsCounter.Add(1);
+            procName = find->second.procName;
+            procStartAddr = find->second.procStartAddr;
+            fullSourcePath = find->second.fullSourcePath;
+            lineNum = find->second.lineNum;
             return;
+        }
 
-        if (!info.proceduresDataValid)
-            CollectProcDataFromElf(startAddr, info);
-
-        if (info.proceduresData.empty() ||
-            addr >= info.proceduresData.rbegin()->second.endAddr)
-            return;
+        // Note, cache size is limited, since some code (for example, JIT'ed code stubs) could provide unique addresses all the time.
+        static const size_t maxAddrDataCacheSize = 64 * 1024;
+        if (info.addrDataCache.size() >= maxAddrDataCacheSize)
+            info.addrDataCache.clear();
 
-        auto upper_bound = info.proceduresData.upper_bound(addr);
-        if (upper_bound != info.proceduresData.begin())
+        LibraryInfo::addr_data_t &data = info.addrDataCache[addr - startAddr];
+        FindDataForAddrInDebugInfo(info, addr - startAddr, data.procName, data.fullSourcePath, data.lineNum);
+        if (data.procName.empty())
         {
-            auto closest_lower = std::prev(upper_bound);
-            if (closest_lower->first <= addr && addr < closest_lower->second.endAddr)
+            if (!info.proceduresDataValid)
+                CollectProcDataFromElf(startAddr, info);
+
+            if (!info.proceduresData.empty() &&
+                addr < info.proceduresData.rbegin()->second.endAddr)
             {
-                procStartAddr = closest_lower->first;
-                if (!DemangleCXXABI(closest_lower->second.procName.c_str(), procName))
-                    procName = closest_lower->second.procName + "()";
+                auto upper_bound = info.proceduresData.upper_bound(addr);
+                if (upper_bound != info.proceduresData.begin())
+                {
+                    auto closest_lower = std::prev(upper_bound);
+                    if (closest_lower->first <= addr && addr < closest_lower->second.endAddr)
+                    {
+                        data.procStartAddr = closest_lower->first;
+                        data.procName = GetProcDisplayName(closest_lower->second);
+                    }
+                }
             }
         }
+
+        procName = data.procName;
+        procStartAddr = data.procStartAddr;
+        fullSourcePath = data.fullSourcePath;
+        lineNum = data.lineNum;
+    });
+}
+
+void InteropLibraries::FindLibForAddr(std::uintptr_t addr, std::string &libName, std::uintptr_t &libStartAddr)
+{
+    FindLibraryInfoForAddr(addr, [&](std::uintptr_t startAddr, LibraryInfo &info)
+    {
+        libName = GetBasename(info.fullName);
+        libStartAddr = startAddr;
     });
 }
 
@@ -648,13 +896,27 @@ bool InteropLibraries::IsUserDebuggingCode(std::uintptr_t addr)
     bool isUserCode = false;
     FindLibraryInfoForAddr(addr, [&](std::uintptr_t startAddr, LibraryInfo &info)
     {
-        if (!info.isCoreCLR && info.dw != nullptr)
+        // Note, debuginfo existence is enough here, no need to parse DWARF data.
+        if (!info.isCoreCLR && info.ef != nullptr)
             isUserCode = true;
     });
 
     return isUserCode;
 }
 
+std::shared_ptr<LibraryUnwindInfo> InteropLibraries::GetUnwindInfoForAddr(std::uintptr_t addr)
+{
+    std::shared_ptr<LibraryUnwindInfo> result;
+    FindLibraryInfoForAddr(addr, [&](std::uintptr_t, LibraryInfo &info)
+    {
+        if (!info.unwindInfo)
+            info.unwindInfo = CreateLibraryUnwindInfo();
+
+        result = info.unwindInfo;
+    });
+    return result;
+}
+
 bool InteropLibraries::IsThumbCode(std::uintptr_t addr)
 {
 #if DEBUGGER_UNIX_ARM
@@ -712,11 +974,11 @@ bool InteropLibraries::FindDataForNotClrAddr(std::uintptr_t addr, std::string &l
                 libLoadName = libLoadName.substr(0, i + 3);
         }
 
-        if (info.dw != nullptr)
+        if (GetDwarf(info) != nullptr)
         {
             std::string fullSourcePath;
             int lineNum;
-            FindDataForAddrInDebugInfo(info.dw.get(), addr - startAddr, procName, fullSourcePath, lineNum);
+            FindDataForAddrInDebugInfo(info, addr - startAddr, procName, fullSourcePath, lineNum);
             return;
         }
 
@@ -732,10 +994,7 @@ bool InteropLibraries::FindDataForNotClrAddr(std::uintptr_t addr, std::string &l
         {
             auto closest_lower = std::prev(upper_bound);
             if (closest_lower->first <= addr && addr < closest_lower->second.endAddr)
-            {
-                if (!DemangleCXXABI(closest_lower->second.procName.c_str(), procName))
-                    procName = closest_lower->second.procName + "()";
-            }
+                procName = GetProcDisplayName(closest_lower->second);
         }
     });
 
@@ -9,6 +9,7 @@
 #include <memory>
 #include <mutex>
 #include <map>
+#include <unordered_map>
 #include <functional>
 #include "interfaces/types.h"
 
@@ -27,6 +28,10 @@ namespace netcoredbg
 namespace InteropDebugging
 {
 
+struct LibraryUnwindInfo;
+struct DwarfAddrIndex;
+struct DwarfLinesIndex;
+
 class InteropLibraries
 {
 public:
@@ -36,9 +41,13 @@ public:
         std::string fullName;
         std::string fullLoadName;
         std::uintptr_t libEndAddr; // have same logic as STL `end()` iterator - "first address after"
-        // debuginfo related
+        // debuginfo related, `ef` is mmap'ed file with debuginfo, `dw` created at first debuginfo use
         std::unique_ptr<elf::elf> ef;
         std::unique_ptr<dwarf::dwarf> dw;
+        // Addresses index for debuginfo, created at first address search in this lib.
+        std::shared_ptr<DwarfAddrIndex> dwAddrIndex;
+        // Source lines index for debuginfo, created at first breakpoint resolve in this lib.
+        std::shared_ptr<DwarfLinesIndex> dwLinesIndex;
 #if DEBUGGER_UNIX_ARM
         // All thumb code related address blocks in form [`start address`, `end address`),
         // where `start address` is `key` and `end address` is `value` of map.
@@ -50,6 +59,8 @@ public:
         {
             std::uintptr_t endAddr = 0; // have same logic as STL `end()` iterator - "first address after"
             std::string procName;
+            // Demangled (or with "()" added) name, created at first use.
+            std::string procDisplayName;
             proc_data_t(std::uintptr_t addr, const std::string &name) :
                 endAddr(addr),
                 procName(name)
@@ -60,6 +71,19 @@ public:
         std::map<std::uintptr_t, proc_data_t> proceduresData;
         // Is this lib related to CoreCLR (Note, we don't allow debug CoreCLR native code).
         bool isCoreCLR = false;
+        // Unwind tables cache, created at first unwind through this lib.
+        std::shared_ptr<LibraryUnwindInfo> unwindInfo;
+        // Symbolization results cache for FindDataForAddr(), address offset in lib is `key`. Shared by all threads
+        // and stops, since same return addresses are common for many threads (thread pool waits, event loops, etc).
+        // Note, cache is dropped together with lib info at lib unload.
+        struct addr_data_t
+        {
+            std::string procName;
+            std::uintptr_t procStartAddr = 0;
+            std::string fullSourcePath;
+            int lineNum = 0;
+        };
+        std::unordered_map<std::uintptr_t, addr_data_t> addrDataCache;
     };
 
     void AddLibrary(const std::string &libLoadName, const std::string &fullName, std::uintptr_t startAddr, std::uintptr_t endAddr, SymbolStatus &symbolStatus);
@@ -71,9 +95,13 @@ public:
 
     void FindDataForAddr(std::uintptr_t addr, std::string &libName, std::uintptr_t &libStartAddr, std::string &procName,
                          std::uintptr_t &procStartAddr, std::string &fullSourcePath, int &lineNum);
+    // Same as FindDataForAddr(), but without procedure and source search (for frames, that will not be shown).
+    void FindLibForAddr(std::uintptr_t addr, std::string &libName, std::uintptr_t &libStartAddr);
     bool FindDataForNotClrAddr(std::uintptr_t addr, std::string &libLoadName, std::string &procName);
     bool IsUserDebuggingCode(std::uintptr_t addr);
     bool IsThumbCode(std::uintptr_t addr);
+    // Return nullptr in case addr don't belong any lib.
+    std::shared_ptr<LibraryUnwindInfo> GetUnwindInfoForAddr(std::uintptr_t addr);
 
 private:
 
@@ -2,11 +2,16 @@
 // Distributed under the MIT License.
 // See the LICENSE file in the project root for more information.
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <iterator>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 #include "metadata/jmc.h"
 #include "metadata/attributes.h"
+#include "metadata/typeprinter.h"
 #include "utils/platform.h"
 #include "managed/interop.h"
 #include "utils/torelease.h"
@@ -32,34 +37,9 @@ const char DebuggerAttribute::Hidden[] = "System.Diagnostics.DebuggerHiddenAttri
 static std::vector<std::string> typeAttrNames{DebuggerAttribute::NonUserCode, DebuggerAttribute::StepThrough};
 static std::vector<std::string> methodAttrNames{DebuggerAttribute::NonUserCode, DebuggerAttribute::StepThrough, DebuggerAttribute::Hidden};
 
-static HRESULT GetNonJMCMethodsForTypeDef(
-    IMetaDataImport *pMD,
-    mdTypeDef typeDef,
-    std::vector<mdToken> &excludeMethods)
-{
-    ULONG numMethods = 0;
-    HCORENUM fEnum = NULL;
-    mdMethodDef methodDef;
-    while(SUCCEEDED(pMD->EnumMethods(&fEnum, typeDef, &methodDef, 1, &numMethods)) && numMethods != 0)
-    {
-        mdTypeDef memTypeDef;
-        ULONG nameLen;
-        WCHAR szFunctionName[mdNameLen] = {0};
-
-        if (FAILED(pMD->GetMethodProps(methodDef, &memTypeDef,
-                                       szFunctionName, _countof(szFunctionName), &nameLen,
-                                       nullptr, nullptr, nullptr, nullptr, nullptr)))
-            continue;
-
-        if (HasAttribute(pMD, methodDef, methodAttrNames))
-            excludeMethods.push_back(methodDef);
-    }
-    pMD->CloseEnum(fEnum);
-
-    return S_OK;
-}
-
-static HRESULT GetNonJMCClassesAndMethods(ICorDebugModule *pModule, std::vector<mdToken> &excludeTokens)
+// Read all module's custom attributes at once (CustomAttribute table scan) instead of attributes enumeration for each type and method,
+// attribute constructor name resolved only once for each constructor token.
+HRESULT GetNonJMCClassesAndMethods(ICorDebugModule *pModule, std::vector<mdToken> &excludeTokens)
 {
     HRESULT Status;
 
@@ -68,24 +48,83 @@ static HRESULT GetNonJMCClassesAndMethods(ICorDebugModule *pModule, std::vector<
     IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
     IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
 
-    ULONG numTypedefs = 0;
+    enum attr_kind_e : uint8_t
+    {
+        NotDebugger = 0,
+        TypeAndMethod, // NonUserCode or StepThrough
+        MethodOnly     // Hidden
+    };
+    std::unordered_map<mdToken, attr_kind_e> ctorKinds;
+    std::unordered_set<mdToken> excludeTypes;
+    std::vector<mdMethodDef> excludeMethods;
+
+    static const ULONG attrsBatchSize = 256;
+    mdCustomAttribute attrs[attrsBatchSize];
+    ULONG numAttributes = 0;
     HCORENUM fEnum = NULL;
-    mdTypeDef typeDef;
-    while(SUCCEEDED(pMD->EnumTypeDefs(&fEnum, &typeDef, 1, &numTypedefs)) && numTypedefs != 0)
+    // Note, zero scope token provide all custom attributes in module.
+    while(SUCCEEDED(pMD->EnumCustomAttributes(&fEnum, 0, 0, attrs, attrsBatchSize, &numAttributes)) && numAttributes != 0)
     {
-        if (HasAttribute(pMD, typeDef, typeAttrNames))
-            excludeTokens.push_back(typeDef);
-        else
-            GetNonJMCMethodsForTypeDef(pMD, typeDef, excludeTokens);
+        for (ULONG i = 0; i < numAttributes; i++)
+        {
+            mdToken ptkObj = mdTokenNil;
+            mdToken ptkType = mdTokenNil;
+            if (FAILED(pMD->GetCustomAttributeProps(attrs[i], &ptkObj, &ptkType, nullptr, nullptr)) ||
+                (TypeFromToken(ptkObj) != mdtTypeDef && TypeFromToken(ptkObj) != mdtMethodDef))
+                continue;
+
+            auto findKind = ctorKinds.find(ptkType);
+            if (findKind == ctorKinds.end())
+            {
+                attr_kind_e kind = NotDebugger;
+                std::string mdName;
+                if (SUCCEEDED(TypePrinter::NameForToken(ptkType, pMD, mdName, true, nullptr)))
+                {
+                    if (std::find(typeAttrNames.begin(), typeAttrNames.end(), mdName) != typeAttrNames.end())
+                        kind = TypeAndMethod;
+                    else if (std::find(methodAttrNames.begin(), methodAttrNames.end(), mdName) != methodAttrNames.end())
+                        kind = MethodOnly;
+                }
+                findKind = ctorKinds.emplace(ptkType, kind).first;
+            }
+
+            if (findKind->second == NotDebugger)
+                continue;
+
+            if (TypeFromToken(ptkObj) == mdtMethodDef)
+                excludeMethods.push_back(ptkObj);
+            else if (findKind->second == TypeAndMethod)
+                excludeTypes.insert(ptkObj);
+        }
     }
     pMD->CloseEnum(fEnum);
 
+    std::copy(excludeTypes.begin(), excludeTypes.end(), std::back_inserter(excludeTokens));
+
+    // In case class have "not user code" related attribute, no reason set JMC to false for each method, set it to class will be enough.
+    std::sort(excludeMethods.begin(), excludeMethods.end());
+    excludeMethods.erase(std::unique(excludeMethods.begin(), excludeMethods.end()), excludeMethods.end());
+    for (mdMethodDef methodDef : excludeMethods)
+    {
+        mdTypeDef memTypeDef;
+        if (FAILED(pMD->GetMethodProps(methodDef, &memTypeDef, nullptr, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr)) ||
+            excludeTypes.find(memTypeDef) != excludeTypes.end())
+            continue;
+
+        excludeTokens.push_back(methodDef);
+    }
+
     return S_OK;
 }
 
 void DisableJMCForTokenList(ICorDebugModule *pModule, const std::vector<mdToken> &excludeTokens)
 {
-    for (mdToken token : excludeTokens)
+    SetJMCStatusForTokenList(pModule, excludeTokens, FALSE);
+}
+
+void SetJMCStatusForTokenList(ICorDebugModule *pModule, const std::vector<mdToken> &tokens, BOOL status)
+{
+    for (mdToken token : tokens)
     {
         if (TypeFromToken(token) == mdtMethodDef)
         {
@@ -95,7 +134,7 @@ void DisableJMCForTokenList(ICorDebugModule *pModule, const std::vector<mdToken>
                 FAILED(pFunction->QueryInterface(IID_ICorDebugFunction2, (LPVOID *)&pFunction2)))
                 continue;
 
-            pFunction2->SetJMCStatus(FALSE);
+            pFunction2->SetJMCStatus(status);
         }
         else if (TypeFromToken(token) == mdtTypeDef)
         {
@@ -105,7 +144,7 @@ void DisableJMCForTokenList(ICorDebugModule *pModule, const std::vector<mdToken>
                 FAILED(pClass->QueryInterface(IID_ICorDebugClass2, (LPVOID *)&pClass2)))
                 continue;
 
-            pClass2->SetJMCStatus(FALSE);
+            pClass2->SetJMCStatus(status);
         }
     }
 }
@@ -8,10 +8,18 @@
 #include "cordebug.h"
 
 #include <unordered_set>
+#include <vector>
 
 namespace netcoredbg
 {
 
+// Find types and methods with "not user code" related attributes, could be called from any thread.
+HRESULT GetNonJMCClassesAndMethods(ICorDebugModule *pModule, std::vector<mdToken> &excludeTokens);
+// Caller must care, that process is stopped.
+void DisableJMCForTokenList(ICorDebugModule *pModule, const std::vector<mdToken> &excludeTokens);
+// Same as DisableJMCForTokenList(), but could also revert JMC status for tokens (JMC enabled/disabled by user during debug session).
+// Caller must care, that process is stopped.
+void SetJMCStatusForTokenList(ICorDebugModule *pModule, const std::vector<mdToken> &tokens, BOOL status);
 HRESULT DisableJMCByAttributes(ICorDebugModule *pModule);
 HRESULT DisableJMCByAttributes(ICorDebugModule *pModule, const std::unordered_set<mdMethodDef> &methodTokens);
 
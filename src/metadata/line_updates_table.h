@@ -0,0 +1,204 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "utils/memory_size.h"
+
+namespace netcoredbg
+{
+
+// Hot Reload line updates of one method version, composed for all applied deltas.
+// Table store method's sequence points lines from PDB (old lines) and accumulated offset to actual source lines,
+// so, lookup cost don't depend on deltas count. Entries ordered by source and PDB start line (forward correction
+// with binary search), additional index ordered by source and actual end line (backward correction with binary search).
+// Note, sequence point lines from PDB never changed, only offsets are updated by deltas.
+class LineUpdatesTable
+{
+public:
+
+    // Add sequence point from PDB data, Build() must be called after all sequence points added.
+    void Add(unsigned fullPathIndex, int32_t startLine, int32_t endLine)
+    {
+        m_entries.emplace_back(fullPathIndex, startLine, endLine);
+    }
+
+    void Build()
+    {
+        std::sort(m_entries.begin(), m_entries.end());
+        m_entries.erase(std::unique(m_entries.begin(), m_entries.end()), m_entries.end());
+
+        // Note, sequence points could overlap (multiline statements), in order to stop backward scan during forward
+        // correction we need max end line of all previous entries of same source.
+        m_maxEndLine.resize(m_entries.size());
+        for (size_t i = 0; i < m_entries.size(); i++)
+        {
+            m_maxEndLine[i] = (i == 0 || m_entries[i - 1].fullPathIndex != m_entries[i].fullPathIndex) ?
+                              m_entries[i].endLine : std::max(m_maxEndLine[i - 1], m_entries[i].endLine);
+        }
+
+        BuildActualEndIndex();
+    }
+
+    bool Empty() const
+    {
+        return m_entries.empty();
+    }
+
+    // Approximate heap memory size.
+    size_t GetMemoryUsage() const
+    {
+        return MemorySize::Vector(m_entries) + MemorySize::Vector(m_maxEndLine) + MemorySize::Vector(m_actualEndIndex);
+    }
+
+    // Apply all line updates of one delta for source. Blocks must provide `newLine`, `oldLine` and `endLineOffset` fields,
+    // where `oldLine` is actual line before this delta apply (not PDB line).
+    template <class BlockUpdates>
+    void ApplyBlockUpdates(unsigned fullPathIndex, const BlockUpdates &blockUpdates)
+    {
+        // Note, all blocks of one delta must be applied to lines state before this delta, store offsets first.
+        std::vector<int32_t> deltaOffsets(m_entries.size(), 0);
+        bool changed = false;
+
+        for (const auto &block : blockUpdates)
+        {
+            const int32_t lineOffset = block.newLine - block.oldLine;
+            // Note, endLineOffset could be std::numeric_limits<int32_t>::max() (max line number in C# source), so, we forced to cast it first.
+            const uint32_t blockEndLine = (uint32_t)block.oldLine + (uint32_t)block.endLineOffset;
+
+            for (size_t i = 0; i < m_entries.size(); i++)
+            {
+                const entry_t &entry = m_entries[i];
+                const int32_t actualStartLine = entry.startLine + entry.offset;
+                if (entry.fullPathIndex != fullPathIndex ||
+                    actualStartLine < block.oldLine ||
+                    (uint32_t)(entry.endLine + entry.offset) > blockEndLine)
+                    continue;
+
+                // Line updates file can have only one entry for each line.
+                deltaOffsets[i] = lineOffset;
+                changed = true;
+            }
+        }
+
+        if (!changed)
+            return;
+
+        for (size_t i = 0; i < m_entries.size(); i++)
+        {
+            m_entries[i].offset += deltaOffsets[i];
+        }
+
+        // Note, usually line updates move code blocks without reorder, so, index could be still valid.
+        if (!std::is_sorted(m_actualEndIndex.begin(), m_actualEndIndex.end(), ActualEndLess(this)))
+            BuildActualEndIndex();
+    }
+
+    // Forward correction, find offset from PDB line to actual source line.
+    // Note, in case of overlapped sequence points, innermost (with closest start line) is used.
+    bool GetLineOffset(unsigned fullPathIndex, int32_t line, int32_t &offset) const
+    {
+        auto upper = std::upper_bound(m_entries.begin(), m_entries.end(), std::make_pair(fullPathIndex, line),
+            [](const std::pair<unsigned, int32_t> &value, const entry_t &entry)
+            {
+                return value.first < entry.fullPathIndex || (value.first == entry.fullPathIndex && value.second < entry.startLine);
+            });
+
+        for (size_t i = upper - m_entries.begin(); i > 0; i--)
+        {
+            const entry_t &entry = m_entries[i - 1];
+            if (entry.fullPathIndex != fullPathIndex || m_maxEndLine[i - 1] < line)
+                break;
+
+            if (entry.endLine < line)
+                continue;
+
+            offset = entry.offset;
+            return true;
+        }
+
+        return false;
+    }
+
+    // Backward correction, find closest PDB sequence point line for actual source line (closest next executable code line).
+    bool GetPdbLine(unsigned fullPathIndex, int32_t line, int32_t &pdbLine) const
+    {
+        auto lower = std::lower_bound(m_actualEndIndex.begin(), m_actualEndIndex.end(), std::make_pair(fullPathIndex, line),
+            [this](uint32_t index, const std::pair<unsigned, int32_t> &value)
+            {
+                const entry_t &entry = m_entries[index];
+                return entry.fullPathIndex < value.first || (entry.fullPathIndex == value.first && entry.endLine + entry.offset < value.second);
+            });
+
+        if (lower == m_actualEndIndex.end() || m_entries[*lower].fullPathIndex != fullPathIndex)
+            return false;
+
+        pdbLine = m_entries[*lower].startLine;
+        return true;
+    }
+
+private:
+
+    struct entry_t
+    {
+        unsigned fullPathIndex;
+        int32_t startLine; // PDB lines
+        int32_t endLine;
+        int32_t offset; // offset to actual source lines
+
+        entry_t(unsigned fullPathIndex_, int32_t startLine_, int32_t endLine_) :
+            fullPathIndex(fullPathIndex_), startLine(startLine_), endLine(endLine_), offset(0)
+        {}
+
+        bool operator<(const entry_t &other) const
+        {
+            return fullPathIndex < other.fullPathIndex ||
+                   (fullPathIndex == other.fullPathIndex && (startLine < other.startLine ||
+                   (startLine == other.startLine && endLine < other.endLine)));
+        }
+
+        bool operator==(const entry_t &other) const
+        {
+            return fullPathIndex == other.fullPathIndex && startLine == other.startLine && endLine == other.endLine;
+        }
+    };
+
+    std::vector<entry_t> m_entries;
+    std::vector<int32_t> m_maxEndLine;
+    // Indexes of m_entries ordered by source and actual end line.
+    std::vector<uint32_t> m_actualEndIndex;
+
+    struct ActualEndLess
+    {
+        const LineUpdatesTable *table;
+        explicit ActualEndLess(const LineUpdatesTable *table_) : table(table_) {}
+
+        bool operator()(uint32_t a, uint32_t b) const
+        {
+            const entry_t &entryA = table->m_entries[a];
+            const entry_t &entryB = table->m_entries[b];
+            return entryA.fullPathIndex < entryB.fullPathIndex ||
+                   (entryA.fullPathIndex == entryB.fullPathIndex && entryA.endLine + entryA.offset < entryB.endLine + entryB.offset);
+        }
+    };
+
+    void BuildActualEndIndex()
+    {
+        m_actualEndIndex.resize(m_entries.size());
+        for (size_t i = 0; i < m_entries.size(); i++)
+        {
+            m_actualEndIndex[i] = (uint32_t)i;
+        }
+
+        // Note, stable sort, for same actual end line entry with lowest start line will be first.
+        std::stable_sort(m_actualEndIndex.begin(), m_actualEndIndex.end(), ActualEndLess(this));
+    }
+};
+
+} // namespace netcoredbg
@@ -0,0 +1,303 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/metadata_index.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+#include "metadata/module_snapshot_cache.h"
+#include "utils/platform.h"
+#include "utils/torelease.h"
+#include "utils/utf.h"
+
+namespace netcoredbg
+{
+
+const module_metadata_index_t::type_t *module_metadata_index_t::FindType(mdTypeDef typeDef) const
+{
+    // Note, types stored in tokens order.
+    auto it = std::lower_bound(types.begin(), types.end(), typeDef, [](const type_t &type, mdTypeDef token)
+    {
+        return type.typeDef < token;
+    });
+    if (it == types.end() || it->typeDef != typeDef)
+        return nullptr;
+
+    return &(*it);
+}
+
+std::string module_metadata_index_t::GetMethodShortName(const method_t &method)
+{
+    const size_t pos = method.name.rfind('.');
+    return (pos == std::string::npos ? method.name : method.name.substr(pos + 1)) + method.genericParams;
+}
+
+void module_metadata_index_t::FindMethodsByShortName(const std::string &shortName, std::vector<size_t> &methodIndexes) const
+{
+    const size_t hash = std::hash<std::string>()(shortName);
+    auto it = std::lower_bound(methodsByShortName.begin(), methodsByShortName.end(), std::make_pair(hash, size_t(0)));
+    for (; it != methodsByShortName.end() && it->first == hash; ++it)
+    {
+        // Note, different names could have same hash.
+        if (GetMethodShortName(methods[it->second]) == shortName)
+            methodIndexes.push_back(it->second);
+    }
+}
+
+namespace
+{
+
+    // Note, metadata enumeration with big buffers instead of one token per call.
+    const ULONG EnumBatchSize = 256;
+
+    // Same logic as TypePrinter::NameForTypeDef() without generic arguments provide.
+    void ResolveFullName(module_metadata_index_t &index, size_t typeIndex, unsigned nestedLevel)
+    {
+        module_metadata_index_t::type_t &type = index.types[typeIndex];
+        if (!type.fullName.empty())
+            return;
+
+        // Note, protect from broken metadata with nested types cycle.
+        static const unsigned MaxNestedLevel = 256;
+        const module_metadata_index_t::type_t *enclosingType = nullptr;
+        if (type.enclosingTypeDef == mdTypeDefNil || nestedLevel > MaxNestedLevel ||
+            (enclosingType = index.FindType(type.enclosingTypeDef)) == nullptr)
+        {
+            type.fullName = type.name;
+            return;
+        }
+
+        const size_t enclosingIndex = enclosingType - index.types.data();
+        ResolveFullName(index, enclosingIndex, nestedLevel + 1);
+        index.types[typeIndex].fullName = index.types[enclosingIndex].fullName + "." + index.types[typeIndex].name;
+    }
+
+    void GetGenericParams(IMetaDataImport2 *pMD2, mdMethodDef methodDef, std::string &genericParams)
+    {
+        mdGenericParam params[EnumBatchSize];
+        ULONG numParams = 0;
+        HCORENUM fEnum = NULL;
+        while (SUCCEEDED(pMD2->EnumGenericParams(&fEnum, methodDef, params, EnumBatchSize, &numParams)) && numParams != 0)
+        {
+            for (ULONG i = 0; i < numParams; i++)
+            {
+                WCHAR szGenName[mdNameLen] = {0};
+                ULONG genNameLen;
+                if (FAILED(pMD2->GetGenericParamProps(params[i], nullptr, nullptr, nullptr, nullptr, szGenName, _countof(szGenName), &genNameLen)))
+                    continue;
+
+                genericParams += genericParams.empty() ? "<" : ",";
+                append_utf8(genericParams, szGenName);
+            }
+        }
+        pMD2->CloseEnum(fEnum);
+
+        if (!genericParams.empty())
+            genericParams += ">";
+    }
+
+    void FillMethodsByShortName(module_metadata_index_t &index)
+    {
+        index.methodsByShortName.reserve(index.methods.size());
+        for (size_t methodIndex = 0; methodIndex < index.methods.size(); methodIndex++)
+        {
+            const std::string shortName = module_metadata_index_t::GetMethodShortName(index.methods[methodIndex]);
+            index.methodsByShortName.emplace_back(std::hash<std::string>()(shortName), methodIndex);
+        }
+        std::sort(index.methodsByShortName.begin(), index.methodsByShortName.end());
+    }
+
+    HRESULT BuildModuleIndex(IUnknown *pMDUnknown, module_metadata_index_t &index)
+    {
+        HRESULT Status;
+        ToRelease<IMetaDataImport> pMD;
+        IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
+        ToRelease<IMetaDataImport2> pMD2;
+        IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport2, (LPVOID*) &pMD2));
+
+        mdTypeDef typeDefs[EnumBatchSize];
+        ULONG numTypedefs = 0;
+        HCORENUM hEnum = NULL;
+        while (SUCCEEDED(pMD->EnumTypeDefs(&hEnum, typeDefs, EnumBatchSize, &numTypedefs)) && numTypedefs != 0)
+        {
+            for (ULONG i = 0; i < numTypedefs; i++)
+            {
+                DWORD flags;
+                WCHAR name[mdNameLen];
+                ULONG nameLen;
+                if (FAILED(pMD->GetTypeDefProps(typeDefs[i], name, _countof(name), &nameLen, &flags, NULL)))
+                    continue;
+
+                module_metadata_index_t::type_t type;
+                type.typeDef = typeDefs[i];
+                type.enclosingTypeDef = mdTypeDefNil;
+                type.name = to_utf8(name);
+                type.methodsBegin = type.methodsEnd = 0;
+                if (IsTdNested(flags) && FAILED(pMD->GetNestedClassProps(typeDefs[i], &type.enclosingTypeDef)))
+                    type.enclosingTypeDef = mdTypeDefNil;
+
+                index.types.emplace_back(std::move(type));
+            }
+        }
+        pMD->CloseEnum(hEnum);
+
+        std::sort(index.types.begin(), index.types.end(), [](const module_metadata_index_t::type_t &a, const module_metadata_index_t::type_t &b)
+        {
+            return a.typeDef < b.typeDef;
+        });
+
+        for (size_t typeIndex = 0; typeIndex < index.types.size(); typeIndex++)
+        {
+            ResolveFullName(index, typeIndex, 0);
+
+            index.types[typeIndex].methodsBegin = index.methods.size();
+
+            mdMethodDef methodDefs[EnumBatchSize];
+            ULONG numMethods = 0;
+            HCORENUM fEnum = NULL;
+            while (SUCCEEDED(pMD->EnumMethods(&fEnum, index.types[typeIndex].typeDef, methodDefs, EnumBatchSize, &numMethods)) && numMethods != 0)
+            {
+                for (ULONG i = 0; i < numMethods; i++)
+                {
+                    WCHAR szFuncName[mdNameLen] = {0};
+                    ULONG nameLen;
+                    if (FAILED(pMD->GetMethodProps(methodDefs[i], nullptr, szFuncName, _countof(szFuncName), &nameLen,
+                                                   nullptr, nullptr, nullptr, nullptr, nullptr)))
+                        continue;
+
+                    module_metadata_index_t::method_t method;
+                    method.methodDef = methodDefs[i];
+                    method.typeIndex = typeIndex;
+                    method.name = to_utf8(szFuncName);
+                    GetGenericParams(pMD2, methodDefs[i], method.genericParams);
+
+                    index.methods.emplace_back(std::move(method));
+                }
+            }
+            pMD->CloseEnum(fEnum);
+
+            index.types[typeIndex].methodsEnd = index.methods.size();
+        }
+
+        FillMethodsByShortName(index);
+
+        return S_OK;
+    }
+
+    std::mutex g_indexesMutex;
+    std::unordered_map<CORDB_ADDRESS, MetadataIndex::index_ptr_t> g_indexes;
+    // Note, index build don't hold mutex, generation prevent store of outdated index, if module was invalidated during build.
+    uint64_t g_indexesGeneration = 0;
+
+} // unnamed namespace
+
+namespace MetadataIndex
+{
+
+HRESULT GetModuleIndex(ICorDebugModule *pModule, index_ptr_t &index)
+{
+    HRESULT Status;
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(g_indexesMutex);
+        auto find = g_indexes.find(modAddress);
+        if (find != g_indexes.end())
+        {
+            index = find->second;
+            return S_OK;
+        }
+        generation = g_indexesGeneration;
+    }
+
+    ToRelease<IUnknown> pMDUnknown;
+    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+
+    std::shared_ptr<module_metadata_index_t> newIndex(new module_metadata_index_t);
+    IfFailRet(BuildModuleIndex(pMDUnknown, *newIndex));
+    index = newIndex;
+
+    std::lock_guard<std::mutex> lock(g_indexesMutex);
+    if (generation == g_indexesGeneration)
+        index = g_indexes.emplace(modAddress, index).first->second;
+
+    return S_OK;
+}
+
+void InvalidateModule(CORDB_ADDRESS modAddress)
+{
+    std::lock_guard<std::mutex> lock(g_indexesMutex);
+    g_indexes.erase(modAddress);
+    g_indexesGeneration++;
+}
+
+bool ExportModuleIndex(CORDB_ADDRESS modAddress, module_snapshot_t &snapshot)
+{
+    index_ptr_t index;
+    {
+        std::lock_guard<std::mutex> lock(g_indexesMutex);
+        auto find = g_indexes.find(modAddress);
+        if (find == g_indexes.end())
+            return false;
+
+        index = find->second;
+    }
+
+    // Note, index is immutable after build, so, could be read without mutex.
+    snapshot.types.clear();
+    snapshot.types.reserve(index->types.size());
+    for (const auto &type : index->types)
+    {
+        snapshot.types.push_back({type.typeDef, type.enclosingTypeDef, type.name, type.fullName,
+                                  (uint32_t)type.methodsBegin, (uint32_t)type.methodsEnd});
+    }
+    snapshot.methods.clear();
+    snapshot.methods.reserve(index->methods.size());
+    for (const auto &method : index->methods)
+    {
+        snapshot.methods.push_back({method.methodDef, (uint32_t)method.typeIndex, method.name, method.genericParams});
+    }
+    snapshot.haveIndex = true;
+    return true;
+}
+
+void ImportModuleIndex(CORDB_ADDRESS modAddress, const module_snapshot_t &snapshot)
+{
+    if (!snapshot.haveIndex)
+        return;
+
+    // Note, snapshot data was validated at load (see ModuleSnapshotCache::Load()), types are stored in tokens order.
+    std::shared_ptr<module_metadata_index_t> newIndex(new module_metadata_index_t);
+    newIndex->types.reserve(snapshot.types.size());
+    for (const auto &type : snapshot.types)
+    {
+        newIndex->types.push_back({type.typeDef, type.enclosingTypeDef, type.name, type.fullName, type.methodsBegin, type.methodsEnd});
+    }
+    newIndex->methods.reserve(snapshot.methods.size());
+    for (const auto &method : snapshot.methods)
+    {
+        newIndex->methods.push_back({method.methodDef, method.typeIndex, method.name, method.genericParams});
+    }
+    FillMethodsByShortName(*newIndex);
+
+    std::lock_guard<std::mutex> lock(g_indexesMutex);
+    g_indexes[modAddress] = newIndex;
+}
+
+void Clear()
+{
+    std::lock_guard<std::mutex> lock(g_indexesMutex);
+    g_indexes.clear();
+    g_indexesGeneration++;
+}
+
+} // namespace MetadataIndex
+
+} // namespace netcoredbg
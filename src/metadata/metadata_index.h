@@ -0,0 +1,81 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace netcoredbg
+{
+
+struct module_snapshot_t;
+
+// All module's types and methods names with tokens, built by one bulk scan of module's TypeDef and MethodDef tables.
+// Shared by all code, that need enumerate all module's methods (function breakpoints, functions completions, methods
+// ranges for sources, entry breakpoint, evaluator's methods search), so, each module metadata is scanned only once.
+struct module_metadata_index_t
+{
+    struct method_t
+    {
+        mdMethodDef methodDef;
+        size_t typeIndex;           // index of method's type in `types`
+        std::string name;           // method name, for example "MoveNext", ".ctor"
+        std::string genericParams;  // method generic parameters names, for example "<T,U>", empty for not generic method
+    };
+
+    struct type_t
+    {
+        mdTypeDef typeDef;
+        mdTypeDef enclosingTypeDef; // mdTypeDefNil for not nested type
+        std::string name;           // type name without namespace and enclosing types
+        std::string fullName;       // full type name, same as TypePrinter::NameForToken() provide
+        size_t methodsBegin;        // type's methods range in `methods`
+        size_t methodsEnd;
+    };
+
+    // Types in TypeDef table order, methods of each type stored in MethodDef table order as contiguous range.
+    std::vector<type_t> types;
+    std::vector<method_t> methods;
+    // Hashes of methods short names (last component of full name) with method index, ordered by hash.
+    std::vector<std::pair<size_t, size_t>> methodsByShortName;
+
+    // Return nullptr in case module don't have such type.
+    const type_t *FindType(mdTypeDef typeDef) const;
+    // Full method name in `Namespace.Type.Method<T>` format.
+    std::string GetMethodFullName(const method_t &method) const
+    {
+        return types[method.typeIndex].fullName + "." + method.name + method.genericParams;
+    }
+    // Short name is part of full method name after last '.', for example "Method<T>" or "ctor" (for ".ctor").
+    static std::string GetMethodShortName(const method_t &method);
+    // Find indexes of all methods with provided short name.
+    void FindMethodsByShortName(const std::string &shortName, std::vector<size_t> &methodIndexes) const;
+};
+
+namespace MetadataIndex
+{
+
+    typedef std::shared_ptr<const module_metadata_index_t> index_ptr_t;
+
+    // Return module's index, index is built at first request for module, could be called from any thread.
+    HRESULT GetModuleIndex(ICorDebugModule *pModule, index_ptr_t &index);
+    // Module's metadata was changed (Hot Reload delta could add types and methods) or module was unloaded.
+    void InvalidateModule(CORDB_ADDRESS modAddress);
+    // Module snapshot related (see ModuleSnapshotCache). Export return false in case module's index was not built yet.
+    bool ExportModuleIndex(CORDB_ADDRESS modAddress, module_snapshot_t &snapshot);
+    // Use index from previous debug session snapshot, so, module's metadata will not be scanned at first request.
+    void ImportModuleIndex(CORDB_ADDRESS modAddress, const module_snapshot_t &snapshot);
+    // Must be called on debug session end, since modules addresses could be reused.
+    void Clear();
+
+} // namespace MetadataIndex
+
+} // namespace netcoredbg
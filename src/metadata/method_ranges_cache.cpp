@@ -0,0 +1,140 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/method_ranges_cache.h"
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include "utils/disk_cache.h"
+#include "utils/logger.h"
+#include "utils/mappedfile.h"
+
+namespace netcoredbg
+{
+
+static_assert(std::is_trivially_copyable<method_data_t>::value, "method_data_t must be trivially copyable, since stored in cache as is");
+
+namespace
+{
+    const char cacheMagic[8] = {'N', 'C', 'D', 'B', 'M', 'R', 'C', '\0'};
+
+    using DiskCacheFormat::ReadData;
+    using DiskCacheFormat::ReadValue;
+    using DiskCacheFormat::WriteValue;
+
+    DiskCache &GetCache()
+    {
+        static DiskCache cache("methods ranges", "netcoredbg-ranges-cache", ".ranges", "RangesCacheWriter",
+                               MethodRangesCache::DefaultMaxSize, std::numeric_limits<size_t>::max());
+        return cache;
+    }
+} // unnamed namespace
+
+const uint32_t MethodRangesCache::FormatVersion;
+const uint64_t MethodRangesCache::DefaultMaxSize;
+
+void MethodRangesCache::SetOptions(bool enable, const std::string &dir, uint64_t maxSize)
+{
+    GetCache().SetOptions(enable, dir, maxSize);
+}
+
+bool MethodRangesCache::IsEnabled()
+{
+    return GetCache().IsEnabled();
+}
+
+std::string MethodRangesCache::GetKey(const std::string &moduleId, const std::string &pdbChecksum)
+{
+    if (moduleId.empty() || pdbChecksum.empty())
+        return std::string();
+
+    return moduleId + "-" + pdbChecksum;
+}
+
+bool MethodRangesCache::Load(const std::string &key, module_methods_ranges_t &moduleRanges)
+{
+    std::string entryPath;
+    if (!GetCache().Lookup(key, entryPath))
+        return false;
+
+    // Note, entry is read from read-only mapping without cache lock, since published entry never changed
+    // (only replaced by rename or removed, that don't affect already mapped file).
+    MappedFile file;
+    if (!file.Open(entryPath))
+        return false;
+
+    const char *ptr = file.Data();
+    const char *end = ptr + file.Size();
+    char magic[sizeof(cacheMagic)];
+    uint32_t version = 0;
+    uint32_t fileNum = 0;
+    if (!ReadData(ptr, end, magic, sizeof(magic)) || memcmp(magic, cacheMagic, sizeof(cacheMagic)) != 0 ||
+        !ReadValue(ptr, end, version) || version != FormatVersion ||
+        !ReadValue(ptr, end, fileNum) || (uint64_t)fileNum * sizeof(uint32_t) * 2 > file.Size())
+    {
+        LOGW("Methods ranges cache entry %s have wrong format, ignored", key.c_str());
+        return false;
+    }
+
+    moduleRanges.clear();
+    moduleRanges.resize(fileNum);
+    for (auto &fileRanges : moduleRanges)
+    {
+        uint32_t documentLength = 0;
+        uint32_t methodNum = 0;
+        // Check sizes against rest of file first, since we can't trust data from disk.
+        if (!ReadValue(ptr, end, documentLength) || documentLength > size_t(end - ptr))
+        {
+            moduleRanges.clear();
+            return false;
+        }
+        fileRanges.document.assign(ptr, documentLength);
+        ptr += documentLength;
+        if (!ReadValue(ptr, end, methodNum) || (uint64_t)methodNum * sizeof(method_data_t) > size_t(end - ptr))
+        {
+            moduleRanges.clear();
+            return false;
+        }
+        fileRanges.methodsData.resize(methodNum);
+        ReadData(ptr, end, fileRanges.methodsData.data(), methodNum * sizeof(method_data_t));
+    }
+
+    return true;
+}
+
+void MethodRangesCache::Store(const std::string &key, const module_methods_ranges_t &moduleRanges)
+{
+    uint64_t size = sizeof(cacheMagic) + sizeof(uint32_t) * 2;
+    for (const auto &fileRanges : moduleRanges)
+    {
+        size += sizeof(uint32_t) * 2 + fileRanges.document.size() + fileRanges.methodsData.size() * sizeof(method_data_t);
+    }
+
+    GetCache().Store(key, size, [&](std::ostream &out)
+    {
+        out.write(cacheMagic, sizeof(cacheMagic));
+        WriteValue(out, FormatVersion);
+        WriteValue(out, (uint32_t)moduleRanges.size());
+        for (const auto &fileRanges : moduleRanges)
+        {
+            WriteValue(out, (uint32_t)fileRanges.document.size());
+            out.write(fileRanges.document.data(), fileRanges.document.size());
+            WriteValue(out, (uint32_t)fileRanges.methodsData.size());
+            out.write(reinterpret_cast<const char*>(fileRanges.methodsData.data()), fileRanges.methodsData.size() * sizeof(method_data_t));
+        }
+    });
+}
+
+void MethodRangesCache::StoreAsync(const std::string &key, const module_methods_ranges_t &moduleRanges)
+{
+    if (key.empty() || !IsEnabled())
+        return;
+
+    auto data = std::make_shared<module_methods_ranges_t>(moduleRanges);
+    GetCache().Post([key, data]() { Store(key, *data); });
+}
+
+} // namespace netcoredbg
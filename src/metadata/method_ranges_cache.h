@@ -0,0 +1,45 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "metadata/modules_sources.h"
+
+namespace netcoredbg
+{
+
+// On-disk cache for methods ranges data provided by Interop::GetModuleMethodsRanges().
+// Walk through all methods sequence points in managed part is expensive for big modules, but result depend
+// only on module metadata and PDB, so, it could be reused between debug sessions.
+// Each module stored in separate file, named by module MVID and PDB checksum (so, rebuilt module will not use outdated data).
+// Cache directory is per-user and could be shared by all debugger instances of same user (for example, CI jobs), first
+// instance processed module publishes entry and all others just map it read-only. Entries and index are published
+// by rename and never changed in place (see DiskCache).
+class MethodRangesCache
+{
+public:
+
+    // Increase in case of any changes in stored data format or in data provided by GetModuleMethodsRanges().
+    static const uint32_t FormatVersion = 1;
+    static const uint64_t DefaultMaxSize = 64 * 1024 * 1024;
+
+    // Should be called before any debug session start, default - enabled, temp directory, DefaultMaxSize.
+    // Note, maxSize equal to 0 disable cache.
+    static void SetOptions(bool enable, const std::string &dir, uint64_t maxSize);
+    static bool IsEnabled();
+
+    // Return key for module or empty string in case module can't be cached.
+    static std::string GetKey(const std::string &moduleId, const std::string &pdbChecksum);
+    // Return `true` in case data for key found and successfully loaded.
+    static bool Load(const std::string &key, module_methods_ranges_t &moduleRanges);
+    static void Store(const std::string &key, const module_methods_ranges_t &moduleRanges);
+    // Same as Store(), but entry is written by cache writer thread, so, caller's locks are not held during disk write.
+    static void StoreAsync(const std::string &key, const module_methods_ranges_t &moduleRanges);
+
+};
+
+} // namespace netcoredbg
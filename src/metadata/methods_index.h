@@ -0,0 +1,198 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include "utils/memory_size.h"
+#include "utils/span.h"
+
+namespace netcoredbg
+{
+
+// Flat index of source file methods data, aimed to answer "innermost methods covering line N" request.
+// All nested levels stored in one contiguous array (level by level, each level ordered by end line/column),
+// end lines stored in separate array (struct-of-arrays), so, binary search on each level don't touch methods data at all.
+// Methods, that represent same code (constructor's segments that are part of multiple constructors), stored as
+// index of element -> range in flat tokens array, instead of hash map.
+// Note, MethodData must provide `methodDef`, `startLine` and `endLine` fields.
+template <class MethodData, class Token>
+class MethodsIndex
+{
+public:
+
+    // Build index from properly ordered on each nested level methods data (std::map<size_t, std::set<MethodData>>)
+    // and mapping method's data to array of tokens, that also represent same code.
+    template <class Levels, class MultiMethods>
+    void Build(const Levels &levels, const MultiMethods &multiMethods)
+    {
+        Clear();
+
+        size_t size = 0;
+        for (const auto &level : levels)
+        {
+            size += level.second.size();
+        }
+        m_methods.reserve(size);
+        m_endLines.reserve(size);
+        m_levelOffsets.reserve(levels.size() + 1);
+        if (!multiMethods.empty())
+            m_multiOffsets.reserve(size + 1);
+
+        m_levelOffsets.emplace_back(0);
+        if (!multiMethods.empty())
+            m_multiOffsets.emplace_back(0);
+
+        for (const auto &level : levels)
+        {
+            for (const auto &methodData : level.second)
+            {
+                m_methods.emplace_back(methodData);
+                m_endLines.emplace_back(methodData.endLine);
+
+                if (multiMethods.empty())
+                    continue;
+
+                auto find = multiMethods.find(methodData);
+                if (find != multiMethods.end())
+                    m_multiTokens.insert(m_multiTokens.end(), find->second.begin(), find->second.end());
+                m_multiOffsets.emplace_back((uint32_t)m_multiTokens.size());
+            }
+            m_levelOffsets.emplace_back((uint32_t)m_methods.size());
+        }
+    }
+
+    void Clear()
+    {
+        m_levelOffsets.clear();
+        m_endLines.clear();
+        m_methods.clear();
+        m_multiOffsets.clear();
+        m_multiTokens.clear();
+    }
+
+    bool Empty() const
+    {
+        return m_methods.empty();
+    }
+
+    // Approximate heap memory size.
+    size_t GetMemoryUsage() const
+    {
+        return MemorySize::Vector(m_levelOffsets) + MemorySize::Vector(m_endLines) + MemorySize::Vector(m_methods) +
+               MemorySize::Vector(m_multiOffsets) + MemorySize::Vector(m_multiTokens);
+    }
+
+    // All methods data, level by level.
+    const std::vector<MethodData> &GetMethods() const
+    {
+        return m_methods;
+    }
+
+    // Tokens, that also represent same code as method with index `index` in GetMethods() array.
+    Utility::span<const Token> GetMultiTokens(size_t index) const
+    {
+        if (m_multiOffsets.empty())
+            return Utility::span<const Token>();
+
+        return Utility::span<const Token>(m_multiTokens.data() + m_multiOffsets[index], m_multiOffsets[index + 1] - m_multiOffsets[index]);
+    }
+
+    bool GetMethodTokensByLineNumber(/*in,out*/ int32_t &lineNum,
+                                     /*out*/ std::vector<Token> &Tokens,
+                                     /*out*/ Token &closestNestedToken) const
+    {
+        const MethodData *result = nullptr;
+        size_t resultIndex = 0;
+        closestNestedToken = 0;
+
+        for (size_t level = 0; level + 1 < m_levelOffsets.size(); level++)
+        {
+            auto first = m_endLines.cbegin() + m_levelOffsets[level];
+            auto last = m_endLines.cbegin() + m_levelOffsets[level + 1];
+            auto lower = std::lower_bound(first, last, lineNum);
+            if (lower == last)
+                break; // point behind last method for this nested level
+
+            const size_t lowerIndex = lower - m_endLines.cbegin();
+            const MethodData &lowerData = m_methods[lowerIndex];
+
+            // case with first line of method, for example:
+            // void Method(){
+            //            void Method(){ void Method(){...  <- breakpoint at this line
+            if (lineNum == lowerData.startLine)
+            {
+                // At this point we can't check this case, let managed part decide (since it see Columns):
+                // void Method() {
+                // ... code ...; void Method() {     <- breakpoint at this line
+                //  };
+                if (result)
+                    closestNestedToken = lowerData.methodDef;
+                else
+                {
+                    result = &lowerData;
+                    resultIndex = lowerIndex;
+                }
+
+                break;
+            }
+            else if (lineNum > lowerData.startLine && lowerData.endLine >= lineNum)
+            {
+                result = &lowerData;
+                resultIndex = lowerIndex;
+                continue; // need check nested level (if available)
+            }
+            // out of first level methods lines - forced move line to first method below, for example:
+            //  <-- breakpoint at line without code (out of any methods)
+            // void Method() {...}
+            else if (level == 0 && lineNum < lowerData.startLine)
+            {
+                lineNum = lowerData.startLine;
+                result = &lowerData;
+                resultIndex = lowerIndex;
+                break;
+            }
+            // result was found on previous cycle, check for closest nested method
+            // need it in case of breakpoint setuped at lines without code and before nested method, for example:
+            // {
+            //  <-- breakpoint at line without code (inside method)
+            //     void Method() {...}
+            // }
+            else if (result && lineNum <= lowerData.startLine && lowerData.endLine <= result->endLine)
+            {
+                closestNestedToken = lowerData.methodDef;
+                break;
+            }
+            else
+                break;
+        }
+
+        if (result)
+        {
+            // only constructors segments could be part of multiple methods
+            Utility::span<const Token> multiTokens = GetMultiTokens(resultIndex);
+            Tokens.assign(multiTokens.begin(), multiTokens.end());
+            Tokens.emplace_back(result->methodDef);
+        }
+
+        return !!result;
+    }
+
+private:
+
+    // m_levelOffsets - nested level `i` methods located in [m_levelOffsets[i], m_levelOffsets[i + 1]) range of arrays below
+    std::vector<uint32_t> m_levelOffsets;
+    // m_endLines - methods end lines, same indexes as m_methods
+    std::vector<int32_t> m_endLines;
+    std::vector<MethodData> m_methods;
+    // m_multiOffsets - method with index `i` have additional tokens in [m_multiOffsets[i], m_multiOffsets[i + 1]) range of m_multiTokens,
+    //                  empty in case file don't have methods with same code
+    std::vector<uint32_t> m_multiOffsets;
+    std::vector<Token> m_multiTokens;
+};
+
+} // namespace netcoredbg
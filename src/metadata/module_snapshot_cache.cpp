@@ -0,0 +1,233 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/module_snapshot_cache.h"
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include "utils/disk_cache.h"
+#include "utils/logger.h"
+#include "utils/mappedfile.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+    const char cacheMagic[8] = {'N', 'C', 'D', 'B', 'M', 'S', 'C', '\0'};
+
+    const uint32_t FlagNonJMCTokens = 1;
+    const uint32_t FlagIndex = 2;
+
+    using DiskCacheFormat::ReadData;
+    using DiskCacheFormat::ReadValue;
+    using DiskCacheFormat::ReadString;
+    using DiskCacheFormat::WriteValue;
+    using DiskCacheFormat::WriteString;
+
+    // Read elements count and check it against rest of data (each element have at least `minSize` bytes),
+    // since we can't trust data from disk.
+    bool ReadCount(const char *&ptr, const char *end, size_t minSize, uint32_t &count)
+    {
+        return ReadValue(ptr, end, count) && (uint64_t)count * minSize <= size_t(end - ptr);
+    }
+
+    bool ParseSnapshot(const char *ptr, const char *end, module_snapshot_t &snapshot)
+    {
+        char magic[sizeof(cacheMagic)];
+        uint32_t version = 0;
+        uint32_t flags = 0;
+        if (!ReadData(ptr, end, magic, sizeof(magic)) || memcmp(magic, cacheMagic, sizeof(cacheMagic)) != 0 ||
+            !ReadValue(ptr, end, version) || version != ModuleSnapshotCache::FormatVersion ||
+            !ReadValue(ptr, end, flags))
+            return false;
+
+        snapshot.nonJMCTokensCached = (flags & FlagNonJMCTokens) != 0;
+        snapshot.haveIndex = (flags & FlagIndex) != 0;
+
+        uint32_t count = 0;
+        if (!ReadCount(ptr, end, sizeof(uint32_t), count))
+            return false;
+        snapshot.nonJMCTokens.resize(count);
+        ReadData(ptr, end, snapshot.nonJMCTokens.data(), count * sizeof(uint32_t));
+
+        if (!ReadCount(ptr, end, sizeof(uint32_t) * 4, count))
+            return false;
+        snapshot.asyncMethods.resize(count);
+        for (auto &asyncMethod : snapshot.asyncMethods)
+        {
+            uint32_t awaitsNum = 0;
+            if (!ReadValue(ptr, end, asyncMethod.methodToken) ||
+                !ReadValue(ptr, end, asyncMethod.retCode) ||
+                !ReadValue(ptr, end, asyncMethod.lastIlOffset) ||
+                !ReadCount(ptr, end, sizeof(module_snapshot_t::await_t), awaitsNum))
+                return false;
+
+            asyncMethod.awaits.resize(awaitsNum);
+            for (auto &await : asyncMethod.awaits)
+            {
+                ReadValue(ptr, end, await.yieldOffset);
+                ReadValue(ptr, end, await.resumeOffset);
+            }
+        }
+
+        if (!ReadCount(ptr, end, sizeof(uint32_t) * 6, count))
+            return false;
+        snapshot.types.resize(count);
+        for (auto &type : snapshot.types)
+        {
+            if (!ReadValue(ptr, end, type.typeDef) ||
+                !ReadValue(ptr, end, type.enclosingTypeDef) ||
+                !ReadString(ptr, end, type.name) ||
+                !ReadString(ptr, end, type.fullName) ||
+                !ReadValue(ptr, end, type.methodsBegin) ||
+                !ReadValue(ptr, end, type.methodsEnd))
+                return false;
+        }
+
+        if (!ReadCount(ptr, end, sizeof(uint32_t) * 4, count))
+            return false;
+        snapshot.methods.resize(count);
+        for (auto &method : snapshot.methods)
+        {
+            if (!ReadValue(ptr, end, method.methodDef) ||
+                !ReadValue(ptr, end, method.typeIndex) ||
+                !ReadString(ptr, end, method.name) ||
+                !ReadString(ptr, end, method.genericParams) ||
+                method.typeIndex >= snapshot.types.size())
+                return false;
+        }
+
+        // Note, metadata index users access methods by types ranges without checks and search types by token.
+        for (size_t i = 0; i < snapshot.types.size(); i++)
+        {
+            const module_snapshot_t::type_t &type = snapshot.types[i];
+            if (type.methodsBegin > type.methodsEnd || type.methodsEnd > snapshot.methods.size() ||
+                (i > 0 && snapshot.types[i - 1].typeDef >= type.typeDef))
+                return false;
+        }
+
+        return ptr == end;
+    }
+
+    void WriteSnapshot(std::ostream &out, const module_snapshot_t &snapshot)
+    {
+        out.write(cacheMagic, sizeof(cacheMagic));
+        WriteValue(out, ModuleSnapshotCache::FormatVersion);
+        WriteValue(out, (snapshot.nonJMCTokensCached ? FlagNonJMCTokens : 0) | (snapshot.haveIndex ? FlagIndex : 0));
+
+        WriteValue(out, (uint32_t)snapshot.nonJMCTokens.size());
+        out.write(reinterpret_cast<const char*>(snapshot.nonJMCTokens.data()), snapshot.nonJMCTokens.size() * sizeof(uint32_t));
+
+        WriteValue(out, (uint32_t)snapshot.asyncMethods.size());
+        for (const auto &asyncMethod : snapshot.asyncMethods)
+        {
+            WriteValue(out, asyncMethod.methodToken);
+            WriteValue(out, asyncMethod.retCode);
+            WriteValue(out, asyncMethod.lastIlOffset);
+            WriteValue(out, (uint32_t)asyncMethod.awaits.size());
+            for (const auto &await : asyncMethod.awaits)
+            {
+                WriteValue(out, await.yieldOffset);
+                WriteValue(out, await.resumeOffset);
+            }
+        }
+
+        WriteValue(out, (uint32_t)snapshot.types.size());
+        for (const auto &type : snapshot.types)
+        {
+            WriteValue(out, type.typeDef);
+            WriteValue(out, type.enclosingTypeDef);
+            WriteString(out, type.name);
+            WriteString(out, type.fullName);
+            WriteValue(out, type.methodsBegin);
+            WriteValue(out, type.methodsEnd);
+        }
+
+        WriteValue(out, (uint32_t)snapshot.methods.size());
+        for (const auto &method : snapshot.methods)
+        {
+            WriteValue(out, method.methodDef);
+            WriteValue(out, method.typeIndex);
+            WriteString(out, method.name);
+            WriteString(out, method.genericParams);
+        }
+    }
+
+    DiskCache &GetCache()
+    {
+        static DiskCache cache("module snapshots", "netcoredbg-snapshots-cache", ".snapshot", "SnapshotsCacheWriter",
+                               ModuleSnapshotCache::DefaultMaxSize, std::numeric_limits<size_t>::max());
+        return cache;
+    }
+} // unnamed namespace
+
+const uint32_t ModuleSnapshotCache::FormatVersion;
+const uint64_t ModuleSnapshotCache::DefaultMaxSize;
+const size_t ModuleSnapshotCache::MaxAsyncMethods;
+
+void ModuleSnapshotCache::SetOptions(bool enable, const std::string &dir, uint64_t maxSize)
+{
+    GetCache().SetOptions(enable, dir, maxSize);
+}
+
+bool ModuleSnapshotCache::IsEnabled()
+{
+    return GetCache().IsEnabled();
+}
+
+std::string ModuleSnapshotCache::GetKey(const std::string &moduleId, const std::string &pdbChecksum)
+{
+    if (moduleId.empty() || pdbChecksum.empty())
+        return std::string();
+
+    return moduleId + "-" + pdbChecksum;
+}
+
+bool ModuleSnapshotCache::Load(const std::string &key, module_snapshot_t &snapshot)
+{
+    std::string entryPath;
+    if (!GetCache().Lookup(key, entryPath))
+        return false;
+
+    // Note, entry is read from read-only mapping without cache lock, since published entry never changed
+    // (only replaced by rename or removed, that don't affect already mapped file).
+    MappedFile file;
+    if (!file.Open(entryPath))
+        return false;
+
+    module_snapshot_t result;
+    if (!ParseSnapshot(file.Data(), file.Data() + file.Size(), result))
+    {
+        LOGW("Module snapshots cache entry %s have wrong format, ignored", key.c_str());
+        return false;
+    }
+
+    snapshot = std::move(result);
+    return true;
+}
+
+void ModuleSnapshotCache::Store(const std::string &key, const module_snapshot_t &snapshot)
+{
+    if (key.empty() || !IsEnabled())
+        return;
+
+    std::ostringstream out;
+    WriteSnapshot(out, snapshot);
+    const std::string data = out.str();
+    GetCache().Store(key, data.size(), [&](std::ostream &file) { file.write(data.data(), data.size()); });
+}
+
+void ModuleSnapshotCache::StoreAsync(const std::string &key, const module_snapshot_t &snapshot)
+{
+    if (key.empty() || !IsEnabled())
+        return;
+
+    auto data = std::make_shared<module_snapshot_t>(snapshot);
+    GetCache().Post([key, data]() { Store(key, *data); });
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,90 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace netcoredbg
+{
+
+// Module's data, that debugger calculate from module metadata and PDB during debug session and that could be reused by
+// next debug session of same application: JMC "not user code" tokens, async methods stepping info and metadata index.
+// Note, all tokens are stored as plain integers, so, snapshot could be used without CoreCLR headers.
+struct module_snapshot_t
+{
+    struct await_t
+    {
+        uint32_t yieldOffset;
+        uint32_t resumeOffset;
+    };
+
+    struct async_method_t
+    {
+        uint32_t methodToken;
+        int32_t retCode;        // Interop::GetAsyncMethodSteppingInfo() result, normal methods are stored with error code
+        uint32_t lastIlOffset;
+        std::vector<await_t> awaits; // sorted by yield offset
+    };
+
+    struct type_t
+    {
+        uint32_t typeDef;
+        uint32_t enclosingTypeDef;
+        std::string name;
+        std::string fullName;
+        uint32_t methodsBegin;
+        uint32_t methodsEnd;
+    };
+
+    struct method_t
+    {
+        uint32_t methodDef;
+        uint32_t typeIndex;
+        std::string name;
+        std::string genericParams;
+    };
+
+    bool nonJMCTokensCached = false;
+    std::vector<uint32_t> nonJMCTokens;
+    // Sorted by method token.
+    std::vector<async_method_t> asyncMethods;
+    // Metadata index (see module_metadata_index_t), stored in case it was built during debug session.
+    bool haveIndex = false;
+    std::vector<type_t> types; // sorted by type token
+    std::vector<method_t> methods;
+};
+
+// On-disk cache of module snapshots, stored at debug session end and loaded read-only (mapped) at module load by next
+// debug session, so, repeated launches of same application don't scan same metadata and PDB again.
+// Each module stored in separate file, named by module MVID and PDB checksum (so, rebuilt module will not use outdated data).
+// Entries and index are published by rename and never changed in place (see DiskCache).
+class ModuleSnapshotCache
+{
+public:
+
+    // Increase in case of any changes in stored data format.
+    static const uint32_t FormatVersion = 1;
+    static const uint64_t DefaultMaxSize = 64 * 1024 * 1024;
+    // Limit for async methods stored for one module, only stepped methods are stored, so, this is not reached in real session.
+    static const size_t MaxAsyncMethods = 4096;
+
+    // Should be called before any debug session start, default - enabled, temp directory, DefaultMaxSize.
+    // Note, maxSize equal to 0 disable cache.
+    static void SetOptions(bool enable, const std::string &dir, uint64_t maxSize);
+    static bool IsEnabled();
+
+    // Return key for module or empty string in case module can't be cached.
+    static std::string GetKey(const std::string &moduleId, const std::string &pdbChecksum);
+    // Return `true` in case data for key found and successfully loaded.
+    static bool Load(const std::string &key, module_snapshot_t &snapshot);
+    static void Store(const std::string &key, const module_snapshot_t &snapshot);
+    // Same as Store(), but entry is written by cache writer thread, so, caller's locks are not held during disk write.
+    static void StoreAsync(const std::string &key, const module_snapshot_t &snapshot);
+
+};
+
+} // namespace netcoredbg
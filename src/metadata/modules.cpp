@@ -4,19 +4,46 @@
 
 #include "metadata/modules.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <sstream>
+#include <unordered_set>
 #include <vector>
 #include <iomanip>
+#include <fstream>
+#include <limits>
 
 #include "managed/interop.h"
 #include "utils/platform.h"
 #include "metadata/typeprinter.h"
 #include "metadata/jmc.h"
+#include "metadata/metadata_index.h"
 #include "utils/filesystem.h"
+#include "utils/logger.h"
+#include "utils/memory_size.h"
+#include "utils/perfcounters.h"
+#include "utils/tracerecorder.h"
+#include "utils/string_interner.h"
 
 namespace netcoredbg
 {
 
+static PerfCounters::Counter modulesLoadedCounter("modulesLoaded");
+// Note, include symbols preload in background thread.
+static PerfCounters::Counter symbolsLoadTimeCounter("symbolsLoadTimeUs");
+static PerfCounters::Counter symbolsUnloadedCounter("symbolsUnloaded");
+static PerfCounters::Counter symbolsReloadedCounter("symbolsReloaded");
+
+// Symbols memory limit related, incremented on each unload check, modules with symbols access in current epoch are not unloaded.
+static std::atomic<uint64_t> symbolsUseEpoch(1);
+
+// Symbols idle timeout related, seconds of steady clock.
+static uint64_t GetSymbolsUseTime()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 ModuleInfo::~ModuleInfo() noexcept
 {
     for (auto symbolReaderHandle : m_symbolReaderHandles)
@@ -26,6 +53,41 @@ ModuleInfo::~ModuleInfo() noexcept
     }
 }
 
+// Simple wildcard match, where '*' in pattern match any sequence of characters (including empty).
+static bool IsNameMatch(const std::string &name, const std::string &pattern)
+{
+    size_t n = 0;
+    size_t p = 0;
+    size_t starPos = std::string::npos;
+    size_t starMatch = 0;
+    while (n < name.size())
+    {
+        if (p < pattern.size() && pattern[p] == '*')
+        {
+            starPos = p++;
+            starMatch = n;
+        }
+        else if (p < pattern.size() && pattern[p] == name[n])
+        {
+            p++;
+            n++;
+        }
+        else if (starPos != std::string::npos)
+        {
+            p = starPos + 1;
+            n = ++starMatch;
+        }
+        else
+            return false;
+    }
+
+    while (p < pattern.size() && pattern[p] == '*')
+    {
+        p++;
+    }
+    return p == pattern.size();
+}
+
 static bool IsTargetFunction(const std::vector<std::string> &fullName, const std::vector<std::string> &targetName)
 {
     // Function should be matched by substring, i.e. received target function name should fully or partly equal with the
@@ -39,11 +101,13 @@ static bool IsTargetFunction(const std::vector<std::string> &fullName, const std
     // "ClassA.MethodB" matches
     // Program.ClassA.MethodB
     // Program.ClassB.ClassA.MethodB
+    //
+    // Each name component could have '*' wildcard, for example "ClassA.*" or "ClassA.Get*".
 
     auto fullIt = fullName.rbegin();
     for (auto it = targetName.rbegin(); it != targetName.rend(); it++)
     {
-        if (fullIt == fullName.rend() || *it != *fullIt)
+        if (fullIt == fullName.rend() || !IsNameMatch(*fullIt, *it))
             return false;
 
         fullIt++;
@@ -55,132 +119,255 @@ static bool IsTargetFunction(const std::vector<std::string> &fullName, const std
 static HRESULT ForEachMethod(ICorDebugModule *pModule, std::function<bool(const std::string&, mdMethodDef&)> functor)
 {
     HRESULT Status;
-    ToRelease<IUnknown> pMDUnknown;
-    ToRelease<IMetaDataImport> pMDImport;
-
-    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
-    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID *)&pMDImport));
-
-    ULONG typesCnt = 0;
-    HCORENUM fTypeEnum = NULL;
-    mdTypeDef mdType = mdTypeDefNil;
+    MetadataIndex::index_ptr_t index;
+    IfFailRet(MetadataIndex::GetModuleIndex(pModule, index));
 
-    while (SUCCEEDED(pMDImport->EnumTypeDefs(&fTypeEnum, &mdType, 1, &typesCnt)) && typesCnt != 0)
+    for (const auto &method : index->methods)
     {
-        std::string typeName;
-        IfFailRet(TypePrinter::NameForToken(mdType, pMDImport, typeName, false, nullptr));
-
-        HCORENUM fFuncEnum = NULL;
-        mdMethodDef mdMethod = mdMethodDefNil;
-        ULONG methodsCnt = 0;
+        mdMethodDef mdMethod = method.methodDef;
+        if (!functor(index->GetMethodFullName(method), mdMethod))
+            return E_FAIL;
+    }
 
-        while (SUCCEEDED(pMDImport->EnumMethods(&fFuncEnum, mdType, &mdMethod, 1, &methodsCnt)) && methodsCnt != 0)
-        {
-            mdTypeDef memTypeDef;
-            ULONG nameLen;
-            WCHAR szFuncName[mdNameLen] = {0};
+    return S_OK;
+}
 
-            Status = pMDImport->GetMethodProps(mdMethod, &memTypeDef, szFuncName, _countof(szFuncName), &nameLen,
-                                               nullptr, nullptr, nullptr, nullptr, nullptr);
-            if (FAILED(Status))
-                continue;
+static std::vector<std::string> split_on_tokens(const std::string &str, const char delim)
+{
+    std::vector<std::string> res;
+    size_t pos = 0, prev = 0;
 
-            // Get generic types
-            ToRelease<IMetaDataImport2> pMDImport2;
+    while (true)
+    {
+        pos = str.find(delim, prev);
+        if (pos == std::string::npos)
+        {
+            res.push_back(std::string(str, prev));
+            break;
+        }
 
-            IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport2, (LPVOID *)&pMDImport2));
+        res.push_back(std::string(str, prev, pos - prev));
+        prev = pos + 1;
+    }
 
-            HCORENUM fGenEnum = NULL;
-            mdGenericParam gp;
-            ULONG fetched;
-            std::string genParams("");
+    return res;
+}
 
-            while (SUCCEEDED(pMDImport2->EnumGenericParams(&fGenEnum, mdMethod, &gp, 1, &fetched)) && fetched == 1)
-            {
-                mdMethodDef memMethodDef;
-                WCHAR szGenName[mdNameLen] = {0};
-                ULONG genNameLen;
+static std::string TrimSpaces(const std::string &str)
+{
+    const size_t begin = str.find_first_not_of(" \t");
+    if (begin == std::string::npos)
+        return std::string();
 
-                Status = pMDImport2->GetGenericParamProps(gp, nullptr, nullptr, &memMethodDef, nullptr, szGenName, _countof(szGenName), &genNameLen);
-                if (FAILED(Status))
-                    continue;
+    return str.substr(begin, str.find_last_not_of(" \t") - begin + 1);
+}
 
-                // Add comma for each element. The last one will be stripped later.
-                genParams += to_utf8(szGenName) + ",";
-            }
+// Note, generic arguments in type names could be separated by ", " or ",".
+static std::string RemoveSpaces(std::string str)
+{
+    str.erase(std::remove(str.begin(), str.end(), ' '), str.end());
+    return str;
+}
 
-            pMDImport2->CloseEnum(fGenEnum);
+// Parse function breakpoint parameters in "(int, ref string, List<int>)" format into types names list.
+// Return false in case parameters are not provided (all overloads should be used).
+static bool ParseFuncParams(const std::string &params, std::vector<std::string> &paramsTypes)
+{
+    const std::string trimmed = TrimSpaces(params);
+    if (trimmed.size() < 2 || trimmed.front() != '(' || trimmed.back() != ')')
+        return false;
+
+    paramsTypes.clear();
+    const std::string list = trimmed.substr(1, trimmed.size() - 2);
+    if (TrimSpaces(list).empty())
+        return true;
+
+    // Note, generic arguments could have ',' inside.
+    int nested = 0;
+    size_t prev = 0;
+    for (size_t i = 0; i <= list.size(); i++)
+    {
+        if (i < list.size())
+        {
+            if (list[i] == '<' || list[i] == '[')
+                nested++;
+            else if (list[i] == '>' || list[i] == ']')
+                nested--;
 
-            std::string fullName = to_utf8(szFuncName);
-            if (genParams != "")
-            {
-                // Last symbol is comma and it is useless, so remove
-                genParams.pop_back();
-                fullName += "<" + genParams + ">";
-            }
+            if (list[i] != ',' || nested > 0)
+                continue;
+        }
 
-            if (!functor(typeName + "." + fullName, mdMethod))
+        std::string param = TrimSpaces(list.substr(prev, i - prev));
+        for (const char *modifier : { "ref ", "out ", "in " })
+        {
+            const size_t len = strlen(modifier);
+            if (param.compare(0, len, modifier) == 0)
             {
-                pMDImport->CloseEnum(fFuncEnum);
-                pMDImport->CloseEnum(fTypeEnum);
-                return E_FAIL;
+                param = TrimSpaces(param.substr(len)) + "&";
+                break;
             }
         }
+        paramsTypes.emplace_back(RemoveSpaces(TypePrinter::RenameToCSharp(param)));
+        prev = i + 1;
+    }
+
+    return true;
+}
 
-        pMDImport->CloseEnum(fFuncEnum);
+static bool IsParamTypeMatch(const std::string &typeName, const std::string &targetName)
+{
+    // Note, type could be provided without namespace and enclosing types, for example "ClassA" for "Program.ClassA".
+    return typeName == targetName ||
+           (typeName.size() > targetName.size() && typeName[typeName.size() - targetName.size() - 1] == '.' &&
+            typeName.compare(typeName.size() - targetName.size(), targetName.size(), targetName) == 0);
+}
+
+static bool IsTargetParams(IMetaDataImport *pMD, mdMethodDef methodDef, const std::vector<std::string> &paramsTypes)
+{
+    PCCOR_SIGNATURE pSig = nullptr;
+    ULONG cbSig = 0;
+    std::vector<std::string> methodParams;
+    if (FAILED(pMD->GetMethodProps(methodDef, nullptr, nullptr, 0, nullptr, nullptr, &pSig, &cbSig, nullptr, nullptr)) ||
+        FAILED(TypePrinter::NamesForMethodSigParams(pSig, pMD, methodParams)) ||
+        methodParams.size() != paramsTypes.size())
+        return false;
+
+    for (size_t i = 0; i < methodParams.size(); i++)
+    {
+        if (!IsParamTypeMatch(RemoveSpaces(TypePrinter::RenameToCSharp(methodParams[i])), paramsTypes[i]))
+            return false;
     }
-    pMDImport->CloseEnum(fTypeEnum);
 
-    return S_OK;
+    return true;
 }
 
-static std::vector<std::string> split_on_tokens(const std::string &str, const char delim)
+static HRESULT ResolveMethodInModule(ICorDebugModule *pModule, const std::string &funcName, const std::string &params,
+                                     ResolveFuncBreakpointCallback cb)
 {
-    std::vector<std::string> res;
-    size_t pos = 0, prev = 0;
+    HRESULT Status;
+    MetadataIndex::index_ptr_t index;
+    IfFailRet(MetadataIndex::GetModuleIndex(pModule, index));
 
-    while (true)
+    std::vector<std::string> splitName = split_on_tokens(funcName, '.');
+
+    // Note, in case of method name without wildcard, only methods with same short name are checked (hash lookup),
+    // all module's methods should be checked otherwise.
+    std::vector<size_t> candidates;
+    if (splitName.back().find('*') == std::string::npos)
     {
-        pos = str.find(delim, prev);
-        if (pos == std::string::npos)
+        index->FindMethodsByShortName(splitName.back(), candidates);
+    }
+    else
+    {
+        candidates.resize(index->methods.size());
+        for (size_t i = 0; i < candidates.size(); i++)
         {
-            res.push_back(std::string(str, prev));
-            break;
+            candidates[i] = i;
         }
+    }
 
-        res.push_back(std::string(str, prev, pos - prev));
-        prev = pos + 1;
+    std::vector<std::string> paramsTypes;
+    const bool checkParams = ParseFuncParams(params, paramsTypes);
+    ToRelease<IMetaDataImport> pMD;
+    if (checkParams)
+    {
+        ToRelease<IUnknown> pMDUnknown;
+        IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+        IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
     }
 
-    return res;
+    for (size_t methodIndex : candidates)
+    {
+        const auto &method = index->methods[methodIndex];
+        if (!IsTargetFunction(split_on_tokens(index->GetMethodFullName(method), '.'), splitName) ||
+            (checkParams && !IsTargetParams(pMD, method.methodDef, paramsTypes)))
+            continue;
+
+        mdMethodDef mdMethod = method.methodDef;
+        if (FAILED(cb(pModule, mdMethod)))
+            return E_FAIL; // abort operation
+    }
+
+    return S_OK;
 }
 
-static HRESULT ResolveMethodInModule(ICorDebugModule *pModule, const std::string &funcName, ResolveFuncBreakpointCallback cb)
+// Collect module's data for next debug session, return false in case snapshot should not be stored.
+// Caller must care about m_modulesInfoMutex.
+static bool GetModuleSnapshot(CORDB_ADDRESS modAddress, ModuleInfo &mdInfo, module_snapshot_t &snapshot)
 {
-    std::vector<std::string> splitName = split_on_tokens(funcName, '.');
+    // Note, Hot Reload deltas change module's metadata, collected data don't belong to module with this MVID any more.
+    if (mdInfo.m_snapshotState->m_key.empty() || mdInfo.m_symbolReaderHandles.size() != 1)
+        return false;
 
-    auto functor = [&](const std::string& fullName, mdMethodDef& mdMethod) -> bool
-    {
-        std::vector<std::string> splitFullName = split_on_tokens(fullName, '.');
+    snapshot.nonJMCTokensCached = mdInfo.m_nonJMCTokensCached;
+    if (mdInfo.m_nonJMCTokensCached)
+        snapshot.nonJMCTokens.assign(mdInfo.m_nonJMCTokens.begin(), mdInfo.m_nonJMCTokens.end());
 
-        // If we've found the target function
-        if (IsTargetFunction(splitFullName, splitName))
+    bool changed;
+    {
+        std::lock_guard<std::mutex> lock(mdInfo.m_snapshotState->m_mutex);
+        changed = mdInfo.m_snapshotState->m_changed;
+        snapshot.asyncMethods.reserve(mdInfo.m_snapshotState->m_asyncMethods.size());
+        for (const auto &entry : mdInfo.m_snapshotState->m_asyncMethods)
         {
-            if (FAILED(cb(pModule, mdMethod)))
-                return false; // abort operation
+            snapshot.asyncMethods.emplace_back(entry.second);
         }
+    }
+    std::sort(snapshot.asyncMethods.begin(), snapshot.asyncMethods.end(),
+              [](const module_snapshot_t::async_method_t &a, const module_snapshot_t::async_method_t &b)
+              {
+                  return a.methodToken < b.methodToken;
+              });
 
-        return true;  // continue for other functions with matching name
-    };
+    if (MetadataIndex::ExportModuleIndex(modAddress, snapshot) && !mdInfo.m_snapshotState->m_haveIndex)
+        changed = true;
 
-    return ForEachMethod(pModule, functor);
+    return changed && (snapshot.nonJMCTokensCached || !snapshot.asyncMethods.empty() || snapshot.haveIndex);
 }
 
 void Modules::CleanupAllModules()
 {
-    std::lock_guard<std::mutex> lock(m_modulesInfoMutex);
+    m_symbolsPreloader.Cancel();
+    m_symbolsDownloader.Cancel();
+    m_sourceLinkCache.Cancel();
+    m_symbolsPreloadStarted = false;
+
+    std::lock_guard<Utility::RWLock::Writer> lock(m_modulesInfoMutex.writer);
+    if (ModuleSnapshotCache::IsEnabled())
+    {
+        for (auto &info_pair : m_modulesInfo)
+        {
+            module_snapshot_t snapshot;
+            if (GetModuleSnapshot(info_pair.first, info_pair.second, snapshot))
+                ModuleSnapshotCache::StoreAsync(info_pair.second.m_snapshotState->m_key, snapshot);
+        }
+    }
     m_modulesInfo.clear();
+    m_modulesNames.clear();
     m_modulesAppUpdate.Clear();
+    m_sequencePointsCache.Clear();
+    m_nativeCodeCache.Clear();
+    m_userCodeCache.Clear();
+    TypePrinter::ClearMethodNamesCache();
+    MetadataIndex::Clear();
+
+    std::lock_guard<std::mutex> lockIndexes(m_functionsIndexesMutex);
+    m_functionsIndexes.clear();
+}
+
+void Modules::ModuleUnloaded(ICorDebugModule *pModule)
+{
+    CORDB_ADDRESS modAddress = 0;
+    if (FAILED(pModule->GetBaseAddress(&modAddress)))
+        return;
+
+    m_symbolsDownloader.Remove(modAddress);
+    m_nativeCodeCache.InvalidateModule(modAddress);
+    m_userCodeCache.InvalidateModule(modAddress);
+    MetadataIndex::InvalidateModule(modAddress);
+    std::lock_guard<std::mutex> lockIndexes(m_functionsIndexesMutex);
+    m_functionsIndexes[modAddress].reset(new PrefixIndex("."));
 }
 
 std::string GetModuleFileName(ICorDebugModule *pModule)
@@ -237,9 +424,59 @@ HRESULT IsModuleHaveSameName(ICorDebugModule *pModule, const std::string &Name,
     return modName == Name ? S_OK : S_FALSE;
 }
 
+HRESULT Modules::GetModuleIdCached(ICorDebugModule *pModule, std::string &id)
+{
+    CORDB_ADDRESS modAddress = 0;
+    if (SUCCEEDED(pModule->GetBaseAddress(&modAddress)) &&
+        SUCCEEDED(GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
+        {
+            id = mdInfo.m_id;
+            return S_OK;
+        })))
+    {
+        return S_OK;
+    }
+
+    return GetModuleId(pModule, id);
+}
+
+std::string Modules::GetModuleFileNameCached(ICorDebugModule *pModule)
+{
+    std::string path;
+    CORDB_ADDRESS modAddress = 0;
+    if (SUCCEEDED(pModule->GetBaseAddress(&modAddress)) &&
+        SUCCEEDED(GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
+        {
+            path = mdInfo.m_path;
+            return S_OK;
+        })))
+    {
+        return path;
+    }
+
+    return GetModuleFileName(pModule);
+}
+
+HRESULT Modules::IsModuleHaveSameNameCached(ICorDebugModule *pModule, const std::string &name, bool isFullPath)
+{
+    bool same = false;
+    CORDB_ADDRESS modAddress = 0;
+    if (SUCCEEDED(pModule->GetBaseAddress(&modAddress)) &&
+        SUCCEEDED(GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
+        {
+            same = (isFullPath ? mdInfo.m_path : mdInfo.m_name) == name;
+            return S_OK;
+        })))
+    {
+        return same ? S_OK : S_FALSE;
+    }
+
+    return IsModuleHaveSameName(pModule, name, isFullPath);
+}
+
 HRESULT Modules::GetModuleInfo(CORDB_ADDRESS modAddress, ModuleInfoCallback cb)
 {
-    std::lock_guard<std::mutex> lock(m_modulesInfoMutex);
+    std::lock_guard<Utility::RWLock::Reader> lock(m_modulesInfoMutex.reader);
     auto info_pair = m_modulesInfo.find(modAddress);
     return (info_pair == m_modulesInfo.end()) ? E_FAIL : cb(info_pair->second);
 }
@@ -258,31 +495,31 @@ HRESULT Modules::GetModuleInfo(CORDB_ADDRESS modAddress, ModuleInfo **ppmdInfo)
 HRESULT Modules::ResolveFuncBreakpointInAny(const std::string &module,
                                             bool &module_checked,
                                             const std::string &funcname,
+                                            const std::string &params,
                                             ResolveFuncBreakpointCallback cb)
 {
-    bool isFullPath = IsFullPath(module);
-    HRESULT Status;
+    std::lock_guard<Utility::RWLock::Reader> lock(m_modulesInfoMutex.reader);
 
-    std::lock_guard<std::mutex> lock(m_modulesInfoMutex);
-
-    for (auto &info_pair : m_modulesInfo)
+    if (module.empty())
     {
-        ModuleInfo &mdInfo = info_pair.second;
-        ICorDebugModule *pModule = mdInfo.m_iCorModule.GetPtr();
-
-        if (!module.empty())
+        for (auto &info_pair : m_modulesInfo)
         {
-            IfFailRet(IsModuleHaveSameName(pModule, module, isFullPath));
-            if (Status == S_FALSE)
-                continue;
-
-            module_checked = true;
+            ResolveMethodInModule(info_pair.second.m_iCorModule, funcname, params, cb);
         }
+        return S_OK;
+    }
 
-        ResolveMethodInModule(mdInfo.m_iCorModule, funcname, cb);
+    bool isFullPath = IsFullPath(module);
+    auto range = m_modulesNames.equal_range(isFullPath ? GetFileName(module) : module);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        auto find = m_modulesInfo.find(it->second);
+        if (find == m_modulesInfo.end() || (isFullPath && find->second.m_path != module))
+            continue;
 
-        if (module_checked)
-            break;
+        module_checked = true;
+        ResolveMethodInModule(find->second.m_iCorModule, funcname, params, cb);
+        break;
     }
 
     return S_OK;
@@ -290,20 +527,20 @@ HRESULT Modules::ResolveFuncBreakpointInAny(const std::string &module,
 
 
 HRESULT Modules::ResolveFuncBreakpointInModule(ICorDebugModule *pModule, const std::string &module, bool &module_checked,
-                                               std::string &funcname, ResolveFuncBreakpointCallback cb)
+                                               std::string &funcname, const std::string &params, ResolveFuncBreakpointCallback cb)
 {
     HRESULT Status;
 
     if (!module.empty())
     {
-        IfFailRet(IsModuleHaveSameName(pModule, module, IsFullPath(module)));
+        IfFailRet(IsModuleHaveSameNameCached(pModule, module, IsFullPath(module)));
         if (Status == S_FALSE)
             return E_FAIL;
 
         module_checked = true;
     }
 
-    return ResolveMethodInModule(pModule, funcname, cb);
+    return ResolveMethodInModule(pModule, funcname, params, cb);
 }
 
 HRESULT Modules::GetFrameILAndSequencePoint(
@@ -338,10 +575,7 @@ HRESULT Modules::GetFrameILAndSequencePoint(
 
     return GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
     {
-        if (mdInfo.m_symbolReaderHandles.empty() || mdInfo.m_symbolReaderHandles.size() < methodVersion)
-            return E_FAIL;
-
-        IfFailRet(GetSequencePointByILOffset(mdInfo.m_symbolReaderHandles[methodVersion - 1], methodToken, ilOffset, &sequencePoint));
+        IfFailRet(GetSequencePointByILOffset(mdInfo, modAddress, methodToken, methodVersion, ilOffset, sequencePoint));
 
         // In case Hot Reload we may have line updates that we must take into account.
         unsigned fullPathIndex;
@@ -383,6 +617,29 @@ HRESULT Modules::GetFrameILAndNextUserCodeILOffset(
     return GetNextUserCodeILOffsetInMethod(pModule, methodToken, methodVersion, ilOffset, ilNextOffset, noUserCodeFound);
 }
 
+bool Modules::GetUserCodeProperty(ICorDebugFunction *pFunction, UserCodeCache::Property property, const std::function<bool()> &calculate)
+{
+    mdMethodDef methodToken;
+    ToRelease<ICorDebugCode> pCode;
+    ULONG32 methodVersion;
+    ToRelease<ICorDebugModule> pModule;
+    CORDB_ADDRESS modAddress;
+    if (FAILED(pFunction->GetToken(&methodToken)) ||
+        FAILED(pFunction->GetILCode(&pCode)) ||
+        FAILED(pCode->GetVersionNumber(&methodVersion)) ||
+        FAILED(pFunction->GetModule(&pModule)) ||
+        FAILED(pModule->GetBaseAddress(&modAddress)))
+        return calculate();
+
+    bool value = false;
+    if (m_userCodeCache.Get(modAddress, methodToken, methodVersion, property, value))
+        return value;
+
+    value = calculate();
+    m_userCodeCache.Set(modAddress, methodToken, methodVersion, property, value);
+    return value;
+}
+
 HRESULT Modules::GetStepRangeFromCurrentIP(ICorDebugThread *pThread, COR_DEBUG_STEP_RANGE *range)
 {
     HRESULT Status;
@@ -420,10 +677,10 @@ HRESULT Modules::GetStepRangeFromCurrentIP(ICorDebugThread *pThread, COR_DEBUG_S
 
     IfFailRet(GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
     {
-        if (mdInfo.m_symbolReaderHandles.empty() || mdInfo.m_symbolReaderHandles.size() < methodVersion)
-            return E_FAIL;
+        SequencePointsCache::entry_t methodSequencePoints;
+        IfFailRet(GetMethodSequencePoints(mdInfo, modAddress, methodToken, methodVersion, methodSequencePoints));
 
-        return Interop::GetStepRangesFromIP(mdInfo.m_symbolReaderHandles[methodVersion - 1], nOffset, methodToken, &ilStartOffset, &ilEndOffset);
+        return methodSequencePoints->GetStepRangesFromIP(nOffset, ilStartOffset, ilEndOffset) ? S_OK : E_FAIL;
     }));
 
     if (ilStartOffset == ilEndOffset)
@@ -439,6 +696,121 @@ HRESULT Modules::GetStepRangeFromCurrentIP(ICorDebugThread *pThread, COR_DEBUG_S
     return S_OK;
 }
 
+static native_code_t::InstructionSet GetTargetInstructionSet()
+{
+#if defined(_TARGET_AMD64_)
+    return native_code_t::InstructionSet::AMD64;
+#elif defined(_TARGET_X86_)
+    return native_code_t::InstructionSet::X86;
+#elif defined(_TARGET_ARM64_)
+    return native_code_t::InstructionSet::ARM64;
+#elif defined(_TARGET_ARM_)
+    return native_code_t::InstructionSet::ARM;
+#else
+    return native_code_t::InstructionSet::Unknown;
+#endif
+}
+
+HRESULT Modules::GetNativeCode(ICorDebugCode *pCode, NativeCodeCache::entry_t &nativeCode)
+{
+    HRESULT Status;
+    CORDB_ADDRESS codeAddress;
+    IfFailRet(pCode->GetAddress(&codeAddress));
+
+    // Note, code start address identify method's code version.
+    nativeCode = m_nativeCodeCache.Find(codeAddress);
+    if (nativeCode && nativeCode->address == codeAddress)
+        return S_OK;
+
+    ULONG32 codeSize;
+    IfFailRet(pCode->GetSize(&codeSize));
+    if (codeSize == 0)
+        return E_FAIL;
+
+    ToRelease<ICorDebugFunction> pFunc;
+    IfFailRet(pCode->GetFunction(&pFunc));
+    ToRelease<ICorDebugModule> pModule;
+    IfFailRet(pFunc->GetModule(&pModule));
+    ToRelease<ICorDebugProcess> pProcess;
+    IfFailRet(pModule->GetProcess(&pProcess));
+
+    auto code = std::make_shared<native_code_t>();
+    IfFailRet(pModule->GetBaseAddress(&code->modAddress));
+    IfFailRet(pFunc->GetToken(&code->methodToken));
+    ToRelease<ICorDebugCode> pILCode;
+    IfFailRet(pFunc->GetILCode(&pILCode));
+    IfFailRet(pILCode->GetVersionNumber(&code->methodVersion));
+    code->address = codeAddress;
+
+    // Note, ReadMemory() provide original code bytes without breakpoints patches.
+    code->code.resize(codeSize);
+    SIZE_T read = 0;
+    IfFailRet(pProcess->ReadMemory(codeAddress, codeSize, code->code.data(), &read));
+    code->code.resize(read);
+
+    ULONG32 mapCount = 0;
+    IfFailRet(pCode->GetILToNativeMapping(0, &mapCount, nullptr));
+    std::vector<COR_DEBUG_IL_TO_NATIVE_MAP> map(mapCount);
+    if (mapCount > 0)
+        IfFailRet(pCode->GetILToNativeMapping(mapCount, &mapCount, map.data()));
+
+    code->mapping.reserve(mapCount);
+    for (ULONG32 i = 0; i < mapCount; i++)
+    {
+        code->mapping.push_back({map[i].ilOffset, map[i].nativeStartOffset, map[i].nativeEndOffset});
+    }
+    code->DecodeInstructions(GetTargetInstructionSet());
+
+    m_nativeCodeCache.Put(code);
+    nativeCode = std::move(code);
+    return S_OK;
+}
+
+HRESULT Modules::GetNativeCodeByAddress(ICorDebugProcess *pProcess, CORDB_ADDRESS address, NativeCodeCache::entry_t &nativeCode)
+{
+    nativeCode = m_nativeCodeCache.Find(address);
+    if (nativeCode)
+        return S_OK;
+
+    HRESULT Status;
+    ToRelease<ICorDebugProcess6> pProcess6;
+    IfFailRet(pProcess->QueryInterface(IID_ICorDebugProcess6, (LPVOID*) &pProcess6));
+    ToRelease<ICorDebugCode2> pCode2;
+    IfFailRet(pProcess6->GetCode(address, &pCode2));
+    ToRelease<ICorDebugCode> pCode;
+    IfFailRet(pCode2->QueryInterface(IID_ICorDebugCode, (LPVOID*) &pCode));
+
+    return GetNativeCode(pCode, nativeCode);
+}
+
+HRESULT Modules::GetInstructionStepRangeFromCurrentIP(ICorDebugThread *pThread, COR_DEBUG_STEP_RANGE *range)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugFrame> pFrame;
+    IfFailRet(pThread->GetActiveFrame(&pFrame));
+    if (pFrame == nullptr)
+        return E_FAIL;
+
+    ToRelease<ICorDebugNativeFrame> pNativeFrame;
+    IfFailRet(pFrame->QueryInterface(IID_ICorDebugNativeFrame, (LPVOID*) &pNativeFrame));
+    ULONG32 nativeOffset;
+    IfFailRet(pNativeFrame->GetIP(&nativeOffset));
+    ToRelease<ICorDebugCode> pCode;
+    IfFailRet(pNativeFrame->GetCode(&pCode));
+
+    NativeCodeCache::entry_t nativeCode;
+    IfFailRet(GetNativeCode(pCode, nativeCode));
+
+    size_t index;
+    if (!nativeCode->FindInstruction(nativeOffset, index))
+        return E_FAIL;
+
+    range->startOffset = nativeCode->instructions[index];
+    range->endOffset = nativeCode->GetInstructionEnd(index);
+
+    return S_OK;
+}
+
 HRESULT GetModuleId(ICorDebugModule *pModule, std::string &id)
 {
     HRESULT Status;
@@ -470,6 +842,7 @@ HRESULT GetModuleId(ICorDebugModule *pModule, std::string &id)
 
 static HRESULT LoadSymbols(IMetaDataImport *pMD, ICorDebugModule *pModule, VOID **ppSymbolReaderHandle)
 {
+    PerfCounters::ScopedTime time(symbolsLoadTimeCounter);
     HRESULT Status = S_OK;
     BOOL isDynamic = FALSE;
     BOOL isInMemory = FALSE;
@@ -496,47 +869,343 @@ static HRESULT LoadSymbols(IMetaDataImport *pMD, ICorDebugModule *pModule, VOID
     );
 }
 
-HRESULT Modules::TryLoadModuleSymbols(ICorDebugModule *pModule, Module &module, bool needJMC, bool needHotReload, std::string &outputText)
+PVOID ModuleInfo::GetSymbolReaderHandle(ULONG32 methodVersion)
 {
-    HRESULT Status;
+    if (methodVersion == 0 || m_symbolReaderHandles.size() < methodVersion)
+        return nullptr;
+
+    MarkSymbolsUsed();
+    // Note, only module's PDB symbol reader could be unloaded, Hot Reload deltas are never changed under reader lock.
+    if (methodVersion > 1)
+        return m_symbolReaderHandles[methodVersion - 1];
+
+    std::lock_guard<std::mutex> lock(m_symbolsState->m_mutex);
+    if (m_symbolsState->m_unloaded)
+    {
+        PVOID pSymbolReaderHandle = nullptr;
+        if (FAILED(LoadSymbols(nullptr, m_iCorModule, &pSymbolReaderHandle)) || pSymbolReaderHandle == nullptr)
+        {
+            LOGE("Could not load again unloaded symbols for %s", GetModuleFileName(m_iCorModule).c_str());
+            return nullptr;
+        }
+
+        m_symbolReaderHandles[0] = pSymbolReaderHandle;
+        m_symbolsState->m_unloaded = false;
+        symbolsReloadedCounter.Add();
+    }
+
+    return m_symbolReaderHandles[0];
+}
+
+void ModuleInfo::MarkSymbolsUsed()
+{
+    m_symbolsState->m_lastUse.store(symbolsUseEpoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_symbolsState->m_lastUseTime.store(GetSymbolsUseTime(), std::memory_order_relaxed);
+}
 
+static void PreloadSymbols(ICorDebugModule *pModule, SymbolsPreloader::Result &result)
+{
     ToRelease<IUnknown> pMDUnknown;
     ToRelease<IMetaDataImport> pMDImport;
-    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
-    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMDImport));
-
-    module.path = GetModuleFileName(pModule);
-    module.name = GetFileName(module.path);
+    if (FAILED(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown)) ||
+        FAILED(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMDImport)) ||
+        FAILED(LoadSymbols(pMDImport, pModule, &result.pSymbolReaderHandle)) ||
+        result.pSymbolReaderHandle == nullptr)
+        return;
+
+    // Note, preload used for attach only, where Hot Reload can't be used, so lazy indexing will be used for sure.
+    Interop::GetModuleDocuments(result.pSymbolReaderHandle, result.documents);
+    // Note, attributes scan don't need stopped process, only JMC status apply do.
+    GetNonJMCClassesAndMethods(pModule, result.nonJMCTokens);
+}
 
-    PVOID pSymbolReaderHandle = nullptr;
-    LoadSymbols(pMDImport, pModule, &pSymbolReaderHandle);
-    module.symbolStatus = pSymbolReaderHandle != nullptr ? SymbolsLoaded : SymbolsNotFound;
+Modules::Modules() :
+    m_symbolsPreloader(PreloadSymbols),
+    m_symbolsDownloader(std::bind(&Modules::AttachDownloadedSymbols, this, std::placeholders::_1)),
+    m_sourceLinkCache([](const std::string &url, const std::string &filePath)
+    {
+        return SUCCEEDED(Interop::DownloadSource(url, filePath));
+    })
+{}
 
-    if (module.symbolStatus == SymbolsLoaded)
+void Modules::SetSourceLink(bool enable, unsigned prefetchFrames)
+{
+    if (enable)
     {
-        ToRelease<ICorDebugModule2> pModule2;
-        if (SUCCEEDED(pModule->QueryInterface(IID_ICorDebugModule2, (LPVOID *)&pModule2)))
+        // Note, downloaded sources are shown to user, don't use directory that could be created by other user.
+        std::string cacheDir = GetUserTempDir("netcoredbg-sources");
+        if (!CreatePrivateDir(cacheDir))
         {
-            if (needHotReload)
-                pModule2->SetJITCompilerFlags(CORDEBUG_JIT_ENABLE_ENC);
-            else if (!needJMC) // Note, CORDEBUG_JIT_DISABLE_OPTIMIZATION is part of CORDEBUG_JIT_ENABLE_ENC.
-                pModule2->SetJITCompilerFlags(CORDEBUG_JIT_DISABLE_OPTIMIZATION);
+            LOGW("Could not create sources cache directory %s, SourceLink disabled", cacheDir.c_str());
+            enable = false;
+        }
+        else
+            m_sourceLinkCache.SetDir(cacheDir);
+    }
 
-            if (SUCCEEDED(Status = pModule2->SetJMCStatus(TRUE, 0, nullptr))) // If we can't enable JMC for module, no reason disable JMC on module's types/methods.
-            {
-                // Note, we use JMC in runtime all the time (same behaviour as MS vsdbg and MSVS debugger have),
-                // since this is the only way provide good speed for stepping in case "JMC disabled".
-                // But in case "JMC disabled", debugger must care about different logic for exceptions/stepping/breakpoints.
+    if (!enable)
+        m_sourceLinkCache.Cancel();
 
-                // https://docs.microsoft.com/en-us/visualstudio/debugger/just-my-code
-                // The .NET debugger considers optimized binaries and non-loaded .pdb files to be non-user code.
-                // Three compiler attributes also affect what the .NET debugger considers to be user code:
-                // * DebuggerNonUserCodeAttribute tells the debugger that the code it's applied to isn't user code.
+    m_sourceLinkPrefetchFrames = prefetchFrames;
+    m_sourceLinkEnabled = enable;
+}
+
+static bool IsFileExist(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return file.good();
+}
+
+void Modules::PrefetchSourceLinkSource(ICorDebugFrame *pFrame)
+{
+    ULONG32 ilOffset;
+    Modules::SequencePoint sp;
+    ToRelease<ICorDebugFunction> pFunc;
+    ToRelease<ICorDebugModule> pModule;
+    CORDB_ADDRESS modAddress;
+    if (!m_sourceLinkEnabled ||
+        FAILED(GetFrameILAndSequencePoint(pFrame, ilOffset, sp)) ||
+        FAILED(pFrame->GetFunction(&pFunc)) ||
+        FAILED(pFunc->GetModule(&pModule)) ||
+        FAILED(pModule->GetBaseAddress(&modAddress)))
+        return;
+
+    std::string document(sp.document.begin(), sp.document.end());
+    if (document.empty() || IsFileExist(document))
+        return;
+
+    std::string url;
+    std::string contentKey;
+    if (FAILED(GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
+        {
+            if (mdInfo.m_symbolReaderHandles.size() != 1)
+                return E_FAIL;
+
+            PVOID pSymbolReaderHandle = mdInfo.GetSymbolReaderHandle(1);
+            if (pSymbolReaderHandle == nullptr)
+                return E_FAIL;
+
+            return Interop::GetSourceLinkInfo(pSymbolReaderHandle, document, url, contentKey);
+        })))
+        return;
+
+    m_sourceLinkCache.Prefetch(url, contentKey, GetFileName(document));
+}
+
+void Modules::SetSymbolServers(const std::string &servers, const std::string &cachePath)
+{
+    std::string cacheDir(cachePath);
+    if (cacheDir.empty() && !servers.empty())
+    {
+        // Note, downloaded PDBs are loaded by debugger, don't use directory that could be created by other user.
+        cacheDir = GetUserTempDir("netcoredbg-symbols");
+        if (!CreatePrivateDir(cacheDir))
+        {
+            LOGW("Could not create symbols cache directory %s, symbols download disabled", cacheDir.c_str());
+            cacheDir.clear();
+        }
+    }
+
+    Interop::SetSymbolServers(servers, cacheDir);
+    m_symbolsDownloadEnabled = !servers.empty() && !cacheDir.empty();
+}
+
+void Modules::SetSymbolsDownloadedCallback(std::function<void(const Module &module)> cb)
+{
+    if (!cb)
+        m_symbolsDownloader.Cancel();
+
+    std::lock_guard<std::mutex> lock(m_symbolsDownloadedMutex);
+    m_symbolsDownloadedCallback = cb;
+}
+
+void Modules::AttachDownloadedSymbols(ICorDebugModule *pModule)
+{
+    CORDB_ADDRESS modAddress;
+    ULONG32 size;
+    ToRelease<IUnknown> pMDUnknown;
+    ToRelease<IMetaDataImport> pMDImport;
+    PVOID pSymbolReaderHandle = nullptr;
+    if (FAILED(pModule->GetBaseAddress(&modAddress)) ||
+        FAILED(pModule->GetSize(&size)) ||
+        FAILED(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown)) ||
+        FAILED(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMDImport)) ||
+        FAILED(LoadSymbols(pMDImport, pModule, &pSymbolReaderHandle)) ||
+        pSymbolReaderHandle == nullptr)
+    {
+        LOGW("Could not load downloaded symbols for %s", GetModuleFileName(pModule).c_str());
+        return;
+    }
+
+    // Note, module load (and Hot Reload) use not lazy indexing only in case Hot Reload enabled, download is not used in this case.
+    if (FAILED(m_modulesSources.FillSourcesCodeLinesForModule(pModule, pMDImport, pSymbolReaderHandle, true, nullptr)))
+        LOGE("Could not load source lines related info from PDB file. Could produce failures during breakpoint's source path resolve in future.");
+
+    Module module;
+    {
+        std::lock_guard<Utility::RWLock::Writer> lock(m_modulesInfoMutex.writer);
+        auto info = m_modulesInfo.find(modAddress);
+        // Note, module could be unloaded and new module loaded at same address during download.
+        if (info == m_modulesInfo.end() || info->second.m_iCorModule.GetPtr() != pModule || !info->second.m_symbolReaderHandles.empty())
+        {
+            Interop::DisposeSymbols(pSymbolReaderHandle);
+            return;
+        }
+
+        info->second.m_symbolReaderHandles.emplace_back(pSymbolReaderHandle);
+        info->second.MarkSymbolsUsed();
+        module.id = info->second.m_id;
+        module.name = info->second.m_name;
+        module.path = info->second.m_path;
+    }
+    module.symbolStatus = SymbolsLoaded;
+    module.baseAddress = modAddress;
+    module.size = size;
+
+    std::lock_guard<std::mutex> lock(m_symbolsDownloadedMutex);
+    if (m_symbolsDownloadedCallback)
+        m_symbolsDownloadedCallback(module);
+}
+
+void Modules::PreloadModulesSymbols(ICorDebugAppDomain *pAppDomain)
+{
+    if (m_symbolsPreloadStarted)
+        return;
+
+    m_symbolsPreloadStarted = true;
+
+    std::vector<ToRelease<ICorDebugModule>> modules;
+    ToRelease<ICorDebugAssemblyEnum> pAssemblyEnum;
+    if (FAILED(pAppDomain->EnumerateAssemblies(&pAssemblyEnum)))
+        return;
+
+    ICorDebugAssembly *pAssembly;
+    ULONG assemblyFetched = 0;
+    while (SUCCEEDED(pAssemblyEnum->Next(1, &pAssembly, &assemblyFetched)) && assemblyFetched == 1)
+    {
+        ToRelease<ICorDebugAssembly> trAssembly(pAssembly);
+        ToRelease<ICorDebugModuleEnum> pModuleEnum;
+        if (FAILED(pAssembly->EnumerateModules(&pModuleEnum)))
+            continue;
+
+        ICorDebugModule *pModule;
+        ULONG moduleFetched = 0;
+        while (SUCCEEDED(pModuleEnum->Next(1, &pModule, &moduleFetched)) && moduleFetched == 1)
+        {
+            CORDB_ADDRESS modAddress;
+            if (FAILED(pModule->GetBaseAddress(&modAddress)))
+            {
+                pModule->Release();
+                continue;
+            }
+
+            {
+                std::lock_guard<Utility::RWLock::Reader> lock(m_modulesInfoMutex.reader);
+                if (m_modulesInfo.find(modAddress) != m_modulesInfo.end())
+                {
+                    pModule->Release();
+                    continue;
+                }
+            }
+
+            modules.emplace_back(pModule);
+        }
+    }
+
+    m_symbolsPreloader.Schedule(modules);
+}
+
+HRESULT Modules::TryLoadModuleSymbols(ICorDebugModule *pModule, Module &module, bool needJMC, bool deferJMC, bool needHotReload, std::string &outputText)
+{
+    HRESULT Status;
+    modulesLoadedCounter.Add();
+    TraceRecorder::ScopedEvent traceEvent("symbols", "LoadModuleSymbols");
+
+    ToRelease<IUnknown> pMDUnknown;
+    ToRelease<IMetaDataImport> pMDImport;
+    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMDImport));
+
+    module.path = ::netcoredbg::GetModuleFileName(pModule);
+    module.name = GetFileName(module.path);
+    traceEvent.SetArg(module.name);
+
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+    SymbolsPreloader::Result preloaded;
+    bool isPreloaded = m_symbolsPreloader.Take(modAddress, preloaded);
+
+    PVOID pSymbolReaderHandle = preloaded.pSymbolReaderHandle;
+    if (!isPreloaded)
+        LoadSymbols(pMDImport, pModule, &pSymbolReaderHandle);
+    module.symbolStatus = pSymbolReaderHandle != nullptr ? SymbolsLoaded : SymbolsNotFound;
+
+    // Note, snapshot data depend on PDB (async methods info), so, only modules with symbols could be cached.
+    std::string snapshotKey;
+    module_snapshot_t snapshot;
+    bool snapshotLoaded = false;
+    if (module.symbolStatus == SymbolsLoaded && ModuleSnapshotCache::IsEnabled())
+    {
+        std::string moduleId;
+        std::string pdbChecksum;
+        if (SUCCEEDED(::netcoredbg::GetModuleId(pModule, moduleId)) &&
+            SUCCEEDED(Interop::GetPdbChecksum(pSymbolReaderHandle, pdbChecksum)))
+        {
+            snapshotKey = ModuleSnapshotCache::GetKey(moduleId, pdbChecksum);
+        }
+
+        snapshotLoaded = ModuleSnapshotCache::Load(snapshotKey, snapshot);
+    }
+    bool snapshotChanged = false;
+
+    std::vector<mdToken> nonJMCTokens;
+    bool nonJMCTokensCached = false;
+    bool canSetJMC = false;
+    bool nonJMCApplied = false;
+
+    if (module.symbolStatus == SymbolsLoaded)
+    {
+        ToRelease<ICorDebugModule2> pModule2;
+        if (SUCCEEDED(pModule->QueryInterface(IID_ICorDebugModule2, (LPVOID *)&pModule2)))
+        {
+            if (needHotReload)
+                pModule2->SetJITCompilerFlags(CORDEBUG_JIT_ENABLE_ENC);
+            else if (!needJMC) // Note, CORDEBUG_JIT_DISABLE_OPTIMIZATION is part of CORDEBUG_JIT_ENABLE_ENC.
+                pModule2->SetJITCompilerFlags(CORDEBUG_JIT_DISABLE_OPTIMIZATION);
+
+            if (SUCCEEDED(Status = pModule2->SetJMCStatus(TRUE, 0, nullptr))) // If we can't enable JMC for module, no reason disable JMC on module's types/methods.
+            {
+                canSetJMC = true;
+                // Note, we use JMC in runtime all the time (same behaviour as MS vsdbg and MSVS debugger have),
+                // since this is the only way provide good speed for stepping in case "JMC disabled".
+                // But in case "JMC disabled", debugger must care about different logic for exceptions/stepping/breakpoints.
+
+                // https://docs.microsoft.com/en-us/visualstudio/debugger/just-my-code
+                // The .NET debugger considers optimized binaries and non-loaded .pdb files to be non-user code.
+                // Three compiler attributes also affect what the .NET debugger considers to be user code:
+                // * DebuggerNonUserCodeAttribute tells the debugger that the code it's applied to isn't user code.
                 // * DebuggerHiddenAttribute hides the code from the debugger, even if Just My Code is turned off.
                 // * DebuggerStepThroughAttribute tells the debugger to step through the code it's applied to, rather than step into the code.
                 // The .NET debugger considers all other code to be user code.
-                if (needJMC)
-                    DisableJMCByAttributes(pModule);
+                // Note, tokens are cached for JMC toggling, in case "JMC disabled" they are calculated at first JMC enable.
+                const bool snapshotTokens = snapshotLoaded && snapshot.nonJMCTokensCached;
+                if (needJMC || isPreloaded || snapshotTokens)
+                {
+                    if (isPreloaded)
+                        nonJMCTokens = std::move(preloaded.nonJMCTokens);
+                    else if (snapshotTokens)
+                        nonJMCTokens.assign(snapshot.nonJMCTokens.begin(), snapshot.nonJMCTokens.end());
+                    else
+                        GetNonJMCClassesAndMethods(pModule, nonJMCTokens);
+                    nonJMCTokensCached = true;
+                    snapshotChanged = !snapshotTokens;
+
+                    if (needJMC && !deferJMC)
+                    {
+                        DisableJMCForTokenList(pModule, nonJMCTokens);
+                        nonJMCApplied = true;
+                    }
+                }
             }
             else if (Status == CORDBG_E_CANT_SET_TO_JMC)
             {
@@ -547,11 +1216,13 @@ HRESULT Modules::TryLoadModuleSymbols(ICorDebugModule *pModule, Module &module,
             }
         }
 
-        if (FAILED(m_modulesSources.FillSourcesCodeLinesForModule(pModule, pMDImport, pSymbolReaderHandle)))
+        // Note, Hot Reload need methods data for all modules for line updates, so, lazy indexing can't be used.
+        if (FAILED(m_modulesSources.FillSourcesCodeLinesForModule(pModule, pMDImport, pSymbolReaderHandle, !needHotReload,
+                                                                   isPreloaded && !needHotReload ? &preloaded.documents : nullptr)))
             LOGE("Could not load source lines related info from PDB file. Could produce failures during breakpoint's source path resolve in future.");
     }
 
-    IfFailRet(GetModuleId(pModule, module.id));
+    IfFailRet(::netcoredbg::GetModuleId(pModule, module.id));
 
     CORDB_ADDRESS baseAddress;
     ULONG32 size;
@@ -562,50 +1233,178 @@ HRESULT Modules::TryLoadModuleSymbols(ICorDebugModule *pModule, Module &module,
 
     pModule->AddRef();
     ModuleInfo mdInfo { pSymbolReaderHandle, pModule };
-    std::lock_guard<std::mutex> lock(m_modulesInfoMutex);
-    m_modulesInfo.insert(std::make_pair(baseAddress, std::move(mdInfo)));
+    mdInfo.m_nonJMCTokens = std::move(nonJMCTokens);
+    mdInfo.m_nonJMCTokensCached = nonJMCTokensCached;
+    mdInfo.m_canSetJMC = canSetJMC;
+    mdInfo.m_nonJMCApplied = nonJMCApplied;
+    mdInfo.m_nonJMCNeeded = canSetJMC && needJMC;
+    mdInfo.m_snapshotState->m_key = std::move(snapshotKey);
+    mdInfo.m_snapshotState->m_changed = snapshotChanged;
+    mdInfo.m_snapshotState->m_haveIndex = snapshotLoaded && snapshot.haveIndex;
+    for (auto &asyncMethod : snapshot.asyncMethods)
+    {
+        mdInfo.m_snapshotState->m_asyncMethods.emplace(asyncMethod.methodToken, std::move(asyncMethod));
+    }
+    // Note, module could be loaded at address of unloaded one, index was invalidated at unload.
+    if (snapshotLoaded)
+        MetadataIndex::ImportModuleIndex(baseAddress, snapshot);
+    mdInfo.m_id = module.id;
+    mdInfo.m_path = module.path;
+    mdInfo.m_name = module.name;
+    // Note, new module's symbols are used by breakpoints resolve and JMC setup, don't unload them at next check.
+    mdInfo.MarkSymbolsUsed();
+    std::lock_guard<Utility::RWLock::Writer> lock(m_modulesInfoMutex.writer);
+    if (mdInfo.m_nonJMCNeeded != mdInfo.m_nonJMCApplied && !mdInfo.m_nonJMCTokens.empty())
+        m_haveDeferredJMC = true;
+    if (m_modulesInfo.insert(std::make_pair(baseAddress, std::move(mdInfo))).second)
+        m_modulesNames.emplace(module.name, baseAddress);
+    {
+        // Note, module could be loaded at address of unloaded one, new index will be built at first completions request.
+        std::lock_guard<std::mutex> lockIndexes(m_functionsIndexesMutex);
+        m_functionsIndexes.erase(baseAddress);
+    }
 
     if (needHotReload)
         IfFailRet(m_modulesAppUpdate.AddUpdateHandlerTypesForModule(pModule, pMDImport));
+    else if (module.symbolStatus == SymbolsNotFound && m_symbolsDownloadEnabled && !module.path.empty())
+    {
+        BOOL isDynamic = FALSE;
+        BOOL isInMemory = FALSE;
+        if (SUCCEEDED(pModule->IsDynamic(&isDynamic)) && !isDynamic &&
+            SUCCEEDED(pModule->IsInMemory(&isInMemory)) && !isInMemory)
+            m_symbolsDownloader.Schedule(pModule);
+    }
 
     return S_OK;
 }
 
-HRESULT Modules::GetFrameNamedLocalVariable(
-    ICorDebugModule *pModule,
-    mdMethodDef methodToken,
-    ULONG32 methodVersion,
-    ULONG localIndex,
-    WSTRING &localName,
-    ULONG32 *pIlStart,
-    ULONG32 *pIlEnd)
+HRESULT Modules::ApplyDeferredJMC(const std::unordered_set<CORDB_ADDRESS> *priorityModules)
 {
-    HRESULT Status;
+    // Note, fast path for most calls, all deferred JMC statuses already applied.
+    // In case of priority modules, rest modules could still have deferred JMC statuses, so, flag is not reset.
+    if (priorityModules == nullptr ? !m_haveDeferredJMC.exchange(false) : !m_haveDeferredJMC.load())
+        return S_OK;
 
-    CORDB_ADDRESS modAddress;
-    IfFailRet(pModule->GetBaseAddress(&modAddress));
+    struct deferred_t
+    {
+        ToRelease<ICorDebugModule> iCorModule;
+        CORDB_ADDRESS modAddress;
+        bool nonJMCNeeded;
+        bool tokensCached;
+        std::vector<mdToken> tokens;
+    };
+    std::vector<deferred_t> deferred;
+    {
+        std::lock_guard<Utility::RWLock::Writer> lock(m_modulesInfoMutex.writer);
+        for (auto &info_pair : m_modulesInfo)
+        {
+            ModuleInfo &mdInfo = info_pair.second;
+            if (mdInfo.m_nonJMCNeeded == mdInfo.m_nonJMCApplied ||
+                (priorityModules != nullptr && priorityModules->find(info_pair.first) == priorityModules->end()))
+                continue;
 
-    WCHAR wLocalName[mdNameLen] = W("\0");
+            // Note, state changed in advance, since ICorDebug calls are done without modules info lock.
+            mdInfo.m_nonJMCApplied = mdInfo.m_nonJMCNeeded;
+            if (mdInfo.m_nonJMCTokensCached && mdInfo.m_nonJMCTokens.empty())
+                continue;
 
-    IfFailRet(GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
+            mdInfo.m_iCorModule->AddRef();
+            deferred.emplace_back();
+            deferred.back().iCorModule = mdInfo.m_iCorModule.GetPtr();
+            deferred.back().modAddress = info_pair.first;
+            deferred.back().nonJMCNeeded = mdInfo.m_nonJMCNeeded;
+            deferred.back().tokensCached = mdInfo.m_nonJMCTokensCached;
+            // Note, tokens are kept in cache for next JMC toggle.
+            if (mdInfo.m_nonJMCTokensCached)
+                deferred.back().tokens = mdInfo.m_nonJMCTokens;
+        }
+    }
+
+    // Note, ICorDebug calls don't need modules info lock.
+    bool newTokensCached = false;
+    for (auto &entry : deferred)
     {
-        if (mdInfo.m_symbolReaderHandles.empty() || mdInfo.m_symbolReaderHandles.size() < methodVersion)
-            return E_FAIL;
+        if (!entry.tokensCached)
+        {
+            GetNonJMCClassesAndMethods(entry.iCorModule, entry.tokens);
+            newTokensCached = true;
+        }
 
-        return Interop::GetNamedLocalVariableAndScope(mdInfo.m_symbolReaderHandles[methodVersion - 1], methodToken, localIndex, wLocalName, _countof(wLocalName), pIlStart, pIlEnd);
-    }));
+        SetJMCStatusForTokenList(entry.iCorModule, entry.tokens, entry.nonJMCNeeded ? FALSE : TRUE);
+    }
+
+    if (!deferred.empty())
+        m_userCodeCache.InvalidateJMCStatus();
+
+    if (!newTokensCached)
+        return S_OK;
 
-    localName = wLocalName;
+    std::lock_guard<Utility::RWLock::Writer> lock(m_modulesInfoMutex.writer);
+    for (auto &entry : deferred)
+    {
+        if (entry.tokensCached)
+            continue;
+
+        // Note, module could be unloaded and other module loaded at same address during tokens calculation.
+        auto info_pair = m_modulesInfo.find(entry.modAddress);
+        if (info_pair == m_modulesInfo.end() || info_pair->second.m_iCorModule.GetPtr() != entry.iCorModule.GetPtr() ||
+            info_pair->second.m_nonJMCTokensCached)
+            continue;
+
+        info_pair->second.m_nonJMCTokens = std::move(entry.tokens);
+        info_pair->second.m_nonJMCTokensCached = true;
+        std::lock_guard<std::mutex> lockSnapshot(info_pair->second.m_snapshotState->m_mutex);
+        info_pair->second.m_snapshotState->m_changed = true;
+    }
 
     return S_OK;
 }
 
-HRESULT Modules::GetHoistedLocalScopes(
+void Modules::SetJustMyCode(bool enable, const std::unordered_set<CORDB_ADDRESS> &priorityModules)
+{
+    bool haveChanges = false;
+    {
+        std::lock_guard<Utility::RWLock::Writer> lock(m_modulesInfoMutex.writer);
+        for (auto &info_pair : m_modulesInfo)
+        {
+            ModuleInfo &mdInfo = info_pair.second;
+            if (!mdInfo.m_canSetJMC)
+                continue;
+
+            mdInfo.m_nonJMCNeeded = enable;
+            if (mdInfo.m_nonJMCNeeded != mdInfo.m_nonJMCApplied)
+                haveChanges = true;
+        }
+    }
+
+    if (!haveChanges)
+        return;
+
+    m_haveDeferredJMC = true;
+
+    if (!priorityModules.empty())
+        ApplyDeferredJMC(&priorityModules);
+}
+
+const WSTRING *MethodLocals::FindLocal(ULONG32 localIndex, ULONG32 ilOffset) const
+{
+    auto it = std::lower_bound(locals.begin(), locals.end(), localIndex, [](const local_t &local, ULONG32 index)
+    {
+        return local.index < index;
+    });
+    for (; it != locals.end() && it->index == localIndex; ++it)
+    {
+        if (ilOffset >= it->ilStart && ilOffset < it->ilEnd)
+            return &it->name;
+    }
+    return nullptr;
+}
+
+HRESULT Modules::GetMethodLocals(
     ICorDebugModule *pModule,
     mdMethodDef methodToken,
     ULONG32 methodVersion,
-    PVOID *data,
-    int32_t &hoistedLocalScopesCount)
+    std::shared_ptr<const MethodLocals> &methodLocals)
 {
     HRESULT Status;
     CORDB_ADDRESS modAddress;
@@ -613,36 +1412,85 @@ HRESULT Modules::GetHoistedLocalScopes(
 
     return GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
     {
-        if (mdInfo.m_symbolReaderHandles.empty() || mdInfo.m_symbolReaderHandles.size() < methodVersion)
+        const uint64_t key = ((uint64_t)methodVersion << 32) | methodToken;
+        std::lock_guard<std::mutex> lock(mdInfo.m_localsCache->m_mutex);
+        auto find = mdInfo.m_localsCache->m_methods.find(key);
+        if (find != mdInfo.m_localsCache->m_methods.end())
+        {
+            methodLocals = find->second;
+            return S_OK;
+        }
+
+        PVOID pSymbolReaderHandle = mdInfo.GetSymbolReaderHandle(methodVersion);
+        if (pSymbolReaderHandle == nullptr)
             return E_FAIL;
 
-        return Interop::GetHoistedLocalScopes(mdInfo.m_symbolReaderHandles[methodVersion - 1], methodToken, data, hoistedLocalScopesCount);
+        std::shared_ptr<MethodLocals> newLocals(new MethodLocals());
+        IfFailRet(Interop::GetLocalVariables(pSymbolReaderHandle, methodToken, newLocals->locals));
+        std::stable_sort(newLocals->locals.begin(), newLocals->locals.end(), [](const MethodLocals::local_t &a, const MethodLocals::local_t &b)
+        {
+            return a.index < b.index;
+        });
+
+        // Note, only state machine methods have hoisted local scopes, fail is not an error here.
+        PVOID data = nullptr;
+        int32_t hoistedLocalScopesCount = 0;
+        if (SUCCEEDED(Interop::GetHoistedLocalScopes(pSymbolReaderHandle, methodToken, &data, hoistedLocalScopesCount)) && data)
+        {
+            const MethodLocals::hoisted_local_scope_t *scopes = static_cast<const MethodLocals::hoisted_local_scope_t*>(data);
+            newLocals->hoistedLocalScopes.assign(scopes, scopes + hoistedLocalScopesCount);
+            Interop::CoTaskMemFree(data);
+        }
+
+        methodLocals = newLocals;
+        mdInfo.m_localsCache->m_methods.emplace(key, std::move(newLocals));
+        return S_OK;
     });
 }
 
-HRESULT Modules::GetModuleWithName(const std::string &name, ICorDebugModule **ppModule, bool onlyWithPDB)
+HRESULT Modules::GetModuleWithName(const std::string &name, ICorDebugModule **ppModule, bool onlyWithPDB, bool isFullPath)
 {
-    std::lock_guard<std::mutex> lock(m_modulesInfoMutex);
+    std::lock_guard<Utility::RWLock::Reader> lock(m_modulesInfoMutex.reader);
 
-    for (auto &info_pair : m_modulesInfo)
+    auto range = m_modulesNames.equal_range(isFullPath ? GetFileName(name) : name);
+    for (auto it = range.first; it != range.second; ++it)
     {
-        ModuleInfo &mdInfo = info_pair.second;
+        auto find = m_modulesInfo.find(it->second);
+        if (find == m_modulesInfo.end())
+            continue;
 
-        std::string path = GetModuleFileName(mdInfo.m_iCorModule);
+        ModuleInfo &mdInfo = find->second;
 
-        if (onlyWithPDB && mdInfo.m_symbolReaderHandles.empty())
+        if ((isFullPath && mdInfo.m_path != name) ||
+            (onlyWithPDB && mdInfo.m_symbolReaderHandles.empty()))
             continue;
 
-        if (GetFileName(path) == name)
-        {
-            mdInfo.m_iCorModule->AddRef();
-            *ppModule = mdInfo.m_iCorModule;
-            return S_OK;
-        }
+        mdInfo.m_iCorModule->AddRef();
+        *ppModule = mdInfo.m_iCorModule;
+        return S_OK;
     }
     return E_FAIL;
 }
 
+HRESULT Modules::GetStateMachineMethod(
+    ICorDebugModule *pModule,
+    mdMethodDef kickoffMethodToken,
+    mdMethodDef &moveNextMethodToken)
+{
+    HRESULT Status;
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+
+    return GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
+    {
+        PVOID pSymbolReaderHandle = mdInfo.GetSymbolReaderHandle(1);
+        if (pSymbolReaderHandle == nullptr)
+            return E_FAIL;
+
+        return Interop::GetStateMachineMethod(pSymbolReaderHandle, kickoffMethodToken, moveNextMethodToken);
+    });
+}
+
 HRESULT Modules::GetNextUserCodeILOffsetInMethod(
     ICorDebugModule *pModule,
     mdMethodDef methodToken,
@@ -655,33 +1503,97 @@ HRESULT Modules::GetNextUserCodeILOffsetInMethod(
     CORDB_ADDRESS modAddress;
     IfFailRet(pModule->GetBaseAddress(&modAddress));
 
+    // Note, methods without user code (compiler generated, all sequence points hidden) are common during step-in over
+    // framework-heavy call chains, don't request sequence points for them again (they could be already evicted from cache).
+    bool haveUserCode = true;
+    if (m_userCodeCache.Get(modAddress, methodToken, methodVersion, UserCodeCache::Property::HaveUserCode, haveUserCode) && !haveUserCode)
+    {
+        if (noUserCodeFound)
+            *noUserCodeFound = true;
+        return E_FAIL;
+    }
+
     return GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
     {
-        if (mdInfo.m_symbolReaderHandles.empty() || mdInfo.m_symbolReaderHandles.size() < methodVersion)
-            return E_FAIL;
+        SequencePointsCache::entry_t methodSequencePoints;
+        IfFailRet(GetMethodSequencePoints(mdInfo, modAddress, methodToken, methodVersion, methodSequencePoints));
+
+        haveUserCode = std::any_of(methodSequencePoints->points.begin(), methodSequencePoints->points.end(),
+                                   [](const method_sequence_points_t::point_t &point) { return point.IsUserCode(); });
+        m_userCodeCache.Set(modAddress, methodToken, methodVersion, UserCodeCache::Property::HaveUserCode, haveUserCode);
 
-        return Interop::GetNextUserCodeILOffset(mdInfo.m_symbolReaderHandles[methodVersion - 1], methodToken, ilOffset, ilNextOffset, noUserCodeFound);
+        return methodSequencePoints->GetNextUserCodeILOffset(ilOffset, ilNextOffset, noUserCodeFound) ? S_OK : E_FAIL;
     });
 }
 
+// Caller must care about m_modulesInfoMutex.
+HRESULT Modules::GetMethodSequencePoints(
+    ModuleInfo &mdInfo,
+    CORDB_ADDRESS modAddress,
+    mdMethodDef methodToken,
+    ULONG32 methodVersion,
+    SequencePointsCache::entry_t &methodSequencePoints)
+{
+    if (mdInfo.m_symbolReaderHandles.empty() || mdInfo.m_symbolReaderHandles.size() < methodVersion)
+        return E_FAIL;
+
+    // Note, module with frames must keep symbols loaded, even if all sequence points requests are served by cache.
+    mdInfo.MarkSymbolsUsed();
+    methodSequencePoints = m_sequencePointsCache.Get(modAddress, methodToken, methodVersion);
+    if (methodSequencePoints)
+        return S_OK;
+
+    PVOID pSymbolReaderHandle = mdInfo.GetSymbolReaderHandle(methodVersion);
+    if (pSymbolReaderHandle == nullptr)
+        return E_FAIL;
+
+    HRESULT Status;
+    Interop::SequencePoints symSequencePoints;
+    IfFailRet(Interop::GetSequencePoints(pSymbolReaderHandle, methodToken, true, symSequencePoints));
+
+    auto data = std::make_shared<method_sequence_points_t>();
+    data->documents.reserve(symSequencePoints.GetDocumentsCount());
+    for (int32_t i = 0; i < symSequencePoints.GetDocumentsCount(); i++)
+    {
+        data->documents.emplace_back(StringInterner::SourcePaths().Intern(to_utf8(symSequencePoints.GetDocument(i))));
+    }
+    data->points.reserve(symSequencePoints.GetCount());
+    for (int32_t i = 0; i < symSequencePoints.GetCount(); i++)
+    {
+        const Interop::SequencePoints::Row &row = symSequencePoints[i];
+        data->points.emplace_back(method_sequence_points_t::point_t{row.startLine, row.startColumn, row.endLine, row.endColumn,
+                                                                    (uint32_t)row.offset, row.documentIndex});
+    }
+
+    methodSequencePoints = data;
+    m_sequencePointsCache.Put(modAddress, methodToken, methodVersion, methodSequencePoints);
+    return S_OK;
+}
+
+// Caller must care about m_modulesInfoMutex.
 HRESULT Modules::GetSequencePointByILOffset(
-    PVOID pSymbolReaderHandle,
+    ModuleInfo &mdInfo,
+    CORDB_ADDRESS modAddress,
     mdMethodDef methodToken,
+    ULONG32 methodVersion,
     ULONG32 ilOffset,
-    SequencePoint *sequencePoint)
+    Modules::SequencePoint &sequencePoint)
 {
-    Interop::SequencePoint symSequencePoint;
+    HRESULT Status;
+    SequencePointsCache::entry_t methodSequencePoints;
+    IfFailRet(GetMethodSequencePoints(mdInfo, modAddress, methodToken, methodVersion, methodSequencePoints));
 
-    if (FAILED(Interop::GetSequencePointByILOffset(pSymbolReaderHandle, methodToken, ilOffset, &symSequencePoint))) {
+    method_sequence_points_t::point_t point;
+    if (!methodSequencePoints->GetSequencePointByILOffset(ilOffset, point) ||
+        point.documentIndex < 0 || (size_t)point.documentIndex >= methodSequencePoints->documents.size())
         return E_FAIL;
-    }
 
-    sequencePoint->document = to_utf8(symSequencePoint.document);
-    sequencePoint->startLine = symSequencePoint.startLine;
-    sequencePoint->startColumn = symSequencePoint.startColumn;
-    sequencePoint->endLine = symSequencePoint.endLine;
-    sequencePoint->endColumn = symSequencePoint.endColumn;
-    sequencePoint->offset = symSequencePoint.offset;
+    sequencePoint.document = *methodSequencePoints->documents[point.documentIndex];
+    sequencePoint.startLine = point.startLine;
+    sequencePoint.startColumn = point.startColumn;
+    sequencePoint.endLine = point.EndLine();
+    sequencePoint.endColumn = point.endColumn;
+    sequencePoint.offset = point.offset;
 
     return S_OK;
 }
@@ -695,17 +1607,14 @@ HRESULT Modules::GetSequencePointByILOffset(
 {
     return GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
     {
-        if (mdInfo.m_symbolReaderHandles.empty() || mdInfo.m_symbolReaderHandles.size() < methodVersion)
-            return E_FAIL;
-
-        return GetSequencePointByILOffset(mdInfo.m_symbolReaderHandles[methodVersion - 1], methodToken, ilOffset, &sequencePoint);
+        return GetSequencePointByILOffset(mdInfo, modAddress, methodToken, methodVersion, ilOffset, sequencePoint);
     });
 }
 
 HRESULT Modules::ForEachModule(std::function<HRESULT(ICorDebugModule *pModule)> cb)
 {
     HRESULT Status;
-    std::lock_guard<std::mutex> lock(m_modulesInfoMutex);
+    std::lock_guard<Utility::RWLock::Reader> lock(m_modulesInfoMutex.reader);
 
     for (auto &info_pair : m_modulesInfo)
     {
@@ -724,14 +1633,261 @@ HRESULT Modules::ResolveBreakpoint(/*in*/ CORDB_ADDRESS modAddress, /*in*/ std::
 #endif
 
     // Note, in all code we use m_modulesInfoMutex > m_sourcesInfoMutex lock sequence.
-    std::lock_guard<std::mutex> lockModulesInfo(m_modulesInfoMutex);
+    std::lock_guard<Utility::RWLock::Reader> lockModulesInfo(m_modulesInfoMutex.reader);
     return m_modulesSources.ResolveBreakpoint(this, modAddress, filename, fullname_index, sourceLine, resolvedPoints);
 }
 
-HRESULT Modules::ApplyPdbDeltaAndLineUpdates(ICorDebugModule *pModule, bool needJMC, const std::string &deltaPDB,
-                                             const std::string &lineUpdates, std::unordered_set<mdMethodDef> &methodTokens)
+HRESULT Modules::ResolveBreakpoints(/*in*/ std::vector<ModulesSources::resolve_bp_request_t> requests,
+                                    /*out*/ std::vector<ModulesSources::resolve_bp_result_t> &results)
+{
+#ifdef WIN32
+    HRESULT Status;
+    for (auto &request : requests)
+    {
+        IfFailRet(Interop::StringToUpper(request.filename));
+    }
+#endif
+
+    // Note, in all code we use m_modulesInfoMutex > m_sourcesInfoMutex lock sequence.
+    std::lock_guard<Utility::RWLock::Reader> lockModulesInfo(m_modulesInfoMutex.reader);
+    return m_modulesSources.ResolveBreakpoints(this, requests, results);
+}
+
+HRESULT Modules::LoadPdbDeltaAndLineUpdates(const std::string &deltaPDB, const std::string &lineUpdates, pdb_delta_t &delta)
+{
+    return m_modulesSources.LoadPdbDeltaAndLineUpdates(deltaPDB, lineUpdates, delta);
+}
+
+HRESULT Modules::ApplyPdbDeltaAndLineUpdates(ICorDebugModule *pModule, bool needJMC, pdb_delta_t &delta,
+                                             std::unordered_set<unsigned> &updatedSources)
+{
+    HRESULT Status;
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+    // Note, new methods versions have new symbol reader handle, but delta could also provide line updates for old versions.
+    m_sequencePointsCache.InvalidateModule(modAddress);
+    // Note, methods with new versions will be JIT'ed at new addresses, but also drop old versions code from cache.
+    m_nativeCodeCache.InvalidateModule(modAddress);
+    // Note, delta could change methods attributes, sequence points and JMC statuses.
+    m_userCodeCache.InvalidateModule(modAddress);
+    // Note, delta could add new types and methods.
+    MetadataIndex::InvalidateModule(modAddress);
+
+    // Note, delta apply change module's data (symbol reader handles and line updates), exclusive access required.
+    std::lock_guard<Utility::RWLock::Writer> lock(m_modulesInfoMutex.writer);
+    {
+        // Note, delta could add new methods.
+        std::lock_guard<std::mutex> lockIndexes(m_functionsIndexesMutex);
+        m_functionsIndexes.erase(modAddress);
+    }
+    return m_modulesSources.ApplyPdbDeltaAndLineUpdates(this, pModule, needJMC, delta, updatedSources);
+}
+
+HRESULT Modules::GetOutdatedDeltaSymbolReaders(ICorDebugModule *pModule, std::vector<ULONG32> &outdatedVersions)
+{
+    HRESULT Status;
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+
+    return GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
+    {
+        // Note, symbol reader index is method version - 1.
+        for (size_t i = 1; i + 1 < mdInfo.m_symbolReaderHandles.size() && i < mdInfo.m_symbolReaderMethods.size(); i++)
+        {
+            if (mdInfo.m_symbolReaderHandles[i] == nullptr)
+                continue;
+
+            const ULONG32 version = (ULONG32)(i + 1);
+            bool outdated = true;
+            for (const auto &methodToken : mdInfo.m_symbolReaderMethods[i])
+            {
+                ToRelease<ICorDebugFunction> iCorFunction;
+                ULONG32 currentVersion;
+                if (FAILED(pModule->GetFunctionFromToken(methodToken, &iCorFunction)) ||
+                    FAILED(iCorFunction->GetCurrentVersionNumber(&currentVersion)) ||
+                    currentVersion <= version)
+                {
+                    outdated = false;
+                    break;
+                }
+            }
+
+            if (outdated)
+                outdatedVersions.emplace_back(version);
+        }
+
+        return S_OK;
+    });
+}
+
+HRESULT Modules::DisposeDeltaSymbolReaders(ICorDebugModule *pModule, const std::vector<ULONG32> &versions)
+{
+    HRESULT Status;
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+
+    // Note, symbol reader handles changed, exclusive access required.
+    std::lock_guard<Utility::RWLock::Writer> lock(m_modulesInfoMutex.writer);
+    ModuleInfo *pmdInfo;
+    IfFailRet(GetModuleInfo(modAddress, &pmdInfo));
+
+    for (auto version : versions)
+    {
+        // Note, keep vector's indexes, since they correspond to method version.
+        const size_t index = version - 1;
+        if (version < 2 || index + 1 >= pmdInfo->m_symbolReaderHandles.size() || pmdInfo->m_symbolReaderHandles[index] == nullptr)
+            continue;
+
+        Interop::DisposeSymbols(pmdInfo->m_symbolReaderHandles[index]);
+        pmdInfo->m_symbolReaderHandles[index] = nullptr;
+
+        std::lock_guard<std::mutex> lockLocals(pmdInfo->m_localsCache->m_mutex);
+        auto &methods = pmdInfo->m_localsCache->m_methods;
+        for (auto it = methods.begin(); it != methods.end();)
+        {
+            if ((it->first >> 32) == version)
+                it = methods.erase(it);
+            else
+                ++it;
+        }
+        if (index < pmdInfo->m_symbolReaderMethods.size())
+            std::vector<mdMethodDef>().swap(pmdInfo->m_symbolReaderMethods[index]);
+    }
+
+    return S_OK;
+}
+
+// Caller must care about m_modulesInfoMutex.
+static uint64_t GetSymbolReadersSize(ModuleInfo &mdInfo)
+{
+    uint64_t size = 0;
+    for (size_t i = 0; i < mdInfo.m_symbolReaderHandles.size(); i++)
+    {
+        uint64_t readerSize = 0;
+        if (i > 0)
+        {
+            if (mdInfo.m_symbolReaderHandles[i] != nullptr && SUCCEEDED(Interop::GetSymbolReaderMemorySize(mdInfo.m_symbolReaderHandles[i], readerSize)))
+                size += readerSize;
+            continue;
+        }
+
+        // Note, module's PDB symbol reader size is calculated once, since it is used for each unload check.
+        std::lock_guard<std::mutex> lock(mdInfo.m_symbolsState->m_mutex);
+        if (mdInfo.m_symbolReaderHandles[0] == nullptr)
+            continue;
+        if (mdInfo.m_symbolsState->m_readerSize == 0 && SUCCEEDED(Interop::GetSymbolReaderMemorySize(mdInfo.m_symbolReaderHandles[0], readerSize)))
+            mdInfo.m_symbolsState->m_readerSize = readerSize;
+        size += mdInfo.m_symbolsState->m_readerSize;
+    }
+    return size;
+}
+
+// Caller must care about m_modulesInfoMutex (writer lock).
+static void UnloadSymbolReader(ModuleInfo &mdInfo, uint64_t &totalSize)
+{
+    totalSize -= std::min(totalSize, mdInfo.m_symbolsState->m_readerSize);
+    Interop::DisposeSymbols(mdInfo.m_symbolReaderHandles[0]);
+    mdInfo.m_symbolReaderHandles[0] = nullptr;
+    mdInfo.m_symbolsState->m_unloaded = true;
+    symbolsUnloadedCounter.Add();
+}
+
+void Modules::UnloadUnusedSymbols(const std::unordered_set<CORDB_ADDRESS> &usedModules)
+{
+    const uint64_t limit = m_symbolsMemoryLimit;
+    const uint64_t idleTimeout = m_symbolsIdleTimeout;
+    if (limit == 0 && idleTimeout == 0)
+        return;
+
+    // Note, symbol reader handles changed, exclusive access required.
+    std::lock_guard<Utility::RWLock::Writer> lock(m_modulesInfoMutex.writer);
+    const uint64_t epoch = symbolsUseEpoch.fetch_add(1, std::memory_order_relaxed);
+    const uint64_t now = GetSymbolsUseTime();
+
+    uint64_t totalSize = 0;
+    unsigned idleUnloaded = 0;
+    // Candidates with last use epoch.
+    std::vector<std::pair<uint64_t, ModuleInfo*>> candidates;
+    for (auto &info_pair : m_modulesInfo)
+    {
+        ModuleInfo &mdInfo = info_pair.second;
+        totalSize += GetSymbolReadersSize(mdInfo);
+
+        if (mdInfo.m_symbolReaderHandles.size() != 1 || mdInfo.m_symbolReaderHandles[0] == nullptr ||
+            usedModules.find(info_pair.first) != usedModules.end())
+            continue;
+
+        const uint64_t lastUseTime = mdInfo.m_symbolsState->m_lastUseTime.load(std::memory_order_relaxed);
+        if (idleTimeout != 0 && now >= lastUseTime + idleTimeout)
+        {
+            UnloadSymbolReader(mdInfo, totalSize);
+            idleUnloaded++;
+            continue;
+        }
+
+        const uint64_t lastUse = mdInfo.m_symbolsState->m_lastUse.load(std::memory_order_relaxed);
+        if (lastUse >= epoch)
+            continue;
+
+        candidates.emplace_back(lastUse, &mdInfo);
+    }
+
+    if (idleUnloaded != 0)
+        LOGI("Unloaded %u idle modules symbols, symbol readers use %llu bytes", idleUnloaded, (unsigned long long)totalSize);
+
+    if (limit == 0 || totalSize <= limit)
+        return;
+
+    std::sort(candidates.begin(), candidates.end(), [](const std::pair<uint64_t, ModuleInfo*> &a, const std::pair<uint64_t, ModuleInfo*> &b)
+    {
+        return a.first < b.first;
+    });
+
+    for (auto &candidate : candidates)
+    {
+        if (totalSize <= limit)
+            break;
+
+        UnloadSymbolReader(*candidate.second, totalSize);
+    }
+
+    LOGI("Symbols memory limit %llu bytes, symbol readers use %llu bytes after unload", (unsigned long long)limit, (unsigned long long)totalSize);
+}
+
+void Modules::GetMemoryUsage(MemoryUsage &usage)
 {
-    return m_modulesSources.ApplyPdbDeltaAndLineUpdates(this, pModule, needJMC, deltaPDB, lineUpdates, methodTokens);
+    usage.symbolsLimit = m_symbolsMemoryLimit;
+    {
+        std::lock_guard<Utility::RWLock::Reader> lock(m_modulesInfoMutex.reader);
+        for (auto &info_pair : m_modulesInfo)
+        {
+            ModuleInfo &mdInfo = info_pair.second;
+            usage.symbolReaders += GetSymbolReadersSize(mdInfo);
+            for (size_t i = 1; i < mdInfo.m_symbolReaderHandles.size(); i++)
+            {
+                if (mdInfo.m_symbolReaderHandles[i] != nullptr)
+                    usage.loadedReaders++;
+            }
+            if (!mdInfo.m_symbolReaderHandles.empty())
+            {
+                std::lock_guard<std::mutex> lockState(mdInfo.m_symbolsState->m_mutex);
+                if (mdInfo.m_symbolsState->m_unloaded)
+                    usage.unloadedReaders++;
+                else if (mdInfo.m_symbolReaderHandles[0] != nullptr)
+                    usage.loadedReaders++;
+            }
+
+            usage.lineUpdates += MemorySize::HashNodes(mdInfo.m_methodBlockUpdates);
+            for (const auto &entry : mdInfo.m_methodBlockUpdates)
+            {
+                usage.lineUpdates += entry.second.GetMemoryUsage();
+            }
+        }
+    }
+
+    usage.sequencePoints = m_sequencePointsCache.GetMemoryUsage();
+    // Note, m_modulesSources have its own mutex, don't hold m_modulesInfoMutex here.
+    usage.modulesSources = m_modulesSources.GetMemoryUsage();
 }
 
 HRESULT Modules::GetSourceFullPathByIndex(unsigned index, std::string &fullPath)
@@ -744,43 +1900,125 @@ HRESULT Modules::GetIndexBySourceFullPath(std::string fullPath, unsigned &index)
     return m_modulesSources.GetIndexBySourceFullPath(fullPath, index);
 }
 
+HRESULT Modules::FindModuleSources(CORDB_ADDRESS modAddress, const std::vector<std::string> &filenames, std::vector<bool> &haveSources)
+{
+    return m_modulesSources.FindModuleSources(modAddress, filenames, haveSources);
+}
+
 void Modules::FindFileNames(string_view pattern, unsigned limit, std::function<void(const char *)> cb)
 {
     m_modulesSources.FindFileNames(pattern, limit, cb);
 }
 
+unsigned Modules::GetLoadedSources(unsigned startIndex, unsigned count, std::function<void(const char *)> cb)
+{
+    return m_modulesSources.GetSources(startIndex, count, cb);
+}
+
+void Modules::TakeNewLoadedSources(std::function<void(const char *)> cb)
+{
+    m_modulesSources.TakeNewSources(cb);
+}
+
+void Modules::SearchSources(string_view pattern, unsigned limit, std::function<void(const char *)> cb)
+{
+    m_modulesSources.SearchSources(pattern, limit, cb);
+}
+
 void Modules::FindFunctions(Utility::string_view pattern, unsigned limit, std::function<void(const char *)> cb)
 {
-    auto functor = [&](const std::string& fullName, mdMethodDef &)
-    {
-        if (limit == 0)
-            return false; // limit exceeded
+    std::vector<PrefixIndex::match_t> matches;
 
-        auto pos = fullName.find(pattern);
-        if (pos != std::string::npos && (pos == 0 || fullName[pos-1] == '.'))
+    std::lock_guard<Utility::RWLock::Reader> lock(m_modulesInfoMutex.reader);
+    std::lock_guard<std::mutex> lockIndexes(m_functionsIndexesMutex);
+    for (const auto& modpair : m_modulesInfo)
+    {
+        std::unique_ptr<PrefixIndex> &index = m_functionsIndexes[modpair.first];
+        if (!index)
         {
-            limit--;
-            cb(fullName.c_str());
+            index.reset(new PrefixIndex("."));
+            // Note, overloaded methods have same full name.
+            std::unordered_set<std::string> names;
+            HRESULT Status = ForEachMethod(modpair.second.m_iCorModule, [&](const std::string& fullName, mdMethodDef &)
+            {
+                if (names.insert(fullName).second)
+                    index->Add(fullName);
+                return true;  // continue for next functions
+            });
+            if (FAILED(Status))
+                LOGE("Functions enumeration failed, %0x", Status);
         }
 
-        return true;  // continue for next functions
-    }; 
+        index->Find(pattern, limit, matches);
+    }
 
-    std::lock_guard<std::mutex> lock(m_modulesInfoMutex);
-    for (const auto& modpair : m_modulesInfo)
+    // Note, each module provide up to `limit` ranked matches, rank all together.
+    std::sort(matches.begin(), matches.end(), PrefixIndex::RankedBefore);
+    if (matches.size() > limit)
+        matches.resize(limit);
+
+    for (const auto &match : matches)
     {
-        HRESULT Status = ForEachMethod(modpair.second.m_iCorModule, functor);
-        if (FAILED(Status))
-            break;
+        cb(match.name->c_str());
     }
 }
 
-HRESULT Modules::GetSource(ICorDebugModule *pModule, const std::string &sourcePath, char** fileBuf, int* fileLen)
+HRESULT Modules::GetSource(ICorDebugModule *pModule, const std::string &sourcePath, std::shared_ptr<const char> &fileBuf, int &fileLen)
 {
     HRESULT Status;
     CORDB_ADDRESS modAddress;
     IfFailRet(pModule->GetBaseAddress(&modAddress));
 
+    IfFailRet(GetEmbeddedSource(modAddress, sourcePath, fileBuf, fileLen));
+    if (fileLen != 0 || !m_sourceLinkEnabled)
+        return S_OK;
+
+    std::string url;
+    std::string contentKey;
+    if (FAILED(GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
+        {
+            PVOID pSymbolReaderHandle = mdInfo.GetSymbolReaderHandle(1);
+            if (pSymbolReaderHandle == nullptr)
+                return E_FAIL;
+
+            return Interop::GetSourceLinkInfo(pSymbolReaderHandle, sourcePath, url, contentKey);
+        })))
+        return S_OK; // no SourceLink for this document, same as no embedded source
+
+    // Note, download (in case file was not prefetched) is done without m_modulesInfoMutex lock.
+    std::string filePath;
+    if (!m_sourceLinkCache.Get(url, contentKey, GetFileName(sourcePath), filePath))
+        return S_OK;
+
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    std::streamoff size = file.tellg();
+    if (!file.good() || size <= 0 || size > std::numeric_limits<int>::max())
+        return S_OK;
+
+    char *data = new char[(size_t)size];
+    file.seekg(0);
+    if (!file.read(data, size))
+    {
+        delete[] data;
+        return S_OK;
+    }
+
+    std::shared_ptr<const char> buffer(data, [](const char *ptr) { delete[] ptr; });
+    return GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
+    {
+        // Note, replace cached "no embedded source" entry, so, downloaded source is read from disk once.
+        std::lock_guard<std::mutex> lock(mdInfo.m_embeddedSources->m_mutex);
+        auto &source = mdInfo.m_embeddedSources->m_sources[sourcePath];
+        source = std::make_pair(std::move(buffer), (int)size);
+        fileBuf = source.first;
+        fileLen = source.second;
+        return S_OK;
+    });
+}
+
+HRESULT Modules::GetEmbeddedSource(CORDB_ADDRESS modAddress, const std::string &sourcePath, std::shared_ptr<const char> &fileBuf, int &fileLen)
+{
+    HRESULT Status;
     return GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
     {
         if (mdInfo.m_symbolReaderHandles.size() > 1)
@@ -789,15 +2027,39 @@ HRESULT Modules::GetSource(ICorDebugModule *pModule, const std::string &sourcePa
             return E_FAIL;
         }
 
-        return mdInfo.m_symbolReaderHandles.empty() ?
-            E_FAIL :
-            Interop::GetSource(mdInfo.m_symbolReaderHandles[0], sourcePath, (PVOID*)fileBuf, fileLen);
+        if (mdInfo.m_symbolReaderHandles.empty())
+            return E_FAIL;
+
+        // Note, embedded source decompression is costly, do this only once for each document and share same buffer for all requests.
+        std::lock_guard<std::mutex> lock(mdInfo.m_embeddedSources->m_mutex);
+        auto find = mdInfo.m_embeddedSources->m_sources.find(sourcePath);
+        if (find == mdInfo.m_embeddedSources->m_sources.end())
+        {
+            PVOID data = nullptr;
+            int32_t length = 0;
+            PVOID pSymbolReaderHandle = mdInfo.GetSymbolReaderHandle(1);
+            if (pSymbolReaderHandle == nullptr)
+                return E_FAIL;
+            IfFailRet(Interop::GetSource(pSymbolReaderHandle, sourcePath, &data, &length));
+
+            // Note, document without embedded source is cached too (with zero length).
+            std::shared_ptr<const char> buffer(static_cast<const char*>(data), [](const char *ptr)
+            {
+                if (ptr != nullptr)
+                    Interop::CoTaskMemFree(const_cast<char*>(ptr));
+            });
+            find = mdInfo.m_embeddedSources->m_sources.emplace(sourcePath, std::make_pair(std::move(buffer), (int)length)).first;
+        }
+
+        fileBuf = find->second.first;
+        fileLen = find->second.second;
+        return S_OK;
     });
 }
 
 void Modules::CopyModulesUpdateHandlerTypes(std::vector<ToRelease<ICorDebugType>> &modulesUpdateHandlerTypes)
 {
-    std::lock_guard<std::mutex> lock(m_modulesInfoMutex);
+    std::lock_guard<Utility::RWLock::Reader> lock(m_modulesInfoMutex.reader);
     m_modulesAppUpdate.CopyModulesUpdateHandlerTypes(modulesUpdateHandlerTypes);
 }
 
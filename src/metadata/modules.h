@@ -7,13 +7,24 @@
 #include "cor.h"
 #include "cordebug.h"
 
+#include <atomic>
 #include <functional>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
 #include <memory>
 #include "interfaces/types.h"
 #include "metadata/modules_app_update.h"
+#include "metadata/module_snapshot_cache.h"
 #include "metadata/modules_sources.h"
+#include "metadata/native_code_cache.h"
+#include "metadata/prefix_index.h"
+#include "metadata/sequence_points_cache.h"
+#include "metadata/sourcelink_cache.h"
+#include "metadata/symbols_downloader.h"
+#include "metadata/symbols_preloader.h"
+#include "metadata/user_code_cache.h"
+#include "utils/rwlock.h"
 #include "utils/string_view.h"
 #include "utils/torelease.h"
 #include "utils/utf.h"
@@ -25,15 +36,99 @@ HRESULT GetModuleId(ICorDebugModule *pModule, std::string &id);
 std::string GetModuleFileName(ICorDebugModule *pModule);
 HRESULT IsModuleHaveSameName(ICorDebugModule *pModule, const std::string &Name, bool isFullPath);
 
+// Method's local variables names and scopes (and state machine hoisted locals scopes) from PDB, fetched once for
+// method version, so, locals listing don't call symbol reader for each local index.
+struct MethodLocals
+{
+    struct local_t
+    {
+        ULONG32 index;
+        ULONG32 ilStart;
+        ULONG32 ilEnd;
+        WSTRING name;
+    };
+    struct hoisted_local_scope_t
+    {
+        uint32_t startOffset;
+        uint32_t length;
+    };
+
+    // Note, same local index could be provided for different scopes (slot reuse), sorted by index.
+    std::vector<local_t> locals;
+    // Indexed by hoisted local slot index.
+    std::vector<hoisted_local_scope_t> hoistedLocalScopes;
+
+    // Return local name in scope of IL offset or nullptr.
+    const WSTRING *FindLocal(ULONG32 localIndex, ULONG32 ilOffset) const;
+};
+
 struct ModuleInfo
 {
     std::vector<PVOID> m_symbolReaderHandles;
     ToRelease<ICorDebugModule> m_iCorModule;
     // Cache for LineUpdates data for all methods in this module (Hot Reload related).
     method_block_updates_t m_methodBlockUpdates;
+    // Methods, that have new version in delta PDB (same indexes as m_symbolReaderHandles), in order to find out outdated delta symbol readers.
+    // Note, data cleared for disposed symbol readers.
+    std::vector<std::vector<mdMethodDef>> m_symbolReaderMethods;
+    // Types and methods with "not user code" attributes, cached for JMC toggling during debug session (see Modules::SetJustMyCode()).
+    // Note, module's JMC status is enabled at load for all modules with symbols, so, JMC enabled/disabled by user differ
+    // only by JMC statuses of these tokens.
+    std::vector<mdToken> m_nonJMCTokens;
+    bool m_nonJMCTokensCached = false; // m_nonJMCTokens calculated (or reset after Hot Reload update)
+    bool m_canSetJMC = false;          // module's JMC status enabled at load
+    bool m_nonJMCApplied = false;      // runtime have JMC statuses disabled for m_nonJMCTokens
+    bool m_nonJMCNeeded = false;       // JMC statuses must be disabled for m_nonJMCTokens, deferred in case differ from m_nonJMCApplied
+    // Decompressed sources embedded into module's PDB, by document path.
+    // Note, could be requested under m_modulesInfoMutex reader lock, so, have own mutex.
+    struct EmbeddedSources
+    {
+        std::mutex m_mutex;
+        std::unordered_map<std::string, std::pair<std::shared_ptr<const char>, int>> m_sources;
+    };
+    std::unique_ptr<EmbeddedSources> m_embeddedSources;
+    // Symbols memory limit related, module's PDB symbol reader could be unloaded for not used module and loaded again on demand.
+    // Note, symbol reader could be loaded again under m_modulesInfoMutex reader lock, so, have own mutex.
+    struct SymbolsState
+    {
+        std::mutex m_mutex;
+        bool m_unloaded = false;
+        uint64_t m_readerSize = 0; // module's PDB symbol reader size, 0 - not calculated yet
+        std::atomic<uint64_t> m_lastUse{0}; // symbols use epoch of last access
+        std::atomic<uint64_t> m_lastUseTime{0}; // seconds (steady clock) of last access
+    };
+    std::unique_ptr<SymbolsState> m_symbolsState;
+    // Methods locals by method version and token.
+    // Note, could be requested under m_modulesInfoMutex reader lock, so, have own mutex.
+    struct LocalsCache
+    {
+        std::mutex m_mutex;
+        std::unordered_map<uint64_t, std::shared_ptr<const MethodLocals>> m_methods;
+    };
+    std::unique_ptr<LocalsCache> m_localsCache;
+    // Module's data for next debug session (see ModuleSnapshotCache), stored at debug session end.
+    // Note, async methods info could be requested under m_modulesInfoMutex reader lock, so, have own mutex.
+    struct SnapshotState
+    {
+        std::mutex m_mutex;
+        std::string m_key;      // empty in case module can't be cached
+        bool m_changed = false; // data was calculated after snapshot load, snapshot should be stored again
+        bool m_haveIndex = false; // loaded snapshot have metadata index
+        // Async methods stepping info for module's PDB (method version 1), by method token.
+        std::unordered_map<mdMethodDef, module_snapshot_t::async_method_t> m_asyncMethods;
+    };
+    std::unique_ptr<SnapshotState> m_snapshotState;
+    // Module properties, that are requested often (modules lookup by name, stack frames), stored at module load.
+    std::string m_id;   // MVID
+    std::string m_path; // full path
+    std::string m_name; // file name
 
     ModuleInfo(PVOID Handle, ICorDebugModule *Module) :
-        m_iCorModule(Module)
+        m_iCorModule(Module),
+        m_embeddedSources(new EmbeddedSources()),
+        m_symbolsState(new SymbolsState()),
+        m_localsCache(new LocalsCache()),
+        m_snapshotState(new SnapshotState())
     {
         if (Handle == nullptr)
             return;
@@ -44,26 +139,48 @@ struct ModuleInfo
 
     ModuleInfo(ModuleInfo&& other) noexcept :
         m_symbolReaderHandles(std::move(other.m_symbolReaderHandles)),
-        m_iCorModule(std::move(other.m_iCorModule))
+        m_iCorModule(std::move(other.m_iCorModule)),
+        m_symbolReaderMethods(std::move(other.m_symbolReaderMethods)),
+        m_nonJMCTokens(std::move(other.m_nonJMCTokens)),
+        m_nonJMCTokensCached(other.m_nonJMCTokensCached),
+        m_canSetJMC(other.m_canSetJMC),
+        m_nonJMCApplied(other.m_nonJMCApplied),
+        m_nonJMCNeeded(other.m_nonJMCNeeded),
+        m_embeddedSources(std::move(other.m_embeddedSources)),
+        m_symbolsState(std::move(other.m_symbolsState)),
+        m_localsCache(std::move(other.m_localsCache)),
+        m_snapshotState(std::move(other.m_snapshotState)),
+        m_id(std::move(other.m_id)),
+        m_path(std::move(other.m_path)),
+        m_name(std::move(other.m_name))
     {
     }
     ModuleInfo(const ModuleInfo&) = delete;
     ModuleInfo& operator=(ModuleInfo&&) = delete;
     ModuleInfo& operator=(const ModuleInfo&) = delete;
     ~ModuleInfo() noexcept;
+
+    // Return symbol reader for method version (1 - module's PDB, 2+ - Hot Reload deltas) or nullptr, module's PDB unloaded
+    // by memory limit is loaded again. Caller must care about m_modulesInfoMutex (reader lock is enough).
+    PVOID GetSymbolReaderHandle(ULONG32 methodVersion);
+    // Protect module's symbols from unload by memory limit till next unload check and restart idle timeout.
+    void MarkSymbolsUsed();
 };
 
 class Modules
 {
 public:
 
+    Modules();
+
     struct SequencePoint {
         int32_t startLine;
         int32_t startColumn;
         int32_t endLine;
         int32_t endColumn;
         int32_t offset;
-        std::string document;
+        // Note, interned in StringInterner::SourcePaths() full path, no string copy for each sequence point.
+        Utility::string_view document;
     };
 
     HRESULT ResolveBreakpoint(
@@ -73,12 +190,32 @@ public:
         /*in*/ int sourceLine,
         /*out*/ std::vector<ModulesSources::resolved_bp_t> &resolvedPoints);
 
+    HRESULT ResolveBreakpoints(
+        /*in*/ std::vector<ModulesSources::resolve_bp_request_t> requests,
+        /*out*/ std::vector<ModulesSources::resolve_bp_result_t> &results);
+
     HRESULT GetSourceFullPathByIndex(unsigned index, std::string &fullPath);
     HRESULT GetIndexBySourceFullPath(std::string fullPath, unsigned &index);
-    HRESULT ApplyPdbDeltaAndLineUpdates(ICorDebugModule *pModule, bool needJMC, const std::string &deltaPDB,
-                                        const std::string &lineUpdates, std::unordered_set<mdMethodDef> &methodTokens);
-
-    HRESULT GetModuleWithName(const std::string &name, ICorDebugModule **ppModule, bool onlyWithPDB = false);
+    HRESULT FindModuleSources(CORDB_ADDRESS modAddress, const std::vector<std::string> &filenames, std::vector<bool> &haveSources);
+    // Note, don't need module data access, so, could be called in parallel with module's metadata/IL delta apply.
+    HRESULT LoadPdbDeltaAndLineUpdates(const std::string &deltaPDB, const std::string &lineUpdates, pdb_delta_t &delta);
+    // Module's metadata/IL delta must be already applied, symbol reader handle ownership is moved from `delta` to module.
+    HRESULT ApplyPdbDeltaAndLineUpdates(ICorDebugModule *pModule, bool needJMC, pdb_delta_t &delta,
+                                        std::unordered_set<unsigned> &updatedSources);
+    // Find delta symbol readers, that don't provide current version for any method (all methods have newer version now).
+    // Note, module's PDB and last delta symbol readers are never outdated.
+    HRESULT GetOutdatedDeltaSymbolReaders(ICorDebugModule *pModule, std::vector<ULONG32> &outdatedVersions);
+    // Caller must care, that methods with provided versions are not executed anymore (have no frames).
+    HRESULT DisposeDeltaSymbolReaders(ICorDebugModule *pModule, const std::vector<ULONG32> &versions);
+
+    // Find module by file name or full path (same file could be loaded by different paths, first found is provided).
+    HRESULT GetModuleWithName(const std::string &name, ICorDebugModule **ppModule, bool onlyWithPDB = false, bool isFullPath = false);
+    // Same as GetModuleId(), GetModuleFileName() and IsModuleHaveSameName(), but use properties stored at module load
+    // (ICorDebug interfaces are used for unknown modules only).
+    // Note, must not be called under m_modulesInfoMutex lock (for example, from ForEachModule() callback).
+    HRESULT GetModuleIdCached(ICorDebugModule *pModule, std::string &id);
+    std::string GetModuleFileNameCached(ICorDebugModule *pModule);
+    HRESULT IsModuleHaveSameNameCached(ICorDebugModule *pModule, const std::string &name, bool isFullPath);
 
     void CopyModulesUpdateHandlerTypes(std::vector<ToRelease<ICorDebugType>> &modulesUpdateHandlerTypes);
 
@@ -97,10 +234,15 @@ public:
         ULONG32 &ilNextOffset,
         bool *noUserCodeFound);
 
+    // Stepping related classification of method's current version, `calculate` is called in case property is not cached yet.
+    // Note, cache is reset for module at unload and at Hot Reload delta apply, JMC statuses are reset at JMC statuses change.
+    bool GetUserCodeProperty(ICorDebugFunction *pFunction, UserCodeCache::Property property, const std::function<bool()> &calculate);
+
     HRESULT ResolveFuncBreakpointInAny(
         const std::string &module,
         bool &module_checked,
         const std::string &funcname,
+        const std::string &params,
         ResolveFuncBreakpointCallback cb);
 
     HRESULT ResolveFuncBreakpointInModule(
@@ -108,36 +250,71 @@ public:
         const std::string &module,
         bool &module_checked,
         std::string &funcname,
+        const std::string &params,
         ResolveFuncBreakpointCallback cb);
 
     HRESULT GetStepRangeFromCurrentIP(
         ICorDebugThread *pThread,
         COR_DEBUG_STEP_RANGE *range);
+    // Native offsets range of current instruction in thread's active frame.
+    HRESULT GetInstructionStepRangeFromCurrentIP(
+        ICorDebugThread *pThread,
+        COR_DEBUG_STEP_RANGE *range);
+
+    // Method's native code (code bytes, IL to native mapping and instructions) from cache or read from debuggee.
+    HRESULT GetNativeCode(ICorDebugCode *pCode, NativeCodeCache::entry_t &nativeCode);
+    // Find JIT'ed method's native code, that contain `address`.
+    HRESULT GetNativeCodeByAddress(ICorDebugProcess *pProcess, CORDB_ADDRESS address, NativeCodeCache::entry_t &nativeCode);
 
     HRESULT TryLoadModuleSymbols(
         ICorDebugModule *pModule,
         Module &module,
         bool needJMC,
+        bool deferJMC,
         bool needHotReload,
         std::string &outputText);
+    // Deferred JMC mode related, apply JMC statuses for all modules, that was loaded with deferred JMC or have pending
+    // JMC toggle changes. In case `priorityModules` provided, only these modules are processed, rest are kept deferred.
+    // Caller must care, that process is stopped.
+    HRESULT ApplyDeferredJMC(const std::unordered_set<CORDB_ADDRESS> *priorityModules = nullptr);
+    // JMC enabled/disabled by user during debug session, JMC statuses diffs for already loaded modules are deferred and applied
+    // by ApplyDeferredJMC() calls, `priorityModules` (modules from current stacks) are processed immediately.
+    // Caller must care, that process is stopped in case `priorityModules` not empty.
+    void SetJustMyCode(bool enable, const std::unordered_set<CORDB_ADDRESS> &priorityModules);
 
     void CleanupAllModules();
-
-    HRESULT GetFrameNamedLocalVariable(
+    // Remove unloaded module's functions from completions.
+    void ModuleUnloaded(ICorDebugModule *pModule);
+
+    // Symbol servers URLs separated by ';' and local symbols cache directory. In case servers provided, PDB for modules
+    // without symbols found at load is downloaded in background and attached to module, see SetSymbolsDownloadedCallback().
+    void SetSymbolServers(const std::string &servers, const std::string &cachePath);
+    // Callback is called from download worker thread for module with attached downloaded symbols.
+    // Note, module's JIT flags and JMC status can't be changed after module load, so, this module still "not user code".
+    void SetSymbolsDownloadedCallback(std::function<void(const Module &module)> cb);
+
+    // In case SourceLink enabled, sources missed on disk and not embedded into PDB are downloaded by SourceLink URLs into
+    // local cache, sources for `prefetchFrames` top frames are downloaded in background at stop (0 - no prefetch).
+    void SetSourceLink(bool enable, unsigned prefetchFrames);
+    unsigned GetSourceLinkPrefetchFrames() const { return m_sourceLinkEnabled ? m_sourceLinkPrefetchFrames.load() : 0; }
+    // Queue download of frame's source, in case it missed on disk and module have SourceLink for this document.
+    void PrefetchSourceLinkSource(ICorDebugFrame *pFrame);
+
+    // Start symbols loading in worker threads for all modules in app domain, that was not loaded yet.
+    // Aimed to attach case, when runtime send LoadModule callbacks for all already loaded modules.
+    void PreloadModulesSymbols(ICorDebugAppDomain *pAppDomain);
+
+    // Return cached method's locals table, filtered by IL offset by caller.
+    HRESULT GetMethodLocals(
         ICorDebugModule *pModule,
         mdMethodDef methodToken,
         ULONG32 methodVersion,
-        ULONG localIndex,
-        WSTRING &localName,
-        ULONG32 *pIlStart,
-        ULONG32 *pIlEnd);
+        std::shared_ptr<const MethodLocals> &methodLocals);
 
-    HRESULT GetHoistedLocalScopes(
+    HRESULT GetStateMachineMethod(
         ICorDebugModule *pModule,
-        mdMethodDef methodToken,
-        ULONG32 methodVersion,
-        PVOID *data,
-        int32_t &hoistedLocalScopesCount);
+        mdMethodDef kickoffMethodToken,
+        mdMethodDef &moveNextMethodToken);
 
     HRESULT GetNextUserCodeILOffsetInMethod(
         ICorDebugModule *pModule,
@@ -157,23 +334,93 @@ public:
     HRESULT ForEachModule(std::function<HRESULT(ICorDebugModule *pModule)> cb);
 
     void FindFileNames(Utility::string_view pattern, unsigned limit, std::function<void(const char *)> cb);
+    unsigned GetLoadedSources(unsigned startIndex, unsigned count, std::function<void(const char *)> cb);
+    void TakeNewLoadedSources(std::function<void(const char *)> cb);
+    void SearchSources(Utility::string_view pattern, unsigned limit, std::function<void(const char *)> cb);
     void FindFunctions(Utility::string_view pattern, unsigned limit, std::function<void(const char *)> cb);
-    HRESULT GetSource(ICorDebugModule *pModule, const std::string &sourcePath, char** fileBuf, int* fileLen);
+    HRESULT GetSource(ICorDebugModule *pModule, const std::string &sourcePath, std::shared_ptr<const char> &fileBuf, int &fileLen);
+
+    // Symbol readers soft memory limit in bytes, 0 - no limit.
+    void SetSymbolsMemoryLimit(uint64_t limit) { m_symbolsMemoryLimit = limit; }
+    uint64_t GetSymbolsMemoryLimit() const { return m_symbolsMemoryLimit; }
+    // Time in seconds without symbols access, after that module's PDB symbol reader is unloaded, 0 - never unload idle symbols.
+    void SetSymbolsIdleTimeout(uint64_t timeout) { m_symbolsIdleTimeout = timeout; }
+    uint64_t GetSymbolsIdleTimeout() const { return m_symbolsIdleTimeout; }
+    // Unload PDB symbol readers of idle modules (no symbols access during idle timeout) and, in case symbol readers memory
+    // exceed limit, least recently used modules' PDB symbol readers until memory fit limit.
+    // Modules with Hot Reload deltas, modules from `usedModules` (for example, with breakpoints) and modules, that have symbols
+    // access since previous check (stack frames, stepping, evaluation), are not unloaded.
+    // Note, sources related data (methods ranges, sequence points cache) is native and kept, only reader is loaded again on demand.
+    void UnloadUnusedSymbols(const std::unordered_set<CORDB_ADDRESS> &usedModules);
+    void GetMemoryUsage(MemoryUsage &usage);
 
 private:
 
-    std::mutex m_modulesInfoMutex;
+    // Note, m_modulesInfo changed on module load/unload and Hot Reload delta apply only (writer lock),
+    // all other requests (stack trace, variables, stepping, etc.) work with read lock and don't serialize each other.
+    Utility::RWLock m_modulesInfoMutex;
     std::unordered_map<CORDB_ADDRESS, ModuleInfo> m_modulesInfo;
+    // Modules file names index (file name -> module address), covered by m_modulesInfoMutex.
+    std::unordered_multimap<std::string, CORDB_ADDRESS> m_modulesNames;
     ModulesAppUpdate m_modulesAppUpdate;
 
     // Note, m_modulesSources have its own mutex for private data state sync.
     ModulesSources m_modulesSources;
 
+    // Note, m_symbolsPreloader have its own mutex for private data state sync.
+    SymbolsPreloader m_symbolsPreloader;
+    bool m_symbolsPreloadStarted = false;
+
+    // Note, m_symbolsDownloader have its own mutex for private data state sync.
+    SymbolsDownloader m_symbolsDownloader;
+    std::atomic<bool> m_symbolsDownloadEnabled{false};
+    std::mutex m_symbolsDownloadedMutex;
+    std::function<void(const Module &module)> m_symbolsDownloadedCallback;
+
+    HRESULT GetEmbeddedSource(CORDB_ADDRESS modAddress, const std::string &sourcePath, std::shared_ptr<const char> &fileBuf, int &fileLen);
+    // Load symbols from local symbols cache for module without symbols and publish them.
+    void AttachDownloadedSymbols(ICorDebugModule *pModule);
+
+    // Note, m_sourceLinkCache have its own mutex for private data state sync.
+    SourceLinkCache m_sourceLinkCache;
+    std::atomic<bool> m_sourceLinkEnabled{false};
+    std::atomic<unsigned> m_sourceLinkPrefetchFrames{0};
+
+    // Deferred JMC mode and JMC toggle related, some modules have not applied JMC statuses.
+    std::atomic<bool> m_haveDeferredJMC{false};
+
+    std::atomic<uint64_t> m_symbolsMemoryLimit{0};
+    std::atomic<uint64_t> m_symbolsIdleTimeout{0};
+
+    // Note, m_sequencePointsCache have its own mutex for private data state sync.
+    SequencePointsCache m_sequencePointsCache;
+    // Note, m_nativeCodeCache have its own mutex for private data state sync.
+    NativeCodeCache m_nativeCodeCache;
+    // Note, m_userCodeCache have its own mutex for private data state sync.
+    UserCodeCache m_userCodeCache;
+
+    // Note, in all code we use m_modulesInfoMutex > m_functionsIndexesMutex lock sequence.
+    std::mutex m_functionsIndexesMutex;
+    // m_functionsIndexes - functions full names for completions, module's index built at first completions request,
+    //                      since all module's methods enumeration is costly (empty index for unloaded module)
+    std::unordered_map<CORDB_ADDRESS, std::unique_ptr<PrefixIndex>> m_functionsIndexes;
+
+    // Caller must care about m_modulesInfoMutex.
+    HRESULT GetMethodSequencePoints(
+        ModuleInfo &mdInfo,
+        CORDB_ADDRESS modAddress,
+        mdMethodDef methodToken,
+        ULONG32 methodVersion,
+        SequencePointsCache::entry_t &methodSequencePoints);
+
+    // Caller must care about m_modulesInfoMutex.
     HRESULT GetSequencePointByILOffset(
-        PVOID pSymbolReaderHandle,
+        ModuleInfo &mdInfo,
+        CORDB_ADDRESS modAddress,
         mdMethodDef methodToken,
+        ULONG32 methodVersion,
         ULONG32 ilOffset,
-        SequencePoint *sequencePoint);
+        SequencePoint &sequencePoint);
 
 };
 
@@ -10,8 +10,13 @@
 
 #include "metadata/modules_sources.h"
 #include "metadata/modules.h"
+#include "metadata/fuzzy_match.h"
 #include "metadata/jmc.h"
+#include "metadata/metadata_index.h"
+#include "metadata/method_ranges_cache.h"
 #include "managed/interop.h"
+#include "utils/memory_size.h"
+#include "utils/string_interner.h"
 #include "utils/utf.h"
 
 namespace netcoredbg
@@ -66,7 +71,7 @@ namespace
 
     // Note, we use std::map since we need container that will not invalidate iterators on add new elements.
     void AddMethodData(/*in,out*/ std::map<size_t, std::set<method_data_t>> &methodData,
-                       /*in,out*/ std::unordered_map<method_data_t, std::vector<mdMethodDef>, method_data_t_hash> &multiMethodBpData,
+                       /*in,out*/ multi_methods_data_t &multiMethodBpData,
                        const method_data_t &entry,
                        const size_t nestedLevel)
     {
@@ -131,83 +136,9 @@ namespace
     }
 
 
-    bool GetMethodTokensByLineNumber(const std::vector<std::vector<method_data_t>> &methodBpData,
-                                     const std::unordered_map<method_data_t, std::vector<mdMethodDef>, method_data_t_hash> &multiMethodBpData,
-                                     /*in,out*/ int32_t &lineNum,
-                                     /*out*/ std::vector<mdMethodDef> &Tokens,
-                                     /*out*/ mdMethodDef &closestNestedToken)
-    {
-        const method_data_t *result = nullptr;
-        closestNestedToken = 0;
-
-        for (auto it = methodBpData.cbegin(); it != methodBpData.cend(); ++it)
-        {
-            auto lower = std::lower_bound((*it).cbegin(), (*it).cend(), lineNum);
-            if (lower == (*it).cend())
-                break; // point behind last method for this nested level
-
-            // case with first line of method, for example:
-            // void Method(){ 
-            //            void Method(){ void Method(){...  <- breakpoint at this line
-            if (lineNum == (*lower).startLine)
-            {
-                // At this point we can't check this case, let managed part decide (since it see Columns):
-                // void Method() {
-                // ... code ...; void Method() {     <- breakpoint at this line
-                //  };
-                if (result)
-                    closestNestedToken = (*lower).methodDef;
-                else
-                    result = &(*lower);
-
-                break;
-            }
-            else if (lineNum > (*lower).startLine && (*lower).endLine >= lineNum)
-            {
-                result = &(*lower);
-                continue; // need check nested level (if available)
-            }
-            // out of first level methods lines - forced move line to first method below, for example:
-            //  <-- breakpoint at line without code (out of any methods)
-            // void Method() {...}
-            else if (it == methodBpData.cbegin() && lineNum < (*lower).startLine)
-            {
-                lineNum = (*lower).startLine;
-                result = &(*lower);
-                break;
-            }
-            // result was found on previous cycle, check for closest nested method
-            // need it in case of breakpoint setuped at lines without code and before nested method, for example:
-            // {
-            //  <-- breakpoint at line without code (inside method)
-            //     void Method() {...}
-            // }
-            else if (result && lineNum <= (*lower).startLine && (*lower).endLine <= result->endLine)
-            {
-                closestNestedToken = (*lower).methodDef;
-                break;
-            }
-            else
-                break;
-        }
-
-        if (result)
-        {
-            auto find = multiMethodBpData.find(*result);
-            if (find != multiMethodBpData.end()) // only constructors segments could be part of multiple methods
-            {
-                Tokens.resize((*find).second.size());
-                std::copy(find->second.begin(), find->second.end(), Tokens.begin());
-            }
-            Tokens.emplace_back(result->methodDef);
-        }
-        
-        return !!result;
-    }
-
 } // unnamed namespace
 
-static HRESULT GetPdbMethodsRanges(IMetaDataImport *pMDImport, PVOID pSymbolReaderHandle, std::unordered_set<mdMethodDef> *methodTokens,
+static HRESULT GetPdbMethodsRanges(ICorDebugModule *pModule, IMetaDataImport *pMDImport, PVOID pSymbolReaderHandle, std::unordered_set<mdMethodDef> *methodTokens,
                                    std::unique_ptr<module_methods_data_t, module_methods_data_t_deleter> &inputData)
 {
     HRESULT Status;
@@ -215,19 +146,20 @@ static HRESULT GetPdbMethodsRanges(IMetaDataImport *pMDImport, PVOID pSymbolRead
     std::vector<int32_t> constrTokens;
     std::vector<int32_t> normalTokens;
 
-    ULONG numTypedefs = 0;
-    HCORENUM hEnum = NULL;
-    mdTypeDef typeDef;
-    while(SUCCEEDED(pMDImport->EnumTypeDefs(&hEnum, &typeDef, 1, &numTypedefs)) && numTypedefs != 0)
+    auto addMethod = [&](mdMethodDef methodDef, const std::string &funcName)
     {
-        ULONG numMethods = 0;
-        HCORENUM fEnum = NULL;
-        mdMethodDef methodDef;
-        while(SUCCEEDED(pMDImport->EnumMethods(&fEnum, typeDef, &methodDef, 1, &numMethods)) && numMethods != 0)
-        {
-            if (methodTokens && methodTokens->find(methodDef) == methodTokens->end())
-                continue;
+        if (funcName == ".ctor" || funcName == ".cctor")
+            constrTokens.emplace_back(methodDef);
+        else
+            normalTokens.emplace_back(methodDef);
+    };
 
+    if (methodTokens)
+    {
+        // Note, only methods with provided tokens are needed, no reason scan all module's methods.
+        std::string funcNameUtf8;
+        for (mdMethodDef methodDef : *methodTokens)
+        {
             WCHAR funcName[mdNameLen];
             ULONG funcNameLen;
             if (FAILED(pMDImport->GetMethodProps(methodDef, nullptr, funcName, _countof(funcName), &funcNameLen,
@@ -236,14 +168,22 @@ static HRESULT GetPdbMethodsRanges(IMetaDataImport *pMDImport, PVOID pSymbolRead
                 continue;
             }
 
-            if (str_equal(funcName, W(".ctor")) || str_equal(funcName, W(".cctor")))
-                constrTokens.emplace_back(methodDef);
-            else
-                normalTokens.emplace_back(methodDef);
+            assign_utf8(funcNameUtf8, funcName);
+            addMethod(methodDef, funcNameUtf8);
+        }
+        // Note, keep same tokens order as metadata tables provide.
+        std::sort(constrTokens.begin(), constrTokens.end());
+        std::sort(normalTokens.begin(), normalTokens.end());
+    }
+    else
+    {
+        MetadataIndex::index_ptr_t index;
+        IfFailRet(MetadataIndex::GetModuleIndex(pModule, index));
+        for (const auto &method : index->methods)
+        {
+            addMethod(method.methodDef, method.name);
         }
-        pMDImport->CloseEnum(fEnum);
     }
-    pMDImport->CloseEnum(hEnum);
 
     if (sizeof(std::size_t) > sizeof(std::uint32_t) &&
         (constrTokens.size() > std::numeric_limits<uint32_t>::max() || normalTokens.size() > std::numeric_limits<uint32_t>::max()))
@@ -270,23 +210,35 @@ static std::string GetFileName(const std::string &path)
 // Caller must care about m_sourcesInfoMutex.
 HRESULT ModulesSources::GetFullPathIndex(BSTR document, unsigned &fullPathIndex)
 {
-    std::string fullPath = to_utf8(document);
+    return GetFullPathIndex(to_utf8(document), fullPathIndex);
+}
+
+// Caller must care about m_sourcesInfoMutex.
+HRESULT ModulesSources::GetFullPathIndex(std::string fullPath, unsigned &fullPathIndex)
+{
 #ifdef WIN32
     HRESULT Status;
     std::string initialFullPath = fullPath;
     IfFailRet(Interop::StringToUpper(fullPath));
 #endif
-    auto findPathIndex = m_sourcePathToIndex.find(fullPath);
+    const std::string *internedFullPath = StringInterner::SourcePaths().Intern(fullPath);
+    auto findPathIndex = m_sourcePathToIndex.find(internedFullPath);
     if (findPathIndex == m_sourcePathToIndex.end())
     {
         fullPathIndex = (unsigned)m_sourceIndexToPath.size();
-        m_sourcePathToIndex.emplace(std::make_pair(fullPath, fullPathIndex));
-        m_sourceIndexToPath.emplace_back(fullPath);
+        m_sourcePathToIndex.emplace(std::make_pair(internedFullPath, fullPathIndex));
+        m_sourceIndexToPath.emplace_back(internedFullPath);
 #ifdef WIN32
         m_sourceIndexToInitialFullPath.emplace_back(initialFullPath);
 #endif
-        m_sourceNameToFullPathsIndexes[GetFileName(fullPath)].emplace(fullPathIndex);
+        std::string fileName = GetFileName(fullPath);
+        auto &fileNameIndexes = m_sourceNameToFullPathsIndexes[fileName];
+        if (fileNameIndexes.empty() && fileName != fullPath)
+            m_fileNamesIndex.Add(fileName);
+        fileNameIndexes.emplace(fullPathIndex);
+        m_fileNamesIndex.Add(fullPath);
         m_sourcesMethodsData.emplace_back(std::vector<FileMethodsData>{});
+        m_requestPathToIndex.clear();
     }
     else
         fullPathIndex = findPathIndex->second;
@@ -294,33 +246,77 @@ HRESULT ModulesSources::GetFullPathIndex(BSTR document, unsigned &fullPathIndex)
     return S_OK;
 }
 
-HRESULT ModulesSources::FillSourcesCodeLinesForModule(ICorDebugModule *pModule, IMetaDataImport *pMDImport, PVOID pSymbolReaderHandle)
+// Get methods ranges from methods ranges cache or from PDB (and store result in cache).
+static HRESULT GetMethodsRangesForModule(ICorDebugModule *pModule, IMetaDataImport *pMDImport, PVOID pSymbolReaderHandle,
+                                         module_methods_ranges_t &moduleRanges)
 {
-    std::lock_guard<std::mutex> lock(m_sourcesInfoMutex);
+    std::string cacheKey;
+    if (MethodRangesCache::IsEnabled())
+    {
+        std::string moduleId;
+        std::string pdbChecksum;
+        if (SUCCEEDED(GetModuleId(pModule, moduleId)) &&
+            SUCCEEDED(Interop::GetPdbChecksum(pSymbolReaderHandle, pdbChecksum)))
+        {
+            cacheKey = MethodRangesCache::GetKey(moduleId, pdbChecksum);
+        }
+
+        if (MethodRangesCache::Load(cacheKey, moduleRanges))
+            return S_OK;
+    }
 
     HRESULT Status;
     std::unique_ptr<module_methods_data_t, module_methods_data_t_deleter> inputData;
-    IfFailRet(GetPdbMethodsRanges(pMDImport, pSymbolReaderHandle, nullptr, inputData));
-    if (inputData == nullptr)
-        return S_OK;
+    IfFailRet(GetPdbMethodsRanges(pModule, pMDImport, pSymbolReaderHandle, nullptr, inputData));
+
+    moduleRanges.clear();
+    if (inputData != nullptr)
+    {
+        moduleRanges.resize(inputData->fileNum);
+        for (int i = 0; i < inputData->fileNum; i++)
+        {
+            moduleRanges[i].document = to_utf8(inputData->moduleMethodsData[i].document);
+            moduleRanges[i].methodsData.assign(inputData->moduleMethodsData[i].methodsData,
+                                               inputData->moduleMethodsData[i].methodsData + inputData->moduleMethodsData[i].methodNum);
+        }
+    }
+
+    // Note, module without methods ranges data also should be stored, since this is valid result too.
+    // Lazy indexing is done under modules and sources locks (see IndexModuleMethodsRanges()), don't write entry under them.
+    MethodRangesCache::StoreAsync(cacheKey, moduleRanges);
+    return S_OK;
+}
+
+// Caller must care about m_sourcesInfoMutex.
+HRESULT ModulesSources::AddModuleMethodsRanges(CORDB_ADDRESS modAddress, const module_methods_ranges_t &moduleRanges, bool lazyIndexed)
+{
+    HRESULT Status;
 
     // Usually, modules provide files with unique full paths for sources.
-    m_sourceIndexToPath.reserve(m_sourceIndexToPath.size() + inputData->fileNum);
-    m_sourcesMethodsData.reserve(m_sourcesMethodsData.size() + inputData->fileNum);
+    m_sourceIndexToPath.reserve(m_sourceIndexToPath.size() + moduleRanges.size());
+    m_sourcesMethodsData.reserve(m_sourcesMethodsData.size() + moduleRanges.size());
 #ifdef WIN32
-    m_sourceIndexToInitialFullPath.reserve(m_sourceIndexToInitialFullPath.size() + inputData->fileNum);
+    m_sourceIndexToInitialFullPath.reserve(m_sourceIndexToInitialFullPath.size() + moduleRanges.size());
 #endif
 
-    CORDB_ADDRESS modAddress;
-    IfFailRet(pModule->GetBaseAddress(&modAddress));
-
-    for (int i = 0; i < inputData->fileNum; i++)
+    for (const auto &fileRanges : moduleRanges)
     {
         unsigned fullPathIndex;
-        IfFailRet(GetFullPathIndex(inputData->moduleMethodsData[i].document, fullPathIndex));
+        IfFailRet(GetFullPathIndex(fileRanges.document, fullPathIndex));
 
-        m_sourcesMethodsData[fullPathIndex].emplace_back(FileMethodsData{});
-        auto &fileMethodsData = m_sourcesMethodsData[fullPathIndex].back();
+        // In case of lazy indexing, module's entry was already added for all module's documents.
+        auto findFileMethodsData = m_sourcesMethodsData[fullPathIndex].end();
+        if (lazyIndexed)
+        {
+            findFileMethodsData = std::find_if(m_sourcesMethodsData[fullPathIndex].begin(), m_sourcesMethodsData[fullPathIndex].end(),
+                                               [&](const FileMethodsData &entry) { return entry.modAddress == modAddress; });
+        }
+        if (findFileMethodsData == m_sourcesMethodsData[fullPathIndex].end())
+        {
+            m_sourcesMethodsData[fullPathIndex].emplace_back(FileMethodsData{});
+            findFileMethodsData = std::prev(m_sourcesMethodsData[fullPathIndex].end());
+        }
+        auto &fileMethodsData = *findFileMethodsData;
         fileMethodsData.modAddress = modAddress;
 
         // Note, don't reorder input data, since it have almost ideal order for us.
@@ -333,21 +329,13 @@ HRESULT ModulesSources::FillSourcesCodeLinesForModule(ICorDebugModule *pModule,
         //    };
         //    std::multiset<method_data_t, compare> orderedInputData;
         std::map<size_t, std::set<method_data_t>> inputMethodsData;
-        for (int j = 0; j < inputData->moduleMethodsData[i].methodNum; j++)
+        multi_methods_data_t multiMethodsData;
+        for (const auto &methodData : fileRanges.methodsData)
         {
-            AddMethodData(inputMethodsData, fileMethodsData.multiMethodsData, inputData->moduleMethodsData[i].methodsData[j], 0);
+            AddMethodData(inputMethodsData, multiMethodsData, methodData, 0);
         }
 
-        fileMethodsData.methodsData.resize(inputMethodsData.size());
-        for (size_t i =  0; i < inputMethodsData.size(); i++)
-        {
-            fileMethodsData.methodsData[i].resize(inputMethodsData[i].size());
-            std::copy(inputMethodsData[i].begin(), inputMethodsData[i].end(), fileMethodsData.methodsData[i].begin());
-        }
-        for (auto &data : fileMethodsData.multiMethodsData)
-        {
-            data.second.shrink_to_fit();
-        }
+        fileMethodsData.methodsIndex.Build(inputMethodsData, multiMethodsData);
     }
 
     m_sourcesMethodsData.shrink_to_fit();
@@ -359,12 +347,83 @@ HRESULT ModulesSources::FillSourcesCodeLinesForModule(ICorDebugModule *pModule,
     return S_OK;
 }
 
+HRESULT ModulesSources::FillSourcesCodeLinesForModule(ICorDebugModule *pModule, IMetaDataImport *pMDImport, PVOID pSymbolReaderHandle, bool lazyIndexing,
+                                                      const std::vector<std::string> *pDocuments)
+{
+    HRESULT Status;
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+
+    if (lazyIndexing)
+    {
+        // Only module to documents membership stored at this point, methods data will be added at first breakpoint resolve
+        // for any source of this module.
+        std::vector<std::string> moduleDocuments;
+        if (!pDocuments)
+            IfFailRet(Interop::GetModuleDocuments(pSymbolReaderHandle, moduleDocuments));
+        const std::vector<std::string> &documents = pDocuments ? *pDocuments : moduleDocuments;
+        if (documents.empty())
+            return S_OK;
+
+        std::lock_guard<std::mutex> lock(m_sourcesInfoMutex);
+
+        m_sourceIndexToPath.reserve(m_sourceIndexToPath.size() + documents.size());
+        m_sourcesMethodsData.reserve(m_sourcesMethodsData.size() + documents.size());
+#ifdef WIN32
+        m_sourceIndexToInitialFullPath.reserve(m_sourceIndexToInitialFullPath.size() + documents.size());
+#endif
+        for (const auto &document : documents)
+        {
+            unsigned fullPathIndex;
+            IfFailRet(GetFullPathIndex(document, fullPathIndex));
+
+            m_sourcesMethodsData[fullPathIndex].emplace_back(FileMethodsData{});
+            m_sourcesMethodsData[fullPathIndex].back().modAddress = modAddress;
+        }
+        m_notIndexedModules.emplace(modAddress);
+
+        return S_OK;
+    }
+
+    // Note, don't hold m_sourcesInfoMutex during methods ranges data load, since this could take a while for big modules.
+    module_methods_ranges_t moduleRanges;
+    IfFailRet(GetMethodsRangesForModule(pModule, pMDImport, pSymbolReaderHandle, moduleRanges));
+    if (moduleRanges.empty())
+        return S_OK;
+
+    std::lock_guard<std::mutex> lock(m_sourcesInfoMutex);
+    return AddModuleMethodsRanges(modAddress, moduleRanges, false);
+}
+
+// Caller must care about m_sourcesInfoMutex and m_modulesInfoMutex.
+HRESULT ModulesSources::IndexModuleMethodsRanges(Modules *pModules, CORDB_ADDRESS modAddress)
+{
+    HRESULT Status;
+    ModuleInfo *pmdInfo; // Note, pmdInfo must be covered by m_modulesInfoMutex.
+    // Note, module could be not added into Modules yet, in this case stay it not indexed.
+    IfFailRet(pModules->GetModuleInfo(modAddress, &pmdInfo));
+    m_notIndexedModules.erase(modAddress);
+    PVOID pSymbolReaderHandle = pmdInfo->GetSymbolReaderHandle(1);
+    if (pSymbolReaderHandle == nullptr)
+        return E_FAIL;
+
+    ToRelease<IUnknown> pMDUnknown;
+    IfFailRet(pmdInfo->m_iCorModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+    ToRelease<IMetaDataImport> pMDImport;
+    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMDImport));
+
+    module_methods_ranges_t moduleRanges;
+    IfFailRet(GetMethodsRangesForModule(pmdInfo->m_iCorModule, pMDImport, pSymbolReaderHandle, moduleRanges));
+
+    return AddModuleMethodsRanges(modAddress, moduleRanges, true);
+}
+
 HRESULT ModulesSources::LineUpdatesForMethodData(ICorDebugModule *pModule, unsigned fullPathIndex, method_data_t &methodData,
                                                  const std::vector<block_update_t> &blockUpdate, ModuleInfo &mdInfo)
 {
     int32_t startLineOffset = 0;
     int32_t endLineOffset = 0;
-    std::unordered_map<std::size_t, int32_t> methodBlockOffsets;
+    std::vector<block_update_t> methodBlockUpdates;
 
     for (const auto &block : blockUpdate)
     {
@@ -401,63 +460,38 @@ HRESULT ModulesSources::LineUpdatesForMethodData(ICorDebugModule *pModule, unsig
             ULONG32 methodVersion;
             IfFailRet(iCorFunction2->GetVersionNumber(&methodVersion));
 
-            if (mdInfo.m_symbolReaderHandles.empty() || mdInfo.m_symbolReaderHandles.size() < methodVersion)
+            PVOID pSymbolReaderHandle = mdInfo.GetSymbolReaderHandle(methodVersion);
+            if (pSymbolReaderHandle == nullptr)
                 return E_FAIL;
 
-            Interop::SequencePoint *sequencePoints = nullptr;
-            int32_t count = 0;
-            if (FAILED(Status = Interop::GetSequencePoints(mdInfo.m_symbolReaderHandles[methodVersion - 1], methodData.methodDef, &sequencePoints, count)))
-            {
-                if (sequencePoints)
-                {
-                    for (int i = 0; i < count; i++)
-                    {
-                        Interop::SysFreeString(sequencePoints[i].document);
-                    }
-                    Interop::CoTaskMemFree(sequencePoints);
-                }
+            Interop::SequencePoints sequencePoints;
+            IfFailRet(Interop::GetSequencePoints(pSymbolReaderHandle, methodData.methodDef, false, sequencePoints));
 
-                return Status;
+            // Note, usually all method's sequence points belong to one document.
+            std::vector<unsigned> documentsIndexes(sequencePoints.GetDocumentsCount());
+            for (int32_t i = 0; i < sequencePoints.GetDocumentsCount(); i++)
+            {
+                IfFailRet(GetFullPathIndex(to_utf8(sequencePoints.GetDocument(i)), documentsIndexes[i]));
             }
 
-            for (int i = 0; i < count; i++)
+            auto &lineUpdatesTable = mdInfo.m_methodBlockUpdates[methodData.methodDef];
+            for (int32_t i = 0; i < sequencePoints.GetCount(); i++)
             {
-                unsigned index;
-                IfFailRet(GetFullPathIndex(sequencePoints[i].document, index));
-                Interop::SysFreeString(sequencePoints[i].document);
-
-                mdInfo.m_methodBlockUpdates[methodData.methodDef].emplace_back(index, sequencePoints[i].startLine, sequencePoints[i].startLine, sequencePoints[i].endLine - sequencePoints[i].startLine);
-
+                const Interop::SequencePoints::Row &sequencePoint = sequencePoints[i];
+                lineUpdatesTable.Add(documentsIndexes[sequencePoint.documentIndex], sequencePoint.startLine, sequencePoint.endLine);
             }
-
-            if (sequencePoints)
-                Interop::CoTaskMemFree(sequencePoints);
+            lineUpdatesTable.Build();
         }
 
-        for (std::size_t i = 0; i < mdInfo.m_methodBlockUpdates[methodData.methodDef].size(); ++i)
-        {
-            auto &entry = mdInfo.m_methodBlockUpdates[methodData.methodDef][i];
-
-            if (entry.fullPathIndex != fullPathIndex ||
-                entry.newLine < block.oldLine ||
-                (uint32_t)entry.newLine + (uint32_t)entry.endLineOffset > (uint32_t)block.oldLine + (uint32_t)block.endLineOffset)
-                continue;
-
-            // Line updates file can have only one entry for each line.
-            methodBlockOffsets[i] = lineOffset;
-        }
+        methodBlockUpdates.emplace_back(block);
     }
 
-    if (!methodBlockOffsets.empty())
+    if (!methodBlockUpdates.empty())
     {
         auto findMethod = mdInfo.m_methodBlockUpdates.find(methodData.methodDef);
         assert(findMethod != mdInfo.m_methodBlockUpdates.end());
-
-        for (const auto &entry : methodBlockOffsets)
-        {
-            // All we need for previous stored data is change newLine, since oldLine will be the same (PDB for this method version was not changed).
-            findMethod->second[entry.first].newLine += entry.second;
-        }
+        // All we need for previous stored data is change offsets, since PDB lines will be the same (PDB for this method version was not changed).
+        findMethod->second.ApplyBlockUpdates(fullPathIndex, methodBlockUpdates);
     }
 
     if (startLineOffset == 0 && endLineOffset == 0)
@@ -469,13 +503,14 @@ HRESULT ModulesSources::LineUpdatesForMethodData(ICorDebugModule *pModule, unsig
 }
 
 HRESULT ModulesSources::UpdateSourcesCodeLinesForModule(ICorDebugModule *pModule, IMetaDataImport *pMDImport, std::unordered_set<mdMethodDef> methodTokens,
-                                                        src_block_updates_t &srcBlockUpdates, ModuleInfo &mdInfo)
+                                                        src_block_updates_t &srcBlockUpdates, ModuleInfo &mdInfo,
+                                                        std::unordered_set<unsigned> &updatedSources)
 {
     std::lock_guard<std::mutex> lock(m_sourcesInfoMutex);
 
     HRESULT Status;
     std::unique_ptr<module_methods_data_t, module_methods_data_t_deleter> inputData;
-    IfFailRet(GetPdbMethodsRanges(pMDImport, mdInfo.m_symbolReaderHandles.back(), &methodTokens, inputData));
+    IfFailRet(GetPdbMethodsRanges(pModule, pMDImport, mdInfo.GetSymbolReaderHandle((ULONG32)mdInfo.m_symbolReaderHandles.size()), &methodTokens, inputData));
 
     struct src_update_data_t
     {
@@ -510,8 +545,10 @@ HRESULT ModulesSources::UpdateSourcesCodeLinesForModule(ICorDebugModule *pModule
     for (const auto &updateData : srcUpdateData)
     {
         const unsigned fullPathIndex = updateData.first;
+        updatedSources.insert(fullPathIndex);
 
         std::map<size_t, std::set<method_data_t>> inputMethodsData;
+        multi_methods_data_t multiMethodsData;
         if (m_sourcesMethodsData[fullPathIndex].empty())
         { // New source file added.
             m_sourcesMethodsData[fullPathIndex].emplace_back(FileMethodsData{});
@@ -520,7 +557,7 @@ HRESULT ModulesSources::UpdateSourcesCodeLinesForModule(ICorDebugModule *pModule
 
             for (int j = 0; j < updateData.second.methodNum; j++)
             {
-                AddMethodData(inputMethodsData, tmpFileMethodsData.multiMethodsData, updateData.second.methodsData[j], 0);
+                AddMethodData(inputMethodsData, multiMethodsData, updateData.second.methodsData[j], 0);
             }
         }
         else
@@ -535,63 +572,54 @@ HRESULT ModulesSources::UpdateSourcesCodeLinesForModule(ICorDebugModule *pModule
 
             // Move multiMethodsData first (since this is constructors and all will be on level 0 for sure).
             // Use std::unordered_set here instead array for fast search.
-            auto &tmpFileMethodsData = m_sourcesMethodsData[fullPathIndex].back();
+            const auto &methodsIndex = m_sourcesMethodsData[fullPathIndex].back().methodsIndex;
+            const std::vector<method_data_t> &indexedMethodsData = methodsIndex.GetMethods();
             std::vector<method_data_t> tmpMultiMethodsData;
-            for (const auto &entryData : tmpFileMethodsData.multiMethodsData)
+            for (size_t i = 0; i < indexedMethodsData.size(); i++)
             {
-                auto findData = inputMetodDefSet.find(entryData.first.methodDef);
+                Utility::span<const mdMethodDef> multiTokens = methodsIndex.GetMultiTokens(i);
+                if (multiTokens.empty())
+                    continue;
+
+                const method_data_t &entryData = indexedMethodsData[i];
+                auto findData = inputMetodDefSet.find(entryData.methodDef);
                 if (findData == inputMetodDefSet.end())
-                    tmpMultiMethodsData.emplace_back(entryData.first);
+                    tmpMultiMethodsData.emplace_back(entryData);
 
-                for (const auto &entryMethodDef : entryData.second)
+                for (const auto &entryMethodDef : multiTokens)
                 {
                     findData = inputMetodDefSet.find(entryMethodDef);
                     if (findData == inputMetodDefSet.end())
-                        tmpMultiMethodsData.emplace_back(entryMethodDef, entryData.first.startLine, entryData.first.endLine,
-                                                         entryData.first.startColumn, entryData.first.endColumn);
+                        tmpMultiMethodsData.emplace_back(entryMethodDef, entryData.startLine, entryData.endLine,
+                                                         entryData.startColumn, entryData.endColumn);
                 }
             }
 
-            tmpFileMethodsData.multiMethodsData.clear();
             for (auto &methodData : tmpMultiMethodsData)
             {
                 IfFailRet(LineUpdatesForMethodData(pModule, fullPathIndex, methodData, updateData.second.blockUpdate, mdInfo));
-                AddMethodData(inputMethodsData, tmpFileMethodsData.multiMethodsData, methodData, 0);
+                AddMethodData(inputMethodsData, multiMethodsData, methodData, 0);
             }
 
             // Move normal methods.
-            for (auto &methodsData : tmpFileMethodsData.methodsData)
+            for (auto methodData : indexedMethodsData)
             {
-                for (auto &methodData : methodsData)
+                auto findData = inputMetodDefSet.find(methodData.methodDef);
+                if (findData == inputMetodDefSet.end())
                 {
-                    auto findData = inputMetodDefSet.find(methodData.methodDef);
-                    if (findData == inputMetodDefSet.end())
-                    {
-                        IfFailRet(LineUpdatesForMethodData(pModule, fullPathIndex, methodData, updateData.second.blockUpdate, mdInfo));
-                        AddMethodData(inputMethodsData, tmpFileMethodsData.multiMethodsData, methodData, 0);
-                    }
+                    IfFailRet(LineUpdatesForMethodData(pModule, fullPathIndex, methodData, updateData.second.blockUpdate, mdInfo));
+                    AddMethodData(inputMethodsData, multiMethodsData, methodData, 0);
                 }
             }
-            tmpFileMethodsData.methodsData.clear();
 
             // Move new and modified methods.
             for (int j = 0; j < updateData.second.methodNum; j++)
             {
-                AddMethodData(inputMethodsData, tmpFileMethodsData.multiMethodsData, updateData.second.methodsData[j], 0);
+                AddMethodData(inputMethodsData, multiMethodsData, updateData.second.methodsData[j], 0);
             }
         }
 
-        auto &fileMethodsData = m_sourcesMethodsData[fullPathIndex].back();
-        fileMethodsData.methodsData.resize(inputMethodsData.size());
-        for (size_t i =  0; i < inputMethodsData.size(); i++)
-        {
-            fileMethodsData.methodsData[i].resize(inputMethodsData[i].size());
-            std::copy(inputMethodsData[i].begin(), inputMethodsData[i].end(), fileMethodsData.methodsData[i].begin());
-        }
-        for (auto &data : fileMethodsData.multiMethodsData)
-        {
-            data.second.shrink_to_fit();
-        }
+        m_sourcesMethodsData[fullPathIndex].back().methodsIndex.Build(inputMethodsData, multiMethodsData);
     }
 
     return S_OK;
@@ -633,16 +661,16 @@ HRESULT ModulesSources::ResolveRelativeSourceFileName(std::string &filename)
     if (result == GetFileName(result))
     {
         auto it = std::min_element(possiblePathsIndexes.begin(), possiblePathsIndexes.end(),
-                        [&](const unsigned a, const unsigned b){ return m_sourceIndexToPath[a].size() < m_sourceIndexToPath[b].size(); } );
+                        [&](const unsigned a, const unsigned b){ return m_sourceIndexToPath[a]->size() < m_sourceIndexToPath[b]->size(); } );
 
-        filename = it == possiblePathsIndexes.end() ? result : m_sourceIndexToPath[*it];
+        filename = it == possiblePathsIndexes.end() ? result : *m_sourceIndexToPath[*it];
         return S_OK;
     }
 
     std::list<std::string> possibleResults;
     for (const auto pathIndex : possiblePathsIndexes)
     {
-        if (result.size() > m_sourceIndexToPath[pathIndex].size())
+        if (result.size() > m_sourceIndexToPath[pathIndex]->size())
             continue;
 
         // Note, since assemblies could be built in different OSes, we could have different delimiters in source files paths.
@@ -657,7 +685,7 @@ HRESULT ModulesSources::ResolveRelativeSourceFileName(std::string &filename)
         //    possibleResults.push_back(path);
         auto first1 = result.begin();
         auto last1 = result.end();
-        auto first2 = m_sourceIndexToPath[pathIndex].end() - result.size();
+        auto first2 = m_sourceIndexToPath[pathIndex]->end() - result.size();
         auto equal = [&]()
         {
             for (; first1 != last1; ++first1, ++first2)
@@ -668,7 +696,7 @@ HRESULT ModulesSources::ResolveRelativeSourceFileName(std::string &filename)
             return true;
         };
         if (equal())
-            possibleResults.push_back(m_sourceIndexToPath[pathIndex]);
+            possibleResults.push_back(*m_sourceIndexToPath[pathIndex]);
     }
     // The problem is - we could have several assemblies that could have sources with same relative paths with different path's root.
     // We don't really have a lot of options here, so, we assume, that all possible sources paths have same root and just find the shortest.
@@ -693,26 +721,15 @@ static void LineUpdatesBackwardCorrection(unsigned fullPathIndex, mdMethodDef me
 {
     auto findSourceUpdate = methodBlockUpdates.find(methodToken);
     if (findSourceUpdate != methodBlockUpdates.end())
-    {
-        for (const auto &entry : findSourceUpdate->second)
-        {
-            if (entry.fullPathIndex != fullPathIndex ||
-                entry.newLine + entry.endLineOffset < startLine)
-                continue;
-
-            startLine = entry.oldLine; // <- closest executable code line for requested line in old PDB data
-            break;
-        }
-    }
+        findSourceUpdate->second.GetPdbLine(fullPathIndex, startLine, startLine); // <- closest executable code line for requested line in old PDB data
 }
 
-HRESULT ModulesSources::ResolveBreakpoint(/*in*/ Modules *pModules, /*in*/ CORDB_ADDRESS modAddress, /*in*/ std::string filename, /*out*/ unsigned &fullname_index,
-                                          /*in*/ int sourceLine, /*out*/ std::vector<resolved_bp_t> &resolvedPoints)
+// Caller must care about m_sourcesInfoMutex.
+HRESULT ModulesSources::FindSourceFullPathIndex(std::string filename, unsigned &fullPathIndex)
 {
-    std::lock_guard<std::mutex> lockSourcesInfo(m_sourcesInfoMutex);
-
     HRESULT Status;
-    auto findIndex = m_sourcePathToIndex.find(filename);
+    // Note, not interned path can't be stored in m_sourcePathToIndex, find(nullptr) return end().
+    auto findIndex = m_sourcePathToIndex.find(StringInterner::SourcePaths().Find(filename));
     if (findIndex == m_sourcePathToIndex.end())
     {
         // Check for absolute path.
@@ -726,14 +743,79 @@ HRESULT ModulesSources::ResolveBreakpoint(/*in*/ Modules *pModules, /*in*/ CORDB
             return E_FAIL;
         }
 
-        IfFailRet(ResolveRelativeSourceFileName(filename));
+        auto findCached = m_requestPathToIndex.find(filename);
+        if (findCached != m_requestPathToIndex.end())
+        {
+            fullPathIndex = findCached->second.second;
+            return findCached->second.first;
+        }
 
-        findIndex = m_sourcePathToIndex.find(filename);
-        if (findIndex == m_sourcePathToIndex.end())
+        std::string requestPath = filename;
+        if (FAILED(Status = ResolveRelativeSourceFileName(filename)) ||
+            (findIndex = m_sourcePathToIndex.find(StringInterner::SourcePaths().Find(filename))) == m_sourcePathToIndex.end())
+        {
+            m_requestPathToIndex.emplace(std::move(requestPath), std::make_pair(E_FAIL, 0u));
             return E_FAIL;
+        }
+
+        m_requestPathToIndex.emplace(std::move(requestPath), std::make_pair(S_OK, findIndex->second));
+    }
+
+    fullPathIndex = findIndex->second;
+    return S_OK;
+}
+
+// In case of lazy indexing, methods data for all related modules must be added first.
+// Caller must care about m_sourcesInfoMutex and m_modulesInfoMutex.
+void ModulesSources::IndexModulesForSource(Modules *pModules, CORDB_ADDRESS modAddress, unsigned fullPathIndex)
+{
+    // Note, we use index here, since m_sourcesMethodsData could be changed during indexing.
+    HRESULT Status;
+    for (size_t i = 0; i < m_sourcesMethodsData[fullPathIndex].size() && !m_notIndexedModules.empty(); i++)
+    {
+        CORDB_ADDRESS sourceModAddress = m_sourcesMethodsData[fullPathIndex][i].modAddress;
+        if ((modAddress && modAddress != sourceModAddress) ||
+            m_notIndexedModules.find(sourceModAddress) == m_notIndexedModules.end())
+            continue;
+
+        if (FAILED(Status = IndexModuleMethodsRanges(pModules, sourceModAddress)))
+            LOGE("Could not load source lines related info from PDB file, error 0x%08x.", Status);
     }
+}
+
+HRESULT ModulesSources::ResolveBreakpoint(/*in*/ Modules *pModules, /*in*/ CORDB_ADDRESS modAddress, /*in*/ std::string filename, /*out*/ unsigned &fullname_index,
+                                          /*in*/ int sourceLine, /*out*/ std::vector<resolved_bp_t> &resolvedPoints)
+{
+    HRESULT Status;
+    std::vector<resolve_bp_request_t> requests;
+    requests.emplace_back(modAddress, filename, sourceLine);
+    std::vector<resolve_bp_result_t> results;
+    IfFailRet(ResolveBreakpoints(pModules, requests, results));
 
-    fullname_index = findIndex->second;
+    if (FAILED(results[0].Status))
+        return results[0].Status;
+
+    fullname_index = results[0].fullname_index;
+    resolvedPoints = std::move(results[0].resolvedPoints);
+    return S_OK;
+}
+
+HRESULT ModulesSources::ResolveBreakpoints(/*in*/ Modules *pModules, /*in*/ const std::vector<resolve_bp_request_t> &requests,
+                                           /*out*/ std::vector<resolve_bp_result_t> &results)
+{
+    std::lock_guard<std::mutex> lockSourcesInfo(m_sourcesInfoMutex);
+
+    results.clear();
+    results.resize(requests.size());
+
+    // Note, new sources could be added during indexing, find and index all sources first.
+    for (size_t i = 0; i < requests.size(); i++)
+    {
+        if (FAILED(results[i].Status = FindSourceFullPathIndex(requests[i].filename, results[i].fullname_index)))
+            continue;
+
+        IndexModulesForSource(pModules, requests[i].modAddress, results[i].fullname_index);
+    }
 
     struct resolved_input_bp_t
     {
@@ -741,6 +823,7 @@ HRESULT ModulesSources::ResolveBreakpoint(/*in*/ Modules *pModules, /*in*/ CORDB
         int32_t endLine;
         uint32_t ilOffset;
         uint32_t methodToken;
+        int32_t requestIndex;
     };
 
     struct resolved_input_bp_t_deleter
@@ -751,77 +834,133 @@ HRESULT ModulesSources::ResolveBreakpoint(/*in*/ Modules *pModules, /*in*/ CORDB
         }
     };
 
-    for (const auto &sourceData : m_sourcesMethodsData[findIndex->second])
+    // Data for managed part request, one for each module that have source line related to request.
+    struct pending_request_t
     {
-        if (modAddress && modAddress != sourceData.modAddress)
-            continue;
-
+        size_t resultIndex;
+        ModuleInfo *pmdInfo; // Note, pmdInfo must be covered by m_modulesInfoMutex.
         std::vector<mdMethodDef> Tokens;
-        int32_t correctedStartLine = sourceLine;
-        mdMethodDef closestNestedToken = 0;
-        if (!GetMethodTokensByLineNumber(sourceData.methodsData, sourceData.multiMethodsData, correctedStartLine, Tokens, closestNestedToken))
+        std::vector<PVOID> symbolReaderHandles;
+        int32_t correctedStartLine;
+        mdMethodDef closestNestedToken;
+        int32_t sourcePathIndex;
+    };
+    std::vector<pending_request_t> pendingRequests;
+    std::vector<std::string> sourcePaths;
+    std::unordered_map<unsigned, int32_t> sourcePathsIndexes;
+
+    for (size_t i = 0; i < requests.size(); i++)
+    {
+        if (FAILED(results[i].Status))
             continue;
-        // correctedStartLine - in case line not belong any methods, if possible, will be "moved" to first line of method below sourceLine.
 
-        if ((int32_t)Tokens.size() > std::numeric_limits<int32_t>::max())
+        const unsigned fullPathIndex = results[i].fullname_index;
+        const size_t firstPendingRequest = pendingRequests.size();
+        for (const auto &sourceData : m_sourcesMethodsData[fullPathIndex])
         {
-            LOGE("Too big token arrays.");
-            return E_FAIL;
-        }
+            if (requests[i].modAddress && requests[i].modAddress != sourceData.modAddress)
+                continue;
 
-        ModuleInfo *pmdInfo; // Note, pmdInfo must be covered by m_modulesInfoMutex.
-        IfFailRet(pModules->GetModuleInfo(sourceData.modAddress, &pmdInfo)); // we must have it, since we loaded data from it
-        if (pmdInfo->m_symbolReaderHandles.empty())
-            continue;
+            pending_request_t pending;
+            pending.resultIndex = i;
+            pending.correctedStartLine = requests[i].sourceLine;
+            pending.closestNestedToken = 0;
+            if (!sourceData.methodsIndex.GetMethodTokensByLineNumber(pending.correctedStartLine, pending.Tokens, pending.closestNestedToken))
+                continue;
+            // correctedStartLine - in case line not belong any methods, if possible, will be "moved" to first line of method below sourceLine.
 
-        // In case one source line (field/property initialization) compiled into all constructors, after Hot Reload, constructors may have different
-        // code version numbers, that mean debug info located in different symbol readers.
-        std::vector<PVOID> symbolReaderHandles;
-        symbolReaderHandles.reserve(Tokens.size());
-        for (auto methodToken : Tokens)
-        {
-            // Note, new breakpoints could be setup for last code version only, since protocols (MI, VSCode, ...) provide source:line data only.
-            ULONG32 currentVersion;
-            ToRelease<ICorDebugFunction> pFunction;
-            if (FAILED(pmdInfo->m_iCorModule->GetFunctionFromToken(methodToken, &pFunction)) ||
-                FAILED(pFunction->GetCurrentVersionNumber(&currentVersion)))
+            if ((int32_t)pending.Tokens.size() > std::numeric_limits<int32_t>::max())
             {
-                symbolReaderHandles.emplace_back(pmdInfo->m_symbolReaderHandles[0]);
-                continue;
+                LOGE("Too big token arrays.");
+                results[i].Status = E_FAIL;
+                break;
             }
 
-            assert(pmdInfo->m_symbolReaderHandles.size() >= currentVersion);
-            symbolReaderHandles.emplace_back(pmdInfo->m_symbolReaderHandles[currentVersion - 1]);
-        }
+            // we must have it, since we loaded data from it
+            if (FAILED(results[i].Status = pModules->GetModuleInfo(sourceData.modAddress, &pending.pmdInfo)))
+                break;
+            if (pending.pmdInfo->m_symbolReaderHandles.empty())
+                continue;
 
-        // In case Hot Reload we may have line updates that we must take into account.
-        LineUpdatesBackwardCorrection(findIndex->second, Tokens[0], pmdInfo->m_methodBlockUpdates, correctedStartLine);
+            // In case one source line (field/property initialization) compiled into all constructors, after Hot Reload, constructors may have different
+            // code version numbers, that mean debug info located in different symbol readers.
+            pending.symbolReaderHandles.reserve(pending.Tokens.size());
+            for (auto methodToken : pending.Tokens)
+            {
+                // Note, new breakpoints could be setup for last code version only, since protocols (MI, VSCode, ...) provide source:line data only.
+                ULONG32 currentVersion;
+                ToRelease<ICorDebugFunction> pFunction;
+                if (FAILED(pending.pmdInfo->m_iCorModule->GetFunctionFromToken(methodToken, &pFunction)) ||
+                    FAILED(pFunction->GetCurrentVersionNumber(&currentVersion)))
+                {
+                    pending.symbolReaderHandles.emplace_back(pending.pmdInfo->GetSymbolReaderHandle(1));
+                    continue;
+                }
+
+                assert(pending.pmdInfo->m_symbolReaderHandles.size() >= currentVersion);
+                pending.symbolReaderHandles.emplace_back(pending.pmdInfo->GetSymbolReaderHandle(currentVersion));
+            }
+            // Note, unloaded by memory limit module's PDB could fail to load again.
+            if (std::find(pending.symbolReaderHandles.begin(), pending.symbolReaderHandles.end(), nullptr) != pending.symbolReaderHandles.end())
+                continue;
+
+            // In case Hot Reload we may have line updates that we must take into account.
+            LineUpdatesBackwardCorrection(fullPathIndex, pending.Tokens[0], pending.pmdInfo->m_methodBlockUpdates, pending.correctedStartLine);
 
-        PVOID data = nullptr;
-        int32_t Count = 0;
+            auto findPathIndex = sourcePathsIndexes.find(fullPathIndex);
+            if (findPathIndex == sourcePathsIndexes.end())
+            {
 #ifndef _WIN32
-        std::string fullName = m_sourceIndexToPath[findIndex->second];
+                sourcePaths.emplace_back(*m_sourceIndexToPath[fullPathIndex]);
 #else
-        std::string fullName = m_sourceIndexToInitialFullPath[findIndex->second];
+                sourcePaths.emplace_back(m_sourceIndexToInitialFullPath[fullPathIndex]);
 #endif
-        if (FAILED(Interop::ResolveBreakPoints(symbolReaderHandles.data(), (int32_t)Tokens.size(), Tokens.data(),
-                                               correctedStartLine, closestNestedToken, Count, fullName, &data))
-            || data == nullptr)
-        {
-            continue;
+                findPathIndex = sourcePathsIndexes.emplace(fullPathIndex, (int32_t)(sourcePaths.size() - 1)).first;
+            }
+            pending.sourcePathIndex = findPathIndex->second;
+
+            pendingRequests.emplace_back(std::move(pending));
         }
-        std::unique_ptr<resolved_input_bp_t, resolved_input_bp_t_deleter> inputData((resolved_input_bp_t*)data);
 
-        for (int32_t i = 0; i < Count; i++)
-        {
-            pmdInfo->m_iCorModule->AddRef();
+        // Failed request should not be resolved at all.
+        if (FAILED(results[i].Status))
+            pendingRequests.resize(firstPendingRequest);
+    }
 
-            // In case Hot Reload we may have line updates that we must take into account.
-            LineUpdatesForwardCorrection(findIndex->second, inputData.get()[i].methodToken, pmdInfo->m_methodBlockUpdates, inputData.get()[i]);
+    if (pendingRequests.empty())
+        return S_OK;
 
-            resolvedPoints.emplace_back(resolved_bp_t(inputData.get()[i].startLine, inputData.get()[i].endLine, inputData.get()[i].ilOffset,
-                                                      inputData.get()[i].methodToken, pmdInfo->m_iCorModule.GetPtr()));
-        }
+    std::vector<Interop::ResolveBreakPointsRequest> batchRequests;
+    batchRequests.reserve(pendingRequests.size());
+    for (auto &pending : pendingRequests)
+    {
+        batchRequests.emplace_back(pending.symbolReaderHandles.data(), pending.Tokens.data(), (int32_t)pending.Tokens.size(),
+                                   pending.correctedStartLine, pending.closestNestedToken, pending.sourcePathIndex);
+    }
+
+    PVOID data = nullptr;
+    int32_t Count = 0;
+    if (FAILED(Interop::ResolveBreakPointsBatch(batchRequests, sourcePaths, Count, &data)) || data == nullptr)
+        return S_OK;
+
+    std::unique_ptr<resolved_input_bp_t, resolved_input_bp_t_deleter> inputData((resolved_input_bp_t*)data);
+
+    for (int32_t i = 0; i < Count; i++)
+    {
+        resolved_input_bp_t &inputBP = inputData.get()[i];
+        if (inputBP.requestIndex < 0 || (size_t)inputBP.requestIndex >= pendingRequests.size())
+            continue;
+
+        const pending_request_t &pending = pendingRequests[inputBP.requestIndex];
+        resolve_bp_result_t &result = results[pending.resultIndex];
+
+        pending.pmdInfo->m_iCorModule->AddRef();
+
+        // In case Hot Reload we may have line updates that we must take into account.
+        LineUpdatesForwardCorrection(result.fullname_index, inputBP.methodToken, pending.pmdInfo->m_methodBlockUpdates, inputBP);
+
+        result.resolvedPoints.emplace_back(resolved_bp_t(inputBP.startLine, inputBP.endLine, inputBP.ilOffset,
+                                                         inputBP.methodToken, pending.pmdInfo->m_iCorModule.GetPtr()));
     }
 
     return S_OK;
@@ -910,39 +1049,55 @@ static HRESULT LoadLineUpdatesFile(ModulesSources *pModulesSources, const std::s
     return S_OK;
 }
 
-HRESULT ModulesSources::ApplyPdbDeltaAndLineUpdates(Modules *pModules, ICorDebugModule *pModule, bool needJMC, const std::string &deltaPDB,
-                                                    const std::string &lineUpdates, std::unordered_set<mdMethodDef> &methodTokens)
+// Note, only sources indexes are used here (covered by m_sourcesInfoMutex), so, could be called without m_modulesInfoMutex.
+HRESULT ModulesSources::LoadPdbDeltaAndLineUpdates(const std::string &deltaPDB, const std::string &lineUpdates, pdb_delta_t &delta)
+{
+    HRESULT Status;
+    IfFailRet(Interop::LoadDeltaPdb(deltaPDB, &delta.symbolReaderHandle, delta.methodTokens));
+    return LoadLineUpdatesFile(this, lineUpdates, delta.srcBlockUpdates);
+}
+
+// Caller must care about m_modulesInfoMutex.
+HRESULT ModulesSources::ApplyPdbDeltaAndLineUpdates(Modules *pModules, ICorDebugModule *pModule, bool needJMC, pdb_delta_t &delta,
+                                                    std::unordered_set<unsigned> &updatedSources)
 {
     HRESULT Status;
     CORDB_ADDRESS modAddress;
     IfFailRet(pModule->GetBaseAddress(&modAddress));
 
-    return pModules->GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
-    {
-        if (mdInfo.m_symbolReaderHandles.empty())
-            return E_FAIL; // Deltas could be applied for already loaded modules with PDB only.
+    ModuleInfo *pmdInfo; // Note, pmdInfo must be covered by m_modulesInfoMutex.
+    IfFailRet(pModules->GetModuleInfo(modAddress, &pmdInfo));
+    ModuleInfo &mdInfo = *pmdInfo;
 
-        PVOID pSymbolReaderHandle = nullptr;
-        IfFailRet(Interop::LoadDeltaPdb(deltaPDB, &pSymbolReaderHandle, methodTokens));
-        // Note, even if methodTokens is empty, pSymbolReaderHandle must be added into vector (we use indexes that correspond to il/metadata apply number + will care about release it in proper way).
-        mdInfo.m_symbolReaderHandles.emplace_back(pSymbolReaderHandle);
+    if (mdInfo.m_symbolReaderHandles.empty())
+        return E_FAIL; // Deltas could be applied for already loaded modules with PDB only.
 
-        src_block_updates_t srcBlockUpdates;
-        IfFailRet(LoadLineUpdatesFile(this, lineUpdates, srcBlockUpdates));
+    const std::unordered_set<mdMethodDef> &methodTokens = delta.methodTokens;
+    // Note, even if methodTokens is empty, symbol reader handle must be added into vector (we use indexes that correspond to il/metadata apply number + will care about release it in proper way).
+    mdInfo.m_symbolReaderHandles.emplace_back(delta.symbolReaderHandle);
+    delta.symbolReaderHandle = nullptr;
+    mdInfo.m_symbolReaderMethods.resize(mdInfo.m_symbolReaderHandles.size());
+    mdInfo.m_symbolReaderMethods.back().assign(methodTokens.begin(), methodTokens.end());
 
-        if (methodTokens.empty() && srcBlockUpdates.empty())
-            return S_OK;
+    src_block_updates_t &srcBlockUpdates = delta.srcBlockUpdates;
+    if (methodTokens.empty() && srcBlockUpdates.empty())
+        return S_OK;
 
-        if (needJMC && !methodTokens.empty())
-            DisableJMCByAttributes(pModule, methodTokens);
+    if (needJMC && !methodTokens.empty())
+        DisableJMCByAttributes(pModule, methodTokens);
+    // Note, delta could add types and methods with "not user code" attributes, tokens will be calculated again at next JMC toggle.
+    if (!methodTokens.empty())
+    {
+        mdInfo.m_nonJMCTokens.clear();
+        mdInfo.m_nonJMCTokensCached = false;
+    }
 
-        ToRelease<IUnknown> pMDUnknown;
-        IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
-        ToRelease<IMetaDataImport> pMDImport;
-        IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMDImport));
+    ToRelease<IUnknown> pMDUnknown;
+    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+    ToRelease<IMetaDataImport> pMDImport;
+    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMDImport));
 
-        return UpdateSourcesCodeLinesForModule(pModule, pMDImport, methodTokens, srcBlockUpdates, mdInfo);
-    });
+    return UpdateSourcesCodeLinesForModule(pModule, pMDImport, methodTokens, srcBlockUpdates, mdInfo, updatedSources);
 }
 
 HRESULT ModulesSources::GetSourceFullPathByIndex(unsigned index, std::string &fullPath)
@@ -953,7 +1108,7 @@ HRESULT ModulesSources::GetSourceFullPathByIndex(unsigned index, std::string &fu
         return E_FAIL;
 
 #ifndef _WIN32
-    fullPath = m_sourceIndexToPath[index];
+    fullPath = *m_sourceIndexToPath[index];
 #else
     fullPath = m_sourceIndexToInitialFullPath[index];
 #endif
@@ -970,7 +1125,7 @@ HRESULT ModulesSources::GetIndexBySourceFullPath(std::string fullPath, unsigned
 
     std::lock_guard<std::mutex> lock(m_sourcesInfoMutex);
 
-    auto findIndex = m_sourcePathToIndex.find(fullPath);
+    auto findIndex = m_sourcePathToIndex.find(StringInterner::SourcePaths().Find(fullPath));
     if (findIndex == m_sourcePathToIndex.end())
         return E_FAIL;
 
@@ -978,6 +1133,80 @@ HRESULT ModulesSources::GetIndexBySourceFullPath(std::string fullPath, unsigned
     return S_OK;
 }
 
+HRESULT ModulesSources::FindModuleSources(CORDB_ADDRESS modAddress, const std::vector<std::string> &filenames, std::vector<bool> &haveSources)
+{
+    haveSources.assign(filenames.size(), false);
+
+    std::lock_guard<std::mutex> lock(m_sourcesInfoMutex);
+
+    for (size_t i = 0; i < filenames.size(); i++)
+    {
+#ifdef WIN32
+        HRESULT Status;
+        std::string fileName = GetFileName(filenames[i]);
+        IfFailRet(Interop::StringToUpper(fileName));
+        auto findIndexes = m_sourceNameToFullPathsIndexes.find(fileName);
+#else
+        auto findIndexes = m_sourceNameToFullPathsIndexes.find(GetFileName(filenames[i]));
+#endif
+        if (findIndexes == m_sourceNameToFullPathsIndexes.end())
+            continue;
+
+        for (const auto fullPathIndex : findIndexes->second)
+        {
+            const auto &sourcesData = m_sourcesMethodsData[fullPathIndex];
+            if (std::any_of(sourcesData.begin(), sourcesData.end(),
+                            [&](const FileMethodsData &sourceData) { return sourceData.modAddress == modAddress; }))
+            {
+                haveSources[i] = true;
+                break;
+            }
+        }
+    }
+
+    return S_OK;
+}
+
+size_t ModulesSources::GetMemoryUsage()
+{
+    std::lock_guard<std::mutex> lock(m_sourcesInfoMutex);
+
+    size_t size = StringInterner::SourcePaths().GetMemoryUsage() +
+                  MemorySize::Vector(m_sourceIndexToPath) +
+                  MemorySize::HashNodes(m_sourcePathToIndex) +
+                  MemorySize::HashNodes(m_sourceNameToFullPathsIndexes) +
+                  m_fileNamesIndex.GetMemoryUsage() +
+                  MemorySize::Vector(m_sourcesMethodsData) +
+                  MemorySize::HashNodes(m_notIndexedModules) +
+                  MemorySize::HashNodes(m_requestPathToIndex);
+
+    for (const auto &entry : m_sourceNameToFullPathsIndexes)
+    {
+        size += MemorySize::String(entry.first) + MemorySize::TreeNodes(entry.second);
+    }
+    for (const auto &fileMethodsData : m_sourcesMethodsData)
+    {
+        size += MemorySize::Vector(fileMethodsData);
+        for (const auto &methodsData : fileMethodsData)
+        {
+            size += methodsData.methodsIndex.GetMemoryUsage();
+        }
+    }
+    for (const auto &entry : m_requestPathToIndex)
+    {
+        size += MemorySize::String(entry.first);
+    }
+#ifdef WIN32
+    size += MemorySize::Vector(m_sourceIndexToInitialFullPath);
+    for (const auto &path : m_sourceIndexToInitialFullPath)
+    {
+        size += MemorySize::String(path);
+    }
+#endif
+
+    return size;
+}
+
 void ModulesSources::FindFileNames(Utility::string_view pattern, unsigned limit, std::function<void(const char *)> cb)
 {
 #ifdef WIN32
@@ -987,39 +1216,117 @@ void ModulesSources::FindFileNames(Utility::string_view pattern, unsigned limit,
     pattern = uppercase;
 #endif
 
-    auto check = [&](const std::string& str)
+    std::lock_guard<std::mutex> lock(m_sourcesInfoMutex);
+    std::vector<PrefixIndex::match_t> matches;
+    m_fileNamesIndex.Find(pattern, limit, matches);
+    for (const auto &match : matches)
     {
-        if (limit == 0)
-            return false;
+#ifndef _WIN32
+        cb(match.name->c_str());
+#else
+        auto it = m_sourcePathToIndex.find(StringInterner::SourcePaths().Find(*match.name));
+        cb(it != m_sourcePathToIndex.end() ? m_sourceIndexToInitialFullPath[it->second].c_str() : match.name->c_str());
+#endif
+    }
+}
 
-        auto pos = str.find(pattern);
-        if (pos != std::string::npos && (pos == 0 || str[pos-1] == '/' || str[pos-1] == '\\'))
-        {
-            limit--;
+// Caller must care about m_sourcesInfoMutex.
+const char *ModulesSources::GetSourcePath(unsigned index)
+{
 #ifndef _WIN32
-            cb(str.c_str());
+    return m_sourceIndexToPath[index]->c_str();
 #else
-            auto it = m_sourcePathToIndex.find(str);
-            cb (it != m_sourcePathToIndex.end() ? m_sourceIndexToInitialFullPath[it->second].c_str() : str.c_str());
+    return m_sourceIndexToInitialFullPath[index].c_str();
 #endif
-        }
+}
 
-        return true;
-    };
+unsigned ModulesSources::GetSources(unsigned startIndex, unsigned count, std::function<void(const char *)> cb)
+{
+    std::lock_guard<std::mutex> lock(m_sourcesInfoMutex);
+    const size_t endIndex = std::min(m_sourceIndexToPath.size(), (size_t)startIndex + count);
+    for (size_t index = startIndex; index < endIndex; index++)
+    {
+        cb(GetSourcePath((unsigned)index));
+    }
 
+    return (unsigned)m_sourceIndexToPath.size();
+}
+
+void ModulesSources::TakeNewSources(std::function<void(const char *)> cb)
+{
     std::lock_guard<std::mutex> lock(m_sourcesInfoMutex);
-    for (const auto &pair : m_sourceNameToFullPathsIndexes)
+    for (; m_announcedSources < m_sourceIndexToPath.size(); m_announcedSources++)
     {
-        LOGD("first '%s'", pair.first.c_str());
-        if (!check(pair.first))
-            return;
+        cb(GetSourcePath(m_announcedSources));
+    }
+}
 
-        for (const unsigned fileIndex : pair.second)
+void ModulesSources::SearchSources(Utility::string_view pattern, unsigned limit, std::function<void(const char *)> cb)
+{
+#ifdef WIN32
+    std::string uppercase {pattern};
+    if (FAILED(Interop::StringToUpper(uppercase)))
+        return;
+    pattern = uppercase;
+#endif
+
+    std::lock_guard<std::mutex> lock(m_sourcesInfoMutex);
+    std::unordered_set<unsigned> provided;
+    auto provide = [&](unsigned index)
+    {
+        if (provided.size() < limit && provided.insert(index).second)
+            cb(GetSourcePath(index));
+    };
+    // Note, files names and full paths are stored in same index, file name match provide all full paths with this name.
+    auto provideName = [&](const std::string &name)
+    {
+        auto findName = m_sourceNameToFullPathsIndexes.find(name);
+        if (findName != m_sourceNameToFullPathsIndexes.end())
         {
-            LOGD("second '%s'", m_sourceIndexToPath[fileIndex].c_str());
-            if (!check(m_sourceIndexToPath[fileIndex]))
-                return;
+            for (unsigned index : findName->second)
+            {
+                provide(index);
+            }
+            return;
         }
+
+        auto findPath = m_sourcePathToIndex.find(StringInterner::SourcePaths().Find(name));
+        if (findPath != m_sourcePathToIndex.end())
+            provide(findPath->second);
+    };
+
+    std::vector<PrefixIndex::match_t> matches;
+    m_fileNamesIndex.Find(pattern, limit, matches);
+    for (const auto &match : matches)
+    {
+        provideName(*match.name);
+    }
+
+    if (provided.size() >= limit)
+        return;
+
+    // Note, unique files names are much less than full paths, so, scan through all names is fast enough for search request.
+    std::vector<std::pair<int, const std::string*>> fuzzyMatches;
+    for (const auto &entry : m_sourceNameToFullPathsIndexes)
+    {
+        const int score = FuzzyMatch::Score(pattern, entry.first);
+        if (score != FuzzyMatch::NoMatch)
+            fuzzyMatches.emplace_back(score, &entry.first);
+    }
+    std::sort(fuzzyMatches.begin(), fuzzyMatches.end(), [](const std::pair<int, const std::string*> &a, const std::pair<int, const std::string*> &b)
+    {
+        if (a.first != b.first)
+            return a.first > b.first;
+        if (a.second->size() != b.second->size())
+            return a.second->size() < b.second->size();
+        return *a.second < *b.second;
+    });
+    for (const auto &match : fuzzyMatches)
+    {
+        if (provided.size() >= limit)
+            break;
+
+        provideName(*match.second);
     }
 }
 
@@ -8,6 +8,7 @@
 #include "cordebug.h"
 
 #include <set>
+#include <string>
 #include <mutex>
 #include <functional>
 #include <unordered_set>
@@ -15,6 +16,9 @@
 #include <vector>
 #include "utils/string_view.h"
 #include "utils/torelease.h"
+#include "metadata/methods_index.h"
+#include "metadata/line_updates_table.h"
+#include "metadata/prefix_index.h"
 
 
 namespace netcoredbg
@@ -77,9 +81,23 @@ struct method_data_t_hash
 {
     size_t operator()(const method_data_t &p) const
     {
-        return p.methodDef + (uint32_t)p.startLine * 100 + (uint32_t)p.endLine * 1000;
+        // Note, constructors segments usually have close lines, mix all fields in order to avoid collisions.
+        uint64_t hash = ((uint64_t)(uint32_t)p.startLine << 32) | (uint32_t)p.endLine;
+        hash ^= ((uint64_t)(uint32_t)p.startColumn << 48) ^ ((uint64_t)(uint32_t)p.endColumn << 16) ^ p.methodDef;
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        return (size_t)hash;
     }
 };
+typedef std::unordered_map<method_data_t, std::vector<mdMethodDef>, method_data_t_hash> multi_methods_data_t;
+
+struct file_methods_ranges_t
+{
+    std::string document; // UTF-8 source full path, as it stored in PDB
+    std::vector<method_data_t> methodsData;
+};
+typedef std::vector<file_methods_ranges_t> module_methods_ranges_t;
 
 struct block_update_t
 {
@@ -92,17 +110,17 @@ struct block_update_t
 };
 typedef std::unordered_map<unsigned /*source fullPathIndex*/, std::vector<block_update_t>> src_block_updates_t;
 
-struct file_block_update_t
+// Delta PDB and line updates data, that don't depend on module state and could be loaded in parallel with metadata/IL delta apply.
+// Note, symbol reader handle ownership is moved to module at delta apply, in case delta was not applied, caller must dispose it.
+struct pdb_delta_t
 {
-    unsigned fullPathIndex;
-    int32_t newLine;
-    int32_t oldLine;
-    int32_t endLineOffset;
-    file_block_update_t(unsigned fullPathIndex_, int32_t newLine_, int32_t oldLine_, int32_t endLineOffset_) :
-        fullPathIndex(fullPathIndex_), newLine(newLine_), oldLine(oldLine_), endLineOffset(endLineOffset_)
-    {}
+    PVOID symbolReaderHandle;
+    std::unordered_set<mdMethodDef> methodTokens;
+    src_block_updates_t srcBlockUpdates;
+    pdb_delta_t() : symbolReaderHandle(nullptr) {}
 };
-typedef std::unordered_map<mdMethodDef, std::vector<file_block_update_t>> method_block_updates_t;
+
+typedef std::unordered_map<mdMethodDef, LineUpdatesTable> method_block_updates_t;
 
 template <class T>
 void LineUpdatesForwardCorrection(unsigned fullPathIndex, mdMethodDef methodToken, method_block_updates_t &methodBlockUpdates, T &block)
@@ -111,18 +129,12 @@ void LineUpdatesForwardCorrection(unsigned fullPathIndex, mdMethodDef methodToke
     if (findSourceUpdate == methodBlockUpdates.end())
         return;
 
-    for (const auto &entry : findSourceUpdate->second)
-    {
-        if (entry.fullPathIndex != fullPathIndex ||
-            entry.oldLine > block.startLine ||
-            entry.oldLine + entry.endLineOffset < block.startLine)
-            continue;
-
-        int32_t offset = entry.newLine - entry.oldLine;
-        block.startLine += offset;
-        block.endLine += offset;
-        break;
-    }
+    int32_t offset;
+    if (!findSourceUpdate->second.GetLineOffset(fullPathIndex, block.startLine, offset))
+        return;
+
+    block.startLine += offset;
+    block.endLine += offset;
 }
 
 class Modules;
@@ -149,6 +161,26 @@ public:
         {}
     };
 
+    struct resolve_bp_request_t
+    {
+        CORDB_ADDRESS modAddress; // optional, provide filter by module during resolve
+        std::string filename;
+        int sourceLine;
+
+        resolve_bp_request_t(CORDB_ADDRESS modAddress_, const std::string &filename_, int sourceLine_) :
+            modAddress(modAddress_),
+            filename(filename_),
+            sourceLine(sourceLine_)
+        {}
+    };
+
+    struct resolve_bp_result_t
+    {
+        HRESULT Status = E_FAIL;
+        unsigned fullname_index = 0;
+        std::vector<resolved_bp_t> resolvedPoints;
+    };
+
     HRESULT ResolveBreakpoint(
         /*in*/ Modules *pModules,
         /*in*/ CORDB_ADDRESS modAddress,
@@ -157,43 +189,82 @@ public:
         /*in*/ int sourceLine,
         /*out*/ std::vector<resolved_bp_t> &resolvedPoints);
 
-    HRESULT FillSourcesCodeLinesForModule(ICorDebugModule *pModule, IMetaDataImport *pMDImport, PVOID pSymbolReaderHandle);
+    // Resolve multiple breakpoints (could be in different sources) with one managed part call.
+    // Note, results have same indexes as requests, each result have its own status.
+    HRESULT ResolveBreakpoints(
+        /*in*/ Modules *pModules,
+        /*in*/ const std::vector<resolve_bp_request_t> &requests,
+        /*out*/ std::vector<resolve_bp_result_t> &results);
+
+    // In case of lazy indexing, methods data will be added at first breakpoint resolve for module's source.
+    // Note, pDocuments could be provided in case of lazy indexing, if module's documents was already loaded.
+    HRESULT FillSourcesCodeLinesForModule(ICorDebugModule *pModule, IMetaDataImport *pMDImport, PVOID pSymbolReaderHandle, bool lazyIndexing,
+                                          const std::vector<std::string> *pDocuments = nullptr);
     HRESULT GetSourceFullPathByIndex(unsigned index, std::string &fullPath);
     HRESULT GetIndexBySourceFullPath(std::string fullPath, unsigned &index);
-    HRESULT ApplyPdbDeltaAndLineUpdates(Modules *pModules, ICorDebugModule *pModule, bool needJMC, const std::string &deltaPDB,
-                                        const std::string &lineUpdates, std::unordered_set<mdMethodDef> &methodTokens);
+    // Check, which of requested sources (breakpoints paths, could be relative) module could have, by file name only.
+    // Aimed to skip breakpoints resolve for modules without related sources (most of modules at load).
+    // Note, `haveSources` have same indexes as `filenames`.
+    HRESULT FindModuleSources(CORDB_ADDRESS modAddress, const std::vector<std::string> &filenames, std::vector<bool> &haveSources);
+    HRESULT LoadPdbDeltaAndLineUpdates(const std::string &deltaPDB, const std::string &lineUpdates, pdb_delta_t &delta);
+    HRESULT ApplyPdbDeltaAndLineUpdates(Modules *pModules, ICorDebugModule *pModule, bool needJMC, pdb_delta_t &delta,
+                                        std::unordered_set<unsigned> &updatedSources);
 
     void FindFileNames(Utility::string_view pattern, unsigned limit, std::function<void(const char *)> cb);
+    // Loaded sources (documents full paths of all modules), sources indexes are stable, new sources are added at the end.
+    // Note, callbacks are called with sources lock held, so, paths are provided without copy. Return all sources count.
+    unsigned GetSources(unsigned startIndex, unsigned count, std::function<void(const char *)> cb);
+    // Provide sources added since previous call, aimed to notify protocol about new loaded sources incrementally.
+    void TakeNewSources(std::function<void(const char *)> cb);
+    // Search full paths for IDE "go to file": components prefix matches (see PrefixIndex) first, then files names fuzzy matches.
+    void SearchSources(Utility::string_view pattern, unsigned limit, std::function<void(const char *)> cb);
+    // Approximate heap memory size of sources tables (including interned full paths).
+    size_t GetMemoryUsage();
 
 private:
 
     struct FileMethodsData
     {
         CORDB_ADDRESS modAddress = 0;
-        // properly ordered on each nested level arrays of methods data
-        std::vector<std::vector<method_data_t>> methodsData;
-        // mapping method's data to array of tokens, that also represent same code
-        // aimed to resolve all methods token for constructor's segment, since it could be part of multiple constructors
-        std::unordered_map<method_data_t, std::vector<mdMethodDef>, method_data_t_hash> multiMethodsData;
+        // properly ordered on each nested level methods data with mapping method's data to array of tokens, that also represent same code
+        // (aimed to resolve all methods token for constructor's segment, since it could be part of multiple constructors)
+        MethodsIndex<method_data_t, mdMethodDef> methodsIndex;
     };
 
     // Note, breakpoints setup and ran debuggee's process could be in the same time.
     std::mutex m_sourcesInfoMutex;
     // Note, we only add to m_sourceIndexToPath/m_sourcePathToIndex/m_sourceIndexToInitialFullPath, "size()" used as index in map at new element add.
+    // Note, full paths are interned in StringInterner::SourcePaths(), so, same paths from all modules and sequence points
+    //       are stored once and full path (pointer) is used as key in m_sourcePathToIndex instead of string copy.
     // m_sourceIndexToPath - mapping index to full path
-    std::vector<std::string> m_sourceIndexToPath;
+    std::vector<const std::string*> m_sourceIndexToPath;
     // m_sourcePathToIndex - mapping full path to index
-    std::unordered_map<std::string, unsigned> m_sourcePathToIndex;
+    std::unordered_map<const std::string*, unsigned> m_sourcePathToIndex;
     // m_sourceNameToFullPathsIndexes - mapping file name to set of paths with this file name
     std::unordered_map<std::string, std::set<unsigned>> m_sourceNameToFullPathsIndexes;
+    // m_fileNamesIndex - all full paths and files names, aimed to find files names for completions
+    PrefixIndex m_fileNamesIndex{"/\\"};
     // m_sourcesMethodsData - all methods data indexed by full path, second vector hold data with same full path for different modules,
     //                        since we may have modules with same source full path
     std::vector<std::vector<FileMethodsData>> m_sourcesMethodsData;
+    // m_notIndexedModules - modules with lazy indexing, that have only documents data in m_sourcesMethodsData for now
+    std::unordered_set<CORDB_ADDRESS> m_notIndexedModules;
+    // m_requestPathToIndex - cache for resolved relative paths from breakpoints requests (resolved full path index or error),
+    //                        since relative path resolve depend on all known sources, cache cleared on each new source add
+    std::unordered_map<std::string, std::pair<HRESULT, unsigned>> m_requestPathToIndex;
+    // m_announcedSources - sources count, that was already provided by TakeNewSources()
+    unsigned m_announcedSources = 0;
 
     HRESULT GetFullPathIndex(BSTR document, unsigned &fullPathIndex);
+    const char *GetSourcePath(unsigned index);
+    HRESULT GetFullPathIndex(std::string fullPath, unsigned &fullPathIndex);
     HRESULT UpdateSourcesCodeLinesForModule(ICorDebugModule *pModule, IMetaDataImport *pMDImport, std::unordered_set<mdMethodDef> methodTokens,
-                                            src_block_updates_t &blockUpdates, ModuleInfo &mdInfo);
+                                            src_block_updates_t &blockUpdates, ModuleInfo &mdInfo, std::unordered_set<unsigned> &updatedSources);
     HRESULT ResolveRelativeSourceFileName(std::string &filename);
+    HRESULT FindSourceFullPathIndex(std::string filename, unsigned &fullPathIndex);
+    void IndexModulesForSource(Modules *pModules, CORDB_ADDRESS modAddress, unsigned fullPathIndex);
+    HRESULT AddModuleMethodsRanges(CORDB_ADDRESS modAddress, const module_methods_ranges_t &moduleRanges, bool lazyIndexed);
+    HRESULT IndexModuleMethodsRanges(Modules *pModules, CORDB_ADDRESS modAddress);
     HRESULT LineUpdatesForMethodData(ICorDebugModule *pModule, unsigned fullPathIndex, method_data_t &methodData,
                                      const std::vector<block_update_t> &blockUpdate, ModuleInfo &mdInfo);
 
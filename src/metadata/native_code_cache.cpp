@@ -0,0 +1,270 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/native_code_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace netcoredbg
+{
+
+const uint32_t native_code_t::NoMapping;
+const uint32_t native_code_t::Prolog;
+const uint32_t native_code_t::Epilog;
+const size_t NativeCodeCache::DefaultMaxMethods;
+
+namespace
+{
+
+    // Minimal instruction size, used for addresses of dummy instructions out of method's code.
+    uint64_t GetMinInstructionSize(native_code_t::InstructionSet set)
+    {
+        switch (set)
+        {
+            case native_code_t::InstructionSet::ARM64: return 4;
+            case native_code_t::InstructionSet::ARM:   return 2;
+            default:                                   return 1;
+        }
+    }
+
+    uint32_t ReadLE(const std::vector<uint8_t> &code, uint32_t offset, uint32_t size)
+    {
+        uint32_t value = 0;
+        for (uint32_t i = 0; i < size && offset + i < code.size(); i++)
+        {
+            value |= uint32_t(code[offset + i]) << (8 * i);
+        }
+        return value;
+    }
+
+    std::string GetILOffsetText(uint32_t ilOffset)
+    {
+        switch (ilOffset)
+        {
+            case native_code_t::NoMapping: return "";
+            case native_code_t::Prolog:    return "prolog: ";
+            case native_code_t::Epilog:    return "epilog: ";
+            default:
+                break;
+        }
+        char buffer[16];
+        snprintf(buffer, sizeof(buffer), "IL_%04x: ", ilOffset);
+        return buffer;
+    }
+
+} // unnamed namespace
+
+void native_code_t::DecodeInstructions(InstructionSet set)
+{
+    instructionSet = set;
+    instructions.clear();
+    std::sort(mapping.begin(), mapping.end(), [](const map_entry_t &a, const map_entry_t &b)
+    {
+        return a.nativeStartOffset < b.nativeStartOffset;
+    });
+
+    const uint32_t size = (uint32_t)code.size();
+    switch (set)
+    {
+        case InstructionSet::ARM64:
+            for (uint32_t offset = 0; offset < size; offset += 4)
+            {
+                instructions.emplace_back(offset);
+            }
+            break;
+
+        case InstructionSet::ARM:
+            for (uint32_t offset = 0; offset < size;)
+            {
+                instructions.emplace_back(offset);
+                // First halfword 0b11101, 0b11110 or 0b11111 in bits [15:11] mean 32-bit Thumb-2 instruction.
+                const uint32_t halfword = ReadLE(code, offset, 2);
+                offset += (halfword >> 11) >= 0x1D ? 4 : 2;
+            }
+            break;
+
+        default:
+            if (size == 0)
+                break;
+            instructions.emplace_back(0);
+            for (const auto &entry : mapping)
+            {
+                if (entry.nativeStartOffset < size)
+                    instructions.emplace_back(entry.nativeStartOffset);
+                if (entry.nativeEndOffset < size)
+                    instructions.emplace_back(entry.nativeEndOffset);
+            }
+            std::sort(instructions.begin(), instructions.end());
+            instructions.erase(std::unique(instructions.begin(), instructions.end()), instructions.end());
+            break;
+    }
+}
+
+bool native_code_t::FindInstruction(uint32_t nativeOffset, size_t &index) const
+{
+    if (nativeOffset >= code.size() || instructions.empty())
+        return false;
+
+    auto upper_bound = std::upper_bound(instructions.begin(), instructions.end(), nativeOffset);
+    index = size_t(std::prev(upper_bound) - instructions.begin());
+    return true;
+}
+
+uint32_t native_code_t::GetInstructionEnd(size_t index) const
+{
+    return index + 1 < instructions.size() ? instructions[index + 1] : (uint32_t)code.size();
+}
+
+uint32_t native_code_t::GetILOffset(uint32_t nativeOffset) const
+{
+    for (const auto &entry : mapping)
+    {
+        if (entry.nativeStartOffset > nativeOffset)
+            break;
+
+        if (nativeOffset < entry.nativeEndOffset)
+            return entry.ilOffset;
+    }
+    return NoMapping;
+}
+
+void native_code_t::Disassemble(uint64_t startAddress, int64_t instructionOffset, unsigned count, std::vector<instruction_t> &result) const
+{
+    const uint64_t stride = GetMinInstructionSize(instructionSet);
+    const int64_t instructionsCount = (int64_t)instructions.size();
+    const uint64_t endAddress = address + code.size();
+
+    // Virtual index of instruction, negative index and index after last instruction are dummy entries out of method's code.
+    int64_t index = 0;
+    size_t found = 0;
+    if (startAddress < address)
+        index = -(int64_t)((address - startAddress + stride - 1) / stride);
+    else if (startAddress >= endAddress)
+        index = instructionsCount + (int64_t)((startAddress - endAddress) / stride);
+    else if (FindInstruction(uint32_t(startAddress - address), found))
+        index = (int64_t)found;
+
+    index += instructionOffset;
+
+    result.reserve(result.size() + count);
+    for (unsigned i = 0; i < count; i++, index++)
+    {
+        instruction_t instruction;
+        instruction.ilOffset = NoMapping;
+        instruction.valid = index >= 0 && index < instructionsCount;
+
+        if (!instruction.valid)
+        {
+            const uint64_t distance = uint64_t(index < 0 ? -index : index - instructionsCount) * stride;
+            if (index < 0)
+                instruction.address = address >= distance ? address - distance : 0;
+            else
+                instruction.address = endAddress + distance;
+            instruction.text = "??";
+            result.emplace_back(std::move(instruction));
+            continue;
+        }
+
+        const uint32_t start = instructions[size_t(index)];
+        const uint32_t end = GetInstructionEnd(size_t(index));
+        instruction.address = address + start;
+        instruction.ilOffset = GetILOffset(start);
+
+        char buffer[32];
+        for (uint32_t offset = start; offset < end; offset++)
+        {
+            snprintf(buffer, sizeof(buffer), offset == start ? "%02x" : " %02x", code[offset]);
+            instruction.bytes += buffer;
+        }
+
+        switch (instructionSet)
+        {
+            case InstructionSet::ARM64:
+                snprintf(buffer, sizeof(buffer), ".inst 0x%08x", ReadLE(code, start, 4));
+                break;
+            case InstructionSet::ARM:
+                if (end - start == 4)
+                    snprintf(buffer, sizeof(buffer), ".inst.w 0x%04x%04x", ReadLE(code, start, 2), ReadLE(code, start + 2, 2));
+                else
+                    snprintf(buffer, sizeof(buffer), ".inst.n 0x%04x", ReadLE(code, start, 2));
+                break;
+            default:
+                snprintf(buffer, sizeof(buffer), "[%u bytes]", end - start);
+                break;
+        }
+        instruction.text = GetILOffsetText(instruction.ilOffset) + buffer;
+
+        result.emplace_back(std::move(instruction));
+    }
+}
+
+NativeCodeCache::entry_t NativeCodeCache::Find(uint64_t addr)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    auto upper_bound = m_cacheMap.upper_bound(addr);
+    if (upper_bound == m_cacheMap.begin())
+        return nullptr;
+
+    auto closest_lower = std::prev(upper_bound);
+    const entry_t &entry = *closest_lower->second;
+    if (addr >= entry->address + entry->code.size())
+        return nullptr;
+
+    m_lruList.splice(m_lruList.begin(), m_lruList, closest_lower->second);
+    return entry;
+}
+
+void NativeCodeCache::Put(entry_t entry)
+{
+    if (m_maxMethods == 0 || !entry)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    auto find = m_cacheMap.find(entry->address);
+    if (find != m_cacheMap.end())
+    {
+        *find->second = std::move(entry);
+        m_lruList.splice(m_lruList.begin(), m_lruList, find->second);
+        return;
+    }
+
+    if (m_cacheMap.size() >= m_maxMethods)
+    {
+        m_cacheMap.erase(m_lruList.back()->address);
+        m_lruList.pop_back();
+    }
+
+    const uint64_t address = entry->address;
+    m_lruList.emplace_front(std::move(entry));
+    m_cacheMap.emplace(address, m_lruList.begin());
+}
+
+void NativeCodeCache::InvalidateModule(uint64_t modAddress)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    for (auto it = m_lruList.begin(); it != m_lruList.end();)
+    {
+        if ((*it)->modAddress != modAddress)
+        {
+            ++it;
+            continue;
+        }
+
+        m_cacheMap.erase((*it)->address);
+        it = m_lruList.erase(it);
+    }
+}
+
+void NativeCodeCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_cacheMap.clear();
+    m_lruList.clear();
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,110 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <mutex>
+#include <memory>
+
+namespace netcoredbg
+{
+
+// JIT'ed code of one method version: code bytes, IL to native mapping and decoded instructions boundaries.
+// Note, native code start address identify code version, since re-JIT (tiered compilation, Hot Reload) always
+// provide new code at new address.
+struct native_code_t
+{
+    // Same as CorDebugIlToNativeMappingTypes.
+    static const uint32_t NoMapping = 0xffffffff;
+    static const uint32_t Prolog = 0xfffffffe;
+    static const uint32_t Epilog = 0xfffffffd;
+
+    enum class InstructionSet
+    {
+        Unknown,
+        X86,
+        AMD64,
+        ARM,    // Thumb-2, JIT generate Thumb code only.
+        ARM64
+    };
+
+    struct map_entry_t
+    {
+        uint32_t ilOffset;
+        uint32_t nativeStartOffset;
+        uint32_t nativeEndOffset;
+    };
+
+    struct instruction_t
+    {
+        uint64_t address;
+        std::string bytes; // hex, space separated
+        std::string text;
+        uint32_t ilOffset;
+        bool valid; // false for dummy entries out of method's code
+    };
+
+    uint64_t modAddress = 0;
+    uint32_t methodToken = 0;
+    uint32_t methodVersion = 0; // IL code version (Hot Reload), in order to find sequence points
+    uint64_t address = 0;
+    std::vector<uint8_t> code;
+    std::vector<map_entry_t> mapping; // sorted by native start offset
+    // Native offsets of all instructions starts, sorted. Note, there is no disassembler for variable length instruction sets
+    // (x86 and AMD64), IL to native mapping ranges are used as "instructions" in this case.
+    std::vector<uint32_t> instructions;
+    InstructionSet instructionSet = InstructionSet::Unknown;
+
+    // Must be called after `code` and `mapping` initialization, `mapping` will be sorted.
+    void DecodeInstructions(InstructionSet set);
+    // Return false in case offset out of code.
+    bool FindInstruction(uint32_t nativeOffset, size_t &index) const;
+    uint32_t GetInstructionEnd(size_t index) const;
+    // Return NoMapping in case no mapping for this offset.
+    uint32_t GetILOffset(uint32_t nativeOffset) const;
+    // Provide `count` instructions starting from instruction with `address` shifted by `instructionOffset` (could be negative).
+    // Same as DAP `disassemble` request, out of code addresses provided as not valid instructions, so, `count` entries always provided.
+    void Disassemble(uint64_t address, int64_t instructionOffset, unsigned count, std::vector<instruction_t> &result) const;
+};
+
+// Bounded LRU cache of methods native code, aimed to avoid code read and mapping requests (both are DAC calls) for
+// same methods during disassemble requests and instruction stepping.
+class NativeCodeCache
+{
+public:
+
+    typedef std::shared_ptr<const native_code_t> entry_t;
+
+    static const size_t DefaultMaxMethods = 256;
+
+    NativeCodeCache(size_t maxMethods = DefaultMaxMethods) :
+        m_maxMethods(maxMethods)
+    {}
+
+    // Return nullptr in case no code that contain `addr` in cache.
+    entry_t Find(uint64_t addr);
+    void Put(entry_t entry);
+    // Remove all module's methods code (module unload or Hot Reload delta applied).
+    void InvalidateModule(uint64_t modAddress);
+    void Clear();
+
+private:
+
+    typedef std::list<entry_t> lru_list_t;
+
+    std::mutex m_cacheMutex;
+    size_t m_maxMethods;
+    // m_lruList - most recently used first
+    lru_list_t m_lruList;
+    // Code start address is `key`.
+    std::map<uint64_t, lru_list_t::iterator> m_cacheMap;
+};
+
+} // namespace netcoredbg
@@ -0,0 +1,128 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/prefix_index.h"
+
+#include <algorithm>
+#include "utils/memory_size.h"
+
+namespace netcoredbg
+{
+
+void PrefixIndex::Add(std::string name)
+{
+    uint32_t nameIndex = (uint32_t)m_names.size();
+    m_entries.push_back({nameIndex, 0});
+    for (size_t i = 0; i + 1 < name.size(); i++)
+    {
+        if (m_separators.find(name[i]) != std::string::npos)
+            m_entries.push_back({nameIndex, (uint32_t)(i + 1)});
+    }
+    m_names.emplace_back(std::move(name));
+}
+
+void PrefixIndex::Clear()
+{
+    m_names.clear();
+    m_entries.clear();
+    m_sortedCount = 0;
+}
+
+size_t PrefixIndex::GetMemoryUsage() const
+{
+    size_t size = MemorySize::Vector(m_names) + MemorySize::Vector(m_entries);
+    for (const auto &name : m_names)
+    {
+        size += MemorySize::String(name);
+    }
+    return size;
+}
+
+Utility::string_view PrefixIndex::GetSuffix(const entry_t &entry) const
+{
+    const std::string &name = m_names[entry.nameIndex];
+    return Utility::string_view(name.data() + entry.offset, name.size() - entry.offset);
+}
+
+// Name could have same pattern at several components, count only first one (best ranked).
+bool PrefixIndex::IsFirstMatch(const entry_t &entry, Utility::string_view pattern) const
+{
+    const std::string &name = m_names[entry.nameIndex];
+    for (size_t start = 0; start < entry.offset; )
+    {
+        if (name.compare(start, pattern.size(), pattern.data(), pattern.size()) == 0)
+            return false;
+
+        start = name.find_first_of(m_separators, start);
+        if (start == std::string::npos)
+            break;
+        start++;
+    }
+    return true;
+}
+
+void PrefixIndex::MergePending()
+{
+    if (m_sortedCount == m_entries.size())
+        return;
+
+    auto suffixLess = [&](const entry_t &a, const entry_t &b) { return GetSuffix(a) < GetSuffix(b); };
+    auto pendingBegin = m_entries.begin() + m_sortedCount;
+    std::sort(pendingBegin, m_entries.end(), suffixLess);
+    std::inplace_merge(m_entries.begin(), pendingBegin, m_entries.end(), suffixLess);
+    m_sortedCount = m_entries.size();
+}
+
+bool PrefixIndex::RankedBefore(const match_t &a, const match_t &b)
+{
+    if ((a.offset == 0) != (b.offset == 0))
+        return a.offset == 0;
+
+    if (a.name->size() != b.name->size())
+        return a.name->size() < b.name->size();
+
+    return *a.name < *b.name;
+}
+
+void PrefixIndex::Find(Utility::string_view pattern, size_t limit, std::vector<match_t> &result)
+{
+    if (limit == 0)
+        return;
+
+    MergePending();
+
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), pattern,
+                               [&](const entry_t &entry, Utility::string_view value) { return GetSuffix(entry) < value; });
+
+    // Note, all matched entries are placed in one row, keep only `limit` best ranked matches in heap
+    // (the worst one at the top), so, we don't collect all matched names for short patterns.
+    std::vector<match_t> heap;
+    for (; it != m_entries.end(); ++it)
+    {
+        if (!GetSuffix(*it).starts_with(pattern))
+            break;
+
+        if (!IsFirstMatch(*it, pattern))
+            continue;
+
+        match_t match {&m_names[it->nameIndex], it->offset};
+        if (heap.size() == limit)
+        {
+            if (!RankedBefore(match, heap.front()))
+                continue;
+
+            std::pop_heap(heap.begin(), heap.end(), RankedBefore);
+            heap.back() = match;
+        }
+        else
+            heap.push_back(match);
+
+        std::push_heap(heap.begin(), heap.end(), RankedBefore);
+    }
+
+    std::sort_heap(heap.begin(), heap.end(), RankedBefore);
+    result.insert(result.end(), heap.begin(), heap.end());
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,68 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "utils/string_view.h"
+
+namespace netcoredbg
+{
+
+// Sorted index of names suffixes, that start at name's components (name start and each position after separator),
+// aimed to find names with component prefix match by binary search instead of scan through all names.
+// For example, with "." separator "NS.Class.Method" could be found by "NS", "Cla" or "Method.".
+// Note, index is not thread safe, caller must care about synchronization.
+class PrefixIndex
+{
+public:
+
+    struct match_t
+    {
+        const std::string *name;
+        uint32_t offset; // first matched component start in name
+    };
+
+    explicit PrefixIndex(const char *separators) :
+        m_separators(separators),
+        m_sortedCount(0)
+    {}
+
+    // Note, names are not checked for duplicates, caller must care about this.
+    // New entries are collected as pending and merged into sorted entries at next Find() call.
+    void Add(std::string name);
+    void Clear();
+    size_t Size() const { return m_names.size(); }
+    // Approximate heap memory size.
+    size_t GetMemoryUsage() const;
+
+    // Append up to limit best ranked matches to result, one per name. Note, result is not ranked with already stored data.
+    void Find(Utility::string_view pattern, size_t limit, std::vector<match_t> &result);
+
+    // Ranking: whole name prefix match first, then shorter names, then lexicographical order.
+    static bool RankedBefore(const match_t &a, const match_t &b);
+
+private:
+
+    struct entry_t
+    {
+        uint32_t nameIndex;
+        uint32_t offset;
+    };
+
+    std::string m_separators;
+    std::vector<std::string> m_names;
+    // m_entries - [0, m_sortedCount) entries sorted by suffix, all other entries are pending
+    std::vector<entry_t> m_entries;
+    size_t m_sortedCount;
+
+    Utility::string_view GetSuffix(const entry_t &entry) const;
+    bool IsFirstMatch(const entry_t &entry, Utility::string_view pattern) const;
+    void MergePending();
+};
+
+} // namespace netcoredbg
@@ -0,0 +1,169 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/resolved_bp_cache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include "utils/disk_cache.h"
+#include "utils/logger.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+    const char cacheMagic[8] = {'N', 'C', 'D', 'B', 'R', 'B', 'C', '\0'};
+
+    using DiskCacheFormat::ReadData;
+    using DiskCacheFormat::ReadValue;
+    using DiskCacheFormat::ReadString;
+    using DiskCacheFormat::WriteValue;
+    using DiskCacheFormat::WriteString;
+
+    // Module ID is used as file name, allow only MVID symbols.
+    bool IsValidModuleId(const std::string &moduleId)
+    {
+        if (moduleId.empty())
+            return false;
+
+        for (char c : moduleId)
+        {
+            if (!isxdigit((unsigned char)c) && c != '-')
+                return false;
+        }
+        return true;
+    }
+
+    DiskCache &GetCache()
+    {
+        static DiskCache cache("breakpoints", "netcoredbg-breakpoints-cache", ".bps", "BreakpointsCacheWriter",
+                               std::numeric_limits<uint64_t>::max(), ResolvedBreakpointsCache::MaxModules);
+        return cache;
+    }
+} // unnamed namespace
+
+const uint32_t ResolvedBreakpointsCache::FormatVersion;
+const size_t ResolvedBreakpointsCache::MaxModules;
+const size_t ResolvedBreakpointsCache::MaxModuleBreakpoints;
+
+void ResolvedBreakpointsCache::SetOptions(bool enable, const std::string &dir)
+{
+    GetCache().SetOptions(enable, dir, std::numeric_limits<uint64_t>::max());
+}
+
+bool ResolvedBreakpointsCache::IsEnabled()
+{
+    return GetCache().IsEnabled();
+}
+
+bool ResolvedBreakpointsCache::Load(const std::string &moduleId, module_entries_t &entries)
+{
+    std::string entryPath;
+    if (!IsValidModuleId(moduleId) || !GetCache().Lookup(moduleId, entryPath))
+        return false;
+
+    // Note, entry is read without cache lock, since published entry never changed (only replaced by rename or removed).
+    std::ifstream file(entryPath, std::ios::binary);
+    if (!file)
+        return false;
+
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const char *ptr = data.data();
+    const char *end = ptr + data.size();
+    char magic[sizeof(cacheMagic)];
+    uint32_t version = 0;
+    uint32_t count = 0;
+    if (!ReadData(ptr, end, magic, sizeof(magic)) || memcmp(magic, cacheMagic, sizeof(cacheMagic)) != 0 ||
+        !ReadValue(ptr, end, version) || version != FormatVersion ||
+        !ReadValue(ptr, end, count) || count > MaxModuleBreakpoints)
+    {
+        LOGW("Breakpoints cache entry %s have wrong format, ignored", moduleId.c_str());
+        return false;
+    }
+
+    entries.clear();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        std::string filename;
+        int32_t line = 0;
+        entry_t entry;
+        uint32_t pointsNum = 0;
+        // Check sizes against rest of file first, since we can't trust data from disk.
+        if (!ReadString(ptr, end, filename) ||
+            !ReadValue(ptr, end, line) ||
+            !ReadString(ptr, end, entry.fullname) ||
+            !ReadValue(ptr, end, entry.startLine) ||
+            !ReadValue(ptr, end, entry.endLine) ||
+            !ReadValue(ptr, end, pointsNum) || (uint64_t)pointsNum * sizeof(point_t) > size_t(end - ptr))
+        {
+            LOGW("Breakpoints cache entry %s have wrong format, ignored", moduleId.c_str());
+            entries.clear();
+            return false;
+        }
+        entry.points.resize(pointsNum);
+        for (auto &point : entry.points)
+        {
+            ReadValue(ptr, end, point.methodToken);
+            ReadValue(ptr, end, point.ilOffset);
+        }
+        entries.emplace(std::make_pair(std::move(filename), line), std::move(entry));
+    }
+
+    return true;
+}
+
+void ResolvedBreakpointsCache::Store(const std::string &moduleId, const module_entries_t &entries)
+{
+    if (!IsValidModuleId(moduleId))
+        return;
+
+    if (entries.empty())
+    {
+        GetCache().Remove(moduleId);
+        return;
+    }
+
+    // Note, entries over limit are not stored, so, cache file size for module is limited.
+    const uint32_t count = (uint32_t)std::min(entries.size(), MaxModuleBreakpoints);
+    std::ostringstream out;
+    out.write(cacheMagic, sizeof(cacheMagic));
+    WriteValue(out, FormatVersion);
+    WriteValue(out, count);
+    auto it = entries.begin();
+    for (uint32_t i = 0; i < count; i++, ++it)
+    {
+        WriteString(out, it->first.first);
+        WriteValue(out, it->first.second);
+        WriteString(out, it->second.fullname);
+        WriteValue(out, it->second.startLine);
+        WriteValue(out, it->second.endLine);
+        WriteValue(out, (uint32_t)it->second.points.size());
+        for (const auto &point : it->second.points)
+        {
+            WriteValue(out, point.methodToken);
+            WriteValue(out, point.ilOffset);
+        }
+    }
+
+    const std::string data = out.str();
+    GetCache().Store(moduleId, data.size(), [&](std::ostream &file) { file.write(data.data(), data.size()); });
+}
+
+void ResolvedBreakpointsCache::StoreAsync(const std::string &moduleId, const module_entries_t &entries)
+{
+    if (!IsEnabled())
+        return;
+
+    auto data = std::make_shared<module_entries_t>(entries);
+    GetCache().Post([moduleId, data]() { Store(moduleId, *data); });
+}
+
+} // namespace netcoredbg
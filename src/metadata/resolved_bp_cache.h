@@ -0,0 +1,66 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <cstdint>
+
+namespace netcoredbg
+{
+
+// On-disk cache for line breakpoints resolve results from previous debug sessions. Line breakpoint resolve need module's
+// methods ranges (PDB walk in managed part or methods ranges cache load), that delay first breakpoints in code executed
+// at start. Resolve result (method tokens and IL offsets) depend only on module metadata and PDB, so, it could be reused
+// for module with same MVID. Note, debugger must verify cached result by real resolve later, since MVID may stay same
+// in case of not deterministic build with changed PDB only.
+// Each module stored in separate file named by module MVID, entries are published by rename and never changed in place (see DiskCache).
+class ResolvedBreakpointsCache
+{
+public:
+
+    // Increase in case of any changes in stored data format.
+    static const uint32_t FormatVersion = 1;
+    static const size_t MaxModules = 256;
+    static const size_t MaxModuleBreakpoints = 1024;
+
+    struct point_t
+    {
+        uint32_t methodToken;
+        uint32_t ilOffset;
+
+        bool operator == (const point_t &other) const
+        {
+            return methodToken == other.methodToken && ilOffset == other.ilOffset;
+        }
+    };
+
+    struct entry_t
+    {
+        std::string fullname; // resolved source full path
+        int32_t startLine = 0;
+        int32_t endLine = 0;
+        std::vector<point_t> points;
+    };
+
+    // (breakpoint's source path as provided by protocol, breakpoint's line) -> resolve result.
+    typedef std::map<std::pair<std::string, int32_t>, entry_t> module_entries_t;
+
+    // Should be called before any debug session start, default - enabled, temp directory.
+    static void SetOptions(bool enable, const std::string &dir);
+    static bool IsEnabled();
+
+    // Return `true` in case data for module found and successfully loaded.
+    static bool Load(const std::string &moduleId, module_entries_t &entries);
+    // Note, empty entries remove module's data from cache.
+    static void Store(const std::string &moduleId, const module_entries_t &entries);
+    // Same as Store(), but data is written by cache writer thread, so, caller's locks are not held during disk write.
+    static void StoreAsync(const std::string &moduleId, const module_entries_t &entries);
+
+};
+
+} // namespace netcoredbg
@@ -0,0 +1,187 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/sequence_points_cache.h"
+#include "utils/memory_size.h"
+#include <limits>
+
+namespace netcoredbg
+{
+
+const int32_t method_sequence_points_t::HiddenLine;
+const size_t SequencePointsCache::DefaultMaxMethods;
+std::atomic<size_t> SequencePointsCache::m_defaultMaxMethods(SequencePointsCache::DefaultMaxMethods);
+
+template <typename T>
+static T Saturate(int64_t value)
+{
+    if (value < int64_t(std::numeric_limits<T>::min()))
+        return std::numeric_limits<T>::min();
+    if (value > int64_t(std::numeric_limits<T>::max()))
+        return std::numeric_limits<T>::max();
+    return T(value);
+}
+
+method_sequence_points_t::point_t::point_t(int32_t startLine, int32_t startColumn, int32_t endLine, int32_t endColumn,
+                                           uint32_t offset, int32_t documentIndex) :
+    startLine(startLine),
+    offset(offset),
+    // Note, hidden points have same start and end lines, end line before start line is not valid.
+    endLineDelta(Saturate<line_delta_t>(endLine > startLine ? int64_t(endLine) - startLine : 0)),
+    startColumn(Saturate<column_t>(startColumn)),
+    endColumn(Saturate<column_t>(endColumn)),
+    documentIndex(documentIndex <= std::numeric_limits<document_index_t>::max() ? document_index_t(documentIndex) : -1)
+{}
+
+void SequencePointsCache::SetOptions(size_t maxMethods)
+{
+    m_defaultMaxMethods = maxMethods;
+}
+
+bool method_sequence_points_t::GetSequencePointByILOffset(uint32_t ilOffset, point_t &sequencePoint) const
+{
+    bool found = false;
+
+    for (const auto &point : points)
+    {
+        if (found && point.offset > ilOffset)
+            break;
+
+        if (point.IsUserCode())
+        {
+            sequencePoint = point;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+bool method_sequence_points_t::GetNextUserCodeILOffset(uint32_t ilOffset, uint32_t &ilNextOffset, bool *noUserCodeFound) const
+{
+    for (const auto &point : points)
+    {
+        if (!point.IsUserCode())
+            continue;
+
+        if (point.offset >= ilOffset)
+        {
+            ilNextOffset = point.offset;
+            if (noUserCodeFound)
+                *noUserCodeFound = false;
+            return true;
+        }
+    }
+
+    if (noUserCodeFound)
+        *noUserCodeFound = true;
+    return false;
+}
+
+bool method_sequence_points_t::GetStepRangesFromIP(uint32_t ip, uint32_t &ilStartOffset, uint32_t &ilEndOffset) const
+{
+    if (points.empty())
+        return false;
+
+    size_t endIndex = points.size();
+    for (size_t i = 1; i < points.size(); i++)
+    {
+        if (points[i].offset > ip && points[i].IsUserCode())
+        {
+            endIndex = i;
+            break;
+        }
+    }
+
+    ilStartOffset = points[0].offset;
+    for (size_t j = endIndex - 1; j > 0; j--)
+    {
+        if (points[j].offset <= ip)
+        {
+            ilStartOffset = points[j].offset;
+            break;
+        }
+    }
+
+    // In case of last step range from last sequence point till end of the method, ilEndOffset should be set to IL code size in calling code.
+    ilEndOffset = endIndex == points.size() ? ilStartOffset : points[endIndex].offset;
+    return true;
+}
+
+SequencePointsCache::entry_t SequencePointsCache::Get(uint64_t modAddress, uint32_t methodToken, uint32_t methodVersion)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    auto find = m_cacheMap.find(key_t{modAddress, methodToken, methodVersion});
+    if (find == m_cacheMap.end())
+        return nullptr;
+
+    m_lruList.splice(m_lruList.begin(), m_lruList, find->second);
+    return find->second->second;
+}
+
+void SequencePointsCache::Put(uint64_t modAddress, uint32_t methodToken, uint32_t methodVersion, entry_t entry)
+{
+    if (m_maxMethods == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    const key_t key{modAddress, methodToken, methodVersion};
+    auto find = m_cacheMap.find(key);
+    if (find != m_cacheMap.end())
+    {
+        find->second->second = std::move(entry);
+        m_lruList.splice(m_lruList.begin(), m_lruList, find->second);
+        return;
+    }
+
+    if (m_cacheMap.size() >= m_maxMethods)
+    {
+        m_cacheMap.erase(m_lruList.back().first);
+        m_lruList.pop_back();
+    }
+
+    m_lruList.emplace_front(key, std::move(entry));
+    m_cacheMap.emplace(key, m_lruList.begin());
+}
+
+void SequencePointsCache::InvalidateModule(uint64_t modAddress)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    for (auto it = m_lruList.begin(); it != m_lruList.end();)
+    {
+        if (it->first.modAddress != modAddress)
+        {
+            ++it;
+            continue;
+        }
+
+        m_cacheMap.erase(it->first);
+        it = m_lruList.erase(it);
+    }
+}
+
+size_t SequencePointsCache::GetMemoryUsage()
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    size_t size = MemorySize::ListNodes(m_lruList) + MemorySize::HashNodes(m_cacheMap);
+    for (const auto &entry : m_lruList)
+    {
+        if (entry.second)
+            size += sizeof(method_sequence_points_t) + MemorySize::Vector(entry.second->documents) + MemorySize::Vector(entry.second->points);
+    }
+    return size;
+}
+
+void SequencePointsCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_cacheMap.clear();
+    m_lruList.clear();
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,133 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <list>
+#include <mutex>
+#include <memory>
+#include <unordered_map>
+
+namespace netcoredbg
+{
+
+// Decoded sequence points of one method version (all points in IL offsets order, including hidden).
+struct method_sequence_points_t
+{
+    // Same as Interop::HiddenLine.
+    static const int32_t HiddenLine = 0xfeefee;
+
+#ifdef NCDB_EMBEDDED_PROFILE
+    // Note, embedded profile use 16 bytes per point (instead of 24): end line is stored as delta from start line,
+    // columns and deltas are saturated at 65535, documents indexes over 32767 are stored as -1 (no document).
+    typedef uint16_t column_t;
+    typedef uint16_t line_delta_t;
+    typedef int16_t document_index_t;
+#else
+    typedef int32_t column_t;
+    typedef uint32_t line_delta_t;
+    typedef int32_t document_index_t;
+#endif
+
+    struct point_t
+    {
+        int32_t startLine;
+        uint32_t offset;
+        line_delta_t endLineDelta;
+        column_t startColumn;
+        column_t endColumn;
+        document_index_t documentIndex; // index in documents, -1 in case point don't have document
+
+        point_t() : startLine(0), offset(0), endLineDelta(0), startColumn(0), endColumn(0), documentIndex(-1) {}
+        point_t(int32_t startLine, int32_t startColumn, int32_t endLine, int32_t endColumn, uint32_t offset, int32_t documentIndex);
+
+        int32_t EndLine() const { return startLine + int32_t(endLineDelta); }
+        bool IsUserCode() const { return startLine != 0 && startLine != HiddenLine; }
+    };
+
+    std::vector<const std::string*> documents; // UTF-8 sources full paths, interned in StringInterner::SourcePaths()
+    std::vector<point_t> points;
+
+    // Same logic as SymbolReader.GetSequencePointByILOffset() provide.
+    bool GetSequencePointByILOffset(uint32_t ilOffset, point_t &sequencePoint) const;
+    // Same logic as SymbolReader.GetNextUserCodeILOffset() provide.
+    bool GetNextUserCodeILOffset(uint32_t ilOffset, uint32_t &ilNextOffset, bool *noUserCodeFound) const;
+    // Same logic as SymbolReader.GetStepRangesFromIP() provide.
+    bool GetStepRangesFromIP(uint32_t ip, uint32_t &ilStartOffset, uint32_t &ilEndOffset) const;
+};
+
+// Bounded LRU cache of methods sequence points, aimed to avoid managed part calls (and sequence points blob decoding)
+// for same methods during stepping and stack trace requests.
+class SequencePointsCache
+{
+public:
+
+    typedef std::shared_ptr<const method_sequence_points_t> entry_t;
+
+    static const size_t DefaultMaxMethods = 1024;
+
+    // Set max methods for caches created after this call (default - DefaultMaxMethods), should be called before any
+    // debug session start.
+    static void SetOptions(size_t maxMethods);
+
+    SequencePointsCache() :
+        m_maxMethods(m_defaultMaxMethods)
+    {}
+
+    SequencePointsCache(size_t maxMethods) :
+        m_maxMethods(maxMethods)
+    {}
+
+    // Return nullptr in case no data in cache.
+    entry_t Get(uint64_t modAddress, uint32_t methodToken, uint32_t methodVersion);
+    void Put(uint64_t modAddress, uint32_t methodToken, uint32_t methodVersion, entry_t entry);
+    // Remove all module's methods data (for example, in case of Hot Reload delta applied).
+    void InvalidateModule(uint64_t modAddress);
+    // Approximate heap memory size, documents paths are interned and not included.
+    size_t GetMemoryUsage();
+    void Clear();
+
+private:
+
+    struct key_t
+    {
+        uint64_t modAddress;
+        uint32_t methodToken;
+        uint32_t methodVersion;
+
+        bool operator == (const key_t &other) const
+        {
+            return modAddress == other.modAddress && methodToken == other.methodToken && methodVersion == other.methodVersion;
+        }
+    };
+
+    struct key_t_hash
+    {
+        size_t operator()(const key_t &key) const
+        {
+            uint64_t hash = key.modAddress ^ ((uint64_t)key.methodVersion << 32) ^ key.methodToken;
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdULL;
+            hash ^= hash >> 33;
+            return (size_t)hash;
+        }
+    };
+
+    typedef std::list<std::pair<key_t, entry_t>> lru_list_t;
+
+    static std::atomic<size_t> m_defaultMaxMethods;
+
+    std::mutex m_cacheMutex;
+    size_t m_maxMethods;
+    // m_lruList - most recently used first
+    lru_list_t m_lruList;
+    std::unordered_map<key_t, lru_list_t::iterator, key_t_hash> m_cacheMap;
+};
+
+} // namespace netcoredbg
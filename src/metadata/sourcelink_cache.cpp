@@ -0,0 +1,176 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/sourcelink_cache.h"
+
+#include <fstream>
+#include "utils/filesystem.h"
+
+namespace netcoredbg
+{
+
+const unsigned SourceLinkCache::MaxWorkersCount;
+const unsigned SourceLinkCache::DefaultPrefetchFrames;
+
+static bool IsFileExist(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return file.good();
+}
+
+SourceLinkCache::~SourceLinkCache()
+{
+    Cancel();
+}
+
+void SourceLinkCache::SetDir(const std::string &dir)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_dir = dir;
+    // Note, failed downloads could be available in new cache.
+    for (auto it = m_tasks.begin(); it != m_tasks.end();)
+    {
+        if (it->second.state == State::Failed)
+            it = m_tasks.erase(it);
+        else
+            ++it;
+    }
+}
+
+std::string SourceLinkCache::GetFilePath(const std::string &contentKey, const std::string &fileName)
+{
+    if (m_dir.empty() || contentKey.empty())
+        return std::string();
+
+    // Note, file name provided by PDB, don't allow it point out of cache directory.
+    std::string name = fileName;
+    if (name.empty() || name == "." || name == ".." || name.find_first_of("/\\") != std::string::npos)
+        name = "source";
+
+    std::string path = m_dir;
+    if (path.back() != '/' && path.back() != '\\')
+        path += FileSystem::PathSeparator;
+    return path + contentKey + FileSystem::PathSeparator + name;
+}
+
+void SourceLinkCache::Prefetch(const std::string &url, const std::string &contentKey, const std::string &fileName)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::string filePath = GetFilePath(contentKey, fileName);
+    if (filePath.empty() || m_tasks.find(filePath) != m_tasks.end() || IsFileExist(filePath))
+        return;
+
+    m_cancel = false;
+    m_tasks[filePath].url = url;
+    m_queue.emplace_back(filePath);
+
+    if (m_idleWorkers > 0 || m_workers.size() >= MaxWorkersCount)
+    {
+        m_queueCV.notify_one();
+        return;
+    }
+
+    m_workers.emplace_back(&SourceLinkCache::Worker, this);
+}
+
+bool SourceLinkCache::Get(const std::string &url, const std::string &contentKey, const std::string &fileName, std::string &filePath)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    filePath = GetFilePath(contentKey, fileName);
+    if (filePath.empty())
+        return false;
+
+    auto find = m_tasks.find(filePath);
+    if (find == m_tasks.end())
+    {
+        if (IsFileExist(filePath))
+            return true;
+
+        m_tasks[filePath].state = State::Downloading;
+        lock.unlock();
+        bool succeeded = m_downloadCallback(url, filePath);
+        lock.lock();
+        Done(filePath, succeeded);
+        return succeeded;
+    }
+
+    if (find->second.state == State::Queued)
+    {
+        // Note, don't wait for workers, download in caller's thread.
+        m_queue.remove(filePath);
+        find->second.state = State::Downloading;
+        lock.unlock();
+        bool succeeded = m_downloadCallback(url, filePath);
+        lock.lock();
+        Done(filePath, succeeded);
+        return succeeded;
+    }
+
+    m_doneCV.wait(lock, [&]()
+    {
+        auto task = m_tasks.find(filePath);
+        return task == m_tasks.end() || task->second.state != State::Downloading;
+    });
+    return m_tasks.find(filePath) == m_tasks.end();
+}
+
+void SourceLinkCache::Done(const std::string &filePath, bool succeeded)
+{
+    if (succeeded)
+        m_tasks.erase(filePath);
+    else
+        m_tasks[filePath].state = State::Failed;
+    m_doneCV.notify_all();
+}
+
+void SourceLinkCache::Worker()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_idleWorkers++;
+        m_queueCV.wait(lock, [&]() { return m_cancel || !m_queue.empty(); });
+        m_idleWorkers--;
+        if (m_cancel)
+            return;
+
+        std::string filePath = m_queue.front();
+        m_queue.pop_front();
+        auto find = m_tasks.find(filePath);
+        if (find == m_tasks.end() || find->second.state != State::Queued)
+            continue;
+
+        find->second.state = State::Downloading;
+        std::string url = find->second.url;
+        lock.unlock();
+
+        bool succeeded = m_downloadCallback(url, filePath);
+
+        lock.lock();
+        Done(filePath, succeeded);
+    }
+}
+
+void SourceLinkCache::Cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cancel = true;
+        for (const auto &filePath : m_queue)
+        {
+            m_tasks.erase(filePath);
+        }
+        m_queue.clear();
+        m_queueCV.notify_all();
+    }
+
+    for (auto &worker : m_workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    m_workers.clear();
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,81 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <list>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <unordered_map>
+
+namespace netcoredbg
+{
+
+// Local content-addressed cache for sources downloaded by SourceLink URLs, file path is `<dir>/<content key>/<file name>`,
+// where content key is document checksum from PDB, so, same document version is downloaded once and could be shared by
+// debugger instances on host. Downloads are done by bounded worker pool, so, sources for stack frames could be prefetched
+// at stop and client's source request answered from disk.
+class SourceLinkCache
+{
+public:
+
+    // Blocking download of `url` content into `filePath`, must create directories and write file atomically.
+    typedef std::function<bool(const std::string &url, const std::string &filePath)> DownloadCallback;
+
+    static const unsigned MaxWorkersCount = 4;
+    static const unsigned DefaultPrefetchFrames = 5;
+
+    SourceLinkCache(DownloadCallback cb) :
+        m_downloadCallback(cb)
+    {}
+    ~SourceLinkCache();
+
+    void SetDir(const std::string &dir);
+    // Queue download in case file is not cached, not queued and not failed before.
+    void Prefetch(const std::string &url, const std::string &contentKey, const std::string &fileName);
+    // Return cached file path. In case download is queued or in progress, wait for result, in case file is not cached
+    // and not queued, download it in caller's thread. Note, failed downloads are not repeated.
+    bool Get(const std::string &url, const std::string &contentKey, const std::string &fileName, std::string &filePath);
+    // Clear queue and wait for all worker threads.
+    void Cancel();
+
+private:
+
+    enum class State
+    {
+        Queued,
+        Downloading,
+        Failed
+    };
+
+    struct Task
+    {
+        State state = State::Queued;
+        std::string url;
+    };
+
+    DownloadCallback m_downloadCallback;
+    std::mutex m_mutex;
+    std::condition_variable m_queueCV;
+    std::condition_variable m_doneCV;
+    std::string m_dir;
+    // Not finished and failed downloads by file path, succeeded downloads are removed (file exist).
+    std::unordered_map<std::string, Task> m_tasks;
+    std::list<std::string> m_queue;
+    std::vector<std::thread> m_workers;
+    unsigned m_idleWorkers = 0;
+    bool m_cancel = false;
+
+    // Caller must care about m_mutex.
+    std::string GetFilePath(const std::string &contentKey, const std::string &fileName);
+    // Caller must care about m_mutex.
+    void Done(const std::string &filePath, bool succeeded);
+    void Worker();
+};
+
+} // namespace netcoredbg
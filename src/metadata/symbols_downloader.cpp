@@ -0,0 +1,88 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/symbols_downloader.h"
+
+#include "managed/interop.h"
+#include "metadata/modules.h"
+
+namespace netcoredbg
+{
+
+// Note, download is network bound, but each worker take one managed thread inside CoreCLR, no reason have a lot of them.
+static const unsigned MaxWorkersCount = 4;
+
+SymbolsDownloader::~SymbolsDownloader()
+{
+    Cancel();
+}
+
+void SymbolsDownloader::Schedule(ICorDebugModule *pModule)
+{
+    CORDB_ADDRESS modAddress;
+    if (FAILED(pModule->GetBaseAddress(&modAddress)))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cancel = false;
+
+    pModule->AddRef();
+    m_queue.emplace_back(modAddress, ToRelease<ICorDebugModule>(pModule));
+
+    if (m_idleWorkers > 0 || m_workers.size() >= MaxWorkersCount)
+    {
+        m_queueCV.notify_one();
+        return;
+    }
+
+    m_workers.emplace_back(&SymbolsDownloader::Worker, this);
+}
+
+void SymbolsDownloader::Worker()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_idleWorkers++;
+        m_queueCV.wait(lock, [&]() { return m_cancel || !m_queue.empty(); });
+        m_idleWorkers--;
+        if (m_cancel)
+            return;
+
+        ToRelease<ICorDebugModule> iCorModule(m_queue.front().second.Detach());
+        m_queue.pop_front();
+        lock.unlock();
+
+        if (SUCCEEDED(Interop::DownloadSymbolsForModule(GetModuleFileName(iCorModule))))
+            m_downloadedCallback(iCorModule);
+
+        iCorModule.Free();
+        lock.lock();
+    }
+}
+
+void SymbolsDownloader::Remove(CORDB_ADDRESS modAddress)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.remove_if([&](const std::pair<CORDB_ADDRESS, ToRelease<ICorDebugModule>> &entry) { return entry.first == modAddress; });
+}
+
+void SymbolsDownloader::Cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cancel = true;
+        m_queue.clear();
+        m_queueCV.notify_all();
+    }
+
+    for (auto &worker : m_workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    m_workers.clear();
+}
+
+} // namespace netcoredbg
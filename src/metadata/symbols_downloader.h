@@ -0,0 +1,56 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <vector>
+#include <list>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <unordered_map>
+#include "utils/torelease.h"
+
+namespace netcoredbg
+{
+
+// Bounded worker pool for modules PDB download from symbol servers into local symbols cache.
+// Download could take seconds for each module, so, LoadModule callback only queue module without symbols found, result
+// is attached by callback from worker thread (symbols reader is loaded from local cache).
+class SymbolsDownloader
+{
+public:
+
+    typedef std::function<void(ICorDebugModule *pModule)> DownloadedCallback;
+
+    SymbolsDownloader(DownloadedCallback cb) :
+        m_downloadedCallback(cb)
+    {}
+    ~SymbolsDownloader();
+
+    // Queue module's PDB download, workers are started on demand.
+    void Schedule(ICorDebugModule *pModule);
+    // Remove module from queue (for example, module unloaded), download in progress (if any) is not interrupted.
+    void Remove(CORDB_ADDRESS modAddress);
+    // Clear queue and wait for all worker threads, since download can't be interrupted, could take download timeout.
+    void Cancel();
+
+private:
+
+    DownloadedCallback m_downloadedCallback;
+    std::mutex m_mutex;
+    std::condition_variable m_queueCV;
+    std::list<std::pair<CORDB_ADDRESS, ToRelease<ICorDebugModule>>> m_queue;
+    std::vector<std::thread> m_workers;
+    unsigned m_idleWorkers = 0;
+    bool m_cancel = false;
+
+    void Worker();
+};
+
+} // namespace netcoredbg
@@ -0,0 +1,130 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/symbols_preloader.h"
+
+#include <algorithm>
+#include "managed/interop.h"
+
+namespace netcoredbg
+{
+
+// Note, each worker take one managed thread inside CoreCLR for PDB reading, no reason have a lot of them.
+static const unsigned MaxWorkersCount = 8;
+
+SymbolsPreloader::~SymbolsPreloader()
+{
+    Cancel();
+}
+
+void SymbolsPreloader::Schedule(std::vector<ToRelease<ICorDebugModule>> &modules)
+{
+    JoinWorkers(); // previous workers could be still running
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cancel = false;
+
+    for (auto &iCorModule : modules)
+    {
+        CORDB_ADDRESS modAddress;
+        if (FAILED(iCorModule->GetBaseAddress(&modAddress)) ||
+            m_tasks.find(modAddress) != m_tasks.end())
+            continue;
+
+        Task &task = m_tasks[modAddress];
+        task.iCorModule = iCorModule.Detach();
+        m_queue.emplace_back(modAddress);
+    }
+
+    if (m_queue.empty())
+        return;
+
+    unsigned workersCount = std::max(1u, std::min(MaxWorkersCount, std::thread::hardware_concurrency()));
+    workersCount = std::min(workersCount, (unsigned)m_queue.size());
+    for (unsigned i = 0; i < workersCount; i++)
+    {
+        m_workers.emplace_back(&SymbolsPreloader::Worker, this);
+    }
+}
+
+void SymbolsPreloader::Worker()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_cancel && !m_queue.empty())
+    {
+        CORDB_ADDRESS modAddress = m_queue.front();
+        m_queue.pop_front();
+        auto findTask = m_tasks.find(modAddress);
+        if (findTask == m_tasks.end())
+            continue;
+
+        findTask->second.state = State::Loading;
+        ICorDebugModule *pModule = findTask->second.iCorModule.GetPtr();
+        lock.unlock();
+
+        Result result;
+        m_loadCallback(pModule, result);
+
+        lock.lock();
+        // Note, m_tasks could be changed, but this task can't be removed in Loading state.
+        findTask = m_tasks.find(modAddress);
+        assert(findTask != m_tasks.end());
+        findTask->second.result = std::move(result);
+        findTask->second.state = State::Loaded;
+        m_loadedCV.notify_all();
+    }
+}
+
+bool SymbolsPreloader::Take(CORDB_ADDRESS modAddress, Result &result)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto findTask = m_tasks.find(modAddress);
+    if (findTask == m_tasks.end())
+        return false;
+
+    if (findTask->second.state == State::Queued)
+    {
+        m_queue.remove(modAddress);
+        m_tasks.erase(findTask);
+        return false;
+    }
+
+    m_loadedCV.wait(lock, [&]() { return m_tasks[modAddress].state == State::Loaded; });
+
+    findTask = m_tasks.find(modAddress);
+    result = std::move(findTask->second.result);
+    m_tasks.erase(findTask);
+    return true;
+}
+
+void SymbolsPreloader::JoinWorkers()
+{
+    for (auto &worker : m_workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    m_workers.clear();
+}
+
+void SymbolsPreloader::Cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cancel = true;
+        m_queue.clear();
+    }
+
+    JoinWorkers();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto &task : m_tasks)
+    {
+        if (task.second.result.pSymbolReaderHandle != nullptr)
+            Interop::DisposeSymbols(task.second.result.pSymbolReaderHandle);
+    }
+    m_tasks.clear();
+}
+
+} // namespace netcoredbg
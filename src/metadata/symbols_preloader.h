@@ -0,0 +1,82 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <string>
+#include <vector>
+#include <list>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <unordered_map>
+#include "utils/torelease.h"
+
+namespace netcoredbg
+{
+
+// Bounded worker pool for modules symbols loading.
+// At attach, runtime send LoadModule callbacks for all already loaded modules one by one, PDB open for all of them could
+// be done in parallel before callbacks, but result should be used (published) by each module's LoadModule callback only,
+// in order to keep same breakpoints resolve logic.
+class SymbolsPreloader
+{
+public:
+
+    struct Result
+    {
+        PVOID pSymbolReaderHandle = nullptr;
+        // Module's documents (sources full paths), provided only in case symbols was loaded.
+        std::vector<std::string> documents;
+        // Types and methods with "not user code" attributes, provided only in case symbols was loaded.
+        std::vector<mdToken> nonJMCTokens;
+    };
+    typedef std::function<void(ICorDebugModule *pModule, Result &result)> LoadCallback;
+
+    SymbolsPreloader(LoadCallback cb) :
+        m_loadCallback(cb)
+    {}
+    ~SymbolsPreloader();
+
+    // Start symbols loading for all modules in worker threads.
+    void Schedule(std::vector<ToRelease<ICorDebugModule>> &modules);
+    // Return `true` in case result for module was found. In case module's symbols loading in progress, wait for result.
+    // Note, in case module's symbols loading still wait in queue, it will be removed from queue (caller should load it by itself).
+    bool Take(CORDB_ADDRESS modAddress, Result &result);
+    // Wait for all worker threads and release all not taken results.
+    void Cancel();
+
+private:
+
+    enum class State
+    {
+        Queued,
+        Loading,
+        Loaded
+    };
+
+    struct Task
+    {
+        State state = State::Queued;
+        ToRelease<ICorDebugModule> iCorModule;
+        Result result;
+    };
+
+    LoadCallback m_loadCallback;
+    std::mutex m_mutex;
+    std::condition_variable m_loadedCV;
+    std::unordered_map<CORDB_ADDRESS, Task> m_tasks;
+    std::list<CORDB_ADDRESS> m_queue;
+    std::vector<std::thread> m_workers;
+    bool m_cancel = false;
+
+    void Worker();
+    void JoinWorkers();
+};
+
+} // namespace netcoredbg
@@ -7,6 +7,7 @@
 #include <sstream>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 
 #include "utils/torelease.h"
 #include "utils/utf.h"
@@ -18,49 +19,6 @@ namespace netcoredbg
 namespace TypePrinter
 {
 
-static std::string ConsumeGenericArgs(const std::string &name, std::list<std::string> &args)
-{
-    if (args.empty())
-        return name;
-
-    std::size_t offset = name.find_last_not_of("0123456789");
-
-    if (offset == std::string::npos || offset == name.size() - 1 || name.at(offset) != '`')
-        return name;
-
-    unsigned long numArgs = 0;
-    try {
-        numArgs = std::stoul(name.substr(offset + 1));
-    }
-    catch(std::invalid_argument e)
-    {
-        return name;
-    }
-    catch (std::out_of_range  e)
-    {
-        return name;
-    }
-
-    if (numArgs == 0 || numArgs > args.size())
-    {
-        return name;
-    }
-
-    std::ostringstream ss;
-    ss << name.substr(0, offset);
-    ss << "<";
-    const char *sep = "";
-    while (numArgs--)
-    {
-        ss << sep;
-        sep = ", ";
-        ss << args.front();
-        args.pop_front();
-    }
-    ss << ">";
-    return ss.str();
-}
-
 std::string RenameToSystem(const std::string &typeName)
 {
     static const std::unordered_map<std::string, std::string> cs2system = {
@@ -87,7 +45,7 @@ std::string RenameToSystem(const std::string &typeName)
     return renamed != cs2system.end() ? renamed->second : typeName;
 }
 
-std::string RenameToCSharp(const std::string &typeName)
+static const std::unordered_map<std::string, std::string> &System2CSharp()
 {
     static const std::unordered_map<std::string, std::string> system2cs = {
         {"System.Void",    "void"},
@@ -109,8 +67,13 @@ std::string RenameToCSharp(const std::string &typeName)
         {"System.IntPtr",  "IntPtr"},
         {"System.UIntPtr", "UIntPtr"}
     };
-    auto renamed = system2cs.find(typeName);
-    return renamed != system2cs.end() ? renamed->second : typeName;
+    return system2cs;
+}
+
+std::string RenameToCSharp(const std::string &typeName)
+{
+    auto renamed = System2CSharp().find(typeName);
+    return renamed != System2CSharp().end() ? renamed->second : typeName;
 }
 
 // From metadata.cpp
@@ -122,12 +85,8 @@ std::string RenameToCSharp(const std::string &typeName)
 *    metadata API.                                                     *
 *                                                                      *
 \**********************************************************************/
-// Caller should guard against exception
-HRESULT NameForTypeDef(
-    mdTypeDef tkTypeDef,
-    IMetaDataImport *pImport,
-    std::string &mdName,
-    std::list<std::string> *args)
+// Note, enclosing types names appended first, since they consume first generic arguments.
+static HRESULT AppendTypeDefName(mdTypeDef tkTypeDef, IMetaDataImport *pImport, std::string &mdName, GenericArgs *args)
 {
     HRESULT Status;
     DWORD flags;
@@ -135,27 +94,34 @@ HRESULT NameForTypeDef(
     ULONG nameLen;
 
     IfFailRet(pImport->GetTypeDefProps(tkTypeDef, name, _countof(name), &nameLen, &flags, NULL));
-    mdName = to_utf8(name/*, nameLen*/);
 
-    if (!IsTdNested(flags))
+    if (IsTdNested(flags))
     {
-        if (args)
-            mdName = ConsumeGenericArgs(mdName, *args);
-
-        return S_OK;
+        mdTypeDef tkEnclosingClass;
+        IfFailRet(pImport->GetNestedClassProps(tkTypeDef, &tkEnclosingClass));
+        IfFailRet(AppendTypeDefName(tkEnclosingClass, pImport, mdName, args));
+        mdName += '.';
     }
 
-    mdTypeDef tkEnclosingClass;
-    IfFailRet(pImport->GetNestedClassProps(tkTypeDef, &tkEnclosingClass));
-
-    std::string enclosingName;
-    IfFailRet(NameForTypeDef(tkEnclosingClass, pImport, enclosingName, args));
-
-    mdName = enclosingName + "." + (args ? ConsumeGenericArgs(mdName, *args) : mdName);
+    const size_t start = mdName.size();
+    append_utf8(mdName, name/*, nameLen*/);
+    if (args)
+        args->Consume(mdName, start);
 
     return S_OK;
 }
 
+// Caller should guard against exception
+HRESULT NameForTypeDef(
+    mdTypeDef tkTypeDef,
+    IMetaDataImport *pImport,
+    std::string &mdName,
+    GenericArgs *args)
+{
+    mdName.clear();
+    return AppendTypeDefName(tkTypeDef, pImport, mdName, args);
+}
+
 static HRESULT NameForTypeRef(mdTypeRef tkTypeRef, IMetaDataImport *pImport, std::string &mdName)
 {
     // Note, instead of GetTypeDefProps(), GetTypeRefProps() return fully-qualified name.
@@ -167,7 +133,7 @@ static HRESULT NameForTypeRef(mdTypeRef tkTypeRef, IMetaDataImport *pImport, std
     std::unique_ptr<WCHAR[]> refName(new WCHAR[refNameSize + 1]);
     IfFailRet(pImport->GetTypeRefProps(tkTypeRef, NULL, refName.get(), refNameSize, NULL));
 
-    mdName = to_utf8(refName.get());
+    assign_utf8(mdName, refName.get());
 
     return S_OK;
 }
@@ -175,9 +141,9 @@ static HRESULT NameForTypeRef(mdTypeRef tkTypeRef, IMetaDataImport *pImport, std
 HRESULT NameForTypeByToken(mdToken mb,
                                         IMetaDataImport *pImport,
                                         std::string &mdName,
-                                        std::list<std::string> *args)
+                                        GenericArgs *args)
 {
-    mdName[0] = L'\0';
+    mdName.clear();
     if (TypeFromToken(mb) != mdtTypeDef
         && TypeFromToken(mb) != mdtTypeRef)
     {
@@ -201,7 +167,7 @@ HRESULT NameForTypeByToken(mdToken mb,
     return hr;
 }
 
-static HRESULT AddGenericArgs(ICorDebugType *pType, std::list<std::string> &args)
+static HRESULT AddGenericArgs(ICorDebugType *pType, GenericArgs &args)
 {
     ToRelease<ICorDebugTypeEnum> pTypeEnum;
 
@@ -212,9 +178,7 @@ static HRESULT AddGenericArgs(ICorDebugType *pType, std::list<std::string> &args
 
         while (SUCCEEDED(pTypeEnum->Next(1, &pCurrentTypeParam, &fetched)) && fetched == 1)
         {
-            std::string name;
-            GetTypeOfValue(pCurrentTypeParam, name);
-            args.emplace_back(name);
+            GetTypeOfValue(pCurrentTypeParam, args.Add());
             pCurrentTypeParam.Free();
         }
     }
@@ -222,7 +186,7 @@ static HRESULT AddGenericArgs(ICorDebugType *pType, std::list<std::string> &args
     return S_OK;
 }
 
-HRESULT AddGenericArgs(ICorDebugFrame *pFrame, std::list<std::string> &args)
+HRESULT AddGenericArgs(ICorDebugFrame *pFrame, GenericArgs &args)
 {
     HRESULT Status;
 
@@ -238,9 +202,7 @@ HRESULT AddGenericArgs(ICorDebugFrame *pFrame, std::list<std::string> &args)
 
         while (SUCCEEDED(pTypeEnum->Next(1, &pCurrentTypeParam, &numTypes)) && numTypes == 1)
         {
-            std::string name;
-            GetTypeOfValue(pCurrentTypeParam, name);
-            args.emplace_back(name);
+            GetTypeOfValue(pCurrentTypeParam, args.Add());
             pCurrentTypeParam.Free();
         }
     }
@@ -261,7 +223,7 @@ HRESULT NameForTypeByType(ICorDebugType *pType, std::string &mdName)
     IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
     mdToken tk;
     IfFailRet(pClass->GetToken(&tk));
-    std::list<std::string> args;
+    GenericArgs args;
     AddGenericArgs(pType, args);
     return NameForTypeByToken(tk, pMD, mdName, &args);
 }
@@ -280,9 +242,9 @@ HRESULT NameForToken(mdToken mb,
                                   IMetaDataImport *pImport,
                                   std::string &mdName,
                                   bool bClassName,
-                                  std::list<std::string> *args)
+                                  GenericArgs *args)
 {
-    mdName[0] = L'\0';
+    mdName.clear();
     if (TypeFromToken(mb) != mdtTypeDef
         && TypeFromToken(mb) != mdtFieldDef
         && TypeFromToken(mb) != mdtMethodDef
@@ -315,7 +277,7 @@ HRESULT NameForToken(mdToken mb,
                 hr = NameForTypeDef(mdClass, pImport, mdName, args);
                 mdName += ".";
             }
-            mdName += to_utf8(name/*, size*/);
+            append_utf8(mdName, name/*, size*/);
         }
     }
     else if (TypeFromToken(mb) == mdtMethodDef)
@@ -332,7 +294,7 @@ HRESULT NameForToken(mdToken mb,
                 hr = NameForTypeDef(mdClass, pImport, mdName, args);
                 mdName += ".";
             }
-            mdName += to_utf8(name/*, size*/);
+            append_utf8(mdName, name/*, size*/);
         }
     }
     else if (TypeFromToken(mb) == mdtMemberRef)
@@ -355,7 +317,7 @@ HRESULT NameForToken(mdToken mb,
                 mdName += ".";
             }
             // TODO TypeSpec
-            mdName += to_utf8(name/*, size*/);
+            append_utf8(mdName, name/*, size*/);
         }
     }
     else if (TypeFromToken(mb) == mdtTypeRef)
@@ -370,7 +332,9 @@ HRESULT NameForToken(mdToken mb,
 
     if (SUCCEEDED(hr))
     {
-        mdName = RenameToCSharp(mdName);
+        auto renamed = System2CSharp().find(mdName);
+        if (renamed != System2CSharp().end())
+            mdName = renamed->second;
     }
     return hr;
 }
@@ -427,7 +391,6 @@ HRESULT GetTypeOfValue(ICorDebugType *pType, std::string &elementType, std::stri
     case ELEMENT_TYPE_VALUETYPE:
     case ELEMENT_TYPE_CLASS:
         {
-            std::ostringstream ss;
             //Defaults in case we fail...
             elementType = (corElemType == ELEMENT_TYPE_VALUETYPE) ? "struct" : "class";
 
@@ -443,15 +406,16 @@ HRESULT GetTypeOfValue(ICorDebugType *pType, std::string &elementType, std::stri
                 IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
                 IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
 
-                std::string name;
-                std::list<std::string> args;
+                // Note, type name is formatted directly into output.
+                GenericArgs args;
                 AddGenericArgs(pType, args);
-                if(SUCCEEDED(NameForToken(TokenFromRid(typeDef, mdtTypeDef), pMD, name, false, &args)))
-                {
-                    ss << name;
-                }
+                if(FAILED(NameForToken(TokenFromRid(typeDef, mdtTypeDef), pMD, elementType, false, &args)))
+                    elementType.clear();
+            }
+            else
+            {
+                elementType.clear();
             }
-            elementType = ss.str();
             return S_OK;
         }
         break;
@@ -562,7 +526,7 @@ HRESULT GetTypeOfValue(ICorDebugType *pType, std::string &elementType, std::stri
 }
 
 // From sildasm.cpp
-static PCCOR_SIGNATURE NameForTypeSig(PCCOR_SIGNATURE typePtr, const std::vector<std::string> &args,
+static PCCOR_SIGNATURE NameForTypeSig(PCCOR_SIGNATURE typePtr, const GenericArgs &args,
                                       IMetaDataImport *pImport, std::string &out, std::string &appendix)
 {
     mdToken tk;
@@ -684,7 +648,7 @@ static PCCOR_SIGNATURE NameForTypeSig(PCCOR_SIGNATURE typePtr, const std::vector
 
         case ELEMENT_TYPE_VAR        :
             n  = CorSigUncompressData(typePtr);
-            out = n < int(args.size()) ? args.at(n) : "!" + std::to_string(n);
+            out = n < int(args.Size()) ? args[n] : "!" + std::to_string(n);
             break;
 
         case ELEMENT_TYPE_MVAR        :
@@ -705,15 +669,16 @@ static PCCOR_SIGNATURE NameForTypeSig(PCCOR_SIGNATURE typePtr, const std::vector
                 typePtr += CorSigUncompressElementType(typePtr, &underlyingType);
                 typePtr += CorSigUncompressToken(typePtr, &tk);
 
-                std::list<std::string> genericArgs;
+                GenericArgs genericArgs;
 
                 unsigned numArgs = CorSigUncompressData(typePtr);
+                std::string genTypeAppendix;
                 while(numArgs--)
                 {
-                    std::string genType;
-                    std::string genTypeAppendix;
+                    std::string &genType = genericArgs.Add();
+                    genTypeAppendix.clear();
                     typePtr = NameForTypeSig(typePtr, args, pImport, genType, genTypeAppendix);
-                    genericArgs.push_back(genType + genTypeAppendix);
+                    genType += genTypeAppendix;
                 }
                 NameForToken(tk, pImport, out, true, &genericArgs);
             }
@@ -754,39 +719,159 @@ void NameForTypeSig(
     std::string &typeName)
 {
     // Gather generic arguments from enclosing type
-    std::vector<std::string> args;
+    GenericArgs args;
     ToRelease<ICorDebugTypeEnum> pTypeEnum;
 
-    if (SUCCEEDED(enclosingType->EnumerateTypeParameters(&pTypeEnum)))
+    if (enclosingType != nullptr && SUCCEEDED(enclosingType->EnumerateTypeParameters(&pTypeEnum)))
     {
         ULONG fetched = 0;
         ToRelease<ICorDebugType> pCurrentTypeParam;
 
         while (SUCCEEDED(pTypeEnum->Next(1, &pCurrentTypeParam, &fetched)) && fetched == 1)
         {
-            std::string name;
-            GetTypeOfValue(pCurrentTypeParam, name);
-            args.emplace_back(name);
+            GetTypeOfValue(pCurrentTypeParam, args.Add());
             pCurrentTypeParam.Free();
         }
     }
 
+    std::string appendix;
+    typeName.clear();
+    NameForTypeSig(typePtr, args, pImport, typeName, appendix);
+    typeName += appendix;
+}
+
+static PCCOR_SIGNATURE SkipCustomModifiers(PCCOR_SIGNATURE typePtr)
+{
+    while (*typePtr == ELEMENT_TYPE_CMOD_REQD || *typePtr == ELEMENT_TYPE_CMOD_OPT)
+    {
+        typePtr++;
+        mdToken tk;
+        typePtr += CorSigUncompressToken(typePtr, &tk);
+    }
+    return typePtr;
+}
+
+HRESULT NamesForMethodSigParams(PCCOR_SIGNATURE pSig, IMetaDataImport *pImport, std::vector<std::string> &paramsNames)
+{
+    // MethodDefSig: [[HASTHIS] [EXPLICITTHIS]] (DEFAULT|VARARG|GENERIC GenParamCount) ParamCount RetType Param*
+    ULONG convFlags = CorSigUncompressData(pSig);
+    if (convFlags & IMAGE_CEE_CS_CALLCONV_GENERIC)
+        CorSigUncompressData(pSig);
+
+    ULONG cParams = CorSigUncompressData(pSig);
+
+    const GenericArgs args;
     std::string out;
     std::string appendix;
-    NameForTypeSig(typePtr, args, pImport, out, appendix);
-    typeName = out + appendix;
+    pSig = NameForTypeSig(SkipCustomModifiers(pSig), args, pImport, out, appendix);
+
+    paramsNames.clear();
+    paramsNames.reserve(cParams);
+    for (ULONG i = 0; i < cParams; i++)
+    {
+        if (*pSig == ELEMENT_TYPE_SENTINEL)
+            break;
+
+        out.clear();
+        appendix.clear();
+        pSig = NameForTypeSig(SkipCustomModifiers(pSig), args, pImport, out, appendix);
+        paramsNames.emplace_back(out + appendix);
+    }
+
+    return S_OK;
 }
 
 HRESULT GetTypeOfValue(ICorDebugType *pType, std::string &output)
 {
     HRESULT Status;
-    std::string elementType;
     std::string arrayType;
-    IfFailRet(GetTypeOfValue(pType, elementType, arrayType));
-    output = elementType + arrayType;
+    IfFailRet(GetTypeOfValue(pType, output, arrayType));
+    output += arrayType;
     return S_OK;
 }
 
+namespace
+{
+    // Formatted type and method names for methods (with particular generic arguments), aimed to avoid names
+    // construction from metadata for same methods on each stack trace request (recursion, same call chains, etc.).
+    class MethodNamesCache
+    {
+    public:
+
+        struct key_t
+        {
+            CORDB_ADDRESS modAddress;
+            mdMethodDef methodDef;
+            std::string genericArgs; // frame's generic arguments, separated by ','
+
+            bool operator == (const key_t &other) const
+            {
+                return modAddress == other.modAddress && methodDef == other.methodDef && genericArgs == other.genericArgs;
+            }
+        };
+
+        bool Get(const key_t &key, std::string &typeName, std::string &methodName)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto find = m_names.find(key);
+            if (find == m_names.end())
+                return false;
+
+            typeName.assign(find->second.names, 0, find->second.typeNameLength);
+            methodName.assign(find->second.names, find->second.typeNameLength, std::string::npos);
+            return true;
+        }
+
+        void Put(key_t &&key, const std::string &typeName, const std::string &methodName)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // Note, we don't need precise LRU here, just don't allow cache grow unlimited.
+            if (m_names.size() >= MaxEntries)
+                m_names.clear();
+
+            value_t &value = m_names[std::move(key)];
+            value.names = typeName + methodName;
+            value.typeNameLength = typeName.size();
+        }
+
+        void Clear()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_names.clear();
+        }
+
+    private:
+
+        static const size_t MaxEntries = 8192;
+
+        struct key_t_hash
+        {
+            size_t operator()(const key_t &key) const
+            {
+                return std::hash<std::string>()(key.genericArgs) ^ (size_t)key.modAddress ^ ((size_t)key.methodDef << 16);
+            }
+        };
+
+        // Type and method names stored in one string (one allocation per entry).
+        struct value_t
+        {
+            std::string names;
+            size_t typeNameLength;
+        };
+
+        std::mutex m_mutex;
+        std::unordered_map<key_t, value_t, key_t_hash> m_names;
+    };
+
+    MethodNamesCache g_methodNamesCache;
+
+} // unnamed namespace
+
+void ClearMethodNamesCache()
+{
+    g_methodNamesCache.Clear();
+}
+
 HRESULT GetTypeAndMethod(ICorDebugFrame *pFrame, std::string &typeName, std::string &methodName)
 {
     HRESULT Status;
@@ -794,13 +879,25 @@ HRESULT GetTypeAndMethod(ICorDebugFrame *pFrame, std::string &typeName, std::str
     ToRelease<ICorDebugFunction> pFunction;
     IfFailRet(pFrame->GetFunction(&pFunction));
 
-    ToRelease<ICorDebugClass> pClass;
     ToRelease<ICorDebugModule> pModule;
     mdMethodDef methodDef;
-    IfFailRet(pFunction->GetClass(&pClass));
     IfFailRet(pFunction->GetModule(&pModule));
     IfFailRet(pFunction->GetToken(&methodDef));
 
+    GenericArgs args;
+    AddGenericArgs(pFrame, args);
+
+    MethodNamesCache::key_t cacheKey;
+    IfFailRet(pModule->GetBaseAddress(&cacheKey.modAddress));
+    cacheKey.methodDef = methodDef;
+    args.Join(cacheKey.genericArgs, ',');
+
+    if (g_methodNamesCache.Get(cacheKey, typeName, methodName))
+        return S_OK;
+
+    ToRelease<ICorDebugClass> pClass;
+    IfFailRet(pFunction->GetClass(&pClass));
+
     ToRelease<IUnknown> pMDUnknown;
     ToRelease<IMetaDataImport> pMD;
 
@@ -827,8 +924,6 @@ HRESULT GetTypeAndMethod(ICorDebugFrame *pFrame, std::string &typeName, std::str
                                   szFunctionName, _countof(szFunctionName), &nameLen,
                                   &flags, &pbSigBlob, &ulSigBlob, &ulCodeRVA, &ulImplFlags));
 
-    std::string funcName = to_utf8(szFunctionName/*, nameLen*/);
-
     ULONG methodGenericsCount = 0;
     HCORENUM hEnum = NULL;
     mdGenericParam gp;
@@ -839,24 +934,22 @@ HRESULT GetTypeAndMethod(ICorDebugFrame *pFrame, std::string &typeName, std::str
     }
     pMD2->CloseEnum(hEnum);
 
-    if (methodGenericsCount > 0)
-    {
-        std::ostringstream ss;
-        ss << funcName << '`' << methodGenericsCount;
-        funcName = ss.str();
-    }
-
-    std::list<std::string> args;
-    AddGenericArgs(pFrame, args);
-
     if (memTypeDef != mdTypeDefNil)
     {
         if (FAILED(NameForTypeDef(memTypeDef, pMD, typeName, &args)))
             typeName = "";
     }
 
-    methodName = ConsumeGenericArgs(funcName, args);
+    // Note, method's generic arguments follow type's arguments, that already consumed by type name.
+    assign_utf8(methodName, szFunctionName/*, nameLen*/);
+    if (methodGenericsCount > 0)
+    {
+        methodName += '`';
+        methodName += std::to_string(methodGenericsCount);
+    }
+    args.Consume(methodName, 0);
 
+    g_methodNamesCache.Put(std::move(cacheKey), typeName, methodName);
     return S_OK;
 }
 
@@ -867,13 +960,15 @@ HRESULT GetMethodName(ICorDebugFrame *pFrame, std::string &output)
     std::string typeName;
     std::string methodName;
 
-    std::ostringstream ss;
     IfFailRet(GetTypeAndMethod(pFrame, typeName, methodName));
+    output.clear();
     if (!typeName.empty())
-        ss << typeName << ".";
-    ss << methodName << "()";
-
-    output = ss.str();
+    {
+        output += typeName;
+        output += '.';
+    }
+    output += methodName;
+    output += "()";
     return S_OK;
 }
 
@@ -6,9 +6,9 @@
 #include "cor.h"
 #include "cordebug.h"
 
-#include <list>
 #include <string>
 #include <vector>
+#include "metadata/generic_args.h"
 
 namespace netcoredbg
 {
@@ -16,20 +16,24 @@ namespace netcoredbg
 namespace TypePrinter
 {
 
-    HRESULT AddGenericArgs(ICorDebugFrame *pFrame, std::list<std::string> &args);
+    HRESULT AddGenericArgs(ICorDebugFrame *pFrame, GenericArgs &args);
     HRESULT NameForTypeDef(mdTypeDef tkTypeDef, IMetaDataImport *pImport, std::string &mdName,
-                           std::list<std::string> *args);
+                           GenericArgs *args);
     HRESULT NameForToken(mdToken mb, IMetaDataImport *pImport, std::string &mdName, bool bClassName,
-                         std::list<std::string> *args);
-    HRESULT NameForTypeByToken(mdToken mb, IMetaDataImport *pImport, std::string &mdName, std::list<std::string> *args);
+                         GenericArgs *args);
+    HRESULT NameForTypeByToken(mdToken mb, IMetaDataImport *pImport, std::string &mdName, GenericArgs *args);
     HRESULT NameForTypeByType(ICorDebugType *pType, std::string &mdName);
     HRESULT NameForTypeByValue(ICorDebugValue *pValue, std::string &mdName);
     void NameForTypeSig(PCCOR_SIGNATURE typePtr, ICorDebugType *enclosingType, IMetaDataImport *pImport, std::string &typeName);
+    // Parameters types names from method's signature ("int", "string[]", "int&", "!!0" for method generic parameter, ...).
+    HRESULT NamesForMethodSigParams(PCCOR_SIGNATURE pSig, IMetaDataImport *pImport, std::vector<std::string> &paramsNames);
     HRESULT GetTypeOfValue(ICorDebugType *pType, std::string &output);
     HRESULT GetTypeOfValue(ICorDebugValue *pValue, std::string &output);
     HRESULT GetTypeOfValue(ICorDebugType *pType, std::string &elementType, std::string &arrayType);
     HRESULT GetMethodName(ICorDebugFrame *pFrame, std::string &output);
     HRESULT GetTypeAndMethod(ICorDebugFrame *pFrame, std::string &typeName, std::string &methodName);
+    // Must be called on debug session end, since modules addresses could be reused.
+    void ClearMethodNamesCache();
     std::string RenameToSystem(const std::string &typeName);
     std::string RenameToCSharp(const std::string &typeName);
 
@@ -0,0 +1,81 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/user_code_cache.h"
+
+namespace netcoredbg
+{
+
+static uint64_t MethodKey(uint32_t methodToken, uint32_t methodVersion)
+{
+    return ((uint64_t)methodVersion << 32) | methodToken;
+}
+
+bool UserCodeCache::Get(uint64_t modAddress, uint32_t methodToken, uint32_t methodVersion, Property property, bool &value)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    auto findModule = m_modules.find(modAddress);
+    if (findModule == m_modules.end())
+        return false;
+
+    auto findMethod = findModule->second.find(MethodKey(methodToken, methodVersion));
+    if (findMethod == findModule->second.end() || (findMethod->second & KnownBit(property)) == 0)
+        return false;
+
+    value = (findMethod->second & ValueBit(property)) != 0;
+    return true;
+}
+
+void UserCodeCache::Set(uint64_t modAddress, uint32_t methodToken, uint32_t methodVersion, Property property, bool value)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    uint8_t &bits = m_modules[modAddress][MethodKey(methodToken, methodVersion)];
+    bits |= KnownBit(property);
+    if (value)
+        bits |= ValueBit(property);
+    else
+        bits &= (uint8_t)~ValueBit(property);
+}
+
+void UserCodeCache::InvalidateModule(uint64_t modAddress)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_modules.erase(modAddress);
+}
+
+void UserCodeCache::InvalidateJMCStatus()
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    const uint8_t mask = (uint8_t)~(KnownBit(Property::JMCStatus) | ValueBit(Property::JMCStatus));
+    for (auto &module : m_modules)
+    {
+        for (auto &method : module.second)
+        {
+            method.second &= mask;
+        }
+    }
+}
+
+size_t UserCodeCache::GetMethodsCount()
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    size_t count = 0;
+    for (const auto &module : m_modules)
+    {
+        count += module.second.size();
+    }
+    return count;
+}
+
+void UserCodeCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_modules.clear();
+}
+
+} // namespace netcoredbg
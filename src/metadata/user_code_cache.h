@@ -0,0 +1,52 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace netcoredbg
+{
+
+// Stepping related classification of methods versions, aimed to avoid repeated JMC status, sequence points and attributes
+// queries for same methods during step filtering (for example, step-in over framework-heavy call chains).
+// Each property is calculated lazily by caller and stored on first request.
+class UserCodeCache
+{
+public:
+
+    enum class Property : uint8_t
+    {
+        JMCStatus,      // runtime JMC status of method (depends on JMC enabled/disabled by user)
+        HaveUserCode,   // method have not hidden sequence points
+        StepThrough,    // method or its type have DebuggerHidden/DebuggerStepThrough attributes
+        Filtered,       // method is property accessor or operator (step filtering)
+        Count
+    };
+
+    // Return false in case no data in cache.
+    bool Get(uint64_t modAddress, uint32_t methodToken, uint32_t methodVersion, Property property, bool &value);
+    void Set(uint64_t modAddress, uint32_t methodToken, uint32_t methodVersion, Property property, bool value);
+    // Remove all module's methods data (module unload or Hot Reload delta applied).
+    void InvalidateModule(uint64_t modAddress);
+    // Remove JMC statuses only, in case JMC statuses changed (JMC enabled/disabled by user).
+    void InvalidateJMCStatus();
+    size_t GetMethodsCount();
+    void Clear();
+
+private:
+
+    // Note, each property use 2 bits: "known" and "value".
+    static uint8_t KnownBit(Property property) { return (uint8_t)(1 << ((int)property * 2)); }
+    static uint8_t ValueBit(Property property) { return (uint8_t)(1 << ((int)property * 2 + 1)); }
+
+    std::mutex m_cacheMutex;
+    // Key - module address, value - properties bits by method version (high 32 bits) and token (low 32 bits).
+    std::unordered_map<uint64_t, std::unordered_map<uint64_t, uint8_t>> m_modules;
+};
+
+} // namespace netcoredbg
@@ -0,0 +1,169 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/wellknown_types.h"
+
+#include <mutex>
+#include "utils/torelease.h"
+
+namespace netcoredbg
+{
+
+namespace WellKnownTypes
+{
+
+namespace // unnamed namespace
+{
+
+struct type_entry_t
+{
+    const WCHAR *name;
+    // Element type, that could be provided by ICorDebugType for this type instead of CLASS/VALUETYPE.
+    CorElementType elementType;
+};
+
+const type_entry_t typeEntries[(size_t)Type::Count] = {
+    {W("System.Object"),                          ELEMENT_TYPE_OBJECT},
+    {W("System.ValueType"),                       ELEMENT_TYPE_END},
+    {W("System.Enum"),                            ELEMENT_TYPE_END},
+    {W("System.String"),                          ELEMENT_TYPE_STRING},
+    {W("System.Void"),                            ELEMENT_TYPE_VOID},
+    {W("System.Decimal"),                         ELEMENT_TYPE_END},
+    {W("System.Nullable`1"),                      ELEMENT_TYPE_END},
+    {W("System.Collections.Generic.List`1"),      ELEMENT_TYPE_END},
+    {W("System.Collections.Generic.Dictionary`2"), ELEMENT_TYPE_END},
+    {W("System.Span`1"),                          ELEMENT_TYPE_END},
+    {W("System.ReadOnlySpan`1"),                  ELEMENT_TYPE_END},
+    {W("System.Memory`1"),                        ELEMENT_TYPE_END},
+    {W("System.ReadOnlyMemory`1"),                ELEMENT_TYPE_END},
+    {W("System.ArraySegment`1"),                  ELEMENT_TYPE_END},
+    {W("System.Threading.Tasks.Task"),            ELEMENT_TYPE_END},
+    {W("System.DateTime"),                        ELEMENT_TYPE_END},
+    {W("System.DateTimeOffset"),                  ELEMENT_TYPE_END},
+    {W("System.TimeSpan"),                        ELEMENT_TYPE_END},
+    {W("System.Guid"),                            ELEMENT_TYPE_END},
+    {W("System.IntPtr"),                          ELEMENT_TYPE_I},
+    {W("System.UIntPtr"),                         ELEMENT_TYPE_U}
+};
+
+struct resolved_type_t
+{
+    bool resolved = false;
+    mdTypeDef typeDef = mdTypeDefNil;
+};
+
+std::mutex registryMutex;
+ToRelease<ICorDebugModule> coreLibModule;
+ToRelease<IMetaDataImport> coreLibMD;
+CORDB_ADDRESS coreLibAddress = 0;
+resolved_type_t resolvedTypes[(size_t)Type::Count];
+
+// Caller must hold registryMutex.
+mdTypeDef GetTypeDef(Type type)
+{
+    resolved_type_t &entry = resolvedTypes[(size_t)type];
+    if (!entry.resolved)
+    {
+        entry.resolved = true;
+        if (FAILED(coreLibMD->FindTypeDefByName(typeEntries[(size_t)type].name, mdTypeDefNil, &entry.typeDef)))
+            entry.typeDef = mdTypeDefNil;
+    }
+    return entry.typeDef;
+}
+
+} // unnamed namespace
+
+void Init(ICorDebugModule *pCoreLibModule)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    ToRelease<IUnknown> pMDUnknown;
+    ToRelease<IMetaDataImport> pMD;
+    CORDB_ADDRESS modAddress = 0;
+    if (FAILED(pCoreLibModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown)) ||
+        FAILED(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD)) ||
+        FAILED(pCoreLibModule->GetBaseAddress(&modAddress)))
+        return;
+
+    coreLibModule.Free();
+    pCoreLibModule->AddRef();
+    coreLibModule = pCoreLibModule;
+    coreLibMD = pMD.Detach();
+    coreLibAddress = modAddress;
+    for (auto &entry : resolvedTypes)
+    {
+        entry = resolved_type_t();
+    }
+}
+
+void Shutdown()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    coreLibMD.Free();
+    coreLibModule.Free();
+    coreLibAddress = 0;
+    for (auto &entry : resolvedTypes)
+    {
+        entry = resolved_type_t();
+    }
+}
+
+HRESULT GetClass(Type type, ICorDebugClass **ppClass)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    if (!coreLibModule)
+        return S_FALSE;
+
+    mdTypeDef typeDef = GetTypeDef(type);
+    if (typeDef == mdTypeDefNil)
+        return E_FAIL;
+
+    return coreLibModule->GetClassFromToken(typeDef, ppClass);
+}
+
+bool IsClass(ICorDebugClass *pClass, Type type)
+{
+    mdTypeDef typeDef = mdTypeDefNil;
+    if (FAILED(pClass->GetToken(&typeDef)))
+        return false;
+
+    CORDB_ADDRESS modAddress = 0;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+
+        if (!coreLibModule || GetTypeDef(type) != typeDef)
+            return false;
+
+        modAddress = coreLibAddress;
+    }
+
+    // Note, check module only in case of token match (cheap check first).
+    ToRelease<ICorDebugModule> pModule;
+    CORDB_ADDRESS classModAddress = 0;
+    return SUCCEEDED(pClass->GetModule(&pModule)) &&
+           SUCCEEDED(pModule->GetBaseAddress(&classModAddress)) &&
+           classModAddress == modAddress;
+}
+
+bool IsType(ICorDebugType *pType, Type type)
+{
+    CorElementType corElemType;
+    if (FAILED(pType->GetType(&corElemType)))
+        return false;
+
+    if (corElemType != ELEMENT_TYPE_CLASS && corElemType != ELEMENT_TYPE_VALUETYPE)
+        return corElemType == typeEntries[(size_t)type].elementType;
+
+    ToRelease<ICorDebugClass> pClass;
+    if (FAILED(pType->GetClass(&pClass)))
+        return false;
+
+    return IsClass(pClass, type);
+}
+
+} // namespace WellKnownTypes
+
+} // namespace netcoredbg
@@ -0,0 +1,56 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+namespace netcoredbg
+{
+
+// Process-wide registry of well known System.Private.CoreLib types, aimed to avoid type name building and compare
+// (or metadata search by name) in hot display and eval paths. Types tokens resolved lazily, at first request.
+namespace WellKnownTypes
+{
+    enum class Type : size_t
+    {
+        Object,
+        ValueType,
+        Enum,
+        String,
+        Void,
+        Decimal,
+        Nullable,
+        List,
+        Dictionary,
+        Span,
+        ReadOnlySpan,
+        Memory,
+        ReadOnlyMemory,
+        ArraySegment,
+        Task,
+        DateTime,
+        DateTimeOffset,
+        TimeSpan,
+        Guid,
+        IntPtr,
+        UIntPtr,
+        Count // must be last
+    };
+
+    // Must be called at System.Private.CoreLib.dll module load.
+    void Init(ICorDebugModule *pCoreLibModule);
+    // Must be called at debuggee process exit or detach.
+    void Shutdown();
+
+    // Return S_FALSE in case registry not initialized yet.
+    HRESULT GetClass(Type type, ICorDebugClass **ppClass);
+    // Return false in case registry not initialized yet or any error.
+    bool IsClass(ICorDebugClass *pClass, Type type);
+    bool IsType(ICorDebugType *pType, Type type);
+
+} // namespace WellKnownTypes
+
+} // namespace netcoredbg
@@ -15,9 +15,11 @@
 
 #include "interfaces/idebugger.h"
 #include "debugger/frames.h"
+#include "debugger/stepstats.h"
 #include "utils/platform.h"
 #include "utils/torelease.h"
 #include "protocols/cliprotocol.h"
+#include "protocols/jsonwriter.h"
 #include "linenoise.h"
 #include "utils/utf.h"
 #include "utils/filesystem.h"
@@ -30,6 +32,7 @@
 #include <algorithm>
 #include <numeric>
 #include <memory>
+#include <unordered_map>
 #include <iostream>
 #include <fstream>
 #include <iomanip>
@@ -38,6 +41,8 @@
 #include "utils/string_view.h"
 #include "utils/span.h"
 #include "utils/logger.h"
+#include "utils/perfcounters.h"
+#include "utils/tracerecorder.h"
 #include "tokenizer.h"
 
 #include "tty.h"
@@ -94,6 +99,7 @@ enum class CLIProtocol::CommandTag
     File,
     Finish,
     Frame,
+    Handle,
     Interrupt,
     List,
     Next,
@@ -102,6 +108,8 @@ enum class CLIProtocol::CommandTag
     Run,
     Attach,
     Step,
+    Trace,
+    Snapshot,
     Source,
     Wait,
 
@@ -110,12 +118,23 @@ enum class CLIProtocol::CommandTag
     SetArgs,
     SetJustMyCode,
     SetStepFiltering,
+    SetEvalTimeout,
+    SetExceptionStats,
     SetHelp,
 
     // info subcommand
     Info,
     InfoThreads,
     InfoBreakpoints,
+    InfoStepStats,
+    InfoPerfCounters,
+    InfoTraceEvents,
+    InfoMemory,
+    InfoExceptions,
+    InfoTrace,
+    InfoHeap,
+    InfoGCRoot,
+    InfoTasks,
     InfoHelp,
 
     // save subcommand
@@ -123,10 +142,18 @@ enum class CLIProtocol::CommandTag
     SaveBreakpoints,
     SaveHelp,
 
+    // profile subcommands
+    Profile,
+    ProfileStart,
+    ProfileStop,
+    ProfileExport,
+    ProfileHelp,
+
     // help subcommands
     HelpInfo,
     HelpSet,
     HelpSave,
+    HelpProfile,
 
     // These two definitons should end command list.
     CommandsCount,  // Total number of the commands.
@@ -172,11 +199,38 @@ constexpr static const CLIParams::CommandInfo save_commands[] =
     {CommandTag::End, {}, {}, {}, {}}
 };
 
+// Subcommands for "profile" command.
+constexpr static const CLIParams::CommandInfo profile_commands[] =
+{
+    {CommandTag::ProfileStart, {}, {}, {{"start"}},
+            {{"[interval]"}, "Start sampling of all threads stacks with interval\n"
+                             "in milliseconds (10 by default), previous samples are dropped."}},
+    {CommandTag::ProfileStop,  {}, {}, {{"stop"}}, {{}, "Stop sampling."}},
+    {CommandTag::ProfileExport,{}, {}, {{"export"}},
+            {{"folded|speedscope [file]"}, "Print collected samples or save them to the file\n"
+                                          "in folded (collapsed stacks) or speedscope format."}},
+    {CommandTag::ProfileHelp,  {}, {}, {{"help"}}, {{}, {}}},
+
+    // This should be placed at end of command (sub)lists.
+    {CommandTag::End, {}, {}, {}, {}}
+};
+
 // Subcommands for "info" command.
 constexpr static const CLIParams::CommandInfo info_commands[] =
 {
-    {CommandTag::InfoThreads,    {}, {}, {{"threads"}}, {{}, "Display currently known threads."}},
+    {CommandTag::InfoThreads,    {}, {}, {{"threads"}}, {{"[refresh]"}, "Display currently known threads. With `refresh`, native\n"
+                                                                        "threads names are re-read in interop mode."}},
     {CommandTag::InfoBreakpoints,{}, {}, {{"breakpoints", "break"}}, {{}, "Display existing breakpoints."}},
+    {CommandTag::InfoStepStats,  {}, {}, {{"step-stats"}}, {"[reset]", "Display stepping latency statistic, reset it if requested."}},
+    {CommandTag::InfoPerfCounters, {}, {}, {{"perf-counters"}}, {"[reset]", "Display performance counters in JSON, reset them if requested."}},
+    {CommandTag::InfoTraceEvents, {}, {}, {{"trace-events"}}, {"<file>|clear", "Write debugger internal activity timelines into file\n"
+                                                                              "in Chrome trace JSON format, or remove recorded events."}},
+    {CommandTag::InfoMemory,     {}, {}, {{"memory"}}, {{}, "Display memory used by symbols related data."}},
+    {CommandTag::InfoExceptions, {}, {}, {{"exceptions"}}, {"[reset]", "Display exception statistics, reset it if requested."}},
+    {CommandTag::InfoTrace,      {}, {}, {{"trace"}}, {"[drain|clear]", "Display trace points hits, remove displayed or all hits if requested."}},
+    {CommandTag::InfoHeap,       {}, {}, {{"heap"}}, {"[count] [N]", "Display top N (20 by default) managed heap types by size or objects count."}},
+    {CommandTag::InfoGCRoot,     {}, {}, {{"gcroot"}}, {"<expr>", "Display shortest references path from GC root to object."}},
+    {CommandTag::InfoTasks,      {}, {}, {{"tasks"}}, {"[all]", "Display live tasks grouped by status and await point, with async stacks."}},
     {CommandTag::InfoHelp,       {}, {}, {{"help"}}, {{}, {}}},
 
     // This should be placed at end of command (sub)lists.
@@ -198,6 +252,14 @@ constexpr static const CLIParams::CommandInfo set_commands[] =
             {{"1 or 0"},  "Prevent or allow stepping into properties and operators\n"
                           "in managed code."}},
 
+    {CommandTag::SetEvalTimeout, {}, {}, {{"eval-timeout"}},
+            {{"milliseconds"},  "Set timeout for function evaluation in managed code,\n"
+                                "0 - use default timeout (5000 milliseconds)."}},
+
+    {CommandTag::SetExceptionStats, {}, {}, {{"exception-stats"}},
+            {{"1 or 0"},  "Enable or disable exception statistics mode, first chance exceptions\n"
+                          "are counted by type and throw-site without stop (see 'info exceptions')."}},
+
     {CommandTag::SetHelp, {}, {}, {{"help"}}, {{}, {}}},
 
     // This should be placed at end of command (sub)lists.
@@ -210,6 +272,7 @@ constexpr static const CLIParams::CommandInfo help_commands[] =
     {CommandTag::HelpInfo, {}, {},  {{"info"}}, {{}, {}}},
     {CommandTag::HelpSet,  {}, {},  {{"set"}},  {{}, {}}},
     {CommandTag::HelpSave, {}, {},  {{"save"}}, {{}, {}}},
+    {CommandTag::HelpProfile, {}, {}, {{"profile"}}, {{}, {}}},
 
     // This should be placed at end of command (sub)lists.
     {CommandTag::End, {}, {}, {}, {}}
@@ -219,7 +282,8 @@ constexpr static const CLIParams::CommandInfo help_commands[] =
 constexpr static const CLIParams::CommandInfo commands_list[] =
 {
     {CommandTag::Backtrace, {}, {}, {{"backtrace", "bt"}},
-        {{}, "Print backtrace info."}},
+        {{}, "Print backtrace info. With `all --group`, threads with\n"
+             "identical backtraces are grouped."}},
 
     {CommandTag::Break, {}, {{{1, CompletionTag::Break}}}, {{"break", "b"}},
         {"<loc>", "Set breakpoint at specified location, where the\n"
@@ -254,6 +318,11 @@ constexpr static const CLIParams::CommandInfo commands_list[] =
     {CommandTag::Frame, {}, {}, {{"frame", "f"}},
         {{}, "Select & display stack frame."}},
 
+    {CommandTag::Handle, {}, {}, {{"handle"}},
+        {"<signal> stop|print|pass", "Set action for signal delivered to debuggee in interop mode:\n"
+                                     "stop execution, print signal and deliver it, or deliver\n"
+                                     "it silently (default)."}},
+
     {CommandTag::Interrupt, {}, {}, {{"interrupt"}},
         {{}, "Interrupt program execution, stop all threads."}},
 
@@ -281,6 +350,16 @@ constexpr static const CLIParams::CommandInfo commands_list[] =
     {CommandTag::Step, {}, {}, {{"step", "s"}},
         {{}, "Step program until a different source line."}},
 
+    {CommandTag::Trace, {}, {}, {{"trace"}},
+        {"[-args N] <loc>", "Set trace point at specified location (same as 'break'),\n"
+                            "hits are recorded with N leading arguments values\n"
+                            "without stop (see 'info trace')."}},
+
+    {CommandTag::Snapshot, {}, {{{1, CompletionTag::File}}}, {{"snapshot"}},
+        {"<file> [frames]", "Save threads stacks, locals of top frames (3 by default)\n"
+                            "and current exceptions without evaluation to the file\n"
+                            "in JSON format and detach from the debugged process."}},
+
     {CommandTag::Source, {}, {{{1, CompletionTag::File}}}, {{"source"}},
         {"<file>", "Read commands from a file."}},
 
@@ -296,6 +375,9 @@ constexpr static const CLIParams::CommandInfo commands_list[] =
     {CommandTag::Save, save_commands, {}, {{"save"}},
         {"args...", "Save misc. things to the files."}},
 
+    {CommandTag::Profile, profile_commands, {}, {{"profile"}},
+        {"args...", "Sampling profiler (see 'help profile')"}},
+
     {CommandTag::Help, help_commands, {}, {{"help"}},
         {"[topic]", "Show help on specified topic or print\n"
                     "this help message (if no argument specified)."}},
@@ -317,6 +399,7 @@ constexpr const CLIProtocol::CLIParams::CommandInfo CLIProtocol::CommandsList::h
 constexpr const CLIProtocol::CLIParams::CommandInfo CLIProtocol::CommandsList::info_commands[];
 constexpr const CLIProtocol::CLIParams::CommandInfo CLIProtocol::CommandsList::set_commands[];
 constexpr const CLIProtocol::CLIParams::CommandInfo CLIProtocol::CommandsList::save_commands[];
+constexpr const CLIProtocol::CLIParams::CommandInfo CLIProtocol::CommandsList::profile_commands[];
 
 // instantiate cli_helper class which allows to parse command line, dispatch
 // appropriate command or perform command completons
@@ -564,7 +647,9 @@ CLIProtocol::CLIProtocol(InStream& input, OutStream& output) :
   m_stoppedAt(0),
   m_frameIdx(0),
   m_sources(nullptr),
+  m_sourcesMaxSize(SourceStorage::DefaultMaxSize),
   m_term_settings(*this), 
+  m_batchMode(false),
   line_reader(),
   m_commandMode(CommandMode::Unset)
 {
@@ -591,7 +676,9 @@ int CLIProtocol::printf_checked(const char *fmt, ...)
         {
             lock_guard lock(m_cout_mutex);
             cout << buf;
-            cout.flush();
+            // Note, batch mode output is flushed before blocking and at exit only.
+            if (!m_batchMode)
+                cout.flush();
             return len;
         }
     }
@@ -606,7 +693,8 @@ int CLIProtocol::printf_checked(const char *fmt, ...)
 
     lock_guard lock(m_cout_mutex);
     cout << dbuf.get();
-    cout.flush();
+    if (!m_batchMode)
+        cout.flush();
     return len;
 }
 
@@ -837,6 +925,13 @@ void CLIProtocol::EmitStoppedEvent(const StoppedEvent &event)
                 int(event.threadId), frameLocation.c_str());
             break;
         }
+        case StopDataBreakpoint:
+        {
+            printf("\nstopped, reason: data breakpoint %i (%s) hit, thread id: %i, stopped threads: all, times= %u, frame={%s}\n",
+                  (unsigned int)event.breakpoint.id, event.breakpoint.funcname.c_str(), int(event.threadId),
+                  (unsigned int)event.breakpoint.hitCount, frameLocation.c_str());
+            break;
+        }
         case StopPause:
         {
 #ifdef INTEROP_DEBUGGING
@@ -896,7 +991,7 @@ void CLIProtocol::EmitTerminatedEvent()
 
 // This function implements Debugger interface and called from ManagedDebugger, 
 // as callback function, in separate thread.
-void CLIProtocol::EmitContinuedEvent(ThreadId threadId)
+void CLIProtocol::EmitContinuedEvent(ThreadId threadId, bool allThreadsContinued)
 {
     LogFuncEntry();
 }
@@ -1006,6 +1101,8 @@ HRESULT CLIProtocol::doCommand<CommandTag::Backtrace>(const std::vector<std::str
     }
 
     std::vector<std::string> args = args_orig;
+    // Note, must be erased before StripArgs() call, since this option have no value.
+    const bool groupThreads = ProtocolUtils::FindAndEraseArg(args, "--group");
     ProtocolUtils::StripArgs(args);
     int lowFrame = 0;
     int highFrame = FrameLevel::MaxFrameLevel;
@@ -1022,6 +1119,50 @@ HRESULT CLIProtocol::doCommand<CommandTag::Backtrace>(const std::vector<std::str
         }
 
         std::ostringstream ss;
+
+        // command "bt all --group", "parallel stacks" like view, threads with identical stack traces are grouped
+        if (groupThreads)
+        {
+            // Note, keep first thread order for groups.
+            std::vector<std::pair<std::string, std::vector<const Thread*>>> groups;
+            std::unordered_map<std::string, size_t> groupIndexes;
+
+            for (const auto &thread : threads)
+            {
+                std::string stackTrace;
+                if (FAILED(PrintFrames(thread.id, stackTrace, FrameLevel{lowFrame}, FrameLevel{highFrame})))
+                    continue;
+
+                auto find = groupIndexes.find(stackTrace);
+                if (find == groupIndexes.end())
+                {
+                    groupIndexes.emplace(stackTrace, groups.size());
+                    groups.emplace_back(std::move(stackTrace), std::vector<const Thread*>{&thread});
+                }
+                else
+                    groups[find->second].second.push_back(&thread);
+            }
+
+            for (const auto &group : groups)
+            {
+                ss << "\n" << group.second.size() << (group.second.size() == 1 ? " thread" : " threads") << ", id=\"";
+                for (size_t i = 0; i < group.second.size(); i++)
+                {
+                    ss << (i == 0 ? "" : ",") << int(group.second[i]->id);
+                }
+                ss << "\"\n" << group.first;
+            }
+
+            if (ss.str().empty())
+            {
+                output = "No stacktraces.";
+                return E_FAIL;
+            }
+
+            output = ss.str();
+            return S_OK;
+        }
+
         int number = 1;
 
         for (const auto &thread : threads)
@@ -1056,8 +1197,7 @@ HRESULT CLIProtocol::doCommand<CommandTag::Backtrace>(const std::vector<std::str
     return PrintFrames(threadId, output, FrameLevel{lowFrame}, FrameLevel{highFrame});
 }
 
-template <>
-HRESULT CLIProtocol::doCommand<CommandTag::Break>(const std::vector<std::string> &unmutable_args, std::string &output)
+HRESULT CLIProtocol::SetBreakpoint(const std::vector<std::string> &unmutable_args, std::string &output, bool trace, unsigned traceArgs)
 {
     HRESULT Status = E_FAIL;
     Breakpoint breakpoint;
@@ -1078,7 +1218,8 @@ HRESULT CLIProtocol::doCommand<CommandTag::Break>(const std::vector<std::string>
         struct LineBreak lb;
 
         if (ProtocolUtils::ParseBreakpoint(args, lb)
-            && SUCCEEDED(m_breakpointsHandle.SetLineBreakpoint(m_sharedDebugger, lb.module, lb.filename, lb.linenum, lb.condition, breakpoint)))
+            && SUCCEEDED(m_breakpointsHandle.SetLineBreakpoint(m_sharedDebugger, lb.module, lb.filename, lb.linenum, lb.condition, breakpoint,
+                                                               trace, traceArgs)))
             Status = S_OK;
     }
     else if (bt == BreakType::FuncBreak)
@@ -1086,7 +1227,8 @@ HRESULT CLIProtocol::doCommand<CommandTag::Break>(const std::vector<std::string>
         struct FuncBreak fb;
 
         if (ProtocolUtils::ParseBreakpoint(args, fb)
-            && SUCCEEDED(m_breakpointsHandle.SetFuncBreakpoint(m_sharedDebugger, fb.module, fb.funcname, fb.params, fb.condition, breakpoint)))
+            && SUCCEEDED(m_breakpointsHandle.SetFuncBreakpoint(m_sharedDebugger, fb.module, fb.funcname, fb.params, fb.condition, breakpoint,
+                                                               trace, traceArgs)))
             Status = S_OK;
     }
 
@@ -1098,6 +1240,33 @@ HRESULT CLIProtocol::doCommand<CommandTag::Break>(const std::vector<std::string>
     return Status;
 }
 
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::Break>(const std::vector<std::string> &args, std::string &output)
+{
+    return SetBreakpoint(args, output, false, 0);
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::Trace>(const std::vector<std::string> &unmutable_args, std::string &output)
+{
+    std::vector<std::string> args = unmutable_args;
+    unsigned traceArgs = 0;
+    if (args.size() > 2 && args[0] == "-args")
+    {
+        bool ok = true;
+        int count = ProtocolUtils::ParseInt(args[1], ok);
+        if (!ok || count < 0)
+        {
+            output = "Wrong trace point arguments count";
+            return E_INVALIDARG;
+        }
+        traceArgs = count;
+        args.erase(args.begin(), args.begin() + 2);
+    }
+
+    return SetBreakpoint(args, output, true, traceArgs);
+}
+
 template <>
 HRESULT CLIProtocol::doCommand<CommandTag::Catch>(const std::vector<std::string> &args, std::string &outStr)
 {
@@ -1393,8 +1562,10 @@ HRESULT CLIProtocol::doCommand<CommandTag::InfoThreads>(const std::vector<std::s
       }
     }
 
+    const bool refreshNames = !args.empty() && args[0] == "refresh";
+
     std::vector<Thread> threads;
-    if (FAILED(m_sharedDebugger->GetThreads(threads, true)))
+    if (FAILED(m_sharedDebugger->GetThreads(threads, true, refreshNames)))
     {
         output = "No threads.";
         return E_FAIL;
@@ -1506,6 +1677,308 @@ HRESULT CLIProtocol::doCommand<CommandTag::InfoBreakpoints>(const std::vector<st
     return S_OK;
 }
 
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::InfoStepStats>(const std::vector<std::string> &args, std::string &output)
+{
+    if (!args.empty() && args[0] == "reset")
+    {
+        StepStats::Reset();
+        output = "Stepping statistic reset.";
+        return S_OK;
+    }
+
+    std::ostringstream ss;
+    ss << "Stepping latency (microseconds):";
+
+    for (size_t i = 0; i < size_t(StepStats::Phase::Count); i++)
+    {
+        TimingHistogram::snapshot_t snapshot;
+        StepStats::GetSnapshot(StepStats::Phase(i), snapshot);
+
+        ss << "\n" << StepStats::GetPhaseName(StepStats::Phase(i)) << ": count=" << snapshot.count
+           << ", avg=" << (snapshot.count ? snapshot.totalUs / snapshot.count : 0) << ", max=" << snapshot.maxUs;
+
+        // Print only non empty buckets, as upper bound of bucket and count.
+        const char *separator = ", buckets=\"";
+        for (size_t b = 0; b < TimingHistogram::BucketsCount; b++)
+        {
+            if (snapshot.buckets[b] == 0)
+                continue;
+
+            uint64_t limit = TimingHistogram::GetBucketLimit(b);
+            ss << separator;
+            if (limit != 0)
+                ss << "<" << limit;
+            else
+                ss << ">=" << TimingHistogram::GetBucketLimit(b - 1);
+            ss << ":" << snapshot.buckets[b];
+            separator = " ";
+        }
+        if (separator[0] == ' ')
+            ss << "\"";
+    }
+
+    output = ss.str();
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::InfoPerfCounters>(const std::vector<std::string> &args, std::string &output)
+{
+    if (!args.empty() && args[0] == "reset")
+    {
+        PerfCounters::Reset();
+        output = "Performance counters reset.";
+        return S_OK;
+    }
+
+    if (!PerfCounters::IsEnabled())
+    {
+        output = "Performance counters disabled (see '--perf-counters' option).";
+        return E_FAIL;
+    }
+
+    output = PerfCounters::DumpJSON();
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::InfoTraceEvents>(const std::vector<std::string> &args, std::string &output)
+{
+    if (!TraceRecorder::IsEnabled())
+    {
+        output = "Trace events recording disabled (see '--trace-events' option).";
+        return E_FAIL;
+    }
+
+    if (args.size() != 1)
+    {
+        output = "Command requires file name or 'clear' as argument.";
+        return E_INVALIDARG;
+    }
+
+    if (args[0] == "clear")
+    {
+        TraceRecorder::Clear();
+        output = "Trace events removed.";
+        return S_OK;
+    }
+
+    if (!TraceRecorder::WriteChromeJSON(args[0]))
+    {
+        output = "Can't write trace events into '" + args[0] + "'.";
+        return E_FAIL;
+    }
+
+    output = "Trace events written into '" + args[0] + "'.";
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::InfoMemory>(const std::vector<std::string> &, std::string &output)
+{
+    MemoryUsage usage;
+    m_sharedDebugger->GetMemoryUsage(usage);
+
+    auto kib = [](uint64_t bytes) { return (bytes + 1023) / 1024; };
+    std::ostringstream ss;
+    ss << "Memory usage (KiB):"
+       << "\nsymbol readers: " << kib(usage.symbolReaders) << " (loaded " << usage.loadedReaders
+       << ", unloaded " << usage.unloadedReaders << ", limit ";
+    if (usage.symbolsLimit == 0)
+        ss << "none)";
+    else
+        ss << kib(usage.symbolsLimit) << ")";
+    ss << "\nmodules sources: " << kib(usage.modulesSources)
+       << "\nline updates: " << kib(usage.lineUpdates)
+       << "\nsequence points cache: " << kib(usage.sequencePoints)
+       << "\neval caches: " << kib(usage.evalCaches);
+
+    output = ss.str();
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::InfoTrace>(const std::vector<std::string> &args, std::string &output)
+{
+    HRESULT Status;
+    if (!args.empty() && args[0] == "clear")
+    {
+        IfFailRet(m_sharedDebugger->ClearTraceRecords());
+        output = "Trace points hits removed.";
+        return S_OK;
+    }
+
+    std::vector<TraceRecord> records;
+    uint64_t overwrittenCount = 0;
+    IfFailRet(m_sharedDebugger->GetTraceRecords(records, overwrittenCount, !args.empty() && args[0] == "drain"));
+
+    std::ostringstream ss;
+    ss << "Trace points hits (timestamp us, breakpoint, thread, location, arguments):";
+    for (const TraceRecord &record : records)
+    {
+        ss << "\n" << record.timestamp << " #" << record.breakpointId << " " << int(record.threadId) << " "
+           << record.module << "!" << record.method << " IL_" << std::hex << std::setw(4) << std::setfill('0')
+           << record.ilOffset << std::dec;
+        for (size_t i = 0; i < record.args.size(); i++)
+        {
+            ss << (i == 0 ? " (" : ", ") << record.args[i];
+        }
+        if (!record.args.empty())
+            ss << ")";
+    }
+    if (overwrittenCount != 0)
+        ss << "\nOverwritten (trace buffer is full): " << overwrittenCount;
+
+    output = ss.str();
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::InfoHeap>(const std::vector<std::string> &unmutable_args, std::string &output)
+{
+    std::vector<std::string> args = unmutable_args;
+    bool sortByCount = false;
+    if (!args.empty() && args[0] == "count")
+    {
+        sortByCount = true;
+        args.erase(args.begin());
+    }
+
+    unsigned topCount = 20;
+    if (!args.empty())
+    {
+        bool ok = true;
+        int count = ProtocolUtils::ParseInt(args[0], ok);
+        if (!ok || count <= 0)
+        {
+            output = "Wrong types count";
+            return E_INVALIDARG;
+        }
+        topCount = count;
+    }
+
+    auto kib = [](uint64_t bytes) { return (bytes + 1023) / 1024; };
+    HRESULT Status;
+    HeapStatistics statistics;
+    // Note, heap walk could take a while for large heaps, show progress during walk.
+    IfFailRet(m_sharedDebugger->GetHeapStatistics(topCount, sortByCount, [&](const HeapStatistics &partial)
+    {
+        printf("Heap walk: %llu objects, %llu KiB...\n", (unsigned long long)partial.objectsCount,
+               (unsigned long long)kib(partial.totalSize));
+    }, statistics));
+
+    std::ostringstream ss;
+    ss << "Heap: " << statistics.objectsCount << " objects, " << kib(statistics.totalSize) << " KiB, "
+       << statistics.typesCount << " types\nTypes (size KiB, count, type):";
+    for (const HeapTypeStatistic &type : statistics.types)
+    {
+        ss << "\n" << kib(type.size) << " " << type.count << " " << type.typeName;
+    }
+
+    output = ss.str();
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::InfoGCRoot>(const std::vector<std::string> &args, std::string &output)
+{
+    if (args.empty())
+    {
+        output = "Expression required";
+        return E_INVALIDARG;
+    }
+
+    std::string expression = args[0];
+    for (size_t i = 1; i < args.size(); i++)
+    {
+        expression += " " + args[i];
+    }
+
+    FrameId frameId;
+    {
+        lock_guard lock(m_mutex);
+        frameId = FrameId(m_sharedDebugger->GetLastStoppedThreadId(), FrameLevel{m_frameIdx});
+    }
+
+    HRESULT Status;
+    GCRootPath path;
+    IfFailRet(m_sharedDebugger->FindGCRootPath(frameId, expression, defaultEvalFlags, path));
+
+    if (path.objects.empty())
+    {
+        output = "Object is not reachable from GC roots.";
+        return S_OK;
+    }
+
+    std::ostringstream ss;
+    ss << "GC root: " << path.rootKind;
+    for (const GCRootPathObject &object : path.objects)
+    {
+        ss << "\n  -> 0x" << std::hex << object.address << std::dec << " " << object.typeName;
+    }
+
+    output = ss.str();
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::InfoTasks>(const std::vector<std::string> &args, std::string &output)
+{
+    const bool includeCompleted = !args.empty() && args[0] == "all";
+
+    HRESULT Status;
+    std::vector<AsyncTaskGroup> groups;
+    uint64_t tasksCount = 0;
+    IfFailRet(m_sharedDebugger->GetAsyncTasks(includeCompleted, groups, tasksCount));
+
+    std::ostringstream ss;
+    ss << "Tasks: " << tasksCount << ", groups: " << groups.size();
+    for (const AsyncTaskGroup &group : groups)
+    {
+        ss << "\n" << group.count << " " << group.status << " " << group.name;
+        if (!group.tasks.empty())
+            ss << " (0x" << std::hex << group.tasks.front() << std::dec << (group.count > 1 ? ", ..." : "") << ")";
+        for (const StackFrame &frame : group.asyncStack)
+        {
+            ss << "\n    " << frame.methodName;
+            if (!frame.source.IsNull())
+                ss << " at " << frame.source.path << ":" << frame.line;
+        }
+    }
+
+    output = ss.str();
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::InfoExceptions>(const std::vector<std::string> &args, std::string &output)
+{
+    HRESULT Status;
+    std::vector<ExceptionStatistic> statistics;
+    uint64_t droppedCount = 0;
+    IfFailRet(m_sharedDebugger->GetExceptionStatistics(statistics, droppedCount, !args.empty() && args[0] == "reset"));
+
+    std::ostringstream ss;
+    if (!m_sharedDebugger->IsExceptionStatistics())
+        ss << "Exception statistics disabled (see 'set exception-stats').\n";
+    ss << "Exceptions (count, type, throw-site):";
+    for (const ExceptionStatistic &statistic : statistics)
+    {
+        ss << "\n" << statistic.count << " " << statistic.exceptionType << " ";
+        if (statistic.module.empty())
+            ss << "<native code>";
+        else
+            ss << statistic.module << "!" << statistic.method << " IL_" << std::hex << std::setw(4) << std::setfill('0')
+               << statistic.ilOffset << std::dec;
+    }
+    if (droppedCount != 0)
+        ss << "\nNot aggregated (too many throw-sites): " << droppedCount;
+
+    output = ss.str();
+    return S_OK;
+}
+
 
 template <>
 HRESULT CLIProtocol::doCommand<CommandTag::Interrupt>(const std::vector<std::string> &, std::string &output)
@@ -1629,17 +2102,18 @@ HRESULT CLIProtocol::doCommand<CommandTag::List>(const std::vector<std::string>
         for (int i = 0; i < lines; i++, line++)
         {
             const char* errMessage = nullptr;
-            char* toPrint = m_sources->getLine(m_sourcePath, line, &errMessage);
+            string_view toPrint;
+            bool found = m_sources->getLine(m_sourcePath, line, toPrint, &errMessage);
             if (errMessage)
             {
                 printf("Source code file: %s\n%s\n", m_sourcePath.c_str(), errMessage);
             }
-            if (toPrint)
+            if (found)
             {
                 if(line == m_stoppedAt)
-                    printf(" > %d\t%s\n", line,  toPrint);
+                    printf(" > %d\t%.*s\n", line, (int)toPrint.size(), toPrint.data());
                 else
-                    printf("   %d\t%s\n", line,  toPrint);
+                    printf("   %d\t%.*s\n", line, (int)toPrint.size(), toPrint.data());
             }
             else
                 break; // end of file
@@ -1747,7 +2221,7 @@ HRESULT CLIProtocol::doCommand<CommandTag::Run>(const std::vector<std::string> &
 
     HRESULT Status;
     m_sharedDebugger->Initialize();
-    m_sources.reset(new SourceStorage(m_sharedDebugger.get()));
+    m_sources.reset(new SourceStorage(m_sharedDebugger.get(), m_sourcesMaxSize));
     IfFailRet(m_sharedDebugger->Launch(exec_file, exec_args, {}, "", false));
 
     lock.lock();
@@ -1795,7 +2269,7 @@ HRESULT CLIProtocol::doCommand<CommandTag::Attach>(const std::vector<std::string
 
     HRESULT Status;
     m_sharedDebugger->Initialize();
-    m_sources.reset(new SourceStorage(m_sharedDebugger.get()));
+    m_sources.reset(new SourceStorage(m_sharedDebugger.get(), m_sourcesMaxSize));
     IfFailRet(m_sharedDebugger->Attach(pid));
 
     lock.lock();
@@ -1846,6 +2320,79 @@ HRESULT CLIProtocol::doCommand<CommandTag::Source>(const std::vector<std::string
 }
 
 
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::Handle>(const std::vector<std::string> &args, std::string &output)
+{
+    if (args.size() != 2)
+        return E_INVALIDARG;
+
+    SignalAction action;
+    if (args[1] == "stop")
+        action = SignalAction::Stop;
+    else if (args[1] == "print")
+        action = SignalAction::Print;
+    else if (args[1] == "pass")
+        action = SignalAction::Pass;
+    else
+        return E_INVALIDARG;
+
+    HRESULT Status;
+    IfFailRet(m_sharedDebugger->SetSignalAction(args[0], action));
+    output = "Signal " + args[0] + " action set to " + args[1] + ".";
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::Snapshot>(const std::vector<std::string> &args, std::string &output)
+{
+    if (args.empty() || args.size() > 2)
+        return E_INVALIDARG;
+
+    unsigned localsFrames = 3;
+    if (args.size() == 2)
+    {
+        char *end;
+        localsFrames = strtoul(args[1].c_str(), &end, 10);
+        if (*end != 0)
+            return E_INVALIDARG;
+    }
+
+    {
+      lock_guard lock(m_mutex);
+
+      if (m_processStatus == NotStarted || m_processStatus == Exited)
+      {
+          output = "No process to snapshot.";
+          return E_FAIL;
+      }
+    }
+
+    std::string snapshot;
+    HRESULT Status;
+    IfFailRet(m_sharedDebugger->SnapshotAndDetach(localsFrames, snapshot));
+
+    const std::string& filename = args[0];
+    std::unique_ptr<FILE, std::function<void(FILE*)> >
+        file {fopen(filename.c_str(), "w"), [](FILE *file){ if (file) fclose(file); }};
+    if (!file || fwrite(snapshot.data(), 1, snapshot.size(), file.get()) != snapshot.size())
+    {
+        output = filename + ": ";
+        char buf[1024];
+#if defined(_MSC_VER)
+        if (strerror_s(buf, sizeof(buf), errno) == 0)
+            output += buf;
+        else
+            output += "Could not translate errno to a string";
+#else
+        output += strerror_r(errno, buf, sizeof(buf));
+#endif
+        return E_FAIL;
+    }
+
+    output = "Snapshot saved to " + filename + ".";
+    return S_OK;
+}
+
 template <>
 HRESULT CLIProtocol::doCommand<CommandTag::Wait>(const std::vector<std::string> &, std::string &)
 {
@@ -1964,6 +2511,91 @@ HRESULT CLIProtocol::doCommand<CommandTag::SaveHelp>(const std::vector<std::stri
 }
 
 
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::Profile>(const std::vector<std::string> &args, std::string &output)
+{
+    printf("Argument(s) required: see 'help profile' for details.\n");
+    return S_FALSE;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::ProfileStart>(const std::vector<std::string> &args, std::string &output)
+{
+    static const int DefaultInterval = 10;
+    bool ok = true;
+    int interval = args.empty() ? DefaultInterval : ProtocolUtils::ParseInt(args[0], ok);
+    if (!ok || interval <= 0)
+        return E_INVALIDARG;
+
+    HRESULT Status;
+    IfFailRet(m_sharedDebugger->StartSampling(interval));
+    output = "Sampling started with " + std::to_string(interval) + " ms interval.";
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::ProfileStop>(const std::vector<std::string> &args, std::string &output)
+{
+    uint64_t samplesCount = 0;
+    HRESULT Status;
+    IfFailRet(m_sharedDebugger->StopSampling(samplesCount));
+    output = "Sampling stopped, " + std::to_string(samplesCount) + " samples collected.";
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::ProfileExport>(const std::vector<std::string> &args, std::string &output)
+{
+    SamplesFormat format;
+    if (args.empty() || args.size() > 2)
+        return E_INVALIDARG;
+    else if (args[0] == "folded")
+        format = SamplesFormat::Folded;
+    else if (args[0] == "speedscope")
+        format = SamplesFormat::Speedscope;
+    else
+        return E_INVALIDARG;
+
+    std::string samples;
+    HRESULT Status;
+    IfFailRet(m_sharedDebugger->ExportSamples(format, samples));
+
+    if (args.size() == 1)
+    {
+        output = std::move(samples);
+        return S_OK;
+    }
+
+    const std::string& filename = args[1];
+    std::unique_ptr<FILE, std::function<void(FILE*)> >
+        file {fopen(filename.c_str(), "w"), [](FILE *file){ if (file) fclose(file); }};
+    if (!file || fwrite(samples.data(), 1, samples.size(), file.get()) != samples.size())
+    {
+        output = filename + ": ";
+        char buf[1024];
+#if defined(_MSC_VER)
+        if (strerror_s(buf, sizeof(buf), errno) == 0)
+            output += buf;
+        else
+            output += "Could not translate errno to a string";
+#else
+        output += strerror_r(errno, buf, sizeof(buf));
+#endif
+        return E_FAIL;
+    }
+
+    output = "Samples saved to " + filename + ".";
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::ProfileHelp>(const std::vector<std::string> &args, std::string &output)
+{
+    printHelp(CommandsList::profile_commands, args.empty() ? string_view{} : string_view{args[0]});
+    return S_OK;
+}
+
+
 template <>
 HRESULT CLIProtocol::doCommand<CommandTag::SetArgs>(const std::vector<std::string> &args, std::string &output)
 {
@@ -1992,6 +2624,28 @@ HRESULT CLIProtocol::doCommand<CommandTag::SetStepFiltering>(const std::vector<s
     return S_OK;
 }
 
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::SetEvalTimeout>(const std::vector<std::string> &args, std::string &output)
+{
+    bool ok = false;
+    int timeout = args.empty() ? 0 : ProtocolUtils::ParseInt(args[0], ok);
+    if (!ok || timeout < 0)
+        return E_INVALIDARG;
+
+    m_sharedDebugger->SetEvalTimeout(timeout);
+    return S_OK;
+}
+
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::SetExceptionStats>(const std::vector<std::string> &args, std::string &output)
+{
+    if (args.empty() || (args[0] != "0" && args[0] != "1"))
+        return E_INVALIDARG;
+
+    m_sharedDebugger->SetExceptionStatistics(args[0] == "1");
+    return S_OK;
+}
+
 template <>
 HRESULT CLIProtocol::doCommand<CommandTag::SetHelp>(const std::vector<std::string> &args, std::string &output)
 {
@@ -2017,6 +2671,12 @@ HRESULT CLIProtocol::doCommand<CommandTag::HelpSave>(const std::vector<std::stri
     return doCommand<CommandTag::SaveHelp>(args, output);
 }
 
+template <>
+HRESULT CLIProtocol::doCommand<CommandTag::HelpProfile>(const std::vector<std::string> &args, std::string &output)
+{
+    return doCommand<CommandTag::ProfileHelp>(args, output);
+}
+
 
 // This function tries to complete command `str`, where the cursor position is `cursor`:
 // functor `func` will be called for each possible completion variant.
@@ -2247,7 +2907,7 @@ std::tuple<string_view, CLIProtocol::LineReader::Result> CLIProtocol::getLine(co
 }
 
 
-HRESULT CLIProtocol::execCommands(LineReader&& lr, bool printCommands)
+HRESULT CLIProtocol::execCommands(LineReader&& lr, bool printCommands, std::ostream *results)
 {
     // preserve currently existing line reader and restore it on exit
     auto restorer = [&](LineReader* save) { line_reader = save; };
@@ -2278,6 +2938,17 @@ HRESULT CLIProtocol::execCommands(LineReader&& lr, bool printCommands)
         // should input be passed to debuggee stdin?
         if (process_stdin && m_commandMode == CommandMode::Synchronous && m_processStatus == Running)
         {
+            if (m_batchMode)
+            {
+                // Note, batch script don't feed debuggee stdin, next command is executed after debuggee stop or exit.
+                {
+                    lock_guard lockCout(m_cout_mutex);
+                    cout.flush();
+                }
+                m_state_cv.wait(lock, [&]() { return m_processStatus != Running; });
+                continue;
+            }
+
             lock.unlock();
 
             // blocking here on undefined time (till error, EOF or Ctrl-C).
@@ -2350,6 +3021,9 @@ HRESULT CLIProtocol::execCommands(LineReader&& lr, bool printCommands)
             while (tokenizer.Next(result))
                args.push_back(result);
 
+            TraceRecorder::ScopedEvent traceEvent("protocol", "ExecuteCommand");
+            if (TraceRecorder::IsEnabled())
+                traceEvent.SetArg(std::string(str));
             hr = (this->*func)(args, output);
             have_result = true;
         };
@@ -2370,6 +3044,19 @@ HRESULT CLIProtocol::execCommands(LineReader&& lr, bool printCommands)
             hr = E_FAIL;
         }
 
+        if (results)
+        {
+            std::string result;
+            JsonWriter writer(result);
+            writer.BeginObject()
+                .Key("command").String(input)
+                .Key("status").String(SUCCEEDED(hr) ? "done" : "error")
+                .Key("code").UInt(uint32_t(hr))
+                .Key("output").String(output)
+                .EndObject();
+            *results << result << '\n';
+        }
+
         if (m_exit)
             break;
 
@@ -2406,6 +3093,87 @@ void CLIProtocol::Source(span<const string_view> init_commands)
 }
 
 
+bool CLIProtocol::SetBatchMode(const std::string &resultsPath)
+{
+    if (!resultsPath.empty())
+    {
+        m_batchResults.reset(new std::ofstream(resultsPath.c_str()));
+        if (m_batchResults->fail())
+        {
+            m_batchResults.reset();
+            return false;
+        }
+    }
+
+    m_batchMode = true;
+    return true;
+}
+
+
+HRESULT CLIProtocol::ExecBatch(span<const string_view> commands)
+{
+    assert(m_batchMode);
+
+    {
+        lock_guard lock(m_mutex);
+        if (m_commandMode == CommandMode::Unset)
+            m_commandMode = CommandMode::Synchronous;
+        // Note, no repaint needed, since there is no prompt.
+        m_repaint_fn = nullptr;
+    }
+
+    // Note, forward_list keeps strings addresses, so, string_view for lines stay valid.
+    static const string_view SourcePrefix = "source ";
+    std::forward_list<std::string> scripts;
+    std::vector<string_view> lines;
+    for (string_view command : commands)
+    {
+        if (command.compare(0, SourcePrefix.size(), SourcePrefix) != 0)
+        {
+            lines.push_back(command);
+            continue;
+        }
+
+        std::ifstream file(std::string(command.substr(SourcePrefix.size())).c_str(), std::ios::binary);
+        if (file.fail())
+        {
+            // `source` command will report error.
+            lines.push_back(command);
+            continue;
+        }
+
+        std::ostringstream content;
+        content << file.rdbuf();
+        scripts.push_front(content.str());
+        string_view script(scripts.front());
+        while (!script.empty())
+        {
+            size_t end = script.find('\n');
+            string_view line = script.substr(0, end);
+            script = end == string_view::npos ? string_view{} : script.substr(end + 1);
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if (!line.empty())
+                lines.push_back(line);
+        }
+    }
+
+    LOGI("Batch mode: %u commands", unsigned(lines.size()));
+    HRESULT Status = execCommands(MemoryLineReader(lines), false, m_batchResults.get());
+
+    m_sharedDebugger->Disconnect(); // Terminate debuggee process if debugger ran this process and detach in case debugger was attached to it.
+
+    {
+        lock_guard lock(m_cout_mutex);
+        cout.flush();
+    }
+    if (m_batchResults)
+        m_batchResults->flush();
+
+    return Status;
+}
+
+
 // Note, caller must lock m_mutex.
 void CLIProtocol::repaint()
 {
@@ -64,6 +64,7 @@ class CLIProtocol : public IProtocol
     int m_stoppedAt;
     int m_frameIdx;
     std::unique_ptr<SourceStorage> m_sources;
+    size_t m_sourcesMaxSize;
 
     // Functor which is called when UI repaint required.
     std::function<void()> m_repaint_fn;
@@ -77,6 +78,9 @@ class CLIProtocol : public IProtocol
     };
     TermSettings m_term_settings;
 
+    bool m_batchMode;
+    std::unique_ptr<std::ostream> m_batchResults;
+
     int printf_checked(const char *fmt, ...);
 
     static HRESULT PrintBreakpoint(const Breakpoint &b, std::string &output);
@@ -90,7 +94,7 @@ public:
     void EmitStoppedEvent(const StoppedEvent &event) override;
     void EmitExitedEvent(const ExitedEvent &event) override;
     void EmitTerminatedEvent() override;
-    void EmitContinuedEvent(ThreadId threadId) override;
+    void EmitContinuedEvent(ThreadId threadId, bool allThreadsContinued) override;
     void EmitInteropDebuggingErrorEvent(const int error_n) override;
     void EmitThreadEvent(const ThreadEvent &event) override;
     void EmitModuleEvent(const ModuleEvent &event) override;
@@ -101,6 +105,15 @@ public:
 
     void Source(span<const string_view> init_commands = {});
 
+    // Batch mode (see `--batch` option): commands are executed without interactive console (no prompts, line
+    // editing and history), output is buffered and debuggee stdin is not read. In case `resultsPath` isn't empty,
+    // result of each command is written into file as JSON object per line. Must be called before ExecBatch().
+    bool SetBatchMode(const std::string &resultsPath);
+
+    // Execute commands back-to-back and finish session (like CommandLoop() does). Scripts provided as
+    // `source <file>` commands are read and split to lines up front.
+    HRESULT ExecBatch(span<const string_view> commands);
+
     void SetLaunchCommand(const std::string &fileExec, const std::vector<std::string> &args) override
     {
         lock_guard lock(m_mutex);
@@ -108,6 +121,9 @@ public:
         m_execArgs = args;
     }
 
+    // Set max size (in bytes) of source files cached for `list` command.
+    void SetSourcesCacheSize(size_t size) { m_sourcesMaxSize = size; }
+
     enum class CommandMode
     {
         Asynchronous,
@@ -178,6 +194,7 @@ private:
     HRESULT StepCommand(const std::vector<std::string> &args,
                         std::string &output,
                         IDebugger::StepType stepType);
+    HRESULT SetBreakpoint(const std::vector<std::string> &args, std::string &output, bool trace, unsigned traceArgs);
     HRESULT PrintFrames(ThreadId threadId, std::string &output, FrameLevel lowFrame, FrameLevel highFrame);
     HRESULT PrintVariable(const Variable &v, std::ostringstream &output, bool expand, bool is_static);
     static HRESULT PrintFrameLocation(const StackFrame &stackFrame, std::string &output);
@@ -213,8 +230,9 @@ private:
     std::tuple<string_view, LineReader::Result> getLine(const char *prompt);
 
     // This function interprets commands from the input till reaching Eof or Error.
-    // Function returns E_FAIL in case of input error.
-    HRESULT execCommands(LineReader&&, bool printCommands = false);
+    // Function returns E_FAIL in case of input error. In case `results` provided,
+    // result of each command is written into stream (see SetBatchMode()).
+    HRESULT execCommands(LineReader&&, bool printCommands = false, std::ostream *results = nullptr);
 
     // update screen (after asynchronous message printed)
     void repaint();
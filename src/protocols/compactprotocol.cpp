@@ -0,0 +1,721 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// note: order matters, compactprotocol.h should be included before winerror.h
+#include "protocols/compactprotocol.h"
+#include "winerror.h"
+
+#include "interfaces/idebugger.h"
+#include "utils/logger.h"
+#include "utils/torelease.h"
+#include "utils/utf.h"
+
+namespace netcoredbg
+{
+
+const uint32_t CompactProtocol::MaxMessageSize;
+
+namespace // unnamed namespace
+{
+
+const size_t LengthPrefixSize = 4;
+
+// Default levels for "allStackTraces" request (stack traces for all threads at once).
+const int64_t DefaultAllStackTracesLevels = 20;
+
+int64_t GetInt(const MsgPackValue &arguments, string_view key, int64_t defaultValue)
+{
+    const MsgPackValue *value = arguments.Find(key);
+    return value ? value->GetInt(defaultValue) : defaultValue;
+}
+
+bool GetBool(const MsgPackValue &arguments, string_view key, bool defaultValue)
+{
+    const MsgPackValue *value = arguments.Find(key);
+    return value ? value->GetBool(defaultValue) : defaultValue;
+}
+
+std::string GetString(const MsgPackValue &arguments, string_view key, const std::string &defaultValue = std::string())
+{
+    const MsgPackValue *value = arguments.Find(key);
+    return value ? value->GetString(defaultValue) : defaultValue;
+}
+
+std::vector<std::string> GetStringArray(const MsgPackValue &arguments, string_view key)
+{
+    std::vector<std::string> result;
+    const MsgPackValue *value = arguments.Find(key);
+    if (value == nullptr)
+        return result;
+
+    for (const auto &entry : value->GetArray())
+    {
+        result.emplace_back(entry.GetString());
+    }
+    return result;
+}
+
+HRESULT GetThreadId(const MsgPackValue &arguments, ThreadId &threadId)
+{
+    int64_t id = GetInt(arguments, "threadId", 0);
+    if (id <= 0 || id > INT_MAX)
+        return E_INVALIDARG;
+
+    threadId = ThreadId{int(id)};
+    return S_OK;
+}
+
+HRESULT GetFrameId(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &arguments, FrameId &frameId)
+{
+    const MsgPackValue *value = arguments.Find("frameId");
+    if (value == nullptr)
+    {
+        ThreadId threadId = sharedDebugger->GetLastStoppedThreadId();
+        if (!threadId)
+            return E_INVALIDARG;
+
+        frameId = FrameId{threadId, FrameLevel{0}};
+        return S_OK;
+    }
+
+    int64_t id = value->GetInt(-1);
+    if (id < 0 || id > FrameId::MaxFrameId)
+        return E_INVALIDARG;
+
+    frameId = FrameId{int(id)};
+    return S_OK;
+}
+
+// Positional arrays, see docs/compactprotocol.md for fields order.
+
+void WriteThread(MsgPackWriter &writer, const Thread &thread)
+{
+    writer.Array(3)
+        .Int(int(thread.id))
+        .String(thread.name)
+        .Bool(thread.running);
+}
+
+void WriteStackFrame(MsgPackWriter &writer, const StackFrame &frame)
+{
+    writer.Array(9)
+        .Int(int(frame.id))
+        .String(frame.methodName)
+        .Int(frame.line)
+        .Int(frame.column)
+        .Int(frame.endLine)
+        .Int(frame.endColumn)
+        .String(frame.moduleId)
+        .String(frame.source.name)
+        .String(frame.source.path);
+}
+
+void WriteVariable(MsgPackWriter &writer, const Variable &variable)
+{
+    writer.Array(7)
+        .String(variable.name)
+        .String(variable.value)
+        .String(variable.type)
+        .String(variable.evaluateName)
+        .UInt(variable.variablesReference)
+        .Int(variable.namedVariables)
+        .Int(variable.indexedVariables);
+}
+
+void WriteScope(MsgPackWriter &writer, const Scope &scope)
+{
+    writer.Array(5)
+        .String(scope.name)
+        .UInt(scope.variablesReference)
+        .Int(scope.namedVariables)
+        .Int(scope.indexedVariables)
+        .Bool(scope.expensive);
+}
+
+void WriteBreakpoint(MsgPackWriter &writer, const Breakpoint &breakpoint)
+{
+    writer.Array(5)
+        .UInt(breakpoint.id)
+        .Bool(breakpoint.verified)
+        .Int(breakpoint.line)
+        .String(breakpoint.source.path)
+        .String(breakpoint.message);
+}
+
+template <typename T>
+void WriteArray(MsgPackWriter &writer, const std::vector<T> &values, void (*writeValue)(MsgPackWriter &, const T &))
+{
+    writer.Array(values.size());
+    for (const auto &value : values)
+    {
+        writeValue(writer, value);
+    }
+}
+
+typedef HRESULT (*CommandHandler)(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &arguments,
+                                  MsgPackWriter &body, std::string &message);
+
+HRESULT HandleInitialize(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &, MsgPackWriter &body, std::string &)
+{
+    HRESULT Status;
+    IfFailRet(sharedDebugger->Initialize());
+    body.Map(1).Key("protocolVersion").UInt(1);
+    return S_OK;
+}
+
+HRESULT HandleAttach(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &arguments, MsgPackWriter &, std::string &)
+{
+    int64_t processId = GetInt(arguments, "processId", 0);
+    if (processId <= 0 || processId > INT_MAX)
+        return E_INVALIDARG;
+
+    sharedDebugger->SetEvalTimeout(unsigned(GetInt(arguments, "evalTimeout", 0)));
+    return sharedDebugger->Attach(int(processId));
+}
+
+HRESULT HandleConfigurationDone(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &, MsgPackWriter &, std::string &)
+{
+    return sharedDebugger->ConfigurationDone();
+}
+
+HRESULT HandleSetBreakpoints(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &arguments, MsgPackWriter &body, std::string &)
+{
+    std::string path = GetString(arguments, "source");
+    if (path.empty())
+        return E_INVALIDARG;
+
+    std::vector<LineBreakpoint> lineBreakpoints;
+    const MsgPackValue *breakpointsArg = arguments.Find("breakpoints");
+    if (breakpointsArg != nullptr)
+    {
+        for (const auto &entry : breakpointsArg->GetArray())
+        {
+            int64_t line = GetInt(entry, "line", 0);
+            if (line <= 0 || line > INT_MAX)
+                return E_INVALIDARG;
+
+            lineBreakpoints.emplace_back(std::string(), int(line), GetString(entry, "condition"),
+                                         GetString(entry, "hitCondition"), GetString(entry, "logMessage"));
+        }
+    }
+
+    HRESULT Status;
+    std::vector<Breakpoint> breakpoints;
+    IfFailRet(sharedDebugger->SetLineBreakpoints(path, lineBreakpoints, breakpoints));
+
+    body.Map(1).Key("breakpoints");
+    WriteArray(body, breakpoints, &WriteBreakpoint);
+    return S_OK;
+}
+
+HRESULT HandleSetExceptionBreakpoints(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &arguments, MsgPackWriter &, std::string &)
+{
+    std::vector<ExceptionBreakpoint> exceptionBreakpoints;
+    for (const auto &filter : GetStringArray(arguments, "filters"))
+    {
+        if (filter == "all")
+            exceptionBreakpoints.emplace_back(ExceptionCategory::ANY, ExceptionBreakpointFilter::THROW);
+        else if (filter == "user-unhandled")
+            exceptionBreakpoints.emplace_back(ExceptionCategory::ANY, ExceptionBreakpointFilter::USER_UNHANDLED);
+        else
+            return E_INVALIDARG;
+    }
+
+    std::vector<Breakpoint> breakpoints;
+    return sharedDebugger->SetExceptionBreakpoints(exceptionBreakpoints, breakpoints);
+}
+
+HRESULT HandleContinue(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &arguments, MsgPackWriter &, std::string &)
+{
+    HRESULT Status;
+    ThreadId threadId;
+    IfFailRet(GetThreadId(arguments, threadId));
+    return sharedDebugger->Continue(threadId);
+}
+
+HRESULT HandlePause(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &arguments, MsgPackWriter &, std::string &)
+{
+    HRESULT Status;
+    ThreadId threadId;
+    IfFailRet(GetThreadId(arguments, threadId));
+    return sharedDebugger->Pause(threadId, EventFormat::Default);
+}
+
+template <IDebugger::StepType stepType>
+HRESULT HandleStep(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &arguments, MsgPackWriter &, std::string &)
+{
+    HRESULT Status;
+    ThreadId threadId;
+    IfFailRet(GetThreadId(arguments, threadId));
+    return sharedDebugger->StepCommand(threadId, stepType);
+}
+
+HRESULT HandleThreads(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &, MsgPackWriter &body, std::string &)
+{
+    HRESULT Status;
+    std::vector<Thread> threads;
+    IfFailRet(sharedDebugger->GetThreads(threads));
+
+    body.Map(1).Key("threads");
+    WriteArray(body, threads, &WriteThread);
+    return S_OK;
+}
+
+HRESULT HandleStackTrace(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &arguments, MsgPackWriter &body, std::string &)
+{
+    HRESULT Status;
+    ThreadId threadId;
+    IfFailRet(GetThreadId(arguments, threadId));
+
+    int64_t startFrame = GetInt(arguments, "startFrame", 0);
+    int64_t levels = GetInt(arguments, "levels", 0);
+    if (startFrame < 0 || startFrame > FrameLevel::MaxFrameLevel || levels < 0)
+        return E_INVALIDARG;
+
+    std::vector<StackFrame> stackFrames;
+    int totalFrames = 0;
+    IfFailRet(sharedDebugger->GetStackTrace(threadId, FrameLevel{int(startFrame)}, unsigned(levels), stackFrames, totalFrames));
+
+    body.Map(2).Key("totalFrames").Int(totalFrames).Key("stackFrames");
+    WriteArray(body, stackFrames, &WriteStackFrame);
+    return S_OK;
+}
+
+// Not part of DAP, provide threads with top stack frames for all threads in one round trip.
+HRESULT HandleAllStackTraces(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &arguments, MsgPackWriter &body, std::string &)
+{
+    HRESULT Status;
+    int64_t levels = GetInt(arguments, "levels", DefaultAllStackTracesLevels);
+    if (levels < 0)
+        return E_INVALIDARG;
+
+    std::vector<Thread> threads;
+    IfFailRet(sharedDebugger->GetThreads(threads));
+
+    body.Map(1).Key("threads").Array(threads.size());
+    std::vector<StackFrame> stackFrames;
+    for (const auto &thread : threads)
+    {
+        stackFrames.clear();
+        int totalFrames = 0;
+        // Note, stack trace could be unavailable for some threads (for example, running threads), provide empty stack.
+        if (FAILED(sharedDebugger->GetStackTrace(thread.id, FrameLevel{0}, unsigned(levels), stackFrames, totalFrames)))
+        {
+            stackFrames.clear();
+            totalFrames = 0;
+        }
+
+        body.Array(4).Int(int(thread.id)).String(thread.name).Int(totalFrames);
+        WriteArray(body, stackFrames, &WriteStackFrame);
+    }
+    return S_OK;
+}
+
+HRESULT HandleScopes(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &arguments, MsgPackWriter &body, std::string &)
+{
+    HRESULT Status;
+    FrameId frameId;
+    IfFailRet(GetFrameId(sharedDebugger, arguments, frameId));
+
+    std::vector<Scope> scopes;
+    IfFailRet(sharedDebugger->GetScopes(frameId, scopes));
+
+    body.Map(1).Key("scopes");
+    WriteArray(body, scopes, &WriteScope);
+    return S_OK;
+}
+
+HRESULT HandleVariables(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &arguments, MsgPackWriter &body, std::string &)
+{
+    HRESULT Status;
+    int64_t reference = GetInt(arguments, "variablesReference", 0);
+    int64_t start = GetInt(arguments, "start", 0);
+    int64_t count = GetInt(arguments, "count", 0);
+    if (reference <= 0 || reference > UINT32_MAX || start < 0 || start > INT_MAX || count < 0 || count > INT_MAX)
+        return E_INVALIDARG;
+
+    VariablesFilter filter = VariablesBoth;
+    std::string filterName = GetString(arguments, "filter");
+    if (filterName == "named")
+        filter = VariablesNamed;
+    else if (filterName == "indexed")
+        filter = VariablesIndexed;
+    else if (!filterName.empty())
+        return E_INVALIDARG;
+
+    std::vector<Variable> variables;
+    IfFailRet(sharedDebugger->GetVariables(uint32_t(reference), filter, int(start), int(count), variables));
+
+    body.Map(1).Key("variables");
+    WriteArray(body, variables, &WriteVariable);
+    return S_OK;
+}
+
+HRESULT HandleEvaluate(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &arguments, MsgPackWriter &body, std::string &message)
+{
+    HRESULT Status;
+    std::string expression = GetString(arguments, "expression");
+    FrameId frameId;
+    IfFailRet(GetFrameId(sharedDebugger, arguments, frameId));
+
+    Variable variable;
+    IfFailRet(sharedDebugger->Evaluate(frameId, expression, variable, message));
+
+    variable.name = expression;
+    body.Map(1).Key("variable");
+    WriteVariable(body, variable);
+    return S_OK;
+}
+
+HRESULT HandleExceptionInfo(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &arguments, MsgPackWriter &body, std::string &)
+{
+    HRESULT Status;
+    ThreadId threadId;
+    IfFailRet(GetThreadId(arguments, threadId));
+
+    ExceptionInfo exceptionInfo;
+    IfFailRet(sharedDebugger->GetExceptionInfo(threadId, exceptionInfo));
+
+    body.Map(6)
+        .Key("exceptionId").String(exceptionInfo.exceptionId)
+        .Key("description").String(exceptionInfo.description)
+        .Key("breakMode").String(exceptionInfo.breakMode)
+        .Key("message").String(exceptionInfo.details.message)
+        .Key("typeName").String(exceptionInfo.details.fullTypeName)
+        .Key("stackTrace").String(exceptionInfo.details.stackTrace);
+    return S_OK;
+}
+
+HRESULT HandleDisconnect(std::shared_ptr<IDebugger> &sharedDebugger, const MsgPackValue &arguments, MsgPackWriter &, std::string &)
+{
+    IDebugger::DisconnectAction action = IDebugger::DisconnectAction::DisconnectDefault;
+    const MsgPackValue *terminateArg = arguments.Find("terminateDebuggee");
+    if (terminateArg != nullptr)
+        action = terminateArg->GetBool() ? IDebugger::DisconnectAction::DisconnectTerminate : IDebugger::DisconnectAction::DisconnectDetach;
+
+    sharedDebugger->Disconnect(action);
+    return S_OK;
+}
+
+const std::unordered_map<std::string, CommandHandler> commandHandlers {
+    { "initialize",              &HandleInitialize },
+    { "attach",                  &HandleAttach },
+    { "configurationDone",       &HandleConfigurationDone },
+    { "setBreakpoints",          &HandleSetBreakpoints },
+    { "setExceptionBreakpoints", &HandleSetExceptionBreakpoints },
+    { "continue",                &HandleContinue },
+    { "pause",                   &HandlePause },
+    { "next",                    &HandleStep<IDebugger::StepType::STEP_OVER> },
+    { "stepIn",                  &HandleStep<IDebugger::StepType::STEP_IN> },
+    { "stepOut",                 &HandleStep<IDebugger::StepType::STEP_OUT> },
+    { "threads",                 &HandleThreads },
+    { "stackTrace",              &HandleStackTrace },
+    { "allStackTraces",          &HandleAllStackTraces },
+    { "scopes",                  &HandleScopes },
+    { "variables",               &HandleVariables },
+    { "evaluate",                &HandleEvaluate },
+    { "exceptionInfo",           &HandleExceptionInfo },
+    { "disconnect",              &HandleDisconnect }
+};
+
+} // unnamed namespace
+
+HRESULT CompactProtocol::HandleCommand(const std::string &command, const MsgPackValue &arguments, MsgPackWriter &body, std::string &message)
+{
+    // Note, "launch" need launch command provided by command line, all other commands are stateless for protocol.
+    if (command == "launch")
+    {
+        std::map<std::string, std::string> env;
+        const MsgPackValue *envArg = arguments.Find("env");
+        if (envArg != nullptr)
+        {
+            for (const auto &entry : envArg->GetMap())
+            {
+                env.emplace(entry.first, entry.second.GetString());
+            }
+        }
+
+        m_sharedDebugger->SetJustMyCode(GetBool(arguments, "justMyCode", true));
+        m_sharedDebugger->SetStepFiltering(GetBool(arguments, "enableStepFiltering", true));
+        m_sharedDebugger->SetDeferredJMC(GetBool(arguments, "deferredJMC", false));
+        m_sharedDebugger->SetNonStop(GetBool(arguments, "nonStop", false));
+        m_sharedDebugger->SetEvalTimeout(unsigned(GetInt(arguments, "evalTimeout", 0)));
+
+        const std::string cwd = GetString(arguments, "cwd");
+        const bool stopAtEntry = GetBool(arguments, "stopAtEntry", false);
+        if (!m_fileExec.empty())
+            return m_sharedDebugger->Launch(m_fileExec, m_execArgs, env, cwd, stopAtEntry);
+
+        std::string program = GetString(arguments, "program");
+        if (program.empty())
+            return E_INVALIDARG;
+
+        std::vector<std::string> args = GetStringArray(arguments, "args");
+        args.insert(args.begin(), program);
+        return m_sharedDebugger->Launch("dotnet", args, env, cwd, stopAtEntry);
+    }
+
+    auto findHandler = commandHandlers.find(command);
+    if (findHandler == commandHandlers.end())
+        return E_NOTIMPL;
+
+    return findHandler->second(m_sharedDebugger, arguments, body, message);
+}
+
+MsgPackWriter CompactProtocol::BeginMessage(size_t fieldsCount, string_view type)
+{
+    m_message.assign(LengthPrefixSize, '\0');
+    MsgPackWriter writer(m_message);
+    writer.Map(fieldsCount)
+        .Key("type").String(type)
+        .Key("seq").UInt(m_seqCounter++);
+    return writer;
+}
+
+void CompactProtocol::EndMessage()
+{
+    const size_t size = m_message.size() - LengthPrefixSize;
+    for (size_t i = 0; i < LengthPrefixSize; i++)
+    {
+        m_message[i] = static_cast<char>((size >> ((LengthPrefixSize - 1 - i) * 8)) & 0xff);
+    }
+
+    cout.write(m_message.data(), m_message.size());
+    cout.flush();
+}
+
+void CompactProtocol::EmitEvent(string_view name, string_view body)
+{
+    std::lock_guard<std::mutex> lock(m_outMutex);
+    MsgPackWriter writer = BeginMessage(4, "event");
+    writer.Key("event").String(name)
+          .Key("body").Raw(body);
+    EndMessage();
+}
+
+void CompactProtocol::SendResponse(uint64_t requestSeq, const std::string &command, HRESULT Status, const std::string &errorMessage)
+{
+    std::lock_guard<std::mutex> lock(m_outMutex);
+    const bool success = SUCCEEDED(Status);
+    MsgPackWriter writer = BeginMessage(success ? 6 : 7, "response");
+    writer.Key("request_seq").UInt(requestSeq)
+          .Key("command").String(command)
+          .Key("success").Bool(success);
+
+    if (!success)
+    {
+        writer.Key("message");
+        if (errorMessage.empty())
+            writer.String(string_view(errormessage(Status)));
+        else
+            writer.String(errorMessage);
+    }
+
+    writer.Key("body");
+    if (m_responseBody.empty())
+        writer.Map(0);
+    else
+        writer.Raw(m_responseBody);
+
+    EndMessage();
+}
+
+void CompactProtocol::EmitInitializedEvent()
+{
+    EmitEvent("initialized", "\x80"); // empty map
+}
+
+void CompactProtocol::EmitExecEvent(PID pid, const std::string& argv0)
+{
+    std::string body;
+    MsgPackWriter(body).Map(2)
+        .Key("name").String(argv0)
+        .Key("systemProcessId").UInt(PID::ScalarType(pid));
+    EmitEvent("process", body);
+}
+
+void CompactProtocol::EmitStoppedEvent(const StoppedEvent &event)
+{
+    string_view reason;
+    switch(event.reason)
+    {
+        case StopStep:       reason = "step";       break;
+        case StopBreakpoint: reason = "breakpoint"; break;
+        case StopException:  reason = "exception";  break;
+        case StopPause:      reason = "pause";      break;
+        case StopEntry:      reason = "entry";      break;
+        case StopDataBreakpoint: reason = "data breakpoint"; break;
+    }
+
+    std::string body;
+    MsgPackWriter(body).Map(4)
+        .Key("reason").String(reason)
+        .Key("threadId").Int(int(event.threadId))
+        .Key("text").String(event.text)
+        .Key("allThreadsStopped").Bool(event.allThreadsStopped);
+    EmitEvent("stopped", body);
+}
+
+void CompactProtocol::EmitExitedEvent(const ExitedEvent &event)
+{
+    std::string body;
+    MsgPackWriter(body).Map(1).Key("exitCode").Int(event.exitCode);
+    EmitEvent("exited", body);
+}
+
+void CompactProtocol::EmitTerminatedEvent()
+{
+    EmitEvent("terminated", "\x80"); // empty map
+}
+
+void CompactProtocol::EmitContinuedEvent(ThreadId threadId, bool allThreadsContinued)
+{
+    std::string body;
+    MsgPackWriter writer(body);
+    writer.Map(2).Key("threadId");
+    if (threadId)
+        writer.Int(int(threadId));
+    else
+        writer.Nil();
+    writer.Key("allThreadsContinued").Bool(allThreadsContinued);
+    EmitEvent("continued", body);
+}
+
+void CompactProtocol::EmitThreadEvent(const ThreadEvent &event)
+{
+    string_view reason;
+    switch(event.reason)
+    {
+        case ManagedThreadStarted: reason = "started"; break;
+        case ManagedThreadExited:  reason = "exited";  break;
+        default:
+            return;
+    }
+
+    std::string body;
+    MsgPackWriter(body).Map(2)
+        .Key("reason").String(reason)
+        .Key("threadId").Int(int(event.threadId));
+    EmitEvent("thread", body);
+}
+
+void CompactProtocol::EmitModuleEvent(const ModuleEvent &event)
+{
+    string_view reason;
+    switch(event.reason)
+    {
+        case ModuleNew:     reason = "new";     break;
+        case ModuleChanged: reason = "changed"; break;
+        case ModuleRemoved: reason = "removed"; break;
+    }
+
+    // Module: [id, name, path, symbolsLoaded]
+    std::string body;
+    MsgPackWriter(body).Map(2)
+        .Key("reason").String(reason)
+        .Key("module").Array(4)
+            .String(event.module.id)
+            .String(event.module.name)
+            .String(event.module.path)
+            .Bool(event.module.symbolStatus == SymbolsLoaded);
+    EmitEvent("module", body);
+}
+
+void CompactProtocol::EmitOutputEvent(OutputCategory category, string_view output, string_view source)
+{
+    string_view categoryName = "console";
+    switch(category)
+    {
+        case OutputConsole: categoryName = "console"; break;
+        case OutputStdOut:  categoryName = "stdout";  break;
+        case OutputStdErr:  categoryName = "stderr";  break;
+    }
+
+    // Note, no escaping needed, output is provided as is.
+    std::string body;
+    body.reserve(output.size() + 32);
+    MsgPackWriter(body).Map(2)
+        .Key("category").String(categoryName)
+        .Key("output").String(output);
+    EmitEvent("output", body);
+}
+
+void CompactProtocol::EmitBreakpointEvent(const BreakpointEvent &event)
+{
+    string_view reason;
+    switch(event.reason)
+    {
+        case BreakpointNew:     reason = "new";     break;
+        case BreakpointChanged: reason = "changed"; break;
+        case BreakpointRemoved: reason = "removed"; break;
+    }
+
+    std::string body;
+    MsgPackWriter writer(body);
+    writer.Map(2).Key("reason").String(reason).Key("breakpoint");
+    WriteBreakpoint(writer, event.breakpoint);
+    EmitEvent("breakpoint", body);
+}
+
+void CompactProtocol::CommandLoop()
+{
+    std::string data;
+    MsgPackValue request;
+
+    while (!m_exit)
+    {
+        unsigned char prefix[LengthPrefixSize];
+        if (!cin.read(reinterpret_cast<char*>(prefix), LengthPrefixSize))
+            break;
+
+        const uint32_t size = (uint32_t(prefix[0]) << 24) | (uint32_t(prefix[1]) << 16) | (uint32_t(prefix[2]) << 8) | uint32_t(prefix[3]);
+        if (size == 0 || size > MaxMessageSize)
+        {
+            LOGE("Incorrect compact protocol message size %u", size);
+            break;
+        }
+
+        data.resize(size);
+        if (!cin.read(&data[0], size))
+            break;
+
+        // Note, framing is still consistent in case of malformed message, so, we could continue.
+        if (MsgPackValue::Parse(data.data(), data.size(), request) != data.size() || !request.IsMap())
+        {
+            LOGE("Can't parse compact protocol message");
+            m_responseBody.clear();
+            SendResponse(0, std::string(), E_INVALIDARG, "can't parse message");
+            continue;
+        }
+
+        const uint64_t requestSeq = GetInt(request, "seq", 0);
+        const std::string command = GetString(request, "command");
+        static const MsgPackValue emptyArguments;
+        const MsgPackValue *arguments = request.Find("arguments");
+
+        m_responseBody.clear();
+        MsgPackWriter body(m_responseBody);
+        std::string message;
+        HRESULT Status = HandleCommand(command, arguments ? *arguments : emptyArguments, body, message);
+        // Note, partially written body must not be sent in case of error.
+        if (FAILED(Status))
+            m_responseBody.clear();
+
+        SendResponse(requestSeq, command, Status, message);
+
+        if (command == "disconnect")
+            m_exit = true;
+    }
+
+    if (!m_exit)
+        m_sharedDebugger->Disconnect(); // Terminate debuggee process if debugger ran this process and detach in case debugger was attached to it.
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,72 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include "interfaces/idebugger.h"
+#include "interfaces/iprotocol.h"
+#include "protocols/msgpack.h"
+
+namespace netcoredbg
+{
+
+// Compact binary protocol for tooling clients, which need high throughput for stacks and variables requests.
+// Each message is 4 bytes big-endian length prefix followed by one MessagePack map, messages have VSCode-like
+// structure (requests, responses and events), but stack frames, variables, threads, scopes and breakpoints are
+// provided as positional arrays. See docs/compactprotocol.md for messages schema.
+class CompactProtocol : public IProtocol
+{
+public:
+
+    // Maximum message size, larger messages are treated as protocol error.
+    static const uint32_t MaxMessageSize = 64 * 1024 * 1024;
+
+    CompactProtocol(std::istream& input, std::ostream& output) : IProtocol(input, output), m_seqCounter(1) {}
+
+    void EmitInitializedEvent() override;
+    void EmitExecEvent(PID, const std::string& argv0) override;
+    void EmitStoppedEvent(const StoppedEvent &event) override;
+    void EmitExitedEvent(const ExitedEvent &event) override;
+    void EmitTerminatedEvent() override;
+    void EmitContinuedEvent(ThreadId threadId, bool allThreadsContinued) override;
+    void EmitThreadEvent(const ThreadEvent &event) override;
+    void EmitModuleEvent(const ModuleEvent &event) override;
+    void EmitOutputEvent(OutputCategory category, string_view output, string_view source = "") override;
+    void EmitBreakpointEvent(const BreakpointEvent &event) override;
+    void Cleanup() override {}
+    void CommandLoop() override;
+
+    void SetLaunchCommand(const std::string &fileExec, const std::vector<std::string> &args) override
+    {
+        m_fileExec = fileExec;
+        m_execArgs = args;
+    }
+
+private:
+
+    std::mutex m_outMutex;
+    uint64_t m_seqCounter;  // guarded by m_outMutex
+    std::string m_message;  // guarded by m_outMutex, reused for messages serialization
+
+    std::string m_fileExec;
+    std::vector<std::string> m_execArgs;
+
+    // Buffer reused for responses body serialization (used by command loop thread only).
+    std::string m_responseBody;
+
+    HRESULT HandleCommand(const std::string &command, const MsgPackValue &arguments, MsgPackWriter &body, std::string &message);
+
+    // Start new message in m_message (reserve place for length prefix) and write message type and seq fields,
+    // caller must hold m_outMutex.
+    MsgPackWriter BeginMessage(size_t fieldsCount, string_view type);
+    // Write length prefix and send m_message, caller must hold m_outMutex.
+    void EndMessage();
+    void EmitEvent(string_view name, string_view body);
+    void SendResponse(uint64_t requestSeq, const std::string &command, HRESULT Status, const std::string &errorMessage);
+};
+
+} // namespace netcoredbg
@@ -0,0 +1,234 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "protocols/enginelog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+namespace netcoredbg
+{
+
+const uint32_t EngineLogWriter::FormatVersion;
+const size_t EngineLogWriter::HeaderSize;
+const size_t EngineLogWriter::RecordHeaderSize;
+const size_t EngineLogWriter::DefaultBufferSize;
+
+namespace // unnamed namespace
+{
+
+const char Magic[8] = {'N', 'C', 'D', 'B', 'G', 'L', 'O', 'G'};
+
+// Flush records into stream at least each WorkerIntervalMs or in case buffer half full.
+const unsigned WorkerIntervalMs = 100;
+
+void StoreLE(char *dest, uint64_t value, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        dest[i] = char(value & 0xff);
+        value >>= 8;
+    }
+}
+
+uint64_t LoadLE(const char *src, size_t size)
+{
+    uint64_t value = 0;
+    for (size_t i = size; i > 0; i--)
+    {
+        value = (value << 8) | uint8_t(src[i - 1]);
+    }
+    return value;
+}
+
+uint64_t NowUs()
+{
+    return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // unnamed namespace
+
+EngineLogWriter::EngineLogWriter(std::unique_ptr<std::ostream> &&stream, size_t bufferSize) :
+    m_stream(std::move(stream)),
+    m_buffer(bufferSize),
+    m_exit(false),
+    m_flushRequested(false),
+    m_head(0),
+    m_tail(0),
+    m_dropped(0),
+    m_droppedPending(0)
+{
+    char header[HeaderSize];
+    memcpy(header, Magic, sizeof(Magic));
+    StoreLE(header + sizeof(Magic), FormatVersion, 4);
+    m_stream->write(header, sizeof(header));
+
+    m_worker = std::thread(&EngineLogWriter::Worker, this);
+}
+
+EngineLogWriter::~EngineLogWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_exit = true;
+    }
+    m_workerCV.notify_one();
+    m_worker.join();
+}
+
+// Caller must care about m_mutex.
+void EngineLogWriter::PutBytes(const char *data, size_t size)
+{
+    size_t offset = size_t(m_head % m_buffer.size());
+    size_t firstPart = std::min(size, m_buffer.size() - offset);
+    memcpy(m_buffer.data() + offset, data, firstPart);
+    memcpy(m_buffer.data(), data + firstPart, size - firstPart);
+    m_head += size;
+}
+
+// Caller must care about m_mutex.
+bool EngineLogWriter::PutRecord(Direction direction, uint64_t timestamp, const char *data, size_t size)
+{
+    if (size > UINT32_MAX || RecordHeaderSize + size > m_buffer.size() - size_t(m_head - m_tail))
+        return false;
+
+    char header[RecordHeaderSize];
+    StoreLE(header, size, 4);
+    StoreLE(header + 4, timestamp, 8);
+    header[12] = char(direction);
+    PutBytes(header, sizeof(header));
+    PutBytes(data, size);
+    return true;
+}
+
+void EngineLogWriter::Write(Direction direction, const char *data, size_t size)
+{
+    uint64_t timestamp = NowUs();
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_droppedPending != 0)
+    {
+        char count[8];
+        StoreLE(count, m_droppedPending, sizeof(count));
+        if (PutRecord(Direction::Dropped, timestamp, count, sizeof(count)))
+            m_droppedPending = 0;
+    }
+
+    if (m_droppedPending != 0 || !PutRecord(direction, timestamp, data, size))
+    {
+        m_dropped++;
+        m_droppedPending++;
+    }
+
+    if (size_t(m_head - m_tail) >= m_buffer.size() / 2)
+        m_workerCV.notify_one();
+}
+
+void EngineLogWriter::Flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    uint64_t head = m_head;
+    m_flushRequested = true;
+    m_workerCV.notify_one();
+    m_flushCV.wait(lock, [&]{ return m_tail >= head || m_exit; });
+}
+
+uint64_t EngineLogWriter::GetDroppedCount()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dropped;
+}
+
+void EngineLogWriter::Worker()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+        m_workerCV.wait_for(lock, std::chrono::milliseconds(WorkerIntervalMs), [&]
+        {
+            return m_exit || m_flushRequested || size_t(m_head - m_tail) >= m_buffer.size() / 2;
+        });
+
+        bool exit = m_exit;
+        m_flushRequested = false;
+        uint64_t head = m_head;
+        uint64_t tail = m_tail;
+        lock.unlock();
+
+        // Note, writers never change data in [tail, head) range, so, stream write don't need lock.
+        if (head != tail)
+        {
+            size_t size = size_t(head - tail);
+            size_t offset = size_t(tail % m_buffer.size());
+            size_t firstPart = std::min(size, m_buffer.size() - offset);
+            m_stream->write(m_buffer.data() + offset, firstPart);
+            m_stream->write(m_buffer.data(), size - firstPart);
+        }
+        m_stream->flush();
+
+        lock.lock();
+        m_tail = head;
+        m_flushCV.notify_all();
+
+        // Note, write all records, that was added during last stream write, before exit.
+        if (exit && m_head == m_tail)
+            break;
+    }
+}
+
+bool DecodeEngineLog(std::istream &input, std::ostream &output)
+{
+    char header[EngineLogWriter::HeaderSize];
+    if (!input.read(header, sizeof(header)) ||
+        memcmp(header, Magic, sizeof(Magic)) != 0 ||
+        LoadLE(header + sizeof(Magic), 4) != EngineLogWriter::FormatVersion)
+        return false;
+
+    std::string payload;
+    char recordHeader[EngineLogWriter::RecordHeaderSize];
+    while (input.read(recordHeader, sizeof(recordHeader)))
+    {
+        size_t size = size_t(LoadLE(recordHeader, 4));
+        uint64_t timestamp = LoadLE(recordHeader + 4, 8);
+        EngineLogWriter::Direction direction = EngineLogWriter::Direction(uint8_t(recordHeader[12]));
+
+        payload.resize(size);
+        if (size != 0 && !input.read(&payload[0], size))
+            return false;
+
+        time_t seconds = time_t(timestamp / 1000000);
+        char timeBuf[64] = "";
+        const std::tm *utc = std::gmtime(&seconds);
+        if (utc != nullptr)
+            strftime(timeBuf, sizeof(timeBuf), "%Y-%m-%d %H:%M:%S", utc);
+        char usBuf[16];
+        snprintf(usBuf, sizeof(usBuf), ".%06u ", unsigned(timestamp % 1000000));
+        output << timeBuf << usBuf;
+
+        switch (direction)
+        {
+        case EngineLogWriter::Direction::Command:  output << "-> (C) " << payload; break;
+        case EngineLogWriter::Direction::Response: output << "<- (R) " << payload; break;
+        case EngineLogWriter::Direction::Event:    output << "<- (E) " << payload; break;
+        case EngineLogWriter::Direction::Request:  output << "<- (Q) " << payload; break;
+        case EngineLogWriter::Direction::Dropped:
+            output << "!! dropped " << (size == 8 ? LoadLE(payload.data(), 8) : 0) << " records";
+            break;
+        default:
+            output << "?? (" << unsigned(direction) << ") " << payload;
+            break;
+        }
+        output << '\n';
+    }
+
+    // Note, stream could be at EOF only in case last record is complete.
+    return input.eof() && input.gcount() == 0;
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,86 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace netcoredbg
+{
+
+// Compact binary engine log, protocol messages are stored as is (raw bytes) with timestamp and direction, so, engine
+// logging could be enabled all the time without messages re-serialization and synchronous file writes.
+// File format (all integers are little-endian):
+//     header: "NCDBGLOG" magic (8 bytes), format version (uint32)
+//     record: payload size (uint32), timestamp in microseconds since Unix epoch (uint64), direction (uint8), payload
+// Records are copied into ring buffer and written into stream by background thread. In case ring buffer don't have
+// enough free space, record is dropped and dropped records count is stored as separate record (uint64 payload).
+class EngineLogWriter
+{
+public:
+
+    enum class Direction : uint8_t
+    {
+        Command  = 0,   // client request
+        Response = 1,   // response for client request
+        Event    = 2,   // event
+        Request  = 3,   // reverse request
+        Dropped  = 0xff // dropped records count
+    };
+
+    static const uint32_t FormatVersion = 1;
+    static const size_t HeaderSize = 12;
+    static const size_t RecordHeaderSize = 13;
+    static const size_t DefaultBufferSize = 4 * 1024 * 1024;
+
+    // Note, header is written into stream at construction.
+    EngineLogWriter(std::unique_ptr<std::ostream> &&stream, size_t bufferSize = DefaultBufferSize);
+    // Write all records and stop background thread.
+    ~EngineLogWriter();
+
+    void Write(Direction direction, const char *data, size_t size);
+    // Wait till all records are written into stream and flush it.
+    void Flush();
+    uint64_t GetDroppedCount();
+
+private:
+
+    EngineLogWriter(const EngineLogWriter&) = delete;
+    EngineLogWriter& operator=(const EngineLogWriter&) = delete;
+
+    // Caller must care about m_mutex.
+    bool PutRecord(Direction direction, uint64_t timestamp, const char *data, size_t size);
+    void PutBytes(const char *data, size_t size);
+    void Worker();
+
+    std::unique_ptr<std::ostream> m_stream;
+    std::vector<char> m_buffer;
+
+    std::mutex m_mutex;
+    std::condition_variable m_workerCV;
+    std::condition_variable m_flushCV;
+    std::thread m_worker;
+    bool m_exit;
+    bool m_flushRequested;
+
+    // Note, positions are total bytes count and never wrap, buffer offset is position modulo buffer size.
+    uint64_t m_head; // write position
+    uint64_t m_tail; // position of first not written into stream byte
+    uint64_t m_dropped;
+    uint64_t m_droppedPending; // dropped records count, that was not stored yet
+};
+
+// Convert binary engine log into text, records are stored one per line with UTC time and same direction prefixes
+// as text engine log have. Return false in case of wrong format or truncated record (all previous records are converted).
+bool DecodeEngineLog(std::istream &input, std::ostream &output);
+
+} // namespace netcoredbg
@@ -6,9 +6,161 @@
 #include "escaped_string.h"
 #include "assert.h"
 
+#if !defined(ESCAPED_STRING_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ESCAPED_STRING_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define ESCAPED_STRING_NEON
+#endif
+#endif // ESCAPED_STRING_NO_SIMD
+
+#if defined(ESCAPED_STRING_SSE2) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace netcoredbg
 {
 
+namespace EscapedStringInternal
+{
+
+// Note, control characters are forbidden in all protocols, so, vectorized scanner checks all of them as candidates
+// and final decision is made by lookup table.
+static const unsigned char ControlCharsMax = 0x1f;
+
+ScanTable::ScanTable(string_view forbidden) :
+    vectorCharsCount(0),
+    vectorizable(true)
+{
+    assert(forbidden.size() < 256);
+    std::fill(std::begin(index), std::end(index), 0);
+
+    for (size_t i = forbidden.size(); i > 0; i--)
+    {
+        // Note, first occurrence of character in `forbidden` define substitution.
+        unsigned char c = static_cast<unsigned char>(forbidden[i - 1]);
+        index[c] = static_cast<unsigned char>(i);
+    }
+
+    for (unsigned c = ControlCharsMax + 1; c < 256; c++)
+    {
+        if (index[c] == 0)
+            continue;
+
+        if (vectorCharsCount == MaxVectorChars)
+        {
+            vectorizable = false;
+            break;
+        }
+        vectorChars[vectorCharsCount++] = static_cast<char>(c);
+    }
+}
+
+const char* FindForbiddenScalar(const ScanTable& table, const char* begin, const char* end)
+{
+    for (; begin != end; ++begin)
+    {
+        if (table.index[static_cast<unsigned char>(*begin)] != 0)
+            break;
+    }
+    return begin;
+}
+
+#if defined(ESCAPED_STRING_SSE2)
+
+static inline unsigned CountTrailingZeros(unsigned mask)
+{
+#ifdef _MSC_VER
+    unsigned long pos;
+    _BitScanForward(&pos, mask);
+    return static_cast<unsigned>(pos);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+static const char* FindForbiddenVector(const ScanTable& table, const char* begin, const char* end)
+{
+    static const size_t BlockSize = 16;
+    const __m128i controlMax = _mm_set1_epi8(static_cast<char>(ControlCharsMax));
+    __m128i chars[ScanTable::MaxVectorChars];
+    for (size_t i = 0; i < table.vectorCharsCount; i++)
+    {
+        chars[i] = _mm_set1_epi8(table.vectorChars[i]);
+    }
+
+    for (; size_t(end - begin) >= BlockSize; begin += BlockSize)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        // Note, SSE2 have signed compare only, `min(x, 0x1f) == x` is unsigned `x <= 0x1f`.
+        __m128i found = _mm_cmpeq_epi8(_mm_min_epu8(block, controlMax), block);
+        for (size_t i = 0; i < table.vectorCharsCount; i++)
+        {
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(block, chars[i]));
+        }
+
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(found));
+        while (mask != 0)
+        {
+            const unsigned pos = CountTrailingZeros(mask);
+            if (table.index[static_cast<unsigned char>(begin[pos])] != 0)
+                return begin + pos;
+            mask &= mask - 1;
+        }
+    }
+
+    return FindForbiddenScalar(table, begin, end);
+}
+
+#elif defined(ESCAPED_STRING_NEON)
+
+static const char* FindForbiddenVector(const ScanTable& table, const char* begin, const char* end)
+{
+    static const size_t BlockSize = 16;
+    const uint8x16_t controlMax = vdupq_n_u8(ControlCharsMax);
+    uint8x16_t chars[ScanTable::MaxVectorChars];
+    for (size_t i = 0; i < table.vectorCharsCount; i++)
+    {
+        chars[i] = vdupq_n_u8(static_cast<uint8_t>(table.vectorChars[i]));
+    }
+
+    for (; size_t(end - begin) >= BlockSize; begin += BlockSize)
+    {
+        const uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(begin));
+        uint8x16_t found = vcleq_u8(block, controlMax);
+        for (size_t i = 0; i < table.vectorCharsCount; i++)
+        {
+            found = vorrq_u8(found, vceqq_u8(block, chars[i]));
+        }
+
+        // Note, NEON don't have movemask analogue, check block for candidates at first and find position by lookup table.
+        const uint64x2_t found64 = vreinterpretq_u64_u8(found);
+        if ((vgetq_lane_u64(found64, 0) | vgetq_lane_u64(found64, 1)) == 0)
+            continue;
+
+        const char *pos = FindForbiddenScalar(table, begin, begin + BlockSize);
+        if (pos != begin + BlockSize)
+            return pos;
+    }
+
+    return FindForbiddenScalar(table, begin, end);
+}
+
+#endif
+
+const char* FindForbidden(const ScanTable& table, const char* begin, const char* end)
+{
+#if defined(ESCAPED_STRING_SSE2) || defined(ESCAPED_STRING_NEON)
+    if (table.vectorizable)
+        return FindForbiddenVector(table, begin, end);
+#endif
+    return FindForbiddenScalar(table, begin, end);
+}
+
+} // namespace EscapedStringInternal
+
 EscapedStringInternal::EscapedStringImpl::EscapedStringImpl(const EscapedStringInternal::EscapedStringImpl::Params& params, Utility::string_view str, const TempRef& ref, bool isstring)
 : 
     m_ref(&ref), m_params(params), m_input(str), m_result(), m_size(UndefinedSize), m_isstring(isstring), m_isresult(false)
@@ -29,31 +181,32 @@ void EscapedStringInternal::EscapedStringImpl::operator()(void *thiz, void (*fun
         return func(thiz, m_input);
 
     // perform transformation and compute result size
+    const ScanTable& table = m_params.table();
     size_t size = 0;
-    string_view src = m_input;
-    while (!src.empty())
+    const char *src = m_input.data();
+    const char *end = m_input.data() + m_input.size();
+    while (src != end)
     {
         // try to find first forbidden character
-        auto it = std::find_first_of(src.begin(), src.end(), m_params.forbidden.begin(), m_params.forbidden.end());
-        size_t prefix_size = it - src.begin();
+        const char *it = FindForbidden(table, src, end);
+        size_t prefix_size = it - src;
         if (prefix_size)
         {
-            // output any other charactes that preceede first forbidden character
-            func(thiz, src.substr(0, prefix_size));
+            // output any other charactes that preceede first forbidden character (clean run in one piece)
+            func(thiz, string_view(src, prefix_size));
             size += prefix_size;
         }
 
-        if (it != src.end())
+        if (it != end)
         {
             // find right substitution for forbidden character and output substituting pair of characters
-            auto ir = std::find(m_params.forbidden.begin(), m_params.forbidden.end(), *it);
-            string_view subst = m_params.subst[ir - m_params.forbidden.begin()];
+            string_view subst = m_params.subst[table.index[static_cast<unsigned char>(*it)] - 1];
             func(thiz, subst);
             size += subst.size();
             prefix_size++;
         }
 
-        src.remove_prefix(prefix_size);
+        src += prefix_size;
     }
 
     // remember output size (to avoid computations in future)
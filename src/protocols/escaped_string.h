@@ -58,6 +58,26 @@ namespace EscapedStringInternal
     };
 
 
+    // Lookup table for forbidden characters search, built once for each set of escaping rules.
+    struct ScanTable
+    {
+        // Maximum number of forbidden characters, which are not control characters, that could be
+        // checked by vectorized scanner (control characters are always checked as candidates).
+        static const size_t MaxVectorChars = 4;
+
+        explicit ScanTable(string_view forbidden);
+
+        unsigned char index[256];           // position of character in `forbidden` plus one, zero for allowed characters
+        char vectorChars[MaxVectorChars];   // forbidden characters out of control characters range
+        size_t vectorCharsCount;
+        bool vectorizable;                  // true in case vectorized scanner could be used
+    };
+
+    // Functions return pointer to first forbidden character in range, or `end` in case of no forbidden characters.
+    // FindForbidden() use SSE2 or NEON (if available), and FindForbiddenScalar() is portable fallback.
+    const char* FindForbiddenScalar(const ScanTable& table, const char* begin, const char* end);
+    const char* FindForbidden(const ScanTable& table, const char* begin, const char* end);
+
     // This is actual implementation of `EscapedString` class.
     struct EscapedStringImpl
     {
@@ -68,6 +88,7 @@ namespace EscapedStringInternal
             string_view forbidden;                  // characters which must be replaced
             Utility::span<const string_view> subst; // strings to which `forbidden` characters must be replaced
             char escape;                            // character, which preceedes each substitution
+            const ScanTable& (*table)();            // returns lookup table for `forbidden` characters
         };
 
         using TempRef = TempReference<EscapedStringImpl>;
@@ -143,6 +164,13 @@ template <typename Traits> class EscapedString
     using EscapedStringImpl = EscapedStringInternal::EscapedStringImpl;
     static EscapedStringImpl::Params params;
 
+    // Note, table is built at first use (thread-safe, since C++11).
+    static const EscapedStringInternal::ScanTable& GetScanTable()
+    {
+        static const EscapedStringInternal::ScanTable table(params.forbidden);
+        return table;
+    }
+
 public:
     /// Construct `EscapedString` from c-strings (via implicit conversion) or string_view.
     /// Second parameter must have default value (shouldn't be assigned explicitly).
@@ -189,7 +217,8 @@ template <typename Traits> EscapedStringInternal::EscapedStringImpl::Params Esca
         "forbidden_chars and subst_chars must have same size!");}),
       string_view(Traits::forbidden_chars)) },
     { Traits::subst_chars },
-    Traits::escape_char
+    Traits::escape_char,
+    &EscapedString<Traits>::GetScanTable
 };
 
 
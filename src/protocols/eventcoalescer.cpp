@@ -0,0 +1,120 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "protocols/eventcoalescer.h"
+
+namespace netcoredbg
+{
+
+EventCoalescer::EventCoalescer(FlushCallback callback) :
+    m_callback(std::move(callback)),
+    m_exit(false),
+    m_replaced(0)
+{
+    m_worker = std::thread(&EventCoalescer::Worker, this);
+}
+
+EventCoalescer::~EventCoalescer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_exit = true;
+    }
+    m_workerCV.notify_one();
+    m_worker.join();
+
+    Flush();
+}
+
+void EventCoalescer::SetOptions(const Options &options)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_options = options;
+    m_workerCV.notify_one();
+}
+
+uint64_t EventCoalescer::GetReplacedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_replaced;
+}
+
+void EventCoalescer::Add(const std::string &name, std::string &&body, const std::string &key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Note, replaced event keep position of pending event, since it could be related to events after it
+    // (for example, breakpoint changed event after module load event).
+    if (!key.empty())
+    {
+        auto find = m_pendingKeys.find(key);
+        if (find != m_pendingKeys.end())
+        {
+            Event &event = m_pending[find->second];
+            event.name = name;
+            event.body = std::move(body);
+            m_replaced++;
+            return;
+        }
+    }
+
+    const bool wasEmpty = m_pending.empty();
+    if (wasEmpty)
+        m_pendingStart = clock::now();
+
+    if (!key.empty())
+        m_pendingKeys.emplace(key, m_pending.size());
+    m_pending.emplace_back();
+    m_pending.back().name = name;
+    m_pending.back().body = std::move(body);
+    m_pending.back().key = key;
+
+    if (m_options.windowMs == 0 || m_pending.size() >= m_options.batchSize)
+        FlushPending();
+    else if (wasEmpty)
+        m_workerCV.notify_one();
+}
+
+void EventCoalescer::Flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FlushPending();
+}
+
+// Caller must care about m_mutex.
+void EventCoalescer::FlushPending()
+{
+    if (m_pending.empty())
+        return;
+
+    m_flushBuffer.swap(m_pending);
+    m_pendingKeys.clear();
+    m_callback(m_flushBuffer);
+    m_flushBuffer.clear();
+}
+
+void EventCoalescer::Worker()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (!m_exit)
+    {
+        if (m_pending.empty())
+        {
+            m_workerCV.wait(lock);
+            continue;
+        }
+
+        const clock::time_point windowEnd = m_pendingStart + std::chrono::milliseconds(m_options.windowMs);
+        if (clock::now() < windowEnd)
+        {
+            m_workerCV.wait_until(lock, windowEnd);
+            continue;
+        }
+
+        FlushPending();
+    }
+}
+
+} // namespace netcoredbg
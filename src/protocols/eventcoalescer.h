@@ -0,0 +1,78 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace netcoredbg
+{
+
+// Buffer protocol events, that could be emitted in huge amount (for example, module and breakpoint events during
+// debuggee startup), and provide them as batches, so, all batch events are written at once. Batch is provided after
+// time window since first pending event, in case batch size limit reached or at explicit flush (for example, before
+// stop event). Event with key replace pending event with same key, so, only latest state is provided.
+class EventCoalescer
+{
+public:
+
+    struct Event
+    {
+        std::string name; // event name
+        std::string body; // serialized event body
+        std::string key;  // empty in case event can't be replaced
+    };
+
+    // Note, callback executed with coalescer internal lock held, so, all batches are provided in proper order.
+    using FlushCallback = std::function<void(const std::vector<Event> &events)>;
+
+    struct Options
+    {
+        unsigned windowMs = 50;  // maximum time event could be delayed, 0 for no coalescing
+        size_t batchSize = 256;  // events count, that must be provided without delay
+    };
+
+    explicit EventCoalescer(FlushCallback callback);
+    ~EventCoalescer();
+
+    void SetOptions(const Options &options);
+    void Add(const std::string &name, std::string &&body, const std::string &key = std::string());
+    // Provide all pending events immediately.
+    void Flush();
+    uint64_t GetReplacedCount() const;
+
+private:
+
+    EventCoalescer(const EventCoalescer&) = delete;
+    EventCoalescer& operator=(const EventCoalescer&) = delete;
+
+    using clock = std::chrono::steady_clock;
+
+    // Caller must care about m_mutex.
+    void FlushPending();
+    void Worker();
+
+    FlushCallback m_callback;
+    Options m_options;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_workerCV;
+    std::thread m_worker;
+    bool m_exit;
+
+    std::vector<Event> m_pending;
+    std::vector<Event> m_flushBuffer; // Note, swapped with m_pending on flush, so, both buffers memory is reused.
+    std::unordered_map<std::string, size_t> m_pendingKeys; // key -> index in m_pending
+    clock::time_point m_pendingStart;
+    uint64_t m_replaced;
+};
+
+} // namespace netcoredbg
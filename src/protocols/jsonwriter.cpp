@@ -0,0 +1,102 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "protocols/jsonwriter.h"
+#include "utils/base64.h"
+
+namespace netcoredbg
+{
+
+// Note, same escaping as nlohmann::json dump() have (UTF-8 is not escaped).
+void JsonWriter::EscapeString(string_view value, std::string &output)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    output.push_back('"');
+    for (char c : value)
+    {
+        switch (c)
+        {
+        case '"':  output.append("\\\""); break;
+        case '\\': output.append("\\\\"); break;
+        case '\b': output.append("\\b"); break;
+        case '\f': output.append("\\f"); break;
+        case '\n': output.append("\\n"); break;
+        case '\r': output.append("\\r"); break;
+        case '\t': output.append("\\t"); break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                output.append("\\u00");
+                output.push_back(hex[(c >> 4) & 0xf]);
+                output.push_back(hex[c & 0xf]);
+            }
+            else
+                output.push_back(c);
+        }
+    }
+    output.push_back('"');
+}
+
+JsonWriter &JsonWriter::Key(string_view key)
+{
+    Separator();
+    EscapeString(key, m_output);
+    m_output.push_back(':');
+    m_needComma = false;
+    return *this;
+}
+
+JsonWriter &JsonWriter::String(string_view value)
+{
+    Separator();
+    EscapeString(value, m_output);
+    m_needComma = true;
+    return *this;
+}
+
+JsonWriter &JsonWriter::Int(int64_t value)
+{
+    Separator();
+    m_output.append(std::to_string(value));
+    m_needComma = true;
+    return *this;
+}
+
+JsonWriter &JsonWriter::UInt(uint64_t value)
+{
+    Separator();
+    m_output.append(std::to_string(value));
+    m_needComma = true;
+    return *this;
+}
+
+JsonWriter &JsonWriter::Bool(bool value)
+{
+    Separator();
+    m_output.append(value ? "true" : "false");
+    m_needComma = true;
+    return *this;
+}
+
+JsonWriter &JsonWriter::Raw(string_view value)
+{
+    Separator();
+    m_output.append(value.data(), value.size());
+    m_needComma = true;
+    return *this;
+}
+
+JsonWriter &JsonWriter::Base64(const void *data, size_t size)
+{
+    Separator();
+    m_output.reserve(m_output.size() + Base64::EncodedSize(size) + 2);
+    m_output.push_back('"');
+    Base64::Encode(data, size, m_output);
+    m_output.push_back('"');
+    m_needComma = true;
+    return *this;
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,56 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "utils/string_view.h"
+
+namespace netcoredbg
+{
+
+// Streaming JSON serializer, write values directly into output string without intermediate DOM build
+// (aimed to protocol hot paths with large responses, like variables or stack trace).
+// Note, writer care about separators only, caller must provide correct keys/values sequence.
+class JsonWriter
+{
+public:
+
+    using string_view = Utility::string_view;
+
+    JsonWriter(std::string &output) : m_output(output), m_needComma(false) {}
+
+    JsonWriter &BeginObject() { Separator(); m_output.push_back('{'); m_needComma = false; return *this; }
+    JsonWriter &EndObject() { m_output.push_back('}'); m_needComma = true; return *this; }
+    JsonWriter &BeginArray() { Separator(); m_output.push_back('['); m_needComma = false; return *this; }
+    JsonWriter &EndArray() { m_output.push_back(']'); m_needComma = true; return *this; }
+
+    // Key must be followed by value, object or array.
+    JsonWriter &Key(string_view key);
+
+    JsonWriter &String(string_view value);
+    JsonWriter &Int(int64_t value);
+    JsonWriter &UInt(uint64_t value);
+    JsonWriter &Bool(bool value);
+    // Already serialized JSON value.
+    JsonWriter &Raw(string_view value);
+    // String value with base64 encoded binary data, encoded directly into output.
+    JsonWriter &Base64(const void *data, size_t size);
+
+    static void EscapeString(string_view value, std::string &output);
+
+private:
+
+    std::string &m_output;
+    bool m_needComma;
+
+    void Separator()
+    {
+        if (m_needComma)
+            m_output.push_back(',');
+    }
+};
+
+} // namespace netcoredbg
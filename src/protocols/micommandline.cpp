@@ -0,0 +1,144 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "protocols/micommandline.h"
+
+namespace netcoredbg
+{
+
+const size_t MICommandLine::MaxArgs;
+
+namespace
+{
+    inline bool IsDelimiter(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+}
+
+// Same state machine as Tokenizer::Next() have, but token chars are written into buffer in place (write position is
+// never ahead of read position), so, not read part of buffer is not changed and could be used as remain of line.
+bool MICommandLine::NextToken(Utility::string_view &token)
+{
+    token = Utility::string_view();
+
+    if (m_next >= m_buffer.size())
+        return false;
+
+    enum {
+        StateSpace,
+        StateToken,
+        StateQuotedToken,
+        StateEscape
+    } state = StateSpace;
+
+    char *data = &m_buffer[0];
+    const size_t start = m_next;
+    size_t write = m_next;
+
+    for (; m_next < m_buffer.size(); m_next++)
+    {
+        const char c = data[m_next];
+        switch(state)
+        {
+            case StateSpace:
+                if (IsDelimiter(c))
+                    continue;
+                if (write != start)
+                {
+                    token = Utility::string_view(data + start, write - start);
+                    return true;
+                }
+                state = c == '"' ? StateQuotedToken : StateToken;
+                if (state != StateQuotedToken)
+                    data[write++] = c;
+                break;
+            case StateToken:
+                if (IsDelimiter(c))
+                    state = StateSpace;
+                else
+                    data[write++] = c;
+                break;
+            case StateQuotedToken:
+                if (c == '\\')
+                    state = StateEscape;
+                else if (c == '"')
+                    state = StateSpace;
+                else
+                    data[write++] = c;
+                break;
+            case StateEscape:
+                data[write++] = c;
+                state = StateQuotedToken;
+                break;
+        }
+    }
+
+    token = Utility::string_view(data + start, write - start);
+    return state != StateEscape || token.empty();
+}
+
+bool MICommandLine::AddArg(Utility::string_view arg)
+{
+    if (m_argsCount == MaxArgs)
+        return false;
+
+    m_args[m_argsCount++] = arg;
+    return true;
+}
+
+bool MICommandLine::Parse(Utility::string_view line)
+{
+    m_token = Utility::string_view();
+    m_command = Utility::string_view();
+    m_argsCount = 0;
+    m_next = 0;
+
+    // Note, trailing delimiters are removed, as Tokenizer does.
+    size_t size = line.size();
+    while (size > 0 && IsDelimiter(line[size - 1]))
+        size--;
+    m_buffer.assign(line.data(), size);
+
+    Utility::string_view result;
+    if (!NextToken(result) || result.empty())
+        return false;
+
+    size_t i = 0;
+    while (i < result.size() && result[i] >= '0' && result[i] <= '9')
+        i++;
+    if (i == result.size() || result[i] != '-')
+        return false;
+
+    m_token = result.substr(0, i);
+    m_command = result.substr(i + 1);
+
+    // Second argument is the rest of line (expression).
+    if (m_command == "var-assign" || m_command == "break-condition")
+    {
+        NextToken(result);
+        AddArg(result);
+        AddArg(Utility::string_view(m_buffer.data() + m_next, m_buffer.size() - m_next));
+        return true;
+    }
+
+    while (NextToken(result))
+    {
+        if (!AddArg(result))
+            return false;
+    }
+
+    return true;
+}
+
+void MICommandLine::GetArgs(std::vector<std::string> &args) const
+{
+    args.resize(m_argsCount);
+    for (size_t i = 0; i < m_argsCount; i++)
+    {
+        args[i].assign(m_args[i].data(), m_args[i].size());
+    }
+}
+
+} // namespace netcoredbg
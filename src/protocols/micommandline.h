@@ -0,0 +1,51 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "utils/string_view.h"
+
+namespace netcoredbg
+{
+
+// MI command line parser (`[token]-command args...`) without allocations in steady state: token, command and arguments
+// are slices of parser's own copy of line, quoted arguments are unescaped in place (unescaped argument is never longer
+// than quoted one). Line buffer capacity is reused by next Parse() calls. Tokenization rules are same as Tokenizer
+// class provide. Note, not thread safe, slices are valid till next Parse() call.
+class MICommandLine
+{
+public:
+
+    // Arguments count limit, lines with more arguments are not parsed.
+    static const size_t MaxArgs = 64;
+
+    MICommandLine() : m_argsCount(0), m_next(0) {}
+
+    bool Parse(Utility::string_view line);
+
+    Utility::string_view Token() const { return m_token; }
+    Utility::string_view Command() const { return m_command; }
+    size_t ArgsCount() const { return m_argsCount; }
+    Utility::string_view Arg(size_t index) const { return m_args[index]; }
+    // Note, `args` elements capacity is reused, so, there is no allocations in case `args` previously had same (or bigger)
+    // arguments.
+    void GetArgs(std::vector<std::string> &args) const;
+
+private:
+
+    bool NextToken(Utility::string_view &token);
+    bool AddArg(Utility::string_view arg);
+
+    std::string m_buffer;
+    Utility::string_view m_token;
+    Utility::string_view m_command;
+    Utility::string_view m_args[MaxArgs];
+    size_t m_argsCount;
+    size_t m_next;  // read position in m_buffer
+};
+
+} // namespace netcoredbg
@@ -6,7 +6,7 @@
 #include "utils/platform.h"
 #include "utils/torelease.h"
 #include "protocols/miprotocol.h"
-#include "tokenizer.h"
+#include "micommandline.h"
 #include "utils/filesystem.h"
 
 #include <sstream>
@@ -14,6 +14,8 @@
 #include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <map>
+#include <cstdlib>
 
 #include "utils/logger.h"
 
@@ -106,74 +108,79 @@ static HRESULT StepCommand(std::shared_ptr<IDebugger> &sharedDebugger, MIProtoco
     return S_OK;
 }
 
-static HRESULT PrintFrameLocation(const StackFrame &stackFrame, std::string &output)
+static HRESULT WriteFrameLocation(MIWriter &writer, const StackFrame &stackFrame)
 {
-    std::ostringstream ss;
-
     if (!stackFrame.source.IsNull())
     {
-        ss << "file=\"" << MIProtocol::EscapeMIValue(stackFrame.source.name) << "\","
-           << "fullname=\"" << MIProtocol::EscapeMIValue(stackFrame.source.path) << "\","
-           << "line=\"" << stackFrame.line << "\","
-           << "col=\"" << stackFrame.column << "\","
-           << "end-line=\"" << stackFrame.endLine << "\","
-           << "end-col=\"" << stackFrame.endColumn << "\",";
+        writer.Key("file").String(stackFrame.source.name)
+              .Key("fullname").String(stackFrame.source.path)
+              .Key("line").Int(stackFrame.line)
+              .Key("col").Int(stackFrame.column)
+              .Key("end-line").Int(stackFrame.endLine)
+              .Key("end-col").Int(stackFrame.endColumn);
     }
 
     if (stackFrame.clrAddr.methodToken != 0)
     {
-        ss << "clr-addr={module-id=\"{" << stackFrame.moduleId << "}\","
-           << "method-token=\"0x"
-           << std::setw(8) << std::setfill('0') << std::hex << stackFrame.clrAddr.methodToken << "\","
-           << "method-version=\"" << std::dec << stackFrame.clrAddr.methodVersion << "\","
-           << "il-offset=\"" << std::dec << stackFrame.clrAddr.ilOffset
-           << "\",native-offset=\"" << stackFrame.clrAddr.nativeOffset << "\"},";
+        char methodToken[16];
+        snprintf(methodToken, sizeof(methodToken), "0x%08x", stackFrame.clrAddr.methodToken);
+
+        writer.Key("clr-addr").BeginTuple()
+              .Key("module-id").String("{" + stackFrame.moduleId + "}")
+              .Key("method-token").String(methodToken)
+              .Key("method-version").UInt(stackFrame.clrAddr.methodVersion)
+              .Key("il-offset").UInt(stackFrame.clrAddr.ilOffset)
+              .Key("native-offset").UInt(stackFrame.clrAddr.nativeOffset)
+              .EndTuple();
     }
 
-    ss << "func=\"" << stackFrame.methodName << "\"";
+    writer.Key("func").String(stackFrame.methodName);
     if (stackFrame.id)
-        ss << ",addr=\"" << ProtocolUtils::AddrToString(stackFrame.addr) << "\"";
+        writer.Key("addr").String(ProtocolUtils::AddrToString(stackFrame.addr));
 
-    ss << ",active-statement-flags=\"";
+    std::string flags;
     if (stackFrame.activeStatementFlags == StackFrame::ActiveStatementFlags::None)
     {
-        ss << "None";
+        flags = "None";
     }
     else
     {
         struct flag_t
         {
             StackFrame::ActiveStatementFlags bit;
-            std::string name;
-            flag_t(StackFrame::ActiveStatementFlags bit_, const std::string &name_) : bit(bit_), name(name_) {}
+            const char *name;
         };
-        static const std::vector<flag_t> flagsMap
+        static const flag_t flagsMap[] =
            {{StackFrame::ActiveStatementFlags::LeafFrame,          "LeafFrame"},
             {StackFrame::ActiveStatementFlags::NonLeafFrame,       "NonLeafFrame"},
             {StackFrame::ActiveStatementFlags::PartiallyExecuted,  "PartiallyExecuted"},
             {StackFrame::ActiveStatementFlags::MethodUpToDate,     "MethodUpToDate"},
             {StackFrame::ActiveStatementFlags::Stale,              "Stale"}};
-        bool first = true;
         for (auto &flag : flagsMap)
         {
             if ((stackFrame.activeStatementFlags & flag.bit) == flag.bit)
             {
-                ss << (first ? "":",") << flag.name;
-                first = false;
+                if (!flags.empty())
+                    flags.push_back(',');
+                flags.append(flag.name);
             }
         }
     }
-    ss << "\"";
-
-    output = ss.str();
+    writer.Key("active-statement-flags").String(flags);
 
     return stackFrame.source.IsNull() ? S_FALSE : S_OK;
 }
 
+static HRESULT PrintFrameLocation(const StackFrame &stackFrame, std::string &output)
+{
+    output.clear();
+    MIWriter writer(output);
+    return WriteFrameLocation(writer, stackFrame);
+}
+
 static HRESULT PrintFrames(std::shared_ptr<IDebugger> &sharedDebugger, ThreadId threadId, std::string &output, FrameLevel lowFrame, FrameLevel highFrame, bool hotReloadAwareCaller)
 {
     HRESULT Status;
-    std::ostringstream ss;
 
     int totalFrames = 0;
     std::vector<StackFrame> stackFrames;
@@ -181,79 +188,54 @@ static HRESULT PrintFrames(std::shared_ptr<IDebugger> &sharedDebugger, ThreadId
 
     int currentFrame = int(lowFrame);
 
-    ss << "stack=[";
-    const char *sep = "";
-
+    output.clear();
+    MIWriter writer(output);
+    writer.Key("stack").BeginList();
     for (const StackFrame &stackFrame : stackFrames)
     {
-        ss << sep;
-        sep = ",";
-
-        std::string frameLocation;
-        PrintFrameLocation(stackFrame, frameLocation);
-
-        ss << "frame={level=\"" << currentFrame << "\"";
-        if (!frameLocation.empty())
-            ss << "," << frameLocation;
-        ss << "}";
+        writer.Key("frame").BeginTuple().Key("level").Int(currentFrame);
+        WriteFrameLocation(writer, stackFrame);
+        writer.EndTuple();
         currentFrame++;
     }
-
-    ss << "]";
-
-    output = ss.str();
+    writer.EndList();
 
     return S_OK;
 }
 
 static HRESULT PrintVariables(const std::vector<Variable> &variables, std::string &output)
 {
-    std::ostringstream ss;
-    ss << "variables=[";
-    const char *sep = "";
-
+    output.clear();
+    MIWriter writer(output);
+    writer.Key("variables").BeginList();
     for (const Variable &var : variables)
     {
-        ss << sep;
-        sep = ",";
-
-        ss << "{name=\"" << MIProtocol::EscapeMIValue(var.name) << "\"";
-        ss << ",value=\"" << MIProtocol::EscapeMIValue(var.value) << "\"";
-        ss << "}";
+        writer.BeginTuple()
+              .Key("name").String(var.name)
+              .Key("value").String(var.value)
+              .EndTuple();
     }
-
-    ss << "]";
-    output = ss.str();
+    writer.EndList();
     return S_OK;
 }
 
-static void PrintVar(const std::string &varobjName, Variable &v, ThreadId threadId, int print_values, std::string &output)
+static void WriteVar(MIWriter &writer, const std::string &varobjName, Variable &v, ThreadId threadId, int print_values)
 {
-    std::ostringstream ss;
-
-    std::string attributes;
-    if (v.editable)
-        attributes = "editable";
-    else
-        attributes = "noneditable";
-
-    ss << "name=\"" << varobjName << "\",";
+    writer.Key("name").String(varobjName);
     if (print_values)
-    {
-        ss << "value=\"" << MIProtocol::EscapeMIValue(v.value) << "\",";
-    }
-    ss << "attributes=\"" << attributes << "\",";
-    ss << "exp=\"" << MIProtocol::EscapeMIValue(v.name.empty() ? v.evaluateName : v.name) << "\",";
-    ss << "numchild=\"" << v.namedVariables << "\",";
-    ss << "type=\"" << v.type << "\",";
-    ss << "thread-id=\"" << int(threadId) << "\"";
-
-    output = ss.str();
+        writer.Key("value").String(v.value);
+    writer.Key("attributes").String(v.editable ? string_view("editable") : string_view("noneditable"))
+          .Key("exp").String(v.name.empty() ? v.evaluateName : v.name)
+          .Key("numchild").Int(v.namedVariables)
+          .Key("type").String(v.type)
+          .Key("thread-id").Int(int(threadId));
 }
 
 HRESULT MIProtocol::VariablesHandle::PrintNewVar(const std::string& varobjName, Variable &v, ThreadId threadId,
-                                                 FrameLevel level, int print_values, std::string &output)
+                                                 FrameLevel level, int print_values, MIWriter &writer)
 {
+    std::lock_guard<std::mutex> lock(m_varsMutex);
+
     if (m_vars.size() == std::numeric_limits<unsigned>::max())
         return E_FAIL;
 
@@ -267,9 +249,9 @@ HRESULT MIProtocol::VariablesHandle::PrintNewVar(const std::string& varobjName,
         name = varobjName;
     }
 
-    m_vars[name] = MIVariable{v, threadId, level};
+    WriteVar(writer, name, v, threadId, print_values);
 
-    PrintVar(name, v, threadId, print_values, output);
+    m_vars[std::move(name)] = MIVariable{v, threadId, level};
 
     return S_OK;
 }
@@ -284,7 +266,53 @@ HRESULT MIProtocol::VariablesHandle::CreateVar(std::shared_ptr<IDebugger> &share
     IfFailRet(sharedDebugger->Evaluate(frameId, expression, variable, output));
 
     int print_values = 1;
-    return PrintNewVar(varobjName, variable, threadId, level, print_values, output);
+    output.clear();
+    MIWriter writer(output);
+    return PrintNewVar(varobjName, variable, threadId, level, print_values, writer);
+}
+
+// Create var objects for all expressions by one batch evaluation, in case of expression evaluation error, var object is not
+// created and error message provided instead.
+HRESULT MIProtocol::VariablesHandle::CreateVars(std::shared_ptr<IDebugger> &sharedDebugger, ThreadId threadId, FrameLevel level,
+                                                int evalFlags, const std::vector<std::string> &expressions, std::string &output)
+{
+    HRESULT Status;
+
+    FrameId frameId(threadId, level);
+    std::vector<Variable> variables(expressions.size(), Variable(evalFlags));
+    std::vector<HRESULT> statuses;
+    std::vector<std::string> outputs;
+    IfFailRet(sharedDebugger->EvaluateBatch(frameId, expressions, variables, statuses, outputs));
+
+    output.clear();
+    MIWriter writer(output);
+    writer.Key("vars").BeginList();
+    const std::string minus("-");
+    for (size_t i = 0; i < expressions.size(); i++)
+    {
+        if (FAILED(statuses[i]))
+        {
+            if (outputs[i].empty())
+            {
+                std::ostringstream stream;
+                stream << "Error: 0x" << std::hex << statuses[i];
+                outputs[i] = stream.str();
+            }
+            writer.Key("var").BeginTuple()
+                  .Key("exp").String(expressions[i])
+                  .Key("error").String(outputs[i])
+                  .EndTuple();
+            continue;
+        }
+
+        int print_values = 1;
+        writer.Key("var").BeginTuple();
+        IfFailRet(PrintNewVar(minus, variables[i], threadId, level, print_values, writer));
+        writer.EndTuple();
+    }
+    writer.EndList();
+
+    return S_OK;
 }
 
 HRESULT MIProtocol::VariablesHandle::DeleteVar(const std::string &varobjName)
@@ -298,12 +326,14 @@ HRESULT MIProtocol::VariablesHandle::DeleteVar(const std::string &varobjName)
     //       Debugger can't provide any data by old var objects in this case, since old data have inconsistent state.
     //       This is the reason why we don't hold old data. IDE must create new var objects for each stop point.
     // * IDE should not care about `var-delete` return status, but just in case return S_OK.
+    std::lock_guard<std::mutex> lock(m_varsMutex);
     m_vars.erase(varobjName);
     return S_OK;
 }
 
 HRESULT MIProtocol::VariablesHandle::FindVar(const std::string &varobjName, MIVariable &variable)
 {
+    std::lock_guard<std::mutex> lock(m_varsMutex);
     auto it = m_vars.find(varobjName);
     if (it == m_vars.end())
         return E_FAIL;
@@ -321,6 +351,7 @@ void MIProtocol::Cleanup()
 
 void MIProtocol::VariablesHandle::Cleanup()
 {
+    std::lock_guard<std::mutex> lock(m_varsMutex);
     m_vars.clear();
 }
 
@@ -328,31 +359,23 @@ HRESULT MIProtocol::VariablesHandle::PrintChildren(std::vector<Variable> &childr
                                                    int print_values, bool has_more, std::string &output)
 {
     HRESULT Status;
-    std::ostringstream ss;
-    ss << "numchild=\"" << children.size() << "\"";
+    output.clear();
+    MIWriter writer(output);
+    writer.Key("numchild").UInt(children.size());
 
     if (children.empty())
-    {
-        output = ss.str();
         return S_OK;
-    }
-    ss << ",children=[";
 
-    const char *sep = "";
+    writer.Key("children").BeginList();
+    const std::string minus("-");
     for (auto &child : children)
     {
-        std::string varout;
-        std::string minus("-");
-        IfFailRet(PrintNewVar(minus, child, threadId, level, print_values, varout));
-
-        ss << sep;
-        sep = ",";
-        ss << "child={" << varout << "}";
+        writer.Key("child").BeginTuple();
+        IfFailRet(PrintNewVar(minus, child, threadId, level, print_values, writer));
+        writer.EndTuple();
     }
-
-    ss << "]";
-    ss << ",has_more=\"" << (has_more ? 1 : 0) << "\"";
-    output = ss.str();
+    writer.EndList();
+    writer.Key("has_more").Int(has_more ? 1 : 0);
 
     return S_OK;
 }
@@ -378,6 +401,128 @@ HRESULT MIProtocol::VariablesHandle::ListChildren(std::shared_ptr<IDebugger> &sh
     return PrintChildren(variables, miVariable.threadId, miVariable.level, print_values, has_more, output);
 }
 
+// Note, var objects values are cached (values provided at var object creation or last update), so, only var objects
+// with changed value or type are provided in changelist. For all var objects update ("*"), var objects are evaluated
+// by one batch per frame without func-evals, so, property-backed and lazy var objects are not re-evaluated
+// (and treated as unchanged), such var objects are re-evaluated by explicit update request only.
+HRESULT MIProtocol::VariablesHandle::UpdateVars(std::shared_ptr<IDebugger> &sharedDebugger, const std::string &varobjName,
+                                                int print_values, std::string &output)
+{
+    HRESULT Status;
+    const bool updateAll = varobjName == "*";
+
+    std::vector<std::pair<std::string, MIVariable> > vars;
+    {
+        std::lock_guard<std::mutex> lock(m_varsMutex);
+        if (updateAll)
+        {
+            vars.reserve(m_vars.size());
+            for (const auto &entry : m_vars)
+            {
+                if (!entry.second.variable.presentationHint.lazy)
+                    vars.emplace_back(entry);
+            }
+            // Note, provide changelist in var objects creation order (names have same prefix in most cases).
+            std::sort(vars.begin(), vars.end(), [](const std::pair<std::string, MIVariable> &left, const std::pair<std::string, MIVariable> &right)
+            {
+                return left.first.size() != right.first.size() ? left.first.size() < right.first.size() : left.first < right.first;
+            });
+        }
+        else
+        {
+            auto find = m_vars.find(varobjName);
+            if (find == m_vars.end())
+                return E_FAIL;
+            vars.emplace_back(*find);
+        }
+    }
+
+    // Group var objects by frame for batch evaluation.
+    std::map<std::pair<int, int>, std::vector<size_t> > frames;
+    for (size_t i = 0; i < vars.size(); i++)
+    {
+        frames[std::make_pair(int(vars[i].second.threadId), int(vars[i].second.level))].push_back(i);
+    }
+
+    std::vector<Variable> updated(vars.size());
+    std::vector<bool> evaluated(vars.size(), false);
+    for (const auto &frame : frames)
+    {
+        FrameId frameId(vars[frame.second.front()].second.threadId, vars[frame.second.front()].second.level);
+        std::vector<std::string> expressions;
+        std::vector<Variable> variables;
+        expressions.reserve(frame.second.size());
+        variables.reserve(frame.second.size());
+        for (size_t index : frame.second)
+        {
+            const Variable &variable = vars[index].second.variable;
+            expressions.emplace_back(variable.evaluateName);
+            variables.emplace_back(updateAll ? variable.evalFlags | EVAL_NOFUNCEVAL : variable.evalFlags);
+        }
+
+        std::vector<HRESULT> statuses;
+        std::vector<std::string> outputs;
+        if (!updateAll)
+        {
+            IfFailRet(sharedDebugger->Evaluate(frameId, expressions[0], variables[0], output));
+            statuses.push_back(S_OK);
+        }
+        else if (FAILED(sharedDebugger->EvaluateBatch(frameId, expressions, variables, statuses, outputs)))
+            continue;
+
+        for (size_t i = 0; i < frame.second.size(); i++)
+        {
+            if (FAILED(statuses[i]))
+                continue;
+
+            updated[frame.second[i]] = std::move(variables[i]);
+            evaluated[frame.second[i]] = true;
+        }
+    }
+
+    output.clear();
+    MIWriter writer(output);
+    writer.Key("changelist").BeginList();
+    for (size_t i = 0; i < vars.size(); i++)
+    {
+        if (!evaluated[i])
+            continue;
+
+        const Variable &cached = vars[i].second.variable;
+        Variable &variable = updated[i];
+        const bool typeChanged = variable.type != cached.type;
+        if (!typeChanged && variable.value == cached.value)
+            continue;
+
+        // Note, var object keep own name and attributes, only value related data updated.
+        variable.name = cached.name;
+        variable.evaluateName = cached.evaluateName;
+        variable.evalFlags = cached.evalFlags;
+        variable.editable = cached.editable;
+        {
+            std::lock_guard<std::mutex> lock(m_varsMutex);
+            auto find = m_vars.find(vars[i].first);
+            if (find != m_vars.end())
+                find->second.variable = variable;
+        }
+
+        writer.BeginTuple().Key("name").String(vars[i].first);
+        if (print_values == 1 || (print_values == 2 && variable.namedVariables == 0))
+            writer.Key("value").String(variable.value);
+        writer.Key("in_scope").String("true")
+              .Key("type_changed").String(typeChanged ? string_view("true") : string_view("false"));
+        if (typeChanged)
+        {
+            writer.Key("new_type").String(variable.type)
+                  .Key("new_num_children").Int(variable.namedVariables);
+        }
+        writer.EndTuple();
+    }
+    writer.EndList();
+
+    return S_OK;
+}
+
 static void ParseBreakpointIndexes(const std::vector<std::string> &args, std::function<void(const std::unordered_set<uint32_t> &ids)> cb)
 {
     std::unordered_set<uint32_t> ids;
@@ -398,29 +543,32 @@ void MIProtocol::EmitStoppedEvent(const StoppedEvent &event)
 
     std::string frameLocation;
     PrintFrameLocation(event.frame, frameLocation);
+    // Note, in non-stop mode only event thread is stopped.
+    const std::string stoppedThreads = event.allThreadsStopped ? "\"all\"" : "[\"" + std::to_string(int(event.threadId)) + "\"]";
 
     switch(event.reason)
     {
         case StopBreakpoint:
         {
-            MIProtocol::Printf("*stopped,reason=\"breakpoint-hit\",thread-id=\"%i\",stopped-threads=\"all\",bkptno=\"%u\",times=\"%u\",frame={%s}\n",
-                int(event.threadId), (unsigned int)event.breakpoint.id, (unsigned int)event.breakpoint.hitCount, frameLocation.c_str());
+            MIProtocol::Printf("*stopped,reason=\"breakpoint-hit\",thread-id=\"%i\",stopped-threads=%s,bkptno=\"%u\",times=\"%u\",frame={%s}\n",
+                int(event.threadId), stoppedThreads.c_str(), (unsigned int)event.breakpoint.id, (unsigned int)event.breakpoint.hitCount, frameLocation.c_str());
             break;
         }
         case StopStep:
         {
-            MIProtocol::Printf("*stopped,reason=\"end-stepping-range\",thread-id=\"%i\",stopped-threads=\"all\",frame={%s}\n",
-                int(event.threadId), frameLocation.c_str());
+            MIProtocol::Printf("*stopped,reason=\"end-stepping-range\",thread-id=\"%i\",stopped-threads=%s,frame={%s}\n",
+                int(event.threadId), stoppedThreads.c_str(), frameLocation.c_str());
             break;
         }
         case StopException:
         {
-            MIProtocol::Printf("*stopped,reason=\"exception-received\",exception-name=\"%s\",exception=\"%s\",exception-stage=\"%s\",exception-category=\"%s\",thread-id=\"%i\",stopped-threads=\"all\",frame={%s}\n",
+            MIProtocol::Printf("*stopped,reason=\"exception-received\",exception-name=\"%s\",exception=\"%s\",exception-stage=\"%s\",exception-category=\"%s\",thread-id=\"%i\",stopped-threads=%s,frame={%s}\n",
                 event.exception_name.c_str(),
                 MIProtocol::EscapeMIValue(event.exception_message.empty() ? event.text : event.exception_message).c_str(),
                 event.exception_stage.c_str(),
                 event.exception_category.c_str(),
                 int(event.threadId),
+                stoppedThreads.c_str(),
                 frameLocation.c_str());
             break;
         }
@@ -428,14 +576,21 @@ void MIProtocol::EmitStoppedEvent(const StoppedEvent &event)
         {
             // When async break happens, this should be reason="interrupted".
             // But MIEngine in Visual Studio accepts only reason="signal-received",signal-name="SIGINT".
-            MIProtocol::Printf("*stopped,reason=\"signal-received\",signal-name=\"SIGINT\",thread-id=\"%i\",stopped-threads=\"all\",frame={%s}\n",
-                int(event.threadId), frameLocation.c_str());
+            MIProtocol::Printf("*stopped,reason=\"signal-received\",signal-name=\"SIGINT\",thread-id=\"%i\",stopped-threads=%s,frame={%s}\n",
+                int(event.threadId), stoppedThreads.c_str(), frameLocation.c_str());
             break;
         }
         case StopEntry:
         {
-            MIProtocol::Printf("*stopped,reason=\"entry-point-hit\",thread-id=\"%i\",stopped-threads=\"all\",frame={%s}\n",
-                int(event.threadId), frameLocation.c_str());
+            MIProtocol::Printf("*stopped,reason=\"entry-point-hit\",thread-id=\"%i\",stopped-threads=%s,frame={%s}\n",
+                int(event.threadId), stoppedThreads.c_str(), frameLocation.c_str());
+            break;
+        }
+        case StopDataBreakpoint:
+        {
+            MIProtocol::Printf("*stopped,reason=\"watchpoint-trigger\",wpt={number=\"%u\",exp=\"%s\"},thread-id=\"%i\",stopped-threads=%s,times=\"%u\",frame={%s}\n",
+                (unsigned int)event.breakpoint.id, event.breakpoint.funcname.c_str(), int(event.threadId), stoppedThreads.c_str(),
+                (unsigned int)event.breakpoint.hitCount, frameLocation.c_str());
             break;
         }
         default:
@@ -443,6 +598,7 @@ void MIProtocol::EmitStoppedEvent(const StoppedEvent &event)
     }
 
     MIProtocol::Printf("(gdb)\n");
+    Flush();
 }
 
 void MIProtocol::EmitExitedEvent(const ExitedEvent &event)
@@ -451,11 +607,20 @@ void MIProtocol::EmitExitedEvent(const ExitedEvent &event)
 
     MIProtocol::Printf("*stopped,reason=\"exited\",exit-code=\"%i\"\n", event.exitCode);
     MIProtocol::Printf("(gdb)\n");
+    Flush();
 }
 
-void MIProtocol::EmitContinuedEvent(ThreadId threadId)
+void MIProtocol::EmitContinuedEvent(ThreadId threadId, bool allThreadsContinued)
 {
     LogFuncEntry();
+
+    // Note, in all-stop mode MIEngine don't need *running event, since it's implied by exec command result.
+    if (allThreadsContinued || !threadId)
+        return;
+
+    MIProtocol::Printf("*running,thread-id=\"%i\"\n", int(threadId));
+    MIProtocol::Printf("(gdb)\n");
+    Flush();
 }
 
 void MIProtocol::EmitThreadEvent(const ThreadEvent &event)
@@ -524,13 +689,16 @@ void MIProtocol::EmitOutputEvent(OutputCategory category, string_view output, st
 
     std::lock_guard<std::mutex> lock(m_outMutex);
 
-    cout << "=message,text=\"" << EscapeMIValue(output) << "\",send-to=\"output-window\"";
+    m_outBuffer.append("=message,");
+    MIWriter writer(m_outBuffer);
+    writer.Key("text").String(output)
+          .Key("send-to").String("output-window");
 
     if (!source.empty())
-        cout << ",source=\"" << EscapeMIValue(source) << "\"";
+        writer.Key("source").String(source);
 
-    cout << "\n";
-    cout.flush();
+    m_outBuffer.push_back('\n');
+    FlushIfIdle();
 }
 
 static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, BreakpointsHandle &breakpointsHandle, MIProtocol::VariablesHandle &variablesHandle,
@@ -650,6 +818,67 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
 
         return Status;
     } },
+    { "break-watch", [&](const std::vector<std::string> &unmutable_args, std::string &output) -> HRESULT {
+        // Note, native memory address only (interop mode), optional size argument is not part of GDB/MI.
+        std::vector<std::string> args = unmutable_args;
+        ProtocolUtils::StripArgs(args);
+
+        DataBreakpointAccess access = DataBreakpointAccess::Write;
+        std::string miType = "wpt";
+        if (ProtocolUtils::FindAndEraseArg(args, "-r"))
+        {
+            access = DataBreakpointAccess::Read;
+            miType = "hw-rwpt";
+        }
+        else if (ProtocolUtils::FindAndEraseArg(args, "-a"))
+        {
+            access = DataBreakpointAccess::ReadWrite;
+            miType = "hw-awpt";
+        }
+
+        if (args.empty() || args.size() > 2)
+        {
+            output = "Command usage: -break-watch [-r|-a] <address> [<size>]";
+            return E_INVALIDARG;
+        }
+
+        std::string addrStr = args.at(0);
+        if (!addrStr.empty() && addrStr[0] == '*')
+            addrStr.erase(0, 1);
+
+        char *end = nullptr;
+        unsigned long long address = strtoull(addrStr.c_str(), &end, 16);
+        if (end == addrStr.c_str() || *end != '\0' || address == 0)
+        {
+            output = "Wrong watchpoint address specified";
+            return E_INVALIDARG;
+        }
+
+        uint32_t size = sizeof(std::uintptr_t);
+        if (args.size() == 2)
+        {
+            bool ok;
+            int sizeValue = ProtocolUtils::ParseInt(args.at(1), ok);
+            if (!ok || sizeValue <= 0)
+            {
+                output = "Wrong watchpoint size specified";
+                return E_INVALIDARG;
+            }
+            size = (uint32_t)sizeValue;
+        }
+
+        HRESULT Status;
+        Breakpoint breakpoint;
+        IfFailRet(breakpointsHandle.SetDataBreakpoint(sharedDebugger, (std::uintptr_t)address, size, access, breakpoint));
+
+        std::ostringstream ss;
+        ss << miType << "={number=\"" << breakpoint.id << "\",exp=\"" << breakpoint.funcname << "\"}";
+        if (!breakpoint.verified)
+            ss << ",warning=\"" << MIProtocol::EscapeMIValue(breakpoint.message) << "\"";
+        output = ss.str();
+
+        return S_OK;
+    } },
     { "break-exception-insert", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
         if (args.size() < 2)
         {
@@ -711,6 +940,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         {
             breakpointsHandle.DeleteLineBreakpoints(sharedDebugger, ids);
             breakpointsHandle.DeleteFuncBreakpoints(sharedDebugger, ids);
+            breakpointsHandle.DeleteDataBreakpoints(sharedDebugger, ids);
         });
         return S_OK;
     } },
@@ -751,6 +981,25 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
     { "exec-finish", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
         return StepCommand(sharedDebugger, variablesHandle, args, IDebugger::StepType::STEP_OUT, output);
     }},
+    { "exec-until", [&](const std::vector<std::string> &unmutable_args, std::string &output) -> HRESULT {
+        // Same as GDB/MI, continue till location reached, but any other stop event (breakpoint, step, etc.) also stop execution.
+        std::vector<std::string> args = unmutable_args;
+        ThreadId threadId{ ProtocolUtils::GetIntArg(args, "--thread", int(sharedDebugger->GetLastStoppedThreadId())) };
+        ProtocolUtils::StripArgs(args);
+
+        struct LineBreak lb;
+        if (args.empty() || !ProtocolUtils::ParseBreakpoint(args, lb))
+        {
+            output = "Wrong location specified";
+            return E_FAIL;
+        }
+
+        HRESULT Status;
+        IfFailRet(sharedDebugger->RunToLine(threadId, lb.filename, lb.linenum));
+        variablesHandle.Cleanup(); // Important, must be sync with ManagedDebugger m_sharedVariables->Clear()
+        output = "^running";
+        return S_OK;
+    }},
     { "exec-abort", [&](const std::vector<std::string> &, std::string &output) -> HRESULT {
         sharedDebugger->Disconnect(IDebugger::DisconnectAction::DisconnectTerminate);
         return S_OK;
@@ -813,6 +1062,9 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         ThreadId threadId { ProtocolUtils::GetIntArg(args, "--thread", int(sharedDebugger->GetLastStoppedThreadId())) };
         FrameLevel level { ProtocolUtils::GetIntArg(args, "--frame", 0) };
         int evalFlags = ProtocolUtils::GetIntArg(args, "--evalFlags", 0);
+        int evalTimeout = ProtocolUtils::GetIntArg(args, "--evalTimeout", 0);
+        if (evalTimeout > 0)
+            evalFlags = SetEvalFlagsTimeout(evalFlags, evalTimeout);
 
         std::string varName = args.at(0);
         std::string varExpr = args.at(1);
@@ -821,6 +1073,25 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
 
         return variablesHandle.CreateVar(sharedDebugger, threadId, level, evalFlags, varName, varExpr, output);
     }},
+    { "var-evaluate-batch", [&](const std::vector<std::string> &args_orig, std::string &output) -> HRESULT {
+        std::vector<std::string> args = args_orig;
+
+        ThreadId threadId { ProtocolUtils::GetIntArg(args, "--thread", int(sharedDebugger->GetLastStoppedThreadId())) };
+        FrameLevel level { ProtocolUtils::GetIntArg(args, "--frame", 0) };
+        int evalFlags = ProtocolUtils::GetIntArg(args, "--evalFlags", 0);
+        int evalTimeout = ProtocolUtils::GetIntArg(args, "--evalTimeout", 0);
+        if (evalTimeout > 0)
+            evalFlags = SetEvalFlagsTimeout(evalFlags, evalTimeout);
+
+        ProtocolUtils::StripArgs(args);
+        if (args.empty())
+        {
+            output = "Command requires at least 1 argument";
+            return E_FAIL;
+        }
+
+        return variablesHandle.CreateVars(sharedDebugger, threadId, level, evalFlags, args, output);
+    }},
     { "var-list-children", [&](const std::vector<std::string> &args_orig, std::string &output) -> HRESULT {
         std::vector<std::string> args = args_orig;
 
@@ -911,6 +1182,36 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
             sharedDebugger->SetStepFiltering(args.at(1) == "1");
         else if (args.at(0) == "enable-hot-reload")
             return sharedDebugger->SetHotReload(args.at(1) == "1");
+        else if (args.at(0) == "eval-timeout")
+        {
+            bool ok;
+            int timeout = ProtocolUtils::ParseInt(args.at(1), ok);
+            if (!ok || timeout < 0)
+                return E_FAIL;
+            sharedDebugger->SetEvalTimeout(timeout);
+        }
+        else if (args.at(0) == "enable-adaptive-eval-timeout")
+            sharedDebugger->SetAdaptiveEvalTimeout(args.at(1) == "1");
+        else if (args.at(0) == "max-parallel-evals")
+        {
+            bool ok;
+            int count = ProtocolUtils::ParseInt(args.at(1), ok);
+            if (!ok || count < 0)
+                return E_FAIL;
+            sharedDebugger->SetMaxParallelEvals(count);
+        }
+        else if (args.at(0) == "enable-array-preview")
+            sharedDebugger->SetArrayPreview(args.at(1) == "1");
+        else if (args.at(0) == "variables-eval-budget")
+        {
+            bool ok;
+            int budget = ProtocolUtils::ParseInt(args.at(1), ok);
+            if (!ok || budget < 0)
+                return E_FAIL;
+            sharedDebugger->SetEvalBudget(budget);
+        }
+        else if (args.at(0) == "non-stop")
+            sharedDebugger->SetNonStop(args.at(1) == "1" || args.at(1) == "on");
         else
             return E_FAIL;
 
@@ -926,6 +1227,18 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
             ss << "value=\"" << (sharedDebugger->IsJustMyCode() ? "1" : "0") << "\"";
         else if (args.at(0) == "enable-step-filtering")
             ss << "value=\"" << (sharedDebugger->IsStepFiltering() ? "1" : "0") << "\"";
+        else if (args.at(0) == "eval-timeout")
+            ss << "value=\"" << sharedDebugger->GetEvalTimeout() << "\"";
+        else if (args.at(0) == "enable-adaptive-eval-timeout")
+            ss << "value=\"" << (sharedDebugger->IsAdaptiveEvalTimeout() ? "1" : "0") << "\"";
+        else if (args.at(0) == "max-parallel-evals")
+            ss << "value=\"" << sharedDebugger->GetMaxParallelEvals() << "\"";
+        else if (args.at(0) == "enable-array-preview")
+            ss << "value=\"" << (sharedDebugger->IsArrayPreview() ? "1" : "0") << "\"";
+        else if (args.at(0) == "variables-eval-budget")
+            ss << "value=\"" << sharedDebugger->GetEvalBudget() << "\"";
+        else if (args.at(0) == "non-stop")
+            ss << "value=\"" << (sharedDebugger->IsNonStop() ? "on" : "off") << "\"";
         else
             return E_FAIL;
 
@@ -935,6 +1248,37 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
     { "interpreter-exec", [](const std::vector<std::string> &args, std::string &output) -> HRESULT {
         return S_OK;
     }},
+    { "var-update", [&](const std::vector<std::string> &args_orig, std::string &output) -> HRESULT {
+        std::vector<std::string> args = args_orig;
+
+        int print_values = 0;
+        if (!args.empty())
+        {
+            auto first_arg_it = args.begin();
+            if (*first_arg_it == "1" || *first_arg_it == "--all-values")
+            {
+                print_values = 1;
+                args.erase(first_arg_it);
+            }
+            else if (*first_arg_it == "2" || *first_arg_it == "--simple-values")
+            {
+                print_values = 2;
+                args.erase(first_arg_it);
+            }
+            else if (*first_arg_it == "0" || *first_arg_it == "--no-values")
+            {
+                args.erase(first_arg_it);
+            }
+        }
+
+        if (args.size() != 1)
+        {
+            output = "Command requires an argument";
+            return E_FAIL;
+        }
+
+        return variablesHandle.UpdateVars(sharedDebugger, args.at(0), print_values, output);
+    }},
     { "var-show-attributes", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
         HRESULT Status;
         MIProtocol::MIVariable miVariable;
@@ -995,6 +1339,38 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         output = "value=\"" + MIProtocol::EscapeMIValue(variable.value) + "\"";
         return S_OK;
     }},
+    // Read part of string value of var object: `-var-read-string <varobj> <offset> <count>` (offset and count in
+    // UTF-16 code units), in order to fetch full value of huge string by parts (var objects provide truncated preview).
+    { "var-read-string", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+        HRESULT Status;
+
+        if (args.size() != 3)
+        {
+            output = "Command requires 3 arguments";
+            return E_FAIL;
+        }
+
+        bool ok;
+        int offset = ProtocolUtils::ParseInt(args.at(1), ok);
+        if (!ok || offset < 0)
+            return E_INVALIDARG;
+        int count = ProtocolUtils::ParseInt(args.at(2), ok);
+        if (!ok || count < 0)
+            return E_INVALIDARG;
+
+        MIProtocol::MIVariable miVariable;
+        IfFailRet(variablesHandle.FindVar(args.at(0), miVariable));
+        FrameId frameId(miVariable.threadId, miVariable.level);
+        std::string value;
+        uint32_t read;
+        uint32_t length;
+        IfFailRet(sharedDebugger->ReadString(frameId, miVariable.variable.evaluateName, miVariable.variable.evalFlags,
+                                             uint32_t(offset), uint32_t(count), value, read, length));
+
+        output = "value=\"" + MIProtocol::EscapeMIValue(value) + "\",read=\"" + std::to_string(read) +
+                 "\",length=\"" + std::to_string(length) + "\"";
+        return S_OK;
+    }},
     { "apply-deltas", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
         HRESULT Status;
 
@@ -1027,152 +1403,286 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
     return command_it->second(args, output);
 }
 
-static bool ParseLine(const std::string &str, std::string &token, std::string &cmd, std::vector<std::string> &args)
+MIProtocol::CommandsLaneType MIProtocol::GetCommandLane(const std::string &command)
 {
-    token.clear();
-    cmd.clear();
-    args.clear();
+    // Commands, that could be executed in parallel, since only read debugger/debuggee state.
+    static const std::unordered_set<std::string> readOnlyCommandSet{
+        "thread-info", "stack-list-frames", "var-show-attributes"};
+    // Commands, that must be executed in order with each other (could run implicit func-evals and create var objects).
+    // Note, func-eval resume debuggee, so, read-only commands wait for evaluation command finish (see LaneWorker()).
+    static const std::unordered_set<std::string> evaluationCommandSet{
+        "stack-list-variables", "var-create", "var-evaluate-batch", "var-list-children", "var-evaluate-expression", "var-read-string", "var-update"};
 
-    Tokenizer tokenizer(str);
-    std::string result;
+    if (readOnlyCommandSet.find(command) != readOnlyCommandSet.end())
+        return ReadOnlyLane;
 
-    if (!tokenizer.Next(result) || result.empty())
-        return false;
+    if (evaluationCommandSet.find(command) != evaluationCommandSet.end())
+        return EvaluationLane;
 
-    std::size_t i = result.find_first_not_of("0123456789");
-    if (i == std::string::npos)
-        return false;
+    return CommandsLaneTypeCount;
+}
+
+void MIProtocol::ExecuteCommand(const std::string &token, const std::string &command, const std::vector<std::string> &args)
+{
+    BeginCommand();
 
-    if (result.at(i) != '-')
-        return false;
+    std::string output;
+    HRESULT hr = HandleCommand(m_sharedDebugger, m_breakpointsHandle, m_variablesHandle, m_fileExec, m_execArgs, command, args, output);
+
+    WriteResultRecord(token, hr, output);
+    EndCommand();
+}
 
-    token = result.substr(0, i);
-    cmd = result.substr(i + 1);
+void MIProtocol::LaneWorker(CommandsLane &lane)
+{
+    std::unique_lock<std::mutex> lockLanesMutex(m_lanesMutex);
 
-    if (cmd == "var-assign")
+    while (true)
     {
-        tokenizer.Next(result);
-        args.push_back(result); // name
-        args.push_back(tokenizer.Remain()); // expression
-        return true;
+        while (lane.queue.empty() && !m_lanesExit)
+        {
+            lane.cv.wait(lockLanesMutex);
+        }
+
+        if (lane.queue.empty())
+            break;
+
+        PipelinedCommand c = std::move(lane.queue.front());
+        lane.queue.pop_front();
+        lockLanesMutex.unlock();
+
+        // Note, read-only commands could be executed in parallel with each other only, since evaluation command
+        // could run func-eval (resume debuggee) and stack walk/threads enumeration must not see debuggee in this state.
+        if (&lane == &m_lanes[ReadOnlyLane])
+        {
+            std::lock_guard<Utility::RWLock::Reader> guardLanesEvalRWLock(m_lanesEvalRWLock.reader);
+            ExecuteCommand(c.token, c.command, c.args);
+        }
+        else
+        {
+            std::lock_guard<Utility::RWLock::Writer> guardLanesEvalRWLock(m_lanesEvalRWLock.writer);
+            ExecuteCommand(c.token, c.command, c.args);
+        }
+
+        lockLanesMutex.lock();
+        lane.pending--;
+        if (lane.pending == 0)
+            m_lanesIdleCV.notify_all();
     }
-    else if (cmd == "break-condition")
+}
+
+void MIProtocol::StartLanes()
+{
+    m_lanesExit = false;
+    for (unsigned i = 0; i < ReadOnlyLaneThreads; i++)
     {
-        tokenizer.Next(result);
-        args.push_back(result); // id
-        args.push_back(tokenizer.Remain()); // expression
-        return true;
+        m_lanes[ReadOnlyLane].threads.emplace_back(&MIProtocol::LaneWorker, this, std::ref(m_lanes[ReadOnlyLane]));
     }
+    // Note, evaluation lane have only one thread, since evaluation related commands must be executed in order.
+    m_lanes[EvaluationLane].threads.emplace_back(&MIProtocol::LaneWorker, this, std::ref(m_lanes[EvaluationLane]));
+}
 
-    while (tokenizer.Next(result))
-        args.push_back(result);
+void MIProtocol::StopLanes()
+{
+    {
+        std::lock_guard<std::mutex> lockLanesMutex(m_lanesMutex);
+        m_lanesExit = true;
+    }
+    for (auto &lane : m_lanes)
+    {
+        lane.cv.notify_all();
+        for (auto &thread : lane.threads)
+        {
+            thread.join();
+        }
+        lane.threads.clear();
+    }
+}
 
-    return true;
+void MIProtocol::WaitLanesIdle()
+{
+    std::unique_lock<std::mutex> lockLanesMutex(m_lanesMutex);
+    while (m_lanes[ReadOnlyLane].pending != 0 || m_lanes[EvaluationLane].pending != 0)
+    {
+        m_lanesIdleCV.wait(lockLanesMutex);
+    }
 }
 
 void MIProtocol::CommandLoop()
 {
+    // Note, all buffers are reused between commands, so, in common case line parsing don't allocate memory.
+    MICommandLine commandLine;
+    std::string input;
     std::string token;
+    std::string command;
+    std::vector<std::string> args;
+
+    if (!m_strictOrder)
+        StartLanes();
 
     Printf("(gdb)\n");
 
     while (!m_exit)
     {
         token.clear();
-        std::string input;
 
         std::getline(cin, input);
         if (input.empty() && cin.eof())
             break;
 
-        std::vector<std::string> args;
-        std::string command;
-        if (!ParseLine(input, token, command, args))
+        if (!commandLine.Parse(input))
+        {
+            Printf("^error,msg=\"Failed to parse input\"\n");
+            continue;
+        }
+        token.assign(commandLine.Token().data(), commandLine.Token().size());
+        command.assign(commandLine.Command().data(), commandLine.Command().size());
+        commandLine.GetArgs(args);
+
+        // Note, commands without token can't be pipelined, since frontend can't match out of order results.
+        CommandsLaneType laneType = GetCommandLane(command);
+        if (!m_strictOrder && !token.empty() && laneType != CommandsLaneTypeCount)
         {
-            Printf("%s^error,msg=\"Failed to parse input\"\n", token.c_str());
+            std::lock_guard<std::mutex> lockLanesMutex(m_lanesMutex);
+            CommandsLane &lane = m_lanes[laneType];
+            lane.queue.emplace_back(PipelinedCommand{token, command, std::move(args)});
+            lane.pending++;
+            lane.cv.notify_one();
             continue;
         }
 
+        WaitLanesIdle();
+
         // Pre command action.
         if (command == "gdb-exit")
             m_exit = true;
 
+        BeginCommand();
+
         std::string output;
         HRESULT hr = HandleCommand(m_sharedDebugger, m_breakpointsHandle, m_variablesHandle, m_fileExec, m_execArgs, command, args, output);
 
         if (m_exit)
             break;
 
-        if (SUCCEEDED(hr))
-        {
-            const char *resultClass;
-            if (output.empty())
-                resultClass = "^done";
-            else if (output.at(0) == '^')
-                resultClass = "";
-            else
-                resultClass = "^done,";
-
-            Printf("%s%s%s\n", token.c_str(), resultClass, output.c_str());
-        }
-        else
-        {
-            if (output.empty())
-            {
-                Printf("%s^error,msg=\"Error: 0x%08x\"\n", token.c_str(), hr);
-            }
-            else
-            {
-                Printf("%s^error,msg=\"%s\"\n", token.c_str(), MIProtocol::EscapeMIValue(output).c_str());
-            }
-        }
-        Printf("(gdb)\n");
+        WriteResultRecord(token, hr, output);
+        EndCommand();
     }
 
+    StopLanes();
+
     if (!m_exit)
         m_sharedDebugger->Disconnect(); // Terminate debuggee process if debugger ran this process and detach in case debugger was attached to it.
 
     Printf("%s^exit\n", token.c_str());
     Printf("(gdb)\n");
+    Flush();
+}
+
+void MIProtocol::FlushLocked()
+{
+    if (m_outBuffer.empty())
+        return;
+
+    cout.write(m_outBuffer.data(), m_outBuffer.size());
+    cout.flush();
+    m_outBuffer.clear();
+}
+
+void MIProtocol::FlushIfIdle()
+{
+    if (m_commandsInProgress == 0 || m_outBuffer.size() >= MaxOutBufferSize)
+        FlushLocked();
+}
+
+void MIProtocol::Flush()
+{
+    std::lock_guard<std::mutex> lock(m_outMutex);
+    FlushLocked();
+}
+
+void MIProtocol::BeginCommand()
+{
+    std::lock_guard<std::mutex> lock(m_outMutex);
+    m_commandsInProgress++;
+}
+
+void MIProtocol::EndCommand()
+{
+    std::lock_guard<std::mutex> lock(m_outMutex);
+    m_commandsInProgress--;
+    FlushLocked();
+}
+
+// Note, result record with prompt is written into output buffer as is (without formatting), since could be huge.
+void MIProtocol::WriteResultRecord(const std::string &token, HRESULT Status, const std::string &output)
+{
+    std::lock_guard<std::mutex> lock(m_outMutex);
+
+    m_outBuffer.append(token);
+    if (SUCCEEDED(Status))
+    {
+        if (output.empty())
+            m_outBuffer.append("^done");
+        else if (output.at(0) != '^')
+            m_outBuffer.append("^done,");
+
+        m_outBuffer.append(output);
+    }
+    else if (output.empty())
+    {
+        char error[32];
+        snprintf(error, sizeof(error), "^error,msg=\"Error: 0x%08x\"", Status);
+        m_outBuffer.append(error);
+    }
+    else
+    {
+        m_outBuffer.append("^error,msg=");
+        MIWriter::EscapeString(output, m_outBuffer);
+    }
+    m_outBuffer.append("\n(gdb)\n");
 }
 
 void MIProtocol::Printf(const char *fmt, ...)
 {
-    std::string strbuffer;
-    char buffer[32];
+    // Note, format directly into output buffer tail, in most cases buffer already have enough capacity.
+    static const size_t MinFormatSize = 256;
 
-    const char *out = nullptr;
+    std::lock_guard<std::mutex> lock(m_outMutex);
+
+    const size_t start = m_outBuffer.size();
+    const size_t avail = std::max(m_outBuffer.capacity() - start, MinFormatSize);
+    m_outBuffer.resize(start + avail);
 
     va_list arg;
 
     va_start(arg, fmt);
-    int n = vsnprintf(buffer, sizeof(buffer), fmt, arg);
+    int n = vsnprintf(&m_outBuffer[start], avail, fmt, arg);
     va_end(arg);
 
     if (n < 0)
+    {
+        m_outBuffer.resize(start);
         return;
+    }
 
-    if (n >= int(sizeof(buffer)))
+    if (size_t(n) >= avail)
     {
-        strbuffer.resize(n);
+        m_outBuffer.resize(start + n + 1);
 
         va_start(arg, fmt);
-        n = vsnprintf(&strbuffer[0], strbuffer.size() + 1, fmt, arg);
+        n = vsnprintf(&m_outBuffer[start], size_t(n) + 1, fmt, arg);
         va_end(arg);
 
-        if (n < 0 || n > int(strbuffer.size()))
+        if (n < 0)
+        {
+            m_outBuffer.resize(start);
             return;
-        out = strbuffer.c_str();
-    }
-    else
-    {
-        buffer[n] = '\0';
-        out = buffer;
+        }
     }
 
-    std::lock_guard<std::mutex> lock(m_outMutex);
-    cout << out;
-    cout.flush(); // TODO too frequent flush
+    m_outBuffer.resize(start + n);
+    FlushIfIdle();
 }
 
 
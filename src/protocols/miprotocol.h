@@ -3,8 +3,11 @@
 // See the LICENSE file in the project root for more information.
 #pragma once
 
+#include <condition_variable>
+#include <list>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -12,9 +15,11 @@
 #include <memory>
 #include "utils/string_view.h"
 #include "protocols/escaped_string.h"
+#include "protocols/miwriter.h"
 #include "protocols/protocol_utils.h"
 #include "interfaces/idebugger.h"
 #include "interfaces/iprotocol.h"
+#include "utils/rwlock.h"
 
 namespace netcoredbg
 {
@@ -28,14 +33,14 @@ public:
     struct MIProtocolChars;
     using EscapeMIValue = EscapedString<MIProtocolChars>;
 
-    MIProtocol(std::istream& input, std::ostream& output) : IProtocol(input, output) {}
+    MIProtocol(std::istream& input, std::ostream& output) : IProtocol(input, output), m_commandsInProgress(0), m_strictOrder(false) {}
 
     void EmitInitializedEvent() override {}
     void EmitExecEvent(PID, const std::string& argv0) override {}
     void EmitStoppedEvent(const StoppedEvent &event) override;
     void EmitExitedEvent(const ExitedEvent &event) override;
     void EmitTerminatedEvent() override {}
-    void EmitContinuedEvent(ThreadId threadId) override;
+    void EmitContinuedEvent(ThreadId threadId, bool allThreadsContinued) override;
     void EmitThreadEvent(const ThreadEvent &event) override;
     void EmitModuleEvent(const ModuleEvent &event) override;
     void EmitOutputEvent(OutputCategory category, string_view output, string_view source = "") override;
@@ -49,6 +54,9 @@ public:
         m_execArgs = args;
     }
 
+    // Disable pipelined execution of read-only commands, all results are provided in commands order.
+    void SetStrictOrder(bool enable) { m_strictOrder = enable; }
+
     struct MIVariable
     {
         Variable variable;
@@ -59,23 +67,76 @@ public:
     class VariablesHandle
     {
     private:
+        // Note, var objects could be created and used by pipelined commands in parallel with other commands.
+        std::mutex m_varsMutex;
         std::unordered_map<std::string, MIVariable> m_vars;
 
     public:
         HRESULT CreateVar(std::shared_ptr<IDebugger> &sharedDebugger, ThreadId threadId, FrameLevel level, int evalFlags,
                           const std::string &varobjName, const std::string &expression, std::string &output);
+        HRESULT CreateVars(std::shared_ptr<IDebugger> &sharedDebugger, ThreadId threadId, FrameLevel level, int evalFlags,
+                           const std::vector<std::string> &expressions, std::string &output);
         HRESULT DeleteVar(const std::string &varobjName);
         HRESULT FindVar(const std::string &varobjName, MIVariable &variable);
         HRESULT PrintChildren(std::vector<Variable> &children, ThreadId threadId, FrameLevel level, int print_values, bool has_more, std::string &output);
-        HRESULT PrintNewVar(const std::string& varobjName, Variable &v, ThreadId threadId, FrameLevel level, int print_values, std::string &output);
+        HRESULT PrintNewVar(const std::string& varobjName, Variable &v, ThreadId threadId, FrameLevel level, int print_values, MIWriter &writer);
         HRESULT ListChildren(std::shared_ptr<IDebugger> &sharedDebugger, int childStart, int childEnd,
                              const MIVariable &miVariable, int print_values, std::string &output);
+        // Re-evaluate var object (or all var objects in case of "*" name) and provide changed var objects only.
+        HRESULT UpdateVars(std::shared_ptr<IDebugger> &sharedDebugger, const std::string &varobjName, int print_values, std::string &output);
         void Cleanup();
     };
 
 private:
 
+    // Note, output is collected in buffer and written at explicit flush points only: at the end of result record
+    // and at exec async records (stop events), async records emitted while no command in progress are written at once.
+    static const size_t MaxOutBufferSize = 64 * 1024;
     std::mutex m_outMutex;
+    std::string m_outBuffer;        // guarded by m_outMutex
+    unsigned m_commandsInProgress;  // guarded by m_outMutex
+
+    // Commands with token, that don't change debugger/debuggee state, are executed in separate threads
+    // (in case strict order is not enabled), results are provided as soon as command execution finished.
+    // All other commands are executed by command loop, after all pipelined commands execution finished.
+    struct PipelinedCommand
+    {
+        std::string token;
+        std::string command;
+        std::vector<std::string> args;
+    };
+
+    enum CommandsLaneType
+    {
+        ReadOnlyLane,
+        EvaluationLane,
+        CommandsLaneTypeCount
+    };
+
+    struct CommandsLane
+    {
+        std::list<PipelinedCommand> queue;
+        unsigned pending = 0; // queued and executing commands
+        std::condition_variable cv;
+        std::vector<std::thread> threads;
+    };
+
+    static const unsigned ReadOnlyLaneThreads = 2;
+
+    bool m_strictOrder;
+    std::mutex m_lanesMutex;
+    std::condition_variable m_lanesIdleCV;
+    CommandsLane m_lanes[CommandsLaneTypeCount];
+    // Read-only lane commands hold reader, evaluation lane commands hold writer.
+    Utility::RWLock m_lanesEvalRWLock;
+    bool m_lanesExit = false;
+
+    static CommandsLaneType GetCommandLane(const std::string &command);
+    void ExecuteCommand(const std::string &token, const std::string &command, const std::vector<std::string> &args);
+    void LaneWorker(CommandsLane &lane);
+    void StartLanes();
+    void StopLanes();
+    void WaitLanesIdle();
 
     std::string m_fileExec;
     std::vector<std::string> m_execArgs;
@@ -83,6 +144,15 @@ private:
     VariablesHandle m_variablesHandle;
     BreakpointsHandle m_breakpointsHandle;
 
+    // Write buffered output, caller must hold m_outMutex.
+    void FlushLocked();
+    // Write buffered output in case no command in progress or buffer is too big, caller must hold m_outMutex.
+    void FlushIfIdle();
+    void Flush();
+    void BeginCommand();
+    void EndCommand();
+    void WriteResultRecord(const std::string &token, HRESULT Status, const std::string &output);
+
 #ifdef _MSC_VER
     void Printf(_Printf_format_string_ const char *fmt, ...);
 #else
@@ -0,0 +1,90 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "protocols/miwriter.h"
+
+namespace netcoredbg
+{
+
+void MIWriter::EscapeString(string_view value, std::string &output)
+{
+    output.push_back('"');
+
+    // Note, most of strings don't need escaping, append unescaped parts by blocks.
+    const char *start = value.data();
+    const char *end = start + value.size();
+    for (const char *p = start; p != end; ++p)
+    {
+        const char *subst;
+        switch (*p)
+        {
+        case '"':  subst = "\\\""; break;
+        case '\\': subst = "\\\\"; break;
+        case '\0': subst = "\\0"; break;
+        case '\a': subst = "\\a"; break;
+        case '\b': subst = "\\b"; break;
+        case '\f': subst = "\\f"; break;
+        case '\n': subst = "\\n"; break;
+        case '\r': subst = "\\r"; break;
+        case '\t': subst = "\\t"; break;
+        case '\v': subst = "\\v"; break;
+        default:
+            continue;
+        }
+
+        output.append(start, p);
+        output.append(subst, 2);
+        start = p + 1;
+    }
+    output.append(start, end);
+
+    output.push_back('"');
+}
+
+MIWriter &MIWriter::Key(string_view name)
+{
+    Separator();
+    m_output.append(name.data(), name.size());
+    m_output.push_back('=');
+    m_needComma = false;
+    return *this;
+}
+
+MIWriter &MIWriter::String(string_view value)
+{
+    Separator();
+    EscapeString(value, m_output);
+    m_needComma = true;
+    return *this;
+}
+
+MIWriter &MIWriter::Int(int64_t value)
+{
+    Separator();
+    m_output.push_back('"');
+    m_output.append(std::to_string(value));
+    m_output.push_back('"');
+    m_needComma = true;
+    return *this;
+}
+
+MIWriter &MIWriter::UInt(uint64_t value)
+{
+    Separator();
+    m_output.push_back('"');
+    m_output.append(std::to_string(value));
+    m_output.push_back('"');
+    m_needComma = true;
+    return *this;
+}
+
+MIWriter &MIWriter::Raw(string_view value)
+{
+    Separator();
+    m_output.append(value.data(), value.size());
+    m_needComma = true;
+    return *this;
+}
+
+} // namespace netcoredbg
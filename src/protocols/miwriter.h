@@ -0,0 +1,55 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "utils/string_view.h"
+
+namespace netcoredbg
+{
+
+// Streaming GDB/MI output builder, write results, tuples and lists directly into output string
+// without temporary strings and streams (aimed to large responses, like var-list-children or stack-list-frames).
+// Note, all values are MI c-strings (numbers are quoted too), writer care about separators only,
+// caller must provide correct results sequence.
+class MIWriter
+{
+public:
+
+    using string_view = Utility::string_view;
+
+    MIWriter(std::string &output) : m_output(output), m_needComma(false) {}
+
+    MIWriter &BeginTuple() { Separator(); m_output.push_back('{'); m_needComma = false; return *this; }
+    MIWriter &EndTuple() { m_output.push_back('}'); m_needComma = true; return *this; }
+    MIWriter &BeginList() { Separator(); m_output.push_back('['); m_needComma = false; return *this; }
+    MIWriter &EndList() { m_output.push_back(']'); m_needComma = true; return *this; }
+
+    // Variable name of result, must be followed by value, tuple or list.
+    MIWriter &Key(string_view name);
+
+    MIWriter &String(string_view value);
+    MIWriter &Int(int64_t value);
+    MIWriter &UInt(uint64_t value);
+    // Already formatted MI value (or results sequence).
+    MIWriter &Raw(string_view value);
+
+    // Note, same escaping as MIProtocol::EscapeMIValue have.
+    static void EscapeString(string_view value, std::string &output);
+
+private:
+
+    std::string &m_output;
+    bool m_needComma;
+
+    void Separator()
+    {
+        if (m_needComma)
+            m_output.push_back(',');
+    }
+};
+
+} // namespace netcoredbg
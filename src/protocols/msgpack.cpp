@@ -0,0 +1,310 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "protocols/msgpack.h"
+
+#include <cstring>
+
+namespace netcoredbg
+{
+
+// Write code and big-endian value with provided size in bytes.
+void MsgPackWriter::Header(uint8_t code, uint64_t value, size_t bytes)
+{
+    m_output.push_back(static_cast<char>(code));
+    for (size_t i = bytes; i > 0; i--)
+    {
+        m_output.push_back(static_cast<char>((value >> ((i - 1) * 8)) & 0xff));
+    }
+}
+
+void MsgPackWriter::Container(size_t count, uint8_t fixCode, uint8_t code16, uint8_t code32)
+{
+    if (count < 16)
+        m_output.push_back(static_cast<char>(fixCode | count));
+    else if (count <= UINT16_MAX)
+        Header(code16, count, 2);
+    else
+        Header(code32, count, 4);
+}
+
+MsgPackWriter &MsgPackWriter::Map(size_t count)
+{
+    Container(count, 0x80, 0xde, 0xdf);
+    return *this;
+}
+
+MsgPackWriter &MsgPackWriter::Array(size_t count)
+{
+    Container(count, 0x90, 0xdc, 0xdd);
+    return *this;
+}
+
+MsgPackWriter &MsgPackWriter::Int(int64_t value)
+{
+    if (value >= 0)
+        return UInt(uint64_t(value));
+
+    if (value >= -32)
+        m_output.push_back(static_cast<char>(value)); // negative fixint
+    else if (value >= INT8_MIN)
+        Header(0xd0, uint64_t(value), 1);
+    else if (value >= INT16_MIN)
+        Header(0xd1, uint64_t(value), 2);
+    else if (value >= INT32_MIN)
+        Header(0xd2, uint64_t(value), 4);
+    else
+        Header(0xd3, uint64_t(value), 8);
+
+    return *this;
+}
+
+MsgPackWriter &MsgPackWriter::UInt(uint64_t value)
+{
+    if (value < 128)
+        m_output.push_back(static_cast<char>(value)); // positive fixint
+    else if (value <= UINT8_MAX)
+        Header(0xcc, value, 1);
+    else if (value <= UINT16_MAX)
+        Header(0xcd, value, 2);
+    else if (value <= UINT32_MAX)
+        Header(0xce, value, 4);
+    else
+        Header(0xcf, value, 8);
+
+    return *this;
+}
+
+MsgPackWriter &MsgPackWriter::String(string_view value)
+{
+    const size_t size = value.size();
+    if (size < 32)
+        m_output.push_back(static_cast<char>(0xa0 | size));
+    else if (size <= UINT8_MAX)
+        Header(0xd9, size, 1);
+    else if (size <= UINT16_MAX)
+        Header(0xda, size, 2);
+    else
+        Header(0xdb, size, 4);
+
+    m_output.append(value.data(), size);
+    return *this;
+}
+
+namespace // unnamed namespace
+{
+
+// Note, nesting limit protect parser from stack exhaustion on malformed data.
+const unsigned MaxNestingDepth = 64;
+
+// Read big-endian value, caller must check buffer size.
+uint64_t ReadBE(const char *data, size_t bytes)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; i++)
+    {
+        value = (value << 8) | static_cast<unsigned char>(data[i]);
+    }
+    return value;
+}
+
+} // unnamed namespace
+
+size_t MsgPackValue::Parse(const char *data, size_t size, MsgPackValue &value)
+{
+    value = MsgPackValue();
+    return Parse(data, size, value, 0);
+}
+
+size_t MsgPackValue::Parse(const char *data, size_t size, MsgPackValue &value, unsigned depth)
+{
+    if (size == 0 || depth > MaxNestingDepth)
+        return 0;
+
+    const uint8_t code = static_cast<uint8_t>(data[0]);
+    size_t pos = 1;
+
+    // Read length-prefixed field size (or value) with provided size in bytes.
+    auto readSize = [&](size_t bytes, uint64_t &result) -> bool
+    {
+        if (size - pos < bytes)
+            return false;
+        result = ReadBE(data + pos, bytes);
+        pos += bytes;
+        return true;
+    };
+
+    // Note, Int is used for negative values only, so, all non-negative values have same representation.
+    auto setSigned = [&](int64_t signedValue)
+    {
+        value.m_type = signedValue < 0 ? Type::Int : Type::UInt;
+        value.m_uint = uint64_t(signedValue);
+    };
+
+    uint64_t length = 0;
+    enum { Scalar, Str, Bin, Arr, Obj } kind = Scalar;
+
+    if (code <= 0x7f)
+    {
+        value.m_type = Type::UInt;
+        value.m_uint = code;
+    }
+    else if (code <= 0x8f)
+    {
+        kind = Obj;
+        length = code & 0x0f;
+    }
+    else if (code <= 0x9f)
+    {
+        kind = Arr;
+        length = code & 0x0f;
+    }
+    else if (code <= 0xbf)
+    {
+        kind = Str;
+        length = code & 0x1f;
+    }
+    else if (code >= 0xe0)
+    {
+        setSigned(int8_t(code));
+    }
+    else
+    {
+        switch (code)
+        {
+        case 0xc0: value.m_type = Type::Nil; break;
+        case 0xc2: value.m_type = Type::Bool; value.m_uint = 0; break;
+        case 0xc3: value.m_type = Type::Bool; value.m_uint = 1; break;
+        case 0xc4: kind = Bin; if (!readSize(1, length)) return 0; break;
+        case 0xc5: kind = Bin; if (!readSize(2, length)) return 0; break;
+        case 0xc6: kind = Bin; if (!readSize(4, length)) return 0; break;
+        case 0xca:
+        {
+            uint64_t bits;
+            if (!readSize(4, bits))
+                return 0;
+            uint32_t bits32 = uint32_t(bits);
+            float f;
+            memcpy(&f, &bits32, sizeof(f));
+            value.m_type = Type::Double;
+            value.m_double = f;
+            break;
+        }
+        case 0xcb:
+        {
+            uint64_t bits;
+            if (!readSize(8, bits))
+                return 0;
+            value.m_type = Type::Double;
+            memcpy(&value.m_double, &bits, sizeof(value.m_double));
+            break;
+        }
+        case 0xcc: value.m_type = Type::UInt; if (!readSize(1, value.m_uint)) return 0; break;
+        case 0xcd: value.m_type = Type::UInt; if (!readSize(2, value.m_uint)) return 0; break;
+        case 0xce: value.m_type = Type::UInt; if (!readSize(4, value.m_uint)) return 0; break;
+        case 0xcf: value.m_type = Type::UInt; if (!readSize(8, value.m_uint)) return 0; break;
+        case 0xd0: if (!readSize(1, length)) return 0; setSigned(int8_t(length)); break;
+        case 0xd1: if (!readSize(2, length)) return 0; setSigned(int16_t(length)); break;
+        case 0xd2: if (!readSize(4, length)) return 0; setSigned(int32_t(length)); break;
+        case 0xd3: if (!readSize(8, length)) return 0; setSigned(int64_t(length)); break;
+        case 0xd9: kind = Str; if (!readSize(1, length)) return 0; break;
+        case 0xda: kind = Str; if (!readSize(2, length)) return 0; break;
+        case 0xdb: kind = Str; if (!readSize(4, length)) return 0; break;
+        case 0xdc: kind = Arr; if (!readSize(2, length)) return 0; break;
+        case 0xdd: kind = Arr; if (!readSize(4, length)) return 0; break;
+        case 0xde: kind = Obj; if (!readSize(2, length)) return 0; break;
+        case 0xdf: kind = Obj; if (!readSize(4, length)) return 0; break;
+        default:
+            return 0; // 0xc1 (never used) and extension types
+        }
+    }
+
+    switch (kind)
+    {
+    case Scalar:
+        break;
+
+    case Str:
+    case Bin:
+        if (size - pos < length)
+            return 0;
+        value.m_type = kind == Str ? Type::String : Type::Binary;
+        value.m_string.assign(data + pos, size_t(length));
+        pos += size_t(length);
+        break;
+
+    case Arr:
+        value.m_type = Type::Array;
+        // Note, each element takes at least one byte, don't trust count for memory reservation.
+        if (size - pos < length)
+            return 0;
+        value.m_array.resize(size_t(length));
+        for (auto &element : value.m_array)
+        {
+            size_t consumed = Parse(data + pos, size - pos, element, depth + 1);
+            if (consumed == 0)
+                return 0;
+            pos += consumed;
+        }
+        break;
+
+    case Obj:
+        value.m_type = Type::Map;
+        if ((size - pos) / 2 < length)
+            return 0;
+        value.m_map.resize(size_t(length));
+        for (auto &entry : value.m_map)
+        {
+            MsgPackValue key;
+            size_t consumed = Parse(data + pos, size - pos, key, depth + 1);
+            if (consumed == 0 || key.m_type != Type::String)
+                return 0;
+            pos += consumed;
+            entry.first = std::move(key.m_string);
+
+            consumed = Parse(data + pos, size - pos, entry.second, depth + 1);
+            if (consumed == 0)
+                return 0;
+            pos += consumed;
+        }
+        break;
+    }
+
+    return pos;
+}
+
+bool MsgPackValue::GetBool(bool defaultValue) const
+{
+    return m_type == Type::Bool ? m_uint != 0 : defaultValue;
+}
+
+int64_t MsgPackValue::GetInt(int64_t defaultValue) const
+{
+    if (m_type == Type::Int || (m_type == Type::UInt && m_uint <= uint64_t(INT64_MAX)))
+        return int64_t(m_uint);
+
+    return defaultValue;
+}
+
+uint64_t MsgPackValue::GetUInt(uint64_t defaultValue) const
+{
+    return m_type == Type::UInt ? m_uint : defaultValue;
+}
+
+std::string MsgPackValue::GetString(const std::string &defaultValue) const
+{
+    return m_type == Type::String ? m_string : defaultValue;
+}
+
+const MsgPackValue *MsgPackValue::Find(string_view key) const
+{
+    for (const auto &entry : m_map)
+    {
+        if (entry.first.size() == key.size() && memcmp(entry.first.data(), key.data(), key.size()) == 0)
+            return &entry.second;
+    }
+    return nullptr;
+}
+
+} // namespace netcoredbg
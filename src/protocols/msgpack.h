@@ -0,0 +1,103 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "utils/string_view.h"
+
+namespace netcoredbg
+{
+
+// Streaming MessagePack (https://msgpack.org/) serializer, used by compact protocol.
+// Note, MessagePack maps and arrays have elements count in header, caller must provide exact count
+// and correct keys/values sequence.
+class MsgPackWriter
+{
+public:
+
+    using string_view = Utility::string_view;
+
+    MsgPackWriter(std::string &output) : m_output(output) {}
+
+    MsgPackWriter &Map(size_t count);
+    MsgPackWriter &Array(size_t count);
+    MsgPackWriter &Key(string_view key) { return String(key); }
+
+    MsgPackWriter &Nil() { m_output.push_back('\xc0'); return *this; }
+    MsgPackWriter &Bool(bool value) { m_output.push_back(value ? '\xc3' : '\xc2'); return *this; }
+    MsgPackWriter &Int(int64_t value);
+    MsgPackWriter &UInt(uint64_t value);
+    MsgPackWriter &String(string_view value);
+    // Already serialized MessagePack value.
+    MsgPackWriter &Raw(string_view value) { m_output.append(value.data(), value.size()); return *this; }
+
+private:
+
+    std::string &m_output;
+
+    void Header(uint8_t code, uint64_t value, size_t bytes);
+    void Container(size_t count, uint8_t fixCode, uint8_t code16, uint8_t code32);
+};
+
+// MessagePack value, used for requests parsing (requests are small, so, simple DOM is fine here).
+// Note, only string keys are supported for maps, extension types are not supported.
+class MsgPackValue
+{
+public:
+
+    using string_view = Utility::string_view;
+
+    enum class Type
+    {
+        Nil,
+        Bool,
+        Int,    // negative integer
+        UInt,   // non-negative integer
+        Double,
+        String,
+        Binary,
+        Array,
+        Map
+    };
+
+    MsgPackValue() : m_type(Type::Nil), m_uint(0), m_double(0) {}
+
+    // Parse one value from buffer and return consumed bytes count, zero in case of error (malformed or incomplete data).
+    static size_t Parse(const char *data, size_t size, MsgPackValue &value);
+
+    Type GetType() const { return m_type; }
+    bool IsNil() const { return m_type == Type::Nil; }
+    bool IsInteger() const { return m_type == Type::Int || m_type == Type::UInt; }
+    bool IsString() const { return m_type == Type::String; }
+    bool IsArray() const { return m_type == Type::Array; }
+    bool IsMap() const { return m_type == Type::Map; }
+
+    // Getters return default value in case of type mismatch (or value out of range for integers).
+    bool GetBool(bool defaultValue = false) const;
+    int64_t GetInt(int64_t defaultValue = 0) const;
+    uint64_t GetUInt(uint64_t defaultValue = 0) const;
+    std::string GetString(const std::string &defaultValue = std::string()) const;
+
+    const std::vector<MsgPackValue> &GetArray() const { return m_array; }
+    const std::vector<std::pair<std::string, MsgPackValue> > &GetMap() const { return m_map; }
+    // Return nullptr in case value is not map or key not found.
+    const MsgPackValue *Find(string_view key) const;
+
+private:
+
+    static size_t Parse(const char *data, size_t size, MsgPackValue &value, unsigned depth);
+
+    Type m_type;
+    uint64_t m_uint; // Note, Bool, Int and UInt values are stored here.
+    double m_double;
+    std::string m_string; // String and Binary
+    std::vector<MsgPackValue> m_array;
+    std::vector<std::pair<std::string, MsgPackValue> > m_map;
+};
+
+} // namespace netcoredbg
@@ -0,0 +1,176 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "protocols/outputcoalescer.h"
+
+#include <algorithm>
+
+namespace netcoredbg
+{
+
+OutputCoalescer::OutputCoalescer(FlushCallback callback) :
+    m_callback(std::move(callback)),
+    m_exit(false),
+    m_pendingCategory(0),
+    m_suppressed(0),
+    m_suppressedCategory(0),
+    m_suppressedTotal(0),
+    m_atLineStart(true),
+    m_budget(0),
+    m_budgetTime(clock::now())
+{
+    m_worker = std::thread(&OutputCoalescer::Worker, this);
+}
+
+OutputCoalescer::~OutputCoalescer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_exit = true;
+    }
+    m_workerCV.notify_one();
+    m_worker.join();
+
+    Flush();
+}
+
+void OutputCoalescer::SetOptions(const Options &options)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_options = options;
+    m_budget = int64_t(m_options.rateLimit);
+    m_budgetTime = clock::now();
+    m_workerCV.notify_one();
+}
+
+uint64_t OutputCoalescer::GetSuppressedBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_suppressedTotal;
+}
+
+void OutputCoalescer::Add(int category, string_view text)
+{
+    if (text.empty())
+        return;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // Note, only consecutive chunks with same category could be merged, since outputs order must be kept.
+    if (!m_pending.empty() && m_pendingCategory != category)
+        FlushPending();
+
+    auto isOverLimit = [&]() { return !m_pending.empty() && m_pending.size() + text.size() > m_options.maxPendingSize; };
+
+    if (isOverLimit())
+    {
+        m_workerCV.notify_one();
+        m_flushedCV.wait_for(lock, std::chrono::milliseconds(m_options.backpressureMs), [&]() { return m_exit || !isOverLimit(); });
+
+        if (!m_pending.empty() && m_pendingCategory != category)
+            FlushPending();
+    }
+
+    if (isOverLimit())
+    {
+        if (m_suppressed != 0 && m_suppressedCategory != category)
+            FlushPending();
+
+        m_suppressed += text.size();
+        m_suppressedCategory = category;
+        m_suppressedTotal += text.size();
+        return;
+    }
+
+    const bool wasEmpty = m_pending.empty();
+    if (wasEmpty)
+    {
+        m_pendingCategory = category;
+        m_pendingStart = clock::now();
+    }
+    m_pending.append(text.data(), text.size());
+
+    if (wasEmpty || m_pending.size() >= m_options.windowSize)
+        m_workerCV.notify_one();
+}
+
+void OutputCoalescer::Flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FlushPending();
+}
+
+// Caller must care about m_mutex.
+void OutputCoalescer::FlushPending()
+{
+    if (!m_pending.empty())
+    {
+        m_flushBuffer.swap(m_pending);
+        m_callback(m_pendingCategory, m_flushBuffer);
+        m_atLineStart = m_flushBuffer.back() == '\n';
+        if (m_options.rateLimit != 0)
+            m_budget -= int64_t(m_flushBuffer.size());
+        m_flushBuffer.clear();
+    }
+
+    if (m_suppressed != 0)
+    {
+        std::string notice(m_atLineStart ? "" : "\n");
+        notice += "<" + std::to_string(m_suppressed) + " bytes suppressed>\n";
+        m_callback(m_suppressedCategory, notice);
+        m_suppressed = 0;
+        m_atLineStart = true;
+    }
+
+    m_flushedCV.notify_all();
+}
+
+void OutputCoalescer::RefillBudget(clock::time_point now)
+{
+    const int64_t elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(now - m_budgetTime).count();
+    const int64_t refill = int64_t(m_options.rateLimit) * elapsedUs / 1000000;
+    // Note, don't move budget time point in case elapsed time is too small for refill, in order to not lose it.
+    if (refill <= 0)
+        return;
+
+    m_budgetTime = now;
+    // Note, budget is limited by one second of output.
+    m_budget = std::min(m_budget + refill, int64_t(m_options.rateLimit));
+}
+
+void OutputCoalescer::Worker()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (!m_exit)
+    {
+        if (m_pending.empty() && m_suppressed == 0)
+        {
+            m_workerCV.wait(lock);
+            continue;
+        }
+
+        const clock::time_point now = clock::now();
+        const clock::time_point windowEnd = m_pendingStart + std::chrono::milliseconds(m_options.windowMs);
+        if (!m_pending.empty() && m_pending.size() < m_options.windowSize && now < windowEnd)
+        {
+            m_workerCV.wait_until(lock, windowEnd);
+            continue;
+        }
+
+        if (m_options.rateLimit != 0)
+        {
+            RefillBudget(now);
+            if (m_budget < 0)
+            {
+                m_workerCV.wait_for(lock, std::chrono::microseconds(1 + (-m_budget) * 1000000 / int64_t(m_options.rateLimit)));
+                continue;
+            }
+        }
+
+        FlushPending();
+    }
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,85 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "utils/string_view.h"
+
+namespace netcoredbg
+{
+
+// Merge debuggee output chunks into bigger blocks before protocol output, so, heavy debuggee output don't produce
+// a lot of protocol messages. Consecutive chunks with same category are merged during time window or until block
+// size reach size window. In case rate limit is set, blocks output is delayed, producer is blocked for a while
+// (backpressure), in case pending output still exceed limit, output is dropped and notice with dropped bytes count
+// is provided instead.
+class OutputCoalescer
+{
+public:
+
+    using string_view = Utility::string_view;
+    // Note, callback executed with coalescer internal lock held, so, all outputs are serialized in proper order.
+    using FlushCallback = std::function<void(int category, string_view text)>;
+
+    struct Options
+    {
+        unsigned windowMs = 10;                 // maximum time output chunk could be delayed for merge
+        size_t windowSize = 64 * 1024;          // block size, that must be provided without delay
+        size_t rateLimit = 0;                   // maximum output rate in bytes per second, 0 for unlimited
+        size_t maxPendingSize = 4 * 1024 * 1024; // pending output limit, exceeded output is dropped
+        unsigned backpressureMs = 100;          // maximum time producer could be blocked before output drop
+    };
+
+    explicit OutputCoalescer(FlushCallback callback);
+    ~OutputCoalescer();
+
+    void SetOptions(const Options &options);
+    void Add(int category, string_view text);
+    // Output all pending data immediately (ignore rate limit).
+    void Flush();
+    uint64_t GetSuppressedBytes() const;
+
+private:
+
+    OutputCoalescer(const OutputCoalescer&) = delete;
+    OutputCoalescer& operator=(const OutputCoalescer&) = delete;
+
+    using clock = std::chrono::steady_clock;
+
+    // Caller must care about m_mutex.
+    void FlushPending();
+    void RefillBudget(clock::time_point now);
+    void Worker();
+
+    FlushCallback m_callback;
+    Options m_options;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_workerCV;
+    std::condition_variable m_flushedCV;
+    std::thread m_worker;
+    bool m_exit;
+
+    std::string m_pending;
+    std::string m_flushBuffer; // Note, swapped with m_pending on flush, so, both buffers memory is reused.
+    int m_pendingCategory;
+    clock::time_point m_pendingStart;
+
+    uint64_t m_suppressed;          // dropped bytes, that was not reported yet
+    int m_suppressedCategory;
+    uint64_t m_suppressedTotal;
+    bool m_atLineStart;
+
+    int64_t m_budget;               // rate limit budget in bytes, negative in case of debt
+    clock::time_point m_budgetTime;
+};
+
+} // namespace netcoredbg
@@ -21,6 +21,7 @@ void BreakpointsHandle::Cleanup()
     m_lineBreakpoints.clear();
     m_funcBreakpoints.clear();
     m_exceptionBreakpoints.clear();
+    m_dataBreakpoints.clear();
 }
 
 HRESULT BreakpointsHandle::UpdateLineBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger, int id, int linenum, Breakpoint &breakpoint)
@@ -51,7 +52,7 @@ HRESULT BreakpointsHandle::UpdateLineBreakpoint(std::shared_ptr<IDebugger> &shar
 
 HRESULT BreakpointsHandle::SetLineBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger,
                                              const std::string &module, const std::string &filename, int linenum,
-                                             const std::string &condition, Breakpoint &breakpoint)
+                                             const std::string &condition, Breakpoint &breakpoint, bool trace, unsigned traceArgs)
 {
     HRESULT Status;
 
@@ -62,6 +63,8 @@ HRESULT BreakpointsHandle::SetLineBreakpoint(std::shared_ptr<IDebugger> &sharedD
         lineBreakpoints.push_back(it.second);
 
     lineBreakpoints.emplace_back(module, linenum, condition);
+    lineBreakpoints.back().trace = trace;
+    lineBreakpoints.back().traceArgs = traceArgs;
 
     std::vector<Breakpoint> breakpoints;
     IfFailRet(sharedDebugger->SetLineBreakpoints(filename, lineBreakpoints, breakpoints));
@@ -74,7 +77,7 @@ HRESULT BreakpointsHandle::SetLineBreakpoint(std::shared_ptr<IDebugger> &sharedD
 
 HRESULT BreakpointsHandle::SetFuncBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger,
                                              const std::string &module, const std::string &funcname, const std::string &params,
-                                             const std::string &condition, Breakpoint &breakpoint)
+                                             const std::string &condition, Breakpoint &breakpoint, bool trace, unsigned traceArgs)
 {
     HRESULT Status;
 
@@ -84,6 +87,8 @@ HRESULT BreakpointsHandle::SetFuncBreakpoint(std::shared_ptr<IDebugger> &sharedD
         funcBreakpoints.push_back(it.second);
 
     funcBreakpoints.emplace_back(module, funcname, params, condition);
+    funcBreakpoints.back().trace = trace;
+    funcBreakpoints.back().traceArgs = traceArgs;
 
     std::vector<Breakpoint> breakpoints;
     IfFailRet(sharedDebugger->SetFuncBreakpoints(funcBreakpoints, breakpoints));
@@ -94,6 +99,27 @@ HRESULT BreakpointsHandle::SetFuncBreakpoint(std::shared_ptr<IDebugger> &sharedD
     return S_OK;
 }
 
+HRESULT BreakpointsHandle::SetDataBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger, std::uintptr_t address, uint32_t size,
+                                             DataBreakpointAccess access, Breakpoint &breakpoint)
+{
+    HRESULT Status;
+
+    std::vector<DataBreakpoint> dataBreakpoints;
+    dataBreakpoints.reserve(m_dataBreakpoints.size() + 1); // size + new element
+    for (const auto &it : m_dataBreakpoints)
+        dataBreakpoints.push_back(it.second);
+
+    dataBreakpoints.emplace_back(address, size, access);
+
+    std::vector<Breakpoint> breakpoints;
+    IfFailRet(sharedDebugger->SetDataBreakpoints(dataBreakpoints, breakpoints));
+
+    // Note, SetDataBreakpoints() will return new breakpoint in "breakpoints" with same index as we have it in "dataBreakpoints".
+    breakpoint = breakpoints.back();
+    m_dataBreakpoints.insert(std::make_pair(breakpoint.id, dataBreakpoints.back()));
+    return S_OK;
+}
+
 // Note, exceptionBreakpoints data will be invalidated by this call.
 HRESULT BreakpointsHandle::SetExceptionBreakpoints(std::shared_ptr<IDebugger> &sharedDebugger,
                                                    /* [in] */ std::vector<ExceptionBreakpoint> &exceptionBreakpoints,
@@ -213,6 +239,28 @@ void BreakpointsHandle::DeleteFuncBreakpoints(std::shared_ptr<IDebugger> &shared
     sharedDebugger->SetFuncBreakpoints(remainingFuncBreakpoints, tmpBreakpoints);
 }
 
+void BreakpointsHandle::DeleteDataBreakpoints(std::shared_ptr<IDebugger> &sharedDebugger, const std::unordered_set<uint32_t> &ids)
+{
+    std::size_t initialSize = m_dataBreakpoints.size();
+    std::vector<DataBreakpoint> remainingDataBreakpoints;
+    for (auto it = m_dataBreakpoints.begin(); it != m_dataBreakpoints.end();)
+    {
+        if (ids.find(it->first) == ids.end())
+        {
+            remainingDataBreakpoints.push_back(it->second);
+            ++it;
+        }
+        else
+            it = m_dataBreakpoints.erase(it);
+    }
+
+    if (initialSize == m_dataBreakpoints.size())
+        return;
+
+    std::vector<Breakpoint> tmpBreakpoints;
+    sharedDebugger->SetDataBreakpoints(remainingDataBreakpoints, tmpBreakpoints);
+}
+
 void BreakpointsHandle::DeleteExceptionBreakpoints(std::shared_ptr<IDebugger> &sharedDebugger, const std::unordered_set<uint32_t> &ids)
 {
     std::size_t initialSize = m_exceptionBreakpoints.size();
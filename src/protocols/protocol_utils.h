@@ -40,20 +40,25 @@ private:
     std::unordered_map<std::string, std::unordered_map<uint32_t, LineBreakpoint> > m_lineBreakpoints;
     std::unordered_map<uint32_t, FuncBreakpoint> m_funcBreakpoints;
     std::unordered_map<uint32_t, ExceptionBreakpoint> m_exceptionBreakpoints;
+    std::unordered_map<uint32_t, DataBreakpoint> m_dataBreakpoints;
 
 public:
     HRESULT UpdateLineBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger, int id, int linenum, Breakpoint &breakpoint);
+    // Note, in case `trace` is true, trace point will be created (see LineBreakpoint::trace).
     HRESULT SetLineBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger, const std::string &module, const std::string &filename,
-                              int linenum, const std::string &condition, Breakpoint &breakpoints);
+                              int linenum, const std::string &condition, Breakpoint &breakpoints, bool trace = false, unsigned traceArgs = 0);
     HRESULT SetFuncBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger, const std::string &module, const std::string &funcname,
-                              const std::string &params, const std::string &condition, Breakpoint &breakpoint);
+                              const std::string &params, const std::string &condition, Breakpoint &breakpoint, bool trace = false, unsigned traceArgs = 0);
     HRESULT SetExceptionBreakpoints(std::shared_ptr<IDebugger> &sharedDebugger, std::vector<ExceptionBreakpoint> &excBreakpoints,
                                     std::vector<Breakpoint> &breakpoints);
+    HRESULT SetDataBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger, std::uintptr_t address, uint32_t size,
+                              DataBreakpointAccess access, Breakpoint &breakpoint);
     HRESULT SetLineBreakpointCondition(std::shared_ptr<IDebugger> &sharedDebugger, uint32_t id, const std::string &condition);
     HRESULT SetFuncBreakpointCondition(std::shared_ptr<IDebugger> &sharedDebugger, uint32_t id, const std::string &condition);
     void DeleteLineBreakpoints(std::shared_ptr<IDebugger> &sharedDebugger, const std::unordered_set<uint32_t> &ids);
     void DeleteFuncBreakpoints(std::shared_ptr<IDebugger> &sharedDebugger, const std::unordered_set<uint32_t> &ids);
     void DeleteExceptionBreakpoints(std::shared_ptr<IDebugger> &sharedDebugger, const std::unordered_set<uint32_t> &ids);
+    void DeleteDataBreakpoints(std::shared_ptr<IDebugger> &sharedDebugger, const std::unordered_set<uint32_t> &ids);
     void Cleanup();
 };
 
@@ -1,101 +1,214 @@
 #include "sourcestorage.h"
 #include "utils/torelease.h"
 
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#include "utils/utf.h"
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 namespace netcoredbg
 {
 
     SourceStorage::~SourceStorage()
     {
         // Free memory and clear list elements
-        while(!files.empty())
+        for (auto &sf : m_files)
+        {
+            freeFile(sf);
+        }
+        m_files.clear();
+        m_filesIndex.clear();
+    }
+
+    bool SourceStorage::getLine(const std::string& file, int linenum, string_view& line, const char **errMessage)
+    {
+        auto find = m_filesIndex.find(file);
+        if (find == m_filesIndex.end())
+        {
+            // file is not in the storage -- try to load it from disk or pdb
+            if (loadFile(file, errMessage) != S_OK)
+                return false;
+        }
+        else if (find->second != m_files.begin())
         {
-            files.back()->lines.clear();
-            m_dbg->FreeUnmanaged(files.back()->text);
-            delete files.back();
-            files.pop_back();
+            // Note, splice don't invalidate iterators stored in index.
+            m_files.splice(m_files.begin(), m_files, find->second);
         }
+
+        SourceFile &sf = m_files.front();
+        if (linenum < 1 || !indexLine(sf, (size_t)linenum))
+            return false;
+
+        const char* start = sf.text + sf.lineStarts[linenum - 1];
+        const char* end = start;
+        while (end < sf.text + sf.size && *end != '\r' && *end != '\n' && *end != '\0')
+            end++;
+
+        line = string_view(start, end - start);
+        return true;
     }
 
-    char* SourceStorage::getLine(std::string& file, int linenum, const char **errMessage)
+    // Index lines up to `linenum` (counted from 1), return `false` in case file have less lines.
+    bool SourceStorage::indexLine(SourceFile &sf, size_t linenum)
     {
-        if(files.empty() || files.front()->filePath != file)
+        const char* end = sf.text + sf.size;
+        while (sf.lineStarts.size() < linenum)
         {
-            auto files_it = files.begin();
-            bool notFound = true;
-            for ( ; files_it != files.end(); files_it++)
+            if (sf.indexedPos >= sf.size)
+                return false;
+
+            sf.lineStarts.push_back(sf.indexedPos);
+
+            const char* bufptr = sf.text + sf.indexedPos;
+            while (bufptr < end && *bufptr != '\r' && *bufptr != '\n' && *bufptr != '\0')
+                bufptr++;
+            if (bufptr < end)
             {
-                if((*files_it)->filePath == file)
+                if (*bufptr == '\0')
+                    bufptr++;
+                else
                 {
-                    files.push_front(*files_it);
-                    files.erase(files_it);
-                    notFound = false;
-                    break;
+                    if (*bufptr == '\r')
+                        bufptr++;
+                    if (bufptr < end && *bufptr == '\n')
+                        bufptr++;
                 }
             }
-
-            if (notFound)
-            {
-                // file is not in the list -- try to load it from pdb
-                if (loadFile(file, errMessage) != S_OK)
-                    return NULL;
-            }
+            sf.indexedPos = bufptr - sf.text;
         }
-        
-        if ((int)files.front()->lines.size() > linenum)
-            return files.front()->lines[linenum];
-        else
-            return NULL;
+        return true;
     }
 
-    HRESULT SourceStorage::loadFile(std::string& file, const char **errMessage)
+    bool SourceStorage::mapFile(const std::string& file, SourceFile &sf)
     {
-        char* fileBuff = NULL;
-        int fileLen = 0;
-        HRESULT Status = S_OK;
+#ifdef _WIN32
+        HANDLE fileHandle = CreateFileW(to_utf16(file).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0 || (ULONGLONG)fileSize.QuadPart > (SIZE_T)-1)
+        {
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(fileHandle);
+        if (mappingHandle == nullptr)
+            return false;
 
-        if (FAILED(Status = m_dbg->GetSourceFile(file, &fileBuff, &fileLen)))
+        // Note, mapped view keep mapping object alive, handle could be closed right now.
+        void* addr = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mappingHandle);
+        if (addr == nullptr)
+            return false;
+
+        sf.size = (size_t)fileSize.QuadPart;
+#else
+        int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1)
+            return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0)
         {
-            *errMessage = "Debug information (PDB file) cannot be opened. Check that PDB file exists and is correct.";
-            return Status;
+            close(fd);
+            return false;
         }
-        if (fileLen == 0)
+
+        // Note, mapping is not affected by file descriptor close.
+        void* addr = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED)
+            return false;
+
+        sf.size = (size_t)st.st_size;
+#endif
+        sf.text = static_cast<const char*>(addr);
+        sf.mapped = true;
+        return true;
+    }
+
+    void SourceStorage::freeFile(SourceFile &sf)
+    {
+        if (sf.text == nullptr)
+            return;
+
+        if (sf.mapped)
         {
-            *errMessage = "Debug information (PDB file) doesn't contain source code. Make sure csproj file has <EmbedAllSources>true</EmbedAllSources> line.";
-            return E_FAIL;
+#ifdef _WIN32
+            UnmapViewOfFile(sf.text);
+#else
+            munmap(const_cast<char*>(sf.text), sf.size);
+#endif
         }
+        else
+            sf.embeddedSource.reset();
 
-        SourceFile *sf = new SourceFile();
-        sf->filePath = file;
-        sf->size = fileLen;
-        sf->text = fileBuff;
+        sf.text = nullptr;
+        sf.size = 0;
+    }
+
+    HRESULT SourceStorage::loadFile(const std::string& file, const char **errMessage)
+    {
+        SourceFile sf;
+        sf.filePath = file;
 
-        sf->lines.push_back(NULL); // The lines count begins from 1, the 0th line is empty
-        for(char* bufptr = sf->text; bufptr < sf->text + fileLen; )
+        // Source file on disk is mapped (no copy and lines are indexed on demand), embedded into PDB source is used only in case
+        // there is no file on disk (for example, debugging on other host).
+        if (!mapFile(file, sf))
         {
-            sf->lines.push_back(bufptr);
-            while(*bufptr != '\r' && *bufptr != '\n' && *bufptr != '\0')
-                bufptr++;
-            if (*bufptr == '\0')
+            int fileLen = 0;
+            HRESULT Status = S_OK;
+
+            if (FAILED(Status = m_dbg->GetSourceFile(file, sf.embeddedSource, fileLen)))
             {
-                bufptr++;
-                continue;
+                *errMessage = "Debug information (PDB file) cannot be opened. Check that PDB file exists and is correct.";
+                return Status;
             }
-            if (*bufptr == '\r')
-                *bufptr++ = '\0';
-            if (*bufptr == '\n')
-                *bufptr++ = '\0';
+            if (fileLen == 0)
+            {
+                *errMessage = "Debug information (PDB file) doesn't contain source code. Make sure csproj file has <EmbedAllSources>true</EmbedAllSources> line.";
+                return E_FAIL;
+            }
+
+            sf.text = sf.embeddedSource.get();
+            sf.size = (size_t)fileLen;
         }
 
-        totalLen += fileLen;
-        files.push_front(sf);
+        // Skip UTF-8 BOM.
+        static const char utf8Bom[] = "\xEF\xBB\xBF";
+        if (sf.size >= 3 && memcmp(sf.text, utf8Bom, 3) == 0)
+            sf.indexedPos = 3;
 
-        // Check if the storage exceeds max size and remove the oldest files if it does.
-        // Do not remove the most recent file even if it's size exceeds max size of the storage
-        while (totalLen > STORAGE_MAX_SIZE && files.size() > 1) {
-            m_dbg->FreeUnmanaged(files.back()->text);
-            totalLen -= files.back()->size;
-            files.pop_back();
+        m_totalSize += sf.size;
+        m_files.emplace_front(std::move(sf));
+        m_filesIndex[file] = m_files.begin();
+
+        evictFiles();
+        return S_OK;
+    }
+
+    // Check if the storage exceeds max size and remove the least recently used files if it does.
+    // Do not remove the most recent file even if it's size exceeds max size of the storage.
+    void SourceStorage::evictFiles()
+    {
+        while (m_totalSize > m_maxSize && m_files.size() > 1)
+        {
+            SourceFile &sf = m_files.back();
+            m_totalSize -= sf.size;
+            m_filesIndex.erase(sf.filePath);
+            freeFile(sf);
+            m_files.pop_back();
         }
-        return Status;
     }
-} //namespace netcoredbg
\ No newline at end of file
+} //namespace netcoredbg
@@ -1,41 +1,64 @@
 #include "cor.h"
 #include "interfaces/idebugger.h"
+#include "utils/string_view.h"
 
+#include <cstddef>
 #include <vector>
 #include <string>
 #include <list>
-
-#define STORAGE_MAX_SIZE    1000000
+#include <unordered_map>
+#include <memory>
 
 namespace netcoredbg
 {
 
-class SourceStorage 
+using Utility::string_view;
+
+class SourceStorage
 {
     struct SourceFile
     {
         std::string filePath;
-        std::vector<char*> lines;
-        char* text;
-        int size;
+        const char* text;
+        size_t size;
+        // Note, file could be mapped from disk or shared with debugger's embedded into PDB sources cache.
+        bool mapped;
+        std::shared_ptr<const char> embeddedSource;
+        // Start offsets of already indexed lines, line N (counted from 1) begins at lineStarts[N - 1].
+        // Note, lines are indexed lazily, only up to requested line.
+        std::vector<size_t> lineStarts;
+        size_t indexedPos;
+
+        SourceFile() : text(nullptr), size(0), mapped(false), indexedPos(0) {}
     };
 
-    std::list<SourceFile*> files;
+    // The most recently used file is first.
+    std::list<SourceFile> m_files;
+    std::unordered_map<std::string, std::list<SourceFile>::iterator> m_filesIndex;
     IDebugger* m_dbg;
-    int totalLen;
+    size_t m_totalSize;
+    size_t m_maxSize;
 
 private:
-    HRESULT loadFile(std::string& file, const char **errMessage);
+    HRESULT loadFile(const std::string& file, const char **errMessage);
+    bool mapFile(const std::string& file, SourceFile &sf);
+    void freeFile(SourceFile &sf);
+    void evictFiles();
+    static bool indexLine(SourceFile &sf, size_t linenum);
 
 public:
-    SourceStorage(IDebugger* d) 
-    {
-        m_dbg = d;
-        totalLen = 0;
-    }
+    static const size_t DefaultMaxSize = 1000000;
+
+    SourceStorage(IDebugger* d, size_t maxSize = DefaultMaxSize) :
+        m_dbg(d),
+        m_totalSize(0),
+        m_maxSize(maxSize)
+    {}
     ~SourceStorage();
 
-    char* getLine(std::string& file, int linenum, const char **errMessage);
+    // Find line `linenum` (counted from 1) of file, line don't include end of line symbols.
+    // Return `false` in case file can't be loaded (`errMessage` is set) or file have no such line.
+    bool getLine(const std::string& file, int linenum, string_view& line, const char **errMessage);
 
 }; // class sourcestorage
-} // namespace
\ No newline at end of file
+} // namespace
@@ -13,17 +13,26 @@
 #include <algorithm>
 #include <thread>
 #include <future>
+#include <cerrno>
+#include <cstdlib>
+#include <climits>
 
 // note: order matters, vscodeprotocol.h should be included before winerror.h
 #include "protocols/vscodeprotocol.h"
 #include "winerror.h"
 
 #include "interfaces/idebugger.h"
+#include "metadata/sourcelink_cache.h"
+#include "debugger/stepstats.h"
+#include "utils/base64.h"
 #include "utils/streams.h"
 #include "utils/torelease.h"
 #include "utils/utf.h"
 #include "utils/logger.h"
+#include "utils/perfcounters.h"
+#include "utils/tracerecorder.h"
 #include "protocols/escaped_string.h"
+#include "protocols/jsonwriter.h"
 
 // for convenience
 using json = nlohmann::json;
@@ -43,6 +52,7 @@ namespace
     const std::string LOG_COMMAND("-> (C) ");
     const std::string LOG_RESPONSE("<- (R) ");
     const std::string LOG_EVENT("<- (E) ");
+    const std::string LOG_REQUEST("<- (Q) ");
 
     // Make sure we continue add new commands into queue only after current command execution is finished.
     // Note, configurationDone: prevent deadlock in _dup() call during std::getline() from stdin in main thread.
@@ -50,10 +60,17 @@ namespace
         "configurationDone", "disconnect", "terminate"};
     // Commands, that trigger command queue canceling routine.
     const std::unordered_set<std::string> g_cancelCommandQueueSet{
-        "disconnect", "terminate", "continue", "next", "stepIn", "stepOut"};
+        "disconnect", "terminate", "continue", "next", "stepIn", "stepOut", "runToCursor"};
+    // Commands, that could be executed in parallel, since only read debugger/debuggee state.
+    const std::unordered_set<std::string> g_readOnlyCommandSet{
+        "threads", "stackTrace", "scopes", "disassemble", "readMemory"};
+    // Commands, that must be executed in order with each other (could run implicit func-evals).
+    // Note, func-eval resume debuggee, so, read-only commands wait for evaluation command finish (see LaneWorker()).
+    const std::unordered_set<std::string> g_evaluationCommandSet{
+        "variables", "evaluate", "evaluateBatch", "readString", "exceptionInfo"};
     // Don't cancel commands related to debugger configuration. For example, breakpoint setup could be done in any time (even if process don't attached at all).
     const std::unordered_set<std::string> g_debuggerSetupCommandSet{
-        "initialize", "setExceptionBreakpoints", "configurationDone", "setBreakpoints", "launch", "disconnect", "terminate", "attach", "setFunctionBreakpoints"};
+        "initialize", "setExceptionBreakpoints", "configurationDone", "setBreakpoints", "launch", "disconnect", "terminate", "attach", "setFunctionBreakpoints", "setDataBreakpoints"};
 } // unnamed namespace
 
 void to_json(json &j, const Source &s) {
@@ -74,6 +91,14 @@ void to_json(json &j, const Breakpoint &b) {
     }
 }
 
+// Memory reference of instruction pointer or instruction in "disassemble" request, hex address with "0x" prefix.
+static std::string AddrToMemoryReference(std::uintptr_t addr)
+{
+    std::ostringstream ss;
+    ss << "0x" << std::hex << addr;
+    return ss.str();
+}
+
 void to_json(json &j, const StackFrame &f) {
     j = json{
         {"id",        int(f.id)},
@@ -85,6 +110,8 @@ void to_json(json &j, const StackFrame &f) {
         {"moduleId",  f.moduleId}};
     if (!f.source.IsNull())
         j["source"] = f.source;
+    if (f.addr != 0)
+        j["instructionPointerReference"] = AddrToMemoryReference(f.addr);
 }
 
 void to_json(json &j, const Thread &t) {
@@ -99,13 +126,19 @@ void to_json(json &j, const Scope &s) {
         {"variablesReference", s.variablesReference},
         {"expensive",          false}};
 
-    if (s.variablesReference > 0)
+    if (s.variablesReference > 0 && s.namedVariables != Scope::DeferredCount)
     {
         j["namedVariables"] = s.namedVariables;
         // j["indexedVariables"] = s.indexedVariables;
     }
 }
 
+void to_json(json &j, const StepInTarget &t) {
+    j = json{
+        {"id",    t.id},
+        {"label", t.label}};
+}
+
 void to_json(json &j, const Variable &v) {
     j = json{
         {"name",               v.name},
@@ -119,6 +152,99 @@ void to_json(json &j, const Variable &v) {
         j["namedVariables"] = v.namedVariables;
         // j["indexedVariables"] = v.indexedVariables;
     }
+
+    if (v.presentationHint.lazy)
+        j["presentationHint"]["lazy"] = true;
+    // Note, "changed" is not DAP attribute, clients that don't support it just ignore it.
+    if (v.presentationHint.changed)
+        j["presentationHint"]["attributes"] = json::array({"changed"});
+}
+
+// Streaming serialization for hot paths, must provide same fields as to_json() above.
+
+static void WriteJson(JsonWriter &writer, const Source &s)
+{
+    writer.BeginObject()
+          .Key("name").String(s.name)
+          .Key("path").String(s.path)
+          .EndObject();
+}
+
+static void WriteJson(JsonWriter &writer, const Breakpoint &b)
+{
+    writer.BeginObject()
+          .Key("id").UInt(b.id)
+          .Key("line").Int(b.line)
+          .Key("verified").Bool(b.verified)
+          .Key("message").String(b.message);
+    if (b.verified)
+    {
+        writer.Key("endLine").Int(b.endLine);
+        if (!b.source.IsNull())
+            WriteJson(writer.Key("source"), b.source);
+    }
+    writer.EndObject();
+}
+
+static void WriteJson(JsonWriter &writer, const StackFrame &f)
+{
+    writer.BeginObject()
+          .Key("id").Int(int(f.id))
+          .Key("name").String(f.methodName)
+          .Key("line").Int(f.line)
+          .Key("column").Int(f.column)
+          .Key("endLine").Int(f.endLine)
+          .Key("endColumn").Int(f.endColumn)
+          .Key("moduleId").String(f.moduleId);
+    if (!f.source.IsNull())
+        WriteJson(writer.Key("source"), f.source);
+    if (f.addr != 0)
+        writer.Key("instructionPointerReference").String(AddrToMemoryReference(f.addr));
+    writer.EndObject();
+}
+
+static void WriteJson(JsonWriter &writer, const Thread &t)
+{
+    writer.BeginObject()
+          .Key("id").Int(int(t.id))
+          .Key("name").String(t.name)
+          .EndObject();
+}
+
+static void WriteJson(JsonWriter &writer, const Variable &v)
+{
+    writer.BeginObject()
+          .Key("name").String(v.name)
+          .Key("value").String(v.value)
+          .Key("type").String(v.type)
+          .Key("evaluateName").String(v.evaluateName)
+          .Key("variablesReference").UInt(v.variablesReference);
+
+    if (v.variablesReference > 0)
+        writer.Key("namedVariables").Int(v.namedVariables);
+
+    if (v.presentationHint.lazy || v.presentationHint.changed)
+    {
+        writer.Key("presentationHint").BeginObject();
+        if (v.presentationHint.lazy)
+            writer.Key("lazy").Bool(true);
+        if (v.presentationHint.changed)
+            writer.Key("attributes").BeginArray().String("changed").EndArray();
+        writer.EndObject();
+    }
+
+    writer.EndObject();
+}
+
+template <typename T>
+static void WriteJsonArray(JsonWriter &writer, const std::vector<T> &values)
+{
+    writer.BeginArray();
+    for (const auto &value : values)
+    {
+        WriteJson(writer, value);
+    }
+    writer.EndArray();
 }
 
 static json FormJsonForExceptionDetails(const ExceptionDetails &details)
@@ -145,7 +271,7 @@ static json FormJsonForExceptionDetails(const ExceptionDetails &details)
     return result;
 }
 
-void VSCodeProtocol::EmitContinuedEvent(ThreadId threadId)
+void VSCodeProtocol::EmitContinuedEvent(ThreadId threadId, bool allThreadsContinued)
 {
     LogFuncEntry();
 
@@ -154,13 +280,16 @@ void VSCodeProtocol::EmitContinuedEvent(ThreadId threadId)
     if (threadId)
         body["threadId"] = int(threadId);
 
-    body["allThreadsContinued"] = true;
+    body["allThreadsContinued"] = allThreadsContinued;
+    m_eventCoalescer.Flush();
     EmitEvent("continued", body);
 }
 
 void VSCodeProtocol::EmitStoppedEvent(const StoppedEvent &event)
 {
     LogFuncEntry();
+    m_outputCoalescer.Flush();
+    m_eventCoalescer.Flush();
 
     json body;
 
@@ -181,6 +310,9 @@ void VSCodeProtocol::EmitStoppedEvent(const StoppedEvent &event)
         case StopEntry:
             body["reason"] = "entry";
             break;
+        case StopDataBreakpoint:
+            body["reason"] = "data breakpoint";
+            break;
     }
 
     // Note, `description` not in use at this moment, provide `reason` only.
@@ -203,6 +335,8 @@ void VSCodeProtocol::EmitStoppedEvent(const StoppedEvent &event)
 void VSCodeProtocol::EmitExitedEvent(const ExitedEvent &event)
 {
     LogFuncEntry();
+    m_outputCoalescer.Flush();
+    m_eventCoalescer.Flush();
     json body;
     body["exitCode"] = event.exitCode;
     EmitEvent("exited", body);
@@ -211,6 +345,8 @@ void VSCodeProtocol::EmitExitedEvent(const ExitedEvent &event)
 void VSCodeProtocol::EmitTerminatedEvent()
 {
     LogFuncEntry();
+    m_outputCoalescer.Flush();
+    m_eventCoalescer.Flush();
     EmitEvent("terminated", json::object());
 }
 
@@ -275,7 +411,19 @@ void VSCodeProtocol::EmitModuleEvent(const ModuleEvent &event)
         }
     }
 
-    EmitEvent("module", body);
+    // Note, debuggee startup could load hundreds of modules, events are provided as batches. Only "changed" event
+    // could replace pending event, since client must get "new" and "removed" events.
+    m_eventCoalescer.Add("module", body.dump(), event.reason == ModuleChanged ? "module:" + event.module.id : std::string());
+}
+
+void VSCodeProtocol::EmitLoadedSourceEvent(const Source &source)
+{
+    LogFuncEntry();
+    json body;
+    body["reason"] = "new";
+    body["source"] = source;
+    // Note, module with symbols could provide thousands of sources, events are provided as batches.
+    m_eventCoalescer.Add("loadedSource", body.dump());
 }
 
 
@@ -302,52 +450,22 @@ namespace
         "\\u0010", "\\u0011", "\\u0012", "\\u0013", "\\u0014", "\\u0015", "\\u0016", "\\u0017",
         "\\u0018", "\\u0019", "\\u001a", "\\u001b", "\\u001c", "\\u001d", "\\u001e", "\\u001f"
     };
-
-    // This function serializes "OutputEvent" to specified output stream and used for two
-    // purposes: to compute output size, and to perform the output directly.
-    template <typename T1, typename T2>
-    void serialize_output(std::ostream& stream, uint64_t counter, string_view name, T1& text, T2& source)
-    {
-        stream << "{\"seq\":" << counter 
-            << ", \"event\":\"output\",\"type\":\"event\",\"body\":{\"category\":\"" << name
-            << "\",\"output\":\"" << text << "\"";
-
-        if (source.size() > 0)
-            stream << ",\"source\":\"" << source << "\"";
-
-        stream <<  "}}";
-
-        stream.flush();
-    };
 }
 
 void VSCodeProtocol::EmitOutputEvent(OutputCategory category, string_view output, string_view source)
 {
     LogFuncEntry();
 
-    static const string_view categories[] = {"console", "stdout", "stderr"};
-
-    // determine "category name"
-    assert(category == OutputConsole || category == OutputStdOut || category == OutputStdErr);
-    const string_view& name = categories[category];
-
-    EscapedString<JSON_escape_rules> escaped_text(output);
-    EscapedString<JSON_escape_rules> escaped_source(source);
-
-    std::lock_guard<std::mutex> lock(m_outMutex);
-
-    // compute size of headers without text (text could be huge, no reason parse it for size, that we already know)
-    CountingStream count;
-    serialize_output(count, m_seqCounter, name, "", escaped_source);
-
-    // compute total size of headers + text
-    auto const total_size = count.size() + escaped_text.size();
-
-    // perform output
-    cout << CONTENT_LENGTH << total_size << TWO_CRLF;
-    serialize_output(cout, m_seqCounter, name, escaped_text, escaped_source);
+    // Note, debuggee stdout/stderr could be huge, merge it into bigger blocks. Console output is not merged,
+    // since could have source, but pending output must be provided first in order to keep outputs order.
+    if (source.empty() && (category == OutputStdOut || category == OutputStdErr))
+    {
+        m_outputCoalescer.Add(category, output);
+        return;
+    }
 
-    ++m_seqCounter;
+    m_outputCoalescer.Flush();
+    WriteOutputEvent(category, output, source);
 }
 
 void VSCodeProtocol::EmitBreakpointEvent(const BreakpointEvent &event)
@@ -370,7 +488,9 @@ void VSCodeProtocol::EmitBreakpointEvent(const BreakpointEvent &event)
 
     body["breakpoint"] = event.breakpoint;
 
-    EmitEvent("breakpoint", body);
+    // Note, breakpoint could be changed many times during modules load, client need only latest state.
+    m_eventCoalescer.Add("breakpoint", body.dump(),
+                         event.reason == BreakpointChanged ? "breakpoint:" + std::to_string(event.breakpoint.id) : std::string());
 }
 
 void VSCodeProtocol::EmitInitializedEvent()
@@ -391,16 +511,205 @@ void VSCodeProtocol::EmitExecEvent(PID pid, const std::string& argv0)
     EmitEvent("process", body);
 }
 
+// Note, "evalTimeout" is not MS vsdbg option, but same as MSVS NormalEvalTimeout setting (in milliseconds).
+// "deferPropertiesEvaluation" is not MS vsdbg option too, in case it enabled, properties getters are not evaluated during
+// object expansion, but provided as lazy variables (evaluated at client request).
+// "arrayPreview" is not MS vsdbg option too, in case it enabled, values of primitive type arrays include first elements.
+// "maxParallelEvals" is not MS vsdbg option too, max count of evaluations for different threads, that could be run at once.
+// "variablesEvalBudget" is not MS vsdbg option too, time (in milliseconds) for properties evaluation during one "variables"
+// request, properties that left after budget was used up are provided as lazy variables.
+static void SetEvalSettings(std::shared_ptr<IDebugger> &sharedDebugger, const json &arguments)
+{
+    sharedDebugger->SetEvalTimeout(arguments.value("evalTimeout", 0u));
+    sharedDebugger->SetAdaptiveEvalTimeout(arguments.value("adaptiveEvalTimeout", false));
+    sharedDebugger->SetMaxParallelEvals(arguments.value("maxParallelEvals", 1u));
+    sharedDebugger->SetDeferPropertiesEvaluation(arguments.value("deferPropertiesEvaluation", false));
+    sharedDebugger->SetArrayPreview(arguments.value("arrayPreview", false));
+    sharedDebugger->SetEvalBudget(arguments.value("variablesEvalBudget", 0u));
+}
+
+// Note, MS vsdbg "symbolOptions" is partially supported: symbol servers from "searchPaths" (local directories are ignored),
+// "searchMicrosoftSymbolServer", "searchNuGetOrgSymbolServer" and "cachePath". Command line options are used in case
+// "symbolOptions" not provided.
+static void SetSymbolOptions(std::shared_ptr<IDebugger> &sharedDebugger, const json &arguments)
+{
+    auto symbolOptionsIt = arguments.find("symbolOptions");
+    if (symbolOptionsIt == arguments.end() || !symbolOptionsIt->is_object())
+        return;
+
+    const json &symbolOptions = symbolOptionsIt.value();
+    std::string servers;
+    auto addServer = [&](const std::string &server)
+    {
+        if (server.compare(0, 7, "http://") != 0 && server.compare(0, 8, "https://") != 0)
+            return;
+        if (!servers.empty())
+            servers += ';';
+        servers += server;
+    };
+
+    for (const std::string &path : symbolOptions.value("searchPaths", std::vector<std::string>()))
+        addServer(path);
+    if (symbolOptions.value("searchMicrosoftSymbolServer", false))
+        addServer("https://msdl.microsoft.com/download/symbols");
+    if (symbolOptions.value("searchNuGetOrgSymbolServer", false))
+        addServer("https://symbols.nuget.org/download/symbols");
+
+    sharedDebugger->SetSymbolServers(servers, symbolOptions.value("cachePath", std::string()));
+}
+
+// Note, MS vsdbg "sourceLinkOptions" is partially supported: only "*" (all URLs) "enabled" is used.
+// "sourceLinkPrefetchFrames" is not MS vsdbg option, count of top frames, which sources are prefetched at stop.
+static void SetSourceLinkOptions(std::shared_ptr<IDebugger> &sharedDebugger, const json &arguments)
+{
+    auto sourceLinkOptionsIt = arguments.find("sourceLinkOptions");
+    if (sourceLinkOptionsIt == arguments.end() || !sourceLinkOptionsIt->is_object())
+        return;
+
+    bool enable = false;
+    auto allIt = sourceLinkOptionsIt->find("*");
+    if (allIt != sourceLinkOptionsIt->end() && allIt->is_object())
+        enable = allIt->value("enabled", true);
+
+    sharedDebugger->SetSourceLink(enable, arguments.value("sourceLinkPrefetchFrames", SourceLinkCache::DefaultPrefetchFrames));
+}
+
+// Note, "signals" is not MS vsdbg option, object with signal name as key and "stop", "print" or "pass" as value (interop mode only).
+static void SetSignalOptions(std::shared_ptr<IDebugger> &sharedDebugger, const json &arguments)
+{
+    auto signalsIt = arguments.find("signals");
+    if (signalsIt == arguments.end() || !signalsIt->is_object())
+        return;
+
+    for (auto it = signalsIt->begin(); it != signalsIt->end(); ++it)
+    {
+        if (!it.value().is_string())
+            continue;
+
+        const std::string action = it.value();
+        if (action == "stop")
+            sharedDebugger->SetSignalAction(it.key(), SignalAction::Stop);
+        else if (action == "print")
+            sharedDebugger->SetSignalAction(it.key(), SignalAction::Print);
+        else if (action == "pass")
+            sharedDebugger->SetSignalAction(it.key(), SignalAction::Pass);
+    }
+}
+
+static void FormEvaluateBody(HRESULT Status, const Variable &variable, const std::string &output, json &body)
+{
+    if (FAILED(Status))
+    {
+        if (output.empty())
+        {
+            std::stringstream stream;
+            stream << "error: 0x" << std::hex << Status;
+            body["message"] = stream.str();
+        }
+        else
+            body["message"] = output;
+
+        return;
+    }
+
+    body["result"] = variable.value;
+    body["type"] = variable.type;
+    body["variablesReference"] = variable.variablesReference;
+    if (variable.variablesReference > 0)
+    {
+        body["namedVariables"] = variable.namedVariables;
+        // indexedVariables
+    }
+}
+
+// Data breakpoint `dataId` have "<hex address>,<size>" format or "field:<id>,<size>" format for managed fields
+// (see "dataBreakpointInfo" request).
+static bool ParseDataBreakpointId(const std::string &dataId, std::uintptr_t &address, uint32_t &size, uint32_t &managedFieldId)
+{
+    static const char fieldPrefix[] = "field:";
+    managedFieldId = 0;
+    if (dataId.compare(0, sizeof(fieldPrefix) - 1, fieldPrefix) == 0)
+    {
+        char *end = nullptr;
+        const char *idStr = dataId.c_str() + sizeof(fieldPrefix) - 1;
+        unsigned long id = strtoul(idStr, &end, 10);
+        if (end == idStr || id == 0 || id > 0xFFFFFFFFul || *end != ',')
+            return false;
+        char *sizeStr = end + 1;
+        unsigned long sizeValue = strtoul(sizeStr, &end, 10);
+        if (end == sizeStr || sizeValue == 0 || *end != '\0')
+            return false;
+
+        // Note, field address is resolved by debugger.
+        address = 0;
+        size = (uint32_t)sizeValue;
+        managedFieldId = (uint32_t)id;
+        return true;
+    }
+
+    char *end = nullptr;
+    errno = 0;
+    unsigned long long addr = strtoull(dataId.c_str(), &end, 16);
+    if (errno != 0 || end == dataId.c_str() || addr == 0)
+        return false;
+
+    size = sizeof(std::uintptr_t);
+    if (*end == ',')
+    {
+        char *sizeStr = end + 1;
+        unsigned long sizeValue = strtoul(sizeStr, &end, 10);
+        if (end == sizeStr || sizeValue == 0)
+            return false;
+        size = (uint32_t)sizeValue;
+    }
+
+    if (*end != '\0')
+        return false;
+
+    address = (std::uintptr_t)addr;
+    return true;
+}
+
+static bool ParseMemoryReference(const std::string &memoryReference, std::uintptr_t &address)
+{
+    char *end = nullptr;
+    errno = 0;
+    unsigned long long addr = strtoull(memoryReference.c_str(), &end, 16);
+    if (errno != 0 || end == memoryReference.c_str() || *end != '\0')
+        return false;
+
+    address = (std::uintptr_t)addr;
+    return true;
+}
+
+static IDebugger::StepType GetStepType(const json &arguments, IDebugger::StepType lineStep, IDebugger::StepType instructionStep)
+{
+    // Note, "statement" granularity is same as "line", since sequence points are statements.
+    return arguments.value("granularity", std::string()) == "instruction" ? instructionStep : lineStep;
+}
+
 static void AddCapabilitiesTo(json &capabilities)
 {
     capabilities["supportsConfigurationDoneRequest"] = true;
     capabilities["supportsFunctionBreakpoints"] = true;
+    capabilities["supportsDataBreakpoints"] = true;
     capabilities["supportsConditionalBreakpoints"] = true;
+    capabilities["supportsHitConditionalBreakpoints"] = true;
+    capabilities["supportsLogPoints"] = true;
     capabilities["supportTerminateDebuggee"] = true;
     capabilities["supportsSetVariable"] = true;
     capabilities["supportsSetExpression"] = true;
+    capabilities["supportsEvaluateBatchRequest"] = true; // not part of DAP, see "evaluateBatch" request
+    capabilities["supportsReadStringRequest"] = true; // not part of DAP, see "readString" request
     capabilities["supportsTerminateRequest"] = true;
     capabilities["supportsCancelRequest"] = true;
+    capabilities["supportsStepInTargetsRequest"] = true;
+    capabilities["supportsRunToCursorRequest"] = true; // not part of DAP, see "runToCursor" request
+    capabilities["supportsDisassembleRequest"] = true;
+    capabilities["supportsLoadedSourcesRequest"] = true;
+    capabilities["supportsReadMemoryRequest"] = true;
+    capabilities["supportsWriteMemoryRequest"] = true;
+    capabilities["supportsSteppingGranularity"] = true;
 
     capabilities["supportsExceptionInfoRequest"] = true;
     capabilities["supportsExceptionFilterOptions"] = true;
@@ -434,24 +743,93 @@ void VSCodeProtocol::Cleanup()
 
 }
 
+// Note, messages content only, without headers.
+static PerfCounters::Counter protocolBytesInCounter("protocolBytesIn");
+static PerfCounters::Counter protocolBytesOutCounter("protocolBytesOut");
+static PerfCounters::Gauge commandsQueueDepthGauge("commandsQueueDepth");
+
+void VSCodeProtocol::WriteOutputEvent(OutputCategory category, string_view output, string_view source)
+{
+    static const string_view categories[] = {"console", "stdout", "stderr"};
+
+    // determine "category name"
+    assert(category == OutputConsole || category == OutputStdOut || category == OutputStdErr);
+    const string_view& name = categories[category];
+
+    std::lock_guard<std::mutex> lock(m_outMutex);
+
+    // Note, message is serialized into reused buffer, text escaped in single pass by temporary EscapedString object
+    // (transformation result is not stored, no memory allocation for text copy).
+    m_outputMessage.clear();
+    m_outputMessage.append("{\"seq\":").append(std::to_string(m_seqCounter))
+                   .append(", \"event\":\"output\",\"type\":\"event\",\"body\":{\"category\":\"")
+                   .append(name.data(), name.size())
+                   .append("\",\"output\":\"");
+    EscapedString<JSON_escape_rules>{output}([&](string_view str) { m_outputMessage.append(str.data(), str.size()); });
+    m_outputMessage.push_back('"');
+
+    if (source.size() > 0)
+    {
+        m_outputMessage.append(",\"source\":\"");
+        EscapedString<JSON_escape_rules>{source}([&](string_view str) { m_outputMessage.append(str.data(), str.size()); });
+        m_outputMessage.push_back('"');
+    }
+
+    m_outputMessage.append("}}");
+    ++m_seqCounter;
+
+    protocolBytesOutCounter.Add(m_outputMessage.size());
+    cout << CONTENT_LENGTH << m_outputMessage.size() << TWO_CRLF;
+    cout.write(m_outputMessage.data(), m_outputMessage.size());
+    cout.flush();
+}
+
 // Caller must care about m_outMutex.
-void VSCodeProtocol::EmitMessage(nlohmann::json &message, std::string &output)
+void VSCodeProtocol::EmitMessage(nlohmann::json &message, std::string &output, const std::string &rawBody, bool flush)
 {
     message["seq"] = std::to_string(m_seqCounter);
     ++m_seqCounter;
     output = message.dump();
+    if (!rawBody.empty())
+    {
+        // Add already serialized body as last field of message object.
+        static const std::string bodyKey(",\"body\":");
+        output.reserve(output.size() + bodyKey.size() + rawBody.size());
+        output.pop_back();
+        output.append(bodyKey);
+        output.append(rawBody);
+        output.push_back('}');
+    }
+    protocolBytesOutCounter.Add(output.size());
     cout << CONTENT_LENGTH << output.size() << TWO_CRLF << output;
-    cout.flush();
+    if (flush)
+        cout.flush();
 }
 
-void VSCodeProtocol::EmitMessageWithLog(const std::string &message_prefix, nlohmann::json &message)
+void VSCodeProtocol::EmitMessageWithLog(const std::string &message_prefix, nlohmann::json &message, const std::string &rawBody)
 {
     std::lock_guard<std::mutex> lock(m_outMutex);
     std::string output;
-    EmitMessage(message, output);
+    EmitMessage(message, output, rawBody);
     Log(message_prefix, output);
 }
 
+// Note, all batch events are written with single stream flush.
+void VSCodeProtocol::WriteEvents(const std::vector<EventCoalescer::Event> &events)
+{
+    std::lock_guard<std::mutex> lock(m_outMutex);
+    std::string output;
+    for (const auto &event : events)
+    {
+        json message;
+        message["type"] = "event";
+        message["event"] = event.name;
+        EmitMessage(message, output, event.body, false);
+        Log(LOG_EVENT, output);
+    }
+    cout.flush();
+}
+
 void VSCodeProtocol::EmitEvent(const std::string &name, const nlohmann::json &body)
 {
     json message;
@@ -461,9 +839,176 @@ void VSCodeProtocol::EmitEvent(const std::string &name, const nlohmann::json &bo
     EmitMessageWithLog(LOG_EVENT, message);
 }
 
+// Commands with large responses, response body serialized directly into string by JsonWriter.
+static HRESULT HandleStreamCommand(std::shared_ptr<IDebugger> &sharedDebugger, const std::string &command, const json &arguments,
+                                   std::string &rawBody, bool &handled)
+{
+    typedef std::function<HRESULT(const json &arguments, JsonWriter &body)> CommandCallback;
+    static std::unordered_map<std::string, CommandCallback> commands {
+    { "threads", [&](const json &arguments, JsonWriter &body){
+        HRESULT Status;
+        std::vector<Thread> threads;
+        IfFailRet(sharedDebugger->GetThreads(threads));
+
+        WriteJsonArray(body.Key("threads"), threads);
+
+        return S_OK;
+    } },
+    { "stackTrace", [&](const json &arguments, JsonWriter &body){
+        HRESULT Status;
+
+        int totalFrames = 0;
+        ThreadId threadId{int(arguments.at("threadId"))};
+
+        std::vector<StackFrame> stackFrames;
+        IfFailRet(sharedDebugger->GetStackTrace(
+            threadId,
+            FrameLevel{arguments.value("startFrame", 0)},
+            unsigned(arguments.value("levels", 0)),
+            stackFrames,
+            totalFrames
+            ));
+
+        WriteJsonArray(body.Key("stackFrames"), stackFrames);
+        body.Key("totalFrames").Int(totalFrames);
+
+        return S_OK;
+    } },
+    // Note, stack frames provide source path only (no "sourceReference"), so, source is requested by path. Aimed to provide
+    // sources missed on disk: embedded into PDB or downloaded by SourceLink.
+    { "source", [&](const json &arguments, JsonWriter &body){
+        HRESULT Status;
+        auto sourceIt = arguments.find("source");
+        if (sourceIt == arguments.end() || !sourceIt->is_object() || sourceIt->find("path") == sourceIt->end())
+            return E_INVALIDARG;
+
+        std::shared_ptr<const char> fileBuf;
+        int fileLen = 0;
+        IfFailRet(sharedDebugger->GetSourceFile(sourceIt->at("path").get<std::string>(), fileBuf, fileLen));
+        if (fileLen == 0)
+            return E_FAIL;
+
+        body.Key("content").String(string_view(fileBuf.get(), fileLen));
+
+        return S_OK;
+    } },
+    // Note, data is encoded directly into response by JsonWriter, so, large buffers are provided without intermediate copies.
+    { "readMemory", [&](const json &arguments, JsonWriter &body){
+        HRESULT Status;
+        std::uintptr_t address;
+        if (!ParseMemoryReference(arguments.at("memoryReference"), address))
+            return E_INVALIDARG;
+        const int64_t offset = arguments.value("offset", int64_t(0));
+
+        std::string data;
+        uint32_t unreadableBytes = 0;
+        IfFailRet(sharedDebugger->ReadMemory(address, offset, arguments.at("count"), data, unreadableBytes));
+
+        body.Key("address").String(AddrToMemoryReference(std::uintptr_t(int64_t(address) + offset)));
+        if (unreadableBytes > 0)
+            body.Key("unreadableBytes").UInt(unreadableBytes);
+        body.Key("data").Base64(data.data(), data.size());
+
+        return S_OK;
+    } },
+    { "variables", [&](const json &arguments, JsonWriter &body){
+        HRESULT Status;
+        std::string filterName = arguments.value("filter", "");
+        VariablesFilter filter = VariablesBoth;
+        if (filterName == "named")
+            filter = VariablesNamed;
+        else if (filterName == "indexed")
+            filter = VariablesIndexed;
+
+        std::vector<Variable> variables;
+        IfFailRet(sharedDebugger->GetVariables(
+            arguments.at("variablesReference"),
+            filter,
+            arguments.value("start", 0),
+            arguments.value("count", 0),
+            variables));
+
+        WriteJsonArray(body.Key("variables"), variables);
+
+        return S_OK;
+    } },
+    { "setBreakpoints", [&](const json &arguments, JsonWriter &body){
+        HRESULT Status;
+
+        std::vector<LineBreakpoint> lineBreakpoints;
+        for (auto &b : arguments.at("breakpoints"))
+        {
+            lineBreakpoints.emplace_back(std::string(), b.at("line"), b.value("condition", std::string()),
+                                         b.value("hitCondition", std::string()), b.value("logMessage", std::string()));
+            lineBreakpoints.back().trace = b.value("trace", false);
+            lineBreakpoints.back().traceArgs = b.value("traceArgs", 0u);
+        }
+
+        std::vector<Breakpoint> breakpoints;
+        IfFailRet(sharedDebugger->SetLineBreakpoints(arguments.at("source").at("path"), lineBreakpoints, breakpoints));
+
+        WriteJsonArray(body.Key("breakpoints"), breakpoints);
+
+        return S_OK;
+    } },
+    // Note, not part of DAP arguments: optional "startIndex" and "count" (all sources by default) for paging, body also
+    // contains "totalSources". Sources are written into response directly from debugger's sources index.
+    { "loadedSources", [&](const json &arguments, JsonWriter &body){
+        const unsigned startIndex = arguments.value("startIndex", 0u);
+        const unsigned count = arguments.value("count", 0u);
+        body.Key("sources").BeginArray();
+        const unsigned totalSources = sharedDebugger->GetLoadedSources(startIndex, count == 0 ? UINT_MAX : count, [&](const char *path)
+        {
+            WriteJson(body, Source(path));
+        });
+        body.EndArray();
+        body.Key("totalSources").UInt(totalSources);
+
+        return S_OK;
+    } },
+    // Arguments: "pattern" and optional "limit" (100 by default). Body contains "sources" with full paths matched by
+    // path components prefix (for example, "Contr" or "src/Contr") first and files names fuzzy matches (for example, "hctrl"
+    // for "HomeController.cs") after.
+    { "ncdbg_searchSources", [&](const json &arguments, JsonWriter &body){
+        const std::string pattern = arguments.at("pattern");
+        body.Key("sources").BeginArray();
+        sharedDebugger->SearchSources(pattern, arguments.value("limit", 100u), [&](const char *path)
+        {
+            WriteJson(body, Source(path));
+        });
+        body.EndArray();
+
+        return S_OK;
+    } }
+    };
+
+    auto command_it = commands.find(command);
+    if (command_it == commands.end())
+    {
+        handled = false;
+        return E_NOTIMPL;
+    }
+
+    handled = true;
+    std::string output;
+    JsonWriter writer(output);
+    writer.BeginObject();
+    HRESULT Status = command_it->second(arguments, writer);
+    writer.EndObject();
+    if (SUCCEEDED(Status))
+        rawBody = std::move(output);
+
+    return Status;
+}
+
 static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::string &fileExec, std::vector<std::string> &execArgs,
-                             const std::string &command, const json &arguments, json &body)
+                             const std::string &command, const json &arguments, json &body, std::string &rawBody)
 {
+    bool handled = false;
+    HRESULT Status = HandleStreamCommand(sharedDebugger, command, arguments, rawBody, handled);
+    if (handled)
+        return Status;
+
     typedef std::function<HRESULT(const json &arguments, json &body)> CommandCallback;
     static std::unordered_map<std::string, CommandCallback> commands {
     { "initialize", [&](const json &arguments, json &body){
@@ -548,20 +1093,6 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         body["details"] = FormJsonForExceptionDetails(exceptionInfo.details);
         return S_OK;
     } },
-    { "setBreakpoints", [&](const json &arguments, json &body){
-        HRESULT Status;
-
-        std::vector<LineBreakpoint> lineBreakpoints;
-        for (auto &b : arguments.at("breakpoints"))
-            lineBreakpoints.emplace_back(std::string(), b.at("line"), b.value("condition", std::string()));
-
-        std::vector<Breakpoint> breakpoints;
-        IfFailRet(sharedDebugger->SetLineBreakpoints(arguments.at("source").at("path"), lineBreakpoints, breakpoints));
-
-        body["breakpoints"] = breakpoints;
-
-        return S_OK;
-    } },
     { "launch", [&](const json &arguments, json &body){
         auto cwdIt = arguments.find("cwd");
         const std::string cwd(cwdIt != arguments.end() ? cwdIt.value().get<std::string>() : std::string{});
@@ -579,6 +1110,15 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
 
         sharedDebugger->SetJustMyCode(arguments.value("justMyCode", true)); // MS vsdbg have "justMyCode" enabled by default.
         sharedDebugger->SetStepFiltering(arguments.value("enableStepFiltering", true)); // MS vsdbg have "enableStepFiltering" enabled by default.
+        // Note, "deferredJMC" is not MS vsdbg option, in case it enabled, JMC statuses for "not user code" attributes are applied at
+        // first step, breakpoint or exception, instead of module load (first exception could be reported with not corrected by attributes type).
+        sharedDebugger->SetDeferredJMC(arguments.value("deferredJMC", false));
+        // Note, "nonStop" is not MS vsdbg option, in case it enabled, stop event suspend event thread only.
+        sharedDebugger->SetNonStop(arguments.value("nonStop", false));
+        SetEvalSettings(sharedDebugger, arguments);
+        SetSymbolOptions(sharedDebugger, arguments);
+        SetSourceLinkOptions(sharedDebugger, arguments);
+        SetSignalOptions(sharedDebugger, arguments);
 
         if (!fileExec.empty())
             return sharedDebugger->Launch(fileExec, execArgs, env, cwd, arguments.value("stopAtEntry", false));
@@ -588,15 +1128,6 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
 
         return sharedDebugger->Launch("dotnet", args, env, cwd, arguments.value("stopAtEntry", false));
     } },
-    { "threads", [&](const json &arguments, json &body){
-        HRESULT Status;
-        std::vector<Thread> threads;
-        IfFailRet(sharedDebugger->GetThreads(threads));
-
-        body["threads"] = threads;
-
-        return S_OK;
-    } },
     { "disconnect", [&](const json &arguments, json &body){
         auto terminateArgIter = arguments.find("terminateDebuggee");
         IDebugger::DisconnectAction action;
@@ -613,28 +1144,8 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         sharedDebugger->Disconnect(IDebugger::DisconnectAction::DisconnectTerminate);
         return S_OK;
     } },
-    { "stackTrace", [&](const json &arguments, json &body){
-        HRESULT Status;
-
-        int totalFrames = 0;
-        ThreadId threadId{int(arguments.at("threadId"))};
-
-        std::vector<StackFrame> stackFrames;
-        IfFailRet(sharedDebugger->GetStackTrace(
-            threadId,
-            FrameLevel{arguments.value("startFrame", 0)},
-            unsigned(arguments.value("levels", 0)),
-            stackFrames,
-            totalFrames
-            ));
-
-        body["stackFrames"] = stackFrames;
-        body["totalFrames"] = totalFrames;
-
-        return S_OK;
-    } },
     { "continue", [&](const json &arguments, json &body){
-        body["allThreadsContinued"] = true;
+        body["allThreadsContinued"] = !sharedDebugger->IsNonStop();
 
         ThreadId threadId{int(arguments.at("threadId"))};
         body["threadId"] = int(threadId);
@@ -646,10 +1157,31 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         return sharedDebugger->Pause(threadId, EventFormat::Default);
     } },
     { "next", [&](const json &arguments, json &body){
-        return sharedDebugger->StepCommand(ThreadId{int(arguments.at("threadId"))}, IDebugger::StepType::STEP_OVER);
+        return sharedDebugger->StepCommand(ThreadId{int(arguments.at("threadId"))},
+            GetStepType(arguments, IDebugger::StepType::STEP_OVER, IDebugger::StepType::STEP_OVER_INSTRUCTION));
     } },
     { "stepIn", [&](const json &arguments, json &body){
-        return sharedDebugger->StepCommand(ThreadId{int(arguments.at("threadId"))}, IDebugger::StepType::STEP_IN);
+        auto targetIdIter = arguments.find("targetId");
+        if (targetIdIter != arguments.end())
+            return sharedDebugger->StepIntoTarget(ThreadId{int(arguments.at("threadId"))}, targetIdIter.value().get<int>());
+
+        return sharedDebugger->StepCommand(ThreadId{int(arguments.at("threadId"))},
+            GetStepType(arguments, IDebugger::StepType::STEP_IN, IDebugger::StepType::STEP_IN_INSTRUCTION));
+    } },
+    { "stepInTargets", [&](const json &arguments, json &body){
+        HRESULT Status;
+        std::vector<StepInTarget> targets;
+        IfFailRet(sharedDebugger->GetStepInTargets(FrameId{int(arguments.at("frameId"))}, targets));
+
+        body["targets"] = targets;
+
+        return S_OK;
+    } },
+    { "runToCursor", [&](const json &arguments, json &body){
+        // Not part of DAP, continue thread till source line reached (or any other stop event) without user breakpoint setup.
+        ThreadId threadId{int(arguments.at("threadId"))};
+        body["threadId"] = int(threadId);
+        return sharedDebugger->RunToLine(threadId, arguments.at("source").at("path"), arguments.at("line"));
     } },
     { "stepOut", [&](const json &arguments, json &body){
         return sharedDebugger->StepCommand(ThreadId{int(arguments.at("threadId"))}, IDebugger::StepType::STEP_OUT);
@@ -664,27 +1196,6 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
 
         return S_OK;
     } },
-    { "variables", [&](const json &arguments, json &body){
-        HRESULT Status;
-        std::string filterName = arguments.value("filter", "");
-        VariablesFilter filter = VariablesBoth;
-        if (filterName == "named")
-            filter = VariablesNamed;
-        else if (filterName == "indexed")
-            filter = VariablesIndexed;
-
-        std::vector<Variable> variables;
-        IfFailRet(sharedDebugger->GetVariables(
-            arguments.at("variablesReference"),
-            filter,
-            arguments.value("start", 0),
-            arguments.value("count", 0),
-            variables));
-
-        body["variables"] = variables;
-
-        return S_OK;
-    } },
     { "evaluate", [&](const json &arguments, json &body){
         HRESULT Status;
         std::string expression = arguments.at("expression");
@@ -706,28 +1217,132 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         Variable variable;
         std::string output;
         Status = sharedDebugger->Evaluate(frameId, expression, variable, output);
-        if (FAILED(Status))
-        {
-            if (output.empty())
+        FormEvaluateBody(Status, variable, output, body);
+        return Status;
+    } },
+    // Not part of DAP, evaluate all watch expressions at once, same as a sequence of "evaluate" requests for the same frame.
+    // Body contains "results" array with "evaluate" response body for each expression (with "success" field).
+    { "evaluateBatch", [&](const json &arguments, json &body){
+        HRESULT Status;
+        std::vector<std::string> expressions = arguments.at("expressions").get<std::vector<std::string> >();
+        FrameId frameId([&](){
+            auto frameIdIter = arguments.find("frameId");
+            if (frameIdIter == arguments.end())
             {
-                std::stringstream stream;
-                stream << "error: 0x" << std::hex << Status;
-                body["message"] = stream.str();
+                ThreadId threadId = sharedDebugger->GetLastStoppedThreadId();
+                return FrameId{threadId, FrameLevel{0}};
             }
-            else
-                body["message"] = output;
+            else {
+                return FrameId{int(frameIdIter.value())};
+            }
+        }());
 
-            return Status;
+        std::vector<Variable> variables(expressions.size());
+        std::vector<HRESULT> statuses;
+        std::vector<std::string> outputs;
+        IfFailRet(sharedDebugger->EvaluateBatch(frameId, expressions, variables, statuses, outputs));
+
+        json results = json::array();
+        for (size_t i = 0; i < expressions.size(); i++)
+        {
+            json result;
+            FormEvaluateBody(statuses[i], variables[i], outputs[i], result);
+            result["success"] = SUCCEEDED(statuses[i]);
+            results.push_back(result);
         }
+        body["results"] = results;
+        return S_OK;
+    } },
+    { "writeMemory", [&](const json &arguments, json &body){
+        HRESULT Status;
+        std::uintptr_t address;
+        if (!ParseMemoryReference(arguments.at("memoryReference"), address))
+            return E_INVALIDARG;
+        const int64_t offset = arguments.value("offset", int64_t(0));
+
+        std::string data;
+        if (!Base64::Decode(arguments.at("data").get<std::string>(), data))
+            return E_INVALIDARG;
 
-        body["result"] = variable.value;
-        body["type"] = variable.type;
-        body["variablesReference"] = variable.variablesReference;
-        if (variable.variablesReference > 0)
+        uint32_t bytesWritten = 0;
+        IfFailRet(sharedDebugger->WriteMemory(address, offset, data, arguments.value("allowPartial", false), bytesWritten));
+
+        body["bytesWritten"] = bytesWritten;
+        return S_OK;
+    } },
+    // Instructions of JIT'ed managed code, "memoryReference" is stack frame's "instructionPointerReference" or "address"
+    // of provided instruction. Instructions out of method's code are provided with "invalid" presentation hint.
+    { "disassemble", [&](const json &arguments, json &body){
+        HRESULT Status;
+        std::uintptr_t address;
+        if (!ParseMemoryReference(arguments.at("memoryReference"), address))
+            return E_INVALIDARG;
+
+        std::vector<DisassembledInstruction> instructions;
+        IfFailRet(sharedDebugger->Disassemble(address, arguments.value("offset", int64_t(0)), arguments.value("instructionOffset", 0),
+                                              arguments.at("instructionCount"), arguments.value("resolveSymbols", false), instructions));
+
+        json result = json::array();
+        std::string prevSourcePath;
+        for (const DisassembledInstruction &instruction : instructions)
         {
-            body["namedVariables"] = variable.namedVariables;
-            // indexedVariables
+            json entry{{"address", AddrToMemoryReference(instruction.address)}};
+            if (!instruction.valid)
+            {
+                entry["instruction"] = "??";
+                entry["presentationHint"] = "invalid";
+                result.push_back(entry);
+                continue;
+            }
+
+            entry["instruction"] = instruction.instruction;
+            entry["instructionBytes"] = instruction.instructionBytes;
+            if (!instruction.symbol.empty())
+                entry["symbol"] = instruction.symbol;
+            if (instruction.line > 0)
+            {
+                entry["line"] = instruction.line;
+                entry["endLine"] = instruction.endLine;
+                // Note, location should be provided only in case it differs from previous instruction location.
+                if (!instruction.source.IsNull() && instruction.source.path != prevSourcePath)
+                {
+                    entry["location"] = instruction.source;
+                    prevSourcePath = instruction.source.path;
+                }
+            }
+            result.push_back(entry);
         }
+        body["instructions"] = result;
+        return S_OK;
+    } },
+    // Not part of DAP, read part of string value of expression, in order to fetch full value of huge string by parts
+    // (variables and evaluate provide truncated string preview). Arguments: "expression", "frameId", "offset" and "count"
+    // in UTF-16 code units. Body contains "value" (not escaped), "read" (code units actually read) and "length" of string.
+    { "readString", [&](const json &arguments, json &body){
+        HRESULT Status;
+        std::string expression = arguments.at("expression");
+        FrameId frameId([&](){
+            auto frameIdIter = arguments.find("frameId");
+            if (frameIdIter == arguments.end())
+            {
+                ThreadId threadId = sharedDebugger->GetLastStoppedThreadId();
+                return FrameId{threadId, FrameLevel{0}};
+            }
+            else {
+                return FrameId{int(frameIdIter.value())};
+            }
+        }());
+        uint32_t offset = arguments.value("offset", 0);
+        uint32_t count = arguments.at("count");
+
+        std::string value;
+        uint32_t read;
+        uint32_t length;
+        IfFailRet(sharedDebugger->ReadString(frameId, expression, defaultEvalFlags, offset, count, value, read, length));
+
+        body["value"] = value;
+        body["read"] = read;
+        body["length"] = length;
         return S_OK;
     } },
     { "setExpression", [&](const json &arguments, json &body){
@@ -769,6 +1384,15 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         return S_OK;
     } },
     { "attach", [&](const json &arguments, json &body){
+        // Note, same "coreDumpPath" argument as vsdbg use for dump analysis in attach configuration.
+        const std::string coreDumpPath = arguments.value("coreDumpPath", std::string());
+        if (!coreDumpPath.empty())
+        {
+            SetSymbolOptions(sharedDebugger, arguments);
+            SetSourceLinkOptions(sharedDebugger, arguments);
+            return sharedDebugger->OpenDump(coreDumpPath);
+        }
+
         int processId;
 
         const json &processIdArg = arguments.at("processId");
@@ -779,6 +1403,11 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         else
             return E_INVALIDARG;
 
+        sharedDebugger->SetNonStop(arguments.value("nonStop", false));
+        SetEvalSettings(sharedDebugger, arguments);
+        SetSymbolOptions(sharedDebugger, arguments);
+        SetSourceLinkOptions(sharedDebugger, arguments);
+        SetSignalOptions(sharedDebugger, arguments);
         return sharedDebugger->Attach(processId);
     } },
     { "setVariable", [&](const json &arguments, json &body) {
@@ -827,7 +1456,9 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
                 name.erase(i, closeBrace);
             }
 
-            funcBreakpoints.emplace_back(module, name, params, b.value("condition", std::string()));
+            funcBreakpoints.emplace_back(module, name, params, b.value("condition", std::string()), b.value("hitCondition", std::string()));
+            funcBreakpoints.back().trace = b.value("trace", false);
+            funcBreakpoints.back().traceArgs = b.value("traceArgs", 0u);
         }
 
         std::vector<Breakpoint> breakpoints;
@@ -836,6 +1467,342 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         body["breakpoints"] = breakpoints;
 
         return Status;
+    } },
+    { "dataBreakpointInfo", [&](const json &arguments, json &body) {
+        // Note, data breakpoints implemented by hardware watchpoints (interop mode), so, we accept memory address
+        // (as `name` with `asAddress` or `name` that is hex address) or instance field of object (`name` with
+        // `variablesReference` of object).
+        std::string name = arguments.value("name", std::string());
+        const bool asAddress = arguments.value("asAddress", false);
+        const uint32_t variablesReference = arguments.value("variablesReference", 0u);
+        if (!asAddress && variablesReference != 0)
+        {
+            DataBreakpoint dataBreakpoint(0, 0, DataBreakpointAccess::Write);
+            std::string description;
+            HRESULT Status;
+            IfFailRet(sharedDebugger->GetFieldDataBreakpointInfo(variablesReference, name, dataBreakpoint, description));
+            body["description"] = description;
+            if (Status != S_OK)
+            {
+                body["dataId"] = nullptr;
+                return S_OK;
+            }
+
+            std::ostringstream ss;
+            ss << "field:" << dataBreakpoint.managedFieldId << "," << dataBreakpoint.size;
+            body["dataId"] = ss.str();
+            body["accessTypes"] = std::vector<std::string>({"write", "read", "readWrite"});
+            body["canPersist"] = false;
+            return S_OK;
+        }
+
+        std::uintptr_t address = 0;
+        uint32_t size = 0;
+        uint32_t managedFieldId = 0;
+        if (!ParseDataBreakpointId(name, address, size, managedFieldId) || managedFieldId != 0)
+        {
+            body["dataId"] = nullptr;
+            body["description"] = "Data breakpoints are supported for native memory addresses only.";
+            return S_OK;
+        }
+
+        if (arguments.find("bytes") != arguments.end())
+            size = arguments.at("bytes").get<uint32_t>();
+
+        std::ostringstream ss;
+        ss << "0x" << std::hex << address << "," << std::dec << size;
+        body["dataId"] = ss.str();
+        body["description"] = ss.str();
+        body["accessTypes"] = std::vector<std::string>({"write", "read", "readWrite"});
+        body["canPersist"] = false;
+
+        return S_OK;
+    } },
+    { "setDataBreakpoints", [&](const json &arguments, json &body) {
+        HRESULT Status = S_OK;
+
+        std::vector<DataBreakpoint> dataBreakpoints;
+        for (auto &b : arguments.at("breakpoints"))
+        {
+            std::uintptr_t address = 0;
+            uint32_t size = 0;
+            uint32_t managedFieldId = 0;
+            if (!ParseDataBreakpointId(b.at("dataId"), address, size, managedFieldId))
+                return E_INVALIDARG;
+
+            std::string accessType = b.value("accessType", std::string("write"));
+            DataBreakpointAccess access = DataBreakpointAccess::Write;
+            if (accessType == "read")
+                access = DataBreakpointAccess::Read;
+            else if (accessType == "readWrite")
+                access = DataBreakpointAccess::ReadWrite;
+
+            dataBreakpoints.emplace_back(address, size, access, managedFieldId);
+        }
+
+        std::vector<Breakpoint> breakpoints;
+        IfFailRet(sharedDebugger->SetDataBreakpoints(dataBreakpoints, breakpoints));
+
+        body["breakpoints"] = breakpoints;
+
+        return Status;
+    } },
+    // Note, custom ncdbg request, provide stepping latency statistic (histogram buckets are power of two microseconds)
+    // and performance counters (in case enabled by command line option).
+    { "ncdbg_perfStats", [&](const json &arguments, json &body) {
+        json phases = json::array();
+        for (size_t i = 0; i < size_t(StepStats::Phase::Count); i++)
+        {
+            TimingHistogram::snapshot_t snapshot;
+            StepStats::GetSnapshot(StepStats::Phase(i), snapshot);
+
+            json buckets = json::array();
+            for (size_t b = 0; b < TimingHistogram::BucketsCount; b++)
+            {
+                buckets.push_back(snapshot.buckets[b]);
+            }
+
+            phases.push_back({{"name", StepStats::GetPhaseName(StepStats::Phase(i))},
+                              {"count", snapshot.count},
+                              {"totalUs", snapshot.totalUs},
+                              {"maxUs", snapshot.maxUs},
+                              {"buckets", buckets}});
+        }
+        body["phases"] = phases;
+        body["countersEnabled"] = PerfCounters::IsEnabled();
+        body["counters"] = json::parse(PerfCounters::DumpJSON());
+
+        if (arguments.value("reset", false))
+        {
+            StepStats::Reset();
+            PerfCounters::Reset();
+        }
+
+        return S_OK;
+    } },
+    // Note, custom ncdbg request, write recorded debugger internal activity timelines into file in Chrome trace JSON format
+    // (in case enabled by command line option), recorded events are removed if requested.
+    { "ncdbg_traceEvents", [&](const json &arguments, json &body) {
+        if (!TraceRecorder::IsEnabled())
+            return E_FAIL;
+
+        std::string path = arguments.value("path", std::string());
+        if (!path.empty() && !TraceRecorder::WriteChromeJSON(path))
+            return E_FAIL;
+
+        if (arguments.value("clear", false))
+            TraceRecorder::Clear();
+
+        return S_OK;
+    } },
+    // Note, custom ncdbg request, provide approximate memory (in bytes) used by symbols related data.
+    { "ncdbg_memoryUsage", [&](const json &arguments, json &body) {
+        MemoryUsage usage;
+        sharedDebugger->GetMemoryUsage(usage);
+
+        body["symbolReaders"] = usage.symbolReaders;
+        body["loadedReaders"] = usage.loadedReaders;
+        body["unloadedReaders"] = usage.unloadedReaders;
+        body["symbolsLimit"] = usage.symbolsLimit;
+        body["modulesSources"] = usage.modulesSources;
+        body["lineUpdates"] = usage.lineUpdates;
+        body["sequencePoints"] = usage.sequencePoints;
+        body["evalCaches"] = usage.evalCaches;
+
+        return S_OK;
+    } },
+    // Note, custom ncdbg request, sampling profiler control: "start" (with "interval" in milliseconds), "stop" and
+    // "export" (with "format" - "folded" or "speedscope", samples are provided as string in body's "samples").
+    { "ncdbg_profile", [&](const json &arguments, json &body) {
+        HRESULT Status;
+        const std::string action = arguments.at("action");
+        if (action == "start")
+            return sharedDebugger->StartSampling(arguments.value("interval", 10u));
+
+        if (action == "stop")
+        {
+            uint64_t samplesCount = 0;
+            IfFailRet(sharedDebugger->StopSampling(samplesCount));
+            body["samplesCount"] = samplesCount;
+            return S_OK;
+        }
+
+        if (action != "export")
+            return E_INVALIDARG;
+
+        const std::string format = arguments.value("format", "folded");
+        if (format != "folded" && format != "speedscope")
+            return E_INVALIDARG;
+
+        std::string samples;
+        IfFailRet(sharedDebugger->ExportSamples(format == "folded" ? SamplesFormat::Folded : SamplesFormat::Speedscope, samples));
+        body["format"] = format;
+        body["samples"] = samples;
+        return S_OK;
+    } },
+    { "ncdbg_exceptionStatistics", [&](const json &arguments, json &body) {
+        HRESULT Status;
+        const std::string action = arguments.at("action");
+        if (action == "start" || action == "stop")
+        {
+            sharedDebugger->SetExceptionStatistics(action == "start");
+            return S_OK;
+        }
+
+        if (action != "get")
+            return E_INVALIDARG;
+
+        std::vector<ExceptionStatistic> statistics;
+        uint64_t droppedCount = 0;
+        IfFailRet(sharedDebugger->GetExceptionStatistics(statistics, droppedCount, arguments.value("reset", false)));
+
+        json exceptions = json::array();
+        for (const ExceptionStatistic &statistic : statistics)
+        {
+            exceptions.push_back(json{{"exceptionType", statistic.exceptionType},
+                                      {"module", statistic.module},
+                                      {"method", statistic.method},
+                                      {"ilOffset", statistic.ilOffset},
+                                      {"count", statistic.count}});
+        }
+        body["exceptions"] = exceptions;
+        body["droppedCount"] = droppedCount;
+        return S_OK;
+    } },
+    { "ncdbg_trace", [&](const json &arguments, json &body) {
+        HRESULT Status;
+        const std::string action = arguments.at("action");
+        if (action == "clear")
+            return sharedDebugger->ClearTraceRecords();
+
+        // Note, "drain" provide streaming of trace points hits, each hit is returned once.
+        if (action != "get" && action != "drain")
+            return E_INVALIDARG;
+
+        std::vector<TraceRecord> records;
+        uint64_t overwrittenCount = 0;
+        IfFailRet(sharedDebugger->GetTraceRecords(records, overwrittenCount, action == "drain"));
+
+        json hits = json::array();
+        for (const TraceRecord &record : records)
+        {
+            hits.push_back(json{{"timestamp", record.timestamp},
+                                {"breakpointId", record.breakpointId},
+                                {"threadId", int(record.threadId)},
+                                {"module", record.module},
+                                {"method", record.method},
+                                {"ilOffset", record.ilOffset},
+                                {"args", record.args}});
+        }
+        body["hits"] = hits;
+        body["overwrittenCount"] = overwrittenCount;
+        return S_OK;
+    } },
+    { "ncdbg_heapStatistics", [&](const json &arguments, json &body) {
+        HRESULT Status;
+        const std::string sort = arguments.value("sort", "size");
+        if (sort != "size" && sort != "count")
+            return E_INVALIDARG;
+        const int top = arguments.value("top", 20);
+        if (top <= 0)
+            return E_INVALIDARG;
+
+        HeapStatistics statistics;
+        IfFailRet(sharedDebugger->GetHeapStatistics(unsigned(top), sort == "count", nullptr, statistics));
+
+        json types = json::array();
+        for (const HeapTypeStatistic &type : statistics.types)
+        {
+            types.push_back(json{{"typeName", type.typeName},
+                                 {"count", type.count},
+                                 {"size", type.size}});
+        }
+        body["types"] = types;
+        body["objectsCount"] = statistics.objectsCount;
+        body["totalSize"] = statistics.totalSize;
+        body["typesCount"] = statistics.typesCount;
+        return S_OK;
+    } },
+    // Arguments: "expression" (for example, "evaluateName" of variable) and "frameId". Body contains "rootKind" and
+    // "objects" from root object to target object, both empty in case object is not reachable.
+    { "ncdbg_gcRootPath", [&](const json &arguments, json &body) {
+        HRESULT Status;
+        std::string expression = arguments.at("expression");
+        FrameId frameId([&](){
+            auto frameIdIter = arguments.find("frameId");
+            if (frameIdIter == arguments.end())
+            {
+                ThreadId threadId = sharedDebugger->GetLastStoppedThreadId();
+                return FrameId{threadId, FrameLevel{0}};
+            }
+            else {
+                return FrameId{int(frameIdIter.value())};
+            }
+        }());
+
+        GCRootPath path;
+        IfFailRet(sharedDebugger->FindGCRootPath(frameId, expression, defaultEvalFlags, path));
+
+        json objects = json::array();
+        for (const GCRootPathObject &object : path.objects)
+        {
+            std::ostringstream address;
+            address << "0x" << std::hex << object.address;
+            objects.push_back(json{{"address", address.str()},
+                                   {"typeName", object.typeName}});
+        }
+        body["rootKind"] = path.rootKind;
+        body["objects"] = objects;
+        return S_OK;
+    } },
+    // Arguments: optional "includeCompleted" (false by default). Body contains "tasksCount" and "groups" sorted by tasks
+    // count, each group with "status", "name", "count", first tasks addresses and async stack of first task.
+    { "ncdbg_tasks", [&](const json &arguments, json &body) {
+        HRESULT Status;
+        std::vector<AsyncTaskGroup> groups;
+        uint64_t tasksCount = 0;
+        IfFailRet(sharedDebugger->GetAsyncTasks(arguments.value("includeCompleted", false), groups, tasksCount));
+
+        json groupsJson = json::array();
+        for (const AsyncTaskGroup &group : groups)
+        {
+            json tasks = json::array();
+            for (uint64_t task : group.tasks)
+            {
+                std::ostringstream address;
+                address << "0x" << std::hex << task;
+                tasks.push_back(address.str());
+            }
+            json asyncStack = json::array();
+            for (const StackFrame &frame : group.asyncStack)
+            {
+                json frameJson{{"name", frame.methodName},
+                               {"moduleId", frame.moduleId}};
+                if (!frame.source.IsNull())
+                {
+                    frameJson["source"] = json{{"name", frame.source.name}, {"path", frame.source.path}};
+                    frameJson["line"] = frame.line;
+                    frameJson["column"] = frame.column;
+                }
+                asyncStack.push_back(frameJson);
+            }
+            groupsJson.push_back(json{{"status", group.status},
+                                      {"name", group.name},
+                                      {"count", group.count},
+                                      {"tasks", tasks},
+                                      {"asyncStack", asyncStack}});
+        }
+        body["tasksCount"] = tasksCount;
+        body["groups"] = groupsJson;
+        return S_OK;
+    } },
+    { "ncdbg_snapshotAndDetach", [&](const json &arguments, json &body) {
+        HRESULT Status;
+        std::string snapshot;
+        IfFailRet(sharedDebugger->SnapshotAndDetach(arguments.value("localsFrames", 3u), snapshot));
+        // Note, snapshot is provided as is (compact JSON text), client save it to file without reformatting.
+        body["snapshot"] = snapshot;
+        return S_OK;
     } }
     };
 
@@ -849,11 +1816,11 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
 }
 
 static HRESULT HandleCommandJSON(std::shared_ptr<IDebugger> &sharedDebugger, std::string &fileExec, std::vector<std::string> &execArgs,
-                                 const std::string &command, const json &arguments, json &body)
+                                 const std::string &command, const json &arguments, json &body, std::string &rawBody)
 {
     try
     {
-        return HandleCommand(sharedDebugger, fileExec, execArgs, command, arguments, body);
+        return HandleCommand(sharedDebugger, fileExec, execArgs, command, arguments, body, rawBody);
     }
     catch (nlohmann::detail::exception& ex)
     {
@@ -922,8 +1889,209 @@ static std::string ReadData(std::istream& cin)
     return result;
 }
 
+static void SetCanceledResponse(json &response, const std::string &command)
+{
+    response["success"] = false;
+    response["message"] = std::string("Error processing '") + command + std::string("' request. The operation was canceled.");
+}
+
+void VSCodeProtocol::ExecuteCommand(CommandQueueEntry &c)
+{
+    TraceRecorder::ScopedEvent traceEvent("protocol", "ExecuteCommand", c.command);
+
+    // Note, command could be canceled after it was removed from queue, but before execution start, drop stale command.
+    if (c.token.IsCanceled())
+    {
+        SetCanceledResponse(c.response, c.command);
+        EmitMessageWithLog(LOG_RESPONSE, c.response);
+        return;
+    }
+
+    json body = json::object();
+    std::string rawBody; // already serialized body, in case command support streaming serialization
+    std::future<HRESULT> future = std::async(std::launch::async, [&](){
+        TraceRecorder::SetThreadName("CommandExecutor");
+        TraceRecorder::ScopedEvent traceCommand("protocol", "HandleCommand", c.command);
+        Cancellation::Scope cancellationScope(c.token);
+        return HandleCommandJSON(m_sharedDebugger, m_fileExec, m_execArgs, c.command, c.arguments, body, rawBody);
+    });
+    HRESULT Status;
+    // Note, CommandsWorker() loop should never hangs, but even in case some command execution is timed out,
+    // this could be not critical issue. Let IDE decide.
+
+    // MSVS debugger use config file, for Visual Studio 2022 Community Edition located at
+    // C:\Program Files\Microsoft Visual Studio\2022\Community\Common7\IDE\Profiles\CSharp.vssettings
+    // Visual Studio have timeout setup for each type of requests, for example:
+    // LocalsTimeout = 1000
+    // LongEvalTimeout = 10000
+    // NormalEvalTimeout = 5000
+    // QuickwatchTimeout = 15000
+    // SetValueTimeout = 10000
+    // ...
+    // we use max default timeout (15000), one timeout for all requests.
+
+    // TODO add timeout configuration feature
+    std::future_status timeoutStatus = future.wait_for(std::chrono::milliseconds(15000));
+    if (timeoutStatus == std::future_status::timeout)
+    {
+        // Note, response will be emitted now, so, make command execution finish as soon as possible.
+        c.token.Cancel();
+        body["message"] = "Command execution timed out.";
+        Status = COR_E_TIMEOUT;
+    }
+    else
+        Status = future.get();
+
+    if (Status == COR_E_OPERATIONCANCELED && c.token.IsCanceled())
+        SetCanceledResponse(c.response, c.command);
+    else if (SUCCEEDED(Status))
+    {
+        c.response["success"] = true;
+        if (rawBody.empty())
+            c.response["body"] = body;
+    }
+    else
+    {
+        if (body.find("message") == body.end())
+        {
+            std::ostringstream ss;
+            ss << "Failed command '" << c.command << "' : "
+            << "0x" << std::setw(8) << std::setfill('0') << std::hex << Status;
+            c.response["message"] = ss.str();
+        }
+        else
+            c.response["message"] = body["message"];
+
+        c.response["success"] = false;
+    }
+
+    EmitMessageWithLog(LOG_RESPONSE, c.response, SUCCEEDED(Status) ? rawBody : std::string());
+}
+
+// Return CommandsLaneTypeCount in case command must be executed by CommandsWorker thread.
+VSCodeProtocol::CommandsLaneType VSCodeProtocol::GetCommandLane(const std::string &command)
+{
+    if (g_readOnlyCommandSet.find(command) != g_readOnlyCommandSet.end())
+        return ReadOnlyLane;
+
+    if (g_evaluationCommandSet.find(command) != g_evaluationCommandSet.end())
+        return EvaluationLane;
+
+    return CommandsLaneTypeCount;
+}
+
+void VSCodeProtocol::LaneWorker(CommandsLane &lane)
+{
+    TraceRecorder::SetThreadName("CommandsLane");
+    std::unique_lock<std::mutex> lockLanesMutex(m_lanesMutex);
+
+    while (true)
+    {
+        while (lane.queue.empty() && !m_lanesExit)
+        {
+            lane.cv.wait(lockLanesMutex);
+        }
+
+        if (lane.queue.empty())
+            break;
+
+        CommandQueueEntry c = std::move(lane.queue.front());
+        lane.queue.pop_front();
+        auto running = m_lanesRunning.insert(m_lanesRunning.end(), CommandQueueEntry{c.command, json(), c.response, c.token});
+        lockLanesMutex.unlock();
+
+        // Note, read-only commands could be executed in parallel with each other only, since evaluation command
+        // could run func-eval (resume debuggee) and stack walk/threads enumeration must not see debuggee in this state.
+        if (&lane == &m_lanes[ReadOnlyLane])
+        {
+            std::lock_guard<Utility::RWLock::Reader> guardLanesEvalRWLock(m_lanesEvalRWLock.reader);
+            ExecuteCommand(c);
+        }
+        else
+        {
+            std::lock_guard<Utility::RWLock::Writer> guardLanesEvalRWLock(m_lanesEvalRWLock.writer);
+            ExecuteCommand(c);
+        }
+
+        lockLanesMutex.lock();
+        m_lanesRunning.erase(running);
+        lane.pending--;
+        if (lane.pending == 0)
+            m_lanesIdleCV.notify_all();
+    }
+}
+
+void VSCodeProtocol::StartLanes()
+{
+    m_lanesExit = false;
+    for (unsigned i = 0; i < ReadOnlyLaneThreads; i++)
+    {
+        m_lanes[ReadOnlyLane].threads.emplace_back(&VSCodeProtocol::LaneWorker, this, std::ref(m_lanes[ReadOnlyLane]));
+    }
+    // Note, evaluation lane have only one thread, since evaluation related commands must be executed in order.
+    m_lanes[EvaluationLane].threads.emplace_back(&VSCodeProtocol::LaneWorker, this, std::ref(m_lanes[EvaluationLane]));
+}
+
+void VSCodeProtocol::StopLanes()
+{
+    {
+        std::lock_guard<std::mutex> lockLanesMutex(m_lanesMutex);
+        m_lanesExit = true;
+    }
+    for (auto &lane : m_lanes)
+    {
+        lane.cv.notify_all();
+        for (auto &thread : lane.threads)
+        {
+            thread.join();
+        }
+        lane.threads.clear();
+    }
+}
+
+void VSCodeProtocol::WaitLanesIdle()
+{
+    std::unique_lock<std::mutex> lockLanesMutex(m_lanesMutex);
+    while (m_lanes[ReadOnlyLane].pending != 0 || m_lanes[EvaluationLane].pending != 0)
+    {
+        m_lanesIdleCV.wait(lockLanesMutex);
+    }
+}
+
+// Caller must care about m_lanesMutex.
+void VSCodeProtocol::CancelLanesCommands(const std::function<bool(const CommandQueueEntry &entry)> &needCancel)
+{
+    for (auto &lane : m_lanes)
+    {
+        for (auto iter = lane.queue.begin(); iter != lane.queue.end();)
+        {
+            if (!needCancel(*iter))
+            {
+                ++iter;
+                continue;
+            }
+
+            SetCanceledResponse(iter->response, iter->command);
+            EmitMessageWithLog(LOG_RESPONSE, iter->response);
+            iter = lane.queue.erase(iter);
+            lane.pending--;
+        }
+        if (lane.pending == 0)
+            m_lanesIdleCV.notify_all();
+    }
+
+    // Note, running command will emit "canceled" response by itself, as soon as debugger reach cancellation point.
+    for (auto &entry : m_lanesRunning)
+    {
+        if (needCancel(entry))
+            entry.token.Cancel();
+    }
+}
+
 void VSCodeProtocol::CommandsWorker()
 {
+    TraceRecorder::SetThreadName("CommandsWorker");
+    StartLanes();
     std::unique_lock<std::mutex> lockCommandsMutex(m_commandsMutex);
 
     while (true)
@@ -937,65 +2105,35 @@ void VSCodeProtocol::CommandsWorker()
 
         CommandQueueEntry c = std::move(m_commandsQueue.front());
         m_commandsQueue.pop_front();
+        commandsQueueDepthGauge.Set(m_commandsQueue.size());
         lockCommandsMutex.unlock();
 
         // Check for ncdbg internal commands.
         if (c.command == "ncdbg_disconnect")
         {
+            WaitLanesIdle();
             m_sharedDebugger->Disconnect();
             break;
         }
 
-        json body = json::object();
-        std::future<HRESULT> future = std::async(std::launch::async, [&](){
-            return HandleCommandJSON(m_sharedDebugger, m_fileExec, m_execArgs, c.command, c.arguments, body);
-        });
-        HRESULT Status;
-        // Note, CommandsWorker() loop should never hangs, but even in case some command execution is timed out,
-        // this could be not critical issue. Let IDE decide.
-
-        // MSVS debugger use config file, for Visual Studio 2022 Community Edition located at
-        // C:\Program Files\Microsoft Visual Studio\2022\Community\Common7\IDE\Profiles\CSharp.vssettings
-        // Visual Studio have timeout setup for each type of requests, for example:
-        // LocalsTimeout = 1000
-        // LongEvalTimeout = 10000
-        // NormalEvalTimeout = 5000
-        // QuickwatchTimeout = 15000
-        // SetValueTimeout = 10000
-        // ...
-        // we use max default timeout (15000), one timeout for all requests.
-
-        // TODO add timeout configuration feature
-        std::future_status timeoutStatus = future.wait_for(std::chrono::milliseconds(15000));
-        if (timeoutStatus == std::future_status::timeout)
-        {
-            body["message"] = "Command execution timed out.";
-            Status = COR_E_TIMEOUT;
-        }
-        else
-            Status = future.get();
-
-        if (SUCCEEDED(Status))
-        {
-            c.response["success"] = true;
-            c.response["body"] = body;
-        }
-        else
+        // Read-only commands are executed in parallel by read-only lane threads, evaluation related commands are executed in order
+        // by evaluation lane thread. State-changing commands are executed by this thread in order, after all previous commands
+        // execution finished.
+        CommandsLaneType laneType = GetCommandLane(c.command);
+        if (laneType != CommandsLaneTypeCount)
         {
-            if (body.find("message") == body.end())
             {
-                std::ostringstream ss;
-                ss << "Failed command '" << c.command << "' : "
-                << "0x" << std::setw(8) << std::setfill('0') << std::hex << Status;
-                c.response["message"] = ss.str();
+                std::lock_guard<std::mutex> lockLanesMutex(m_lanesMutex);
+                m_lanes[laneType].queue.emplace_back(std::move(c));
+                m_lanes[laneType].pending++;
             }
-            else
-                c.response["message"] = body["message"];
-
-            c.response["success"] = false;
+            m_lanes[laneType].cv.notify_one();
+            lockCommandsMutex.lock();
+            continue;
         }
 
-        EmitMessageWithLog(LOG_RESPONSE, c.response);
+        WaitLanesIdle();
+        ExecuteCommand(c);
 
         // Post command action.
         if (g_syncCommandExecutionSet.find(c.command) != g_syncCommandExecutionSet.end())
@@ -1006,20 +2144,55 @@ void VSCodeProtocol::CommandsWorker()
         lockCommandsMutex.lock();
     }
 
+    StopLanes();
     m_exit = true;
 }
 
+// Child session is started by client with `startDebugging` reverse request, client connects debugger again and new
+// connection is served as separate session. In case debugger allowed to serve few sessions at once (`--max-sessions`),
+// same netcoredbg process debugs child process in parallel with current session.
+void VSCodeProtocol::StartChildSession(CommandQueueEntry &queueEntry)
+{
+    const json &processId = queueEntry.arguments.at("processId");
+    if (!m_startDebuggingSupported || (!processId.is_number() && !processId.is_string()))
+    {
+        queueEntry.response["success"] = false;
+        queueEntry.response["message"] = m_startDebuggingSupported ? "Wrong processId." : "Client doesn't support startDebugging request.";
+        EmitMessageWithLog(LOG_RESPONSE, queueEntry.response);
+        return;
+    }
+
+    auto find = queueEntry.arguments.find("configuration");
+    json configuration = find == queueEntry.arguments.end() ? json::object() : find.value();
+    configuration["request"] = "attach";
+    configuration["processId"] = processId;
+    if (configuration.find("name") == configuration.end())
+        configuration["name"] = "Process " + (processId.is_string() ? processId.get<std::string>() : processId.dump());
+
+    json request;
+    request["type"] = "request";
+    request["command"] = "startDebugging";
+    request["arguments"] = json{{"request", "attach"}, {"configuration", configuration}};
+    EmitMessageWithLog(LOG_REQUEST, request);
+
+    queueEntry.response["success"] = true;
+    queueEntry.response["body"] = json::object();
+    EmitMessageWithLog(LOG_RESPONSE, queueEntry.response);
+}
+
 // Caller must care about m_commandsMutex.
 std::list<VSCodeProtocol::CommandQueueEntry>::iterator VSCodeProtocol::CancelCommand(const std::list<VSCodeProtocol::CommandQueueEntry>::iterator &iter)
 {
-    iter->response["success"] = false;
-    iter->response["message"] = std::string("Error processing '") + iter->command + std::string("' request. The operation was canceled.");
+    SetCanceledResponse(iter->response, iter->command);
     EmitMessageWithLog(LOG_RESPONSE, iter->response);
-    return m_commandsQueue.erase(iter);
+    auto next = m_commandsQueue.erase(iter);
+    commandsQueueDepthGauge.Set(m_commandsQueue.size());
+    return next;
 }
 
 void VSCodeProtocol::CommandLoop()
 {
+    TraceRecorder::SetThreadName("ProtocolReader");
     std::thread commandsWorker{&VSCodeProtocol::CommandsWorker, this};
 
     m_exit = false;
@@ -1037,6 +2210,7 @@ void VSCodeProtocol::CommandLoop()
             m_commandsCV.notify_one(); // notify_one with lock
             break;
         }
+        protocolBytesInCounter.Add(requestText.size());
 
         {
             std::lock_guard<std::mutex> lock(m_outMutex);
@@ -1053,6 +2227,14 @@ void VSCodeProtocol::CommandLoop()
         {
             json request = json::parse(requestText);
 
+            // Note, client's answers for debugger's (reverse) requests don't need any actions.
+            if (request["type"] == "response")
+            {
+                if (!request.value("success", false))
+                    LOGW("Reverse request %s failed", request.value("command", std::string()).c_str());
+                continue;
+            }
+
             // Variable `resp' is used to construct response and assign it to `response'
             // variable in single step: `response' variable should always be in
             // consistent state (it must not have state when some fields is assigned and
@@ -1075,7 +2257,16 @@ void VSCodeProtocol::CommandLoop()
 
             // Pre command action.
             if (queueEntry.command == "initialize")
+            {
+                m_startDebuggingSupported = queueEntry.arguments.value("supportsStartDebuggingRequest", false);
                 EmitCapabilitiesEvent();
+            }
+            // Note, child session start is quick and don't depend on debugger state, this is command implementation itself.
+            else if (queueEntry.command == "ncdbg_startChildSession")
+            {
+                StartChildSession(queueEntry);
+                continue;
+            }
             else if (g_cancelCommandQueueSet.find(queueEntry.command) != g_cancelCommandQueueSet.end())
             {
                 std::lock_guard<std::mutex> guardCommandsMutex(m_commandsMutex);
@@ -1088,6 +2279,10 @@ void VSCodeProtocol::CommandLoop()
                     else
                         iter = CancelCommand(iter);
                 }
+
+                // Note, lanes have only read-only and evaluation related commands.
+                std::lock_guard<std::mutex> guardLanesMutex(m_lanesMutex);
+                CancelLanesCommands([](const CommandQueueEntry &) { return true; });
             }
             // Note, in case "cancel" this is command implementation itself.
             else if (queueEntry.command == "cancel")
@@ -1108,8 +2303,31 @@ void VSCodeProtocol::CommandLoop()
                     queueEntry.response["success"] = true;
                     break;
                 }
+                bool cancelEval = false;
+                if (!queueEntry.response["success"])
+                {
+                    std::lock_guard<std::mutex> guardLanesMutex(m_lanesMutex);
+                    CancelLanesCommands([&](const CommandQueueEntry &entry)
+                    {
+                        if (requestId != entry.response.at("request_seq"))
+                            return false;
+
+                        queueEntry.response["success"] = true;
+                        return true;
+                    });
+
+                    for (const auto &entry : m_lanesRunning)
+                    {
+                        if (requestId == entry.response.at("request_seq") && GetCommandLane(entry.command) == EvaluationLane)
+                            cancelEval = true;
+                    }
+                }
                 lockCommandsMutex.unlock();
 
+                // Note, evaluation lane execute commands in order, so, running eval (if any) belong to canceled command.
+                if (cancelEval)
+                    m_sharedDebugger->CancelEvalRunning();
+
                 if (!queueEntry.response["success"])
                     queueEntry.response["message"] = "CancelRequest is not supported for requestId.";
 
@@ -1120,6 +2338,7 @@ void VSCodeProtocol::CommandLoop()
             std::unique_lock<std::mutex> lockCommandsMutex(m_commandsMutex);
             bool isCommandNeedSync = g_syncCommandExecutionSet.find(queueEntry.command) != g_syncCommandExecutionSet.end();
             m_commandsQueue.emplace_back(std::move(queueEntry));
+            commandsQueueDepthGauge.Set(m_commandsQueue.size());
             m_commandsCV.notify_one(); // notify_one with lock
 
             if (isCommandNeedSync)
@@ -1148,12 +2367,23 @@ void VSCodeProtocol::CommandLoop()
     commandsWorker.join();
 }
 
-void VSCodeProtocol::EngineLogging(const std::string &path)
+void VSCodeProtocol::EngineLogging(const std::string &path, bool binary)
 {
     if (path.empty())
     {
         m_engineLogOutput = LogConsole;
     }
+    else if (binary)
+    {
+        std::unique_ptr<std::ostream> stream(new std::ofstream(path, std::ios::out | std::ios::binary | std::ios::trunc));
+        if (!*stream)
+        {
+            LOGE("Can't open engine log file '%s'", path.c_str());
+            return;
+        }
+        m_binaryEngineLog.reset(new EngineLogWriter(std::move(stream)));
+        m_engineLogOutput = LogBinary;
+    }
     else
     {
         m_engineLogOutput = LogFile;
@@ -1169,9 +2399,22 @@ void VSCodeProtocol::Log(const std::string &prefix, const std::string &text)
         case LogNone:
             return;
         case LogFile:
-            m_engineLog << prefix << text << std::endl;
-            m_engineLog.flush();
+            // Note, no flush for each message, file flushed by stream buffer and at close.
+            m_engineLog << prefix << text << '\n';
             return;
+        case LogBinary:
+        {
+            // Note, only copy into ring buffer here, file is written by background thread.
+            EngineLogWriter::Direction direction = EngineLogWriter::Direction::Event;
+            if (prefix == LOG_COMMAND)
+                direction = EngineLogWriter::Direction::Command;
+            else if (prefix == LOG_RESPONSE)
+                direction = EngineLogWriter::Direction::Response;
+            else if (prefix == LOG_REQUEST)
+                direction = EngineLogWriter::Direction::Request;
+            m_binaryEngineLog->Write(direction, text.data(), text.size());
+            return;
+        }
         case LogConsole:
         {
             json response;
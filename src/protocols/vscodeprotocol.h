@@ -7,6 +7,9 @@
 #include <mutex>
 #include <string>
 #include <list>
+#include <vector>
+#include <thread>
+#include <functional>
 #include <condition_variable>
 
 #pragma warning (disable:4068)  // Visual Studio should ignore GCC pragmas
@@ -16,6 +19,11 @@
 #pragma GCC diagnostic pop
 
 #include "interfaces/iprotocol.h"
+#include "protocols/enginelog.h"
+#include "protocols/eventcoalescer.h"
+#include "protocols/outputcoalescer.h"
+#include "utils/cancellation.h"
+#include "utils/rwlock.h"
 
 namespace netcoredbg
 {
@@ -26,17 +34,24 @@ class VSCodeProtocol : public IProtocol
     enum {
         LogNone,
         LogConsole,
-        LogFile
+        LogFile,
+        LogBinary
     } m_engineLogOutput;
     std::ofstream m_engineLog;
+    std::unique_ptr<EngineLogWriter> m_binaryEngineLog;
     uint64_t m_seqCounter; // Note, this counter must be covered by m_outMutex.
+    bool m_startDebuggingSupported; // client supports `startDebugging` reverse request
 
     std::string m_fileExec;
     std::vector<std::string> m_execArgs;
 
-    void EmitMessage(nlohmann::json &message, std::string &output);
-    void EmitMessageWithLog(const std::string &message_prefix, nlohmann::json &message);
+    // Note, rawBody is optional already serialized JSON, that will be added as "body" field of message.
+    // In case flush is false, caller must care about output stream flush.
+    void EmitMessage(nlohmann::json &message, std::string &output, const std::string &rawBody = std::string(), bool flush = true);
+    void EmitMessageWithLog(const std::string &message_prefix, nlohmann::json &message, const std::string &rawBody = std::string());
     void EmitEvent(const std::string &name, const nlohmann::json &body);
+    void WriteOutputEvent(OutputCategory category, string_view output, string_view source);
+    void WriteEvents(const std::vector<EventCoalescer::Event> &events);
 
     void Log(const std::string &prefix, const std::string &text);
 
@@ -45,6 +60,7 @@ class VSCodeProtocol : public IProtocol
         std::string command;
         nlohmann::json arguments;
         nlohmann::json response;
+        CancellationToken token;
     };
 
     std::mutex m_commandsMutex;
@@ -53,13 +69,61 @@ class VSCodeProtocol : public IProtocol
     std::list<CommandQueueEntry> m_commandsQueue;
 
     void CommandsWorker();
+    void StartChildSession(CommandQueueEntry &queueEntry);
     std::list<CommandQueueEntry>::iterator CancelCommand(const std::list<CommandQueueEntry>::iterator &iter);
+    void ExecuteCommand(CommandQueueEntry &c);
+
+    // Commands dispatched by CommandsWorker for execution in separate threads.
+    enum CommandsLaneType
+    {
+        ReadOnlyLane,
+        EvaluationLane,
+        CommandsLaneTypeCount
+    };
+
+    struct CommandsLane
+    {
+        std::list<CommandQueueEntry> queue;
+        unsigned pending = 0; // queued and executing commands
+        std::condition_variable cv;
+        std::vector<std::thread> threads;
+    };
+
+    static const unsigned ReadOnlyLaneThreads = 2;
+
+    std::mutex m_lanesMutex;
+    std::condition_variable m_lanesIdleCV;
+    CommandsLane m_lanes[CommandsLaneTypeCount];
+    // Read-only lane commands hold reader, evaluation lane commands hold writer.
+    Utility::RWLock m_lanesEvalRWLock;
+    // Copies (without arguments) of commands executed by lanes threads now, provide tokens for running commands cancellation.
+    std::list<CommandQueueEntry> m_lanesRunning;
+    bool m_lanesExit = false;
+
+    static CommandsLaneType GetCommandLane(const std::string &command);
+    void LaneWorker(CommandsLane &lane);
+    void StartLanes();
+    void StopLanes();
+    void WaitLanesIdle();
+    // Remove queued commands from lanes and cancel tokens of running commands, that need cancel.
+    void CancelLanesCommands(const std::function<bool(const CommandQueueEntry &entry)> &needCancel);
+
+    std::string m_outputMessage; // Note, reused for all output events, must be covered by m_outMutex.
+    // Note, must be declared after all members used by WriteOutputEvent(), since pending output is flushed at destruction.
+    OutputCoalescer m_outputCoalescer;
+    // Note, must be declared after all members used by WriteEvents(), since pending events are flushed at destruction.
+    EventCoalescer m_eventCoalescer;
 
 public:
 
     VSCodeProtocol(std::istream& input, std::ostream& output) :
-        IProtocol(input, output), m_engineLogOutput(LogNone), m_seqCounter(1) {}
-    void EngineLogging(const std::string &path);
+        IProtocol(input, output), m_engineLogOutput(LogNone), m_seqCounter(1), m_startDebuggingSupported(false),
+        m_outputCoalescer([this](int category, string_view text) { WriteOutputEvent(OutputCategory(category), text, string_view()); }),
+        m_eventCoalescer([this](const std::vector<EventCoalescer::Event> &events) { WriteEvents(events); }) {}
+    // In case `binary` is true, messages are stored into file in compact binary format (see EngineLogWriter).
+    void EngineLogging(const std::string &path, bool binary = false);
+    void SetOutputOptions(const OutputCoalescer::Options &options) { m_outputCoalescer.SetOptions(options); }
+    void SetEventsOptions(const EventCoalescer::Options &options) { m_eventCoalescer.SetOptions(options); }
     void SetLaunchCommand(const std::string &fileExec, const std::vector<std::string> &args) override
     {
         m_fileExec = fileExec;
@@ -71,9 +135,10 @@ public:
     void EmitStoppedEvent(const StoppedEvent &event) override;
     void EmitExitedEvent(const ExitedEvent &event) override;
     void EmitTerminatedEvent() override;
-    void EmitContinuedEvent(ThreadId threadId) override;
+    void EmitContinuedEvent(ThreadId threadId, bool allThreadsContinued) override;
     void EmitThreadEvent(const ThreadEvent &event) override;
     void EmitModuleEvent(const ModuleEvent &event) override;
+    void EmitLoadedSourceEvent(const Source &source) override;
     void EmitOutputEvent(OutputCategory category, string_view output, string_view source = "") override;
     void EmitBreakpointEvent(const BreakpointEvent &event) override;
     void Cleanup() override;
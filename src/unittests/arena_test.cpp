@@ -0,0 +1,79 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include "utils/arena.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    struct Element
+    {
+        int value;
+        std::shared_ptr<int> owned;
+
+        Element(int value_, std::shared_ptr<int> owned_) : value(value_), owned(owned_) {}
+    };
+}
+
+TEST_CASE("DenseArena::EmplaceAndReset")
+{
+    DenseArena<Element, 4> arena;
+    std::shared_ptr<int> owned = std::make_shared<int>(0);
+
+    std::vector<Element*> pointers;
+    for (int i = 0; i < 10; i++)
+    {
+        pointers.push_back(&arena.Emplace(i, owned));
+    }
+    REQUIRE(arena.Size() == 10);
+    CHECK(owned.use_count() == 11);
+
+    // Elements are never moved.
+    for (int i = 0; i < 10; i++)
+    {
+        CHECK(arena.Get(i) == pointers[i]);
+        CHECK(arena.Get(i)->value == i);
+    }
+    CHECK(arena.Get(10) == nullptr);
+
+    // Elements are destroyed, blocks are reused.
+    arena.Reset();
+    CHECK(arena.Size() == 0);
+    CHECK(arena.Get(0) == nullptr);
+    CHECK(owned.use_count() == 1);
+
+    CHECK(&arena.Emplace(42, owned) == pointers[0]);
+    CHECK(arena.Get(0)->value == 42);
+}
+
+TEST_CASE("StringArena::Store")
+{
+    StringArena arena;
+    CHECK(arena.Store("").empty());
+
+    std::vector<std::pair<Utility::string_view, std::string>> stored;
+    for (int i = 0; i < 10000; i++)
+    {
+        std::string str = "variable." + std::to_string(i);
+        stored.emplace_back(arena.Store(str), str);
+    }
+    const std::string large(100 * 1024, 'x');
+    stored.emplace_back(arena.Store(large), large);
+    stored.emplace_back(arena.Store("tail"), "tail");
+
+    // Views are valid after other strings addition.
+    for (const auto &entry : stored)
+    {
+        CHECK(std::string(entry.first) == entry.second);
+    }
+
+    arena.Reset();
+    CHECK(arena.GetMemoryUsage() < 100 * 1024);
+    CHECK(std::string(arena.Store("after reset")) == "after reset");
+}
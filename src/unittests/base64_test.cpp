@@ -0,0 +1,76 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include "utils/base64.h"
+
+namespace Base64 = ::netcoredbg::Base64;
+
+namespace
+{
+
+    std::string Encode(const std::string &data)
+    {
+        std::string output;
+        Base64::Encode(data.data(), data.size(), output);
+        return output;
+    }
+
+} // unnamed namespace
+
+TEST_CASE("Base64::Encode")
+{
+    // RFC 4648 test vectors.
+    CHECK(Encode("") == "");
+    CHECK(Encode("f") == "Zg==");
+    CHECK(Encode("fo") == "Zm8=");
+    CHECK(Encode("foo") == "Zm9v");
+    CHECK(Encode("foob") == "Zm9vYg==");
+    CHECK(Encode("fooba") == "Zm9vYmE=");
+    CHECK(Encode("foobar") == "Zm9vYmFy");
+    CHECK(Encode("foobarfoobarfoobar") == "Zm9vYmFyZm9vYmFyZm9vYmFy");
+    CHECK(Encode(std::string("\0\xff\xfe", 3)) == "AP/+");
+
+    SECTION("append")
+    {
+        std::string output = "\"";
+        Base64::Encode("foo", 3, output);
+        CHECK(output == "\"Zm9v");
+    }
+}
+
+TEST_CASE("Base64::Decode")
+{
+    std::string output;
+
+    SECTION("round trip")
+    {
+        std::string data;
+        for (int i = 0; i < 1000; i++)
+        {
+            data.push_back(char(i * 7));
+            const std::string encoded = Encode(data);
+            CHECK(encoded.size() == Base64::EncodedSize(data.size()));
+            output.clear();
+            REQUIRE(Base64::Decode(encoded, output));
+            CHECK(output == data);
+        }
+    }
+
+    SECTION("invalid input")
+    {
+        CHECK(!Base64::Decode("Zm9", output));
+        CHECK(!Base64::Decode("Zm 9", output));
+        CHECK(!Base64::Decode("Z=9v", output));
+        CHECK(!Base64::Decode("Zg==Zm9v", output));
+        CHECK(output.empty());
+    }
+
+    SECTION("padding")
+    {
+        REQUIRE(Base64::Decode("Zm8=", output));
+        CHECK(output == "fo");
+    }
+}
@@ -0,0 +1,19 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+// Entry point of `benchmarks` executable: benchmarks are hidden test cases, so, all of them are
+// selected in case no command line arguments provided, any Catch2 options could be used otherwise.
+
+#define CATCH_CONFIG_COLOUR_NONE
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch.hpp>
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1)
+        return Catch::Session().run(argc, argv);
+
+    const char *args[] = { argv[0], "[benchmark]" };
+    return Catch::Session().run(2, args);
+}
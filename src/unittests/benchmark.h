@@ -0,0 +1,132 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+// Helpers for microbenchmarks (hidden "[.benchmark]" test cases), see `benchmarks` target in CMakeLists.txt.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace netcoredbg
+{
+namespace Benchmark
+{
+    struct Result
+    {
+        std::string name;
+        uint64_t iterations;
+        double nsPerOp;
+        double mbPerSec; // 0 in case operation don't process data
+    };
+
+    // Results are printed right after measure, in addition they are written at exit as JSON array into file
+    // provided by NETCOREDBG_BENCHMARK_JSON environment variable (if any), in order to track regressions.
+    class Results
+    {
+    public:
+
+        void Add(Result result)
+        {
+            if (result.mbPerSec > 0)
+                printf("%-56s %12.1f ns/op %10.1f MB/s\n", result.name.c_str(), result.nsPerOp, result.mbPerSec);
+            else
+                printf("%-56s %12.1f ns/op\n", result.name.c_str(), result.nsPerOp);
+
+            m_results.emplace_back(std::move(result));
+        }
+
+        ~Results()
+        {
+            const char *path = getenv("NETCOREDBG_BENCHMARK_JSON");
+            if (path == nullptr || *path == '\0' || m_results.empty())
+                return;
+
+            FILE *file = fopen(path, "w");
+            if (file == nullptr)
+            {
+                fprintf(stderr, "can't write benchmark results to %s\n", path);
+                return;
+            }
+
+            fprintf(file, "[\n");
+            for (size_t i = 0; i < m_results.size(); i++)
+            {
+                const Result &result = m_results[i];
+                std::string name;
+                for (char c : result.name)
+                {
+                    if (c == '"' || c == '\\')
+                        name.push_back('\\');
+                    name.push_back(c);
+                }
+                fprintf(file, "  {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f, \"mb_per_s\": %.3f}%s\n",
+                        name.c_str(), (unsigned long long)result.iterations, result.nsPerOp, result.mbPerSec,
+                        i + 1 < m_results.size() ? "," : "");
+            }
+            fprintf(file, "]\n");
+            fclose(file);
+        }
+
+    private:
+
+        std::vector<Result> m_results;
+    };
+
+    inline Results &GetResults()
+    {
+        static Results results;
+        return results;
+    }
+
+    // Report measured time of `iterations` operations, `bytes` is amount of data processed by one operation (if any).
+    inline void Report(const char *name, uint64_t iterations, std::chrono::nanoseconds time, size_t bytes = 0)
+    {
+        const double ns = double(time.count());
+        const double nsPerOp = iterations > 0 ? ns / double(iterations) : 0;
+        // Note, bytes per nanosecond is 1000 MB/s.
+        const double mbPerSec = (bytes > 0 && ns > 0) ? double(bytes) * double(iterations) * 1000.0 / ns : 0;
+        GetResults().Add({name, iterations, nsPerOp, mbPerSec});
+    }
+
+    // Prevent compiler from optimizing out measured code, result of each operation must be passed here.
+    inline void DoNotOptimize(size_t value)
+    {
+        static volatile size_t sink;
+        sink = sink + value;
+    }
+
+    // Measure `func` (returns size_t checksum), number of iterations is doubled until measure takes at least
+    // MinTime, so fast operations are measured with enough iterations for stable results.
+    template <typename Func>
+    void Measure(const char *name, size_t bytes, Func &&func)
+    {
+        static const std::chrono::milliseconds MinTime(200);
+        static const uint64_t MaxIterations = uint64_t(1) << 30;
+
+        for (uint64_t iterations = 1; ; iterations *= 2)
+        {
+            size_t check = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                check += func();
+            }
+            auto time = std::chrono::steady_clock::now() - start;
+            DoNotOptimize(check);
+
+            if (time >= MinTime || iterations >= MaxIterations)
+            {
+                Report(name, iterations, std::chrono::duration_cast<std::chrono::nanoseconds>(time), bytes);
+                return;
+            }
+        }
+    }
+
+} // namespace Benchmark
+} // namespace netcoredbg
@@ -0,0 +1,62 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <thread>
+#include "utils/cancellation.h"
+
+using ::netcoredbg::CancellationToken;
+namespace Cancellation = ::netcoredbg::Cancellation;
+
+TEST_CASE("CancellationToken")
+{
+    CancellationToken token;
+    CancellationToken copy = token;
+    CHECK(!token.IsCanceled());
+    CHECK(!copy.IsCanceled());
+
+    copy.Cancel();
+    CHECK(token.IsCanceled());
+    CHECK(copy.IsCanceled());
+
+    CancellationToken other;
+    CHECK(!other.IsCanceled());
+}
+
+TEST_CASE("Cancellation::Scope")
+{
+    CHECK(!Cancellation::IsRequested());
+
+    CancellationToken outer;
+    CancellationToken inner;
+    {
+        Cancellation::Scope outerScope(outer);
+        CHECK(!Cancellation::IsRequested());
+        {
+            Cancellation::Scope innerScope(inner);
+            inner.Cancel();
+            CHECK(Cancellation::IsRequested());
+        }
+        CHECK(!Cancellation::IsRequested());
+        outer.Cancel();
+        CHECK(Cancellation::IsRequested());
+    }
+    CHECK(!Cancellation::IsRequested());
+}
+
+TEST_CASE("Cancellation::Scope is per thread")
+{
+    CancellationToken token;
+    token.Cancel();
+    Cancellation::Scope scope(token);
+    CHECK(Cancellation::IsRequested());
+
+    bool requested = true;
+    std::thread thread([&]()
+    {
+        requested = Cancellation::IsRequested();
+    });
+    thread.join();
+    CHECK(!requested);
+}
@@ -0,0 +1,114 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "utils/compressedstream.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    std::string MakeResponse(size_t variables)
+    {
+        std::string result = "{\"seq\":12,\"type\":\"response\",\"command\":\"variables\",\"body\":{\"variables\":[";
+        for (size_t i = 0; i < variables; i++)
+        {
+            if (i != 0)
+                result += ",";
+            result += "{\"name\":\"[" + std::to_string(i) + "]\",\"value\":\"" + std::to_string(i * 7919) +
+                      "\",\"type\":\"int\",\"evaluateName\":\"list[" + std::to_string(i) + "]\",\"variablesReference\":0}";
+        }
+        return result + "]}}";
+    }
+
+    // Function writes messages (each one followed by flush) and returns produced frames.
+    std::string Write(const std::vector<std::string> &messages, size_t bufSize)
+    {
+        std::stringbuf transport;
+        {
+            CompressedStreamBuf buffer(transport, bufSize);
+            std::ostream out(&buffer);
+            for (const auto &message : messages)
+            {
+                out << message;
+                out.flush();
+            }
+        }
+        return transport.str();
+    }
+
+    std::string ReadAll(const std::string &frames, size_t bufSize)
+    {
+        std::stringbuf transport(frames);
+        CompressedStreamBuf buffer(transport, bufSize);
+        std::istream in(&buffer);
+        std::ostringstream result;
+        result << in.rdbuf();
+        return result.str();
+    }
+}
+
+TEST_CASE("CompressedStreamBuf::SmallMessagesUncompressed")
+{
+    const std::string message = "Content-Length: 42\r\n\r\n{\"seq\":1,\"type\":\"event\",\"event\":\"stopped\"}";
+    const std::string frames = Write({message}, 4096);
+
+    REQUIRE(frames.size() == message.size() + 4);
+    CHECK(frames.compare(0, 4, std::string("\0\0\0", 3) + char(message.size())) == 0);
+    CHECK(frames.substr(4) == message);
+    CHECK(ReadAll(frames, 4096) == message);
+}
+
+TEST_CASE("CompressedStreamBuf::RoundTrip")
+{
+    const std::vector<std::string> messages = {
+        "small",
+        MakeResponse(200),
+        "small again",
+        MakeResponse(2000), // bigger than buffer
+        MakeResponse(200),
+        "",
+        "last"
+    };
+    std::string expected;
+    for (const auto &message : messages)
+        expected += message;
+
+    const std::string frames = Write(messages, 4096);
+    CHECK(frames.size() < expected.size() / 4);
+
+    // Note, reader's buffer is smaller than inflate output.
+    CHECK(ReadAll(frames, 1024) == expected);
+    CHECK(ReadAll(frames, 64 * 1024) == expected);
+}
+
+TEST_CASE("CompressedStreamBuf::BrokenInput")
+{
+    std::string frames = Write({MakeResponse(100)}, 4096);
+
+    // Truncated frame.
+    CHECK(ReadAll(frames.substr(0, frames.size() - 1), 4096).empty());
+
+    // Frame size limit.
+    frames[0] = char(0x7F);
+    CHECK(ReadAll(frames, 4096).empty());
+}
+
+TEST_CASE("StreamCompression::Negotiate")
+{
+    {
+        std::stringbuf transport("Content-Length: 10\r\n\r\n");
+        CHECK_FALSE(StreamCompression::Negotiate(transport));
+        CHECK(transport.str() == "Content-Length: 10\r\n\r\n");
+        CHECK(transport.sgetc() == 'C');
+    }
+    {
+        std::stringbuf transport(std::string(StreamCompression::Hello, StreamCompression::HelloSize) + "data");
+        REQUIRE(StreamCompression::Negotiate(transport));
+        CHECK(transport.sgetc() == 'd');
+    }
+}
@@ -0,0 +1,221 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <limits>
+#include <vector>
+#include "debugger/conditionpredicate.h"
+
+using ::netcoredbg::ConditionPredicate;
+using ::netcoredbg::ConditionPredicatesCache;
+
+namespace
+{
+
+    typedef ConditionPredicate::value_t value_t;
+    typedef ConditionPredicate::Operation Operation;
+    typedef ConditionPredicate::Logic Logic;
+
+    // Calculate predicate with literals only (or with provided values for both operands of single comparison).
+    bool Calculate(const std::string &condition, bool &result, const value_t *left = nullptr, const value_t *right = nullptr)
+    {
+        ConditionPredicate predicate;
+        if (!predicate.Parse(condition))
+            return false;
+
+        for (const auto &comparison : predicate.GetComparisons())
+        {
+            if (!ConditionPredicate::Calculate(comparison, left ? *left : comparison.left.literal,
+                                               right ? *right : comparison.right.literal, result))
+                return false;
+            if (predicate.IsFinalResult(result))
+                break;
+        }
+        return true;
+    }
+
+} // unnamed namespace
+
+TEST_CASE("ConditionPredicate::Parse")
+{
+    ConditionPredicate predicate;
+
+    REQUIRE(predicate.Parse("i == 1000"));
+    CHECK(predicate.GetComparisons().front().left.identifiers == std::vector<std::string>{"i"});
+    CHECK(predicate.GetComparisons().front().operation == Operation::Equal);
+    CHECK(predicate.GetComparisons().front().right.IsLiteral());
+    CHECK(predicate.GetComparisons().front().right.literal.kind == value_t::Kind::Signed);
+    CHECK(predicate.GetComparisons().front().right.literal.data.i == 1000);
+
+    REQUIRE(predicate.Parse("this.obj.field!=null"));
+    CHECK(predicate.GetComparisons().front().left.identifiers == std::vector<std::string>{"this", "obj", "field"});
+    CHECK(predicate.GetComparisons().front().operation == Operation::NotEqual);
+    CHECK(predicate.GetComparisons().front().right.literal.kind == value_t::Kind::Null);
+
+    REQUIRE(predicate.Parse("  flag  "));
+    CHECK(predicate.GetComparisons().front().left.identifiers == std::vector<std::string>{"flag"});
+    CHECK(predicate.GetComparisons().front().operation == Operation::None);
+
+    REQUIRE(predicate.Parse("x>=-0x10"));
+    CHECK(predicate.GetComparisons().front().operation == Operation::GreaterOrEqual);
+    CHECK(predicate.GetComparisons().front().right.literal.data.i == -16);
+
+    REQUIRE(predicate.Parse("d < 1.5e2"));
+    CHECK(predicate.GetComparisons().front().operation == Operation::Less);
+    CHECK(predicate.GetComparisons().front().right.literal.kind == value_t::Kind::Real);
+    CHECK(predicate.GetComparisons().front().right.literal.data.d == 150.0);
+
+    REQUIRE(predicate.Parse("c == 'a'"));
+    CHECK(predicate.GetComparisons().front().right.literal.kind == value_t::Kind::Unsigned);
+    CHECK(predicate.GetComparisons().front().right.literal.data.u == 'a');
+
+    REQUIRE(predicate.Parse("u > 18446744073709551615"));
+    CHECK(predicate.GetComparisons().front().right.literal.kind == value_t::Kind::Unsigned);
+
+    REQUIRE(predicate.Parse("obj != null && obj.field>0&&flag"));
+    CHECK(predicate.GetLogic() == Logic::And);
+    REQUIRE(predicate.GetComparisons().size() == 3);
+    CHECK(predicate.GetComparisons()[1].left.identifiers == std::vector<std::string>{"obj", "field"});
+    CHECK(predicate.GetComparisons()[1].operation == Operation::Greater);
+    CHECK(predicate.GetComparisons()[2].left.identifiers == std::vector<std::string>{"flag"});
+    CHECK(predicate.GetComparisons()[2].operation == Operation::None);
+
+    REQUIRE(predicate.Parse("i == 1 || i == 2"));
+    CHECK(predicate.GetLogic() == Logic::Or);
+    CHECK(predicate.GetComparisons().size() == 2);
+
+    REQUIRE(predicate.Parse("i == 1"));
+    CHECK(predicate.GetLogic() == Logic::None);
+    CHECK(predicate.GetComparisons().size() == 1);
+
+    // non trivial conditions
+    CHECK(!predicate.Parse(""));
+    CHECK(!predicate.Parse("i + 1 == 2"));
+    CHECK(!predicate.Parse("i == 1 && j == 2 || k == 3"));
+    CHECK(!predicate.Parse("i == 1 & j == 2"));
+    CHECK(!predicate.Parse("i == 1 &&"));
+    CHECK(!predicate.Parse("(i == 1) && j == 2"));
+    CHECK(!predicate.Parse("a && b && c && d && e && f && g && h && i"));
+    CHECK(!predicate.Parse("obj.Method() == 1"));
+    CHECK(!predicate.Parse("arr[0] == 1"));
+    CHECK(!predicate.Parse("s == \"text\""));
+    CHECK(!predicate.Parse("!flag"));
+    CHECK(!predicate.Parse("i << 2"));
+    CHECK(!predicate.Parse("i == 1u"));
+    CHECK(!predicate.Parse("i == 1."));
+    CHECK(!predicate.Parse("f == 1.5f"));
+    CHECK(!predicate.Parse("c == '\\n'"));
+    CHECK(!predicate.Parse("base.field == 1"));
+    CHECK(!predicate.Parse("obj.this == 1"));
+    CHECK(!predicate.Parse("i = 1"));
+    CHECK(!predicate.Parse("i == 99999999999999999999"));
+}
+
+TEST_CASE("ConditionPredicate::Calculate")
+{
+    bool result = false;
+
+    SECTION("integers")
+    {
+        REQUIRE(Calculate("1000 == 1000", result));
+        CHECK(result);
+        REQUIRE(Calculate("-1 < 0", result));
+        CHECK(result);
+        REQUIRE(Calculate("-1 < 18446744073709551615", result));
+        CHECK(result);
+        REQUIRE(Calculate("18446744073709551615 > -1", result));
+        CHECK(result);
+        REQUIRE(Calculate("5 <= 4", result));
+        CHECK(!result);
+        REQUIRE(Calculate("'a' == 97", result));
+        CHECK(result);
+    }
+
+    SECTION("reals")
+    {
+        REQUIRE(Calculate("1.5 > 1", result));
+        CHECK(result);
+        REQUIRE(Calculate("2 != 2.0", result));
+        CHECK(!result);
+
+        const value_t nan = value_t::Real(std::numeric_limits<double>::quiet_NaN());
+        const value_t zero = value_t::Real(0.0);
+        REQUIRE(Calculate("x == 0.0", result, &nan, &zero));
+        CHECK(!result);
+        REQUIRE(Calculate("x != 0.0", result, &nan, &zero));
+        CHECK(result);
+    }
+
+    SECTION("bools")
+    {
+        REQUIRE(Calculate("true", result));
+        CHECK(result);
+        REQUIRE(Calculate("false != true", result));
+        CHECK(result);
+        CHECK(!Calculate("true < false", result));
+        CHECK(!Calculate("true == 1", result));
+        CHECK(!Calculate("1", result));
+    }
+
+    SECTION("references")
+    {
+        const value_t nullRef = value_t::Reference(true);
+        const value_t objRef = value_t::Reference(false);
+        const value_t nullLiteral = value_t::Null();
+
+        REQUIRE(Calculate("obj == null", result, &nullRef, &nullLiteral));
+        CHECK(result);
+        REQUIRE(Calculate("obj != null", result, &objRef, &nullLiteral));
+        CHECK(result);
+        REQUIRE(Calculate("null == obj", result, &nullLiteral, &objRef));
+        CHECK(!result);
+        CHECK(!Calculate("obj1 == obj2", result, &objRef, &objRef));
+        CHECK(!Calculate("obj < null", result, &objRef, &nullLiteral));
+        CHECK(!Calculate("null == 0", result));
+    }
+
+    SECTION("logical operations")
+    {
+        REQUIRE(Calculate("1 == 1 && 2 > 1", result));
+        CHECK(result);
+        REQUIRE(Calculate("1 == 1 && 2 < 1", result));
+        CHECK(!result);
+        REQUIRE(Calculate("1 == 2 || true", result));
+        CHECK(result);
+        REQUIRE(Calculate("false || 1 > 2", result));
+        CHECK(!result);
+        // Short-circuit, second comparison is not calculated.
+        REQUIRE(Calculate("false && null == 0", result));
+        CHECK(!result);
+        REQUIRE(Calculate("true || null == 0", result));
+        CHECK(result);
+        CHECK(!Calculate("true && null == 0", result));
+    }
+
+    SECTION("not supported values")
+    {
+        const value_t none;
+        const value_t one = value_t::Signed(1);
+        CHECK(!Calculate("s == 1", result, &none, &one));
+        CHECK(!Calculate("flag", result, &none));
+    }
+}
+
+TEST_CASE("ConditionPredicatesCache::GetPredicate")
+{
+    ConditionPredicatesCache cache;
+
+    auto predicate = cache.GetPredicate("i == 1");
+    REQUIRE(predicate != nullptr);
+    CHECK(cache.GetPredicate("i == 1") == predicate);
+
+    CHECK(cache.GetPredicate("i + 1 == 2") == nullptr);
+    CHECK(cache.GetPredicate("i + 1 == 2") == nullptr);
+
+    cache.Clear();
+    auto newPredicate = cache.GetPredicate("i == 1");
+    REQUIRE(newPredicate != nullptr);
+    CHECK(newPredicate != predicate);
+}
@@ -0,0 +1,219 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "debugger/coredump.h"
+
+using ::netcoredbg::CoreDump;
+
+namespace
+{
+
+    void Put(std::string &out, size_t offset, const void *data, size_t size)
+    {
+        if (out.size() < offset + size)
+            out.resize(offset + size);
+        memcpy(&out[offset], data, size);
+    }
+
+    template <class T>
+    void Put(std::string &out, size_t offset, T value)
+    {
+        Put(out, offset, &value, sizeof(T));
+    }
+
+    std::string Note(uint32_t type, const std::string &desc)
+    {
+        std::string note;
+        Put<uint32_t>(note, 0, 5);
+        Put<uint32_t>(note, 4, (uint32_t)desc.size());
+        Put<uint32_t>(note, 8, type);
+        Put(note, 12, "CORE\0\0\0", 8);
+        note += desc;
+        note.resize((note.size() + 3) & ~size_t(3));
+        return note;
+    }
+
+    struct Segment
+    {
+        uint64_t vaddr;
+        std::string data;
+        uint64_t memSize;
+    };
+
+    // Build ELF64 core file with one PT_NOTE and PT_LOAD for each segment.
+    std::string MakeCore(const std::string &notes, const std::vector<Segment> &segments, uint16_t type = 4)
+    {
+        std::string core;
+        Put(core, 0, "\x7f" "ELF\x02\x01\x01", 7);
+        Put<uint16_t>(core, 16, type);
+        Put<uint16_t>(core, 18, 62); // EM_X86_64
+        Put<uint64_t>(core, 32, 64); // e_phoff
+        Put<uint16_t>(core, 52, 64);
+        Put<uint16_t>(core, 54, 56);
+        Put<uint16_t>(core, 56, (uint16_t)(segments.size() + 1));
+
+        size_t dataOffset = 64 + 56 * (segments.size() + 1);
+        Put<uint32_t>(core, 64, 4); // PT_NOTE
+        Put<uint64_t>(core, 64 + 8, dataOffset);
+        Put<uint64_t>(core, 64 + 32, notes.size());
+        Put(core, dataOffset, notes.data(), notes.size());
+        dataOffset += notes.size();
+
+        for (size_t i = 0; i < segments.size(); i++)
+        {
+            const size_t phdr = 64 + 56 * (i + 1);
+            Put<uint32_t>(core, phdr, 1); // PT_LOAD
+            Put<uint64_t>(core, phdr + 8, dataOffset);
+            Put<uint64_t>(core, phdr + 16, segments[i].vaddr);
+            Put<uint64_t>(core, phdr + 32, segments[i].data.size());
+            Put<uint64_t>(core, phdr + 40, segments[i].memSize);
+            Put(core, dataOffset, segments[i].data.data(), segments[i].data.size());
+            dataOffset += segments[i].data.size();
+        }
+        return core;
+    }
+
+    std::string Prstatus(uint32_t tid, const std::string &regs)
+    {
+        std::string desc(112, '\0');
+        Put<uint32_t>(desc, 32, tid);
+        return desc + regs;
+    }
+
+    std::string NtFile(const std::vector<CoreDump::Mapping> &mappings, uint64_t pageSize)
+    {
+        std::string desc;
+        Put<uint64_t>(desc, 0, mappings.size());
+        Put<uint64_t>(desc, 8, pageSize);
+        for (size_t i = 0; i < mappings.size(); i++)
+        {
+            Put<uint64_t>(desc, 16 + i * 24, mappings[i].start);
+            Put<uint64_t>(desc, 16 + i * 24 + 8, mappings[i].end);
+            Put<uint64_t>(desc, 16 + i * 24 + 16, mappings[i].fileOffset / pageSize);
+        }
+        for (const auto &mapping : mappings)
+            desc.append(mapping.path.c_str(), mapping.path.size() + 1);
+        return desc;
+    }
+
+    struct TempFile
+    {
+        std::string path;
+
+        TempFile(const std::string &name, const std::string &content)
+        {
+            path = std::string(P_tmpdir) + "/netcoredbg_coredump_test_" + name;
+            FILE *file = fopen(path.c_str(), "wb");
+            REQUIRE(file != nullptr);
+            fwrite(content.data(), 1, content.size(), file);
+            fclose(file);
+        }
+
+        ~TempFile() { remove(path.c_str()); }
+    };
+
+} // unnamed namespace
+
+TEST_CASE("CoreDump::Open")
+{
+    std::string error;
+
+    SECTION("not existing file")
+    {
+        CoreDump dump;
+        CHECK(!dump.Open("/not/existing/core", error));
+    }
+
+    SECTION("not ELF file")
+    {
+        TempFile file("not_elf", std::string(128, 'x'));
+        CoreDump dump;
+        CHECK(!dump.Open(file.path, error));
+        CHECK(error == "not ELF file");
+    }
+
+    SECTION("not core")
+    {
+        TempFile file("not_core", MakeCore(Note(1, Prstatus(1, "")), {}, 2 /*ET_EXEC*/));
+        CoreDump dump;
+        CHECK(!dump.Open(file.path, error));
+        CHECK(error == "not core dump");
+    }
+
+    SECTION("no threads")
+    {
+        TempFile file("no_threads", MakeCore(std::string(), {}));
+        CoreDump dump;
+        CHECK(!dump.Open(file.path, error));
+        CHECK(error == "no threads in dump");
+    }
+}
+
+TEST_CASE("CoreDump threads and memory")
+{
+    const std::string moduleContent = "0123456789abcdef";
+    TempFile module("module.so", moduleContent);
+
+    std::vector<CoreDump::Mapping> mappings;
+    mappings.push_back({0x20000, 0x20010, 0, module.path});
+    mappings.push_back({0x30000, 0x30008, 8, module.path});
+
+    const std::string notes = Note(1, Prstatus(100, "REGS1234")) +
+                              Note(1, Prstatus(101, "REGS5678")) +
+                              Note(0x46494c45, NtFile(mappings, 4));
+    std::vector<Segment> segments;
+    segments.push_back({0x10000, "ABCDEFGH", 8});
+    segments.push_back({0x10008, "IJKL", 4});
+    segments.push_back({0x20000, "", 0x10}); // not dumped file backed memory
+    TempFile core("core", MakeCore(notes, segments));
+
+    CoreDump dump;
+    std::string error;
+    REQUIRE(dump.Open(core.path, error));
+    CHECK(dump.Machine() == 62);
+
+    REQUIRE(dump.Threads().size() == 2);
+    CHECK(dump.Threads()[0].tid == 100);
+    CHECK(std::string(dump.Threads()[0].registers.begin(), dump.Threads()[0].registers.end()) == "REGS1234");
+    CHECK(dump.Threads()[1].tid == 101);
+
+    char buffer[32] = {0};
+    SECTION("segments")
+    {
+        CHECK(dump.ReadMemory(0x10002, buffer, 4) == 4);
+        CHECK(std::string(buffer, 4) == "CDEF");
+        // Read cross segments border.
+        CHECK(dump.ReadMemory(0x10006, buffer, 4) == 4);
+        CHECK(std::string(buffer, 4) == "GHIJ");
+        // Partial read at the end of available memory.
+        CHECK(dump.ReadMemory(0x1000A, buffer, 8) == 2);
+        CHECK(std::string(buffer, 2) == "KL");
+        CHECK(dump.ReadMemory(0x5000, buffer, 4) == 0);
+    }
+
+    SECTION("mapped files")
+    {
+        CHECK(dump.ReadMemory(0x20004, buffer, 4) == 4);
+        CHECK(std::string(buffer, 4) == "4567");
+        CHECK(dump.ReadMemory(0x30000, buffer, 16) == 8);
+        CHECK(std::string(buffer, 8) == "89abcdef");
+    }
+
+    SECTION("module base")
+    {
+        uint64_t base = 0;
+        std::string path;
+        const std::string fileName = module.path.substr(module.path.rfind('/') + 1);
+        REQUIRE(dump.FindModuleBase(fileName, base, path));
+        CHECK(base == 0x20000);
+        CHECK(path == module.path);
+        CHECK(!dump.FindModuleBase("le.so", base, path));
+        CHECK(!dump.FindModuleBase("libcoreclr.so", base, path));
+    }
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+#include "protocols/enginelog.h"
+
+using ::netcoredbg::EngineLogWriter;
+using ::netcoredbg::DecodeEngineLog;
+
+typedef EngineLogWriter::Direction Direction;
+
+namespace
+{
+
+    std::unique_ptr<std::ostream> MakeStream(std::stringbuf &buf)
+    {
+        return std::unique_ptr<std::ostream>(new std::ostream(&buf));
+    }
+
+    std::string Decode(const std::string &data, bool &result)
+    {
+        std::istringstream input(data);
+        std::ostringstream output;
+        result = DecodeEngineLog(input, output);
+        return output.str();
+    }
+
+    // Remove "YYYY-MM-DD HH:MM:SS.uuuuuu " prefix of each line.
+    std::string StripTime(const std::string &text)
+    {
+        static const size_t timeLength = 27;
+        std::istringstream input(text);
+        std::string result;
+        std::string line;
+        while (std::getline(input, line))
+        {
+            result += line.size() > timeLength ? line.substr(timeLength) : std::string();
+            result += '\n';
+        }
+        return result;
+    }
+
+} // unnamed namespace
+
+TEST_CASE("EngineLog write and decode")
+{
+    std::stringbuf buf;
+    {
+        EngineLogWriter writer(MakeStream(buf));
+        static const std::string command = "{\"command\":\"initialize\",\"seq\":1,\"type\":\"request\"}";
+        static const std::string response = "{\"request_seq\":1,\"success\":true,\"type\":\"response\"}";
+        static const std::string event = "{\"event\":\"initialized\",\"type\":\"event\"}";
+        writer.Write(Direction::Command, command.data(), command.size());
+        writer.Write(Direction::Response, response.data(), response.size());
+        writer.Flush();
+        CHECK(buf.str().size() == EngineLogWriter::HeaderSize + EngineLogWriter::RecordHeaderSize * 2 + command.size() + response.size());
+        writer.Write(Direction::Event, event.data(), event.size());
+        writer.Write(Direction::Request, "", 0);
+    }
+
+    bool result = false;
+    std::string text = Decode(buf.str(), result);
+    CHECK(result);
+    CHECK(text.compare(0, 2, "20") == 0);
+    CHECK(StripTime(text) ==
+        "-> (C) {\"command\":\"initialize\",\"seq\":1,\"type\":\"request\"}\n"
+        "<- (R) {\"request_seq\":1,\"success\":true,\"type\":\"response\"}\n"
+        "<- (E) {\"event\":\"initialized\",\"type\":\"event\"}\n"
+        "<- (Q) \n");
+
+    // Truncated record (last empty record and last byte of event).
+    text = Decode(buf.str().substr(0, buf.str().size() - EngineLogWriter::RecordHeaderSize - 1), result);
+    CHECK(!result);
+    CHECK(StripTime(text).find("initialized") == std::string::npos);
+    CHECK(StripTime(text).find("initialize\"") != std::string::npos);
+
+    // Wrong header.
+    Decode("NOTALOG0\x01\x00\x00\x00", result);
+    CHECK(!result);
+}
+
+TEST_CASE("EngineLog dropped records")
+{
+    std::stringbuf buf;
+    const std::string big(100, 'x');
+    uint64_t dropped = 0;
+    {
+        // Note, buffer for one record only, worker is not able to write anything before Flush() call.
+        EngineLogWriter writer(MakeStream(buf), EngineLogWriter::RecordHeaderSize + big.size());
+        writer.Write(Direction::Event, big.data(), big.size());
+        writer.Write(Direction::Event, big.data(), big.size());
+        dropped = writer.GetDroppedCount();
+        writer.Flush();
+        writer.Write(Direction::Event, "y", 1);
+        writer.Flush();
+    }
+
+    bool result = false;
+    std::string text = StripTime(Decode(buf.str(), result));
+    CHECK(result);
+    // Note, second record could be written in case worker wake up between writes.
+    if (dropped == 1)
+        CHECK(text == "<- (E) " + big + "\n!! dropped 1 records\n<- (E) y\n");
+    else
+        CHECK(text == "<- (E) " + big + "\n<- (E) " + big + "\n<- (E) y\n");
+}
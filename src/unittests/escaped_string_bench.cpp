@@ -0,0 +1,95 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+// Benchmarks are hidden, run them explicitly: `escaped_string [benchmark]`.
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <string>
+#include "utils/string_view.h"
+#include "protocols/escaped_string.h"
+#include "benchmark.h"
+
+using namespace netcoredbg;
+using string_view = Utility::string_view;
+
+namespace
+{
+    struct JsonRules
+    {
+        static const char forbidden_chars[];
+        static const string_view subst_chars[];
+        static const char constexpr escape_char = '\\';
+    };
+
+    const char JsonRules::forbidden_chars[] =
+    "\"\\"
+    "\000\001\002\003\004\005\006\007\010\011\012\013\014\015\016\017"
+    "\020\021\022\023\024\025\026\027\030\031\032\033\034\035\036\037";
+
+    const string_view JsonRules::subst_chars[] = {
+        "\\\"", "\\\\",
+        "\\u0000", "\\u0001", "\\u0002", "\\u0003", "\\u0004", "\\u0005", "\\u0006", "\\u0007",
+        "\\b", "\\t", "\\n", "\\u000b", "\\f", "\\r", "\\u000e", "\\u000f",
+        "\\u0010", "\\u0011", "\\u0012", "\\u0013", "\\u0014", "\\u0015", "\\u0016", "\\u0017",
+        "\\u0018", "\\u0019", "\\u001a", "\\u001b", "\\u001c", "\\u001d", "\\u001e", "\\u001f"
+    };
+
+    // Typical debuggee console output: text lines with rare quotes.
+    std::string MakeText(size_t size)
+    {
+        static const char line[] = "[12:34:56.789] Processing item \"name\" with value 12345 at C:\\path\\file.cs\n";
+        std::string result;
+        while (result.size() < size)
+        {
+            result.append(line);
+        }
+        result.resize(size);
+        return result;
+    }
+
+    template <typename Func>
+    void Measure(const char *name, size_t bytes, Func &&func)
+    {
+        static const int Iterations = 200;
+        size_t check = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < Iterations; i++)
+        {
+            check += func();
+        }
+        Benchmark::Report(name, Iterations, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start), bytes);
+        CHECK(check != 0);
+    }
+}
+
+TEST_CASE("EscapedString benchmark", "[.][benchmark]")
+{
+    using namespace EscapedStringInternal;
+
+    const ScanTable table(string_view(JsonRules::forbidden_chars));
+    const std::string clean(1024 * 1024, 'x');
+    const std::string text = MakeText(1024 * 1024);
+
+    Measure("FindForbidden, clean text", clean.size(), [&]() {
+        return size_t(FindForbidden(table, clean.data(), clean.data() + clean.size()) - clean.data());
+    });
+    Measure("FindForbiddenScalar, clean text", clean.size(), [&]() {
+        return size_t(FindForbiddenScalar(table, clean.data(), clean.data() + clean.size()) - clean.data());
+    });
+
+    Measure("EscapedString size, console text", text.size(), [&]() {
+        return EscapedString<JsonRules>(text).size();
+    });
+    Measure("EscapedString output, console text", text.size(), [&]() {
+        size_t size = 0;
+        EscapedString<JsonRules>{text}([&](string_view str) { size += str.size(); });
+        return size;
+    });
+    Measure("EscapedString output, clean text", clean.size(), [&]() {
+        size_t size = 0;
+        EscapedString<JsonRules>{clean}([&](string_view str) { size += str.size(); });
+        return size;
+    });
+}
@@ -2,6 +2,8 @@
 // See the LICENSE file in the project root for more information.
 
 #include <catch2/catch.hpp>
+#include <algorithm>
+#include <random>
 #include <string>
 #include "utils/string_view.h"
 #include "protocols/escaped_string.h"
@@ -51,3 +53,94 @@ TEST_CASE("EscapedString")
     CHECK(result == "aaa\\nbbb");
 }
 
+
+namespace
+{
+    // Rules with too many printable forbidden characters for vectorized scanner.
+    struct WideEscapeRules
+    {
+        static const char forbidden_chars[];
+        static const string_view subst_chars[];
+        static const char constexpr escape_char = '\\';
+    };
+
+    const char WideEscapeRules::forbidden_chars[] = "abcde\n\x80";
+    const string_view WideEscapeRules::subst_chars[] {
+        "\\A", "\\B", "\\C", "\\D", "\\E", "\\n", "\\x80"
+    };
+
+    // Reference implementation of escaping.
+    template <typename Rules>
+    std::string Escape(string_view str)
+    {
+        string_view forbidden(Rules::forbidden_chars);
+        std::string result;
+        for (char c : str)
+        {
+            auto it = std::find(forbidden.begin(), forbidden.end(), c);
+            if (it == forbidden.end())
+                result.push_back(c);
+            else
+                result.append(std::string(Rules::subst_chars[it - forbidden.begin()]));
+        }
+        return result;
+    }
+
+    std::string RandomString(std::mt19937 &rng, size_t size, const std::string &alphabet)
+    {
+        std::string result(size, 0);
+        for (auto &c : result)
+        {
+            c = alphabet[rng() % alphabet.size()];
+        }
+        return result;
+    }
+}
+
+TEST_CASE("EscapedStringInternal::ScanTable")
+{
+    using EscapedStringInternal::ScanTable;
+
+    ScanTable table(string_view(EscapeRules::forbidden_chars));
+    CHECK(table.vectorizable);
+    CHECK(table.vectorCharsCount == 2);
+    CHECK(table.index[static_cast<unsigned char>('"')] == 1);
+    CHECK(table.index[static_cast<unsigned char>('\\')] == 2);
+    CHECK(table.index[0] == 3);
+    CHECK(table.index[static_cast<unsigned char>('\v')] == 10);
+    CHECK(table.index[static_cast<unsigned char>('a')] == 0);
+    CHECK(table.index[0x1f] == 0);
+
+    ScanTable wideTable(string_view(WideEscapeRules::forbidden_chars));
+    CHECK(!wideTable.vectorizable);
+}
+
+TEST_CASE("EscapedStringInternal::FindForbidden")
+{
+    using namespace EscapedStringInternal;
+
+    ScanTable table(string_view(EscapeRules::forbidden_chars));
+    ScanTable wideTable(string_view(WideEscapeRules::forbidden_chars));
+
+    // Note, alphabet include control characters, which are not forbidden (candidates for vectorized scanner).
+    const std::string alphabet(std::string("xyzabcde\"\\\n\t\x01\x1f\x7f\x80\xff") + '\0');
+    std::mt19937 rng(12345);
+    for (size_t size = 0; size < 100; size++)
+    {
+        for (int n = 0; n < 20; n++)
+        {
+            // Note, sparse forbidden characters, in order to test long clean runs too.
+            std::string str = RandomString(rng, size, n % 2 ? alphabet : std::string("xyz0123456789") + alphabet[rng() % alphabet.size()]);
+            const char *begin = str.data();
+            const char *end = begin + str.size();
+            for (const char *pos = begin; pos <= end; pos++)
+            {
+                CHECK(FindForbidden(table, pos, end) == FindForbiddenScalar(table, pos, end));
+                CHECK(FindForbidden(wideTable, pos, end) == FindForbiddenScalar(wideTable, pos, end));
+            }
+
+            CHECK(static_cast<const std::string&>(ES(str)) == Escape<EscapeRules>(str));
+            CHECK(static_cast<const std::string&>(EscapedString<WideEscapeRules>(str)) == Escape<WideEscapeRules>(str));
+        }
+    }
+}
@@ -0,0 +1,234 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "debugger/evalarithmetic.h"
+
+using namespace netcoredbg;
+using namespace netcoredbg::EvalArithmetic;
+
+namespace
+{
+    Value FromRaw(BasicTypes type, int64_t data)
+    {
+        Value value;
+        REQUIRE(Value::FromRaw(type, &data, value));
+        return value;
+    }
+
+    Value Calc(OperationType opType, const Value &x, const Value &y, bool checkedContext = false)
+    {
+        Value result;
+        std::string error;
+        REQUIRE(Calculate(opType, x, y, checkedContext, result, error) == Result::Calculated);
+        return result;
+    }
+
+    Value Calc(OperationType opType, const Value &x, bool checkedContext = false)
+    {
+        Value result;
+        std::string error;
+        REQUIRE(Calculate(opType, x, checkedContext, result, error) == Result::Calculated);
+        return result;
+    }
+
+    Result Status(OperationType opType, const Value &x, const Value &y, bool checkedContext = false)
+    {
+        Value result;
+        std::string error;
+        return Calculate(opType, x, y, checkedContext, result, error);
+    }
+
+    std::string Error(OperationType opType, const Value &x, const Value &y, bool checkedContext = false)
+    {
+        Value result;
+        std::string error;
+        CHECK(Calculate(opType, x, y, checkedContext, result, error) == Result::Failed);
+        return error;
+    }
+}
+
+TEST_CASE("EvalArithmetic::Raw")
+{
+    Value value = FromRaw(BasicTypes::TypeSByte, 0xFF);
+    CHECK(value.i == -1);
+    value = FromRaw(BasicTypes::TypeUInt16, 0xFFFF);
+    CHECK(value.i == 0xFFFF);
+    value = FromRaw(BasicTypes::TypeBoolean, 2);
+    CHECK(value.i == 1);
+
+    float f = 1.5f;
+    int64_t data = 0;
+    memcpy(&data, &f, sizeof(f));
+    value = FromRaw(BasicTypes::TypeSingle, data);
+    CHECK(value.d == 1.5);
+
+    data = -1;
+    CHECK(Value::FromInt32(-2).ToRaw(&data));
+    CHECK(data == 0xFFFFFFFE);
+    CHECK(!Value::FromString("a").ToRaw(&data));
+    CHECK(!Value::FromRaw(BasicTypes::TypeString, &data, value));
+}
+
+TEST_CASE("EvalArithmetic::Promotion")
+{
+    Value byte = FromRaw(BasicTypes::TypeByte, 200);
+    Value result = Calc(OperationType::AddExpression, byte, byte);
+    CHECK(result.type == BasicTypes::TypeInt32);
+    CHECK(result.i == 400);
+
+    result = Calc(OperationType::AddExpression, Value::FromUInt32(1), Value::FromInt32(-2));
+    CHECK(result.type == BasicTypes::TypeInt64);
+    CHECK(result.i == -1);
+
+    result = Calc(OperationType::AddExpression, Value::FromUInt32(1), FromRaw(BasicTypes::TypeUInt16, 2));
+    CHECK(result.type == BasicTypes::TypeUInt32);
+
+    result = Calc(OperationType::MultiplyExpression, Value::FromInt32(3), Value::FromDouble(0.5));
+    CHECK(result.type == BasicTypes::TypeDouble);
+    CHECK(result.d == 1.5);
+
+    // Note, int converted to float before comparison.
+    result = Calc(OperationType::EqualsExpression, Value::FromInt32(16777217), Value::FromSingle(16777216.0f));
+    CHECK(result.type == BasicTypes::TypeBoolean);
+    CHECK(result.i == 1);
+
+    result = Calc(OperationType::AddExpression, FromRaw(BasicTypes::TypeChar, 'a'), Value::FromInt32(1));
+    CHECK(result.type == BasicTypes::TypeInt32);
+    CHECK(result.i == 'b');
+
+    // ulong with signed operand is ambiguous in C#.
+    CHECK(Status(OperationType::AddExpression, Value::FromUInt64(1), Value::FromInt32(1)) == Result::NotHandled);
+    CHECK(Calc(OperationType::AddExpression, Value::FromUInt64(1), Value::FromUInt32(1)).type == BasicTypes::TypeUInt64);
+}
+
+TEST_CASE("EvalArithmetic::Integral")
+{
+    const int32_t min32 = std::numeric_limits<int32_t>::min();
+    const int32_t max32 = std::numeric_limits<int32_t>::max();
+    const int64_t max64 = std::numeric_limits<int64_t>::max();
+
+    CHECK(Calc(OperationType::AddExpression, Value::FromInt32(max32), Value::FromInt32(1)).i == min32);
+    CHECK(Calc(OperationType::SubtractExpression, Value::FromUInt32(0), Value::FromUInt32(1)).i == 0xFFFFFFFF);
+    CHECK(Calc(OperationType::MultiplyExpression, Value::FromInt64(max64), Value::FromInt64(2)).i == -2);
+    CHECK(Calc(OperationType::SubtractExpression, Value::FromUInt64(0), Value::FromUInt64(1)).i == -1);
+    CHECK(Calc(OperationType::DivideExpression, Value::FromInt32(-7), Value::FromInt32(2)).i == -3);
+    CHECK(Calc(OperationType::ModuloExpression, Value::FromInt32(-7), Value::FromInt32(2)).i == -1);
+    CHECK(Calc(OperationType::DivideExpression, Value::FromUInt64(~0ull), Value::FromUInt64(2)).i == int64_t(~0ull / 2));
+    CHECK(Calc(OperationType::BitwiseAndExpression, Value::FromInt32(-1), Value::FromUInt32(0xF0)).i == 0xF0);
+    CHECK(Calc(OperationType::ExclusiveOrExpression, Value::FromInt32(5), Value::FromInt32(3)).i == 6);
+    CHECK(Calc(OperationType::LessThanExpression, Value::FromInt32(-1), Value::FromInt64(0)).i == 1);
+    CHECK(Calc(OperationType::LessThanExpression, Value::FromUInt64(1), Value::FromUInt64(~0ull)).i == 1);
+    CHECK(Calc(OperationType::GreaterThanOrEqualExpression, Value::FromUInt32(0xFFFFFFFF), Value::FromInt32(0)).i == 1);
+}
+
+TEST_CASE("EvalArithmetic::Checked")
+{
+    const std::string overflow = "error: Arithmetic operation resulted in an overflow.";
+    const int32_t max32 = std::numeric_limits<int32_t>::max();
+
+    CHECK(Error(OperationType::AddExpression, Value::FromInt32(max32), Value::FromInt32(1), true) == overflow);
+    CHECK(Error(OperationType::SubtractExpression, Value::FromUInt32(0), Value::FromUInt32(1), true) == overflow);
+    CHECK(Error(OperationType::MultiplyExpression, Value::FromInt64(1ll << 32), Value::FromInt64(1ll << 31), true) == overflow);
+    CHECK(Error(OperationType::MultiplyExpression, Value::FromUInt64(1ull << 32), Value::FromUInt64(1ull << 32), true) == overflow);
+    CHECK(Calc(OperationType::MultiplyExpression, Value::FromInt64(-(1ll << 31)), Value::FromInt64(1ll << 32), true).i == std::numeric_limits<int64_t>::min());
+    CHECK(Calc(OperationType::AddExpression, Value::FromInt32(max32 - 1), Value::FromInt32(1), true).i == max32);
+
+    CHECK(Error(OperationType::DivideExpression, Value::FromInt32(1), Value::FromInt32(0)) == "error: Attempted to divide by zero.");
+    CHECK(Error(OperationType::ModuloExpression, Value::FromUInt64(1), Value::FromUInt64(0)) == "error: Attempted to divide by zero.");
+    CHECK(Error(OperationType::DivideExpression, Value::FromInt32(std::numeric_limits<int32_t>::min()), Value::FromInt32(-1)) == overflow);
+
+    Value result;
+    std::string error;
+    CHECK(Calculate(OperationType::UnaryMinusExpression, Value::FromInt32(std::numeric_limits<int32_t>::min()), true, result, error) == Result::Failed);
+    CHECK(error == overflow);
+    CHECK(Calc(OperationType::UnaryMinusExpression, Value::FromInt32(std::numeric_limits<int32_t>::min())).i == std::numeric_limits<int32_t>::min());
+}
+
+TEST_CASE("EvalArithmetic::FloatingPoint")
+{
+    CHECK(Calc(OperationType::DivideExpression, Value::FromDouble(1), Value::FromInt32(0)).d == std::numeric_limits<double>::infinity());
+    CHECK(Calc(OperationType::ModuloExpression, Value::FromDouble(-5.5), Value::FromDouble(2)).d == -1.5);
+
+    Value nan = Value::FromDouble(std::nan(""));
+    CHECK(Calc(OperationType::EqualsExpression, nan, nan).i == 0);
+    CHECK(Calc(OperationType::NotEqualsExpression, nan, nan).i == 1);
+
+    Value result = Calc(OperationType::AddExpression, Value::FromSingle(0.1f), Value::FromSingle(0.2f));
+    CHECK(result.type == BasicTypes::TypeSingle);
+    CHECK(result.d == double(0.1f + 0.2f));
+
+    CHECK(Status(OperationType::BitwiseAndExpression, Value::FromDouble(1), Value::FromInt32(1)) == Result::NotHandled);
+}
+
+TEST_CASE("EvalArithmetic::Shift")
+{
+    Value result = Calc(OperationType::LeftShiftExpression, FromRaw(BasicTypes::TypeByte, 1), Value::FromInt32(33));
+    CHECK(result.type == BasicTypes::TypeInt32);
+    CHECK(result.i == 2);
+    CHECK(Calc(OperationType::LeftShiftExpression, Value::FromInt32(1), Value::FromInt32(31)).i == std::numeric_limits<int32_t>::min());
+    CHECK(Calc(OperationType::RightShiftExpression, Value::FromInt32(-8), Value::FromInt32(1)).i == -4);
+    CHECK(Calc(OperationType::RightShiftExpression, Value::FromUInt32(0x80000000), Value::FromInt32(31)).i == 1);
+    CHECK(Calc(OperationType::LeftShiftExpression, Value::FromInt64(1), Value::FromInt32(63)).i == std::numeric_limits<int64_t>::min());
+    CHECK(Calc(OperationType::RightShiftExpression, Value::FromUInt64(~0ull), Value::FromInt32(60)).i == 0xF);
+    // Shift count must be convertible to int.
+    CHECK(Status(OperationType::LeftShiftExpression, Value::FromInt32(1), Value::FromInt64(1)) == Result::NotHandled);
+    CHECK(Status(OperationType::LeftShiftExpression, Value::FromDouble(1), Value::FromInt32(1)) == Result::NotHandled);
+}
+
+TEST_CASE("EvalArithmetic::Boolean")
+{
+    Value t = Value::FromBoolean(true);
+    Value f = Value::FromBoolean(false);
+    CHECK(Calc(OperationType::LogicalAndExpression, t, f).i == 0);
+    CHECK(Calc(OperationType::LogicalOrExpression, t, f).i == 1);
+    CHECK(Calc(OperationType::ExclusiveOrExpression, t, t).i == 0);
+    CHECK(Calc(OperationType::EqualsExpression, f, f).i == 1);
+    CHECK(Calc(OperationType::LogicalNotExpression, f).i == 1);
+    CHECK(Status(OperationType::AddExpression, t, t) == Result::NotHandled);
+    CHECK(Status(OperationType::EqualsExpression, t, Value::FromInt32(1)) == Result::NotHandled);
+    CHECK(Status(OperationType::LogicalAndExpression, Value::FromInt32(1), Value::FromInt32(1)) == Result::NotHandled);
+}
+
+TEST_CASE("EvalArithmetic::Unary")
+{
+    Value result = Calc(OperationType::UnaryMinusExpression, Value::FromUInt32(1));
+    CHECK(result.type == BasicTypes::TypeInt64);
+    CHECK(result.i == -1);
+
+    result = Calc(OperationType::UnaryPlusExpression, FromRaw(BasicTypes::TypeInt16, 0xFFFF));
+    CHECK(result.type == BasicTypes::TypeInt32);
+    CHECK(result.i == -1);
+
+    CHECK(Calc(OperationType::BitwiseNotExpression, Value::FromUInt32(0)).i == 0xFFFFFFFF);
+    CHECK(Calc(OperationType::BitwiseNotExpression, FromRaw(BasicTypes::TypeByte, 0)).i == -1);
+    CHECK(Calc(OperationType::UnaryMinusExpression, Value::FromDouble(2)).d == -2);
+
+    Value ignored;
+    std::string error;
+    CHECK(Calculate(OperationType::UnaryMinusExpression, Value::FromUInt64(1), false, ignored, error) == Result::NotHandled);
+    CHECK(Calculate(OperationType::BitwiseNotExpression, Value::FromDouble(1), false, ignored, error) == Result::NotHandled);
+    CHECK(Calculate(OperationType::LogicalNotExpression, Value::FromInt32(1), false, ignored, error) == Result::NotHandled);
+}
+
+TEST_CASE("EvalArithmetic::String")
+{
+    Value result = Calc(OperationType::AddExpression, Value::FromString("a"), Value::FromInt32(-1));
+    CHECK(result.type == BasicTypes::TypeString);
+    CHECK(result.s == "a-1");
+    CHECK(Calc(OperationType::AddExpression, Value::FromBoolean(true), Value::FromString("")).s == "True");
+    CHECK(Calc(OperationType::AddExpression, Value::FromString(""), Value::FromUInt64(~0ull)).s == "18446744073709551615");
+    CHECK(Calc(OperationType::AddExpression, Value::FromString("x"), FromRaw(BasicTypes::TypeChar, 0x416)).s == "x\xD0\x96");
+    CHECK(Calc(OperationType::EqualsExpression, Value::FromString("a"), Value::FromString("a")).i == 1);
+    CHECK(Calc(OperationType::NotEqualsExpression, Value::FromString("a"), Value::FromString("A")).i == 1);
+
+    // Floating point formatting is left for managed part.
+    CHECK(Status(OperationType::AddExpression, Value::FromString("a"), Value::FromDouble(1)) == Result::NotHandled);
+    CHECK(Status(OperationType::AddExpression, Value::FromString("a"), FromRaw(BasicTypes::TypeChar, 0xD800)) == Result::NotHandled);
+    CHECK(Status(OperationType::LessThanExpression, Value::FromString("a"), Value::FromString("b")) == Result::NotHandled);
+    CHECK(Status(OperationType::EqualsExpression, Value::FromString("1"), Value::FromInt32(1)) == Result::NotHandled);
+}
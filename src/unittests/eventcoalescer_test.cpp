@@ -0,0 +1,151 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "protocols/eventcoalescer.h"
+
+using ::netcoredbg::EventCoalescer;
+
+namespace
+{
+    struct Output
+    {
+        std::mutex mutex;
+        std::vector<std::vector<EventCoalescer::Event>> batches;
+
+        EventCoalescer::FlushCallback Callback()
+        {
+            return [this](const std::vector<EventCoalescer::Event> &events)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                batches.push_back(events);
+            };
+        }
+
+        size_t Size()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return batches.size();
+        }
+    };
+}
+
+TEST_CASE("EventCoalescer batches events")
+{
+    Output output;
+    EventCoalescer coalescer(output.Callback());
+    EventCoalescer::Options options;
+    options.windowMs = 10000;
+    coalescer.SetOptions(options);
+
+    coalescer.Add("module", "1");
+    coalescer.Add("module", "2");
+    coalescer.Add("breakpoint", "3");
+    CHECK(output.Size() == 0);
+    coalescer.Flush();
+
+    REQUIRE(output.batches.size() == 1);
+    REQUIRE(output.batches[0].size() == 3);
+    CHECK(output.batches[0][0].name == "module");
+    CHECK(output.batches[0][0].body == "1");
+    CHECK(output.batches[0][1].body == "2");
+    CHECK(output.batches[0][2].name == "breakpoint");
+    CHECK(output.batches[0][2].body == "3");
+
+    // Nothing pending.
+    coalescer.Flush();
+    CHECK(output.batches.size() == 1);
+}
+
+TEST_CASE("EventCoalescer replaces events with same key")
+{
+    Output output;
+    EventCoalescer coalescer(output.Callback());
+    EventCoalescer::Options options;
+    options.windowMs = 10000;
+    coalescer.SetOptions(options);
+
+    coalescer.Add("breakpoint", "bp1 changed A", "bp:1");
+    coalescer.Add("module", "module new");
+    coalescer.Add("breakpoint", "bp2 changed", "bp:2");
+    coalescer.Add("breakpoint", "bp1 changed B", "bp:1");
+    coalescer.Flush();
+
+    CHECK(coalescer.GetReplacedCount() == 1);
+    REQUIRE(output.batches.size() == 1);
+    REQUIRE(output.batches[0].size() == 3);
+    CHECK(output.batches[0][0].body == "bp1 changed B");
+    CHECK(output.batches[0][1].body == "module new");
+    CHECK(output.batches[0][2].body == "bp2 changed");
+
+    // Keys are not kept after flush.
+    coalescer.Add("breakpoint", "bp1 changed C", "bp:1");
+    coalescer.Flush();
+    REQUIRE(output.batches.size() == 2);
+    REQUIRE(output.batches[1].size() == 1);
+    CHECK(output.batches[1][0].body == "bp1 changed C");
+    CHECK(coalescer.GetReplacedCount() == 1);
+}
+
+TEST_CASE("EventCoalescer flushes by time window and batch size")
+{
+    Output output;
+    EventCoalescer coalescer(output.Callback());
+    EventCoalescer::Options options;
+    options.windowMs = 5;
+    options.batchSize = 3;
+    coalescer.SetOptions(options);
+
+    coalescer.Add("module", "1");
+    for (int i = 0; i < 200 && output.Size() == 0; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    REQUIRE(output.Size() == 1);
+    CHECK(output.batches[0].size() == 1);
+
+    options.windowMs = 10000;
+    coalescer.SetOptions(options);
+    coalescer.Add("module", "2");
+    coalescer.Add("module", "3");
+    CHECK(output.Size() == 1);
+    coalescer.Add("module", "4");
+    REQUIRE(output.Size() == 2);
+    CHECK(output.batches[1].size() == 3);
+}
+
+TEST_CASE("EventCoalescer without window")
+{
+    Output output;
+    EventCoalescer coalescer(output.Callback());
+    EventCoalescer::Options options;
+    options.windowMs = 0;
+    coalescer.SetOptions(options);
+
+    coalescer.Add("module", "1");
+    coalescer.Add("module", "2", "m:1");
+    coalescer.Add("module", "3", "m:1");
+    REQUIRE(output.batches.size() == 3);
+    CHECK(output.batches[2][0].body == "3");
+    CHECK(coalescer.GetReplacedCount() == 0);
+}
+
+TEST_CASE("EventCoalescer flushes at destruction")
+{
+    Output output;
+    {
+        EventCoalescer coalescer(output.Callback());
+        EventCoalescer::Options options;
+        options.windowMs = 10000;
+        coalescer.SetOptions(options);
+        coalescer.Add("module", "1");
+    }
+    REQUIRE(output.batches.size() == 1);
+    CHECK(output.batches[0][0].body == "1");
+}
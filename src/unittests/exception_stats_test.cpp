@@ -0,0 +1,111 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "debugger/exception_stats.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    typedef ExceptionStats::exc_key_t exc_key_t;
+    typedef ExceptionStats::entry_t entry_t;
+
+    uint64_t GetCount(const std::vector<entry_t> &entries, const exc_key_t &key)
+    {
+        auto find = std::find_if(entries.begin(), entries.end(), [&](const entry_t &entry) { return entry.key == key; });
+        return find == entries.end() ? 0 : find->count;
+    }
+}
+
+TEST_CASE("ExceptionStats::Aggregation")
+{
+    ExceptionStats stats;
+    const exc_key_t first(1, 0x02000010, 2, 0x06000001, 10);
+    const exc_key_t second(1, 0x02000010, 2, 0x06000001, 12); // same type and method, other IL offset
+    const exc_key_t native(1, 0x02000011, 0, 0, 0);
+
+    CHECK(stats.Add(first));
+    CHECK(stats.Add(first));
+    CHECK(stats.Add(second));
+    CHECK(stats.Add(native));
+
+    std::vector<entry_t> entries;
+    stats.GetEntries(entries, false);
+    CHECK(entries.size() == 3);
+    CHECK(GetCount(entries, first) == 2);
+    CHECK(GetCount(entries, second) == 1);
+    CHECK(GetCount(entries, native) == 1);
+
+    // Reset drop counts, entries with zero count are not provided.
+    entries.clear();
+    stats.GetEntries(entries, true);
+    CHECK(entries.size() == 3);
+    entries.clear();
+    stats.GetEntries(entries, false);
+    CHECK(entries.empty());
+
+    CHECK(stats.Add(second));
+    entries.clear();
+    stats.GetEntries(entries, false);
+    CHECK(entries.size() == 1);
+    CHECK(GetCount(entries, second) == 1);
+}
+
+TEST_CASE("ExceptionStats::Capacity")
+{
+    ExceptionStats stats;
+    for (uint32_t i = 0; i < ExceptionStats::Capacity; i++)
+    {
+        REQUIRE(stats.Add(exc_key_t(1, 0x02000001, 1, 0x06000001, i)));
+    }
+
+    CHECK(!stats.Add(exc_key_t(1, 0x02000001, 1, 0x06000001, ExceptionStats::Capacity)));
+    CHECK(stats.GetDroppedCount() == 1);
+    // Already known throw-site is still counted.
+    CHECK(stats.Add(exc_key_t(1, 0x02000001, 1, 0x06000001, 0)));
+
+    std::vector<entry_t> entries;
+    stats.GetEntries(entries, true);
+    CHECK(entries.size() == ExceptionStats::Capacity);
+    CHECK(stats.GetDroppedCount() == 0);
+}
+
+TEST_CASE("ExceptionStats::Concurrent")
+{
+    ExceptionStats stats;
+    const unsigned threadsCount = 4;
+    const uint32_t keysCount = 64;
+    const unsigned repeats = 1000;
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < threadsCount; t++)
+    {
+        threads.emplace_back([&]()
+        {
+            for (unsigned r = 0; r < repeats; r++)
+            {
+                for (uint32_t k = 0; k < keysCount; k++)
+                {
+                    stats.Add(exc_key_t(1, 0x02000001 + k, 2, 0x06000001, k));
+                }
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<entry_t> entries;
+    stats.GetEntries(entries, false);
+    REQUIRE(entries.size() == keysCount);
+    for (const entry_t &entry : entries)
+    {
+        CHECK(entry.count == threadsCount * repeats);
+    }
+}
@@ -0,0 +1,45 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include "metadata/fuzzy_match.h"
+
+namespace FuzzyMatch = ::netcoredbg::FuzzyMatch;
+using ::netcoredbg::Utility::string_view;
+
+namespace
+{
+
+    int Score(const char *pattern, const char *name)
+    {
+        return FuzzyMatch::Score(string_view(pattern), string_view(name));
+    }
+
+} // unnamed namespace
+
+TEST_CASE("FuzzyMatch::Subsequence")
+{
+    CHECK(Score("", "Program.cs") == 0);
+    CHECK(Score("mpcs", "MainProgram.cs") != FuzzyMatch::NoMatch);
+    CHECK(Score("MainPg", "MainProgram.cs") != FuzzyMatch::NoMatch);
+    CHECK(Score("PROGRAM", "program.cs") != FuzzyMatch::NoMatch);
+    CHECK(Score("prgx", "Program.cs") == FuzzyMatch::NoMatch);
+    CHECK(Score("sc", "cs") == FuzzyMatch::NoMatch);
+    CHECK(Score("Program.cs.bak", "Program.cs") == FuzzyMatch::NoMatch);
+}
+
+TEST_CASE("FuzzyMatch::Ranking")
+{
+    // Word starts before characters inside words.
+    CHECK(Score("pc", "ProgramCache.cs") > Score("pc", "Epic.cs"));
+    // Contiguous characters before scattered.
+    CHECK(Score("prog", "Program.cs") > Score("prog", "PeerRouting.cs"));
+    // Name start before word start.
+    CHECK(Score("cache", "Cache.cs") > Score("cache", "SourceCache.cs"));
+    // Best match is found even if greedy match is worse: "c" should be matched at "Cache", not at "Source".
+    CHECK(Score("sc", "SourceCache.cs") > Score("sc", "Sources.txt"));
+    // Separators and digits start words.
+    CHECK(Score("t2", "test_2.cs") > Score("t2", "t12.cs"));
+    CHECK(Score("t2", "test2.cs") > Score("t2", "t12.cs"));
+}
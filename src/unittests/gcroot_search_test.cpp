@@ -0,0 +1,104 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <map>
+#include <vector>
+#include "debugger/gcroot_search.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    typedef std::map<uint64_t, std::vector<uint64_t>> graph_t;
+
+    GCRootSearch::ReferencesCallback GetReferences(const graph_t &graph)
+    {
+        return [&graph](uint64_t address, std::vector<uint64_t> &references)
+        {
+            auto find = graph.find(address);
+            if (find != graph.end())
+                references = find->second;
+            return true;
+        };
+    }
+}
+
+TEST_CASE("GCRootSearch::ShortestPath")
+{
+    // Two paths from root 1 to 0x1050: via 0x1010 -> 0x1020 -> 0x1030 and shorter via 0x1040.
+    // Cycle 0x1020 <-> 0x1010 must not hang search, 0x9000 is out of segments.
+    graph_t graph;
+    graph[0x1000] = { 0x1010, 0x9000 };
+    graph[0x1010] = { 0x1020 };
+    graph[0x1020] = { 0x1010, 0x1030 };
+    graph[0x1030] = { 0x1050 };
+    graph[0x9000] = { 0x1040 };
+    graph[0x1040] = { 0x1050 };
+    graph[0x2000] = { 0x2010 };
+
+    GCRootSearch search(8, 1024 * 1024);
+    search.AddSegment(0x2000, 0x3000);
+    search.AddSegment(0x1000, 0x2000);
+    search.AddRoot(7, 0x2000);
+    search.AddRoot(1, 0x1000);
+
+    uint32_t rootId = 0;
+    std::vector<uint64_t> path;
+    REQUIRE(search.Find(0x1050, GetReferences(graph), rootId, path) == GCRootSearch::Result::Found);
+    CHECK(rootId == 1);
+    CHECK(path == std::vector<uint64_t>({ 0x1000, 0x9000, 0x1040, 0x1050 }));
+}
+
+TEST_CASE("GCRootSearch::RootAndNotFound")
+{
+    graph_t graph;
+    graph[0x1000] = { 0x1010 };
+    graph[0x1010] = { 0x1000 };
+
+    uint32_t rootId = 0;
+    std::vector<uint64_t> path;
+
+    GCRootSearch rootTarget(8, 1024 * 1024);
+    rootTarget.AddSegment(0x1000, 0x2000);
+    rootTarget.AddRoot(3, 0x1010);
+    REQUIRE(rootTarget.Find(0x1010, GetReferences(graph), rootId, path) == GCRootSearch::Result::Found);
+    CHECK(rootId == 3);
+    CHECK(path == std::vector<uint64_t>({ 0x1010 }));
+
+    GCRootSearch garbage(8, 1024 * 1024);
+    garbage.AddSegment(0x1000, 0x2000);
+    garbage.AddRoot(3, 0x1000);
+    CHECK(garbage.Find(0x1020, GetReferences(graph), rootId, path) == GCRootSearch::Result::NotFound);
+}
+
+TEST_CASE("GCRootSearch::Limits")
+{
+    // Long chain of objects.
+    graph_t graph;
+    for (uint64_t i = 0; i < 10000; i++)
+    {
+        graph[0x100000 + i * 8] = { 0x100000 + (i + 1) * 8 };
+    }
+
+    uint32_t rootId = 0;
+    std::vector<uint64_t> path;
+
+    GCRootSearch search(8, 1024 * 1024);
+    search.AddSegment(0x100000, 0x200000);
+    search.AddRoot(0, 0x100000);
+    REQUIRE(search.Find(0x100000 + 9999 * 8, GetReferences(graph), rootId, path) == GCRootSearch::Result::Found);
+    CHECK(path.size() == 10000);
+
+    GCRootSearch limited(8, 16 * 1024);
+    limited.AddSegment(0x100000, 0x200000);
+    limited.AddRoot(0, 0x100000);
+    CHECK(limited.Find(0x100000 + 9999 * 8, GetReferences(graph), rootId, path) == GCRootSearch::Result::MemoryLimit);
+
+    GCRootSearch aborted(8, 1024 * 1024);
+    aborted.AddSegment(0x100000, 0x200000);
+    aborted.AddRoot(0, 0x100000);
+    CHECK(aborted.Find(0x100000 + 9999 * 8, [](uint64_t, std::vector<uint64_t> &) { return false; }, rootId, path) ==
+          GCRootSearch::Result::Aborted);
+}
@@ -0,0 +1,122 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "metadata/generic_args.h"
+#include "benchmark.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    // Generic instantiation, as it described by signature: metadata name with arity and arguments.
+    struct TypeNode
+    {
+        std::string name;
+        std::vector<TypeNode> args;
+    };
+
+    // Previous implementation, generic arguments in std::list and name built by std::ostringstream.
+    std::string ConsumeGenericArgsList(const std::string &name, std::list<std::string> &args)
+    {
+        if (args.empty())
+            return name;
+
+        std::size_t offset = name.find_last_not_of("0123456789");
+        if (offset == std::string::npos || offset == name.size() - 1 || name.at(offset) != '`')
+            return name;
+
+        unsigned long numArgs = std::stoul(name.substr(offset + 1));
+        if (numArgs == 0 || numArgs > args.size())
+            return name;
+
+        std::ostringstream ss;
+        ss << name.substr(0, offset);
+        ss << "<";
+        const char *sep = "";
+        while (numArgs--)
+        {
+            ss << sep;
+            sep = ", ";
+            ss << args.front();
+            args.pop_front();
+        }
+        ss << ">";
+        return ss.str();
+    }
+
+    std::string FormatList(const TypeNode &node)
+    {
+        std::list<std::string> args;
+        for (const auto &arg : node.args)
+        {
+            std::string genType = FormatList(arg);
+            std::string genTypeAppendix;
+            args.push_back(genType + genTypeAppendix);
+        }
+        std::string name = node.name;
+        return ConsumeGenericArgsList(name, args);
+    }
+
+    void FormatGenericArgs(const TypeNode &node, std::string &output)
+    {
+        TypePrinter::GenericArgs args;
+        for (const auto &arg : node.args)
+            FormatGenericArgs(arg, args.Add());
+
+        output.clear();
+        output += node.name;
+        args.Consume(output, 0);
+    }
+
+    TypeNode Leaf(const char *name) { return TypeNode{name, {}}; }
+}
+
+TEST_CASE("GenericArgs::Benchmark", "[.benchmark]")
+{
+    // Dictionary<string, List<Tuple<int, int>>>
+    const TypeNode dictionary{"System.Collections.Generic.Dictionary`2", {
+        Leaf("string"),
+        TypeNode{"System.Collections.Generic.List`1", {
+            TypeNode{"System.Tuple`2", { Leaf("int"), Leaf("int") }}
+        }}
+    }};
+    // Func<Dictionary<...>, KeyValuePair<string, Dictionary<...>>, Task<List<Dictionary<...>>>>
+    const TypeNode func{"System.Func`3", {
+        dictionary,
+        TypeNode{"System.Collections.Generic.KeyValuePair`2", { Leaf("string"), dictionary }},
+        TypeNode{"System.Threading.Tasks.Task`1", {
+            TypeNode{"System.Collections.Generic.List`1", { dictionary }}
+        }}
+    }};
+
+    std::string output;
+    FormatGenericArgs(dictionary, output);
+    REQUIRE(output == FormatList(dictionary));
+    REQUIRE(output == "System.Collections.Generic.Dictionary<string, System.Collections.Generic.List<System.Tuple<int, int>>>");
+    FormatGenericArgs(func, output);
+    REQUIRE(output == FormatList(func));
+
+    Benchmark::Measure("TypeName list+ostringstream, Dictionary<,List<Tuple<,>>>", 0, [&]() {
+        return FormatList(dictionary).size();
+    });
+
+    Benchmark::Measure("TypeName GenericArgs, Dictionary<,List<Tuple<,>>>", 0, [&]() {
+        FormatGenericArgs(dictionary, output);
+        return output.size();
+    });
+
+    Benchmark::Measure("TypeName list+ostringstream, Func<...> deep", 0, [&]() {
+        return FormatList(func).size();
+    });
+
+    Benchmark::Measure("TypeName GenericArgs, Func<...> deep", 0, [&]() {
+        FormatGenericArgs(func, output);
+        return output.size();
+    });
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include "metadata/generic_args.h"
+
+using namespace netcoredbg::TypePrinter;
+
+namespace
+{
+    std::string Consume(GenericArgs &args, const std::string &prefix, const std::string &name)
+    {
+        std::string output = prefix + name;
+        args.Consume(output, prefix.size());
+        return output;
+    }
+}
+
+TEST_CASE("GenericArgs::Consume")
+{
+    GenericArgs args;
+    args.Add("string");
+    args.Add() = "List<Tuple<int, int>>";
+    args.Add("int");
+    CHECK(args.Size() == 3);
+    CHECK(args.Remain() == 3);
+
+    CHECK(Consume(args, "", "Dictionary`2") == "Dictionary<string, List<Tuple<int, int>>>");
+    CHECK(args.Remain() == 1);
+    // Nested type consumes rest of arguments.
+    CHECK(Consume(args, "Outer.", "Inner`1") == "Outer.Inner<int>");
+    CHECK(args.Remain() == 0);
+    CHECK(Consume(args, "", "Other`1") == "Other`1");
+}
+
+TEST_CASE("GenericArgs::NotGeneric")
+{
+    GenericArgs args;
+    args.Add("int");
+
+    CHECK(Consume(args, "", "List") == "List");
+    CHECK(Consume(args, "", "List`") == "List`");
+    CHECK(Consume(args, "", "List`0") == "List`0");
+    CHECK(Consume(args, "", "List`2") == "List`2");
+    CHECK(Consume(args, "", "List1") == "List1");
+    CHECK(Consume(args, "", "List`99999999999999999999") == "List`99999999999999999999");
+    // Arity suffix must belong to name after `start` position.
+    CHECK(Consume(args, "Type`", "1") == "Type`1");
+    CHECK(args.Remain() == 1);
+
+    CHECK(Consume(args, "", "`1") == "<int>");
+    CHECK(args.Remain() == 0);
+}
+
+TEST_CASE("GenericArgs::Join")
+{
+    GenericArgs args;
+    std::string output;
+    args.Join(output, ',');
+    CHECK(output.empty());
+
+    for (int i = 0; i < 10; i++)
+        args.Add(std::to_string(i));
+
+    output = "key:";
+    args.Join(output, ',');
+    CHECK(output == "key:0,1,2,3,4,5,6,7,8,9");
+    CHECK(args[9] == "9");
+}
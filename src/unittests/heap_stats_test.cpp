@@ -0,0 +1,74 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <vector>
+#include "debugger/heap_stats.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    typedef HeapStats::type_key_t type_key_t;
+    typedef HeapStats::entry_t entry_t;
+}
+
+TEST_CASE("HeapStats::Aggregation")
+{
+    HeapStats stats;
+    const type_key_t strings(0x1000, 0);
+    const type_key_t arrays(0x2000, 0);
+    const type_key_t objects(0x3000, 0);
+
+    for (int i = 0; i < 10; i++)
+    {
+        stats.Add(strings, 30);
+    }
+    stats.Add(arrays, 1000);
+    stats.Add(objects, 24);
+    stats.Add(strings, 40);
+    stats.Add(objects, 24);
+
+    CHECK(stats.GetObjectsCount() == 14);
+    CHECK(stats.GetTotalSize() == 10 * 30 + 1000 + 48 + 40);
+    CHECK(stats.GetTypesCount() == 3);
+
+    std::vector<entry_t> entries;
+    stats.GetTop(10, false, entries);
+    REQUIRE(entries.size() == 3);
+    CHECK(entries[0].key == arrays);
+    CHECK(entries[1].key == strings);
+    CHECK(entries[1].count == 11);
+    CHECK(entries[1].size == 340);
+    CHECK(entries[2].key == objects);
+
+    stats.GetTop(2, true, entries);
+    REQUIRE(entries.size() == 2);
+    CHECK(entries[0].key == strings);
+    CHECK(entries[1].key == objects);
+}
+
+TEST_CASE("HeapStats::TopOfManyTypes")
+{
+    HeapStats stats;
+    // Many types with one object each, size grows with type token.
+    for (uint64_t i = 1; i <= 10000; i++)
+    {
+        stats.Add(type_key_t(i, 0), i);
+    }
+    CHECK(stats.GetTypesCount() == 10000);
+
+    std::vector<entry_t> entries;
+    stats.GetTop(3, false, entries);
+    REQUIRE(entries.size() == 3);
+    CHECK(entries[0].key == type_key_t(10000, 0));
+    CHECK(entries[1].key == type_key_t(9999, 0));
+    CHECK(entries[2].key == type_key_t(9998, 0));
+
+    // Same count for all types, ordered by key.
+    stats.GetTop(2, true, entries);
+    REQUIRE(entries.size() == 2);
+    CHECK(entries[0].key == type_key_t(1, 0));
+    CHECK(entries[1].key == type_key_t(2, 0));
+}
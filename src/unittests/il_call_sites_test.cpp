@@ -0,0 +1,75 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include "debugger/il_call_sites.h"
+
+using namespace netcoredbg;
+
+TEST_CASE("ILCallSites::Find")
+{
+    const std::vector<uint8_t> code = {
+        0x00,                               // 0x00: nop
+        0x02,                               // 0x01: ldarg.0
+        0x1F, 0x05,                         // 0x02: ldc.i4.s 5
+        0x28, 0x01, 0x00, 0x00, 0x06,       // 0x04: call 0x06000001
+        0x73, 0x02, 0x00, 0x00, 0x0A,       // 0x09: newobj 0x0A000002
+        0x45, 0x02, 0x00, 0x00, 0x00,       // 0x0E: switch (2 targets)
+              0x00, 0x00, 0x00, 0x00,
+              0x00, 0x00, 0x00, 0x00,
+        0xFE, 0x16, 0x03, 0x00, 0x00, 0x1B, // 0x1B: constrained. 0x1B000003
+        0x6F, 0x04, 0x00, 0x00, 0x2B,       // 0x21: callvirt 0x2B000004
+        0xFE, 0x0C, 0x01, 0x00,             // 0x26: ldloc 1
+        0x2A                                // 0x2A: ret
+    };
+
+    std::vector<ILCallSites::call_site_t> calls;
+
+    SECTION("whole method")
+    {
+        REQUIRE(ILCallSites::Find(code, 0, (uint32_t)code.size(), calls));
+        REQUIRE(calls.size() == 3);
+        CHECK(calls[0].ilOffset == 0x04);
+        CHECK(calls[0].methodToken == 0x06000001);
+        CHECK(!calls[0].newObj);
+        CHECK(calls[1].ilOffset == 0x09);
+        CHECK(calls[1].methodToken == 0x0A000002);
+        CHECK(calls[1].newObj);
+        CHECK(calls[2].ilOffset == 0x21);
+        CHECK(calls[2].methodToken == 0x2B000004);
+        CHECK(!calls[2].newObj);
+    }
+
+    SECTION("range")
+    {
+        REQUIRE(ILCallSites::Find(code, 0x09, 0x21, calls));
+        REQUIRE(calls.size() == 1);
+        CHECK(calls[0].ilOffset == 0x09);
+    }
+
+    SECTION("end offset out of code")
+    {
+        REQUIRE(ILCallSites::Find(code, 0x21, 0x1000, calls));
+        REQUIRE(calls.size() == 1);
+        CHECK(calls[0].ilOffset == 0x21);
+    }
+
+    SECTION("truncated instruction")
+    {
+        std::vector<uint8_t> truncated(code.begin(), code.begin() + 7);
+        CHECK(!ILCallSites::Find(truncated, 0, (uint32_t)truncated.size(), calls));
+    }
+
+    SECTION("truncated switch")
+    {
+        std::vector<uint8_t> truncated(code.begin(), code.begin() + 0x17);
+        CHECK(!ILCallSites::Find(truncated, 0x0E, (uint32_t)truncated.size(), calls));
+    }
+
+    SECTION("invalid opcode")
+    {
+        const std::vector<uint8_t> invalid = { 0x00, 0x24, 0x2A };
+        CHECK(!ILCallSites::Find(invalid, 0, (uint32_t)invalid.size(), calls));
+    }
+}
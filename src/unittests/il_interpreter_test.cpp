@@ -0,0 +1,159 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <limits>
+#include <map>
+#include "debugger/il_interpreter.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    typedef ILInterpreter::value_t value_t;
+
+    class FakeContext : public ILInterpreter::IContext
+    {
+    public:
+        std::map<std::pair<size_t, uint32_t>, value_t> fields;
+        std::map<uint32_t, value_t> staticFields;
+        std::map<uint32_t, std::pair<std::vector<uint8_t>, unsigned>> methods;
+
+        bool LoadField(const value_t &object, uint32_t fieldToken, value_t &result) override
+        {
+            auto find = fields.find(std::make_pair(object.object, fieldToken));
+            if (find == fields.end())
+                return false;
+            result = find->second;
+            return true;
+        }
+
+        bool LoadStaticField(uint32_t fieldToken, value_t &result) override
+        {
+            auto find = staticFields.find(fieldToken);
+            if (find == staticFields.end())
+                return false;
+            result = find->second;
+            return true;
+        }
+
+        bool GetMethod(uint32_t methodToken, bool virtualCall, std::vector<uint8_t> &code, unsigned &argsCount) override
+        {
+            auto find = methods.find(methodToken);
+            if (virtualCall || find == methods.end())
+                return false;
+            code = find->second.first;
+            argsCount = find->second.second;
+            return true;
+        }
+    };
+
+    bool Run(FakeContext &context, const std::vector<uint8_t> &code, const std::vector<value_t> &args, value_t &result)
+    {
+        ILInterpreter interpreter(context);
+        return interpreter.Execute(code, args, result);
+    }
+}
+
+TEST_CASE("ILInterpreter::Arithmetic")
+{
+    FakeContext context;
+    value_t result;
+
+    // return 2 + 3 * 4;
+    REQUIRE(Run(context, { 0x18, 0x19, 0x1A, 0x5A, 0x58, 0x2A }, {}, result));
+    CHECK(result.kind == value_t::Int32);
+    CHECK(result.i == 14);
+
+    // return int.MaxValue + 1; (wraps)
+    REQUIRE(Run(context, { 0x20, 0xFF, 0xFF, 0xFF, 0x7F, 0x17, 0x58, 0x2A }, {}, result));
+    CHECK(result.i == std::numeric_limits<int32_t>::min());
+
+    // return 1L << 40;
+    REQUIRE(Run(context, { 0x17, 0x6A, 0x1F, 40, 0x62, 0x2A }, {}, result));
+    CHECK(result.kind == value_t::Int64);
+    CHECK(result.i == (int64_t(1) << 40));
+
+    // return 1.5 * 2;
+    REQUIRE(Run(context, { 0x23, 0, 0, 0, 0, 0, 0, 0xF8, 0x3F, 0x18, 0x6C, 0x5A, 0x2A }, {}, result));
+    CHECK(result.kind == value_t::Double);
+    CHECK(result.d == 3.0);
+
+    // Division by zero and mixed types must be executed by debuggee.
+    CHECK_FALSE(Run(context, { 0x17, 0x16, 0x5B, 0x2A }, {}, result));
+    CHECK_FALSE(Run(context, { 0x17, 0x17, 0x6A, 0x58, 0x2A }, {}, result));
+}
+
+TEST_CASE("ILInterpreter::Branches")
+{
+    FakeContext context;
+    value_t result;
+
+    // return arg0 > arg1 ? arg0 : arg1;
+    const std::vector<uint8_t> max = { 0x02, 0x03, 0x30, 0x02, 0x03, 0x2A, 0x02, 0x2A };
+    REQUIRE(Run(context, max, { value_t::FromInt32(3), value_t::FromInt32(7) }, result));
+    CHECK(result.i == 7);
+    REQUIRE(Run(context, max, { value_t::FromInt32(9), value_t::FromInt32(7) }, result));
+    CHECK(result.i == 9);
+
+    // int s = 0; for (int i = 0; i < arg0; i++) s += i; return s;
+    const std::vector<uint8_t> sum = {
+        0x16, 0x0A,             // s = 0
+        0x16, 0x0B,             // i = 0
+        0x2B, 0x08,             // br.s condition
+        0x06, 0x07, 0x58, 0x0A, // s += i
+        0x07, 0x17, 0x58, 0x0B, // i++
+        0x07, 0x02, 0x32, 0xF4, // if (i < arg0) goto loop body
+        0x06, 0x2A              // return s
+    };
+    REQUIRE(Run(context, sum, { value_t::FromInt32(10) }, result));
+    CHECK(result.i == 45);
+
+    // Budget is exhausted by long loops.
+    CHECK_FALSE(Run(context, sum, { value_t::FromInt32(1000000) }, result));
+
+    // return arg0 == arg1; (ceq)
+    REQUIRE(Run(context, { 0x02, 0x03, 0xFE, 0x01, 0x2A }, { value_t::FromInt32(1), value_t::FromInt32(1) }, result));
+    CHECK(result.i == 1);
+}
+
+TEST_CASE("ILInterpreter::FieldsAndCalls")
+{
+    FakeContext context;
+    value_t result;
+
+    const uint32_t fieldA = 0x04000001;
+    const uint32_t fieldB = 0x04000002;
+    const uint32_t staticField = 0x04000003;
+    const uint32_t getter = 0x06000001;
+    context.fields[std::make_pair(size_t(1), fieldA)] = value_t::FromInt32(20);
+    context.fields[std::make_pair(size_t(1), fieldB)] = value_t::FromInt32(22);
+    context.staticFields[staticField] = value_t::FromInt64(5);
+
+    // return this._a + this._b;
+    const std::vector<uint8_t> sumFields = { 0x02, 0x7B, 0x01, 0, 0, 0x04, 0x02, 0x7B, 0x02, 0, 0, 0x04, 0x58, 0x2A };
+    REQUIRE(Run(context, sumFields, { value_t::FromObject(1) }, result));
+    CHECK(result.i == 42);
+
+    // Unknown object.
+    CHECK_FALSE(Run(context, sumFields, { value_t::FromObject(2) }, result));
+
+    // return Static;
+    REQUIRE(Run(context, { 0x7E, 0x03, 0, 0, 0x04, 0x2A }, {}, result));
+    CHECK(result.i == 5);
+
+    // return this.Sum * 2; (call to other getter)
+    context.methods[getter] = std::make_pair(sumFields, 1u);
+    REQUIRE(Run(context, { 0x02, 0x28, 0x01, 0, 0, 0x06, 0x18, 0x5A, 0x2A }, { value_t::FromObject(1) }, result));
+    CHECK(result.i == 84);
+
+    // Virtual call is rejected by context, recursion is limited by call depth.
+    CHECK_FALSE(Run(context, { 0x02, 0x6F, 0x01, 0, 0, 0x06, 0x2A }, { value_t::FromObject(1) }, result));
+    const uint32_t recursive = 0x06000002;
+    context.methods[recursive] = std::make_pair(std::vector<uint8_t>{ 0x02, 0x28, 0x02, 0, 0, 0x06, 0x2A }, 1u);
+    CHECK_FALSE(Run(context, { 0x02, 0x28, 0x02, 0, 0, 0x06, 0x2A }, { value_t::FromObject(1) }, result));
+
+    // Not supported instruction (stfld).
+    CHECK_FALSE(Run(context, { 0x02, 0x16, 0x7D, 0x01, 0, 0, 0x04, 0x16, 0x2A }, { value_t::FromObject(1) }, result));
+}
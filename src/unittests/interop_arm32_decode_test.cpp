@@ -0,0 +1,212 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <random>
+#include "debugger/interop_arm32_decode_helpers.h"
+
+using namespace netcoredbg::InteropDebugging;
+
+namespace
+{
+
+    // Reference implementation, bitfields branching logic of software single step next PC calculation.
+
+    uint32_t GetBits(uint32_t val, uint32_t first, uint32_t last)
+    {
+        return (val >> first) & (((uint32_t)1 << (last - first + 1)) - 1);
+    }
+
+    bool IsThumb32(uint16_t inst1)
+    {
+        return (inst1 & 0xe000) == 0xe000 && (inst1 & 0x1800) != 0;
+    }
+
+    arm32_insn_class_e ReferenceArm(uint32_t insn)
+    {
+        unsigned op = GetBits(insn, 24, 27);
+        if (GetBits(insn, 28, 31) == 0xf)
+        {
+            if (op == 0xb)
+                return arm32_insn_class_e::ArmUncondBranch;
+            if (op > 0xb && op <= 0xe)
+                return arm32_insn_class_e::ArmUncondCoprocessor;
+            return arm32_insn_class_e::Default;
+        }
+
+        if (op <= 0x3)
+            return arm32_insn_class_e::ArmMiscellaneous;
+        if (op <= 0x7)
+            return arm32_insn_class_e::ArmMemory;
+        if (op <= 0x9)
+            return arm32_insn_class_e::ArmMultipleMemory;
+        if (op <= 0xb)
+            return arm32_insn_class_e::ArmBranch;
+        return arm32_insn_class_e::Default;
+    }
+
+    arm32_insn_class_e ReferenceThumb16(uint16_t inst1)
+    {
+        switch (GetBits(inst1, 12, 15))
+        {
+        case 0x4:
+            if ((inst1 & 0xff00) == 0x4700)
+                return arm32_insn_class_e::Thumb16BranchExchange;
+            if ((inst1 & 0xff87) == 0x4687)
+                return arm32_insn_class_e::Thumb16MovPC;
+            break;
+        case 0xb:
+            if ((inst1 & 0xff00) == 0xbd00)
+                return arm32_insn_class_e::Thumb16PopPC;
+            if ((inst1 & 0xf500) == 0xb100)
+                return arm32_insn_class_e::Thumb16CompareAndBranch;
+            break;
+        case 0xd:
+            return arm32_insn_class_e::Thumb16CondBranch;
+        case 0xe:
+            if ((inst1 & 0xf800) == 0xe000)
+                return arm32_insn_class_e::Thumb16UncondBranch;
+            break;
+        }
+        return arm32_insn_class_e::Default;
+    }
+
+    arm32_insn_class_e ReferenceThumb32(uint16_t inst1, uint16_t inst2)
+    {
+        static const struct
+        {
+            uint32_t mask;
+            uint32_t opcode;
+            arm32_insn_class_e insnClass;
+        } patterns[] =
+        {
+            {0x8000f800, 0x8000f000, arm32_insn_class_e::Thumb32BranchesMiscControl},
+            {0x2000ffd0, 0x0000e910, arm32_insn_class_e::Thumb32LDM},
+            {0x2000ffd0, 0x0000e890, arm32_insn_class_e::Thumb32LDM},
+            {0xffffffd0, 0xc000e990, arm32_insn_class_e::Thumb32RFE},
+            {0xffffffd0, 0xc000e810, arm32_insn_class_e::Thumb32RFE},
+            {0xf0f0ffef, 0x0000ea4f, arm32_insn_class_e::Thumb32MOV},
+            {0xfff0fff0, 0xf000e8d0, arm32_insn_class_e::Thumb32TBB},
+            {0xfff0fff0, 0xf010e8d0, arm32_insn_class_e::Thumb32TBH},
+            {0xf000ff70, 0xf000f850, arm32_insn_class_e::Thumb32LDR},
+        };
+
+        uint32_t data32 = ((uint32_t)inst2 << 16) | inst1;
+        for (auto &entry : patterns)
+        {
+            if ((data32 & entry.mask) == entry.opcode)
+                return entry.insnClass;
+        }
+        return arm32_insn_class_e::Default;
+    }
+
+    bool ReferenceCondition(uint32_t cond, uint32_t regPS)
+    {
+        const uint32_t FLAG_N = 0x80000000;
+        const uint32_t FLAG_Z = 0x40000000;
+        const uint32_t FLAG_C = 0x20000000;
+        const uint32_t FLAG_V = 0x10000000;
+
+        switch (cond)
+        {
+        case 0x0: return (regPS & FLAG_Z) != 0;
+        case 0x1: return (regPS & FLAG_Z) == 0;
+        case 0x2: return (regPS & FLAG_C) != 0;
+        case 0x3: return (regPS & FLAG_C) == 0;
+        case 0x4: return (regPS & FLAG_N) != 0;
+        case 0x5: return (regPS & FLAG_N) == 0;
+        case 0x6: return (regPS & FLAG_V) != 0;
+        case 0x7: return (regPS & FLAG_V) == 0;
+        case 0x8: return (regPS & (FLAG_C | FLAG_Z)) == FLAG_C;
+        case 0x9: return (regPS & (FLAG_C | FLAG_Z)) != FLAG_C;
+        case 0xa: return ((regPS & FLAG_N) == 0) == ((regPS & FLAG_V) == 0);
+        case 0xb: return ((regPS & FLAG_N) == 0) != ((regPS & FLAG_V) == 0);
+        case 0xc: return ((regPS & FLAG_Z) == 0) && (((regPS & FLAG_N) == 0) == ((regPS & FLAG_V) == 0));
+        case 0xd: return ((regPS & FLAG_Z) != 0) || (((regPS & FLAG_N) == 0) != ((regPS & FLAG_V) == 0));
+        default:  return true;
+        }
+    }
+
+} // unnamed namespace
+
+TEST_CASE("ARM32Decode::Arm")
+{
+    for (uint32_t high = 0; high < 256; high++)
+    {
+        CHECK(ARM32_ClassifyArmInsn(high << 24) == ReferenceArm(high << 24));
+    }
+
+    std::mt19937 rng(42);
+    size_t mismatches = 0;
+    for (int i = 0; i < 1000000; i++)
+    {
+        uint32_t insn = rng();
+        if (ARM32_ClassifyArmInsn(insn) != ReferenceArm(insn))
+            mismatches++;
+    }
+    CHECK(mismatches == 0);
+
+    CHECK(ARM32_ClassifyArmInsn(0xeb000010) == arm32_insn_class_e::ArmBranch); // bl
+    CHECK(ARM32_ClassifyArmInsn(0xe12fff1e) == arm32_insn_class_e::ArmMiscellaneous); // bx lr
+    CHECK(ARM32_ClassifyArmInsn(0xe8bd8010) == arm32_insn_class_e::ArmMultipleMemory); // pop {r4, pc}
+    CHECK(ARM32_ClassifyArmInsn(0xfb000010) == arm32_insn_class_e::ArmUncondBranch); // blx <label>
+}
+
+TEST_CASE("ARM32Decode::Thumb16")
+{
+    size_t mismatches = 0;
+    for (uint32_t inst1 = 0; inst1 <= 0xffff; inst1++)
+    {
+        if (IsThumb32((uint16_t)inst1))
+            continue;
+
+        if (ARM32_ClassifyThumb16Insn((uint16_t)inst1) != ReferenceThumb16((uint16_t)inst1))
+            mismatches++;
+    }
+    CHECK(mismatches == 0);
+
+    CHECK(ARM32_ClassifyThumb16Insn(0x4770) == arm32_insn_class_e::Thumb16BranchExchange); // bx lr
+    CHECK(ARM32_ClassifyThumb16Insn(0x46f7) == arm32_insn_class_e::Thumb16MovPC); // mov pc, lr
+    CHECK(ARM32_ClassifyThumb16Insn(0xbd10) == arm32_insn_class_e::Thumb16PopPC); // pop {r4, pc}
+    CHECK(ARM32_ClassifyThumb16Insn(0xb118) == arm32_insn_class_e::Thumb16CompareAndBranch); // cbz r0, <label>
+    CHECK(ARM32_ClassifyThumb16Insn(0xd0fe) == arm32_insn_class_e::Thumb16CondBranch); // beq <label>
+    CHECK(ARM32_ClassifyThumb16Insn(0xe7fe) == arm32_insn_class_e::Thumb16UncondBranch); // b <label>
+    CHECK(ARM32_ClassifyThumb16Insn(0xb510) == arm32_insn_class_e::Default); // push {r4, lr}
+}
+
+TEST_CASE("ARM32Decode::Thumb32")
+{
+    std::mt19937 rng(42);
+    size_t mismatches = 0;
+    for (uint32_t inst1 = 0xe800; inst1 <= 0xffff; inst1++)
+    {
+        // Note, all patterns have inst2 mask in bits [15:12] and [7:4], check all of them and random low bits.
+        for (uint32_t bits = 0; bits < 256; bits++)
+        {
+            uint16_t inst2 = (uint16_t)(((bits & 0xf0) << 8) | ((bits & 0x0f) << 4) | (rng() & 0x0f0f));
+            if (ARM32_ClassifyThumb32Insn((uint16_t)inst1, inst2) != ReferenceThumb32((uint16_t)inst1, inst2))
+                mismatches++;
+        }
+    }
+    CHECK(mismatches == 0);
+
+    CHECK(ARM32_ClassifyThumb32Insn(0xf7ff, 0xfffe) == arm32_insn_class_e::Thumb32BranchesMiscControl); // bl <label>
+    CHECK(ARM32_ClassifyThumb32Insn(0xe8bd, 0x8010) == arm32_insn_class_e::Thumb32LDM); // pop.w {r4, pc}
+    CHECK(ARM32_ClassifyThumb32Insn(0xe8df, 0xf000) == arm32_insn_class_e::Thumb32TBB); // tbb [pc, r0]
+    CHECK(ARM32_ClassifyThumb32Insn(0xe8df, 0xf010) == arm32_insn_class_e::Thumb32TBH); // tbh [pc, r0, lsl #1]
+    CHECK(ARM32_ClassifyThumb32Insn(0xf85d, 0xfb04) == arm32_insn_class_e::Thumb32LDR); // ldr pc, [sp], #4
+    CHECK(ARM32_ClassifyThumb32Insn(0xf8d0, 0x1004) == arm32_insn_class_e::Default); // ldr.w r1, [r0, #4]
+}
+
+TEST_CASE("ARM32Decode::Condition")
+{
+    for (uint32_t cond = 0; cond < 16; cond++)
+    {
+        for (uint32_t nzcv = 0; nzcv < 16; nzcv++)
+        {
+            uint32_t regPS = (nzcv << 28) | 0x10; // user mode
+            CHECK(ARM32_IsConditionPassed(cond, regPS) == ReferenceCondition(cond, regPS));
+        }
+    }
+}
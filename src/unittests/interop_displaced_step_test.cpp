@@ -0,0 +1,188 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <vector>
+#include "debugger/interop_displaced_step_helpers.h"
+
+using namespace netcoredbg::InteropDebugging;
+
+namespace
+{
+
+    bool PrepareAMD64(const std::vector<uint8_t> &code, amd64_displaced_insn_t &displaced)
+    {
+        // Note, add some trailing bytes, since decoder have no information about real instruction size.
+        std::vector<uint8_t> insn(code);
+        insn.resize(AMD64_MaxInsnSize, 0x90);
+        return AMD64_PrepareDisplacedInsn(insn.data(), insn.size(), displaced);
+    }
+
+    std::vector<uint8_t> Code(const amd64_displaced_insn_t &displaced)
+    {
+        return std::vector<uint8_t>(displaced.code, displaced.code + displaced.length);
+    }
+
+} // unnamed namespace
+
+TEST_CASE("DisplacedStep::AMD64_Length")
+{
+    amd64_displaced_insn_t displaced;
+
+    REQUIRE(PrepareAMD64({0x55}, displaced)); // push rbp
+    CHECK(displaced.length == 1);
+    REQUIRE(PrepareAMD64({0x48, 0x89, 0xE5}, displaced)); // mov rbp, rsp
+    CHECK(displaced.length == 3);
+    REQUIRE(PrepareAMD64({0x48, 0x83, 0xEC, 0x10}, displaced)); // sub rsp, 0x10
+    CHECK(displaced.length == 4);
+    REQUIRE(PrepareAMD64({0xC7, 0x45, 0xFC, 0x01, 0x00, 0x00, 0x00}, displaced)); // mov dword [rbp-4], 1
+    CHECK(displaced.length == 7);
+    REQUIRE(PrepareAMD64({0x48, 0xB8, 1, 2, 3, 4, 5, 6, 7, 8}, displaced)); // movabs rax, imm64
+    CHECK(displaced.length == 10);
+    REQUIRE(PrepareAMD64({0x66, 0xB8, 0x01, 0x00}, displaced)); // mov ax, 1
+    CHECK(displaced.length == 4);
+    REQUIRE(PrepareAMD64({0x8B, 0x44, 0x24, 0x08}, displaced)); // mov eax, [rsp+8]
+    CHECK(displaced.length == 4);
+    REQUIRE(PrepareAMD64({0xF3, 0x0F, 0x1E, 0xFA}, displaced)); // endbr64
+    CHECK(displaced.length == 4);
+    REQUIRE(PrepareAMD64({0x66, 0x0F, 0x3A, 0x0F, 0xC1, 0x08}, displaced)); // palignr xmm0, xmm1, 8
+    CHECK(displaced.length == 6);
+    REQUIRE(PrepareAMD64({0xC5, 0xF8, 0x77}, displaced)); // vzeroupper
+    CHECK(displaced.length == 3);
+    REQUIRE(PrepareAMD64({0xF6, 0x45, 0x00, 0x01}, displaced)); // test byte [rbp], 1
+    CHECK(displaced.length == 4);
+    CHECK(displaced.ripReg == -1);
+    CHECK(!displaced.relativeBranch);
+    CHECK(!displaced.returnAddress);
+}
+
+TEST_CASE("DisplacedStep::AMD64_Branches")
+{
+    amd64_displaced_insn_t displaced;
+
+    REQUIRE(PrepareAMD64({0xE8, 0x10, 0x00, 0x00, 0x00}, displaced)); // call rel32
+    CHECK(displaced.length == 5);
+    CHECK(displaced.relativeBranch);
+    CHECK(displaced.returnAddress);
+
+    REQUIRE(PrepareAMD64({0x0F, 0x84, 0x10, 0x00, 0x00, 0x00}, displaced)); // je rel32
+    CHECK(displaced.length == 6);
+    CHECK(displaced.relativeBranch);
+
+    REQUIRE(PrepareAMD64({0x75, 0xF0}, displaced)); // jne rel8
+    CHECK(displaced.length == 2);
+    CHECK(displaced.relativeBranch);
+
+    REQUIRE(PrepareAMD64({0xC3}, displaced)); // ret
+    CHECK(!displaced.relativeBranch);
+    CHECK(!displaced.returnAddress);
+
+    REQUIRE(PrepareAMD64({0xFF, 0xD0}, displaced)); // call rax
+    CHECK(!displaced.relativeBranch);
+    CHECK(displaced.returnAddress);
+
+    REQUIRE(PrepareAMD64({0xFF, 0xE0}, displaced)); // jmp rax
+    CHECK(!displaced.relativeBranch);
+    CHECK(!displaced.returnAddress);
+
+    CHECK(!PrepareAMD64({0xCC}, displaced)); // int3
+    CHECK(!PrepareAMD64({0x0F, 0x0B}, displaced)); // ud2
+    CHECK(!PrepareAMD64({0xC7, 0xF8, 0, 0, 0, 0}, displaced)); // xbegin
+    CHECK(!PrepareAMD64({0x66, 0xE8, 0x10, 0x00}, displaced)); // call rel16
+}
+
+TEST_CASE("DisplacedStep::AMD64_RIPRelative")
+{
+    amd64_displaced_insn_t displaced;
+
+    // mov rax, [rip+0x1000] -> mov rax, [rbx+0x1000]
+    REQUIRE(PrepareAMD64({0x48, 0x8B, 0x05, 0x00, 0x10, 0x00, 0x00}, displaced));
+    CHECK(displaced.ripReg == 3);
+    CHECK(Code(displaced) == std::vector<uint8_t>({0x48, 0x8B, 0x83, 0x00, 0x10, 0x00, 0x00}));
+
+    // lea rbx, [rip+0x20] -> lea rbx, [rbp+0x20]
+    REQUIRE(PrepareAMD64({0x48, 0x8D, 0x1D, 0x20, 0x00, 0x00, 0x00}, displaced));
+    CHECK(displaced.ripReg == 5);
+    CHECK(Code(displaced) == std::vector<uint8_t>({0x48, 0x8D, 0x9D, 0x20, 0x00, 0x00, 0x00}));
+
+    // cmp dword [rip+0x10], 5 (REX.B ignored for RIP-relative operand, must be cleared)
+    REQUIRE(PrepareAMD64({0x41, 0x83, 0x3D, 0x10, 0x00, 0x00, 0x00, 0x05}, displaced));
+    CHECK(displaced.length == 8);
+    CHECK(displaced.ripReg == 3);
+    CHECK(Code(displaced) == std::vector<uint8_t>({0x40, 0x83, 0xBB, 0x10, 0x00, 0x00, 0x00, 0x05}));
+
+    // jmp [rip+0x200] (PLT)
+    REQUIRE(PrepareAMD64({0xFF, 0x25, 0x00, 0x02, 0x00, 0x00}, displaced));
+    CHECK(displaced.ripReg == 3);
+    CHECK(!displaced.relativeBranch);
+    CHECK(Code(displaced) == std::vector<uint8_t>({0xFF, 0xA3, 0x00, 0x02, 0x00, 0x00}));
+
+    // cmpxchg16b [rip+0x10] use RBX implicitly
+    REQUIRE(PrepareAMD64({0x48, 0x0F, 0xC7, 0x0D, 0x10, 0x00, 0x00, 0x00}, displaced));
+    CHECK(displaced.ripReg == 5);
+
+    // vmovdqu ymm0, [rip+0x40] (VEX3 with inverted B bit)
+    REQUIRE(PrepareAMD64({0xC4, 0xC1, 0x7E, 0x6F, 0x05, 0x40, 0x00, 0x00, 0x00}, displaced));
+    CHECK(displaced.length == 9);
+    CHECK(displaced.ripReg == 3);
+    CHECK(Code(displaced) == std::vector<uint8_t>({0xC4, 0xE1, 0x7E, 0x6F, 0x83, 0x40, 0x00, 0x00, 0x00}));
+
+    // 32-bit address size
+    CHECK(!PrepareAMD64({0x67, 0x8B, 0x05, 0x00, 0x10, 0x00, 0x00}, displaced));
+}
+
+TEST_CASE("DisplacedStep::ARM64")
+{
+    const std::uintptr_t addr = 0x400000;
+    arm64_displaced_insn_t displaced;
+
+    // add x0, x1, #1
+    REQUIRE(ARM64_PrepareDisplacedInsn(0x91000420, addr, displaced));
+    CHECK(displaced.type == arm64_displaced_e::Copy);
+    CHECK(displaced.code == 0x91000420);
+
+    // bl #-4
+    REQUIRE(ARM64_PrepareDisplacedInsn(0x97ffffff, addr, displaced));
+    CHECK(displaced.type == arm64_displaced_e::Branch);
+    CHECK(displaced.link);
+    CHECK(displaced.target == addr - 4);
+    CHECK(displaced.code == ARM64_NopInsn);
+
+    // b.eq #0x40
+    REQUIRE(ARM64_PrepareDisplacedInsn(0x54000200, addr, displaced));
+    CHECK(displaced.type == arm64_displaced_e::CondBranch);
+    CHECK(displaced.target == addr + 0x40);
+    CHECK(displaced.code == 0x54000040);
+
+    // tbnz w0, #3, #-8
+    REQUIRE(ARM64_PrepareDisplacedInsn(0x371fffc0, addr, displaced));
+    CHECK(displaced.type == arm64_displaced_e::CondBranch);
+    CHECK(displaced.target == addr - 8);
+    CHECK(displaced.code == 0x37180040);
+
+    // adrp x1, #0x2000
+    REQUIRE(ARM64_PrepareDisplacedInsn(0xd0000001, addr + 0x123, displaced));
+    CHECK(displaced.type == arm64_displaced_e::Adr);
+    CHECK(displaced.reg == 1);
+    CHECK(displaced.target == addr + 0x2000);
+
+    // ldr x2, #0x10
+    REQUIRE(ARM64_PrepareDisplacedInsn(0x58000082, addr, displaced));
+    CHECK(displaced.type == arm64_displaced_e::LoadLiteral);
+    CHECK(displaced.reg == 2);
+    CHECK(displaced.target == addr + 0x10);
+    CHECK(displaced.loadSize == 8);
+    CHECK(!displaced.loadSigned);
+
+    // blr x3
+    REQUIRE(ARM64_PrepareDisplacedInsn(0xd63f0060, addr, displaced));
+    CHECK(displaced.type == arm64_displaced_e::BranchReg);
+
+    // svc #0
+    REQUIRE(ARM64_PrepareDisplacedInsn(0xd4000001, addr, displaced));
+    CHECK(displaced.type == arm64_displaced_e::Copy);
+
+    CHECK(!ARM64_PrepareDisplacedInsn(0xd4200000, addr, displaced)); // brk #0
+    CHECK(!ARM64_PrepareDisplacedInsn(0x5c000080, addr, displaced)); // ldr d0, #0x10
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <signal.h>
+#include "debugger/interop_signal_policy.h"
+
+using namespace netcoredbg;
+using namespace netcoredbg::InteropDebugging;
+
+TEST_CASE("SignalPolicy::ParseSignal")
+{
+    CHECK(SignalPolicy::ParseSignal("SIGPIPE") == SIGPIPE);
+    CHECK(SignalPolicy::ParseSignal("PIPE") == SIGPIPE);
+    CHECK(SignalPolicy::ParseSignal("14") == SIGALRM);
+    CHECK(SignalPolicy::ParseSignal("SIG40") == 40);
+    CHECK(SignalPolicy::ParseSignal("sigpipe") == 0);
+    CHECK(SignalPolicy::ParseSignal("SIGNOPE") == 0);
+    CHECK(SignalPolicy::ParseSignal("100") == 0);
+    CHECK(SignalPolicy::ParseSignal("1x") == 0);
+    CHECK(SignalPolicy::ParseSignal("") == 0);
+
+    CHECK(SignalPolicy::GetSignalName(SIGCHLD) == "SIGCHLD");
+    CHECK(SignalPolicy::GetSignalName(40) == "SIG40");
+}
+
+TEST_CASE("SignalPolicy::Actions")
+{
+    SignalPolicy policy;
+    SignalAction action = SignalAction::Stop;
+
+    REQUIRE(policy.Get(SIGPIPE, action));
+    CHECK(action == SignalAction::Pass);
+
+    CHECK(policy.Set(SIGPIPE, SignalAction::Print));
+    REQUIRE(policy.Get(SIGPIPE, action));
+    CHECK(action == SignalAction::Print);
+
+    CHECK(policy.Set(SIGSEGV, SignalAction::Stop));
+    REQUIRE(policy.Get(SIGSEGV, action));
+    CHECK(action == SignalAction::Stop);
+
+    // Debugger internal signals.
+    CHECK(!policy.Set(SIGTRAP, SignalAction::Pass));
+    CHECK(!policy.Set(SIGSTOP, SignalAction::Pass));
+    CHECK(!policy.Get(SIGILL, action));
+    CHECK(!policy.Get(0, action));
+    CHECK(!policy.Get(SignalPolicy::MaxSignal, action));
+}
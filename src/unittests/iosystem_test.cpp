@@ -216,6 +216,46 @@ TEST_CASE("IOSystem::socket")
 }
 
 
+TEST_CASE("IOSystem::server_socket")
+{
+    char buf[1024];
+
+    IOSystem::FileHandle server;
+    unsigned port = 0;
+    srand(unsigned(time(NULL)));
+    for (unsigned retry = 0; retry < 10 && !server; retry++)
+    {
+        port = rand()%32768 + 1024;
+        server = IOSystem::server_socket(port);
+    }
+    REQUIRE(server);
+
+    // both clients are connected before first connection is accepted (clients wait in queue)
+    IOSystem::FileHandle conns[2] = { connect_to(port), connect_to(port) };
+    REQUIRE(conns[0]);
+    REQUIRE(conns[1]);
+
+    for (auto &conn : conns)
+    {
+        IOSystem::FileHandle sock = IOSystem::accept_socket(server);
+        REQUIRE(sock);
+
+        auto result = IOSystem::write(conn, test_str, sizeof(test_str)-1);
+        CHECK(result.status == IOSystem::IOResult::Success);
+
+        result = IOSystem::read(sock, buf, sizeof(buf));
+        CHECK(result.status == IOSystem::IOResult::Success);
+        CHECK(result.size == sizeof(test_str)-1);
+        CHECK(!strncmp(test_str, buf, sizeof(test_str)-1));
+
+        IOSystem::close(conn);
+        IOSystem::close(sock);
+    }
+
+    IOSystem::close(server);
+}
+
+
 TEST_CASE("IOSystem::StdIOSwap")
 {
     char buf[1024];
@@ -336,3 +376,102 @@ TEST_CASE("IOSystem::select_socket")
     //check_select(socket_pair());
 }
 
+
+#ifndef WIN32
+// Function checks async operations waiting (epoll based on Linux),
+// including changes of the awaited handles set between waits.
+TEST_CASE("IOSystem::async_pipe")
+{
+    auto pipe = IOSystem::unnamed_pipe();
+    REQUIRE(pipe.first);
+    REQUIRE(pipe.second);
+
+    char buf[1024];
+    IOSystem::AsyncHandle handles[2];
+    auto& read_handle = handles[0];
+    auto& write_handle = handles[1];
+
+    // check wait with no events
+    read_handle = IOSystem::async_read(pipe.first, buf, sizeof(buf));
+    REQUIRE(!!read_handle);
+    CHECK(!IOSystem::async_wait(handles, &handles[2], std::chrono::milliseconds(100)));
+    CHECK(IOSystem::async_result(read_handle).status == IOSystem::IOResult::Pending);
+
+    // check, that pipe ready for writing wakes thread
+    write_handle = IOSystem::async_write(pipe.second, test_str, sizeof(test_str)-1);
+    REQUIRE(!!write_handle);
+    CHECK(IOSystem::async_wait(handles, &handles[2], std::chrono::milliseconds(100)));
+    auto result = IOSystem::async_result(write_handle);
+    CHECK(result.status == IOSystem::IOResult::Success);
+    CHECK(result.size == sizeof(test_str)-1);
+    CHECK(!write_handle);
+
+    CHECK(IOSystem::async_wait(handles, &handles[2], std::chrono::milliseconds(100)));
+    result = IOSystem::async_result(read_handle);
+    CHECK(result.status == IOSystem::IOResult::Success);
+    CHECK(result.size == sizeof(test_str)-1);
+    CHECK(memcmp(buf, test_str, sizeof(test_str)-1) == 0);
+    CHECK(!read_handle);
+
+    // check, that writing end (always ready for writing) removed from awaited set doesn't wake thread
+    read_handle = IOSystem::async_read(pipe.first, buf, sizeof(buf));
+    CHECK(!IOSystem::async_wait(handles, &handles[2], std::chrono::milliseconds(100)));
+    CHECK(IOSystem::async_result(read_handle).status == IOSystem::IOResult::Pending);
+
+    // check, that data written by other thread wakes thread
+    std::thread thread {
+        [&]{ IOSystem::write(pipe.second, test_str, sizeof(test_str)-1); }
+    };
+    CHECK(IOSystem::async_wait(handles, &handles[2], std::chrono::milliseconds(1000)));
+    result = IOSystem::async_result(read_handle);
+    CHECK(result.status == IOSystem::IOResult::Success);
+    CHECK(result.size == sizeof(test_str)-1);
+    thread.join();
+
+    // check, that closing writing end of the pipe wakes thread waiting on reading end of the pipe
+    read_handle = IOSystem::async_read(pipe.first, buf, sizeof(buf));
+    IOSystem::close(pipe.second);
+    CHECK(IOSystem::async_wait(handles, &handles[2], std::chrono::milliseconds(1000)));
+    CHECK(IOSystem::async_result(read_handle).status == IOSystem::IOResult::Eof);
+
+    IOSystem::close(pipe.first);
+}
+#endif
+
+#ifdef __linux__
+// Function checks direct data transfer between pipes.
+TEST_CASE("IOSystem::async_splice")
+{
+    auto in_pipe = IOSystem::unnamed_pipe();
+    auto out_pipe = IOSystem::unnamed_pipe();
+    REQUIRE(in_pipe.first);
+    REQUIRE(out_pipe.second);
+
+    IOSystem::AsyncHandle h = IOSystem::async_splice(in_pipe.first, out_pipe.second, 64 * 1024);
+    REQUIRE(!!h);
+    CHECK(!IOSystem::async_wait(&h, &h + 1, std::chrono::milliseconds(100)));
+    CHECK(IOSystem::async_result(h).status == IOSystem::IOResult::Pending);
+
+    CHECK(IOSystem::write(in_pipe.second, test_str, sizeof(test_str)-1).size == sizeof(test_str)-1);
+    CHECK(IOSystem::async_wait(&h, &h + 1, std::chrono::milliseconds(100)));
+    auto result = IOSystem::async_result(h);
+    CHECK(result.status == IOSystem::IOResult::Success);
+    CHECK(result.size == sizeof(test_str)-1);
+
+    char buf[1024];
+    result = IOSystem::read(out_pipe.first, buf, sizeof(buf));
+    CHECK(result.status == IOSystem::IOResult::Success);
+    CHECK(result.size == sizeof(test_str)-1);
+    CHECK(memcmp(buf, test_str, sizeof(test_str)-1) == 0);
+
+    // check EOF
+    IOSystem::close(in_pipe.second);
+    h = IOSystem::async_splice(in_pipe.first, out_pipe.second, 64 * 1024);
+    CHECK(IOSystem::async_wait(&h, &h + 1, std::chrono::milliseconds(100)));
+    CHECK(IOSystem::async_result(h).status == IOSystem::IOResult::Eof);
+
+    IOSystem::close(in_pipe.first);
+    IOSystem::close(out_pipe.first);
+    IOSystem::close(out_pipe.second);
+}
+#endif
@@ -0,0 +1,108 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+#include "json/json.hpp"
+#include "protocols/jsonwriter.h"
+#include "benchmark.h"
+
+using namespace netcoredbg;
+using json = nlohmann::json;
+
+namespace
+{
+    // Same fields as Variable (see interfaces/types.h), which can't be used here since require PAL headers.
+    struct test_variable_t
+    {
+        std::string name;
+        std::string value;
+        std::string type;
+        std::string evaluateName;
+        uint32_t variablesReference;
+        int namedVariables;
+        bool lazy;
+    };
+
+    // Same serialization as to_json() and WriteJson() for Variable in vscodeprotocol.cpp.
+    void to_json(json &j, const test_variable_t &v)
+    {
+        j = json{
+            {"name",               v.name},
+            {"value",              v.value},
+            {"type",               v.type},
+            {"evaluateName",       v.evaluateName},
+            {"variablesReference", v.variablesReference}};
+
+        if (v.variablesReference > 0)
+            j["namedVariables"] = v.namedVariables;
+
+        if (v.lazy)
+            j["presentationHint"] = json{{"lazy", true}};
+    }
+
+    void WriteJson(JsonWriter &writer, const test_variable_t &v)
+    {
+        writer.BeginObject()
+              .Key("name").String(v.name)
+              .Key("value").String(v.value)
+              .Key("type").String(v.type)
+              .Key("evaluateName").String(v.evaluateName)
+              .Key("variablesReference").UInt(v.variablesReference);
+
+        if (v.variablesReference > 0)
+            writer.Key("namedVariables").Int(v.namedVariables);
+
+        if (v.lazy)
+            writer.Key("presentationHint").BeginObject().Key("lazy").Bool(true).EndObject();
+
+        writer.EndObject();
+    }
+
+    std::vector<test_variable_t> MakeVariables(size_t count)
+    {
+        std::vector<test_variable_t> result;
+        for (size_t i = 0; i < count; i++)
+        {
+            std::string index = std::to_string(i);
+            result.push_back({"[" + index + "]", i % 2 ? "{MyApp.Item}" : "\"string \\\"value\\\" " + index + "\"",
+                              i % 2 ? "MyApp.Item" : "string", "collection[" + index + "]",
+                              i % 2 ? uint32_t(i + 1000) : 0, i % 2 ? 5 : 0, i % 10 == 0});
+        }
+        return result;
+    }
+}
+
+TEST_CASE("JsonWriter::Benchmark", "[.benchmark]")
+{
+    // `variables` response body with 1000 children.
+    const std::vector<test_variable_t> variables = MakeVariables(1000);
+
+    std::string expected;
+    {
+        JsonWriter writer(expected);
+        writer.BeginObject().Key("variables").BeginArray();
+        for (const auto &v : variables)
+            WriteJson(writer, v);
+        writer.EndArray().EndObject();
+    }
+    CHECK(json::parse(expected) == json{{"variables", variables}});
+
+    Benchmark::Measure("variables response, nlohmann::json", expected.size(), [&]() {
+        json body;
+        body["variables"] = variables;
+        return body.dump().size();
+    });
+
+    Benchmark::Measure("variables response, JsonWriter", expected.size(), [&]() {
+        std::string output;
+        JsonWriter writer(output);
+        writer.BeginObject().Key("variables").BeginArray();
+        for (const auto &v : variables)
+            WriteJson(writer, v);
+        writer.EndArray().EndObject();
+        return output.size();
+    });
+}
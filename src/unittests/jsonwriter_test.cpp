@@ -0,0 +1,74 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include "json/json.hpp"
+#include "protocols/jsonwriter.h"
+
+using ::netcoredbg::JsonWriter;
+
+TEST_CASE("JsonWriter::EscapeString")
+{
+    const std::string values[] = {
+        "",
+        "plain text",
+        "quote \" and backslash \\",
+        "\b\f\n\r\t",
+        std::string("\x01\x1f zero \0 end", 13),
+        "\xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82" // UTF-8
+    };
+
+    for (const auto &value : values)
+    {
+        std::string output;
+        JsonWriter::EscapeString(value, output);
+        CHECK(output == nlohmann::json(value).dump());
+        CHECK(nlohmann::json::parse(output).get<std::string>() == value);
+    }
+}
+
+TEST_CASE("JsonWriter::Write")
+{
+    std::string output;
+    JsonWriter writer(output);
+
+    writer.BeginObject();
+    writer.Key("variables").BeginArray();
+    for (int i = 0; i < 2; i++)
+    {
+        writer.BeginObject()
+              .Key("name").String("v" + std::to_string(i))
+              .Key("variablesReference").UInt(uint32_t(-1))
+              .Key("line").Int(-i)
+              .Key("lazy").Bool(i == 0)
+              .EndObject();
+    }
+    writer.EndArray();
+    writer.Key("empty").BeginObject().EndObject();
+    writer.Key("emptyArray").BeginArray().EndArray();
+    writer.Key("raw").Raw("{\"a\":1}");
+    writer.EndObject();
+
+    CHECK(output == "{\"variables\":[{\"name\":\"v0\",\"variablesReference\":4294967295,\"line\":0,\"lazy\":true},"
+                    "{\"name\":\"v1\",\"variablesReference\":4294967295,\"line\":-1,\"lazy\":false}],"
+                    "\"empty\":{},\"emptyArray\":[],\"raw\":{\"a\":1}}");
+
+    nlohmann::json parsed = nlohmann::json::parse(output);
+    CHECK(parsed["variables"].size() == 2);
+    CHECK(parsed["raw"]["a"] == 1);
+}
+
+TEST_CASE("JsonWriter::Base64")
+{
+    std::string output;
+    JsonWriter writer(output);
+
+    const unsigned char data[] = {0x00, 0xff, 0xfe, 'f', 'o'};
+    writer.BeginObject()
+          .Key("data").Base64(data, sizeof(data))
+          .Key("empty").Base64(nullptr, 0)
+          .EndObject();
+    CHECK(output == "{\"data\":\"AP/+Zm8=\",\"empty\":\"\"}");
+}
@@ -0,0 +1,238 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <limits>
+#include <vector>
+#include "metadata/line_updates_table.h"
+#include "benchmark.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+
+    struct test_block_t
+    {
+        int32_t newLine;
+        int32_t oldLine;
+        int32_t endLineOffset;
+        test_block_t(int32_t newLine_, int32_t oldLine_, int32_t endLineOffset_) :
+            newLine(newLine_), oldLine(oldLine_), endLineOffset(endLineOffset_)
+        {}
+    };
+
+    // Previous layout (array of sequence points with actual lines and linear search), in order to check and compare with LineUpdatesTable.
+    struct reference_entry_t
+    {
+        unsigned fullPathIndex;
+        int32_t newLine;
+        int32_t oldLine;
+        int32_t endLineOffset;
+    };
+
+    void ReferenceApply(std::vector<reference_entry_t> &entries, unsigned fullPathIndex, const std::vector<test_block_t> &blocks)
+    {
+        std::vector<int32_t> offsets(entries.size(), 0);
+        for (const auto &block : blocks)
+        {
+            for (size_t i = 0; i < entries.size(); i++)
+            {
+                auto &entry = entries[i];
+                if (entry.fullPathIndex != fullPathIndex ||
+                    entry.newLine < block.oldLine ||
+                    (uint32_t)entry.newLine + (uint32_t)entry.endLineOffset > (uint32_t)block.oldLine + (uint32_t)block.endLineOffset)
+                    continue;
+
+                offsets[i] = block.newLine - block.oldLine;
+            }
+        }
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            entries[i].newLine += offsets[i];
+        }
+    }
+
+    bool ReferenceOffset(const std::vector<reference_entry_t> &entries, unsigned fullPathIndex, int32_t line, int32_t &offset)
+    {
+        for (const auto &entry : entries)
+        {
+            if (entry.fullPathIndex != fullPathIndex ||
+                entry.oldLine > line ||
+                entry.oldLine + entry.endLineOffset < line)
+                continue;
+
+            offset = entry.newLine - entry.oldLine;
+            return true;
+        }
+        return false;
+    }
+
+    // Method with `count` single line sequence points on each second line started from `startLine`.
+    void MakeMethod(int32_t startLine, int32_t count, LineUpdatesTable &table, std::vector<reference_entry_t> &reference)
+    {
+        for (int32_t i = 0; i < count; i++)
+        {
+            const int32_t line = startLine + i * 2;
+            table.Add(1, line, line);
+            reference.push_back({1, line, line, 0});
+        }
+        table.Build();
+    }
+
+    // Delta with one line inserted before `line` (all code from `line` moved down).
+    std::vector<test_block_t> InsertLineDelta(int32_t line)
+    {
+        return {test_block_t(line + 1, line, std::numeric_limits<int32_t>::max() - line)};
+    }
+
+} // unnamed namespace
+
+TEST_CASE("LineUpdatesTable::ForwardCorrection")
+{
+    LineUpdatesTable table;
+    table.Add(1, 10, 10);
+    table.Add(1, 12, 14); // multiline statement
+    table.Add(1, 13, 13); // nested into multiline statement (lambda call arguments)
+    table.Add(2, 5, 5);   // other source (partial method)
+    table.Add(1, 20, 20);
+    table.Build();
+
+    int32_t offset = 0;
+    CHECK(table.GetLineOffset(1, 10, offset));
+    CHECK(offset == 0);
+    CHECK(!table.GetLineOffset(1, 11, offset));
+    CHECK(!table.GetLineOffset(3, 10, offset));
+
+    // Move lines 12-30 down on 3 lines.
+    table.ApplyBlockUpdates(1, std::vector<test_block_t>{test_block_t(15, 12, 18)});
+    CHECK(table.GetLineOffset(1, 10, offset));
+    CHECK(offset == 0);
+    CHECK(table.GetLineOffset(1, 12, offset));
+    CHECK(offset == 3);
+    CHECK(table.GetLineOffset(1, 14, offset));
+    CHECK(offset == 3);
+    CHECK(table.GetLineOffset(1, 20, offset));
+    CHECK(offset == 3);
+    CHECK(table.GetLineOffset(2, 5, offset));
+    CHECK(offset == 0);
+
+    // Second delta work with actual lines, move line 23 (PDB line 20) up on 1 line.
+    table.ApplyBlockUpdates(1, std::vector<test_block_t>{test_block_t(22, 23, 0)});
+    CHECK(table.GetLineOffset(1, 20, offset));
+    CHECK(offset == 2);
+    CHECK(table.GetLineOffset(1, 13, offset));
+    CHECK(offset == 3);
+}
+
+TEST_CASE("LineUpdatesTable::BackwardCorrection")
+{
+    LineUpdatesTable table;
+    table.Add(1, 10, 10);
+    table.Add(1, 12, 14);
+    table.Add(1, 20, 20);
+    table.Build();
+
+    int32_t pdbLine = 0;
+    CHECK(table.GetPdbLine(1, 5, pdbLine));
+    CHECK(pdbLine == 10);
+    CHECK(table.GetPdbLine(1, 13, pdbLine));
+    CHECK(pdbLine == 12);
+    CHECK(table.GetPdbLine(1, 15, pdbLine));
+    CHECK(pdbLine == 20);
+    CHECK(!table.GetPdbLine(1, 21, pdbLine));
+    CHECK(!table.GetPdbLine(2, 1, pdbLine));
+
+    // Insert 5 lines before line 20.
+    table.ApplyBlockUpdates(1, InsertLineDelta(20));
+    table.ApplyBlockUpdates(1, std::vector<test_block_t>{test_block_t(25, 21, std::numeric_limits<int32_t>::max() - 21)});
+    CHECK(table.GetPdbLine(1, 15, pdbLine));
+    CHECK(pdbLine == 20);
+    CHECK(table.GetPdbLine(1, 25, pdbLine));
+    CHECK(pdbLine == 20);
+    CHECK(!table.GetPdbLine(1, 26, pdbLine));
+}
+
+TEST_CASE("LineUpdatesTable::SequentialDeltas")
+{
+    LineUpdatesTable table;
+    std::vector<reference_entry_t> reference;
+    MakeMethod(100, 200, table, reference);
+
+    for (int32_t delta = 0; delta < 1000; delta++)
+    {
+        // Note, actual lines only grow, so, insert point always inside method.
+        const int32_t line = 100 + (int32_t)(((uint32_t)delta * 2654435761u) % 400u);
+        auto blocks = InsertLineDelta(line);
+        table.ApplyBlockUpdates(1, blocks);
+        ReferenceApply(reference, 1, blocks);
+    }
+
+    size_t mismatches = 0;
+    for (int32_t line = 90; line < 510; line++)
+    {
+        int32_t offset = 0;
+        int32_t referenceOffset = 0;
+        bool found = table.GetLineOffset(1, line, offset);
+        bool referenceFound = ReferenceOffset(reference, 1, line, referenceOffset);
+        if (found != referenceFound || offset != referenceOffset)
+            mismatches++;
+    }
+    CHECK(mismatches == 0);
+}
+
+// 1000 sequential deltas and sequence points lookups, compare with previous layout,
+// run with `line_updates_table "[.benchmark]"`.
+TEST_CASE("LineUpdatesTable::Benchmark", "[.benchmark]")
+{
+    const int32_t pointsCount = 2000;
+    const int32_t deltasCount = 1000;
+    const int32_t requestsCount = 200000;
+    LineUpdatesTable table;
+    std::vector<reference_entry_t> reference;
+    MakeMethod(1, pointsCount, table, reference);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t delta = 0; delta < deltasCount; delta++)
+    {
+        const int32_t line = 1 + (int32_t)(((uint32_t)delta * 2654435761u) % (uint32_t)(pointsCount * 2));
+        ReferenceApply(reference, 1, InsertLineDelta(line));
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int32_t delta = 0; delta < deltasCount; delta++)
+    {
+        const int32_t line = 1 + (int32_t)(((uint32_t)delta * 2654435761u) % (uint32_t)(pointsCount * 2));
+        table.ApplyBlockUpdates(1, InsertLineDelta(line));
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    using std::chrono::nanoseconds;
+    using std::chrono::duration_cast;
+    Benchmark::Report("line updates, deltas apply, linear array", deltasCount, duration_cast<nanoseconds>(middle - start));
+    Benchmark::Report("line updates, deltas apply, LineUpdatesTable", deltasCount, duration_cast<nanoseconds>(end - middle));
+
+    size_t checksumOld = 0;
+    size_t checksumNew = 0;
+    int32_t offset;
+    start = std::chrono::steady_clock::now();
+    for (int32_t r = 0; r < requestsCount; r++)
+    {
+        int32_t line = 1 + (int32_t)(((uint32_t)r * 2654435761u) % (uint32_t)(pointsCount * 2));
+        if (ReferenceOffset(reference, 1, line, offset))
+            checksumOld += offset;
+    }
+    middle = std::chrono::steady_clock::now();
+    for (int32_t r = 0; r < requestsCount; r++)
+    {
+        int32_t line = 1 + (int32_t)(((uint32_t)r * 2654435761u) % (uint32_t)(pointsCount * 2));
+        if (table.GetLineOffset(1, line, offset))
+            checksumNew += offset;
+    }
+    end = std::chrono::steady_clock::now();
+
+    Benchmark::Report("line updates, lookups, linear array", requestsCount, duration_cast<nanoseconds>(middle - start));
+    Benchmark::Report("line updates, lookups, LineUpdatesTable", requestsCount, duration_cast<nanoseconds>(end - middle));
+    CHECK(checksumOld == checksumNew);
+}
@@ -0,0 +1,258 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <map>
+#include <set>
+#include <vector>
+#include <chrono>
+#include <unordered_map>
+#include "metadata/methods_index.h"
+#include "benchmark.h"
+
+using ::netcoredbg::MethodsIndex;
+
+namespace
+{
+
+    // Same layout and ordering as method_data_t (see modules_sources.h), which can't be used here since require cor.h.
+    struct test_method_data_t
+    {
+        uint32_t methodDef;
+        int32_t startLine;
+        int32_t endLine;
+        int32_t startColumn;
+        int32_t endColumn;
+
+        test_method_data_t(uint32_t methodDef_, int32_t startLine_, int32_t endLine_, int32_t startColumn_ = 1, int32_t endColumn_ = 2) :
+            methodDef(methodDef_), startLine(startLine_), endLine(endLine_), startColumn(startColumn_), endColumn(endColumn_)
+        {}
+
+        bool operator < (const test_method_data_t &other) const
+        {
+            return endLine < other.endLine || (endLine == other.endLine && endColumn < other.endColumn);
+        }
+
+        bool operator < (const int32_t lineNum) const
+        {
+            return endLine < lineNum;
+        }
+
+        bool operator == (const test_method_data_t &other) const
+        {
+            return methodDef == other.methodDef &&
+                   startLine == other.startLine && endLine == other.endLine &&
+                   startColumn == other.startColumn && endColumn == other.endColumn;
+        }
+    };
+
+    struct test_method_data_t_hash
+    {
+        size_t operator()(const test_method_data_t &p) const
+        {
+            return p.methodDef ^ ((size_t)p.startLine << 8) ^ ((size_t)p.endLine << 20);
+        }
+    };
+
+    typedef std::map<size_t, std::set<test_method_data_t>> levels_t;
+    typedef std::unordered_map<test_method_data_t, std::vector<uint32_t>, test_method_data_t_hash> multi_t;
+    typedef MethodsIndex<test_method_data_t, uint32_t> index_t;
+
+    // class A {                              // line 1
+    //     void M1() {                        // line 2
+    //         ...
+    //         void Local() {...}             // line 5-7
+    //     }                                  // line 10
+    //
+    //     A() {...}  A(int) : this() {...}   // ctor segment lines 13-15, shared by tokens 4 and 5
+    //     void M2() {...}                    // line 20-30
+    // }
+    index_t BuildTestIndex()
+    {
+        levels_t levels;
+        levels[0].emplace(1, 2, 10);
+        levels[0].emplace(4, 13, 15);
+        levels[0].emplace(2, 20, 30);
+        levels[1].emplace(3, 5, 7);
+
+        multi_t multi;
+        multi[test_method_data_t(4, 13, 15)] = {5};
+
+        index_t index;
+        index.Build(levels, multi);
+        return index;
+    }
+
+} // unnamed namespace
+
+TEST_CASE("MethodsIndex::Empty")
+{
+    index_t index;
+    CHECK(index.Empty());
+
+    int32_t line = 10;
+    std::vector<uint32_t> tokens;
+    uint32_t closestNested = 1;
+    CHECK(!index.GetMethodTokensByLineNumber(line, tokens, closestNested));
+    CHECK(tokens.empty());
+    CHECK(closestNested == 0);
+}
+
+TEST_CASE("MethodsIndex::Build")
+{
+    index_t index = BuildTestIndex();
+    CHECK(!index.Empty());
+
+    const auto &methods = index.GetMethods();
+    REQUIRE(methods.size() == 4);
+    // level 0 ordered by end line, level 1 after
+    CHECK(methods[0].methodDef == 1);
+    CHECK(methods[1].methodDef == 4);
+    CHECK(methods[2].methodDef == 2);
+    CHECK(methods[3].methodDef == 3);
+
+    CHECK(index.GetMultiTokens(0).empty());
+    REQUIRE(index.GetMultiTokens(1).size() == 1);
+    CHECK(index.GetMultiTokens(1)[0] == 5);
+    CHECK(index.GetMultiTokens(3).empty());
+
+    index.Clear();
+    CHECK(index.Empty());
+}
+
+TEST_CASE("MethodsIndex::GetMethodTokensByLineNumber")
+{
+    index_t index = BuildTestIndex();
+    std::vector<uint32_t> tokens;
+    uint32_t closestNested = 0;
+
+    SECTION("line inside method")
+    {
+        int32_t line = 3;
+        CHECK(index.GetMethodTokensByLineNumber(line, tokens, closestNested));
+        CHECK(line == 3);
+        CHECK(tokens == std::vector<uint32_t>{1});
+        CHECK(closestNested == 3);
+    }
+
+    SECTION("line inside nested method")
+    {
+        int32_t line = 6;
+        CHECK(index.GetMethodTokensByLineNumber(line, tokens, closestNested));
+        CHECK(line == 6);
+        CHECK(tokens == std::vector<uint32_t>{3});
+        CHECK(closestNested == 0);
+    }
+
+    SECTION("first line of nested method")
+    {
+        int32_t line = 5;
+        CHECK(index.GetMethodTokensByLineNumber(line, tokens, closestNested));
+        CHECK(tokens == std::vector<uint32_t>{1});
+        CHECK(closestNested == 3);
+    }
+
+    SECTION("line after nested method")
+    {
+        int32_t line = 8;
+        CHECK(index.GetMethodTokensByLineNumber(line, tokens, closestNested));
+        CHECK(tokens == std::vector<uint32_t>{1});
+        CHECK(closestNested == 0);
+    }
+
+    SECTION("line between methods moved to method below")
+    {
+        int32_t line = 17;
+        CHECK(index.GetMethodTokensByLineNumber(line, tokens, closestNested));
+        CHECK(line == 20);
+        CHECK(tokens == std::vector<uint32_t>{2});
+        CHECK(closestNested == 0);
+    }
+
+    SECTION("constructor segment shared by multiple constructors")
+    {
+        int32_t line = 14;
+        CHECK(index.GetMethodTokensByLineNumber(line, tokens, closestNested));
+        CHECK(tokens == std::vector<uint32_t>{5, 4});
+    }
+
+    SECTION("line behind last method")
+    {
+        int32_t line = 31;
+        CHECK(!index.GetMethodTokensByLineNumber(line, tokens, closestNested));
+        CHECK(line == 31);
+        CHECK(tokens.empty());
+    }
+}
+
+// Previous layout (array per nested level + hash map for multi methods) in order to compare with MethodsIndex,
+// run with `methods_index "[.benchmark]"`.
+TEST_CASE("MethodsIndex::Benchmark", "[.benchmark]")
+{
+    const int32_t methodsCount = 20000;
+    const int32_t linesPerMethod = 10;
+    levels_t levels;
+    multi_t multi;
+    for (int32_t i = 0; i < methodsCount; i++)
+    {
+        const int32_t startLine = i * linesPerMethod + 1;
+        levels[0].emplace(i * 2 + 1, startLine, startLine + linesPerMethod - 2);
+        levels[1].emplace(i * 2 + 2, startLine + 2, startLine + 4);
+        if (i % 10 == 0)
+            multi[test_method_data_t(i * 2 + 1, startLine, startLine + linesPerMethod - 2)] = {(uint32_t)(methodsCount * 2 + i)};
+    }
+
+    std::vector<std::vector<test_method_data_t>> nestedData;
+    for (const auto &level : levels)
+    {
+        nestedData.emplace_back(level.second.begin(), level.second.end());
+    }
+    index_t index;
+    index.Build(levels, multi);
+
+    const int32_t requestsCount = 2000000;
+    std::vector<uint32_t> tokens;
+    uint32_t closestNested;
+    size_t checksumOld = 0;
+    size_t checksumNew = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t r = 0; r < requestsCount; r++)
+    {
+        int32_t line = (int32_t)(((uint32_t)r * 2654435761u) % (uint32_t)(methodsCount * linesPerMethod)) + 1;
+        const test_method_data_t *result = nullptr;
+        for (const auto &level : nestedData)
+        {
+            auto lower = std::lower_bound(level.cbegin(), level.cend(), line);
+            if (lower == level.cend() || line < lower->startLine)
+                break;
+            result = &(*lower);
+        }
+        if (!result)
+            continue;
+        tokens.clear();
+        auto find = multi.find(*result);
+        if (find != multi.end())
+            tokens.assign(find->second.begin(), find->second.end());
+        tokens.emplace_back(result->methodDef);
+        checksumOld += tokens.size() + tokens.back();
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int32_t r = 0; r < requestsCount; r++)
+    {
+        int32_t line = (int32_t)(((uint32_t)r * 2654435761u) % (uint32_t)(methodsCount * linesPerMethod)) + 1;
+        tokens.clear();
+        if (!index.GetMethodTokensByLineNumber(line, tokens, closestNested))
+            continue;
+        checksumNew += tokens.size() + tokens.back();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    using std::chrono::nanoseconds;
+    using std::chrono::duration_cast;
+    netcoredbg::Benchmark::Report("methods by line, nested vectors + hash map", requestsCount, duration_cast<nanoseconds>(middle - start));
+    netcoredbg::Benchmark::Report("methods by line, flat MethodsIndex", requestsCount, duration_cast<nanoseconds>(end - middle));
+    CHECK(checksumOld != 0);
+    CHECK(checksumNew != 0);
+}
@@ -0,0 +1,66 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+#include "protocols/micommandline.h"
+#include "protocols/tokenizer.h"
+#include "benchmark.h"
+
+using namespace netcoredbg;
+
+TEST_CASE("MICommandLine::Benchmark", "[.benchmark]")
+{
+    // Typical scripted MI session commands.
+    const std::vector<std::string> lines = {
+        "101-stack-list-frames --thread 1 0 20",
+        "102-stack-list-variables --thread 1 --frame 0",
+        "103-var-create - * \"collection.Where(x => x.Id > 5)\" --thread 1 --frame 0 --evalFlags 16",
+        "104-var-list-children --simple-values \"var12\" 0 100",
+        "105-break-insert -f -c \"i == 10\" /home/user/src/project/Program.cs:123",
+        "106-var-assign var12 value + 1",
+        "107-exec-next --thread 1",
+    };
+    size_t bytes = 0;
+    for (const auto &line : lines)
+        bytes += line.size();
+
+    Benchmark::Measure("MI command line, Tokenizer and std::string args", bytes, [&]() {
+        size_t result = 0;
+        for (const auto &line : lines)
+        {
+            Tokenizer tokenizer(line);
+            std::vector<std::string> args;
+            std::string token;
+            while (tokenizer.Next(token))
+                args.push_back(token);
+            result += args.size();
+        }
+        return result;
+    });
+
+    MICommandLine parser;
+    Benchmark::Measure("MICommandLine::Parse, slices", bytes, [&]() {
+        size_t result = 0;
+        for (const auto &line : lines)
+        {
+            parser.Parse(line);
+            result += parser.ArgsCount();
+        }
+        return result;
+    });
+
+    std::vector<std::string> args;
+    Benchmark::Measure("MICommandLine::Parse, reused std::string args", bytes, [&]() {
+        size_t result = 0;
+        for (const auto &line : lines)
+        {
+            parser.Parse(line);
+            parser.GetArgs(args);
+            result += args.size();
+        }
+        return result;
+    });
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+#include "protocols/micommandline.h"
+#include "protocols/tokenizer.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    // Reference implementation, MI command line parsing by Tokenizer.
+    bool ParseByTokenizer(const std::string &str, std::string &token, std::string &cmd, std::vector<std::string> &args)
+    {
+        token.clear();
+        cmd.clear();
+        args.clear();
+
+        Tokenizer tokenizer(str);
+        std::string result;
+
+        if (!tokenizer.Next(result) || result.empty())
+            return false;
+
+        std::size_t i = result.find_first_not_of("0123456789");
+        if (i == std::string::npos || result.at(i) != '-')
+            return false;
+
+        token = result.substr(0, i);
+        cmd = result.substr(i + 1);
+
+        if (cmd == "var-assign" || cmd == "break-condition")
+        {
+            tokenizer.Next(result);
+            args.push_back(result);
+            args.push_back(tokenizer.Remain());
+            return true;
+        }
+
+        while (tokenizer.Next(result))
+            args.push_back(result);
+
+        return true;
+    }
+}
+
+TEST_CASE("MICommandLine::SameAsTokenizer")
+{
+    const std::vector<std::string> lines = {
+        "-exec-continue",
+        "15-stack-list-frames --thread 1 0 10",
+        "   7-var-create  - *   \"collection.Where(x => x.Id > 5)\"   ",
+        "-break-insert -f -c \"i == 10 && name == \\\"test\\\"\" /home/user/src/project/Program.cs:123",
+        "3-var-assign var1   i + \"str\"  ",
+        "4-break-condition 2 x > 1 && y == \"a b\"",
+        "5-var-assign",
+        "-exec-arguments \"\" a \"\"",
+        "-gdb-set \"just\\\\escaped\\",
+        "-file-exec-and-symbols \"C:\\\\path with spaces\\\\app.dll\"",
+        "\t-var-list-children\t--simple-values\t\"var2\"\r\n",
+        "12abc",
+        "",
+        "   ",
+        "-",
+    };
+
+    MICommandLine parser;
+    std::vector<std::string> args;
+    for (const std::string &line : lines)
+    {
+        std::string token;
+        std::string command;
+        std::vector<std::string> expected;
+        const bool ok = ParseByTokenizer(line, token, command, expected);
+        INFO(line);
+        REQUIRE(parser.Parse(line) == ok);
+        if (!ok)
+            continue;
+
+        CHECK(std::string(parser.Token()) == token);
+        CHECK(std::string(parser.Command()) == command);
+        parser.GetArgs(args);
+        CHECK(args == expected);
+    }
+}
+
+TEST_CASE("MICommandLine::ArgsLimit")
+{
+    MICommandLine parser;
+    std::string line = "-var-evaluate-batch";
+    for (size_t i = 0; i < MICommandLine::MaxArgs; i++)
+    {
+        line += " e" + std::to_string(i);
+    }
+    REQUIRE(parser.Parse(line));
+    CHECK(parser.ArgsCount() == MICommandLine::MaxArgs);
+    CHECK(std::string(parser.Arg(MICommandLine::MaxArgs - 1)) == "e" + std::to_string(MICommandLine::MaxArgs - 1));
+
+    line += " overflow";
+    CHECK_FALSE(parser.Parse(line));
+}
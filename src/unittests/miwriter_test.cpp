@@ -0,0 +1,53 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include "protocols/miwriter.h"
+
+using ::netcoredbg::MIWriter;
+
+TEST_CASE("MIWriter::EscapeString")
+{
+    auto escape = [](const std::string &value)
+    {
+        std::string output;
+        MIWriter::EscapeString(value, output);
+        return output;
+    };
+
+    CHECK(escape("") == "\"\"");
+    CHECK(escape("plain text") == "\"plain text\"");
+    CHECK(escape("quote \" and backslash \\") == "\"quote \\\" and backslash \\\\\"");
+    CHECK(escape("\a\b\f\n\r\t\v") == "\"\\a\\b\\f\\n\\r\\t\\v\"");
+    CHECK(escape(std::string("zero \0 end", 10)) == "\"zero \\0 end\"");
+    CHECK(escape("\x01\xd0\xbf") == "\"\x01\xd0\xbf\"");
+}
+
+TEST_CASE("MIWriter::Write")
+{
+    std::string output;
+    MIWriter writer(output);
+
+    writer.Key("numchild").UInt(2)
+          .Key("children").BeginList();
+    for (int i = 0; i < 2; i++)
+    {
+        writer.Key("child").BeginTuple()
+              .Key("name").String("var" + std::to_string(i))
+              .Key("value").String("\"s\"")
+              .Key("level").Int(-i)
+              .EndTuple();
+    }
+    writer.EndList();
+    writer.Key("empty").BeginTuple().EndTuple();
+    writer.Key("values").BeginList().String("a").String("b").EndList();
+    writer.Raw("has_more=\"0\"");
+
+    CHECK(output ==
+        "numchild=\"2\",children=["
+            "child={name=\"var0\",value=\"\\\"s\\\"\",level=\"0\"},"
+            "child={name=\"var1\",value=\"\\\"s\\\"\",level=\"-1\"}],"
+        "empty={},values=[\"a\",\"b\"],has_more=\"0\"");
+}
@@ -0,0 +1,156 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <fstream>
+#include <string>
+#include "metadata/module_snapshot_cache.h"
+#include "utils/filesystem.h"
+#include "temp_dir.h"
+
+using ::netcoredbg::ModuleSnapshotCache;
+using ::netcoredbg::module_snapshot_t;
+using ::netcoredbg::Test::TempDir;
+
+namespace
+{
+    module_snapshot_t MakeSnapshot()
+    {
+        module_snapshot_t snapshot;
+        snapshot.nonJMCTokensCached = true;
+        snapshot.nonJMCTokens = {0x02000003, 0x06000010};
+
+        module_snapshot_t::async_method_t asyncMethod;
+        asyncMethod.methodToken = 0x06000002;
+        asyncMethod.retCode = 0;
+        asyncMethod.lastIlOffset = 0x40;
+        asyncMethod.awaits.push_back({0x10, 0x18});
+        asyncMethod.awaits.push_back({0x28, 0x30});
+        snapshot.asyncMethods.push_back(asyncMethod);
+        asyncMethod.methodToken = 0x06000005;
+        asyncMethod.retCode = (int32_t)0x80004005;
+        asyncMethod.lastIlOffset = 0;
+        asyncMethod.awaits.clear();
+        snapshot.asyncMethods.push_back(asyncMethod);
+
+        snapshot.haveIndex = true;
+        snapshot.types.push_back({0x02000002, 0x01000000, "Program", "App.Program", 0, 2});
+        snapshot.types.push_back({0x02000003, 0x02000002, "<Main>d__0", "App.Program.<Main>d__0", 2, 3});
+        snapshot.methods.push_back({0x06000001, 0, "Main", ""});
+        snapshot.methods.push_back({0x06000002, 0, "Get", "<T,U>"});
+        snapshot.methods.push_back({0x06000003, 1, "MoveNext", ""});
+        return snapshot;
+    }
+}
+
+TEST_CASE("ModuleSnapshotCache::StoreLoad")
+{
+    const TempDir tempDir("netcoredbg-snapshot-test-");
+    const std::string &dir = tempDir.Path();
+    ModuleSnapshotCache::SetOptions(true, dir, ModuleSnapshotCache::DefaultMaxSize);
+    const std::string key = ModuleSnapshotCache::GetKey("00000001-0000-0000-0000-000000000000", "SHA256:0102");
+    REQUIRE(!key.empty());
+    CHECK(ModuleSnapshotCache::GetKey("", "SHA256:0102").empty());
+
+    module_snapshot_t snapshot;
+    CHECK(!ModuleSnapshotCache::Load(key, snapshot));
+
+    ModuleSnapshotCache::Store(key, MakeSnapshot());
+    // Reload from disk, as new debugger instance do.
+    ModuleSnapshotCache::SetOptions(true, dir, ModuleSnapshotCache::DefaultMaxSize);
+    REQUIRE(ModuleSnapshotCache::Load(key, snapshot));
+
+    CHECK(snapshot.nonJMCTokensCached);
+    REQUIRE(snapshot.nonJMCTokens.size() == 2);
+    CHECK(snapshot.nonJMCTokens[1] == 0x06000010);
+
+    REQUIRE(snapshot.asyncMethods.size() == 2);
+    CHECK(snapshot.asyncMethods[0].methodToken == 0x06000002);
+    CHECK(snapshot.asyncMethods[0].lastIlOffset == 0x40);
+    REQUIRE(snapshot.asyncMethods[0].awaits.size() == 2);
+    CHECK(snapshot.asyncMethods[0].awaits[1].yieldOffset == 0x28);
+    CHECK(snapshot.asyncMethods[0].awaits[1].resumeOffset == 0x30);
+    CHECK(snapshot.asyncMethods[1].retCode == (int32_t)0x80004005);
+    CHECK(snapshot.asyncMethods[1].awaits.empty());
+
+    CHECK(snapshot.haveIndex);
+    REQUIRE(snapshot.types.size() == 2);
+    CHECK(snapshot.types[1].fullName == "App.Program.<Main>d__0");
+    CHECK(snapshot.types[1].enclosingTypeDef == 0x02000002);
+    CHECK(snapshot.types[1].methodsBegin == 2);
+    REQUIRE(snapshot.methods.size() == 3);
+    CHECK(snapshot.methods[1].genericParams == "<T,U>");
+    CHECK(snapshot.methods[2].typeIndex == 1);
+
+    // Snapshot without optional parts.
+    ModuleSnapshotCache::Store(key, module_snapshot_t());
+    REQUIRE(ModuleSnapshotCache::Load(key, snapshot));
+    CHECK(!snapshot.nonJMCTokensCached);
+    CHECK(!snapshot.haveIndex);
+    CHECK(snapshot.asyncMethods.empty());
+    CHECK(snapshot.methods.empty());
+}
+
+TEST_CASE("ModuleSnapshotCache::BrokenEntry")
+{
+    const TempDir tempDir("netcoredbg-snapshot-test-");
+    const std::string &dir = tempDir.Path();
+    ModuleSnapshotCache::SetOptions(true, dir, ModuleSnapshotCache::DefaultMaxSize);
+    const std::string key = ModuleSnapshotCache::GetKey("00000002-0000-0000-0000-000000000000", "SHA256:0102");
+    ModuleSnapshotCache::Store(key, MakeSnapshot());
+
+    const std::string path = dir + ::netcoredbg::FileSystem::PathSeparator + key + ".snapshot";
+    std::string data;
+    {
+        std::ifstream file(path, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    REQUIRE(data.size() > 16);
+
+    // Truncated entry.
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size() - 3);
+    }
+    module_snapshot_t snapshot;
+    CHECK(!ModuleSnapshotCache::Load(key, snapshot));
+
+    // Method with type index out of range.
+    module_snapshot_t broken = MakeSnapshot();
+    broken.methods[0].typeIndex = 7;
+    ModuleSnapshotCache::Store(key, broken);
+    CHECK(!ModuleSnapshotCache::Load(key, snapshot));
+
+    // Type with methods range out of range.
+    broken = MakeSnapshot();
+    broken.types[1].methodsEnd = 4;
+    ModuleSnapshotCache::Store(key, broken);
+    CHECK(!ModuleSnapshotCache::Load(key, snapshot));
+}
+
+TEST_CASE("ModuleSnapshotCache::Eviction")
+{
+    const TempDir tempDir("netcoredbg-snapshot-test-");
+    const std::string &dir = tempDir.Path();
+    module_snapshot_t snapshot = MakeSnapshot();
+    snapshot.nonJMCTokens.resize(1024);
+    // Each entry is a bit more than 4KiB, so, 3 entries don't fit into 10KiB.
+    ModuleSnapshotCache::SetOptions(true, dir, 10 * 1024);
+    const std::string key1 = ModuleSnapshotCache::GetKey("00000003-0000-0000-0000-000000000000", "SHA256:01");
+    const std::string key2 = ModuleSnapshotCache::GetKey("00000004-0000-0000-0000-000000000000", "SHA256:01");
+    const std::string key3 = ModuleSnapshotCache::GetKey("00000005-0000-0000-0000-000000000000", "SHA256:01");
+    ModuleSnapshotCache::Store(key1, snapshot);
+    ModuleSnapshotCache::Store(key2, snapshot);
+    ModuleSnapshotCache::Store(key3, snapshot);
+
+    module_snapshot_t loaded;
+    CHECK(!ModuleSnapshotCache::Load(key1, loaded));
+    CHECK(ModuleSnapshotCache::Load(key2, loaded));
+    CHECK(ModuleSnapshotCache::Load(key3, loaded));
+
+    // Disabled cache.
+    ModuleSnapshotCache::SetOptions(true, dir, 0);
+    CHECK(!ModuleSnapshotCache::IsEnabled());
+    CHECK(!ModuleSnapshotCache::Load(key3, loaded));
+}
@@ -0,0 +1,141 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include "protocols/msgpack.h"
+
+using ::netcoredbg::MsgPackWriter;
+using ::netcoredbg::MsgPackValue;
+
+namespace
+{
+    std::string Bytes(std::initializer_list<unsigned> bytes)
+    {
+        std::string result;
+        for (unsigned byte : bytes)
+            result.push_back(static_cast<char>(byte));
+        return result;
+    }
+
+    MsgPackValue Roundtrip(const std::string &data)
+    {
+        MsgPackValue value;
+        REQUIRE(MsgPackValue::Parse(data.data(), data.size(), value) == data.size());
+        return value;
+    }
+}
+
+TEST_CASE("MsgPackWriter integers encoding")
+{
+    auto encodeInt = [](int64_t value) { std::string out; MsgPackWriter(out).Int(value); return out; };
+    auto encodeUInt = [](uint64_t value) { std::string out; MsgPackWriter(out).UInt(value); return out; };
+
+    CHECK(encodeUInt(0) == Bytes({0x00}));
+    CHECK(encodeUInt(127) == Bytes({0x7f}));
+    CHECK(encodeUInt(128) == Bytes({0xcc, 0x80}));
+    CHECK(encodeUInt(256) == Bytes({0xcd, 0x01, 0x00}));
+    CHECK(encodeUInt(0x10000) == Bytes({0xce, 0x00, 0x01, 0x00, 0x00}));
+    CHECK(encodeUInt(0x100000000ull) == Bytes({0xcf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00}));
+    CHECK(encodeInt(5) == Bytes({0x05}));
+    CHECK(encodeInt(-1) == Bytes({0xff}));
+    CHECK(encodeInt(-32) == Bytes({0xe0}));
+    CHECK(encodeInt(-33) == Bytes({0xd0, 0xdf}));
+    CHECK(encodeInt(-129) == Bytes({0xd1, 0xff, 0x7f}));
+    CHECK(encodeInt(-40000) == Bytes({0xd2, 0xff, 0xff, 0x63, 0xc0}));
+    CHECK(encodeInt(INT64_MIN) == Bytes({0xd3, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}));
+
+    for (int64_t value : {int64_t(0), int64_t(-1), int64_t(-32), int64_t(-33), int64_t(-128), int64_t(-129),
+                          int64_t(INT16_MIN), int64_t(INT32_MIN), int64_t(INT32_MIN) - 1, INT64_MIN, INT64_MAX})
+    {
+        CHECK(Roundtrip(encodeInt(value)).GetInt() == value);
+    }
+    CHECK(Roundtrip(encodeUInt(UINT64_MAX)).GetUInt() == UINT64_MAX);
+    CHECK(Roundtrip(encodeUInt(UINT64_MAX)).GetInt(42) == 42);
+}
+
+TEST_CASE("MsgPackWriter strings and containers")
+{
+    std::string out;
+    MsgPackWriter(out).String("abc");
+    CHECK(out == Bytes({0xa3, 'a', 'b', 'c'}));
+
+    for (size_t size : {size_t(0), size_t(31), size_t(32), size_t(255), size_t(256), size_t(70000)})
+    {
+        out.clear();
+        std::string str(size, 'x');
+        MsgPackWriter(out).String(str);
+        CHECK(Roundtrip(out).GetString() == str);
+    }
+
+    out.clear();
+    MsgPackWriter writer(out);
+    writer.Map(3)
+        .Key("nil").Nil()
+        .Key("flag").Bool(true)
+        .Key("list").Array(2).Int(-5).String("s");
+
+    MsgPackValue value = Roundtrip(out);
+    REQUIRE(value.IsMap());
+    CHECK(value.GetMap().size() == 3);
+    REQUIRE(value.Find("nil") != nullptr);
+    CHECK(value.Find("nil")->IsNil());
+    CHECK(value.Find("flag")->GetBool() == true);
+    CHECK(value.Find("missing") == nullptr);
+    const MsgPackValue *list = value.Find("list");
+    REQUIRE(list != nullptr);
+    REQUIRE(list->IsArray());
+    REQUIRE(list->GetArray().size() == 2);
+    CHECK(list->GetArray()[0].GetInt() == -5);
+    CHECK(list->GetArray()[1].GetString() == "s");
+
+    for (size_t count : {size_t(15), size_t(16), size_t(70000)})
+    {
+        out.clear();
+        MsgPackWriter arrayWriter(out);
+        arrayWriter.Array(count);
+        for (size_t i = 0; i < count; i++)
+            arrayWriter.UInt(i);
+        MsgPackValue array = Roundtrip(out);
+        REQUIRE(array.GetArray().size() == count);
+        CHECK(array.GetArray()[count - 1].GetUInt() == count - 1);
+    }
+}
+
+TEST_CASE("MsgPackValue parse other types")
+{
+    // float32 1.5, float64 -2.0, bin8
+    CHECK(Roundtrip(Bytes({0xca, 0x3f, 0xc0, 0x00, 0x00})).GetType() == MsgPackValue::Type::Double);
+    CHECK(Roundtrip(Bytes({0xcb, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00})).GetType() == MsgPackValue::Type::Double);
+    CHECK(Roundtrip(Bytes({0xc4, 0x02, 0x01, 0x02})).GetType() == MsgPackValue::Type::Binary);
+    CHECK(Roundtrip(Bytes({0xc2})).GetBool(true) == false);
+    // Type mismatch provide default value.
+    CHECK(Roundtrip(Bytes({0xa1, 'x'})).GetInt(7) == 7);
+    CHECK(Roundtrip(Bytes({0x01})).GetString("def") == "def");
+}
+
+TEST_CASE("MsgPackValue parse malformed data")
+{
+    MsgPackValue value;
+    auto parse = [&](const std::string &data) { return MsgPackValue::Parse(data.data(), data.size(), value); };
+
+    CHECK(parse(std::string()) == 0);
+    CHECK(parse(Bytes({0xc1})) == 0);                    // never used
+    CHECK(parse(Bytes({0xd4, 0x01, 0x02})) == 0);        // extension types not supported
+    CHECK(parse(Bytes({0xa3, 'a', 'b'})) == 0);          // truncated string
+    CHECK(parse(Bytes({0xcd, 0x01})) == 0);              // truncated integer
+    CHECK(parse(Bytes({0x92, 0x01})) == 0);              // truncated array
+    CHECK(parse(Bytes({0xdd, 0xff, 0xff, 0xff, 0xff})) == 0); // huge count
+    CHECK(parse(Bytes({0x81, 0x01, 0x01})) == 0);        // non-string key
+    CHECK(parse(Bytes({0x81, 0xa1, 'k'})) == 0);         // missing map value
+
+    // Nesting depth is limited.
+    std::string nested(1000, static_cast<char>(0x91));
+    nested.push_back(0);
+    CHECK(parse(nested) == 0);
+
+    // Trailing data is not consumed.
+    CHECK(parse(Bytes({0x01, 0x02})) == 1);
+    CHECK(value.GetUInt() == 1);
+}
@@ -0,0 +1,163 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <memory>
+#include "metadata/native_code_cache.h"
+
+using ::netcoredbg::native_code_t;
+using ::netcoredbg::NativeCodeCache;
+
+namespace
+{
+
+    typedef native_code_t::InstructionSet InstructionSet;
+
+    // 0x1000 prolog     [0, 4)
+    // 0x1004 IL_0000    [4, 10)
+    // 0x100a IL_0005    [10, 12)
+    // 0x100c epilog     [12, 16)
+    std::shared_ptr<native_code_t> MakeTestCode(InstructionSet set, uint64_t address = 0x1000, uint64_t modAddress = 0x100)
+    {
+        auto code = std::make_shared<native_code_t>();
+        code->modAddress = modAddress;
+        code->methodToken = 0x06000001;
+        code->address = address;
+        code->code = {0x55, 0x48, 0x2d, 0xe9, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x5d, 0xc3, 0xcc, 0xcc};
+        code->mapping = {
+            {native_code_t::Epilog, 12, 16},
+            {0x05, 10, 12},
+            {native_code_t::Prolog, 0, 4},
+            {0x00, 4, 10}
+        };
+        code->DecodeInstructions(set);
+        return code;
+    }
+
+} // unnamed namespace
+
+TEST_CASE("native_code_t::DecodeInstructions")
+{
+    SECTION("mapping ranges")
+    {
+        auto code = MakeTestCode(InstructionSet::AMD64);
+        CHECK(code->mapping.front().nativeStartOffset == 0);
+        CHECK(code->instructions == std::vector<uint32_t>({0, 4, 10, 12}));
+        CHECK(code->GetInstructionEnd(3) == 16);
+    }
+
+    SECTION("ARM64")
+    {
+        auto code = MakeTestCode(InstructionSet::ARM64);
+        CHECK(code->instructions == std::vector<uint32_t>({0, 4, 8, 12}));
+    }
+
+    SECTION("ARM")
+    {
+        auto code = MakeTestCode(InstructionSet::ARM);
+        // 0x4855 (16-bit), 0xe92d 0x9090 (32-bit), all other are 16-bit.
+        CHECK(code->instructions == std::vector<uint32_t>({0, 2, 6, 8, 10, 12, 14}));
+    }
+}
+
+TEST_CASE("native_code_t::FindInstruction and GetILOffset")
+{
+    auto code = MakeTestCode(InstructionSet::AMD64);
+
+    size_t index = 0;
+    REQUIRE(code->FindInstruction(0, index));
+    CHECK(index == 0);
+    REQUIRE(code->FindInstruction(7, index));
+    CHECK(index == 1);
+    REQUIRE(code->FindInstruction(15, index));
+    CHECK(index == 3);
+    CHECK(!code->FindInstruction(16, index));
+
+    CHECK(code->GetILOffset(2) == native_code_t::Prolog);
+    CHECK(code->GetILOffset(9) == 0x00);
+    CHECK(code->GetILOffset(10) == 0x05);
+    CHECK(code->GetILOffset(13) == native_code_t::Epilog);
+    CHECK(code->GetILOffset(16) == native_code_t::NoMapping);
+}
+
+TEST_CASE("native_code_t::Disassemble")
+{
+    auto code = MakeTestCode(InstructionSet::ARM64);
+    std::vector<native_code_t::instruction_t> result;
+
+    SECTION("inside code")
+    {
+        code->Disassemble(0x1006, 0, 2, result);
+        REQUIRE(result.size() == 2);
+        CHECK(result[0].valid);
+        CHECK(result[0].address == 0x1004);
+        CHECK(result[0].bytes == "90 90 90 90");
+        CHECK(result[0].text == "IL_0000: .inst 0x90909090");
+        CHECK(result[1].address == 0x1008);
+    }
+
+    SECTION("out of code")
+    {
+        code->Disassemble(0x1000, -2, 7, result);
+        REQUIRE(result.size() == 7);
+        CHECK(!result[0].valid);
+        CHECK(result[0].address == 0xff8);
+        CHECK(!result[1].valid);
+        CHECK(result[1].address == 0xffc);
+        CHECK(result[2].valid);
+        CHECK(result[2].text == "prolog: .inst 0xe92d4855");
+        CHECK(result[5].valid);
+        CHECK(result[5].ilOffset == native_code_t::Epilog);
+        CHECK(!result[6].valid);
+        CHECK(result[6].address == 0x1010);
+    }
+
+    SECTION("after code")
+    {
+        code->Disassemble(0x1018, -3, 2, result);
+        REQUIRE(result.size() == 2);
+        CHECK(result[0].valid);
+        CHECK(result[0].address == 0x100c);
+        CHECK(!result[1].valid);
+        CHECK(result[1].address == 0x1010);
+    }
+}
+
+TEST_CASE("NativeCodeCache")
+{
+    NativeCodeCache cache(2);
+
+    cache.Put(MakeTestCode(InstructionSet::AMD64, 0x1000, 0x100));
+    cache.Put(MakeTestCode(InstructionSet::AMD64, 0x2000, 0x200));
+
+    REQUIRE(cache.Find(0x100f) != nullptr);
+    CHECK(cache.Find(0x100f)->address == 0x1000);
+    CHECK(cache.Find(0x1010) == nullptr);
+    CHECK(cache.Find(0xfff) == nullptr);
+
+    SECTION("LRU eviction")
+    {
+        // 0x1000 was used last, 0x2000 must be evicted.
+        cache.Put(MakeTestCode(InstructionSet::AMD64, 0x3000, 0x100));
+        CHECK(cache.Find(0x2000) == nullptr);
+        CHECK(cache.Find(0x1000) != nullptr);
+        CHECK(cache.Find(0x3000) != nullptr);
+    }
+
+    SECTION("module invalidation")
+    {
+        cache.InvalidateModule(0x100);
+        CHECK(cache.Find(0x1000) == nullptr);
+        CHECK(cache.Find(0x2000) != nullptr);
+        cache.Clear();
+        CHECK(cache.Find(0x2000) == nullptr);
+    }
+
+    SECTION("zero size cache")
+    {
+        NativeCodeCache disabled(0);
+        disabled.Put(MakeTestCode(InstructionSet::AMD64));
+        CHECK(disabled.Find(0x1000) == nullptr);
+    }
+}
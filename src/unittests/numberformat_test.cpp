@@ -0,0 +1,158 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "debugger/numberformat.h"
+#include "benchmark.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    // Reference conversion, one digit per long division pass (as previously used for decimals).
+    std::string Reference(std::vector<uint32_t> words)
+    {
+        std::string result;
+        do
+        {
+            uint64_t remainder = 0;
+            for (size_t i = words.size(); i-- > 0;)
+            {
+                const uint64_t dividend = (remainder << 32) | words[i];
+                words[i] = static_cast<uint32_t>(dividend / 10);
+                remainder = dividend % 10;
+            }
+            result.insert(0, 1, static_cast<char>('0' + remainder));
+        } while (std::any_of(words.begin(), words.end(), [](uint32_t w) { return w != 0; }));
+        return result;
+    }
+
+    std::string ToString(std::vector<uint32_t> words)
+    {
+        return NumberFormat::UIntToString(words.data(), words.size());
+    }
+
+    const uint32_t Negative = 1ul << 31;
+    uint32_t Scale(uint32_t scale) { return scale << 16; }
+}
+
+TEST_CASE("NumberFormat::UInt")
+{
+    CHECK(ToString({}) == "0");
+    CHECK(ToString({0, 0, 0}) == "0");
+    CHECK(ToString({7}) == "7");
+    CHECK(ToString({999999999}) == "999999999");
+    CHECK(ToString({1000000000}) == "1000000000");
+    CHECK(ToString({1000000001}) == "1000000001");
+    CHECK(ToString({0xFFFFFFFF}) == "4294967295");
+    CHECK(ToString({0, 1}) == "4294967296");
+    CHECK(ToString({0xFFFFFFFF, 0xFFFFFFFF}) == "18446744073709551615");
+    CHECK(ToString({0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF}) == "79228162514264337593543950335");
+    // 10^18, chunk with zeros only in the middle.
+    CHECK(ToString({0xA7640000, 0x0DE0B6B3}) == "1000000000000000000");
+
+    std::mt19937 gen(42);
+    for (size_t count = 1; count < 40; count++)
+    {
+        std::vector<uint32_t> words(count);
+        for (auto &word : words)
+            word = gen() % 4 == 0 ? 0 : static_cast<uint32_t>(gen());
+        REQUIRE(ToString(words) == Reference(words));
+    }
+}
+
+TEST_CASE("NumberFormat::Decimal")
+{
+    CHECK(NumberFormat::DecimalToString(0, 0, 0, 0) == "0");
+    CHECK(NumberFormat::DecimalToString(0, 0, 12345, 0) == "12345");
+    CHECK(NumberFormat::DecimalToString(0, 0, 12345, Scale(2)) == "123.45");
+    CHECK(NumberFormat::DecimalToString(0, 0, 12345, Scale(2) | Negative) == "-123.45");
+    CHECK(NumberFormat::DecimalToString(0, 0, 5, Scale(3)) == "0.005");
+    CHECK(NumberFormat::DecimalToString(0, 0, 100, Scale(2)) == "1.00");
+    CHECK(NumberFormat::DecimalToString(0, 0, 0, Scale(2)) == "0.00");
+    CHECK(NumberFormat::DecimalToString(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0) == "79228162514264337593543950335");
+    CHECK(NumberFormat::DecimalToString(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, Scale(28) | Negative) == "-7.9228162514264337593543950335");
+}
+
+TEST_CASE("NumberFormat::BigInteger")
+{
+    std::vector<uint32_t> words = {0, 0, 0, 1};
+    CHECK(NumberFormat::BigIntegerToString(false, words.data(), words.size()) == "79228162514264337593543950336");
+    words = {0, 0, 0, 1};
+    CHECK(NumberFormat::BigIntegerToString(true, words.data(), words.size()) == "-79228162514264337593543950336");
+    words = {0};
+    CHECK(NumberFormat::BigIntegerToString(true, words.data(), words.size()) == "0");
+}
+
+TEST_CASE("NumberFormat::DateTime")
+{
+    const uint64_t KindUtc = 0x4000000000000000ull;
+    CHECK(NumberFormat::DateTimeToString(0) == "01/01/0001 00:00:00");
+    CHECK(NumberFormat::DateTimeToString(639275870450000000ull) == "10/14/2026 15:04:05");
+    CHECK(NumberFormat::DateTimeToString(639275870450000000ull | KindUtc) == "10/14/2026 15:04:05");
+    CHECK(NumberFormat::DateTimeToString(639275870459999999ull) == "10/14/2026 15:04:05");
+    CHECK(NumberFormat::DateTimeToString(638448479990000000ull) == "02/29/2024 23:59:59");
+    CHECK(NumberFormat::DateTimeToString(630873792000000000ull) == "02/29/2000 00:00:00");
+    CHECK(NumberFormat::DateTimeToString(599317056000000000ull) == "03/01/1900 00:00:00");
+    CHECK(NumberFormat::DateTimeToString(639343152000000000ull) == "12/31/2026 12:00:00");
+    CHECK(NumberFormat::DateTimeToString(3155378975999999999ull) == "12/31/9999 23:59:59");
+
+    // UTC time 10/14/2026 15:04:05 in +03:00 and -05:30 time zones.
+    CHECK(NumberFormat::DateTimeOffsetToString(639275870450000000ull, 180) == "10/14/2026 18:04:05 +03:00");
+    CHECK(NumberFormat::DateTimeOffsetToString(639275870450000000ull, -330) == "10/14/2026 09:34:05 -05:30");
+    CHECK(NumberFormat::DateTimeOffsetToString(639275870450000000ull, 0) == "10/14/2026 15:04:05 +00:00");
+}
+
+TEST_CASE("NumberFormat::TimeSpan")
+{
+    CHECK(NumberFormat::TimeSpanToString(0) == "00:00:00");
+    CHECK(NumberFormat::TimeSpanToString(10000000) == "00:00:01");
+    CHECK(NumberFormat::TimeSpanToString(-10000000) == "-00:00:01");
+    CHECK(NumberFormat::TimeSpanToString(1234567) == "00:00:00.1234567");
+    CHECK(NumberFormat::TimeSpanToString(1) == "00:00:00.0000001");
+    CHECK(NumberFormat::TimeSpanToString(36610000000ll + 864000000000ll * 2) == "2.01:01:01");
+    CHECK(NumberFormat::TimeSpanToString(INT64_MAX) == "10675199.02:48:05.4775807");
+    CHECK(NumberFormat::TimeSpanToString(INT64_MIN) == "-10675199.02:48:05.4775808");
+}
+
+TEST_CASE("NumberFormat::Guid")
+{
+    // new Guid("0f8fad5b-d9cb-469f-a165-70867728950e") in little-endian memory.
+    const uint8_t data[16] = {0x5b, 0xad, 0x8f, 0x0f, 0xcb, 0xd9, 0x9f, 0x46, 0xa1, 0x65, 0x70, 0x86, 0x77, 0x28, 0x95, 0x0e};
+    CHECK(NumberFormat::GuidToString(data) == "0f8fad5b-d9cb-469f-a165-70867728950e");
+    const uint8_t empty[16] = {};
+    CHECK(NumberFormat::GuidToString(empty) == "00000000-0000-0000-0000-000000000000");
+}
+
+// run with `numberformat "[.benchmark]"`.
+TEST_CASE("NumberFormat::Benchmark", "[.benchmark]")
+{
+    // Typical financial values grid: scale 2-4, 12-20 digits.
+    std::mt19937 gen(42);
+    std::vector<std::vector<uint32_t>> decimals;
+    for (int i = 0; i < 1024; i++)
+        decimals.push_back({static_cast<uint32_t>(gen()), static_cast<uint32_t>(gen() % 0x10000), 0, Scale(2 + gen() % 3)});
+
+    size_t index = 0;
+    Benchmark::Measure("decimal to string, 10^9 chunks", 0, [&]() {
+        const auto &d = decimals[index++ % decimals.size()];
+        return NumberFormat::DecimalToString(d[2], d[1], d[0], d[3]).size();
+    });
+    Benchmark::Measure("decimal to string, digit per pass (reference)", 0, [&]() {
+        const auto &d = decimals[index++ % decimals.size()];
+        return Reference({d[0], d[1], d[2]}).size();
+    });
+
+    std::vector<uint32_t> big(64);
+    for (auto &word : big)
+        word = static_cast<uint32_t>(gen());
+    Benchmark::Measure("BigInteger (2048 bits) to string", 0, [&]() {
+        std::vector<uint32_t> words(big);
+        return NumberFormat::BigIntegerToString(false, words.data(), words.size()).size();
+    });
+}
@@ -0,0 +1,145 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "protocols/outputcoalescer.h"
+
+using ::netcoredbg::OutputCoalescer;
+using string_view = ::netcoredbg::Utility::string_view;
+
+namespace
+{
+    struct Output
+    {
+        std::mutex mutex;
+        std::vector<std::pair<int, std::string>> blocks;
+
+        OutputCoalescer::FlushCallback Callback()
+        {
+            return [this](int category, string_view text)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                blocks.emplace_back(category, std::string(text.data(), text.size()));
+            };
+        }
+
+        size_t Size()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return blocks.size();
+        }
+    };
+}
+
+TEST_CASE("OutputCoalescer merges chunks")
+{
+    Output output;
+    OutputCoalescer coalescer(output.Callback());
+    OutputCoalescer::Options options;
+    options.windowMs = 10000;
+    coalescer.SetOptions(options);
+
+    coalescer.Add(1, "abc");
+    coalescer.Add(1, "def\n");
+    coalescer.Add(2, "err");
+    coalescer.Add(1, "ghi");
+    coalescer.Flush();
+
+    REQUIRE(output.blocks.size() == 3);
+    CHECK(output.blocks[0] == std::make_pair(1, std::string("abcdef\n")));
+    CHECK(output.blocks[1] == std::make_pair(2, std::string("err")));
+    CHECK(output.blocks[2] == std::make_pair(1, std::string("ghi")));
+}
+
+TEST_CASE("OutputCoalescer flushes by time and size window")
+{
+    Output output;
+    OutputCoalescer coalescer(output.Callback());
+    OutputCoalescer::Options options;
+    options.windowMs = 5;
+    options.windowSize = 8;
+    coalescer.SetOptions(options);
+
+    coalescer.Add(1, "abc");
+    for (int i = 0; i < 200 && output.Size() == 0; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    REQUIRE(output.Size() == 1);
+    CHECK(output.blocks[0].second == "abc");
+
+    options.windowMs = 10000;
+    coalescer.SetOptions(options);
+    coalescer.Add(1, "0123456789");
+    for (int i = 0; i < 200 && output.Size() == 1; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    REQUIRE(output.Size() == 2);
+    CHECK(output.blocks[1].second == "0123456789");
+}
+
+TEST_CASE("OutputCoalescer drops output over limit")
+{
+    Output output;
+    OutputCoalescer coalescer(output.Callback());
+    OutputCoalescer::Options options;
+    options.windowMs = 10000;
+    options.windowSize = 1000;
+    options.maxPendingSize = 10;
+    options.backpressureMs = 1;
+    coalescer.SetOptions(options);
+
+    coalescer.Add(1, "01234567");
+    coalescer.Add(1, "abcd");
+    coalescer.Add(1, "ef");
+    coalescer.Add(1, "xyz");
+    coalescer.Flush();
+
+    // Note, "ef" fit into pending limit, "abcd" and "xyz" don't.
+    CHECK(coalescer.GetSuppressedBytes() == 7);
+    REQUIRE(output.blocks.size() == 2);
+    CHECK(output.blocks[0].second == "01234567ef");
+    CHECK(output.blocks[1].second == "\n<7 bytes suppressed>\n");
+
+    coalescer.Add(1, "next\n");
+    coalescer.Flush();
+    REQUIRE(output.blocks.size() == 3);
+    CHECK(output.blocks[2].second == "next\n");
+}
+
+TEST_CASE("OutputCoalescer rate limit")
+{
+    Output output;
+    OutputCoalescer coalescer(output.Callback());
+    OutputCoalescer::Options options;
+    options.windowMs = 0;
+    options.rateLimit = 1000;
+    options.backpressureMs = 0;
+    options.maxPendingSize = 100;
+    coalescer.SetOptions(options);
+
+    std::string chunk(100, 'a');
+    for (int i = 0; i < 100; i++)
+    {
+        coalescer.Add(1, chunk);
+    }
+    coalescer.Flush();
+
+    // Note, 1000 bytes per second budget allow ~10 chunks output, all other chunks must be dropped.
+    CHECK(coalescer.GetSuppressedBytes() > 5000);
+    size_t total = 0;
+    for (auto &block : output.blocks)
+    {
+        if (block.second[0] == 'a')
+            total += block.second.size();
+    }
+    CHECK(total + coalescer.GetSuppressedBytes() == 100 * chunk.size());
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utils/perfcounters.h"
+
+namespace PerfCounters = ::netcoredbg::PerfCounters;
+
+namespace
+{
+
+    PerfCounters::Counter testSum("testSum");
+    PerfCounters::Counter testTime("testTimeUs");
+    PerfCounters::Gauge testGauge("testGauge");
+
+} // unnamed namespace
+
+TEST_CASE("PerfCounters::Disabled")
+{
+    PerfCounters::Enable(false);
+    PerfCounters::Reset();
+
+    testSum.Add(10);
+    testGauge.Set(5);
+    {
+        PerfCounters::ScopedTime time(testTime);
+    }
+    CHECK(testSum.GetValue() == 0);
+    CHECK(testGauge.GetValue() == 0);
+    CHECK(testGauge.GetMax() == 0);
+    CHECK(testTime.GetValue() == 0);
+}
+
+TEST_CASE("PerfCounters::Enabled")
+{
+    PerfCounters::Enable(true);
+    PerfCounters::Reset();
+
+    testSum.Add();
+    testSum.Add(2);
+    CHECK(testSum.GetValue() == 3);
+
+    testGauge.Set(5);
+    testGauge.Set(2);
+    CHECK(testGauge.GetValue() == 2);
+    CHECK(testGauge.GetMax() == 5);
+
+    {
+        PerfCounters::ScopedTime time(testTime);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    CHECK(testTime.GetValue() >= 2000);
+
+    const int threadsCount = 4;
+    const int addsCount = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadsCount; t++)
+    {
+        threads.emplace_back([]()
+        {
+            for (int i = 0; i < addsCount; i++)
+            {
+                testSum.Add();
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    CHECK(testSum.GetValue() == 3 + threadsCount * addsCount);
+
+    PerfCounters::Reset();
+    testSum.Add(7);
+    testGauge.Set(3);
+    CHECK(PerfCounters::DumpJSON() == "{\"testGauge\":{\"value\":3,\"max\":3},\"testSum\":7,\"testTimeUs\":0}");
+
+    PerfCounters::Enable(false);
+}
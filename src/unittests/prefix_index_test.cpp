@@ -0,0 +1,104 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+#include "metadata/prefix_index.h"
+
+using ::netcoredbg::PrefixIndex;
+
+namespace
+{
+
+    std::vector<std::string> Find(PrefixIndex &index, const char *pattern, size_t limit = 100)
+    {
+        std::vector<PrefixIndex::match_t> matches;
+        index.Find(::netcoredbg::Utility::string_view(pattern), limit, matches);
+
+        std::vector<std::string> result;
+        for (const auto &match : matches)
+        {
+            result.push_back(*match.name);
+        }
+        return result;
+    }
+
+} // unnamed namespace
+
+TEST_CASE("PrefixIndex::ComponentsMatch")
+{
+    PrefixIndex index(".");
+    index.Add("NS.Program.Main");
+    index.Add("NS.Program.MainAsync");
+    index.Add("NS.Helper.Do");
+    index.Add("Other.Main");
+
+    CHECK(Find(index, "Main") == std::vector<std::string>({"Other.Main", "NS.Program.Main", "NS.Program.MainAsync"}));
+    CHECK(Find(index, "NS.Pro") == std::vector<std::string>({"NS.Program.Main", "NS.Program.MainAsync"}));
+    CHECK(Find(index, "Helper.") == std::vector<std::string>({"NS.Helper.Do"}));
+    CHECK(Find(index, "ain").empty()); // not component start
+    CHECK(Find(index, "Missing").empty());
+    CHECK(Find(index, "").size() == 4);
+}
+
+TEST_CASE("PrefixIndex::Ranking")
+{
+    PrefixIndex index("/\\");
+    index.Add("/home/user/src/Program.cs");
+    index.Add("Program.cs");
+    index.Add("/src/Program.cs");
+    index.Add("Prog.cs");
+
+    // whole name prefix first, then shorter
+    CHECK(Find(index, "Prog") == std::vector<std::string>({"Prog.cs", "Program.cs", "/src/Program.cs", "/home/user/src/Program.cs"}));
+    CHECK(Find(index, "src") == std::vector<std::string>({"/src/Program.cs", "/home/user/src/Program.cs"}));
+}
+
+TEST_CASE("PrefixIndex::Limit")
+{
+    PrefixIndex index(".");
+    for (int i = 9; i >= 0; i--)
+    {
+        index.Add("A.Func" + std::to_string(i));
+    }
+    index.Add("Func");
+
+    CHECK(Find(index, "Func", 0).empty());
+    CHECK(Find(index, "Func", 3) == std::vector<std::string>({"Func", "A.Func0", "A.Func1"}));
+    CHECK(Find(index, "A.Func", 2) == std::vector<std::string>({"A.Func0", "A.Func1"}));
+}
+
+TEST_CASE("PrefixIndex::DuplicatedComponents")
+{
+    PrefixIndex index(".");
+    index.Add("Foo.Foo.Foo");
+    index.Add("Bar.Foo.Foo");
+
+    // one match per name, best component used for ranking
+    CHECK(Find(index, "Foo") == std::vector<std::string>({"Foo.Foo.Foo", "Bar.Foo.Foo"}));
+
+    std::vector<PrefixIndex::match_t> matches;
+    index.Find("Foo", 10, matches);
+    REQUIRE(matches.size() == 2);
+    CHECK(matches[0].offset == 0);
+    CHECK(matches[1].offset == 4);
+}
+
+TEST_CASE("PrefixIndex::IncrementalAdd")
+{
+    PrefixIndex index(".");
+    index.Add("B.Second");
+    CHECK(Find(index, "Second") == std::vector<std::string>({"B.Second"}));
+
+    index.Add("A.Second");
+    index.Add("C.Third");
+    CHECK(Find(index, "Second") == std::vector<std::string>({"A.Second", "B.Second"}));
+    CHECK(Find(index, "Third") == std::vector<std::string>({"C.Third"}));
+    CHECK(index.Size() == 3);
+
+    index.Clear();
+    CHECK(index.Size() == 0);
+    CHECK(Find(index, "Second").empty());
+}
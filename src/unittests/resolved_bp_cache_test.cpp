@@ -0,0 +1,140 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "metadata/resolved_bp_cache.h"
+#include "utils/filesystem.h"
+#include "temp_dir.h"
+
+using ::netcoredbg::ResolvedBreakpointsCache;
+using ::netcoredbg::Test::TempDir;
+
+namespace
+{
+    std::string ModuleId(unsigned n)
+    {
+        std::ostringstream ss;
+        ss << std::hex << "0000" << n << "-0000-0000-0000-000000000000";
+        return ss.str();
+    }
+
+    ResolvedBreakpointsCache::module_entries_t MakeEntries()
+    {
+        ResolvedBreakpointsCache::module_entries_t entries;
+        ResolvedBreakpointsCache::entry_t entry;
+        entry.fullname = "/src/dir with space/Program.cs";
+        entry.startLine = 12;
+        entry.endLine = 13;
+        entry.points.push_back({0x06000001, 0});
+        entry.points.push_back({0x06000007, 0x1c});
+        entries.emplace(std::make_pair(std::string("Program.cs"), 11), entry);
+        entry.points.resize(1);
+        entries.emplace(std::make_pair(std::string("/src/dir with space/Program.cs"), 12), entry);
+        return entries;
+    }
+}
+
+TEST_CASE("ResolvedBreakpointsCache::StoreLoad")
+{
+    const TempDir tempDir("netcoredbg-bpcache-test-");
+    const std::string &dir = tempDir.Path();
+    ResolvedBreakpointsCache::SetOptions(true, dir);
+    const std::string id = ModuleId(1);
+    ResolvedBreakpointsCache::module_entries_t entries;
+
+    CHECK(!ResolvedBreakpointsCache::Load(id, entries));
+
+    const ResolvedBreakpointsCache::module_entries_t stored = MakeEntries();
+    ResolvedBreakpointsCache::Store(id, stored);
+    REQUIRE(ResolvedBreakpointsCache::Load(id, entries));
+    REQUIRE(entries.size() == stored.size());
+    auto find = entries.find(std::make_pair(std::string("Program.cs"), 11));
+    REQUIRE(find != entries.end());
+    CHECK(find->second.fullname == "/src/dir with space/Program.cs");
+    CHECK(find->second.startLine == 12);
+    CHECK(find->second.endLine == 13);
+    REQUIRE(find->second.points.size() == 2);
+    CHECK(find->second.points[1].methodToken == 0x06000007);
+    CHECK(find->second.points[1].ilOffset == 0x1c);
+
+    // Reload from disk, as new debugger instance do.
+    ResolvedBreakpointsCache::SetOptions(true, dir);
+    entries.clear();
+    CHECK(ResolvedBreakpointsCache::Load(id, entries));
+    CHECK(entries.size() == stored.size());
+
+    // Empty entries remove module.
+    ResolvedBreakpointsCache::Store(id, ResolvedBreakpointsCache::module_entries_t());
+    CHECK(!ResolvedBreakpointsCache::Load(id, entries));
+
+    // Module ID is used as file name.
+    ResolvedBreakpointsCache::Store("../evil", stored);
+    CHECK(!ResolvedBreakpointsCache::Load("../evil", entries));
+
+    ResolvedBreakpointsCache::SetOptions(false, dir);
+    ResolvedBreakpointsCache::Store(id, stored);
+    CHECK(!ResolvedBreakpointsCache::Load(id, entries));
+}
+
+TEST_CASE("ResolvedBreakpointsCache::WrongFormat")
+{
+    const TempDir tempDir("netcoredbg-bpcache-test-");
+    const std::string &dir = tempDir.Path();
+    ResolvedBreakpointsCache::SetOptions(true, dir);
+    const std::string id = ModuleId(2);
+    ResolvedBreakpointsCache::Store(id, MakeEntries());
+
+    const std::string path = dir + ::netcoredbg::FileSystem::PathSeparator + id + ".bps";
+    std::string data;
+    {
+        std::ifstream file(path, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    REQUIRE(data.size() > 20);
+
+    // Truncated entry.
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size() - 5);
+    }
+    ResolvedBreakpointsCache::module_entries_t entries;
+    CHECK(!ResolvedBreakpointsCache::Load(id, entries));
+    CHECK(entries.empty());
+
+    // Wrong version.
+    data[8] = 100;
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size());
+    }
+    CHECK(!ResolvedBreakpointsCache::Load(id, entries));
+}
+
+TEST_CASE("ResolvedBreakpointsCache::Eviction")
+{
+    const TempDir tempDir("netcoredbg-bpcache-test-");
+    const std::string &dir = tempDir.Path();
+    ResolvedBreakpointsCache::SetOptions(true, dir);
+    const ResolvedBreakpointsCache::module_entries_t stored = MakeEntries();
+    for (unsigned i = 0; i < ResolvedBreakpointsCache::MaxModules + 2; i++)
+    {
+        ResolvedBreakpointsCache::Store(ModuleId(i), stored);
+    }
+
+    ResolvedBreakpointsCache::module_entries_t entries;
+    CHECK(!ResolvedBreakpointsCache::Load(ModuleId(0), entries));
+    CHECK(!ResolvedBreakpointsCache::Load(ModuleId(1), entries));
+    CHECK(ResolvedBreakpointsCache::Load(ModuleId(2), entries));
+    CHECK(ResolvedBreakpointsCache::Load(ModuleId(ResolvedBreakpointsCache::MaxModules + 1), entries));
+
+    // Restored module become newest.
+    ResolvedBreakpointsCache::Store(ModuleId(2), stored);
+    ResolvedBreakpointsCache::Store(ModuleId(1000), stored);
+    CHECK(ResolvedBreakpointsCache::Load(ModuleId(2), entries));
+    CHECK(!ResolvedBreakpointsCache::Load(ModuleId(3), entries));
+}
@@ -0,0 +1,171 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <memory>
+#include "metadata/sequence_points_cache.h"
+
+using ::netcoredbg::method_sequence_points_t;
+using ::netcoredbg::SequencePointsCache;
+
+namespace
+{
+
+    const int32_t Hidden = method_sequence_points_t::HiddenLine;
+
+    // IL_0000 line 10 (user code)
+    // IL_0005 hidden
+    // IL_000a line 11 (user code)
+    // IL_0010 hidden
+    // IL_0014 line 12 (user code)
+    SequencePointsCache::entry_t MakeTestMethod()
+    {
+        auto data = std::make_shared<method_sequence_points_t>();
+        static const std::string document = "/src/Program.cs";
+        data->documents.emplace_back(&document);
+        data->points = {
+            {10, 9, 10, 20, 0x00, 0},
+            {Hidden, 0, Hidden, 0, 0x05, 0},
+            {11, 9, 11, 30, 0x0a, 0},
+            {Hidden, 0, Hidden, 0, 0x10, 0},
+            {12, 5, 12, 6, 0x14, 0}
+        };
+        return data;
+    }
+
+} // unnamed namespace
+
+TEST_CASE("SequencePoints::GetSequencePointByILOffset")
+{
+    auto data = MakeTestMethod();
+    method_sequence_points_t::point_t point;
+
+    REQUIRE(data->GetSequencePointByILOffset(0x00, point));
+    CHECK(point.startLine == 10);
+    REQUIRE(data->GetSequencePointByILOffset(0x07, point));
+    CHECK(point.startLine == 10); // hidden point skipped
+    REQUIRE(data->GetSequencePointByILOffset(0x0a, point));
+    CHECK(point.startLine == 11);
+    REQUIRE(data->GetSequencePointByILOffset(0x100, point));
+    CHECK(point.startLine == 12);
+    CHECK(point.documentIndex == 0);
+
+    method_sequence_points_t empty;
+    CHECK(!empty.GetSequencePointByILOffset(0, point));
+}
+
+TEST_CASE("SequencePoints::GetNextUserCodeILOffset")
+{
+    auto data = MakeTestMethod();
+    uint32_t next = 0;
+    bool noUserCodeFound = true;
+
+    REQUIRE(data->GetNextUserCodeILOffset(0x05, next, &noUserCodeFound));
+    CHECK(next == 0x0a);
+    CHECK(!noUserCodeFound);
+    REQUIRE(data->GetNextUserCodeILOffset(0x14, next, nullptr));
+    CHECK(next == 0x14);
+    CHECK(!data->GetNextUserCodeILOffset(0x15, next, &noUserCodeFound));
+    CHECK(noUserCodeFound);
+}
+
+TEST_CASE("SequencePoints::GetStepRangesFromIP")
+{
+    auto data = MakeTestMethod();
+    uint32_t start = 0;
+    uint32_t end = 0;
+
+    REQUIRE(data->GetStepRangesFromIP(0x00, start, end));
+    CHECK(start == 0x00);
+    CHECK(end == 0x0a);
+    // range start at hidden sequence point, but end at next user code sequence point
+    REQUIRE(data->GetStepRangesFromIP(0x06, start, end));
+    CHECK(start == 0x05);
+    CHECK(end == 0x0a);
+    REQUIRE(data->GetStepRangesFromIP(0x12, start, end));
+    CHECK(start == 0x10);
+    CHECK(end == 0x14);
+    // last range, end should be set to IL code size by caller
+    REQUIRE(data->GetStepRangesFromIP(0x16, start, end));
+    CHECK(start == 0x14);
+    CHECK(end == start);
+
+    method_sequence_points_t empty;
+    CHECK(!empty.GetStepRangesFromIP(0, start, end));
+}
+
+TEST_CASE("SequencePoints::PointEncoding")
+{
+    method_sequence_points_t::point_t point(100, 9, 103, 20, 0x10, 2);
+    CHECK(point.startLine == 100);
+    CHECK(point.EndLine() == 103);
+    CHECK(point.startColumn == 9);
+    CHECK(point.endColumn == 20);
+    CHECK(point.offset == 0x10);
+    CHECK(point.documentIndex == 2);
+
+    method_sequence_points_t::point_t hidden(Hidden, 0, Hidden, 0, 0x05, -1);
+    CHECK(!hidden.IsUserCode());
+    CHECK(hidden.EndLine() == Hidden);
+    CHECK(hidden.documentIndex == -1);
+
+#ifdef NCDB_EMBEDDED_PROFILE
+    CHECK(sizeof(method_sequence_points_t::point_t) == 16);
+    method_sequence_points_t::point_t saturated(10, 100000, 100000, 70000, 0x20, 40000);
+    CHECK(saturated.startColumn == 65535);
+    CHECK(saturated.endColumn == 65535);
+    CHECK(saturated.EndLine() == 10 + 65535);
+    CHECK(saturated.documentIndex == -1);
+#endif
+}
+
+TEST_CASE("SequencePointsCache::GetPut")
+{
+    SequencePointsCache cache;
+    auto data = MakeTestMethod();
+
+    CHECK(cache.Get(0x1000, 0x06000001, 1) == nullptr);
+    cache.Put(0x1000, 0x06000001, 1, data);
+    CHECK(cache.Get(0x1000, 0x06000001, 1) == data);
+    // key include module, token and method version
+    CHECK(cache.Get(0x2000, 0x06000001, 1) == nullptr);
+    CHECK(cache.Get(0x1000, 0x06000002, 1) == nullptr);
+    CHECK(cache.Get(0x1000, 0x06000001, 2) == nullptr);
+
+    cache.Clear();
+    CHECK(cache.Get(0x1000, 0x06000001, 1) == nullptr);
+}
+
+TEST_CASE("SequencePointsCache::Eviction")
+{
+    SequencePointsCache cache(2);
+    auto data = MakeTestMethod();
+
+    cache.Put(0x1000, 1, 1, data);
+    cache.Put(0x1000, 2, 1, data);
+    CHECK(cache.Get(0x1000, 1, 1) != nullptr); // token 2 is least recently used now
+    cache.Put(0x1000, 3, 1, data);
+    CHECK(cache.Get(0x1000, 1, 1) != nullptr);
+    CHECK(cache.Get(0x1000, 2, 1) == nullptr);
+    CHECK(cache.Get(0x1000, 3, 1) != nullptr);
+
+    SequencePointsCache disabled(0);
+    disabled.Put(0x1000, 1, 1, data);
+    CHECK(disabled.Get(0x1000, 1, 1) == nullptr);
+}
+
+TEST_CASE("SequencePointsCache::InvalidateModule")
+{
+    SequencePointsCache cache;
+    auto data = MakeTestMethod();
+
+    cache.Put(0x1000, 1, 1, data);
+    cache.Put(0x1000, 1, 2, data);
+    cache.Put(0x2000, 1, 1, data);
+
+    cache.InvalidateModule(0x1000);
+    CHECK(cache.Get(0x1000, 1, 1) == nullptr);
+    CHECK(cache.Get(0x1000, 1, 2) == nullptr);
+    CHECK(cache.Get(0x2000, 1, 1) != nullptr);
+}
@@ -0,0 +1,111 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utils/sequenced_executor.h"
+#include "benchmark.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    // Emulation of debugger's shared state: "protocol" thread do short requests under state lock, while "callbacks" thread
+    // update state and do slow work (for example, cache write to disk) for each update.
+    const int Requests = 2000;
+    const std::chrono::microseconds SlowWork(200);
+
+    void SlowWorkEmulation()
+    {
+        auto end = std::chrono::steady_clock::now() + SlowWork;
+        while (std::chrono::steady_clock::now() < end)
+        {
+        }
+    }
+
+    template <typename Update>
+    std::vector<std::chrono::nanoseconds> MeasureRequestsLatency(std::mutex &stateMutex, Update &&update)
+    {
+        std::atomic<bool> stop(false);
+        std::thread callbacks([&]()
+        {
+            while (!stop)
+            {
+                update();
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        });
+
+        std::vector<std::chrono::nanoseconds> latency;
+        latency.reserve(Requests);
+        size_t state = 0;
+        for (int i = 0; i < Requests; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                state++;
+            }
+            latency.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        Benchmark::DoNotOptimize(state);
+
+        stop = true;
+        callbacks.join();
+        std::sort(latency.begin(), latency.end());
+        return latency;
+    }
+
+    void ReportPercentiles(const std::string &name, const std::vector<std::chrono::nanoseconds> &latency)
+    {
+        const std::pair<const char*, double> percentiles[] = {{"p50", 0.5}, {"p99", 0.99}, {"max", 1.0}};
+        for (const auto &percentile : percentiles)
+        {
+            const size_t index = std::min(latency.size() - 1, size_t(double(latency.size()) * percentile.second));
+            Benchmark::Report((name + " " + percentile.first).c_str(), 1, latency[index]);
+        }
+    }
+}
+
+// Note, reported "ns/op" is request latency (lock wait included) for percentile.
+TEST_CASE("SequencedExecutor request latency", "[.benchmark]")
+{
+    std::mutex stateMutex;
+    size_t state = 0;
+
+    ReportPercentiles("request latency, slow work under state lock", MeasureRequestsLatency(stateMutex, [&]()
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        state++;
+        SlowWorkEmulation();
+    }));
+
+    SequencedExecutor executor("Bench");
+    std::atomic<unsigned> queued(0);
+    ReportPercentiles("request latency, slow work posted to executor", MeasureRequestsLatency(stateMutex, [&]()
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        state++;
+        // Note, limit queue size, so, executor do same amount of work.
+        if (queued >= 4)
+            return;
+        queued++;
+        const size_t copy = state;
+        executor.Post([&queued, copy]()
+        {
+            Benchmark::DoNotOptimize(copy);
+            SlowWorkEmulation();
+            queued--;
+        });
+    }));
+    executor.WaitIdle();
+    Benchmark::DoNotOptimize(state);
+}
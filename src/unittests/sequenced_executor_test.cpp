@@ -0,0 +1,79 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "utils/sequenced_executor.h"
+
+using ::netcoredbg::SequencedExecutor;
+
+TEST_CASE("SequencedExecutor::Order")
+{
+    std::vector<int> order;
+    {
+        SequencedExecutor executor("Test");
+        for (int i = 0; i < 100; i++)
+        {
+            executor.Post([&order, i]() { order.push_back(i); });
+        }
+        executor.WaitIdle();
+        REQUIRE(order.size() == 100);
+        for (int i = 0; i < 100; i++)
+        {
+            CHECK(order[i] == i);
+        }
+
+        // Queued tasks are executed at destruction.
+        for (int i = 100; i < 200; i++)
+        {
+            executor.Post([&order, i]() { order.push_back(i); });
+        }
+    }
+    CHECK(order.size() == 200);
+    CHECK(order.back() == 199);
+}
+
+TEST_CASE("SequencedExecutor::Run")
+{
+    SequencedExecutor executor("Test");
+    std::atomic<int> value(0);
+    std::thread::id workerId;
+
+    executor.Run([&]()
+    {
+        workerId = std::this_thread::get_id();
+        CHECK(executor.IsWorkerThread());
+        // Nested Run() from worker thread is executed immediately.
+        executor.Run([&]() { value = 1; });
+        CHECK(value == 1);
+        // WaitIdle() from worker thread don't wait for itself.
+        executor.WaitIdle();
+        value = 2;
+    });
+    CHECK(value == 2);
+    CHECK(workerId != std::this_thread::get_id());
+    CHECK(!executor.IsWorkerThread());
+
+    // Posts from few threads are serialized.
+    int counter = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&]()
+        {
+            for (int i = 0; i < 1000; i++)
+            {
+                executor.Post([&]() { counter++; });
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    executor.WaitIdle();
+    CHECK(counter == 4000);
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <memory>
+#include <string>
+#include "utils/small_vector.h"
+
+using ::netcoredbg::Utility::small_vector;
+
+TEST_CASE("SmallVector::Inline")
+{
+    small_vector<std::string, 4> v;
+    CHECK(v.empty());
+    CHECK(v.capacity() == 4);
+
+    const void *storage = v.data();
+    for (int i = 0; i < 4; i++)
+        v.emplace_back(std::to_string(i));
+
+    CHECK(v.size() == 4);
+    CHECK(v.data() == storage);
+    CHECK(v.front() == "0");
+    CHECK(v.back() == "3");
+
+    std::string joined;
+    for (const auto &s : v)
+        joined += s;
+    CHECK(joined == "0123");
+
+    v.pop_back();
+    CHECK(v.size() == 3);
+    v.clear();
+    CHECK(v.empty());
+}
+
+TEST_CASE("SmallVector::Grow")
+{
+    small_vector<std::string, 2> v;
+    const std::string longString(100, 'x');
+    for (int i = 0; i < 100; i++)
+        v.push_back(longString + std::to_string(i));
+
+    REQUIRE(v.size() == 100);
+    CHECK(v.capacity() >= 100);
+    for (int i = 0; i < 100; i++)
+        CHECK(v[i] == longString + std::to_string(i));
+
+    // Note, argument refers to element, that is moved during reallocation.
+    small_vector<std::string, 1> self;
+    self.emplace_back(longString);
+    self.push_back(self[0]);
+    CHECK(self.size() == 2);
+    CHECK(self[1] == longString);
+
+    // Memory is kept for reuse.
+    const size_t capacity = v.capacity();
+    v.clear();
+    CHECK(v.capacity() == capacity);
+}
+
+TEST_CASE("SmallVector::Destroy")
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        small_vector<std::shared_ptr<int>, 2> v;
+        for (int i = 0; i < 5; i++)
+            v.push_back(counter);
+        CHECK(counter.use_count() == 6);
+        v.pop_back();
+        CHECK(counter.use_count() == 5);
+    }
+    CHECK(counter.use_count() == 1);
+}
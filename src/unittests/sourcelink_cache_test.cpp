@@ -0,0 +1,154 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "metadata/sourcelink_cache.h"
+#include "utils/filesystem.h"
+#include "temp_dir.h"
+
+using ::netcoredbg::SourceLinkCache;
+using ::netcoredbg::Test::TempDir;
+
+namespace
+{
+    // Downloads emulation, "ok" in URL mean successful download.
+    struct Server
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool blocked = false;
+        std::atomic<int> downloads{0};
+
+        SourceLinkCache::DownloadCallback Callback()
+        {
+            return [this](const std::string &url, const std::string &filePath)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [&]() { return !blocked; });
+                }
+                downloads++;
+                if (url.find("ok") == std::string::npos)
+                    return false;
+
+                ::netcoredbg::CreateDir(filePath.substr(0, filePath.find_last_of("/\\")));
+                std::ofstream file(filePath, std::ios::binary);
+                file << url;
+                return file.good();
+            };
+        }
+
+        void Block(bool block)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            blocked = block;
+            cv.notify_all();
+        }
+    };
+
+    std::string ReadFile(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+}
+
+TEST_CASE("SourceLinkCache::Get")
+{
+    // Note, must be destroyed after cache, since cache workers write into it.
+    const TempDir tempDir("netcoredbg-sourcelink-test-");
+    Server server;
+    SourceLinkCache cache(server.Callback());
+    std::string filePath;
+
+    // No cache directory.
+    CHECK(!cache.Get("https://ok/a.cs", "key1", "a.cs", filePath));
+    CHECK(server.downloads == 0);
+
+    cache.SetDir(tempDir.Path());
+    REQUIRE(cache.Get("https://ok/a.cs", "key1", "a.cs", filePath));
+    CHECK(ReadFile(filePath) == "https://ok/a.cs");
+    CHECK(server.downloads == 1);
+
+    // Cached file is used.
+    REQUIRE(cache.Get("https://ok/a.cs", "key1", "a.cs", filePath));
+    CHECK(server.downloads == 1);
+
+    // Different content for same file name.
+    std::string otherPath;
+    REQUIRE(cache.Get("https://ok/a2.cs", "key2", "a.cs", otherPath));
+    CHECK(otherPath != filePath);
+    CHECK(server.downloads == 2);
+
+    // Failed download is not repeated.
+    CHECK(!cache.Get("https://fail/b.cs", "key3", "b.cs", filePath));
+    CHECK(!cache.Get("https://fail/b.cs", "key3", "b.cs", filePath));
+    CHECK(server.downloads == 3);
+
+    // File name from PDB can't point out of content directory.
+    REQUIRE(cache.Get("https://ok/c.cs", "key4", "../c.cs", filePath));
+    CHECK(filePath.find("..") == std::string::npos);
+}
+
+TEST_CASE("SourceLinkCache::Prefetch")
+{
+    // Note, must be destroyed after cache, since cache workers write into it.
+    const TempDir tempDir("netcoredbg-sourcelink-test-");
+    Server server;
+    SourceLinkCache cache(server.Callback());
+    cache.SetDir(tempDir.Path());
+    std::string filePath;
+
+    SECTION("prefetched file")
+    {
+        cache.Prefetch("https://ok/a.cs", "key1", "a.cs");
+        // Wait for download in progress.
+        REQUIRE(cache.Get("https://ok/a.cs", "key1", "a.cs", filePath));
+        CHECK(ReadFile(filePath) == "https://ok/a.cs");
+        CHECK(server.downloads == 1);
+
+        // Already cached file is not queued.
+        cache.Prefetch("https://ok/a.cs", "key1", "a.cs");
+        cache.Cancel();
+        CHECK(server.downloads == 1);
+    }
+
+    SECTION("duplicated prefetch")
+    {
+        server.Block(true);
+        for (int i = 0; i < 10; i++)
+            cache.Prefetch("https://ok/a.cs", "key1", "a.cs");
+        server.Block(false);
+        REQUIRE(cache.Get("https://ok/a.cs", "key1", "a.cs", filePath));
+        cache.Cancel();
+        CHECK(server.downloads == 1);
+    }
+
+    SECTION("failed prefetch")
+    {
+        cache.Prefetch("https://fail/a.cs", "key1", "a.cs");
+        CHECK(!cache.Get("https://fail/a.cs", "key1", "a.cs", filePath));
+        cache.Prefetch("https://fail/a.cs", "key1", "a.cs");
+        cache.Cancel();
+        CHECK(server.downloads == 1);
+    }
+
+    SECTION("bounded workers")
+    {
+        server.Block(true);
+        for (int i = 0; i < 20; i++)
+            cache.Prefetch("https://ok/" + std::to_string(i), "key" + std::to_string(i), "a.cs");
+        server.Block(false);
+        for (int i = 0; i < 20; i++)
+            CHECK(cache.Get("https://ok/" + std::to_string(i), "key" + std::to_string(i), "a.cs", filePath));
+        CHECK(server.downloads == 20);
+    }
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include "debugger/stack_samples.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    typedef StackSamples::frame_t frame_t;
+
+    std::string FrameName(const frame_t &frame)
+    {
+        return frame.module == 0 ? "[native]" : "m" + std::to_string(frame.module) + "!f" + std::to_string(frame.token);
+    }
+}
+
+TEST_CASE("StackSamples::Folded")
+{
+    StackSamples samples;
+    const StackSamples::stack_t first = { frame_t(1, 10), frame_t(1, 11) };
+    const StackSamples::stack_t second = { frame_t(1, 10), frame_t(2, 20), frame_t(0, 1) };
+
+    samples.AddSample({ first, second, StackSamples::stack_t() });
+    samples.AddSample({ first });
+    CHECK(samples.GetSamplesCount() == 2);
+
+    std::string output;
+    samples.ExportFolded(FrameName, output);
+    CHECK(output == "m1!f10;m1!f11 2\nm1!f10;m2!f20;[native] 1\n");
+
+    std::vector<frame_t> frames;
+    samples.GetFrames(frames);
+    CHECK(frames == std::vector<frame_t>({ frame_t(0, 1), frame_t(1, 10), frame_t(1, 11), frame_t(2, 20) }));
+
+    // Note, frames separator in names must be replaced.
+    output.clear();
+    samples.ExportFolded([](const frame_t &) { return std::string("a;b"); }, output);
+    CHECK(output == "a:b;a:b 2\na:b;a:b;a:b 1\n");
+
+    samples.Clear();
+    CHECK(samples.GetSamplesCount() == 0);
+    output.clear();
+    samples.ExportFolded(FrameName, output);
+    CHECK(output.empty());
+}
+
+TEST_CASE("StackSamples::Speedscope")
+{
+    StackSamples samples;
+    samples.AddSample({ { frame_t(1, 10), frame_t(1, 11) }, { frame_t(1, 10) } });
+    samples.AddSample({ { frame_t(1, 10) } });
+
+    unsigned calls = 0;
+    std::string output;
+    samples.ExportSpeedscope([&](const frame_t &frame)
+    {
+        calls++;
+        return frame.token == 10 ? std::string("Main") : std::string("\"q\"\\\n");
+    }, "test", output);
+
+    // Each unique frame name resolved once.
+    CHECK(calls == 2);
+    CHECK(output == "{\"$schema\":\"https://www.speedscope.app/file-format-schema.json\","
+                    "\"shared\":{\"frames\":[{\"name\":\"Main\"},{\"name\":\"\\\"q\\\"\\\\\\n\"}]},"
+                    "\"profiles\":[{\"type\":\"sampled\",\"name\":\"test\",\"unit\":\"none\",\"startValue\":0,\"endValue\":3,"
+                    "\"samples\":[[0],[0,1]],\"weights\":[2,1]}],\"name\":\"test\",\"exporter\":\"netcoredbg\"}");
+}
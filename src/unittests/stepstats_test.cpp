@@ -0,0 +1,113 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <thread>
+#include <vector>
+#include "debugger/stepstats.h"
+
+using ::netcoredbg::TimingHistogram;
+namespace StepStats = ::netcoredbg::StepStats;
+
+TEST_CASE("TimingHistogram::GetBucketIndex")
+{
+    CHECK(TimingHistogram::GetBucketIndex(0) == 0);
+    CHECK(TimingHistogram::GetBucketIndex(1) == 1);
+    CHECK(TimingHistogram::GetBucketIndex(2) == 2);
+    CHECK(TimingHistogram::GetBucketIndex(3) == 2);
+    CHECK(TimingHistogram::GetBucketIndex(1000) == 10);
+    CHECK(TimingHistogram::GetBucketIndex(uint64_t(-1)) == TimingHistogram::BucketsCount - 1);
+
+    for (size_t i = 0; i < TimingHistogram::BucketsCount - 1; i++)
+    {
+        uint64_t limit = TimingHistogram::GetBucketLimit(i);
+        CHECK(TimingHistogram::GetBucketIndex(limit - 1) == i);
+        CHECK(TimingHistogram::GetBucketIndex(limit) == i + 1);
+    }
+    CHECK(TimingHistogram::GetBucketLimit(TimingHistogram::BucketsCount - 1) == 0);
+}
+
+TEST_CASE("TimingHistogram::Add")
+{
+    TimingHistogram histogram;
+    TimingHistogram::snapshot_t snapshot;
+
+    histogram.Add(0);
+    histogram.Add(5);
+    histogram.Add(7);
+    histogram.Add(100);
+    histogram.GetSnapshot(snapshot);
+    CHECK(snapshot.count == 4);
+    CHECK(snapshot.totalUs == 112);
+    CHECK(snapshot.maxUs == 100);
+    CHECK(snapshot.buckets[0] == 1);
+    CHECK(snapshot.buckets[3] == 2);
+    CHECK(snapshot.buckets[7] == 1);
+
+    histogram.Reset();
+    histogram.GetSnapshot(snapshot);
+    CHECK(snapshot.count == 0);
+    CHECK(snapshot.totalUs == 0);
+    CHECK(snapshot.maxUs == 0);
+    CHECK(snapshot.buckets[3] == 0);
+
+    const int threadsCount = 4;
+    const int addsCount = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadsCount; t++)
+    {
+        threads.emplace_back([&histogram, t]()
+        {
+            for (int i = 0; i < addsCount; i++)
+            {
+                histogram.Add(uint64_t(t + 1));
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    histogram.GetSnapshot(snapshot);
+    CHECK(snapshot.count == threadsCount * addsCount);
+    CHECK(snapshot.totalUs == (1 + 2 + 3 + 4) * addsCount);
+    CHECK(snapshot.maxUs == threadsCount);
+    CHECK(snapshot.buckets[1] == addsCount);
+    CHECK(snapshot.buckets[2] == 2 * addsCount);
+    CHECK(snapshot.buckets[3] == addsCount);
+}
+
+TEST_CASE("StepStats")
+{
+    TimingHistogram::snapshot_t snapshot;
+    StepStats::Reset();
+
+    StepStats::Add(StepStats::Phase::SetupStep, std::chrono::milliseconds(2));
+    StepStats::GetSnapshot(StepStats::Phase::SetupStep, snapshot);
+    CHECK(snapshot.count == 1);
+    CHECK(snapshot.totalUs == 2000);
+
+    // No step start mark, nothing to add.
+    StepStats::MarkStepComplete();
+    StepStats::GetSnapshot(StepStats::Phase::StepComplete, snapshot);
+    CHECK(snapshot.count == 0);
+
+    StepStats::MarkStepStart();
+    StepStats::MarkStepComplete();
+    StepStats::MarkStepComplete();
+    StepStats::GetSnapshot(StepStats::Phase::StepComplete, snapshot);
+    CHECK(snapshot.count == 1);
+
+    {
+        StepStats::ScopedTimer timer(StepStats::Phase::StackTrace);
+    }
+    StepStats::GetSnapshot(StepStats::Phase::StackTrace, snapshot);
+    CHECK(snapshot.count == 1);
+
+    CHECK(std::string(StepStats::GetPhaseName(StepStats::Phase::StoppedEvent)) == "stoppedEvent");
+
+    StepStats::Reset();
+    StepStats::GetSnapshot(StepStats::Phase::SetupStep, snapshot);
+    CHECK(snapshot.count == 0);
+}
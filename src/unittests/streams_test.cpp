@@ -4,6 +4,11 @@
 
 #include <catch2/catch.hpp>
 #include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
 
 #include "utils/iosystem.h"
 #include "utils/streams.h"
@@ -12,6 +17,75 @@ using namespace netcoredbg;
 
 static const char test_str[] = "A quick brown fox jumps over the lazy dog.";
 
+namespace
+{
+    // Read all data from the pipe until writing side is closed.
+    std::string read_all(IOSystem::FileHandle fh)
+    {
+        std::string result;
+        char buf[64 * 1024];
+        while (true)
+        {
+            auto res = IOSystem::read(fh, buf, sizeof(buf));
+            if (res.status != IOSystem::IOResult::Success)
+                break;
+            result.append(buf, res.size);
+        }
+        return result;
+    }
+
+    // Behaviour of default std::streambuf::xsputn (previous implementation, data copied to the buffer
+    // and written by buffer size chunks), in order to compare with gather write.
+    void copying_write(OutStreamBuf &buf, const char *s, size_t count)
+    {
+        while (count > 0)
+        {
+            size_t chunk = std::min(count, size_t(buf.epptr() - buf.pptr()));
+            memcpy(buf.pptr(), s, chunk);
+            buf.pbump(int(chunk));
+            s += chunk;
+            count -= chunk;
+            if (count > 0)
+            {
+                buf.sputc(*s++);  // overflow
+                count--;
+            }
+        }
+    }
+
+    // Write `count` protocol-like messages (header and body) to the pipe and return elapsed time in milliseconds.
+    long long write_messages(size_t buf_size, size_t count, const std::string &body, bool copying)
+    {
+        auto pipe = IOSystem::unnamed_pipe();
+        REQUIRE(pipe.first);
+        REQUIRE(pipe.second);
+
+        size_t total = 0;
+        std::thread thread([&]{ total = read_all(pipe.first).size(); });
+
+        auto start = std::chrono::steady_clock::now();
+        {
+            OutStreamBuf buf(pipe.second, buf_size);
+            std::ostream stream(&buf);
+            for (size_t n = 0; n < count; n++)
+            {
+                stream << "Content-Length: " << body.size() << "\r\n\r\n";
+                if (copying)
+                    copying_write(buf, body.data(), body.size());
+                else
+                    stream.write(body.data(), body.size());
+                stream.flush();
+            }
+        }
+        thread.join();
+        auto end = std::chrono::steady_clock::now();
+        IOSystem::close(pipe.first);
+
+        CHECK(total == count * (body.size() + 20 + std::to_string(body.size()).size()));
+        return (long long)std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    }
+}
+
 
 TEST_CASE("Streams::InStreamBuf")
 {
@@ -61,6 +135,58 @@ TEST_CASE("Streams::OutStreamBuf")
 }
 
 
+TEST_CASE("Streams::OutStreamBuf::GatherWrite")
+{
+    auto pipe = IOSystem::unnamed_pipe();
+    REQUIRE(pipe.first);
+    REQUIRE(pipe.second);
+
+    std::string body;
+    for (size_t n = 0; body.size() < 256 * 1024; n++)
+        body += std::to_string(n) + ' ';
+
+    std::string data;
+    std::thread thread([&]{ data = read_all(pipe.first); });
+    {
+        OutStream ostream(OutStreamBuf(pipe.second, 256));
+
+        // header is buffered, body doesn't fit in the buffer
+        ostream << "header\n";
+        ostream.write(body.data(), body.size());
+        // small data is buffered after gather write
+        ostream.write(test_str, sizeof(test_str)-1);
+        CHECK(ostream.good());
+    }
+    thread.join();
+
+    CHECK(data == "header\n" + body + test_str);
+    IOSystem::close(pipe.first);
+}
+
+
+// Write protocol-like messages with different buffer sizes, compare with previous implementation,
+// run with `streams "[.benchmark]"`.
+TEST_CASE("Streams::OutStreamBuf::Benchmark", "[.benchmark]")
+{
+    const size_t small_count = 100000;
+    const size_t large_count = 2000;
+    const std::string small_body(200, 'x');
+    const std::string large_body(256 * 1024, 'x');
+
+    for (size_t buf_size : {size_t(4096), size_t(64 * 1024)})
+    {
+        for (int copying = 1; copying >= 0; copying--)
+        {
+            long long small_ms = write_messages(buf_size, small_count, small_body, copying);
+            long long large_ms = write_messages(buf_size, large_count, large_body, copying);
+
+            printf("%s, buffer %5u KiB: small messages %lld ms, large messages %lld ms\n", copying ? "copying" : "gather ",
+                   (unsigned)(buf_size / 1024), small_ms, large_ms);
+        }
+    }
+}
+
+
 // This test only tests, that code can be compiled.
 TEST_CASE("Streams::StreamBuf")
 {
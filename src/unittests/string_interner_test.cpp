@@ -0,0 +1,69 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "utils/memory_size.h"
+#include "utils/string_interner.h"
+
+using ::netcoredbg::StringInterner;
+namespace MemorySize = ::netcoredbg::MemorySize;
+
+TEST_CASE("StringInterner::Intern")
+{
+    StringInterner interner;
+    const std::string *first = interner.Intern("/src/Program.cs");
+    const std::string *second = interner.Intern(std::string("/src/") + "Program.cs");
+    REQUIRE(first == second);
+    CHECK(*first == "/src/Program.cs");
+    CHECK(interner.Intern("/src/Other.cs") != first);
+    CHECK(interner.Size() == 2);
+
+    // Note, pointers must stay valid after container rehash.
+    for (int i = 0; i < 1000; i++)
+    {
+        interner.Intern("/src/File" + std::to_string(i) + ".cs");
+    }
+    CHECK(interner.Intern("/src/Program.cs") == first);
+    CHECK(*first == "/src/Program.cs");
+}
+
+TEST_CASE("StringInterner::Find")
+{
+    StringInterner interner;
+    CHECK(interner.Find("/src/Program.cs") == nullptr);
+    const std::string *interned = interner.Intern("/src/Program.cs");
+    CHECK(interner.Find("/src/Program.cs") == interned);
+    CHECK(interner.Find("/src/program.cs") == nullptr);
+    CHECK(interner.Size() == 1);
+}
+
+TEST_CASE("StringInterner::GetMemoryUsage")
+{
+    StringInterner interner;
+    const size_t empty = interner.GetMemoryUsage();
+    interner.Intern(std::string(100, 'a'));
+    const size_t one = interner.GetMemoryUsage();
+    CHECK(one >= empty + 101);
+    interner.Intern(std::string(100, 'a'));
+    CHECK(interner.GetMemoryUsage() == one);
+}
+
+TEST_CASE("MemorySize")
+{
+    CHECK(MemorySize::String(std::string()) == 0);
+    CHECK(MemorySize::String(std::string(100, 'a')) >= 101);
+
+    std::vector<int> vec;
+    CHECK(MemorySize::Vector(vec) == 0);
+    vec.reserve(10);
+    CHECK(MemorySize::Vector(vec) == vec.capacity() * sizeof(int));
+
+    std::unordered_map<int, int> map;
+    const size_t emptyMap = MemorySize::HashNodes(map);
+    map.emplace(1, 1);
+    CHECK(MemorySize::HashNodes(map) > emptyMap + sizeof(std::pair<const int, int>));
+}
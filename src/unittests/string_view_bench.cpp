@@ -0,0 +1,122 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+#include "utils/string_view.h"
+#include "benchmark.h"
+
+using namespace netcoredbg;
+using Utility::string_view;
+
+namespace
+{
+    // Typical protocol data: fully qualified names and source paths.
+    std::vector<std::string> MakeNames()
+    {
+        std::vector<std::string> result;
+        for (int i = 0; i < 64; i++)
+        {
+            result.push_back("System.Collections.Generic.Dictionary`2[[System.String],[MyApp.Item" + std::to_string(i) + "]]");
+            result.push_back("/home/user/src/project/Module" + std::to_string(i) + "/Program.cs");
+        }
+        return result;
+    }
+}
+
+TEST_CASE("string_view::Benchmark", "[.benchmark]")
+{
+    const std::vector<std::string> names = MakeNames();
+    size_t bytes = 0;
+    for (const auto &name : names)
+        bytes += name.size();
+
+    Benchmark::Measure("string_view::find(char)", bytes, [&]() {
+        size_t result = 0;
+        for (const auto &name : names)
+            result += string_view(name).find('/');
+        return result;
+    });
+
+    Benchmark::Measure("string_view::find(string_view)", bytes, [&]() {
+        size_t result = 0;
+        for (const auto &name : names)
+            result += string_view(name).find(string_view("Program.cs"));
+        return result;
+    });
+
+    Benchmark::Measure("string_view::rfind(char)", bytes, [&]() {
+        size_t result = 0;
+        for (const auto &name : names)
+            result += string_view(name).rfind('.');
+        return result;
+    });
+
+    Benchmark::Measure("string_view::find_first_of", bytes, [&]() {
+        size_t result = 0;
+        for (const auto &name : names)
+            result += string_view(name).find_first_of(string_view("[]`"));
+        return result;
+    });
+
+    Benchmark::Measure("string_view::find_last_of", bytes, [&]() {
+        size_t result = 0;
+        for (const auto &name : names)
+            result += string_view(name).find_last_of(string_view("/\\"));
+        return result;
+    });
+
+    Benchmark::Measure("string_view::find_first_not_of", bytes, [&]() {
+        size_t result = 0;
+        for (const auto &name : names)
+            result += string_view(name).find_first_not_of(string_view("/abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"));
+        return result;
+    });
+
+    Benchmark::Measure("string_view::compare_nocase", bytes, [&]() {
+        size_t result = 0;
+        for (size_t i = 1; i < names.size(); i++)
+            result += string_view(names[i]).compare_nocase(string_view(names[i - 1])) < 0;
+        return result + string_view(names[0]).compare_nocase(string_view(names[0])) + 1;
+    });
+
+    Benchmark::Measure("string_view::compare", bytes, [&]() {
+        size_t result = 0;
+        for (size_t i = 1; i < names.size(); i++)
+            result += string_view(names[i]).compare(string_view(names[i - 1])) < 0;
+        return result + 1;
+    });
+
+    Benchmark::Measure("string_view::substr", bytes, [&]() {
+        size_t result = 0;
+        for (const auto &name : names)
+        {
+            string_view view(name);
+            while (!view.empty())
+            {
+                size_t pos = view.find('.');
+                if (pos == string_view::npos)
+                    break;
+                result += view.substr(0, pos).size();
+                view = view.substr(pos + 1);
+            }
+        }
+        return result;
+    });
+
+    Benchmark::Measure("std::string::find(string), reference", bytes, [&]() {
+        size_t result = 0;
+        for (const auto &name : names)
+            result += name.find("Program.cs");
+        return result;
+    });
+
+    Benchmark::Measure("std::string::find_first_of, reference", bytes, [&]() {
+        size_t result = 0;
+        for (const auto &name : names)
+            result += name.find_first_of("[]`");
+        return result;
+    });
+}
@@ -217,6 +217,67 @@ TEST_CASE("StringView::FindLastNotOf")
 	CHECK(s.find_last_not_of("67890123456789",9, 4) == 5);
 }
 
+// Check search functions on strings longer than vector block, with matches in blocks and in tails,
+// results must be the same as std::string results.
+TEST_CASE("StringView::FindLong")
+{
+	std::string str;
+	for (int i = 0; i < 100; i++)
+		str += char('a' + i % 26);
+	str[17] = '/';
+	str[40] = '\\';
+	str[77] = '/';
+	str[99] = '\xff';
+	string_view s(str);
+
+	const char *sets[] = {"/", "/\\", "\\/x", "\xff/\\.", "xyz/\\Q", "", "abcdefghijklmnopqrstuvwxyz"};
+	for (const char *set : sets)
+	{
+		for (size_t pos = 0; pos <= str.size(); pos++)
+		{
+			CHECK(s.find_first_of(set, pos) == str.find_first_of(set, pos));
+			CHECK(s.find_first_not_of(set, pos) == str.find_first_not_of(set, pos));
+			CHECK(s.find_last_of(set, pos) == str.find_last_of(set, pos));
+			CHECK(s.find_last_not_of(set, pos) == str.find_last_not_of(set, pos));
+		}
+		CHECK(s.find_last_of(set) == str.find_last_of(set));
+		CHECK(s.find_last_not_of(set) == str.find_last_not_of(set));
+	}
+
+	for (size_t pos = 0; pos + 1 < str.size(); pos++)
+	{
+		CHECK(s.find(str[pos]) == str.find(str[pos]));
+		CHECK(s.rfind(str[pos]) == str.rfind(str[pos]));
+		CHECK(s.find(str.substr(pos, 5)) == str.find(str.substr(pos, 5)));
+		CHECK(s.find(str.substr(pos, 5), pos + 1) == str.find(str.substr(pos, 5), pos + 1));
+	}
+	CHECK(s.find(str) == 0);
+	CHECK(s.find(str + "a") == string_view::npos);
+}
+
+#ifndef TEST_NATIVE_STRING_VIEW
+TEST_CASE("StringView::CompareNoCase")
+{
+	string_view s("/Home/User/Src/Project/Program.cs");
+
+	CHECK(s.compare_nocase("/home/user/src/project/program.cs") == 0);
+	CHECK(s.compare_nocase("/HOME/USER/SRC/PROJECT/PROGRAM.CS") == 0);
+	CHECK(s.compare_nocase("/home/user/src/project/program.cs1") < 0);
+	CHECK(s.compare_nocase("/home/user/src/project/program.c") > 0);
+	CHECK(s.compare_nocase("/home/user/src/project/program.ct") < 0);
+	CHECK(s.compare_nocase("/home/user/srb/project/program.cs") > 0);
+	// Only ASCII letters are folded, '@' and '`', '[' and '{' are neighbours of letters ranges.
+	CHECK(string_view("@[").compare_nocase("`{") != 0);
+	CHECK(string_view("\xc0").compare_nocase("\xe0") < 0);
+	CHECK(string_view("\xe0 long enough for vector compare").compare_nocase("a long enough for vector compare") > 0);
+	CHECK(string_view("").compare_nocase("") == 0);
+
+	::netcoredbg::Utility::u16string_view w(u"Program.CS");
+	CHECK(w.compare_nocase(u"program.cs") == 0);
+	CHECK(w.compare_nocase(u"program.ct") < 0);
+}
+#endif
+
 TEST_CASE("StringView::starts_with")
 {
     string_view s("0123456789");
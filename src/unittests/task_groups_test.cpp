@@ -0,0 +1,70 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+#include "debugger/task_groups.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    typedef TaskGroups::Status Status;
+    typedef TaskGroups::key_t group_key_t;
+    typedef TaskGroups::group_t group_t;
+}
+
+TEST_CASE("TaskGroups::Status")
+{
+    CHECK(TaskGroups::GetStatus(0) == Status::Created);
+    CHECK(TaskGroups::GetStatus(0x2000000) == Status::WaitingForActivation);
+    CHECK(TaskGroups::GetStatus(0x10000) == Status::WaitingToRun);
+    CHECK(TaskGroups::GetStatus(0x10000 | 0x20000) == Status::Running);
+    CHECK(TaskGroups::GetStatus(0x10000 | 0x20000 | 0x800000) == Status::WaitingForChildrenToComplete);
+    CHECK(TaskGroups::GetStatus(0x2000000 | 0x1000000) == Status::RanToCompletion);
+    // Note, faulted and canceled flags have priority, same as in Task.Status.
+    CHECK(TaskGroups::GetStatus(0x1000000 | 0x400000) == Status::Canceled);
+    CHECK(TaskGroups::GetStatus(0x1000000 | 0x400000 | 0x200000) == Status::Faulted);
+
+    CHECK(std::string(TaskGroups::GetStatusName(Status::WaitingForActivation)) == "WaitingForActivation");
+    CHECK(TaskGroups::IsCompleted(Status::Faulted));
+    CHECK_FALSE(TaskGroups::IsCompleted(Status::Running));
+}
+
+TEST_CASE("TaskGroups::Grouping")
+{
+    TaskGroups groups;
+    const group_key_t awaitFirst(Status::WaitingForActivation, 0x1000, 0, 0);
+    const group_key_t awaitSecond(Status::WaitingForActivation, 0x1000, 0, 1);
+    const group_key_t delay(Status::WaitingForActivation, 0x2000, 0, TaskGroups::NoState);
+    const group_key_t completed(Status::RanToCompletion, 0x1000, 0, -2);
+
+    for (uint64_t i = 0; i < 20; i++)
+    {
+        groups.Add(awaitFirst, 0x10000 + i * 0x100);
+    }
+    groups.Add(awaitSecond, 0x50000);
+    groups.Add(awaitSecond, 0x50100);
+    groups.Add(delay, 0x60000);
+    groups.Add(completed, 0x70000);
+    groups.Add(delay, 0x60100);
+    groups.Add(delay, 0x60200);
+
+    CHECK(groups.GetTasksCount() == 26);
+
+    std::vector<group_t> result;
+    groups.GetGroups(result);
+    REQUIRE(result.size() == 4);
+    CHECK(result[0].key == awaitFirst);
+    CHECK(result[0].count == 20);
+    REQUIRE(result[0].tasks.size() == TaskGroups::MaxGroupTasks);
+    CHECK(result[0].tasks[0] == 0x10000);
+    CHECK(result[1].key == delay);
+    CHECK(result[1].count == 3);
+    CHECK(result[1].tasks == std::vector<uint64_t>({0x60000, 0x60100, 0x60200}));
+    CHECK(result[2].key == awaitSecond);
+    CHECK(result[3].key == completed);
+    CHECK(result[3].tasks == std::vector<uint64_t>({0x70000}));
+}
@@ -0,0 +1,96 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+// Unique temporary directory for test case, removed (with all content) at guard destruction.
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <unistd.h>
+#endif
+#include "utils/filesystem.h"
+
+namespace netcoredbg
+{
+namespace Test
+{
+    class TempDir
+    {
+    public:
+
+        explicit TempDir(const char *prefix)
+        {
+            const string_view tempDir = GetTempDir();
+            m_path.assign(tempDir.begin(), tempDir.end());
+            if (!m_path.empty() && m_path.back() != '/' && m_path.back() != '\\')
+                m_path += FileSystem::PathSeparator;
+            m_path += prefix + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+            CreateDir(m_path);
+        }
+
+        ~TempDir()
+        {
+            Remove(m_path);
+        }
+
+        const std::string &Path() const { return m_path; }
+
+    private:
+
+        TempDir(const TempDir&) = delete;
+        TempDir& operator=(const TempDir&) = delete;
+
+        std::string m_path;
+
+        static void Remove(const std::string &path)
+        {
+#ifdef WIN32
+            WIN32_FIND_DATAA data;
+            HANDLE find = FindFirstFileA((path + "\\*").c_str(), &data);
+            if (find != INVALID_HANDLE_VALUE)
+            {
+                do
+                {
+                    const std::string name(data.cFileName);
+                    if (name == "." || name == "..")
+                        continue;
+
+                    if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+                        Remove(path + "\\" + name);
+                    else
+                        std::remove((path + "\\" + name).c_str());
+                }
+                while (FindNextFileA(find, &data));
+                FindClose(find);
+            }
+            RemoveDirectoryA(path.c_str());
+#else
+            DIR *dir = opendir(path.c_str());
+            if (dir != nullptr)
+            {
+                while (struct dirent *entry = readdir(dir))
+                {
+                    const std::string name(entry->d_name);
+                    if (name == "." || name == "..")
+                        continue;
+
+                    // Note, unlink() fails for directories, so, don't care about d_type support by file system.
+                    const std::string entryPath = path + "/" + name;
+                    if (unlink(entryPath.c_str()) != 0)
+                        Remove(entryPath);
+                }
+                closedir(dir);
+            }
+            rmdir(path.c_str());
+#endif
+        }
+    };
+} // namespace Test
+} // namespace netcoredbg
@@ -0,0 +1,51 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+#include "protocols/tokenizer.h"
+#include "benchmark.h"
+
+using namespace netcoredbg;
+
+TEST_CASE("Tokenizer::Benchmark", "[.benchmark]")
+{
+    // Typical CLI and MI command lines.
+    const std::vector<std::string> lines = {
+        "break Program.cs:42",
+        "print localVariable.Field[10].Property",
+        "-break-insert -f -c \"i == 10 && name == \\\"test\\\"\" /home/user/src/project/Program.cs:123",
+        "-var-create - * \"collection.Where(x => x.Id > 5)\"",
+        "-exec-arguments --option value \"quoted argument with spaces\" last",
+        "   info    threads   ",
+    };
+    size_t bytes = 0;
+    for (const auto &line : lines)
+        bytes += line.size();
+
+    Benchmark::Measure("Tokenizer::Next, command lines", bytes, [&]() {
+        size_t result = 0;
+        std::string token;
+        for (const auto &line : lines)
+        {
+            Tokenizer tokenizer(line);
+            while (tokenizer.Next(token))
+                result += token.size();
+        }
+        return result;
+    });
+
+    Benchmark::Measure("Tokenizer::Remain, command lines", bytes, [&]() {
+        size_t result = 0;
+        std::string token;
+        for (const auto &line : lines)
+        {
+            Tokenizer tokenizer(line);
+            tokenizer.Next(token);
+            result += tokenizer.Remain().size();
+        }
+        return result;
+    });
+}
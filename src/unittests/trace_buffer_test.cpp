@@ -0,0 +1,74 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include "debugger/trace_buffer.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    TraceBuffer::record_t MakeRecord(uint64_t timestamp)
+    {
+        TraceBuffer::record_t record = TraceBuffer::record_t();
+        record.timestamp = timestamp;
+        record.breakpointId = 1;
+        return record;
+    }
+}
+
+TEST_CASE("TraceBuffer::Records")
+{
+    TraceBuffer buffer(4);
+    std::vector<TraceBuffer::record_t> records;
+
+    buffer.GetRecords(records, false);
+    CHECK(records.empty());
+
+    buffer.Push(MakeRecord(1));
+    buffer.Push(MakeRecord(2));
+    buffer.GetRecords(records, false);
+    REQUIRE(records.size() == 2);
+    CHECK(records[0].timestamp == 1);
+    CHECK(records[1].timestamp == 2);
+
+    // Snapshot don't remove records.
+    records.clear();
+    buffer.GetRecords(records, false);
+    CHECK(records.size() == 2);
+
+    // Drain remove returned records, new records are added after.
+    records.clear();
+    buffer.GetRecords(records, true);
+    CHECK(records.size() == 2);
+    buffer.Push(MakeRecord(3));
+    records.clear();
+    buffer.GetRecords(records, true);
+    REQUIRE(records.size() == 1);
+    CHECK(records[0].timestamp == 3);
+    CHECK(buffer.GetOverwrittenCount() == 0);
+}
+
+TEST_CASE("TraceBuffer::Overwrite")
+{
+    TraceBuffer buffer(3);
+    for (uint64_t i = 1; i <= 5; i++)
+    {
+        buffer.Push(MakeRecord(i));
+    }
+
+    std::vector<TraceBuffer::record_t> records;
+    buffer.GetRecords(records, false);
+    REQUIRE(records.size() == 3);
+    CHECK(records[0].timestamp == 3);
+    CHECK(records[1].timestamp == 4);
+    CHECK(records[2].timestamp == 5);
+    CHECK(buffer.GetOverwrittenCount() == 2);
+
+    buffer.Clear();
+    records.clear();
+    buffer.GetRecords(records, false);
+    CHECK(records.empty());
+    CHECK(buffer.GetOverwrittenCount() == 0);
+}
@@ -0,0 +1,90 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utils/tracerecorder.h"
+
+namespace TraceRecorder = ::netcoredbg::TraceRecorder;
+
+namespace
+{
+
+    size_t CountOccurrences(const std::string &str, const std::string &pattern)
+    {
+        size_t count = 0;
+        for (size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + pattern.size()))
+        {
+            count++;
+        }
+        return count;
+    }
+
+} // unnamed namespace
+
+TEST_CASE("TraceRecorder::Disabled")
+{
+    TraceRecorder::Enable(false);
+    TraceRecorder::Clear();
+
+    {
+        TraceRecorder::ScopedEvent event("test", "disabledEvent");
+    }
+    CHECK(TraceRecorder::DumpChromeJSON().find("disabledEvent") == std::string::npos);
+}
+
+TEST_CASE("TraceRecorder::Events")
+{
+    TraceRecorder::Enable(true);
+    TraceRecorder::Clear();
+
+    TraceRecorder::SetThreadName("testMain");
+    {
+        TraceRecorder::ScopedEvent event("test", "mainEvent", "arg \"quoted\"");
+    }
+    std::thread worker([]()
+    {
+        TraceRecorder::SetThreadName("testWorker");
+        for (int i = 0; i < 3; i++)
+        {
+            TraceRecorder::ScopedEvent event("test", "workerEvent");
+            event.SetArg(std::string(100, 'x'));
+        }
+    });
+    worker.join();
+
+    std::string json = TraceRecorder::DumpChromeJSON();
+    CHECK(json.compare(0, 1, "{") == 0);
+    CHECK(json.compare(json.size() - 2, 2, "]}") == 0);
+    CHECK(CountOccurrences(json, "\"name\":\"mainEvent\"") == 1);
+    CHECK(CountOccurrences(json, "\"name\":\"workerEvent\"") == 3);
+    CHECK(json.find("\"arg\":\"arg \\\"quoted\\\"\"") != std::string::npos);
+    CHECK(json.find("\"arg\":\"" + std::string(TraceRecorder::MaxArgLength, 'x') + "\"") != std::string::npos);
+    CHECK(json.find("\"name\":\"testMain\"") != std::string::npos);
+    CHECK(json.find("\"name\":\"testWorker\"") != std::string::npos);
+
+    TraceRecorder::Clear();
+    json = TraceRecorder::DumpChromeJSON();
+    CHECK(json.find("mainEvent") == std::string::npos);
+    CHECK(json.find("workerEvent") == std::string::npos);
+
+    TraceRecorder::Enable(false);
+}
+
+TEST_CASE("TraceRecorder::Overwrite")
+{
+    TraceRecorder::Enable(true);
+    TraceRecorder::Clear();
+
+    for (size_t i = 0; i < TraceRecorder::ThreadBufferEvents + 10; i++)
+    {
+        TraceRecorder::ScopedEvent event("test", "ringEvent");
+    }
+    CHECK(CountOccurrences(TraceRecorder::DumpChromeJSON(), "\"name\":\"ringEvent\"") == TraceRecorder::ThreadBufferEvents);
+
+    TraceRecorder::Clear();
+    TraceRecorder::Enable(false);
+}
@@ -0,0 +1,163 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+
+#ifndef _WIN32
+
+#include <string>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "utils/iosystem.h"
+#include "benchmark.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    // Emulation of protocol traffic: client send small request and wait for small response (for example,
+    // "stackTrace" request during stepping), so, round-trip latency is measured, not throughput.
+    const size_t RequestSize = 200;
+    const size_t ResponseSize = 600;
+
+    bool ReadAll(int fd, char *buf, size_t size)
+    {
+        while (size > 0)
+        {
+            ssize_t result = ::read(fd, buf, size);
+            if (result <= 0)
+                return false;
+            buf += result;
+            size -= size_t(result);
+        }
+        return true;
+    }
+
+    bool WriteAll(int fd, const char *buf, size_t size)
+    {
+        while (size > 0)
+        {
+            ssize_t result = ::write(fd, buf, size);
+            if (result <= 0)
+                return false;
+            buf += result;
+            size -= size_t(result);
+        }
+        return true;
+    }
+
+    // Debugger side: reply to each request, response is written by two writes (header and body), same as protocols do.
+    void Serve(int inFd, int outFd)
+    {
+        std::string request(RequestSize, ' ');
+        std::string response(ResponseSize, 'r');
+        const size_t headerSize = 32;
+        while (ReadAll(inFd, &request[0], request.size()))
+        {
+            if (!WriteAll(outFd, response.data(), headerSize) ||
+                !WriteAll(outFd, response.data() + headerSize, response.size() - headerSize))
+                break;
+        }
+    }
+
+    void MeasureRoundTrip(const char *name, int inFd, int outFd)
+    {
+        std::string request(RequestSize, 'q');
+        std::string response(ResponseSize, ' ');
+        Benchmark::Measure(name, RequestSize + ResponseSize, [&]() -> size_t
+        {
+            if (!WriteAll(outFd, request.data(), request.size()) ||
+                !ReadAll(inFd, &response[0], response.size()))
+                FAIL("transport failed");
+            return size_t(response[0]);
+        });
+    }
+
+    int ConnectTcp(unsigned port)
+    {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(uint16_t(port));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (fd < 0 || ::connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0)
+            FAIL("can't connect to tcp port");
+        return fd;
+    }
+
+    int ConnectUnix(const std::string &path)
+    {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        path.copy(addr.sun_path, sizeof(addr.sun_path) - 1);
+        if (fd < 0 || ::connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0)
+            FAIL("can't connect to unix socket");
+        return fd;
+    }
+
+    template <typename Connect>
+    void MeasureSocket(const char *name, IOSystem::FileHandle server, bool noDelay, Connect &&connect)
+    {
+        REQUIRE(server);
+        int clientFd = -1;
+        std::thread client([&]() { clientFd = connect(); });
+        IOSystem::FileHandle connection = IOSystem::accept_socket(server);
+        client.join();
+        REQUIRE(connection);
+        IOSystem::close(server);
+
+        if (noDelay)
+        {
+            IOSystem::tune_socket(connection, 0);
+            int flag = 1;
+            ::setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+        }
+
+        const int serverFd = int(connection.handle.fd);
+        std::thread debugger([serverFd]() { Serve(serverFd, serverFd); });
+        MeasureRoundTrip(name, clientFd, clientFd);
+        ::shutdown(clientFd, SHUT_RDWR);
+        debugger.join();
+        ::close(clientFd);
+        IOSystem::close(connection);
+    }
+
+    unsigned BenchPort()
+    {
+        return 40000 + unsigned(getpid()) % 20000;
+    }
+}
+
+// Note, reported "ns/op" is request/response round-trip latency.
+TEST_CASE("Transport round-trip", "[.benchmark]")
+{
+    {
+        int requests[2], responses[2];
+        REQUIRE(::pipe(requests) == 0);
+        REQUIRE(::pipe(responses) == 0);
+        std::thread debugger([&]() { Serve(requests[0], responses[1]); });
+        MeasureRoundTrip("stdio (pipes)", responses[0], requests[1]);
+        ::close(requests[1]);
+        debugger.join();
+        ::close(requests[0]);
+        ::close(responses[0]);
+        ::close(responses[1]);
+    }
+
+    const unsigned port = BenchPort();
+    MeasureSocket("tcp loopback", IOSystem::server_socket(port), false, [port]() { return ConnectTcp(port); });
+    MeasureSocket("tcp loopback, TCP_NODELAY", IOSystem::server_socket(port + 1), true, [port]() { return ConnectTcp(port + 1); });
+
+    const std::string path = "/tmp/netcoredbg-bench-" + std::to_string(getpid()) + ".sock";
+    MeasureSocket("unix domain socket", IOSystem::server_unix_socket(path), false, [&path]() { return ConnectUnix(path); });
+    ::unlink(path.c_str());
+}
+
+#endif // _WIN32
@@ -0,0 +1,57 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include "debugger/triage_snapshot.h"
+
+using namespace netcoredbg;
+
+TEST_CASE("TriageSnapshot::Json")
+{
+    TriageSnapshot snapshot;
+    snapshot.processId = 42;
+    snapshot.frozenMs = 7;
+
+    SECTION("empty")
+    {
+        std::string output;
+        ExportTriageSnapshotJson(snapshot, output);
+        CHECK(output == "{\"pid\":42,\"frozenMs\":7,\"threads\":[]}");
+    }
+
+    SECTION("threads")
+    {
+        TriageSnapshot::Thread first;
+        first.id = 100;
+        first.exceptionType = "System.InvalidOperationException";
+        first.exceptionMessage = "bad \"state\"\n";
+        TriageSnapshot::Frame frame;
+        frame.methodName = "Program.Main()";
+        frame.module = "app.dll";
+        frame.source = "/src/Program.cs";
+        frame.line = 12;
+        frame.locals.push_back({"i", "int", "5"});
+        frame.locals.push_back({"s", "string", ""});
+        first.frames.push_back(frame);
+        first.truncated = true;
+        snapshot.threads.push_back(first);
+
+        TriageSnapshot::Thread second;
+        second.id = 101;
+        TriageSnapshot::Frame noSymbols;
+        noSymbols.methodName = "System.Threading.Thread.Sleep()";
+        second.frames.push_back(noSymbols);
+        second.frames.push_back(noSymbols);
+        snapshot.threads.push_back(second);
+
+        std::string output;
+        ExportTriageSnapshotJson(snapshot, output);
+        CHECK(output == "{\"pid\":42,\"frozenMs\":7,\"threads\":["
+                        "{\"id\":100,\"exception\":{\"type\":\"System.InvalidOperationException\",\"message\":\"bad \\\"state\\\"\\n\"},"
+                        "\"frames\":[{\"method\":\"Program.Main()\",\"module\":\"app.dll\",\"source\":\"/src/Program.cs\",\"line\":12,"
+                        "\"locals\":[{\"name\":\"i\",\"type\":\"int\",\"value\":\"5\"},{\"name\":\"s\",\"type\":\"string\"}]}],\"truncated\":true},"
+                        "{\"id\":101,\"frames\":[{\"method\":\"System.Threading.Thread.Sleep()\"},{\"method\":\"System.Threading.Thread.Sleep()\"}]}]}");
+    }
+}
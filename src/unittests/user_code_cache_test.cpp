@@ -0,0 +1,62 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include "metadata/user_code_cache.h"
+
+using ::netcoredbg::UserCodeCache;
+
+typedef UserCodeCache::Property Property;
+
+TEST_CASE("UserCodeCache properties")
+{
+    UserCodeCache cache;
+    bool value = false;
+
+    CHECK(!cache.Get(0x1000, 0x06000001, 1, Property::JMCStatus, value));
+
+    cache.Set(0x1000, 0x06000001, 1, Property::JMCStatus, true);
+    cache.Set(0x1000, 0x06000001, 1, Property::StepThrough, false);
+    REQUIRE(cache.Get(0x1000, 0x06000001, 1, Property::JMCStatus, value));
+    CHECK(value);
+    REQUIRE(cache.Get(0x1000, 0x06000001, 1, Property::StepThrough, value));
+    CHECK(!value);
+    CHECK(!cache.Get(0x1000, 0x06000001, 1, Property::HaveUserCode, value));
+    CHECK(!cache.Get(0x1000, 0x06000001, 1, Property::Filtered, value));
+
+    // Other version and other module are different methods.
+    CHECK(!cache.Get(0x1000, 0x06000001, 2, Property::JMCStatus, value));
+    CHECK(!cache.Get(0x2000, 0x06000001, 1, Property::JMCStatus, value));
+
+    // Overwrite.
+    cache.Set(0x1000, 0x06000001, 1, Property::JMCStatus, false);
+    REQUIRE(cache.Get(0x1000, 0x06000001, 1, Property::JMCStatus, value));
+    CHECK(!value);
+    CHECK(cache.GetMethodsCount() == 1);
+}
+
+TEST_CASE("UserCodeCache invalidation")
+{
+    UserCodeCache cache;
+    bool value = false;
+
+    cache.Set(0x1000, 0x06000001, 1, Property::JMCStatus, true);
+    cache.Set(0x1000, 0x06000001, 1, Property::Filtered, true);
+    cache.Set(0x1000, 0x06000002, 2, Property::HaveUserCode, true);
+    cache.Set(0x2000, 0x06000001, 1, Property::JMCStatus, false);
+    CHECK(cache.GetMethodsCount() == 3);
+
+    cache.InvalidateJMCStatus();
+    CHECK(!cache.Get(0x1000, 0x06000001, 1, Property::JMCStatus, value));
+    CHECK(!cache.Get(0x2000, 0x06000001, 1, Property::JMCStatus, value));
+    REQUIRE(cache.Get(0x1000, 0x06000001, 1, Property::Filtered, value));
+    CHECK(value);
+
+    cache.InvalidateModule(0x1000);
+    CHECK(!cache.Get(0x1000, 0x06000002, 2, Property::HaveUserCode, value));
+    CHECK(cache.GetMethodsCount() == 1);
+
+    cache.Clear();
+    CHECK(cache.GetMethodsCount() == 0);
+}
@@ -0,0 +1,46 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include "utils/utf.h"
+#include "benchmark.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    std::string MakeText(const char *pattern, size_t size)
+    {
+        std::string result;
+        while (result.size() < size)
+            result.append(pattern);
+        return result;
+    }
+}
+
+TEST_CASE("UTF::Benchmark", "[.benchmark]")
+{
+    // Variable names and values: ASCII only and mixed with two-byte UTF-8 sequences (cyrillic).
+    const std::string ascii = MakeText("localVariable.Field = \"value\"; ", 256);
+    const std::string mixed = MakeText("\xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82 value; ", 256);
+    const WSTRING asciiUtf16 = to_utf16(ascii);
+    const WSTRING mixedUtf16 = to_utf16(mixed);
+
+    CHECK(to_utf8(asciiUtf16.c_str()) == ascii);
+    CHECK(to_utf8(mixedUtf16.c_str()) == mixed);
+
+    Benchmark::Measure("to_utf16, ascii", ascii.size(), [&]() {
+        return to_utf16(ascii).size();
+    });
+    Benchmark::Measure("to_utf16, mixed", mixed.size(), [&]() {
+        return to_utf16(mixed).size();
+    });
+    Benchmark::Measure("to_utf8, ascii", ascii.size(), [&]() {
+        return to_utf8(asciiUtf16.c_str()).size();
+    });
+    Benchmark::Measure("to_utf8, mixed", mixed.size(), [&]() {
+        return to_utf8(mixedUtf16.c_str()).size();
+    });
+}
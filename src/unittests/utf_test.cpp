@@ -0,0 +1,158 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <codecvt>
+#include <locale>
+#include <random>
+#include <string>
+#include "utils/utf.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    // Reference conversion for valid strings.
+    std::wstring_convert<std::codecvt_utf8_utf16<WCHAR>, WCHAR> reference;
+
+    WSTRING Utf16(std::initializer_list<unsigned> units)
+    {
+        WSTRING result;
+        for (unsigned unit : units)
+            result.push_back(static_cast<WCHAR>(unit));
+        return result;
+    }
+
+    // Random valid string, which mix ASCII runs (longer than vector block) with non-ASCII characters.
+    std::string RandomUtf8(std::mt19937 &gen, size_t size)
+    {
+        static const char *chars[] = { "a", "Z", "0", " ", "\x7f", "\xd0\xbf", "\xc2\x80", "\xe4\xb8\xad",
+                                       "\xef\xbf\xbf", "\xf0\x9f\x98\x80", "\xf4\x8f\xbf\xbf" };
+        std::uniform_int_distribution<size_t> charDist(0, sizeof(chars) / sizeof(chars[0]) - 1);
+        std::uniform_int_distribution<size_t> runDist(0, 40);
+        std::string result;
+        while (result.size() < size)
+        {
+            result.append(runDist(gen), 'x');
+            result.append(chars[charDist(gen)]);
+        }
+        return result;
+    }
+}
+
+TEST_CASE("UTF::Ascii")
+{
+    // Note, all lengths around vector block size.
+    std::string ascii;
+    for (size_t len = 0; len < 70; len++)
+    {
+        WSTRING utf16 = to_utf16(ascii);
+        REQUIRE(utf16.size() == ascii.size());
+        CHECK(to_utf8(utf16.c_str()) == ascii);
+        ascii.push_back(static_cast<char>(0x20 + len));
+    }
+
+    CHECK(to_utf8(static_cast<WCHAR>('a')) == "a");
+    CHECK(to_utf16(std::string()).empty());
+}
+
+TEST_CASE("UTF::Valid")
+{
+    const std::string text = "\xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82, \xe4\xb8\xad\xe6\x96\x87 \xf0\x9f\x98\x80!";
+    CHECK(to_utf16(text) == reference.from_bytes(text));
+    CHECK(to_utf8(reference.from_bytes(text).c_str()) == text);
+
+    // Non-ASCII character and surrogate pair on vector block border.
+    for (size_t pos = 0; pos < 34; pos++)
+    {
+        for (const char *c : { "\xd0\xbf", "\xe4\xb8\xad", "\xf0\x9f\x98\x80" })
+        {
+            std::string str(40, 'x');
+            str.insert(pos, c);
+            WSTRING utf16 = to_utf16(str);
+            REQUIRE(utf16 == reference.from_bytes(str));
+            REQUIRE(to_utf8(utf16.c_str()) == str);
+        }
+    }
+
+    CHECK(to_utf8(static_cast<WCHAR>(0x43f)) == "\xd0\xbf");
+
+    std::mt19937 gen(42);
+    for (int i = 0; i < 200; i++)
+    {
+        const std::string str = RandomUtf8(gen, 300);
+        WSTRING utf16 = to_utf16(str);
+        REQUIRE(utf16 == reference.from_bytes(str));
+        REQUIRE(to_utf8(utf16.c_str()) == str);
+    }
+}
+
+TEST_CASE("UTF::Invalid")
+{
+    const std::string replacement = "\xef\xbf\xbd";
+
+    // Unpaired surrogates.
+    CHECK(to_utf8(Utf16({'a', 0xD83D, 'b', 0}).c_str()) == "a" + replacement + "b");
+    CHECK(to_utf8(Utf16({'a', 0xDE00, 'b', 0}).c_str()) == "a" + replacement + "b");
+    CHECK(to_utf8(Utf16({'a', 0xD83D, 0}).c_str()) == "a" + replacement);
+    CHECK(to_utf8(Utf16({0xDE00, 0xD83D, 0}).c_str()) == replacement + replacement);
+    CHECK(to_utf8(static_cast<WCHAR>(0xD83D)) == replacement);
+
+    const WCHAR r = 0xFFFD;
+    // Invalid lead byte, truncated sequence, broken sequence, overlong encoding, encoded surrogate, out of range.
+    CHECK(to_utf16("a\xff" "b") == Utf16({'a', r, 'b'}));
+    CHECK(to_utf16("a\xe4\xb8") == Utf16({'a', r, r}));
+    CHECK(to_utf16("\xe4" "ab") == Utf16({r, 'a', 'b'}));
+    CHECK(to_utf16("\xc0\x80" "a") == Utf16({r, 'a'}));
+    CHECK(to_utf16("\xed\xa0\x80" "a") == Utf16({r, 'a'}));
+    CHECK(to_utf16("\xf4\x90\x80\x80" "a") == Utf16({r, 'a'}));
+}
+
+TEST_CASE("UTF::Buffer")
+{
+    const std::string text = "value = \"\xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82\" \xf0\x9f\x98\x80";
+    const WSTRING utf16 = to_utf16(text);
+
+    std::vector<char> buf(Utf8MaxSize(utf16.size()));
+    size_t size = to_utf8(utf16.data(), utf16.size(), buf.data());
+    CHECK(std::string(buf.data(), size) == text);
+
+    std::vector<WCHAR> wbuf(text.size());
+    size = to_utf16(text.data(), text.size(), wbuf.data());
+    CHECK(WSTRING(wbuf.data(), size) == utf16);
+
+    // Note, length is provided explicitly, so, conversion don't stop at zero.
+    std::string output = "prefix.";
+    append_utf8(output, utf16.c_str());
+    append_utf8(output, Utf16({'a', 0, 'b'}).c_str(), 3);
+    CHECK(output == "prefix." + text + std::string("a\0b", 3));
+}
+
+TEST_CASE("UTF::View")
+{
+    const std::string text = "a.b\xd0\xbf\xf0\x9f\x98\x80.c";
+    const WSTRING utf16 = to_utf16(text);
+
+    // Note, view could point to part of string without terminating zero.
+    CHECK(to_utf8(WSTRING_VIEW(utf16.data() + 2, utf16.size() - 4)) == "b\xd0\xbf\xf0\x9f\x98\x80");
+    CHECK(to_utf8(WSTRING_VIEW(utf16)) == text);
+
+    std::string output(100, 'x');
+    const void *data = output.data();
+    assign_utf8(output, WSTRING_VIEW(utf16));
+    CHECK(output == text);
+    CHECK(output.data() == data);
+    assign_utf8(output, utf16.c_str());
+    CHECK(output == text);
+    append_utf8(output, WSTRING_VIEW(utf16.data(), 1));
+    CHECK(output == text + "a");
+
+    WSTRING woutput;
+    assign_utf16(woutput, Utility::string_view(text.data(), 3));
+    CHECK(woutput == Utf16({'a', '.', 'b'}));
+    assign_utf16(woutput, text);
+    CHECK(woutput == utf16);
+    assign_utf16(woutput, Utility::string_view());
+    CHECK(woutput.empty());
+}
@@ -0,0 +1,209 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <map>
+#include <string>
+#include <vector>
+#include "debugger/watchcache.h"
+
+using ::netcoredbg::WatchResultsCache;
+using ::netcoredbg::ValueChangesTracker;
+
+namespace
+{
+
+    typedef WatchResultsCache::Dependency Dependency;
+
+    // Debuggee state emulation: stack variables and objects memory.
+    struct State
+    {
+        std::map<std::string, std::string> stackVars;
+        std::map<uint64_t, std::string> objects;
+        int reads = 0;
+
+        bool Read(const Dependency &dependency, std::string &data)
+        {
+            reads++;
+            switch (dependency.kind)
+            {
+                case Dependency::Kind::StackVariable:
+                {
+                    auto find = stackVars.find(dependency.name);
+                    if (find == stackVars.end())
+                        return false;
+                    data = find->second;
+                    return true;
+                }
+                case Dependency::Kind::ThisMember:
+                    return stackVars.find(dependency.name) == stackVars.end();
+                case Dependency::Kind::Object:
+                {
+                    auto find = objects.find(dependency.address);
+                    if (find == objects.end())
+                        return false;
+                    data = find->second.substr(0, dependency.data.size());
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    WatchResultsCache::Result MakeResult(const std::string &value, const std::string &type)
+    {
+        WatchResultsCache::Result result;
+        result.value = value;
+        result.type = type;
+        return result;
+    }
+
+    // Dependencies of `this.obj.field` like expression.
+    std::vector<Dependency> MakeDependencies(State &state)
+    {
+        std::vector<Dependency> dependencies;
+        dependencies.emplace_back(Dependency::Kind::StackVariable, "this", 0, std::string(state.stackVars["this"]));
+        dependencies.emplace_back(Dependency::Kind::ThisMember, "obj", 0, std::string());
+        dependencies.emplace_back(Dependency::Kind::Object, "", 0x1000, std::string(state.objects[0x1000]));
+        return dependencies;
+    }
+
+} // unnamed namespace
+
+TEST_CASE("WatchResultsCache::Find")
+{
+    WatchResultsCache cache;
+    State state;
+    state.stackVars["this"] = "this@1";
+    state.objects[0x1000] = "abcd";
+    auto read = [&](const Dependency &dependency, std::string &data) { return state.Read(dependency, data); };
+
+    WatchResultsCache::Result result;
+    CHECK(!cache.Find("obj.field", read, result));
+
+    cache.Add("obj.field", MakeDependencies(state), MakeResult("5", "int"));
+    REQUIRE(cache.Find("obj.field", read, result));
+    CHECK(result.value == "5");
+    CHECK(result.type == "int");
+    CHECK(!result.editable);
+    CHECK(state.reads == 3);
+
+    SECTION("object changed")
+    {
+        state.objects[0x1000] = "abXd";
+        CHECK(!cache.Find("obj.field", read, result));
+        // Stale result dropped.
+        state.objects[0x1000] = "abcd";
+        CHECK(!cache.Find("obj.field", read, result));
+    }
+
+    SECTION("stack variable changed")
+    {
+        state.stackVars["this"] = "this@2";
+        CHECK(!cache.Find("obj.field", read, result));
+    }
+
+    SECTION("stack variable shadow this member")
+    {
+        state.stackVars["obj"] = "obj@3";
+        CHECK(!cache.Find("obj.field", read, result));
+    }
+
+    SECTION("dependency not readable")
+    {
+        state.stackVars.erase("this");
+        CHECK(!cache.Find("obj.field", read, result));
+    }
+
+    SECTION("result replaced")
+    {
+        cache.Add("obj.field", MakeDependencies(state), MakeResult("6", "int"));
+        REQUIRE(cache.Find("obj.field", read, result));
+        CHECK(result.value == "6");
+    }
+
+    SECTION("clear")
+    {
+        cache.Clear();
+        CHECK(!cache.Find("obj.field", read, result));
+    }
+}
+
+TEST_CASE("WatchResultsCache::Add overflow")
+{
+    WatchResultsCache cache;
+    auto read = [](const Dependency &, std::string &) { return true; };
+
+    for (size_t i = 0; i < WatchResultsCache::MaxResults; i++)
+        cache.Add(std::to_string(i), std::vector<Dependency>(), MakeResult(std::to_string(i), "int"));
+
+    WatchResultsCache::Result result;
+    REQUIRE(cache.Find("0", read, result));
+    CHECK(result.value == "0");
+
+    // Existing result update don't drop cache.
+    cache.Add("0", std::vector<Dependency>(), MakeResult("zero", "int"));
+    CHECK(cache.Find("1", read, result));
+
+    cache.Add("new", std::vector<Dependency>(), MakeResult("new", "int"));
+    CHECK(!cache.Find("1", read, result));
+    REQUIRE(cache.Find("new", read, result));
+    CHECK(result.value == "new");
+}
+
+TEST_CASE("ValueChangesTracker")
+{
+    ValueChangesTracker tracker;
+    const uint64_t one = ValueChangesTracker::Hash("1");
+    const uint64_t two = ValueChangesTracker::Hash("2");
+    REQUIRE(one != two);
+
+    // First stop, nothing to compare with.
+    CHECK(!tracker.Update("1:main:i", one));
+    CHECK(!tracker.Update("1:main:j", one));
+    tracker.NextStop();
+
+    CHECK(tracker.Update("1:main:i", two));
+    CHECK(!tracker.Update("1:main:j", one));
+    // Same value requested again at same stop.
+    CHECK(tracker.Update("1:main:i", two));
+
+    SECTION("next stop")
+    {
+        tracker.NextStop();
+        CHECK(!tracker.Update("1:main:i", two));
+        CHECK(tracker.Update("1:main:j", two));
+    }
+
+    SECTION("value not shown at last stop")
+    {
+        tracker.NextStop();
+        CHECK(!tracker.Update("1:main:i", two));
+        tracker.NextStop();
+        // Compared with stop where value was shown.
+        CHECK(tracker.Update("1:main:j", two));
+    }
+
+    SECTION("clear")
+    {
+        tracker.Clear();
+        CHECK(!tracker.Update("1:main:i", one));
+    }
+}
+
+TEST_CASE("ValueChangesTracker overflow")
+{
+    ValueChangesTracker tracker;
+    for (size_t i = 0; i < ValueChangesTracker::MaxValues; i++)
+        tracker.Update(std::to_string(i), 0);
+
+    // Not tracked, since limit reached, but existing values are updated.
+    tracker.Update("new", 0);
+    tracker.Update("0", 1);
+    tracker.NextStop();
+
+    CHECK(!tracker.Update("new", 1));
+    CHECK(tracker.Update("0", 2));
+    CHECK(tracker.Update("1", 1));
+}
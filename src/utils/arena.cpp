@@ -0,0 +1,56 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "utils/arena.h"
+
+#include <cstring>
+
+namespace netcoredbg
+{
+
+const size_t StringArena::BlockSize;
+
+Utility::string_view StringArena::Store(Utility::string_view str)
+{
+    if (str.empty())
+        return Utility::string_view();
+
+    if (str.size() > BlockSize)
+    {
+        m_blocks.emplace_back(std::unique_ptr<char[]>(new char[str.size()]), str.size());
+        memcpy(m_blocks.back().first.get(), str.data(), str.size());
+        return Utility::string_view(m_blocks.back().first.get(), str.size());
+    }
+
+    if (m_used + str.size() > BlockSize)
+    {
+        if (m_current)
+            m_blocks.emplace_back(std::move(m_current), BlockSize);
+        m_current.reset(new char[BlockSize]);
+        m_used = 0;
+    }
+
+    char *data = m_current.get() + m_used;
+    memcpy(data, str.data(), str.size());
+    m_used += str.size();
+    return Utility::string_view(data, str.size());
+}
+
+void StringArena::Reset()
+{
+    m_blocks.clear();
+    m_used = m_current ? 0 : BlockSize;
+}
+
+size_t StringArena::GetMemoryUsage() const
+{
+    size_t size = (m_current ? BlockSize : 0) + m_blocks.capacity() * sizeof(m_blocks[0]);
+    for (const auto &block : m_blocks)
+    {
+        size += block.second;
+    }
+    return size;
+}
+
+} // namespace netcoredbg
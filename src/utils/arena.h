@@ -0,0 +1,96 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "utils/string_view.h"
+
+namespace netcoredbg
+{
+
+// Append-only storage of elements with dense indexes (in order of addition). Elements are stored in fixed size blocks
+// and never moved, so, pointers to elements are valid till Reset(). Blocks are kept by Reset() for next elements
+// generation reuse, so, there is no allocations in steady state.
+// Note, not thread safe.
+template <class T, size_t BlockSize = 256>
+class DenseArena
+{
+public:
+
+    DenseArena() : m_size(0) {}
+    ~DenseArena() { Reset(); }
+
+    DenseArena(const DenseArena&) = delete;
+    DenseArena& operator=(const DenseArena&) = delete;
+
+    size_t Size() const { return m_size; }
+
+    template <class... Args>
+    T &Emplace(Args&&... args)
+    {
+        if (m_size == m_blocks.size() * BlockSize)
+            m_blocks.emplace_back(new storage_t[BlockSize]);
+
+        T *element = new (&m_blocks[m_size / BlockSize][m_size % BlockSize]) T(std::forward<Args>(args)...);
+        m_size++;
+        return *element;
+    }
+
+    // Return nullptr in case `index` is out of range.
+    T *Get(size_t index)
+    {
+        if (index >= m_size)
+            return nullptr;
+        return reinterpret_cast<T*>(&m_blocks[index / BlockSize][index % BlockSize]);
+    }
+
+    void Reset()
+    {
+        for (size_t i = 0; i < m_size; i++)
+        {
+            reinterpret_cast<T*>(&m_blocks[i / BlockSize][i % BlockSize])->~T();
+        }
+        m_size = 0;
+    }
+
+private:
+
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_t;
+
+    std::vector<std::unique_ptr<storage_t[]>> m_blocks;
+    size_t m_size;
+};
+
+// Append-only strings storage, strings are copied into big blocks (without allocation for each string), returned views
+// are valid till Reset(). Current block is kept by Reset() for next strings generation reuse.
+// Note, not thread safe.
+class StringArena
+{
+public:
+
+    StringArena() : m_used(BlockSize) {}
+
+    Utility::string_view Store(Utility::string_view str);
+    void Reset();
+    // Approximate heap memory size.
+    size_t GetMemoryUsage() const;
+
+private:
+
+    static const size_t BlockSize = 64 * 1024;
+
+    std::unique_ptr<char[]> m_current;
+    size_t m_used;  // used bytes of current block
+    // Filled blocks and strings bigger than block (have own blocks).
+    std::vector<std::pair<std::unique_ptr<char[]>, size_t>> m_blocks;
+};
+
+} // namespace netcoredbg
@@ -0,0 +1,147 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "utils/base64.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace netcoredbg
+{
+namespace Base64
+{
+
+namespace
+{
+
+    const char Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    // Two output chars for each 12 bits of input, so, 3 input bytes are encoded by two lookups and two 2-byte stores.
+    struct PairsTable
+    {
+        char pairs[4096 * 2];
+
+        PairsTable()
+        {
+            for (unsigned i = 0; i < 4096; i++)
+            {
+                pairs[i * 2] = Alphabet[i >> 6];
+                pairs[i * 2 + 1] = Alphabet[i & 0x3f];
+            }
+        }
+    };
+
+    struct DecodeTable
+    {
+        int8_t values[256];
+
+        DecodeTable()
+        {
+            memset(values, -1, sizeof(values));
+            for (int i = 0; i < 64; i++)
+            {
+                values[(unsigned char)Alphabet[i]] = (int8_t)i;
+            }
+        }
+    };
+
+    inline void EncodeGroup(const char *pairs, const uint8_t *in, char *out)
+    {
+        const uint32_t group = (uint32_t(in[0]) << 16) | (uint32_t(in[1]) << 8) | uint32_t(in[2]);
+        memcpy(out, pairs + (group >> 12) * 2, 2);
+        memcpy(out + 2, pairs + (group & 0xfff) * 2, 2);
+    }
+
+} // unnamed namespace
+
+void Encode(const void *data, size_t size, std::string &output)
+{
+    static const PairsTable table;
+    const char *pairs = table.pairs;
+
+    const uint8_t *in = static_cast<const uint8_t*>(data);
+    const size_t start = output.size();
+    output.resize(start + EncodedSize(size));
+    char *out = &output[start];
+
+    size_t i = 0;
+    // Note, 4 independent groups per iteration, so, compiler could interleave loads and lookups.
+    for (; i + 12 <= size; i += 12, out += 16)
+    {
+        EncodeGroup(pairs, in + i, out);
+        EncodeGroup(pairs, in + i + 3, out + 4);
+        EncodeGroup(pairs, in + i + 6, out + 8);
+        EncodeGroup(pairs, in + i + 9, out + 12);
+    }
+    for (; i + 3 <= size; i += 3, out += 4)
+    {
+        EncodeGroup(pairs, in + i, out);
+    }
+
+    switch (size - i)
+    {
+        case 1:
+            out[0] = Alphabet[in[i] >> 2];
+            out[1] = Alphabet[(in[i] & 0x03) << 4];
+            out[2] = '=';
+            out[3] = '=';
+            break;
+        case 2:
+            out[0] = Alphabet[in[i] >> 2];
+            out[1] = Alphabet[((in[i] & 0x03) << 4) | (in[i + 1] >> 4)];
+            out[2] = Alphabet[(in[i + 1] & 0x0f) << 2];
+            out[3] = '=';
+            break;
+        default:
+            break;
+    }
+}
+
+bool Decode(Utility::string_view input, std::string &output)
+{
+    static const DecodeTable table;
+
+    if (input.size() % 4 != 0)
+        return false;
+
+    size_t padding = 0;
+    if (!input.empty() && input[input.size() - 1] == '=')
+        padding = (input.size() > 1 && input[input.size() - 2] == '=') ? 2 : 1;
+
+    const size_t start = output.size();
+    output.resize(start + input.size() / 4 * 3);
+    char *out = &output[start];
+
+    for (size_t i = 0; i < input.size(); i += 4, out += 3)
+    {
+        const bool last = i + 4 == input.size();
+        int32_t values[4];
+        for (size_t j = 0; j < 4; j++)
+        {
+            // Note, padding chars are allowed at the end of last group only.
+            if (last && j >= 4 - padding)
+            {
+                values[j] = 0;
+                continue;
+            }
+            values[j] = table.values[(unsigned char)input[i + j]];
+            if (values[j] < 0)
+            {
+                output.resize(start);
+                return false;
+            }
+        }
+
+        const uint32_t group = (uint32_t(values[0]) << 18) | (uint32_t(values[1]) << 12) | (uint32_t(values[2]) << 6) | uint32_t(values[3]);
+        out[0] = char(group >> 16);
+        out[1] = char((group >> 8) & 0xff);
+        out[2] = char(group & 0xff);
+    }
+
+    output.resize(output.size() - padding);
+    return true;
+}
+
+} // namespace Base64
+} // namespace netcoredbg
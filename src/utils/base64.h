@@ -0,0 +1,24 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "utils/string_view.h"
+
+namespace netcoredbg
+{
+namespace Base64
+{
+    // Size of encoded data with padding.
+    inline size_t EncodedSize(size_t size) { return (size + 2) / 3 * 4; }
+
+    // Append encoded data (standard alphabet with padding) to `output`.
+    void Encode(const void *data, size_t size, std::string &output);
+
+    // Append decoded data to `output`, return false in case input is not valid base64 (no whitespaces allowed).
+    bool Decode(Utility::string_view input, std::string &output);
+
+} // namespace Base64
+} // namespace netcoredbg
@@ -0,0 +1,38 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "utils/cancellation.h"
+
+namespace netcoredbg
+{
+
+namespace Cancellation
+{
+
+namespace // unnamed namespace
+{
+
+thread_local const CancellationToken *currentToken = nullptr;
+
+} // unnamed namespace
+
+Scope::Scope(const CancellationToken &token) :
+    m_prevToken(currentToken)
+{
+    currentToken = &token;
+}
+
+Scope::~Scope()
+{
+    currentToken = m_prevToken;
+}
+
+bool IsRequested()
+{
+    return currentToken != nullptr && currentToken->IsCanceled();
+}
+
+} // namespace Cancellation
+
+} // namespace netcoredbg
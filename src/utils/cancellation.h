@@ -0,0 +1,63 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace netcoredbg
+{
+
+// Cancellation token for protocol request execution. Token copies share same state, so, protocol side could
+// keep one copy and cancel request, that is executed with another copy in separate thread.
+class CancellationToken
+{
+public:
+
+    CancellationToken() :
+        m_canceled(std::make_shared<std::atomic<bool> >(false))
+    {}
+
+    void Cancel() const
+    {
+        m_canceled->store(true, std::memory_order_relaxed);
+    }
+
+    bool IsCanceled() const
+    {
+        return m_canceled->load(std::memory_order_relaxed);
+    }
+
+private:
+
+    std::shared_ptr<std::atomic<bool> > m_canceled;
+};
+
+// Note, debugger routines (variables fetch, evaluation, stack trace) don't receive token as argument,
+// protocol side set token for thread that execute request and debugger routines check it at cancellation points.
+namespace Cancellation
+{
+    // Set token for current thread for scope lifetime (previous token restored at scope exit).
+    class Scope
+    {
+    public:
+
+        explicit Scope(const CancellationToken &token);
+        ~Scope();
+
+    private:
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        const CancellationToken *m_prevToken;
+    };
+
+    // Return true in case current thread have token and token was canceled.
+    bool IsRequested();
+
+} // namespace Cancellation
+
+} // namespace netcoredbg
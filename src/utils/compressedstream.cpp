@@ -0,0 +1,267 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+/// \file compressedstream.cpp  This file contains member definitions of CompressedStreamBuf
+/// and CompressedStream classes.
+
+#include <cstring>
+#include <cassert>
+#include <algorithm>
+#include <stdexcept>
+#include <zlib.h>
+
+#include "utils/compressedstream.h"
+#include "utils/logger.h"
+
+namespace netcoredbg
+{
+
+const size_t CompressedStreamBuf::MinCompressSize = 512;
+const size_t CompressedStreamBuf::MaxFrameSize = 16 * 1024 * 1024;
+
+namespace
+{
+    const size_t FrameHeaderSize = 4;
+    const uint32_t CompressedFlag = 0x80000000;
+    const size_t MinBufferSize = 1024;
+    const size_t OverflowChars = 1;  // number of extra chars in buffer for overflow
+
+    // Note, protocol data is sent interactively, so, fastest level is used: the most of gain
+    // for JSON text is provided by any level, higher levels only increase latency.
+    const int CompressionLevel = Z_BEST_SPEED;
+    // Raw deflate stream (negative value), 32 KiB window.
+    const int WindowBits = -15;
+    const int MemLevel = 8;
+}
+
+CompressedStreamBuf::CompressedStreamBuf(std::streambuf &transport, size_t buf_size)
+: m_transport(transport),
+  m_deflate(new z_stream()),
+  m_inflate(new z_stream()),
+  m_deflatePending(false),
+  m_inflateMore(false),
+  m_inflateError(false),
+  m_outbuf(std::min(std::max(buf_size, MinBufferSize), MaxFrameSize)),
+  m_inbuf(m_outbuf.size()),
+  m_compressed(m_outbuf.size())
+{
+    if (deflateInit2(m_deflate.get(), CompressionLevel, Z_DEFLATED, WindowBits, MemLevel, Z_DEFAULT_STRATEGY) != Z_OK ||
+        inflateInit2(m_inflate.get(), WindowBits) != Z_OK)
+    {
+        throw std::runtime_error("can't initialize zlib");
+    }
+
+    setp(m_outbuf.data(), m_outbuf.data() + m_outbuf.size() - OverflowChars);
+    setg(m_inbuf.data(), m_inbuf.data(), m_inbuf.data());
+}
+
+CompressedStreamBuf::~CompressedStreamBuf()
+{
+    CompressedStreamBuf::sync();
+    deflateEnd(m_deflate.get());
+    inflateEnd(m_inflate.get());
+}
+
+bool CompressedStreamBuf::WriteFrame(const char *data, size_t size, bool compressed)
+{
+    assert(size <= MaxFrameSize);
+    const uint32_t value = uint32_t(size) | (compressed ? CompressedFlag : 0);
+    const char header[FrameHeaderSize] = {
+        char(value >> 24), char(value >> 16), char(value >> 8), char(value)
+    };
+
+    return m_transport.sputn(header, FrameHeaderSize) == std::streamsize(FrameHeaderSize) &&
+           m_transport.sputn(data, size) == std::streamsize(size);
+}
+
+// Function sends buffered data, `flush` -- ends deflate block, so, peer could decode all sent data.
+bool CompressedStreamBuf::Send(bool flush)
+{
+    const size_t size = pptr() - pbase();
+    if (size == 0 && !(flush && m_deflatePending))
+        return true;
+
+    setp(m_outbuf.data(), m_outbuf.data() + m_outbuf.size() - OverflowChars);
+
+    if (!m_deflatePending && size < MinCompressSize)
+        return WriteFrame(m_outbuf.data(), size, false);
+
+    m_deflate->next_in = reinterpret_cast<Bytef*>(m_outbuf.data());
+    m_deflate->avail_in = uInt(size);
+    do
+    {
+        m_deflate->next_out = reinterpret_cast<Bytef*>(m_compressed.data());
+        m_deflate->avail_out = uInt(m_compressed.size());
+
+        const int ret = deflate(m_deflate.get(), flush ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+        // Note, Z_BUF_ERROR means no progress was possible (all data already flushed), that is not fatal.
+        if (ret != Z_OK && ret != Z_BUF_ERROR)
+        {
+            LOGE("deflate failed: %d", ret);
+            return false;
+        }
+
+        const size_t produced = m_compressed.size() - m_deflate->avail_out;
+        if (produced != 0 && !WriteFrame(m_compressed.data(), produced, true))
+            return false;
+    }
+    while (m_deflate->avail_in != 0 || m_deflate->avail_out == 0);
+
+    m_deflatePending = !flush;
+    return true;
+}
+
+int CompressedStreamBuf::overflow(int c)
+{
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);  // need extra char at buffer
+    }
+
+    if (!Send(false))
+        return traits_type::eof();
+
+    return traits_type::not_eof(c);
+}
+
+int CompressedStreamBuf::sync()
+{
+    if (!Send(true))
+        return -1;
+
+    return m_transport.pubsync();
+}
+
+// Function reads next frame, raw payload is stored directly in input buffer, compressed
+// payload is stored as inflate input.
+bool CompressedStreamBuf::ReadFrame()
+{
+    char header[FrameHeaderSize];
+    if (m_transport.sgetn(header, FrameHeaderSize) != std::streamsize(FrameHeaderSize))
+        return false;
+
+    const uint32_t value = (uint32_t(uint8_t(header[0])) << 24) | (uint32_t(uint8_t(header[1])) << 16) |
+                           (uint32_t(uint8_t(header[2])) << 8) | uint32_t(uint8_t(header[3]));
+    const size_t size = value & ~CompressedFlag;
+    if (size > MaxFrameSize)
+    {
+        LOGE("Wrong compressed stream frame size %zu", size);
+        return false;
+    }
+
+    std::vector<char> &payload = (value & CompressedFlag) ? m_frame : m_inbuf;
+    if (payload.size() < size)
+        payload.resize(size);
+
+    if (m_transport.sgetn(payload.data(), size) != std::streamsize(size))
+        return false;
+
+    if (value & CompressedFlag)
+    {
+        m_inflate->next_in = reinterpret_cast<Bytef*>(m_frame.data());
+        m_inflate->avail_in = uInt(size);
+        setg(m_inbuf.data(), m_inbuf.data(), m_inbuf.data());
+    }
+    else
+    {
+        setg(m_inbuf.data(), m_inbuf.data(), m_inbuf.data() + size);
+    }
+
+    return true;
+}
+
+int CompressedStreamBuf::underflow()
+{
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    if (m_inflateError)
+        return traits_type::eof();
+
+    while (true)
+    {
+        if (m_inflate->avail_in == 0 && !m_inflateMore)
+        {
+            if (!ReadFrame())
+            {
+                m_inflateError = true;
+                return traits_type::eof();
+            }
+
+            if (gptr() < egptr())
+                return traits_type::to_int_type(*gptr());
+
+            if (m_inflate->avail_in == 0)
+                continue; // empty frame
+        }
+
+        m_inflate->next_out = reinterpret_cast<Bytef*>(m_inbuf.data());
+        m_inflate->avail_out = uInt(m_inbuf.size());
+
+        const int ret = inflate(m_inflate.get(), Z_SYNC_FLUSH);
+        if (ret != Z_OK && ret != Z_BUF_ERROR)
+        {
+            LOGE("inflate failed: %d", ret);
+            m_inflateError = true;
+            return traits_type::eof();
+        }
+
+        m_inflateMore = m_inflate->avail_out == 0;
+        const size_t produced = m_inbuf.size() - m_inflate->avail_out;
+        if (produced != 0)
+        {
+            setg(m_inbuf.data(), m_inbuf.data(), m_inbuf.data() + produced);
+            return traits_type::to_int_type(*gptr());
+        }
+    }
+}
+
+
+CompressedStream::CompressedStream(std::unique_ptr<std::iostream> transport, size_t buf_size)
+: std::iostream(nullptr),
+  m_transport(std::move(transport)),
+  m_buffer(new CompressedStreamBuf(*m_transport->rdbuf(), buf_size))
+{
+    rdbuf(m_buffer.get());
+}
+
+CompressedStream::~CompressedStream()
+{
+    // Note, buffer must be flushed and destroyed before transport.
+    m_buffer.reset();
+}
+
+
+namespace StreamCompression
+{
+
+const char Hello[] = "\0NCDBG-DEFLATE\n";
+const size_t HelloSize = sizeof(Hello) - 1;
+
+bool Negotiate(std::streambuf &transport)
+{
+    typedef std::streambuf::traits_type traits_type;
+
+    const int c = transport.sgetc();
+    if (traits_type::eq_int_type(c, traits_type::eof()) || traits_type::to_char_type(c) != Hello[0])
+        return false;
+
+    char request[sizeof(Hello)];
+    if (transport.sgetn(request, HelloSize) != std::streamsize(HelloSize) || memcmp(request, Hello, HelloSize) != 0)
+    {
+        LOGE("Wrong compression request");
+        return false;
+    }
+
+    if (transport.sputn(Hello, HelloSize) != std::streamsize(HelloSize) || transport.pubsync() != 0)
+        return false;
+
+    LOGI("Compressed transport negotiated");
+    return true;
+}
+
+} // namespace StreamCompression
+
+} // ::netcoredbg
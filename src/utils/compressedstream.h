@@ -0,0 +1,116 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+/// \file compressedstream.h  This file contains declaration of classes implementing optional
+/// deflate compression layer for TCP/IP connection in server mode.
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <streambuf>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+struct z_stream_s;
+
+namespace netcoredbg
+{
+
+/// This class implements `std::streambuf` interface on top of other (transport) stream buffer
+/// and transfers data as sequence of frames. Each frame have 4 bytes header (big endian): high bit
+/// is set for compressed payload, other bits contain payload size. Compressed frames contain parts
+/// of single deflate stream (RFC 1951) without zlib header, each flush of the buffer ends with
+/// Z_SYNC_FLUSH, so, receiver could decode all sent data without waiting for next frames.
+///
+/// Note, small messages (most of protocol events and responses) are sent as is, since deflate
+/// can't reduce such messages size and only wastes CPU time.
+///
+class CompressedStreamBuf : public std::streambuf
+{
+public:
+    using traits_type = std::streambuf::traits_type;
+
+    /// Data flushed by one portion smaller than this size is sent uncompressed.
+    static const size_t MinCompressSize;
+
+    /// Maximum supported frame payload size, bigger frame is treated as input error.
+    static const size_t MaxFrameSize;
+
+    /// Arguments are following: `transport` -- underlying stream buffer, which should outlive
+    /// this object, `buf_size` -- size of input and output buffers.
+    CompressedStreamBuf(std::streambuf &transport, size_t buf_size);
+
+    CompressedStreamBuf(const CompressedStreamBuf&) = delete;
+    CompressedStreamBuf &operator=(const CompressedStreamBuf&) = delete;
+
+    virtual ~CompressedStreamBuf();
+
+protected:
+    /// Function reads and decodes next frames until at least one character is available.
+    /// Returns traits_type::eof() on transport error, end of file or broken frame.
+    virtual int underflow() override;
+
+    /// Function sends buffered data (without flush of deflate stream) and ensures, that
+    /// after return there is space in the buffer for at least one character.
+    virtual int overflow(int c) override;
+
+    /// Function sends all buffered data and flushes transport.
+    virtual int sync() override;
+
+private:
+    bool Send(bool flush);
+    bool WriteFrame(const char *data, size_t size, bool compressed);
+    bool ReadFrame();
+
+    std::streambuf &m_transport;
+    std::unique_ptr<z_stream_s> m_deflate;
+    std::unique_ptr<z_stream_s> m_inflate;
+    // Note, deflate stream could keep part of consumed data in internal state until flush,
+    // in this case rest of data must be compressed too, whatever it size.
+    bool m_deflatePending;
+    // Note, inflate output could be bigger than input buffer, in this case inflate must be
+    // called again (even without new input) before next frame reading.
+    bool m_inflateMore;
+    bool m_inflateError;
+    std::vector<char> m_outbuf;
+    std::vector<char> m_inbuf;
+    std::vector<char> m_compressed; // deflate output
+    std::vector<char> m_frame;      // compressed frame payload, inflate input
+};
+
+
+/// This class is similar to IOStream, but transfers data with CompressedStreamBuf.
+/// Class owns underlying transport stream.
+class CompressedStream : public std::iostream
+{
+public:
+    CompressedStream(std::unique_ptr<std::iostream> transport, size_t buf_size);
+
+    CompressedStream(const CompressedStream&) = delete;
+
+    virtual ~CompressedStream();
+
+private:
+    std::unique_ptr<std::iostream> m_transport;
+    std::unique_ptr<CompressedStreamBuf> m_buffer;
+};
+
+
+namespace StreamCompression
+{
+    /// Compression request, which client must send first (before any protocol data) and
+    /// which is sent back by debugger in case compression is accepted. Client must wait
+    /// for this answer, all next data in both directions is framed by CompressedStreamBuf.
+    extern const char Hello[];
+    extern const size_t HelloSize;
+
+    /// Function waits for first client's data and checks for compression request. Returns true
+    /// in case compression was requested (request is consumed and answer is sent), or false
+    /// in case client sent protocol data (no data consumed). Note, in case of broken request
+    /// or transport error false is returned too, protocol will fail on next input.
+    bool Negotiate(std::streambuf &transport);
+}
+
+} // ::netcoredbg
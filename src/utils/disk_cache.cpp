@@ -0,0 +1,295 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "utils/disk_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <unordered_set>
+#include "utils/filesystem.h"
+#include "utils/logger.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+    const char indexFileName[] = "index";
+
+    // Note, keys from index file are used as file names, don't allow them point out of cache directory.
+    bool IsValidKey(const std::string &key)
+    {
+        return !key.empty() && key != "." && key != ".." && key.find_first_of("/\\") == std::string::npos;
+    }
+
+    std::string GetTempPath(const std::string &path)
+    {
+        std::random_device random;
+        std::ostringstream ss;
+        ss << path << "." << std::hex << random() << random() << ".tmp";
+        return ss.str();
+    }
+
+    bool Publish(const std::string &tempPath, const std::string &path)
+    {
+        if (std::rename(tempPath.c_str(), path.c_str()) == 0)
+            return true;
+
+        // Note, on Windows rename fails in case destination exists.
+        std::remove(path.c_str());
+        if (std::rename(tempPath.c_str(), path.c_str()) == 0)
+            return true;
+
+        std::remove(tempPath.c_str());
+        return false;
+    }
+} // unnamed namespace
+
+DiskCache::DiskCache(const char *name, const char *dirName, const char *entryExt, const char *writerName, uint64_t maxSize, size_t maxEntries) :
+    m_name(name),
+    m_dirName(dirName),
+    m_entryExt(entryExt),
+    m_maxEntries(maxEntries),
+    m_enabled(true),
+    m_indexLoaded(false),
+    m_defaultDir(false),
+    m_maxSize(maxSize),
+    m_totalSize(0),
+    m_writer(writerName)
+{}
+
+void DiskCache::SetOptions(bool enable, const std::string &dir, uint64_t maxSize)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_enabled = enable && maxSize != 0;
+    m_dir = dir;
+    m_defaultDir = false;
+    m_maxSize = maxSize;
+    m_indexLoaded = false;
+    m_index.clear();
+    m_totalSize = 0;
+}
+
+bool DiskCache::IsEnabled()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_enabled;
+}
+
+// Caller must care about m_mutex.
+std::string DiskCache::GetDir()
+{
+    if (m_dir.empty())
+    {
+        m_dir = GetUserTempDir(m_dirName);
+        m_defaultDir = true;
+    }
+
+    return m_dir;
+}
+
+// Caller must care about m_mutex.
+std::string DiskCache::GetEntryPath(const std::string &key)
+{
+    return GetDir() + FileSystem::PathSeparator + key + m_entryExt;
+}
+
+// Caller must care about m_mutex.
+void DiskCache::LoadIndex()
+{
+    if (m_indexLoaded)
+        return;
+
+    m_indexLoaded = true;
+
+    // Note, only default directory in shared temp directory must be checked for owner and access rights,
+    // directory provided by user could have any rights.
+    const std::string dir = GetDir();
+    if (!(m_defaultDir ? CreatePrivateDir(dir) : CreateDir(dir)))
+    {
+        LOGW("Could not create %s cache directory %s, cache disabled", m_name, dir.c_str());
+        m_enabled = false;
+        return;
+    }
+
+    ReadIndexFile(m_index);
+    for (const auto &entry : m_index)
+    {
+        m_totalSize += entry.size;
+    }
+}
+
+// Caller must care about m_mutex.
+void DiskCache::ReadIndexFile(std::list<entry_t> &index)
+{
+    std::ifstream indexFile(GetDir() + FileSystem::PathSeparator + indexFileName);
+    std::string line;
+    while (std::getline(indexFile, line))
+    {
+        std::istringstream ss(line);
+        entry_t entry;
+        if (!(ss >> entry.key) || !IsValidKey(entry.key))
+            continue;
+        // Note, entries without size could be stored by previous debugger versions.
+        if (!(ss >> entry.size))
+            entry.size = 0;
+
+        index.emplace_back(std::move(entry));
+    }
+}
+
+// Caller must care about m_mutex.
+void DiskCache::SaveIndex(const std::string &removedKey)
+{
+    // Other debugger instances could publish entries since index was loaded, keep them (as older entries).
+    std::unordered_set<std::string> keys;
+    for (const auto &entry : m_index)
+    {
+        keys.insert(entry.key);
+    }
+    if (!removedKey.empty())
+        keys.insert(removedKey);
+    std::list<entry_t> published;
+    ReadIndexFile(published);
+    for (auto it = published.rbegin(); it != published.rend(); ++it)
+    {
+        if (!keys.insert(it->key).second || !std::ifstream(GetEntryPath(it->key)))
+            continue;
+
+        m_totalSize += it->size;
+        m_index.emplace_front(std::move(*it));
+    }
+    Evict(0, 0);
+
+    const std::string indexPath = GetDir() + FileSystem::PathSeparator + indexFileName;
+    const std::string tempPath = GetTempPath(indexPath);
+    {
+        std::ofstream indexFile(tempPath, std::ios::trunc);
+        for (const auto &entry : m_index)
+        {
+            indexFile << entry.key << " " << entry.size << "\n";
+        }
+    }
+    Publish(tempPath, indexPath);
+}
+
+// Caller must care about m_mutex.
+void DiskCache::RemoveFromIndex(const std::string &key)
+{
+    for (auto it = m_index.begin(); it != m_index.end(); ++it)
+    {
+        if (it->key != key)
+            continue;
+
+        m_totalSize -= it->size;
+        m_index.erase(it);
+        break;
+    }
+}
+
+// Caller must care about m_mutex.
+void DiskCache::Evict(uint64_t requiredSize, size_t requiredEntries)
+{
+    while (!m_index.empty() && (m_totalSize + requiredSize > m_maxSize || m_index.size() + requiredEntries > m_maxEntries))
+    {
+        std::remove(GetEntryPath(m_index.front().key).c_str());
+        m_totalSize -= m_index.front().size;
+        m_index.pop_front();
+    }
+}
+
+bool DiskCache::Lookup(const std::string &key, std::string &entryPath)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_enabled || !IsValidKey(key))
+        return false;
+
+    LoadIndex();
+    if (!m_enabled)
+        return false;
+
+    entryPath = GetEntryPath(key);
+    return true;
+}
+
+void DiskCache::Store(const std::string &key, uint64_t size, const std::function<void(std::ostream &out)> &write)
+{
+    std::string entryPath;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_enabled || !IsValidKey(key))
+            return;
+
+        LoadIndex();
+        if (!m_enabled || size > m_maxSize)
+            return;
+
+        entryPath = GetEntryPath(key);
+    }
+
+    // Note, entry is written into unique temporary file without cache lock, so, Lookup() don't wait for disk write.
+    const std::string tempPath = GetTempPath(entryPath);
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        write(out);
+
+        if (!out)
+        {
+            LOGW("Could not write %s cache entry %s", m_name, entryPath.c_str());
+            out.close();
+            std::remove(tempPath.c_str());
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Note, options could be changed by SetOptions() during entry write.
+    if (m_enabled)
+        LoadIndex();
+    if (!m_enabled || size > m_maxSize || GetEntryPath(key) != entryPath)
+    {
+        std::remove(tempPath.c_str());
+        return;
+    }
+
+    // Same key could be stored already (for example, updated data or entry with wrong format), remove previous entry from index.
+    RemoveFromIndex(key);
+    Evict(size, 1);
+
+    // Note, in case other instance published same entry at same time, any of them could be used (data is same).
+    if (!Publish(tempPath, entryPath))
+    {
+        LOGW("Could not publish %s cache entry %s", m_name, entryPath.c_str());
+        SaveIndex();
+        return;
+    }
+
+    m_index.emplace_back(entry_t{key, size});
+    m_totalSize += size;
+    SaveIndex();
+}
+
+void DiskCache::Remove(const std::string &key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_enabled || !IsValidKey(key))
+        return;
+
+    LoadIndex();
+    if (!m_enabled)
+        return;
+
+    RemoveFromIndex(key);
+    std::remove(GetEntryPath(key).c_str());
+    SaveIndex(key);
+}
+
+void DiskCache::Post(SequencedExecutor::Task &&task)
+{
+    m_writer.Post(std::move(task));
+}
+
+} // namespace netcoredbg
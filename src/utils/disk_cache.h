@@ -0,0 +1,122 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <string>
+#include <list>
+#include <mutex>
+#include <ostream>
+#include <functional>
+#include <cstdint>
+#include <cstring>
+#include "utils/sequenced_executor.h"
+
+namespace netcoredbg
+{
+
+// Helpers for entries binary format, all values are stored in host byte order (cache is not shared between hosts).
+namespace DiskCacheFormat
+{
+    // Read from entry data, `ptr` is advanced by `size` bytes.
+    inline bool ReadData(const char *&ptr, const char *end, void *data, size_t size)
+    {
+        if (size_t(end - ptr) < size)
+            return false;
+
+        memcpy(data, ptr, size);
+        ptr += size;
+        return true;
+    }
+
+    template <class T>
+    bool ReadValue(const char *&ptr, const char *end, T &value)
+    {
+        return ReadData(ptr, end, &value, sizeof(T));
+    }
+
+    inline bool ReadString(const char *&ptr, const char *end, std::string &str)
+    {
+        uint32_t length = 0;
+        if (!ReadValue(ptr, end, length) || length > size_t(end - ptr))
+            return false;
+
+        str.assign(ptr, length);
+        ptr += length;
+        return true;
+    }
+
+    template <class T>
+    void WriteValue(std::ostream &out, const T &value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    inline void WriteString(std::ostream &out, const std::string &str)
+    {
+        WriteValue(out, (uint32_t)str.size());
+        out.write(str.data(), str.size());
+    }
+} // namespace DiskCacheFormat
+
+// Directory with entries and index, shared by on-disk caches (methods ranges, resolved breakpoints, module snapshots).
+// Cache directory could be shared by few debugger instances of same user, so, all files are written into unique temporary
+// file first and renamed after, other instances never see partially written file. Published entry never changed in place
+// (only replaced by rename or removed), so, it could be read without any locks.
+// Index keep entries in order of addition (oldest first), oldest entries are evicted in case size or entries limit reached.
+class DiskCache
+{
+public:
+
+    // Note, all strings must be string literals (or have static storage duration), `name` is used in log messages.
+    DiskCache(const char *name, const char *dirName, const char *entryExt, const char *writerName, uint64_t maxSize, size_t maxEntries);
+
+    // Empty `dir` - per-user directory in temp directory, maxSize equal to 0 disable cache.
+    void SetOptions(bool enable, const std::string &dir, uint64_t maxSize);
+    bool IsEnabled();
+
+    // Return `false` in case cache is disabled, otherwise provide path to entry file (file could not exist).
+    bool Lookup(const std::string &key, std::string &entryPath);
+    // Write entry with `size` bytes by `write` and publish it, entry over size limit is not stored.
+    // Note, `write` is called without cache lock held.
+    void Store(const std::string &key, uint64_t size, const std::function<void(std::ostream &out)> &write);
+    void Remove(const std::string &key);
+    // Note, all entries are written by one thread in Post() calls order, queued entries are written at exit.
+    void Post(SequencedExecutor::Task &&task);
+
+private:
+
+    struct entry_t
+    {
+        std::string key;
+        uint64_t size;
+    };
+
+    const char *m_name;
+    const char *m_dirName;
+    const char *m_entryExt;
+    const size_t m_maxEntries;
+
+    std::mutex m_mutex;
+    bool m_enabled;
+    bool m_indexLoaded;
+    std::string m_dir;
+    bool m_defaultDir; // per-user directory in temp directory is used
+    uint64_t m_maxSize;
+    uint64_t m_totalSize;
+    std::list<entry_t> m_index;
+    // Note, must be declared last, since queued tasks are executed at destruction and use all other members.
+    SequencedExecutor m_writer;
+
+    std::string GetDir();
+    std::string GetEntryPath(const std::string &key);
+    void LoadIndex();
+    void ReadIndexFile(std::list<entry_t> &index);
+    // Note, `removedKey` is removed from index, even if other instance published it.
+    void SaveIndex(const std::string &removedKey = std::string());
+    void RemoveFromIndex(const std::string &key);
+    void Evict(uint64_t requiredSize, size_t requiredEntries);
+};
+
+} // namespace netcoredbg
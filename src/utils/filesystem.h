@@ -45,6 +45,19 @@ namespace netcoredbg
     /// Function changes current working directory. Return value is `false` in case of error.
     bool SetWorkDir(const std::string &path);
 
+    /// Function creates directory (only last path component), return value is `false` in case of error.
+    /// Note, already existing directory is not an error.
+    bool CreateDir(const std::string &path);
+
+    /// Function creates directory (only last path component) accessible by current user only, return value
+    /// is `false` in case of error. Note, already existing directory is accepted only in case it is not
+    /// a symlink, owned by current user and not accessible by other users.
+    bool CreatePrivateDir(const std::string &path);
+
+    /// Function returns path to per-user directory with `name` in temporary directory (see GetTempDir()),
+    /// intended for debugger's caches. Note, directory is not created, use CreatePrivateDir() for this.
+    std::string GetUserTempDir(const char *name);
+
     /// Function returns path to directory, which should be used for creation of
     /// temporary files. Typically this is `/tmp` on Unix and something like
     /// `C:\Users\localuser\Appdata\Local\Temp` on Windows.
@@ -10,6 +10,8 @@
 #endif
 #include <stdlib.h>
 #include <unistd.h>
+#include <errno.h>
+#include <sys/stat.h>
 #include <array>
 #include <string>
 #include "utils/filesystem.h"
@@ -85,5 +87,35 @@ bool SetWorkDir(const std::string &path)
     return chdir(path.c_str()) == 0;
 }
 
+// Function creates directory (only last path component), return value is `false` in case of error.
+bool CreateDir(const std::string &path)
+{
+    return mkdir(path.c_str(), 0700) == 0 || errno == EEXIST;
+}
+
+// Function creates directory (only last path component) accessible by current user only, return value is `false` in case of error.
+bool CreatePrivateDir(const std::string &path)
+{
+    if (mkdir(path.c_str(), 0700) != 0 && errno != EEXIST)
+        return false;
+
+    // Note, directory could be created by other user (or replaced by symlink) before us, since temp directory is shared.
+    struct stat st;
+    return lstat(path.c_str(), &st) == 0 &&
+           S_ISDIR(st.st_mode) &&
+           st.st_uid == getuid() &&
+           (st.st_mode & 0777) == 0700;
+}
+
+// Function returns path to per-user directory with `name` in temporary directory.
+std::string GetUserTempDir(const char *name)
+{
+    string_view tempDir = GetTempDir();
+    std::string result(tempDir.begin(), tempDir.end());
+    if (!result.empty() && result.back() != FileSystem::PathSeparator)
+        result += FileSystem::PathSeparator;
+    return result + name + "-" + std::to_string(getuid());
+}
+
 }  // ::netcoredbg
 #endif __unix__
@@ -7,6 +7,7 @@
 #ifdef WIN32
 #include <windows.h>
 #include <string>
+#include <string.h>
 #include "utils/filesystem.h"
 #include "utils/limits.h"
 
@@ -48,5 +49,37 @@ bool SetWorkDir(const std::string &path)
     return SetCurrentDirectoryA(path.c_str());
 }
 
+// Function creates directory (only last path component), return value is `false` in case of error.
+bool CreateDir(const std::string &path)
+{
+    if (path.size() >= MAX_PATH)
+        return false;
+
+    return CreateDirectoryA(path.c_str(), NULL) || GetLastError() == ERROR_ALREADY_EXISTS;
+}
+
+// Function creates directory (only last path component) accessible by current user only, return value is `false` in case of error.
+bool CreatePrivateDir(const std::string &path)
+{
+    if (!CreateDir(path))
+        return false;
+
+    // Note, temp directory is per-user on Windows, only care about junctions/symlinks here.
+    DWORD attributes = GetFileAttributesA(path.c_str());
+    return attributes != INVALID_FILE_ATTRIBUTES &&
+           (attributes & FILE_ATTRIBUTE_DIRECTORY) &&
+           !(attributes & FILE_ATTRIBUTE_REPARSE_POINT);
+}
+
+// Function returns path to per-user directory with `name` in temporary directory.
+std::string GetUserTempDir(const char *name)
+{
+    string_view tempDir = GetTempDir();
+    std::string result(tempDir.begin(), tempDir.end());
+    if (!result.empty() && !strchr(FileSystem::PathSeparatorSymbols, result.back()))
+        result += FileSystem::PathSeparator;
+    return result + name;
+}
+
 }  // ::netcoredbg
 #endif
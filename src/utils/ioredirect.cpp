@@ -11,6 +11,7 @@
 #include "interfaces/idebugger.h"
 #include "utils/logger.h"
 #include "utils/rwlock.h"
+#include "utils/tracerecorder.h"
 
 namespace netcoredbg
 {
@@ -24,6 +25,9 @@ namespace
     // timeout for select() call
     std::chrono::milliseconds WaitForever{INT_MAX / 1000};
 
+    // max size of data forwarded directly from child process stdout/stderr by one request
+    const size_t SpliceSize = 64 * 1024;
+
     char *get_streams_pptr(std::tuple<OutStream, InStream, InStream> &m_streams)
     {
         auto *out = dynamic_cast<OutStreamBuf*>(std::get<IOSystem::Stdin>(m_streams).rdbuf());
@@ -61,6 +65,8 @@ IORedirectHelper::IORedirectHelper(
   m_input_pipe(IOSystem::unnamed_pipe()),
   m_cancel(),
   m_finish(),
+  m_passthrough_file(),
+  m_passthrough(false),
   m_thread{&IORedirectHelper::worker, this}
 {
     assert(std::get<IOSystem::Stdin>(pipes).first);
@@ -104,6 +110,13 @@ void IORedirectHelper::wake_reader()
     IOSystem::write(m_input_pipe.second, "", 1);
 }
 
+void IORedirectHelper::set_passthrough(IOSystem::FileHandle out)
+{
+    // Note, worker thread start forwarding with next read request.
+    m_passthrough_file = out;
+    m_passthrough.store(true, std::memory_order_release);
+}
+
 
 // Output buffer management:
 // ----------SSSSSSSSSSS++++++++++----------
@@ -142,6 +155,9 @@ void IORedirectHelper::worker()
 
     // currently existing asyncchronous io requests
     IOSystem::AsyncHandle async_handles[Utility::Size(stream_types) + 1];
+    // read requests, which forward data directly to m_passthrough_file
+    bool spliced[Utility::Size(stream_types)] = {};
+    bool passthrough_failed = false;
     auto& out_handle = async_handles[0];
     auto& pipe_handle = async_handles[Utility::Size(stream_types)];
 
@@ -162,6 +178,7 @@ void IORedirectHelper::worker()
     assert(pipe_handle);
 
     LOGI("%s started", __func__);
+    TraceRecorder::SetThreadName("IORedirect");
 
     std::unique_lock<Utility::RWLock::Reader> read_lock(m_rwlock.reader, std::defer_lock_t{});
 
@@ -184,11 +201,20 @@ void IORedirectHelper::worker()
             if (avail)
             {
                 LOGD("push %u bytes to callback", int(avail));
+                TraceRecorder::ScopedEvent traceEvent("io", "DebuggeeOutput");
                 m_callback(stream_types[n], span<char>(stream->gptr(), avail));
                 stream->gbump(int(avail));
                 stream->compactify();
             }
 
+            // request to forward data directly, if no transformation required
+            if (!async_handles[n] && !passthrough_failed && m_passthrough.load(std::memory_order_acquire))
+            {
+                async_handles[n] = IOSystem::async_splice(stream->get_file_handle(), m_passthrough_file, SpliceSize);
+                spliced[n] = !!async_handles[n];
+                passthrough_failed = !spliced[n];
+            }
+
             // request to read more data
             if (!async_handles[n])
             {
@@ -226,8 +252,15 @@ void IORedirectHelper::worker()
             return;
 
         // process finished read requests
-        if (!ProcessFinishedReadRequests(in_streams, Utility::Size(stream_types), async_handles))
+        if (!ProcessFinishedReadRequests(in_streams, Utility::Size(stream_types), async_handles, spliced))
             return;
+
+        // kind of next request (forwarding or reading into buffer) will be chosen again
+        for (unsigned n = 0; n < Utility::Size(stream_types); n++)
+        {
+            if (spliced[n] && !async_handles[n])
+                spliced[n] = false;
+        }
     }
 }
 
@@ -318,7 +351,7 @@ bool IORedirectHelper::ProcessFinishedWriteRequests(std::unique_lock<Utility::RW
     return true;
 }
 
-bool IORedirectHelper::ProcessFinishedReadRequests(InStreamBuf* const in_streams[], size_t stream_types_cout, IOSystem::AsyncHandle async_handles[])
+bool IORedirectHelper::ProcessFinishedReadRequests(InStreamBuf* const in_streams[], size_t stream_types_cout, IOSystem::AsyncHandle async_handles[], bool spliced[])
 {
     for (size_t n = 0; n < stream_types_cout; n++)
     {
@@ -327,6 +360,23 @@ bool IORedirectHelper::ProcessFinishedReadRequests(InStreamBuf* const in_streams
             continue;
 
         IOSystem::IOResult result = IOSystem::async_result(async_handles[n]);
+        if (spliced[n])
+        {
+            if (result.status == IOSystem::IOResult::Success)
+            {
+                LOGD("forwarded %u bytes", int(result.size));
+                async_handles[n] = {};  // can issue next request
+                continue;
+            }
+            else if (result.status == IOSystem::IOResult::Error)
+            {
+                LOGW("can't forward child process output directly, fall back to buffered output");
+                m_passthrough.store(false, std::memory_order_relaxed);
+                async_handles[n] = {};
+                continue;
+            }
+        }
+
         if (result.status == IOSystem::IOResult::Success)
         {
             // update buffer
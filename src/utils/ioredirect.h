@@ -67,6 +67,12 @@ public:
     /// or thread which will call `async_input` next time.
     void async_cancel();
 
+    /// This function allows to forward data written to stdout/stderr directly to file `out`,
+    /// without copying to user space buffers (if platform supports this), callback functor
+    /// isn't called for such data. Should be called before the program start, in case
+    /// forwarding isn't possible, data is passed to callback functor as usual.
+    void set_passthrough(IOSystem::FileHandle out);
+
     /// This function allows to execute some another function `func` with substituted
     /// standard input/output files. Typically function `func` should start some external
     /// process, which inherits stdin/stdout/stderr files which is substituted during
@@ -100,7 +106,7 @@ private:
     void worker();    // worker thread function
     void StartNewWriteRequests(std::unique_lock<Utility::RWLock::Reader> &read_lock, OutStreamBuf* const out_stream, IOSystem::AsyncHandle &out_handle);
     bool ProcessFinishedWriteRequests(std::unique_lock<Utility::RWLock::Reader> &read_lock, OutStreamBuf* const out_stream, IOSystem::AsyncHandle &out_handle);
-    bool ProcessFinishedReadRequests(InStreamBuf* const in_streams[], size_t stream_types_cout, IOSystem::AsyncHandle async_handles[]);
+    bool ProcessFinishedReadRequests(InStreamBuf* const in_streams[], size_t stream_types_cout, IOSystem::AsyncHandle async_handles[], bool spliced[]);
 
     // remote side of the pipes
     const std::tuple<IOSystem::FileHandle, IOSystem::FileHandle, IOSystem::FileHandle> m_pipes;
@@ -127,6 +133,9 @@ private:
     std::atomic<bool> m_cancel;  // atomic flag which prevents multiple calls to async_cancel()
     volatile bool     m_finish;  // exit request for worker thread
 
+    IOSystem::FileHandle m_passthrough_file;  // file for direct forwarding of stdout/stderr data
+    std::atomic<bool>    m_passthrough;       // m_passthrough_file is set
+
     std::thread   m_thread;     // worker threead (which monitors received data)
 };
 
@@ -9,6 +9,7 @@
 #include <utility>
 #include <type_traits>
 #include <chrono>
+#include <string>
 
 #include "utils/platform.h"
 
@@ -36,6 +37,13 @@ template <typename Traits> struct IOSystemImpl
         size_t size;    /// amount of written/read data in bytes
     };
 
+    /// Structure describes one fragment of data for gather write operation (see `writev`).
+    struct WriteBuffer
+    {
+        const void *buf;    /// pointer to the data
+        size_t count;       /// size of the data in bytes
+    };
+
 
     /// Handle of asynchronous operation, for which result can be requested via call to
     /// `async_result` or operation can be canceled via call to `async_cancel`. This
@@ -147,12 +155,36 @@ template <typename Traits> struct IOSystemImpl
     /// In case of error, empty file handle will be returned.
     static FileHandle listen_socket(unsigned tcp_port) { return Traits::listen_socket(tcp_port); }
 
+    /// Function creates TCP socket listening for connections on given port, connections
+    /// should be accepted by `accept_socket` function. In case of error, empty file handle
+    /// will be returned.
+    static FileHandle server_socket(unsigned tcp_port) { return Traits::server_socket(tcp_port); }
+
+    /// Function creates Unix domain socket listening for connections on given path (stale socket
+    /// file is removed), connections should be accepted by `accept_socket` function. In case of
+    /// error, empty file handle will be returned.
+    static FileHandle server_unix_socket(const std::string &path) { return Traits::server_unix_socket(path); }
+
+    /// Function waits and accepts single connection on socket created by `server_socket`
+    /// or `server_unix_socket` function, and return file handle related to the accepted connection.
+    /// In case of error, empty file handle will be returned.
+    static FileHandle accept_socket(FileHandle server) { return Traits::accept_socket(server.handle); }
+
+    /// Function disables Nagle's algorithm for TCP connection (ignored for Unix domain socket) and
+    /// set socket send and receive buffers size in bytes (0 - system default).
+    static IOResult tune_socket(FileHandle fh, size_t buffer_size) { return Traits::tune_socket(fh.handle, buffer_size); }
+
     /// Function perform reading from the file: it may read up to `count' bytes to `buf'.
     static IOResult read(FileHandle fh, void *buf, size_t count) { return Traits::read(fh.handle, buf, count); }
 
     /// Function perform writing to the file: it may write up to `count' byte from `buf'.
     static IOResult write(FileHandle fh, const void *buf, size_t count) { return Traits::write(fh.handle, buf, count); }
 
+    /// Function perform gather writing to the file: it may write up to sum of `count` bytes
+    /// of all `nbufs` buffers, fragments are written sequentially one after another (as single
+    /// write operation, if platform allows this). Result size is total amount of written bytes.
+    static IOResult writev(FileHandle fh, const WriteBuffer *bufs, size_t nbufs) { return Traits::writev(fh.handle, bufs, nbufs); }
+
     /// Enable or disable handle inheritance for child processes.
     static IOResult set_inherit(FileHandle fh, bool inherit_handle) { return Traits::set_inherit(fh.handle, inherit_handle); }
     
@@ -168,6 +200,12 @@ template <typename Traits> struct IOSystemImpl
     /// operation must be canceled via call to `async_cancel`.
     static AsyncHandle async_write(FileHandle fh, const void *buf, size_t count) { return {Traits::async_write(fh.handle, buf, count)}; }
 
+    /// Start asynchronous transfer of up to `count` bytes from file handle `in` (must be a pipe)
+    /// directly to file handle `out`, without copying data to user space buffer. Function returns
+    /// empty `AsyncHandle` value in case such transfer isn't supported for the platform. Note,
+    /// result is `Error` in case transfer isn't supported for particular files (no data transferred).
+    static AsyncHandle async_splice(FileHandle in, FileHandle out, size_t count) { return {Traits::async_splice(in.handle, out.handle, count)}; }
+
     /// This function allows to wait until one of the specified asynchronous operations
     /// is finished, or until timeout expired. Function returns `true` if at least one
     /// asynchronous operation is finished.
@@ -16,7 +16,16 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <climits>
+#include <atomic>
+#include <vector>
+#endif
 #include <stdexcept>
 #include <algorithm>
 
@@ -26,8 +35,199 @@ namespace
 {
     // short alias for full class name
     typedef netcoredbg::IOSystemTraits<netcoredbg::UnixPlatformTag> Class;
-    
-    
+
+
+    void throw_error(const char *func)
+    {
+        // TODO make exception class
+        char msg[256];
+        snprintf(msg, sizeof(msg), "%s: %s", func, strerror(errno));
+        throw std::runtime_error(msg);
+    }
+
+#ifdef __linux__
+    // Incremented each time any file is closed or replaced, since epoll registration could be silently dropped
+    // in this case and descriptor could be reused for other file.
+    std::atomic<unsigned> files_generation(0);
+
+    void files_changed()
+    {
+        files_generation.fetch_add(1, std::memory_order_release);
+    }
+
+    // Epoll based waiting for async operations. Note, epoll instance is created for each thread, which waits
+    // for async operations, and registered descriptors are changed only in case awaited set is changed, so,
+    // usually waiting costs single epoll_wait() call. Async operations use readiness from the last wait
+    // instead of additional select() call for each operation.
+    class EpollWaiter
+    {
+        struct waited_t
+        {
+            int fd;
+            uint32_t events;
+            uint32_t ready;
+        };
+
+        int m_epfd;
+        unsigned m_generation;
+        std::vector<std::pair<int, uint32_t>> m_registered;
+        // Descriptors of the last wait.
+        std::vector<waited_t> m_waited;
+
+        EpollWaiter() : m_epfd(-1), m_generation(0) {}
+
+    public:
+
+        ~EpollWaiter()
+        {
+            if (m_epfd != -1)
+                ::close(m_epfd);
+        }
+
+        static EpollWaiter &instance()
+        {
+            static thread_local EpollWaiter waiter;
+            return waiter;
+        }
+
+        bool wait(Class::IOSystem::AsyncHandleIterator begin, Class::IOSystem::AsyncHandleIterator end, std::chrono::milliseconds timeout)
+        {
+            // Note, registered descriptors can't be checked, so, all descriptors are registered again after any file close.
+            unsigned generation = files_generation.load(std::memory_order_acquire);
+            if (m_epfd != -1 && generation != m_generation)
+            {
+                ::close(m_epfd);
+                m_epfd = -1;
+                m_registered.clear();
+            }
+            m_generation = generation;
+
+            if (m_epfd == -1 && (m_epfd = epoll_create1(EPOLL_CLOEXEC)) == -1)
+                throw_error("epoll_create1");
+
+            m_waited.clear();
+            for (Class::IOSystem::AsyncHandleIterator it = begin; it != end; ++it)
+            {
+                if (!*it)
+                    continue;
+
+                uint32_t events;
+                int fd = it->handle.epoll(&events);
+                auto find = std::find_if(m_waited.begin(), m_waited.end(), [&](const waited_t &w) { return w.fd == fd; });
+                if (find != m_waited.end())
+                    find->events |= events;
+                else
+                    m_waited.push_back({fd, events, 0});
+            }
+
+            // Note, descriptors that are not awaited anymore must be removed, since level-triggered readiness
+            // of such descriptors (for example, pipe that is always ready for write) will wake us up.
+            for (auto it = m_registered.begin(); it != m_registered.end(); )
+            {
+                if (std::find_if(m_waited.begin(), m_waited.end(), [&](const waited_t &w) { return w.fd == it->first; }) != m_waited.end())
+                {
+                    ++it;
+                    continue;
+                }
+
+                epoll_ctl(m_epfd, EPOLL_CTL_DEL, it->first, nullptr);
+                it = m_registered.erase(it);
+            }
+
+            bool alwaysReady = false;
+            for (auto &w : m_waited)
+            {
+                auto reg = std::find_if(m_registered.begin(), m_registered.end(), [&](const std::pair<int, uint32_t> &r) { return r.first == w.fd; });
+                if (reg != m_registered.end() && reg->second == w.events)
+                    continue;
+
+                struct epoll_event ev;
+                memset(&ev, 0, sizeof(ev));
+                ev.events = w.events;
+                ev.data.fd = w.fd;
+
+                if (reg != m_registered.end())
+                {
+                    // Note, descriptor could be closed and reused, in this case epoll already dropped it.
+                    if (epoll_ctl(m_epfd, EPOLL_CTL_MOD, w.fd, &ev) == 0 ||
+                        (errno == ENOENT && epoll_ctl(m_epfd, EPOLL_CTL_ADD, w.fd, &ev) == 0))
+                    {
+                        reg->second = w.events;
+                        continue;
+                    }
+                    m_registered.erase(reg);
+                }
+                else if (epoll_ctl(m_epfd, EPOLL_CTL_ADD, w.fd, &ev) == 0)
+                {
+                    m_registered.emplace_back(w.fd, w.events);
+                    continue;
+                }
+
+                // Regular files are not supported by epoll, but always ready (same as for select()).
+                if (errno != EPERM)
+                    throw_error("epoll_ctl");
+
+                w.ready = w.events;
+                alwaysReady = true;
+            }
+
+            int timeoutMs = alwaysReady ? 0 : (int)std::max<std::chrono::milliseconds::rep>(0, std::min<std::chrono::milliseconds::rep>(timeout.count(), INT_MAX));
+
+            static const int MaxEvents = 8;
+            struct epoll_event events[MaxEvents];
+            int result;
+            do result = epoll_wait(m_epfd, events, MaxEvents, timeoutMs);
+            while (result < 0 && errno == EINTR);
+
+            if (result < 0)
+                throw_error("epoll_wait");
+
+            for (int i = 0; i < result; i++)
+            {
+                for (auto &w : m_waited)
+                {
+                    if (w.fd == events[i].data.fd)
+                        w.ready |= events[i].events;
+                }
+            }
+
+            return result > 0 || alwaysReady;
+        }
+
+        // Function check readiness of descriptor from the last wait, readiness for `events` is consumed (next check
+        // return `false` until next wait). Return value is `false` in case descriptor was not awaited by last wait.
+        bool check_ready(int fd, uint32_t events, bool &ready)
+        {
+            for (auto &w : m_waited)
+            {
+                if (w.fd != fd || (w.events & events) == 0)
+                    continue;
+
+                ready = (w.ready & (events | EPOLLERR | EPOLLHUP)) != 0;
+                w.ready &= ~events;
+                return true;
+            }
+            return false;
+        }
+    };
+#endif // __linux__
+
+    // Function checks (without waiting) if file descriptor is ready for reading or writing,
+    // return value is positive if ready, zero if not ready and negative in case of error.
+    ssize_t check_ready(int fd, bool write)
+    {
+#ifdef __linux__
+        bool ready;
+        if (EpollWaiter::instance().check_ready(fd, write ? EPOLLOUT : EPOLLIN, ready))
+            return ready ? 1 : 0;
+#endif
+        fd_set set;
+        FD_ZERO(&set);
+        FD_SET(fd, &set);
+        struct timeval tv = {0, 0};
+        return write ? ::select(fd + 1, NULL, &set, NULL, &tv) : ::select(fd + 1, &set, NULL, &set, &tv);
+    }
+
     struct AsyncRead
     {
         int    fd;
@@ -38,12 +238,7 @@ namespace
 
         Class::IOResult operator()()
         {
-            // TODO need to optimize code to left only one syscall.
-            fd_set set;
-            FD_ZERO(&set);
-            FD_SET(fd, &set);
-            struct timeval tv = {0, 0};
-            ssize_t result = ::select(fd + 1, &set, NULL, &set, &tv);
+            ssize_t result = check_ready(fd, false);
             if (result == 0)
                 return {Class::IOResult::Pending, 0};
 
@@ -55,10 +250,7 @@ namespace
                 if (errno == EAGAIN)
                     return {Class::IOResult::Pending, 0};
 
-                // TODO make exception class
-                char msg[256];
-                snprintf(msg, sizeof(msg), "select: %s", strerror(errno));
-                throw std::runtime_error(msg);
+                throw_error("select");
             }
 
             return {result == 0 ? Class::IOResult::Eof : Class::IOResult::Success, size_t(result)};
@@ -70,6 +262,14 @@ namespace
             FD_SET(fd, except);
             return fd;
         }
+
+#ifdef __linux__
+        int epoll(uint32_t *events) const
+        {
+            *events = EPOLLIN;
+            return fd;
+        }
+#endif
     };
 
     struct AsyncWrite
@@ -82,11 +282,7 @@ namespace
 
         Class::IOResult operator()()
         {
-            fd_set set;
-            FD_ZERO(&set);
-            FD_SET(fd, &set);
-            struct timeval tv = {0, 0};
-            ssize_t result = select(fd + 1, NULL, &set, NULL, &tv);
+            ssize_t result = check_ready(fd, true);
             if (result == 0)
                 return {Class::IOResult::Pending, 0};
 
@@ -98,9 +294,7 @@ namespace
                 if (errno == EAGAIN)
                     return {Class::IOResult::Pending, 0};
 
-                char msg[256];
-                snprintf(msg, sizeof(msg), "select: %s", strerror(errno));
-                throw std::runtime_error(msg);
+                throw_error("select");
             }
 
             return {Class::IOResult::Success, size_t(result)};
@@ -112,7 +306,61 @@ namespace
             FD_SET(fd, write);
             return fd;
         }
+
+#ifdef __linux__
+        int epoll(uint32_t *events) const
+        {
+            *events = EPOLLOUT;
+            return fd;
+        }
+#endif
     };
+
+#ifdef __linux__
+    struct AsyncSplice
+    {
+        int    in_fd;
+        int    out_fd;
+        size_t size;
+
+        AsyncSplice(int in_fd, int out_fd, size_t size) : in_fd(in_fd), out_fd(out_fd), size(size) {}
+
+        Class::IOResult operator()()
+        {
+            ssize_t result = check_ready(in_fd, false);
+            if (result == 0)
+                return {Class::IOResult::Pending, 0};
+
+            // Note, input pipe have data, so, splice() could block only on output (same as write() to this file).
+            if (result >= 0)
+                result = ::splice(in_fd, NULL, out_fd, NULL, size, SPLICE_F_MOVE);
+
+            if (result < 0)
+            {
+                if (errno == EAGAIN)
+                    return {Class::IOResult::Pending, 0};
+
+                // Note, output file could not support splice (for example, tty on recent kernels).
+                return {Class::IOResult::Error, 0};
+            }
+
+            return {result == 0 ? Class::IOResult::Eof : Class::IOResult::Success, size_t(result)};
+        }
+
+        int poll(fd_set* read, fd_set *, fd_set* except) const
+        {
+            FD_SET(in_fd, read);
+            FD_SET(in_fd, except);
+            return in_fd;
+        }
+
+        int epoll(uint32_t *events) const
+        {
+            *events = EPOLLIN;
+            return in_fd;
+        }
+    };
+#endif // __linux__
 }
 
 
@@ -124,6 +372,11 @@ template <typename T> Class::AsyncHandle::Traits  Class::AsyncHandle::TraitsImpl
     [](void *thiz, fd_set* read, fd_set* write, fd_set* except)
         -> int { return reinterpret_cast<T*>(thiz)->poll(read, write, except); },
 
+#ifdef __linux__
+    [](void *thiz, uint32_t *events)
+        -> int { return reinterpret_cast<T*>(thiz)->epoll(events); },
+#endif
+
     [](void *src, void *dst)
         -> void { *reinterpret_cast<T*>(dst) = *reinterpret_cast<T*>(src); },
 
@@ -150,16 +403,13 @@ std::pair<Class::FileHandle, Class::FileHandle> Class::unnamed_pipe()
 }
 
 
-// Function creates listening TCP socket on given port, waits, accepts single
-// connection, and return file descriptor related to the accepted connection.
+// Function creates TCP socket listening for connections on given port.
 // In case of error, empty file handle will be returned.
-Class::FileHandle Class::listen_socket(unsigned port)
+Class::FileHandle Class::server_socket(unsigned port)
 {
     assert(port > 0 && port < 65536);
 
-    int newsockfd;
-    socklen_t clilen;
-    struct sockaddr_in serv_addr, cli_addr;
+    struct sockaddr_in serv_addr;
 
     int sockFd = ::socket(AF_INET, SOCK_STREAM, 0);
     if (sockFd < 0)
@@ -188,7 +438,8 @@ Class::FileHandle Class::listen_socket(unsigned port)
         return {};
     }
 
-    ::listen(sockFd, 1);
+    // Note, in multi-session mode next clients could connect while current session is running.
+    ::listen(sockFd, SOMAXCONN);
 
 #ifdef DEBUGGER_FOR_TIZEN
     // On Tizen, launch_app won't terminate until stdin, stdout and stderr are closed.
@@ -218,9 +469,61 @@ Class::FileHandle Class::listen_socket(unsigned port)
     //TODO on Tizen redirect stderr/stdout output into dlog
 #endif
 
-    clilen = sizeof(cli_addr);
-    newsockfd = ::accept(sockFd, (struct sockaddr *) &cli_addr, &clilen);
-    ::close(sockFd);
+    return sockFd;
+}
+
+// Function creates Unix domain socket listening for connections on given path.
+// In case of error, empty file handle will be returned.
+Class::FileHandle Class::server_unix_socket(const std::string &path)
+{
+    struct sockaddr_un serv_addr;
+    if (path.empty() || path.size() >= sizeof(serv_addr.sun_path))
+    {
+        fprintf(stderr, "wrong unix socket path length\n");
+        return {};
+    }
+
+    int sockFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sockFd < 0)
+    {
+        perror("can't create socket");
+        return {};
+    }
+
+    memset(&serv_addr, 0, sizeof(serv_addr));
+    serv_addr.sun_family = AF_UNIX;
+    memcpy(serv_addr.sun_path, path.c_str(), path.size());
+
+    // Note, socket file is not removed at close, so, it could be left by previous debugger run.
+    ::unlink(path.c_str());
+
+    if (::bind(sockFd, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0)
+    {
+        ::close(sockFd);
+        perror("can't bind to specified unix socket path");
+        return {};
+    }
+
+    // Note, in multi-session mode next clients could connect while current session is running.
+    ::listen(sockFd, SOMAXCONN);
+
+    return sockFd;
+}
+
+// Function waits and accepts single connection on listening socket, and return
+// file descriptor related to the accepted connection.
+// In case of error, empty file handle will be returned.
+Class::FileHandle Class::accept_socket(const FileHandle &server)
+{
+    struct sockaddr_storage cli_addr;
+    socklen_t clilen = sizeof(cli_addr);
+    int newsockfd;
+    do
+    {
+        newsockfd = ::accept(server.fd, (struct sockaddr *) &cli_addr, &clilen);
+    }
+    while (newsockfd < 0 && errno == EINTR);
+
     if (newsockfd < 0)
     {
         perror("accept");
@@ -230,6 +533,39 @@ Class::FileHandle Class::listen_socket(unsigned port)
     return newsockfd;
 }
 
+// Function creates listening TCP socket on given port, waits, accepts single
+// connection, and return file descriptor related to the accepted connection.
+// In case of error, empty file handle will be returned.
+Class::FileHandle Class::listen_socket(unsigned port)
+{
+    FileHandle server = server_socket(port);
+    if (!server)
+        return {};
+
+    FileHandle result = accept_socket(server);
+    ::close(server.fd);
+    return result;
+}
+
+// Note, protocol messages are small and each message is written by one call (see OutStreamBuf), so, Nagle's algorithm
+// only delays responses and events till peer's delayed ACK.
+Class::IOResult Class::tune_socket(const FileHandle &fh, size_t buffer_size)
+{
+    // Note, fails for Unix domain socket, that don't have Nagle's algorithm.
+    int enable = 1;
+    ::setsockopt(fh.fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+    if (buffer_size != 0)
+    {
+        int size = int(std::min(buffer_size, size_t(INT_MAX)));
+        if (::setsockopt(fh.fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size)) < 0 ||
+            ::setsockopt(fh.fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size)) < 0)
+            return {IOResult::Error, 0};
+    }
+
+    return {IOResult::Success, 0};
+}
+
 // Enable/disable handle inheritance for child processes.
 Class::IOResult Class::set_inherit(const FileHandle &fh, bool inherit)
 {
@@ -269,6 +605,26 @@ Class::IOResult Class::write(const FileHandle &fh, const void *buf, size_t count
         return { IOResult::Success, size_t(wsize) };
 }
 
+Class::IOResult Class::writev(const FileHandle &fh, const IOSystem::WriteBuffer *bufs, size_t nbufs)
+{
+    // Note, typically only few fragments are written (message header and body), so iovec
+    // array is allocated on stack, remaining fragments will be written by next call.
+    const size_t MaxFragments = 16;
+    struct iovec iov[MaxFragments];
+    int iovcnt = int(std::min(nbufs, MaxFragments));
+    for (int n = 0; n < iovcnt; n++)
+    {
+        iov[n].iov_base = const_cast<void*>(bufs[n].buf);
+        iov[n].iov_len = bufs[n].count;
+    }
+
+    ssize_t wsize = ::writev(fh.fd, iov, iovcnt);
+    if (wsize < 0)
+        return { (errno == EAGAIN ? IOResult::Pending : IOResult::Error), 0 };
+    else
+        return { IOResult::Success, size_t(wsize) };
+}
+
 
 Class::AsyncHandle Class::async_read(const FileHandle& fh, void *buf, size_t count)
 {
@@ -280,9 +636,22 @@ Class::AsyncHandle Class::async_write(const FileHandle& fh, const void *buf, siz
     return fh.fd == -1 ? AsyncHandle() : AsyncHandle::create<AsyncWrite>(fh.fd, buf, count);
 }
 
+Class::AsyncHandle Class::async_splice(const FileHandle& in, const FileHandle& out, size_t count)
+{
+#ifdef __linux__
+    return (in.fd == -1 || out.fd == -1) ? AsyncHandle() : AsyncHandle::create<AsyncSplice>(in.fd, out.fd, count);
+#else
+    (void)in, (void)out, (void)count;
+    return AsyncHandle(); // not supported
+#endif
+}
+
 
 bool Class::async_wait(IOSystem::AsyncHandleIterator begin, IOSystem::AsyncHandleIterator end, std::chrono::milliseconds timeout)
 {
+#ifdef __linux__
+    return EpollWaiter::instance().wait(begin, end, timeout);
+#else
     fd_set read_set, write_set, except_set;
     FD_ZERO(&read_set);
     FD_ZERO(&write_set);
@@ -304,13 +673,10 @@ bool Class::async_wait(IOSystem::AsyncHandleIterator begin, IOSystem::AsyncHandl
     while (result < 0 && errno == EINTR);
 
     if (result < 0)
-    {
-        char msg[256];
-        snprintf(msg, sizeof(msg), "select: %s", strerror(errno));
-        throw std::runtime_error(msg);
-    }
+        throw_error("select");
 
     return result > 0;
+#endif
 }
 
 Class::IOResult Class::async_cancel(Class::AsyncHandle& handle)
@@ -338,7 +704,11 @@ Class::IOResult Class::async_result(Class::AsyncHandle& handle)
 // Function closes the file represented by file handle.
 Class::IOResult Class::close(const FileHandle &fh)
 {
-    return { (::close(fh.fd) == 0 ? IOResult::Success : IOResult::Error), 0 };
+    IOResult result = { (::close(fh.fd) == 0 ? IOResult::Success : IOResult::Error), 0 };
+#ifdef __linux__
+    files_changed();
+#endif
+    return result;
 }
 
 
@@ -381,6 +751,9 @@ Class::StdIOSwap::StdIOSwap(const StdFiles& files) : m_valid(true)
             throw std::runtime_error(msg);
         }
     }
+#ifdef __linux__
+    files_changed();
+#endif
 }
 
 
@@ -400,6 +773,9 @@ Class::StdIOSwap::~StdIOSwap()
         
         ::close(m_orig_fd[n]);
     }
+#ifdef __linux__
+    files_changed();
+#endif
 }
 
 #endif  // __unix__
@@ -6,6 +6,7 @@
 #if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
 #pragma once
 #include <cstdlib>
+#include <cstdint>
 #include <cassert>
 #include <sys/select.h>
 #include <tuple>
@@ -34,6 +35,10 @@ template <> struct netcoredbg::IOSystemTraits<netcoredbg::UnixPlatformTag>
         {
             IOResult (*oper)(void *thiz);
             int (*poll)(void *thiz, fd_set *, fd_set *, fd_set *);
+#ifdef __linux__
+            // Returns file descriptor and epoll events, which should be awaited (epoll based `async_wait`).
+            int (*epoll)(void *thiz, uint32_t *events);
+#endif
             void (*move)(void* src, void *dst);
             void (*destr)(void *thiz);
         };
@@ -56,6 +61,14 @@ template <> struct netcoredbg::IOSystemTraits<netcoredbg::UnixPlatformTag>
             return traits->poll(data, read, write, except);
         }
 
+#ifdef __linux__
+        int epoll(uint32_t *events)
+        {
+            assert(*this);
+            return traits->epoll(data, events);
+        }
+#endif
+
         AsyncHandle() : traits(nullptr) {}
 
         template <typename InstanceType, typename... Args>
@@ -85,11 +98,17 @@ template <> struct netcoredbg::IOSystemTraits<netcoredbg::UnixPlatformTag>
 
     static std::pair<FileHandle, FileHandle> unnamed_pipe();
     static FileHandle listen_socket(unsigned tcp_port);
+    static FileHandle server_socket(unsigned tcp_port);
+    static FileHandle server_unix_socket(const std::string &path);
+    static FileHandle accept_socket(const FileHandle&);
+    static IOResult tune_socket(const FileHandle&, size_t buffer_size);
     static IOResult set_inherit(const FileHandle&, bool);
     static IOResult read(const FileHandle&, void *buf, size_t count);
     static IOResult write(const FileHandle&, const void *buf, size_t count);
+    static IOResult writev(const FileHandle&, const IOSystem::WriteBuffer *bufs, size_t nbufs);
     static AsyncHandle async_read(const FileHandle&, void *buf, size_t count);
     static AsyncHandle async_write(const FileHandle&, const void *buf, size_t count);
+    static AsyncHandle async_splice(const FileHandle& in, const FileHandle& out, size_t count);
     static bool async_wait(IOSystem::AsyncHandleIterator begin, IOSystem::AsyncHandleIterator end, std::chrono::milliseconds);
     static IOResult async_cancel(AsyncHandle&);
     static IOResult async_result(AsyncHandle&);
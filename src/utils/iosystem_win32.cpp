@@ -13,6 +13,8 @@
 #include <new>
 #include <memory>
 #include <atomic>
+#include <algorithm>
+#include <climits>
 #include <string.h>
 #include <assert.h>
 #include "utils/iosystem.h"
@@ -228,16 +230,13 @@ std::pair<Class::FileHandle, Class::FileHandle> Class::unnamed_pipe()
 }
 
 
-// Function creates listening TCP socket on given port, waits, accepts single
-// connection, and return file descriptor related to the accepted connection.
+// Function creates TCP socket listening for connections on given port.
 // In case of error, empty file handle will be returned.
-Class::FileHandle Class::listen_socket(unsigned port)
+Class::FileHandle Class::server_socket(unsigned port)
 {
     assert(port > 0 && port < 65536);
 
-    SOCKET newsockfd;
-    int clilen;
-    struct sockaddr_in serv_addr, cli_addr;
+    struct sockaddr_in serv_addr;
 
     SOCKET sockFd = ::socket(AF_INET, SOCK_STREAM, 0);
     if (sockFd == INVALID_SOCKET)
@@ -266,11 +265,58 @@ Class::FileHandle Class::listen_socket(unsigned port)
         return {};
     }
 
-    ::listen(sockFd, 1);
+    // Note, in multi-session mode next clients could connect while current session is running.
+    ::listen(sockFd, SOMAXCONN);
+
+    return FileHandle(sockFd);
+}
+
+// Function creates Unix domain socket (Windows 10 1803 and later) listening for connections on given path.
+// In case of error, empty file handle will be returned.
+Class::FileHandle Class::server_unix_socket(const std::string &path)
+{
+    struct sockaddr_un serv_addr;
+    if (path.empty() || path.size() >= sizeof(serv_addr.sun_path))
+    {
+        fprintf(stderr, "wrong unix socket path length\n");
+        return {};
+    }
+
+    SOCKET sockFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sockFd == INVALID_SOCKET)
+    {
+        fprintf(stderr, "can't create socket: %#x\n", WSAGetLastError());
+        return {};
+    }
+
+    memset(&serv_addr, 0, sizeof(serv_addr));
+    serv_addr.sun_family = AF_UNIX;
+    memcpy(serv_addr.sun_path, path.c_str(), path.size());
+
+    // Note, socket file is not removed at close, so, it could be left by previous debugger run.
+    ::DeleteFileA(path.c_str());
+
+    if (::bind(sockFd, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) == SOCKET_ERROR)
+    {
+        ::closesocket(sockFd);
+        fprintf(stderr, "can't bind to specified unix socket path!\n");
+        return {};
+    }
+
+    // Note, in multi-session mode next clients could connect while current session is running.
+    ::listen(sockFd, SOMAXCONN);
+
+    return FileHandle(sockFd);
+}
 
-    clilen = sizeof(cli_addr);
-    newsockfd = ::accept(sockFd, (struct sockaddr*)&cli_addr, &clilen);
-    ::closesocket(sockFd);
+// Function waits and accepts single connection on listening socket, and return
+// file descriptor related to the accepted connection.
+// In case of error, empty file handle will be returned.
+Class::FileHandle Class::accept_socket(const FileHandle& server)
+{
+    struct sockaddr_storage cli_addr;
+    int clilen = sizeof(cli_addr);
+    SOCKET newsockfd = ::accept((SOCKET)server.handle, (struct sockaddr*)&cli_addr, &clilen);
     if (newsockfd == INVALID_SOCKET)
     {
         fprintf(stderr, "can't accept connection\n");
@@ -280,6 +326,39 @@ Class::FileHandle Class::listen_socket(unsigned port)
     return FileHandle(newsockfd);
 }
 
+// Function creates listening TCP socket on given port, waits, accepts single
+// connection, and return file descriptor related to the accepted connection.
+// In case of error, empty file handle will be returned.
+Class::FileHandle Class::listen_socket(unsigned port)
+{
+    FileHandle server = server_socket(port);
+    if (!server)
+        return {};
+
+    FileHandle result = accept_socket(server);
+    close(server);
+    return result;
+}
+
+// Note, protocol messages are small and each message is written by one call (see OutStreamBuf), so, Nagle's algorithm
+// only delays responses and events till peer's delayed ACK.
+Class::IOResult Class::tune_socket(const FileHandle& fh, size_t buffer_size)
+{
+    // Note, fails for Unix domain socket, that don't have Nagle's algorithm.
+    BOOL enable = 1;
+    ::setsockopt((SOCKET)fh.handle, IPPROTO_TCP, TCP_NODELAY, (const char *)&enable, sizeof(BOOL));
+
+    if (buffer_size != 0)
+    {
+        int size = int(std::min(buffer_size, size_t(INT_MAX)));
+        if (::setsockopt((SOCKET)fh.handle, SOL_SOCKET, SO_SNDBUF, (const char *)&size, sizeof(size)) == SOCKET_ERROR ||
+            ::setsockopt((SOCKET)fh.handle, SOL_SOCKET, SO_RCVBUF, (const char *)&size, sizeof(size)) == SOCKET_ERROR)
+            return {IOResult::Error, 0};
+    }
+
+    return {IOResult::Success, 0};
+}
+
 // Function enables or disables inheritance of file handle for child processes.
 Class::IOResult Class::set_inherit(const FileHandle& fh, bool inherit)
 {
@@ -322,6 +401,28 @@ Class::IOResult Class::write(const FileHandle& fh, const void *buf, size_t count
         return { IOResult::Success, dwWritten };
 }
 
+// Note, there is no gather write for pipes and sockets opened as files (WriteFileGather requires
+// unbuffered file), so fragments are written sequentially until first short or failed write.
+Class::IOResult Class::writev(const FileHandle& fh, const IOSystem::WriteBuffer *bufs, size_t nbufs)
+{
+    size_t written = 0;
+    for (size_t n = 0; n < nbufs; n++)
+    {
+        if (bufs[n].count == 0)
+            continue;
+
+        IOResult res = write(fh, bufs[n].buf, bufs[n].count);
+        if (res.status != IOResult::Success)
+            return written != 0 ? IOResult{ IOResult::Success, written } : res;
+
+        written += res.size;
+        if (res.size != bufs[n].count)
+            break;
+    }
+
+    return { IOResult::Success, written };
+}
+
 
 Class::AsyncHandle Class::async_read(const FileHandle& fh, void *buf, size_t count)
 {
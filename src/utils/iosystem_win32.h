@@ -68,11 +68,17 @@ template <> struct IOSystemTraits<Win32PlatformTag>
 
     static std::pair<FileHandle, FileHandle> unnamed_pipe();
     static FileHandle listen_socket(unsigned tcp_port);
+    static FileHandle server_socket(unsigned tcp_port);
+    static FileHandle server_unix_socket(const std::string &path);
+    static FileHandle accept_socket(const FileHandle &);
+    static IOResult tune_socket(const FileHandle &, size_t buffer_size);
     static IOResult set_inherit(const FileHandle &, bool);
     static IOResult read(const FileHandle &, void *buf, size_t count);
     static IOResult write(const FileHandle &, const void *buf, size_t count);
+    static IOResult writev(const FileHandle &, const IOSystem::WriteBuffer *bufs, size_t nbufs);
     static AsyncHandle async_read(const FileHandle &, void *buf, size_t count);
     static AsyncHandle async_write(const FileHandle &, const void *buf, size_t count);
+    static AsyncHandle async_splice(const FileHandle &, const FileHandle &, size_t) { return {}; }  // not supported
     static bool async_wait(IOSystem::AsyncHandleIterator begin, IOSystem::AsyncHandleIterator end, std::chrono::milliseconds);
     static IOResult async_cancel(AsyncHandle &);
     static IOResult async_result(AsyncHandle &);
@@ -0,0 +1,43 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+/// \file jsonstring.h  This file contains helper for JSON string literal output, used by exporters that don't need
+/// full JSON library (profiler samples, triage snapshot).
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+namespace netcoredbg
+{
+
+/// Append `str` to `output` as quoted and escaped JSON string (UTF-8 data is copied as is).
+inline void AppendJsonString(std::string &output, const std::string &str)
+{
+    output += '"';
+    for (char c : str)
+    {
+        switch (c)
+        {
+            case '"':  output += "\\\""; break;
+            case '\\': output += "\\\\"; break;
+            case '\n': output += "\\n"; break;
+            case '\r': output += "\\r"; break;
+            case '\t': output += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char buf[8];
+                    snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                    output += buf;
+                }
+                else
+                    output += c;
+        }
+    }
+    output += '"';
+}
+
+} // namespace netcoredbg
@@ -16,7 +16,14 @@
 #include <string.h>
 #include <time.h>
 #include <assert.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
+#include <thread>
 #include "utils/limits.h"
 
 #ifdef _WIN32
@@ -33,8 +40,6 @@
 
 namespace
 {
-    char log_buffer[2*LINE_MAX];
-
     // Implementation clock_gettime(CLOCK_MONOTONIC, ...) for Windows.
     #ifdef _WIN32
     enum { CLOCK_MONOTONIC = 0 };
@@ -101,9 +106,237 @@ namespace
             return nullptr;
         }
 
-        setvbuf(result, log_buffer, _IOFBF, sizeof(log_buffer));
+        setvbuf(result, nullptr, _IOFBF, 16 * LINE_MAX);
         return result;
     }
+
+    // This function returns minimal log level, determined by contents of environment
+    // variable "LOG_LEVEL" (first letter of level name, "DIWEF" or "diwef"), debug by default.
+    log_priority get_log_level()
+    {
+        const char *env = getenv("LOG_LEVEL");
+        if (!env || !*env)
+            return DLOG_DEBUG;
+
+        const char *levels = "DIWEF";
+        const char *level = strchr(levels, toupper((unsigned char)*env));
+        return level ? log_priority(DLOG_DEBUG + (level - levels)) : DLOG_DEBUG;
+    }
+
+    // Asynchronous log writer: formatted log messages are placed into bounded lock-free queue
+    // (multiple producers, single consumer) by logging threads, background thread write them into file.
+    // Note, file flushed only in case queue is empty (not for each line). In case queue is full,
+    // message is dropped and counted, number of dropped messages is written into log later.
+    class LogWriter
+    {
+    public:
+
+        static const size_t RecordsCount = 2048; // must be power of two
+        static const size_t RecordSize = 512; // longer messages are allocated on heap
+
+        LogWriter(FILE *file) :
+            m_file(file),
+            m_enqueuePos(0),
+            m_dequeuePos(0),
+            m_dropped(0),
+            m_pending(false),
+            m_stop(false)
+        {
+            for (size_t i = 0; i < RecordsCount; i++)
+            {
+                m_records[i].sequence.store(i, std::memory_order_relaxed);
+                m_records[i].longText = nullptr;
+            }
+            m_thread = std::thread(&LogWriter::Worker, this);
+        }
+
+        // Return length of written message or negative value in case of error.
+        int Write(const char *header, size_t headerLen, const char *fmt, va_list ap, bool sync);
+        void Stop();
+
+    private:
+
+        struct record_t
+        {
+            std::atomic<size_t> sequence;
+            size_t len;
+            char *longText; // allocated in case message don't fit into text
+            char text[RecordSize];
+        };
+
+        FILE *m_file;
+        record_t m_records[RecordsCount];
+        std::atomic<size_t> m_enqueuePos;
+        size_t m_dequeuePos; // covered by m_writeMutex
+        std::atomic<unsigned> m_dropped;
+        std::atomic<bool> m_pending;
+        std::mutex m_writeMutex;
+        std::mutex m_wakeMutex;
+        std::condition_variable m_wakeCV;
+        std::atomic<bool> m_stop;
+        std::thread m_thread;
+
+        void Drain();
+        void Worker();
+    };
+
+    const size_t LogWriter::RecordsCount;
+    const size_t LogWriter::RecordSize;
+
+    int LogWriter::Write(const char *header, size_t headerLen, const char *fmt, va_list ap, bool sync)
+    {
+        record_t *record;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            record = &m_records[pos & (RecordsCount - 1)];
+            size_t sequence = record->sequence.load(std::memory_order_acquire);
+            intptr_t diff = intptr_t(sequence) - intptr_t(pos);
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return DLOG_ERROR_NOT_PERMITTED;
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Note, record reserved at this point and must be published in any case.
+        headerLen = std::min(headerLen, RecordSize - 2);
+        memcpy(record->text, header, headerLen);
+
+        va_list apCopy;
+        va_copy(apCopy, ap);
+        int r = vsnprintf(record->text + headerLen, RecordSize - 1 - headerLen, fmt, ap);
+        if (r < 0)
+            r = 0;
+
+        if (size_t(r) < RecordSize - 1 - headerLen)
+        {
+            record->len = headerLen + r;
+            record->text[record->len++] = '\n';
+        }
+        else
+        {
+            record->len = headerLen + r + 1;
+            record->longText = static_cast<char*>(malloc(record->len + 1));
+            if (record->longText)
+            {
+                memcpy(record->longText, header, headerLen);
+                vsnprintf(record->longText + headerLen, r + 1, fmt, apCopy);
+                record->longText[record->len - 1] = '\n';
+            }
+            else
+            {
+                record->len = RecordSize - 1;
+                record->text[record->len - 1] = '\n';
+            }
+        }
+        va_end(apCopy);
+
+        // Note, record could be written and reused by drain thread right after publish.
+        const int len = int(record->len);
+        record->sequence.store(pos + 1, std::memory_order_release);
+
+        // Note, after writer stop (at exit) all messages are written synchronously.
+        if (sync || m_stop.load(std::memory_order_relaxed))
+            Drain();
+        else if (!m_pending.exchange(true, std::memory_order_relaxed))
+            m_wakeCV.notify_one();
+
+        return len;
+    }
+
+    void LogWriter::Drain()
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+
+        bool written = false;
+        while (true)
+        {
+            record_t &record = m_records[m_dequeuePos & (RecordsCount - 1)];
+            if (record.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+                break;
+
+            if (record.longText)
+            {
+                fwrite(record.longText, 1, record.len, m_file);
+                free(record.longText);
+                record.longText = nullptr;
+            }
+            else
+            {
+                fwrite(record.text, 1, record.len, m_file);
+            }
+
+            record.sequence.store(m_dequeuePos + RecordsCount, std::memory_order_release);
+            m_dequeuePos++;
+            written = true;
+        }
+
+        unsigned dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped != 0)
+        {
+            fprintf(m_file, "Logger: %u messages dropped (queue is full)\n", dropped);
+            written = true;
+        }
+
+        if (written)
+            fflush(m_file);
+    }
+
+    void LogWriter::Worker()
+    {
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        while (!m_stop.load(std::memory_order_relaxed))
+        {
+            m_pending.store(false, std::memory_order_relaxed);
+            lock.unlock();
+            Drain();
+            lock.lock();
+
+            // Note, wake up could be missed in case of race with m_pending check, so, wait with timeout.
+            m_wakeCV.wait_for(lock, std::chrono::milliseconds(100), [this]()
+            {
+                return m_stop.load(std::memory_order_relaxed) || m_pending.load(std::memory_order_relaxed);
+            });
+        }
+    }
+
+    void LogWriter::Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            if (m_stop.load(std::memory_order_relaxed))
+                return;
+            m_stop.store(true, std::memory_order_relaxed);
+        }
+        m_wakeCV.notify_one();
+        if (m_thread.joinable())
+            m_thread.join();
+
+        Drain();
+    }
+
+    // Note, writer is allocated at first log message and never freed (since could be used during
+    // static objects destruction), writer thread is stopped at exit with all pending messages write.
+    LogWriter *create_log_writer()
+    {
+        FILE *file = open_log_file();
+        if (file == nullptr)
+            return nullptr;
+
+        static LogWriter *writer = new LogWriter(file);
+        atexit([]{ writer->Stop(); });
+        return writer;
+    }
 }
 
 
@@ -129,30 +362,27 @@ extern "C" int dlog_vprint(log_priority prio, const char *tag, const char *fmt,
     struct timespec ts {};
     clock_gettime(CLOCK_MONOTONIC, &ts);
 
-    static std::mutex mutex;
-    std::lock_guard<std::mutex> lock(mutex);
-
     if (prio == DLOG_DEFAULT)
         prio = DLOG_INFO;
 
+    static const log_priority log_level = get_log_level();
+    if (prio < log_level)
+        return 0;
+
+    static LogWriter *log_writer = create_log_writer();
+    if (log_writer == nullptr)
+        return DLOG_ERROR_NOT_PERMITTED;
+
     char level = 'I';
     if (prio >= DLOG_DEBUG && prio <= DLOG_FATAL)
         level = "DIWEF"[prio - DLOG_DEBUG];
 
-    static FILE *log_file = open_log_file();
-    if (log_file == NULL || ferror(log_file))
-        return DLOG_ERROR_NOT_PERMITTED;
-
-    int len = fprintf(log_file, "%lu.%03u %c/%s(P%4u, T%4u): ",
+    char header[LINE_MAX];
+    int len = snprintf(header, sizeof(header), "%lu.%03u %c/%s(P%4u, T%4u): ",
                 long(ts.tv_sec & 0x7fffff), int(ts.tv_nsec / 1000000), level, tag, get_pid(), get_tid());
-
-    int r = vfprintf(log_file, fmt, ap);
-    if (r < 0) {
-        fputc('\n', log_file);
+    if (len < 0)
         return DLOG_ERROR_INVALID_PARAMETER;
-    }
 
-    fputc('\n', log_file);
-    return fflush(log_file) < 0 ? DLOG_ERROR_NOT_PERMITTED : len + r + 1;
+    // Note, fatal messages are written synchronously, since process could be terminated right after.
+    return log_writer->Write(header, std::min(size_t(len), sizeof(header) - 1), fmt, ap, prio == DLOG_FATAL);
 }
-
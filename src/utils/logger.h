@@ -104,9 +104,16 @@ namespace DLogInternal
 #define LOG_CHECK_ARGS_(fmt, ...) (false ? DLogInternal::check_args(fmt, ##__VA_ARGS__) : 0)
 #endif
 
+// Minimal log priority for compile time filtering, messages with lower priority are excluded from code
+// (for example, -DLOG_MIN_PRIORITY=DLOG_WARN). Note, run time filtering provided by "LOG_LEVEL" environment variable.
+#ifndef LOG_MIN_PRIORITY
+#define LOG_MIN_PRIORITY DLOG_DEBUG
+#endif
+
 // Following macros shouldn't be used directly, it is intendent for internal use.
 #define LOG_(prio, tag, fmt, ...) \
         (LOG_CHECK_ARGS_(fmt, ##__VA_ARGS__), \
+        ((prio) == DLOG_DEFAULT ? DLOG_INFO : (prio)) < LOG_MIN_PRIORITY ? 0 : \
         dlog_print(prio, tag, "%.*s: %.*s(%.*s) > " fmt, \
             int(sizeof(__FILE__) - DLogInternal::path_len(__FILE__)), &__FILE__[DLogInternal::path_len(__FILE__)], \
             int(DLogInternal::funcname_len(__func__)), __func__, \
@@ -0,0 +1,39 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+/// \file mappedfile.h  This file contains declaration of MappedFile class, which provides
+/// read-only access to file content mapped into memory.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace netcoredbg
+{
+
+/// Read-only memory mapped file. Note, mapped pages are shared by all processes mapping same file,
+/// and mapping stays valid even in case file was removed or replaced (on Unix) after open.
+class MappedFile
+{
+public:
+    MappedFile() : m_data(nullptr), m_size(0) {}
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile &operator=(const MappedFile&) = delete;
+
+    /// Function returns `false` in case file can't be opened or mapped, or file is empty.
+    bool Open(const std::string &path);
+    void Close();
+
+    const char *Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+
+private:
+    const char *m_data;
+    size_t m_size;
+};
+
+} // namespace netcoredbg
@@ -0,0 +1,59 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+/// \file mappedfile_win32.cpp
+/// This file contains definitions of windows-specific MappedFile class functions.
+
+#ifdef WIN32
+#include <windows.h>
+#include "utils/mappedfile.h"
+#include "utils/utf.h"
+
+namespace netcoredbg
+{
+
+bool MappedFile::Open(const std::string &path)
+{
+    Close();
+
+    HANDLE fileHandle = CreateFileW(to_utf16(path).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0 || (ULONGLONG)fileSize.QuadPart > (SIZE_T)-1)
+    {
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(fileHandle);
+    if (mappingHandle == nullptr)
+        return false;
+
+    // Note, mapped view keep mapping object alive, handle could be closed right now.
+    void *addr = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mappingHandle);
+    if (addr == nullptr)
+        return false;
+
+    m_data = static_cast<const char*>(addr);
+    m_size = (size_t)fileSize.QuadPart;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data == nullptr)
+        return;
+
+    UnmapViewOfFile(m_data);
+    m_data = nullptr;
+    m_size = 0;
+}
+
+}  // ::netcoredbg
+#endif // WIN32
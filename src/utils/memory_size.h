@@ -0,0 +1,52 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace netcoredbg
+{
+
+// Approximate heap memory size of standard containers, aimed to memory accounting reports only (real allocator
+// overhead is not taken into account). Note, elements own heap memory (strings, vectors) is not included.
+namespace MemorySize
+{
+    // Note, short strings are stored inside string object (small string optimization), no heap memory used.
+    inline size_t String(const std::string &str)
+    {
+        return str.capacity() > sizeof(std::string) - 1 ? str.capacity() + 1 : 0;
+    }
+
+    template <class T>
+    size_t Vector(const std::vector<T> &vec)
+    {
+        return vec.capacity() * sizeof(T);
+    }
+
+    // Each node hold element and "next" pointer (plus cached hash), container hold buckets array.
+    template <class C>
+    size_t HashNodes(const C &container)
+    {
+        return container.size() * (sizeof(typename C::value_type) + 2 * sizeof(void*)) + container.bucket_count() * sizeof(void*);
+    }
+
+    // Each node hold element, three pointers and color.
+    template <class C>
+    size_t TreeNodes(const C &container)
+    {
+        return container.size() * (sizeof(typename C::value_type) + 4 * sizeof(void*));
+    }
+
+    template <class C>
+    size_t ListNodes(const C &container)
+    {
+        return container.size() * (sizeof(typename C::value_type) + 2 * sizeof(void*));
+    }
+
+} // namespace MemorySize
+
+} // namespace netcoredbg
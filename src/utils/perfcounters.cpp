@@ -0,0 +1,173 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "utils/perfcounters.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "utils/logger.h"
+
+namespace netcoredbg
+{
+
+namespace PerfCounters
+{
+
+namespace Internal
+{
+    std::atomic<bool> enabled(false);
+}
+
+namespace // unnamed namespace
+{
+
+// Note, registry head have constant initialization (performed before any dynamic initialization),
+// so, counters could be safely registered from constructors of objects with static storage duration in any unit.
+CounterBase *registryHead = nullptr;
+
+std::mutex &GetRegistryMutex()
+{
+    static std::mutex registryMutex;
+    return registryMutex;
+}
+
+struct periodic_log_t
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::thread thread;
+    bool stop = false;
+};
+
+// Note, allocated at first start and never freed, since periodic log thread could be still running at exit()
+// (we don't care, since all counters are trivially destructible).
+periodic_log_t *periodicLog = nullptr;
+std::mutex periodicLogMutex;
+
+} // unnamed namespace
+
+void Enable(bool enable)
+{
+    Internal::enabled.store(enable, std::memory_order_relaxed);
+}
+
+CounterBase::CounterBase(const char *name, Kind kind) :
+    m_name(name),
+    m_kind(kind),
+    m_value(0),
+    m_max(0)
+{
+    std::lock_guard<std::mutex> lock(GetRegistryMutex());
+    m_next = registryHead;
+    registryHead = this;
+}
+
+void CounterBase::Reset()
+{
+    m_value.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+void Gauge::SetValue(uint64_t value)
+{
+    m_value.store(value, std::memory_order_relaxed);
+
+    uint64_t maxValue = m_max.load(std::memory_order_relaxed);
+    while (maxValue < value && !m_max.compare_exchange_weak(maxValue, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+void ForEachCounter(void (*callback)(CounterBase&, void*), void *data)
+{
+    std::lock_guard<std::mutex> lock(GetRegistryMutex());
+    for (CounterBase *counter = registryHead; counter != nullptr; counter = counter->m_next)
+    {
+        callback(*counter, data);
+    }
+}
+
+std::string DumpJSON()
+{
+    std::vector<CounterBase*> counters;
+    ForEachCounter([](CounterBase &counter, void *data)
+    {
+        static_cast<std::vector<CounterBase*>*>(data)->push_back(&counter);
+    }, &counters);
+
+    std::sort(counters.begin(), counters.end(), [](const CounterBase *left, const CounterBase *right)
+    {
+        return strcmp(left->GetName(), right->GetName()) < 0;
+    });
+
+    // Note, counters names are identifiers, no escaping needed.
+    std::ostringstream ss;
+    ss << "{";
+    for (size_t i = 0; i < counters.size(); i++)
+    {
+        if (i != 0)
+            ss << ",";
+
+        ss << "\"" << counters[i]->GetName() << "\":";
+        if (counters[i]->GetKind() == CounterBase::Kind::Gauge)
+            ss << "{\"value\":" << counters[i]->GetValue() << ",\"max\":" << counters[i]->GetMax() << "}";
+        else
+            ss << counters[i]->GetValue();
+    }
+    ss << "}";
+    return ss.str();
+}
+
+void Reset()
+{
+    ForEachCounter([](CounterBase &counter, void*)
+    {
+        counter.Reset();
+    }, nullptr);
+}
+
+void StartPeriodicLog(unsigned interval)
+{
+    StopPeriodicLog();
+
+    if (interval == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(periodicLogMutex);
+    if (periodicLog == nullptr)
+        periodicLog = new periodic_log_t;
+
+    periodicLog->stop = false;
+    periodicLog->thread = std::thread([interval]()
+    {
+        std::unique_lock<std::mutex> lockLog(periodicLog->mutex);
+        while (!periodicLog->cv.wait_for(lockLog, std::chrono::seconds(interval), []{ return periodicLog->stop; }))
+        {
+            LOGI("Performance counters: %s", DumpJSON().c_str());
+        }
+    });
+}
+
+void StopPeriodicLog()
+{
+    std::lock_guard<std::mutex> lock(periodicLogMutex);
+    if (periodicLog == nullptr || !periodicLog->thread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lockLog(periodicLog->mutex);
+        periodicLog->stop = true;
+    }
+    periodicLog->cv.notify_one();
+    periodicLog->thread.join();
+}
+
+} // namespace PerfCounters
+
+} // namespace netcoredbg
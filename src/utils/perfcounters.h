@@ -0,0 +1,140 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace netcoredbg
+{
+
+// Process-wide performance counters. Any module could define own counters as objects with static storage duration,
+// counters are registered in global registry at construction and could be dumped all together in JSON.
+// Counters are disabled by default, in this case counter update cost is one relaxed atomic load and branch only
+// (no clock calls for time counters), in enabled state counters use relaxed atomics.
+namespace PerfCounters
+{
+    namespace Internal
+    {
+        extern std::atomic<bool> enabled;
+    }
+
+    inline bool IsEnabled()
+    {
+        return Internal::enabled.load(std::memory_order_relaxed);
+    }
+
+    void Enable(bool enable);
+
+    class CounterBase
+    {
+    public:
+
+        enum class Kind
+        {
+            Sum,    // accumulated value
+            Gauge   // current value and maximum
+        };
+
+        const char *GetName() const { return m_name; }
+        Kind GetKind() const { return m_kind; }
+        uint64_t GetValue() const { return m_value.load(std::memory_order_relaxed); }
+        uint64_t GetMax() const { return m_max.load(std::memory_order_relaxed); }
+        void Reset();
+
+    protected:
+
+        // Note, name must be string literal (or have static storage duration), it is stored as is.
+        CounterBase(const char *name, Kind kind);
+
+        CounterBase(const CounterBase&) = delete;
+        CounterBase& operator=(const CounterBase&) = delete;
+
+        const char *m_name;
+        Kind m_kind;
+        std::atomic<uint64_t> m_value;
+        std::atomic<uint64_t> m_max;
+
+    private:
+
+        friend void ForEachCounter(void (*callback)(CounterBase&, void*), void *data);
+        CounterBase *m_next;
+    };
+
+    class Counter : public CounterBase
+    {
+    public:
+
+        explicit Counter(const char *name) : CounterBase(name, Kind::Sum) {}
+
+        void Add(uint64_t value = 1)
+        {
+            if (IsEnabled())
+                m_value.fetch_add(value, std::memory_order_relaxed);
+        }
+    };
+
+    class Gauge : public CounterBase
+    {
+    public:
+
+        explicit Gauge(const char *name) : CounterBase(name, Kind::Gauge) {}
+
+        void Set(uint64_t value)
+        {
+            if (IsEnabled())
+                SetValue(value);
+        }
+
+    private:
+
+        void SetValue(uint64_t value);
+    };
+
+    // Add scope duration in microseconds to time counter.
+    class ScopedTime
+    {
+    public:
+
+        explicit ScopedTime(Counter &counter) :
+            m_counter(counter),
+            m_enabled(IsEnabled())
+        {
+            if (m_enabled)
+                m_start = std::chrono::steady_clock::now();
+        }
+
+        ~ScopedTime()
+        {
+            if (m_enabled)
+                m_counter.Add(uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count()));
+        }
+
+    private:
+
+        ScopedTime(const ScopedTime&) = delete;
+        ScopedTime& operator=(const ScopedTime&) = delete;
+
+        Counter &m_counter;
+        bool m_enabled;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    void ForEachCounter(void (*callback)(CounterBase&, void*), void *data);
+
+    // Return JSON object with all registered counters (sorted by name), sum counters provided as numbers,
+    // gauges as objects with "value" and "max" fields.
+    std::string DumpJSON();
+    void Reset();
+
+    // Start periodic counters output into log with provided interval (in seconds).
+    void StartPeriodicLog(unsigned interval);
+    void StopPeriodicLog();
+
+} // namespace PerfCounters
+
+} // namespace netcoredbg
@@ -0,0 +1,100 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "utils/sequenced_executor.h"
+#include "utils/tracerecorder.h"
+
+namespace netcoredbg
+{
+
+SequencedExecutor::~SequencedExecutor()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_exit = true;
+    m_tasksCV.notify_one();
+    lock.unlock();
+
+    if (m_worker.joinable())
+        m_worker.join();
+}
+
+void SequencedExecutor::Worker()
+{
+    TraceRecorder::SetThreadName(m_name);
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+        while (m_tasks.empty() && !m_exit)
+        {
+            m_tasksCV.wait(lock);
+        }
+
+        // Note, all queued tasks are executed before exit.
+        if (m_tasks.empty())
+            return;
+
+        Task task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        m_busy = true;
+        lock.unlock();
+
+        task();
+
+        lock.lock();
+        m_busy = false;
+        if (m_tasks.empty())
+            m_idleCV.notify_all();
+    }
+}
+
+void SequencedExecutor::Post(Task &&task)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_worker.joinable())
+        m_worker = std::thread(&SequencedExecutor::Worker, this);
+
+    m_tasks.emplace_back(std::move(task));
+    m_tasksCV.notify_one();
+}
+
+void SequencedExecutor::Run(Task &&task)
+{
+    if (IsWorkerThread())
+    {
+        task();
+        return;
+    }
+
+    std::mutex doneMutex;
+    std::condition_variable doneCV;
+    bool done = false;
+    Post([&]()
+    {
+        task();
+        std::lock_guard<std::mutex> lock(doneMutex);
+        done = true;
+        doneCV.notify_one();
+    });
+
+    std::unique_lock<std::mutex> lock(doneMutex);
+    doneCV.wait(lock, [&]() { return done; });
+}
+
+void SequencedExecutor::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_worker.get_id() == std::this_thread::get_id())
+        return;
+
+    m_idleCV.wait(lock, [&]() { return m_tasks.empty() && !m_busy; });
+}
+
+bool SequencedExecutor::IsWorkerThread()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_worker.get_id() == std::this_thread::get_id();
+}
+
+} // namespace netcoredbg
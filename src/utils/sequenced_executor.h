@@ -0,0 +1,56 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+
+namespace netcoredbg
+{
+
+// Execute posted tasks one by one in own worker thread. In this way, slow operations (for example, disk writes) are moved
+// out of locks, that shared by protocol and managed callbacks threads: thread, that hold lock, post task with copy of data
+// and release lock without waiting for task execution. Tasks are executed in post order.
+// Note, worker thread is started at first Post() call, all queued tasks are executed at destruction.
+class SequencedExecutor
+{
+public:
+
+    typedef std::function<void()> Task;
+
+    // Name for worker thread in trace, must be string literal (or have static storage duration).
+    explicit SequencedExecutor(const char *name) :
+        m_name(name)
+    {}
+    ~SequencedExecutor();
+
+    void Post(Task &&task);
+    // Post task and wait for its execution. Note, in case called from worker thread, task is executed immediately.
+    void Run(Task &&task);
+    // Wait for all previously posted tasks execution.
+    void WaitIdle();
+    bool IsWorkerThread();
+
+private:
+
+    SequencedExecutor(const SequencedExecutor&) = delete;
+    SequencedExecutor& operator=(const SequencedExecutor&) = delete;
+
+    const char *m_name;
+    std::mutex m_mutex;
+    std::condition_variable m_tasksCV;
+    std::condition_variable m_idleCV;
+    std::deque<Task> m_tasks;
+    bool m_busy = false;
+    bool m_exit = false;
+    std::thread m_worker;
+
+    void Worker();
+};
+
+} // namespace netcoredbg
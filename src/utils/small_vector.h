@@ -0,0 +1,125 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+/// \file small_vector.h  This file contains definition of `small_vector' class, vector-like container with inline storage.
+
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <assert.h>
+
+namespace netcoredbg
+{
+
+namespace Utility
+{
+
+/// Vector-like container, which keeps up to `N` elements inside of object itself and allocates memory only in case
+/// of more elements added. Aimed for short temporary sequences (like generic arguments of type), which are created
+/// and destroyed many times. Only the part of std::vector interface, which is needed by debugger, is implemented.
+/// Note, iterators and references are invalidated by any element addition (same as std::vector on reallocation).
+template <typename T, size_t N> class small_vector
+{
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef pointer iterator;
+    typedef const_pointer const_iterator;
+    typedef size_t size_type;
+
+    small_vector() noexcept : _data(inline_data()), _size(0), _capacity(N) {}
+
+    ~small_vector()
+    {
+        clear();
+        if (_data != inline_data())
+            ::operator delete(_data);
+    }
+
+    small_vector(const small_vector&) = delete;
+    small_vector& operator=(const small_vector&) = delete;
+
+    size_type size() const noexcept { return _size; }
+    size_type capacity() const noexcept { return _capacity; }
+    bool empty() const noexcept { return _size == 0; }
+
+    pointer data() noexcept { return _data; }
+    const_pointer data() const noexcept { return _data; }
+
+    iterator begin() noexcept { return _data; }
+    iterator end() noexcept { return _data + _size; }
+    const_iterator begin() const noexcept { return _data; }
+    const_iterator end() const noexcept { return _data + _size; }
+
+    reference operator[](size_type pos) { assert(pos < _size); return _data[pos]; }
+    const_reference operator[](size_type pos) const { assert(pos < _size); return _data[pos]; }
+
+    reference front() { assert(_size != 0); return _data[0]; }
+    reference back() { assert(_size != 0); return _data[_size - 1]; }
+
+    template <typename... Args> reference emplace_back(Args&&... args)
+    {
+        if (_size == _capacity)
+            return grow_and_emplace(std::forward<Args>(args)...);
+
+        new (_data + _size) T(std::forward<Args>(args)...);
+        return _data[_size++];
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back()
+    {
+        assert(_size != 0);
+        _data[--_size].~T();
+    }
+
+    /// Destroys all elements, but keeps allocated memory (if any) for reuse.
+    void clear() noexcept
+    {
+        while (_size != 0)
+            _data[--_size].~T();
+    }
+
+private:
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_t;
+
+    pointer inline_data() noexcept { return reinterpret_cast<pointer>(_inline); }
+
+    // Note, new element constructed before old elements moved, since arguments could refer to container's element.
+    template <typename... Args> reference grow_and_emplace(Args&&... args)
+    {
+        const size_type capacity = _capacity * 2;
+        pointer data = static_cast<pointer>(::operator new(capacity * sizeof(T)));
+        new (data + _size) T(std::forward<Args>(args)...);
+
+        for (size_type i = 0; i < _size; i++)
+        {
+            new (data + i) T(std::move(_data[i]));
+            _data[i].~T();
+        }
+
+        if (_data != inline_data())
+            ::operator delete(_data);
+
+        _data = data;
+        _capacity = capacity;
+        return _data[_size++];
+    }
+
+    storage_t _inline[N];
+    pointer _data;
+    size_type _size;
+    size_type _capacity;
+};
+
+} // namespace Utility
+
+} // namespace netcoredbg
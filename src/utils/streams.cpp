@@ -194,4 +194,44 @@ int OutStreamBuf::sync()
     return 0;
 }
 
+// Function writes `count` characters from `s`, large data isn't copied to the buffer and
+// written with buffered data (message header, for example) by single gather write operation.
+std::streamsize OutStreamBuf::xsputn(const char *s, std::streamsize count)
+{
+    using IOResult = IOSystem::IOResult;
+
+    if (count <= 0)
+        return 0;
+
+    size_t left = size_t(count);
+    while (left > size_t(epptr() - pptr()))
+    {
+        size_t buffered = pptr() - pbase();
+        IOSystem::WriteBuffer bufs[2] = { {pbase(), buffered}, {s, left} };
+        IOResult res = IOSystem::writev(file_handle, bufs, 2);
+        if (res.status == IOResult::Error)
+            return count - std::streamsize(left);
+
+        if (res.status != IOResult::Success)
+        {
+            std::this_thread::yield();      // for non-blocking streams
+            continue;
+        }
+
+        // move unwritten part of the buffer to the beginning of the buffer
+        size_t from_buffer = std::min(res.size, buffered);
+        memmove(pbase(), pbase() + from_buffer, buffered - from_buffer);
+        setp(pbase(), epptr());
+        pbump(int(buffered - from_buffer));
+
+        s += res.size - from_buffer;
+        left -= res.size - from_buffer;
+    }
+
+    // rest of the data fits in the buffer
+    memcpy(pptr(), s, left);
+    pbump(int(left));
+    return count;
+}
+
 }  // ::netcoredbg
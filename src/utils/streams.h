@@ -171,6 +171,11 @@ protected:
     /// (user code should use `pubsync` function for such purpose).
     virtual int sync() override;
 
+    /// Function writes `count` characters from `s`. Data which doesn't fit in the buffer
+    /// isn't copied: buffered data and `s` are written with single gather write operation.
+    /// Function returns number of consumed characters (less than `count` on write error).
+    virtual std::streamsize xsputn(const char *s, std::streamsize count) override;
+
     // Following functions exposed to enable direct access of the buffer.
 public:
     /// Function returns the pointer to the beginning of free space in the buffer.
@@ -252,6 +257,9 @@ protected:
     /// (user code should use `pubsync` function for such purpose).
     virtual int sync() override { return OutStreamBuf::sync(); }
 
+    /// Function writes `count` characters from `s` (see OutStreamBuf::xsputn).
+    virtual std::streamsize xsputn(const char *s, std::streamsize count) override { return OutStreamBuf::xsputn(s, count); }
+
 public:
     /// Function returns pointer to the next available character.
     char* gptr() { return std::streambuf::gptr(); }
@@ -0,0 +1,47 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "utils/string_interner.h"
+#include "utils/memory_size.h"
+
+namespace netcoredbg
+{
+
+const std::string *StringInterner::Intern(const std::string &str)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return &(*m_strings.insert(str).first);
+}
+
+const std::string *StringInterner::Find(const std::string &str)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto find = m_strings.find(str);
+    return find == m_strings.end() ? nullptr : &(*find);
+}
+
+size_t StringInterner::Size()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_strings.size();
+}
+
+size_t StringInterner::GetMemoryUsage()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t size = MemorySize::HashNodes(m_strings);
+    for (const auto &str : m_strings)
+    {
+        size += MemorySize::String(str);
+    }
+    return size;
+}
+
+StringInterner &StringInterner::SourcePaths()
+{
+    static StringInterner sourcePaths;
+    return sourcePaths;
+}
+
+} // namespace netcoredbg
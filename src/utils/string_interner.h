@@ -0,0 +1,40 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+namespace netcoredbg
+{
+
+// Thread safe storage of unique strings. Strings are never removed, so, returned pointers are valid during all
+// debugger's life time and same strings have same pointers (pointers could be compared and hashed instead of strings).
+// Aimed to share sources full paths between modules sources data, sequence points caches and sequence points.
+class StringInterner
+{
+public:
+
+    // Return pointer to stored string equal to `str`, add `str` in case it is not stored yet.
+    const std::string *Intern(const std::string &str);
+    // Return pointer to stored string equal to `str` or nullptr, in case `str` is not stored (don't add new string).
+    const std::string *Find(const std::string &str);
+    size_t Size();
+    // Approximate heap memory size.
+    size_t GetMemoryUsage();
+
+    // Shared storage for sources full paths.
+    static StringInterner &SourcePaths();
+
+private:
+
+    std::mutex m_mutex;
+    // Note, unordered_set is node-based container, elements are not moved at rehash.
+    std::unordered_set<std::string> m_strings;
+};
+
+} // namespace netcoredbg
@@ -13,6 +13,15 @@
 #include <ostream>
 #include <string>
 
+// Note, SSE2 is always available on x86-64, for other targets search primitives fall back to memchr() and byte sets.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NCDB_STRING_VIEW_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
 namespace netcoredbg { namespace Utility {
 
 template <typename CharT> class StringViewBase
@@ -79,6 +88,43 @@ private:
 			}
 			return NULL;
 		}
+
+		// Find first (`match` is true) or first not (`match` is false) character of `s` from `set`.
+		static const U* find_first_of(const StringViewBase<U>& s, const StringViewBase<U>& set, bool match)
+		{
+			for (iterator i = s.begin(); i != s.end(); ++i)
+			{
+				if ((set.find(*i) != npos) == match)
+					return &*i;
+			}
+			return NULL;
+		}
+
+		static const U* find_last_of(const StringViewBase<U>& s, const StringViewBase<U>& set, bool match)
+		{
+			for (reverse_iterator i = s.rbegin(); i != s.rend(); ++i)
+			{
+				if ((set.find(*i) != npos) == match)
+					return &*i;
+			}
+			return NULL;
+		}
+
+		static U fold_case(U c) { return (c >= U('A') && c <= U('Z')) ? U(c - U('A') + U('a')) : c; }
+
+		static int compare_nocase(const StringViewBase<U>& a, const StringViewBase<U>& b)
+		{
+			iterator i = a.begin(), j = b.begin();
+			while (i != a.end() && j != b.end())
+			{
+				U x = fold_case(*i), y = fold_case(*j);
+				if (x != y)
+					return x < y ? -1 : +1;
+				++i, ++j;
+			}
+
+			return a.size() < b.size() ? -1 : (a.size() > b.size()) ? +1 : 0;
+		}
 	};
 
 	template <typename CharType> struct CharTraits
@@ -100,7 +146,154 @@ private:
 
 		static const CharType* find_last(const StringViewBase<CharType>& s, CharType c)
 		{
+#ifdef __GLIBC__
+			return static_cast<const_pointer>(memrchr(s.data(), c, s.size()));
+#else
 			return Traits<CharType, CharType>::find_last(s, c);
+#endif
+		}
+
+		// Set of characters for find_first_of() and similar functions, each character is checked by one lookup.
+		class ByteSet
+		{
+			uint32_t bits[8];
+
+		public:
+			explicit ByteSet(const StringViewBase<CharType>& set) : bits()
+			{
+				for (iterator i = set.begin(); i != set.end(); ++i)
+					bits[uint8_t(*i) >> 5] |= uint32_t(1) << (uint8_t(*i) & 31);
+			}
+
+			bool contains(CharType c) const { return (bits[uint8_t(c) >> 5] & (uint32_t(1) << (uint8_t(c) & 31))) != 0; }
+		};
+
+		// Note, building of ByteSet costs set.size() operations, so, first characters are checked by memchr() in set,
+		// result is often found near search start (separators, leading spaces, etc).
+		static const size_t DirectSearchLength = 16;
+
+		static bool in_set(const StringViewBase<CharType>& set, CharType c) { return memchr(set.data(), c, set.size()) != NULL; }
+
+#ifdef NCDB_STRING_VIEW_SSE2
+		// Sets up to this size are searched by SIMD compare of 16 characters with each set character.
+		static const size_t MaxSimdSet = 4;
+
+		static unsigned first_bit(unsigned mask)
+		{
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return unsigned(index);
+#else
+			return unsigned(__builtin_ctz(mask));
+#endif
+		}
+
+		// Return mask with bits set for characters of `block`, that are in `set`.
+		static unsigned match_mask(__m128i block, const __m128i *set, size_t count)
+		{
+			__m128i eq = _mm_cmpeq_epi8(block, set[0]);
+			for (size_t i = 1; i < count; i++)
+				eq = _mm_or_si128(eq, _mm_cmpeq_epi8(block, set[i]));
+			return unsigned(_mm_movemask_epi8(eq));
+		}
+
+		// ASCII upper case letters are converted to lower case for 16 characters at once.
+		static __m128i fold_case(__m128i block)
+		{
+			__m128i upper = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)),
+			                              _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), block));
+			return _mm_or_si128(block, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+		}
+#endif
+
+		static const CharType* find_first_of(const StringViewBase<CharType>& s, const StringViewBase<CharType>& set, bool match)
+		{
+			if (match && set.size() == 1)
+				return find_first(s, set[0]);
+
+			const_pointer p = s.data();
+			const_pointer end = p + s.size();
+#ifdef NCDB_STRING_VIEW_SSE2
+			if (!set.empty() && set.size() <= MaxSimdSet)
+			{
+				__m128i chars[MaxSimdSet];
+				for (size_t i = 0; i < set.size(); i++)
+					chars[i] = _mm_set1_epi8(char(set[i]));
+
+				for (; end - p >= 16; p += 16)
+				{
+					unsigned mask = match_mask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), chars, set.size());
+					if (!match)
+						mask ^= 0xffff;
+					if (mask != 0)
+						return p + first_bit(mask);
+				}
+			}
+#endif
+			for (const_pointer direct = end - p > ptrdiff_t(DirectSearchLength) ? p + DirectSearchLength : end; p != direct; ++p)
+			{
+				if (in_set(set, *p) == match)
+					return p;
+			}
+			if (p == end)
+				return NULL;
+
+			ByteSet bytes(set);
+			for (; p != end; ++p)
+			{
+				if (bytes.contains(*p) == match)
+					return p;
+			}
+			return NULL;
+		}
+
+		static const CharType* find_last_of(const StringViewBase<CharType>& s, const StringViewBase<CharType>& set, bool match)
+		{
+			if (match && set.size() == 1)
+				return find_last(s, set[0]);
+
+			const_pointer p = s.data() + s.size();
+			for (const_pointer direct = s.size() > DirectSearchLength ? p - DirectSearchLength : s.data(); p != direct;)
+			{
+				if (in_set(set, *--p) == match)
+					return p;
+			}
+			if (p == s.data())
+				return NULL;
+
+			ByteSet bytes(set);
+			while (p != s.data())
+			{
+				if (bytes.contains(*--p) == match)
+					return p;
+			}
+			return NULL;
+		}
+
+		static int compare_nocase(const StringViewBase<CharType>& a, const StringViewBase<CharType>& b)
+		{
+			const size_t size = a.size() < b.size() ? a.size() : b.size();
+			size_t i = 0;
+#ifdef NCDB_STRING_VIEW_SSE2
+			for (; size - i >= 16; i += 16)
+			{
+				__m128i x = fold_case(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a.data() + i)));
+				__m128i y = fold_case(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b.data() + i)));
+				if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) != 0xffff)
+					break;
+			}
+#endif
+			// Note, characters are compared as unsigned, same as memcmp() in compare() do.
+			for (; i < size; i++)
+			{
+				uint8_t x = uint8_t(Traits<CharType, CharType>::fold_case(a[i]));
+				uint8_t y = uint8_t(Traits<CharType, CharType>::fold_case(b[i]));
+				if (x != y)
+					return x < y ? -1 : +1;
+			}
+
+			return a.size() < b.size() ? -1 : (a.size() > b.size()) ? +1 : 0;
 		}
 	};
 
@@ -318,6 +511,10 @@ public:
 
 	///@}
 
+	/// Function compares two character sequences same way as compare(), but ASCII letters are compared case-insensitively
+	/// (other characters, including non-ASCII letters, are compared as is).
+	int compare_nocase(StringViewBase s) const { return Traits<value_type>::compare_nocase(*this, s); }
+
 	///@{ Function finds the first substring equal to the given character sequence.
 	/// Return value: Position of the first character of the found substring, or npos if no such substring is found
 
@@ -332,8 +529,14 @@ public:
 	{
 		if (s.empty()) return 0;
 
-		while (pos = find(s[0], pos), pos != npos)
+		// Note, first character is searched only in positions, where whole substring could fit.
+		while (pos + s.size() <= size())
 		{
+			const_pointer p = Traits<value_type>::find_first(StringViewBase(_data + pos, size() - pos - s.size() + 1), s[0]);
+			if (p == NULL)
+				break;
+
+			pos = p - data();
 			if (! compare(pos, s.size(), s))
 				return pos;
 
@@ -388,12 +591,8 @@ public:
 
 	size_type find_first_of(StringViewBase s, size_type pos = 0) const
 	{
-		for (iterator i = begin() + pos; i != end(); ++i)
-		{
-			if (s.find(*i) != npos)
-				return i - begin();
-		}
-		return npos;
+		const_pointer p = Traits<value_type>::find_first_of(substr(pos), s, true);
+		return p == NULL ? npos : p - data();
 	}
 
 	size_type find_first_of(const_pointer s, size_type pos, size_type count) const
@@ -415,16 +614,8 @@ public:
 
 	size_type find_last_of(StringViewBase s, size_type pos = npos) const
 	{
-		if (begin() != end())
-		{
-			iterator i = (pos == npos) ? end() - 1 : begin() + pos;
-			do {
-				if (s.find(*i) != npos)
-					return i - begin();
-
-			} while (i-- != begin());
-		}
-		return npos;
+		const_pointer p = Traits<value_type>::find_last_of(substr(0, pos == npos ? npos : pos + 1), s, true);
+		return p == NULL ? npos : p - data();
 	}
 
 	size_type find_last_of(const_pointer s, size_type pos, size_type count) const
@@ -443,12 +634,8 @@ public:
 
 	size_type find_first_not_of(StringViewBase s, size_type pos = 0) const
 	{
-		for (iterator i = begin() + pos; i != end(); ++i)
-		{
-			if (s.find(*i) == npos)
-				return i - begin();
-		}
-		return npos;
+		const_pointer p = Traits<value_type>::find_first_of(substr(pos), s, false);
+		return p == NULL ? npos : p - data();
 	}
 
 	size_type find_first_not_of(value_type c, size_type pos = 0) const
@@ -475,16 +662,8 @@ public:
 
 	size_type find_last_not_of(StringViewBase s, size_type pos = npos) const
 	{
-		if (begin() != end())
-		{
-			iterator i = (pos == npos) ? end() - 1 : begin() + pos;
-			do {
-				if (s.find(*i) == npos)
-					return i - begin();
-
-			} while (i-- != begin());
-		}
-		return npos;
+		const_pointer p = Traits<value_type>::find_last_of(substr(0, pos == npos ? npos : pos + 1), s, false);
+		return p == NULL ? npos : p - data();
 	}
 
 	size_type find_last_not_of(value_type c, size_type pos = npos) const
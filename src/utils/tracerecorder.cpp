@@ -0,0 +1,307 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "utils/tracerecorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <vector>
+#include "utils/jsonstring.h"
+
+namespace netcoredbg
+{
+
+namespace TraceRecorder
+{
+
+namespace Internal
+{
+    std::atomic<bool> enabled(false);
+}
+
+namespace // unnamed namespace
+{
+
+struct event_t
+{
+    // Note, sequence lock, odd value - event is written now, even value - (index + 1) * 2 of written event.
+    std::atomic<uint64_t> seq{0};
+    const char *category;
+    const char *name;
+    uint64_t startUs;
+    uint64_t durationUs;
+    uint32_t tid;
+    char arg[MaxArgLength + 1];
+};
+
+// Note, buffer have only one writer (owner thread) at any time, buffer of finished thread is reused by next new thread,
+// so, buffers count is limited by max count of simultaneously running threads. Buffers are never freed, since export
+// could be called at exit(), when some threads still running.
+struct thread_buffer_t
+{
+    event_t events[ThreadBufferEvents];
+    std::atomic<uint64_t> head{0};      // index of next event
+    std::atomic<uint64_t> clearHead{0}; // events with less indexes are removed by Clear()
+    std::atomic<bool> owned{true};
+    thread_buffer_t *next = nullptr;
+};
+
+struct thread_name_t
+{
+    uint32_t tid;
+    const char *name;
+};
+
+std::mutex &GetRegistryMutex()
+{
+    static std::mutex registryMutex;
+    return registryMutex;
+}
+
+// Note, protected by GetRegistryMutex().
+thread_buffer_t *registryHead = nullptr;
+uint32_t lastTid = 0;
+std::vector<thread_name_t> threadNames;
+std::string exitPath;
+
+// Note, trace time is relative to first use, since trace viewers don't like huge timestamps.
+const std::chrono::steady_clock::time_point &GetEpoch()
+{
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return epoch;
+}
+
+struct thread_state_t
+{
+    thread_buffer_t *buffer = nullptr;
+    uint32_t tid = 0;
+    const char *name = nullptr;
+
+    ~thread_state_t()
+    {
+        if (buffer != nullptr)
+            buffer->owned.store(false, std::memory_order_release);
+    }
+
+    void Init()
+    {
+        std::lock_guard<std::mutex> lock(GetRegistryMutex());
+        tid = ++lastTid;
+        for (thread_buffer_t *it = registryHead; it != nullptr; it = it->next)
+        {
+            bool owned = false;
+            if (it->owned.compare_exchange_strong(owned, true, std::memory_order_acquire))
+            {
+                buffer = it;
+                return;
+            }
+        }
+        buffer = new thread_buffer_t;
+        buffer->next = registryHead;
+        registryHead = buffer;
+    }
+};
+
+thread_local thread_state_t threadState;
+
+thread_state_t &GetThreadState()
+{
+    if (threadState.buffer == nullptr)
+        threadState.Init();
+    return threadState;
+}
+
+void AddThreadName(uint32_t tid, const char *name)
+{
+    std::lock_guard<std::mutex> lock(GetRegistryMutex());
+    threadNames.emplace_back(thread_name_t{tid, name});
+}
+
+void AppendEventJSON(std::string &output, const event_t &event)
+{
+    // Note, categories and names are identifiers or function names, but argument could be any string.
+    output += "{\"cat\":";
+    AppendJsonString(output, event.category);
+    output += ",\"name\":";
+    AppendJsonString(output, event.name);
+    output += ",\"ph\":\"X\",\"pid\":1,\"tid\":";
+    output += std::to_string(event.tid);
+    output += ",\"ts\":";
+    output += std::to_string(event.startUs);
+    output += ",\"dur\":";
+    output += std::to_string(event.durationUs);
+    if (event.arg[0] != '\0')
+    {
+        output += ",\"args\":{\"arg\":";
+        AppendJsonString(output, event.arg);
+        output += "}";
+    }
+    output += "}";
+}
+
+void WriteAtExitHandler()
+{
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(GetRegistryMutex());
+        path = exitPath;
+    }
+    if (!path.empty())
+        WriteChromeJSON(path);
+}
+
+} // unnamed namespace
+
+uint64_t Internal::NowUs()
+{
+    return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - GetEpoch()).count());
+}
+
+void Internal::AddEvent(const char *category, const char *name, const std::string &arg, uint64_t startUs, uint64_t durationUs)
+{
+    thread_state_t &state = GetThreadState();
+    thread_buffer_t &buffer = *state.buffer;
+
+    uint64_t index = buffer.head.load(std::memory_order_relaxed);
+    event_t &event = buffer.events[index % ThreadBufferEvents];
+    event.seq.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    event.category = category;
+    event.name = name;
+    event.startUs = startUs;
+    event.durationUs = durationUs;
+    event.tid = state.tid;
+    size_t argLength = std::min(arg.size(), MaxArgLength);
+    memcpy(event.arg, arg.data(), argLength);
+    event.arg[argLength] = '\0';
+
+    event.seq.store((index + 1) * 2, std::memory_order_release);
+    buffer.head.store(index + 1, std::memory_order_release);
+}
+
+void Enable(bool enable)
+{
+    // Note, initialize epoch before any event.
+    GetEpoch();
+    Internal::enabled.store(enable, std::memory_order_relaxed);
+}
+
+void SetThreadName(const char *name)
+{
+    if (!IsEnabled())
+        return;
+
+    thread_state_t &state = GetThreadState();
+    if (state.name == name)
+        return;
+
+    state.name = name;
+    AddThreadName(state.tid, name);
+}
+
+std::string DumpChromeJSON()
+{
+    std::vector<thread_buffer_t*> buffers;
+    std::vector<thread_name_t> names;
+    {
+        std::lock_guard<std::mutex> lock(GetRegistryMutex());
+        for (thread_buffer_t *it = registryHead; it != nullptr; it = it->next)
+        {
+            buffers.push_back(it);
+        }
+        names = threadNames;
+    }
+
+    std::string output = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+
+    // Note, thread could be renamed (buffer reused or name changed), last name is used by viewers.
+    for (const auto &name : names)
+    {
+        if (!first)
+            output += ",";
+        first = false;
+
+        output += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+        output += std::to_string(name.tid);
+        output += ",\"args\":{\"name\":";
+        AppendJsonString(output, name.name);
+        output += "}}";
+    }
+
+    event_t event;
+    for (thread_buffer_t *buffer : buffers)
+    {
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t start = head > ThreadBufferEvents ? head - ThreadBufferEvents : 0;
+        start = std::max(start, buffer->clearHead.load(std::memory_order_relaxed));
+        for (uint64_t index = start; index < head; index++)
+        {
+            const event_t &source = buffer->events[index % ThreadBufferEvents];
+            uint64_t seq = source.seq.load(std::memory_order_acquire);
+            if (seq != (index + 1) * 2)
+                continue;
+
+            event.category = source.category;
+            event.name = source.name;
+            event.startUs = source.startUs;
+            event.durationUs = source.durationUs;
+            event.tid = source.tid;
+            memcpy(event.arg, source.arg, sizeof(event.arg));
+            event.arg[MaxArgLength] = '\0';
+
+            // Note, event could be overwritten by owner thread during copy, drop it in this case.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (source.seq.load(std::memory_order_relaxed) != seq)
+                continue;
+
+            if (!first)
+                output += ",";
+            first = false;
+            AppendEventJSON(output, event);
+        }
+    }
+
+    output += "]}";
+    return output;
+}
+
+bool WriteChromeJSON(const std::string &path)
+{
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+
+    std::string json = DumpChromeJSON();
+    file.write(json.data(), json.size());
+    return !file.fail();
+}
+
+void WriteAtExit(const std::string &path)
+{
+    // Note, registry must be initialized before handler registration, since statics are destroyed after handlers call.
+    std::lock_guard<std::mutex> lock(GetRegistryMutex());
+    bool registered = !exitPath.empty();
+    exitPath = path;
+    if (!registered)
+        atexit(WriteAtExitHandler);
+}
+
+void Clear()
+{
+    std::lock_guard<std::mutex> lock(GetRegistryMutex());
+    for (thread_buffer_t *it = registryHead; it != nullptr; it = it->next)
+    {
+        it->clearHead.store(it->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+} // namespace TraceRecorder
+
+} // namespace netcoredbg
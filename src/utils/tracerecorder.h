@@ -0,0 +1,98 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace netcoredbg
+{
+
+// Process-wide in-memory recorder of debugger internal activity timelines (callbacks, protocol commands, evals, symbols load),
+// aimed to find stalls between debugger threads. Each thread write events into own fixed size ring buffer without locks,
+// oldest events are overwritten. Recorded events could be exported in Chrome trace JSON format (Trace Event Format), that
+// is also supported by Perfetto UI (ui.perfetto.dev) and chrome://tracing.
+// Recorder is disabled by default, in this case event cost is one relaxed atomic load and branch only (no clock calls).
+namespace TraceRecorder
+{
+    namespace Internal
+    {
+        extern std::atomic<bool> enabled;
+
+        uint64_t NowUs();
+        void AddEvent(const char *category, const char *name, const std::string &arg, uint64_t startUs, uint64_t durationUs);
+    }
+
+    inline bool IsEnabled()
+    {
+        return Internal::enabled.load(std::memory_order_relaxed);
+    }
+
+    void Enable(bool enable);
+
+    // Name current thread in trace, name must be string literal (or have static storage duration), it is stored as is.
+    void SetThreadName(const char *name);
+
+    // Record scope as complete event, category and name must be string literals (or have static storage duration).
+    // Note, argument is truncated to MaxArgLength during record.
+    class ScopedEvent
+    {
+    public:
+
+        ScopedEvent(const char *category, const char *name) :
+            m_category(category),
+            m_name(name),
+            m_enabled(IsEnabled()),
+            m_start(m_enabled ? Internal::NowUs() : 0)
+        {}
+
+        ScopedEvent(const char *category, const char *name, const std::string &arg) :
+            ScopedEvent(category, name)
+        {
+            if (m_enabled)
+                m_arg = arg;
+        }
+
+        ~ScopedEvent()
+        {
+            if (m_enabled)
+                Internal::AddEvent(m_category, m_name, m_arg, m_start, Internal::NowUs() - m_start);
+        }
+
+        // Argument could be known only during scope execution.
+        void SetArg(const std::string &arg)
+        {
+            if (m_enabled)
+                m_arg = arg;
+        }
+
+    private:
+
+        ScopedEvent(const ScopedEvent&) = delete;
+        ScopedEvent& operator=(const ScopedEvent&) = delete;
+
+        const char *m_category;
+        const char *m_name;
+        bool m_enabled;
+        uint64_t m_start;
+        std::string m_arg;
+    };
+
+    const size_t MaxArgLength = 47;
+    const size_t ThreadBufferEvents = 4096;
+
+    // Return Chrome trace JSON object with all recorded events of all threads.
+    std::string DumpChromeJSON();
+    // Return false in case file can't be written.
+    bool WriteChromeJSON(const std::string &path);
+    // Write trace at process exit (normal return from main() or exit() call).
+    void WriteAtExit(const std::string &path);
+    void Clear();
+
+} // namespace TraceRecorder
+
+} // namespace netcoredbg
@@ -4,27 +4,313 @@
 
 #include "utils/utf.h"
 
-#include <codecvt>
-#include <locale>
+#include <cstdint>
+
+#if !defined(UTF_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UTF_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define UTF_NEON
+#endif
+#endif // UTF_NO_SIMD
 
 namespace netcoredbg
 {
 
-static std::wstring_convert<std::codecvt_utf8_utf16<WCHAR>,WCHAR> convert;
+static_assert(sizeof(WCHAR) == sizeof(uint16_t), "WCHAR must be UTF-16 code unit");
+
+namespace
+{
+
+const uint16_t ReplacementChar = 0xFFFD;
+
+// Most of strings (metadata names, paths, variables values) are ASCII only, vectorized code convert blocks of
+// 16 ASCII characters at once and stop at first block with non-ASCII character, which is converted by scalar code.
+const size_t BlockSize = 16;
+
+#if defined(UTF_SSE2)
+
+void AsciiToUtf8(const uint16_t *&src, const uint16_t *end, char *&dst)
+{
+    const __m128i nonAsciiMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+    const __m128i zero = _mm_setzero_si128();
+    for (; size_t(end - src) >= BlockSize; src += BlockSize, dst += BlockSize)
+    {
+        const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + BlockSize / 2));
+        const __m128i nonAscii = _mm_and_si128(_mm_or_si128(low, high), nonAsciiMask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, zero)) != 0xFFFF)
+            return;
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(low, high));
+    }
+}
+
+void AsciiToUtf16(const unsigned char *&src, const unsigned char *end, uint16_t *&dst)
+{
+    const __m128i zero = _mm_setzero_si128();
+    for (; size_t(end - src) >= BlockSize; src += BlockSize, dst += BlockSize)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        if (_mm_movemask_epi8(block) != 0)
+            return;
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi8(block, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + BlockSize / 2), _mm_unpackhi_epi8(block, zero));
+    }
+}
+
+#elif defined(UTF_NEON)
+
+void AsciiToUtf8(const uint16_t *&src, const uint16_t *end, char *&dst)
+{
+    const uint16x8_t nonAsciiMask = vdupq_n_u16(0xFF80);
+    for (; size_t(end - src) >= BlockSize; src += BlockSize, dst += BlockSize)
+    {
+        const uint16x8_t low = vld1q_u16(src);
+        const uint16x8_t high = vld1q_u16(src + BlockSize / 2);
+        const uint64x2_t nonAscii = vreinterpretq_u64_u16(vandq_u16(vorrq_u16(low, high), nonAsciiMask));
+        if ((vgetq_lane_u64(nonAscii, 0) | vgetq_lane_u64(nonAscii, 1)) != 0)
+            return;
+
+        vst1q_u8(reinterpret_cast<uint8_t*>(dst), vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+    }
+}
+
+void AsciiToUtf16(const unsigned char *&src, const unsigned char *end, uint16_t *&dst)
+{
+    for (; size_t(end - src) >= BlockSize; src += BlockSize, dst += BlockSize)
+    {
+        const uint8x16_t block = vld1q_u8(src);
+        const uint64x2_t block64 = vreinterpretq_u64_u8(block);
+        if (((vgetq_lane_u64(block64, 0) | vgetq_lane_u64(block64, 1)) & 0x8080808080808080ULL) != 0)
+            return;
+
+        vst1q_u16(dst, vmovl_u8(vget_low_u8(block)));
+        vst1q_u16(dst + BlockSize / 2, vmovl_u8(vget_high_u8(block)));
+    }
+}
+
+#else
+
+void AsciiToUtf8(const uint16_t *&, const uint16_t *, char *&) {}
+void AsciiToUtf16(const unsigned char *&, const unsigned char *, uint16_t *&) {}
+
+#endif
+
+// Convert one code point (code unit or surrogate pair).
+inline void EncodeCodePoint(const uint16_t *&src, const uint16_t *end, char *&dst)
+{
+    uint32_t cp = *src++;
+    if (cp < 0x80)
+    {
+        *dst++ = static_cast<char>(cp);
+        return;
+    }
+
+    if (cp >= 0xD800 && cp <= 0xDFFF)
+    {
+        if (cp <= 0xDBFF && src != end && *src >= 0xDC00 && *src <= 0xDFFF)
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (*src++ - 0xDC00);
+        else
+            cp = ReplacementChar;
+    }
+
+    if (cp < 0x800)
+    {
+        *dst++ = static_cast<char>(0xC0 | (cp >> 6));
+    }
+    else if (cp < 0x10000)
+    {
+        *dst++ = static_cast<char>(0xE0 | (cp >> 12));
+        *dst++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    }
+    else
+    {
+        *dst++ = static_cast<char>(0xF0 | (cp >> 18));
+        *dst++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        *dst++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    }
+    *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+}
+
+// Convert one UTF-8 sequence. Note, in case of broken sequence only lead byte is replaced, so, following
+// bytes are checked again, but overlong sequences and encoded surrogates are replaced as whole sequence.
+inline void DecodeCodePoint(const unsigned char *&src, const unsigned char *end, uint16_t *&dst)
+{
+    const unsigned char lead = *src++;
+    if (lead < 0x80)
+    {
+        *dst++ = lead;
+        return;
+    }
+
+    size_t count;
+    uint32_t cp;
+    uint32_t min;
+    if ((lead & 0xE0) == 0xC0)
+    {
+        count = 1;
+        cp = lead & 0x1F;
+        min = 0x80;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        count = 2;
+        cp = lead & 0x0F;
+        min = 0x800;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        count = 3;
+        cp = lead & 0x07;
+        min = 0x10000;
+    }
+    else
+    {
+        *dst++ = ReplacementChar;
+        return;
+    }
+
+    if (size_t(end - src) < count)
+    {
+        *dst++ = ReplacementChar;
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if ((src[i] & 0xC0) != 0x80)
+        {
+            *dst++ = ReplacementChar;
+            return;
+        }
+        cp = (cp << 6) | (src[i] & 0x3F);
+    }
+    src += count;
+
+    if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+    {
+        *dst++ = ReplacementChar;
+    }
+    else if (cp >= 0x10000)
+    {
+        cp -= 0x10000;
+        *dst++ = static_cast<uint16_t>(0xD800 + (cp >> 10));
+        *dst++ = static_cast<uint16_t>(0xDC00 + (cp & 0x3FF));
+    }
+    else
+    {
+        *dst++ = static_cast<uint16_t>(cp);
+    }
+}
+
+} // unnamed namespace
+
+size_t to_utf8(const WCHAR *wstr, size_t len, char *buf)
+{
+    const uint16_t *src = reinterpret_cast<const uint16_t*>(wstr);
+    const uint16_t *end = src + len;
+    char *dst = buf;
+
+    while (src != end)
+    {
+        AsciiToUtf8(src, end, dst);
+
+        // Note, surrogate pair could cross block end, scalar code will convert it as whole.
+        const uint16_t *blockEnd = size_t(end - src) > BlockSize ? src + BlockSize : end;
+        while (src < blockEnd)
+        {
+            EncodeCodePoint(src, end, dst);
+        }
+    }
+
+    return dst - buf;
+}
+
+size_t to_utf16(const char *utf8, size_t len, WCHAR *buf)
+{
+    const unsigned char *src = reinterpret_cast<const unsigned char*>(utf8);
+    const unsigned char *end = src + len;
+    uint16_t *dst = reinterpret_cast<uint16_t*>(buf);
+
+    while (src != end)
+    {
+        AsciiToUtf16(src, end, dst);
+
+        const unsigned char *blockEnd = size_t(end - src) > BlockSize ? src + BlockSize : end;
+        while (src < blockEnd)
+        {
+            DecodeCodePoint(src, end, dst);
+        }
+    }
+
+    return dst - reinterpret_cast<uint16_t*>(buf);
+}
+
+void append_utf8(std::string &output, const WCHAR *wstr, size_t len)
+{
+    const size_t size = output.size();
+    output.resize(size + Utf8MaxSize(len));
+    output.resize(size + to_utf8(wstr, len, &output[size]));
+}
+
+void append_utf8(std::string &output, const WCHAR *wstr)
+{
+    append_utf8(output, wstr, std::char_traits<WCHAR>::length(wstr));
+}
+
+void append_utf8(std::string &output, WSTRING_VIEW wstr)
+{
+    append_utf8(output, wstr.data(), wstr.size());
+}
+
+void assign_utf8(std::string &output, const WCHAR *wstr)
+{
+    output.clear();
+    append_utf8(output, wstr);
+}
+
+void assign_utf8(std::string &output, WSTRING_VIEW wstr)
+{
+    output.clear();
+    append_utf8(output, wstr.data(), wstr.size());
+}
+
+void assign_utf16(WSTRING &output, Utility::string_view utf8)
+{
+    output.resize(utf8.size());
+    output.resize(to_utf16(utf8.data(), utf8.size(), &output[0]));
+}
 
 std::string to_utf8(const WCHAR *wstr)
 {
-    return convert.to_bytes(wstr);
+    std::string result;
+    append_utf8(result, wstr);
+    return result;
 }
 
 std::string to_utf8(WCHAR wch)
 {
-    return convert.to_bytes(wch);
+    std::string result;
+    append_utf8(result, &wch, 1);
+    return result;
+}
+
+std::string to_utf8(WSTRING_VIEW wstr)
+{
+    std::string result;
+    append_utf8(result, wstr);
+    return result;
 }
 
 WSTRING to_utf16(const std::string &utf8)
 {
-    return convert.from_bytes(utf8);
+    WSTRING result;
+    assign_utf16(result, utf8);
+    return result;
 }
 
 } // namespace netcoredbg
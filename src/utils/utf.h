@@ -5,6 +5,7 @@
 
 #include <string>
 #include <vector>
+#include "utils/string_view.h"
 
 #ifdef _MSC_VER
 #include <wtypes.h>
@@ -24,10 +25,33 @@ typedef std::wstring WSTRING;
 #else
 typedef std::u16string WSTRING;
 #endif
+typedef Utility::StringViewBase<WCHAR> WSTRING_VIEW;
 
+// Note, all conversion functions have no shared state (no static converters or locale objects),
+// so, they could be called concurrently from any thread without locks.
+
+// Note, conversion never fails, unpaired surrogates (UTF-16) and invalid sequences (UTF-8) are replaced by U+FFFD.
 std::string to_utf8(const WCHAR *wstr);
 WSTRING to_utf16(const std::string &utf8);
 std::string to_utf8(WCHAR wch);
+std::string to_utf8(WSTRING_VIEW wstr);
+
+// Conversion into caller-provided buffer, return number of written code units. Buffer must have at least
+// Utf8MaxSize(len) bytes for to_utf8() and `len` code units for to_utf16(), no terminating zero written.
+inline size_t Utf8MaxSize(size_t len) { return len * 3; }
+size_t to_utf8(const WCHAR *wstr, size_t len, char *buf);
+size_t to_utf16(const char *utf8, size_t len, WCHAR *buf);
+
+// Append converted string to `output`, in order to reuse `output` memory.
+void append_utf8(std::string &output, const WCHAR *wstr, size_t len);
+void append_utf8(std::string &output, const WCHAR *wstr);
+void append_utf8(std::string &output, WSTRING_VIEW wstr);
+
+// Replace `output` content by converted string, `output` memory is reused (no allocation in case
+// `output` capacity is enough), should be used for strings converted in loops.
+void assign_utf8(std::string &output, const WCHAR *wstr);
+void assign_utf8(std::string &output, WSTRING_VIEW wstr);
+void assign_utf16(WSTRING &output, Utility::string_view utf8);
 
 template <typename CharT, size_t Size>
 bool starts_with(const CharT *left, const CharT (&right)[Size])
@@ -0,0 +1,428 @@
+using System;
+using System.IO;
+using System.Diagnostics;
+using System.Collections.Generic;
+using System.Reflection;
+
+using NetcoreDbgTest;
+using NetcoreDbgTest.MI;
+using NetcoreDbgTest.Script;
+
+namespace NetcoreDbgTest.Script
+{
+    // Scenarios sizes and timing limits, shared by debuggee and control script.
+    // Note, sizes are chosen in order to fit into default test timeout, limits are generous and intended
+    // to catch significant regressions only, exact latencies are printed at the end of test.
+    static class Scenario
+    {
+        public const int Modules = 500;
+        public const int Breakpoints = 1000;
+        public const int Steps = 1000;
+        public const int ArrayLength = 100000;
+        public const int ArrayPage = 1000;
+        public const int ConditionalHits = 10000;
+        public const int Exceptions = 10000;
+
+        public const double MaxRequestP99 = 1000; // ms
+        public const double MaxStepP99 = 1000; // ms
+        public const double MaxModuleLoadAverage = 50; // ms
+        public const double MaxConditionCheckAverage = 20; // ms
+        public const double MaxExceptionAverage = 10; // ms
+    }
+
+    class Context
+    {
+        public void Prepare(string caller_trace)
+        {
+            // Explicitly enable JMC for this test.
+            Assert.Equal(MIResultClass.Done,
+                         MIDebugger.Request("-gdb-set just-my-code 1").Class,
+                         @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            Assert.Equal(MIResultClass.Done,
+                         MIDebugger.Request("-file-exec-and-symbols " + ControlInfo.CorerunPath).Class,
+                         @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            Assert.Equal(MIResultClass.Done,
+                         MIDebugger.Request("-exec-arguments " + ControlInfo.TargetAssemblyPath).Class,
+                         @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            Assert.Equal(MIResultClass.Running,
+                         MIDebugger.Request("-exec-run").Class,
+                         @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        bool IsStoppedEvent(MIOutOfBandRecord record)
+        {
+            if (record.Type != MIOutOfBandRecordType.Async) {
+                return false;
+            }
+
+            var asyncRecord = (MIAsyncRecord)record;
+
+            if (asyncRecord.Class != MIAsyncRecordClass.Exec ||
+                asyncRecord.Output.Class != MIAsyncOutputClass.Stopped) {
+                return false;
+            }
+
+            return true;
+        }
+
+        public void WasEntryPointHit(string caller_trace)
+        {
+            Func<MIOutOfBandRecord, bool> filter = (record) => {
+                if (!IsStoppedEvent(record)) {
+                    return false;
+                }
+
+                var output = ((MIAsyncRecord)record).Output;
+                var reason = (MIConst)output["reason"];
+
+                if (reason.CString != "entry-point-hit") {
+                    return false;
+                }
+
+                var frame = (MITuple)output["frame"];
+                var func = (MIConst)frame["func"];
+                if (func.CString == ControlInfo.TestName + ".Program.Main()") {
+                    return true;
+                }
+
+                return false;
+            };
+
+            Assert.True(MIDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasBreakpointHit(string caller_trace, string bpName)
+        {
+            var bp = (LineBreakpoint)ControlInfo.Breakpoints[bpName];
+
+            Func<MIOutOfBandRecord, bool> filter = (record) => {
+                if (!IsStoppedEvent(record)) {
+                    return false;
+                }
+
+                var output = ((MIAsyncRecord)record).Output;
+                var reason = (MIConst)output["reason"];
+
+                if (reason.CString != "breakpoint-hit") {
+                    return false;
+                }
+
+                var frame = (MITuple)output["frame"];
+                var fileName = (MIConst)frame["file"];
+                var line = ((MIConst)frame["line"]).Int;
+
+                if (fileName.CString == bp.FileName &&
+                    line == bp.NumLine) {
+                    return true;
+                }
+
+                return false;
+            };
+
+            Assert.True(MIDebugger.IsEventReceived(filter),
+                        @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasStep(string caller_trace)
+        {
+            Func<MIOutOfBandRecord, bool> filter = (record) => {
+                if (!IsStoppedEvent(record)) {
+                    return false;
+                }
+
+                var output = ((MIAsyncRecord)record).Output;
+                var reason = (MIConst)output["reason"];
+
+                return reason.CString == "end-stepping-range";
+            };
+
+            Assert.True(MIDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasExit(string caller_trace)
+        {
+            Func<MIOutOfBandRecord, bool> filter = (record) => {
+                if (!IsStoppedEvent(record)) {
+                    return false;
+                }
+
+                var output = ((MIAsyncRecord)record).Output;
+                var reason = (MIConst)output["reason"];
+
+                if (reason.CString != "exited") {
+                    return false;
+                }
+
+                var exitCode = (MIConst)output["exit-code"];
+
+                if (exitCode.CString == "0") {
+                    return true;
+                }
+
+                return false;
+            };
+
+            Assert.True(MIDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public string EnableBreakpoint(string caller_trace, string bpName, int lineOffset = 0, string condition = null)
+        {
+            Breakpoint bp = ControlInfo.Breakpoints[bpName];
+
+            Assert.Equal(BreakpointType.Line, bp.Type, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            var lbp = (LineBreakpoint)bp;
+
+            var res = MIDebugger.Request("-break-insert -f " +
+                                         (condition != null ? "-c \"" + condition + "\" " : "") +
+                                         lbp.FileName + ":" + (lbp.NumLine + lineOffset));
+            Assert.Equal(MIResultClass.Done, res.Class, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            return ((MIConst)((MITuple)res["bkpt"])["number"]).CString;
+        }
+
+        public void DeleteBreakpoint(string caller_trace, string id)
+        {
+            Assert.Equal(MIResultClass.Done,
+                         MIDebugger.Request("-break-delete " + id).Class,
+                         @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void Continue(string caller_trace)
+        {
+            Assert.Equal(MIResultClass.Running,
+                         MIDebugger.Request("-exec-continue").Class,
+                         @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void StepOver(string caller_trace)
+        {
+            Assert.Equal(MIResultClass.Running,
+                         MIDebugger.Request("-exec-next").Class,
+                         @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void ContinueTo(string caller_trace, string bpName, string scenarioName)
+        {
+            MIDebugger.Latencies.Measure(scenarioName, () => {
+                Continue(caller_trace);
+                WasBreakpointHit(caller_trace, bpName);
+            });
+        }
+
+        public void BreakpointsScenario(string caller_trace)
+        {
+            // Note, breakpoints are set to method that never called, so, debuggee will not stop at them.
+            var ids = new List<string>();
+            for (int i = 0; i < Scenario.Breakpoints; i++) {
+                ids.Add(EnableBreakpoint(caller_trace, "unused_code", i % 10));
+            }
+            foreach (var id in ids) {
+                DeleteBreakpoint(caller_trace, id);
+            }
+
+            CheckP99(caller_trace, "-break-insert", Scenario.MaxRequestP99);
+            CheckP99(caller_trace, "-break-delete", Scenario.MaxRequestP99);
+        }
+
+        public void SteppingScenario(string caller_trace)
+        {
+            for (int i = 0; i < Scenario.Steps; i++) {
+                MIDebugger.Latencies.Measure("scenario: step over", () => {
+                    StepOver(caller_trace);
+                    WasStep(caller_trace);
+                });
+            }
+
+            CheckP99(caller_trace, "-exec-next", Scenario.MaxRequestP99);
+            CheckP99(caller_trace, "scenario: step over", Scenario.MaxStepP99);
+        }
+
+        public void ArrayScenario(string caller_trace)
+        {
+            var res = MIDebugger.Request("-var-create - * \"array\"");
+            Assert.Equal(MIResultClass.Done, res.Class, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            string varName = ((MIConst)res["name"]).CString;
+            Assert.Equal(Scenario.ArrayLength, ((MIConst)res["numchild"]).Int, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            for (int start = 0; start < Scenario.ArrayLength; start += Scenario.ArrayPage) {
+                res = MIDebugger.Request("-var-list-children --simple-values \"" + varName + "\" " +
+                                         start + " " + (start + Scenario.ArrayPage));
+                Assert.Equal(MIResultClass.Done, res.Class, @"__FILE__:__LINE__"+"\n"+caller_trace);
+                Assert.Equal(Scenario.ArrayPage, ((MIList)res["children"]).ToArray().Length, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            }
+
+            CheckP99(caller_trace, "-var-create", Scenario.MaxRequestP99);
+            CheckP99(caller_trace, "-var-list-children", Scenario.MaxRequestP99);
+        }
+
+        public void CheckP99(string caller_trace, string name, double limit)
+        {
+            double p99 = MIDebugger.Latencies.Percentile(name, 99);
+            Assert.True(p99 <= limit, @"__FILE__:__LINE__"+"\n"+caller_trace + "\n" +
+                        name + " p99 " + p99 + " ms exceeds " + limit + " ms");
+        }
+
+        public void CheckAverage(string caller_trace, string name, int count, double limit)
+        {
+            double average = MIDebugger.Latencies.Total(name) / count;
+            Assert.True(average <= limit, @"__FILE__:__LINE__"+"\n"+caller_trace + "\n" +
+                        name + " average " + average + " ms exceeds " + limit + " ms");
+        }
+
+        public void ReportLatencies()
+        {
+            MIDebugger.Latencies.Report();
+        }
+
+        public void DebuggerExit(string caller_trace)
+        {
+            Assert.Equal(MIResultClass.Exit,
+                         MIDebugger.Request("-gdb-exit").Class,
+                         @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public Context(ControlInfo controlInfo, NetcoreDbgTestCore.DebuggerClient debuggerClient)
+        {
+            ControlInfo = controlInfo;
+            MIDebugger = new MIDebugger(debuggerClient);
+        }
+
+        ControlInfo ControlInfo;
+        public MIDebugger MIDebugger { get; private set; }
+        public string conditionalId;
+    }
+}
+
+namespace MITestPerformance
+{
+    class Program
+    {
+        static void UnusedCode()
+        {
+            int value = 0;                                      Label.Breakpoint("unused_code");
+            value++;
+            value++;
+            value++;
+            value++;
+            value++;
+            value++;
+            value++;
+            value++;
+            Console.WriteLine(value);
+        }
+
+        static void Main(string[] args)
+        {
+            Label.Checkpoint("init", "modules", (Object context) => {
+                Context Context = (Context)context;
+                Context.Prepare(@"__FILE__:__LINE__");
+                Context.WasEntryPointHit(@"__FILE__:__LINE__");
+                Context.EnableBreakpoint(@"__FILE__:__LINE__", "modules_start");
+                Context.EnableBreakpoint(@"__FILE__:__LINE__", "modules_done");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            var assemblies = new List<System.Reflection.Emit.AssemblyBuilder>();    Label.Breakpoint("modules_start");
+
+            Label.Checkpoint("modules", "steps", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "modules_start");
+                Context.ContinueTo(@"__FILE__:__LINE__", "modules_done", "scenario: load modules");
+                Context.CheckAverage(@"__FILE__:__LINE__", "scenario: load modules", Scenario.Modules, Scenario.MaxModuleLoadAverage);
+
+                Context.BreakpointsScenario(@"__FILE__:__LINE__");
+
+                Context.EnableBreakpoint(@"__FILE__:__LINE__", "steps_start");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            // Note, each dynamic module load is reported to debugger by runtime.
+            for (int i = 0; i < Scenario.Modules; i++)
+            {
+                var assembly = System.Reflection.Emit.AssemblyBuilder.DefineDynamicAssembly(new AssemblyName("Dynamic" + i),
+                                                                                System.Reflection.Emit.AssemblyBuilderAccess.Run);
+                assembly.DefineDynamicModule("Dynamic" + i).DefineType("Type" + i).CreateType();
+                assemblies.Add(assembly);
+            }
+
+            Console.WriteLine(assemblies.Count);                Label.Breakpoint("modules_done");
+
+            int sum = 0;                                        Label.Breakpoint("steps_start");
+
+            Label.Checkpoint("steps", "array", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "steps_start");
+                Context.SteppingScenario(@"__FILE__:__LINE__");
+
+                Context.EnableBreakpoint(@"__FILE__:__LINE__", "array_ready");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            for (int i = 0; i < Scenario.Steps; i++)
+            {
+                sum += i;
+            }
+
+            int[] array = new int[Scenario.ArrayLength];
+            for (int i = 0; i < array.Length; i++)
+            {
+                array[i] = i;
+            }
+            Console.WriteLine(array.Length);                    Label.Breakpoint("array_ready");
+
+            Label.Checkpoint("array", "conditional", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "array_ready");
+                Context.ArrayScenario(@"__FILE__:__LINE__");
+
+                Context.conditionalId = Context.EnableBreakpoint(@"__FILE__:__LINE__", "conditional", 0, "i == " + (Scenario.ConditionalHits - 1));
+                Context.ContinueTo(@"__FILE__:__LINE__", "conditional", "scenario: conditional breakpoint");
+            });
+
+            for (int i = 0; i < Scenario.ConditionalHits; i++)
+            {
+                sum += i;                                       Label.Breakpoint("conditional");
+            }
+
+            Label.Checkpoint("conditional", "exceptions", (Object context) => {
+                Context Context = (Context)context;
+                Context.CheckAverage(@"__FILE__:__LINE__", "scenario: conditional breakpoint", Scenario.ConditionalHits, Scenario.MaxConditionCheckAverage);
+                Context.DeleteBreakpoint(@"__FILE__:__LINE__", Context.conditionalId);
+
+                Context.EnableBreakpoint(@"__FILE__:__LINE__", "exceptions_done");
+                Context.ContinueTo(@"__FILE__:__LINE__", "exceptions_done", "scenario: first-chance exceptions");
+            });
+
+            for (int i = 0; i < Scenario.Exceptions; i++)
+            {
+                try
+                {
+                    throw new InvalidOperationException();
+                }
+                catch (InvalidOperationException)
+                {
+                    sum++;
+                }
+            }
+
+            Console.WriteLine(sum);                             Label.Breakpoint("exceptions_done");
+
+            Label.Checkpoint("exceptions", "finish", (Object context) => {
+                Context Context = (Context)context;
+                Context.CheckAverage(@"__FILE__:__LINE__", "scenario: first-chance exceptions", Scenario.Exceptions, Scenario.MaxExceptionAverage);
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            Label.Checkpoint("finish", "", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasExit(@"__FILE__:__LINE__");
+                Context.ReportLatencies();
+                Context.DebuggerExit(@"__FILE__:__LINE__");
+            });
+        }
+    }
+}
@@ -1,4 +1,5 @@
 using System;
+using System.Diagnostics;
 using System.Collections.Generic;
 using NetcoreDbgTestCore;
 using NetcoreDbgTestCore.MI;
@@ -10,6 +11,7 @@ namespace NetcoreDbgTest.MI
         public MIResultRecord Request(string command, int timeout = -1)
         {
             MIResultRecord resultRecord = null;
+            var stopwatch = Stopwatch.StartNew();
 
             Logger.LogLine("> " + command);
 
@@ -45,9 +47,21 @@ namespace NetcoreDbgTest.MI
                 }
             }
 
+            Latencies.Add(RequestName(command), stopwatch.Elapsed);
             return resultRecord;
         }
 
+        // Command name without token and arguments, for example, "-exec-next" for "5-exec-next --thread 1".
+        static string RequestName(string command)
+        {
+            int start = 0;
+            while (start < command.Length && Char.IsDigit(command[start])) {
+                start++;
+            }
+            int end = command.IndexOf(' ', start);
+            return end == -1 ? command.Substring(start) : command.Substring(start, end - start);
+        }
+
         void ReceiveEvents(int timeout = -1)
         {
             string[] response = DebuggerClient.Receive(timeout);
@@ -95,6 +109,8 @@ namespace NetcoreDbgTest.MI
             DebuggerClient = debuggerClient;
         }
 
+        public RequestLatencies Latencies = new RequestLatencies();
+
         Queue<MIOutOfBandRecord> EventQueue = new Queue<MIOutOfBandRecord>();
         Logger Logger = new Logger();
         MIParser MIParser = new MIParser();
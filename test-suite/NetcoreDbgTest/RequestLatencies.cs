@@ -0,0 +1,65 @@
+using System;
+using System.Linq;
+using System.Diagnostics;
+using System.Collections.Generic;
+
+namespace NetcoreDbgTest
+{
+    // Latencies of protocol requests (and measured scenario operations), collected per request name,
+    // in order to report p50/p99 and check timing assertions in performance scenarios.
+    public class RequestLatencies
+    {
+        public void Add(string name, TimeSpan time)
+        {
+            List<double> list;
+            if (!Latencies.TryGetValue(name, out list)) {
+                list = new List<double>();
+                Latencies.Add(name, list);
+            }
+            list.Add(time.TotalMilliseconds);
+        }
+
+        public void Measure(string name, Action action)
+        {
+            var stopwatch = Stopwatch.StartNew();
+            action();
+            Add(name, stopwatch.Elapsed);
+        }
+
+        public int Count(string name)
+        {
+            List<double> list;
+            return Latencies.TryGetValue(name, out list) ? list.Count : 0;
+        }
+
+        // Nearest-rank percentile in milliseconds, `percent` is 0..100.
+        public double Percentile(string name, double percent)
+        {
+            List<double> list;
+            if (!Latencies.TryGetValue(name, out list) || list.Count == 0) {
+                return 0;
+            }
+
+            var sorted = list.OrderBy(x => x).ToList();
+            int rank = (int)Math.Ceiling(percent / 100 * sorted.Count);
+            return sorted[Math.Min(Math.Max(rank, 1), sorted.Count) - 1];
+        }
+
+        public double Total(string name)
+        {
+            List<double> list;
+            return Latencies.TryGetValue(name, out list) ? list.Sum() : 0;
+        }
+
+        public void Report()
+        {
+            Console.WriteLine("{0,-40} {1,8} {2,12} {3,12} {4,12}", "request", "count", "p50 (ms)", "p99 (ms)", "max (ms)");
+            foreach (var item in Latencies.OrderBy(x => x.Key)) {
+                Console.WriteLine("{0,-40} {1,8} {2,12:F3} {3,12:F3} {4,12:F3}",
+                                  item.Key, item.Value.Count, Percentile(item.Key, 50), Percentile(item.Key, 99), item.Value.Max());
+            }
+        }
+
+        Dictionary<string, List<double>> Latencies = new Dictionary<string, List<double>>();
+    }
+}
@@ -1,5 +1,6 @@
 using System;
 using System.IO;
+using System.Diagnostics;
 using System.Collections.Generic;
 using NetcoreDbgTestCore;
 using NetcoreDbgTestCore.VSCode;
@@ -56,6 +57,7 @@ namespace NetcoreDbgTest.VSCode
         public VSCodeResult Request(Request command, int timeout = -1)
         {
             command.seq = RequestSeq++;
+            var stopwatch = Stopwatch.StartNew();
             string stringJSON = JsonConvert.SerializeObject(command,
                                                             Formatting.None,
                                                             new JsonSerializerSettings { 
@@ -77,10 +79,11 @@ namespace NetcoreDbgTest.VSCode
                 if (isResponseContainProperty(line, "type", "response"))
                 {
                     Logger.LogLine("<- (R) " + line);
-                    if ((Int64)GetResponsePropertyValue(line, "request_seq") == command.seq)
-                        return new VSCodeResult((bool)GetResponsePropertyValue(line, "success"), line);
-                    else
+                    if ((Int64)GetResponsePropertyValue(line, "request_seq") != command.seq)
                         throw new WrongResponseSequence();
+
+                    Latencies.Add(command.command, stopwatch.Elapsed);
+                    return new VSCodeResult((bool)GetResponsePropertyValue(line, "success"), line);
                 } else {
                     Logger.LogLine("<- (E) " + line);
                     EventQueue.Enqueue(line);
@@ -131,6 +134,8 @@ namespace NetcoreDbgTest.VSCode
             DebuggerClient = debuggerClient;
         }
 
+        public RequestLatencies Latencies = new RequestLatencies();
+
         Queue<string> EventQueue = new Queue<string>();
         Logger Logger = new Logger();
         DebuggerClient DebuggerClient;
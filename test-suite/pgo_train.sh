@@ -0,0 +1,69 @@
+#!/bin/bash
+
+# Build profile-guided and link-time optimized netcoredbg:
+#  1. build instrumented debugger (PGO=generate) in BUILD_DIR;
+#  2. run training scenarios (attach, stepping, modules load storm, evaluation) by run_tests.sh;
+#  3. merge collected profiles and rebuild debugger in same BUILD_DIR with PGO=use.
+# Note, same build directory is used for both builds, since gcc bind profiles to object files paths.
+#
+# Usage: pgo_train.sh [cmake options...]
+# Environment: BUILD_DIR (default ../build-pgo), INSTALL_DIR (default BUILD_DIR/install), TIMEOUT for run_tests.sh.
+
+set -e
+
+SCRIPTDIR=$(cd "$(dirname "$0")"; pwd)
+: ${BUILD_DIR:="$SCRIPTDIR/../build-pgo"}
+: ${INSTALL_DIR:="$BUILD_DIR/install"}
+: ${TIMEOUT:=600}
+
+PROFILE_DIR="$BUILD_DIR/pgo-profiles"
+TRAIN_TESTS=(
+    "VSCodeTestAttach"
+    "MITestStepping"
+    "VSCodeTestStepping"
+    "MITestPerformance"
+    "MITestEvaluate"
+    "VSCodeTestEvaluate"
+)
+
+CC_VERSION=$(${CC:-cc} --version 2>/dev/null | head -n 1)
+if [[ "$CC_VERSION" == *clang* ]]; then
+    IS_CLANG=1
+    PROFILE_DATA="$PROFILE_DIR/netcoredbg.profdata"
+    PGO_PROFILE_GENERATE=""
+else
+    IS_CLANG=0
+    PROFILE_DATA="$PROFILE_DIR"
+    PGO_PROFILE_GENERATE="$PROFILE_DIR"
+fi
+
+rm -rf "$PROFILE_DIR"
+mkdir -p "$BUILD_DIR" "$PROFILE_DIR"
+
+echo "=== Build instrumented debugger"
+cmake -S "$SCRIPTDIR/.." -B "$BUILD_DIR" "$@" \
+    -DCMAKE_BUILD_TYPE=Release -DCMAKE_INSTALL_PREFIX="$INSTALL_DIR" \
+    -DLTO=ON -DPGO=generate -DPGO_PROFILE="$PGO_PROFILE_GENERATE"
+cmake --build "$BUILD_DIR" --target install -j"$(nproc)"
+
+echo "=== Run training scenarios"
+# Note, timing assertions of performance scenarios could fail with instrumented build, profiles are collected anyway.
+pushd "$SCRIPTDIR" > /dev/null
+LLVM_PROFILE_FILE="$PROFILE_DIR/netcoredbg-%p.profraw" TIMEOUT=$TIMEOUT \
+    NETCOREDBG="$INSTALL_DIR/netcoredbg" ./run_tests.sh "${TRAIN_TESTS[@]}" || true
+popd > /dev/null
+
+if [ "$IS_CLANG" -eq "1" ]; then
+    echo "=== Merge profiles"
+    : ${LLVM_PROFDATA:=llvm-profdata}
+    $LLVM_PROFDATA merge -o "$PROFILE_DATA" "$PROFILE_DIR"/*.profraw
+fi
+
+echo "=== Build optimized debugger"
+cmake -S "$SCRIPTDIR/.." -B "$BUILD_DIR" "$@" \
+    -DCMAKE_BUILD_TYPE=Release -DCMAKE_INSTALL_PREFIX="$INSTALL_DIR" \
+    -DLTO=ON -DPGO=use -DPGO_PROFILE="$PROFILE_DATA"
+cmake --build "$BUILD_DIR" --target clean
+cmake --build "$BUILD_DIR" --target install -j"$(nproc)"
+
+echo "=== Optimized debugger installed to $INSTALL_DIR"
@@ -73,6 +73,7 @@ $ALL_TEST_NAMES = @(
 
 # Skipped tests:
 # VSCodeTest297killNCD --- is not automated enough. For manual run only.
+# MITestPerformance --- performance scenarios with timing assertions, depends on host load. For manual run only.
 
 $TEST_NAMES = $tests
 
@@ -87,6 +87,8 @@ ALL_TEST_NAMES=(
 
 # Skipped tests:
 # VSCodeTest297killNCD --- is not automated enough. For manual run only.
+# MITestPerformance --- performance scenarios with timing assertions, depends on host load. For manual run only:
+#     TIMEOUT=600 ./run_tests.sh MITestPerformance
 
 INTEROP="0"
 